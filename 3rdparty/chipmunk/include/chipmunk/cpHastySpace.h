@@ -23,5 +23,16 @@ CP_EXPORT void cpHastySpaceSetThreads(cpSpace *space, unsigned long threads);
 /// Returns the number of threads the solver is using to run.
 CP_EXPORT unsigned long cpHastySpaceGetThreads(cpSpace *space);
 
+/// Solves an island of the space, see cpHastySpaceSetIslandSolver().
+typedef void (*cpHastySpaceIslandFunc)(unsigned long island, void *data);
+/// Calls func(island, data) for each island in [0, count), possibly in parallel, and returns once they all ran.
+typedef void (*cpHastySpaceParallelForFunc)(cpHastySpaceIslandFunc func, void *data, unsigned long count, void *userData);
+
+/// Solve the islands of the space, the groups of dynamic bodies touching or jointed together, in parallel.
+/// The islands share no dynamic body, so the results are the same as with one thread, unlike the solver threads.
+/// It is used in place of the solver threads when the step has more constraints than the threshold of the threads.
+/// Pass NULL to use the solver threads again.
+CP_EXPORT void cpHastySpaceSetIslandSolver(cpSpace *space, cpHastySpaceParallelForFunc parallelFor, void *userData);
+
 /// When stepping a hasty space, you must use this function.
 CP_EXPORT void cpHastySpaceStep(cpSpace *space, cpFloat dt);
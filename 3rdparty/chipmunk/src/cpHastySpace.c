@@ -3,6 +3,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 //TODO: Move all the thread stuff to another file
 
@@ -394,6 +396,22 @@ struct ThreadContext {
 
 typedef	void (*cpHastySpaceWorkFunction)(cpSpace *space, unsigned long worker, unsigned long worker_count);
 
+// The islands of a step, their arbiters and constraints are stored by island, in the order of the space.
+struct IslandSolver {
+	cpHastySpaceParallelForFunc parallel_for;
+	void *user_data;
+	
+	unsigned long capacity;
+	int *arbiter_offsets, *constraint_offsets, *cursors;
+	
+	int arbiter_capacity, constraint_capacity;
+	cpArbiter **arbiters;
+	cpConstraint **constraints;
+	
+	// Bodies marked with their island, and the flood fill stack.
+	cpArray *marked, *stack;
+};
+
 struct cpHastySpace {
 	cpSpace space;
 	
@@ -413,6 +431,8 @@ struct cpHastySpace {
 	cpHastySpaceWorkFunction work;
 	
 	struct ThreadContext workers[MAX_THREADS - 1];
+	
+	struct IslandSolver islands;
 };
 
 static void *
@@ -494,6 +514,206 @@ Solver(cpSpace *space, unsigned long worker, unsigned long worker_count)
 	}
 }
 
+//MARK: Island Solver
+
+// While solving, the awake dynamic bodies hold their island in their component root.
+// They have a NULL root otherwise, and the roots are cleared before the solver returns.
+static inline cpBody *
+IslandMark(unsigned long island)
+{
+	return (cpBody *)(uintptr_t)(island + 1);
+}
+
+static inline unsigned long
+IslandOf(cpBody *body, unsigned long shared)
+{
+	// The root of a sleeping body is a body.
+	uintptr_t root = (uintptr_t)body->sleeping.root;
+	return (cpBodyGetType(body) == CP_BODY_TYPE_DYNAMIC && root > 0 && root <= shared ? (unsigned long)(root - 1) : shared);
+}
+
+static inline unsigned long
+IslandIndex(cpBody *a, cpBody *b, unsigned long shared)
+{
+	unsigned long island = IslandOf(a, shared);
+	return (island != shared ? island : IslandOf(b, shared));
+}
+
+static inline void
+IslandVisit(struct IslandSolver *islands, cpBody *body, cpBody *mark)
+{
+	// Sleeping bodies have a root already.
+	if(cpBodyGetType(body) == CP_BODY_TYPE_DYNAMIC && body->sleeping.root == NULL){
+		body->sleeping.root = mark;
+		cpArrayPush(islands->marked, body);
+		cpArrayPush(islands->stack, body);
+	}
+}
+
+static void
+IslandFloodFill(struct IslandSolver *islands, cpBody *seed, unsigned long island)
+{
+	cpBody *mark = IslandMark(island);
+	IslandVisit(islands, seed, mark);
+	
+	while(islands->stack->num > 0){
+		cpBody *body = (cpBody *)cpArrayPop(islands->stack);
+		CP_BODY_FOREACH_ARBITER(body, arb) IslandVisit(islands, (arb->body_a == body ? arb->body_b : arb->body_a), mark);
+		CP_BODY_FOREACH_CONSTRAINT(body, constraint) IslandVisit(islands, (constraint->a == body ? constraint->b : constraint->a), mark);
+	}
+}
+
+static inline void
+IslandSeed(struct IslandSolver *islands, cpBody *a, cpBody *b, unsigned long *count)
+{
+	cpBody *body = (cpBodyGetType(a) == CP_BODY_TYPE_DYNAMIC ? a : b);
+	if(cpBodyGetType(body) == CP_BODY_TYPE_DYNAMIC && body->sleeping.root == NULL){
+		IslandFloodFill(islands, body, (*count)++);
+	}
+}
+
+static void
+IslandReserve(struct IslandSolver *islands, unsigned long count, int arbiters, int constraints)
+{
+	if(islands->capacity < count){
+		islands->capacity = count*2;
+		islands->arbiter_offsets = (int *)cprealloc(islands->arbiter_offsets, (islands->capacity + 1)*sizeof(int));
+		islands->constraint_offsets = (int *)cprealloc(islands->constraint_offsets, (islands->capacity + 1)*sizeof(int));
+		islands->cursors = (int *)cprealloc(islands->cursors, islands->capacity*sizeof(int));
+	}
+	
+	if(islands->arbiter_capacity < arbiters){
+		islands->arbiter_capacity = arbiters*2;
+		islands->arbiters = (cpArbiter **)cprealloc(islands->arbiters, islands->arbiter_capacity*sizeof(cpArbiter *));
+	}
+	
+	if(islands->constraint_capacity < constraints){
+		islands->constraint_capacity = constraints*2;
+		islands->constraints = (cpConstraint **)cprealloc(islands->constraints, islands->constraint_capacity*sizeof(cpConstraint *));
+	}
+}
+
+// Solves an island the way Solver() does for the whole space, the islands share no dynamic body.
+static void
+SolveIsland(unsigned long island, void *data)
+{
+	cpHastySpace *hasty = (cpHastySpace *)data;
+	cpSpace *space = (cpSpace *)hasty;
+	struct IslandSolver *islands = &hasty->islands;
+	
+	cpFloat dt = space->curr_dt;
+	int arbiter_begin = islands->arbiter_offsets[island], arbiter_end = islands->arbiter_offsets[island + 1];
+	int constraint_begin = islands->constraint_offsets[island], constraint_end = islands->constraint_offsets[island + 1];
+	
+	for(int i=0; i<space->iterations; i++){
+		for(int j=arbiter_begin; j<arbiter_end; j++){
+			#ifdef __ARM_NEON__
+				cpArbiterApplyImpulse_NEON(islands->arbiters[j]);
+			#else
+				cpArbiterApplyImpulse(islands->arbiters[j]);
+			#endif
+		}
+		
+		for(int j=constraint_begin; j<constraint_end; j++){
+			cpConstraint *constraint = islands->constraints[j];
+			constraint->klass->applyImpulse(constraint, dt);
+		}
+	}
+}
+
+static void
+IslandSolverRun(cpHastySpace *hasty)
+{
+	cpSpace *space = (cpSpace *)hasty;
+	struct IslandSolver *islands = &hasty->islands;
+	cpArray *arbiters = space->arbiters;
+	cpArray *constraints = space->constraints;
+	
+	// Number the islands in the order of the space.
+	unsigned long count = 0;
+	for(int i=0; i<arbiters->num; i++){
+		cpArbiter *arb = (cpArbiter *)arbiters->arr[i];
+		IslandSeed(islands, arb->body_a, arb->body_b, &count);
+	}
+	
+	for(int i=0; i<constraints->num; i++){
+		cpConstraint *constraint = (cpConstraint *)constraints->arr[i];
+		IslandSeed(islands, constraint->a, constraint->b, &count);
+	}
+	
+	if(count > 1){
+		// The arbiters and constraints without a dynamic body, they only apply null impulses.
+		unsigned long shared = count++;
+		IslandReserve(islands, count, arbiters->num, constraints->num);
+		
+		// Bucket the arbiters and constraints by island, in their order.
+		memset(islands->arbiter_offsets, 0, (count + 1)*sizeof(int));
+		memset(islands->constraint_offsets, 0, (count + 1)*sizeof(int));
+		for(int i=0; i<arbiters->num; i++){
+			cpArbiter *arb = (cpArbiter *)arbiters->arr[i];
+			islands->arbiter_offsets[IslandIndex(arb->body_a, arb->body_b, shared) + 1]++;
+		}
+		for(int i=0; i<constraints->num; i++){
+			cpConstraint *constraint = (cpConstraint *)constraints->arr[i];
+			islands->constraint_offsets[IslandIndex(constraint->a, constraint->b, shared) + 1]++;
+		}
+		for(unsigned long i=0; i<count; i++){
+			islands->arbiter_offsets[i + 1] += islands->arbiter_offsets[i];
+			islands->constraint_offsets[i + 1] += islands->constraint_offsets[i];
+		}
+		
+		memcpy(islands->cursors, islands->arbiter_offsets, count*sizeof(int));
+		for(int i=0; i<arbiters->num; i++){
+			cpArbiter *arb = (cpArbiter *)arbiters->arr[i];
+			islands->arbiters[islands->cursors[IslandIndex(arb->body_a, arb->body_b, shared)]++] = arb;
+		}
+		
+		memcpy(islands->cursors, islands->constraint_offsets, count*sizeof(int));
+		for(int i=0; i<constraints->num; i++){
+			cpConstraint *constraint = (cpConstraint *)constraints->arr[i];
+			islands->constraints[islands->cursors[IslandIndex(constraint->a, constraint->b, shared)]++] = constraint;
+		}
+		
+		islands->parallel_for(SolveIsland, hasty, count, islands->user_data);
+	} else {
+		Solver(space, 0, 1);
+	}
+	
+	// Only sleeping bodies retain their component root.
+	for(int i=0; i<islands->marked->num; i++){
+		((cpBody *)islands->marked->arr[i])->sleeping.root = NULL;
+	}
+	islands->marked->num = 0;
+}
+
+void
+cpHastySpaceSetIslandSolver(cpSpace *space, cpHastySpaceParallelForFunc parallelFor, void *userData)
+{
+	cpHastySpace *hasty = (cpHastySpace *)space;
+	struct IslandSolver *islands = &hasty->islands;
+	
+	islands->parallel_for = parallelFor;
+	islands->user_data = userData;
+	
+	if(parallelFor && islands->marked == NULL){
+		islands->marked = cpArrayNew(0);
+		islands->stack = cpArrayNew(0);
+	}
+}
+
+static void
+IslandSolverFree(struct IslandSolver *islands)
+{
+	cpfree(islands->arbiter_offsets);
+	cpfree(islands->constraint_offsets);
+	cpfree(islands->cursors);
+	cpfree(islands->arbiters);
+	cpfree(islands->constraints);
+	
+	if(islands->marked) cpArrayFree(islands->marked);
+	if(islands->stack) cpArrayFree(islands->stack);
+}
+
 //MARK: Thread Management Functions
 
 static void
@@ -583,6 +803,7 @@ cpHastySpaceFree(cpSpace *space)
 	cpHastySpace *hasty = (cpHastySpace *)space;
 	
 	HaltThreads(hasty);
+	IslandSolverFree(&hasty->islands);
 	
 	pthread_mutex_destroy(&hasty->mutex);
 	pthread_cond_destroy(&hasty->cond_work);
@@ -676,7 +897,11 @@ cpHastySpaceStep(cpSpace *space, cpFloat dt)
 		// Run the impulse solver.
 		cpHastySpace *hasty = (cpHastySpace *)space;
 		if((unsigned long)(arbiters->num + constraints->num) > hasty->constraint_count_threshold){
-			RunWorkers(hasty, Solver);
+			if(hasty->islands.parallel_for){
+				IslandSolverRun(hasty);
+			} else {
+				RunWorkers(hasty, Solver);
+			}
 		} else {
 			Solver(space, 0, 1);
 		}
@@ -4,9 +4,11 @@
 #include "oboe.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <stdint.h>
 
+#include "alc/alconfig.h"
 #include "alnumeric.h"
 #include "core/device.h"
 #include "core/logging.h"
@@ -34,6 +36,7 @@ struct OboePlayback final : public BackendBase, public oboe::AudioStreamCallback
     bool reset() override;
     void start() override;
     void stop() override;
+    ClockLatency getClockLatency() override;
 };
 
 
@@ -81,6 +84,11 @@ bool OboePlayback::reset()
     oboe::AudioStreamBuilder builder;
     builder.setDirection(oboe::Direction::Output);
     builder.setPerformanceMode(oboe::PerformanceMode::LowLatency);
+    /* An exclusive stream skips the system mixer for the lowest latency. It's
+     * a request, the stream is shared when the device doesn't allow it.
+     */
+    if(GetConfigValueBool(mDevice->DeviceName.c_str(), "oboe", "exclusive", false))
+        builder.setSharingMode(oboe::SharingMode::Exclusive);
     /* Don't let Oboe convert. We should be able to handle anything it gives
      * back.
      */
@@ -181,12 +189,14 @@ bool OboePlayback::reset()
     }
     mDevice->Frequency = static_cast<uint32_t>(mStream->getSampleRate());
 
-    /* Ensure the period size is no less than 10ms. It's possible for FramesPerCallback to be 0
-     * indicating variable updates, but OpenAL should have a reasonable minimum update size set.
-     * FramesPerBurst may not necessarily be correct, but hopefully it can act as a minimum
-     * update size.
+    /* Ensure the period size is no less than 10ms, or 4ms with an exclusive
+     * stream. It's possible for FramesPerCallback to be 0 indicating variable
+     * updates, but OpenAL should have a reasonable minimum update size set.
+     * FramesPerBurst may not necessarily be correct, but hopefully it can act
+     * as a minimum update size.
      */
-    mDevice->UpdateSize = maxu(mDevice->Frequency / 100,
+    const bool exclusive{mStream->getSharingMode() == oboe::SharingMode::Exclusive};
+    mDevice->UpdateSize = maxu(mDevice->Frequency / (exclusive ? 250 : 100),
         static_cast<uint32_t>(mStream->getFramesPerBurst()));
     mDevice->BufferSize = maxu(mDevice->UpdateSize * 2,
         static_cast<uint32_t>(mStream->getBufferSizeInFrames()));
@@ -209,6 +219,22 @@ void OboePlayback::stop()
         ERR("Failed to stop stream: %s\n", oboe::convertToText(result));
 }
 
+ClockLatency OboePlayback::getClockLatency()
+{
+    ClockLatency ret{BackendBase::getClockLatency()};
+
+    /* Oboe can measure the latency from the stream timestamps, which includes
+     * the latency of the system mixer and the hardware. Keep the estimation
+     * from the buffer size when it can't.
+     */
+    auto latency = mStream->calculateLatencyMillis();
+    if(latency)
+        ret.Latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double,std::milli>{latency.value()});
+
+    return ret;
+}
+
 
 struct OboeCapture final : public BackendBase, public oboe::AudioStreamCallback {
     OboeCapture(DeviceBase *device) : BackendBase{device} { }
@@ -55,6 +55,9 @@ function(ax_link_cxx_prebuilt APP_NAME AX_ROOT_DIR AX_PREBUILT_DIR)
         PRIVATE CP_USE_DOUBLES=0
         PRIVATE CP_USE_CGTYPES=0
     )
+    if (NOT EMSCRIPTEN)
+        target_compile_definitions(${APP_NAME} PRIVATE BT_THREADSAFE=1)
+    endif()
 
     ax_config_pred(${APP_NAME} AX_USE_ALSOFT)
     ax_config_pred(${APP_NAME} AX_ENABLE_MSEDGE_WEBVIEW2)
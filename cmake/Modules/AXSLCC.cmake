@@ -13,6 +13,8 @@ axslcc_option(AXSLCC_FRAG_SOURCE_FILE_EXTENSIONS ".frag;.fsh;.fs")
 axslcc_option(AXSLCC_VERT_SOURCE_FILE_EXTENSIONS ".vert;.vsh;.vs")
 axslcc_option(AXSLCC_OUT_DIR ${CMAKE_BINARY_DIR}/runtime/axslc)
 axslcc_option(AXSLCC_FIND_PROG_ROOT "")
+# metal only: compile the shaders to metallib bytecode, so the driver doesn't compile their sources at runtime
+axslcc_option(AXSLCC_COMPILE_BINARY FALSE)
 
 find_program(AXSLCC_EXE NAMES axslcc
     PATHS ${AXSLCC_FIND_PROG_ROOT}
@@ -27,6 +29,7 @@ message(STATUS "AXSLCC_OUT_DIR=${AXSLCC_OUT_DIR}")
 message(STATUS "AXSLCC_FIND_PROG_ROOT=${AXSLCC_FIND_PROG_ROOT}")
 message(STATUS "AXSLCC_FRAG_SOURCE_FILE_EXTENSIONS=${AXSLCC_FRAG_SOURCE_FILE_EXTENSIONS}")
 message(STATUS "AXSLCC_VERT_SOURCE_FILE_EXTENSIONS=${AXSLCC_VERT_SOURCE_FILE_EXTENSIONS}")
+message(STATUS "AXSLCC_COMPILE_BINARY=${AXSLCC_COMPILE_BINARY}")
 
 # PROPERTY: include direcotries (optional)
 define_property(SOURCE PROPERTY AXSLCC_INCLUDE_DIRS
@@ -151,6 +154,10 @@ function (ax_target_compile_shaders target_name)
         # sgs, because Apple Metal lack of shader uniform reflect so use --sgs --refelect
         if (AX_USE_METAL)
             list(APPEND SC_FLAGS "--sgs" "--reflect")
+            # the bytecode is stored as the DATA chunk of the sgs, loaded by ShaderModuleMTL with newLibraryWithData
+            if (AXSLCC_COMPILE_BINARY AND NOT opt_CVAR)
+                list(APPEND SC_FLAGS "--bin")
+            endif()
         endif()
 
         # input
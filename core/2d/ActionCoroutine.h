@@ -31,28 +31,7 @@ THE SOFTWARE.
 #define __ACTION_CCCOROUTINE_ACTION_H__
 
 #include "2d/Action.h"
-
-#if __has_include(<coroutine>)
-#    include <coroutine>
-namespace axstd
-{
-using suspend_always = std::suspend_always;
-template <typename _Ty>
-using coroutine_handle = std::coroutine_handle<_Ty>;
-}  // namespace axstd
-#elif __has_include(<experimental/coroutine>)
-// fallback to experimental, currently only for android, in the future may don't required,
-// for example: we upgrade ndk in the future releases of axmol
-#    include <experimental/coroutine>
-namespace axstd
-{
-using suspend_always = std::experimental::suspend_always;
-template <typename _Ty>
-using coroutine_handle = std::experimental::coroutine_handle<_Ty>;
-}  // namespace axstd
-#else
-#    error This compiler missing c++20 coroutine
-#endif
+#include "base/Async.h"
 
 namespace ax
 {
@@ -60,6 +60,8 @@ void GridAction::startWithTarget(Node* target)
             targetGrid->getGridSize().height == _gridSize.height)
         {
             targetGrid->reuse();
+            // the effect of the previous action isn't part of the vertices
+            targetGrid->setShaderEffect(GridShaderEffect());
         }
         else
         {
@@ -85,6 +87,11 @@ void GridAction::cacheTargetAsGridNode()
     AXASSERT(_gridNodeTarget, "GridActions can only used on NodeGrid");
 }
 
+void GridAction::setShaderEffect(const GridShaderEffect& effect)
+{
+    _gridNodeTarget->getGrid()->setShaderEffect(effect);
+}
+
 GridAction* GridAction::reverse() const
 {
     // FIXME: This conversion isn't safe.
@@ -35,6 +35,7 @@ namespace ax
 
 class GridBase;
 class NodeGrid;
+struct GridShaderEffect;
 
 /**
  * @addtogroup actions
@@ -74,12 +75,25 @@ public:
      */
     bool initWithDuration(float duration, const Vec2& gridSize);
 
+    /**
+     * @brief Sets whether the effect moves the vertices in the vertex shader of the grid instead of on the CPU, its
+     * cost then doesn't depend on the size of the grid. Only the actions with a shader variant use it: Waves3D,
+     * Ripple3D, Lens3D, Liquid, Waves, Twirl, PageTurn3D, WavesTiles3D and JumpTiles3D. The vertices of the grid
+     * aren't changed by the effect, a grid reused by the next action doesn't include it.
+     * @param enabled Whether the effect runs in the vertex shader, false by default.
+     */
+    void setShaderEffectEnabled(bool enabled) { _shaderEffectEnabled = enabled; }
+    bool isShaderEffectEnabled() const { return _shaderEffectEnabled; }
+
 protected:
     Vec2 _gridSize;
 
     NodeGrid* _gridNodeTarget;
+    bool _shaderEffectEnabled = false;
 
     void cacheTargetAsGridNode();
+    /** Sets the effect computed by the vertex shader of the grid of the target. */
+    void setShaderEffect(const GridShaderEffect& effect);
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(GridAction);
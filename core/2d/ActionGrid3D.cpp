@@ -26,6 +26,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "2d/ActionGrid3D.h"
+#include "2d/Grid.h"
 #include "base/Director.h"
 
 namespace ax
@@ -63,11 +64,20 @@ bool Waves3D::initWithDuration(float duration, const Vec2& gridSize, unsigned in
 Waves3D* Waves3D::clone() const
 {
     // no copy constructor
-    return Waves3D::create(_duration, _gridSize, _waves, _amplitude);
+    auto a = Waves3D::create(_duration, _gridSize, _waves, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
+    return a;
 }
 
 void Waves3D::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::WAVES_3D,
+                         Vec4((float)M_PI * time * _waves * 2, _amplitude * _amplitudeRate, 0, 0)});
+        return;
+    }
+
     int i, j;
     for (i = 0; i < _gridSize.width + 1; ++i)
     {
@@ -321,6 +331,7 @@ Lens3D* Lens3D::clone() const
     // no copy constructor
     auto a = new Lens3D();
     a->initWithDuration(_duration, _gridSize, _position, _radius);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
     a->autorelease();
     return a;
 }
@@ -336,6 +347,13 @@ void Lens3D::setPosition(const Vec2& pos)
 
 void Lens3D::update(float /*time*/)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::LENS_3D, Vec4(_lensEffect, _concave ? -1.0f : 1.0f, 0, 0),
+                         Vec4(_position.x, _position.y, _radius, 0)});
+        return;
+    }
+
     if (_dirty)
     {
         int i, j;
@@ -431,12 +449,21 @@ Ripple3D* Ripple3D::clone() const
     // no copy constructor
     auto a = new Ripple3D();
     a->initWithDuration(_duration, _gridSize, _position, _radius, _waves, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
     a->autorelease();
     return a;
 }
 
 void Ripple3D::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::RIPPLE_3D,
+                         Vec4(time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate, 0, 0),
+                         Vec4(_position.x, _position.y, _radius, 0)});
+        return;
+    }
+
     int i, j;
 
     for (i = 0; i < (_gridSize.width + 1); ++i)
@@ -558,12 +585,20 @@ Liquid* Liquid::clone() const
     // no copy constructor
     auto a = new Liquid();
     a->initWithDuration(_duration, _gridSize, _waves, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
     a->autorelease();
     return a;
 }
 
 void Liquid::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::LIQUID,
+                         Vec4(time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate, 0, 0)});
+        return;
+    }
+
     int i, j;
 
     for (i = 1; i < _gridSize.width; ++i)
@@ -628,12 +663,21 @@ Waves* Waves::clone() const
     // no copy constructor
     auto a = new Waves();
     a->initWithDuration(_duration, _gridSize, _waves, _amplitude, _horizontal, _vertical);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
     a->autorelease();
     return a;
 }
 
 void Waves::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::WAVES,
+                         Vec4(time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate, _horizontal ? 1.0f : 0.0f,
+                              _vertical ? 1.0f : 0.0f)});
+        return;
+    }
+
     int i, j;
 
     for (i = 0; i < _gridSize.width + 1; ++i)
@@ -705,12 +749,22 @@ Twirl* Twirl::clone() const
     // no copy constructor
     auto a = new Twirl();
     a->initWithDuration(_duration, _gridSize, _position, _twirls, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
     a->autorelease();
     return a;
 }
 
 void Twirl::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        float amp = 0.1f * _amplitude * _amplitudeRate;
+        setShaderEffect({GridShaderEffect::Type::TWIRL,
+                         Vec4(cosf((float)M_PI / 2.0f + time * (float)M_PI * _twirls * 2) * amp, 0, 0, 0),
+                         Vec4(_position.x, _position.y, 0, 0)});
+        return;
+    }
+
     int i, j;
     Vec2 c = _position;
 
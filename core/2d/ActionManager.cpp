@@ -31,8 +31,10 @@ THE SOFTWARE.
 #include "2d/ActionManager.h"
 #include "2d/Node.h"
 #include "2d/Action.h"
+#include "2d/TweenSystem.h"
 #include "base/Scheduler.h"
 #include "base/Macros.h"
+#include "base/Profiling.h"
 
 namespace ax
 {
@@ -40,7 +42,9 @@ namespace ax
 // singleton stuff
 //
 
-ActionManager::ActionManager() : _currentTarget(nullptr), _currentTargetSalvaged(false) {}
+ActionManager::ActionManager()
+    : _currentTarget(nullptr), _currentTargetSalvaged(false), _tweenSystem(std::make_unique<TweenSystem>())
+{}
 
 ActionManager::~ActionManager()
 {
@@ -103,6 +107,7 @@ void ActionManager::pauseTarget(Node* target)
     {
         it->second.paused = true;
     }
+    _tweenSystem->pauseTarget(target);
 }
 
 void ActionManager::resumeTarget(Node* target)
@@ -112,6 +117,7 @@ void ActionManager::resumeTarget(Node* target)
     {
         it->second.paused = false;
     }
+    _tweenSystem->resumeTarget(target);
 }
 
 Vector<Node*> ActionManager::pauseAllRunningActions()
@@ -124,6 +130,12 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
         idsWithActions.pushBack(const_cast<Node*>(target));
     }
 
+    for (auto target : _tweenSystem->pauseAllTargets())
+    {
+        if (_targets.find(target) == _targets.end())
+            idsWithActions.pushBack(target);
+    }
+
     return idsWithActions;
 }
 
@@ -167,6 +179,7 @@ void ActionManager::removeAllActions()
 {
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
         removeTargetActionHandle(actionIt);
+    _tweenSystem->stopAll();
 }
 
 void ActionManager::removeAllActionsFromTarget(Node* target)
@@ -180,6 +193,7 @@ void ActionManager::removeAllActionsFromTarget(Node* target)
     auto actionIt = _targets.find(target);
     if (actionIt != _targets.end())
         removeTargetActionHandle(actionIt);
+    _tweenSystem->stopAllForTarget(target);
 }
 
 void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
@@ -392,6 +406,8 @@ ssize_t ActionManager::getNumberOfRunningActions() const
 // main loop
 void ActionManager::update(float dt)
 {
+    AX_TRACE_SCOPE("ActionManager::update");
+
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
     {
         auto elt               = &actionIt->second;
@@ -452,6 +468,8 @@ void ActionManager::update(float dt)
 
     // issue #635
     _currentTarget = nullptr;
+
+    _tweenSystem->update(dt);
 }
 
 }
@@ -35,9 +35,13 @@ THE SOFTWARE.
 #include "base/Vector.h"
 #include "base/Object.h"
 
+#include <memory>
+
 namespace ax
 {
 
+class TweenSystem;
+
 struct ActionHandle
 {
     Vector<Action*> actions;
@@ -195,6 +199,11 @@ public:
      */
     virtual void resumeTargets(const Vector<Node*>& targetsToResume);
 
+    /** Gets the TweenSystem running the simple move, scale, rotate, fade and tint tweens without Action objects.
+     * Its tweens are paused, resumed and removed with the actions of their targets.
+     */
+    TweenSystem* getTweenSystem() const { return _tweenSystem.get(); }
+
     /** Main loop of ActionManager.
      * @param dt    In seconds.
      */
@@ -216,6 +225,7 @@ protected:
     std::unordered_map<Node*, ActionHandle> _targets;
     ActionHandle* _currentTarget;
     bool _currentTargetSalvaged;
+    std::unique_ptr<TweenSystem> _tweenSystem;
 };
 
 // end of actions group
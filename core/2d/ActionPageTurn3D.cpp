@@ -48,7 +48,9 @@ PageTurn3D* PageTurn3D::create(float duration, const Vec2& gridSize)
 PageTurn3D* PageTurn3D::clone() const
 {
     // no copy constructor
-    return PageTurn3D::create(_duration, _gridSize);
+    auto a = PageTurn3D::create(_duration, _gridSize);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
+    return a;
 }
 
 GridBase* PageTurn3D::getGrid()
@@ -80,6 +82,12 @@ void PageTurn3D::update(float time)
     float sinTheta = sinf(theta);
     float cosTheta = cosf(theta);
 
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::PAGE_TURN_3D, Vec4(ay, sinTheta, cosTheta, rotateByYAxis)});
+        return;
+    }
+
     for (int i = 0; i <= _gridSize.width; ++i)
     {
         for (int j = 0; j <= _gridSize.height; ++j)
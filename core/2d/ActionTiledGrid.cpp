@@ -673,11 +673,20 @@ bool WavesTiles3D::initWithDuration(float duration, const Vec2& gridSize, unsign
 WavesTiles3D* WavesTiles3D::clone() const
 {
     // no copy constructor
-    return WavesTiles3D::create(_duration, _gridSize, _waves, _amplitude);
+    auto a = WavesTiles3D::create(_duration, _gridSize, _waves, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
+    return a;
 }
 
 void WavesTiles3D::update(float time)
 {
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::WAVES_TILES_3D,
+                         Vec4(time * (float)M_PI * _waves * 2, _amplitude * _amplitudeRate, 0, 0)});
+        return;
+    }
+
     for (int i = 0; i < _gridSize.width; i++)
     {
         for (int j = 0; j < _gridSize.height; j++)
@@ -729,7 +738,9 @@ bool JumpTiles3D::initWithDuration(float duration, const Vec2& gridSize, unsigne
 JumpTiles3D* JumpTiles3D::clone() const
 {
     // no copy constructor
-    return JumpTiles3D::create(_duration, _gridSize, _jumps, _amplitude);
+    auto a = JumpTiles3D::create(_duration, _gridSize, _jumps, _amplitude);
+    a->setShaderEffectEnabled(_shaderEffectEnabled);
+    return a;
 }
 
 void JumpTiles3D::update(float time)
@@ -737,6 +748,12 @@ void JumpTiles3D::update(float time)
     float sinz  = (sinf((float)M_PI * time * _jumps * 2) * _amplitude * _amplitudeRate);
     float sinz2 = (sinf((float)M_PI * (time * _jumps * 2 + 1)) * _amplitude * _amplitudeRate);
 
+    if (_shaderEffectEnabled)
+    {
+        setShaderEffect({GridShaderEffect::Type::JUMP_TILES_3D, Vec4(sinz, sinz2, 0, 0)});
+        return;
+    }
+
     for (int i = 0; i < _gridSize.width; i++)
     {
         for (int j = 0; j < _gridSize.height; j++)
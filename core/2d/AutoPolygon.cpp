@@ -702,8 +702,10 @@ Rect AutoPolygon::getRealRect(const Rect& rect)
     }
     else
     {
-        // rect is specified, so convert to real rect
+        // rect is specified, so convert to real rect, the tracing steps by whole pixels
         realRect = AX_RECT_POINTS_TO_PIXELS(rect);
+        realRect.setRect(std::round(realRect.origin.x), std::round(realRect.origin.y),
+                         std::round(realRect.size.width), std::round(realRect.size.height));
     }
     return realRect;
 }
@@ -723,6 +725,18 @@ PolygonInfo AutoPolygon::generateTriangles(const Rect& rect, float epsilon, floa
     return ret;
 }
 
+std::vector<PolygonInfo> AutoPolygon::generateTriangles(std::span<const Rect> rects, float epsilon, float threshold)
+{
+    // the image is only read, so the rects don't need any lock
+    std::vector<PolygonInfo> ret(rects.size());
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    jobSystem->wait(jobSystem->parallelFor(rects.size(), 1, [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i)
+            ret[i] = generateTriangles(rects[i], epsilon, threshold);
+    }));
+    return ret;
+}
+
 PolygonInfo AutoPolygon::generatePolygon(std::string_view filename, const Rect& rect, float epsilon, float threshold)
 {
     AutoPolygon ap(filename);
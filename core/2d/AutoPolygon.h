@@ -31,6 +31,7 @@ THE SOFTWARE.
 #ifndef COCOS_2D_CCAUTOPOLYGON_H__
 #define COCOS_2D_CCAUTOPOLYGON_H__
 
+#include <span>
 #include <string>
 #include <vector>
 #include "platform/Image.h"
@@ -243,6 +244,18 @@ public:
      */
     PolygonInfo generateTriangles(const Rect& rect = Rect::ZERO, float epsilon = 2.0f, float threshold = 0.05f);
 
+    /**
+     * Generates the polygons of several texture rects of the image, e.g. the frames of a sprite sheet.
+     * The rects are traced in parallel on the workers of the JobSystem, the call returns once they are all done.
+     * @param   rects   the texture rects, in points like for generateTriangles
+     * @param   epsilon the value used to reduce and expand, default to 2.0
+     * @param   threshold   the value where bigger than the threshold will be counted as opaque, used in trace
+     * @return  a PolygonInfo for each rect, in the order of the rects
+     */
+    std::vector<PolygonInfo> generateTriangles(std::span<const Rect> rects,
+                                               float epsilon   = 2.0f,
+                                               float threshold = 0.05f);
+
     /**
      * a helper function, packing autoPolygon creation, trace, reduce, expand, triangulate and calculate uv in one
      * function
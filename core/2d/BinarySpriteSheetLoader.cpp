@@ -0,0 +1,630 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/BinarySpriteSheetLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "2d/AutoPolygon.h"
+#include "2d/SpriteFrameCache.h"
+#include "base/Director.h"
+#include "base/Macros.h"
+#include "base/NinePatchImageParser.h"
+#include "base/NS.h"
+#include "base/Utils.h"
+#include "mio/mio.hpp"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureCache.h"
+
+namespace ax
+{
+
+// all the integers are little endian, the offsets are from the start of the file
+struct BinarySpriteSheetLoader::StringRef
+{
+    uint32_t offset;  // in the string pool
+    uint32_t length;
+};
+
+struct BinarySpriteSheetLoader::FileHeader
+{
+    char magic[4];  // "SSHB"
+    uint32_t version;
+    uint32_t fileSize;
+    int32_t pixelFormat;        // backend::PixelFormat of the texture, NONE for the default one
+    float textureSize[2];       // of the polygon uvs
+    StringRef textureFileName;  // relative to the sheet
+    uint32_t frameCount;
+    uint32_t frameOffset;  // FrameEntry[frameCount]
+    uint32_t nameCount;
+    uint32_t nameOffset;  // NameEntry[nameCount], sorted by name
+    uint32_t intCount;
+    uint32_t intOffset;  // int32_t[intCount], the polygons
+    uint32_t stringPoolOffset;
+    uint32_t stringPoolSize;
+};
+
+// the values given to SpriteFrame::createWithTexture, in pixels
+struct BinarySpriteSheetLoader::FrameEntry
+{
+    float rect[4];
+    float offset[2];
+    float originalSize[2];
+    float anchor[2];     // NaN when the frame has none
+    float capInsets[4];  // NaN when the frame isn't a nine patch
+    uint32_t rotated;
+    uint32_t vertexBegin;  // range of the int table, the x y of the vertices followed by the x y of their uvs
+    uint32_t vertexCount;  // of ints, in each of the two lists
+    uint32_t indexBegin;
+    uint32_t indexCount;
+};
+
+// the frame names and the aliases
+struct BinarySpriteSheetLoader::NameEntry
+{
+    StringRef name;
+    uint32_t frame;
+};
+
+static constexpr char SSHB_MAGIC[4] = {'S', 'S', 'H', 'B'};
+
+static backend::PixelFormat pixelFormatFromName(std::string_view name)
+{
+    // the names of the plist metadata, same as PlistSpriteSheetLoader
+    static const std::pair<std::string_view, backend::PixelFormat> pixelFormats[] = {
+        {"RGBA8888"sv, backend::PixelFormat::RGBA8}, {"RGBA4444"sv, backend::PixelFormat::RGBA4},
+        {"RGB5A1"sv, backend::PixelFormat::RGB5A1},  {"RGBA5551"sv, backend::PixelFormat::RGB5A1},
+        {"RGB565"sv, backend::PixelFormat::RGB565},  {"R8"sv, backend::PixelFormat::R8},
+        {"RG8"sv, backend::PixelFormat::RG8},        {"RGB888"sv, backend::PixelFormat::RGB8}};
+    for (auto&& [formatName, format] : pixelFormats)
+    {
+        if (formatName == name)
+            return format;
+    }
+    return backend::PixelFormat::NONE;
+}
+
+class BinarySpriteSheetLoader::FrameIndex : public ISpriteFrameIndex
+{
+public:
+    ~FrameIndex() override { AX_SAFE_RELEASE(_texture); }
+
+    bool open(std::string_view fullPath)
+    {
+        std::error_code error;
+        _mapping.map(fullPath, error);
+        if (!error && _mapping.size() > 0)
+        {
+            _data = reinterpret_cast<const uint8_t*>(_mapping.data());
+            _size = _mapping.size();
+        }
+        else
+        {
+            // not a regular file, e.g. in the apk
+            _buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+            _data   = _buffer.getBytes();
+            _size   = static_cast<size_t>(_buffer.getSize());
+        }
+        return _data && validate();
+    }
+
+    bool open(const Data& content)
+    {
+        _buffer.copy(content.getBytes(), content.getSize());
+        _data = _buffer.getBytes();
+        _size = static_cast<size_t>(_buffer.getSize());
+        return _data && validate();
+    }
+
+    SpriteFrame* createFrame(std::string_view name, SpriteFrameCache& cache) override
+    {
+        auto names = reinterpret_cast<const NameEntry*>(_data + header()->nameOffset);
+        auto end   = names + header()->nameCount;
+        auto it    = std::lower_bound(names, end, name, [this](const NameEntry& entry, std::string_view key) {
+            return readString(entry.name) < key;
+        });
+        if (it == end || readString(it->name) != name)
+            return nullptr;
+
+        auto& entry      = reinterpret_cast<const FrameEntry*>(_data + header()->frameOffset)[it->frame];
+        auto spriteFrame = SpriteFrame::createWithTexture(
+            _texture, Rect(entry.rect[0], entry.rect[1], entry.rect[2], entry.rect[3]), entry.rotated != 0,
+            Vec2(entry.offset[0], entry.offset[1]), Vec2(entry.originalSize[0], entry.originalSize[1]));
+
+        if (entry.vertexCount)
+        {
+            auto ints = reinterpret_cast<const int32_t*>(_data + header()->intOffset);
+            auto uvs  = ints + entry.vertexBegin + entry.vertexCount;
+            std::vector<int> vertices(ints + entry.vertexBegin, uvs);
+            std::vector<int> verticesUV(uvs, uvs + entry.vertexCount);
+            std::vector<int> indices(ints + entry.indexBegin, ints + entry.indexBegin + entry.indexCount);
+
+            PolygonInfo info;
+            initializePolygonInfo(Vec2(header()->textureSize[0], header()->textureSize[1]),
+                                  Vec2(entry.originalSize[0], entry.originalSize[1]), vertices, verticesUV, indices,
+                                  info);
+            spriteFrame->setPolygonInfo(info);
+        }
+        if (!std::isnan(entry.anchor[0]))
+            spriteFrame->setAnchorPoint(Vec2(entry.anchor[0], entry.anchor[1]));
+        if (!std::isnan(entry.capInsets[0]) && _texture)
+        {
+            cache.addSpriteFrameCapInset(
+                spriteFrame, Rect(entry.capInsets[0], entry.capInsets[1], entry.capInsets[2], entry.capInsets[3]),
+                _texture);
+        }
+        return spriteFrame;
+    }
+
+    Texture2D* getTexture() const override { return _texture; }
+
+    void setTexture(Texture2D* texture)
+    {
+        AX_SAFE_RETAIN(texture);
+        AX_SAFE_RELEASE(_texture);
+        _texture = texture;
+    }
+
+    std::string_view getTextureFileName() const { return readString(header()->textureFileName); }
+    backend::PixelFormat getPixelFormat() const { return static_cast<backend::PixelFormat>(header()->pixelFormat); }
+
+private:
+    const FileHeader* header() const { return reinterpret_cast<const FileHeader*>(_data); }
+
+    // the refs are checked by validate
+    std::string_view readString(const StringRef& ref) const
+    {
+        return std::string_view{reinterpret_cast<const char*>(_data + header()->stringPoolOffset + ref.offset),
+                                ref.length};
+    }
+
+    bool validate() const
+    {
+        if (_size < sizeof(FileHeader))
+            return false;
+
+        auto header = this->header();
+        if (memcmp(header->magic, SSHB_MAGIC, sizeof(SSHB_MAGIC)) != 0 ||
+            header->version != BinarySpriteSheetLoader::VERSION || header->fileSize != _size)
+            return false;
+
+        auto inFile = [this](size_t offset, size_t size) {
+            return offset % alignof(uint32_t) == 0 && offset <= _size && size <= _size - offset;
+        };
+        if (!inFile(header->frameOffset, size_t{header->frameCount} * sizeof(FrameEntry)) ||
+            !inFile(header->nameOffset, size_t{header->nameCount} * sizeof(NameEntry)) ||
+            !inFile(header->intOffset, size_t{header->intCount} * sizeof(int32_t)) ||
+            header->stringPoolOffset > _size || header->stringPoolSize > _size - header->stringPoolOffset)
+            return false;
+
+        auto inPool = [header](const StringRef& ref) {
+            return ref.offset <= header->stringPoolSize && ref.length <= header->stringPoolSize - ref.offset;
+        };
+        if (!inPool(header->textureFileName))
+            return false;
+
+        auto names = reinterpret_cast<const NameEntry*>(_data + header->nameOffset);
+        for (uint32_t i = 0; i < header->nameCount; ++i)
+        {
+            if (!inPool(names[i].name) || names[i].frame >= header->frameCount)
+                return false;
+        }
+
+        auto frames   = reinterpret_cast<const FrameEntry*>(_data + header->frameOffset);
+        auto intCount = size_t{header->intCount};
+        for (uint32_t i = 0; i < header->frameCount; ++i)
+        {
+            auto& frame = frames[i];
+            if (frame.vertexBegin > intCount || size_t{frame.vertexCount} * 2 > intCount - frame.vertexBegin ||
+                frame.indexBegin > intCount || frame.indexCount > intCount - frame.indexBegin)
+                return false;
+        }
+        return true;
+    }
+
+    mio::mmap_source _mapping;
+    Data _buffer;  // used when the file can't be mapped
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+    Texture2D* _texture  = nullptr;
+};
+
+bool BinarySpriteSheetLoader::convert(std::string_view plistPath,
+                                      std::string_view dstFullPath,
+                                      bool tracePolygons,
+                                      float epsilon,
+                                      float threshold)
+{
+    auto fileUtils      = FileUtils::getInstance();
+    const auto fullPath = fileUtils->fullPathForFilename(plistPath);
+    auto dict           = fullPath.empty() ? ValueMap{} : fileUtils->getValueMapFromFile(fullPath);
+
+    int format = 0;
+    Vec2 textureSize;
+    std::string textureFileName;
+    std::string pixelFormatName;
+    auto metaItr = dict.find("metadata"sv);
+    if (metaItr != dict.end())
+    {
+        auto& metadataDict = metaItr->second.asValueMap();
+        format             = optValue(metadataDict, "format"sv).asInt();
+        textureFileName    = optValue(metadataDict, "textureFileName"sv).asString();
+        pixelFormatName    = optValue(metadataDict, "pixelFormat"sv).asString();
+        if (metadataDict.find("size"sv) != metadataDict.end())
+            textureSize = SizeFromString(optValue(metadataDict, "size"sv).asString());
+    }
+
+    auto framesItr = dict.find("frames"sv);
+    if (framesItr == dict.end() || framesItr->second.getType() != Value::Type::MAP || format < 0 || format > 3)
+    {
+        AXLOGW("BinarySpriteSheetLoader: failed to convert '{}'", plistPath);
+        return false;
+    }
+
+    if (textureFileName.empty())
+    {
+        // same as the plist loader, the texture is named after the sheet
+        auto slash      = plistPath.find_last_of('/');
+        textureFileName = plistPath.substr(slash == std::string_view::npos ? 0 : slash + 1);
+        textureFileName = textureFileName.substr(0, textureFileName.find_last_of('.')).append(".png");
+    }
+
+    std::vector<FrameEntry> frames;
+    std::vector<std::pair<std::string, uint32_t>> names;
+    std::vector<int32_t> ints;
+    std::vector<uint32_t> untracedFrames;
+    Image* image = nullptr;
+    NinePatchImageParser parser;
+
+    for (auto&& [frameName, frameValue] : framesItr->second.asValueMap())
+    {
+        auto& frameDict = frameValue.asValueMap();
+        FrameEntry entry{};
+        entry.anchor[0] = entry.anchor[1] = NAN;
+        entry.capInsets[0] = entry.capInsets[1] = entry.capInsets[2] = entry.capInsets[3] = NAN;
+
+        Rect rect;
+        Vec2 offset;
+        Vec2 originalSize;
+        if (format == 0)
+        {
+            rect         = Rect(optValue(frameDict, "x"sv).asFloat(), optValue(frameDict, "y"sv).asFloat(),
+                                optValue(frameDict, "width"sv).asFloat(), optValue(frameDict, "height"sv).asFloat());
+            offset       = Vec2(optValue(frameDict, "offsetX"sv).asFloat(), optValue(frameDict, "offsetY"sv).asFloat());
+            originalSize = Vec2(static_cast<float>(std::abs(optValue(frameDict, "originalWidth"sv).asInt())),
+                                static_cast<float>(std::abs(optValue(frameDict, "originalHeight"sv).asInt())));
+        }
+        else if (format == 1 || format == 2)
+        {
+            rect          = RectFromString(optValue(frameDict, "frame"sv).asString());
+            entry.rotated = format == 2 && optValue(frameDict, "rotated"sv).asBool();
+            offset        = PointFromString(optValue(frameDict, "offset"sv).asString());
+            originalSize  = SizeFromString(optValue(frameDict, "sourceSize"sv).asString());
+        }
+        else
+        {
+            auto spriteSize = SizeFromString(optValue(frameDict, "spriteSize"sv).asString());
+            auto textureRect = RectFromString(optValue(frameDict, "textureRect"sv).asString());
+            rect          = Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height);
+            entry.rotated = optValue(frameDict, "textureRotated"sv).asBool();
+            offset        = PointFromString(optValue(frameDict, "spriteOffset"sv).asString());
+            originalSize  = SizeFromString(optValue(frameDict, "spriteSourceSize"sv).asString());
+
+            if (frameDict.find("vertices"sv) != frameDict.end())
+            {
+                using ax::utils::parseIntegerList;
+                auto vertices   = parseIntegerList(optValue(frameDict, "vertices"sv).asString());
+                auto verticesUV = parseIntegerList(optValue(frameDict, "verticesUV"sv).asString());
+                auto indices    = parseIntegerList(optValue(frameDict, "triangles"sv).asString());
+                verticesUV.resize(vertices.size());
+
+                entry.vertexBegin = static_cast<uint32_t>(ints.size());
+                entry.vertexCount = static_cast<uint32_t>(vertices.size());
+                ints.insert(ints.end(), vertices.begin(), vertices.end());
+                ints.insert(ints.end(), verticesUV.begin(), verticesUV.end());
+                entry.indexBegin = static_cast<uint32_t>(ints.size());
+                entry.indexCount = static_cast<uint32_t>(indices.size());
+                ints.insert(ints.end(), indices.begin(), indices.end());
+            }
+            if (frameDict.find("anchor"sv) != frameDict.end())
+            {
+                auto anchor     = PointFromString(optValue(frameDict, "anchor"sv).asString());
+                entry.anchor[0] = anchor.x;
+                entry.anchor[1] = anchor.y;
+            }
+
+            auto frameIndex = static_cast<uint32_t>(frames.size());
+            for (auto&& alias : optValue(frameDict, "aliases"sv).asValueVector())
+                names.emplace_back(alias.asString(), frameIndex);
+        }
+
+        entry.rect[0]         = rect.origin.x;
+        entry.rect[1]         = rect.origin.y;
+        entry.rect[2]         = rect.size.width;
+        entry.rect[3]         = rect.size.height;
+        entry.offset[0]       = offset.x;
+        entry.offset[1]       = offset.y;
+        entry.originalSize[0] = originalSize.x;
+        entry.originalSize[1] = originalSize.y;
+
+        // the cap insets need the pixels, they are computed once here instead of on each load
+        if (NinePatchImageParser::isNinePatchImage(frameName))
+        {
+            if (!image)
+            {
+                image = new Image();
+                image->initWithImageFile(fileUtils->fullPathFromRelativeFile(textureFileName, plistPath));
+            }
+            parser.setSpriteFrameInfo(image, rect, entry.rotated != 0);
+            auto capInsets     = parser.parseCapInset();
+            entry.capInsets[0] = capInsets.origin.x;
+            entry.capInsets[1] = capInsets.origin.y;
+            entry.capInsets[2] = capInsets.size.width;
+            entry.capInsets[3] = capInsets.size.height;
+        }
+        else if (tracePolygons && entry.vertexCount == 0)
+            untracedFrames.emplace_back(static_cast<uint32_t>(frames.size()));
+
+        names.emplace_back(frameName, static_cast<uint32_t>(frames.size()));
+        frames.emplace_back(entry);
+    }
+
+    if (!untracedFrames.empty())
+    {
+        const auto texturePath = fileUtils->fullPathFromRelativeFile(textureFileName, plistPath);
+        if (!image)
+        {
+            image = new Image();
+            image->initWithImageFile(texturePath);
+        }
+
+        if (image->getPixelFormat() != backend::PixelFormat::RGBA8)
+            AXLOGW("BinarySpriteSheetLoader: the polygons of '{}' aren't traced, its texture isn't RGBA8", plistPath);
+        else
+        {
+            const auto width  = static_cast<int>(image->getWidth());
+            const auto height = static_cast<int>(image->getHeight());
+            auto pixels       = image->getData();
+            if (textureSize.isZero())
+                textureSize.set(static_cast<float>(width), static_cast<float>(height));
+
+            // AutoPolygon asserts on the rects without any opaque pixel, their frames keep their quad
+            auto isOpaque = [&](int x, int y, int w, int h) {
+                if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width || y + h > height)
+                    return false;
+                for (int row = y; row < y + h; ++row)
+                {
+                    for (auto alpha = pixels + (row * width + x) * 4 + 3, end = alpha + w * 4; alpha != end; alpha += 4)
+                        if (*alpha > threshold)
+                            return true;
+                }
+                return false;
+            };
+
+            const auto scaleFactor = AX_CONTENT_SCALE_FACTOR();
+            std::vector<uint32_t> tracedFrames;
+            std::vector<Rect> rects;
+            for (auto frameIndex : untracedFrames)
+            {
+                // the texture rect of a rotated frame has its width and height swapped
+                auto& entry = frames[frameIndex];
+                const int x = static_cast<int>(entry.rect[0]);
+                const int y = static_cast<int>(entry.rect[1]);
+                const int w = static_cast<int>(entry.rect[entry.rotated ? 3 : 2]);
+                const int h = static_cast<int>(entry.rect[entry.rotated ? 2 : 3]);
+                if (isOpaque(x, y, w, h))
+                {
+                    tracedFrames.emplace_back(frameIndex);
+                    rects.emplace_back(x / scaleFactor, y / scaleFactor, w / scaleFactor, h / scaleFactor);
+                }
+            }
+
+            AutoPolygon autoPolygon(texturePath);
+            auto polygons = autoPolygon.generateTriangles(rects, epsilon, threshold);
+            for (size_t i = 0; i < polygons.size(); ++i)
+            {
+                auto& entry     = frames[tracedFrames[i]];
+                auto& triangles = polygons[i].triangles;
+
+                // the vertices are stored like the TexturePacker ones, in pixels of the untrimmed sprite with y down,
+                // and their uvs in pixels of the texture
+                const float left = (entry.originalSize[0] - entry.rect[2]) / 2 + entry.offset[0];
+                const float top  = (entry.originalSize[1] - entry.rect[3]) / 2 - entry.offset[1];
+                std::vector<int32_t> vertices;
+                std::vector<int32_t> verticesUV;
+                for (unsigned int v = 0; v < triangles.vertCount; ++v)
+                {
+                    const float tx = triangles.verts[v].texCoords.u * width;
+                    const float ty = triangles.verts[v].texCoords.v * height;
+                    Vec2 local     = entry.rotated ? Vec2(ty - entry.rect[1], entry.rect[0] + entry.rect[3] - tx)
+                                                   : Vec2(tx - entry.rect[0], ty - entry.rect[1]);
+                    vertices.emplace_back(static_cast<int32_t>(std::lround(left + local.x)));
+                    vertices.emplace_back(static_cast<int32_t>(std::lround(top + local.y)));
+                    verticesUV.emplace_back(static_cast<int32_t>(std::lround(tx)));
+                    verticesUV.emplace_back(static_cast<int32_t>(std::lround(ty)));
+                }
+
+                entry.vertexBegin = static_cast<uint32_t>(ints.size());
+                entry.vertexCount = static_cast<uint32_t>(vertices.size());
+                ints.insert(ints.end(), vertices.begin(), vertices.end());
+                ints.insert(ints.end(), verticesUV.begin(), verticesUV.end());
+                entry.indexBegin = static_cast<uint32_t>(ints.size());
+                entry.indexCount = static_cast<uint32_t>(triangles.indexCount);
+                ints.insert(ints.end(), triangles.indices, triangles.indices + triangles.indexCount);
+            }
+        }
+    }
+    AX_SAFE_RELEASE(image);
+
+    // the first of duplicated names wins, like the first frame added to SpriteFrameCache
+    std::stable_sort(names.begin(), names.end(), [](auto& a, auto& b) { return a.first < b.first; });
+    names.erase(std::unique(names.begin(), names.end(), [](auto& a, auto& b) { return a.first == b.first; }),
+                names.end());
+
+    std::string strings;
+    auto addString = [&strings](std::string_view str) {
+        StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size())};
+        strings.append(str);
+        return ref;
+    };
+
+    FileHeader header{};
+    memcpy(header.magic, SSHB_MAGIC, sizeof(SSHB_MAGIC));
+    header.version         = VERSION;
+    header.pixelFormat     = static_cast<int32_t>(pixelFormatFromName(pixelFormatName));
+    header.textureSize[0]  = textureSize.x;
+    header.textureSize[1]  = textureSize.y;
+    header.textureFileName = addString(textureFileName);
+
+    std::vector<NameEntry> nameEntries;
+    nameEntries.reserve(names.size());
+    for (auto&& [name, frame] : names)
+        nameEntries.emplace_back(NameEntry{addString(name), frame});
+
+    // every table is made of 4 bytes fields, the string pool is last
+    header.frameCount       = static_cast<uint32_t>(frames.size());
+    header.frameOffset      = sizeof(FileHeader);
+    header.nameCount        = static_cast<uint32_t>(nameEntries.size());
+    header.nameOffset       = static_cast<uint32_t>(header.frameOffset + frames.size() * sizeof(FrameEntry));
+    header.intCount         = static_cast<uint32_t>(ints.size());
+    header.intOffset        = static_cast<uint32_t>(header.nameOffset + nameEntries.size() * sizeof(NameEntry));
+    header.stringPoolOffset = static_cast<uint32_t>(header.intOffset + ints.size() * sizeof(int32_t));
+    header.stringPoolSize   = static_cast<uint32_t>(strings.size());
+    header.fileSize         = header.stringPoolOffset + header.stringPoolSize;
+
+    std::vector<uint8_t> buffer(header.fileSize);
+    memcpy(buffer.data(), &header, sizeof(header));
+    if (!frames.empty())
+        memcpy(buffer.data() + header.frameOffset, frames.data(), frames.size() * sizeof(FrameEntry));
+    if (!nameEntries.empty())
+        memcpy(buffer.data() + header.nameOffset, nameEntries.data(), nameEntries.size() * sizeof(NameEntry));
+    if (!ints.empty())
+        memcpy(buffer.data() + header.intOffset, ints.data(), ints.size() * sizeof(int32_t));
+    if (!strings.empty())
+        memcpy(buffer.data() + header.stringPoolOffset, strings.data(), strings.size());
+
+    return FileUtils::writeBinaryToFile(buffer.data(), buffer.size(), dstFullPath);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, SpriteFrameCache& cache)
+{
+    loadFile(filePath, {}, nullptr, cache);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache)
+{
+    loadFile(filePath, {}, texture, cache);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath,
+                                   std::string_view textureFileName,
+                                   SpriteFrameCache& cache)
+{
+    AXASSERT(!textureFileName.empty(), "texture name should not be null");
+    loadFile(filePath, textureFileName, nullptr, cache);
+}
+
+void BinarySpriteSheetLoader::load(const Data& content, Texture2D* texture, SpriteFrameCache& cache)
+{
+    if (content.isNull())
+        return;
+
+    auto index = std::make_shared<FrameIndex>();
+    if (!index->open(content))
+    {
+        AXLOGW("BinarySpriteSheetLoader: the content is not a valid ssb file");
+        return;
+    }
+    addSpriteSheet(std::move(index), "by#addSpriteFramesWithFileContent()", {}, texture, cache);
+}
+
+void BinarySpriteSheetLoader::reload(std::string_view filePath, SpriteFrameCache& cache)
+{
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+    auto index    = std::make_shared<FrameIndex>();
+    if (fullPath.empty() || !index->open(fullPath))
+        return;
+
+    auto texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(index->getTextureFileName(), filePath);
+    if (Director::getInstance()->getTextureCache()->reloadTexture(texturePath))
+        addSpriteSheet(std::move(index), filePath, texturePath, nullptr, cache);
+    else
+        AXLOGD("SpriteFrameCache: Couldn't load texture");
+}
+
+void BinarySpriteSheetLoader::loadFile(std::string_view filePath,
+                                       std::string_view textureFileName,
+                                       Texture2D* texture,
+                                       SpriteFrameCache& cache)
+{
+    // the sheets are often added again by each scene using them
+    if (cache.isSpriteFramesWithFileLoaded(filePath))
+        return;
+
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+    auto index    = std::make_shared<FrameIndex>();
+    if (fullPath.empty() || !index->open(fullPath))
+    {
+        AXLOGW("BinarySpriteSheetLoader: '{}' is not a valid ssb file", filePath);
+        return;
+    }
+    addSpriteSheet(std::move(index), filePath, textureFileName, texture, cache);
+}
+
+void BinarySpriteSheetLoader::addSpriteSheet(std::shared_ptr<FrameIndex> index,
+                                             std::string_view sheetPath,
+                                             std::string_view textureFileName,
+                                             Texture2D* texture,
+                                             SpriteFrameCache& cache)
+{
+    if (!texture)
+    {
+        auto textureCache = Director::getInstance()->getTextureCache();
+        auto texturePath  = textureFileName.empty()
+                                ? FileUtils::getInstance()->fullPathFromRelativeFile(index->getTextureFileName(), sheetPath)
+                                : std::string{textureFileName};
+        auto pixelFormat = index->getPixelFormat();
+        texture          = pixelFormat != backend::PixelFormat::NONE ? textureCache->addImage(texturePath, pixelFormat)
+                                                                     : textureCache->addImage(texturePath);
+        if (!texture)
+        {
+            AXLOGD("SpriteFrameCache: Couldn't load texture");
+            return;
+        }
+    }
+    index->setTexture(texture);
+
+    auto spriteSheet    = std::make_shared<SpriteSheet>();
+    spriteSheet->path   = sheetPath;
+    spriteSheet->format = getFormat();
+    spriteSheet->full   = true;
+    spriteSheet->index  = std::move(index);
+    cache.insertSpriteSheet(spriteSheet);
+}
+
+}  // namespace ax
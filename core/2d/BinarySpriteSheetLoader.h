@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include "2d/SpriteSheetLoader.h"
+#include "base/Data.h"
+
+namespace ax
+{
+
+/**
+ * @brief Loads the .ssb files, a preprocessed binary sprite sheet format.
+ *
+ * A .ssb file holds the frames of a sprite sheet in a table, with their names sorted in an index. Loading it only
+ * maps the file and loads the texture, the SpriteFrames are created one by one when SpriteFrameCache is first asked
+ * for them, so the sheets with thousands of frames cost nothing for the frames that are never used. The frames of
+ * the TexturePacker polygon format are kept, the nine patch cap insets are computed by the conversion.
+ *
+ * A .ssb file is created from a .plist sprite sheet with BinarySpriteSheetLoader::convert, it is loaded with
+ * SpriteFrameCache::addSpriteFramesWithFile like a .plist file.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL BinarySpriteSheetLoader : public SpriteSheetLoader
+{
+public:
+    static constexpr uint32_t FORMAT = SpriteSheetFormat::BINARY;
+
+    /** The file format version, files of other versions are rejected. */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * Convert a .plist sprite sheet to a .ssb file, the texture file name is kept relative to the sheet.
+     * With tracePolygons, the frames without a polygon of their own are traced by AutoPolygon, so that their trimmed
+     * meshes are loaded from the file instead of being traced at runtime. The texture must be RGBA8.
+     */
+    static bool convert(std::string_view plistPath,
+                        std::string_view dstFullPath,
+                        bool tracePolygons = false,
+                        float epsilon      = 2.0f,
+                        float threshold    = 0.05f);
+
+    uint32_t getFormat() override { return FORMAT; }
+    void load(std::string_view filePath, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache) override;
+    void load(const Data& content, Texture2D* texture, SpriteFrameCache& cache) override;
+    void reload(std::string_view filePath, SpriteFrameCache& cache) override;
+
+protected:
+    struct FileHeader;
+    struct StringRef;
+    struct FrameEntry;
+    struct NameEntry;
+    class FrameIndex;
+
+    void loadFile(std::string_view filePath,
+                  std::string_view textureFileName,
+                  Texture2D* texture,
+                  SpriteFrameCache& cache);
+
+    /** Adds the sheet of an index to the cache. The texture is loaded when it is null, from the file name stored in
+     the sheet when textureFileName is empty. */
+    void addSpriteSheet(std::shared_ptr<FrameIndex> index,
+                        std::string_view sheetPath,
+                        std::string_view textureFileName,
+                        Texture2D* texture,
+                        SpriteFrameCache& cache);
+};
+
+}  // namespace ax
@@ -32,6 +32,8 @@
 #include "2d/Scene.h"
 #include "renderer/Renderer.h"
 #include "renderer/QuadCommand.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/PostProcessGraph.h"
 
 namespace ax
 {
@@ -108,6 +110,8 @@ Camera::Camera()
 Camera::~Camera()
 {
     AX_SAFE_RELEASE(_clearBrush);
+    AX_SAFE_RELEASE(_dynamicResolution);
+    AX_SAFE_RELEASE(_postProcess);
 }
 
 const Mat4& Camera::getProjectionMatrix() const
@@ -373,14 +377,24 @@ void Camera::unprojectGL(const Vec2& viewport, const Vec3* src, Vec3* dst) const
 }
 
 #if defined(AX_ENABLE_3D)
-bool Camera::isVisibleInFrustum(const AABB* aabb) const
+const Frustum& Camera::getFrustum() const
 {
     if (_frustumDirty)
     {
         _frustum.initFrustum(this);
         _frustumDirty = false;
     }
-    return !_frustum.isOutOfFrustum(*aabb);
+    return _frustum;
+}
+
+bool Camera::isVisibleInFrustum(const AABB* aabb) const
+{
+    return !getFrustum().isOutOfFrustum(*aabb);
+}
+
+void Camera::cullInFrustum(const BoundsBatch& batch, std::vector<uint32_t>& visibility) const
+{
+    getFrustum().cull(batch, visibility);
 }
 #endif
 
@@ -551,6 +565,20 @@ void Camera::setBackgroundBrush(CameraBackgroundBrush* clearBrush)
     _clearBrush = clearBrush;
 }
 
+void Camera::setDynamicResolution(DynamicResolution* dynamicResolution)
+{
+    AX_SAFE_RETAIN(dynamicResolution);
+    AX_SAFE_RELEASE(_dynamicResolution);
+    _dynamicResolution = dynamicResolution;
+}
+
+void Camera::setPostProcess(PostProcessGraph* postProcess)
+{
+    AX_SAFE_RETAIN(postProcess);
+    AX_SAFE_RELEASE(_postProcess);
+    _postProcess = postProcess;
+}
+
 bool Camera::isBrushValid()
 {
     return _clearBrush != nullptr && _clearBrush->isValid();
@@ -41,6 +41,8 @@ namespace ax
 
 class Scene;
 class CameraBackgroundBrush;
+class DynamicResolution;
+class PostProcessGraph;
 
 /**
  * Note:
@@ -195,10 +197,18 @@ public:
     void unprojectGL(const Vec2& size, const Vec3* src, Vec3* dst) const;
 
 #if defined(AX_ENABLE_3D)
+    /**
+     * The frustum of the camera in world space, computed again when the camera moved.
+     */
+    const Frustum& getFrustum() const;
     /**
      * Is this aabb visible in frustum
      */
     bool isVisibleInFrustum(const AABB* aabb) const;
+    /**
+     * Tests a batch of volumes against the frustum at once, see Frustum::cull
+     */
+    void cullInFrustum(const BoundsBatch& batch, std::vector<uint32_t>& visibility) const;
 #endif
 
     /**
@@ -317,6 +327,22 @@ public:
      */
     CameraBackgroundBrush* getBackgroundBrush() const { return _clearBrush; }
 
+    /**
+     * Render this camera at a scaled resolution that follows the frame time, and upscale it to the viewport.
+     * Typically set on the 3D camera, the cameras drawn after it (the UI) stay at the native resolution.
+     * @param dynamicResolution The scaling of the resolution, nullptr to render at the native resolution.
+     */
+    void setDynamicResolution(DynamicResolution* dynamicResolution);
+    DynamicResolution* getDynamicResolution() const { return _dynamicResolution; }
+
+    /**
+     * Render this camera offscreen and run the fullscreen passes of the graph on it, e.g. a bloom or a color grading.
+     * With a dynamic resolution too, the passes run at the scaled resolution before the upscale.
+     * @param postProcess The passes, nullptr to render the camera directly.
+     */
+    void setPostProcess(PostProcessGraph* postProcess);
+    PostProcessGraph* getPostProcess() const { return _postProcess; }
+
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
 
     bool isBrushValid();
@@ -375,7 +401,9 @@ protected:
     float _zoomFactorFarPlane;
     float _zoomFactorNearPlane;
 
-    CameraBackgroundBrush* _clearBrush = nullptr;  // brush used to clear the back ground
+    CameraBackgroundBrush* _clearBrush    = nullptr;  // brush used to clear the back ground
+    DynamicResolution* _dynamicResolution = nullptr;
+    PostProcessGraph* _postProcess        = nullptr;
 };
 
 }
@@ -27,11 +27,15 @@
  *
  */
 #include "2d/ClippingNode.h"
+#include "2d/Camera.h"
+#include "2d/Layer.h"
+#include "2d/Sprite.h"
 #include "renderer/Renderer.h"
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
 #include "base/Director.h"
 #include "base/StencilStateManager.h"
+#include "platform/GLView.h"
 
 namespace ax
 {
@@ -51,6 +55,7 @@ ClippingNode::~ClippingNode()
     {
         AX_SAFE_RELEASE(stencilProgramState.second);
     }
+    restoreMaskedProgramStates(true);
 }
 
 ClippingNode* ClippingNode::create()
@@ -150,6 +155,49 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
 
+    if (updateMask())
+        visitChildren(renderer, flags);
+    else if (_clipMode == ClipMode::AUTO && getStencilRect(_scissorRect))
+        visitScissor(renderer, flags);
+    else
+        visitStencil(renderer, flags);
+
+    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void ClippingNode::visitChildren(Renderer* renderer, uint32_t flags)
+{
+    bool visibleByCamera = isVisitableByVisitingCamera();
+
+    if (!_children.empty())
+    {
+        sortAllChildren();
+        // draw children zOrder < 0
+        int i = 0;
+        for (int size = static_cast<int>(_children.size()); i < size; ++i)
+        {
+            auto node = _children.at(i);
+
+            if (node && node->getLocalZOrder() < 0)
+                node->visit(renderer, _modelViewTransform, flags);
+            else
+                break;
+        }
+        // self draw
+        if (visibleByCamera)
+            this->draw(renderer, _modelViewTransform, flags);
+
+        for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
+            (*it)->visit(renderer, _modelViewTransform, flags);
+    }
+    else if (visibleByCamera)
+    {
+        this->draw(renderer, _modelViewTransform, flags);
+    }
+}
+
+void ClippingNode::visitStencil(Renderer* renderer, uint32_t flags)
+{
     // Add group command
 
     auto* groupCommandStencil = renderer->getNextGroupCommand();
@@ -182,8 +230,6 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     afterDrawStencilCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterDrawStencil, _stencilStateManager);
     renderer->addCommand(afterDrawStencilCmd);
 
-    bool visibleByCamera = isVisitableByVisitingCamera();
-
     // `_groupCommandChildren` is used as a barrier
     // to ensure commands above be executed before children nodes
     auto* groupCommandChildren = renderer->getNextGroupCommand();
@@ -193,31 +239,7 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
 
     renderer->pushGroup(groupCommandChildren->getRenderQueueID());
 
-    if (!_children.empty())
-    {
-        sortAllChildren();
-        // draw children zOrder < 0
-        int i = 0;
-        for (int size = static_cast<int>(_children.size()); i < size; ++i)
-        {
-            auto node = _children.at(i);
-
-            if (node && node->getLocalZOrder() < 0)
-                node->visit(renderer, _modelViewTransform, flags);
-            else
-                break;
-        }
-        // self draw
-        if (visibleByCamera)
-            this->draw(renderer, _modelViewTransform, flags);
-
-        for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
-    }
-    else if (visibleByCamera)
-    {
-        this->draw(renderer, _modelViewTransform, flags);
-    }
+    visitChildren(renderer, flags);
 
     renderer->popGroup();
 
@@ -227,8 +249,229 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
     renderer->addCommand(_afterVisitCmd);
 
     renderer->popGroup();
+}
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+void ClippingNode::visitScissor(Renderer* renderer, uint32_t flags)
+{
+    // no stencil draw and clear, the group keeps the children between the scissor commands
+    auto* groupCommand = renderer->getNextGroupCommand();
+    groupCommand->init(_globalZOrder);
+    renderer->addCommand(groupCommand);
+    renderer->pushGroup(groupCommand->getRenderQueueID());
+
+    auto beforeVisitCmd = renderer->nextCallbackCommand();
+    beforeVisitCmd->init(_globalZOrder);
+    beforeVisitCmd->func = AX_CALLBACK_0(ClippingNode::onBeforeVisitScissor, this);
+    renderer->addCommand(beforeVisitCmd);
+
+    visitChildren(renderer, flags);
+
+    auto afterVisitCmd = renderer->nextCallbackCommand();
+    afterVisitCmd->init(_globalZOrder);
+    afterVisitCmd->func = AX_CALLBACK_0(ClippingNode::onAfterVisitScissor, this);
+    renderer->addCommand(afterVisitCmd);
+
+    renderer->popGroup();
+}
+
+bool ClippingNode::getStencilRect(Rect& rect) const
+{
+    if (isInverted() || getAlphaThreshold() < 1 || !_stencil->isVisible() || !_stencil->getChildren().empty())
+        return false;
+
+    // the scissor is in the points of the window, only the default camera is known to cover it
+    auto camera = Camera::getVisitingCamera();
+    if (!camera || camera != Camera::getDefaultCamera())
+        return false;
+
+    Rect local;
+    if (auto sprite = dynamic_cast<Sprite*>(_stencil))
+    {
+        // a polygon or a 9-slice sprite may not cover its quad
+        if (sprite->getPolygonInfo().getVertCount() != 4)
+            return false;
+        const auto& quad = sprite->getQuad();
+        local = Rect(quad.bl.vertices.x, quad.bl.vertices.y, quad.tr.vertices.x - quad.bl.vertices.x,
+                     quad.tr.vertices.y - quad.bl.vertices.y);
+    }
+    else if (dynamic_cast<LayerColor*>(_stencil))
+        local = Rect(Vec2::ZERO, _stencil->getContentSize());
+    else
+        return false;
+
+    // the corners on screen must stay an axis-aligned rectangle
+    const auto transform = _modelViewTransform * _stencil->getNodeToParentTransform();
+    Vec2 corners[4];
+    const float xs[] = {local.getMinX(), local.getMaxX(), local.getMaxX(), local.getMinX()};
+    const float ys[] = {local.getMinY(), local.getMinY(), local.getMaxY(), local.getMaxY()};
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec3 point(xs[i], ys[i], 0.0f);
+        transform.transformPoint(&point);
+        corners[i] = camera->projectGL(point);
+    }
+
+    float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+    for (auto&& corner : corners)
+    {
+        minX = std::min(minX, corner.x);
+        maxX = std::max(maxX, corner.x);
+        minY = std::min(minY, corner.y);
+        maxY = std::max(maxY, corner.y);
+    }
+
+    // every corner of an axis-aligned rectangle is on the bounds in both axes, a rotated one isn't
+    constexpr float EPSILON = 0.01f;
+    auto onBounds           = [](float value, float min, float max) {
+        return std::abs(value - min) < EPSILON || std::abs(value - max) < EPSILON;
+    };
+    for (auto&& corner : corners)
+    {
+        if (!onBounds(corner.x, minX, maxX) || !onBounds(corner.y, minY, maxY))
+            return false;
+    }
+
+    rect = Rect(minX, minY, maxX - minX, maxY - minY);
+    return true;
+}
+
+void ClippingNode::onBeforeVisitScissor()
+{
+    auto renderer = _director->getRenderer();
+    auto glView   = _director->getGLView();
+
+    Rect rect       = _scissorRect;
+    _oldScissorTest = renderer->getScissorTest();
+    if (_oldScissorTest)
+    {
+        // nested in another clipping, only the intersection is drawn
+        _oldScissorRect  = glView->getScissorRect();
+        const float minX = std::max(rect.getMinX(), _oldScissorRect.getMinX());
+        const float minY = std::max(rect.getMinY(), _oldScissorRect.getMinY());
+        const float maxX = std::min(rect.getMaxX(), _oldScissorRect.getMaxX());
+        const float maxY = std::min(rect.getMaxY(), _oldScissorRect.getMaxY());
+        rect             = Rect(minX, minY, std::max(maxX - minX, 0.0f), std::max(maxY - minY, 0.0f));
+    }
+
+    renderer->setScissorTest(true);
+    glView->setScissorInPoints(rect.origin.x, rect.origin.y, rect.size.width, rect.size.height);
+}
+
+void ClippingNode::onAfterVisitScissor()
+{
+    if (_oldScissorTest)
+        _director->getGLView()->setScissorInPoints(_oldScissorRect.origin.x, _oldScissorRect.origin.y,
+                                                   _oldScissorRect.size.width, _oldScissorRect.size.height);
+    else
+        _director->getRenderer()->setScissorTest(false);
+}
+
+bool ClippingNode::updateMask()
+{
+    auto sprite = _clipMode == ClipMode::ALPHA_MASK || _clipMode == ClipMode::SDF_MASK
+                      ? dynamic_cast<Sprite*>(_stencil)
+                      : nullptr;
+    if (!sprite || !sprite->getTexture() || sprite->getPolygonInfo().getVertCount() != 4)
+    {
+        restoreMaskedProgramStates(true);
+        return false;
+    }
+
+    const auto& quad   = sprite->getQuad();
+    const float width  = quad.br.vertices.x - quad.bl.vertices.x;
+    const float height = quad.tl.vertices.y - quad.bl.vertices.y;
+    if (width == 0 || height == 0)
+    {
+        restoreMaskedProgramStates(true);
+        return false;
+    }
+
+    // from the space of the batched vertices to the unit square of the quad of the stencil
+    Mat4 toQuad;
+    Mat4::createScale(1.0f / width, 1.0f / height, 1.0f, &toQuad);
+    toQuad.translate(-quad.bl.vertices.x, -quad.bl.vertices.y, 0.0f);
+    _maskMatrix = toQuad * (_modelViewTransform * _stencil->getNodeToParentTransform()).getInversed();
+
+    // the texture coords along the sides of the quad, a rotated frame of an atlas swaps them
+    const auto& origin = quad.bl.texCoords;
+    _maskAxes          = Vec4(quad.br.texCoords.u - origin.u, quad.br.texCoords.v - origin.v,
+                              quad.tl.texCoords.u - origin.u, quad.tl.texCoords.v - origin.v);
+    _maskParams        = Vec4(origin.u, origin.v, _clipMode == ClipMode::SDF_MASK ? 1.0f : 0.0f,
+                              isInverted() ? 1.0f : 0.0f);
+    _maskTexture       = sprite->getTexture()->getBackendTexture();
+
+    ++_maskFrame;
+    for (auto&& child : _children)
+        updateMaskRecursively(child);
+    restoreMaskedProgramStates(false);
+    return true;
+}
+
+void ClippingNode::updateMaskRecursively(Node* node)
+{
+    auto programState = node->getProgramState();
+    if (programState)
+    {
+        auto it = _maskedNodes.find(node);
+        if (it != _maskedNodes.end() && it->second.mask != programState)
+        {
+            // the program state was replaced since, it isn't restored
+            AX_SAFE_RELEASE(it->second.original);
+            AX_SAFE_RELEASE(it->second.mask);
+            node->release();
+            _maskedNodes.erase(it);
+            it = _maskedNodes.end();
+        }
+
+        if (it == _maskedNodes.end() &&
+            programState->getProgram()->getProgramType() == backend::ProgramType::POSITION_TEXTURE_COLOR)
+        {
+            auto* program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_MASK);
+            MaskedNode masked;
+            masked.original = programState;
+            masked.mask     = new backend::ProgramState(program);
+            AX_SAFE_RETAIN(masked.original);
+            node->retain();
+            node->setProgramState(masked.mask);
+            it = _maskedNodes.emplace(node, masked).first;
+        }
+
+        if (it != _maskedNodes.end())
+        {
+            auto mask = it->second.mask;
+            mask->setUniform(mask->getUniformLocation("u_maskMatrix"), _maskMatrix.m, sizeof(_maskMatrix.m));
+            mask->setUniform(mask->getUniformLocation("u_maskAxes"), &_maskAxes, sizeof(_maskAxes));
+            mask->setUniform(mask->getUniformLocation("u_maskParams"), &_maskParams, sizeof(_maskParams));
+            mask->setTexture(mask->getUniformLocation("u_tex1"), 1, _maskTexture);
+            // the children of all the clipping nodes share the program, the uniforms tell them apart
+            mask->updateBatchId();
+            it->second.frame = _maskFrame;
+        }
+    }
+
+    for (auto&& child : node->getChildren())
+        updateMaskRecursively(child);
+}
+
+void ClippingNode::restoreMaskedProgramStates(bool all)
+{
+    for (auto it = _maskedNodes.begin(); it != _maskedNodes.end();)
+    {
+        auto& masked = it->second;
+        if (!all && masked.frame == _maskFrame)
+        {
+            ++it;
+            continue;
+        }
+
+        auto node = it->first;
+        if (node->getProgramState() == masked.mask)
+            node->setProgramState(masked.original);
+        AX_SAFE_RELEASE(masked.original);
+        AX_SAFE_RELEASE(masked.mask);
+        node->release();
+        it = _maskedNodes.erase(it);
+    }
 }
 
 void ClippingNode::setGlobalZOrder(float globalZOrder)
@@ -349,6 +592,13 @@ void ClippingNode::setInverted(bool inverted)
     _stencilStateManager->setInverted(inverted);
 }
 
+void ClippingNode::setClipMode(ClipMode clipMode)
+{
+    _clipMode = clipMode;
+    if (_clipMode != ClipMode::ALPHA_MASK && _clipMode != ClipMode::SDF_MASK)
+        restoreMaskedProgramStates(true);
+}
+
 void ClippingNode::setProgramStateRecursively(Node* node, backend::ProgramState* programState)
 {
     if (_originalStencilProgramState.find(node) == _originalStencilProgramState.end())
@@ -49,6 +49,23 @@ class StencilStateManager;
 class AX_DLL ClippingNode : public Node
 {
 public:
+    /** How the children are clipped. */
+    enum class ClipMode
+    {
+        /** The scissor test when the stencil is an axis-aligned rectangle, the stencil buffer otherwise. */
+        AUTO,
+        /** Always the stencil buffer. */
+        STENCIL,
+        /**
+         * The alpha of the stencil, which must be a Sprite, multiplies the children. It is done in the shader of the
+         * children, so they stay batchable with each other and the edges are soft. Only the children drawn with the
+         * default sprite shader are masked.
+         */
+        ALPHA_MASK,
+        /** Same as ALPHA_MASK, with a distance field in the texture of the stencil, the edge is at 0.5. */
+        SDF_MASK,
+    };
+
     /** Creates and initializes a clipping node without a stencil.
      *
      * @return An autorelease ClippingNode.
@@ -119,6 +136,10 @@ public:
      */
     void setInverted(bool inverted);
 
+    /** The clip mode, AUTO by default. The masks fall back to the stencil buffer when the stencil isn't a Sprite. */
+    ClipMode getClipMode() const { return _clipMode; }
+    void setClipMode(ClipMode clipMode);
+
     // Overrides
     /**
      * @lua NA
@@ -163,6 +184,27 @@ protected:
     void setProgramStateRecursively(Node* node, backend::ProgramState* programState);
     void restoreAllProgramStates();
 
+    void visitChildren(Renderer* renderer, uint32_t flags);
+    void visitStencil(Renderer* renderer, uint32_t flags);
+    void visitScissor(Renderer* renderer, uint32_t flags);
+    /// the rectangle in world space when the stencil is an axis-aligned rectangle that isn't alpha tested
+    bool getStencilRect(Rect& rect) const;
+    void onBeforeVisitScissor();
+    void onAfterVisitScissor();
+
+    /// sets the mask program state on the children drawn with the sprite shader, false when there is no mask
+    bool updateMask();
+    void updateMaskRecursively(Node* node);
+    /// restores the program states of the nodes not masked this frame, or of all
+    void restoreMaskedProgramStates(bool all);
+
+    struct MaskedNode
+    {
+        backend::ProgramState* original = nullptr;
+        backend::ProgramState* mask     = nullptr;
+        unsigned int frame              = 0;
+    };
+
     bool _uniqueChildStencils                 = false;
     Node* _stencil                            = nullptr;
     StencilStateManager* _stencilStateManager = nullptr;
@@ -171,6 +213,19 @@ protected:
     //CallbackCommand _afterVisitCmd;
     std::unordered_map<Node*, backend::ProgramState*> _originalStencilProgramState;
 
+    ClipMode _clipMode = ClipMode::AUTO;
+    Rect _scissorRect;
+    Rect _oldScissorRect;
+    bool _oldScissorTest = false;
+
+    // the nodes are retained while they are masked, the mask uniforms are the same for all of them
+    std::unordered_map<Node*, MaskedNode> _maskedNodes;
+    Mat4 _maskMatrix;
+    Vec4 _maskAxes;
+    Vec4 _maskParams;
+    backend::TextureBackend* _maskTexture = nullptr;
+    unsigned int _maskFrame               = 0;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ClippingNode);
 };
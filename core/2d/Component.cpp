@@ -24,11 +24,12 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "2d/Component.h"
+#include "2d/Node.h"
 
 namespace ax
 {
 
-Component::Component() : _owner(nullptr), _enabled(true) {}
+Component::Component() : _owner(nullptr), _enabled(true), _parallelUpdate(false) {}
 
 Component::~Component() {}
 
@@ -73,6 +74,13 @@ void Component::setOwner(Node* owner)
     _owner = owner;
 }
 
+void Component::setParallelUpdateEnabled(bool enabled)
+{
+    _parallelUpdate = enabled;
+    if (enabled && _owner)
+        _owner->scheduleParallelUpdate();
+}
+
 void Component::setEnabled(bool enabled)
 {
     _enabled = enabled;
@@ -68,6 +68,13 @@ public:
     virtual void setOwner(Node* owner);
 
     virtual void update(float delta);
+
+    /**
+     * A parallel safe component is updated in the parallel update phase of its owner, on a JobSystem worker, instead
+     * of with the other components. Its update must not change the scene graph, see Scheduler::scheduleParallel.
+     */
+    void setParallelUpdateEnabled(bool enabled);
+    bool isParallelUpdateEnabled() const { return _parallelUpdate; }
     virtual bool serialize(void* r);
 
     virtual void onEnter();
@@ -84,6 +91,7 @@ protected:
     Node* _owner;
     std::string _name;
     bool _enabled;
+    bool _parallelUpdate;
 };
 
 }
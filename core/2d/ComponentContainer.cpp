@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "2d/Component.h"
 #include "2d/Node.h"
 
+#include <algorithm>
+
 namespace ax
 {
 
@@ -36,15 +38,12 @@ ComponentContainer::~ComponentContainer() {}
 
 Component* ComponentContainer::get(std::string_view name) const
 {
-    Component* ret = nullptr;
-
-    auto it = _componentMap.find(name);
-    if (it != _componentMap.end())
+    for (auto component : _components)
     {
-        ret = it->second;
+        if (component->getName() == name)
+            return component;
     }
-
-    return ret;
+    return nullptr;
 }
 
 bool ComponentContainer::add(Component* com)
@@ -54,14 +53,12 @@ bool ComponentContainer::add(Component* com)
     AXASSERT(com->getOwner() == nullptr, "Component already added. It can't be added again");
     do
     {
-        auto componentName = com->getName();
-
-        if (_componentMap.find(componentName) != _componentMap.end())
+        if (get(com->getName()) != nullptr)
         {
             AXASSERT(false, "ComponentContainer already have this kind of component");
             break;
         }
-        hlookup::set_item(_componentMap, componentName, com);  //_componentMap[componentName] = com;
+        _components.emplace_back(com);
         com->retain();
         com->setOwner(_owner);
         com->onAdd();
@@ -73,23 +70,18 @@ bool ComponentContainer::add(Component* com)
 
 bool ComponentContainer::remove(std::string_view componentName)
 {
-    bool ret = false;
-    do
-    {
-        auto iter = _componentMap.find(componentName);
-        AX_BREAK_IF(iter == _componentMap.end());
-
-        auto component = iter->second;
-        _componentMap.erase(componentName);
-
-        component->onRemove();
-        component->setOwner(nullptr);
-        component->release();
-
-        ret = true;
-    } while (0);
-
-    return ret;
+    auto iter = std::find_if(_components.begin(), _components.end(),
+                             [componentName](Component* component) { return component->getName() == componentName; });
+    if (iter == _components.end())
+        return false;
+
+    auto component = *iter;
+    _components.erase(iter);
+
+    component->onRemove();
+    component->setOwner(nullptr);
+    component->release();
+    return true;
 }
 
 bool ComponentContainer::remove(Component* com)
@@ -99,46 +91,58 @@ bool ComponentContainer::remove(Component* com)
 
 void ComponentContainer::removeAll()
 {
-    if (!_componentMap.empty())
+    if (!_components.empty())
     {
-        for (auto&& iter : _componentMap)
+        for (auto component : _components)
         {
-            iter.second->onRemove();
-            iter.second->setOwner(nullptr);
-            iter.second->release();
+            component->onRemove();
+            component->setOwner(nullptr);
+            component->release();
         }
 
-        _componentMap.clear();
+        _components.clear();
         _owner->unscheduleUpdate();
+        _owner->unscheduleParallelUpdate();
     }
 }
 
 void ComponentContainer::visit(float delta)
 {
-    if (!_componentMap.empty())
+    if (!_components.empty())
     {
         AX_SAFE_RETAIN(_owner);
-        for (auto&& iter : _componentMap)
+        for (auto component : _components)
         {
-            iter.second->update(delta);
+            if (!component->isParallelUpdateEnabled())
+                component->update(delta);
         }
         AX_SAFE_RELEASE(_owner);
     }
 }
 
+void ComponentContainer::visitParallel(float delta)
+{
+    // on a worker, the owner isn't retained, it can't be released before the phase is over
+    for (auto component : _components)
+    {
+        if (component->isParallelUpdateEnabled())
+            component->update(delta);
+    }
+}
+
 void ComponentContainer::onEnter()
 {
-    for (auto&& iter : _componentMap)
+    for (auto component : _components)
     {
-        iter.second->onEnter();
+        component->onEnter();
     }
 }
 
 void ComponentContainer::onExit()
 {
-    for (auto&& iter : _componentMap)
+    for (auto component : _components)
     {
-        iter.second->onExit();
+        component->onExit();
     }
 }
 
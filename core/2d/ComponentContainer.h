@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include "base/Map.h"
 #include <string>
+#include <vector>
 
 namespace ax
 {
@@ -62,14 +63,17 @@ public:
     bool remove(Component* com);
     void removeAll();
     void visit(float delta);
+    /** Updates the parallel components, from the parallel update phase of the owner. */
+    void visitParallel(float delta);
 
     void onEnter();
     void onExit();
 
-    bool isEmpty() const { return _componentMap.empty(); }
+    bool isEmpty() const { return _components.empty(); }
 
 private:
-    hlookup::string_map<Component*> _componentMap;
+    // nodes have a few components, a linear search beats the hashing of the names
+    std::vector<Component*> _components;
     Node* _owner;
 
     friend class Node;
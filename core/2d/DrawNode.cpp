@@ -34,8 +34,11 @@
 #include "base/EventDispatcher.h"
 #include "2d/ActionCatmullRom.h"
 #include "base/Utils.h"
+#include "math/MathUtil.h"
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/Buffer.h"
 #include "poly2tri/poly2tri.h"
 
 namespace ax
@@ -72,6 +75,8 @@ static bool isConvex(const Vec2* verts, int count)
     return true;  // is convex
 }
 
+static_assert(sizeof(V2F_C4B_T2F_T4F_C4B) == 2 * sizeof(V2F_C4B_T2F), "a shape vertex takes two elements");
+
 static V2F_C4B_T2F* expandBufferAndGetPointer(axstd::pod_vector<V2F_C4B_T2F>& buffer, size_t count)
 {
     size_t oldSize = buffer.size();
@@ -103,6 +108,10 @@ DrawNode::~DrawNode()
     freeShaderInternal(_customCommandTriangle);
     freeShaderInternal(_customCommandPoint);
     freeShaderInternal(_customCommandLine);
+    freeShaderInternal(_customCommandShape);
+
+    for (auto&& state : _geometryBuffers)
+        AX_SAFE_RELEASE(state.buffer);
 }
 
 DrawNode* DrawNode::create()
@@ -127,6 +136,7 @@ bool DrawNode::init()
     _trianglesDirty = true;
     _pointsDirty = true;
     _linesDirty  = true;
+    _shapesDirty = true;
 
     return true;
 }
@@ -141,6 +151,9 @@ void DrawNode::updateShader()
 
     updateShaderInternal(_customCommandLine, backend::ProgramType::POSITION_COLOR_LENGTH_TEXTURE,
                          CustomCommand::DrawType::ARRAY, CustomCommand::PrimitiveType::LINE);
+
+    updateShaderInternal(_customCommandShape, backend::ProgramType::DRAW_NODE_SHAPE,
+                         CustomCommand::DrawType::ARRAY, CustomCommand::PrimitiveType::TRIANGLE);
 }
 
 void DrawNode::updateShaderInternal(CustomCommand& cmd,
@@ -161,7 +174,8 @@ void DrawNode::updateShaderInternal(CustomCommand& cmd,
 void DrawNode::setVertexLayout(CustomCommand& cmd)
 {
     auto* programState = cmd.getPipelineDescriptor().programState;
-    programState->validateSharedVertexLayout(backend::VertexLayoutType::DrawNode);
+    programState->validateSharedVertexLayout(&cmd == &_customCommandShape ? backend::VertexLayoutType::DrawNodeShape
+                                                                          : backend::VertexLayoutType::DrawNode);
 }
 
 void DrawNode::freeShaderInternal(CustomCommand& cmd)
@@ -207,8 +221,8 @@ void DrawNode::updateUniforms(const Mat4& transform, CustomCommand& cmd)
 
 void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    if (_trianglesDirty || _pointsDirty || _linesDirty)
-        updateBuffers();
+    AXASSERT(!_recording, "DrawNode: a group is being recorded, call endGroup");
+    updateBuffers(renderer);
 
     if (_customCommandTriangle.getVertexDrawCount() > 0)
     {
@@ -233,44 +247,341 @@ void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         _customCommandLine.init(_globalZOrder);
         renderer->addCommand(&_customCommandLine);
     }
+
+    if (_customCommandShape.getVertexDrawCount() > 0)
+    {
+        updateBlendState(_customCommandShape);
+        updateUniforms(transform, _customCommandShape);
+        _customCommandShape.init(_globalZOrder);
+        renderer->addCommand(&_customCommandShape);
+    }
+}
+
+axstd::pod_vector<V2F_C4B_T2F>& DrawNode::getGeometry(int type)
+{
+    switch (type)
+    {
+    case GEOMETRY_TRIANGLES:
+        return _triangles;
+    case GEOMETRY_POINTS:
+        return _points;
+    case GEOMETRY_LINES:
+        return _lines;
+    default:
+        return _shapes;
+    }
+}
+
+CustomCommand& DrawNode::getGeometryCommand(int type)
+{
+    switch (type)
+    {
+    case GEOMETRY_TRIANGLES:
+        return _customCommandTriangle;
+    case GEOMETRY_POINTS:
+        return _customCommandPoint;
+    case GEOMETRY_LINES:
+        return _customCommandLine;
+    default:
+        return _customCommandShape;
+    }
+}
+
+size_t DrawNode::getVertexElements(int type)
+{
+    return type == GEOMETRY_SHAPES ? 2 : 1;
+}
+
+size_t DrawNode::getPrimitiveElements(int type)
+{
+    switch (type)
+    {
+    case GEOMETRY_TRIANGLES:
+        return 3;
+    case GEOMETRY_POINTS:
+        return 1;
+    case GEOMETRY_LINES:
+        return 2;
+    default:
+        return 6 * getVertexElements(type);
+    }
+}
+
+bool DrawNode::isGeometryDirty(int type) const
+{
+    switch (type)
+    {
+    case GEOMETRY_TRIANGLES:
+        return _trianglesDirty;
+    case GEOMETRY_POINTS:
+        return _pointsDirty;
+    case GEOMETRY_LINES:
+        return _linesDirty;
+    default:
+        return _shapesDirty;
+    }
 }
 
-static void udpateCommand(CustomCommand& cmd, const axstd::pod_vector<V2F_C4B_T2F>& buffer)
+void DrawNode::setGeometryDirty(int type, bool dirty)
 {
-    if (buffer.empty())
+    switch (type)
     {
-        cmd.setVertexBuffer(nullptr);
+    case GEOMETRY_TRIANGLES:
+        _trianglesDirty = dirty;
+        break;
+    case GEOMETRY_POINTS:
+        _pointsDirty = dirty;
+        break;
+    case GEOMETRY_LINES:
+        _linesDirty = dirty;
+        break;
+    default:
+        _shapesDirty = dirty;
+        break;
+    }
+}
+
+void DrawNode::markGeometryDirty(int type, size_t begin, size_t end)
+{
+    auto& state = _geometryBuffers[type];
+    if (state.dirtyBegin == state.dirtyEnd)
+    {
+        state.dirtyBegin = begin;
+        state.dirtyEnd   = end;
     }
     else
     {
-        cmd.createVertexBuffer(sizeof(V2F_C4B_T2F), buffer.size(), CustomCommand::BufferUsage::STATIC);
-        cmd.updateVertexBuffer(buffer.data(), buffer.size() * sizeof(V2F_C4B_T2F));
+        state.dirtyBegin = (std::min)(state.dirtyBegin, begin);
+        state.dirtyEnd   = (std::max)(state.dirtyEnd, end);
+    }
+    setGeometryDirty(type, true);
+}
+
+void DrawNode::uploadGeometry(int type, CustomCommand& cmd)
+{
+    const size_t stride = sizeof(V2F_C4B_T2F);
+    auto& geometry      = getGeometry(type);
+    auto& state         = _geometryBuffers[type];
+    const size_t count  = geometry.size();
+
+    if (count > 0 && (!state.buffer || state.buffer->getSize() < count * stride))
+    {
+        // grow geometrically, the buffer is kept when the geometry shrinks
+        size_t capacity = (std::max)(count, state.buffer ? state.buffer->getSize() / stride * 2 : 0);
+        AX_SAFE_RELEASE(state.buffer);
+        state.buffer   = backend::DriverBase::getInstance()->newBuffer(capacity * stride, backend::BufferType::VERTEX,
+                                                                        backend::BufferUsage::STATIC);
+        state.uploaded = 0;
+    }
+
+    // the appended vertices and the ranges rewritten by the groups
+    size_t begin = count, end = 0;
+    if (state.uploaded < count)
+    {
+        begin = state.uploaded;
+        end   = count;
+    }
+    if (state.dirtyBegin < state.dirtyEnd)
+    {
+        begin = (std::min)(begin, state.dirtyBegin);
+        end   = (std::max)(end, (std::min)(state.dirtyEnd, count));
     }
+    if (begin < end)
+        state.buffer->updateSubData(geometry.data() + begin, begin * stride, (end - begin) * stride);
 
-    cmd.setVertexDrawInfo(0, buffer.size());
+    state.uploaded   = count;
+    state.dirtyBegin = state.dirtyEnd = 0;
+
+    cmd.setVertexBuffer(state.buffer);
+    cmd.setVertexDrawInfo(0, count / getVertexElements(type));
+}
+
+bool DrawNode::streamGeometry(Renderer* renderer, int type, CustomCommand& cmd)
+{
+    const size_t stride = sizeof(V2F_C4B_T2F) * getVertexElements(type);
+    auto& geometry      = getGeometry(type);
+    if (geometry.empty())
+    {
+        cmd.setVertexDrawInfo(0, 0);
+        return true;
+    }
+
+    size_t offset = 0;
+    const size_t count = geometry.size() / getVertexElements(type);
+    auto buffer        = renderer->streamVertices(geometry.data(), count * stride, stride, offset);
+    if (!buffer)
+        return false;
+
+    cmd.setVertexBuffer(buffer);
+    cmd.setVertexDrawInfo(offset / stride, count);
+
+    // the node buffer is stale now, it's uploaded whole once used again
+    _geometryBuffers[type].uploaded = 0;
+    return true;
 }
 
-void DrawNode::updateBuffers()
+void DrawNode::updateBuffers(Renderer* renderer)
 {
-    if (_trianglesDirty)
+    for (int type = 0; type < GEOMETRY_COUNT; ++type)
     {
-        _trianglesDirty = false;
-        udpateCommand(_customCommandTriangle, _triangles);
+        auto& cmd = getGeometryCommand(type);
+        if (_transient && streamGeometry(renderer, type, cmd))
+        {
+            setGeometryDirty(type, false);
+            continue;
+        }
+
+        if (isGeometryDirty(type) || cmd.getVertexBuffer() != _geometryBuffers[type].buffer)
+        {
+            setGeometryDirty(type, false);
+            uploadGeometry(type, cmd);
+        }
     }
+}
+
+void DrawNode::beginGroup(std::string_view name)
+{
+    AXASSERT(!_recording, "DrawNode: endGroup must be called before recording another group");
+    _recording = true;
+    _recordingGroup.assign(name);
 
-    if (_pointsDirty)
+    for (int type = 0; type < GEOMETRY_COUNT; ++type)
     {
-        _pointsDirty = false;
-        udpateCommand(_customCommandPoint, _points);
+        std::swap(getGeometry(type), _swappedGeometry[type]);
+        getGeometry(type).clear();
     }
+}
+
+void DrawNode::endGroup()
+{
+    AXASSERT(_recording, "DrawNode: beginGroup must be called first");
+    _recording = false;
+
+    auto it = _groups.find(_recordingGroup);
+    if (it == _groups.end())
+        it = _groups.emplace(_recordingGroup, Group{}).first;
 
-    if (_linesDirty)
+    auto& group = it.value();
+    for (int type = 0; type < GEOMETRY_COUNT; ++type)
     {
-        _linesDirty = false;
-        udpateCommand(_customCommandLine, _lines);
+        std::swap(getGeometry(type), _swappedGeometry[type]);
+        commitGroupGeometry(type, group.ranges[type], _swappedGeometry[type]);
+        _swappedGeometry[type].clear();
     }
 }
 
+void DrawNode::removeGroup(std::string_view name)
+{
+    auto it = _groups.find(name);
+    if (it == _groups.end())
+        return;
+
+    for (int type = 0; type < GEOMETRY_COUNT; ++type)
+        freeGroupRange(type, it.value().ranges[type]);
+    _groups.erase(it);
+
+    for (int type = 0; type < GEOMETRY_COUNT; ++type)
+        compactGeometry(type);
+}
+
+bool DrawNode::hasGroup(std::string_view name) const
+{
+    return _groups.find(name) != _groups.end();
+}
+
+void DrawNode::commitGroupGeometry(int type, Range& range, const axstd::pod_vector<V2F_C4B_T2F>& vertices)
+{
+    const size_t count = vertices.size();
+    auto& geometry     = getGeometry(type);
+
+    if (count <= range.capacity)
+    {
+        // in place, the unused end of the range is degenerate: zero area and fully transparent
+        memcpy(geometry.data() + range.offset, vertices.data(), count * sizeof(V2F_C4B_T2F));
+        if (count < range.count)
+            memset(geometry.data() + range.offset + count, 0, (range.count - count) * sizeof(V2F_C4B_T2F));
+        if (count > 0 || range.count > 0)
+            markGeometryDirty(type, range.offset, range.offset + (std::max)(count, range.count));
+        range.count = count;
+        return;
+    }
+
+    // grown past its range, move after the other primitives with some room to grow in place next time, the room
+    // is whole primitives so the ranges after it stay aligned on them
+    const size_t primitive = getPrimitiveElements(type);
+    freeGroupRange(type, range);
+    range.offset   = geometry.size();
+    range.count    = count;
+    range.capacity = (count + count / 4 + primitive - 1) / primitive * primitive;
+    auto dst       = expandBufferAndGetPointer(geometry, range.capacity);
+    memcpy(dst, vertices.data(), count * sizeof(V2F_C4B_T2F));
+    memset(dst + count, 0, (range.capacity - count) * sizeof(V2F_C4B_T2F));
+    setGeometryDirty(type, true);
+
+    compactGeometry(type);
+}
+
+void DrawNode::freeGroupRange(int type, Range& range)
+{
+    if (range.capacity == 0)
+        return;
+
+    auto& state = _geometryBuffers[type];
+    memset(getGeometry(type).data() + range.offset, 0, range.capacity * sizeof(V2F_C4B_T2F));
+    markGeometryDirty(type, range.offset, range.offset + range.capacity);
+    state.holes.emplace_back(range);
+    state.holeCount += range.capacity;
+    range = Range{};
+}
+
+void DrawNode::compactGeometry(int type)
+{
+    auto& state    = _geometryBuffers[type];
+    auto& geometry = getGeometry(type);
+    if (state.holeCount * 2 <= geometry.size())
+        return;
+
+    std::sort(state.holes.begin(), state.holes.end(),
+              [](const Range& a, const Range& b) { return a.offset < b.offset; });
+
+    // the offset of a vertex moves down by the size of the holes before it
+    auto shift = [&state](size_t offset) {
+        size_t removed = 0;
+        for (auto&& hole : state.holes)
+        {
+            if (hole.offset >= offset)
+                break;
+            removed += hole.capacity;
+        }
+        return offset - removed;
+    };
+    for (auto it = _groups.begin(); it != _groups.end(); ++it)
+    {
+        auto& range = it.value().ranges[type];
+        if (range.capacity > 0)
+            range.offset = shift(range.offset);
+    }
+
+    size_t write = 0, read = 0;
+    for (auto&& hole : state.holes)
+    {
+        size_t keep = hole.offset - read;
+        memmove(geometry.data() + write, geometry.data() + read, keep * sizeof(V2F_C4B_T2F));
+        write += keep;
+        read = hole.offset + hole.capacity;
+    }
+    memmove(geometry.data() + write, geometry.data() + read, (geometry.size() - read) * sizeof(V2F_C4B_T2F));
+    geometry.resize(write + geometry.size() - read);
+
+    state.holes.clear();
+    state.holeCount = 0;
+
+    // everything moved, upload it whole
+    state.uploaded   = 0;
+    state.dirtyBegin = state.dirtyEnd = 0;
+    setGeometryDirty(type, true);
+}
+
 void DrawNode::drawPoint(const Vec2& position,
                          const float pointSize,
                          const Color4B& color,
@@ -632,6 +943,55 @@ void DrawNode::drawSolidRect(const Vec2& origin,
     _drawPolygon(_vertices, 5, fillColor, borderColor, true, thickness, true);
 }
 
+void DrawNode::drawSolidRoundedRect(const Vec2& origin,
+                                    const Vec2& destination,
+                                    float cornerRadius,
+                                    const Color4B& color,
+                                    float thickness,
+                                    const Color4B& borderColor)
+{
+    if (thickness < 0.0f)
+    {
+        AXLOGW("{}: thickness < 0, changed to 0", __FUNCTION__);
+        thickness = 0.0f;
+    }
+
+    Vec2 center      = (origin + destination) * 0.5f;
+    Vec2 halfExtents = Vec2(fabsf(destination.x - origin.x), fabsf(destination.y - origin.y)) * 0.5f;
+    cornerRadius     = clampf(cornerRadius, 0.0f, (std::min)(halfExtents.x, halfExtents.y));
+
+    if (_analyticShapes && !properties.transform)
+    {
+        _drawShape(center, Vec2(1.0f, 0.0f), halfExtents, cornerRadius, color, borderColor,
+                   2 * thickness / properties.factor);
+        return;
+    }
+
+    if (cornerRadius == 0.0f)
+    {
+        drawSolidRect(origin, destination, color, thickness, borderColor);
+        return;
+    }
+
+    // a quarter circle of a few segments per corner, starting at the top right one
+    constexpr unsigned int CORNER_SEGMENTS = 8;
+    Vec2 vertices[4 * (CORNER_SEGMENTS + 1) + 1];
+    Vec2 inner = halfExtents - Vec2(cornerRadius, cornerRadius);
+    unsigned int count = 0;
+    for (unsigned int corner = 0; corner < 4; ++corner)
+    {
+        Vec2 arcCenter = center + Vec2((corner == 0 || corner == 3) ? inner.x : -inner.x,
+                                       corner < 2 ? inner.y : -inner.y);
+        for (unsigned int i = 0; i <= CORNER_SEGMENTS; ++i)
+        {
+            float rads        = (corner + (float)i / CORNER_SEGMENTS) * (float)M_PI_2;
+            vertices[count++] = arcCenter + Vec2(cosf(rads), sinf(rads)) * cornerRadius;
+        }
+    }
+    vertices[count++] = vertices[0];
+    _drawPolygon(vertices, count, color, borderColor, true, thickness, true);
+}
+
 void DrawNode::drawSolidPoly(const Vec2* poli,
                              unsigned int numberOfPoints,
                              const Color4B& color,
@@ -781,13 +1141,26 @@ void DrawNode::drawSolidTriangle(const Vec2& p1,
 
 void DrawNode::clear()
 {
+    AXASSERT(!_recording, "DrawNode: a group is being recorded, call endGroup");
+
     _trianglesDirty = true;
     _pointsDirty    = true;
     _linesDirty     = true;
+    _shapesDirty    = true;
 
     _triangles.clear();
     _points.clear();
     _lines.clear();
+    _shapes.clear();
+
+    _groups.clear();
+    for (auto&& state : _geometryBuffers)
+    {
+        state.uploaded   = 0;
+        state.dirtyBegin = state.dirtyEnd = 0;
+        state.holes.clear();
+        state.holeCount = 0;
+    }
 }
 
 const BlendFunc& DrawNode::getBlendFunc() const
@@ -1057,7 +1430,23 @@ void DrawNode::_drawSegment(const Vec2& from,
     if (thickness < 1.0f)
         thickness = 1.0f;
 
-    if (thickness == 1.0f && !properties.drawOrder)
+    if (_analyticShapes && !properties.transform &&
+        (etStart == DrawNode::EndType::Round) == (etEnd == DrawNode::EndType::Round))
+    {
+        // a capsule when both ends are round, else a box extended by the square ends
+        float width  = thickness / (2 * properties.factor);
+        bool round   = etStart == DrawNode::EndType::Round;
+        Vec2 axis    = to - from;
+        float length = axis.length();
+        axis         = length > 0.0f ? axis / length : Vec2(1.0f, 0.0f);
+
+        float startCap = (round || etStart == DrawNode::EndType::Square) ? width : 0.0f;
+        float endCap   = (round || etEnd == DrawNode::EndType::Square) ? width : 0.0f;
+        Vec2 center    = (from + to + axis * (endCap - startCap)) * 0.5f;
+        _drawShape(center, axis, Vec2((length + startCap + endCap) * 0.5f, width), round ? width : 0.0f, color,
+                   Color4B::TRANSPARENT, 0.0f);
+    }
+    else if (thickness == 1.0f && !properties.drawOrder)
     {
         _drawLine(from, to, color); // fastest way to draw a line
     }
@@ -1218,6 +1607,14 @@ void DrawNode::_drawCircle(const Vec2& center,
                            bool solid,
                            float thickness)
 {
+    if (_analyticShapes && !properties.transform && !drawLineToCenter && scaleX == scaleY)
+    {
+        float rs = fabsf(radius * scaleX);
+        _drawShape(center, Vec2(1.0f, 0.0f), Vec2(rs, rs), rs, solid ? fillColor : Color4B::TRANSPARENT, borderColor,
+                   2 * thickness / properties.factor);
+        return;
+    }
+
     const float coef = 2.0f * (float)M_PI / segments;
 
     int count       = (drawLineToCenter) ? 3 : 2;
@@ -1244,6 +1641,39 @@ void DrawNode::_drawCircle(const Vec2& center,
     AX_SAFE_DELETE_ARRAY(_vertices);
 }
 
+void DrawNode::_drawShape(const Vec2& center,
+                          const Vec2& axis,
+                          const Vec2& halfExtents,
+                          float cornerRadius,
+                          const Color4B& fillColor,
+                          const Color4B& borderColor,
+                          float borderWidth)
+{
+    // the border is centered on the edge, and the quad leaves a point around the shape for its anti-aliased edge
+    float halfBorder = borderWidth * 0.5f;
+    Vec4 params(halfExtents.x + halfBorder, halfExtents.y + halfBorder,
+                cornerRadius > 0.0f ? cornerRadius + halfBorder : 0.0f, borderWidth);
+    Vec2 quad(params.x + 1.0f, params.y + 1.0f);
+    Vec2 u = axis * quad.x;
+    Vec2 v = axis.getPerp() * quad.y;
+
+    V2F_C4B_T2F_T4F_C4B a = {center - u - v, fillColor, Vec2(-quad.x, -quad.y), params, borderColor};
+    V2F_C4B_T2F_T4F_C4B b = {center - u + v, fillColor, Vec2(-quad.x, quad.y), params, borderColor};
+    V2F_C4B_T2F_T4F_C4B c = {center + u + v, fillColor, Vec2(quad.x, quad.y), params, borderColor};
+    V2F_C4B_T2F_T4F_C4B d = {center + u - v, fillColor, Vec2(quad.x, -quad.y), params, borderColor};
+
+    auto vertices = reinterpret_cast<V2F_C4B_T2F_T4F_C4B*>(
+        expandBufferAndGetPointer(_shapes, getPrimitiveElements(GEOMETRY_SHAPES)));
+    _shapesDirty = true;
+
+    vertices[0] = a;
+    vertices[1] = b;
+    vertices[2] = c;
+    vertices[3] = a;
+    vertices[4] = c;
+    vertices[5] = d;
+}
+
 void DrawNode::_drawColoredTriangle(Vec2* vertices3,
                              const Color4B* color3)
 {
@@ -1549,13 +1979,14 @@ void DrawNode::applyTransform(const Vec2* from, Vec2* to, unsigned int count)
     auto scale = properties.scale;
     auto position = properties.position;
 
+    // to = scale * (rotation * (from - center) + center) + position, as one matrix
+    Mat4 m;
     if (properties.rotation == 0.0f)
     {
-        for (unsigned int i = 0; i < count; i++)
-        {
-            to[i].x = from[i].x * scale.x + position.x;
-            to[i].y = from[i].y * scale.y + position.y;
-        }
+        m.m[0]  = scale.x;
+        m.m[5]  = scale.y;
+        m.m[12] = position.x;
+        m.m[13] = position.y;
     }
     else
     {
@@ -1564,25 +1995,15 @@ void DrawNode::applyTransform(const Vec2* from, Vec2* to, unsigned int count)
         auto center = properties.center;
 
         // https://stackoverflow.com/questions/2259476/rotating-a-point-about-another-point-2d
-        for (unsigned int i = 0; i < count; i++)
-        {
-            // translate point to origin
-            float x = from[i].x - center.x;
-            float y = from[i].y - center.y;
-
-            // rotate point
-            float rx = x * cosRot - y * sinRot;
-            float ry = x * sinRot + y * cosRot;
-
-            // translate point back
-            x = rx + center.x;
-            y = ry + center.y;
-
-            // scale and position
-            to[i].x = x * scale.x + position.x;
-            to[i].y = y * scale.y + position.y;
-        }
+        m.m[0]  = cosRot * scale.x;
+        m.m[1]  = sinRot * scale.y;
+        m.m[4]  = -sinRot * scale.x;
+        m.m[5]  = cosRot * scale.y;
+        m.m[12] = (center.x - (center.x * cosRot - center.y * sinRot)) * scale.x + position.x;
+        m.m[13] = (center.y - (center.x * sinRot + center.y * cosRot)) * scale.y + position.y;
     }
+
+    MathUtil::transformVec2(m, from, to, count);
 }
 
 void DrawNode::Properties::setDefaultValues()
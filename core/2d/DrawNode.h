@@ -38,6 +38,7 @@
 #include "base/Types.h"
 #include "renderer/CustomCommand.h"
 #include "math/Math.h"
+#include "base/hlookup.h"
 
 namespace ax
 {
@@ -330,6 +331,23 @@ public:
                        float thickness            = 0,
                        const Color4B& borderColor = Color4B(0, 0, 0, 0));
 
+    /** Draws a solid rectangle with rounded corners given the origin and destination point measured in points.
+     *
+     * @param origin The rectangle origin.
+     * @param destination The rectangle destination.
+     * @param cornerRadius The radius of the corners, clamped to half the smallest side.
+     * @param color The rectangle color.
+     * @param thickness The border width.
+     * @param borderColor The border color.
+     * @js NA
+     */
+    void drawSolidRoundedRect(const Vec2& origin,
+                              const Vec2& destination,
+                              float cornerRadius,
+                              const Color4B& color,
+                              float thickness            = 0,
+                              const Color4B& borderColor = Color4B(0, 0, 0, 0));
+
     /** Draws a solid polygon given a pointer to CGPoint coordinates, the number of vertices measured in points, and a
      * color.
      *
@@ -520,8 +538,38 @@ public:
                            const Color4B& borderColor,
                            float thickness = 1.0f);
 
-    /** Clear the geometry in the node's buffer. */
+    /** Clear the geometry in the node's buffer, including the groups. */
     void clear();
+
+    /** Begin recording a named group of primitives, the primitives drawn until endGroup form the group.
+     * A group can be redrawn on its own: recording it again replaces its primitives, and only the vertex ranges it
+     * occupies are uploaded again. A group keeps its place in the drawing order unless it grows past the room
+     * reserved for it, it's then moved after the other primitives.
+     * @param name The name of the group, recording an existing group replaces its primitives.
+     */
+    void beginGroup(std::string_view name);
+    /** End recording the group begun by beginGroup. */
+    void endGroup();
+    /** Remove the primitives of a group. */
+    void removeGroup(std::string_view name);
+    bool hasGroup(std::string_view name) const;
+
+    /** Sets whether the geometry is transient, i.e. cleared and redrawn every frame.
+     * The vertices of a transient node are streamed into the renderer ring buffer when drawn instead of being
+     * uploaded into buffers owned by the node, see Renderer::streamVertices. The node buffers are still used when
+     * the driver has no ring buffers.
+     */
+    void setTransient(bool transient) { _transient = transient; }
+    bool isTransient() const { return _transient; }
+    /** Sets whether circles, segments and rounded rectangles are drawn as analytic shapes.
+     * An analytic shape is one quad whose fragment shader evaluates the signed distance to the shape, so its edges
+     * are anti-aliased and no segments are tessellated on the CPU. It applies to drawCircle, drawSolidCircle,
+     * drawSegment and drawSolidRoundedRect; ellipses, lines to the center, segments mixing round and flat ends and
+     * the primitives drawn while properties.transform is set are still tessellated.
+     * The analytic shapes are drawn after the other primitives of the node.
+     */
+    void setAnalyticShapes(bool analytic) { _analyticShapes = analytic; }
+    bool isAnalyticShapes() const { return _analyticShapes; }
     /** Get the color mixed mode.
      * @lua NA
      */
@@ -553,7 +601,57 @@ public:
     virtual bool init() override;
 
 protected:
-    void updateBuffers();
+    enum GeometryType
+    {
+        GEOMETRY_TRIANGLES,
+        GEOMETRY_POINTS,
+        GEOMETRY_LINES,
+        GEOMETRY_SHAPES,
+        GEOMETRY_COUNT
+    };
+
+    /** A range of vertices in _triangles, _points or _lines, value initialized to empty. */
+    struct Range
+    {
+        size_t offset;
+        size_t count;
+        size_t capacity;  ///< the vertices reserved, the ones after count are degenerate
+    };
+
+    struct Group
+    {
+        Range ranges[GEOMETRY_COUNT];
+    };
+
+    /** The GPU buffer of _triangles, _points or _lines and what changed since it was uploaded. */
+    struct GeometryBuffer
+    {
+        backend::Buffer* buffer = nullptr;
+        size_t uploaded         = 0;  ///< the vertices after it were appended, they are uploaded next time
+        size_t dirtyBegin       = 0;  ///< the uploaded vertices which changed
+        size_t dirtyEnd         = 0;
+        std::vector<Range> holes;     ///< the ranges of the groups removed or moved, zeroed
+        size_t holeCount = 0;
+    };
+
+    void updateBuffers(Renderer* renderer);
+    void uploadGeometry(int type, CustomCommand& cmd);
+    bool streamGeometry(Renderer* renderer, int type, CustomCommand& cmd);
+
+    axstd::pod_vector<V2F_C4B_T2F>& getGeometry(int type);
+    CustomCommand& getGeometryCommand(int type);
+    /** The elements of the geometry array taken by a vertex, 2 for the shapes. */
+    static size_t getVertexElements(int type);
+    /** The elements taken by a primitive, the ranges of the groups are multiples of it. */
+    static size_t getPrimitiveElements(int type);
+    bool isGeometryDirty(int type) const;
+    void setGeometryDirty(int type, bool dirty);
+    void markGeometryDirty(int type, size_t begin, size_t end);
+    /** Copy the vertices recorded for a group into its range, or a new one at the end when they don't fit. */
+    void commitGroupGeometry(int type, Range& range, const axstd::pod_vector<V2F_C4B_T2F>& vertices);
+    void freeGroupRange(int type, Range& range);
+    /** Remove the holes once they are most of the geometry, the groups after them move down. */
+    void compactGeometry(int type);
     void updateShader();
     void updateShaderInternal(CustomCommand& cmd,
                               uint32_t programType,
@@ -569,6 +667,7 @@ protected:
     bool _trianglesDirty: 1 = false;
     bool _pointsDirty: 1 = false;
     bool _linesDirty: 1 = false;
+    bool _shapesDirty: 1 = false;
 
     bool _isolated: 1 = false;
 
@@ -577,10 +676,22 @@ protected:
     CustomCommand _customCommandTriangle;
     CustomCommand _customCommandPoint;
     CustomCommand _customCommandLine;
+    CustomCommand _customCommandShape;
 
     axstd::pod_vector<V2F_C4B_T2F> _triangles;
     axstd::pod_vector<V2F_C4B_T2F> _points;
     axstd::pod_vector<V2F_C4B_T2F> _lines;
+    // every V2F_C4B_T2F_T4F_C4B takes two elements, so the shapes share the bookkeeping of the other geometry
+    axstd::pod_vector<V2F_C4B_T2F> _shapes;
+
+    GeometryBuffer _geometryBuffers[GEOMETRY_COUNT];
+    hlookup::string_map<Group> _groups;
+    // while recording a group the draws append to the arrays above, the geometry of the node is swapped here
+    axstd::pod_vector<V2F_C4B_T2F> _swappedGeometry[GEOMETRY_COUNT];
+    std::string _recordingGroup;
+    bool _recording: 1 = false;
+    bool _transient: 1 = false;
+    bool _analyticShapes: 1 = false;
 
 
 private:
@@ -662,6 +773,17 @@ private:
                      bool solid,
                      float thickness = 1.0f);
 
+    // Internal function _drawShape
+    // Appends a rounded box of halfExtents centered on center, its x axis along the unit vector axis. A circle is a
+    // square whose corners are rounded by its radius.
+    void _drawShape(const Vec2& center,
+                    const Vec2& axis,
+                    const Vec2& halfExtents,
+                    float cornerRadius,
+                    const Color4B& fillColor,
+                    const Color4B& borderColor,
+                    float borderWidth);
+
     // Internal function _drawPie
     void _drawPie(const Vec2& center,
                   float radius,
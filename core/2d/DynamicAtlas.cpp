@@ -0,0 +1,393 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/DynamicAtlas.h"
+
+#include <algorithm>
+
+#include "2d/SpriteFrame.h"
+#include "2d/SpriteFrameCache.h"
+#include "base/Config.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
+#include "base/Macros.h"
+#include "platform/Image.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/PixelFormatUtils.h"
+
+namespace ax
+{
+
+static DynamicAtlas* s_sharedDynamicAtlas = nullptr;
+
+DynamicAtlas* DynamicAtlas::getInstance()
+{
+    if (!s_sharedDynamicAtlas)
+        s_sharedDynamicAtlas = new DynamicAtlas();
+    return s_sharedDynamicAtlas;
+}
+
+void DynamicAtlas::destroyInstance()
+{
+    AX_SAFE_DELETE(s_sharedDynamicAtlas);
+}
+
+DynamicAtlas::DynamicAtlas(int pageSize, int padding) : _pageSize(pageSize), _padding((std::max)(padding, 0))
+{
+    AXASSERT(pageSize > 0, "The page size should be positive");
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    _rendererRecreatedListener =
+        EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { reloadPages(); });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_rendererRecreatedListener, 1);
+#endif
+}
+
+DynamicAtlas::~DynamicAtlas()
+{
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_rendererRecreatedListener);
+#endif
+    removeAllImages();
+}
+
+SpriteFrame* DynamicAtlas::addImage(std::string_view filePath)
+{
+    auto it = _entries.find(filePath);
+    if (it != _entries.end())
+        return it->second.frame;
+
+    Image image;
+    if (!image.initWithImageFile(filePath))
+        return nullptr;
+    return addImage(&image, filePath);
+}
+
+SpriteFrame* DynamicAtlas::addImage(Image* image, std::string_view name)
+{
+    AXASSERT(image, "The image should not be null");
+
+    auto it = _entries.find(name);
+    if (it != _entries.end())
+        return it->second.frame;
+
+    const int width  = image->getWidth();
+    const int height = image->getHeight();
+    if (image->isCompressed() || width <= 0 || height <= 0 || width + 2 * _padding > _pageSize ||
+        height + 2 * _padding > _pageSize)
+    {
+        AXLOGW("DynamicAtlas: can't pack the {}x{} image {}", width, height, name);
+        return nullptr;
+    }
+
+    // the first level only, the pages have no mipmaps
+    const auto format     = image->getPixelFormat();
+    const auto dataLen    = static_cast<size_t>(width) * height * backend::PixelFormatUtils::getBitsPerPixel(format) / 8;
+    unsigned char* pixels = nullptr;
+    size_t pixelsLen      = 0;
+    if (backend::PixelFormatUtils::convertDataToFormat(image->getData(), dataLen, format, backend::PixelFormat::RGBA8,
+                                                       &pixels, &pixelsLen) != backend::PixelFormat::RGBA8)
+    {
+        if (pixels != image->getData())
+            free(pixels);
+        AXLOGW("DynamicAtlas: can't convert the image {} to RGBA8", name);
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.width  = width;
+    entry.height = height;
+    entry.pixels.assign(pixels, pixels + pixelsLen);
+    if (pixels != image->getData())
+        free(pixels);
+#if AX_ENABLE_PREMULTIPLIED_ALPHA
+    if (!image->hasPremultipliedAlpha())
+        backend::PixelFormatUtils::premultiplyAlpha(entry.pixels.data(), entry.pixels.size());
+#endif
+
+    if (!placeEntry(entry))
+        return nullptr;
+
+    entry.frame = SpriteFrame::createWithTexture(
+        entry.page->texture, AX_RECT_PIXELS_TO_POINTS(Rect(entry.x, entry.y, entry.width, entry.height)));
+    entry.frame->retain();
+
+    auto frame = entry.frame;
+    _entries.emplace(std::string{name}, std::move(entry));
+    SpriteFrameCache::getInstance()->addSpriteFrame(frame, name);
+    return frame;
+}
+
+bool DynamicAtlas::removeImage(std::string_view name)
+{
+    auto it = _entries.find(name);
+    if (it == _entries.end())
+        return false;
+
+    auto page = it->second.page;
+    page->liveArea -= (it->second.width + 2 * _padding) * (it->second.height + 2 * _padding);
+    --page->imageCount;
+
+    auto frameCache = SpriteFrameCache::getInstance();
+    if (frameCache->findFrame(name) == it->second.frame)
+        frameCache->removeSpriteFrameByName(name);
+    it->second.frame->release();
+    _entries.erase(it);
+
+    if (page->imageCount == 0)
+        releasePage(page);
+    else if (page->liveArea < page->usedArea * _compactionThreshold)
+        compactPage(page);
+    return true;
+}
+
+void DynamicAtlas::removeAllImages()
+{
+    auto frameCache = SpriteFrameCache::getInstance();
+    for (auto&& item : _entries)
+    {
+        if (frameCache->findFrame(item.first) == item.second.frame)
+            frameCache->removeSpriteFrameByName(item.first);
+        item.second.frame->release();
+    }
+    _entries.clear();
+
+    for (auto&& page : _pages)
+        page->texture->release();
+    _pages.clear();
+}
+
+SpriteFrame* DynamicAtlas::getSpriteFrame(std::string_view name) const
+{
+    auto it = _entries.find(name);
+    return it != _entries.end() ? it->second.frame : nullptr;
+}
+
+void DynamicAtlas::setCompactionThreshold(float threshold)
+{
+    _compactionThreshold = std::clamp(threshold, 0.0f, 1.0f);
+}
+
+void DynamicAtlas::compact()
+{
+    std::vector<Page*> pages;
+    for (auto&& page : _pages)
+    {
+        if (page->liveArea < page->usedArea * _compactionThreshold)
+            pages.emplace_back(page.get());
+    }
+    for (auto page : pages)
+        compactPage(page);
+}
+
+Texture2D* DynamicAtlas::getPageTexture(int index) const
+{
+    return index >= 0 && index < static_cast<int>(_pages.size()) ? _pages[index]->texture : nullptr;
+}
+
+bool DynamicAtlas::placeEntry(Entry& entry)
+{
+    const int width  = entry.width + 2 * _padding;
+    const int height = entry.height + 2 * _padding;
+
+    int x      = 0;
+    int y      = 0;
+    Page* page = nullptr;
+    for (auto&& candidate : _pages)
+    {
+        if (allocateRect(*candidate, width, height, x, y))
+        {
+            page = candidate.get();
+            break;
+        }
+    }
+    if (!page)
+    {
+        page = createPage();
+        if (!page || !allocateRect(*page, width, height, x, y))
+            return false;
+    }
+
+    page->usedArea += width * height;
+    page->liveArea += width * height;
+    ++page->imageCount;
+
+    entry.page = page;
+    entry.x    = x + _padding;
+    entry.y    = y + _padding;
+    uploadEntry(entry);
+    return true;
+}
+
+bool DynamicAtlas::allocateRect(Page& page, int width, int height, int& x, int& y)
+{
+    auto& skyline = page.skyline;
+    int bestIndex = -1;
+    int bestY     = _pageSize;
+    int bestWidth = _pageSize + 1;
+    for (int i = 0, count = static_cast<int>(skyline.size()); i < count; ++i)
+    {
+        int nodeX = skyline[i].x;
+        if (nodeX + width > _pageSize)
+            break;
+
+        // the rect rests on the highest node it spans
+        int nodeY     = 0;
+        int remaining = width;
+        for (int k = i; remaining > 0; ++k)
+        {
+            nodeY = (std::max)(nodeY, skyline[k].y);
+            remaining -= skyline[k].width;
+        }
+        if (nodeY + height > _pageSize)
+            continue;
+
+        if (nodeY < bestY || (nodeY == bestY && skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestY     = nodeY;
+            bestWidth = skyline[i].width;
+        }
+    }
+
+    if (bestIndex < 0)
+        return false;
+
+    x = skyline[bestIndex].x;
+    y = bestY;
+    skyline.insert(skyline.begin() + bestIndex, SkylineNode{x, y + height, width});
+
+    // shrink or remove the nodes covered by the new one
+    for (size_t i = bestIndex + 1; i < skyline.size();)
+    {
+        auto& prev  = skyline[i - 1];
+        auto& node  = skyline[i];
+        int overlap = prev.x + prev.width - node.x;
+        if (overlap <= 0)
+            break;
+        node.x += overlap;
+        node.width -= overlap;
+        if (node.width > 0)
+            break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+    return true;
+}
+
+DynamicAtlas::Page* DynamicAtlas::createPage()
+{
+    // the room of the pages is written once, so the padding stays transparent
+    std::vector<uint8_t> zeros(static_cast<size_t>(_pageSize) * _pageSize * 4);
+    auto texture = new Texture2D();
+    if (!texture->initWithData(zeros.data(), static_cast<ssize_t>(zeros.size()), backend::PixelFormat::RGBA8,
+                               _pageSize, _pageSize, AX_ENABLE_PREMULTIPLIED_ALPHA != 0))
+    {
+        texture->release();
+        return nullptr;
+    }
+
+    auto page     = std::make_unique<Page>();
+    page->texture = texture;
+    page->skyline.emplace_back(SkylineNode{0, 0, _pageSize});
+    _pages.emplace_back(std::move(page));
+    return _pages.back().get();
+}
+
+void DynamicAtlas::uploadEntry(const Entry& entry)
+{
+    entry.page->texture->updateWithSubData(const_cast<uint8_t*>(entry.pixels.data()), entry.x, entry.y, entry.width,
+                                           entry.height);
+}
+
+void DynamicAtlas::compactPage(Page* page)
+{
+    auto pos = std::find_if(_pages.begin(), _pages.end(), [page](auto& item) { return item.get() == page; });
+    if (pos == _pages.end())
+        return;
+
+    std::vector<Entry*> entries;
+    for (auto it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        if (it->second.page == page)
+            entries.emplace_back(&it.value());
+    }
+
+    // take the page out, so its images go to the other pages or to a new one
+    auto detached = std::move(*pos);
+    _pages.erase(pos);
+
+    std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) { return a->height > b->height; });
+    for (auto entry : entries)
+    {
+        if (!placeEntry(*entry))
+            continue;
+        page->liveArea -= (entry->width + 2 * _padding) * (entry->height + 2 * _padding);
+        --page->imageCount;
+        entry->frame->setTexture(entry->page->texture);
+        entry->frame->setRectInPixels(Rect(entry->x, entry->y, entry->width, entry->height));
+    }
+
+    // keep the page when a new one can't be created
+    if (page->imageCount > 0)
+        _pages.emplace_back(std::move(detached));
+    else
+        page->texture->release();
+}
+
+void DynamicAtlas::releasePage(Page* page)
+{
+    auto pos = std::find_if(_pages.begin(), _pages.end(), [page](auto& item) { return item.get() == page; });
+    if (pos != _pages.end())
+    {
+        page->texture->release();
+        _pages.erase(pos);
+    }
+}
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+void DynamicAtlas::reloadPages()
+{
+    std::vector<uint8_t> zeros(static_cast<size_t>(_pageSize) * _pageSize * 4);
+    for (auto&& page : _pages)
+    {
+        page->texture->initWithData(zeros.data(), static_cast<ssize_t>(zeros.size()), backend::PixelFormat::RGBA8,
+                                    _pageSize, _pageSize, AX_ENABLE_PREMULTIPLIED_ALPHA != 0);
+    }
+    for (auto&& item : _entries)
+        uploadEntry(item.second);
+}
+#endif
+
+}  // namespace ax
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "base/hlookup.h"
+
+namespace ax
+{
+
+class Image;
+class Texture2D;
+class SpriteFrame;
+class EventListenerCustom;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @brief Packs images loaded at runtime, e.g. downloaded avatars or icons, into shared RGBA8 atlas pages.
+ *
+ * Sprites created from separate files get a texture each and break the batching of the renderer, the images
+ * added here share a few pages instead. Every image gets a SpriteFrame, which is also added to SpriteFrameCache
+ * under the name of the image, so `Sprite::createWithSpriteFrameName` serves it.
+ *
+ * The pages are filled with skyline bottom left packing, which can't reuse the room of a removed image. When the
+ * images left in a page cover less than the compaction threshold of its used area, they are moved to the other
+ * pages and the page is dropped, the frames are updated in place. Sprites already showing a moved image keep the
+ * old page texture alive and keep drawing it until they are given the frame again.
+ *
+ * The pixels of every image are kept, to move them and to restore the pages when the renderer is recreated.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL DynamicAtlas
+{
+public:
+    static constexpr int DEFAULT_PAGE_SIZE = 1024;
+    /** The transparent gap around the images, so the filtering doesn't sample the neighbors. */
+    static constexpr int DEFAULT_PADDING = 2;
+
+    static DynamicAtlas* getInstance();
+    static void destroyInstance();
+
+    explicit DynamicAtlas(int pageSize = DEFAULT_PAGE_SIZE, int padding = DEFAULT_PADDING);
+    ~DynamicAtlas();
+
+    DynamicAtlas(const DynamicAtlas&)            = delete;
+    DynamicAtlas& operator=(const DynamicAtlas&) = delete;
+
+    /** Loads an image file and packs it under the file path, or returns the frame of the path packed before. */
+    SpriteFrame* addImage(std::string_view filePath);
+
+    /**
+     * Packs an image under a name, or returns the frame of the name packed before.
+     * Uncompressed images are converted to RGBA8, nullptr is returned for the compressed ones and the images larger
+     * than a page.
+     */
+    SpriteFrame* addImage(Image* image, std::string_view name);
+
+    /** Removes an image and its SpriteFrameCache entry, its page may be compacted. */
+    bool removeImage(std::string_view name);
+
+    void removeAllImages();
+
+    SpriteFrame* getSpriteFrame(std::string_view name) const;
+    bool hasImage(std::string_view name) const { return _entries.find(name) != _entries.end(); }
+    size_t getImageCount() const { return _entries.size(); }
+
+    /** Sets the ratio of live to used area a page is compacted below, 0 disables the compaction. Default 0.5. */
+    void setCompactionThreshold(float threshold);
+    float getCompactionThreshold() const { return _compactionThreshold; }
+
+    /** Compacts every page below the compaction threshold. */
+    void compact();
+
+    int getPageSize() const { return _pageSize; }
+    int getPageCount() const { return static_cast<int>(_pages.size()); }
+    Texture2D* getPageTexture(int index) const;
+
+protected:
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page
+    {
+        Texture2D* texture = nullptr;
+        std::vector<SkylineNode> skyline;
+        int usedArea   = 0;  // of the allocated rects, removed ones included
+        int liveArea   = 0;
+        int imageCount = 0;
+    };
+
+    struct Entry
+    {
+        SpriteFrame* frame = nullptr;
+        Page* page         = nullptr;
+        int x              = 0;
+        int y              = 0;
+        int width          = 0;
+        int height         = 0;
+        std::vector<uint8_t> pixels;  // RGBA8, premultiplied like the pages
+    };
+
+    /** Allocates room for the entry in a page, a new one when none has room, and uploads its pixels. */
+    bool placeEntry(Entry& entry);
+    bool allocateRect(Page& page, int width, int height, int& x, int& y);
+    Page* createPage();
+    void uploadEntry(const Entry& entry);
+
+    void compactPage(Page* page);
+    void releasePage(Page* page);
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    void reloadPages();
+    EventListenerCustom* _rendererRecreatedListener = nullptr;
+#endif
+
+    int _pageSize;
+    int _padding;
+    float _compactionThreshold = 0.5f;
+
+    std::vector<std::unique_ptr<Page>> _pages;
+    hlookup::string_map<Entry> _entries;
+};
+
+// end of _2d group
+/// @}
+
+}  // namespace ax
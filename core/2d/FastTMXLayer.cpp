@@ -155,9 +155,11 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
         inv.inverse();
         rect = RectApplyTransform(rect, inv);
 
-        updateTiles(rect);
-        updateIndexBuffer();
-        updatePrimitives();
+        if (updateTiles(rect))
+        {
+            updateIndexBuffer();
+            updatePrimitives();
+        }
         _dirty = false;
     }
 
@@ -175,122 +177,96 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
     }
 }
 
-void FastTMXLayer::updateTiles(const Rect& culledRect)
+bool FastTMXLayer::updateTiles(const Rect& culledRect)
 {
-    Rect visibleTiles        = Rect(culledRect.origin, culledRect.size * _director->getContentScaleFactor());
-    Vec2 mapTileSize         = AX_SIZE_PIXELS_TO_POINTS(_mapTileSize);
-    Vec2 tileSize            = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-    Mat4 nodeToTileTransform = _tileToNodeTransform.getInversed();
-    // transform to tile
-    visibleTiles = RectApplyTransform(visibleTiles, nodeToTileTransform);
-    // tile coordinate is upside-down, so we need to make the tile coordinate use top-left for the start point.
-    visibleTiles.origin.y += 1;
-
-    // if x=0.7, width=9.5, we need to draw number 0~10 of tiles, and so is height.
-    visibleTiles.size.width  = ceil(visibleTiles.origin.x + visibleTiles.size.width) - floor(visibleTiles.origin.x);
-    visibleTiles.size.height = ceil(visibleTiles.origin.y + visibleTiles.size.height) - floor(visibleTiles.origin.y);
-    visibleTiles.origin.x    = floor(visibleTiles.origin.x);
-    visibleTiles.origin.y    = floor(visibleTiles.origin.y);
-
-    // for the bigger tiles.
-    int tilesOverX = 0;
-    int tilesOverY = 0;
-    // for diagonal orientation tiles
-    float tileSizeMax = std::max(tileSize.width, tileSize.height);
-    if (_layerOrientation == FAST_TMX_ORIENTATION_ORTHO)
-    {
-        tilesOverX = (int)ceil(tileSizeMax / mapTileSize.width) - 1;
-        tilesOverY = (int)ceil(tileSizeMax / mapTileSize.height) - 1;
+    Rect visibleRect = Rect(culledRect.origin, culledRect.size * _director->getContentScaleFactor());
 
-        if (tilesOverX < 0)
-            tilesOverX = 0;
-        if (tilesOverY < 0)
-            tilesOverY = 0;
-    }
-    else if (_layerOrientation == FAST_TMX_ORIENTATION_ISO)
-    {
-        Rect overTileRect(0, 0, tileSizeMax - mapTileSize.width, tileSizeMax - mapTileSize.height);
-        if (overTileRect.size.width < 0)
-            overTileRect.size.width = 0;
-        if (overTileRect.size.height < 0)
-            overTileRect.size.height = 0;
-        overTileRect = RectApplyTransform(overTileRect, nodeToTileTransform);
-
-        tilesOverX = (int)(ceil(overTileRect.origin.x + overTileRect.size.width) - floor(overTileRect.origin.x));
-        tilesOverY = (int)(ceil(overTileRect.origin.y + overTileRect.size.height) - floor(overTileRect.origin.y));
-    }
-    else
+    // the bounds of a chunk cover its whole quads, so the tiles bigger than the map tiles need no margin
+    _culledChunks.clear();
+    for (int i = 0; i < static_cast<int>(_chunks.size()); ++i)
     {
-        // do nothing, do not support
-        // AXASSERT(0, "TMX invalid value");
+        if (_chunks[i].runCount > 0 && _chunks[i].bounds.intersectsRect(visibleRect))
+            _culledChunks.emplace_back(i);
     }
 
-    _indicesVertexZNumber.clear();
+    // the indices change only when the camera crosses a chunk boundary
+    if (!_dirty && _culledChunks == _visibleChunks)
+        return false;
+    std::swap(_visibleChunks, _culledChunks);
 
-    for (const auto& iter : _indicesVertexZOffsets)
+    // the quads are drawn in the order of the whole layer: by vertexZ, then row by row
+    _visibleRuns.clear();
+    for (auto&& chunkIndex : _visibleChunks)
     {
-        _indicesVertexZNumber[iter.first] = iter.second;
+        auto& chunk = _chunks[chunkIndex];
+        for (int i = 0; i < chunk.runCount; ++i)
+            _visibleRuns.emplace_back(&_runs[chunk.runOffset + i]);
     }
+    std::sort(_visibleRuns.begin(), _visibleRuns.end(), [](const TileRun* a, const TileRun* b) {
+        if (a->vertexZ != b->vertexZ)
+            return a->vertexZ < b->vertexZ;
+        return a->y != b->y ? a->y < b->y : a->x < b->x;
+    });
 
-    int yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
-    int yEnd =
-        static_cast<int>(std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
-    int xBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.x - tilesOverX));
-    int xEnd =
-        static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
+    _indicesVertexZOffsets.clear();
+    _indicesVertexZNumber.clear();
 
-    for (int y = yBegin; y < yEnd; ++y)
+    int offset = 0;
+    for (auto&& run : _visibleRuns)
     {
-        for (int x = xBegin; x < xEnd; ++x)
+        auto iter = _indicesVertexZNumber.find(run->vertexZ);
+        if (iter == _indicesVertexZNumber.end())
         {
-            int tileIndex = getTileIndexByPos(x, y);
-            if (_tiles[tileIndex] == 0)
-                continue;
-
-            int vertexZ = getVertexZForPos(Vec2((float)x, (float)y));
-            auto iter   = _indicesVertexZNumber.find(vertexZ);
-            int offset  = iter->second;
-            iter->second++;
+            _indicesVertexZOffsets[run->vertexZ] = offset;
+            iter = _indicesVertexZNumber.emplace(run->vertexZ, 0).first;
+        }
+        iter->second += run->quadCount;
 
-            auto quadIndex = static_cast<decltype(_indices)::value_type>(_tileToQuadIndex[tileIndex]);
+        for (int i = 0; i < run->quadCount; ++i, ++offset)
+        {
+            auto quadIndex = static_cast<decltype(_indices)::value_type>(run->quadOffset + i);
             _indices[6 * offset + 0] = quadIndex * 4 + 0;
             _indices[6 * offset + 1] = quadIndex * 4 + 1;
             _indices[6 * offset + 2] = quadIndex * 4 + 2;
             _indices[6 * offset + 3] = quadIndex * 4 + 3;
             _indices[6 * offset + 4] = quadIndex * 4 + 2;
             _indices[6 * offset + 5] = quadIndex * 4 + 1;
-
-        }  // for x
-    }      // for y
-
-    for (const auto& iter : _indicesVertexZOffsets)
-    {
-        _indicesVertexZNumber[iter.first] -= iter.second;
-        if (_indicesVertexZNumber[iter.first] == 0)
-        {
-            _indicesVertexZNumber.erase(iter.first);
         }
     }
+    _indexQuadCount = offset;
+
+    return true;
 }
 
 void FastTMXLayer::updateVertexBuffer()
 {
     unsigned int vertexBufferSize = (unsigned int)(sizeof(V3F_C4B_T2F) * _totalQuads.size() * 4);
-    if (!_vertexBuffer)
+    if (vertexBufferSize == 0)
+        return;
+
+    if (!_vertexBuffer || _vertexBuffer->getSize() < vertexBufferSize)
     {
+        AX_SAFE_RELEASE(_vertexBuffer);
         _vertexBuffer = backend::DriverBase::getInstance()->newBuffer(vertexBufferSize, backend::BufferType::VERTEX, backend::BufferUsage::STATIC);
     }
-    _vertexBuffer->updateData(&_totalQuads[0], vertexBufferSize);
+    _vertexBuffer->updateSubData(&_totalQuads[0], 0, vertexBufferSize);
+    _dirtyQuadBegin = _dirtyQuadEnd = 0;
 }
 
 void FastTMXLayer::updateIndexBuffer()
 {
     auto indexBufferSize = (sizeof(decltype(_indices)::value_type) * _indices.size());
-    if (!_indexBuffer)
+    if (indexBufferSize == 0)
+        return;
+
+    if (!_indexBuffer || _indexBuffer->getSize() < indexBufferSize)
     {
+        AX_SAFE_RELEASE(_indexBuffer);
         _indexBuffer = backend::DriverBase::getInstance()->newBuffer(indexBufferSize, backend::BufferType::INDEX, backend::BufferUsage::DYNAMIC);
     }
-    _indexBuffer->updateData(&_indices[0], indexBufferSize);
+    // only the indices of the visible chunks
+    if (_indexQuadCount > 0)
+        _indexBuffer->updateSubData(&_indices[0], 0, sizeof(decltype(_indices)::value_type) * 6 * _indexQuadCount);
 }
 
 // FastTMXLayer - setup Tiles
@@ -431,6 +407,20 @@ void FastTMXLayer::updatePrimitives()
 {
     auto blendfunc =
         _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+
+#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
+    CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_INT;
+#else
+    CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_SHORT;
+#endif
+
+    // the vertexZ without visible tiles draw nothing
+    for (auto&& e : _customCommands)
+    {
+        if (_indicesVertexZNumber.find(e.first) == _indicesVertexZNumber.end())
+            e.second->setIndexDrawInfo(0, 0);
+    }
+
     for (const auto& iter : _indicesVertexZNumber)
     {
         int start = _indicesVertexZOffsets.at(iter.first);
@@ -440,12 +430,6 @@ void FastTMXLayer::updatePrimitives()
         {
             auto command = new CustomCommand();
             command->setVertexBuffer(_vertexBuffer);
-
-#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
-            CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_INT;
-#else
-            CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_SHORT;
-#endif
             command->setIndexBuffer(_indexBuffer, indexFormat);
 
             command->setIndexDrawInfo(start * 6, iter.second * 6);
@@ -480,6 +464,9 @@ void FastTMXLayer::updatePrimitives()
         }
         else
         {
+            // the buffers are recreated when the layer grows
+            commandIter->second->setVertexBuffer(_vertexBuffer);
+            commandIter->second->setIndexBuffer(_indexBuffer, indexFormat);
             commandIter->second->setIndexDrawInfo(start * 6, iter.second * 6);
         }
     }
@@ -493,150 +480,200 @@ void FastTMXLayer::setOpacity(uint8_t opacity)
 
 void FastTMXLayer::updateTotalQuads()
 {
-    if (_quadsDirty)
+    if (!_quadsDirty)
     {
-        Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-        Vec2 texSize  = _tileSet->_imageSize;
-        _tileToQuadIndex.clear();
-        _totalQuads.resize(int(_layerSize.width * _layerSize.height));
-        _indices.resize(6 * int(_layerSize.width * _layerSize.height));
-        _tileToQuadIndex.resize(int(_layerSize.width * _layerSize.height), -1);
-        _indicesVertexZOffsets.clear();
-
-        auto color = Color4B::WHITE;
-        color.a    = getDisplayedOpacity();
-
-        if (_texture->hasPremultipliedAlpha())
+        // the tiles changed in place, e.g. by their animations, only their quads are uploaded
+        if (_dirtyQuadBegin < _dirtyQuadEnd)
         {
-            auto alpha = color.a / 255.0f;
-            color.r    = static_cast<uint8_t>(color.r * alpha);
-            color.g    = static_cast<uint8_t>(color.g * alpha);
-            color.b    = static_cast<uint8_t>(color.b * alpha);
+            _vertexBuffer->updateSubData(&_totalQuads[_dirtyQuadBegin], sizeof(V3F_C4B_T2F_Quad) * _dirtyQuadBegin,
+                                         sizeof(V3F_C4B_T2F_Quad) * (_dirtyQuadEnd - _dirtyQuadBegin));
+            _dirtyQuadBegin = _dirtyQuadEnd = 0;
         }
+        return;
+    }
 
-        int quadIndex = 0;
-        for (int y = 0; y < _layerSize.height; ++y)
-        {
-            for (int x = 0; x < _layerSize.width; ++x)
-            {
-                int tileIndex = getTileIndexByPos(x, y);
-                int tileGID   = _tiles[tileIndex];
-
-                if (tileGID == 0)
-                    continue;
+    const int width  = static_cast<int>(_layerSize.width);
+    const int height = static_cast<int>(_layerSize.height);
 
-                _tileToQuadIndex[tileIndex] = quadIndex;
+    int quadCount = 0;
+    for (int i = 0; i < width * height; ++i)
+    {
+        if (_tiles[i] != 0)
+            ++quadCount;
+    }
 
-                auto& quad = _totalQuads[quadIndex];
+    _tileToQuadIndex.assign(width * height, -1);
+    _totalQuads.resize(quadCount);
+    _indices.resize(6 * quadCount);
+    _chunks.clear();
+    _runs.clear();
 
-                Vec3 nodePos(float(x), float(y), 0);
-                _tileToNodeTransform.transformPoint(&nodePos);
+    auto color = Color4B::WHITE;
+    color.a    = getDisplayedOpacity();
 
-                float left, right, top, bottom, z;
+    if (_texture->hasPremultipliedAlpha())
+    {
+        auto alpha = color.a / 255.0f;
+        color.r    = static_cast<uint8_t>(color.r * alpha);
+        color.g    = static_cast<uint8_t>(color.g * alpha);
+        color.b    = static_cast<uint8_t>(color.b * alpha);
+    }
 
-                int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
-                z         = (float)zPos;
-                auto iter = _indicesVertexZOffsets.find(zPos);
-                if (iter == _indicesVertexZOffsets.end())
-                {
-                    _indicesVertexZOffsets[zPos] = 1;
-                }
-                else
-                {
-                    iter->second++;
-                }
-                // vertices
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.height;
-                    bottom = nodePos.y + tileSize.width;
-                    top    = nodePos.y;
-                }
-                else
+    // the quads are laid out chunk by chunk, and sorted by vertexZ in a chunk
+    std::vector<std::pair<int /*vertexZ*/, int /*tile index*/>> cells;
+    int quadIndex = 0;
+    for (int chunkY = 0; chunkY < height; chunkY += CHUNK_SIZE)
+    {
+        for (int chunkX = 0; chunkX < width; chunkX += CHUNK_SIZE)
+        {
+            cells.clear();
+            for (int y = chunkY; y < std::min(chunkY + CHUNK_SIZE, height); ++y)
+            {
+                for (int x = chunkX; x < std::min(chunkX + CHUNK_SIZE, width); ++x)
                 {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.width;
-                    bottom = nodePos.y + tileSize.height;
-                    top    = nodePos.y;
+                    int tileIndex = getTileIndexByPos(x, y);
+                    if (_tiles[tileIndex] != 0)
+                        cells.emplace_back(getVertexZForPos(Vec2((float)x, (float)y)), tileIndex);
                 }
+            }
+            std::stable_sort(cells.begin(), cells.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
 
-                if (tileGID & kTMXTileVerticalFlag)
-                    std::swap(top, bottom);
-                if (tileGID & kTMXTileHorizontalFlag)
-                    std::swap(left, right);
+            auto& chunk     = _chunks.emplace_back();
+            chunk.runOffset = static_cast<int>(_runs.size());
 
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    // FIXME: not working correctly
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = left;
-                    quad.br.vertices.y = top;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = right;
-                    quad.tl.vertices.y = bottom;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-                else
-                {
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = right;
-                    quad.br.vertices.y = bottom;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = left;
-                    quad.tl.vertices.y = top;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-
-                // texcoords
-                Rect tileTexture = _tileSet->getRectForGID(tileGID);
-                left             = (tileTexture.origin.x / texSize.width);
-                right            = left + (tileTexture.size.width / texSize.width);
-                bottom           = (tileTexture.origin.y / texSize.height);
-                top              = bottom + (tileTexture.size.height / texSize.height);
-
-                // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
-                float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
-                float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
-
-                quad.bl.texCoords.u = left + ptx;
-                quad.bl.texCoords.v = bottom + pty;
-                quad.br.texCoords.u = right - ptx;
-                quad.br.texCoords.v = bottom + pty;
-                quad.tl.texCoords.u = left + ptx;
-                quad.tl.texCoords.v = top - pty;
-                quad.tr.texCoords.u = right - ptx;
-                quad.tr.texCoords.v = top - pty;
+            Vec2 boundsMin(FLT_MAX, FLT_MAX), boundsMax(-FLT_MAX, -FLT_MAX);
+            for (auto&& cell : cells)
+            {
+                int x = cell.second % width;
+                int y = cell.second / width;
+                _tileToQuadIndex[cell.second] = quadIndex;
 
+                auto& quad = _totalQuads[quadIndex];
+                setupQuad(quad, x, y, _tiles[cell.second]);
                 quad.bl.colors = color;
                 quad.br.colors = color;
                 quad.tl.colors = color;
                 quad.tr.colors = color;
 
+                for (auto&& vertex : {quad.bl.vertices, quad.br.vertices, quad.tl.vertices, quad.tr.vertices})
+                {
+                    boundsMin.set(std::min(boundsMin.x, vertex.x), std::min(boundsMin.y, vertex.y));
+                    boundsMax.set(std::max(boundsMax.x, vertex.x), std::max(boundsMax.y, vertex.y));
+                }
+
+                if (_runs.size() > static_cast<size_t>(chunk.runOffset))
+                {
+                    auto& run = _runs.back();
+                    if (run.vertexZ == cell.first && run.y == y && run.quadOffset + run.quadCount == quadIndex)
+                    {
+                        ++run.quadCount;
+                        ++quadIndex;
+                        continue;
+                    }
+                }
+                _runs.emplace_back(TileRun{cell.first, y, x, quadIndex, 1});
                 ++quadIndex;
             }
-        }
 
-        int offset = 0;
-        for (auto&& vertexZOffset : _indicesVertexZOffsets)
-        {
-            std::swap(offset, vertexZOffset.second);
-            offset += vertexZOffset.second;
+            chunk.runCount = static_cast<int>(_runs.size()) - chunk.runOffset;
+            if (chunk.runCount > 0)
+                chunk.bounds = Rect(boundsMin, boundsMax - boundsMin);
         }
-        updateVertexBuffer();
+    }
+
+    updateVertexBuffer();
+
+    // the indices are rebuilt for the new quads
+    _visibleChunks.clear();
+    _dirty      = true;
+    _quadsDirty = false;
+}
+
+void FastTMXLayer::setupQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID)
+{
+    Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    Vec2 texSize  = _tileSet->_imageSize;
+
+    Vec3 nodePos(float(x), float(y), 0);
+    _tileToNodeTransform.transformPoint(&nodePos);
 
-        _quadsDirty = false;
+    float left, right, top, bottom, z;
+
+    z = (float)getVertexZForPos(Vec2((float)x, (float)y));
+
+    // vertices
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.height;
+        bottom = nodePos.y + tileSize.width;
+        top    = nodePos.y;
+    }
+    else
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.width;
+        bottom = nodePos.y + tileSize.height;
+        top    = nodePos.y;
+    }
+
+    if (tileGID & kTMXTileVerticalFlag)
+        std::swap(top, bottom);
+    if (tileGID & kTMXTileHorizontalFlag)
+        std::swap(left, right);
+
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        // FIXME: not working correctly
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = left;
+        quad.br.vertices.y = top;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = right;
+        quad.tl.vertices.y = bottom;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+    else
+    {
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = right;
+        quad.br.vertices.y = bottom;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = left;
+        quad.tl.vertices.y = top;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
     }
+
+    // texcoords
+    Rect tileTexture = _tileSet->getRectForGID(tileGID);
+    left             = (tileTexture.origin.x / texSize.width);
+    right            = left + (tileTexture.size.width / texSize.width);
+    bottom           = (tileTexture.origin.y / texSize.height);
+    top              = bottom + (tileTexture.size.height / texSize.height);
+
+    // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
+    float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
+    float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
+
+    quad.bl.texCoords.u = left + ptx;
+    quad.bl.texCoords.v = bottom + pty;
+    quad.br.texCoords.u = right - ptx;
+    quad.br.texCoords.v = bottom + pty;
+    quad.tl.texCoords.u = left + ptx;
+    quad.tl.texCoords.v = top - pty;
+    quad.tr.texCoords.u = right - ptx;
+    quad.tr.texCoords.v = top - pty;
 }
 
 // removing / getting tiles
@@ -777,9 +814,31 @@ void FastTMXLayer::setFlaggedTileGIDByIndex(int index, uint32_t gid)
 {
     if (gid == _tiles[index])
         return;
+
+    // a tile replaced by another one keeps its quad, only the quad is uploaded again
+    bool inPlace  = !_quadsDirty && gid != 0 && _tiles[index] != 0;
     _tiles[index] = gid;
-    _quadsDirty   = true;
-    _dirty        = true;
+    if (inPlace)
+    {
+        int quadIndex = _tileToQuadIndex[index];
+        int width     = static_cast<int>(_layerSize.width);
+        setupQuad(_totalQuads[quadIndex], index % width, index / width, gid);
+
+        if (_dirtyQuadBegin == _dirtyQuadEnd)
+        {
+            _dirtyQuadBegin = quadIndex;
+            _dirtyQuadEnd   = quadIndex + 1;
+        }
+        else
+        {
+            _dirtyQuadBegin = std::min(_dirtyQuadBegin, quadIndex);
+            _dirtyQuadEnd   = std::max(_dirtyQuadEnd, quadIndex + 1);
+        }
+        return;
+    }
+
+    _quadsDirty = true;
+    _dirty      = true;
 }
 
 void FastTMXLayer::removeChild(Node* node, bool cleanup)
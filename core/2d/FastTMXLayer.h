@@ -303,9 +303,31 @@ public:
                                                      TMXMapInfo* mapInfo);
 
 protected:
+    /** The layer is split into chunks of CHUNK_SIZE x CHUNK_SIZE tiles, which are culled as a whole. */
+    static constexpr int CHUNK_SIZE = 16;
+
+    /** The quads of a chunk and their bounds in node space, the quads are laid out chunk by chunk. */
+    struct TileChunk
+    {
+        Rect bounds;
+        int runOffset = 0;
+        int runCount  = 0;
+    };
+
+    /** Consecutive quads of a chunk on the same row with the same vertexZ. */
+    struct TileRun
+    {
+        int vertexZ;
+        int y;
+        int x;
+        int quadOffset;
+        int quadCount;
+    };
+
     virtual void setOpacity(uint8_t opacity) override;
 
-    void updateTiles(const Rect& culledRect);
+    /** Culls the chunks, and rebuilds the indices when the visible chunks changed. */
+    bool updateTiles(const Rect& culledRect);
     Vec2 calculateLayerOffset(const Vec2& offset);
 
     /* The layer recognizes some special properties, like cc_vertexz */
@@ -321,6 +343,7 @@ protected:
 
     //
     void updateTotalQuads();
+    void setupQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID);
 
     int getTileIndexByPos(int x, int y) const { return x + y * (int)_layerSize.width; }
 
@@ -379,8 +402,18 @@ protected:
 #endif
     std::map<int /*vertexZ*/, int /*offset to _indices by quads*/> _indicesVertexZOffsets;
     std::unordered_map<int /*vertexZ*/, int /*number to quads*/> _indicesVertexZNumber;
+    int _indexQuadCount = 0;
     bool _dirty = true;
 
+    std::vector<TileChunk> _chunks;
+    std::vector<TileRun> _runs;
+    std::vector<int> _visibleChunks;
+    std::vector<int> _culledChunks;
+    std::vector<const TileRun*> _visibleRuns;
+    /** the quads rewritten in place since the vertex buffer was uploaded */
+    int _dirtyQuadBegin = 0;
+    int _dirtyQuadEnd   = 0;
+
     backend::Buffer* _vertexBuffer = nullptr;
     backend::Buffer* _indexBuffer  = nullptr;
 
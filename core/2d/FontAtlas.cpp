@@ -32,6 +32,8 @@
 #endif
 #include <algorithm>
 #include "2d/FontFreeType.h"
+#include "2d/FontSystem.h"
+#include "base/Allocator.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/EventListenerCustom.h"
@@ -48,8 +50,28 @@
 namespace ax
 {
 
+// a glyph rasterized on a worker, missing glyphs are resolved with the fallback fonts on the axmol thread
+struct FontAtlas::RasterizedLetter
+{
+    char32_t charCode = 0;
+    bool missing      = false;
+    int width         = 0;
+    int height        = 0;
+    int xAdvance      = 0;
+    Rect rect;
+    std::unique_ptr<uint8_t[]> bitmap;
+};
+
+// outlives the atlas while a batch is in flight
+struct FontAtlas::AsyncState
+{
+    FontAtlas* atlas = nullptr;
+};
+
 const int FontAtlas::CacheTextureWidth     = 512;
 const int FontAtlas::CacheTextureHeight    = 512;
+const int FontAtlas::CacheMaxPageCount     = 4;
+bool FontAtlas::_asyncRasterizationEnabled = false;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__ax_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__ax_RESET_FONTATLAS";
 
@@ -106,7 +128,8 @@ void FontAtlas::loadFontAtlas(std::string_view fontatlasFile, hlookup::string_ma
                 break;
         }
 
-        auto fontAtlas = new FontAtlas(font, atlasDim[0], atlasDim[1], AX_CONTENT_SCALE_FACTOR());
+        auto fontAtlas               = new FontAtlas(font, atlasDim[0], atlasDim[1], AX_CONTENT_SCALE_FACTOR());
+        fontAtlas->_prebuiltFaceSize = faceSize;
 
         try
         {
@@ -161,21 +184,34 @@ FontAtlas::FontAtlas(Font* theFont, int atlasWidth, int atlasHeight, float scale
         {
             _letterPadding += 2 * FontFreeType::DistanceMapSpread;
         }
+    }
+    else if ((_fontSystem = dynamic_cast<FontSystem*>(_font)))
+    {
+        // the glyphs are cells starting at the top of the line
+        _lineHeight          = (float)_font->getFontMaxHeight();
+        _fontAscender        = 0;
+        _strideShift         = 0;
+        _pixelFormat         = backend::PixelFormat::R8;
+        _currentPageDataSize = _width * _height;
+    }
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
+    // the glyphs rasterized at runtime are lost with the renderer
+    if (_fontFreeType || _fontSystem)
+    {
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
 
         _rendererRecreatedListener = EventListenerCustom::create(
             EVENT_RENDERER_RECREATED, AX_CALLBACK_1(FontAtlas::listenRendererRecreated, this));
         eventDispatcher->addEventListenerWithFixedPriority(_rendererRecreatedListener, 1);
-#endif
     }
+#endif
 }
 
 void FontAtlas::reinit()
 {
     if (!_currentPageData)
-        _currentPageData = new uint8_t[_currentPageDataSize];
+        _currentPageData = static_cast<uint8_t*>(Memory::allocate(_currentPageDataSize, MemoryTag::FONT));
     _currentPage = -1;
 
     addNewPage();
@@ -184,7 +220,7 @@ void FontAtlas::reinit()
 FontAtlas::~FontAtlas()
 {
 #if AX_ENABLE_CACHE_TEXTURE_DATA
-    if (_fontFreeType && _rendererRecreatedListener)
+    if (_rendererRecreatedListener)
     {
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
         eventDispatcher->removeEventListener(_rendererRecreatedListener);
@@ -192,20 +228,29 @@ FontAtlas::~FontAtlas()
     }
 #endif
 
+    if (_asyncState)
+        _asyncState->atlas = nullptr;
+    AX_SAFE_RELEASE(_workerFont);
+
     _font->release();
     releaseTextures();
 
-    AX_SAFE_DELETE_ARRAY(_currentPageData);
+    Memory::deallocate(_currentPageData, _currentPageDataSize, MemoryTag::FONT);
 }
 
 void FontAtlas::initWithSettings(void* opaque /*simdjson::ondemand::document*/)
 {
+    simdjson::ondemand::document& settings = *(simdjson::ondemand::document*)opaque;
+
+    // optional, the single channel atlases don't have it
+    std::string_view distanceField;
+    if (settings["distanceField"].get(distanceField) == simdjson::SUCCESS && distanceField == "msdf"sv)
+        enableMultiChannelDistanceField();
+
     if (!_currentPageData)
-        _currentPageData = new uint8_t[_currentPageDataSize];
+        _currentPageData = static_cast<uint8_t*>(Memory::allocate(_currentPageDataSize, MemoryTag::FONT));
     _currentPage = -1;
 
-    simdjson::ondemand::document& settings = *(simdjson::ondemand::document*)opaque;
-
     // pages
     for (auto page : settings["pages"].get_array())
     {
@@ -217,6 +262,12 @@ void FontAtlas::initWithSettings(void* opaque /*simdjson::ondemand::document*/)
     _currentPageOrigX = static_cast<float>(settings["pageX"].get_double());
     _currentPageOrigY = static_cast<float>(settings["pageY"].get_double());
 
+    // the letters of an unfinished line reach below pageY
+    int pageBottom = static_cast<int>(_currentPageOrigY);
+    if (_currentPageOrigX > 0)
+        pageBottom += static_cast<int>(_lineHeight) + _letterPadding + _letterEdgeExtend;
+    resetSkyline((std::min)(pageBottom, _height));
+
     // letters
     FontLetterDefinition tempDef;
     tempDef.rotated         = false;
@@ -243,17 +294,30 @@ void FontAtlas::initWithSettings(void* opaque /*simdjson::ondemand::document*/)
         tempDef.width /= _scaleFactor;
         tempDef.height /= _scaleFactor;
         _letterDefinitions.emplace(charCode, tempDef);
+
+        if (tempDef.textureID >= 0 && tempDef.textureID < static_cast<int>(_pages.size()))
+            _pages[tempDef.textureID].glyphs.emplace_back(charCode);
     }
 }
 
+void FontAtlas::enableMultiChannelDistanceField()
+{
+    AXASSERT(_currentPageData == nullptr, "FontAtlas: the page format can't change once a page is added");
+
+    _multiChannelDistanceField = true;
+    _strideShift               = 2;
+    _pixelFormat               = backend::PixelFormat::RGBA8;
+    _currentPageDataSize       = _width * _height << _strideShift;
+}
+
 void FontAtlas::reset()
 {
     releaseTextures();
 
-    _currLineHeight   = 0;
     _currentPageOrigX = 0;
     _currentPageOrigY = 0;
     _letterDefinitions.clear();
+    _pages.clear();
 
     reinit();
 }
@@ -269,7 +333,7 @@ void FontAtlas::releaseTextures()
 
 void FontAtlas::purgeTexturesAtlas()
 {
-    if (_fontFreeType)
+    if (_fontFreeType || _fontSystem)
     {
         reset();
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
@@ -324,15 +388,22 @@ void FontAtlas::findNewCharacters(const std::u32string& u32Text, std::unordered_
     }
     else
     {
+        // the pages of the letters already in the atlas must not be evicted while the new ones are added
         for (auto&& charCode : u32Text)
-            if (_letterDefinitions.find(charCode) == _letterDefinitions.end())
+        {
+            auto it = _letterDefinitions.find(charCode);
+            if (it == _letterDefinitions.end())
                 charset.insert(charCode);
+            else if (it->second.width > 0)
+                touchPage(it->second.textureID);
+        }
     }
 }
 
 bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
 {
-    if (_fontFreeType == nullptr)
+    // the multi-channel glyphs are generated offline only
+    if ((_fontFreeType == nullptr && _fontSystem == nullptr) || _multiChannelDistanceField)
     {
         return false;
     }
@@ -347,17 +418,25 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         return false;
     }
 
-    int adjustForDistanceMap = _letterPadding / 2;
-    int adjustForExtend      = _letterEdgeExtend / 2;
-    int bitmapWidth          = 0;
-    int bitmapHeight         = 0;
-    int glyphHeight;
+    int bitmapWidth  = 0;
+    int bitmapHeight = 0;
+    int xAdvance     = 0;
     Rect tempRect;
-    FontLetterDefinition tempDef;
 
-    auto pixelFormat = _pixelFormat;
+    if (_fontSystem)
+    {
+        // the platform rasterizes the glyphs in the page format
+        for (auto&& charCode : charCodeSet)
+        {
+            auto bitmap = _fontSystem->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, xAdvance);
+            tempRect.setRect(0, 0, (float)bitmapWidth, (float)bitmapHeight);
+            placeLetter(charCode, nullptr, bitmap, bitmapWidth, bitmapHeight, tempRect, xAdvance);
+            delete[] bitmap;
+        }
 
-    int startY = (int)_currentPageOrigY;
+        updateTextureContent();
+        return true;
+    }
 
     for (auto&& charCode : charCodeSet)
     {
@@ -367,7 +446,7 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         if (missingIt == _missingGlyphFallbackFonts.end())
         {
             FontFaceInfo* fallbackFaceInfo = nullptr;
-            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance,
+            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, xAdvance,
                                                   &fallbackFaceInfo);
             if (!bitmap && fallbackFaceInfo)
             {
@@ -387,7 +466,7 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
                 {
                     unsigned int glyphIndex = fallbackFaceInfo->currentGlyphIndex;
                     bitmap =
-                        charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
+                        charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, xAdvance);
                     _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
                 }
             }
@@ -396,80 +475,396 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         {  // found fallback font for missing charas, getGlyphBitmap without fallback
             charRenderer = missingIt->second.first;
             unsigned int glyphIndex = missingIt->second.second;
-            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
+            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, xAdvance);
         }
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+
+        placeLetter(charCode, charRenderer, bitmap, bitmapWidth, bitmapHeight, tempRect, xAdvance);
+    }
+
+    updateTextureContent();
+    return true;
+}
+
+bool FontAtlas::requestLetterDefinitions(const std::u32string& utf32Text)
+{
+    if (!_asyncRasterizationEnabled || !_fontFreeType || _multiChannelDistanceField)
+    {
+        prepareLetterDefinitions(utf32Text);
+        return true;
+    }
+
+    if (!_currentPageData)
+        reinit();
+
+    bool ready = true;
+    for (auto&& charCode : utf32Text)
+    {
+        auto it = _letterDefinitions.find(charCode);
+        if (it != _letterDefinitions.end())
         {
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+            if (it->second.width > 0)
+                touchPage(it->second.textureID);
+            continue;
+        }
+
+        ready = false;
+        if (_pendingLetters.emplace(charCode).second)
+            _queuedLetters.emplace_back(charCode);
+    }
+
+    if (!_rasterizing && !_queuedLetters.empty())
+        submitPendingLetters();
+    return ready;
+}
+
+void FontAtlas::submitPendingLetters()
+{
+    if (!_workerFont)
+    {
+        _workerFont = _fontFreeType->clone();
+        AX_SAFE_RETAIN(_workerFont);
+    }
+
+    if (!_workerFont)
+    {
+        // the face can't be opened twice, rasterize here
+        std::u32string letters(_queuedLetters.begin(), _queuedLetters.end());
+        _queuedLetters.clear();
+        _pendingLetters.clear();
+        prepareLetterDefinitions(letters);
+        return;
+    }
 
-            if (_currentPageOrigX + tempDef.width > _width)
+    if (!_asyncState)
+    {
+        _asyncState        = std::make_shared<AsyncState>();
+        _asyncState->atlas = this;
+    }
+
+    auto letters = std::make_shared<std::vector<RasterizedLetter>>(_queuedLetters.size());
+    for (size_t i = 0; i < _queuedLetters.size(); ++i)
+        (*letters)[i].charCode = _queuedLetters[i];
+    _queuedLetters.clear();
+    _rasterizing = true;
+
+    // the worker font is only used by this batch until it's done, a FT_Face must not be shared between threads
+    auto font  = _workerFont;
+    auto state = _asyncState;
+    font->retain();
+    Director::getInstance()->getJobSystem()->enqueue(
+        [font, letters] {
+        for (auto&& letter : *letters)
+        {
+            auto glyphIndex = font->getGlyphIndex(letter.charCode);
+            if (glyphIndex == 0)
             {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
-                {
-                    updateTextureContent(pixelFormat, startY);
+                letter.missing = true;
+                continue;
+            }
 
-                    startY = 0;
+            auto bitmap =
+                font->getGlyphBitmapByIndex(glyphIndex, letter.width, letter.height, letter.rect, letter.xAdvance);
+            if (!bitmap || letter.width <= 0 || letter.height <= 0)
+                continue;
 
-                    addNewPage();
-                }
+            // the outline bitmaps are allocated, the others point into the glyph slot of the face
+            if (font->getOutlineSize() > 0)
+            {
+                letter.bitmap.reset(bitmap);
             }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
+            else
             {
-                _currLineHeight = glyphHeight;
+                letter.bitmap.reset(new uint8_t[letter.width * letter.height]);
+                memcpy(letter.bitmap.get(), bitmap, letter.width * letter.height);
             }
-            charRenderer->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
-                                       (int)_currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight,
-                                        _width, _height);
-
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
-            // take from pixels to points
-            tempDef.width   = tempDef.width / _scaleFactor;
-            tempDef.height  = tempDef.height / _scaleFactor;
-            tempDef.U       = tempDef.U / _scaleFactor;
-            tempDef.V       = tempDef.V / _scaleFactor;
-            tempDef.rotated = false;
+        }
+    },
+        [font, letters, state] {
+        if (state->atlas)
+            state->atlas->onLettersRasterized(*letters);
+        font->release();
+    });
+}
+
+void FontAtlas::onLettersRasterized(std::vector<RasterizedLetter>& letters)
+{
+    _rasterizing = false;
+    if (!_currentPageData)
+        reinit();
+
+    std::u32string missingLetters;
+    for (auto&& letter : letters)
+    {
+        _pendingLetters.erase(letter.charCode);
+        if (_letterDefinitions.find(letter.charCode) != _letterDefinitions.end())
+            continue;
+
+        if (letter.missing)
+        {
+            missingLetters.push_back(letter.charCode);
+            continue;
+        }
+
+        auto bitmap = letter.bitmap.get();
+        if (_fontFreeType->getOutlineSize() > 0)
+            letter.bitmap.release();  // consumed by placeLetter
+        placeLetter(letter.charCode, _fontFreeType, bitmap, letter.width, letter.height, letter.rect,
+                    letter.xAdvance);
+    }
+    updateTextureContent();
+
+    if (!missingLetters.empty())
+        prepareLetterDefinitions(missingLetters);
+
+    if (!_queuedLetters.empty())
+        submitPendingLetters();
+}
+
+bool FontAtlas::placeLetter(char32_t charCode,
+                            FontFreeType* renderer,
+                            uint8_t* bitmap,
+                            int bitmapWidth,
+                            int bitmapHeight,
+                            const Rect& rect,
+                            int xAdvance)
+{
+    int adjustForDistanceMap = _letterPadding / 2;
+    int adjustForExtend      = _letterEdgeExtend / 2;
+
+    // one pixel gap to the neighbours, so linear filtering doesn't bleed
+    int glyphWidth = 0, glyphHeight = 0, glyphX = 0, glyphY = 0;
+    bool allocated = false;
+    if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+    {
+        glyphWidth  = (std::max)(bitmapWidth, static_cast<int>(std::ceil(rect.size.width))) + _letterPadding +
+                     _letterEdgeExtend + 1;
+        glyphHeight = (std::max)(bitmapHeight, static_cast<int>(std::ceil(rect.size.height))) + _letterPadding +
+                      _letterEdgeExtend + 1;
+        allocated = allocateGlyphRect(glyphWidth, glyphHeight, glyphX, glyphY);
+        if (!allocated)
+        {
+            updateTextureContent();
+            switchPage();
+            allocated = allocateGlyphRect(glyphWidth, glyphHeight, glyphX, glyphY);
+            if (!allocated)
+                AXLOGW("FontAtlas: the glyph {} doesn't fit in a {}x{} page", (uint32_t)charCode, _width, _height);
+        }
+    }
+
+    FontLetterDefinition tempDef;
+    tempDef.xAdvance = xAdvance;
+    tempDef.rotated  = false;
+    if (allocated)
+    {
+        tempDef.validDefinition = true;
+        tempDef.width           = rect.size.width + _letterPadding + _letterEdgeExtend;
+        tempDef.height          = rect.size.height + _letterPadding + _letterEdgeExtend;
+        tempDef.offsetX         = rect.origin.x - adjustForDistanceMap - adjustForExtend;
+        tempDef.offsetY         = _fontAscender + rect.origin.y - adjustForDistanceMap - adjustForExtend;
+
+        // consumes the outline bitmaps
+        if (renderer)
+            renderer->renderCharAt(_currentPageData, glyphX + adjustForExtend, glyphY + adjustForExtend, bitmap,
+                                   bitmapWidth, bitmapHeight, _width, _height);
+        else
+        {
+            const size_t rowSize = static_cast<size_t>(bitmapWidth) << _strideShift;
+            for (int row = 0; row < bitmapHeight; ++row)
+                memcpy(_currentPageData +
+                           ((_width * (glyphY + adjustForExtend + row) + glyphX + adjustForExtend) << _strideShift),
+                       bitmap + row * rowSize, rowSize);
+        }
+
+        if (_dirtyRect[2] == _dirtyRect[0])
+        {
+            _dirtyRect[0] = glyphX;
+            _dirtyRect[1] = glyphY;
+            _dirtyRect[2] = glyphX + glyphWidth;
+            _dirtyRect[3] = glyphY + glyphHeight;
         }
         else
         {
-            if (bitmap)
-                delete[] bitmap;
-
-            tempDef.validDefinition = !!tempDef.xAdvance;
-            tempDef.width           = 0;
-            tempDef.height          = 0;
-            tempDef.U               = 0;
-            tempDef.V               = 0;
-            tempDef.offsetX         = 0;
-            tempDef.offsetY         = 0;
-            tempDef.textureID       = 0;
-            tempDef.rotated         = false;
-            _currentPageOrigX += 1;
+            _dirtyRect[0] = (std::min)(_dirtyRect[0], glyphX);
+            _dirtyRect[1] = (std::min)(_dirtyRect[1], glyphY);
+            _dirtyRect[2] = (std::max)(_dirtyRect[2], glyphX + glyphWidth);
+            _dirtyRect[3] = (std::max)(_dirtyRect[3], glyphY + glyphHeight);
+        }
+
+        tempDef.textureID = _currentPage;
+        _pages[_currentPage].glyphs.emplace_back(charCode);
+        touchPage(_currentPage);
+
+        // take from pixels to points
+        tempDef.width  = tempDef.width / _scaleFactor;
+        tempDef.height = tempDef.height / _scaleFactor;
+        tempDef.U      = glyphX / _scaleFactor;
+        tempDef.V      = glyphY / _scaleFactor;
+    }
+    else
+    {
+        if (bitmap && renderer && renderer->getOutlineSize() > 0)
+            delete[] bitmap;
+
+        tempDef.validDefinition = !!tempDef.xAdvance;
+        tempDef.width           = 0;
+        tempDef.height          = 0;
+        tempDef.U               = 0;
+        tempDef.V               = 0;
+        tempDef.offsetX         = 0;
+        tempDef.offsetY         = 0;
+        tempDef.textureID       = 0;
+    }
+
+    _letterDefinitions[charCode] = tempDef;
+
+    // everything below the highest skyline node is free, saved by the atlas generator as the page origin
+    _currentPageOrigX = 0;
+    _currentPageOrigY = 0;
+    for (auto&& node : _skyline)
+        _currentPageOrigY = (std::max)(_currentPageOrigY, static_cast<float>(node.y));
+
+    return allocated;
+}
+
+void FontAtlas::updateTextureContent()
+{
+    auto left   = _dirtyRect[0];
+    auto top    = _dirtyRect[1];
+    auto width  = (std::min)(_dirtyRect[2], _width) - left;
+    auto height = (std::min)(_dirtyRect[3], _height) - top;
+    _dirtyRect[0] = _dirtyRect[2] = 0;
+    if (width <= 0 || height <= 0)
+        return;
+
+    // the rows of a full width rect are contiguous, otherwise only the dirty rect is copied out and uploaded
+    const int bpp = 1 << _strideShift;
+    auto data     = _currentPageData + ((_width * top + left) << _strideShift);
+    if (width != _width)
+    {
+        _uploadBuffer.resize(static_cast<size_t>(width) * height * bpp);
+        for (int row = 0; row < height; ++row)
+            memcpy(_uploadBuffer.data() + static_cast<size_t>(row) * width * bpp, data + ((_width * row) << _strideShift),
+                   static_cast<size_t>(width) * bpp);
+        data = _uploadBuffer.data();
+    }
+    _atlasTextures[_currentPage]->updateWithSubData(data, left, top, width, height);
+}
+
+bool FontAtlas::allocateGlyphRect(int width, int height, int& x, int& y)
+{
+    int bestIndex = -1;
+    int bestY     = _height;
+    int bestWidth = _width + 1;
+    for (int i = 0, count = static_cast<int>(_skyline.size()); i < count; ++i)
+    {
+        int nodeX = _skyline[i].x;
+        if (nodeX + width > _width)
+            break;
+
+        // the rect rests on the highest node it spans
+        int nodeY     = 0;
+        int remaining = width;
+        for (int k = i; remaining > 0; ++k)
+        {
+            nodeY = (std::max)(nodeY, _skyline[k].y);
+            remaining -= _skyline[k].width;
         }
+        if (nodeY + height > _height)
+            continue;
 
-        _letterDefinitions[charCode] = tempDef;
+        if (nodeY < bestY || (nodeY == bestY && _skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestY     = nodeY;
+            bestWidth = _skyline[i].width;
+        }
     }
 
-    updateTextureContent(pixelFormat, startY);
+    if (bestIndex < 0)
+        return false;
 
+    x = _skyline[bestIndex].x;
+    y = bestY;
+    _skyline.insert(_skyline.begin() + bestIndex, SkylineNode{x, y + height, width});
+
+    // shrink or remove the nodes covered by the new one
+    for (size_t i = bestIndex + 1; i < _skyline.size();)
+    {
+        auto& prev = _skyline[i - 1];
+        auto& node = _skyline[i];
+        int overlap = prev.x + prev.width - node.x;
+        if (overlap <= 0)
+            break;
+        node.x += overlap;
+        node.width -= overlap;
+        if (node.width > 0)
+            break;
+        _skyline.erase(_skyline.begin() + i);
+    }
+
+    for (size_t i = 0; i + 1 < _skyline.size();)
+    {
+        if (_skyline[i].y == _skyline[i + 1].y)
+        {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
     return true;
 }
 
-void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
+void FontAtlas::resetSkyline(int y)
 {
-    auto data = _currentPageData + (_width * (int)startY << _strideShift);
-    _atlasTextures[_currentPage]->updateWithSubData(data, 0, startY, _width,
-                                                    (std::min)((int)_currentPageOrigY - startY + _currLineHeight, _height));
+    _skyline.clear();
+    _skyline.emplace_back(SkylineNode{0, y, _width});
+    _dirtyRect[0] = _dirtyRect[2] = 0;
+}
+
+void FontAtlas::touchPage(int page)
+{
+    if (page >= 0 && page < static_cast<int>(_pages.size()))
+        _pages[page].lastUsedFrame = Director::getInstance()->getTotalFrames();
+}
+
+int FontAtlas::findEvictablePage() const
+{
+    if (_maxPageCount <= 0 || static_cast<int>(_pages.size()) < _maxPageCount)
+        return -1;
+
+    // pages drawn in the current frame are kept, the atlas grows past its budget when they're all in use
+    auto frame  = Director::getInstance()->getTotalFrames();
+    int victim  = -1;
+    for (int i = 0, count = static_cast<int>(_pages.size()); i < count; ++i)
+    {
+        auto lastUsedFrame = _pages[i].lastUsedFrame;
+        if (lastUsedFrame != frame && (victim < 0 || lastUsedFrame < _pages[victim].lastUsedFrame))
+            victim = i;
+    }
+    return victim;
+}
+
+void FontAtlas::switchPage()
+{
+    int victim = findEvictablePage();
+    if (victim < 0)
+    {
+        addNewPage();
+        return;
+    }
+
+    // the labels using the evicted letters lay out again and rasterize them into the current pages
+    auto& page = _pages[victim];
+    for (auto&& charCode : page.glyphs)
+        _letterDefinitions.erase(charCode);
+    page.glyphs.clear();
+    ++_generation;
+
+    _currentPage = victim;
+    memset(_currentPageData, 0, _currentPageDataSize);
+    resetSkyline(0);
+    touchPage(victim);
 }
 
 void FontAtlas::addNewPage()
@@ -477,7 +872,7 @@ void FontAtlas::addNewPage()
     memset(_currentPageData, 0, _currentPageDataSize);
     addNewPageWithData(_currentPageData, _currentPageDataSize);
 
-    _currentPageOrigY = 0;
+    resetSkyline(0);
 }
 
 void FontAtlas::addNewPageWithData(const uint8_t* data, size_t size)
@@ -494,6 +889,9 @@ void FontAtlas::addNewPageWithData(const uint8_t* data, size_t size)
 
     setTexture(++_currentPage, texture);
     texture->release();
+
+    _pages.resize(_currentPage + 1);
+    touchPage(_currentPage);
 }
 
 void FontAtlas::setTexture(unsigned int slot, Texture2D* texture)
@@ -32,6 +32,9 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include <unordered_set>
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
@@ -48,6 +51,7 @@ class Font;
 class EventCustom;
 class EventListenerCustom;
 class FontFreeType;
+class FontSystem;
 
 struct FontLetterDefinition
 {
@@ -68,6 +72,8 @@ class AX_DLL FontAtlas : public Object
 public:
     static const int CacheTextureWidth;
     static const int CacheTextureHeight;
+    /** The default page budget of the dynamic atlases, 0 means unlimited. */
+    static const int CacheMaxPageCount;
     static const char* CMD_PURGE_FONTATLAS;
     static const char* CMD_RESET_FONTATLAS;
     static void loadFontAtlas(std::string_view fontatlasFile, hlookup::string_map<FontAtlas*>& outAtlasMap);
@@ -87,6 +93,29 @@ public:
 
     bool prepareLetterDefinitions(const std::u32string& utf16String);
 
+    /** Enables rasterizing the missing glyphs of the labels on the JobSystem workers, disabled by default. */
+    static void setAsyncRasterizationEnabled(bool enabled) { _asyncRasterizationEnabled = enabled; }
+    static bool isAsyncRasterizationEnabled() { return _asyncRasterizationEnabled; }
+
+    /** Makes sure the letters of a text are in the atlas.
+     With async rasterization enabled, the missing glyphs are rasterized on a worker with a face of its own and
+     false is returned until they are all in the atlas, the glyphs of a batch are packed and uploaded together on the
+     axmol thread. Otherwise it's prepareLetterDefinitions and returns true.
+     */
+    bool requestLetterDefinitions(const std::u32string& utf32Text);
+
+    /** Whether glyphs requested by requestLetterDefinitions are still being rasterized. */
+    bool hasPendingLetters() const { return !_pendingLetters.empty(); }
+
+    /** Whether the pages are RGBA8 multi-channel signed distance fields generated offline by SDFGen.
+     Such an atlas is loaded with FontAtlasCache::preloadFontAtlas and serves every size of its font, the glyphs
+     missing from it aren't rasterized at runtime.
+     */
+    bool isMultiChannelDistanceField() const { return _multiChannelDistanceField; }
+
+    /** The face size the glyphs of an atlas loaded from a .xasset were generated at, 0 for the other atlases. */
+    int getPrebuiltFaceSize() const { return _prebuiltFaceSize; }
+
     const auto& getLetterDefinitions() const { return _letterDefinitions; }
 
     const std::unordered_map<unsigned int, Texture2D*>& getTextures() const { return _atlasTextures; }
@@ -115,6 +144,19 @@ public:
      */
     void purgeTexturesAtlas();
 
+    /** Sets the max page count of a dynamic atlas, 0 means unlimited.
+     When the budget is reached, the least recently used page that isn't drawn in the current frame is cleared
+     and reused for the new glyphs, the labels using its glyphs lay out their text again.
+     */
+    void setMaxPageCount(int count) { _maxPageCount = count; }
+    int getMaxPageCount() const { return _maxPageCount; }
+
+    /** Marks a page as used in the current frame, so it isn't evicted. */
+    void touchPage(int page);
+
+    /** Incremented each time glyphs are evicted, the letter definitions fetched before are stale. */
+    unsigned int getGeneration() const { return _generation; }
+
     /** sets font texture parameters:
      - GL_TEXTURE_MIN_FILTER = GL_LINEAR
      - GL_TEXTURE_MAG_FILTER = GL_LINEAR
@@ -130,6 +172,9 @@ public:
 protected:
     void initWithSettings(void* opaque /*simdjson::ondemand::document*/);
 
+    /** Switches the pages to RGBA8, must be called before the first page is added. */
+    void enableMultiChannelDistanceField();
+
     void reset();
 
     void reinit();
@@ -145,7 +190,46 @@ protected:
      */
     void scaleFontLetterDefinition(float scaleFactor);
 
-    void updateTextureContent(backend::PixelFormat format, int startY);
+    /** Packs a rasterized glyph into the current page and adds its letter definition.
+     Without a renderer the bitmap is in the page format and is copied as is, the caller keeps its ownership.
+     */
+    bool placeLetter(char32_t charCode,
+                     FontFreeType* renderer,
+                     uint8_t* bitmap,
+                     int bitmapWidth,
+                     int bitmapHeight,
+                     const Rect& rect,
+                     int xAdvance);
+
+    struct RasterizedLetter;
+    struct AsyncState;
+
+    void submitPendingLetters();
+    void onLettersRasterized(std::vector<RasterizedLetter>& letters);
+
+    /** Uploads the glyphs rasterized into the current page since the last upload. */
+    void updateTextureContent();
+
+    /** Finds room for a glyph in the current page with skyline bottom left packing. */
+    bool allocateGlyphRect(int width, int height, int& x, int& y);
+    void resetSkyline(int y);
+
+    /** Moves to a new page, or evicts the least recently used one when the page budget is reached. */
+    void switchPage();
+    int findEvictablePage() const;
+
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct AtlasPage
+    {
+        std::vector<char32_t> glyphs;
+        unsigned int lastUsedFrame = 0;
+    };
 
     std::unordered_map<unsigned int, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
@@ -155,6 +239,7 @@ protected:
 
     Font* _font                 = nullptr;
     FontFreeType* _fontFreeType = nullptr;
+    FontSystem* _fontSystem     = nullptr;
 
     int _width         = 0;  // atlas width
     int _height        = 0;  // atlas height
@@ -177,7 +262,22 @@ protected:
     int _fontAscender                               = 0;
     EventListenerCustom* _rendererRecreatedListener = nullptr;
     bool _antialiasEnabled                          = true;
-    int _currLineHeight                             = 0;
+    int _maxPageCount                               = CacheMaxPageCount;
+    unsigned int _generation                        = 0;
+    int _prebuiltFaceSize                           = 0;
+    bool _multiChannelDistanceField                 = false;
+
+    std::vector<AtlasPage> _pages;
+    std::vector<SkylineNode> _skyline;  // of the current page
+    int _dirtyRect[4]{};                // left, top, right, bottom of the current page, right == left when clean
+    std::vector<uint8_t> _uploadBuffer;
+
+    static bool _asyncRasterizationEnabled;
+    std::unordered_set<char32_t> _pendingLetters;  // requested, not in the atlas yet
+    std::vector<char32_t> _queuedLetters;          // pending, waiting for the running batch
+    std::shared_ptr<AsyncState> _asyncState;
+    FontFreeType* _workerFont = nullptr;  // rasterizes on the workers, one batch at a time
+    bool _rasterizing         = false;
 
     friend class Label;
 };
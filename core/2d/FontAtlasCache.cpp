@@ -31,6 +31,7 @@
 #include "2d/FontFreeType.h"
 #include "2d/FontAtlas.h"
 #include "2d/FontCharMap.h"
+#include "2d/FontSystem.h"
 #include "2d/Label.h"
 #include "platform/FileUtils.h"
 #include "base/format.h"
@@ -64,6 +65,14 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(_ttfConfig* config)
     bool useDistanceField  = config->distanceFieldEnabled;
     int outlineSize        = useDistanceField ? 0 : config->outlineSize;
 
+    // a multi-channel atlas preloaded from a .xasset serves every size of its font
+    if (useDistanceField)
+    {
+        auto it = _atlasMap.find(fmt::format("msdf {}", realFontFilename));
+        if (it != _atlasMap.end())
+            return it->second;
+    }
+
     // underlaying font engine (freetype2) only support int type, so convert to int avoid precision issue
     if (!config->distanceFieldEnabled)
         config->faceSize = static_cast<int>(config->fontSize);
@@ -150,6 +159,29 @@ FontAtlas* FontAtlasCache::getFontAtlasFNT(std::string_view fontFileName, const
     return getFontAtlasFNT(fontFileName, Rect(imageOffset.x, imageOffset.y, 0, 0), false);
 }
 #endif
+FontAtlas* FontAtlasCache::getFontAtlasSystemFont(std::string_view fontName, float fontSize)
+{
+    // the platform text API takes an int size too
+    auto scaledFontSize = static_cast<int>(fontSize * AX_CONTENT_SCALE_FACTOR());
+
+    std::string atlasName = fmt::format("system {} {}", scaledFontSize, fontName);
+    auto it               = _atlasMap.find(atlasName);
+    if (it == _atlasMap.end())
+    {
+        auto font = FontSystem::create(fontName, scaledFontSize);
+        if (font)
+        {
+            auto tempAtlas = font->newFontAtlas();
+            if (tempAtlas)
+                return _atlasMap.emplace(std::move(atlasName), tempAtlas).first->second;
+        }
+    }
+    else
+        return it->second;
+
+    return nullptr;
+}
+
 FontAtlas* FontAtlasCache::getFontAtlasCharMap(std::string_view plistFile)
 {
     std::string_view atlasName = plistFile;
@@ -45,6 +45,7 @@ public:
     /**
      * @brief preload a SDF fontatlas
      * since axmol-2.1.0, must call before creating any Label
+     * A multi-channel (MSDF) fontatlas is used by the distance field labels of its font at every font size.
      */
     static void preloadFontAtlas(std::string_view fontatlasFile);
     static FontAtlas* getFontAtlasTTF(_ttfConfig* config);
@@ -61,6 +62,8 @@ public:
                                           int startCharMap);
     static FontAtlas* getFontAtlasCharMap(Texture2D* texture, int itemWidth, int itemHeight, int startCharMap);
     static FontAtlas* getFontAtlasCharMap(std::string_view plistFile);
+    /** The atlas the system font labels of a font and size share, see Label::setSystemFontGlyphCacheEnabled. */
+    static FontAtlas* getFontAtlasSystemFont(std::string_view fontName, float fontSize);
 
     static bool releaseFontAtlas(FontAtlas* atlas);
 
@@ -64,7 +64,7 @@ constexpr std::string_view _glyphNEHE =
 
 typedef struct _DataRef
 {
-    Data data;
+    FileView data;
     unsigned int referenceCount = 0;
 } DataRef;
 
@@ -123,6 +123,20 @@ FontFreeType* FontFreeType::createWithFaceInfo(FontFaceInfo* info, FontFreeType*
     return nullptr;
 }
 
+FontFreeType* FontFreeType::clone() const
+{
+    // the outline size is scaled again by the constructor
+    FontFreeType* tempFont = new FontFreeType(_distanceFieldEnabled, _outlineSize / AX_CONTENT_SCALE_FACTOR());
+    tempFont->setGlyphCollection(_usedGlyphs, _customGlyphs);
+    if (tempFont->initWithFontPath(_fontName, _faceSize))
+    {
+        tempFont->autorelease();
+        return tempFont;
+    }
+    delete tempFont;
+    return nullptr;
+}
+
 void FontFreeType::setFontEngine(IFontEngine* fe)
 {
     s_FontEngine = fe;
@@ -271,13 +285,13 @@ bool FontFreeType::initWithFontPath(std::string_view fontPath, int faceSize)
         else
         {
             sharableData       = &s_cacheFontData[fontPath];
-            sharableData->data = FileUtils::getInstance()->getDataFromFile(fontPath);
+            sharableData->data = FileUtils::getInstance()->getMappedContents(fontPath);
         }
 
         ++sharableData->referenceCount;
         auto& data = sharableData->data;
         if (data.isNull() ||
-            FT_New_Memory_Face(getFTLibrary(), data.getBytes(), static_cast<FT_Long>(data.getSize()), 0, &face))
+            FT_New_Memory_Face(getFTLibrary(), data.data(), static_cast<FT_Long>(data.size()), 0, &face))
             return false;
     }
 
@@ -469,6 +483,11 @@ unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
     return getGlyphBitmapByIndex(glyphIndex, outWidth, outHeight, outRect, xAdvance);
 }
 
+unsigned int FontFreeType::getGlyphIndex(char32_t charCode) const
+{
+    return FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode));
+}
+
 unsigned char* FontFreeType::getGlyphBitmapByIndex(unsigned int glyphIndex,
                                                    int& outWidth,
                                                    int& outHeight,
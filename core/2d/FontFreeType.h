@@ -101,6 +101,11 @@ public:
 
     static FontFreeType* createWithFaceInfo(FontFaceInfo* info, FontFreeType* mainFont);
 
+    /** Creates a font with its own FT_Face for the same font file and size, a face must only be used by one thread
+     at a time, so glyphs can be rasterized on a worker with the clone while the axmol thread keeps using this font.
+     */
+    FontFreeType* clone() const;
+
     static void shutdownFreeType();
 
     bool isDistanceFieldEnabled() const { return _distanceFieldEnabled; }
@@ -125,6 +130,9 @@ public:
                                   int& xAdvance,
                                   FontFaceInfo** ppFallbackInfo = nullptr);
 
+    /** The glyph index of a character in this face, 0 when the face doesn't have it. */
+    unsigned int getGlyphIndex(char32_t charCode) const;
+
     unsigned char* getGlyphBitmapByIndex(unsigned int glyphIndex,
                                          int& outWidth,
                                          int& outHeight,
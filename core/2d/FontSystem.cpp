@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/FontSystem.h"
+#include "2d/FontAtlas.h"
+#include "platform/Device.h"
+
+namespace ax
+{
+
+FontSystem* FontSystem::create(std::string_view fontName, int fontSize)
+{
+    auto font = new FontSystem();
+    if (font->initWithFont(fontName, fontSize))
+    {
+        font->autorelease();
+        return font;
+    }
+
+    delete font;
+    return nullptr;
+}
+
+bool FontSystem::initWithFont(std::string_view fontName, int fontSize)
+{
+    if (fontSize <= 0)
+        return false;
+
+    // white glyphs on one line, the label colors them
+    _fontDef._fontName   = fontName;
+    _fontDef._fontSize   = fontSize;
+    _fontDef._alignment  = TextHAlignment::LEFT;
+    _fontDef._enableWrap = false;
+
+    int width = 0, height = 0;
+    bool hasPremultipliedAlpha = false;
+    auto data = Device::getTextureDataForText("M", _fontDef, Device::TextAlign::TOP_LEFT, width, height,
+                                              hasPremultipliedAlpha);
+    if (data.isNull() || height <= 0)
+        return false;
+
+    _lineHeight = height;
+    return true;
+}
+
+FontAtlas* FontSystem::newFontAtlas()
+{
+    return new FontAtlas(this);
+}
+
+int* FontSystem::getHorizontalKerningForTextUTF32(const std::u32string& /*text*/, int& /*outNumLetters*/) const
+{
+    return nullptr;
+}
+
+uint8_t* FontSystem::getGlyphBitmap(char32_t charCode, int& outWidth, int& outHeight, int& outXAdvance)
+{
+    outWidth = outHeight = outXAdvance = 0;
+
+    // the label lays out the line breaks itself
+    if (charCode < 0x20)
+        return nullptr;
+
+    std::string utf8;
+    if (!StringUtils::UTF32ToUTF8(std::u32string_view(&charCode, 1), utf8))
+        return nullptr;
+
+    int width = 0, height = 0;
+    bool hasPremultipliedAlpha = false;
+    auto data = Device::getTextureDataForText(utf8, _fontDef, Device::TextAlign::TOP_LEFT, width, height,
+                                              hasPremultipliedAlpha);
+    if (data.isNull() || width <= 0 || height <= 0)
+        return nullptr;
+    outXAdvance = width;
+
+    // the glyph is white, its alpha is the coverage whether it's premultiplied or not
+    const auto pixelCount = static_cast<size_t>(width) * height;
+    const auto rgba       = data.getBytes();
+    auto bitmap           = new uint8_t[pixelCount];
+    uint8_t coverage      = 0;
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        bitmap[i] = rgba[i * 4 + 3];
+        coverage |= bitmap[i];
+    }
+
+    // the blank glyphs, e.g. spaces, only advance
+    if (!coverage)
+    {
+        delete[] bitmap;
+        return nullptr;
+    }
+
+    outWidth  = width;
+    outHeight = height;
+    return bitmap;
+}
+
+}  // namespace ax
@@ -0,0 +1,68 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+/// @cond DO_NOT_SHOW
+
+#include "2d/Font.h"
+#include "base/Types.h"
+
+namespace ax
+{
+
+/**
+ * A system font of a size, its glyphs are rasterized one at a time by the platform text API so the labels using it
+ * share a FontAtlas, see Label::setSystemFontGlyphCacheEnabled.
+ * The platform API doesn't report the glyph metrics, every glyph is a cell of its advance by the line height.
+ */
+class AX_DLL FontSystem : public Font
+{
+public:
+    /** @param fontSize The size in pixels, with the content scale factor applied. */
+    static FontSystem* create(std::string_view fontName, int fontSize);
+
+    virtual FontAtlas* newFontAtlas() override;
+    virtual int* getHorizontalKerningForTextUTF32(const std::u32string& text, int& outNumLetters) const override;
+    virtual int getFontMaxHeight() const override { return _lineHeight; }
+
+    std::string_view getFontName() const { return _fontDef._fontName; }
+
+    /** Rasterizes a glyph, its coverage is the value of the returned bitmap, one byte per pixel.
+     @return The bitmap to delete[], or nullptr with outWidth and outHeight at 0 if the glyph is blank.
+     */
+    uint8_t* getGlyphBitmap(char32_t charCode, int& outWidth, int& outHeight, int& outXAdvance);
+
+protected:
+    FontSystem() = default;
+
+    bool initWithFont(std::string_view fontName, int fontSize);
+
+private:
+    FontDefinition _fontDef;
+    int _lineHeight = 0;
+};
+
+}  // namespace ax
+
+/// @endcond
@@ -40,6 +40,9 @@ THE SOFTWARE.
 
 namespace ax
 {
+// the vertices of a tiled grid also hold the coordinates of their tile, see tiledGridEffect.vert
+static constexpr uint32_t TILED_VERTEX_SIZE = sizeof(Vec3) + sizeof(Vec2) + sizeof(Vec2);
+
 // implementation of GridBase
 
 bool GridBase::initWithSize(const Vec2& gridSize)
@@ -55,19 +58,11 @@ bool GridBase::initWithSize(const Vec2& gridSize, const ax::Rect& rect)
     auto POTWide = utils::nextPOT((unsigned int)s.width);
     auto POTHigh = utils::nextPOT((unsigned int)s.height);
 
-    Texture2D* texture = new Texture2D();
-
-    backend::TextureDescriptor descriptor;
-    descriptor.width         = POTWide;
-    descriptor.height        = POTHigh;
-    descriptor.textureUsage  = backend::TextureUsage::RENDER_TARGET;
-    descriptor.textureFormat = backend::PixelFormat::RGBA8;
-    texture->updateTextureDescriptor(descriptor);
-
+    // the grids of the effects share the screen sized textures
+    auto texture = director->getRenderer()->getRenderTargetPool()->acquireTexture(POTWide, POTHigh,
+                                                                                  backend::PixelFormat::RGBA8);
     initWithSize(gridSize, texture, false, rect);
 
-    texture->release();
-
     return true;
 }
 
@@ -111,15 +106,31 @@ bool GridBase::initWithSize(const Vec2& gridSize, Texture2D* texture, bool flipp
     pipelineDescriptor.programState = _programState;
     _mvpMatrixLocation              = pipelineDescriptor.programState->getUniformLocation("u_MVPMatrix");
     _textureLocation                = pipelineDescriptor.programState->getUniformLocation("u_tex0");
+    setVertexLayout(_programState, sizeof(Vec3) + sizeof(Vec2));
+
+    calculateVertexPoints();
+    updateBlendState();
+    return ret;
+}
+
+void GridBase::updateBlendState()
+{
+    if (!_texture || !_texture->hasPremultipliedAlpha())
+    {
+        _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
+    }
+    else
+    {
+        _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+    }
+}
 
-#define VERTEX_POSITION_SIZE 3
-#define VERTEX_TEXCOORD_SIZE 2
-    uint32_t texcoordOffset   = (VERTEX_POSITION_SIZE) * sizeof(float);
-    uint32_t totalSize        = (VERTEX_POSITION_SIZE + VERTEX_TEXCOORD_SIZE) * sizeof(float);
-    const auto& attributeInfo = _programState->getProgram()->getActiveAttributes();
+void GridBase::setVertexLayout(backend::ProgramState* programState, uint32_t stride)
+{
+    const auto& attributeInfo = programState->getProgram()->getActiveAttributes();
     auto iter                 = attributeInfo.find("a_position");
 
-    auto layout = _programState->getMutableVertexLayout();
+    auto layout = programState->getMutableVertexLayout();
     if (iter != attributeInfo.end())
     {
         layout->setAttrib("a_position", iter->second.location, backend::VertexFormat::FLOAT3, 0, false);
@@ -127,26 +138,54 @@ bool GridBase::initWithSize(const Vec2& gridSize, Texture2D* texture, bool flipp
     iter = attributeInfo.find("a_texCoord");
     if (iter != attributeInfo.end())
     {
-        layout->setAttrib("a_texCoord", iter->second.location, backend::VertexFormat::FLOAT2, texcoordOffset,
-                                   false);
+        layout->setAttrib("a_texCoord", iter->second.location, backend::VertexFormat::FLOAT2, sizeof(Vec3), false);
     }
-    layout->setStride(totalSize);
-
-    calculateVertexPoints();
-    updateBlendState();
-    return ret;
+    layout->setStride(stride);
 }
 
-void GridBase::updateBlendState()
+void GridBase::setShaderEffect(const GridShaderEffect& effect)
 {
-    if (!_texture || !_texture->hasPremultipliedAlpha())
+    if (effect.type != GridShaderEffect::Type::NONE && !_effectProgramState)
     {
-        _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
+        _effectProgramState = newEffectProgramState();
+        if (!_effectProgramState)
+        {
+            AXLOGW("GridBase: the grid has no shader effects, the vertices are drawn as they are");
+            return;
+        }
+        _effectMVPMatrixLocation = _effectProgramState->getUniformLocation("u_MVPMatrix");
+        _effectTextureLocation   = _effectProgramState->getUniformLocation("u_tex0");
+        _effectGridLocation      = _effectProgramState->getUniformLocation("u_grid");
+        _effectGridSizeLocation  = _effectProgramState->getUniformLocation("u_gridSize");
+        _effectParams0Location   = _effectProgramState->getUniformLocation("u_params0");
+        _effectParams1Location   = _effectProgramState->getUniformLocation("u_params1");
     }
-    else
+    _shaderEffect = effect;
+}
+
+void GridBase::updateProgramState()
+{
+    const auto& projectionMat = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    auto& pipelineDescriptor  = _drawCommand.getPipelineDescriptor();
+
+    if (_shaderEffect.type == GridShaderEffect::Type::NONE || !_effectProgramState)
     {
-        _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+        pipelineDescriptor.programState = _programState;
+        _programState->setUniform(_mvpMatrixLocation, projectionMat.m, sizeof(projectionMat.m));
+        _programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+        return;
     }
+
+    Vec4 grid(_gridRect.origin.x, _gridRect.origin.y, _step.x, _step.y);
+    Vec4 gridSize(_gridSize.width, _gridSize.height, static_cast<float>(_shaderEffect.type), 0);
+
+    pipelineDescriptor.programState = _effectProgramState;
+    _effectProgramState->setUniform(_effectMVPMatrixLocation, projectionMat.m, sizeof(projectionMat.m));
+    _effectProgramState->setUniform(_effectGridLocation, &grid, sizeof(grid));
+    _effectProgramState->setUniform(_effectGridSizeLocation, &gridSize, sizeof(gridSize));
+    _effectProgramState->setUniform(_effectParams0Location, &_shaderEffect.params0, sizeof(_shaderEffect.params0));
+    _effectProgramState->setUniform(_effectParams1Location, &_shaderEffect.params1, sizeof(_shaderEffect.params1));
+    _effectProgramState->setTexture(_effectTextureLocation, 0, _texture->getBackendTexture());
 }
 
 GridBase::~GridBase()
@@ -159,6 +198,7 @@ GridBase::~GridBase()
     AX_SAFE_RELEASE(_texture);
 
     AX_SAFE_RELEASE(_programState);
+    AX_SAFE_RELEASE(_effectProgramState);
 }
 
 // properties
@@ -379,13 +419,20 @@ void Grid3D::afterBlit()
 
 void Grid3D::blit()
 {
-    updateVertexBuffer();
+    // a shader effect doesn't change the vertices, they aren't uploaded again
+    if (_vertexBufferDirty)
+        updateVertexBuffer();
     _drawCommand.init(0, _blendFunc);
+    updateProgramState();
     Director::getInstance()->getRenderer()->addCommand(&_drawCommand);
-    ax::Mat4 projectionMat = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
-    auto programState           = _drawCommand.getPipelineDescriptor().programState;
-    programState->setUniform(_mvpMatrixLocation, projectionMat.m, sizeof(projectionMat.m));
-    programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+}
+
+backend::ProgramState* Grid3D::newEffectProgramState()
+{
+    auto* program     = backend::Program::getBuiltinProgram(backend::ProgramType::GRID_EFFECT);
+    auto programState = new backend::ProgramState(program);
+    setVertexLayout(programState, sizeof(Vec3) + sizeof(Vec2));
+    return programState;
 }
 
 void Grid3D::calculateVertexPoints()
@@ -502,6 +549,7 @@ void Grid3D::setVertex(const Vec2& pos, const Vec3& vertex)
     vertArray[index]     = vertex.x;
     vertArray[index + 1] = vertex.y;
     vertArray[index + 2] = vertex.z;
+    _vertexBufferDirty   = true;
 }
 
 void Grid3D::reuse()
@@ -525,9 +573,7 @@ void Grid3D::updateVertexBuffer()
     }
     _drawCommand.updateVertexBuffer(_vertexBuffer,
                                     (unsigned int)(numOfPoints * sizeof(Vec3) + numOfPoints * sizeof(Vec2)));
-
-    _drawCommand.updateIndexBuffer(
-        _indices, static_cast<unsigned int>(_gridSize.width * _gridSize.height * 6 * sizeof(unsigned short)));
+    _vertexBufferDirty = false;
 }
 
 void Grid3D::updateVertexAndTexCoordinate()
@@ -546,8 +592,9 @@ void Grid3D::updateVertexAndTexCoordinate()
     _drawCommand.updateVertexBuffer(_vertexBuffer, numOfPoints * sizeof(Vec3) + numOfPoints * sizeof(Vec2));
 
     unsigned int capacity = (unsigned int)(_gridSize.width * _gridSize.height) * 6;
-    _drawCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, capacity, CustomCommand::BufferUsage::DYNAMIC);
+    _drawCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, capacity, CustomCommand::BufferUsage::STATIC);
     _drawCommand.updateIndexBuffer(_indices, capacity * sizeof(unsigned short));
+    _vertexBufferDirty = false;
 }
 
 // implementation of TiledGrid3D
@@ -558,6 +605,7 @@ TiledGrid3D::~TiledGrid3D()
     AX_SAFE_FREE(_vertices);
     AX_SAFE_FREE(_originalVertices);
     AX_SAFE_FREE(_indices);
+    AX_SAFE_FREE(_vertexBuffer);
 }
 
 TiledGrid3D* TiledGrid3D::create(const Vec2& gridSize)
@@ -630,12 +678,28 @@ TiledGrid3D* TiledGrid3D::create(const Vec2& gridSize, Texture2D* texture, bool
 
 void TiledGrid3D::blit()
 {
-    updateVertexBuffer();
+    // a shader effect doesn't change the tiles, they aren't uploaded again
+    if (_vertexBufferDirty)
+        updateVertexBuffer();
+    updateProgramState();
     Director::getInstance()->getRenderer()->addCommand(&_drawCommand);
-    ax::Mat4 projectionMat = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
-    auto programState           = _drawCommand.getPipelineDescriptor().programState;
-    programState->setUniform(_mvpMatrixLocation, projectionMat.m, sizeof(projectionMat.m));
-    programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+}
+
+backend::ProgramState* TiledGrid3D::newEffectProgramState()
+{
+    auto* program     = backend::Program::getBuiltinProgram(backend::ProgramType::TILED_GRID_EFFECT);
+    auto programState = new backend::ProgramState(program);
+    setVertexLayout(programState, TILED_VERTEX_SIZE);
+
+    const auto& attributeInfo = program->getActiveAttributes();
+    auto iter                 = attributeInfo.find("a_tile");
+    if (iter != attributeInfo.end())
+    {
+        programState->getMutableVertexLayout()->setAttrib("a_tile", iter->second.location,
+                                                          backend::VertexFormat::FLOAT2,
+                                                          sizeof(Vec3) + sizeof(Vec2), false);
+    }
+    return programState;
 }
 
 void TiledGrid3D::calculateVertexPoints()
@@ -655,7 +719,7 @@ void TiledGrid3D::calculateVertexPoints()
     _originalVertices = malloc(numQuads * 4 * sizeof(Vec3));
     _texCoordinates   = malloc(numQuads * 4 * sizeof(Vec2));
     _indices          = (unsigned short*)malloc(numQuads * 6 * sizeof(unsigned short));
-    _vertexBuffer     = malloc(numQuads * 4 * (sizeof(Vec3) + sizeof(Vec2)));
+    _vertexBuffer     = malloc(numQuads * 4 * TILED_VERTEX_SIZE);
 
     float* vertArray         = (float*)_vertices;
     float* texArray          = (float*)_texCoordinates;
@@ -724,6 +788,7 @@ void TiledGrid3D::setTile(const Vec2& pos, const Quad3& coords)
     int idx          = (int)(_gridSize.height * pos.x + pos.y) * 4 * 3;
     float* vertArray = (float*)_vertices;
     memcpy(&vertArray[idx], &coords, sizeof(Quad3));
+    _vertexBufferDirty = true;
 }
 
 Quad3 TiledGrid3D::getOriginalTile(const Vec2& pos) const
@@ -768,13 +833,10 @@ void TiledGrid3D::updateVertexBuffer()
     auto tempVecPointer = (Vec3*)_vertices;
     for (size_t i = 0; i < numOfPoints; ++i)
     {
-        auto offset = i * (sizeof(Vec3) + sizeof(Vec2));
-        memcpy((char*)_vertexBuffer + offset, &tempVecPointer[i], sizeof(Vec3));
+        memcpy((char*)_vertexBuffer + i * TILED_VERTEX_SIZE, &tempVecPointer[i], sizeof(Vec3));
     }
-    _drawCommand.updateVertexBuffer(_vertexBuffer,
-                                    (unsigned int)(numOfPoints * sizeof(Vec3) + numOfPoints * sizeof(Vec2)));
-
-    _drawCommand.updateIndexBuffer(_indices, gradSize * 6 * sizeof(unsigned short));
+    _drawCommand.updateVertexBuffer(_vertexBuffer, numOfPoints * TILED_VERTEX_SIZE);
+    _vertexBufferDirty = false;
 }
 
 void TiledGrid3D::updateVertexAndTexCoordinate()
@@ -783,18 +845,26 @@ void TiledGrid3D::updateVertexAndTexCoordinate()
     auto numOfPoints    = gradSize * 4;
     auto tempVecPointer = (Vec3*)_vertices;
     auto tempTexPointer = (Vec2*)_texCoordinates;
+    int gridHeight      = static_cast<int>(_gridSize.height);
     for (size_t i = 0; i < numOfPoints; ++i)
     {
-        auto offset = i * (sizeof(Vec3) + sizeof(Vec2));
+        // the tiles are stored by column, see setTile
+        int tileIndex = static_cast<int>(i / 4);
+        Vec2 tile(static_cast<float>(tileIndex / gridHeight), static_cast<float>(tileIndex % gridHeight));
+
+        auto offset = i * TILED_VERTEX_SIZE;
         memcpy((char*)_vertexBuffer + offset, &tempVecPointer[i], sizeof(Vec3));
         memcpy((char*)_vertexBuffer + offset + sizeof(Vec3), &tempTexPointer[i], sizeof(Vec2));
+        memcpy((char*)_vertexBuffer + offset + sizeof(Vec3) + sizeof(Vec2), &tile, sizeof(Vec2));
     }
-    _drawCommand.createVertexBuffer((sizeof(Vec3) + sizeof(Vec2)), numOfPoints, CustomCommand::BufferUsage::DYNAMIC);
-    _drawCommand.updateVertexBuffer(_vertexBuffer, numOfPoints * sizeof(Vec3) + numOfPoints * sizeof(Vec2));
+    setVertexLayout(_programState, TILED_VERTEX_SIZE);
+    _drawCommand.createVertexBuffer(TILED_VERTEX_SIZE, numOfPoints, CustomCommand::BufferUsage::DYNAMIC);
+    _drawCommand.updateVertexBuffer(_vertexBuffer, numOfPoints * TILED_VERTEX_SIZE);
 
     _drawCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, gradSize * 6,
-                                   CustomCommand::BufferUsage::DYNAMIC);
+                                   CustomCommand::BufferUsage::STATIC);
     _drawCommand.updateIndexBuffer(_indices, gradSize * 6 * sizeof(unsigned short));
+    _vertexBufferDirty = false;
 }
 
 }
@@ -52,6 +52,31 @@ class RenderTarget;
  * @{
  */
 
+/**
+ * An effect computed in the vertex shader of a grid (gridEffect.vert or tiledGridEffect.vert), see
+ * GridBase::setShaderEffect. The parameters are those of the grid action with the same name.
+ */
+struct GridShaderEffect
+{
+    enum class Type
+    {
+        NONE,
+        WAVES_3D,        ///< params0: x: phase, y: amplitude
+        RIPPLE_3D,       ///< params0: x: phase, y: amplitude, params1: xy: position, z: radius
+        LENS_3D,         ///< params0: x: lens effect, y: 1, or -1 when concave, params1: xy: position, z: radius
+        LIQUID,          ///< params0: x: phase, y: amplitude
+        WAVES,           ///< params0: x: phase, y: amplitude, z: horizontal, w: vertical
+        TWIRL,           ///< params0: x: angle by distance to the center of the grid, params1: xy: position
+        PAGE_TURN_3D,    ///< params0: x: apex of the cone, y: sin(theta), z: cos(theta), w: rotation around y
+        WAVES_TILES_3D,  ///< TiledGrid3D only, params0: x: phase, y: amplitude
+        JUMP_TILES_3D,   ///< TiledGrid3D only, params0: x: jump of the even tiles, y: jump of the odd tiles
+    };
+
+    Type type = Type::NONE;
+    Vec4 params0;
+    Vec4 params1;
+};
+
 /** Base class for Other grid.
  */
 class AX_DLL GridBase : public Object
@@ -140,9 +165,25 @@ public:
      */
     const Rect& getGridRect() const { return _gridRect; }
 
+    /**
+     * Sets the effect computed in the vertex shader of the grid, the vertices are then moved on the GPU and only
+     * uploaded again when they change. Type::NONE draws the vertices as they are.
+     * @param effect An effect supported by the grid, Grid3D has the ones of the Grid3DActions, TiledGrid3D the
+     * ones of the TiledGrid3DActions.
+     */
+    void setShaderEffect(const GridShaderEffect& effect);
+    const GridShaderEffect& getShaderEffect() const { return _shaderEffect; }
+
 protected:
     void updateBlendState();
 
+    /** The program state of the shader effects, nullptr if the grid has none. */
+    virtual backend::ProgramState* newEffectProgramState() { return nullptr; }
+    /** Sets the attributes of the grid vertices, each starts with its position and texture coordinates. */
+    static void setVertexLayout(backend::ProgramState* programState, uint32_t stride);
+    /** Draws with the program state of the shader effect, if any, and sets its uniforms. */
+    void updateProgramState();
+
     bool _active   = false;
     int _reuseGrid = 0;
     Vec2 _gridSize;
@@ -169,6 +210,17 @@ protected:
     backend::ProgramState* _programState = nullptr;
 
     BlendFunc _blendFunc;
+
+    GridShaderEffect _shaderEffect;
+    backend::ProgramState* _effectProgramState = nullptr;
+    backend::UniformLocation _effectMVPMatrixLocation;
+    backend::UniformLocation _effectTextureLocation;
+    backend::UniformLocation _effectGridLocation;
+    backend::UniformLocation _effectGridSizeLocation;
+    backend::UniformLocation _effectParams0Location;
+    backend::UniformLocation _effectParams1Location;
+    // the vertices changed since they were uploaded
+    bool _vertexBufferDirty = false;
 };
 
 /**
@@ -231,6 +283,7 @@ public:
     bool getNeedDepthTestForBlit() const { return _needDepthTestForBlit; }
     /**@}*/
 protected:
+    virtual backend::ProgramState* newEffectProgramState() override;
     void updateVertexBuffer();
     void updateVertexAndTexCoordinate();
 
@@ -297,6 +350,7 @@ protected:
      */
     ~TiledGrid3D();
 
+    virtual backend::ProgramState* newEffectProgramState() override;
     void updateVertexBuffer();
     void updateVertexAndTexCoordinate();
 
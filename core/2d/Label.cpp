@@ -27,6 +27,7 @@
 
 #include "2d/Label.h"
 #include <algorithm>
+#include <limits>
 #include <stddef.h>  // offsetof
 #include "base/Types.h"
 #include "2d/Font.h"
@@ -56,6 +57,9 @@ namespace ax
 
 namespace
 {
+bool s_defaultTextBatchingEnabled         = false;
+bool s_defaultSystemFontGlyphCacheEnabled = false;
+
 void updateBlend(backend::BlendDescriptor& blendDescriptor, BlendFunc blendFunc)
 {
     blendDescriptor.blendEnabled = true;
@@ -211,6 +215,7 @@ Label::BatchCommand::~BatchCommand()
     AX_SAFE_RELEASE(textCommand.getPipelineDescriptor().programState);
     AX_SAFE_RELEASE(shadowCommand.getPipelineDescriptor().programState);
     AX_SAFE_RELEASE(outLineCommand.getPipelineDescriptor().programState);
+    AX_SAFE_RELEASE(quadCommand.getPipelineDescriptor().programState);
 }
 
 void Label::BatchCommand::setProgramState(backend::ProgramState* programState)
@@ -228,6 +233,10 @@ void Label::BatchCommand::setProgramState(backend::ProgramState* programState)
     auto& programStateOutline = outLineCommand.getPipelineDescriptor().programState;
     AX_SAFE_RELEASE(programStateOutline);
     programStateOutline = programState->clone();
+
+    auto& programStateQuad = quadCommand.getPipelineDescriptor().programState;
+    AX_SAFE_RELEASE(programStateQuad);
+    programStateQuad = programState->clone();
 }
 
 std::array<CustomCommand*, 3> Label::BatchCommand::getCommandArray()
@@ -509,8 +518,10 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
 {
     setAnchorPoint(Vec2::ANCHOR_MIDDLE);
     reset();
-    _hAlignment = hAlignment;
-    _vAlignment = vAlignment;
+    _hAlignment          = hAlignment;
+    _vAlignment          = vAlignment;
+    _textBatchingEnabled         = s_defaultTextBatchingEnabled;
+    _systemFontGlyphCacheEnabled = s_defaultSystemFontGlyphCacheEnabled;
 
 #if AX_LABEL_DEBUG_DRAW
     _debugDrawNode = DrawNode::create();
@@ -532,6 +543,13 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
                 FontAtlasCache::releaseFontAtlas(_fontAtlas);
             }
         }
+        else if (isSystemFontCached() && event->getUserData() == _fontAtlas)
+        {
+            // the atlas is reset, the next layout rasterizes the glyphs again
+            _batchNodes.clear();
+            _batchCommands.clear();
+            _contentDirty = true;
+        }
     });
     _eventDispatcher->addEventListenerWithFixedPriority(_purgeTextureListener, 1);
 
@@ -619,6 +637,11 @@ void Label::reset()
         delete[] _horizontalKernings;
         _horizontalKernings = nullptr;
     }
+    _kerningsText.clear();
+    _kerningsFont = nullptr;
+    _letterQuads.clear();
+    _keptQuads.clear();
+    _quadsDirtyBegins.clear();
     _additionalKerning      = 0.f;
     _lineHeight             = 0.f;
     _lineSpacing            = 0.f;
@@ -720,6 +743,23 @@ void Label::updateShaderProgram()
                 backend::ProgramStateRegistry::getInstance()->getProgramType(programType, texture->getSamplerFlags());
         }
     }
+    else if (_useDistanceField && _fontAtlas && _fontAtlas->isMultiChannelDistanceField())
+    {
+        switch (_currLabelEffect)
+        {
+        case ax::LabelEffect::NORMAL:
+            programType = backend::ProgramType::LABEL_MSDF_NORMAL;
+            break;
+        case ax::LabelEffect::OUTLINE:
+            programType = backend::ProgramType::LABEL_MSDF_OUTLINE;
+            break;
+        case ax::LabelEffect::GLOW:
+            programType = backend::ProgramType::LABEL_MSDF_GLOW;
+            break;
+        default:
+            return;
+        }
+    }
     else
     {
         switch (_currLabelEffect)
@@ -795,6 +835,8 @@ void Label::setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled /* = false
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
     }
     _fontAtlas = atlas;
+    _kerningsFont = nullptr;
+    _letterQuads.clear();
 
     if (_reusedLetter == nullptr)
     {
@@ -946,7 +988,7 @@ void Label::setString(std::string_view text)
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
         {
-            _utf32Text = utf32String;
+            _utf32Text = std::move(utf32String);
         }
     }
 }
@@ -1094,6 +1136,7 @@ bool Label::alignText()
     do
     {
         _fontAtlas->prepareLetterDefinitions(_utf32Text);
+        _fontAtlasGeneration = _fontAtlas->getGeneration();
         auto& textures = _fontAtlas->getTextures();
         auto size      = textures.size();
         if (size > static_cast<size_t>(_batchNodes.size()))
@@ -1158,7 +1201,8 @@ bool Label::alignText()
 
         updateLabelLetters();
 
-        updateColor();
+        // the kept quads have their color already
+        updateQuadsColor(true);
     } while (0);
 
     return ret;
@@ -1166,19 +1210,53 @@ bool Label::alignText()
 
 bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
 {
-    if (_horizontalKernings)
+    auto font = _fontAtlas->getFont();
+
+    // The kerning of a letter depends on its neighbours only, so the kernings of the prefix the text shares
+    // with the previous one are kept, all but the last letter of the prefix, whose next letter may differ.
+    size_t keptCount = 0;
+    if (_horizontalKernings && _kerningsFont == font)
     {
-        delete[] _horizontalKernings;
-        _horizontalKernings = nullptr;
+        auto count = std::min(stringToRender.size(), _kerningsText.size());
+        while (keptCount < count && stringToRender[keptCount] == _kerningsText[keptCount])
+            ++keptCount;
+        keptCount = keptCount > 0 ? keptCount - 1 : 0;
     }
 
-    int letterCount     = 0;
-    _horizontalKernings = _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(stringToRender, letterCount);
+    int* kernings = nullptr;
+    if (keptCount > 0)
+    {
+        // the kernings of the letter before the changed ones are needed as well, to compute the first of them
+        auto start      = keptCount - 1;
+        int letterCount = 0;
+        auto tail       = font->getHorizontalKerningForTextUTF32(stringToRender.substr(start), letterCount);
+        if (tail)
+        {
+            kernings = new int[stringToRender.size()];
+            memcpy(kernings, _horizontalKernings, keptCount * sizeof(int));
+            memcpy(kernings + keptCount, tail + 1, (stringToRender.size() - keptCount) * sizeof(int));
+            delete[] tail;
+        }
+    }
+    else
+    {
+        int letterCount = 0;
+        kernings        = font->getHorizontalKerningForTextUTF32(stringToRender, letterCount);
+    }
+
+    delete[] _horizontalKernings;
+    _horizontalKernings = kernings;
 
     if (!_horizontalKernings)
+    {
+        _kerningsText.clear();
+        _kerningsFont = nullptr;
         return false;
-    else
-        return true;
+    }
+
+    _kerningsText = stringToRender;
+    _kerningsFont = font;
+    return true;
 }
 
 bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
@@ -1195,16 +1273,160 @@ bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
     }
 }
 
+bool Label::LetterQuad::hasSameLayout(const LetterQuad& rhs) const
+{
+    return utf32Char == rhs.utf32Char && valid == rhs.valid && positionX == rhs.positionX &&
+           positionY == rhs.positionY && lineWidth == rhs.lineWidth && textureID == rhs.textureID;
+}
+
+bool Label::QuadsLayout::operator==(const QuadsLayout& rhs) const
+{
+    return fontAtlas == rhs.fontAtlas && fontAtlasGeneration == rhs.fontAtlasGeneration &&
+           fontScale == rhs.fontScale && letterOffsetY == rhs.letterOffsetY && tailoredTopY == rhs.tailoredTopY &&
+           tailoredBottomY == rhs.tailoredBottomY && contentSize == rhs.contentSize &&
+           labelWidth == rhs.labelWidth && labelHeight == rhs.labelHeight && overflow == rhs.overflow &&
+           enableWrap == rhs.enableWrap && labelType == rhs.labelType;
+}
+
+Label::LetterQuad Label::makeLetterQuad(int letterIndex) const
+{
+    auto& letterInfo = _lettersInfo[letterIndex];
+    auto lineIndex   = letterInfo.lineIndex;
+
+    LetterQuad letterQuad;
+    letterQuad.utf32Char  = letterInfo.utf32Char;
+    letterQuad.valid      = letterInfo.valid;
+    letterQuad.positionX  = letterInfo.positionX + _linesOffsetX[lineIndex];
+    letterQuad.positionY  = letterInfo.positionY;
+    letterQuad.lineWidth  = _linesWidth[lineIndex];
+    letterQuad.textureID  = -1;
+    letterQuad.atlasIndex = -1;
+    if (letterInfo.valid)
+    {
+        auto it = _fontAtlas->_letterDefinitions.find(letterInfo.utf32Char);
+        if (it != _fontAtlas->_letterDefinitions.end())
+            letterQuad.textureID = it->second.textureID;
+    }
+    return letterQuad;
+}
+
+Label::QuadsLayout Label::makeQuadsLayout() const
+{
+    QuadsLayout layout;
+    layout.fontAtlas           = _fontAtlas;
+    layout.fontAtlasGeneration = _fontAtlasGeneration;
+    layout.fontScale           = _fontScale;
+    layout.letterOffsetY       = _letterOffsetY;
+    layout.tailoredTopY        = _tailoredTopY;
+    layout.tailoredBottomY     = _tailoredBottomY;
+    layout.contentSize         = _contentSize;
+    layout.labelWidth          = _labelWidth;
+    layout.labelHeight         = _labelHeight;
+    layout.overflow            = _overflow;
+    layout.enableWrap          = _enableWrap;
+    layout.labelType           = _currentLabelType;
+    return layout;
+}
+
+void Label::markQuadsDirty(TextureAtlas* textureAtlas, int begin)
+{
+    for (auto&& dirtyBegin : _quadsDirtyBegins)
+    {
+        if (dirtyBegin.first == textureAtlas)
+        {
+            dirtyBegin.second = std::min(dirtyBegin.second, begin);
+            return;
+        }
+    }
+    _quadsDirtyBegins.emplace_back(textureAtlas, begin);
+}
+
+int Label::takeQuadsDirtyBegin(TextureAtlas* textureAtlas)
+{
+    int begin = std::numeric_limits<int>::max();
+
+    // the letter sprites update their quads in the atlas directly
+    if (textureAtlas->isDirty())
+    {
+        begin = 0;
+        textureAtlas->setDirty(false);
+    }
+
+    for (auto it = _quadsDirtyBegins.begin(); it != _quadsDirtyBegins.end(); ++it)
+    {
+        if (it->first == textureAtlas)
+        {
+            begin = std::min(begin, it->second);
+            _quadsDirtyBegins.erase(it);
+            break;
+        }
+    }
+    return begin;
+}
+
 bool Label::updateQuads()
 {
     bool ret = true;
-    for (auto&& batchNode : _batchNodes)
+
+    // The quads of the leading letters laid out exactly as before are kept, when e.g. only the last digits of a
+    // counter change, only the quads of the letters from the first change on are recreated and uploaded.
+    auto layout       = makeQuadsLayout();
+    size_t batchCount = _batchNodes.size();
+    int keptLetters   = 0;
+    // the letter sprites handed out by getLetter write their own quads, their labels are rebuilt as before
+    bool canKeepQuads = _overflow != Overflow::SHRINK && _letters.empty() && _keptQuads.size() == batchCount &&
+                        layout == _quadsLayout;
+    if (canKeepQuads)
     {
-        batchNode->getTextureAtlas()->removeAllQuads();
+        auto count = std::min(static_cast<int>(_letterQuads.size()), _lengthOfString);
+        while (keptLetters < count && makeLetterQuad(keptLetters).hasSameLayout(_letterQuads[keptLetters]))
+            ++keptLetters;
     }
 
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    std::fill(_keptQuads.begin(), _keptQuads.end(), 0);
+    _keptQuads.resize(batchCount, 0);
+    for (int ctr = 0; ctr < keptLetters; ++ctr)
+    {
+        auto& letterQuad = _letterQuads[ctr];
+        if (letterQuad.atlasIndex >= 0)
+            ++_keptQuads[letterQuad.textureID];
+    }
+
+    for (size_t index = 0; index < batchCount; ++index)
+    {
+        auto textureAtlas = _batchNodes.at(index)->getTextureAtlas();
+        if (_keptQuads[index] > textureAtlas->getTotalQuads())
+        {
+            // the atlas was changed behind our back, start over
+            keptLetters = 0;
+            std::fill(_keptQuads.begin(), _keptQuads.end(), 0);
+            break;
+        }
+    }
+
+    for (size_t index = 0; index < batchCount; ++index)
     {
+        auto textureAtlas = _batchNodes.at(index)->getTextureAtlas();
+        if (textureAtlas->isDirty())
+        {
+            markQuadsDirty(textureAtlas, 0);
+            textureAtlas->setDirty(false);
+        }
+        auto totalQuads = static_cast<int>(textureAtlas->getTotalQuads());
+        if (totalQuads > _keptQuads[index])
+            textureAtlas->removeQuadsAtIndex(_keptQuads[index], totalQuads - _keptQuads[index]);
+    }
+
+    _letterQuads.resize(keptLetters);
+    for (int ctr = 0; ctr < keptLetters; ++ctr)
+    {
+        _lettersInfo[ctr].atlasIndex = _letterQuads[ctr].atlasIndex;
+    }
+
+    for (int ctr = keptLetters; ctr < _lengthOfString; ++ctr)
+    {
+        _letterQuads.push_back(makeLetterQuad(ctr));
+
         if (_lettersInfo[ctr].valid)
         {
             auto& letterDef = _fontAtlas->_letterDefinitions[_lettersInfo[ctr].utf32Char];
@@ -1262,7 +1484,8 @@ bool Label::updateQuads()
                 float letterPositionX = _lettersInfo[ctr].positionX + _linesOffsetX[_lettersInfo[ctr].lineIndex];
                 _reusedLetter->setPosition(letterPositionX, py);
                 auto index = static_cast<int>(_batchNodes.at(letterDef.textureID)->getTextureAtlas()->getTotalQuads());
-                _lettersInfo[ctr].atlasIndex = index;
+                _lettersInfo[ctr].atlasIndex   = index;
+                _letterQuads.back().atlasIndex = index;
 
                 this->updateLetterSpriteScale(_reusedLetter);
 
@@ -1271,6 +1494,26 @@ bool Label::updateQuads()
         }
     }
 
+    for (size_t index = 0; index < batchCount; ++index)
+    {
+        auto textureAtlas = _batchNodes.at(index)->getTextureAtlas();
+        if (textureAtlas->isDirty())
+        {
+            markQuadsDirty(textureAtlas, _keptQuads[index]);
+            textureAtlas->setDirty(false);
+        }
+    }
+
+    if (ret)
+    {
+        _quadsLayout = layout;
+    }
+    else
+    {
+        _letterQuads.clear();
+        _keptQuads.clear();
+    }
+
     return ret;
 }
 
@@ -1702,7 +1945,10 @@ void Label::setCameraMask(unsigned short mask, bool applyChildren)
 
 void Label::updateContent()
 {
-    if (_systemFontDirty)
+    // the system font glyphs are laid out from a shared atlas when the label has no outline
+    bool systemFontCached = _currentLabelType == LabelType::STRING_TEXTURE && _systemFontGlyphCacheEnabled &&
+                            _currLabelEffect == LabelEffect::NORMAL;
+    if (_systemFontDirty || (isSystemFontCached() && !systemFontCached))
     {
         if (_fontAtlas)
         {
@@ -1716,18 +1962,27 @@ void Label::updateContent()
         _systemFontDirty = false;
     }
 
+    if (systemFontCached && !_fontAtlas)
+    {
+        auto atlas = FontAtlasCache::getFontAtlasSystemFont(_systemFont, _systemFontSize);
+        if (atlas)
+            setFontAtlas(atlas, false, true);
+    }
+
+    // keep showing the previous text until the glyphs rasterized on the workers are in the atlas
+    if (_fontAtlas && _currentLabelType == LabelType::TTF && FontAtlas::isAsyncRasterizationEnabled())
+    {
+        if (!_fontAtlas->requestLetterDefinitions(_utf32Text))
+            return;
+    }
+
     AX_SAFE_RELEASE_NULL(_textSprite);
     AX_SAFE_RELEASE_NULL(_shadowNode);
     bool updateFinished = true;
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
-        {
-            _utf32Text = utf32String;
-        }
-
+        // setString converted the text already
         computeHorizontalKernings(_utf32Text);
         updateFinished = alignText();
     }
@@ -1749,7 +2004,7 @@ void Label::updateContent()
 
         _lineDrawNode->clear();
 
-        if (_numberOfLines && _currentLabelType != LabelType::STRING_TEXTURE)
+        if (_numberOfLines && (_currentLabelType != LabelType::STRING_TEXTURE || _fontAtlas))
         {
             // This is the logic for TTF fonts
             const float charheight = (_textDesiredHeight / _numberOfLines);
@@ -1842,22 +2097,90 @@ float Label::getBMFontSize() const
     return _bmFontSize;
 }
 
-void Label::updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customCommand)
+void Label::updateBuffer(TextureAtlas* textureAtlas,
+                         CustomCommand& customCommand,
+                         BatchCommand::BufferState& bufferState)
 {
-    if (textureAtlas->getTotalQuads() > customCommand.getVertexCapacity())
+    auto totalQuads = static_cast<int>(textureAtlas->getTotalQuads());
+    if (totalQuads > customCommand.getVertexCapacity())
     {
-        customCommand.createVertexBuffer((unsigned int)sizeof(V3F_C4B_T2F_Quad),
-                                         (unsigned int)textureAtlas->getTotalQuads(),
+        customCommand.createVertexBuffer((unsigned int)sizeof(V3F_C4B_T2F_Quad), (unsigned int)totalQuads,
                                          CustomCommand::BufferUsage::DYNAMIC);
-        customCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT,
-                                        (unsigned int)textureAtlas->getTotalQuads() * 6,
+        customCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, (unsigned int)totalQuads * 6,
                                         CustomCommand::BufferUsage::DYNAMIC);
+        bufferState.allocatedQuads = 0;
     }
-    customCommand.updateVertexBuffer(textureAtlas->getQuads(),
-                                     (unsigned int)(textureAtlas->getTotalQuads() * sizeof(V3F_C4B_T2F_Quad)));
-    customCommand.updateIndexBuffer(textureAtlas->getIndices(),
-                                    (unsigned int)(textureAtlas->getTotalQuads() * 6 * sizeof(unsigned short)));
-    customCommand.setIndexDrawInfo(0, (unsigned int)(textureAtlas->getTotalQuads() * 6));
+
+    int begin = bufferState.dirtyBegin;
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    // the contents of the dynamic buffers are lost with the context, they aren't cached
+    begin = 0;
+#endif
+    if (begin < totalQuads)
+    {
+#ifdef AX_USE_METAL
+        // each frame writes the next of the in flight buffers, which holds the quads of an older frame
+        begin = 0;
+#endif
+        if (begin > 0 && totalQuads <= bufferState.allocatedQuads)
+        {
+            customCommand.updateVertexBuffer(textureAtlas->getQuads() + begin, begin * sizeof(V3F_C4B_T2F_Quad),
+                                             (totalQuads - begin) * sizeof(V3F_C4B_T2F_Quad));
+            customCommand.updateIndexBuffer(textureAtlas->getIndices() + begin * 6,
+                                            begin * 6 * sizeof(unsigned short),
+                                            (totalQuads - begin) * 6 * sizeof(unsigned short));
+        }
+        else
+        {
+            customCommand.updateVertexBuffer(textureAtlas->getQuads(),
+                                             (unsigned int)(totalQuads * sizeof(V3F_C4B_T2F_Quad)));
+            customCommand.updateIndexBuffer(textureAtlas->getIndices(),
+                                            (unsigned int)(totalQuads * 6 * sizeof(unsigned short)));
+            bufferState.allocatedQuads = totalQuads;
+        }
+    }
+    bufferState.dirtyBegin = std::numeric_limits<int>::max();
+    customCommand.setIndexDrawInfo(0, (unsigned int)(totalQuads * 6));
+}
+
+bool Label::isTextBatchable() const
+{
+    // the labels drawing more than one command per page would interleave them, they can't be merged
+    return _textBatchingEnabled && (_currentLabelType == LabelType::TTF || isSystemFontCached()) && !_shadowEnabled &&
+           _letters.empty() &&
+           (_currLabelEffect != LabelEffect::OUTLINE || _useDistanceField);
+}
+
+void Label::drawTextBatched(BatchCommand& batch,
+                            TextureAtlas* textureAtlas,
+                            Renderer* renderer,
+                            const Mat4& transform,
+                            uint32_t flags)
+{
+    // the quads are transformed when the renderer copies them to its vertex stream
+    auto& matrixProjection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    auto* programState     = batch.quadCommand.getPipelineDescriptor().programState;
+    programState->setUniform(_mvpMatrixLocation, matrixProjection.m, sizeof(matrixProjection.m));
+
+    Vec4 textColor = Vec4::ONE;
+    if (!_textColorInVertices)
+        textColor.set(_textColorF.r, _textColorF.g, _textColorF.b, _textColorF.a);
+    programState->setUniform(_textColorLocation, &textColor, sizeof(textColor));
+
+    if (_currLabelEffect != LabelEffect::NORMAL)
+    {
+        Vec4 effectColor(_effectColorF.r, _effectColorF.g, _effectColorF.b, _effectColorF.a);
+        if (_currLabelEffect == LabelEffect::OUTLINE)
+            effectColor.w = _outlineSize > 0 ? _outlineSize : _fontConfig.outlineSize;
+        programState->setUniform(_effectColorLocation, &effectColor, sizeof(effectColor));
+    }
+    programState->setTexture(textureAtlas->getTexture()->getBackendTexture());
+
+    // the uniforms are part of the batch id, the labels drawn with the same ones are merged into one draw
+    programState->updateBatchId();
+    batch.quadCommand.init(_globalZOrder, textureAtlas->getTexture(), _blendFunc, textureAtlas->getQuads(),
+                           textureAtlas->getTotalQuads(), transform, flags);
+    renderer->addCommand(&batch.quadCommand);
 }
 
 void Label::updateEffectUniforms(BatchCommand& batch,
@@ -1865,19 +2188,19 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                                  Renderer* renderer,
                                  const Mat4& transform)
 {
-    updateBuffer(textureAtlas, batch.textCommand);
+    updateBuffer(textureAtlas, batch.textCommand, batch.textBuffer);
 
     auto& matrixProjection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
 
     if (_shadowEnabled)
     {
-        updateBuffer(textureAtlas, batch.shadowCommand);
+        updateBuffer(textureAtlas, batch.shadowCommand, batch.shadowBuffer);
         auto shadowMatrix = matrixProjection * _shadowTransform;
         batch.shadowCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, shadowMatrix.m,
                                                                              sizeof(shadowMatrix.m));
     }
 
-    if (_currentLabelType == LabelType::TTF)
+    if (_currentLabelType == LabelType::TTF || isSystemFontCached())
     {
         switch (_currLabelEffect)
         {
@@ -1908,7 +2231,7 @@ void Label::updateEffectUniforms(BatchCommand& batch,
                 // draw outline
                 {
                     effectType = 1;
-                    updateBuffer(textureAtlas, batch.outLineCommand);
+                    updateBuffer(textureAtlas, batch.outLineCommand, batch.outLineBuffer);
                     auto* programStateOutline = batch.outLineCommand.getPipelineDescriptor().programState;
                     programStateOutline->setUniform(_effectColorLocation, &effectColor, sizeof(Vec4));
                     programStateOutline->setUniform(_effectTypeLocation, &effectType, sizeof(effectType));
@@ -1967,15 +2290,20 @@ void Label::updateEffectUniforms(BatchCommand& batch,
         {
             Color3B oldColor   = _realColor;
             uint8_t oldOPacity = _displayedOpacity;
+            auto dirtyBegins   = _quadsDirtyBegins;
             _displayedOpacity  = _shadowColor4F.a * (oldOPacity / 255.0f) * 255;
             setColor(Color3B(_shadowColor4F));
             batch.shadowCommand.updateVertexBuffer(
                 textureAtlas->getQuads(), (unsigned int)(textureAtlas->getTotalQuads() * sizeof(V3F_C4B_T2F_Quad)));
+            batch.shadowBuffer.allocatedQuads = static_cast<int>(textureAtlas->getTotalQuads());
             batch.shadowCommand.init(_globalZOrder);
             renderer->addCommand(&batch.shadowCommand);
 
             _displayedOpacity = oldOPacity;
             setColor(oldColor);
+
+            // the quads have their colors back, the buffers are as up to date as before
+            _quadsDirtyBegins = std::move(dirtyBegins);
         }
     }
 
@@ -2047,6 +2375,14 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 
             updateBlendState();
 
+            bool textBatched     = isTextBatchable();
+            bool colorInVertices = textBatched && _currLabelEffect == LabelEffect::NORMAL && _textColorLocation;
+            if (colorInVertices != _textColorInVertices)
+            {
+                _textColorInVertices = colorInVertices;
+                updateColor();
+            }
+
             for (auto&& batchNode : _batchNodes)
             {
                 auto textureAtlas = batchNode->getTextureAtlas();
@@ -2054,6 +2390,25 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
                     continue;
 
                 auto& batch = _batchCommands[i++];
+                if (textBatched)
+                {
+                    drawTextBatched(batch, textureAtlas, renderer, transform, flags);
+                    continue;
+                }
+
+                // the buffers of each command are updated from the first quad any of them misses
+                auto dirtyBegin = takeQuadsDirtyBegin(textureAtlas);
+                for (auto* bufferState : {&batch.textBuffer, &batch.shadowBuffer, &batch.outLineBuffer})
+                {
+                    if (bufferState->textureAtlas != textureAtlas)
+                    {
+                        bufferState->textureAtlas = textureAtlas;
+                        bufferState->dirtyBegin   = 0;
+                    }
+                    else
+                        bufferState->dirtyBegin = std::min(bufferState->dirtyBegin, dirtyBegin);
+                }
+
                 for (auto&& command : batch.getCommandArray())
                 {
                     auto* programState = command->getPipelineDescriptor().programState;
@@ -2092,6 +2447,10 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
+    // letters of this label were evicted from the atlas to make room for others
+    if (_fontAtlas && _fontAtlasGeneration != _fontAtlas->getGeneration())
+        _contentDirty = true;
+
     if (_systemFontDirty || _contentDirty)
     {
         // Label overflow shrink fix #566
@@ -2101,6 +2460,16 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         updateContent();
     }
 
+    // keep the atlas pages this label draws from
+    if (_fontAtlas)
+    {
+        for (ssize_t i = 0, count = _batchNodes.size(); i < count; ++i)
+        {
+            if (_batchNodes.at(i)->getTextureAtlas()->getTotalQuads() > 0)
+                _fontAtlas->touchPage(static_cast<int>(i));
+        }
+    }
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     if (!_utf8Text.empty() && _shadowEnabled && (_shadowDirty || (flags & FLAGS_DIRTY_MASK)))
@@ -2316,6 +2685,43 @@ void Label::setAdditionalKerning(float space)
         AXLOGW("Label::setAdditionalKerning not supported on LabelType::STRING_TEXTURE");
 }
 
+void Label::setTextBatchingEnabled(bool enabled)
+{
+    // the vertex colors follow at the next draw
+    _textBatchingEnabled = enabled;
+}
+
+void Label::setSystemFontGlyphCacheEnabled(bool enabled)
+{
+    if (_systemFontGlyphCacheEnabled != enabled)
+    {
+        // the next update switches between the atlas and the texture
+        _systemFontGlyphCacheEnabled = enabled;
+        if (_currentLabelType == LabelType::STRING_TEXTURE)
+            _contentDirty = true;
+    }
+}
+
+void Label::setDefaultSystemFontGlyphCacheEnabled(bool enabled)
+{
+    s_defaultSystemFontGlyphCacheEnabled = enabled;
+}
+
+bool Label::isDefaultSystemFontGlyphCacheEnabled()
+{
+    return s_defaultSystemFontGlyphCacheEnabled;
+}
+
+void Label::setDefaultTextBatchingEnabled(bool enabled)
+{
+    s_defaultTextBatchingEnabled = enabled;
+}
+
+bool Label::isDefaultTextBatchingEnabled()
+{
+    return s_defaultTextBatchingEnabled;
+}
+
 float Label::getAdditionalKerning() const
 {
     AXASSERT(_currentLabelType != LabelType::STRING_TEXTURE, "Not supported system font!");
@@ -2353,7 +2759,7 @@ int Label::getStringNumLines()
         updateContent();
     }
 
-    if (_currentLabelType == LabelType::STRING_TEXTURE)
+    if (_currentLabelType == LabelType::STRING_TEXTURE && !_fontAtlas)
     {
         computeStringNumLines();
     }
@@ -2448,12 +2854,20 @@ void Label::setTextColor(const Color4B& color)
     _textColorF.b = _textColor.b / 255.0f;
     _textColorF.a = _textColor.a / 255.0f;
 
+    if (_textColorInVertices)
+        updateColor();
+
     //  System font and TTF using setColor for Outline/Glow!");
     if (_currentLabelType != LabelType::TTF && _currentLabelType != LabelType::STRING_TEXTURE) 
         setColor(Color3B(color)); 
 }
 
 void Label::updateColor()
+{
+    updateQuadsColor(false);
+}
+
+void Label::updateQuadsColor(bool newQuadsOnly)
 {
     if (_batchNodes.empty())
     {
@@ -2470,22 +2884,35 @@ void Label::updateColor()
         color4.b *= _displayedOpacity / 255.0f;
     }
 
+    // the shaders multiply the vertex colors with the text color, which is done here when batching
+    if (_textColorInVertices)
+    {
+        color4.r = color4.r * _textColor.r / 255;
+        color4.g = color4.g * _textColor.g / 255;
+        color4.b = color4.b * _textColor.b / 255;
+        color4.a = color4.a * _textColor.a / 255;
+    }
+
     ax::TextureAtlas* textureAtlas;
     V3F_C4B_T2F_Quad* quads;
-    for (auto&& batchNode : _batchNodes)
+    for (size_t batchIndex = 0; batchIndex < _batchNodes.size(); ++batchIndex)
     {
-        textureAtlas = batchNode->getTextureAtlas();
+        textureAtlas = _batchNodes.at(batchIndex)->getTextureAtlas();
         quads        = textureAtlas->getQuads();
         auto count   = textureAtlas->getTotalQuads();
+        int begin    = 0;
+        if (newQuadsOnly && batchIndex < _keptQuads.size())
+            begin = _keptQuads[batchIndex];
 
-        for (int index = 0; index < count; ++index)
+        for (int index = begin; index < count; ++index)
         {
             quads[index].bl.colors = color4;
             quads[index].br.colors = color4;
             quads[index].tl.colors = color4;
             quads[index].tr.colors = color4;
-            textureAtlas->updateQuad(quads[index], index);
         }
+        if (begin < count)
+            markQuadsDirty(textureAtlas, begin);
     }
 }
 
@@ -2818,6 +3245,10 @@ void Label::updateFontScale()
         auto originalFontSize = bmFont->getOriginalFontSize();
         _fontScale            = _bmFontSize * scaleFactor / originalFontSize;
     }
+    else if (_currentLabelType == LabelType::TTF && _fontAtlas->isMultiChannelDistanceField())
+    {
+        _fontScale = _fontConfig.fontSize * scaleFactor / _fontAtlas->getPrebuiltFaceSize();
+    }
     else if (_currentLabelType == LabelType::TTF && _fontConfig.distanceFieldEnabled)
     {
         //! Due to underlaying font engine(freetype2) only support int type faceSize, so not only SDF require fontScale,
@@ -684,6 +684,37 @@ public:
      */
     float getAdditionalKerning() const;
 
+    /**
+     * Sets whether the label is drawn with batchable quad commands.
+     *
+     * The glyph quads of a page are then merged by the renderer with the quads of the other labels drawn with the
+     * same page, program and uniforms, so the labels sharing a FontAtlas draw with one call per page instead of one
+     * per label. The text color of labels without effect moves to the vertex colors, so labels of different text
+     * colors batch too. Labels with a shadow, a bitmap outline or letters handed out by getLetter are drawn as before.
+     *
+     * @warning Not support system font.
+     */
+    void setTextBatchingEnabled(bool enabled);
+    bool isTextBatchingEnabled() const { return _textBatchingEnabled; }
+
+    /** Sets whether the labels created from now on batch their text, disabled by default. */
+    static void setDefaultTextBatchingEnabled(bool enabled);
+    static bool isDefaultTextBatchingEnabled();
+
+    /**
+     * Sets whether the system font label lays out its text from the glyph atlas of its font and size.
+     *
+     * The glyphs are rasterized one at a time by the platform text API into a FontAtlas shared by the system font
+     * labels, so changing the text doesn't create a texture and the labels batch like the TTF ones. The glyphs aren't
+     * kerned, and a label with an outline still draws its text into a texture of its own.
+     */
+    void setSystemFontGlyphCacheEnabled(bool enabled);
+    bool isSystemFontGlyphCacheEnabled() const { return _systemFontGlyphCacheEnabled; }
+
+    /** Sets whether the labels created from now on use the system font glyph cache, disabled by default. */
+    static void setDefaultSystemFontGlyphCacheEnabled(bool enabled);
+    static bool isDefaultSystemFontGlyphCacheEnabled();
+
     bool setProgramState(backend::ProgramState* programState, bool ownPS = false) override;
 
     FontAtlas* getFontAtlas() { return _fontAtlas; }
@@ -760,9 +791,55 @@ protected:
 
         std::array<CustomCommand*, 3> getCommandArray();
 
+        // what the buffers of a command hold, the quads from dirtyBegin on are uploaded by the next update
+        struct BufferState
+        {
+            TextureAtlas* textureAtlas = nullptr;
+            int allocatedQuads         = 0;
+            int dirtyBegin             = 0;
+        };
+
         CustomCommand textCommand;
         CustomCommand outLineCommand;
         CustomCommand shadowCommand;
+        QuadCommand quadCommand;  // draws the text when batching
+
+        BufferState textBuffer;
+        BufferState outLineBuffer;
+        BufferState shadowBuffer;
+    };
+
+    // what the quad of a letter was made from, the quads of the letters laid out as before are kept
+    struct LetterQuad
+    {
+        char32_t utf32Char;
+        bool valid;
+        float positionX;
+        float positionY;
+        float lineWidth;
+        int textureID;
+        int atlasIndex;
+
+        bool hasSameLayout(const LetterQuad& rhs) const;
+    };
+
+    // the params the quads of all letters depend on
+    struct QuadsLayout
+    {
+        FontAtlas* fontAtlas;
+        unsigned int fontAtlasGeneration;
+        float fontScale;
+        float letterOffsetY;
+        float tailoredTopY;
+        float tailoredBottomY;
+        Vec2 contentSize;
+        float labelWidth;
+        float labelHeight;
+        Overflow overflow;
+        bool enableWrap;
+        LabelType labelType;
+
+        bool operator==(const QuadsLayout& rhs) const;
     };
 
     virtual void setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled = false, bool useA8Shader = false);
@@ -789,6 +866,13 @@ protected:
     void recordPlaceholderInfo(int letterIndex, char32_t utf16Char);
 
     bool updateQuads();
+    LetterQuad makeLetterQuad(int letterIndex) const;
+    QuadsLayout makeQuadsLayout() const;
+
+    /** Records that the quads of an atlas changed from begin on, so only those are uploaded. */
+    void markQuadsDirty(TextureAtlas* textureAtlas, int begin);
+    int takeQuadsDirtyBegin(TextureAtlas* textureAtlas);
+    void updateQuadsColor(bool newQuadsOnly);
 
     void createSpriteForSystemFont(const FontDefinition& fontDef);
     void createShadowSpriteForSystemFont(const FontDefinition& fontDef);
@@ -822,7 +906,18 @@ protected:
                               TextureAtlas* textureAtlas,
                               Renderer* renderer,
                               const Mat4& transform);
-    void updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customCommand);
+    void updateBuffer(TextureAtlas* textureAtlas,
+                      CustomCommand& customCommand,
+                      BatchCommand::BufferState& bufferState);
+
+    bool isTextBatchable() const;
+    //! whether the glyphs of the system font are laid out from an atlas, see setSystemFontGlyphCacheEnabled
+    bool isSystemFontCached() const { return _currentLabelType == LabelType::STRING_TEXTURE && _fontAtlas; }
+    void drawTextBatched(BatchCommand& batch,
+                         TextureAtlas* textureAtlas,
+                         Renderer* renderer,
+                         const Mat4& transform,
+                         uint32_t flags);
 
     void updateBatchCommand(BatchCommand& batch);
 
@@ -894,7 +989,12 @@ protected:
     Sprite* _textSprite;
     Sprite* _shadowNode;
     int* _horizontalKernings;
+    //! the text and font the kernings were computed for, the kernings of an unchanged prefix are kept
+    std::u32string _kerningsText;
+    const Font* _kerningsFont = nullptr;
     FontAtlas* _fontAtlas;
+    //! the atlas generation the letters were laid out with
+    unsigned int _fontAtlasGeneration = 0;
     //! used for optimization
     Sprite* _reusedLetter;
     DrawNode* _lineDrawNode;
@@ -919,11 +1019,21 @@ protected:
     Vector<SpriteBatchNode*> _batchNodes;
     std::vector<LetterInfo> _lettersInfo;
 
+    std::vector<LetterQuad> _letterQuads;
+    QuadsLayout _quadsLayout{};
+    std::vector<int> _keptQuads;  // per batch node, by the last updateQuads
+    std::vector<std::pair<TextureAtlas*, int>> _quadsDirtyBegins;
+
     std::vector<float> _linesWidth;
     std::vector<float> _linesOffsetX;
 
     QuadCommand _quadCommand;
 
+    bool _textBatchingEnabled         = false;
+    bool _systemFontGlyphCacheEnabled = false;
+    //! the quads are colored with the text color, see updateQuadsColor
+    bool _textColorInVertices = false;
+
     std::vector<BatchCommand> _batchCommands;
 
     std::unordered_map<int, Sprite*> _letters;
@@ -25,7 +25,6 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "2d/MotionStreak.h"
-#include "math/Vertex.h"
 #include "base/Director.h"
 #include "base/Utils.h"
 #include "renderer/TextureCache.h"
@@ -37,20 +36,11 @@ THE SOFTWARE.
 namespace ax
 {
 
-MotionStreak::MotionStreak()
-{
-    _customCommand.setDrawType(CustomCommand::DrawType::ARRAY);
-    _customCommand.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE_STRIP);
-}
+MotionStreak::MotionStreak() {}
 
 MotionStreak::~MotionStreak()
 {
     AX_SAFE_RELEASE(_texture);
-    AX_SAFE_FREE(_pointState);
-    AX_SAFE_FREE(_pointVertexes);
-    AX_SAFE_FREE(_vertices);
-    AX_SAFE_FREE(_colorPointer);
-    AX_SAFE_FREE(_texCoords);
 }
 
 MotionStreak* MotionStreak::create(float fade, float minSeg, float stroke, const Color3B& color, std::string_view path)
@@ -99,8 +89,7 @@ bool MotionStreak::initWithFade(float fade, float minSeg, float stroke, const Co
     _minSeg   = (minSeg == -1.0f) ? stroke / 5.0f : minSeg;
     _minSeg *= _minSeg;
 
-    _stroke    = stroke;
-    _fadeDelta = 1.0f / fade;
+    _stroke = stroke;
 
     // Fix #629 Motion streak vsync off crash
     double interval = _director->getAnimationInterval();
@@ -108,21 +97,7 @@ bool MotionStreak::initWithFade(float fade, float minSeg, float stroke, const Co
     if (roundf(fps) > 240.0)
         fps = 240.0;
 
-    _maxPoints = (int)(fade * fps) + 2;
-
-    _pointState    = (float*)malloc(sizeof(float) * _maxPoints);
-    _pointVertexes = (Vec2*)malloc(sizeof(Vec2) * _maxPoints);
-
-    const size_t VERTEX_SIZE = sizeof(Vec2) + sizeof(Tex2F) + sizeof(uint8_t) * 4;
-
-    _vertexCount  = _maxPoints * 2;
-    _vertices     = (Vec2*)malloc(sizeof(Vec2) * _vertexCount);
-    _texCoords    = (Tex2F*)malloc(sizeof(Tex2F) * _vertexCount);
-    _colorPointer = (uint8_t*)malloc(sizeof(uint8_t) * 4 * _vertexCount);
-    _customCommand.createVertexBuffer(VERTEX_SIZE, _vertexCount, CustomCommand::BufferUsage::DYNAMIC);
-
-    auto zeros = std::make_unique<uint8_t[]>(VERTEX_SIZE * _vertexCount);
-    _customCommand.updateVertexBuffer(zeros.get(), VERTEX_SIZE * _vertexCount);
+    _trail.init((unsigned int)(fade * fps) + 2, fade);
 
     setTexture(texture);
     setColor(color);
@@ -197,12 +172,7 @@ void MotionStreak::setPositionY(float y)
 void MotionStreak::tintWithColor(const Color3B& colors)
 {
     setColor(colors);
-
-    // Fast assignation
-    for (unsigned int i = 0; i < _nuPoints * 2; i++)
-    {
-        *((Color3B*)(_colorPointer + i * 4)) = colors;
-    }
+    _trail.setColor(colors);
 }
 
 Texture2D* MotionStreak::getTexture() const
@@ -218,7 +188,7 @@ void MotionStreak::setTexture(Texture2D* texture)
         AX_SAFE_RELEASE(_texture);
         _texture = texture;
 
-        setProgramStateWithRegistry(backend::ProgramType::POSITION_TEXTURE_COLOR, _texture);
+        setProgramStateWithRegistry(backend::ProgramType::MOTION_STREAK, _texture);
     }
 }
 
@@ -227,33 +197,7 @@ bool MotionStreak::setProgramState(backend::ProgramState* programState, bool own
     if (Node::setProgramState(programState, ownPS))
     {
         AXASSERT(programState, "argument should not be nullptr");
-        auto& pipelineDescriptor        = _customCommand.getPipelineDescriptor();
-        pipelineDescriptor.programState = _programState;
-
-        _mvpMatrixLocaiton = _programState->getUniformLocation("u_MVPMatrix");
-        _textureLocation   = _programState->getUniformLocation("u_tex0");
-
-        // setup custom vertex layout for V2F_T2F_C4B
-        const auto& attributeInfo = _programState->getProgram()->getActiveAttributes();
-        auto iter                 = attributeInfo.find("a_position");
-        auto layout               = _programState->getMutableVertexLayout();
-        if (iter != attributeInfo.end())
-        {
-            layout->setAttrib("a_position", iter->second.location, backend::VertexFormat::FLOAT2, 0, false);
-        }
-        iter = attributeInfo.find("a_texCoord");
-        if (iter != attributeInfo.end())
-        {
-            layout->setAttrib("a_texCoord", iter->second.location, backend::VertexFormat::FLOAT2,
-                                      2 * sizeof(float), false);
-        }
-        iter = attributeInfo.find("a_color");
-        if (iter != attributeInfo.end())
-        {
-            layout->setAttrib("a_color", iter->second.location, backend::VertexFormat::UBYTE4,
-                                      4 * sizeof(float), true);
-        }
-        layout->setStride(4 * sizeof(float) + 4 * sizeof(uint8_t));
+        _trail.setProgramState(_programState);
 
         updateProgramStateTexture(_texture);
         return true;
@@ -294,147 +238,94 @@ void MotionStreak::update(float delta)
     if (!_startingPositionInitialized)
         return;
 
-    delta *= _fadeDelta;
-
-    unsigned int newIdx, newIdx2, i, i2;
-    unsigned int mov = 0;
-
-    // Update current points
-    for (i = 0; i < _nuPoints; i++)
-    {
-        _pointState[i] -= delta;
-
-        if (_pointState[i] <= 0)
-            mov++;
-        else
-        {
-            newIdx = i - mov;
-
-            if (mov > 0)
-            {
-                // Move data
-                _pointState[newIdx] = _pointState[i];
-
-                // Move point
-                _pointVertexes[newIdx] = _pointVertexes[i];
-
-                // Move vertices
-                i2                     = i * 2;
-                newIdx2                = newIdx * 2;
-                _vertices[newIdx2]     = _vertices[i2];
-                _vertices[newIdx2 + 1] = _vertices[i2 + 1];
-
-                // Move color
-                i2 *= 4;
-                newIdx2 *= 4;
-                _colorPointer[newIdx2 + 0] = _colorPointer[i2 + 0];
-                _colorPointer[newIdx2 + 1] = _colorPointer[i2 + 1];
-                _colorPointer[newIdx2 + 2] = _colorPointer[i2 + 2];
-                _colorPointer[newIdx2 + 4] = _colorPointer[i2 + 4];
-                _colorPointer[newIdx2 + 5] = _colorPointer[i2 + 5];
-                _colorPointer[newIdx2 + 6] = _colorPointer[i2 + 6];
-            }
-            else
-                newIdx2 = newIdx * 8;
-
-            const uint8_t op           = (uint8_t)(_pointState[newIdx] * 255.0f);
-            _colorPointer[newIdx2 + 3] = op;
-            _colorPointer[newIdx2 + 7] = op;
-        }
-    }
-    _nuPoints -= mov;
+    _trail.update(delta);
 
     // Append new point
+    const auto count    = _trail.getPointCount();
     bool appendNewPoint = true;
-    if (_nuPoints >= _maxPoints)
+    if (_trail.isFull())
         appendNewPoint = false;
-    else if (_nuPoints > 0)
+    else if (count > 0)
     {
-        bool a1 = _pointVertexes[_nuPoints - 1].getDistanceSq(_positionR) < _minSeg;
-        bool a2 =
-            (_nuPoints == 1) ? false : (_pointVertexes[_nuPoints - 2].getDistanceSq(_positionR) < (_minSeg * 2.0f));
+        const Vec3 position(_positionR.x, _positionR.y, 0.0f);
+        bool a1 = _trail.getPoint(count - 1).distanceSquared(position) < _minSeg;
+        bool a2 = (count == 1) ? false : (_trail.getPoint(count - 2).distanceSquared(position) < (_minSeg * 2.0f));
         if (a1 || a2)
             appendNewPoint = false;
     }
 
-    if (appendNewPoint)
-    {
-        _pointVertexes[_nuPoints] = _positionR;
-        _pointState[_nuPoints]    = 1.0f;
-
-        // Color assignment
-        const unsigned int offset                 = _nuPoints * 8;
-        *((Color3B*)(_colorPointer + offset))     = _displayedColor;
-        *((Color3B*)(_colorPointer + offset + 4)) = _displayedColor;
+    if (!appendNewPoint)
+        return;
 
-        // Opacity
-        _colorPointer[offset + 3] = 255;
-        _colorPointer[offset + 7] = 255;
+    // only the new point and the one before it change, the others keep the offsets they were uploaded with
+    _trail.append(Vec3(_positionR.x, _positionR.y, 0.0f), Vec3::ZERO, Color4B(_displayedColor, 255));
+    if (count > 0)
+    {
+        if (count > 1)
+            updateOffset(count - 1);
+        updateOffset(count);
+        if (count == 1)
+            updateOffset(0);
+    }
+}
 
-        // Generate polygon
-        if (_nuPoints > 0 && _fastMode)
+void MotionStreak::updateOffset(unsigned int index)
+{
+    // the same perpendiculars as ccVertexLineToPolygon, for a stroke of 1
+    const auto last = _trail.getPointCount() - 1;
+    const Vec2 p1(_trail.getPoint(index).x, _trail.getPoint(index).y);
+    Vec2 perpVector;
+    if (index == 0)
+    {
+        const Vec2 p2(_trail.getPoint(1).x, _trail.getPoint(1).y);
+        perpVector = (p1 - p2).getNormalized().getPerp();
+    }
+    else
+    {
+        const Vec2 p0(_trail.getPoint(index - 1).x, _trail.getPoint(index - 1).y);
+        if (index == last)
+            perpVector = (p0 - p1).getNormalized().getPerp();
+        else
         {
-            if (_nuPoints > 1)
-            {
-                ccVertexLineToPolygon(_pointVertexes, _stroke, _vertices, _nuPoints, 1);
-            }
-            else
-            {
-                ccVertexLineToPolygon(_pointVertexes, _stroke, _vertices, 0, 2);
-            }
-        }
+            const Vec2 p2(_trail.getPoint(index + 1).x, _trail.getPoint(index + 1).y);
 
-        _nuPoints++;
-    }
+            Vec2 p2p1 = (p2 - p1).getNormalized();
+            Vec2 p0p1 = (p0 - p1).getNormalized();
 
-    if (!_fastMode)
-        ccVertexLineToPolygon(_pointVertexes, _stroke, _vertices, 0, _nuPoints);
+            // Calculate angle between vectors
+            float angle = acosf(clampf(p2p1.dot(p0p1), -1.0f, 1.0f));
 
-    // Updated Tex Coords only if they are different than previous step
-    if (_nuPoints && _previousNuPoints != _nuPoints)
-    {
-        float texDelta = 1.0f / _nuPoints;
-        for (i = 0; i < _nuPoints; i++)
-        {
-            _texCoords[i * 2]     = Tex2F(0, texDelta * i);
-            _texCoords[i * 2 + 1] = Tex2F(1, texDelta * i);
+            if (angle < AX_DEGREES_TO_RADIANS(70))
+                perpVector = p2p1.getMidpoint(p0p1).getNormalized().getPerp();
+            else if (angle < AX_DEGREES_TO_RADIANS(170))
+                perpVector = p2p1.getMidpoint(p0p1).getNormalized();
+            else
+                perpVector = (p2 - p0).getNormalized().getPerp();
         }
 
-        _previousNuPoints = _nuPoints;
+        // keeps the sides of the segment from crossing, the strip would be twisted
+        const auto& previous = _trail.getOffset(index - 1);
+        if (perpVector.x * previous.x + perpVector.y * previous.y < 0.0f)
+            perpVector = -perpVector;
     }
+
+    _trail.setOffset(index, Vec3(perpVector.x, perpVector.y, 0.0f));
 }
 
 void MotionStreak::reset()
 {
-    _nuPoints = 0;
+    _trail.reset();
 }
 
 void MotionStreak::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    if (_nuPoints <= 1)
-        return;
-
-    auto drawCount = _nuPoints * 2;
-
-    _customCommand.init(_globalZOrder, _blendFunc);
-    _customCommand.setVertexDrawInfo(0, drawCount);
-    renderer->addCommand(&_customCommand);
-
-    auto programState = _customCommand.getPipelineDescriptor().programState;
-
     const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
-    Mat4 finalMat             = projectionMat * transform;
-    programState->setUniform(_mvpMatrixLocaiton, finalMat.m, sizeof(Mat4));
-
-    unsigned int offset     = 0;
-    unsigned int vertexSize = sizeof(Vec2) + sizeof(Vec2) + sizeof(uint8_t) * 4;
-    for (unsigned int i = 0; i < drawCount; ++i)
+    const int commandCount    = _trail.prepareCommands(projectionMat * transform, _stroke);
+    for (int i = 0; i < commandCount; ++i)
     {
-        offset = i * vertexSize;
-        _customCommand.updateVertexBuffer(&_vertices[i], offset, sizeof(_vertices[0]));
-        _customCommand.updateVertexBuffer(&_texCoords[i], offset + sizeof(_vertices[0]), sizeof(_texCoords[0]));
-        _customCommand.updateVertexBuffer(&_colorPointer[i * 4], offset + sizeof(_vertices[0]) + sizeof(_texCoords[0]),
-                                          4 * sizeof(uint8_t));
+        auto& command = _trail.getCommand(i);
+        command.init(_globalZOrder, _blendFunc);
+        renderer->addCommand(&command);
     }
 }
 
@@ -28,7 +28,7 @@ THE SOFTWARE.
 
 #include "base/Protocols.h"
 #include "2d/Node.h"
-#include "renderer/CustomCommand.h"
+#include "renderer/TrailBuffer.h"
 
 namespace ax
 {
@@ -42,6 +42,9 @@ class Texture2D;
 
 /** @class MotionStreak.
  * @brief Creates a trailing path.
+ *
+ * The points are kept in a TrailBuffer, each one is uploaded once and faded out by the vertex shader, so many
+ * streaks can run at once. A custom program state needs the attributes and uniforms of motionStreak.vert.
  */
 class AX_DLL MotionStreak : public Node, public TextureProtocol
 {
@@ -123,6 +126,7 @@ public:
     void reset();
 
     /** When fast mode is enabled, new points are added faster but with lower precision.
+     * Only the new point and the one before it are updated in both modes now, so the mode makes no difference.
      *
      * @return True if fast mode is enabled.
      */
@@ -170,6 +174,9 @@ public:
     bool initWithFade(float fade, float minSeg, float stroke, const Color3B& color, Texture2D* texture);
 
 protected:
+    /** Computes the offset of a point of the strip from its neighbours. */
+    void updateOffset(unsigned int index);
+
     bool _fastMode                    = false;
     bool _startingPositionInitialized = false;
 
@@ -178,27 +185,10 @@ protected:
     BlendFunc _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
     Vec2 _positionR;
 
-    float _stroke    = 0.f;
-    float _fadeDelta = 0.f;
-    float _minSeg    = 0.f;
-
-    unsigned int _maxPoints        = 0;
-    unsigned int _nuPoints         = 0;
-    unsigned int _previousNuPoints = 0;
-
-    /** Pointers */
-    Vec2* _pointVertexes = nullptr;
-    float* _pointState   = nullptr;
-
-    Vec2* _vertices           = nullptr;
-    uint8_t* _colorPointer    = nullptr;
-    Tex2F* _texCoords         = nullptr;
-    unsigned int _vertexCount = 0;
-
-    CustomCommand _customCommand;
+    float _stroke = 0.f;
+    float _minSeg = 0.f;
 
-    backend::UniformLocation _mvpMatrixLocaiton;
-    backend::UniformLocation _textureLocation;
+    TrailBuffer _trail;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(MotionStreak);
@@ -33,8 +33,10 @@ THE SOFTWARE.
 #include <algorithm>
 #include <string>
 #include <regex>
+#include <mutex>
+#include <condition_variable>
+#include <cfloat>
 
-#include "xxhash.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
 #include "base/EventDispatcher.h"
@@ -42,8 +44,13 @@ THE SOFTWARE.
 #include "2d/Camera.h"
 #include "2d/ActionManager.h"
 #include "2d/Scene.h"
+#include "2d/NodePool.h"
+#include "2d/SpatialGrid.h"
+#include "2d/TransformBatch.h"
+#include "renderer/StaticBatch.h"
 #include "2d/Component.h"
 #include "renderer/Material.h"
+#include "renderer/Renderer.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
 #include "renderer/backend/ProgramStateRegistry.h"
@@ -54,11 +61,6 @@ THE SOFTWARE.
 #    define RENDER_IN_SUBPIXEL(__ARGS__) (ceil(__ARGS__))
 #endif
 
-/*
- * 4.5x faster than std::hash in release mode
- */
-#define AX_HASH_NODE_NAME(name) (!name.empty() ? XXH3_64bits(name.data(), name.length()) : 0)
-
 namespace ax
 {
 
@@ -67,6 +69,78 @@ namespace ax
 std::uint32_t Node::s_globalOrderOfArrival = 0;
 int Node::__attachedNodeCount              = 0;
 
+/*
+ * Visits the children flagged as parallel visit roots on JobSystem workers, the children are dispatched
+ * before the serial walk and their recordings are submitted when the walk reaches them, so the render queue
+ * content is the same as a serial visit.
+ */
+class ParallelChildrenVisitor
+{
+public:
+    explicit ParallelChildrenVisitor(Renderer* renderer) : _renderer(renderer) {}
+    ~ParallelChildrenVisitor()
+    {
+        // the jobs reference this object, wait for the ones never reached by the walk, i.e. on early return
+        for (auto& job : _jobs)
+            if (job.recorder)
+                wait(job);
+    }
+
+    void dispatch(Director* director, const Vector<Node*>& children, const Mat4& transform, uint32_t flags)
+    {
+        for (auto child : children)
+            if (child->isParallelVisitRoot() && child->isVisible())
+                _jobs.emplace_back(Job{child, _renderer->acquireRecorder()});
+
+        auto jobSystem = director->getJobSystem();
+        for (auto& job : _jobs)
+        {
+            jobSystem->enqueue([this, &job, transform, flags] {
+                _renderer->beginRecording(job.recorder);
+                job.node->visit(_renderer, transform, flags);
+                _renderer->endRecording();
+
+                std::lock_guard<std::mutex> lck(_mutex);
+                job.done = true;
+                _cond.notify_all();
+            });
+        }
+    }
+
+    void visit(Node* child, const Mat4& transform, uint32_t flags)
+    {
+        if (_nextJob < _jobs.size() && _jobs[_nextJob].node == child)
+        {
+            auto& job = _jobs[_nextJob++];
+            wait(job);
+            _renderer->submitRecording(job.recorder);
+            job.recorder = nullptr;
+        }
+        else
+            child->visit(_renderer, transform, flags);
+    }
+
+private:
+    struct Job
+    {
+        Node* node;
+        RenderCommandRecorder* recorder;
+        bool done = false;
+    };
+
+    void wait(Job& job)
+    {
+        std::unique_lock<std::mutex> lck(_mutex);
+        _cond.wait(lck, [&job] { return job.done; });
+    }
+
+    Renderer* _renderer;
+    std::vector<Job> _jobs;
+    size_t _nextJob = 0;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+};
+
 // MARK: Constructor, Destructor, Init
 
 Node::Node()
@@ -87,6 +161,7 @@ Node::Node()
     , _contentSizeDirty(true)
     , _transformDirty(true)
     , _inverseDirty(true)
+    , _inverse(nullptr)
     , _additionalTransform(nullptr)
     , _additionalTransformDirty(false)
     , _transformUpdated(true)
@@ -98,8 +173,6 @@ Node::Node()
     , _parent(nullptr)
     // "whole screen" objects. like Scenes and Layers, should set _ignoreAnchorPointForPosition to true
     , _tag(Node::INVALID_TAG)
-    , _name()
-    , _hashOfName(0)
     // userData is always inited as nil
     , _userData(nullptr)
     , _userObject(nullptr)
@@ -121,10 +194,6 @@ Node::Node()
     , _cascadeOpacityEnabled(false)
     , _childFollowCameraMask(false)
     , _cameraMask(1)
-    , _onEnterCallback(nullptr)
-    , _onExitCallback(nullptr)
-    , _onEnterTransitionDidFinishCallback(nullptr)
-    , _onExitTransitionDidStartCallback(nullptr)
 #if defined(AX_ENABLE_PHYSICS)
     , _physicsBody(nullptr)
 #endif
@@ -138,7 +207,7 @@ Node::Node()
     _eventDispatcher = _director->getEventDispatcher();
     _eventDispatcher->retain();
 
-    _transform = _inverse = Mat4::IDENTITY;
+    _transform = Mat4::IDENTITY;
 }
 
 Node* Node::create()
@@ -160,6 +229,12 @@ Node::~Node()
     AXLOGV("deallocing Node: {} - tag: {}", fmt::ptr(this), _tag);
 
     AX_SAFE_DELETE(_childrenIndexer);
+    AX_SAFE_DELETE(_spatialIndex);
+    AX_SAFE_DELETE(_transformBatch);
+    AX_SAFE_DELETE(_staticBatch);
+
+    if (_nodePool)
+        _nodePool->forget(this);
 
 #if AX_ENABLE_SCRIPT_BINDING
     if (_updateScriptHandler)
@@ -199,6 +274,8 @@ Node::~Node()
     AX_SAFE_RELEASE(_eventDispatcher);
 
     delete[] _additionalTransform;
+    AX_SAFE_DELETE(_inverse);
+    AX_SAFE_DELETE(_enterExitCallbacks);
     AX_SAFE_RELEASE(_programState);
 }
 
@@ -256,8 +333,8 @@ void Node::setSkewX(float skewX)
     if (_skewX == skewX)
         return;
 
-    _skewX            = skewX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    _skewX = skewX;
+    setTransformDirty();
 }
 
 float Node::getSkewY() const
@@ -270,8 +347,8 @@ void Node::setSkewY(float skewY)
     if (_skewY == skewY)
         return;
 
-    _skewY            = skewY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    _skewY = skewY;
+    setTransformDirty();
 }
 
 void Node::setLocalZOrder(int z)
@@ -285,7 +362,7 @@ void Node::setLocalZOrder(int z)
         _parent->reorderChild(this, z);
     }
 
-    _eventDispatcher->setDirtyForNode(this);
+    _eventDispatcher->setDirtyForReorder(_parent ? _parent : this);
 }
 
 /// zOrder setter : private method
@@ -305,7 +382,7 @@ void Node::setGlobalZOrder(float globalZOrder)
     if (_globalZOrder != globalZOrder)
     {
         _globalZOrder = globalZOrder;
-        _eventDispatcher->setDirtyForNode(this);
+        _eventDispatcher->setDirtyForReorder(this);
     }
 }
 
@@ -323,7 +400,7 @@ void Node::setRotation(float rotation)
         return;
 
     _rotationZ_X = _rotationZ_Y = rotation;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 
     updateRotationQuat();
 }
@@ -338,7 +415,7 @@ void Node::setRotation3D(const Vec3& rotation)
     if (_rotationX == rotation.x && _rotationY == rotation.y && _rotationZ_X == rotation.z)
         return;
 
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -391,7 +468,7 @@ void Node::setRotationQuat(const Quaternion& quat)
 {
     _rotationQuat = quat;
     updateRotation3D();
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -405,7 +482,7 @@ void Node::setRotationSkewX(float rotationX)
         return;
 
     _rotationZ_X      = rotationX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 
     updateRotationQuat();
 }
@@ -421,7 +498,7 @@ void Node::setRotationSkewY(float rotationY)
         return;
 
     _rotationZ_Y      = rotationY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 
     updateRotationQuat();
 }
@@ -440,7 +517,7 @@ void Node::setScale(float scale)
         return;
 
     _scaleX = _scaleY = _scaleZ = scale;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// scaleX getter
@@ -457,7 +534,7 @@ void Node::setScale(float scaleX, float scaleY)
 
     _scaleX           = scaleX;
     _scaleY           = scaleY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// scaleX setter
@@ -467,7 +544,7 @@ void Node::setScaleX(float scaleX)
         return;
 
     _scaleX           = scaleX;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// scaleY getter
@@ -483,7 +560,7 @@ void Node::setScaleZ(float scaleZ)
         return;
 
     _scaleZ           = scaleZ;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// scaleY getter
@@ -499,7 +576,7 @@ void Node::setScaleY(float scaleY)
         return;
 
     _scaleY           = scaleY;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// position getter
@@ -528,7 +605,7 @@ void Node::setPosition(float x, float y)
     _position.x = x;
     _position.y = y;
 
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
     _usingNormalizedPosition                            = false;
 }
 
@@ -573,7 +650,7 @@ void Node::setPositionZ(float positionZ)
     if (_positionZ == positionZ)
         return;
 
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 
     _positionZ = positionZ;
 }
@@ -593,7 +670,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _normalizedPosition      = position;
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -614,7 +691,7 @@ void Node::setVisible(bool visible)
     {
         _visible = visible;
         if (_visible)
-            _transformUpdated = _transformDirty = _inverseDirty = true;
+            setTransformDirty();
     }
 }
 
@@ -635,7 +712,7 @@ void Node::setAnchorPoint(const Vec2& point)
     {
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
-        _transformUpdated = _transformDirty = _inverseDirty = true;
+        setTransformDirty();
     }
 }
 
@@ -652,7 +729,8 @@ void Node::setContentSize(const Vec2& size)
         _contentSize = size;
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
-        _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        setTransformDirty();
+        _contentSizeDirty = true;
     }
 }
 
@@ -672,9 +750,14 @@ bool Node::isRunning() const
 /// parent setter
 void Node::setParent(Node* parent)
 {
-    _parent           = parent;
+    if (_parent)
+        _parent->invalidateSubtreeCameraMask();
+    if (parent)
+        parent->invalidateSubtreeCameraMask();
+
+    _parent                  = parent;
     _normalizedPositionDirty = true;
-    _transformUpdated = _transformDirty = _inverseDirty = true;
+    setTransformDirty();
 }
 
 /// isRelativeAnchorPoint getter
@@ -689,7 +772,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     if (newValue != _ignoreAnchorPointForPosition)
     {
         _ignoreAnchorPointForPosition = newValue;
-        _transformUpdated = _transformDirty = _inverseDirty = true;
+        setTransformDirty();
     }
 }
 
@@ -708,13 +791,12 @@ void Node::setTag(int tag)
 
 std::string_view Node::getName() const
 {
-    return _name;
+    return _name.view();
 }
 
 void Node::setName(std::string_view name)
 {
     updateParentChildrenIndexer(name);
-    _name = name;
 }
 
 void Node::updateParentChildrenIndexer(int tag)
@@ -730,17 +812,16 @@ void Node::updateParentChildrenIndexer(int tag)
 
 void Node::updateParentChildrenIndexer(std::string_view name)
 {
-    uint64_t newHash           = AX_HASH_NODE_NAME(name);
+    InternedString newName(name);
     auto parentChildrenIndexer = getParentChildrenIndexer();
     if (parentChildrenIndexer)
     {
-        auto oldHash = AX_HASH_NODE_NAME(_name);
-        if (oldHash != newHash)
-            parentChildrenIndexer->erase(oldHash);
-        (*parentChildrenIndexer)[newHash] = this;
+        if (_name != newName)
+            parentChildrenIndexer->erase(_name.hash());
+        (*parentChildrenIndexer)[newName.hash()] = this;
     }
 
-    _hashOfName = newHash;
+    _name = newName;
 }
 
 NodeIndexerMap_t* Node::getParentChildrenIndexer()
@@ -831,18 +912,21 @@ Node* Node::getChildByTag(int tag) const
 Node* Node::getChildByName(std::string_view name) const
 {
     // AXASSERT(!name.empty(), "Invalid name");
-    auto hash = AX_HASH_NODE_NAME(name);
+    // a name that was never interned isn't the name of any node
+    auto interned = InternedString::find(name);
+    if (interned.empty() && !name.empty())
+        return nullptr;
+
     if (_childrenIndexer)
     {
-        auto it = _childrenIndexer->find(hash);
+        auto it = _childrenIndexer->find(interned.hash());
         if (it != _childrenIndexer->end())
             return it->second;
     }
 
     for (const auto& child : _children)
     {
-        // Different strings may have the same hash code, but can use it to compare first for speed
-        if (child->_hashOfName == hash && child->_name.compare(name) == 0)
+        if (child->_name == interned)
             return child;
     }
     return nullptr;
@@ -897,7 +981,7 @@ void Node::enumerateChildren(std::string_view name, std::function<bool(Node*)> c
     else
     {
         // name is xxx
-        target->doEnumerate(std::string{newName}, callback);
+        target->doEnumerate(newName, callback);
     }
 }
 
@@ -905,7 +989,7 @@ bool Node::doEnumerateRecursive(const Node* node, std::string_view name, std::fu
 {
     bool ret = false;
 
-    if (node->doEnumerate(std::string{name}, callback))
+    if (node->doEnumerate(name, callback))
     {
         // search itself
         ret = true;
@@ -926,23 +1010,37 @@ bool Node::doEnumerateRecursive(const Node* node, std::string_view name, std::fu
     return ret;
 }
 
-bool Node::doEnumerate(std::string name, std::function<bool(Node*)> callback) const
+bool Node::doEnumerate(std::string_view name, std::function<bool(Node*)> callback) const
 {
     // name may be xxx/yyy, should find its parent
-    size_t pos             = name.find('/');
-    std::string searchName = name;
-    bool needRecursive     = false;
+    size_t pos         = name.find('/');
+    auto searchName    = name;
+    bool needRecursive = false;
     if (pos != name.npos)
     {
         searchName = name.substr(0, pos);
-        name.erase(0, pos + 1);
+        name.remove_prefix(pos + 1);
         needRecursive = true;
     }
 
+    // the plain names are compared with the interned ones, the others are regular expressions
+    const bool isPattern = searchName.find_first_of("\\^$.|?*+()[]{}") != std::string_view::npos;
+    InternedString internedName;
+    std::regex pattern;
+    if (isPattern)
+        pattern.assign(searchName.data(), searchName.length());
+    else
+    {
+        internedName = InternedString::find(searchName);
+        if (internedName.empty() && !searchName.empty())
+            return false;
+    }
+
     bool ret = false;
     for (const auto& child : getChildren())
     {
-        if (std::regex_match(child->_name, std::regex(searchName)))
+        auto childName = child->_name.view();
+        if (isPattern ? std::regex_match(childName.begin(), childName.end(), pattern) : child->_name == internedName)
         {
             if (!needRecursive)
             {
@@ -1007,6 +1105,10 @@ void Node::addChildHelper(Node* child, int localZOrder, int tag, std::string_vie
 
     child->setParent(this);
 
+    if (_spatialIndex)
+        _spatialIndex->insert(child);
+    invalidateStaticBatch();
+
     if (_childFollowCameraMask)
     {
         child->setCameraMask(this->getCameraMask());
@@ -1050,13 +1152,13 @@ void Node::addChildHelper(Node* child, int localZOrder, int tag, std::string_vie
 void Node::addChild(Node* child, int zOrder)
 {
     AXASSERT(child != nullptr, "Argument must be non-nil");
-    this->addChild(child, zOrder, child->_name);
+    this->addChild(child, zOrder, child->_name.view());
 }
 
 void Node::addChild(Node* child)
 {
     AXASSERT(child != nullptr, "Argument must be non-nil");
-    this->addChild(child, child->getLocalZOrder(), child->_name);
+    this->addChild(child, child->getLocalZOrder(), child->_name.view());
 }
 
 void Node::removeFromParent()
@@ -1134,8 +1236,14 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
         resetChild(child, cleanup);
     }
 
+    invalidateStaticBatch();
+    if (_staticBatch || _inStaticBatch)
+        setDescendantsInStaticBatch(false);
+
     _children.clear();
     AX_SAFE_DELETE(_childrenIndexer);
+    if (_spatialIndex)
+        _spatialIndex->clear();
 }
 
 void Node::resetChild(Node* child, bool cleanup)
@@ -1164,6 +1272,10 @@ void Node::resetChild(Node* child, bool cleanup)
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
     // set parent nil at the end
     child->setParent(nullptr);
+
+    // a pooled child only referenced by this node goes back to its pool instead of being destroyed
+    if (cleanup && child->_nodePool)
+        child->_nodePool->reclaim(child);
 }
 
 void Node::detachChild(Node* child, ssize_t childIndex, bool cleanup)
@@ -1171,7 +1283,17 @@ void Node::detachChild(Node* child, ssize_t childIndex, bool cleanup)
     if (_childrenIndexer)
     {
         _childrenIndexer->erase(child->_tag);
-        _childrenIndexer->erase(child->_hashOfName);
+        _childrenIndexer->erase(child->_name.hash());
+    }
+
+    if (_spatialIndex)
+        _spatialIndex->remove(child);
+
+    invalidateStaticBatch();
+    if (child->_inStaticBatch)
+    {
+        child->_inStaticBatch = false;
+        child->setDescendantsInStaticBatch(false);
     }
 
     resetChild(child, cleanup);
@@ -1208,7 +1330,7 @@ void Node::sortAllChildren()
     {
         sortNodes(_children);
         _reorderChildDirty = false;
-        _eventDispatcher->setDirtyForNode(this);
+        _eventDispatcher->setDirtyForReorder(this);
     }
 }
 
@@ -1236,10 +1358,10 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
         AXASSERT(_parent, "setPositionNormalized() doesn't work with orphan nodes");
         if ((parentFlags & FLAGS_CONTENT_SIZE_DIRTY) || _normalizedPositionDirty)
         {
-            auto& s           = _parent->getContentSize();
-            _position.x       = _normalizedPosition.x * s.width;
-            _position.y       = _normalizedPosition.y * s.height;
-            _transformUpdated = _transformDirty = _inverseDirty = true;
+            auto& s     = _parent->getContentSize();
+            _position.x = _normalizedPosition.x * s.width;
+            _position.y = _normalizedPosition.y * s.height;
+            setTransformDirty();
             _normalizedPositionDirty                            = false;
         }
     }
@@ -1254,7 +1376,17 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
 
     if (flags & FLAGS_DIRTY_MASK)
-        _modelViewTransform = this->transform(parentTransform);
+    {
+        // computed by the transform batch of an ancestor unless the node or its parent changed since
+        bool batched = _transformBatchFrame == _director->getTotalFrames() + 1 && !_transformDirty && _parent &&
+                       &parentTransform == &_parent->_modelViewTransform &&
+                       _parent->_transformBatchFrame == _transformBatchFrame;
+        if (!batched)
+        {
+            _modelViewTransform  = this->transform(parentTransform);
+            _transformBatchFrame = 0;
+        }
+    }
 
     _transformUpdated = false;
     _contentSizeDirty = false;
@@ -1262,6 +1394,31 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     return flags;
 }
 
+unsigned short Node::getSubtreeCameraMask()
+{
+    if (_subtreeCameraMaskDirty)
+    {
+        _subtreeCameraMask      = computeSubtreeCameraMask();
+        _subtreeCameraMaskDirty = false;
+    }
+    return _subtreeCameraMask;
+}
+
+unsigned short Node::computeSubtreeCameraMask()
+{
+    unsigned short mask = _cameraMask;
+    for (auto child : _children)
+        mask |= child->getSubtreeCameraMask();
+    return mask;
+}
+
+void Node::invalidateSubtreeCameraMask()
+{
+    // the ancestors of a dirty node are dirty
+    for (auto node = this; node && !node->_subtreeCameraMaskDirty; node = node->_parent)
+        node->_subtreeCameraMaskDirty = true;
+}
+
 bool Node::isVisitableByVisitingCamera() const
 {
     auto camera          = Camera::getVisitingCamera();
@@ -1277,6 +1434,21 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
         return;
     }
 
+    // nothing in the subtree for the visiting camera, Scene::render updated the masks before the cameras visit
+    auto camera = Camera::getVisitingCamera();
+    if (camera && !_subtreeCameraMaskDirty && !((unsigned short)camera->getCameraFlag() & _subtreeCameraMask))
+        return;
+
+    if (_staticBatch && _staticBatchState != StaticBatchState::UNBAKEABLE && !renderer->isRecording())
+    {
+        visitStaticBatch(renderer, parentTransform, parentFlags);
+        return;
+    }
+
+    // tell the renderer which node adds the commands, restored for the self draw after the children
+    const bool diagnostics = renderer->isBatchDiagnosticsEnabled() && !renderer->isRecording();
+    const Node* parentNode = diagnostics ? renderer->setDiagnosticsNode(this) : nullptr;
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     // IMPORTANT:
@@ -1292,22 +1464,37 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     if (!_children.empty())
     {
         sortAllChildren();
-        // draw children zOrder < 0
-        for (auto size = _children.size(); i < size; ++i)
-        {
-            auto node = _children.at(i);
 
-            if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
-            else
-                break;
+        if (_transformBatch)
+            _transformBatch->update(this, flags);
+
+        if (_spatialIndex && visitChildrenIndexed(renderer, flags, visibleByCamera))
+        {
+            // only the children in the view of the camera were visited
+        }
+        else if (renderer->isParallelVisitEnabled() && !renderer->isRecording())
+        {
+            visitChildrenParallel(renderer, flags, visibleByCamera);
         }
-        // self draw
-        if (visibleByCamera)
-            this->draw(renderer, _modelViewTransform, flags);
+        else
+        {
+            // draw children zOrder < 0
+            for (auto size = _children.size(); i < size; ++i)
+            {
+                auto node = _children.at(i);
 
-        for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+                if (node && node->_localZOrder < 0)
+                    node->visit(renderer, _modelViewTransform, flags);
+                else
+                    break;
+            }
+            // self draw
+            if (visibleByCamera)
+                this->draw(renderer, _modelViewTransform, flags);
+
+            for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
+                (*it)->visit(renderer, _modelViewTransform, flags);
+        }
     }
     else if (visibleByCamera)
     {
@@ -1316,15 +1503,213 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
 
     _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
+    if (diagnostics)
+        renderer->setDiagnosticsNode(parentNode);
+
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
     // reset for next frame
     // _orderOfArrival = 0;
 }
 
+void Node::visitChildrenParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera)
+{
+    ParallelChildrenVisitor visitor(renderer);
+    visitor.dispatch(_director, _children, _modelViewTransform, flags);
+
+    // same order as the serial visit: children zOrder < 0, self, remaining children
+    size_t i = 0;
+    for (auto size = _children.size(); i < size; ++i)
+    {
+        auto node = _children.at(i);
+
+        if (node && node->_localZOrder < 0)
+            visitor.visit(node, _modelViewTransform, flags);
+        else
+            break;
+    }
+
+    if (visibleByCamera)
+        this->draw(renderer, _modelViewTransform, flags);
+
+    for (auto size = _children.size(); i < size; ++i)
+        visitor.visit(_children.at(i), _modelViewTransform, flags);
+}
+
+void Node::setParallelVisitRoot(bool parallelVisitRoot)
+{
+    _parallelVisitRoot = parallelVisitRoot;
+}
+
+void Node::setTransformBatchRoot(bool transformBatchRoot)
+{
+    if (transformBatchRoot == isTransformBatchRoot())
+        return;
+
+    if (transformBatchRoot)
+        _transformBatch = new TransformBatch();
+    else
+        AX_SAFE_DELETE(_transformBatch);
+}
+
+bool Node::visitChildrenIndexed(Renderer* renderer, uint32_t flags, bool visibleByCamera)
+{
+    // a static batch keeps the children out of view too
+    if (renderer->isStaticCapturing())
+        return false;
+
+    // only the default camera is culled, like Renderer::checkVisibility
+    auto camera = Camera::getVisitingCamera();
+    auto scene  = _director->getRunningScene();
+    if (!camera || !scene || scene->getDefaultCamera() != camera)
+        return false;
+
+    // intersect the frustum edges with the z = 0 plane of this node
+    Mat4 clipToLocal = camera->getViewProjectionMatrix() * _modelViewTransform;
+    clipToLocal.inverse();
+
+    Rect view;
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec4 nearPoint((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, -1.0f, 1.0f);
+        Vec4 farPoint(nearPoint.x, nearPoint.y, 1.0f, 1.0f);
+        clipToLocal.transformVector(&nearPoint);
+        clipToLocal.transformVector(&farPoint);
+        if (std::abs(nearPoint.w) < FLT_EPSILON || std::abs(farPoint.w) < FLT_EPSILON)
+            return false;
+
+        Vec3 from(nearPoint.x / nearPoint.w, nearPoint.y / nearPoint.w, nearPoint.z / nearPoint.w);
+        Vec3 to(farPoint.x / farPoint.w, farPoint.y / farPoint.w, farPoint.z / farPoint.w);
+        float dz = from.z - to.z;
+        if (std::abs(dz) < FLT_EPSILON)
+            return false;  // looking along the plane
+        Vec3 point = from + (to - from) * (from.z / dz);
+
+        if (i == 0)
+            view.setRect(point.x, point.y, 0, 0);
+        else
+            view.merge(Rect(point.x, point.y, 0, 0));
+    }
+
+    _spatialIndex->refresh();
+    auto& visibleNodes = _spatialIndex->getVisibleNodes();
+    visibleNodes.clear();
+    _spatialIndex->query(view, visibleNodes);
+
+    // same order as the serial visit: children zOrder < 0, self, remaining children
+    std::sort(visibleNodes.begin(), visibleNodes.end(), [](Node* n1, Node* n2) {
+        return (n1->_localZOrder == n2->_localZOrder && n1->_orderOfArrival < n2->_orderOfArrival) ||
+               n1->_localZOrder < n2->_localZOrder;
+    });
+
+    size_t i = 0;
+    for (auto size = visibleNodes.size(); i < size && visibleNodes[i]->_localZOrder < 0; ++i)
+        visibleNodes[i]->visit(renderer, _modelViewTransform, flags);
+
+    if (visibleByCamera)
+        this->draw(renderer, _modelViewTransform, flags);
+
+    for (auto size = visibleNodes.size(); i < size; ++i)
+        visibleNodes[i]->visit(renderer, _modelViewTransform, flags);
+    return true;
+}
+
+void Node::setSpatialIndexEnabled(bool enabled, float cellSize)
+{
+    AX_SAFE_DELETE(_spatialIndex);
+    if (!enabled)
+        return;
+
+    _spatialIndex = new SpatialGrid(cellSize);
+    for (auto&& child : _children)
+        _spatialIndex->insert(child);
+}
+
+void Node::markSpatialIndexDirty()
+{
+    _parent->_spatialIndex->markDirty(this);
+}
+
+void Node::setStaticBatch(bool enabled)
+{
+    if (enabled == (_staticBatch != nullptr))
+        return;
+
+    if (enabled)
+    {
+        _staticBatch      = new StaticBatch();
+        _staticBatchState = StaticBatchState::DIRTY;
+    }
+    else
+    {
+        AX_SAFE_DELETE(_staticBatch);
+        // the descendants may still belong to the batch of an ancestor
+        setDescendantsInStaticBatch(_inStaticBatch);
+        invalidateStaticBatch();
+    }
+}
+
+void Node::invalidateStaticBatch()
+{
+    if (!_staticBatch && !_inStaticBatch)
+        return;
+
+    // up to the outermost root, nested batches are baked into it
+    for (auto node = this; node; node = node->_parent)
+    {
+        if (node->_staticBatch)
+            node->_staticBatchState = StaticBatchState::DIRTY;
+        if (!node->_inStaticBatch)
+            break;
+    }
+}
+
+void Node::setDescendantsInStaticBatch(bool inStaticBatch)
+{
+    for (auto&& child : _children)
+    {
+        child->_inStaticBatch = inStaticBatch;
+        // a nested batch didn't watch its descendants while they were baked into this one
+        if (child->_staticBatch)
+            child->_staticBatchState = StaticBatchState::DIRTY;
+        child->setDescendantsInStaticBatch(inStaticBatch);
+    }
+}
+
+void Node::visitStaticBatch(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_staticBatchState == StaticBatchState::DIRTY)
+    {
+        // record the subtree through the usual visit, then bake what it added
+        auto recorder = renderer->acquireRecorder();
+        renderer->beginStaticCapture(recorder);
+        visit(renderer, parentTransform, parentFlags);
+        renderer->endStaticCapture();
+
+        if (!_staticBatch->build(recorder->getCommands(), _modelViewTransform))
+        {
+            AXLOGD("Node: the subtree of {} can't be baked in a static batch", fmt::ptr(this));
+            renderer->submitRecording(recorder);
+            setDescendantsInStaticBatch(_inStaticBatch);
+            _staticBatchState = StaticBatchState::UNBAKEABLE;
+            return;
+        }
+
+        renderer->discardRecording(recorder);
+        setDescendantsInStaticBatch(true);
+        _staticBatchState = StaticBatchState::BAKED;
+    }
+
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+    if (isVisitableByVisitingCamera())
+        _staticBatch->draw(renderer, _modelViewTransform, flags);
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
-    return parentTransform * this->getNodeToParentTransform();
+    Mat4 ret;
+    TransformBatch::multiply(parentTransform, this->getNodeToParentTransform(), ret);
+    return ret;
 }
 
 // MARK: events
@@ -1336,8 +1721,8 @@ void Node::onEnter()
         ++__attachedNodeCount;
     }
 
-    if (_onEnterCallback)
-        _onEnterCallback();
+    if (_enterExitCallbacks && _enterExitCallbacks->onEnter)
+        _enterExitCallbacks->onEnter();
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
@@ -1346,8 +1731,12 @@ void Node::onEnter()
 
     _isTransitionFinished = false;
 
+    // the children of a scene may be entered before it, see Scene::prepareAsync
     for (const auto& child : _children)
-        child->onEnter();
+    {
+        if (!child->_running)
+            child->onEnter();
+    }
 
     this->resume();
 
@@ -1360,8 +1749,8 @@ void Node::onEnter()
 
 void Node::onEnterTransitionDidFinish()
 {
-    if (_onEnterTransitionDidFinishCallback)
-        _onEnterTransitionDidFinishCallback();
+    if (_enterExitCallbacks && _enterExitCallbacks->onEnterTransitionDidFinish)
+        _enterExitCallbacks->onEnterTransitionDidFinish();
 
     _isTransitionFinished = true;
     for (const auto& child : _children)
@@ -1374,8 +1763,8 @@ void Node::onEnterTransitionDidFinish()
 
 void Node::onExitTransitionDidStart()
 {
-    if (_onExitTransitionDidStartCallback)
-        _onExitTransitionDidStartCallback();
+    if (_enterExitCallbacks && _enterExitCallbacks->onExitTransitionDidStart)
+        _enterExitCallbacks->onExitTransitionDidStart();
 
     for (const auto& child : _children)
         child->onExitTransitionDidStart();
@@ -1392,8 +1781,8 @@ void Node::onExit()
         --__attachedNodeCount;
     }
 
-    if (_onExitCallback)
-        _onExitCallback();
+    if (_enterExitCallbacks && _enterExitCallbacks->onExit)
+        _enterExitCallbacks->onExit();
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
@@ -1533,6 +1922,16 @@ void Node::scheduleUpdateWithPriorityLua(int nHandler, int priority)
     _scheduler->scheduleUpdate(this, priority, !_running);
 }
 
+void Node::scheduleParallelUpdate()
+{
+    _scheduler->scheduleParallelUpdate(this, !_running);
+}
+
+void Node::unscheduleParallelUpdate()
+{
+    _scheduler->unscheduleParallel(this);
+}
+
 void Node::unscheduleUpdate()
 {
     _scheduler->unscheduleUpdate(this);
@@ -1645,6 +2044,14 @@ void Node::update(float fDelta)
     }
 }
 
+void Node::parallelUpdate(float fDelta)
+{
+    if (_componentContainer && !_componentContainer->isEmpty())
+    {
+        _componentContainer->visitParallel(fDelta);
+    }
+}
+
 // MARK: coordinates
 
 AffineTransform Node::getNodeToParentAffineTransform() const
@@ -1661,7 +2068,7 @@ Mat4 Node::getNodeToParentTransform(Node* ancestor) const
 
     for (Node* p = _parent; p != nullptr && p != ancestor; p = p->getParent())
     {
-        t = p->getNodeToParentTransform() * t;
+        TransformBatch::multiply(p->getNodeToParentTransform(), Mat4(t), t);
     }
 
     return t;
@@ -1694,10 +2101,6 @@ const Mat4& Node::getNodeToParentTransform() const
         bool needsSkewMatrix = (_skewX || _skewY);
 
         // Build Transform Matrix = translation * rotation * scale
-        Mat4 translation;
-        // move to anchor point first, then rotate
-        Mat4::createTranslation(x, y, z, &translation);
-
         Mat4::createRotation(_rotationQuat, &_transform);
 
         if (_rotationZ_X != _rotationZ_Y)
@@ -1721,7 +2124,11 @@ const Mat4& Node::getNodeToParentTransform() const
             _transform.m[5] = sy * m4 + cx * m5;
             _transform.m[9] = sy * m8 + cx * m9;
         }
-        _transform = translation * _transform;
+        // move to anchor point first, then rotate: the rotation has no translation, so the translation
+        // on the left only sets the last column
+        _transform.m[12] = x;
+        _transform.m[13] = y;
+        _transform.m[14] = z;
 
         if (_scaleX != 1.f)
         {
@@ -1742,29 +2149,20 @@ const Mat4& Node::getNodeToParentTransform() const
             _transform.m[10] *= _scaleZ;
         }
 
-        // FIXME:: Try to inline skew
         // If skew is needed, apply skew and then anchor point
         if (needsSkewMatrix)
         {
-            float skewMatArray[16] = {1,
-                                      (float)tanf(AX_DEGREES_TO_RADIANS(_skewY)),
-                                      0,
-                                      0,
-                                      (float)tanf(AX_DEGREES_TO_RADIANS(_skewX)),
-                                      1,
-                                      0,
-                                      0,
-                                      0,
-                                      0,
-                                      1,
-                                      0,
-                                      0,
-                                      0,
-                                      0,
-                                      1};
-            Mat4 skewMatrix(skewMatArray);
-
-            _transform = _transform * skewMatrix;
+            // _transform * skew, the skew matrix is the identity with tan(skewY) in m[1] and tan(skewX) in m[4]
+            float skewY = tanf(AX_DEGREES_TO_RADIANS(_skewY));
+            float skewX = tanf(AX_DEGREES_TO_RADIANS(_skewX));
+            float m0 = _transform.m[0], m1 = _transform.m[1], m2 = _transform.m[2];
+            float m4 = _transform.m[4], m5 = _transform.m[5], m6 = _transform.m[6];
+            _transform.m[0] = m0 + m4 * skewY;
+            _transform.m[1] = m1 + m5 * skewY;
+            _transform.m[2] = m2 + m6 * skewY;
+            _transform.m[4] = m0 * skewX + m4;
+            _transform.m[5] = m1 * skewX + m5;
+            _transform.m[6] = m2 * skewX + m6;
         }
 
         // adjust anchor point
@@ -1855,13 +2253,17 @@ AffineTransform Node::getParentToNodeAffineTransform() const
 
 const Mat4& Node::getParentToNodeTransform() const
 {
+    // allocated on first use, most nodes never convert a point to their own space
+    if (!_inverse)
+        _inverse = new Mat4();
+
     if (_inverseDirty)
     {
-        _inverse      = getNodeToParentTransform().getInversed();
+        TransformBatch::invert(getNodeToParentTransform(), *_inverse);
         _inverseDirty = false;
     }
 
-    return _inverse;
+    return *_inverse;
 }
 
 AffineTransform Node::getNodeToWorldAffineTransform() const
@@ -1881,7 +2283,9 @@ AffineTransform Node::getWorldToNodeAffineTransform() const
 
 Mat4 Node::getWorldToNodeTransform() const
 {
-    return getNodeToWorldTransform().getInversed();
+    Mat4 ret;
+    TransformBatch::invert(getNodeToWorldTransform(), ret);
+    return ret;
 }
 
 Vec2 Node::convertToNodeSpace(const Vec2& worldPoint) const
@@ -1973,6 +2377,8 @@ bool Node::addComponent(Component* component)
 
     // should enable schedule update, then all components can receive this call back
     scheduleUpdate();
+    if (component->isParallelUpdateEnabled())
+        scheduleParallelUpdate();
 
     const auto added = _componentContainer->add(component);
     if (added && _running)
@@ -2028,6 +2434,7 @@ void Node::updateDisplayedOpacity(uint8_t parentOpacity)
 {
     _displayedOpacity = _realOpacity * parentOpacity / 255.0;
     updateColor();
+    invalidateStaticBatch();
 
     if (_cascadeOpacityEnabled)
     {
@@ -2091,6 +2498,100 @@ bool Node::isOpacityModifyRGB() const
     return false;
 }
 
+Node::EnterExitCallbacks& Node::getEnterExitCallbacks()
+{
+    if (!_enterExitCallbacks)
+        _enterExitCallbacks = new EnterExitCallbacks();
+    return *_enterExitCallbacks;
+}
+
+void Node::setOnEnterCallback(const std::function<void()>& callback)
+{
+    if (callback || _enterExitCallbacks)
+        getEnterExitCallbacks().onEnter = callback;
+}
+
+const std::function<void()>& Node::getOnEnterCallback() const
+{
+    static const std::function<void()> none;
+    return _enterExitCallbacks ? _enterExitCallbacks->onEnter : none;
+}
+
+void Node::setOnExitCallback(const std::function<void()>& callback)
+{
+    if (callback || _enterExitCallbacks)
+        getEnterExitCallbacks().onExit = callback;
+}
+
+const std::function<void()>& Node::getOnExitCallback() const
+{
+    static const std::function<void()> none;
+    return _enterExitCallbacks ? _enterExitCallbacks->onExit : none;
+}
+
+void Node::setOnEnterTransitionDidFinishCallback(const std::function<void()>& callback)
+{
+    if (callback || _enterExitCallbacks)
+        getEnterExitCallbacks().onEnterTransitionDidFinish = callback;
+}
+
+const std::function<void()>& Node::getOnEnterTransitionDidFinishCallback() const
+{
+    static const std::function<void()> none;
+    return _enterExitCallbacks ? _enterExitCallbacks->onEnterTransitionDidFinish : none;
+}
+
+void Node::setOnExitTransitionDidStartCallback(const std::function<void()>& callback)
+{
+    if (callback || _enterExitCallbacks)
+        getEnterExitCallbacks().onExitTransitionDidStart = callback;
+}
+
+const std::function<void()>& Node::getOnExitTransitionDidStartCallback() const
+{
+    static const std::function<void()> none;
+    return _enterExitCallbacks ? _enterExitCallbacks->onExitTransitionDidStart : none;
+}
+
+Node::MemoryFootprint Node::getMemoryFootprint(bool recursive) const
+{
+    MemoryFootprint footprint;
+    addMemoryFootprint(footprint, recursive);
+    return footprint;
+}
+
+void Node::addMemoryFootprint(MemoryFootprint& footprint, bool recursive) const
+{
+    ++footprint.nodeCount;
+    footprint.nodeBytes += sizeof(Node);
+    footprint.childrenBytes += _children.capacity() * sizeof(Node*);
+
+    // a tree node per entry, with the links and the color of the red black tree
+    if (_childrenIndexer)
+        footprint.indexerBytes +=
+            sizeof(NodeIndexerMap_t) + _childrenIndexer->size() * (sizeof(NodeIndexerMap_t::value_type) + 32);
+
+    if (_componentContainer)
+        footprint.componentBytes +=
+            sizeof(ComponentContainer) + _componentContainer->_components.capacity() * sizeof(Component*);
+
+    // the names are interned, shared by the nodes of the same name, see InternedString::getMemoryUsage()
+    if (_inverse)
+        footprint.otherBytes += sizeof(Mat4);
+    if (_additionalTransform)
+        footprint.otherBytes += sizeof(Mat4) * 2;
+    if (_enterExitCallbacks)
+        footprint.otherBytes += sizeof(EnterExitCallbacks);
+    if (_spatialIndex)
+        footprint.otherBytes += _spatialIndex->getMemoryUsage();
+
+    if (recursive)
+    {
+        for (const auto& child : _children)
+            child->addMemoryFootprint(footprint, true);
+    }
+}
+
 const Color3B& Node::getColor() const
 {
     return _realColor;
@@ -2114,6 +2615,7 @@ void Node::updateDisplayedColor(const Color3B& parentColor)
     _displayedColor.g = _realColor.g * parentColor.g / 255.0;
     _displayedColor.b = _realColor.b * parentColor.b / 255.0;
     updateColor();
+    invalidateStaticBatch();
 
     if (_cascadeColorEnabled)
     {
@@ -2224,6 +2726,7 @@ void Node::applyMaskOnEnter(bool applyChildren)
 void Node::setCameraMask(unsigned short mask, bool applyChildren)
 {
     _cameraMask = mask;
+    invalidateSubtreeCameraMask();
     if (applyChildren)
     {
         for (const auto& child : _children)
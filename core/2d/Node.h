@@ -34,6 +34,7 @@
 #include <cstdint>
 #include "base/Macros.h"
 #include "base/Vector.h"
+#include "base/InternedString.h"
 #include "base/Protocols.h"
 #include "base/ScriptSupport.h"
 #include "math/AffineTransform.h"
@@ -59,6 +60,10 @@ class ComponentContainer;
 class EventDispatcher;
 class Scene;
 class Renderer;
+class SpatialGrid;
+class TransformBatch;
+class StaticBatch;
+class NodePoolBase;
 class Director;
 class Material;
 class Camera;
@@ -997,6 +1002,8 @@ public:
      * @since v3.2
      */
     virtual void setName(std::string_view name);
+    /** The interned name, equal names are the same InternedString. */
+    InternedString getInternedName() const { return _name; }
 
     /**
      * Returns a custom user data pointer.
@@ -1142,6 +1149,69 @@ public:
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit();
 
+    /**
+     * Sets whether this node is a parallel visit root.
+     * When `Renderer::setParallelVisitEnabled(true)` is used, the subtree of a parallel visit root is visited
+     * on a JobSystem worker while its parent continues visiting the siblings, the render commands are recorded
+     * and merged back in visiting order. Only parents using the default `Node::visit` dispatch parallel roots.
+     *
+     * The subtree must be safe to visit off the axmol thread: it must not use GroupCommand (ClippingNode,
+     * RenderTexture, NodeGrid, ui::Layout clipping), create backend resources in draw() or autorelease objects.
+     *
+     * @param parallelVisitRoot true if the subtree of this node can be visited on a JobSystem worker.
+     */
+    void setParallelVisitRoot(bool parallelVisitRoot);
+    bool isParallelVisitRoot() const { return _parallelVisitRoot; }
+
+    /**
+     * Compute the transforms of the dirty descendants level by level before visiting them, so the local
+     * transforms of plain nodes are computed several at a time with SIMD instead of one by one during the visit.
+     * Meant for deep or wide hierarchies of moving nodes, e.g. a skeleton of nodes or a layer of many particles
+     * made of sprites. The visit of a descendant still computes its transform when the node or an ancestor
+     * changes after the batch ran, e.g. in the draw of a sibling.
+     *
+     * @param transformBatchRoot Whether the transforms of the subtree are batched.
+     */
+    void setTransformBatchRoot(bool transformBatchRoot);
+    bool isTransformBatchRoot() const { return _transformBatch != nullptr; }
+    TransformBatch* getTransformBatch() const { return _transformBatch; }
+
+    /**
+     * Index the children in a uniform grid of their bounding boxes, so `visit` only walks the children
+     * intersecting the view of the default camera instead of all of them.
+     * Meant for nodes with many static or slow moving children, e.g. the decorations of a large scrolling map.
+     * A child is culled by its own bounding box, its descendants are culled with it.
+     *
+     * @param enabled Whether the children are indexed.
+     * @param cellSize The size of a grid cell in the space of this node.
+     */
+    void setSpatialIndexEnabled(bool enabled, float cellSize = 256.0f);
+    bool isSpatialIndexEnabled() const { return _spatialIndex != nullptr; }
+    SpatialGrid* getSpatialIndex() const { return _spatialIndex; }
+
+    /** The pool the node returns to when it's removed from its parent with cleanup, see NodePool. */
+    NodePoolBase* getNodePool() const { return _nodePool; }
+
+    /**
+     * Bake the triangles of the subtree into static GPU buffers on the next visit, later visits draw the
+     * baked buffers instead of visiting the subtree. Moving the node itself doesn't rebuild the batch.
+     * Meant for static content made of sprites, e.g. the background layers of a level.
+     *
+     * Transform, color, opacity, texture and children changes in the subtree rebuild the batch on the next
+     * visit, other changes to the content of a descendant must call `invalidateStaticBatch`. If the subtree
+     * draws something else than 2D triangles commands of one render queue and global Z order, it isn't
+     * baked and is visited as usual. The subtree must not use GroupCommand (ClippingNode, RenderTexture,
+     * NodeGrid, ui::Layout clipping), the descendants are drawn regardless of their camera mask and of
+     * the visible area.
+     *
+     * @param enabled Whether the subtree is baked.
+     */
+    void setStaticBatch(bool enabled);
+    bool isStaticBatch() const { return _staticBatch != nullptr; }
+
+    /** Rebuild on the next visit the static batch this node belongs to, see setStaticBatch. */
+    void invalidateStaticBatch();
+
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
      This function recursively calls parent->getScene() until parent is a Scene object. The results are not cached. It
@@ -1337,6 +1407,22 @@ public:
      */
     void unscheduleUpdate();
 
+    /**
+     * Schedules the "parallelUpdate" method.
+     *
+     * It is called every frame on a JobSystem worker, before the "update" methods of all the nodes.
+     * Only one "parallelUpdate" method could be scheduled per node.
+     * @see Scheduler::scheduleParallel
+     * @lua NA
+     */
+    void scheduleParallelUpdate();
+
+    /**
+     * Unschedules the "parallelUpdate" method.
+     * @lua NA
+     */
+    void unscheduleParallelUpdate();
+
     /**
      * Schedules a custom selector.
      *
@@ -1474,6 +1560,15 @@ public:
      */
     virtual void update(float delta);
 
+    /**
+     * Parallel update method, called on a JobSystem worker every frame if "scheduleParallelUpdate" is called, and the
+     * node is "live". It must not change the scene graph, Scheduler::runAfterParallelUpdates defers the changes to
+     * the axmol thread. The default one updates the parallel components.
+     * @param delta In seconds.
+     * @lua NA
+     */
+    virtual void parallelUpdate(float delta);
+
     /// @} end of Scheduler and Timer
 
     /// @{
@@ -1760,54 +1855,65 @@ public:
      * Set the callback of event onEnter.
      * @param callback A std::function<void()> callback.
      */
-    void setOnEnterCallback(const std::function<void()>& callback) { _onEnterCallback = callback; }
+    void setOnEnterCallback(const std::function<void()>& callback);
     /**
      * Get the callback of event onEnter.
      * @return A std:function<void()> callback.
      */
-    const std::function<void()>& getOnEnterCallback() const { return _onEnterCallback; }
+    const std::function<void()>& getOnEnterCallback() const;
     /**
      * Set the callback of event onExit.
      * @param callback A std::function<void()> callback.
      */
-    void setOnExitCallback(const std::function<void()>& callback) { _onExitCallback = callback; }
+    void setOnExitCallback(const std::function<void()>& callback);
     /**
      * Get the callback of event onExit.
      * @return A std::function<void()>.
      */
-    const std::function<void()>& getOnExitCallback() const { return _onExitCallback; }
+    const std::function<void()>& getOnExitCallback() const;
     /**
      * Set the callback of event EnterTransitionDidFinish.
      * @param callback A std::function<void()> callback.
      */
-    void setOnEnterTransitionDidFinishCallback(const std::function<void()>& callback)
-    {
-        _onEnterTransitionDidFinishCallback = callback;
-    }
+    void setOnEnterTransitionDidFinishCallback(const std::function<void()>& callback);
     /**
      * Get the callback of event EnterTransitionDidFinish.
      * @return std::function<void()>
      */
-    const std::function<void()>& getOnEnterTransitionDidFinishCallback() const
-    {
-        return _onEnterTransitionDidFinishCallback;
-    }
+    const std::function<void()>& getOnEnterTransitionDidFinishCallback() const;
     /**
      * Set the callback of event ExitTransitionDidStart.
      * @param callback A std::function<void()> callback.
      */
-    void setOnExitTransitionDidStartCallback(const std::function<void()>& callback)
-    {
-        _onExitTransitionDidStartCallback = callback;
-    }
+    void setOnExitTransitionDidStartCallback(const std::function<void()>& callback);
     /**
      * Get the callback of event ExitTransitionDidStart.
      * @return std::function<void()>
      */
-    const std::function<void()>& getOnExitTransitionDidStartCallback() const
+    const std::function<void()>& getOnExitTransitionDidStartCallback() const;
+
+    /** The memory held by the nodes of a subtree and their bookkeeping, see getMemoryFootprint. */
+    struct MemoryFootprint
     {
-        return _onExitTransitionDidStartCallback;
-    }
+        size_t nodeCount      = 0;
+        size_t nodeBytes      = 0;  ///< sizeof(Node) per node, the members of the subclasses aren't known
+        size_t childrenBytes  = 0;  ///< the capacity of the children arrays
+        size_t indexerBytes   = 0;  ///< the children indexers, estimated
+        size_t componentBytes = 0;  ///< the component containers, the components themselves aren't counted
+        size_t otherBytes     = 0;  ///< names, cached transforms, callbacks and spatial indices
+
+        size_t getTotal() const
+        {
+            return nodeBytes + childrenBytes + indexerBytes + componentBytes + otherBytes;
+        }
+    };
+
+    /**
+     * Sum the memory of the node and the heap blocks it allocates for its children, components, name and the
+     * other members allocated on first use, to find where large scenes spend their memory.
+     * @param recursive Whether the descendants are counted.
+     */
+    MemoryFootprint getMemoryFootprint(bool recursive = true) const;
 
     /**
      * get & set camera mask, the node is visible by the camera whose camera flag & node's camera mask is true
@@ -1829,6 +1935,13 @@ public:
      */
     void applyMaskOnEnter(bool applyChildren);
 
+    /**
+     * The camera masks of the node and all its descendants combined. A camera whose flag isn't in it has nothing to
+     * draw in the subtree, its visit skips the whole subtree, so a UI camera doesn't walk the 3D world and the other
+     * way around. It is updated lazily when a mask or the children change.
+     */
+    unsigned short getSubtreeCameraMask();
+
     virtual void setProgramState(uint32_t programType) { setProgramStateWithRegistry(programType, nullptr); }
     void setProgramStateWithRegistry(uint32_t programType, Texture2D* texture);
 
@@ -1879,13 +1992,39 @@ protected:
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
+    /// visit children with parallel visit roots dispatched to JobSystem workers
+    void visitChildrenParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera);
+    /// visit the children in the view of the default camera only, false if the view can't be mapped to this node
+    bool visitChildrenIndexed(Renderer* renderer, uint32_t flags, bool visibleByCamera);
+
+    /// the transform changed, the spatial index of the parent refreshes the node cells on its next visit
+    void setTransformDirty()
+    {
+        _transformUpdated = _transformDirty = _inverseDirty = true;
+        if (_parent && _parent->_spatialIndex)
+            markSpatialIndexDirty();
+        if (_inStaticBatch)
+            invalidateStaticBatch();
+    }
+    void markSpatialIndexDirty();
+
+    /// bake the subtree on first visit or draw the baked batch, see setStaticBatch
+    void visitStaticBatch(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
+    /// the subtree camera mask of this node and its ancestors is recomputed on next use
+    void invalidateSubtreeCameraMask();
+    /// the own mask and the subtree masks of the children, nodes drawing other children extend it
+    virtual unsigned short computeSubtreeCameraMask();
+    /// flag the descendants so their changes invalidate the batch of this node
+    void setDescendantsInStaticBatch(bool inStaticBatch);
+
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
     virtual void updateCascadeColor();
     virtual void disableCascadeColor();
     virtual void updateColor() {}
 
-    bool doEnumerate(std::string name, std::function<bool(Node*)> callback) const;
+    bool doEnumerate(std::string_view name, std::function<bool(Node*)> callback) const;
+    void addMemoryFootprint(MemoryFootprint& footprint, bool recursive) const;
     bool doEnumerateRecursive(const Node* node, std::string_view name, std::function<bool(Node*)> callback) const;
 
     // check whether this camera mask is visible by the current visiting camera
@@ -1934,7 +2073,7 @@ protected:
     Mat4 _modelViewTransform;  ///< ModelView transform of the Node.
     // "cache" variables are allowed to be mutable
     mutable Mat4 _transform;             ///< transform
-    mutable Mat4 _inverse;               ///< inverse transform
+    mutable Mat4* _inverse;              ///< inverse transform, allocated on first use
     mutable Mat4* _additionalTransform;  ///< two transforms needed by additional transforms
 
 #if AX_LITTLE_ENDIAN
@@ -1969,8 +2108,7 @@ protected:
     Director* _director;                 // cached director pointer to improve rendering performance
     int _tag;                            ///< a tag. Can be any number you assigned just to identify this node
 
-    std::string _name;     ///< a string label, an user defined string to identify this node
-    uint64_t _hashOfName;  ///< hash value of _name, used for speed in getChildByName
+    InternedString _name;  ///< a string label, an user defined string to identify this node
 
     void* _userData;   ///< A user assigned void pointer, Can be point to any cpp object
     Object* _userObject;  ///< A user assigned Object
@@ -2001,8 +2139,30 @@ protected:
     bool _normalizedPositionDirty;
 
     bool _childFollowCameraMask;
+
+    bool _parallelVisitRoot = false;  ///< whether the subtree can be visited on a JobSystem worker
+
+    TransformBatch* _transformBatch = nullptr;  ///< the descendant transforms, see setTransformBatchRoot
+    uint32_t _transformBatchFrame   = 0;        ///< the frame + 1 of the batch which computed the world transform
+    bool _transformBatchable        = true;     ///< false if a subclass relies on its getNodeToParentTransform
+
+    SpatialGrid* _spatialIndex = nullptr;  ///< the grid of the children, see setSpatialIndexEnabled
+    bool _spatialIndexDirty    = false;    ///< whether the node is queued for a refresh by the grid of its parent
+
+    enum class StaticBatchState : uint8_t
+    {
+        DIRTY,
+        BAKED,
+        UNBAKEABLE,  ///< visited as usual until invalidated
+    };
+    StaticBatch* _staticBatch = nullptr;  ///< the baked subtree, see setStaticBatch
+    StaticBatchState _staticBatchState = StaticBatchState::DIRTY;
+    bool _inStaticBatch = false;  ///< whether the node is a descendant of a baked static batch
+    NodePoolBase* _nodePool = nullptr;  ///< the pool recycling the node, see NodePool
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
+    unsigned short _subtreeCameraMask = 0;  ///< see getSubtreeCameraMask
+    bool _subtreeCameraMaskDirty      = true;
 
 #if AX_ENABLE_SCRIPT_BINDING
     int _scriptHandler;        ///< script handler for onEnter() & onExit(), used in Javascript binding and Lua binding.
@@ -2018,10 +2178,15 @@ protected:
     Color3B _realColor;
     uint8_t _realOpacity;
 
-    std::function<void()> _onEnterCallback;
-    std::function<void()> _onExitCallback;
-    std::function<void()> _onEnterTransitionDidFinishCallback;
-    std::function<void()> _onExitTransitionDidStartCallback;
+    struct EnterExitCallbacks
+    {
+        std::function<void()> onEnter;
+        std::function<void()> onExit;
+        std::function<void()> onEnterTransitionDidFinish;
+        std::function<void()> onExitTransitionDidStart;
+    };
+    EnterExitCallbacks* _enterExitCallbacks = nullptr;  ///< allocated on first use, few nodes have callbacks
+    EnterExitCallbacks& getEnterExitCallbacks();
 
     backend::ProgramState* _programState = nullptr;
 
@@ -2046,6 +2211,10 @@ public:
 
     static int __attachedNodeCount;
 
+    friend class SpatialGrid;
+    friend class TransformBatch;
+    friend class NodePoolBase;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Node);
 };
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/NodePool.h"
+
+namespace ax
+{
+
+NodePoolBase::NodePoolBase(size_t capacity) : _capacity(capacity) {}
+
+NodePoolBase::~NodePoolBase()
+{
+    clear();
+
+    // the nodes in use are destroyed as usual
+    for (auto&& node : _nodes)
+        node->_nodePool = nullptr;
+}
+
+void NodePoolBase::setCapacity(size_t capacity)
+{
+    _capacity = capacity;
+    while (_free.size() > _capacity)
+    {
+        auto node = _free.back();
+        _free.pop_back();
+        node->release();
+    }
+}
+
+void NodePoolBase::clear()
+{
+    auto free = std::move(_free);
+    _free.clear();
+    for (auto&& node : free)
+        node->release();
+}
+
+Node* NodePoolBase::popFree()
+{
+    if (_free.empty())
+        return nullptr;
+
+    // the reference of the pool becomes the autoreleased one of the caller
+    auto node = _free.back();
+    _free.pop_back();
+    node->autorelease();
+    return node;
+}
+
+void NodePoolBase::adopt(Node* node)
+{
+    AXASSERT(!node->_nodePool, "The node belongs to a pool already");
+    node->_nodePool = this;
+    _nodes.insert(node);
+}
+
+void NodePoolBase::pushFree(Node* node)
+{
+    node->retain();
+    _free.emplace_back(node);
+}
+
+bool NodePoolBase::reclaim(Node* node)
+{
+    // the parent removing the node holds the only reference
+    if (node->getReferenceCount() != 1 || _free.size() >= _capacity)
+        return false;
+
+    pushFree(node);
+    resetNode(node);
+    ++_recycledCount;
+    return true;
+}
+
+void NodePoolBase::forget(Node* node)
+{
+    _nodes.erase(node);
+}
+
+}  // namespace ax
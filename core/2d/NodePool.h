@@ -0,0 +1,178 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include "2d/Node.h"
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+namespace ax
+{
+
+/**
+ The type independent part of `NodePool`, it keeps the free nodes and is called back by the nodes it created.
+*/
+class AX_DLL NodePoolBase
+{
+public:
+    /**The default number of free nodes a pool keeps.*/
+    static const size_t DEFAULT_CAPACITY = 64;
+
+    explicit NodePoolBase(size_t capacity);
+    virtual ~NodePoolBase();
+
+    NodePoolBase(const NodePoolBase&)            = delete;
+    NodePoolBase& operator=(const NodePoolBase&) = delete;
+
+    /**The number of free nodes kept, the nodes removed when the pool is full are destroyed.*/
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return _capacity; }
+
+    /**The number of nodes waiting in the pool.*/
+    size_t getFreeCount() const { return _free.size(); }
+    /**The number of nodes created by the pool, free or in use.*/
+    size_t getNodeCount() const { return _nodes.size(); }
+    /**The number of nodes returned to the pool since it was created.*/
+    size_t getRecycledCount() const { return _recycledCount; }
+
+    /**Release the free nodes.*/
+    void clear();
+
+protected:
+    /**Pops a free node, autoreleased like a created one, or null.*/
+    Node* popFree();
+    /**Takes a node created for the pool, it returns to the pool when removed from its parent.*/
+    void adopt(Node* node);
+    /**Keeps a free node.*/
+    void pushFree(Node* node);
+
+    virtual void resetNode(Node* node) = 0;
+
+    /**Called when a node is removed from its parent with cleanup, returns whether the pool kept it.*/
+    bool reclaim(Node* node);
+    /**Called by the destructor of a node of the pool.*/
+    void forget(Node* node);
+
+    std::vector<Node*> _free;          // retained
+    std::unordered_set<Node*> _nodes;  // all the nodes of the pool
+    size_t _capacity      = 0;
+    size_t _recycledCount = 0;
+
+    friend class Node;
+};
+
+/**
+ Recycles the nodes of a type instead of destroying them, for the nodes which are spawned and removed all the time,
+ like bullets, enemies or popups.
+
+ A node obtained from the pool is used as a created one, it is autoreleased and added to a parent. When it is removed
+ from its parent with cleanup, e.g. by `removeFromParent`, and nothing else retains it, the autorelease pool of the
+ frame it was obtained in included, it goes back to the pool instead of being destroyed: its actions and scheduled
+ callbacks are gone as usual, then the reset callback puts it back to the state `obtain` should return it in, its
+ other properties keep their values. The pool and its nodes are used from the axmol thread only, the nodes still in
+ use when the pool is destroyed are destroyed as usual.
+
+ @code
+ NodePool<Sprite> bullets(128, [](Sprite* bullet) { bullet->setVisible(true); bullet->setOpacity(255); },
+                          [] { return Sprite::create("bullet.png"); });
+ auto bullet = bullets.obtain();
+ layer->addChild(bullet);
+ bullet->runAction(Sequence::create(MoveBy::create(1.0f, Vec2(0, 600)), RemoveSelf::create(), nullptr));
+ @endcode
+*/
+template <typename T>
+class NodePool : public NodePoolBase
+{
+public:
+    using ResetCallback  = std::function<void(T*)>;
+    using CreateCallback = std::function<T*()>;
+
+    /**
+     * @param capacity The number of free nodes kept.
+     * @param reset Called when a node returns to the pool.
+     * @param create Creates an autoreleased node when the pool is empty, T::create() when null.
+     */
+    explicit NodePool(size_t capacity = DEFAULT_CAPACITY, ResetCallback reset = nullptr, CreateCallback create = nullptr)
+        : NodePoolBase(capacity), _reset(std::move(reset)), _create(std::move(create))
+    {
+        static_assert(std::is_base_of_v<Node, T>, "NodePool only recycles Nodes");
+    }
+
+    /**Returns a free node or creates one, autoreleased.*/
+    T* obtain()
+    {
+        if (auto node = popFree())
+            return static_cast<T*>(node);
+        return createNode();
+    }
+
+    /**Creates free nodes up to count, to avoid creating them during the game.*/
+    void prewarm(size_t count)
+    {
+        while (_free.size() < (std::min)(count, _capacity))
+        {
+            auto node = createNode();
+            if (!node)
+                break;
+            pushFree(node);
+        }
+    }
+
+protected:
+    void resetNode(Node* node) override
+    {
+        if (_reset)
+            _reset(static_cast<T*>(node));
+    }
+
+    T* createNode()
+    {
+        T* node = nullptr;
+        if (_create)
+            node = _create();
+        else if constexpr (requires { T::create(); })
+            node = T::create();
+        AXASSERT(node, "NodePool: no node created, pass a create callback");
+        if (node)
+            adopt(node);
+        return node;
+    }
+
+    ResetCallback _reset;
+    CreateCallback _create;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -47,6 +47,11 @@ THE SOFTWARE.
 #include "2d/ParticleSystem.h"
 
 #include <string>
+#include <limits>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "2d/ParticleBatchNode.h"
 #include "renderer/TextureAtlas.h"
@@ -55,6 +60,7 @@ THE SOFTWARE.
 #include "base/Profiling.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
+#include "math/MathUtil.h"
 #include "renderer/TextureCache.h"
 #include "platform/FileUtils.h"
 
@@ -80,22 +86,124 @@ namespace ax
 //  cocos2d uses a another approach, but the results are almost identical.
 //
 
-inline void normalize_point(float x, float y, particle_point* out)
-{
-    float n = x * x + y * y;
-    // Already normalized.
-    if (n == 1.0f)
-        return;
-
-    n = sqrt(n);
-    // Too close to zero.
-    if (n < MATH_TOLERANCE)
-        return;
-
-    n      = 1.0f / n;
-    out->x = x * n;
-    out->y = y * n;
+namespace
+{
+// update kernels over the SoA particle data, 4 particles per iteration with SIMD
+
+// values[i] += delta
+void advance(float* values, float delta, int count)
+{
+    int i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    const __m128 d = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), d));
+#elif defined(AX_NEON_INTRINSICS)
+    const float32x4_t d = vdupq_n_f32(delta);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), d));
+#endif
+    for (; i < count; ++i)
+        values[i] += delta;
+}
+
+// values[i] = min(values[i] + delta, limits[i])
+void advanceClamped(float* values, const float* limits, float delta, int count)
+{
+    int i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    const __m128 d = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i, _mm_min_ps(_mm_add_ps(_mm_loadu_ps(values + i), d), _mm_loadu_ps(limits + i)));
+#elif defined(AX_NEON_INTRINSICS)
+    const float32x4_t d = vdupq_n_f32(delta);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(values + i, vminq_f32(vaddq_f32(vld1q_f32(values + i), d), vld1q_f32(limits + i)));
+#endif
+    for (; i < count; ++i)
+        values[i] = MIN(values[i] + delta, limits[i]);
+}
+
+// gravity mode: accelerate the direction by gravity and the radial and tangential accelerations, then move
+void updateGravity(ParticleData& p, const Vec2& gravity, float dt, float yFlip, int count)
+{
+    float* posx        = p.posx;
+    float* posy        = p.posy;
+    float* dirX        = p.modeA.dirX;
+    float* dirY        = p.modeA.dirY;
+    const float* ra    = p.modeA.radialAccel;
+    const float* ta    = p.modeA.tangentialAccel;
+    const float moveDt = dt * yFlip;
+
+    int i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    const __m128 gx = _mm_set1_ps(gravity.x), gy = _mm_set1_ps(gravity.y);
+    const __m128 vdt = _mm_set1_ps(dt), vmove = _mm_set1_ps(moveDt);
+    const __m128 one = _mm_set1_ps(1.0f), tolerance = _mm_set1_ps(MATH_TOLERANCE);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x   = _mm_loadu_ps(posx + i);
+        __m128 y   = _mm_loadu_ps(posy + i);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+        // the radial direction is 0 for particles at the origin
+        __m128 inv = _mm_and_ps(_mm_cmpge_ps(len, tolerance), _mm_div_ps(one, len));
+        __m128 rx  = _mm_mul_ps(x, inv);
+        __m128 ry  = _mm_mul_ps(y, inv);
+        __m128 r   = _mm_loadu_ps(ra + i);
+        __m128 t   = _mm_loadu_ps(ta + i);
+        __m128 ax  = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, r), _mm_mul_ps(ry, t)), gx);
+        __m128 ay  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ry, r), _mm_mul_ps(rx, t)), gy);
+        __m128 dx  = _mm_add_ps(_mm_loadu_ps(dirX + i), _mm_mul_ps(ax, vdt));
+        __m128 dy  = _mm_add_ps(_mm_loadu_ps(dirY + i), _mm_mul_ps(ay, vdt));
+        _mm_storeu_ps(dirX + i, dx);
+        _mm_storeu_ps(dirY + i, dy);
+        _mm_storeu_ps(posx + i, _mm_add_ps(x, _mm_mul_ps(dx, vmove)));
+        _mm_storeu_ps(posy + i, _mm_add_ps(y, _mm_mul_ps(dy, vmove)));
+    }
+#elif defined(AX_NEON_INTRINSICS)
+    const float32x4_t gx = vdupq_n_f32(gravity.x), gy = vdupq_n_f32(gravity.y);
+    const float32x4_t tolerance2 = vdupq_n_f32(MATH_TOLERANCE * MATH_TOLERANCE);
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x  = vld1q_f32(posx + i);
+        float32x4_t y  = vld1q_f32(posy + i);
+        float32x4_t n2 = vmlaq_f32(vmulq_f32(x, x), y, y);
+        // reciprocal square root estimate refined by two newton steps, 0 for particles at the origin
+        float32x4_t inv = vrsqrteq_f32(n2);
+        inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(n2, inv), inv));
+        inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(n2, inv), inv));
+        inv             = vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(n2, tolerance2), vreinterpretq_u32_f32(inv)));
+        float32x4_t rx = vmulq_f32(x, inv);
+        float32x4_t ry = vmulq_f32(y, inv);
+        float32x4_t r  = vld1q_f32(ra + i);
+        float32x4_t t  = vld1q_f32(ta + i);
+        float32x4_t ax = vaddq_f32(vmlsq_f32(vmulq_f32(rx, r), ry, t), gx);
+        float32x4_t ay = vaddq_f32(vmlaq_f32(vmulq_f32(ry, r), rx, t), gy);
+        float32x4_t dx = vmlaq_n_f32(vld1q_f32(dirX + i), ax, dt);
+        float32x4_t dy = vmlaq_n_f32(vld1q_f32(dirY + i), ay, dt);
+        vst1q_f32(dirX + i, dx);
+        vst1q_f32(dirY + i, dy);
+        vst1q_f32(posx + i, vmlaq_n_f32(x, dx, moveDt));
+        vst1q_f32(posy + i, vmlaq_n_f32(y, dy, moveDt));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float x   = posx[i];
+        float y   = posy[i];
+        float len = sqrtf(x * x + y * y);
+        float inv = len >= MATH_TOLERANCE ? 1.0f / len : 0.0f;
+        float rx  = x * inv;
+        float ry  = y * inv;
+        float ax  = rx * ra[i] - ry * ta[i] + gravity.x;
+        float ay  = ry * ra[i] + rx * ta[i] + gravity.y;
+        dirX[i] += ax * dt;
+        dirY[i] += ay * dt;
+        posx[i] = x + dirX[i] * moveDt;
+        posy[i] = y + dirY[i] * moveDt;
+    }
 }
+}  // namespace
 
 ParticleData::ParticleData()
 {
@@ -192,6 +300,10 @@ void ParticleData::release()
 
 Vector<ParticleSystem*> ParticleSystem::__allInstances;
 float ParticleSystem::__totalParticleCountFactor = 1.0f;
+bool ParticleSystem::__parallelUpdateEnabled     = false;
+Vector<ParticleSystem*> ParticleSystem::__deferredInstances;
+std::vector<float> ParticleSystem::__deferredDeltas;
+std::vector<uint8_t> ParticleSystem::__deferredAlive;
 
 ParticleSystem::ParticleSystem()
     : _isBlendAdditive(false)
@@ -1488,6 +1600,9 @@ void ParticleSystem::simulate(float seconds, float frameRate)
                               ? 1.0F / Director::getInstance()->getAnimationInterval()
                               : frameRate;
     auto delta          = 1.0F / frameRate;
+
+    // the simulated steps must be applied now, not deferred to the parallel update pass
+    _updatingImmediately = true;
     if (seconds > delta)
     {
         while (seconds > 0.0F)
@@ -1499,6 +1614,7 @@ void ParticleSystem::simulate(float seconds, float frameRate)
     }
     else
         this->update(seconds);
+    _updatingImmediately = false;
 }
 
 void ParticleSystem::resimulate(float seconds, float frameRate)
@@ -1555,13 +1671,43 @@ void ParticleSystem::update(float dt)
     if (!_visible)
         return;
 
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    AX_TRACE_SCOPE("ParticleSystem::update");
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
         _componentContainer->visit(dt);
     }
 
+    if (__parallelUpdateEnabled && !_updatingImmediately)
+    {
+        // merge the updates requested more than once in the frame, a system must be simulated by one worker
+        if (_deferredIndex >= 0)
+            __deferredDeltas[_deferredIndex] += dt;
+        else
+        {
+            _deferredIndex = static_cast<int>(__deferredInstances.size());
+            __deferredInstances.pushBack(this);
+            __deferredDeltas.emplace_back(dt);
+        }
+        return;
+    }
+
+    if (!updateParticles(dt))
+    {
+        this->unscheduleUpdate();
+        _parent->removeChild(this, true);
+        return;
+    }
+
+    // update and send gl buffer only when this node is visible.
+    if (_visible && !_batchNode)
+    {
+        postStep();
+    }
+}
+
+bool ParticleSystem::updateParticles(float dt)
+{
     if (_fixedFPS != 0)
     {
         _fixedFPSDelta += dt;
@@ -1569,8 +1715,7 @@ void ParticleSystem::update(float dt)
         {
             updateParticleQuads();
             _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
-            return;
+            return true;
         }
         dt             = _fixedFPSDelta;
         _fixedFPSDelta = 0.0F;
@@ -1579,30 +1724,7 @@ void ParticleSystem::update(float dt)
     float pureDt = dt;
     dt *= _timeScale;
 
-    if (_isActive && _emissionRate)
-    {
-        float rate         = 1.0f / _emissionRate;
-        int totalParticles = static_cast<int>(_totalParticles * __totalParticleCountFactor);
-
-        // issue #1201, prevent bursts of particles, due to too high emitCounter
-        if (_particleCount < totalParticles)
-        {
-            _emitCounter += dt;
-            _emitCounter = MAX(0.0F, _emitCounter);
-        }
-
-        int emitCount = MIN(totalParticles - _particleCount, _emitCounter / rate);
-        addParticles(emitCount);
-        _emitCounter -= rate * emitCount;
-
-        _elapsed += dt;
-        if (_elapsed < 0.f)
-            _elapsed = 0.f;
-        if (_duration != static_cast<float>(DURATION_INFINITY) && _duration < _elapsed)
-        {
-            this->stopSystem();
-        }
-    }
+    updateEmitter(dt);
 
     // The reason for using for-loops separately for every property is because
     // When the processor needs to read from or write to a location in memory,
@@ -1611,29 +1733,13 @@ void ParticleSystem::update(float dt)
     // for the purpose of improving cache hit rate, we should process only one property in one for-loop.
     // It was proved to be effective especially for low-end devices.
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
+        advance(_particleData.timeToLive, -dt, _particleCount);
 
         if (_isOpacityFadeInAllocated)
-        {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.opacityFadeInDelta[i] += dt;
-                _particleData.opacityFadeInDelta[i] =
-                    MIN(_particleData.opacityFadeInDelta[i], _particleData.opacityFadeInLength[i]);
-            }
-        }
+            advanceClamped(_particleData.opacityFadeInDelta, _particleData.opacityFadeInLength, dt, _particleCount);
 
         if (_isScaleInAllocated)
-        {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.scaleInDelta[i] += dt;
-                _particleData.scaleInDelta[i] = MIN(_particleData.scaleInDelta[i], _particleData.scaleInLength[i]);
-            }
-        }
+            advanceClamped(_particleData.scaleInDelta, _particleData.scaleInLength, dt, _particleCount);
 
         if (_isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
         {
@@ -1723,64 +1829,18 @@ void ParticleSystem::update(float dt)
                 }
                 --_particleCount;
                 if (_particleCount == 0 && _isAutoRemoveOnFinish)
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
+                    return false;
             }
         }
 
         if (_emitterMode == Mode::GRAVITY)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
-
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
-
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= -_particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
+            updateGravity(_particleData, modeA.gravity, dt, _yCoordFlipped, _particleCount);
         }
         else
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
-            }
-
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
+            MathUtil::addScaled(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, dt, _particleCount);
+            MathUtil::addScaled(_particleData.modeB.radius, _particleData.modeB.deltaRadius, dt, _particleCount);
 
             for (int i = 0; i < _particleCount; ++i)
             {
@@ -1794,48 +1854,136 @@ void ParticleSystem::update(float dt)
         }
 
         // color r,g,b,a
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
-        }
+        MathUtil::addScaled(_particleData.colorR, _particleData.deltaColorR, dt, _particleCount);
+        MathUtil::addScaled(_particleData.colorG, _particleData.deltaColorG, dt, _particleCount);
+        MathUtil::addScaled(_particleData.colorB, _particleData.deltaColorB, dt, _particleCount);
+        MathUtil::addScaled(_particleData.colorA, _particleData.deltaColorA, dt, _particleCount);
         // size
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
-        }
+        MathUtil::addScaled(_particleData.size, _particleData.deltaSize, dt, _particleCount);
+        MathUtil::clamp(_particleData.size, _particleCount, 0.0f, (std::numeric_limits<float>::max)());
         // angle
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
-        }
+        MathUtil::addScaled(_particleData.rotation, _particleData.deltaRotation, dt, _particleCount);
 
         updateParticleQuads();
         _transformSystemDirty = false;
     }
 
-    // update and send gl buffer only when this node is visible.
-    if (_visible && !_batchNode)
+    return true;
+}
+
+void ParticleSystem::setParallelUpdateEnabled(bool enabled)
+{
+    if (__parallelUpdateEnabled == enabled)
+        return;
+
+    auto scheduler = Director::getInstance()->getScheduler();
+    if (enabled)
     {
-        postStep();
+        // timers run after the scheduled updates, so the pass collects the updates of the whole frame
+        scheduler->schedule(&ParticleSystem::updateDeferredSystems, &__deferredInstances, 0, false,
+                            "ParticleSystem::updateDeferredSystems");
+    }
+    else
+    {
+        updateDeferredSystems(0);
+        scheduler->unschedule("ParticleSystem::updateDeferredSystems", &__deferredInstances);
+    }
+    __parallelUpdateEnabled = enabled;
+}
+
+void ParticleSystem::updateDeferredSystems(float /*dt*/)
+{
+    if (__deferredInstances.empty())
+        return;
+
+    AX_TRACE_SCOPE("ParticleSystem::updateDeferredSystems");
+
+    // the transforms are cached lazily by the scene graph, compute the ones read by the free emitters before the
+    // workers read them concurrently
+    for (auto system : __deferredInstances)
+    {
+        if (system->_positionType == PositionType::FREE)
+            system->getNodeToWorldTransform();
     }
 
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    const size_t count = __deferredInstances.size();
+    __deferredAlive.assign(count, 1);
+
+    // the systems are independent, systems of a batch node write disjoint ranges of its atlas
+    std::atomic<size_t> next{0};
+    auto simulate = [count, &next] {
+        for (size_t i; (i = next.fetch_add(1)) < count;)
+            __deferredAlive[i] = __deferredInstances.at(i)->updateParticles(__deferredDeltas[i]);
+    };
+
+    auto jobSystem     = Director::getInstance()->getJobSystem();
+    const size_t jobs  = jobSystem ? (std::min)(static_cast<size_t>(std::thread::hardware_concurrency()), count) : 1;
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t pending = jobs > 1 ? jobs - 1 : 0;
+    for (size_t job = 1; job < jobs; ++job)
+    {
+        jobSystem->enqueue([&] {
+            simulate();
+
+            std::lock_guard<std::mutex> lck(mutex);
+            if (--pending == 0)
+                cond.notify_all();
+        });
+    }
+
+    // the axmol thread simulates meanwhile
+    simulate();
+    {
+        std::unique_lock<std::mutex> lck(mutex);
+        cond.wait(lck, [&pending] { return pending == 0; });
+    }
+
+    // finish the systems in submission order, the scene graph is only modified on the axmol thread
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto system            = __deferredInstances.at(i);
+        system->_deferredIndex = -1;
+        if (!__deferredAlive[i])
+        {
+            system->unscheduleUpdate();
+            if (system->_parent)
+                system->_parent->removeChild(system, true);
+        }
+        else if (system->_visible && !system->_batchNode)
+            system->postStep();
+    }
+
+    __deferredInstances.clear();
+    __deferredDeltas.clear();
+}
+
+void ParticleSystem::updateEmitter(float dt)
+{
+    if (_isActive && _emissionRate)
+    {
+        float rate         = 1.0f / _emissionRate;
+        int totalParticles = static_cast<int>(_totalParticles * __totalParticleCountFactor);
+
+        // issue #1201, prevent bursts of particles, due to too high emitCounter
+        if (_particleCount < totalParticles)
+        {
+            _emitCounter += dt;
+            _emitCounter = MAX(0.0F, _emitCounter);
+        }
+
+        int emitCount = MIN(totalParticles - _particleCount, _emitCounter / rate);
+        addParticles(emitCount);
+        _emitCounter -= rate * emitCount;
+
+        _elapsed += dt;
+        if (_elapsed < 0.f)
+            _elapsed = 0.f;
+        if (_duration != static_cast<float>(DURATION_INFINITY) && _duration < _elapsed)
+        {
+            this->stopSystem();
+        }
+    }
 }
 
 void ParticleSystem::updateWithNoTime()
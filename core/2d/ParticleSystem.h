@@ -434,6 +434,17 @@ public:
      */
     static Vector<ParticleSystem*>& getAllParticleSystems();
 
+    /** Sets whether the particle systems are simulated in parallel.
+     When enabled, the scheduled updates of the particle systems are collected and simulated at once by a pass running
+     after the other scheduled updates of the frame: the systems are independent, so they are distributed over the
+     JobSystem workers and the axmol thread only submits them, then removes the finished ones and calls postStep in
+     order. The systems of a ParticleBatchNode write disjoint ranges of its atlas, so they need no locking.
+     The subclasses overriding the simulation stages, e.g. updateParticleQuads, must not touch shared state.
+     `simulate` still updates immediately.
+     */
+    static void setParallelUpdateEnabled(bool enabled);
+    static bool isParallelUpdateEnabled() { return __parallelUpdateEnabled; }
+
 protected:
     bool allocAnimationMem();
     void deallocAnimationMem();
@@ -457,7 +468,7 @@ public:
     void stopSystem();
     /** Kill all living particles.
      */
-    void resetSystem();
+    virtual void resetSystem();
     /** Whether or not the system is full.
      *
      * @return True if the system is full.
@@ -1459,9 +1470,21 @@ public:
 protected:
     virtual void updateBlendFunc();
 
+    /** Emit the particles due after dt, dt is already scaled by the time scale, and stop the system once its
+     duration elapsed. */
+    void updateEmitter(float dt);
+
+    /** Simulate the particles and update their quads, it's invoked on a JobSystem worker by the parallel update pass.
+     @return false if the system finished and must be removed from its parent, see setAutoRemoveOnFinish.
+     */
+    bool updateParticles(float dt);
+
+    /** The parallel update pass, it simulates the systems whose update was deferred in the frame. */
+    static void updateDeferredSystems(float dt);
+
 private:
-    friend class EngineDataManager;
-    /** Internal use only, it's used by EngineDataManager class for Android platform */
+    friend class PerformanceGovernor;
+    /** Internal use only, the PerformanceGovernor scales the particle budget with it */
     static void setTotalParticleCountFactor(float factor);
 
 protected:
@@ -1684,6 +1707,14 @@ protected:
 
     FastRNG _rng;
 
+    static bool __parallelUpdateEnabled;
+    static Vector<ParticleSystem*> __deferredInstances;
+    static std::vector<float> __deferredDeltas;
+    static std::vector<uint8_t> __deferredAlive;
+    /** The index of the system in the deferred systems of the frame, -1 if its update isn't deferred */
+    int _deferredIndex        = -1;
+    bool _updatingImmediately = false;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ParticleSystem);
 };
@@ -44,11 +44,17 @@ THE SOFTWARE.
 #include "base/UTF8.h"
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/Buffer.h"
 #include "2d/TweenFunction.h"
+#include "math/MathUtil.h"
 
 namespace ax
 {
 
+// the GPU simulation clock restarts once all particles are dead past this time, to keep its precision
+static const float GPU_SIMULATION_TIME_REBASE = 3600.0f;
+
 ParticleSystemQuad::ParticleSystemQuad()
 {
     auto& pipelinePS = _quadCommand.getPipelineDescriptor().programState;
@@ -70,6 +76,8 @@ ParticleSystemQuad::~ParticleSystemQuad()
     }
 
     AX_SAFE_RELEASE_NULL(_quadCommand.getPipelineDescriptor().programState);
+    AX_SAFE_RELEASE(_gpuInstanceBuffer);
+    AX_SAFE_RELEASE(_gpuProgramState);
 }
 
 // implementation ParticleSystemQuad
@@ -341,10 +349,15 @@ void ParticleSystemQuad::updateParticleQuads()
         Vec3 p1(currentPosition.x, currentPosition.y, 0);
         Mat4 worldToNodeTM = getWorldToNodeTransform();
         worldToNodeTM.transformPoint(&p1);
-        Vec3 p2;
+
+        // transform the start positions all at once
+        _nodeStartPos.resize(_particleCount * 2);
+        float* startX = _nodeStartPos.data();
+        float* startY = startX + _particleCount;
+        MathUtil::transformVec2(worldToNodeTM, _particleData.startPosX, _particleData.startPosY, startX, startY,
+                                _particleCount);
+
         Vec2 newPos;
-        float* startX               = _particleData.startPosX;
-        float* startY               = _particleData.startPosY;
         float* x                    = _particleData.posx;
         float* y                    = _particleData.posy;
         float* s                    = _particleData.size;
@@ -358,12 +371,9 @@ void ParticleSystemQuad::updateParticleQuads()
             for (int i = 0; i < _particleCount;
                  ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr, ++sid, ++sil)
             {
-                p2.set(*startX, *startY, 0);
-                worldToNodeTM.transformPoint(&p2);
                 newPos.set(*x, *y);
-                p2 = p1 - p2;
-                newPos.x -= p2.x - pos.x;
-                newPos.y -= p2.y - pos.y;
+                newPos.x -= p1.x - *startX - pos.x;
+                newPos.y -= p1.y - *startY - pos.y;
                 updatePosWithParticle(quadStart, newPos, *s, tweenfunc::expoEaseOut(*sid / *sil), *r, *sr);
             }
         }
@@ -371,12 +381,9 @@ void ParticleSystemQuad::updateParticleQuads()
         {
             for (int i = 0; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr)
             {
-                p2.set(*startX, *startY, 0);
-                worldToNodeTM.transformPoint(&p2);
                 newPos.set(*x, *y);
-                p2 = p1 - p2;
-                newPos.x -= p2.x - pos.x;
-                newPos.y -= p2.y - pos.y;
+                newPos.x -= p1.x - *startX - pos.x;
+                newPos.y -= p1.y - *startY - pos.y;
                 updatePosWithParticle(quadStart, newPos, *s, 1.0F, *r, *sr);
             }
         }
@@ -671,6 +678,12 @@ void ParticleSystemQuad::updateParticleQuads()
 // overriding draw method
 void ParticleSystemQuad::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    if (_gpuSimulating)
+    {
+        drawGPUSimulation(renderer, transform);
+        return;
+    }
+
     // quad command
     if (_particleCount > 0)
     {
@@ -773,6 +786,239 @@ void ParticleSystemQuad::listenRendererRecreated(EventCustom* /*event*/)
     //    }
 }
 
+bool ParticleSystemQuad::canSimulateOnGPU() const
+{
+    if (_batchNode || _isOpacityFadeInAllocated || _isScaleInAllocated || _isHSVAllocated || _isAnimAllocated ||
+        _isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
+        return false;
+
+    // the radial and tangential accelerations depend on the position, the motion has no closed form
+    return _emitterMode == Mode::RADIUS || (modeA.radialAccel == 0 && modeA.radialAccelVar == 0 &&
+                                            modeA.tangentialAccel == 0 && modeA.tangentialAccelVar == 0);
+}
+
+void ParticleSystemQuad::update(float dt)
+{
+    bool gpu = _gpuSimulationEnabled && canSimulateOnGPU();
+    if (gpu != _gpuSimulating)
+    {
+        // the live particles of one mode can't be carried over to the other one
+        _particleCount = 0;
+        _gpuSimulating = gpu;
+        if (gpu)
+            resetGPUSimulation();
+    }
+
+    if (!_gpuSimulating)
+    {
+        ParticleSystem::update(dt);
+        return;
+    }
+
+    if (!_visible)
+        return;
+
+    AX_TRACE_SCOPE("ParticleSystemQuad::update");
+
+    if (_componentContainer && !_componentContainer->isEmpty())
+    {
+        _componentContainer->visit(dt);
+    }
+
+    updateGPUSimulation(dt * _timeScale);
+}
+
+void ParticleSystemQuad::resetSystem()
+{
+    ParticleSystem::resetSystem();
+    if (_gpuSimulating)
+        resetGPUSimulation();
+}
+
+void ParticleSystemQuad::updateGPUSimulation(float dt)
+{
+    float now = _gpuTime + dt;
+
+    // recycle the slots of the dead particles in emission order, a slot behind a longer living particle waits
+    const int capacity = static_cast<int>(_gpuDeathTimes.size());
+    bool died          = false;
+    while (_particleCount > 0 && _gpuDeathTimes[_gpuFirst] <= now)
+    {
+        _gpuFirst = (_gpuFirst + 1) % capacity;
+        --_particleCount;
+        died = true;
+    }
+
+    if (_particleCount == 0)
+    {
+        if (died && _isAutoRemoveOnFinish)
+        {
+            this->unscheduleUpdate();
+            _parent->removeChild(this, true);
+            return;
+        }
+        if (now > GPU_SIMULATION_TIME_REBASE)
+        {
+            resetGPUSimulation();
+            now = dt;
+        }
+    }
+
+    // the particles are emitted at the start of the step, like the CPU simulation they are dt old once drawn
+    int first = _particleCount;
+    updateEmitter(dt);
+    if (_particleCount > first)
+        uploadGPUParticles(first);
+
+    _gpuTime = now;
+}
+
+void ParticleSystemQuad::uploadGPUParticles(int first)
+{
+    auto packColors = [](float a, float b) {
+        return std::floor(a * 255.0f + 0.5f) * 256.0f + std::floor(b * 255.0f + 0.5f);
+    };
+
+    const int capacity = static_cast<int>(_gpuParticles.size());
+    const bool radius  = _emitterMode == Mode::RADIUS;
+    for (int i = first; i < _particleCount; ++i)
+    {
+        int slot = (_gpuFirst + i) % capacity;
+        auto& p  = _gpuParticles[slot];
+
+        float life  = _particleData.timeToLive[i];
+        p.spawnTime = _gpuTime;
+        p.life      = life;
+        p.startPos.set(_particleData.startPosX[i], _particleData.startPosY[i]);
+        if (radius)
+        {
+            p.motion[0] = _particleData.modeB.angle[i];
+            p.motion[1] = _particleData.modeB.degreesPerSecond[i];
+            p.motion[2] = _particleData.modeB.radius[i];
+            p.motion[3] = _particleData.modeB.deltaRadius[i];
+        }
+        else
+        {
+            p.motion[0] = _particleData.posx[i];
+            p.motion[1] = _particleData.posy[i];
+            p.motion[2] = _particleData.modeA.dirX[i];
+            p.motion[3] = _particleData.modeA.dirY[i];
+        }
+        p.size          = _particleData.size[i];
+        p.deltaSize     = _particleData.deltaSize[i];
+        p.rotation      = _particleData.rotation[i] + _particleData.staticRotation[i];
+        p.deltaRotation = _particleData.deltaRotation[i];
+
+        // the deltas are per second, the shader interpolates to the end color over the life
+        float r = _particleData.colorR[i], g = _particleData.colorG[i];
+        float b = _particleData.colorB[i], a = _particleData.colorA[i];
+        p.colors[0] = packColors(r, g);
+        p.colors[1] = packColors(b, a);
+        if (life > 0)
+        {
+            r = clampf(r + _particleData.deltaColorR[i] * life, 0, 1);
+            g = clampf(g + _particleData.deltaColorG[i] * life, 0, 1);
+            b = clampf(b + _particleData.deltaColorB[i] * life, 0, 1);
+            a = clampf(a + _particleData.deltaColorA[i] * life, 0, 1);
+        }
+        p.colors[2] = packColors(r, g);
+        p.colors[3] = packColors(b, a);
+
+        _gpuDeathTimes[slot] = _gpuTime + life;
+    }
+
+    // the new slots are contiguous in the ring, they wrap at most once
+    int start = (_gpuFirst + first) % capacity;
+    int count = _particleCount - first;
+    int run   = (std::min)(count, capacity - start);
+    _gpuInstanceBuffer->updateSubData(&_gpuParticles[start], start * sizeof(GPUParticle), run * sizeof(GPUParticle));
+    if (run < count)
+        _gpuInstanceBuffer->updateSubData(_gpuParticles.data(), 0, (count - run) * sizeof(GPUParticle));
+}
+
+void ParticleSystemQuad::resetGPUSimulation()
+{
+    if (!_gpuProgramState)
+    {
+        // the unit quad, with the vertex order and indices of a particle quad
+        static const Vec2 vertices[]    = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+        static const uint16_t indices[] = {0, 1, 2, 3, 2, 1};
+
+        _gpuCommand.createVertexBuffer(sizeof(Vec2), 4, CustomCommand::BufferUsage::STATIC);
+        _gpuCommand.updateVertexBuffer(vertices, sizeof(vertices));
+        _gpuCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, 6, CustomCommand::BufferUsage::STATIC);
+        _gpuCommand.updateIndexBuffer(indices, sizeof(indices));
+        _gpuCommand.setIndexDrawInfo(0, 6);
+        _gpuCommand.setDrawType(CustomCommand::DrawType::ELEMENT_INSTANCE);
+
+        auto program            = backend::Program::getBuiltinProgram(backend::ProgramType::PARTICLE_GPU);
+        _gpuProgramState        = new backend::ProgramState(program);
+        _gpuMVPMatrixLocation   = _gpuProgramState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+        _gpuStartMatrixLocation = _gpuProgramState->getUniformLocation("u_startMatrix");
+        _gpuSimulationLocation  = _gpuProgramState->getUniformLocation("u_simulation");
+        _gpuGravityLocation     = _gpuProgramState->getUniformLocation("u_gravity");
+        _gpuTexRectLocation     = _gpuProgramState->getUniformLocation("u_texRect");
+        _gpuCommand.getPipelineDescriptor().programState = _gpuProgramState;
+    }
+
+    // a zero life: every slot is dead
+    size_t capacity = static_cast<size_t>((std::max)(_totalParticles, 1));
+    _gpuParticles.assign(capacity, GPUParticle{});
+    _gpuDeathTimes.assign(capacity, 0.0f);
+    _particleCount = 0;
+    _gpuFirst      = 0;
+    _gpuTime       = 0;
+
+    size_t size = capacity * sizeof(GPUParticle);
+    if (!_gpuInstanceBuffer || _gpuInstanceBuffer->getSize() != size)
+    {
+        // the ring is partially updated every frame, the dynamic buffers of some backends are copies per frame in
+        // flight. Writing a slot still drawn by a frame in flight is benign, the new particle isn't spawned yet at
+        // the time of that frame.
+        AX_SAFE_RELEASE(_gpuInstanceBuffer);
+        _gpuInstanceBuffer = backend::DriverBase::getInstance()->newBuffer(size, backend::BufferType::VERTEX,
+                                                                           backend::BufferUsage::STATIC);
+    }
+    _gpuInstanceBuffer->updateData(_gpuParticles.data(), size);
+}
+
+void ParticleSystemQuad::drawGPUSimulation(Renderer* renderer, const Mat4& transform)
+{
+    if (_particleCount <= 0 || !_texture)
+        return;
+
+    _gpuCommand.init(_globalZOrder, _blendFunc);
+
+    const auto& projection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    Mat4 mvp               = projection * transform;
+
+    // see updateParticleQuads, the particles follow the emitter unless it's free or relative to the parent
+    Mat4 startMatrix;
+    if (_positionType == PositionType::FREE)
+        startMatrix = getWorldToNodeTransform();
+    else if (_positionType == PositionType::RELATIVE)
+        Mat4::createTranslation(-_position.x, -_position.y, 0, &startMatrix);
+
+    Vec4 simulation(_gpuTime, _emitterMode == Mode::RADIUS ? 1.0f : 0.0f, static_cast<float>(_yCoordFlipped),
+                    _opacityModifyRGB ? 1.0f : 0.0f);
+    Vec4 gravity(modeA.gravity.x, modeA.gravity.y, 0, 0);
+
+    const auto& bl = _quads[0].bl.texCoords;
+    const auto& tr = _quads[0].tr.texCoords;
+    Vec4 texRect(bl.u, bl.v, tr.u - bl.u, tr.v - bl.v);
+
+    _gpuProgramState->setUniform(_gpuMVPMatrixLocation, mvp.m, sizeof(mvp.m));
+    _gpuProgramState->setUniform(_gpuStartMatrixLocation, startMatrix.m, sizeof(startMatrix.m));
+    _gpuProgramState->setUniform(_gpuSimulationLocation, &simulation, sizeof(simulation));
+    _gpuProgramState->setUniform(_gpuGravityLocation, &gravity, sizeof(gravity));
+    _gpuProgramState->setUniform(_gpuTexRectLocation, &texRect, sizeof(texRect));
+    _gpuProgramState->setTexture(_texture->getBackendTexture());
+
+    // every slot is drawn, the vertex shader discards the ones which aren't alive
+    _gpuCommand.setInstanceBuffer(_gpuInstanceBuffer, static_cast<int>(_gpuParticles.size()));
+    renderer->addCommand(&_gpuCommand);
+}
+
 bool ParticleSystemQuad::allocMemory()
 {
     AXASSERT(!_batchNode, "Memory should not be alloced when not using batchNode");
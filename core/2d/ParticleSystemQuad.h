@@ -31,6 +31,7 @@ THE SOFTWARE.
 
 #include "2d/ParticleSystem.h"
 #include "renderer/QuadCommand.h"
+#include "renderer/CustomCommand.h"
 
 namespace ax
 {
@@ -111,6 +112,20 @@ public:
      */
     void listenRendererRecreated(EventCustom* event);
 
+    /** Sets whether the particles are simulated on the GPU.
+     The CPU only spawns the particles: the state of every new particle is uploaded once into an instance buffer
+     and the vertex shader evaluates its position, size, rotation and color in closed form from its age, so the
+     frame cost no longer depends on the number of live particles.
+     The closed form covers the radius mode and the gravity mode without radial and tangential acceleration, the
+     systems using those, fade in, scale in, HSV, texture animations or a batch node keep being simulated on the
+     CPU, see canSimulateOnGPU. The fixed FPS is ignored, the live particles are killed when the mode changes.
+     */
+    void setGPUSimulationEnabled(bool enabled) { _gpuSimulationEnabled = enabled; }
+    bool isGPUSimulationEnabled() const { return _gpuSimulationEnabled; }
+
+    /** Whether the current settings of the system can be simulated on the GPU. */
+    bool canSimulateOnGPU() const;
+
     /**
      * @js NA
      * @lua NA
@@ -138,6 +153,9 @@ public:
      */
     virtual void setTotalParticles(int tp) override;
 
+    virtual void update(float dt) override;
+    virtual void resetSystem() override;
+
     virtual std::string getDescription() const override;
 
     /**
@@ -169,14 +187,55 @@ protected:
 
     bool allocMemory();
 
+    /** The state of a particle simulated on the GPU at spawn time, it matches the layout of the mat4 instance
+     attribute of the particleGPU shader. */
+    struct GPUParticle
+    {
+        float spawnTime;
+        float life;
+        Vec2 startPos;       ///< the emitter position, mapped by the start matrix
+        float motion[4];     ///< gravity mode: position and velocity, radius mode: angle, speed, radius, speed
+        float size;
+        float deltaSize;
+        float rotation;      ///< includes the static rotation, in degrees
+        float deltaRotation;
+        float colors[4];     ///< the start and end colors, two 8 bit channels per float
+    };
+    static_assert(sizeof(GPUParticle) == sizeof(float) * 16, "GPUParticle must be a mat4");
+
+    void updateGPUSimulation(float dt);
+    void drawGPUSimulation(Renderer* renderer, const Mat4& transform);
+    /** Write the particles emitted at [first, _particleCount) in the scratch particle data to the ring. */
+    void uploadGPUParticles(int first);
+    void resetGPUSimulation();
+
     V3F_C4B_T2F_Quad* _quads = nullptr;  // quads to be rendered
     unsigned short* _indices = nullptr;  // indices
+    std::vector<float> _nodeStartPos;     // the start positions in the space of the node, see updateParticleQuads
 
     QuadCommand _quadCommand;  // quad command
 
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
 
+    bool _gpuSimulationEnabled = false;
+    bool _gpuSimulating        = false;  // the mode used for the live particles
+
+    // live GPU particles are the _particleCount slots from _gpuFirst, slots are recycled in emission order
+    std::vector<GPUParticle> _gpuParticles;
+    std::vector<float> _gpuDeathTimes;
+    int _gpuFirst  = 0;
+    float _gpuTime = 0;
+
+    CustomCommand _gpuCommand;
+    backend::Buffer* _gpuInstanceBuffer     = nullptr;
+    backend::ProgramState* _gpuProgramState = nullptr;
+    backend::UniformLocation _gpuMVPMatrixLocation;
+    backend::UniformLocation _gpuStartMatrixLocation;
+    backend::UniformLocation _gpuSimulationLocation;
+    backend::UniformLocation _gpuGravityLocation;
+    backend::UniformLocation _gpuTexRectLocation;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ParticleSystemQuad);
 };
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "base/Director.h"
 #include "2d/Sprite.h"
 #include "renderer/Renderer.h"
+#include "renderer/InstancedProgressCommand.h"
 #include "base/Utils.h"
 #include "renderer/Shaders.h"
 #include "renderer/backend/ProgramState.h"
@@ -256,11 +257,7 @@ void ProgressTimer::updateColor()
 
     if (!_vertexData.empty())
     {
-        auto sc = _sprite->getQuad().tl.colors;
-        sc.r = sc.r * _sprite->getOpacity() / 255.0f;
-        sc.g = sc.g * _sprite->getOpacity() / 255.0f;
-        sc.b = sc.b * _sprite->getOpacity() / 255.0f;
-        sc.a = sc.a * _sprite->getOpacity() / 255.0f;
+        auto sc = getProgressColor();
         for (auto& d : _vertexData)
         {
             d.colors = sc;
@@ -268,8 +265,40 @@ void ProgressTimer::updateColor()
     }
 }
 
+Color4B ProgressTimer::getProgressColor() const
+{
+    auto sc = _sprite->getQuad().tl.colors;
+    sc.r = sc.r * _sprite->getOpacity() / 255.0f;
+    sc.g = sc.g * _sprite->getOpacity() / 255.0f;
+    sc.b = sc.b * _sprite->getOpacity() / 255.0f;
+    sc.a = sc.a * _sprite->getOpacity() / 255.0f;
+    return sc;
+}
+
+void ProgressTimer::setShaderProgressEnabled(bool enabled)
+{
+    if (_shaderProgressEnabled != enabled)
+    {
+        _shaderProgressEnabled = enabled;
+        if (!enabled && _vertexDataDirty)
+            updateProgress();
+    }
+}
+
 void ProgressTimer::updateProgress()
 {
+    // the shaders compute the progress when drawing, the vertices are built later if they are needed
+    if (_shaderProgressEnabled)
+    {
+        _vertexDataDirty = true;
+        return;
+    }
+    updateVertexData();
+}
+
+void ProgressTimer::updateVertexData()
+{
+    _vertexDataDirty = false;
     switch (_type)
     {
     case Type::RADIAL:
@@ -629,10 +658,36 @@ Vec2 ProgressTimer::boundaryTexCoord(char index)
 
 void ProgressTimer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    if (_vertexData.empty() || !_sprite)
+    if (!_sprite)
         return;
 
     const ax::Mat4& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+
+    if (_shaderProgressEnabled)
+    {
+        // like its vertices, the timer has one color
+        auto quad      = _sprite->getQuad();
+        quad.bl.colors = quad.br.colors = quad.tl.colors = quad.tr.colors = getProgressColor();
+
+        ProgressShape shape;
+        shape.progress      = _percentage / 100.0f;
+        shape.midpoint      = _midpoint;
+        shape.barChangeRate = _barChangeRate;
+        shape.bar           = _type == Type::BAR;
+        shape.reverse       = _reverseDirection;
+        if (renderer->addInstancedProgress(quad, _sprite->isTextureRectRotated(), transform, shape,
+                                           _sprite->getTexture(), _sprite->getBlendFunc(), _globalZOrder,
+                                           projectionMat))
+            return;
+
+        // drawn with its vertices, they may have been cleared by a type or direction change
+        if (_vertexDataDirty || _vertexData.empty())
+            updateVertexData();
+    }
+
+    if (_vertexData.empty())
+        return;
+
     Mat4 finalMat                      = projectionMat * transform;
     _programState->setUniform(_locMVP1, finalMat.m, sizeof(finalMat.m));
     _programState->setTexture(_locTex1, 0, _sprite->getTexture()->getBackendTexture());
@@ -150,6 +150,16 @@ public:
      */
     Vec2 getBarChangeRate() const { return _barChangeRate; }
 
+    /**
+     * Enable/disable the shader progress. The timer then draws its whole sprite and the shaders hide the part which
+     * isn't reached by the percentage, so changing it doesn't rebuild any vertices. Consecutive timers sharing a
+     * texture, a blend function, a type, a direction, a midpoint and a bar change rate are drawn with one call.
+     * The vertices are still built when the timer can't be drawn instanced, e.g. when it is rotated in 3D.
+     * Disabled by default.
+     */
+    void setShaderProgressEnabled(bool enabled);
+    bool isShaderProgressEnabled() const { return _shaderProgressEnabled; }
+
     // Overrides
     virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
     virtual void setAnchorPoint(const Vec2& anchorPoint) override;
@@ -176,10 +186,12 @@ protected:
     Tex2F textureCoordFromAlphaPoint(Vec2 alpha);
     Vec2 vertexFromAlphaPoint(Vec2 alpha);
     void updateProgress();
+    void updateVertexData();
     void updateBar();
     void updateRadial();
     void updateDisplayedOpacity(uint8_t parentOpacity) override;
     void updateColor() override;
+    Color4B getProgressColor() const;
     Vec2 boundaryTexCoord(char index);
 
     Type _type = Type::RADIAL;
@@ -190,6 +202,9 @@ protected:
     std::vector<V2F_C4B_T2F> _vertexData;
     std::vector<unsigned short> _indexData;
     bool _reverseDirection = false;
+    bool _shaderProgressEnabled = false;
+    // the vertices are only built when the shader progress can't be used
+    bool _vertexDataDirty = false;
 
     CustomCommand _customCommand;
     CustomCommand _customCommand2;
@@ -445,6 +445,14 @@ void ProtectedNode::setCameraMask(unsigned short mask, bool applyChildren)
     }
 }
 
+unsigned short ProtectedNode::computeSubtreeCameraMask()
+{
+    unsigned short mask = Node::computeSubtreeCameraMask();
+    for (auto&& child : _protectedChildren)
+        mask |= child->getSubtreeCameraMask();
+    return mask;
+}
+
 void ProtectedNode::setGlobalZOrder(float globalZOrder)
 {
     Node::setGlobalZOrder(globalZOrder);
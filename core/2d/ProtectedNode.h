@@ -207,6 +207,7 @@ public:
 protected:
     /// helper that reorder a child
     void insertProtectedChild(Node* child, int z);
+    virtual unsigned short computeSubtreeCameraMask() override;
 
     Vector<Node*> _protectedChildren;  ///< array of children nodes
     bool _reorderProtectedChildDirty;
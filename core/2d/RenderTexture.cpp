@@ -63,6 +63,19 @@ RenderTexture::RenderTexture()
 #endif
 }
 
+static Texture2D* newDepthStencilTexture(int width, int height)
+{
+    backend::TextureDescriptor descriptor;
+    descriptor.width         = width;
+    descriptor.height        = height;
+    descriptor.textureUsage  = TextureUsage::RENDER_TARGET;
+    descriptor.textureFormat = PixelFormat::D24S8;
+
+    auto texture = new Texture2D();
+    texture->updateTextureDescriptor(descriptor);
+    return texture;
+}
+
 RenderTexture::~RenderTexture()
 {
     AX_SAFE_RELEASE(_renderTarget);
@@ -186,23 +199,26 @@ bool RenderTexture::initWithWidthAndHeight(int w,
             powH = utils::nextPOT(h);
         }
 
-        backend::TextureDescriptor descriptor;
-        descriptor.width         = powW;
-        descriptor.height        = powH;
-        descriptor.textureUsage  = TextureUsage::RENDER_TARGET;
-        descriptor.textureFormat = PixelFormat::RGBA8;
-        _texture2D               = new Texture2D();
-        _texture2D->updateTextureDescriptor(descriptor, !!AX_ENABLE_PREMULTIPLIED_ALPHA);
+        // the color texture is taken back by the pool once the sprite releases it
+        auto renderTargetPool = _director->getRenderer()->getRenderTargetPool();
+        _texture2D = renderTargetPool->acquireTexture(powW, powH, PixelFormat::RGBA8, !!AX_ENABLE_PREMULTIPLIED_ALPHA);
 
+        AX_SAFE_RELEASE_NULL(_depthStencilTexture);
         if (PixelFormat::D24S8 == depthStencilFormat || sharedRenderTarget)
         {
-            descriptor.textureFormat = PixelFormat::D24S8;
-
-            AX_SAFE_RELEASE(_depthStencilTexture);
-
-            _depthStencilTexture = new Texture2D();
-            _depthStencilTexture->updateTextureDescriptor(descriptor);
+            _transientDepthStencil = _transientDepthStencil && !sharedRenderTarget;
+            if (_transientDepthStencil)
+            {
+                _depthStencilTexture = renderTargetPool->acquireTransientDepthStencil(powW, powH);
+                _depthStencilTexture->retain();
+            }
+            else
+            {
+                _depthStencilTexture = newDepthStencilTexture(powW, powH);
+            }
         }
+        else
+            _transientDepthStencil = false;
 
         AX_SAFE_RELEASE(_renderTarget);
 
@@ -224,6 +240,9 @@ bool RenderTexture::initWithWidthAndHeight(int w,
         auto depthStencilTexture = _depthStencilTexture ? _depthStencilTexture->getBackendTexture() : nullptr;
         _renderTarget->setDepthAttachment(depthStencilTexture);
         _renderTarget->setStencilAttachment(depthStencilTexture);
+        if (!sharedRenderTarget)
+            _renderTarget->setTransientAttachments(_transientDepthStencil ? TargetBufferFlags::DEPTH_AND_STENCIL
+                                                                          : TargetBufferFlags::NONE);
 
         clearColorAttachment();
 
@@ -250,8 +269,6 @@ bool RenderTexture::initWithWidthAndHeight(int w,
             _sprite->setOpacityModifyRGB(false);
         }
 
-        _texture2D->release();
-
         // Disabled by default.
         _autoDraw = false;
 
@@ -311,6 +328,37 @@ void RenderTexture::setVirtualViewport(const Vec2& rtBegin, const Rect& fullRect
     _fullviewPort = fullViewport;
 }
 
+void RenderTexture::setTransientDepthStencil(bool transient)
+{
+    if (_transientDepthStencil == transient)
+        return;
+    if (!_depthStencilTexture || isSharedRenderTarget())
+    {
+        AXLOGW("RenderTexture: only the depth stencil of a render target of its own can be transient");
+        return;
+    }
+
+    _transientDepthStencil = transient;
+
+    const int width       = _texture2D->getPixelsWide();
+    const int height      = _texture2D->getPixelsHigh();
+    auto renderTargetPool = _director->getRenderer()->getRenderTargetPool();
+    AX_SAFE_RELEASE(_depthStencilTexture);
+    if (transient)
+    {
+        _depthStencilTexture = renderTargetPool->acquireTransientDepthStencil(width, height);
+        _depthStencilTexture->retain();
+    }
+    else
+    {
+        _depthStencilTexture = newDepthStencilTexture(width, height);
+    }
+
+    _renderTarget->setDepthAttachment(_depthStencilTexture->getBackendTexture());
+    _renderTarget->setStencilAttachment(_depthStencilTexture->getBackendTexture());
+    _renderTarget->setTransientAttachments(transient ? TargetBufferFlags::DEPTH_AND_STENCIL : TargetBufferFlags::NONE);
+}
+
 bool RenderTexture::isSharedRenderTarget() const
 {
     return _renderTarget == _director->getRenderer()->getOffscreenRenderTarget();
@@ -314,6 +314,16 @@ public:
 
     inline backend::RenderTarget* getRenderTarget() const { return _renderTarget; }
 
+    /** Shares the depth stencil buffer with the render textures of the same size, its content doesn't outlive a
+     * render pass. This saves the memory of the buffer, and the bandwidth of storing it on the tile based GPUs, as long
+     * as the depth and stencil are cleared each time the texture is drawn. Only for a render texture with a depth
+     * stencil buffer and a render target of its own.
+     *
+     * @param transient Whether or not the depth stencil buffer is transient.
+     */
+    void setTransientDepthStencil(bool transient);
+    bool isTransientDepthStencil() const { return _transientDepthStencil; }
+
     /** Flag: Use stack matrix computed from scene hierarchy or generate new modelView and projection matrix.
      *
      * @param keepMatrix Whether or not use stack matrix computed from scene hierarchy or generate new modelView and
@@ -428,8 +438,9 @@ protected:
     Color4F _clearColor;
     float _clearDepth     = 1.f;
     int _clearStencil     = 0;
-    bool _autoDraw        = false;
-    ClearFlag _clearFlags = ClearFlag::NONE;
+    bool _autoDraw              = false;
+    bool _transientDepthStencil = false;
+    ClearFlag _clearFlags       = ClearFlag::NONE;
 
     /** The Sprite being used.
      The sprite, by default, will use the following blending function: BlendFactor::ONE,
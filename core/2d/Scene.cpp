@@ -32,8 +32,11 @@ THE SOFTWARE.
 #include "2d/Camera.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
+#include "base/RefPtr.h"
 #include "base/UTF8.h"
 #include "renderer/Renderer.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/PostProcessGraph.h"
 
 #if defined(AX_ENABLE_PHYSICS)
 #    include "physics/PhysicsWorld.h"
@@ -48,6 +51,11 @@ THE SOFTWARE.
 #    include "navmesh/NavMesh.h"
 #endif
 
+#if defined(AX_ENABLE_3D)
+#    include "3d/BoundsTree.h"
+#    include "3d/MeshRenderer.h"
+#endif
+
 namespace ax
 {
 
@@ -66,12 +74,21 @@ Scene::Scene()
 
 Scene::~Scene()
 {
+    // prepared but never run
+    for (auto&& child : _preparedChildren)
+    {
+        if (child->isRunning())
+            child->onExit();
+    }
 #if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
     AX_SAFE_RELEASE(_physics3DWorld);
     AX_SAFE_RELEASE(_physics3dDebugCamera);
 #endif
 #if defined(AX_ENABLE_NAVMESH)
     AX_SAFE_RELEASE(_navMesh);
+#endif
+#if defined(AX_ENABLE_3D)
+    setBoundsTreeEnabled(false);
 #endif
     _director->getEventDispatcher()->removeEventListener(_event);
     AX_SAFE_RELEASE(_event);
@@ -186,6 +203,15 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
     Camera* defaultCamera = nullptr;
     const auto& transform = getNodeToParentTransform();
 
+    // each camera visit skips the subtrees without its flag, the masks are updated here as the children may be
+    // visited by the workers
+    getSubtreeCameraMask();
+
+#if defined(AX_ENABLE_3D)
+    if (_boundsTree)
+        refreshBoundsTree();
+#endif
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -213,8 +239,21 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
                               Camera::_visitingCamera->getViewProjectionMatrix());
 
         camera->apply();
+        auto dynamicResolution = camera->getDynamicResolution();
+        if (dynamicResolution)
+            dynamicResolution->begin(renderer);
+        auto postProcess = camera->getPostProcess();
+        if (postProcess)
+            postProcess->begin(renderer);
         // clear background with max depth
         camera->clearBackground();
+#if defined(AX_ENABLE_3D)
+        if (_boundsTree)
+        {
+            _boundsTree->cull(camera->getFrustum());
+            _boundsCullCamera = camera;
+        }
+#endif
         // visit the scene
         visit(renderer, transform, 0);
 #if defined(AX_ENABLE_NAVMESH)
@@ -225,6 +264,10 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
 #endif
 
         renderer->render();
+        if (postProcess)
+            postProcess->end(renderer);
+        if (dynamicResolution)
+            dynamicResolution->end(renderer);
 
         _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
 
@@ -257,6 +300,9 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
     }
 #endif
 
+#if defined(AX_ENABLE_3D)
+    _boundsCullCamera = nullptr;
+#endif
     Camera::_visitingCamera = nullptr;
 }
 
@@ -269,6 +315,8 @@ void Scene::visit()
 {
     const auto eyeTransform = Mat4::IDENTITY;
 
+    getSubtreeCameraMask();
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -307,6 +355,46 @@ void Scene::removeAllChildren()
     }
 }
 
+void Scene::onEnter()
+{
+    Node::onEnter();
+
+    // the children entered by prepareAsync handle the events once the scene runs
+    for (auto&& child : _preparedChildren)
+    {
+        if (child->getParent() == this && child->isRunning())
+            _eventDispatcher->resumeEventListenersForTarget(child, true);
+    }
+    _preparedChildren.clear();
+}
+
+Task<void> Scene::prepareAsync(BuildFunc build, float frameBudget)
+{
+    AXASSERT(!_running && !_preparing, "Scene::prepareAsync: the scene is already running or preparing");
+    RefPtr<Scene> self(this);
+    _preparing = true;
+
+    TimeSlice slice(frameBudget);
+    if (build)
+        co_await build(slice);
+
+    // entered one child at a time, Node::onEnter skips them once the scene runs, which stops entering them
+    auto children = _children;
+    for (auto&& child : children)
+    {
+        co_await slice;
+        if (_running)
+            break;
+        if (child->getParent() != this || child->isRunning())
+            continue;
+
+        child->onEnter();
+        _eventDispatcher->pauseEventListenersForTarget(child, true);
+        _preparedChildren.pushBack(child);
+    }
+    _preparing = false;
+}
+
 #if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
 void Scene::setPhysics3DDebugCamera(Camera* camera)
 {
@@ -397,4 +485,80 @@ void Scene::stepPhysicsAndNavigation(float deltaTime)
 }
 #endif
 
+#if defined(AX_ENABLE_3D)
+void Scene::setBoundsTreeEnabled(bool enabled)
+{
+    if (enabled == (_boundsTree != nullptr))
+        return;
+
+    if (!enabled)
+    {
+        for (auto mesh : _boundsNodes)
+        {
+            mesh->_boundsScene = nullptr;
+            mesh->_boundsProxy = BoundsTree::NULL_PROXY;
+        }
+        _boundsNodes.clear();
+        AX_SAFE_DELETE(_boundsTree);
+        _boundsCullCamera = nullptr;
+        return;
+    }
+
+    _boundsTree = new BoundsTree();
+    if (!_running)
+        return;  // the mesh renderers add themselves as they enter
+
+    std::function<void(Node*)> addRunningMeshes = [&](Node* node) {
+        for (auto&& child : node->getChildren())
+        {
+            if (!child->isRunning())
+                continue;
+            if (auto mesh = dynamic_cast<MeshRenderer*>(child))
+                addBoundsNode(mesh);
+            addRunningMeshes(child);
+        }
+    };
+    addRunningMeshes(this);
+}
+
+void Scene::addBoundsNode(MeshRenderer* mesh)
+{
+    mesh->_boundsScene = this;
+    mesh->_boundsIndex = _boundsNodes.size();
+    mesh->_boundsProxy = _boundsTree->insert(mesh, mesh->getAABB());
+    mesh->_boundsDirty = false;
+    _boundsNodes.emplace_back(mesh);
+}
+
+void Scene::removeBoundsNode(MeshRenderer* mesh)
+{
+    _boundsTree->remove(mesh->_boundsProxy);
+
+    auto last                        = _boundsNodes.back();
+    last->_boundsIndex               = mesh->_boundsIndex;
+    _boundsNodes[mesh->_boundsIndex] = last;
+    _boundsNodes.pop_back();
+
+    mesh->_boundsScene = nullptr;
+    mesh->_boundsProxy = BoundsTree::NULL_PROXY;
+}
+
+void Scene::refreshBoundsTree()
+{
+    for (auto mesh : _boundsNodes)
+    {
+        if (mesh->_boundsDirty)
+        {
+            _boundsTree->update(mesh->_boundsProxy, mesh->getAABB());
+            mesh->_boundsDirty = false;
+        }
+    }
+}
+
+bool Scene::isCulledByBoundsTree(const MeshRenderer* mesh) const
+{
+    return _boundsCullCamera == Camera::getVisitingCamera() && !_boundsTree->isVisible(mesh->_boundsProxy);
+}
+#endif
+
 }
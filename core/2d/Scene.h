@@ -30,8 +30,10 @@ THE SOFTWARE.
 #ifndef __CCSCENE_H__
 #define __CCSCENE_H__
 
+#include <functional>
 #include <string>
 #include "2d/Node.h"
+#include "base/Async.h"
 
 namespace ax
 {
@@ -50,6 +52,10 @@ class Physics3DWorld;
 #if defined(AX_ENABLE_NAVMESH)
 class NavMesh;
 #endif
+#if defined(AX_ENABLE_3D)
+class BoundsTree;
+class MeshRenderer;
+#endif
 
 /**
  * @addtogroup _2d
@@ -72,6 +78,12 @@ Scene will create a default camera for you.
 class AX_DLL Scene : public Node
 {
 public:
+    /** The time spent preparing a scene per frame by default, in seconds. */
+    static constexpr float DEFAULT_PREPARE_BUDGET = 0.008f;
+
+    /** Builds the content of a scene, awaiting the slice between its pieces. */
+    using BuildFunc = std::function<Task<void>(TimeSlice& slice)>;
+
     /** Creates a new Scene object.
      *
      * @return An autoreleased Scene object.
@@ -122,6 +134,34 @@ public:
     /** override function */
     virtual void removeAllChildren() override;
 
+    void onEnter() override;
+
+    /**
+     * Builds and enters the scene over several frames before it runs, so that showing a heavy scene doesn't hitch.
+     *
+     * `build` creates the content of the scene, awaiting the slice between its pieces so that at most `frameBudget`
+     * seconds are spent on it per frame. The children of the scene are then entered one per slice, their updates and
+     * actions start as they are entered but their event listeners are paused until the scene runs. A prepared scene
+     * is shown like any other, by a transition too, see Director::replaceSceneAsync.
+     @code
+     auto scene = Scene::create();
+     co_await scene->prepareAsync([scene](TimeSlice& slice) -> Task<void> {
+         for (int i = 0; i < 20; ++i)
+         {
+             scene->addChild(createPanel(i));
+             co_await slice;
+         }
+     });
+     Director::getInstance()->replaceScene(TransitionFade::create(0.5f, scene));
+     @endcode
+     * @js NA
+     * @lua NA
+     */
+    Task<void> prepareAsync(BuildFunc build, float frameBudget = DEFAULT_PREPARE_BUDGET);
+
+    /** Whether prepareAsync is building or entering the scene. */
+    bool isPreparing() const { return _preparing; }
+
     Scene();
     virtual ~Scene();
 
@@ -154,6 +194,9 @@ protected:
 
     std::vector<BaseLight*> _lights;
 
+    Vector<Node*> _preparedChildren;  // entered by prepareAsync, their listeners are resumed once the scene runs
+    bool _preparing = false;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Scene);
 
@@ -223,6 +266,34 @@ protected:
 public:
     void stepPhysicsAndNavigation(float deltaTime);
 #endif
+
+#if defined(AX_ENABLE_3D)
+public:
+    /**
+     * Keeps the world bounds of the mesh renderers of the scene in a BoundsTree, for picking and proximity queries
+     * by ray, sphere or frustum. The bounds are refit as the mesh renderers are visited, so the queries see the
+     * bounds of the last drawn frame. The mesh renderers out of the frustum of the rendering camera are then
+     * skipped by their draw.
+     */
+    void setBoundsTreeEnabled(bool enabled);
+    bool isBoundsTreeEnabled() const { return _boundsTree != nullptr; }
+    /** The bounds tree of the scene, null when not enabled. */
+    BoundsTree* getBoundsTree() const { return _boundsTree; }
+
+protected:
+    friend class MeshRenderer;
+
+    void addBoundsNode(MeshRenderer* mesh);
+    void removeBoundsNode(MeshRenderer* mesh);
+    /** Refits the bounds of the mesh renderers which moved since the last frame. */
+    void refreshBoundsTree();
+    /** Whether the mesh renderer is out of the frustum of the visiting camera, as culled by the bounds tree. */
+    bool isCulledByBoundsTree(const MeshRenderer* mesh) const;
+
+    BoundsTree* _boundsTree = nullptr;
+    std::vector<MeshRenderer*> _boundsNodes;  // weak refs, the mesh renderers in the tree
+    Camera* _boundsCullCamera = nullptr;      // the camera the tree culled for
+#endif
 };
 
 // end of _2d group
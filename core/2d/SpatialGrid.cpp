@@ -0,0 +1,213 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/SpatialGrid.h"
+#include "2d/Node.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace ax
+{
+
+SpatialGrid::SpatialGrid(float cellSize) : _cellSize(cellSize), _invCellSize(1.0f / cellSize)
+{
+    AXASSERT(cellSize > 0, "Invalid cell size");
+}
+
+void SpatialGrid::insert(Node* node)
+{
+    if (_entries.emplace(node, Entry{}).second)
+        markDirty(node);
+}
+
+void SpatialGrid::remove(Node* node)
+{
+    auto it = _entries.find(node);
+    if (it == _entries.end())
+        return;
+
+    unplace(node, it.value());
+    _entries.erase(it);
+    // a stale pointer may stay in the dirty list, refresh skips the nodes without entry
+    node->_spatialIndexDirty = false;
+}
+
+void SpatialGrid::clear()
+{
+    for (auto&& item : _entries)
+        const_cast<Node*>(item.first)->_spatialIndexDirty = false;
+    _entries.clear();
+    _cells.clear();
+    _oversized.clear();
+    _dirtyNodes.clear();
+}
+
+void SpatialGrid::markDirty(Node* node)
+{
+    if (!node->_spatialIndexDirty)
+    {
+        node->_spatialIndexDirty = true;
+        _dirtyNodes.emplace_back(node);
+    }
+}
+
+void SpatialGrid::refresh()
+{
+    for (auto node : _dirtyNodes)
+    {
+        auto it = _entries.find(node);
+        if (it == _entries.end())
+            continue;
+
+        node->_spatialIndexDirty = false;
+        auto& entry              = it.value();
+        unplace(node, entry);
+        entry.bounds = node->getBoundingBox();
+        place(node, entry);
+    }
+    _dirtyNodes.clear();
+}
+
+size_t SpatialGrid::getMemoryUsage() const
+{
+    size_t bytes = sizeof(SpatialGrid);
+    bytes += _entries.bucket_count() * (sizeof(std::pair<Node*, Entry>) + sizeof(uint32_t));
+    bytes += _cells.bucket_count() * (sizeof(std::pair<uint64_t, std::vector<Node*>>) + sizeof(uint32_t));
+    for (auto&& cell : _cells)
+        bytes += cell.second.capacity() * sizeof(Node*);
+    bytes += (_oversized.capacity() + _dirtyNodes.capacity() + _visibleNodes.capacity()) * sizeof(Node*);
+    return bytes;
+}
+
+void SpatialGrid::query(const Rect& rect, std::vector<Node*>& nodes)
+{
+    if (++_queryStamp == 0)
+    {
+        for (auto it = _entries.begin(); it != _entries.end(); ++it)
+            it.value().queryStamp = 0;
+        _queryStamp = 1;
+    }
+
+    for (auto node : _oversized)
+        collect(node, _entries.find(node).value(), rect, nodes);
+
+    int minX = static_cast<int>(std::floor(rect.getMinX() * _invCellSize));
+    int minY = static_cast<int>(std::floor(rect.getMinY() * _invCellSize));
+    int maxX = static_cast<int>(std::floor(rect.getMaxX() * _invCellSize));
+    int maxY = static_cast<int>(std::floor(rect.getMaxY() * _invCellSize));
+
+    // zoomed out, walking the populated cells is cheaper
+    if (int64_t(maxX - minX + 1) * (maxY - minY + 1) > static_cast<int64_t>(_cells.size()))
+    {
+        for (auto&& cell : _cells)
+            for (auto node : cell.second)
+                collect(node, _entries.find(node).value(), rect, nodes);
+        return;
+    }
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            auto it = _cells.find(cellKey(x, y));
+            if (it == _cells.end())
+                continue;
+            for (auto node : it->second)
+                collect(node, _entries.find(node).value(), rect, nodes);
+        }
+    }
+}
+
+void SpatialGrid::collect(Node* node, Entry& entry, const Rect& rect, std::vector<Node*>& nodes)
+{
+    if (entry.queryStamp == _queryStamp)
+        return;
+    entry.queryStamp = _queryStamp;
+    if (entry.bounds.intersectsRect(rect))
+        nodes.emplace_back(node);
+}
+
+void SpatialGrid::place(Node* node, Entry& entry)
+{
+    auto& bounds = entry.bounds;
+    int minX     = static_cast<int>(std::floor(bounds.getMinX() * _invCellSize));
+    int minY     = static_cast<int>(std::floor(bounds.getMinY() * _invCellSize));
+    int maxX     = static_cast<int>(std::floor(bounds.getMaxX() * _invCellSize));
+    int maxY     = static_cast<int>(std::floor(bounds.getMaxY() * _invCellSize));
+
+    if (int64_t(maxX - minX + 1) * (maxY - minY + 1) > MAX_NODE_CELLS)
+    {
+        entry.oversized = true;
+        _oversized.emplace_back(node);
+        return;
+    }
+
+    for (int y = minY; y <= maxY; ++y)
+        for (int x = minX; x <= maxX; ++x)
+            _cells.try_emplace(cellKey(x, y)).first.value().emplace_back(node);
+
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = maxX;
+    entry.maxY = maxY;
+}
+
+void SpatialGrid::unplace(Node* node, Entry& entry)
+{
+    if (entry.oversized)
+    {
+        auto it = std::find(_oversized.begin(), _oversized.end(), node);
+        if (it != _oversized.end())
+        {
+            *it = _oversized.back();
+            _oversized.pop_back();
+        }
+        entry.oversized = false;
+        return;
+    }
+
+    for (int y = entry.minY; y <= entry.maxY; ++y)
+    {
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            auto cell = _cells.find(cellKey(x, y));
+            if (cell == _cells.end())
+                continue;
+
+            auto& nodes = cell.value();
+            auto it     = std::find(nodes.begin(), nodes.end(), node);
+            if (it != nodes.end())
+            {
+                *it = nodes.back();
+                nodes.pop_back();
+            }
+            if (nodes.empty())
+                _cells.erase(cell);
+        }
+    }
+    entry.maxX = entry.minX - 1;
+    entry.maxY = entry.minY - 1;
+}
+
+}  // namespace ax
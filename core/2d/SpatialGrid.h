@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "math/Math.h"
+#include "tsl/robin_map.h"
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+namespace ax
+{
+
+class Node;
+
+/**
+ Uniform grid of the bounding boxes of the children of a node, see `Node::setSpatialIndexEnabled`.
+ Nodes are kept in every cell their bounds overlap, a node moving marks itself dirty and its cells are
+ refreshed on the next `refresh`, so the cost of a frame depends on the visible and moved nodes only.
+ Nodes spanning too many cells are kept aside and returned by every query.
+*/
+class AX_DLL SpatialGrid
+{
+public:
+    /**The default size of a cell in the space of the indexed node.*/
+    static constexpr float DEFAULT_CELL_SIZE = 256.0f;
+    /**Nodes overlapping more cells than this are not put in the cells.*/
+    static const int MAX_NODE_CELLS = 256;
+
+    explicit SpatialGrid(float cellSize = DEFAULT_CELL_SIZE);
+
+    float getCellSize() const { return _cellSize; }
+
+    /**Add a node, its cells are computed by the next `refresh`.*/
+    void insert(Node* node);
+    void remove(Node* node);
+    void clear();
+
+    /**Queue a node whose bounding box changed.*/
+    void markDirty(Node* node);
+
+    /**Recompute the cells of the dirty nodes.*/
+    void refresh();
+
+    /**
+     * Append the nodes whose bounding box intersects the rect, each one once and in no particular order.
+     * @param rect The rect in the space of the indexed node.
+     */
+    void query(const Rect& rect, std::vector<Node*>& nodes);
+
+    /**The storage of the visible children of the indexed node, reused by its visits across frames.*/
+    std::vector<Node*>& getVisibleNodes() { return _visibleNodes; }
+
+    /**The number of indexed nodes.*/
+    size_t size() const { return _entries.size(); }
+    /**The number of non-empty cells.*/
+    size_t getCellCount() const { return _cells.size(); }
+    /**The memory held by the grid in bytes, estimated from the capacity of its containers.*/
+    size_t getMemoryUsage() const;
+
+private:
+    struct Entry
+    {
+        Rect bounds;
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;  // the cell range, empty when the node isn't placed
+        bool oversized      = false;
+        uint32_t queryStamp = 0;
+    };
+
+    static uint64_t cellKey(int x, int y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+
+    void place(Node* node, Entry& entry);
+    void unplace(Node* node, Entry& entry);
+    void collect(Node* node, Entry& entry, const Rect& rect, std::vector<Node*>& nodes);
+
+    float _cellSize;
+    float _invCellSize;
+    uint32_t _queryStamp = 0;
+
+    tsl::robin_map<Node*, Entry> _entries;
+    tsl::robin_map<uint64_t, std::vector<Node*>> _cells;
+    std::vector<Node*> _oversized;
+    std::vector<Node*> _dirtyNodes;
+    std::vector<Node*> _visibleNodes;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -437,6 +437,8 @@ void Sprite::setTexture(Texture2D* texture)
         setProgramState(backend::ProgramType::POSITION_TEXTURE_COLOR);
     else
         updateProgramStateTexture(_texture);
+
+    invalidateStaticBatch();
 }
 
 Texture2D* Sprite::getTexture() const
@@ -613,84 +615,16 @@ void Sprite::updatePoly()
 
         const Rect* texRects = _rectRotated ? texRects_rotated : texRects_normal;
 
-        //
-        // vertex Data.
-        //
-
-        // reset center rect since it is altered when when the texture
-        // is rotated
-        cx1 = _centerRectNormalized.origin.x;
-        cy1 = _centerRectNormalized.origin.y;
-        cx2 = _centerRectNormalized.origin.x + _centerRectNormalized.size.width;
-        cy2 = _centerRectNormalized.origin.y + _centerRectNormalized.size.height;
-        if (_rectRotated)
-            std::swap(osw, osh);
-
-        // sizes
-        float x0_s = osw * cx1;
-        float x1_s = osw * (cx2 - cx1) * _stretchFactor.x;
-        float x2_s = osw * (1 - cx2);
-        float y0_s = osh * cy1;
-        float y1_s = osh * (cy2 - cy1) * _stretchFactor.y;
-        float y2_s = osh * (1 - cy2);
-
-        // avoid negative size:
-        if (_contentSize.width < x0_s + x2_s)
-            x2_s = x0_s = _contentSize.width / 2;
-
-        if (_contentSize.height < y0_s + y2_s)
-            y2_s = y0_s = _contentSize.height / 2;
-
-        // is it flipped?
-        // swap sizes to calculate offset correctly
-        if (_flippedX)
-            std::swap(x0_s, x2_s);
-        if (_flippedY)
-            std::swap(y0_s, y2_s);
-
-        // origins
-        float x0 = 0;
-        float x1 = x0 + x0_s;
-        float x2 = x1 + x1_s;
-        float y0 = 0;
-        float y1 = y0 + y0_s;
-        float y2 = y1 + y1_s;
-
-        // swap origin, but restore size to its original value
-        if (_flippedX)
-        {
-            std::swap(x0, x2);
-            std::swap(x0_s, x2_s);
-        }
-        if (_flippedY)
-        {
-            std::swap(y0, y2);
-            std::swap(y0_s, y2_s);
-        }
-
-        const Rect verticesRects[9] = {
-            Rect(x0, y0, x0_s, y0_s),  // bottom-left
-            Rect(x1, y0, x1_s, y0_s),  // bottom
-            Rect(x2, y0, x2_s, y0_s),  // bottom-right
-
-            Rect(x0, y1, x0_s, y1_s),  // left
-            Rect(x1, y1, x1_s, y1_s),  // center
-            Rect(x2, y1, x2_s, y1_s),  // right
-
-            Rect(x0, y2, x0_s, y2_s),  // top-left
-            Rect(x1, y2, x1_s, y2_s),  // top
-            Rect(x2, y2, x2_s, y2_s),  // top-right
-        };
-
         // needed in order to get color from "_quad"
         V3F_C4B_T2F_Quad tmpQuad = _quad;
 
         for (int i = 0; i < 9; ++i)
         {
             setTextureCoords(texRects[i], &tmpQuad);
-            setVertexCoords(verticesRects[i], &tmpQuad);
             populateTriangle(i, tmpQuad);
         }
+        updateSlice9Vertices();
+
         TrianglesCommand::Triangles triangles;
         triangles.verts      = _trianglesVertex;
         triangles.vertCount  = 16;
@@ -701,6 +635,82 @@ void Sprite::updatePoly()
         // to avoid memcpy'ing stuff
         _polyInfo.setTriangles(triangles);
     }
+
+    invalidateStaticBatch();
+}
+
+void Sprite::updateSlice9Vertices()
+{
+    const float cx1 = _centerRectNormalized.origin.x;
+    const float cy1 = _centerRectNormalized.origin.y;
+    const float cx2 = _centerRectNormalized.origin.x + _centerRectNormalized.size.width;
+    const float cy2 = _centerRectNormalized.origin.y + _centerRectNormalized.size.height;
+    const float osw = _rect.size.width;
+    const float osh = _rect.size.height;
+
+    // sizes
+    float x0_s = osw * cx1;
+    float x1_s = osw * (cx2 - cx1) * _stretchFactor.x;
+    float x2_s = osw * (1 - cx2);
+    float y0_s = osh * cy1;
+    float y1_s = osh * (cy2 - cy1) * _stretchFactor.y;
+    float y2_s = osh * (1 - cy2);
+
+    // avoid negative size:
+    if (_contentSize.width < x0_s + x2_s)
+        x2_s = x0_s = _contentSize.width / 2;
+
+    if (_contentSize.height < y0_s + y2_s)
+        y2_s = y0_s = _contentSize.height / 2;
+
+    // is it flipped?
+    // swap sizes to calculate offset correctly
+    if (_flippedX)
+        std::swap(x0_s, x2_s);
+    if (_flippedY)
+        std::swap(y0_s, y2_s);
+
+    // origins
+    float x0 = 0;
+    float x1 = x0 + x0_s;
+    float x2 = x1 + x1_s;
+    float y0 = 0;
+    float y1 = y0 + y0_s;
+    float y2 = y1 + y1_s;
+
+    // swap origin, but restore size to its original value
+    if (_flippedX)
+    {
+        std::swap(x0, x2);
+        std::swap(x0_s, x2_s);
+    }
+    if (_flippedY)
+    {
+        std::swap(y0, y2);
+        std::swap(y0_s, y2_s);
+    }
+
+    // only the corner quads own vertices, the others share them, see populateTriangle()
+    const Rect verticesRects[4] = {
+        Rect(x0, y0, x0_s, y0_s),  // bottom-left
+        Rect(x2, y0, x2_s, y0_s),  // bottom-right
+        Rect(x0, y2, x0_s, y2_s),  // top-left
+        Rect(x2, y2, x2_s, y2_s),  // top-right
+    };
+    const int quadIndices[4] = {0, 2, 6, 8};
+
+    // the texture coords are kept, so only the positions are copied
+    V3F_C4B_T2F_Quad tmpQuad;
+    for (int i = 0; i < 4; ++i)
+    {
+        setVertexCoords(verticesRects[i], &tmpQuad);
+        const int index_bl = getSlice9QuadIndex(quadIndices[i]) * 4 / 3;
+
+        _trianglesVertex[index_bl].vertices     = tmpQuad.bl.vertices;
+        _trianglesVertex[index_bl + 1].vertices = tmpQuad.br.vertices;
+        _trianglesVertex[index_bl + 4].vertices = tmpQuad.tl.vertices;
+        _trianglesVertex[index_bl + 5].vertices = tmpQuad.tr.vertices;
+    }
 }
 
 void Sprite::setCenterRectNormalized(const ax::Rect& rectTopLeft)
@@ -924,6 +934,27 @@ void Sprite::setVertexCoords(const Rect& rect, V3F_C4B_T2F_Quad* outQuad)
     }
 }
 
+int Sprite::getSlice9QuadIndex(int quadIndex) const
+{
+    // the corner quads are swapped when the sprite is flipped
+    if (_flippedX)
+    {
+        if (quadIndex % 3 == 0)
+            quadIndex += 2;
+        else
+            quadIndex -= 2;
+    }
+
+    if (_flippedY)
+    {
+        if (quadIndex <= 2)
+            quadIndex += 6;
+        else
+            quadIndex -= 6;
+    }
+    return quadIndex;
+}
+
 void Sprite::populateTriangle(int quadIndex, const V3F_C4B_T2F_Quad& quad)
 {
     AXASSERT(quadIndex < 9, "Invalid quadIndex");
@@ -952,23 +983,7 @@ void Sprite::populateTriangle(int quadIndex, const V3F_C4B_T2F_Quad& quad)
     // Optimization: I don't need to copy all the vertices all the time. just the 4 "quads" from the corners.
     if (quadIndex == 0 || quadIndex == 2 || quadIndex == 6 || quadIndex == 8)
     {
-        if (_flippedX)
-        {
-            if (quadIndex % 3 == 0)
-                quadIndex += 2;
-            else
-                quadIndex -= 2;
-        }
-
-        if (_flippedY)
-        {
-            if (quadIndex <= 2)
-                quadIndex += 6;
-            else
-                quadIndex -= 6;
-        }
-
-        const int index_bl = quadIndex * 4 / 3;
+        const int index_bl = getSlice9QuadIndex(quadIndex) * 4 / 3;
         const int index_br = index_bl + 1;
         const int index_tl = index_bl + 4;
         const int index_tr = index_bl + 5;
@@ -1088,8 +1103,14 @@ void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
     if (_insideBounds)
 #endif
     {
-        _trianglesCommand.init(_globalZOrder, _texture, _blendFunc, _polyInfo.triangles, transform, flags);
-        renderer->addCommand(&_trianglesCommand);
+        if (_texture->isMipStreaming())
+            requestTextureMipLevel(transform);
+
+        if (!drawInstanced(renderer, transform, flags))
+        {
+            _trianglesCommand.init(_globalZOrder, _texture, _blendFunc, _polyInfo.triangles, transform, flags);
+            renderer->addCommand(&_trianglesCommand);
+        }
 
 #if AX_SPRITE_DEBUG_DRAW
         _debugDrawNode->clear();
@@ -1367,7 +1388,15 @@ void Sprite::setContentSize(const Vec2& size)
     Node::setContentSize(size);
 
     updateStretchFactor();
-    updatePoly();
+
+    // resizing a 9-sliced sprite only moves the vertices of the slices, its texture coords don't change
+    if (_renderMode == RenderMode::SLICE9)
+    {
+        updateSlice9Vertices();
+        invalidateStaticBatch();
+    }
+    else
+        updatePoly();
 }
 
 void Sprite::setStretchEnabled(bool enabled)
@@ -1474,6 +1503,8 @@ void Sprite::flipX()
     else
         // RenderMode:: Quad or Slice9
         updatePoly();
+
+    invalidateStaticBatch();
 }
 
 void Sprite::flipY()
@@ -1491,6 +1522,8 @@ void Sprite::flipY()
     else
         // RenderMode:: Quad or Slice9
         updatePoly();
+
+    invalidateStaticBatch();
 }
 
 //
@@ -1530,6 +1563,8 @@ void Sprite::updateColor()
 
     // self render
     // do nothing
+
+    invalidateStaticBatch();
 }
 
 void Sprite::setOpacityModifyRGB(bool modify)
@@ -1716,6 +1751,38 @@ void Sprite::setPolygonInfo(const PolygonInfo& info)
 {
     _polyInfo   = info;
     _renderMode = RenderMode::POLYGON;
+    invalidateStaticBatch();
+}
+
+void Sprite::requestTextureMipLevel(const Mat4& transform)
+{
+    // the screen size of the sprite is measured along the axes of its transform, the perspective isn't considered
+    auto glView        = _director->getGLView();
+    float screenWidth  = Vec2(transform.m[0], transform.m[1]).length() * _contentSize.width;
+    float screenHeight = Vec2(transform.m[4], transform.m[5]).length() * _contentSize.height;
+    if (glView)
+    {
+        screenWidth *= glView->getScaleX();
+        screenHeight *= glView->getScaleY();
+    }
+    if (screenWidth <= 0 || screenHeight <= 0)
+        return;
+
+    // the level 0 texels per screen pixel, each level halves them
+    auto texels   = AX_SIZE_POINTS_TO_PIXELS(_rect.size);
+    float density = std::max(texels.width / screenWidth, texels.height / screenHeight);
+    _texture->requestMipLevel(density > 1.0f ? static_cast<int>(std::log2(density)) : 0);
+}
+
+bool Sprite::drawInstanced(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    // only plain 2D quads drawn with the default program, the instanced program has no custom uniforms
+    if (!renderer->isSpriteInstancingEnabled() || _renderMode != RenderMode::QUAD || (flags & FLAGS_RENDER_AS_3D) ||
+        _programState->getProgram()->getProgramType() != backend::ProgramType::POSITION_TEXTURE_COLOR)
+        return false;
+
+    const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    return renderer->addInstancedQuad(_quad, transform, _texture, _blendFunc, _globalZOrder, projectionMat);
 }
 
 void Sprite::setMVPMatrixUniform()
@@ -516,7 +516,11 @@ public:
      *In lua: local setBlendFunc(local src, local dst).
      *@endcode
      */
-    void setBlendFunc(const BlendFunc& blendFunc) override { _blendFunc = blendFunc; }
+    void setBlendFunc(const BlendFunc& blendFunc) override
+    {
+        _blendFunc = blendFunc;
+        invalidateStaticBatch();
+    }
     /**
      * @js  NA
      * @lua NA
@@ -669,9 +673,17 @@ protected:
     virtual void flipY();
 
     void updatePoly();
+    // moves the vertices of the 9 slices to the content size, without touching the texture coords
+    void updateSlice9Vertices();
     void updateStretchFactor();
     void populateTriangle(int quadIndex, const V3F_C4B_T2F_Quad& quad);
+    // the corner quad holding the vertices of a quad index, after the flipping
+    int getSlice9QuadIndex(int quadIndex) const;
     void setMVPMatrixUniform();
+    // adds the quad to the renderer instanced sprites, returns false if it needs a TrianglesCommand
+    bool drawInstanced(Renderer* renderer, const Mat4& transform, uint32_t flags);
+    // requests the mip level of a streamed texture matching the texel density on screen
+    void requestTextureMipLevel(const Mat4& transform);
     //
     // Data used when the sprite is rendered using a SpriteSheet
     //
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "2d/Sprite.h"
 #include "2d/AutoPolygon.h"
 #include "2d/PlistSpriteSheetLoader.h"
+#include "2d/BinarySpriteSheetLoader.h"
 #include "platform/FileUtils.h"
 #include "base/Macros.h"
 #include "base/Director.h"
@@ -49,6 +50,14 @@ namespace ax
 
 static SpriteFrameCache* _sharedSpriteFrameCache = nullptr;
 
+// the .ssb sheets are loaded by the binary loader unless another format is asked for
+static uint32_t resolveSpriteSheetFormat(std::string_view spriteSheetFileName, uint32_t spriteSheetFormat)
+{
+    if (spriteSheetFormat == SpriteSheetFormat::PLIST && FileUtils::getPathExtension(spriteSheetFileName) == ".ssb")
+        return SpriteSheetFormat::BINARY;
+    return spriteSheetFormat;
+}
+
 SpriteFrameCache* SpriteFrameCache::getInstance()
 {
     if (!_sharedSpriteFrameCache)
@@ -71,6 +80,7 @@ bool SpriteFrameCache::init()
     clear();
 
     registerSpriteSheetLoader(std::make_shared<PlistSpriteSheetLoader>());
+    registerSpriteSheetLoader(std::make_shared<BinarySpriteSheetLoader>());
 
     return true;
 }
@@ -81,7 +91,7 @@ void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileN
                                                std::string_view textureFileName,
                                                uint32_t spriteSheetFormat)
 {
-    auto* loader = getSpriteSheetLoader(spriteSheetFormat);
+    auto* loader = getSpriteSheetLoader(resolveSpriteSheetFormat(spriteSheetFileName, spriteSheetFormat));
     if (loader)
     {
         loader->load(spriteSheetFileName, textureFileName, *this);
@@ -92,7 +102,7 @@ void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileN
                                                Texture2D* texture,
                                                uint32_t spriteSheetFormat)
 {
-    auto* loader = getSpriteSheetLoader(spriteSheetFormat);
+    auto* loader = getSpriteSheetLoader(resolveSpriteSheetFormat(spriteSheetFileName, spriteSheetFormat));
     if (loader)
     {
         loader->load(spriteSheetFileName, texture, *this);
@@ -101,7 +111,7 @@ void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileN
 
 void SpriteFrameCache::addSpriteFramesWithFile(std::string_view spriteSheetFileName, uint32_t spriteSheetFormat)
 {
-    auto* loader = getSpriteSheetLoader(spriteSheetFormat);
+    auto* loader = getSpriteSheetLoader(resolveSpriteSheetFormat(spriteSheetFileName, spriteSheetFormat));
     if (loader)
     {
         loader->load(spriteSheetFileName, *this);
@@ -255,6 +265,15 @@ void SpriteFrameCache::removeSpriteFramesFromDictionary(ValueMap& dictionary)
 
 void SpriteFrameCache::removeSpriteFramesFromTexture(Texture2D* texture)
 {
+    std::vector<std::string> lazySpriteSheets;
+    for (auto&& spriteSheet : _lazySpriteSheets)
+    {
+        if (spriteSheet->index->getTexture() == texture)
+            lazySpriteSheets.emplace_back(spriteSheet->path);
+    }
+    for (auto&& spriteSheetFileName : lazySpriteSheets)
+        removeSpriteSheet(spriteSheetFileName);
+
     std::vector<std::string_view> keysToRemove;
 
     for (auto&& iter : getSpriteFrames())
@@ -310,6 +329,15 @@ bool SpriteFrameCache::reloadTexture(std::string_view spriteSheetFileName)
     return true;
 }
 
+void SpriteFrameCache::insertSpriteSheet(const std::shared_ptr<SpriteSheet>& spriteSheet)
+{
+    AXASSERT(spriteSheet->index, "Only the lazily loaded sprite sheets are inserted without their frames");
+
+    removeSpriteSheet(spriteSheet->path);
+    _spriteSheets[spriteSheet->path] = spriteSheet;
+    _lazySpriteSheets.emplace_back(spriteSheet);
+}
+
 void SpriteFrameCache::insertFrame(const std::shared_ptr<SpriteSheet>& spriteSheet,
                                    std::string_view frameName,
                                    SpriteFrame* spriteFrame)
@@ -333,7 +361,7 @@ bool SpriteFrameCache::eraseFrame(std::string_view frameName)
         spriteSheet->full = false;
         spriteSheet->frames.erase(frameName);
 
-        if (spriteSheet->frames.empty())
+        if (spriteSheet->frames.empty() && !spriteSheet->index)
         {
             _spriteSheets.erase(spriteSheet->path);
         }
@@ -367,6 +395,9 @@ bool SpriteFrameCache::removeSpriteSheet(std::string_view spriteSheetFileName)
     if (it == _spriteSheets.end())
         return false;
 
+    if (it->second->index)
+        std::erase(_lazySpriteSheets, it->second);
+
     auto& frames = it->second->frames;
     for (const auto& f : frames)
     {
@@ -385,6 +416,7 @@ void SpriteFrameCache::clear()
     _spriteSheets.clear();
     _spriteFrameToSpriteSheetMap.clear();
     _spriteFrames.clear();
+    _lazySpriteSheets.clear();
 }
 
 bool SpriteFrameCache::hasFrame(std::string_view frame) const
@@ -395,12 +427,31 @@ bool SpriteFrameCache::hasFrame(std::string_view frame) const
 bool SpriteFrameCache::isSpriteSheetInUse(std::string_view spriteSheetFileName) const
 {
     const auto spriteSheetItr = _spriteSheets.find(spriteSheetFileName);
-    return spriteSheetItr != _spriteSheets.end() && !spriteSheetItr->second->frames.empty();
+    return spriteSheetItr != _spriteSheets.end() &&
+           (!spriteSheetItr->second->frames.empty() || spriteSheetItr->second->index);
 }
 
 SpriteFrame* SpriteFrameCache::findFrame(std::string_view frame)
 {
-    return _spriteFrames.at(frame);
+    auto* spriteFrame = _spriteFrames.at(frame);
+    if (!spriteFrame && !_lazySpriteSheets.empty())
+        spriteFrame = createLazyFrame(frame);
+    return spriteFrame;
+}
+
+SpriteFrame* SpriteFrameCache::createLazyFrame(std::string_view frameName)
+{
+    // the sheets loaded first win, the same as for the frames added by the eager loaders
+    for (auto&& spriteSheet : _lazySpriteSheets)
+    {
+        auto* spriteFrame = spriteSheet->index->createFrame(frameName, *this);
+        if (spriteFrame)
+        {
+            insertFrame(spriteSheet, frameName, spriteFrame);
+            return spriteFrame;
+        }
+    }
+    return nullptr;
 }
 
 std::string_view SpriteFrameCache::getSpriteFrameName(SpriteFrame* frame)
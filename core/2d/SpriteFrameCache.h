@@ -262,6 +262,11 @@ public:
      */
     bool eraseFrame(std::string_view frameName);
 
+    /** Record a lazily loaded sprite sheet, its frames are created by its index when they are first looked up.
+     *  Erased frames of such a sheet are created again on their next lookup.
+     */
+    void insertSpriteSheet(const std::shared_ptr<SpriteSheet>& spriteSheet);
+
     void addSpriteFrameCapInset(SpriteFrame* spriteFrame, const Rect& capInsets, Texture2D* texture);
 
     void registerSpriteSheetLoader(std::shared_ptr<ISpriteSheetLoader> loader);
@@ -293,6 +298,8 @@ protected:
 
     inline StringMap<SpriteFrame*>& getSpriteFrames();
 
+    SpriteFrame* createLazyFrame(std::string_view frameName);
+
     void markPlistFull(std::string_view spriteSheetFileName, bool full)
     {
         // _spriteSheets[spriteSheetFileName]->full = full;
@@ -312,6 +319,7 @@ private:
     StringMap<SpriteFrame*> _spriteFrames;
     hlookup::string_map<std::shared_ptr<SpriteSheet>> _spriteSheets;
     hlookup::string_map<std::shared_ptr<SpriteSheet>> _spriteFrameToSpriteSheetMap;
+    std::vector<std::shared_ptr<SpriteSheet>> _lazySpriteSheets;  // in load order
 
     std::map<uint32_t, std::shared_ptr<ISpriteSheetLoader>> _spriteSheetLoaders;
 };
@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #pragma once
 
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <string>
@@ -57,10 +58,21 @@ struct SpriteSheetFormat
     enum : uint32_t
     {
         PLIST  = 1,
+        BINARY = 2,
         CUSTOM = 1000
     };
 };
 
+/** The frame index of a sprite sheet whose frames are created on their first lookup. */
+class ISpriteFrameIndex
+{
+public:
+    virtual ~ISpriteFrameIndex() = default;
+    /** Creates the frame of a name, nullptr when the sheet has no such frame. */
+    virtual SpriteFrame* createFrame(std::string_view name, SpriteFrameCache& cache) = 0;
+    virtual Texture2D* getTexture() const                                          = 0;
+};
+
 class SpriteSheet
 {
 public:
@@ -68,6 +80,8 @@ public:
     uint32_t format;
     hlookup::string_set frames;
     bool full = false;
+    /** Set for the lazily loaded sheets, frames holds the names created so far. */
+    std::shared_ptr<ISpriteFrameIndex> index;
 };
 
 class ISpriteSheetLoader
@@ -86,12 +100,12 @@ class SpriteSheetLoader : public ISpriteSheetLoader
 {
 public:
     /** Configures PolygonInfo class with the passed sizes + triangles */
-    void initializePolygonInfo(const Vec2& textureSize,
-                               const Vec2& spriteSize,
-                               const std::vector<int>& vertices,
-                               const std::vector<int>& verticesUV,
-                               const std::vector<int>& triangleIndices,
-                               PolygonInfo& polygonInfo);
+    static void initializePolygonInfo(const Vec2& textureSize,
+                                      const Vec2& spriteSize,
+                                      const std::vector<int>& vertices,
+                                      const std::vector<int>& verticesUV,
+                                      const std::vector<int>& triangleIndices,
+                                      PolygonInfo& polygonInfo);
 
     uint32_t getFormat() override                                                                            = 0;
     void load(std::string_view filePath, SpriteFrameCache& cache) override                                   = 0;
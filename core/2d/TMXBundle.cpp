@@ -0,0 +1,747 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/TMXBundle.h"
+#include "2d/TMXXMLParser.h"
+#include "platform/FileUtils.h"
+#include "base/axstd.h"
+
+namespace ax
+{
+
+// all the integers are little endian, the offsets are from the start of the file
+struct TMXBundle::StringRef
+{
+    uint32_t offset;  // in the string pool
+    uint32_t length;
+};
+
+struct TMXBundle::FileHeader
+{
+    char magic[4];  // "TMXB"
+    uint32_t version;
+    uint32_t fileSize;
+    int32_t orientation;
+    int32_t staggerAxis;
+    int32_t staggerIndex;
+    int32_t hexSideLength;
+    float mapSize[2];
+    float tileSize[2];
+    uint32_t properties;      // ValueEntry index of a MAP
+    uint32_t tileProperties;  // ValueEntry index of an INT_KEY_MAP
+    uint32_t tilesetCount;
+    uint32_t tilesetOffset;  // TilesetEntry[tilesetCount]
+    uint32_t layerCount;
+    uint32_t layerOffset;  // LayerEntry[layerCount]
+    uint32_t objectGroupCount;
+    uint32_t objectGroupOffset;  // ObjectGroupEntry[objectGroupCount]
+    uint32_t animationCount;
+    uint32_t animationOffset;  // AnimationEntry[animationCount]
+    uint32_t frameCount;
+    uint32_t frameOffset;  // TMXTileAnimFrame[frameCount]
+    uint32_t valueCount;
+    uint32_t valueOffset;  // ValueEntry[valueCount]
+    uint32_t mapItemCount;
+    uint32_t mapItemOffset;  // MapItem[mapItemCount]
+    uint32_t stringPoolOffset;
+    uint32_t stringPoolSize;
+};
+
+struct TMXBundle::TilesetEntry
+{
+    StringRef name;
+    StringRef sourceImage;
+    StringRef originSourceImage;
+    int32_t firstGid;
+    int32_t spacing;
+    int32_t margin;
+    uint32_t relativeSourceImage;
+    float tileSize[2];
+    float tileOffset[2];
+    float imageSize[2];
+    uint32_t animationBegin;  // range of the animation table
+    uint32_t animationCount;
+};
+
+struct TMXBundle::AnimationEntry
+{
+    uint32_t tileID;
+    uint32_t frameBegin;  // range of the frame table
+    uint32_t frameCount;
+};
+
+struct TMXBundle::LayerEntry
+{
+    StringRef name;
+    float layerSize[2];
+    float offset[2];
+    uint32_t tilesOffset;  // uint32_t[width * height], aligned to BLOB_ALIGNMENT, null when the layer has no tiles
+    uint32_t properties;   // ValueEntry index of a MAP
+    uint8_t visible;
+    uint8_t opacity;
+    uint8_t reserved[2];
+};
+
+struct TMXBundle::ObjectGroupEntry
+{
+    StringRef name;
+    float positionOffset[2];
+    uint32_t properties;  // ValueEntry index of a MAP
+    uint32_t objects;     // ValueEntry index of a VECTOR
+};
+
+// scalars are stored in bits, a STRING is a StringRef in bits, a VECTOR is the range of its elements in the
+// value table and the maps are a range of the map item table
+struct TMXBundle::ValueEntry
+{
+    uint32_t type;  // Value::Type
+    uint32_t count;
+    uint64_t bits;
+};
+
+struct TMXBundle::MapItem
+{
+    StringRef key;  // the key of an INT_KEY_MAP is stored in offset
+    uint32_t value;
+};
+
+static constexpr char TMXB_MAGIC[4] = {'T', 'M', 'X', 'B'};
+
+namespace
+{
+class BlobWriter
+{
+public:
+    template <typename T>
+    size_t write(const T& value)
+    {
+        return writeBytes(&value, sizeof(T));
+    }
+
+    size_t writeBytes(const void* data, size_t size)
+    {
+        size_t offset = _buffer.size();
+        _buffer.resize(offset + size);
+        if (size)
+            memcpy(_buffer.data() + offset, data, size);
+        return offset;
+    }
+
+    void align(size_t alignment)
+    {
+        size_t size = (_buffer.size() + alignment - 1) & ~(alignment - 1);
+        _buffer.resize(size, 0);
+    }
+
+    template <typename T>
+    T* at(size_t offset)
+    {
+        return reinterpret_cast<T*>(_buffer.data() + offset);
+    }
+
+    size_t size() const { return _buffer.size(); }
+    const uint8_t* data() const { return _buffer.data(); }
+
+private:
+    axstd::pod_vector<uint8_t> _buffer;
+};
+}  // namespace
+
+// the value, map item and string tables are collected while walking the map info and appended at the end
+struct TMXBundle::TableWriter
+{
+    StringRef addString(std::string_view str)
+    {
+        StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size())};
+        strings.append(str);
+        return ref;
+    }
+
+    uint32_t addValue(const Value& value)
+    {
+        auto index = static_cast<uint32_t>(values.size());
+        values.emplace_back();
+        fillValue(index, value);
+        return index;
+    }
+
+    void fillValue(uint32_t index, const Value& value)
+    {
+        ValueEntry entry{static_cast<uint32_t>(value.getType()), 0, 0};
+        switch (value.getTypeFamily())
+        {
+        case Value::Type::INTEGER:
+            entry.bits = static_cast<uint64_t>(value.asInt64());
+            break;
+        case Value::Type::FLOAT:
+        {
+            float v = value.asFloat();
+            memcpy(&entry.bits, &v, sizeof(v));
+            break;
+        }
+        case Value::Type::DOUBLE:
+        {
+            double v = value.asDouble();
+            memcpy(&entry.bits, &v, sizeof(v));
+            break;
+        }
+        case Value::Type::BOOLEAN:
+            entry.bits = value.asBool();
+            break;
+        case Value::Type::STRING:
+        {
+            auto ref    = addString(value.asString());
+            entry.bits  = ref.offset;
+            entry.count = ref.length;
+            break;
+        }
+        case Value::Type::VECTOR:
+        {
+            // the elements are contiguous, their children are appended after them
+            auto& vec   = value.asValueVector();
+            auto begin  = static_cast<uint32_t>(values.size());
+            entry.bits  = begin;
+            entry.count = static_cast<uint32_t>(vec.size());
+            values.resize(values.size() + vec.size());
+            for (uint32_t i = 0; i < entry.count; ++i)
+                fillValue(begin + i, vec[i]);
+            break;
+        }
+        case Value::Type::MAP:
+        {
+            auto& map   = value.asValueMap();
+            auto begin  = static_cast<uint32_t>(items.size());
+            entry.bits  = begin;
+            entry.count = static_cast<uint32_t>(map.size());
+            items.resize(items.size() + map.size());
+            uint32_t i = 0;
+            for (auto&& [key, element] : map)
+            {
+                MapItem item{addString(key), 0};
+                item.value         = addValue(element);
+                items[begin + i++] = item;
+            }
+            break;
+        }
+        case Value::Type::INT_KEY_MAP:
+        {
+            auto& map   = value.asIntKeyMap();
+            auto begin  = static_cast<uint32_t>(items.size());
+            entry.bits  = begin;
+            entry.count = static_cast<uint32_t>(map.size());
+            items.resize(items.size() + map.size());
+            uint32_t i = 0;
+            for (auto&& [key, element] : map)
+            {
+                MapItem item{{static_cast<uint32_t>(key), 0}, 0};
+                item.value         = addValue(element);
+                items[begin + i++] = item;
+            }
+            break;
+        }
+        default:
+            entry.type = static_cast<uint32_t>(Value::Type::NONE);
+            break;
+        }
+        values[index] = entry;
+    }
+
+    std::vector<ValueEntry> values;
+    std::vector<MapItem> items;
+    std::string strings;
+};
+
+bool TMXBundle::write(std::string_view fullPath, const TMXMapInfo* mapInfo, std::string_view mapDir)
+{
+    BlobWriter writer;
+    TableWriter tables;
+    std::vector<AnimationEntry> animations;
+    std::vector<TMXTileAnimFrame> frames;
+
+    auto& tilesets     = mapInfo->getTilesets();
+    auto& layers       = mapInfo->getLayers();
+    auto& objectGroups = mapInfo->getObjectGroups();
+
+    writer.write(FileHeader{});
+    writer.align(BLOB_ALIGNMENT);
+    const size_t layerOffset = writer.size();
+    for (size_t i = 0; i < layers.size(); ++i)
+        writer.write(LayerEntry{});
+
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        auto layer   = layers.at(i);
+        auto tileCount = static_cast<size_t>(layer->_layerSize.width * layer->_layerSize.height);
+
+        size_t tilesOffset = 0;
+        if (layer->_tiles && tileCount)
+        {
+            writer.align(BLOB_ALIGNMENT);
+            tilesOffset = writer.writeBytes(layer->_tiles, tileCount * sizeof(uint32_t));
+        }
+
+        auto entry         = writer.at<LayerEntry>(layerOffset + i * sizeof(LayerEntry));
+        entry->name        = tables.addString(layer->_name);
+        entry->layerSize[0] = layer->_layerSize.width;
+        entry->layerSize[1] = layer->_layerSize.height;
+        entry->offset[0]    = layer->_offset.x;
+        entry->offset[1]    = layer->_offset.y;
+        entry->tilesOffset  = static_cast<uint32_t>(tilesOffset);
+        entry->properties   = tables.addValue(Value(layer->_properties));
+        entry->visible      = layer->_visible;
+        entry->opacity      = layer->_opacity;
+    }
+
+    writer.align(BLOB_ALIGNMENT);
+    const size_t tilesetOffset = writer.size();
+    for (auto tileset : tilesets)
+    {
+        // file names in the map directory are stored relative to it
+        std::string_view sourceImage = tileset->_sourceImage;
+        const bool relative =
+            !mapDir.empty() && sourceImage.size() > mapDir.size() && sourceImage.starts_with(mapDir);
+        if (relative)
+            sourceImage.remove_prefix(mapDir.size());
+
+        TilesetEntry entry{};
+        entry.name                = tables.addString(tileset->_name);
+        entry.sourceImage         = tables.addString(sourceImage);
+        entry.originSourceImage   = tables.addString(tileset->_originSourceImage);
+        entry.firstGid            = tileset->_firstGid;
+        entry.spacing             = tileset->_spacing;
+        entry.margin              = tileset->_margin;
+        entry.relativeSourceImage = relative;
+        entry.tileSize[0]         = tileset->_tileSize.width;
+        entry.tileSize[1]         = tileset->_tileSize.height;
+        entry.tileOffset[0]       = tileset->_tileOffset.x;
+        entry.tileOffset[1]       = tileset->_tileOffset.y;
+        entry.imageSize[0]        = tileset->_imageSize.width;
+        entry.imageSize[1]        = tileset->_imageSize.height;
+        entry.animationBegin      = static_cast<uint32_t>(animations.size());
+        entry.animationCount      = static_cast<uint32_t>(tileset->_animationInfo.size());
+        for (auto&& [gid, info] : tileset->_animationInfo)
+        {
+            animations.emplace_back(AnimationEntry{info->_tileID, static_cast<uint32_t>(frames.size()),
+                                                   static_cast<uint32_t>(info->_frames.size())});
+            frames.insert(frames.end(), info->_frames.begin(), info->_frames.end());
+        }
+        writer.write(entry);
+    }
+
+    writer.align(BLOB_ALIGNMENT);
+    const size_t objectGroupOffset = writer.size();
+    for (auto group : objectGroups)
+    {
+        ObjectGroupEntry entry{};
+        entry.name              = tables.addString(group->getGroupName());
+        entry.positionOffset[0] = group->getPositionOffset().x;
+        entry.positionOffset[1] = group->getPositionOffset().y;
+        entry.properties        = tables.addValue(Value(group->getProperties()));
+        entry.objects           = tables.addValue(Value(group->getObjects()));
+        writer.write(entry);
+    }
+
+    const uint32_t properties = tables.addValue(Value(mapInfo->getProperties()));
+    const uint32_t tileProperties =
+        tables.addValue(Value(mapInfo->getTileProperties()));
+
+    writer.align(BLOB_ALIGNMENT);
+    const size_t animationOffset = writer.writeBytes(animations.data(), animations.size() * sizeof(AnimationEntry));
+    writer.align(BLOB_ALIGNMENT);
+    const size_t frameOffset = writer.writeBytes(frames.data(), frames.size() * sizeof(TMXTileAnimFrame));
+    writer.align(BLOB_ALIGNMENT);
+    const size_t valueOffset = writer.writeBytes(tables.values.data(), tables.values.size() * sizeof(ValueEntry));
+    writer.align(BLOB_ALIGNMENT);
+    const size_t mapItemOffset = writer.writeBytes(tables.items.data(), tables.items.size() * sizeof(MapItem));
+    const size_t stringPoolOffset = writer.writeBytes(tables.strings.data(), tables.strings.size());
+
+    auto header = writer.at<FileHeader>(0);
+    memcpy(header->magic, TMXB_MAGIC, sizeof(TMXB_MAGIC));
+    header->version           = VERSION;
+    header->orientation       = mapInfo->getOrientation();
+    header->staggerAxis       = mapInfo->getStaggerAxis();
+    header->staggerIndex      = mapInfo->getStaggerIndex();
+    header->hexSideLength     = mapInfo->getHexSideLength();
+    header->mapSize[0]        = mapInfo->getMapSize().width;
+    header->mapSize[1]        = mapInfo->getMapSize().height;
+    header->tileSize[0]       = mapInfo->getTileSize().width;
+    header->tileSize[1]       = mapInfo->getTileSize().height;
+    header->properties        = properties;
+    header->tileProperties    = tileProperties;
+    header->tilesetCount      = static_cast<uint32_t>(tilesets.size());
+    header->tilesetOffset     = static_cast<uint32_t>(tilesetOffset);
+    header->layerCount        = static_cast<uint32_t>(layers.size());
+    header->layerOffset       = static_cast<uint32_t>(layerOffset);
+    header->objectGroupCount  = static_cast<uint32_t>(objectGroups.size());
+    header->objectGroupOffset = static_cast<uint32_t>(objectGroupOffset);
+    header->animationCount    = static_cast<uint32_t>(animations.size());
+    header->animationOffset   = static_cast<uint32_t>(animationOffset);
+    header->frameCount        = static_cast<uint32_t>(frames.size());
+    header->frameOffset       = static_cast<uint32_t>(frameOffset);
+    header->valueCount        = static_cast<uint32_t>(tables.values.size());
+    header->valueOffset       = static_cast<uint32_t>(valueOffset);
+    header->mapItemCount      = static_cast<uint32_t>(tables.items.size());
+    header->mapItemOffset     = static_cast<uint32_t>(mapItemOffset);
+    header->stringPoolOffset  = static_cast<uint32_t>(stringPoolOffset);
+    header->stringPoolSize    = static_cast<uint32_t>(tables.strings.size());
+    header->fileSize          = static_cast<uint32_t>(writer.size());
+
+    return FileUtils::writeBinaryToFile(writer.data(), writer.size(), fullPath);
+}
+
+bool TMXBundle::convert(std::string_view srcPath, std::string_view dstFullPath)
+{
+    auto mapInfo = TMXMapInfo::create(srcPath);
+    if (!mapInfo)
+    {
+        AXLOGW("TMXBundle: failed to convert '{}'", srcPath);
+        return false;
+    }
+
+    // the parser prefixes the image names with the directory of the map file name as it was given
+    std::string_view mapDir = srcPath;
+    auto slash              = mapDir.find_last_of('/');
+    mapDir                  = slash != std::string_view::npos ? mapDir.substr(0, slash + 1) : std::string_view{};
+    return write(dstFullPath, mapInfo, mapDir);
+}
+
+TMXBundle::~TMXBundle()
+{
+    clear();
+}
+
+bool TMXBundle::load(std::string_view path)
+{
+    clear();
+
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
+    if (fullPath.empty())
+        return false;
+
+    std::error_code error;
+    _mapping.map(fullPath, error);
+    if (!error && _mapping.size() > 0)
+    {
+        _data = reinterpret_cast<const uint8_t*>(_mapping.data());
+        _size = _mapping.size();
+    }
+    else
+    {
+        // not a regular file, e.g. in the apk
+        _buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+        _data   = _buffer.getBytes();
+        _size   = static_cast<size_t>(_buffer.getSize());
+    }
+
+    if (!_data || !validate())
+    {
+        AXLOGW("TMXBundle: '{}' is not a valid tmxb file", path);
+        clear();
+        return false;
+    }
+
+    // same as the parser, the images are relative to the map file name as it was given
+    auto slash = path.find_last_of('/');
+    _mapDir    = slash != std::string_view::npos ? path.substr(0, slash + 1) : std::string_view{};
+    return true;
+}
+
+void TMXBundle::clear()
+{
+    _mapping.unmap();
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _mapDir.clear();
+}
+
+bool TMXBundle::validate() const
+{
+    if (_size < sizeof(FileHeader))
+        return false;
+
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    if (memcmp(header->magic, TMXB_MAGIC, sizeof(TMXB_MAGIC)) != 0 || header->version != VERSION ||
+        header->fileSize != _size)
+        return false;
+
+    auto inFile = [this](size_t offset, size_t size) { return offset <= _size && size <= _size - offset; };
+    if (!inFile(header->tilesetOffset, size_t{header->tilesetCount} * sizeof(TilesetEntry)) ||
+        !inFile(header->layerOffset, size_t{header->layerCount} * sizeof(LayerEntry)) ||
+        !inFile(header->objectGroupOffset, size_t{header->objectGroupCount} * sizeof(ObjectGroupEntry)) ||
+        !inFile(header->animationOffset, size_t{header->animationCount} * sizeof(AnimationEntry)) ||
+        !inFile(header->frameOffset, size_t{header->frameCount} * sizeof(TMXTileAnimFrame)) ||
+        !inFile(header->valueOffset, size_t{header->valueCount} * sizeof(ValueEntry)) ||
+        !inFile(header->mapItemOffset, size_t{header->mapItemCount} * sizeof(MapItem)) ||
+        !inFile(header->stringPoolOffset, header->stringPoolSize))
+        return false;
+
+    // the tiles are read straight out of the mapping, the strings and values are checked when they are read
+    auto layers = reinterpret_cast<const LayerEntry*>(_data + header->layerOffset);
+    for (uint32_t i = 0; i < header->layerCount; ++i)
+    {
+        auto& layer = layers[i];
+        if (!(layer.layerSize[0] >= 0 && layer.layerSize[1] >= 0))
+            return false;
+        auto tileCount = static_cast<size_t>(layer.layerSize[0]) * static_cast<size_t>(layer.layerSize[1]);
+        if (layer.tilesOffset && (layer.tilesOffset % BLOB_ALIGNMENT != 0 ||
+                                  tileCount > _size / sizeof(uint32_t) ||
+                                  !inFile(layer.tilesOffset, tileCount * sizeof(uint32_t))))
+            return false;
+    }
+
+    auto tilesets = reinterpret_cast<const TilesetEntry*>(_data + header->tilesetOffset);
+    for (uint32_t i = 0; i < header->tilesetCount; ++i)
+    {
+        auto& tileset = tilesets[i];
+        if (tileset.animationBegin > header->animationCount ||
+            tileset.animationCount > header->animationCount - tileset.animationBegin)
+            return false;
+    }
+
+    auto animations = reinterpret_cast<const AnimationEntry*>(_data + header->animationOffset);
+    for (uint32_t i = 0; i < header->animationCount; ++i)
+    {
+        auto& animation = animations[i];
+        if (animation.frameBegin > header->frameCount ||
+            animation.frameCount > header->frameCount - animation.frameBegin)
+            return false;
+    }
+    return true;
+}
+
+bool TMXBundle::readString(const StringRef& ref, std::string& str) const
+{
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    if (ref.offset > header->stringPoolSize || ref.length > header->stringPoolSize - ref.offset)
+        return false;
+    str.assign(reinterpret_cast<const char*>(_data + header->stringPoolOffset + ref.offset), ref.length);
+    return true;
+}
+
+bool TMXBundle::readValue(uint32_t index, Value& value, uint32_t depth) const
+{
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    if (index >= header->valueCount || depth > MAX_VALUE_DEPTH)
+        return false;
+
+    auto& entry = reinterpret_cast<const ValueEntry*>(_data + header->valueOffset)[index];
+    auto items  = reinterpret_cast<const MapItem*>(_data + header->mapItemOffset);
+    auto mapItemsInTable = [&]() {
+        return entry.bits <= header->mapItemCount && entry.count <= header->mapItemCount - entry.bits;
+    };
+
+    switch (static_cast<Value::Type>(entry.type))
+    {
+    case Value::Type::NONE:
+        value = Value::Null;
+        return true;
+    case Value::Type::INT_I32:
+        value = static_cast<int>(entry.bits);
+        return true;
+    case Value::Type::INT_UI32:
+        value = static_cast<unsigned int>(entry.bits);
+        return true;
+    case Value::Type::INT_I64:
+        value = static_cast<int64_t>(entry.bits);
+        return true;
+    case Value::Type::INT_UI64:
+        value = static_cast<uint64_t>(entry.bits);
+        return true;
+    case Value::Type::FLOAT:
+    {
+        float v;
+        memcpy(&v, &entry.bits, sizeof(v));
+        value = v;
+        return true;
+    }
+    case Value::Type::DOUBLE:
+    {
+        double v;
+        memcpy(&v, &entry.bits, sizeof(v));
+        value = v;
+        return true;
+    }
+    case Value::Type::BOOLEAN:
+        value = entry.bits != 0;
+        return true;
+    case Value::Type::STRING:
+    {
+        std::string str;
+        if (entry.bits > UINT32_MAX || !readString(StringRef{static_cast<uint32_t>(entry.bits), entry.count}, str))
+            return false;
+        value = std::move(str);
+        return true;
+    }
+    case Value::Type::VECTOR:
+    {
+        if (entry.bits > header->valueCount || entry.count > header->valueCount - entry.bits)
+            return false;
+        ValueVector vec(entry.count);
+        for (uint32_t i = 0; i < entry.count; ++i)
+        {
+            if (!readValue(static_cast<uint32_t>(entry.bits) + i, vec[i], depth + 1))
+                return false;
+        }
+        value = std::move(vec);
+        return true;
+    }
+    case Value::Type::MAP:
+    {
+        if (!mapItemsInTable())
+            return false;
+        ValueMap map;
+        map.reserve(entry.count);
+        std::string key;
+        for (uint32_t i = 0; i < entry.count; ++i)
+        {
+            auto& item = items[entry.bits + i];
+            if (!readString(item.key, key) || !readValue(item.value, map[key], depth + 1))
+                return false;
+        }
+        value = std::move(map);
+        return true;
+    }
+    case Value::Type::INT_KEY_MAP:
+    {
+        if (!mapItemsInTable())
+            return false;
+        ValueMapIntKey map;
+        map.reserve(entry.count);
+        for (uint32_t i = 0; i < entry.count; ++i)
+        {
+            auto& item = items[entry.bits + i];
+            if (!readValue(item.value, map[static_cast<int>(item.key.offset)], depth + 1))
+                return false;
+        }
+        value = std::move(map);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool TMXBundle::loadMapInfo(TMXMapInfo* mapInfo) const
+{
+    if (!_data)
+        return false;
+
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    mapInfo->setOrientation(header->orientation);
+    mapInfo->setStaggerAxis(header->staggerAxis);
+    mapInfo->setStaggerIndex(header->staggerIndex);
+    mapInfo->setHexSideLength(header->hexSideLength);
+    mapInfo->setMapSize(Vec2(header->mapSize[0], header->mapSize[1]));
+    mapInfo->setTileSize(Vec2(header->tileSize[0], header->tileSize[1]));
+
+    Value properties;
+    Value tileProperties;
+    if (!readValue(header->properties, properties) || properties.getType() != Value::Type::MAP ||
+        !readValue(header->tileProperties, tileProperties) || tileProperties.getType() != Value::Type::INT_KEY_MAP)
+        return false;
+    mapInfo->setProperties(properties.asValueMap());
+    mapInfo->setTileProperties(tileProperties.asIntKeyMap());
+
+    auto animations = reinterpret_cast<const AnimationEntry*>(_data + header->animationOffset);
+    auto frames     = reinterpret_cast<const TMXTileAnimFrame*>(_data + header->frameOffset);
+    auto tilesets   = reinterpret_cast<const TilesetEntry*>(_data + header->tilesetOffset);
+    for (uint32_t i = 0; i < header->tilesetCount; ++i)
+    {
+        auto& entry  = tilesets[i];
+        auto tileset = new TMXTilesetInfo();
+        mapInfo->getTilesets().pushBack(tileset);
+        tileset->release();
+
+        if (!readString(entry.name, tileset->_name) || !readString(entry.sourceImage, tileset->_sourceImage) ||
+            !readString(entry.originSourceImage, tileset->_originSourceImage))
+            return false;
+        if (entry.relativeSourceImage)
+            tileset->_sourceImage.insert(0, _mapDir);
+        tileset->_firstGid   = entry.firstGid;
+        tileset->_spacing    = entry.spacing;
+        tileset->_margin     = entry.margin;
+        tileset->_tileSize   = Vec2(entry.tileSize[0], entry.tileSize[1]);
+        tileset->_tileOffset = Vec2(entry.tileOffset[0], entry.tileOffset[1]);
+        tileset->_imageSize  = Vec2(entry.imageSize[0], entry.imageSize[1]);
+
+        for (uint32_t k = 0; k < entry.animationCount; ++k)
+        {
+            auto& animation = animations[entry.animationBegin + k];
+            auto info       = TMXTileAnimInfo::create(animation.tileID);
+            info->_frames.assign(frames + animation.frameBegin, frames + animation.frameBegin + animation.frameCount);
+            tileset->_animationInfo.insert(animation.tileID, info);
+        }
+    }
+
+    auto layers = reinterpret_cast<const LayerEntry*>(_data + header->layerOffset);
+    for (uint32_t i = 0; i < header->layerCount; ++i)
+    {
+        auto& entry = layers[i];
+        auto layer  = new TMXLayerInfo();
+        mapInfo->getLayers().pushBack(layer);
+        layer->release();
+
+        Value layerProperties;
+        if (!readString(entry.name, layer->_name) || !readValue(entry.properties, layerProperties) ||
+            layerProperties.getType() != Value::Type::MAP)
+            return false;
+        layer->setProperties(std::move(layerProperties.asValueMap()));
+        layer->_layerSize = Vec2(entry.layerSize[0], entry.layerSize[1]);
+        layer->_offset    = Vec2(entry.offset[0], entry.offset[1]);
+        layer->_visible   = entry.visible != 0;
+        layer->_opacity   = entry.opacity;
+
+        // the layer takes ownership of the tiles and modifies them, so they are copied out of the mapping
+        auto tileCount = static_cast<size_t>(entry.layerSize[0]) * static_cast<size_t>(entry.layerSize[1]);
+        if (entry.tilesOffset && tileCount)
+        {
+            layer->_tiles = axstd::pod_vector<uint32_t>(tileCount).release_pointer();
+            memcpy(layer->_tiles, _data + entry.tilesOffset, tileCount * sizeof(uint32_t));
+        }
+    }
+
+    auto groups = reinterpret_cast<const ObjectGroupEntry*>(_data + header->objectGroupOffset);
+    for (uint32_t i = 0; i < header->objectGroupCount; ++i)
+    {
+        auto& entry = groups[i];
+        auto group  = new TMXObjectGroup();
+        mapInfo->getObjectGroups().pushBack(group);
+        group->release();
+
+        std::string name;
+        Value groupProperties;
+        Value objects;
+        if (!readString(entry.name, name) || !readValue(entry.properties, groupProperties) ||
+            groupProperties.getType() != Value::Type::MAP || !readValue(entry.objects, objects) ||
+            objects.getType() != Value::Type::VECTOR)
+            return false;
+        group->setGroupName(name);
+        group->setPositionOffset(Vec2(entry.positionOffset[0], entry.positionOffset[1]));
+        group->setProperties(groupProperties.asValueMap());
+        group->setObjects(objects.asValueVector());
+    }
+    return true;
+}
+
+}  // namespace ax
@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <string>
+
+#include "base/Data.h"
+#include "base/Value.h"
+#include "mio/mio.hpp"
+
+namespace ax
+{
+
+/**
+ * @addtogroup tilemap_parallax_nodes
+ * @{
+ */
+
+class TMXMapInfo;
+
+/**
+ * @brief TMXBundle, a preprocessed binary tile map format, the .tmxb files.
+ *
+ * The tiles of every layer are stored as the uncompressed gid arrays FastTMXLayer works on, aligned to
+ * BLOB_ALIGNMENT, so loading a layer is a single copy out of the mapping instead of the XML parsing, base64
+ * decoding and decompression of a .tmx file. The tilesets, object groups and properties are stored in
+ * indexed tables sharing one string pool. On platforms where the file isn't mappable, e.g. the assets of an
+ * android apk, the file is read into memory instead.
+ *
+ * A .tmxb file is created from a .tmx map with TMXBundle::convert, it is loaded with FastTMXTiledMap::create
+ * like a .tmx map.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL TMXBundle
+{
+public:
+    /** The file format version, files of other versions are rejected. */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The alignment of the tile arrays in the file. */
+    static constexpr uint32_t BLOB_ALIGNMENT = 16;
+
+    /** The max nesting depth of the property values. */
+    static constexpr uint32_t MAX_VALUE_DEPTH = 32;
+
+    /**
+     * Write a parsed map to a .tmxb file.
+     *
+     * @param mapDir the directory the tileset image file names are made relative to, so the file can be moved
+     * along with its images
+     */
+    static bool write(std::string_view fullPath, const TMXMapInfo* mapInfo, std::string_view mapDir = "");
+
+    /** Convert a .tmx map to a .tmxb file. */
+    static bool convert(std::string_view srcPath, std::string_view dstFullPath);
+
+    TMXBundle() = default;
+    ~TMXBundle();
+
+    TMXBundle(const TMXBundle&)            = delete;
+    TMXBundle& operator=(const TMXBundle&) = delete;
+
+    /** Map a .tmxb file and validate its tables. */
+    bool load(std::string_view path);
+
+    /** Unmap the file. */
+    void clear();
+
+    bool isLoaded() const { return _data != nullptr; }
+
+    /** Fill the map info with the map, its tilesets, layers and object groups. */
+    bool loadMapInfo(TMXMapInfo* mapInfo) const;
+
+protected:
+    struct FileHeader;
+    struct StringRef;
+    struct TilesetEntry;
+    struct AnimationEntry;
+    struct LayerEntry;
+    struct ObjectGroupEntry;
+    struct ValueEntry;
+    struct MapItem;
+    struct TableWriter;
+
+    bool validate() const;
+    bool readString(const StringRef& ref, std::string& str) const;
+    bool readValue(uint32_t index, Value& value, uint32_t depth = 0) const;
+
+    std::string _mapDir;
+
+    mio::mmap_source _mapping;
+    Data _buffer;  // used when the file can't be mapped
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+};
+
+// end of tilemap_parallax_nodes group
+/// @}
+
+}  // namespace ax
@@ -29,6 +29,7 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "2d/TMXXMLParser.h"
+#include "2d/TMXBundle.h"
 #include <unordered_map>
 #include <sstream>
 #include <regex>
@@ -151,6 +152,13 @@ bool TMXMapInfo::initWithXML(std::string_view tmxString, std::string_view resour
 bool TMXMapInfo::initWithTMXFile(std::string_view tmxFile)
 {
     internalInit(tmxFile, "");
+
+    // preprocessed maps are read out of the mapped file, nothing to parse
+    if (FileUtils::getPathExtension(tmxFile) == ".tmxb")
+    {
+        TMXBundle bundle;
+        return bundle.load(tmxFile) && bundle.loadMapInfo(this);
+    }
     return parseXMLFile(_TMXFileName);
 }
 
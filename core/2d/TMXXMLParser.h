@@ -287,6 +287,7 @@ public:
     bool parseXMLString(std::string_view xmlString);
 
     ValueMapIntKey& getTileProperties() { return _tileProperties; };
+    const ValueMapIntKey& getTileProperties() const { return _tileProperties; };
     void setTileProperties(const ValueMapIntKey& tileProperties) { _tileProperties = tileProperties; }
 
     /// map orientation
@@ -0,0 +1,377 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/TransformBatch.h"
+#include "2d/Node.h"
+#include "base/Director.h"
+
+namespace ax
+{
+
+namespace
+{
+// 4 float lanes, the local transform kernel is written once against these
+#if defined(AX_SSE_INTRINSICS)
+using Lanes = __m128;
+inline Lanes load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void store(float* p, Lanes v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline Lanes splat(float v)
+{
+    return _mm_set1_ps(v);
+}
+inline Lanes add(Lanes a, Lanes b)
+{
+    return _mm_add_ps(a, b);
+}
+inline Lanes sub(Lanes a, Lanes b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline Lanes mul(Lanes a, Lanes b)
+{
+    return _mm_mul_ps(a, b);
+}
+#elif defined(AX_NEON_INTRINSICS)
+using Lanes = float32x4_t;
+inline Lanes load(const float* p)
+{
+    return vld1q_f32(p);
+}
+inline void store(float* p, Lanes v)
+{
+    vst1q_f32(p, v);
+}
+inline Lanes splat(float v)
+{
+    return vdupq_n_f32(v);
+}
+inline Lanes add(Lanes a, Lanes b)
+{
+    return vaddq_f32(a, b);
+}
+inline Lanes sub(Lanes a, Lanes b)
+{
+    return vsubq_f32(a, b);
+}
+inline Lanes mul(Lanes a, Lanes b)
+{
+    return vmulq_f32(a, b);
+}
+#else
+struct Lanes
+{
+    float v[TransformBatch::LANES];
+};
+inline Lanes load(const float* p)
+{
+    return Lanes{{p[0], p[1], p[2], p[3]}};
+}
+inline void store(float* p, const Lanes& a)
+{
+    for (int i = 0; i < TransformBatch::LANES; ++i)
+        p[i] = a.v[i];
+}
+inline Lanes splat(float v)
+{
+    return Lanes{{v, v, v, v}};
+}
+inline Lanes add(const Lanes& a, const Lanes& b)
+{
+    return Lanes{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+}
+inline Lanes sub(const Lanes& a, const Lanes& b)
+{
+    return Lanes{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+}
+inline Lanes mul(const Lanes& a, const Lanes& b)
+{
+    return Lanes{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+}
+#endif
+
+bool isAffine2D(const Mat4& m)
+{
+    return m.m[2] == 0.0f && m.m[6] == 0.0f && m.m[8] == 0.0f && m.m[9] == 0.0f && m.m[3] == 0.0f &&
+           m.m[7] == 0.0f && m.m[11] == 0.0f && m.m[15] == 1.0f;
+}
+}  // namespace
+
+bool TransformBatch::isBatchable(const Node* node)
+{
+    return node->_transformBatchable && !node->_additionalTransform && node->_skewX == 0.0f &&
+           node->_skewY == 0.0f && node->_rotationZ_X == node->_rotationZ_Y;
+}
+
+void TransformBatch::computeLocalTransforms(Node* const* nodes, size_t count)
+{
+    enum Input
+    {
+        QX,
+        QY,
+        QZ,
+        QW,
+        SX,
+        SY,
+        SZ,
+        TX,
+        TY,
+        TZ,
+        AX,
+        AY,
+        INPUT_COUNT
+    };
+    enum Output
+    {
+        M0,
+        M1,
+        M2,
+        M4,
+        M5,
+        M6,
+        M8,
+        M9,
+        M10,
+        M12,
+        M13,
+        M14,
+        OUTPUT_COUNT
+    };
+    static const int OUTPUT_INDICES[OUTPUT_COUNT] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14};
+
+    alignas(16) float in[INPUT_COUNT][LANES];
+    alignas(16) float out[OUTPUT_COUNT][LANES];
+
+    for (size_t first = 0; first < count; first += LANES)
+    {
+        int lanes = static_cast<int>((std::min)(count - first, static_cast<size_t>(LANES)));
+
+        // gather, the unused lanes of the last iteration compute an identity
+        for (int i = 0; i < LANES; ++i)
+        {
+            if (i >= lanes)
+            {
+                for (int k = 0; k < INPUT_COUNT; ++k)
+                    in[k][i] = (k == QW || k == SX || k == SY || k == SZ) ? 1.0f : 0.0f;
+                continue;
+            }
+
+            auto node = nodes[first + i];
+            AXASSERT(isBatchable(node), "The local transform of the node can't be batched");
+            auto& q   = node->_rotationQuat;
+            in[QX][i] = q.x;
+            in[QY][i] = q.y;
+            in[QZ][i] = q.z;
+            in[QW][i] = q.w;
+            in[SX][i] = node->_scaleX;
+            in[SY][i] = node->_scaleY;
+            in[SZ][i] = node->_scaleZ;
+            in[TX][i] = node->_position.x;
+            in[TY][i] = node->_position.y;
+            in[TZ][i] = node->_positionZ;
+            if (node->_ignoreAnchorPointForPosition)
+            {
+                in[TX][i] += node->_anchorPointInPoints.x;
+                in[TY][i] += node->_anchorPointInPoints.y;
+            }
+            in[AX][i] = node->_anchorPointInPoints.x;
+            in[AY][i] = node->_anchorPointInPoints.y;
+        }
+
+        // translation * rotation * scale, then the anchor point, like Node::getNodeToParentTransform
+        Lanes qx = load(in[QX]), qy = load(in[QY]), qz = load(in[QZ]), qw = load(in[QW]);
+        Lanes x2 = add(qx, qx), y2 = add(qy, qy), z2 = add(qz, qz);
+        Lanes xx2 = mul(qx, x2), yy2 = mul(qy, y2), zz2 = mul(qz, z2);
+        Lanes xy2 = mul(qx, y2), xz2 = mul(qx, z2), yz2 = mul(qy, z2);
+        Lanes wx2 = mul(qw, x2), wy2 = mul(qw, y2), wz2 = mul(qw, z2);
+        Lanes one = splat(1.0f);
+
+        Lanes sx = load(in[SX]), sy = load(in[SY]), sz = load(in[SZ]);
+        Lanes m0  = mul(sub(sub(one, yy2), zz2), sx);
+        Lanes m1  = mul(add(xy2, wz2), sx);
+        Lanes m2  = mul(sub(xz2, wy2), sx);
+        Lanes m4  = mul(sub(xy2, wz2), sy);
+        Lanes m5  = mul(sub(sub(one, xx2), zz2), sy);
+        Lanes m6  = mul(add(yz2, wx2), sy);
+        Lanes m8  = mul(add(xz2, wy2), sz);
+        Lanes m9  = mul(sub(yz2, wx2), sz);
+        Lanes m10 = mul(sub(sub(one, xx2), yy2), sz);
+
+        Lanes ax = load(in[AX]), ay = load(in[AY]);
+        store(out[M0], m0);
+        store(out[M1], m1);
+        store(out[M2], m2);
+        store(out[M4], m4);
+        store(out[M5], m5);
+        store(out[M6], m6);
+        store(out[M8], m8);
+        store(out[M9], m9);
+        store(out[M10], m10);
+        store(out[M12], sub(load(in[TX]), add(mul(m0, ax), mul(m4, ay))));
+        store(out[M13], sub(load(in[TY]), add(mul(m1, ax), mul(m5, ay))));
+        store(out[M14], sub(load(in[TZ]), add(mul(m2, ax), mul(m6, ay))));
+
+        // scatter
+        for (int i = 0; i < lanes; ++i)
+        {
+            auto node = nodes[first + i];
+            auto& m   = node->_transform.m;
+            for (int k = 0; k < OUTPUT_COUNT; ++k)
+                m[OUTPUT_INDICES[k]] = out[k][i];
+            m[3]  = m[7] = m[11] = 0.0f;
+            m[15] = 1.0f;
+
+            node->_transformDirty = node->_additionalTransformDirty = false;
+        }
+    }
+}
+
+void TransformBatch::multiply(const Mat4& parent, const Mat4& local, Mat4& dst)
+{
+    if (!isAffine2D(local))
+    {
+        Mat4::multiply(parent, local, &dst);
+        return;
+    }
+
+    // the columns of dst are combinations of the columns of parent, m[2], m[6], m[8] and m[9] of local are 0
+    const float* p = parent.m;
+    const float* l = local.m;
+#if defined(AX_SSE_INTRINSICS)
+    __m128 p0 = _mm_loadu_ps(p), p1 = _mm_loadu_ps(p + 4), p2 = _mm_loadu_ps(p + 8), p3 = _mm_loadu_ps(p + 12);
+    _mm_storeu_ps(dst.m, _mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(l[0])), _mm_mul_ps(p1, _mm_set1_ps(l[1]))));
+    _mm_storeu_ps(dst.m + 4, _mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(l[4])), _mm_mul_ps(p1, _mm_set1_ps(l[5]))));
+    _mm_storeu_ps(dst.m + 8, _mm_mul_ps(p2, _mm_set1_ps(l[10])));
+    __m128 c3 = _mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(l[12])), _mm_mul_ps(p1, _mm_set1_ps(l[13])));
+    _mm_storeu_ps(dst.m + 12, _mm_add_ps(_mm_add_ps(c3, _mm_mul_ps(p2, _mm_set1_ps(l[14]))), p3));
+#elif defined(AX_NEON_INTRINSICS)
+    float32x4_t p0 = vld1q_f32(p), p1 = vld1q_f32(p + 4), p2 = vld1q_f32(p + 8), p3 = vld1q_f32(p + 12);
+    vst1q_f32(dst.m, vmlaq_n_f32(vmulq_n_f32(p0, l[0]), p1, l[1]));
+    vst1q_f32(dst.m + 4, vmlaq_n_f32(vmulq_n_f32(p0, l[4]), p1, l[5]));
+    vst1q_f32(dst.m + 8, vmulq_n_f32(p2, l[10]));
+    vst1q_f32(dst.m + 12, vaddq_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(p0, l[12]), p1, l[13]), p2, l[14]), p3));
+#else
+    float c[16];
+    for (int r = 0; r < 4; ++r)
+    {
+        c[r]      = p[r] * l[0] + p[4 + r] * l[1];
+        c[4 + r]  = p[r] * l[4] + p[4 + r] * l[5];
+        c[8 + r]  = p[8 + r] * l[10];
+        c[12 + r] = p[r] * l[12] + p[4 + r] * l[13] + p[8 + r] * l[14] + p[12 + r];
+    }
+    dst.set(c);
+#endif
+}
+
+void TransformBatch::invert(const Mat4& m, Mat4& dst)
+{
+    const float* s = m.m;
+    float det      = s[0] * s[5] - s[1] * s[4];
+    if (!isAffine2D(m) || det == 0.0f || s[10] == 0.0f)
+    {
+        dst = m.getInversed();
+        return;
+    }
+
+    float inv = 1.0f / det;
+    float a = s[5] * inv, b = -s[1] * inv, c = -s[4] * inv, d = s[0] * inv;
+    float z = 1.0f / s[10];
+
+    float r[16] = {a, b, 0.0f, 0.0f, c, d, 0.0f, 0.0f, 0.0f, 0.0f, z, 0.0f};
+    r[12] = -(a * s[12] + c * s[13]);
+    r[13] = -(b * s[12] + d * s[13]);
+    r[14] = -s[14] * z;
+    r[15] = 1.0f;
+    dst.set(r);
+}
+
+void TransformBatch::addChildren(Node* parent, uint32_t flags)
+{
+    for (auto child : parent->_children)
+    {
+        // the visit handles these subtrees itself, see Node::processParentFlags
+        if (!child->_visible || child->_usingNormalizedPosition || child->_staticBatch ||
+            !child->isVisitableByVisitingCamera())
+            continue;
+
+        uint32_t childFlags = flags;
+        childFlags |= (child->_transformUpdated ? Node::FLAGS_TRANSFORM_DIRTY : 0);
+        childFlags |= (child->_contentSizeDirty ? Node::FLAGS_CONTENT_SIZE_DIRTY : 0);
+        _nextLevel.emplace_back(Entry{child, childFlags});
+    }
+}
+
+void TransformBatch::update(Node* root, uint32_t flags)
+{
+    _frame        = root->_director->getTotalFrames() + 1;
+    _nodeCount    = 0;
+    _updatedCount = 0;
+    _batchedCount = 0;
+
+    root->_transformBatchFrame = _frame;
+
+    _nextLevel.clear();
+    addChildren(root, flags);
+
+    while (!_nextLevel.empty())
+    {
+        std::swap(_level, _nextLevel);
+        _nextLevel.clear();
+        _nodeCount += _level.size();
+
+        _dirty.clear();
+        for (auto&& entry : _level)
+        {
+            auto node = entry.node;
+            if ((entry.flags & Node::FLAGS_DIRTY_MASK) && node->_transformDirty && isBatchable(node))
+                _dirty.emplace_back(node);
+        }
+        computeLocalTransforms(_dirty.data(), _dirty.size());
+        _batchedCount += _dirty.size();
+
+        for (auto&& entry : _level)
+        {
+            auto node = entry.node;
+            if (entry.flags & Node::FLAGS_DIRTY_MASK)
+            {
+                // the local transforms of the other nodes are computed by their possibly overridden getter
+                multiply(node->_parent->_modelViewTransform, node->getNodeToParentTransform(),
+                         node->_modelViewTransform);
+                ++_updatedCount;
+            }
+            // a clean node keeps the world transform of the previous visit, it's valid too
+            node->_transformBatchFrame = _frame;
+
+            // a nested batch root updates its own subtree
+            if (!node->_transformBatch && !node->_children.empty())
+                addChildren(node, entry.flags);
+        }
+    }
+}
+
+}  // namespace ax
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "math/Math.h"
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+namespace ax
+{
+
+class Node;
+
+/**
+ Computes the transforms of the dirty nodes of a subtree level by level ahead of its visit, see
+ `Node::setTransformBatchRoot`. The local transforms of the plain nodes of a level are computed LANES nodes
+ at a time from structure of arrays, the world transforms are multiplied with an affine specialization for
+ the nodes which don't rotate out of the XY plane. The visit then uses the precomputed transforms.
+ Subtrees of invisible nodes, nodes not visited by the visiting camera and nodes using a normalized position
+ are left to the visit.
+*/
+class AX_DLL TransformBatch
+{
+public:
+    /**The number of local transforms computed per SIMD iteration.*/
+    static const int LANES = 4;
+
+    /**
+     * Compute the world transforms of the dirty descendants of a node.
+     * @param root The node whose descendants are updated, its own world transform must be up to date.
+     * @param flags The flags returned by `Node::processParentFlags` of the root.
+     */
+    void update(Node* root, uint32_t flags);
+
+    /**The number of nodes walked by the last update.*/
+    size_t getNodeCount() const { return _nodeCount; }
+    /**The number of world transforms computed by the last update.*/
+    size_t getUpdatedCount() const { return _updatedCount; }
+    /**The number of local transforms computed by the SIMD path in the last update.*/
+    size_t getBatchedCount() const { return _batchedCount; }
+
+    /**
+     * Compute the local transforms of nodes which can be batched, see `isBatchable`.
+     * Same result as `Node::getNodeToParentTransform`, which returns them afterwards.
+     */
+    static void computeLocalTransforms(Node* const* nodes, size_t count);
+
+    /**Whether the local transform of the node is made of a position, anchor, quaternion rotation and scale only.*/
+    static bool isBatchable(const Node* node);
+
+    /**
+     * dst = parent * local, skipping the terms of an affine local transform rotating in the XY plane only,
+     * which is what the transforms of 2D nodes are. dst must not be local.
+     */
+    static void multiply(const Mat4& parent, const Mat4& local, Mat4& dst);
+
+    /**
+     * dst = the inverse of m, computed from its 2x2 and Z scale blocks for the transforms of 2D nodes.
+     * Like Mat4::getInversed, a non invertible matrix is copied as is.
+     */
+    static void invert(const Mat4& m, Mat4& dst);
+
+private:
+    struct Entry
+    {
+        Node* node;
+        uint32_t flags;  ///< the parent flags combined with the own dirty flags of the node
+    };
+
+    void addChildren(Node* parent, uint32_t flags);
+
+    std::vector<Entry> _level;
+    std::vector<Entry> _nextLevel;
+    std::vector<Node*> _dirty;
+
+    uint32_t _frame      = 0;
+    size_t _nodeCount    = 0;
+    size_t _updatedCount = 0;
+    size_t _batchedCount = 0;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
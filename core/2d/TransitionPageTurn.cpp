@@ -143,15 +143,19 @@ void TransitionPageTurn::onExit()
 
 ActionInterval* TransitionPageTurn::actionWithSize(const Vec2& vector)
 {
+    // the page is turned in the vertex shader of the grid
+    auto action = PageTurn3D::create(_duration, vector);
+    action->setShaderEffectEnabled(true);
+
     if (_back)
     {
         // Get hold of the PageTurn3DAction
-        return ReverseTime::create(PageTurn3D::create(_duration, vector));
+        return ReverseTime::create(action);
     }
     else
     {
         // Get hold of the PageTurn3DAction
-        return PageTurn3D::create(_duration, vector);
+        return action;
     }
 }
 
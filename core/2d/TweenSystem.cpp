@@ -0,0 +1,444 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/TweenSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "2d/Node.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/Macros.h"
+#include "base/Profiling.h"
+
+namespace ax
+{
+
+// removes the tweens matching pred by swapping the last ones in, returns how many were removed
+template <typename T, typename Pred>
+static size_t removeTweensIf(std::vector<T>& tweens, Pred&& pred)
+{
+    size_t removed = 0;
+    for (size_t i = tweens.size(); i-- > 0;)
+    {
+        if (pred(tweens[i]))
+        {
+            tweens[i] = tweens.back();
+            tweens.pop_back();
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+TweenSystem::~TweenSystem()
+{
+    stopAll();
+}
+
+template <typename Fn>
+void TweenSystem::forEachTrack(Fn&& fn)
+{
+    fn(_moves);
+    fn(_scales);
+    fn(_rotations);
+    fn(_fades);
+    fn(_tints);
+}
+
+template <typename Fn>
+void TweenSystem::forEachTrack(Fn&& fn) const
+{
+    fn(_moves);
+    fn(_scales);
+    fn(_rotations);
+    fn(_fades);
+    fn(_tints);
+}
+
+template <typename T>
+TweenSystem::TweenId TweenSystem::addTween(Track<T>& track,
+                                           Node* target,
+                                           float duration,
+                                           const T& from,
+                                           const T& delta,
+                                           tweenfunc::TweenType easing,
+                                           float easingParam)
+{
+    AXASSERT(target != nullptr, "target can't be nullptr!");
+    AXASSERT(easing != tweenfunc::CUSTOM_EASING, "TweenSystem doesn't support the custom easing");
+    if (target == nullptr)
+        return INVALID_TWEEN;
+
+    // like ActionManager, a new target is paused until it enters the scene
+    auto it = _targets.find(target);
+    if (it == _targets.end())
+    {
+        it = _targets.emplace(target, TargetState{0, !target->isRunning()}).first;
+        target->retain();
+    }
+    ++it->second.tweenCount;
+
+    TweenId id = _nextId++;
+    if (_nextId == INVALID_TWEEN)
+        _nextId = 1;
+
+    track.tweens.emplace_back(
+        Tween<T>{target, from, delta, 0.0f, (std::max)(duration, 0.0f), easingParam, easing, id, it->second.paused});
+    return id;
+}
+
+TweenSystem::TweenId TweenSystem::moveTo(Node* target,
+                                         float duration,
+                                         const Vec2& position,
+                                         tweenfunc::TweenType easing,
+                                         float easingParam)
+{
+    const Vec2 from = target ? target->getPosition() : Vec2::ZERO;
+    return addTween(_moves, target, duration, from, position - from, easing, easingParam);
+}
+
+TweenSystem::TweenId TweenSystem::moveBy(Node* target,
+                                         float duration,
+                                         const Vec2& deltaPosition,
+                                         tweenfunc::TweenType easing,
+                                         float easingParam)
+{
+    const Vec2 from = target ? target->getPosition() : Vec2::ZERO;
+    return addTween(_moves, target, duration, from, deltaPosition, easing, easingParam);
+}
+
+TweenSystem::TweenId TweenSystem::scaleTo(Node* target,
+                                          float duration,
+                                          float scaleX,
+                                          float scaleY,
+                                          tweenfunc::TweenType easing,
+                                          float easingParam)
+{
+    const Vec2 from = target ? Vec2(target->getScaleX(), target->getScaleY()) : Vec2::ONE;
+    return addTween(_scales, target, duration, from, Vec2(scaleX, scaleY) - from, easing, easingParam);
+}
+
+TweenSystem::TweenId TweenSystem::rotateTo(Node* target,
+                                           float duration,
+                                           float angle,
+                                           tweenfunc::TweenType easing,
+                                           float easingParam)
+{
+    // same as RotateTo::calculateAngles
+    float from = target ? target->getRotation() : 0.0f;
+    from       = from > 0 ? fmodf(from, 360.0f) : fmodf(from, -360.0f);
+    float diff = angle - from;
+    if (diff > 180)
+        diff -= 360;
+    if (diff < -180)
+        diff += 360;
+    return addTween(_rotations, target, duration, from, diff, easing, easingParam);
+}
+
+TweenSystem::TweenId TweenSystem::fadeTo(Node* target,
+                                         float duration,
+                                         uint8_t opacity,
+                                         tweenfunc::TweenType easing,
+                                         float easingParam)
+{
+    const float from = target ? static_cast<float>(target->getOpacity()) : 0.0f;
+    return addTween(_fades, target, duration, from, opacity - from, easing, easingParam);
+}
+
+TweenSystem::TweenId TweenSystem::tintTo(Node* target,
+                                         float duration,
+                                         const Color3B& color,
+                                         tweenfunc::TweenType easing,
+                                         float easingParam)
+{
+    Vec3 from;
+    if (target)
+    {
+        auto& current = target->getColor();
+        from          = Vec3(current.r, current.g, current.b);
+    }
+    return addTween(_tints, target, duration, from, Vec3(color.r, color.g, color.b) - from, easing, easingParam);
+}
+
+void TweenSystem::setCompletionCallback(TweenId id, std::function<void()> callback)
+{
+    if (callback)
+        _callbacks[id] = std::move(callback);
+    else
+        _callbacks.erase(id);
+}
+
+bool TweenSystem::stop(TweenId id)
+{
+    Node* target = nullptr;
+    forEachTrack([id, &target](auto& track) {
+        if (target)
+            return;
+        auto& tweens = track.tweens;
+        auto it = std::find_if(tweens.begin(), tweens.end(), [id](const auto& tween) { return tween.id == id; });
+        if (it != tweens.end())
+        {
+            target = it->target;
+            *it    = tweens.back();
+            tweens.pop_back();
+        }
+    });
+    if (!target)
+        return false;
+
+    _callbacks.erase(id);
+    releaseTarget(target);
+    return true;
+}
+
+void TweenSystem::stopAllForTarget(Node* target)
+{
+    // called by Node::stopAllActions of every node, most have no tween
+    auto it = _targets.find(target);
+    if (it == _targets.end())
+        return;
+
+    const bool hasCallbacks = !_callbacks.empty();
+    forEachTrack([this, target, hasCallbacks](auto& track) {
+        removeTweensIf(track.tweens, [this, target, hasCallbacks](const auto& tween) {
+            if (tween.target != target)
+                return false;
+            if (hasCallbacks)
+                _callbacks.erase(tween.id);
+            return true;
+        });
+    });
+
+    _targets.erase(it);
+    if (_updating)
+        _releasedTargets.emplace_back(target);
+    else
+        target->release();
+}
+
+void TweenSystem::stopAll()
+{
+    forEachTrack([](auto& track) { track.tweens.clear(); });
+    _callbacks.clear();
+
+    for (auto& [target, state] : _targets)
+    {
+        if (_updating)
+            _releasedTargets.emplace_back(target);
+        else
+            target->release();
+    }
+    _targets.clear();
+}
+
+void TweenSystem::pauseTarget(Node* target)
+{
+    auto it = _targets.find(target);
+    if (it == _targets.end() || it->second.paused)
+        return;
+
+    it->second.paused = true;
+    forEachTrack([target](auto& track) {
+        for (auto& tween : track.tweens)
+        {
+            if (tween.target == target)
+                tween.paused = true;
+        }
+    });
+}
+
+void TweenSystem::resumeTarget(Node* target)
+{
+    auto it = _targets.find(target);
+    if (it == _targets.end() || !it->second.paused)
+        return;
+
+    it->second.paused = false;
+    forEachTrack([target](auto& track) {
+        for (auto& tween : track.tweens)
+        {
+            if (tween.target == target)
+                tween.paused = false;
+        }
+    });
+}
+
+std::vector<Node*> TweenSystem::pauseAllTargets()
+{
+    std::vector<Node*> paused;
+    for (auto& [target, state] : _targets)
+    {
+        if (!state.paused)
+        {
+            state.paused = true;
+            paused.emplace_back(target);
+        }
+    }
+    forEachTrack([](auto& track) {
+        for (auto& tween : track.tweens)
+            tween.paused = true;
+    });
+    return paused;
+}
+
+bool TweenSystem::isRunning(TweenId id) const
+{
+    bool found = false;
+    forEachTrack([id, &found](const auto& track) {
+        found = found || std::any_of(track.tweens.begin(), track.tweens.end(),
+                                     [id](const auto& tween) { return tween.id == id; });
+    });
+    return found;
+}
+
+size_t TweenSystem::getTweenCount() const
+{
+    size_t count = 0;
+    forEachTrack([&count](const auto& track) { count += track.tweens.size(); });
+    return count;
+}
+
+void TweenSystem::releaseTarget(Node* target)
+{
+    auto it = _targets.find(target);
+    if (it == _targets.end() || --it->second.tweenCount > 0)
+        return;
+
+    _targets.erase(it);
+    // a released node may be deleted, which stops its actions and so its tweens
+    if (_updating)
+        _releasedTargets.emplace_back(target);
+    else
+        target->release();
+}
+
+template <typename T, typename Apply>
+void TweenSystem::updateTrack(Track<T>& track, float dt, Apply&& apply)
+{
+    auto& tweens       = track.tweens;
+    const size_t count = tweens.size();
+    if (count == 0)
+        return;
+
+    track.values.resize(count);
+    auto tweenData = tweens.data();
+    auto values    = track.values.data();
+
+    // the evaluation only touches the arrays, it can run on the workers
+    parallelFor(count, [tweenData, values, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto& tween = tweenData[i];
+            if (tween.paused)
+                continue;
+
+            tween.elapsed += dt;
+            const float time = tween.duration > 0 ? (std::min)(1.0f, tween.elapsed / tween.duration) : 1.0f;
+            float param      = tween.easingParam;
+            const float eased = tweenfunc::tweenTo(time, tween.easing, param != 0 ? &param : nullptr);
+            values[i]         = tween.from + tween.delta * eased;
+        }
+    });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!tweenData[i].paused)
+            apply(tweenData[i].target, values[i]);
+    }
+
+    // retire the finished tweens from the back, swapping the last ones in
+    const bool hasCallbacks = !_callbacks.empty();
+    for (size_t i = count; i-- > 0;)
+    {
+        auto& tween = tweens[i];
+        if (tween.paused || tween.elapsed < tween.duration)
+            continue;
+
+        if (hasCallbacks)
+            _finished.emplace_back(tween.id);
+        auto target = tween.target;
+        tween       = tweens.back();
+        tweens.pop_back();
+        releaseTarget(target);
+    }
+}
+
+void TweenSystem::update(float dt)
+{
+    if (_targets.empty())
+        return;
+
+    AX_TRACE_SCOPE("TweenSystem::update");
+
+    _updating = true;
+
+    updateTrack(_moves, dt, [](Node* target, const Vec2& position) { target->setPosition(position); });
+    updateTrack(_scales, dt, [](Node* target, const Vec2& scale) { target->setScale(scale.x, scale.y); });
+    updateTrack(_rotations, dt, [](Node* target, float rotation) { target->setRotation(rotation); });
+    updateTrack(_fades, dt, [](Node* target, float opacity) {
+        target->setOpacity(static_cast<uint8_t>(std::clamp(opacity + 0.5f, 0.0f, 255.0f)));
+    });
+    updateTrack(_tints, dt, [](Node* target, const Vec3& color) {
+        target->setColor(Color3B(static_cast<uint8_t>(std::clamp(color.x + 0.5f, 0.0f, 255.0f)),
+                                 static_cast<uint8_t>(std::clamp(color.y + 0.5f, 0.0f, 255.0f)),
+                                 static_cast<uint8_t>(std::clamp(color.z + 0.5f, 0.0f, 255.0f))));
+    });
+
+    // the callbacks may add or stop tweens, the targets are still alive while they run
+    for (size_t i = 0; i < _finished.size(); ++i)
+    {
+        auto it = _callbacks.find(_finished[i]);
+        if (it == _callbacks.end())
+            continue;
+        auto callback = std::move(it->second);
+        _callbacks.erase(it);
+        callback();
+    }
+    _finished.clear();
+
+    _updating = false;
+
+    auto released = std::move(_releasedTargets);
+    _releasedTargets.clear();
+    for (auto target : released)
+        target->release();
+}
+
+void TweenSystem::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn)
+{
+    auto jobSystem =
+        _parallelThreshold && count >= _parallelThreshold ? Director::getInstance()->getJobSystem() : nullptr;
+    if (!jobSystem)
+    {
+        fn(0, count);
+        return;
+    }
+
+    constexpr size_t CHUNK_SIZE = 1024;
+    jobSystem->wait(jobSystem->parallelFor(count, CHUNK_SIZE, fn));
+}
+
+}  // namespace ax
@@ -0,0 +1,205 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "2d/TweenFunction.h"
+#include "base/Types.h"
+#include "math/Math.h"
+
+namespace ax
+{
+
+class Node;
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+
+/**
+ * @brief Runs the simple interval animations, move, scale, rotate, fade and tint, without Action objects.
+ *
+ * Every kind of tween lives in its own contiguous array, and an update evaluates a whole array in a tight loop
+ * before writing the values to the nodes, instead of a virtual step per ref counted action. When many tweens run,
+ * the evaluation is spread over the JobSystem workers, the nodes are always written on the axmol thread.
+ *
+ * It is owned by the ActionManager and follows its targets, the tweens of a node are paused with its actions and
+ * stopped by Node::stopAllActions. The targets are retained while they have tweens. Two tweens of the same property
+ * on a node both write it, stop the previous one first. Use the Action classes for sequences and custom actions.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL TweenSystem
+{
+public:
+    using TweenId = uint32_t;
+
+    static constexpr TweenId INVALID_TWEEN = 0;
+
+    /** The tween count the evaluation is spread over the workers from. */
+    static constexpr size_t DEFAULT_PARALLEL_THRESHOLD = 4096;
+
+    TweenSystem() = default;
+    ~TweenSystem();
+
+    TweenSystem(const TweenSystem&)            = delete;
+    TweenSystem& operator=(const TweenSystem&) = delete;
+
+    /**
+     * Tweens the position of a node to a point, from its current position.
+     * The easing parameter is the period of the elastic easings, 0 for their default. CUSTOM_EASING isn't supported.
+     */
+    TweenId moveTo(Node* target,
+                   float duration,
+                   const Vec2& position,
+                   tweenfunc::TweenType easing = tweenfunc::Linear,
+                   float easingParam           = 0);
+    TweenId moveBy(Node* target,
+                   float duration,
+                   const Vec2& deltaPosition,
+                   tweenfunc::TweenType easing = tweenfunc::Linear,
+                   float easingParam           = 0);
+    TweenId scaleTo(Node* target,
+                    float duration,
+                    float scaleX,
+                    float scaleY,
+                    tweenfunc::TweenType easing = tweenfunc::Linear,
+                    float easingParam           = 0);
+    /** Rotates by the shortest way to the angle in degrees, like RotateTo. */
+    TweenId rotateTo(Node* target,
+                     float duration,
+                     float angle,
+                     tweenfunc::TweenType easing = tweenfunc::Linear,
+                     float easingParam           = 0);
+    TweenId fadeTo(Node* target,
+                   float duration,
+                   uint8_t opacity,
+                   tweenfunc::TweenType easing = tweenfunc::Linear,
+                   float easingParam           = 0);
+    TweenId tintTo(Node* target,
+                   float duration,
+                   const Color3B& color,
+                   tweenfunc::TweenType easing = tweenfunc::Linear,
+                   float easingParam           = 0);
+
+    /** Sets a function called after a tween finished, not when it is stopped. */
+    void setCompletionCallback(TweenId id, std::function<void()> callback);
+
+    /** Stops a tween, its property keeps the value it has. */
+    bool stop(TweenId id);
+    void stopAllForTarget(Node* target);
+    void stopAll();
+
+    void pauseTarget(Node* target);
+    void resumeTarget(Node* target);
+
+    /** Pauses all the targets, returns the ones which weren't paused. */
+    std::vector<Node*> pauseAllTargets();
+
+    bool isRunning(TweenId id) const;
+    bool hasTweens(const Node* target) const { return _targets.find(const_cast<Node*>(target)) != _targets.end(); }
+    size_t getTweenCount() const;
+
+    /** Sets the tween count the evaluation is spread over the workers from, 0 to always evaluate on the axmol thread. */
+    void setParallelThreshold(size_t count) { _parallelThreshold = count; }
+    size_t getParallelThreshold() const { return _parallelThreshold; }
+
+    /** Advances, applies and retires the tweens, called by ActionManager::update. */
+    void update(float dt);
+
+protected:
+    template <typename T>
+    struct Tween
+    {
+        Node* target;
+        T from;
+        T delta;
+        float elapsed;
+        float duration;
+        float easingParam;
+        tweenfunc::TweenType easing;
+        TweenId id;
+        bool paused;
+    };
+
+    template <typename T>
+    struct Track
+    {
+        std::vector<Tween<T>> tweens;
+        std::vector<T> values;  // evaluated by the update, parallel to tweens
+    };
+
+    struct TargetState
+    {
+        uint32_t tweenCount;
+        bool paused;
+    };
+
+    template <typename T>
+    TweenId addTween(Track<T>& track,
+                     Node* target,
+                     float duration,
+                     const T& from,
+                     const T& delta,
+                     tweenfunc::TweenType easing,
+                     float easingParam);
+
+    template <typename T, typename Apply>
+    void updateTrack(Track<T>& track, float dt, Apply&& apply);
+
+    template <typename Fn>
+    void forEachTrack(Fn&& fn);
+    template <typename Fn>
+    void forEachTrack(Fn&& fn) const;
+
+    /** Drops a tween from the count of its target, the target is released with its last tween. */
+    void releaseTarget(Node* target);
+
+    /** Calls fn(begin, end) over [0, count), in chunks on the workers when count reaches the parallel threshold. */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn);
+
+    Track<Vec2> _moves;
+    Track<Vec2> _scales;
+    Track<float> _rotations;
+    Track<float> _fades;
+    Track<Vec3> _tints;
+
+    std::unordered_map<Node*, TargetState> _targets;
+    std::unordered_map<TweenId, std::function<void()>> _callbacks;
+    std::vector<TweenId> _finished;       // with a completion callback
+    std::vector<Node*> _releasedTargets;  // released at the end of the update
+
+    TweenId _nextId           = 1;
+    size_t _parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+    bool _updating            = false;
+};
+
+// end of actions group
+/// @}
+
+}  // namespace ax
@@ -27,6 +27,8 @@
 #include "3d/Animate3D.h"
 #include "3d/MeshRenderer.h"
 #include "3d/Skeleton3D.h"
+#include "2d/Camera.h"
+#include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "base/Configuration.h"
 #include "base/EventCustom.h"
@@ -117,6 +119,7 @@ Animate3D* Animate3D::clone() const
     copy->_start       = _start;
     copy->_last        = _last;
     copy->_playReverse = _playReverse;
+    copy->_lodLevels   = _lodLevels;
     copy->setDuration(animate->getDuration());
     copy->setOriginInterval(animate->getOriginInterval());
     return copy;
@@ -156,6 +159,8 @@ void Animate3D::startWithTarget(Node* target)
     {
         _boneCurves.clear();
         _nodeCurves.clear();
+        _bakedBones.clear();
+        _bakedClip = nullptr;
 
         bool hasCurve    = false;
         MeshRenderer* mesh = dynamic_cast<MeshRenderer*>(target);
@@ -199,6 +204,27 @@ void Animate3D::startWithTarget(Node* target)
                     }
                 }
             }
+
+            auto clip = _animation ? _animation->getBakedClip() : nullptr;
+            auto skin = mesh->getSkeleton();
+            if (clip && skin)
+            {
+                auto& trackNames = clip->getTrackNames();
+                for (int track = 0; track < clip->getTrackCount(); ++track)
+                {
+                    auto bone = skin->getBoneByName(trackNames[track]);
+                    if (bone)
+                    {
+                        _bakedBones.emplace_back(bone, track);
+                        _boneCurves.erase(bone);
+                    }
+                }
+                if (!_bakedBones.empty())
+                {
+                    _bakedClip = clip;
+                    _bakedPose.resize(clip->getPoseSize());
+                }
+            }
         }
         else
         {
@@ -335,6 +361,7 @@ void Animate3D::update(float t)
         {
             if (_weight > 0.0f)
             {
+                const bool evaluate = !isSkippedByLOD();
                 float transDst[3], rotDst[4], scaleDst[3];
                 float *trans = nullptr, *rot = nullptr, *scale = nullptr;
                 if (_playReverse)
@@ -346,50 +373,78 @@ void Animate3D::update(float t)
                 t        = _start + t * _last;
                 lastTime = _start + lastTime * _last;
 
-                for (const auto& it : _boneCurves)
+                // bones and nodes keep their last pose when the LOD skips this frame
+                if (evaluate)
                 {
-                    auto bone  = it.first;
-                    auto curve = it.second;
-                    if (curve->translateCurve)
-                    {
-                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
-                        trans = &transDst[0];
-                    }
-                    if (curve->rotCurve)
-                    {
-                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
-                        rot = &rotDst[0];
-                    }
-                    if (curve->scaleCurve)
+                    if (_bakedClip)
                     {
-                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
-                        scale = &scaleDst[0];
-                    }
-                    bone->setAnimationValue(trans, rot, scale, this, _weight);
-                }
+                        _bakedClip->sample(t, _bakedPose.data(), _quality == Animate3DQuality::QUALITY_LOW);
+                        const int lanes = _bakedClip->getLaneCount();
+                        for (const auto& it : _bakedBones)
+                        {
+                            auto flags = _bakedClip->getTrackFlags(it.second);
+                            auto lane  = _bakedPose.data() + it.second;
+                            float bakedTrans[3], bakedRot[4], bakedScale[3];
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                bakedTrans[c] = lane[(Animation3D::BakedClip::CHANNEL_TRANSLATE + c) * lanes];
+                                bakedScale[c] = lane[(Animation3D::BakedClip::CHANNEL_SCALE + c) * lanes];
+                            }
+                            for (int c = 0; c < 4; ++c)
+                                bakedRot[c] = lane[(Animation3D::BakedClip::CHANNEL_ROTATION + c) * lanes];
 
-                for (const auto& it : _nodeCurves)
-                {
-                    auto node  = it.first;
-                    auto curve = it.second;
-                    Mat4 transform;
-                    if (curve->translateCurve)
-                    {
-                        curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
-                        transform.translate(transDst[0], transDst[1], transDst[2]);
+                            it.first->setAnimationValue(
+                                (flags & Animation3D::BakedClip::HAS_TRANSLATION) ? bakedTrans : nullptr,
+                                (flags & Animation3D::BakedClip::HAS_ROTATION) ? bakedRot : nullptr,
+                                (flags & Animation3D::BakedClip::HAS_SCALE) ? bakedScale : nullptr, this, _weight);
+                        }
                     }
-                    if (curve->rotCurve)
+
+                    for (const auto& it : _boneCurves)
                     {
-                        curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
-                        Quaternion qua(rotDst[0], rotDst[1], rotDst[2], rotDst[3]);
-                        transform.rotate(qua);
+                        auto bone  = it.first;
+                        auto curve = it.second;
+                        if (curve->translateCurve)
+                        {
+                            curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
+                            trans = &transDst[0];
+                        }
+                        if (curve->rotCurve)
+                        {
+                            curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
+                            rot = &rotDst[0];
+                        }
+                        if (curve->scaleCurve)
+                        {
+                            curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
+                            scale = &scaleDst[0];
+                        }
+                        bone->setAnimationValue(trans, rot, scale, this, _weight);
                     }
-                    if (curve->scaleCurve)
+
+                    for (const auto& it : _nodeCurves)
                     {
-                        curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
-                        transform.scale(scaleDst[0], scaleDst[1], scaleDst[2]);
+                        auto node  = it.first;
+                        auto curve = it.second;
+                        Mat4 transform;
+                        if (curve->translateCurve)
+                        {
+                            curve->translateCurve->evaluate(t, transDst, _translateEvaluate);
+                            transform.translate(transDst[0], transDst[1], transDst[2]);
+                        }
+                        if (curve->rotCurve)
+                        {
+                            curve->rotCurve->evaluate(t, rotDst, _roteEvaluate);
+                            Quaternion qua(rotDst[0], rotDst[1], rotDst[2], rotDst[3]);
+                            transform.rotate(qua);
+                        }
+                        if (curve->scaleCurve)
+                        {
+                            curve->scaleCurve->evaluate(t, scaleDst, _scaleEvaluate);
+                            transform.scale(scaleDst[0], scaleDst[1], scaleDst[2]);
+                        }
+                        node->setAdditionalTransform(&transform);
                     }
-                    node->setAdditionalTransform(&transform);
                 }
                 if (!_keyFrameUserInfos.empty())
                 {
@@ -467,6 +522,48 @@ Animate3DQuality Animate3D::getQuality() const
     return _quality;
 }
 
+void Animate3D::setLODLevels(std::vector<LODLevel> levels)
+{
+    std::sort(levels.begin(), levels.end(),
+              [](const LODLevel& a, const LODLevel& b) { return a.distance < b.distance; });
+    _lodLevels = std::move(levels);
+}
+
+bool Animate3D::isSkippedByLOD()
+{
+    if (_lodLevels.empty() || _state != Animate3D::Animate3DState::Running)
+        return false;
+
+    auto scene = Director::getInstance()->getRunningScene();
+    if (!scene)
+        return false;
+
+    Vec3 position;
+    _target->getNodeToWorldTransform().getTranslation(&position);
+
+    float distanceSq = -1.f;
+    for (auto&& camera : scene->getCameras())
+    {
+        if (!((unsigned short)camera->getCameraFlag() & _target->getCameraMask()))
+            continue;
+        Vec3 eye;
+        camera->getNodeToWorldTransform().getTranslation(&eye);
+        float d = position.distanceSquared(eye);
+        if (distanceSq < 0 || d < distanceSq)
+            distanceSq = d;
+    }
+
+    int interval = 1;
+    for (auto&& level : _lodLevels)
+    {
+        if (distanceSq < level.distance * level.distance)
+            break;
+        interval = level.frameInterval;
+    }
+
+    return interval > 1 && (_lodFrame++ % interval) != 0;
+}
+
 const ValueMap* Animate3D::getKeyFrameUserInfo(int keyFrame) const
 {
     auto iter = _keyFrameUserInfos.find(keyFrame);
@@ -502,6 +599,9 @@ Animate3D::Animate3D()
     , _lastTime(0.0f)
     , _originInterval(0.0f)
     , _frameRate(30.0f)
+    // stagger the evaluations of the animations sharing a LOD level over the frames
+    , _lodFrame(static_cast<unsigned int>(reinterpret_cast<uintptr_t>(this) >> 4))
+    , _bakedClip(nullptr)
 {
     setQuality(Animate3DQuality::QUALITY_HIGH);
 }
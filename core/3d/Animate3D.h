@@ -122,6 +122,21 @@ public:
     /**get animate quality*/
     Animate3DQuality getQuality() const;
 
+    /** A level of the animation LOD, beyond `distance` the bones are evaluated every `frameInterval` frames. */
+    struct LODLevel
+    {
+        float distance;
+        int frameInterval;
+    };
+
+    /**
+     * Set the animation LOD levels, sorted by distance. The distance is measured from the target to the
+     * nearest camera that draws it, between evaluations the bones keep their last pose. While fading in or
+     * out the bones are evaluated every frame. Empty by default, every frame is evaluated.
+     */
+    void setLODLevels(std::vector<LODLevel> levels);
+    const std::vector<LODLevel>& getLODLevels() const { return _lodLevels; }
+
     struct Animate3DDisplayedEventInfo
     {
         int frame;
@@ -169,9 +184,20 @@ protected:
     EvaluateType _scaleEvaluate;
     Animate3DQuality _quality;
 
+    bool isSkippedByLOD();
+
+    // animation LOD
+    std::vector<LODLevel> _lodLevels;
+    unsigned int _lodFrame;
+
     std::unordered_map<Bone3D*, Animation3D::Curve*> _boneCurves;  // weak ref
     std::unordered_map<Node*, Animation3D::Curve*> _nodeCurves;
 
+    // bones sampled from the baked clip in one pass, they are not in _boneCurves
+    const Animation3D::BakedClip* _bakedClip;          // weak ref, owned by _animation
+    std::vector<std::pair<Bone3D*, int>> _bakedBones;  // weak ref, bone and its track
+    axstd::pod_vector<float> _bakedPose;
+
     std::unordered_map<int, ValueMap> _keyFrameUserInfos;
     std::unordered_map<int, EventCustom*> _keyFrameEvent;
     std::unordered_map<int, Animate3DDisplayedEventInfo> _displayedEventInfo;
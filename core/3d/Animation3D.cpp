@@ -29,9 +29,118 @@
 #include "platform/FileUtils.h"
 #include "base/axstd.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ax
 {
 
+namespace
+{
+// out = bias + scale * lerp(q0, q1, alpha), count is a multiple of 4
+void dequantizeFrames(const int16_t* q0,
+                      const int16_t* q1,
+                      float alpha,
+                      const float* bias,
+                      const float* scale,
+                      float* out,
+                      int count)
+{
+#if defined(AX_SSE_INTRINSICS)
+    const __m128 a = _mm_set1_ps(alpha);
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128i i0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(q0 + i));
+        __m128i i1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(q1 + i));
+        // sign extend the 16 bit lanes to 32 bit
+        __m128 f0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(i0, i0), 16));
+        __m128 f1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(i1, i1), 16));
+        __m128 v  = _mm_add_ps(f0, _mm_mul_ps(_mm_sub_ps(f1, f0), a));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(bias + i), _mm_mul_ps(_mm_loadu_ps(scale + i), v)));
+    }
+#elif defined(AX_NEON_INTRINSICS)
+    for (int i = 0; i < count; i += 4)
+    {
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vld1_s16(q0 + i)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vld1_s16(q1 + i)));
+        float32x4_t v  = vmlaq_n_f32(f0, vsubq_f32(f1, f0), alpha);
+        vst1q_f32(out + i, vmlaq_f32(vld1q_f32(bias + i), vld1q_f32(scale + i), v));
+    }
+#else
+    for (int i = 0; i < count; ++i)
+    {
+        float v = q0[i] + (q1[i] - q0[i]) * alpha;
+        out[i]  = bias[i] + scale[i] * v;
+    }
+#endif
+}
+
+// normalize the SoA quaternions x, y, z, w of lanes tracks, lanes is a multiple of 4
+void normalizeRotations(float* rot, int lanes)
+{
+    float* x = rot;
+    float* y = rot + lanes;
+    float* z = rot + lanes * 2;
+    float* w = rot + lanes * 3;
+#if defined(AX_SSE_INTRINSICS)
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (int i = 0; i < lanes; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i), vw = _mm_loadu_ps(w + i);
+        __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)),
+                                 _mm_add_ps(_mm_mul_ps(vz, vz), _mm_mul_ps(vw, vw)));
+        __m128 inv  = _mm_div_ps(one, _mm_sqrt_ps(len2));
+        _mm_storeu_ps(x + i, _mm_mul_ps(vx, inv));
+        _mm_storeu_ps(y + i, _mm_mul_ps(vy, inv));
+        _mm_storeu_ps(z + i, _mm_mul_ps(vz, inv));
+        _mm_storeu_ps(w + i, _mm_mul_ps(vw, inv));
+    }
+#elif defined(AX_NEON_INTRINSICS)
+    for (int i = 0; i < lanes; i += 4)
+    {
+        float32x4_t vx = vld1q_f32(x + i), vy = vld1q_f32(y + i), vz = vld1q_f32(z + i), vw = vld1q_f32(w + i);
+        float32x4_t len2 = vmlaq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(vx, vx), vy, vy), vz, vz), vw, vw);
+        // reciprocal square root estimate refined by two newton steps
+        float32x4_t inv = vrsqrteq_f32(len2);
+        inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+        inv             = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+        vst1q_f32(x + i, vmulq_f32(vx, inv));
+        vst1q_f32(y + i, vmulq_f32(vy, inv));
+        vst1q_f32(z + i, vmulq_f32(vz, inv));
+        vst1q_f32(w + i, vmulq_f32(vw, inv));
+    }
+#else
+    for (int i = 0; i < lanes; ++i)
+    {
+        float inv = 1.0f / std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i]);
+        x[i] *= inv;
+        y[i] *= inv;
+        z[i] *= inv;
+        w[i] *= inv;
+    }
+#endif
+}
+}  // namespace
+
+void Animation3D::BakedClip::sample(float t, float* out, bool nearest) const
+{
+    const int poseSize = getPoseSize();
+    float pos          = std::clamp(t, 0.0f, 1.0f) * (_frameCount - 1);
+    int frame          = (std::min)(static_cast<int>(pos), _frameCount - 2);
+    float alpha        = pos - frame;
+    if (nearest)
+    {
+        if (alpha >= 0.5f)
+            ++frame;
+        alpha = 0.0f;
+    }
+
+    const int16_t* q0 = _frames.data() + frame * poseSize;
+    const int16_t* q1 = alpha > 0.0f ? q0 + poseSize : q0;
+    dequantizeFrames(q0, q1, alpha, _bias.data(), _scale.data(), out, poseSize);
+    normalizeRotations(out + CHANNEL_ROTATION * _laneCount, _laneCount);
+}
+
 Animation3D* Animation3D::create(std::string_view fileName, std::string_view animationName)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
@@ -189,6 +298,113 @@ bool Animation3D::init(const Animation3DData& data)
     return true;
 }
 
+bool Animation3D::bake(float sampleRate)
+{
+    AXASSERT(sampleRate > 0.0f, "invalid sample rate");
+    if (_bakedClip)
+        return true;
+    if (_boneCurves.empty() || sampleRate <= 0.0f)
+        return false;
+
+    auto clip            = std::make_unique<BakedClip>();
+    const int lanes      = (static_cast<int>(_boneCurves.size()) + 3) & ~3;
+    const int poseSize   = BakedClip::CHANNEL_COUNT * lanes;
+    const int frameCount = (std::max)(2, static_cast<int>(std::ceil(_duration * sampleRate)) + 1);
+    clip->_laneCount     = lanes;
+    clip->_frameCount    = frameCount;
+    clip->_sampleRate    = sampleRate;
+
+    // evaluate all the frames first, the quantization range of a channel depends on all of its samples,
+    // the channels without a curve and the padding lanes keep the identity transform
+    axstd::pod_vector<float> samples(static_cast<size_t>(frameCount) * poseSize, 0.0f);
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        float* pose = samples.data() + frame * poseSize;
+        std::fill_n(pose + (BakedClip::CHANNEL_ROTATION + 3) * lanes, lanes, 1.0f);
+        std::fill_n(pose + BakedClip::CHANNEL_SCALE * lanes, 3 * lanes, 1.0f);
+    }
+
+    int track = 0;
+    for (const auto& iter : _boneCurves)
+    {
+        auto curve    = iter.second;
+        uint8_t flags = 0;
+        Quaternion lastRot;
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+            float t     = static_cast<float>(frame) / (frameCount - 1);
+            float* lane = samples.data() + frame * poseSize + track;
+            float value[4];
+            if (curve->translateCurve)
+            {
+                flags |= BakedClip::HAS_TRANSLATION;
+                curve->translateCurve->evaluate(t, value, EvaluateType::INT_LINEAR);
+                for (int c = 0; c < 3; ++c)
+                    lane[(BakedClip::CHANNEL_TRANSLATE + c) * lanes] = value[c];
+            }
+            if (curve->rotCurve)
+            {
+                flags |= BakedClip::HAS_ROTATION;
+                curve->rotCurve->evaluate(t, value, EvaluateType::INT_QUAT_SLERP);
+                Quaternion rot(value[0], value[1], value[2], value[3]);
+                rot.normalize();
+                // keep consecutive frames in the same hemisphere so the interpolation takes the short path
+                if (frame > 0 && rot.x * lastRot.x + rot.y * lastRot.y + rot.z * lastRot.z + rot.w * lastRot.w < 0.0f)
+                    rot.set(-rot.x, -rot.y, -rot.z, -rot.w);
+                lastRot = rot;
+                lane[BakedClip::CHANNEL_ROTATION * lanes]       = rot.x;
+                lane[(BakedClip::CHANNEL_ROTATION + 1) * lanes] = rot.y;
+                lane[(BakedClip::CHANNEL_ROTATION + 2) * lanes] = rot.z;
+                lane[(BakedClip::CHANNEL_ROTATION + 3) * lanes] = rot.w;
+            }
+            if (curve->scaleCurve)
+            {
+                flags |= BakedClip::HAS_SCALE;
+                curve->scaleCurve->evaluate(t, value, EvaluateType::INT_LINEAR);
+                for (int c = 0; c < 3; ++c)
+                    lane[(BakedClip::CHANNEL_SCALE + c) * lanes] = value[c];
+            }
+        }
+        clip->_trackNames.emplace_back(iter.first);
+        clip->_trackFlags.emplace_back(flags);
+        ++track;
+    }
+
+    // rotations are unit length and use the full 16 bit range, the others are quantized in their own range
+    clip->_bias.resize(poseSize);
+    clip->_scale.resize(poseSize);
+    for (int i = 0; i < poseSize; ++i)
+    {
+        if (i >= BakedClip::CHANNEL_ROTATION * lanes && i < BakedClip::CHANNEL_SCALE * lanes)
+        {
+            clip->_bias[i]  = 0.0f;
+            clip->_scale[i] = 1.0f / 32767.0f;
+            continue;
+        }
+        float minValue = samples[i], maxValue = samples[i];
+        for (int frame = 1; frame < frameCount; ++frame)
+        {
+            float value = samples[frame * poseSize + i];
+            minValue    = (std::min)(minValue, value);
+            maxValue    = (std::max)(maxValue, value);
+        }
+        clip->_bias[i]  = (minValue + maxValue) * 0.5f;
+        clip->_scale[i] = (maxValue - minValue) * 0.5f / 32767.0f;
+    }
+
+    clip->_frames.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const int channel = static_cast<int>(i % poseSize);
+        const float scale = clip->_scale[channel];
+        float quantized   = scale > 0.0f ? std::round((samples[i] - clip->_bias[channel]) / scale) : 0.0f;
+        clip->_frames[i]  = static_cast<int16_t>(std::clamp(quantized, -32767.0f, 32767.0f));
+    }
+
+    _bakedClip = std::move(clip);
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////
 Animation3DCache* Animation3DCache::_cacheInstance = nullptr;
 
@@ -27,12 +27,14 @@
 #define __CCANIMATION3D_H__
 
 #include <unordered_map>
+#include <memory>
 
 #include "3d/AnimationCurve.h"
 
 #include "base/Macros.h"
 #include "base/Object.h"
 #include "3d/Bundle3DData.h"
+#include "base/axstd.h"
 
 namespace ax
 {
@@ -69,6 +71,62 @@ public:
         ~Curve();
     };
 
+    /**
+     * Baked clip, all the curves resampled at a fixed rate and quantized to 16 bit.
+     * The samples of one frame are laid out SoA: channel major, one lane per track, the lanes are padded to
+     * a multiple of 4 so a whole frame is dequantized and interpolated in one SIMD pass.
+     */
+    class AX_DLL BakedClip
+    {
+    public:
+        enum TrackFlags : uint8_t
+        {
+            HAS_TRANSLATION = 1,
+            HAS_ROTATION    = 1 << 1,
+            HAS_SCALE       = 1 << 2,
+        };
+
+        /**translate xyz, rotation xyzw, scale xyz*/
+        static const int CHANNEL_COUNT = 10;
+        static const int CHANNEL_TRANSLATE = 0;
+        static const int CHANNEL_ROTATION  = 3;
+        static const int CHANNEL_SCALE     = 7;
+
+        /**the track names, one track per bone curve*/
+        const std::vector<std::string>& getTrackNames() const { return _trackNames; }
+        uint8_t getTrackFlags(int track) const { return _trackFlags[track]; }
+        int getTrackCount() const { return static_cast<int>(_trackNames.size()); }
+        /**the distance between two channels of the sampled pose, the track count rounded up to 4*/
+        int getLaneCount() const { return _laneCount; }
+        int getFrameCount() const { return _frameCount; }
+        float getSampleRate() const { return _sampleRate; }
+        /**the float count of a sampled pose, CHANNEL_COUNT * getLaneCount()*/
+        int getPoseSize() const { return CHANNEL_COUNT * _laneCount; }
+        /**memory used by the quantized frames in bytes*/
+        size_t getMemorySize() const { return _frames.size() * sizeof(int16_t); }
+
+        /**
+         * Sample all the tracks at t (0 - 1), the rotations are normalized after interpolation.
+         *
+         * @param out pose of getPoseSize() floats, channel c of track k is at out[c * getLaneCount() + k]
+         * @param nearest use the nearest frame instead of interpolating
+         */
+        void sample(float t, float* out, bool nearest = false) const;
+
+    protected:
+        friend class Animation3D;
+
+        std::vector<std::string> _trackNames;
+        std::vector<uint8_t> _trackFlags;
+        int _laneCount    = 0;
+        int _frameCount   = 0;
+        float _sampleRate = 0;
+        // value = bias + scale * quantized, per channel lane
+        axstd::pod_vector<float> _bias;
+        axstd::pod_vector<float> _scale;
+        axstd::pod_vector<int16_t> _frames;
+    };
+
     /**read all animation or only the animation with given animationName? animationName == "" read the first.*/
     static Animation3D* create(std::string_view filename, std::string_view animationName = "");
 
@@ -85,6 +143,18 @@ public:
     /**get the bone Curves set*/
     const hlookup::string_map<Curve*>& getBoneCurves() const { return _boneCurves; }
 
+    /**
+     * Resample and quantize the bone curves to a baked clip, Animate3D created afterwards
+     * sample the bones from it instead of evaluating each curve, the curves are kept for the nodes.
+     * A clip is baked once, calling it again has no effect.
+     *
+     * @param sampleRate frames per second of the baked clip
+     */
+    bool bake(float sampleRate = 30.0f);
+
+    /**get the baked clip, nullptr if the animation isn't baked*/
+    const BakedClip* getBakedClip() const { return _bakedClip.get(); }
+
     Animation3D();
     virtual ~Animation3D();
     /**init Animation3D from bundle data*/
@@ -97,6 +167,8 @@ protected:
     hlookup::string_map<Curve*> _boneCurves;  // bone curves map, key bone name, value AnimationCurve
 
     float _duration;  // animation duration
+
+    std::unique_ptr<BakedClip> _bakedClip;
 };
 
 /**
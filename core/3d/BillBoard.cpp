@@ -112,6 +112,10 @@ void BillBoard::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t
     // Add 3D flag so all the children will be rendered as 3D object
     flags |= FLAGS_RENDER_AS_3D;
 
+    // without children the transform turned towards the camera isn't needed, the vertex shader turns the quad
+    if (_children.empty() && drawInstanced(renderer))
+        return;
+
     // Update Billboard transform
     bool dirty = calculateBillboardTransform();
     if (dirty)
@@ -243,6 +247,19 @@ void BillBoard::draw(Renderer* renderer, const Mat4& /*transform*/, uint32_t fla
     renderer->addCommand(&_trianglesCommand);
 }
 
+bool BillBoard::drawInstanced(Renderer* renderer)
+{
+    // only quads drawn with the default program, the instanced program has no custom uniforms
+    if (!renderer->isBillBoardInstancingEnabled() || _renderMode != RenderMode::QUAD ||
+        _programState->getProgram()->getProgramType() != backend::ProgramType::POSITION_TEXTURE_COLOR)
+        return false;
+
+    // the scale and the position of the anchor point are the same in the turned transform of a previous frame
+    const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    return renderer->addInstancedBillBoard(_quad, _anchorPointInPoints, _modelViewTransform,
+                                           _mode == Mode::VIEW_PLANE_ORIENTED, _texture, _blendFunc, projectionMat);
+}
+
 void BillBoard::setMode(Mode mode)
 {
     _mode      = mode;
@@ -112,6 +112,9 @@ protected:
      */
     bool calculateBillboardTransform();
 
+    /** add the billboard to an instanced draw turning it in the vertex shader, see Renderer::addInstancedBillBoard */
+    bool drawInstanced(Renderer* renderer);
+
     Mat4 _camWorldMat;
     Mat4 _mvTransform;
 
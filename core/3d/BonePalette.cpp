@@ -0,0 +1,166 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/BonePalette.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
+#include "renderer/Pass.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/Texture.h"
+
+namespace ax
+{
+
+BonePalette* BonePalette::_instance = nullptr;
+
+BonePalette* BonePalette::getInstance()
+{
+    if (!_instance)
+        _instance = new BonePalette();
+    return _instance;
+}
+
+void BonePalette::destroyInstance()
+{
+    AX_SAFE_DELETE(_instance);
+}
+
+bool BonePalette::isSupported()
+{
+#if defined(AX_GLES_PROFILE) && AX_GLES_PROFILE == 200
+    // no vertex texture fetch of float textures in ES 2.0
+    return false;
+#else
+    return true;
+#endif
+}
+
+BonePalette::BonePalette()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    _afterVisitListener =
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) { upload(); });
+    _afterDrawListener =
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { reset(); });
+    _recreatedListener =
+        dispatcher->addCustomEventListener(EVENT_RENDERER_RECREATED, [this](EventCustom*) { releaseTextures(); });
+}
+
+BonePalette::~BonePalette()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(_afterVisitListener);
+    dispatcher->removeEventListener(_afterDrawListener);
+    dispatcher->removeEventListener(_recreatedListener);
+
+    releaseTextures();
+}
+
+int BonePalette::append(const Vec4* rows, size_t count)
+{
+    int offset = static_cast<int>(_rows.size());
+    _rows.insert(_rows.end(), rows, rows + count);
+    _dirty = true;
+
+    // visited after the scene, e.g. in the notification node
+    if (_uploaded)
+        upload();
+    return offset;
+}
+
+void BonePalette::addPass(Pass* pass)
+{
+    _passes.emplace_back(pass);
+    if (_uploaded)
+        pass->setUniformBonePalette(TEXTURE_SLOT, _textures[_textureIndex]);
+}
+
+void BonePalette::upload()
+{
+    if (!_dirty)
+        return;
+    _dirty    = false;
+    _uploaded = true;
+
+    // pad to whole rows of the texture
+    int height = static_cast<int>((_rows.size() + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH);
+    _rows.resize(static_cast<size_t>(height) * TEXTURE_WIDTH);
+
+    auto& texture = _textures[_textureIndex];
+    auto& capacity = _textureHeights[_textureIndex];
+    if (!texture || capacity < height)
+    {
+        AX_SAFE_RELEASE(texture);
+
+        capacity = 16;
+        while (capacity < height)
+            capacity *= 2;
+
+        backend::TextureDescriptor descriptor;
+        descriptor.textureType       = backend::TextureType::TEXTURE_2D;
+        descriptor.textureFormat     = backend::PixelFormat::RGBA32F;
+        descriptor.textureUsage      = backend::TextureUsage::READ;
+        descriptor.width             = TEXTURE_WIDTH;
+        descriptor.height            = capacity;
+        descriptor.samplerDescriptor = backend::SamplerDescriptor(
+            backend::SamplerFilter::NEAREST, backend::SamplerFilter::NEAREST,
+            backend::SamplerAddressMode::CLAMP_TO_EDGE, backend::SamplerAddressMode::CLAMP_TO_EDGE);
+        texture = backend::DriverBase::getInstance()->newTexture(descriptor);
+
+        // allocate the whole texture, the rows past the palette are zeros
+        _rows.resize(static_cast<size_t>(capacity) * TEXTURE_WIDTH);
+        static_cast<backend::Texture2DBackend*>(texture)->updateData(reinterpret_cast<uint8_t*>(_rows.data()),
+                                                                     TEXTURE_WIDTH, capacity, 0);
+    }
+    else
+        static_cast<backend::Texture2DBackend*>(texture)->updateSubData(0, 0, TEXTURE_WIDTH, height, 0,
+                                                                        reinterpret_cast<uint8_t*>(_rows.data()));
+
+    for (auto&& pass : _passes)
+        pass->setUniformBonePalette(TEXTURE_SLOT, texture);
+}
+
+void BonePalette::reset()
+{
+    if (_rows.empty())
+        return;
+
+    _rows.clear();
+    _passes.clear();
+    _uploaded = false;
+    _textureIndex = (_textureIndex + 1) % TEXTURE_COUNT;
+}
+
+void BonePalette::releaseTextures()
+{
+    for (int i = 0; i < TEXTURE_COUNT; ++i)
+    {
+        AX_SAFE_RELEASE_NULL(_textures[i]);
+        _textureHeights[i] = 0;
+    }
+}
+
+}  // namespace ax
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "base/Macros.h"
+#include "math/Vec4.h"
+#include <vector>
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+class Pass;
+class EventListenerCustom;
+
+namespace backend
+{
+class TextureBackend;
+}
+
+/**
+ * @brief BonePalette, the matrix palettes of all skinned meshes drawn in a frame packed into one float texture.
+ *
+ * Skinned meshes using a palette texture material append their palette while they are visited, and the
+ * texture is uploaded once after the scene is visited. Each bone takes three RGBA32F texels, the rows of
+ * its 4x3 skinning matrix, the shader reads them from the offset set on the mesh. Unlike the uniform
+ * palette, the bone count of a mesh is not limited.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL BonePalette
+{
+public:
+    /** The texels in a row of the palette texture, the shaders must use the same value. */
+    static constexpr int TEXTURE_WIDTH = 1024;
+
+    /** The texture slot of the palette, after the textures of the mesh materials. */
+    static constexpr int TEXTURE_SLOT = 2;
+
+    static BonePalette* getInstance();
+    static void destroyInstance();
+
+    /** Whether vertex shaders can read float textures, the builtin skin materials use the palette texture then. */
+    static bool isSupported();
+
+    /**
+     * Appends the palette of a mesh to the palette texture of this frame.
+     * @param rows The palette, three rows per bone.
+     * @param count The number of rows.
+     * @return The index of the first texel of the palette, to be set as `u_paletteOffset`.
+     */
+    int append(const Vec4* rows, size_t count);
+
+    /** Binds the palette texture of this frame to a pass when it's uploaded. */
+    void addPass(Pass* pass);
+
+    /** The texels used in this frame. */
+    size_t getSize() const { return _rows.size(); }
+
+protected:
+    BonePalette();
+    ~BonePalette();
+
+    void upload();
+    void reset();
+    void releaseTextures();
+
+    std::vector<Vec4> _rows;
+    std::vector<Pass*> _passes;  // weak ref, they are alive until the frame is rendered
+    bool _dirty    = false;
+    bool _uploaded = false;
+
+    // the textures rotate so the one in flight on the GPU is not written
+    static constexpr int TEXTURE_COUNT = 3;
+    backend::TextureBackend* _textures[TEXTURE_COUNT]{};
+    int _textureHeights[TEXTURE_COUNT]{};
+    int _textureIndex = 0;
+
+    EventListenerCustom* _afterVisitListener = nullptr;
+    EventListenerCustom* _afterDrawListener  = nullptr;
+    EventListenerCustom* _recreatedListener  = nullptr;
+
+    static BonePalette* _instance;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
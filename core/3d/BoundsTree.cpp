@@ -0,0 +1,503 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/BoundsTree.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+namespace
+{
+AABB merge(const AABB& a, const AABB& b)
+{
+    return AABB(Vec3(std::min(a._min.x, b._min.x), std::min(a._min.y, b._min.y), std::min(a._min.z, b._min.z)),
+                Vec3(std::max(a._max.x, b._max.x), std::max(a._max.y, b._max.y), std::max(a._max.z, b._max.z)));
+}
+
+// the cost of a box for the insertion, the area of its surface
+float area(const AABB& box)
+{
+    Vec3 size = box._max - box._min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool contains(const AABB& outer, const AABB& inner)
+{
+    return outer._min.x <= inner._min.x && outer._min.y <= inner._min.y && outer._min.z <= inner._min.z &&
+           inner._max.x <= outer._max.x && inner._max.y <= outer._max.y && inner._max.z <= outer._max.z;
+}
+
+AABB fatten(const AABB& bounds, float margin)
+{
+    Vec3 extent = (bounds._max - bounds._min) * margin;
+    return AABB(bounds._min - extent, bounds._max + extent);
+}
+
+// slab test, the distance is 0 when the origin is inside of the box
+bool rayBox(const Vec3& origin, const Vec3& invDirection, const AABB& box, float maxDistance, float& distance)
+{
+    float tmin = 0.0f, tmax = maxDistance;
+    auto slab  = [&](float origin, float invDirection, float min, float max) {
+        float t1 = (min - origin) * invDirection;
+        float t2 = (max - origin) * invDirection;
+        tmin     = std::max(tmin, std::min(t1, t2));
+        tmax     = std::min(tmax, std::max(t1, t2));
+    };
+    slab(origin.x, invDirection.x, box._min.x, box._max.x);
+    slab(origin.y, invDirection.y, box._min.y, box._max.y);
+    slab(origin.z, invDirection.z, box._min.z, box._max.z);
+    distance = tmin;
+    return tmin <= tmax;
+}
+
+bool sphereBox(const Vec3& center, float radiusSq, const AABB& box)
+{
+    auto excess = [](float v, float min, float max) { return v < min ? min - v : (v > max ? v - max : 0.0f); };
+    float dx    = excess(center.x, box._min.x, box._max.x);
+    float dy    = excess(center.y, box._min.y, box._max.y);
+    float dz    = excess(center.z, box._min.z, box._max.z);
+    return dx * dx + dy * dy + dz * dz <= radiusSq;
+}
+
+Vec3 inverseDirection(const Vec3& direction)
+{
+    // a zero component gives an infinite slab, the box is then hit only when the origin is between its planes
+    auto inverse = [](float v) { return v != 0.0f ? 1.0f / v : FLT_MAX; };
+    return Vec3(inverse(direction.x), inverse(direction.y), inverse(direction.z));
+}
+}  // namespace
+
+BoundsTree::BoundsTree(float margin) : _margin(margin)
+{
+    AXASSERT(margin >= 0, "Invalid margin");
+}
+
+int BoundsTree::insert(Node* node, const AABB& bounds)
+{
+    int proxy   = allocateNode();
+    auto& leaf  = _nodes[proxy];
+    leaf.node   = node;
+    leaf.bounds = bounds;
+    leaf.box    = fatten(bounds, _margin);
+    leaf.height = 0;
+    insertLeaf(proxy);
+    ++_leafCount;
+    return proxy;
+}
+
+void BoundsTree::remove(int proxy)
+{
+    AXASSERT(proxy >= 0 && proxy < static_cast<int>(_nodes.size()) && _nodes[proxy].isLeaf(), "Invalid proxy");
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --_leafCount;
+}
+
+void BoundsTree::clear()
+{
+    _nodes.clear();
+    _root      = NULL_PROXY;
+    _freeList  = NULL_PROXY;
+    _leafCount = 0;
+}
+
+bool BoundsTree::update(int proxy, const AABB& bounds)
+{
+    auto& leaf  = _nodes[proxy];
+    leaf.bounds = bounds;
+
+    // refit only while the bounds stay inside of the margin, and while the margin isn't much too large
+    if (contains(leaf.box, bounds) && contains(fatten(bounds, _margin * 4.0f), leaf.box))
+        return false;
+
+    removeLeaf(proxy);
+    _nodes[proxy].box = fatten(bounds, _margin);
+    insertLeaf(proxy);
+    return true;
+}
+
+void BoundsTree::queryRay(const Ray& ray,
+                          std::vector<Node*>& nodes,
+                          float maxDistance,
+                          std::vector<float>* distances) const
+{
+    if (_root == NULL_PROXY)
+        return;
+
+    Vec3 invDirection = inverseDirection(ray._direction);
+    std::vector<std::pair<float, Node*>> hits;
+    std::vector<int> stack{_root};
+    while (!stack.empty())
+    {
+        auto& treeNode = _nodes[stack.back()];
+        stack.pop_back();
+
+        float distance;
+        if (treeNode.isLeaf())
+        {
+            if (rayBox(ray._origin, invDirection, treeNode.bounds, maxDistance, distance))
+                hits.emplace_back(distance, treeNode.node);
+        }
+        else if (rayBox(ray._origin, invDirection, treeNode.box, maxDistance, distance))
+        {
+            stack.emplace_back(treeNode.child1);
+            stack.emplace_back(treeNode.child2);
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](auto& a, auto& b) { return a.first < b.first; });
+    for (auto&& hit : hits)
+    {
+        nodes.emplace_back(hit.second);
+        if (distances)
+            distances->emplace_back(hit.first);
+    }
+}
+
+Node* BoundsTree::raycast(const Ray& ray, float maxDistance, float* distance) const
+{
+    if (_root == NULL_PROXY)
+        return nullptr;
+
+    Vec3 invDirection     = inverseDirection(ray._direction);
+    Node* nearest         = nullptr;
+    float nearestDistance = maxDistance;
+    float entry;
+    if (!rayBox(ray._origin, invDirection, _nodes[_root].box, nearestDistance, entry))
+        return nullptr;
+
+    // the nearer child is visited first, the branches farther than the nearest hit are skipped
+    std::vector<std::pair<float, int>> stack{{entry, _root}};
+    while (!stack.empty())
+    {
+        auto [boxDistance, index] = stack.back();
+        stack.pop_back();
+        if (boxDistance >= nearestDistance)
+            continue;
+
+        auto& treeNode = _nodes[index];
+        if (treeNode.isLeaf())
+        {
+            if (rayBox(ray._origin, invDirection, treeNode.bounds, nearestDistance, entry) &&
+                entry < nearestDistance)
+            {
+                nearest         = treeNode.node;
+                nearestDistance = entry;
+            }
+            continue;
+        }
+
+        float entry1, entry2;
+        bool hit1 = rayBox(ray._origin, invDirection, _nodes[treeNode.child1].box, nearestDistance, entry1);
+        bool hit2 = rayBox(ray._origin, invDirection, _nodes[treeNode.child2].box, nearestDistance, entry2);
+        if (hit1 && hit2 && entry1 < entry2)
+        {
+            stack.emplace_back(entry2, treeNode.child2);
+            stack.emplace_back(entry1, treeNode.child1);
+        }
+        else
+        {
+            if (hit1)
+                stack.emplace_back(entry1, treeNode.child1);
+            if (hit2)
+                stack.emplace_back(entry2, treeNode.child2);
+        }
+    }
+
+    if (nearest && distance)
+        *distance = nearestDistance;
+    return nearest;
+}
+
+void BoundsTree::querySphere(const Vec3& center, float radius, std::vector<Node*>& nodes) const
+{
+    if (_root == NULL_PROXY)
+        return;
+
+    float radiusSq = radius * radius;
+    std::vector<int> stack{_root};
+    while (!stack.empty())
+    {
+        auto& treeNode = _nodes[stack.back()];
+        stack.pop_back();
+
+        if (treeNode.isLeaf())
+        {
+            if (sphereBox(center, radiusSq, treeNode.bounds))
+                nodes.emplace_back(treeNode.node);
+        }
+        else if (sphereBox(center, radiusSq, treeNode.box))
+        {
+            stack.emplace_back(treeNode.child1);
+            stack.emplace_back(treeNode.child2);
+        }
+    }
+}
+
+void BoundsTree::queryFrustum(const Frustum& frustum, std::vector<Node*>& nodes) const
+{
+    if (_root == NULL_PROXY)
+        return;
+
+    std::vector<int> stack{_root};
+    while (!stack.empty())
+    {
+        auto& treeNode = _nodes[stack.back()];
+        stack.pop_back();
+
+        if (treeNode.isLeaf())
+        {
+            if (!frustum.isOutOfFrustum(treeNode.bounds))
+                nodes.emplace_back(treeNode.node);
+        }
+        else if (!frustum.isOutOfFrustum(treeNode.box))
+        {
+            stack.emplace_back(treeNode.child1);
+            stack.emplace_back(treeNode.child2);
+        }
+    }
+}
+
+void BoundsTree::cull(const Frustum& frustum)
+{
+    if (++_cullStamp == 0)
+    {
+        for (auto& treeNode : _nodes)
+            treeNode.cullStamp = 0;
+        _cullStamp = 1;
+    }
+    if (_root == NULL_PROXY)
+        return;
+
+    std::vector<int> stack{_root};
+    while (!stack.empty())
+    {
+        auto& treeNode = _nodes[stack.back()];
+        stack.pop_back();
+
+        if (treeNode.isLeaf())
+        {
+            if (!frustum.isOutOfFrustum(treeNode.bounds))
+                treeNode.cullStamp = _cullStamp;
+        }
+        else if (!frustum.isOutOfFrustum(treeNode.box))
+        {
+            stack.emplace_back(treeNode.child1);
+            stack.emplace_back(treeNode.child2);
+        }
+    }
+}
+
+size_t BoundsTree::getMemoryUsage() const
+{
+    return sizeof(BoundsTree) + _nodes.capacity() * sizeof(TreeNode);
+}
+
+int BoundsTree::allocateNode()
+{
+    if (_freeList == NULL_PROXY)
+    {
+        _nodes.emplace_back();
+        return static_cast<int>(_nodes.size()) - 1;
+    }
+
+    int index     = _freeList;
+    _freeList     = _nodes[index].parent;
+    _nodes[index] = TreeNode{};
+    return index;
+}
+
+void BoundsTree::freeNode(int index)
+{
+    auto& treeNode  = _nodes[index];
+    treeNode.node   = nullptr;
+    treeNode.child1 = treeNode.child2 = NULL_PROXY;
+    treeNode.height = -1;
+    treeNode.parent = _freeList;
+    _freeList       = index;
+}
+
+void BoundsTree::insertLeaf(int leaf)
+{
+    if (_root == NULL_PROXY)
+    {
+        _root               = leaf;
+        _nodes[leaf].parent = NULL_PROXY;
+        return;
+    }
+
+    // descend to the sibling growing the tree the least, the cost of a node is the area of its box
+    AABB leafBox = _nodes[leaf].box;
+    int index    = _root;
+    while (!_nodes[index].isLeaf())
+    {
+        auto& treeNode      = _nodes[index];
+        float boxArea       = area(treeNode.box);
+        float combinedArea  = area(merge(treeNode.box, leafBox));
+        float cost          = 2.0f * combinedArea;  // a new parent of this node and the leaf
+        float inheritedCost = 2.0f * (combinedArea - boxArea);
+
+        auto childCost = [&](int child) {
+            auto& childNode = _nodes[child];
+            float childArea = area(merge(childNode.box, leafBox));
+            return (childNode.isLeaf() ? childArea : childArea - area(childNode.box)) + inheritedCost;
+        };
+        float cost1 = childCost(treeNode.child1);
+        float cost2 = childCost(treeNode.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? treeNode.child1 : treeNode.child2;
+    }
+
+    int sibling   = index;
+    int newParent = allocateNode();  // may reallocate the nodes
+    auto& parent  = _nodes[newParent];
+    int oldParent = _nodes[sibling].parent;
+    parent.parent = oldParent;
+    parent.box    = merge(leafBox, _nodes[sibling].box);
+    parent.height = _nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (oldParent != NULL_PROXY)
+    {
+        if (_nodes[oldParent].child1 == sibling)
+            _nodes[oldParent].child1 = newParent;
+        else
+            _nodes[oldParent].child2 = newParent;
+    }
+    else
+        _root = newParent;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent    = newParent;
+
+    refitAncestors(_nodes[leaf].parent);
+}
+
+void BoundsTree::removeLeaf(int leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_PROXY;
+        return;
+    }
+
+    int parent      = _nodes[leaf].parent;
+    int grandParent = _nodes[parent].parent;
+    int sibling     = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grandParent != NULL_PROXY)
+    {
+        // the sibling takes the place of the parent
+        if (_nodes[grandParent].child1 == parent)
+            _nodes[grandParent].child1 = sibling;
+        else
+            _nodes[grandParent].child2 = sibling;
+        _nodes[sibling].parent = grandParent;
+        freeNode(parent);
+        refitAncestors(grandParent);
+    }
+    else
+    {
+        _root                  = sibling;
+        _nodes[sibling].parent = NULL_PROXY;
+        freeNode(parent);
+    }
+}
+
+void BoundsTree::refitAncestors(int index)
+{
+    while (index != NULL_PROXY)
+    {
+        index           = balance(index);
+        auto& treeNode  = _nodes[index];
+        auto& child1    = _nodes[treeNode.child1];
+        auto& child2    = _nodes[treeNode.child2];
+        treeNode.height = 1 + std::max(child1.height, child2.height);
+        treeNode.box    = merge(child1.box, child2.box);
+        index           = treeNode.parent;
+    }
+}
+
+int BoundsTree::balance(int iA)
+{
+    auto& a = _nodes[iA];
+    if (a.isLeaf() || a.height < 2)
+        return iA;
+
+    int iB   = a.child1;
+    int iC   = a.child2;
+    auto& b  = _nodes[iB];
+    auto& c  = _nodes[iC];
+    int diff = c.height - b.height;
+
+    // rotates the higher child up, its lower child takes its place under A
+    auto rotateUp = [&](int iUp, TreeNode& up, TreeNode& other, bool upIsChild2) {
+        int iF  = up.child1;
+        int iG  = up.child2;
+        auto& f = _nodes[iF];
+        auto& g = _nodes[iG];
+
+        up.child1 = iA;
+        up.parent = a.parent;
+        a.parent  = iUp;
+        if (up.parent != NULL_PROXY)
+        {
+            if (_nodes[up.parent].child1 == iA)
+                _nodes[up.parent].child1 = iUp;
+            else
+                _nodes[up.parent].child2 = iUp;
+        }
+        else
+            _root = iUp;
+
+        int iKeep  = f.height > g.height ? iF : iG;
+        int iMove  = iKeep == iF ? iG : iF;
+        auto& keep = _nodes[iKeep];
+        auto& move = _nodes[iMove];
+
+        up.child2 = iKeep;
+        if (upIsChild2)
+            a.child2 = iMove;
+        else
+            a.child1 = iMove;
+        move.parent = iA;
+
+        a.box     = merge(other.box, move.box);
+        up.box    = merge(a.box, keep.box);
+        a.height  = 1 + std::max(other.height, move.height);
+        up.height = 1 + std::max(a.height, keep.height);
+        return iUp;
+    };
+
+    if (diff > 1)
+        return rotateUp(iC, c, b, true);
+    if (diff < -1)
+        return rotateUp(iB, b, c, false);
+    return iA;
+}
+
+}  // namespace ax
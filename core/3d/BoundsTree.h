@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "3d/AABB.h"
+#include "3d/Frustum.h"
+#include "3d/Ray.h"
+
+namespace ax
+{
+
+class Node;
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief BoundsTree, a dynamic bounding volume hierarchy over the world bounds of 3D nodes.
+ *
+ * Each node is a leaf holding its bounds enlarged by a margin, so that a node moving a little is refit without
+ * touching the tree. A node leaving its enlarged bounds is removed and inserted again at the place that grows
+ * the tree the least, and the tree is rebalanced by rotations on the way up. Ray, sphere and frustum queries
+ * then visit the branches overlapping the query only. See Scene::setBoundsTreeEnabled for the tree kept by a
+ * scene over its mesh renderers.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL BoundsTree
+{
+public:
+    /** The proxy of a node not in the tree. */
+    static constexpr int NULL_PROXY = -1;
+    /** The default margin of the leaves, as a fraction of the size of the bounds. */
+    static constexpr float DEFAULT_MARGIN = 0.1f;
+
+    explicit BoundsTree(float margin = DEFAULT_MARGIN);
+
+    /** Adds a node with its world bounds, returns its proxy. */
+    int insert(Node* node, const AABB& bounds);
+    void remove(int proxy);
+    void clear();
+
+    /**
+     * Sets the bounds of a node, returns true if its leaf had to be moved in the tree. The leaf is only refit
+     * when the bounds stay inside of its margin.
+     */
+    bool update(int proxy, const AABB& bounds);
+
+    Node* getNode(int proxy) const { return _nodes[proxy].node; }
+    const AABB& getBounds(int proxy) const { return _nodes[proxy].bounds; }
+
+    /**
+     * Appends the nodes whose bounds are hit by the ray, the nearest first.
+     * @param distances If not null, receives the distance along the ray to the bounds of each node.
+     */
+    void queryRay(const Ray& ray,
+                  std::vector<Node*>& nodes,
+                  float maxDistance             = FLT_MAX,
+                  std::vector<float>* distances = nullptr) const;
+
+    /** The node whose bounds are the nearest hit by the ray, or null. */
+    Node* raycast(const Ray& ray, float maxDistance = FLT_MAX, float* distance = nullptr) const;
+
+    /** Appends the nodes whose bounds intersect the sphere, in no particular order. */
+    void querySphere(const Vec3& center, float radius, std::vector<Node*>& nodes) const;
+
+    /** Appends the nodes whose bounds aren't out of the frustum, in no particular order. */
+    void queryFrustum(const Frustum& frustum, std::vector<Node*>& nodes) const;
+
+    /**
+     * Marks the leaves whose bounds aren't out of the frustum, the previous marks are discarded.
+     * See isVisible.
+     */
+    void cull(const Frustum& frustum);
+    /** Whether the bounds of a node weren't out of the frustum of the last cull. */
+    bool isVisible(int proxy) const { return _nodes[proxy].cullStamp == _cullStamp; }
+
+    /** The number of nodes in the tree. */
+    size_t size() const { return _leafCount; }
+    /** The height of the tree, 0 for a single leaf. */
+    int getHeight() const { return _root == NULL_PROXY ? 0 : _nodes[_root].height; }
+    /** The memory held by the tree in bytes, estimated from the capacity of its containers. */
+    size_t getMemoryUsage() const;
+
+private:
+    struct TreeNode
+    {
+        AABB box;       // the enlarged bounds of a leaf, the union of the children otherwise
+        AABB bounds;    // the bounds of a leaf as given
+        Node* node = nullptr;
+        int parent = NULL_PROXY;  // the next free node when the node isn't used
+        int child1 = NULL_PROXY;
+        int child2 = NULL_PROXY;
+        int height = -1;  // 0 for a leaf, -1 when the node is free
+        uint32_t cullStamp = 0;
+
+        bool isLeaf() const { return child1 == NULL_PROXY; }
+    };
+
+    int allocateNode();
+    void freeNode(int index);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int index);
+    void refitAncestors(int index);
+
+    std::vector<TreeNode> _nodes;
+    int _root     = NULL_PROXY;
+    int _freeList = NULL_PROXY;
+    size_t _leafCount = 0;
+    float _margin;
+    uint32_t _cullStamp = 0;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -161,12 +161,12 @@ void Bundle3D::clear()
 {
     if (_isBinary)
     {
-        _binaryBuffer.clear();
+        _binaryBuffer = {};
         AX_SAFE_DELETE_ARRAY(_references);
     }
     else
     {
-        _jsonBuffer.clear();
+        _jsonReader.SetNull();
     }
 }
 
@@ -1066,9 +1066,10 @@ bool Bundle3D::loadJson(std::string_view path)
 {
     clear();
 
-    _jsonBuffer = FileUtils::getInstance()->getStringFromFile(path);
+    // parsed from the mapped file, the strings are copied in the document
+    auto contents = FileUtils::getInstance()->getMappedContents(path);
 
-    if (_jsonReader.ParseInsitu<0>((char*)_jsonBuffer.c_str()).HasParseError())
+    if (_jsonReader.Parse<0>(reinterpret_cast<const char*>(contents.data()), contents.size()).HasParseError())
     {
         clear();
         AXLOGW("Parse json failed in Bundle3D::loadJson function");
@@ -1089,8 +1090,7 @@ bool Bundle3D::loadBinary(std::string_view path)
     clear();
 
     // get file data
-    _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
+    _binaryBuffer = FileUtils::getInstance()->getMappedContents(path);
     if (_binaryBuffer.isNull())
     {
         clear();
@@ -1099,7 +1099,7 @@ bool Bundle3D::loadBinary(std::string_view path)
     }
 
     // Initialise bundle reader
-    _binaryReader.init((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
+    _binaryReader.init((char*)_binaryBuffer.data(), static_cast<ssize_t>(_binaryBuffer.size()));
 
     // Read identifier info
     char identifier[] = {'C', '3', 'B', '\0'};
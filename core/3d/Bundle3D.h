@@ -28,6 +28,7 @@
 #define __CCBUNDLE3D_H__
 
 #include "base/Data.h"
+#include "platform/FileView.h"
 #include "3d/Bundle3DData.h"
 #include "3d/BundleReader.h"
 #include "rapidjson/rapidjson.h"
@@ -190,11 +191,10 @@ protected:
     std::string _version;  // the c3b or c3t version
 
     // for json reading
-    std::string _jsonBuffer;
     rapidjson::Document _jsonReader;
 
     // for binary reading
-    Data _binaryBuffer;
+    FileView _binaryBuffer;
     BundleReader _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
@@ -17,11 +17,14 @@ int MeshVertexAttrib::getAttribSizeBytes() const
     case backend::VertexFormat::FLOAT2:
     case backend::VertexFormat::INT2:
     case backend::VertexFormat::USHORT4:
+    case backend::VertexFormat::SHORT4:
+    case backend::VertexFormat::HALF4:
         return 8;
     case backend::VertexFormat::FLOAT:
     case backend::VertexFormat::INT:
     case backend::VertexFormat::UBYTE4:
     case backend::VertexFormat::USHORT2:
+    case backend::VertexFormat::HALF2:
         return 4;
     default:
         AXASSERT(false, "VertexFormat convert to size error");
@@ -29,4 +32,10 @@ int MeshVertexAttrib::getAttribSizeBytes() const
     return ret;
 }
 
+bool MeshVertexAttrib::isNormalized() const
+{
+    // the integer formats of the meshes hold unit vectors or weights, see VertexCompression
+    return type == backend::VertexFormat::SHORT4 || type == backend::VertexFormat::UBYTE4;
+}
+
 }
\ No newline at end of file
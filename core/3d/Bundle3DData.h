@@ -169,7 +169,8 @@ public:
     const _Ty& at(size_t idx) const
     {
         assert(sizeof(_Ty) == _stride);
-        return (const _Ty&)_buffer[idx * sizeof(_Ty)];
+        // cast the address, casting the const byte reference would bind to a converted temporary
+        return *reinterpret_cast<const _Ty*>(&_buffer[idx * sizeof(_Ty)]);
     }
 
     template <typename _Ty>
@@ -183,7 +184,7 @@ public:
     const _Ty& operator[](_Ty idx) const
     {
         assert(sizeof(_Ty) == _stride);
-        return (const _Ty&)_buffer[idx * _stride];
+        return *reinterpret_cast<const _Ty*>(&_buffer[idx * _stride]);
     }
 
     uint8_t* data() noexcept { return _buffer.data(); }
@@ -228,6 +229,8 @@ struct AX_DLL MeshVertexAttrib
     backend::VertexFormat type;
     shaderinfos::VertexKey vertexAttrib;
     int getAttribSizeBytes() const;
+    /** Whether the integer components are mapped to [0, 1] or [-1, 1] when the vertices are fetched. */
+    bool isNormalized() const;
 };
 
 /** model node data, since 3.3
@@ -0,0 +1,466 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/CascadedShadowMap.h"
+#include "3d/3DProgramInfo.h"
+#include "3d/LightClusters.h"
+#include "3d/Mesh.h"
+#include "3d/MeshRenderer.h"
+#include "3d/MeshSkin.h"
+#include "3d/MeshVertexIndexData.h"
+#include "2d/Camera.h"
+#include "2d/Light.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
+#include "renderer/Pass.h"
+#include "renderer/Renderer.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureCache.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramManager.h"
+#include "renderer/backend/ProgramState.h"
+#include "renderer/backend/RenderTarget.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ax
+{
+
+// the palette of the skinned depth shader, see skinPositionTexture.vert
+static const ssize_t MAX_SKIN_PALETTE_SIZE = 60 * 3;
+
+std::vector<CascadedShadowMap*> CascadedShadowMap::_shadowMaps;
+std::vector<MeshRenderer*> CascadedShadowMap::_casters;
+
+CascadedShadowMap* CascadedShadowMap::create(DirectionLight* light, int cascades, int mapSize)
+{
+    auto shadowMap = new CascadedShadowMap();
+    if (shadowMap->init(light, cascades, mapSize))
+    {
+        shadowMap->autorelease();
+        return shadowMap;
+    }
+    AX_SAFE_DELETE(shadowMap);
+    return nullptr;
+}
+
+bool CascadedShadowMap::isSupported()
+{
+    return LightClusters::isSupported();
+}
+
+CascadedShadowMap::CascadedShadowMap() {}
+
+CascadedShadowMap::~CascadedShadowMap()
+{
+    std::erase(_shadowMaps, this);
+    if (_recreatedListener)
+        _eventDispatcher->removeEventListener(_recreatedListener);
+
+    releaseTargets();
+    for (auto&& it : _depthDraws)
+    {
+        for (auto programState : it.second->programStates)
+            AX_SAFE_RELEASE(programState);
+        it.second->mesh->release();
+    }
+    AX_SAFE_RELEASE(_light);
+}
+
+bool CascadedShadowMap::init(DirectionLight* light, int cascades, int mapSize)
+{
+    AXASSERT(light, "Invalid light");
+    if (!light || !Node::init())
+        return false;
+
+    _light = light;
+    _light->retain();
+    _cascades.setCascadeCount(cascades);
+    _cascades.setMapSize(mapSize);
+    _shadowMaps.emplace_back(this);
+
+    // the targets are created again when they are used
+    _recreatedListener =
+        _eventDispatcher->addCustomEventListener(EVENT_RENDERER_RECREATED, [this](EventCustom*) { releaseTargets(); });
+    return true;
+}
+
+void CascadedShadowMap::setShadowDistance(float distance)
+{
+    _shadowDistance = distance;
+    _preparedCamera = nullptr;
+}
+
+void CascadedShadowMap::setSplitLambda(float lambda)
+{
+    _cascades.setSplitLambda(lambda);
+    _preparedCamera = nullptr;
+}
+
+void CascadedShadowMap::addCaster(MeshRenderer* caster)
+{
+    if (std::find(_casters.begin(), _casters.end(), caster) == _casters.end())
+        _casters.emplace_back(caster);
+}
+
+void CascadedShadowMap::removeCaster(MeshRenderer* caster)
+{
+    std::erase(_casters, caster);
+}
+
+CascadedShadowMap* CascadedShadowMap::findShadowMap(const Camera* camera, unsigned int lightMask)
+{
+    for (auto shadowMap : _shadowMaps)
+    {
+        if (!shadowMap->isRunning() || !shadowMap->isVisible() || shadowMap->getScene() != camera->getScene())
+            continue;
+        if (!(shadowMap->getCameraMask() & static_cast<unsigned short>(camera->getCameraFlag())))
+            continue;
+
+        auto light = shadowMap->_light;
+        if (light->isEnabled() && (static_cast<unsigned int>(light->getLightFlag()) & lightMask))
+            return shadowMap;
+    }
+    return nullptr;
+}
+
+const DirectionLight* CascadedShadowMap::getShadowLight(unsigned int lightMask)
+{
+    auto camera    = Camera::getVisitingCamera();
+    auto shadowMap = camera ? findShadowMap(camera, lightMask) : nullptr;
+    return shadowMap ? shadowMap->_light : nullptr;
+}
+
+void CascadedShadowMap::bind(Pass* pass, unsigned int lightMask)
+{
+    auto camera    = Camera::getVisitingCamera();
+    auto shadowMap = camera ? findShadowMap(camera, lightMask) : nullptr;
+    auto white     = Director::getInstance()->getTextureCache()->getWhiteTexture()->getBackendTexture();
+    if (!shadowMap)
+    {
+        Vec4 params;
+        pass->setUniformShadowParams(&params, sizeof(params));
+        for (int i = 0; i < ShadowCascades::MAX_CASCADES; ++i)
+            pass->setUniformShadowMap(i, TEXTURE_SLOT + i, white);
+        return;
+    }
+
+    shadowMap->prepare(camera);
+    // the unused cascades still need a texture on some backends
+    for (int i = 0; i < ShadowCascades::MAX_CASCADES; ++i)
+    {
+        auto texture = shadowMap->_targets[i].color;
+        pass->setUniformShadowMap(i, TEXTURE_SLOT + i,
+                                  i < shadowMap->getCascadeCount() ? texture->getBackendTexture() : white);
+    }
+    pass->setUniformShadowMatrices(shadowMap->_shadowMatrices, sizeof(shadowMap->_shadowMatrices));
+    pass->setUniformShadowSplits(&shadowMap->_shadowSplits, sizeof(shadowMap->_shadowSplits));
+    pass->setUniformShadowDepth(&shadowMap->_shadowDepth, sizeof(shadowMap->_shadowDepth));
+    pass->setUniformShadowBias(&shadowMap->_shadowBias, sizeof(shadowMap->_shadowBias));
+    pass->setUniformShadowParams(&shadowMap->_shadowParams, sizeof(shadowMap->_shadowParams));
+
+    auto light         = shadowMap->_light;
+    float intensity    = light->getIntensity() / 255.0f;
+    const Color3B& col = light->getDisplayedColor();
+    Vec3 color(col.r * intensity, col.g * intensity, col.b * intensity);
+    Vec3 direction = light->getDirectionInWorld();
+    direction.normalize();
+    pass->setUniformShadowLightColor(&color, sizeof(color));
+    pass->setUniformShadowLightDir(&direction, sizeof(direction));
+}
+
+void CascadedShadowMap::prepare(const Camera* camera)
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (_preparedCamera == camera && _preparedFrame == frame)
+        return;
+    _preparedCamera = camera;
+    _preparedFrame  = frame;
+
+    if (!_targets[0].renderTarget)
+        createTargets();
+
+    float farPlane   = camera->getFarPlane();
+    if (_shadowDistance > 0.0f)
+        farPlane = (std::min)(_shadowDistance, farPlane);
+    const Mat4& view = camera->getViewMatrix();
+    _cascades.update(view, camera->getProjectionMatrix(), camera->getNearPlane(), farPlane,
+                     _light->getDirectionInWorld());
+
+    const int count = _cascades.getCascadeCount();
+    for (auto&& target : _targets)
+    {
+        target.visible.clear();
+        target.animated = false;
+    }
+
+    // the casters of each cascade, the depth range of the cascades grows to include them
+    auto scene = getScene();
+    for (auto caster : _casters)
+    {
+        if (!caster->isRunning() || !caster->isVisible() || caster->getScene() != scene)
+            continue;
+
+        bool skinned = std::any_of(caster->getMeshes().begin(), caster->getMeshes().end(),
+                                   [](const Mesh* mesh) { return mesh->getSkin() != nullptr; });
+        const AABB& bounds = caster->getAABB();
+        Mat4 transform     = caster->getNodeToWorldTransform();
+        for (int i = 0; i < count; ++i)
+        {
+            if (!_cascades.addCaster(i, bounds))
+                continue;
+            _targets[i].visible.emplace_back(CasterState{caster, transform});
+            _targets[i].animated |= skinned;
+        }
+    }
+    _cascades.computeMatrices();
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto& target               = _targets[i];
+        const Mat4& viewProjection = _cascades.getViewProjection(i);
+        target.dirty = target.dirty || target.animated || target.visible != target.casters ||
+                       !std::equal(viewProjection.m, viewProjection.m + 16, target.viewProjection.m);
+
+        // the bias in texels, scaled to the depth range of the cascade
+        float texel           = 2.0f * _cascades.getRadius(i) / _cascades.getMapSize();
+        _shadowMatrices[i]    = viewProjection;
+        (&_shadowSplits.x)[i] = _cascades.getSplit(i);
+        (&_shadowBias.x)[i]   = _depthBias * texel / _cascades.getDepthRange(i);
+    }
+
+    // the view depth is the negated view space z
+    _shadowDepth.set(-view.m[2], -view.m[6], -view.m[10], -view.m[14]);
+#ifdef AX_USE_METAL
+    // the render targets are top to bottom, the depth range is 0 to 1
+    _shadowParams.set(static_cast<float>(count), 1.0f / _cascades.getMapSize(), -1.0f, 1.0f);
+#else
+    _shadowParams.set(static_cast<float>(count), 1.0f / _cascades.getMapSize(), 1.0f, 0.5f);
+#endif
+}
+
+void CascadedShadowMap::draw(Renderer* renderer, const Mat4& /*transform*/, uint32_t /*flags*/)
+{
+    auto camera = Camera::getVisitingCamera();
+    if (!camera || !_light->isEnabled())
+        return;
+
+    prepare(camera);
+    for (int i = 0; i < _cascades.getCascadeCount(); ++i)
+    {
+        if (_targets[i].dirty)
+            drawCascade(renderer, i);
+    }
+    purgeDepthDraws();
+}
+
+void CascadedShadowMap::drawCascade(Renderer* renderer, int cascade)
+{
+    auto& target = _targets[cascade];
+
+    // drawn before everything else the camera draws, the depth pass is done when the receivers are drawn
+    const float globalZ = std::numeric_limits<float>::lowest();
+    auto groupCommand   = renderer->getNextGroupCommand();
+    groupCommand->init(globalZ);
+    renderer->addCommand(groupCommand);
+    renderer->pushGroup(groupCommand->getRenderQueueID());
+
+    auto beginCommand = renderer->nextCallbackCommand();
+    beginCommand->init(globalZ);
+    beginCommand->func = [this, cascade]() { onBeginCascade(cascade); };
+    renderer->addCommand(beginCommand);
+    renderer->clear(ClearFlag::COLOR | ClearFlag::DEPTH, Color4F::WHITE, 1.0f, 0, globalZ);
+
+    // the mesh commands are in the 3D opaque queue, drawn with depth test and write and back face culling
+    const Mat4& viewProjection = _cascades.getViewProjection(cascade);
+    for (auto&& state : target.visible)
+    {
+        auto caster = const_cast<MeshRenderer*>(state.caster);
+        if (auto skeleton = caster->getSkeleton())
+            skeleton->updateBoneMatrix();
+
+        Mat4 matrix = viewProjection * state.transform;
+        for (auto mesh : caster->getMeshes())
+        {
+            auto skin = mesh->getSkin();
+            if (!mesh->isVisible() || (skin && skin->getMatrixPaletteSize() > MAX_SKIN_PALETTE_SIZE))
+                continue;
+
+            auto depthDraw    = getDepthDraw(mesh);
+            auto programState = depthDraw->programStates[cascade];
+            programState->setUniform(depthDraw->locMVPMatrix, matrix.m, sizeof(matrix.m));
+            if (skin)
+                programState->setUniform(depthDraw->locMatrixPalette, skin->getMatrixPalette(),
+                                         static_cast<uint32_t>(skin->getMatrixPaletteSizeInBytes()));
+
+            auto& command = depthDraw->commands[cascade];
+            command.init(globalZ);
+            command.setVertexBuffer(mesh->getVertexBuffer());
+            command.setIndexBuffer(mesh->getIndexBuffer(), mesh->getIndexFormat());
+            command.setIndexDrawInfo(0, mesh->getIndexCount());
+            renderer->addCommand(&command);
+        }
+    }
+
+    // after the 3D queues
+    auto endCommand = renderer->nextCallbackCommand();
+    endCommand->init(0.0f);
+    endCommand->func = AX_CALLBACK_0(CascadedShadowMap::onEndCascade, this);
+    renderer->addCommand(endCommand);
+    renderer->popGroup();
+
+    target.viewProjection = viewProjection;
+    target.casters        = target.visible;
+    target.dirty          = false;
+    ++target.drawCount;
+}
+
+void CascadedShadowMap::onBeginCascade(int cascade)
+{
+    auto renderer    = _director->getRenderer();
+    _oldRenderTarget = renderer->getRenderTarget();
+    _oldViewport     = renderer->getViewport();
+
+    int size = _cascades.getMapSize();
+    renderer->setRenderTarget(_targets[cascade].renderTarget);
+    renderer->setViewPort(0, 0, size, size);
+}
+
+void CascadedShadowMap::onEndCascade()
+{
+    auto renderer = _director->getRenderer();
+    renderer->setViewPort(_oldViewport.x, _oldViewport.y, _oldViewport.width, _oldViewport.height);
+    renderer->setRenderTarget(_oldRenderTarget);
+}
+
+CascadedShadowMap::DepthDraw* CascadedShadowMap::getDepthDraw(Mesh* mesh)
+{
+    auto& depthDraw = _depthDraws[mesh];
+    if (depthDraw)
+        return depthDraw.get();
+
+    depthDraw       = std::make_unique<DepthDraw>();
+    depthDraw->mesh = mesh;
+    mesh->retain();
+
+    auto program = backend::ProgramManager::getInstance()->getBuiltinProgram(
+        mesh->getSkin() ? backend::ProgramType::SHADOW_DEPTH_SKIN_3D : backend::ProgramType::SHADOW_DEPTH_3D);
+    auto programState = new backend::ProgramState(program);
+    programState->setUniformBufferOwned(true);
+
+    // the layout of the mesh vertices, built like VertexAttribBinding does
+    auto vertexData        = mesh->getMeshIndexData()->getMeshVertexData();
+    auto vertexLayout      = programState->getMutableVertexLayout();
+    const auto& attributes = program->getActiveAttributes();
+    int offset             = 0;
+    for (ssize_t k = 0; k < vertexData->getMeshVertexAttribCount(); ++k)
+    {
+        const auto& meshAttribute = vertexData->getMeshVertexAttrib(k);
+        auto name                 = shaderinfos::getAttributeName(meshAttribute.vertexAttrib);
+        auto it                   = attributes.find(name);
+        if (it != attributes.end())
+            vertexLayout->setAttrib(name, it->second.location, meshAttribute.type, offset,
+                                    meshAttribute.isNormalized());
+        offset += meshAttribute.getAttribSizeBytes();
+    }
+    vertexLayout->setStride(offset);
+
+    depthDraw->locMVPMatrix     = programState->getUniformLocation("u_MVPMatrix");
+    depthDraw->locMatrixPalette = programState->getUniformLocation("u_matrixPalette");
+    for (int i = 0; i < ShadowCascades::MAX_CASCADES; ++i)
+    {
+        depthDraw->programStates[i] = i == 0 ? programState : programState->clone();
+
+        auto& command = depthDraw->commands[i];
+        command.setTransparent(false);
+        command.set3D(true);
+        command.setPrimitiveType(mesh->getPrimitiveType());
+        command.setDrawType(MeshCommand::DrawType::ELEMENT);
+        command.getPipelineDescriptor().programState                 = depthDraw->programStates[i];
+        command.getPipelineDescriptor().blendDescriptor.blendEnabled = false;
+    }
+    return depthDraw.get();
+}
+
+void CascadedShadowMap::purgeDepthDraws()
+{
+    // the meshes only referenced by the depth draws are gone
+    for (auto it = _depthDraws.begin(); it != _depthDraws.end();)
+    {
+        auto& depthDraw = it->second;
+        if (depthDraw->mesh->getReferenceCount() > 1)
+        {
+            ++it;
+            continue;
+        }
+        for (auto programState : depthDraw->programStates)
+            AX_SAFE_RELEASE(programState);
+        depthDraw->mesh->release();
+        it = _depthDraws.erase(it);
+    }
+}
+
+void CascadedShadowMap::createTargets()
+{
+    int size = _cascades.getMapSize();
+    backend::TextureDescriptor descriptor;
+    descriptor.width        = size;
+    descriptor.height       = size;
+    descriptor.textureUsage = backend::TextureUsage::RENDER_TARGET;
+
+    for (int i = 0; i < _cascades.getCascadeCount(); ++i)
+    {
+        auto& target             = _targets[i];
+        descriptor.textureFormat = backend::PixelFormat::RGBA8;
+        target.color             = new Texture2D();
+        target.color->updateTextureDescriptor(descriptor);
+        // the packed depth must not be filtered
+        target.color->setAliasTexParameters();
+
+        descriptor.textureFormat = backend::PixelFormat::D24S8;
+        target.depth             = new Texture2D();
+        target.depth->updateTextureDescriptor(descriptor);
+
+        target.renderTarget = backend::DriverBase::getInstance()->newRenderTarget(
+            target.color->getBackendTexture(), target.depth->getBackendTexture(), target.depth->getBackendTexture());
+        target.dirty = true;
+    }
+}
+
+void CascadedShadowMap::releaseTargets()
+{
+    for (auto&& target : _targets)
+    {
+        AX_SAFE_RELEASE_NULL(target.renderTarget);
+        AX_SAFE_RELEASE_NULL(target.color);
+        AX_SAFE_RELEASE_NULL(target.depth);
+        target.casters.clear();
+        target.dirty = true;
+    }
+    _preparedCamera = nullptr;
+}
+
+}  // namespace ax
@@ -0,0 +1,223 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "2d/Node.h"
+#include "3d/ShadowCascades.h"
+#include "renderer/MeshCommand.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+class DirectionLight;
+class Camera;
+class Mesh;
+class MeshRenderer;
+class Pass;
+class Texture2D;
+class EventListenerCustom;
+
+namespace backend
+{
+class RenderTarget;
+class ProgramState;
+}  // namespace backend
+
+/**
+ * @brief CascadedShadowMap, the shadows of a DirectionLight for the cameras of its camera mask.
+ *
+ * The shadow casters are the mesh renderers enabled with MeshRenderer::setCastShadow, they are drawn into one
+ * depth map per cascade, see ShadowCascades, by a depth only pass recorded in the draw of the shadow map node:
+ * the meshes are not visited again, the pass records one MeshCommand per mesh and cascade from their buffers.
+ * Casters outside a cascade are culled by their bounds. A cascade is only drawn again if its matrices changed or
+ * one of its casters moved, so the cascades of static scenes are drawn once while the camera moves by less than
+ * a texel. Skinned casters are drawn each frame.
+ *
+ * The shadows are received by the meshes of MeshMaterial::MaterialType::DIFFUSE_CLUSTERED materials lit by the
+ * light, the light is then evaluated with the shadow instead of as one of the directional light uniforms. Add the
+ * shadow map to the scene and set its camera mask to the one of the receivers, the depth is packed into RGBA8
+ * textures since depth texture sampling isn't available on all backends.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL CascadedShadowMap : public Node
+{
+public:
+    /** The first texture slot of the cascades, after the light clusters. */
+    static constexpr int TEXTURE_SLOT = 4;
+
+    /**
+     * @param light The light casting the shadows, retained.
+     * @param cascades The amount of cascades, from 1 to ShadowCascades::MAX_CASCADES.
+     * @param mapSize The texels per side of the depth map of each cascade.
+     */
+    static CascadedShadowMap* create(DirectionLight* light, int cascades = 3, int mapSize = 1024);
+
+    /** Whether the shadows can be received, the receiving material is only available where this is true. */
+    static bool isSupported();
+
+    /**
+     * Binds the shadow map of the visiting camera to a pass, and fits its cascades to the camera the first
+     * time in a frame. Without a shadow map for the camera and the light mask, no cascade is bound.
+     * @param lightMask The light flags the mesh is lit by.
+     */
+    static void bind(Pass* pass, unsigned int lightMask);
+
+    /** The light of the shadow map bound to the visiting camera and light mask, or nullptr. */
+    static const DirectionLight* getShadowLight(unsigned int lightMask);
+
+    /** Registers a shadow caster, see MeshRenderer::setCastShadow. */
+    static void addCaster(MeshRenderer* caster);
+    static void removeCaster(MeshRenderer* caster);
+
+    DirectionLight* getLight() const { return _light; }
+
+    int getCascadeCount() const { return _cascades.getCascadeCount(); }
+    int getMapSize() const { return _cascades.getMapSize(); }
+
+    /**
+     * Sets the view distance the shadows end at, 0 to use the far plane of the camera. The default is 100,
+     * the texels of the cascades are spread over this distance.
+     */
+    void setShadowDistance(float distance);
+    float getShadowDistance() const { return _shadowDistance; }
+
+    /** Sets the blend of logarithmic to uniform cascade splits, the default is 0.75. */
+    void setSplitLambda(float lambda);
+    float getSplitLambda() const { return _cascades.getSplitLambda(); }
+
+    /**
+     * Sets the depth bias applied to the receivers, in texels of the cascade they are in. The default is 1.5,
+     * larger values remove shadow acne and detach the shadows from their casters.
+     */
+    void setDepthBias(float texels) { _depthBias = texels; }
+    float getDepthBias() const { return _depthBias; }
+
+    /** The cascades, fitted to the last camera. */
+    const ShadowCascades& getCascades() const { return _cascades; }
+
+    /** The depth map of a cascade. */
+    Texture2D* getShadowTexture(int cascade) const { return _targets[cascade].color; }
+
+    /** The amount of casters drawn into a cascade when it was drawn the last time. */
+    size_t getCasterCount(int cascade) const { return _targets[cascade].casters.size(); }
+
+    /** The amount of times a cascade was drawn. */
+    unsigned int getDrawCount(int cascade) const { return _targets[cascade].drawCount; }
+
+    // Overrides
+    void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
+
+    CascadedShadowMap();
+    ~CascadedShadowMap() override;
+
+    bool init(DirectionLight* light, int cascades, int mapSize);
+
+protected:
+    struct CasterState
+    {
+        const MeshRenderer* caster;
+        Mat4 transform;
+        bool operator==(const CasterState& other) const
+        {
+            return caster == other.caster && std::equal(transform.m, transform.m + 16, other.transform.m);
+        }
+    };
+
+    struct Target
+    {
+        Texture2D* color                    = nullptr;
+        Texture2D* depth                    = nullptr;
+        backend::RenderTarget* renderTarget = nullptr;
+
+        Mat4 viewProjection;  // when the casters were drawn
+        std::vector<CasterState> casters;
+        std::vector<CasterState> visible;  // the casters in the cascade in this frame
+        bool animated          = false;    // a visible caster is skinned
+        bool dirty             = true;
+        unsigned int drawCount = 0;
+    };
+
+    // the depth pass commands of one mesh, one per cascade since their matrices differ
+    struct DepthDraw
+    {
+        Mesh* mesh = nullptr;
+        backend::ProgramState* programStates[ShadowCascades::MAX_CASCADES]{};
+        backend::UniformLocation locMVPMatrix;
+        backend::UniformLocation locMatrixPalette;
+        MeshCommand commands[ShadowCascades::MAX_CASCADES];
+    };
+
+    static CascadedShadowMap* findShadowMap(const Camera* camera, unsigned int lightMask);
+
+    void prepare(const Camera* camera);
+    void createTargets();
+    void releaseTargets();
+    void drawCascade(Renderer* renderer, int cascade);
+    DepthDraw* getDepthDraw(Mesh* mesh);
+    void purgeDepthDraws();
+
+    void onBeginCascade(int cascade);
+    void onEndCascade();
+
+    DirectionLight* _light = nullptr;
+    ShadowCascades _cascades;
+    float _shadowDistance = 100.0f;
+    float _depthBias      = 1.5f;
+
+    Target _targets[ShadowCascades::MAX_CASCADES];
+    std::unordered_map<const Mesh*, std::unique_ptr<DepthDraw>> _depthDraws;
+
+    // the uniforms of the receivers
+    Mat4 _shadowMatrices[ShadowCascades::MAX_CASCADES];
+    Vec4 _shadowSplits;
+    Vec4 _shadowDepth;
+    Vec4 _shadowBias;
+    Vec4 _shadowParams;
+
+    const Camera* _preparedCamera = nullptr;  // weak ref, only compared
+    unsigned int _preparedFrame   = 0;
+
+    backend::RenderTarget* _oldRenderTarget = nullptr;
+    Viewport _oldViewport;
+
+    EventListenerCustom* _recreatedListener = nullptr;
+
+    static std::vector<CascadedShadowMap*> _shadowMaps;
+    static std::vector<MeshRenderer*> _casters;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
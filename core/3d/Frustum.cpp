@@ -26,13 +26,60 @@
 #include "3d/Frustum.h"
 #include "2d/Camera.h"
 
+#if defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1)
+#    define AX_FRUSTUM_NEON 1
+#endif
+
 namespace ax
 {
 
+void BoundsBatch::clear()
+{
+    for (auto array : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ, &_radius})
+        array->clear();
+}
+
+void BoundsBatch::reserve(size_t count)
+{
+    for (auto array : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ, &_radius})
+        array->reserve(count);
+}
+
+size_t BoundsBatch::add(const AABB& aabb)
+{
+    const auto center = (aabb._min + aabb._max) * 0.5f;
+    const auto extent = (aabb._max - aabb._min) * 0.5f;
+    _centerX.push_back(center.x);
+    _centerY.push_back(center.y);
+    _centerZ.push_back(center.z);
+    _extentX.push_back(extent.x);
+    _extentY.push_back(extent.y);
+    _extentZ.push_back(extent.z);
+    _radius.push_back(0.0f);
+    return size() - 1;
+}
+
+size_t BoundsBatch::add(const Vec3& center, float radius)
+{
+    _centerX.push_back(center.x);
+    _centerY.push_back(center.y);
+    _centerZ.push_back(center.z);
+    _extentX.push_back(0.0f);
+    _extentY.push_back(0.0f);
+    _extentZ.push_back(0.0f);
+    _radius.push_back(radius);
+    return size() - 1;
+}
+
 bool Frustum::initFrustum(const Camera* camera)
+{
+    return initFrustum(camera->getViewProjectionMatrix());
+}
+
+bool Frustum::initFrustum(const Mat4& viewProjection)
 {
     _initialized = true;
-    createPlane(camera);
+    createPlane(viewProjection);
     return true;
 }
 bool Frustum::isOutOfFrustum(const AABB& aabb) const
@@ -81,9 +128,97 @@ bool Frustum::isOutOfFrustum(const OBB& obb) const
     return false;
 }
 
-void Frustum::createPlane(const Camera* camera)
+void Frustum::cull(const BoundsBatch& batch, std::vector<uint32_t>& visibility) const
+{
+    const size_t count = batch.size();
+    visibility.assign((count + 31) / 32, 0);
+    if (!_initialized)
+    {
+        for (size_t i = 0; i < count; ++i)
+            visibility[i >> 5] |= 1u << (i & 31);
+        return;
+    }
+
+    // a volume is out when its nearest point to a plane is in front of it: n.c - dist > |n|.e + r
+    const int planeCount = _clipZ ? 6 : 4;
+    float nx[6], ny[6], nz[6], dist[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < planeCount; ++p)
+    {
+        const Vec3& normal = _plane[p].getNormal();
+        nx[p]              = normal.x;
+        ny[p]              = normal.y;
+        nz[p]              = normal.z;
+        dist[p]            = -_plane[p].getDist();
+        ax[p]              = std::abs(normal.x);
+        ay[p]              = std::abs(normal.y);
+        az[p]              = std::abs(normal.z);
+    }
+
+    size_t i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 cx     = _mm_loadu_ps(&batch._centerX[i]);
+        const __m128 cy     = _mm_loadu_ps(&batch._centerY[i]);
+        const __m128 cz     = _mm_loadu_ps(&batch._centerZ[i]);
+        const __m128 ex     = _mm_loadu_ps(&batch._extentX[i]);
+        const __m128 ey     = _mm_loadu_ps(&batch._extentY[i]);
+        const __m128 ez     = _mm_loadu_ps(&batch._extentZ[i]);
+        const __m128 radius = _mm_loadu_ps(&batch._radius[i]);
+
+        __m128 out = _mm_setzero_ps();
+        for (int p = 0; p < planeCount; ++p)
+        {
+            __m128 d = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(nx[p])), _mm_mul_ps(cy, _mm_set1_ps(ny[p])));
+            d        = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(nz[p])), _mm_set1_ps(dist[p])));
+            __m128 r = _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(ax[p])), _mm_mul_ps(ey, _mm_set1_ps(ay[p])));
+            r        = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(ez, _mm_set1_ps(az[p])), radius));
+            out      = _mm_or_ps(out, _mm_cmpgt_ps(d, r));
+        }
+        visibility[i >> 5] |= uint32_t(~_mm_movemask_ps(out) & 0xf) << (i & 31);
+    }
+#elif defined(AX_FRUSTUM_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t cx     = vld1q_f32(&batch._centerX[i]);
+        const float32x4_t cy     = vld1q_f32(&batch._centerY[i]);
+        const float32x4_t cz     = vld1q_f32(&batch._centerZ[i]);
+        const float32x4_t ex     = vld1q_f32(&batch._extentX[i]);
+        const float32x4_t ey     = vld1q_f32(&batch._extentY[i]);
+        const float32x4_t ez     = vld1q_f32(&batch._extentZ[i]);
+        const float32x4_t radius = vld1q_f32(&batch._radius[i]);
+
+        uint32x4_t out = vdupq_n_u32(0);
+        for (int p = 0; p < planeCount; ++p)
+        {
+            float32x4_t d = vmlaq_n_f32(vdupq_n_f32(dist[p]), cx, nx[p]);
+            d             = vmlaq_n_f32(vmlaq_n_f32(d, cy, ny[p]), cz, nz[p]);
+            float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(radius, ex, ax[p]), ey, ay[p]), ez, az[p]);
+            out           = vorrq_u32(out, vcgtq_f32(d, r));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, out);
+        const uint32_t outBits = (lanes[0] & 1) | (lanes[1] & 2) | (lanes[2] & 4) | (lanes[3] & 8);
+        visibility[i >> 5] |= (~outBits & 0xf) << (i & 31);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        bool out = false;
+        for (int p = 0; p < planeCount && !out; ++p)
+        {
+            const float d = batch._centerX[i] * nx[p] + batch._centerY[i] * ny[p] + batch._centerZ[i] * nz[p] + dist[p];
+            const float r = batch._extentX[i] * ax[p] + batch._extentY[i] * ay[p] + batch._extentZ[i] * az[p] +
+                            batch._radius[i];
+            out = d > r;
+        }
+        if (!out)
+            visibility[i >> 5] |= 1u << (i & 31);
+    }
+}
+
+void Frustum::createPlane(const Mat4& mat)
 {
-    const Mat4& mat = camera->getViewProjectionMatrix();
     // ref http://www.lighthouse3d.com/tutorials/view-frustum-culling/clip-space-approach-extracting-the-planes/
     // extract frustum plane
     _plane[0].initPlane(-Vec3(mat.m[3] + mat.m[0], mat.m[7] + mat.m[4], mat.m[11] + mat.m[8]),
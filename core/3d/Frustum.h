@@ -32,11 +32,44 @@
 #include "3d/OBB.h"
 #include "3d/Plane.h"
 
+#include <vector>
+
 namespace ax
 {
 
 class Camera;
 
+/**
+ * Bounding volumes in structure of arrays layout, Frustum::cull tests 4 of them at a time.
+ * A box is kept as its center and half size, a sphere as its center and radius.
+ */
+class AX_DLL BoundsBatch
+{
+public:
+    void clear();
+    void reserve(size_t count);
+
+    /** Adds a box, returns its index in the visibility mask. */
+    size_t add(const AABB& aabb);
+    /** Adds a sphere, returns its index in the visibility mask. */
+    size_t add(const Vec3& center, float radius);
+
+    size_t size() const { return _centerX.size(); }
+
+    /** Whether the volume at index is visible in a mask filled by Frustum::cull. */
+    static bool isVisible(const std::vector<uint32_t>& visibility, size_t index)
+    {
+        return (visibility[index >> 5] >> (index & 31)) & 1;
+    }
+
+protected:
+    friend class Frustum;
+
+    std::vector<float> _centerX, _centerY, _centerZ;
+    std::vector<float> _extentX, _extentY, _extentZ;
+    std::vector<float> _radius;
+};
+
 /**
  * the frustum is a six-side geometry, usually use the frustum to do fast-culling:
  * check a entity whether is a potential visible entity
@@ -58,6 +91,10 @@ public:
      * init frustum from camera.
      */
     bool initFrustum(const Camera* camera);
+    /**
+     * init frustum from a view projection matrix.
+     */
+    bool initFrustum(const Mat4& viewProjection);
 
     /**
      * is aabb out of frustum.
@@ -67,6 +104,11 @@ public:
      * is obb out of frustum
      */
     bool isOutOfFrustum(const OBB& obb) const;
+    /**
+     * Tests all the volumes of a batch, the bit i of visibility is set when the volume i isn't out of frustum.
+     * Uses SSE or NEON when available.
+     */
+    void cull(const BoundsBatch& batch, std::vector<uint32_t>& visibility) const;
 
     /**
      * get & set z clip. if bclipZ == true use near and far plane
@@ -78,7 +120,7 @@ protected:
     /**
      * create clip plane
      */
-    void createPlane(const Camera* camera);
+    void createPlane(const Mat4& mat);
 
     Plane _plane[6];  // clip plane, left, right, top, bottom, near, far
     bool _clipZ;      // use near and far clip plane
@@ -0,0 +1,204 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/LODGroup.h"
+#include "3d/MeshRenderer.h"
+#include "2d/Camera.h"
+#include "base/Director.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+LODGroup* LODGroup::create()
+{
+    auto group = new LODGroup();
+    if (group->init())
+    {
+        group->autorelease();
+        return group;
+    }
+    AX_SAFE_DELETE(group);
+    return nullptr;
+}
+
+LODGroup::LODGroup() {}
+
+LODGroup::~LODGroup() {}
+
+void LODGroup::addLevel(Node* level, float minScreenSize)
+{
+    AXASSERT(level && !level->getParent(), "the level must be a node without parent");
+
+    addChild(level);
+    auto it = std::upper_bound(_levels.begin(), _levels.end(), minScreenSize,
+                               [](float size, const Level& other) { return size > other.minScreenSize; });
+    _levels.insert(it, Level{level, minScreenSize});
+    _currentLevel = -1;
+    _fadingLevel  = -1;
+}
+
+void LODGroup::removeAllLevels()
+{
+    while (!_levels.empty())
+        removeChild(_levels.back().node);
+}
+
+void LODGroup::removeChild(Node* child, bool cleanup)
+{
+    auto it = std::find_if(_levels.begin(), _levels.end(), [child](const Level& level) { return level.node == child; });
+    if (it != _levels.end())
+    {
+        // a cross fade in progress is dropped
+        if (_fadingLevel >= 0)
+        {
+            for (auto&& level : _levels)
+                level.node->setOpacity(255);
+        }
+        _levels.erase(it);
+        _currentLevel = -1;
+        _fadingLevel  = -1;
+    }
+    Node::removeChild(child, cleanup);
+}
+
+void LODGroup::removeAllChildrenWithCleanup(bool cleanup)
+{
+    _levels.clear();
+    _currentLevel = -1;
+    _fadingLevel  = -1;
+    Node::removeAllChildrenWithCleanup(cleanup);
+}
+
+Node* LODGroup::getLevel(int index) const
+{
+    AXASSERT(index >= 0 && index < static_cast<int>(_levels.size()), "invalid level index");
+    return _levels[index].node;
+}
+
+float LODGroup::computeScreenSize(const Mat4& transform) const
+{
+    auto camera = Camera::getVisitingCamera();
+    if (!camera || _levels.empty())
+        return 0.0f;
+
+    Vec3 center;
+    float radius = _boundingRadius;
+    if (radius <= 0.0f)
+    {
+        auto meshRenderer = dynamic_cast<MeshRenderer*>(_levels.front().node);
+        if (!meshRenderer)
+            return 0.0f;
+        auto aabb = meshRenderer->getAABBRecursively();
+        if (aabb.isEmpty())
+            return 0.0f;
+        center = aabb.getCenter();
+        radius = (aabb._max - aabb._min).length() * 0.5f;
+    }
+    else
+    {
+        center.set(transform.m[12], transform.m[13], transform.m[14]);
+    }
+
+    // the projected diameter over the viewport height, the same for perspective and orthographic cameras
+    Vec4 clip;
+    camera->getViewProjectionMatrix().transformVector(Vec4(center.x, center.y, center.z, 1.0f), &clip);
+    if (clip.w <= 0.0f)
+        return std::numeric_limits<float>::max();
+    return radius * std::abs(camera->getProjectionMatrix().m[5]) / clip.w;
+}
+
+int LODGroup::selectLevel(float screenSize) const
+{
+    for (int i = 0, count = static_cast<int>(_levels.size()); i < count; ++i)
+    {
+        if (screenSize >= _levels[i].minScreenSize)
+            return i;
+    }
+    return -1;
+}
+
+void LODGroup::updateFade(int level)
+{
+    if (level != _currentLevel)
+    {
+        if (_fadingLevel >= 0)
+            _levels[_fadingLevel].node->setOpacity(255);
+        _fadingLevel  = _currentLevel;
+        _currentLevel = level;
+        _fadeTime     = 0.0f;
+    }
+    else if (_fadingLevel >= 0)
+    {
+        _fadeTime += _director->getDeltaTime();
+    }
+
+    if (_fadingLevel < 0)
+        return;
+
+    float t = _fadeTime / _fadeDuration;
+    if (t >= 1.0f)
+    {
+        _levels[_fadingLevel].node->setOpacity(255);
+        if (_currentLevel >= 0)
+            _levels[_currentLevel].node->setOpacity(255);
+        _fadingLevel = -1;
+        return;
+    }
+
+    auto opacity = static_cast<uint8_t>(t * 255);
+    _levels[_fadingLevel].node->setOpacity(255 - opacity);
+    if (_currentLevel >= 0)
+        _levels[_currentLevel].node->setOpacity(opacity);
+}
+
+void LODGroup::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!_visible || !isVisitableByVisitingCamera())
+        return;
+
+    if (_fadeDuration > 0.0f)
+    {
+        auto frame = _director->getTotalFrames();
+        if (frame != _frame)
+        {
+            _frame      = frame;
+            _screenSize = computeScreenSize(transform(parentTransform));
+            updateFade(selectLevel(_screenSize));
+        }
+    }
+    else
+    {
+        _screenSize   = computeScreenSize(transform(parentTransform));
+        _currentLevel = selectLevel(_screenSize);
+        _fadingLevel  = -1;
+    }
+
+    for (int i = 0, count = static_cast<int>(_levels.size()); i < count; ++i)
+        _levels[i].node->setVisible(i == _currentLevel || i == _fadingLevel);
+
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
+}  // namespace ax
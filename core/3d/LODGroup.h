@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "2d/Node.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief LODGroup, shows one of its levels of detail depending on the size of the group on the screen.
+ *
+ * The levels are children of the group, each one with the smallest screen size it's shown at. The screen size is
+ * the projected diameter of the bounding sphere over the viewport height, e.g. 0.5 when the object covers half of
+ * the screen height. Below the screen size of the last level nothing is drawn. The bounding sphere is taken from
+ * the AABB of the first level or set with setBoundingRadius. Lower levels are usually created with
+ * MeshRenderer::createSimplified.
+ */
+class AX_DLL LODGroup : public Node
+{
+public:
+    static LODGroup* create();
+
+    /**
+     * Add a level of detail, the levels are kept sorted by their screen size, largest first.
+     *
+     * @param level the node drawn for this level
+     * @param minScreenSize the smallest screen size the level is used for
+     */
+    void addLevel(Node* level, float minScreenSize);
+
+    /** Remove all levels, the level nodes are removed from the group. */
+    void removeAllLevels();
+
+    ssize_t getLevelCount() const { return _levels.size(); }
+
+    /** get the node of a level, 0 being the most detailed one */
+    Node* getLevel(int index) const;
+
+    /** get the level shown in the last visit, -1 if the group was too small to be drawn */
+    int getCurrentLevel() const { return _currentLevel; }
+
+    /** get the screen size computed in the last visit */
+    float getScreenSize() const { return _screenSize; }
+
+    /**
+     * Set the radius in world units of the bounding sphere around the group position, 0 uses the bounding box of
+     * the first level which is the default.
+     */
+    void setBoundingRadius(float radius) { _boundingRadius = radius; }
+    float getBoundingRadius() const { return _boundingRadius; }
+
+    /**
+     * Cross fade the levels through their opacity for the given seconds when the level changes, 0 switches at
+     * once which is the default. While fading the level is selected once a frame, with the first camera visiting
+     * the group.
+     */
+    void setFadeDuration(float seconds) { _fadeDuration = seconds; }
+    float getFadeDuration() const { return _fadeDuration; }
+
+    virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
+    virtual void removeChild(Node* child, bool cleanup = true) override;
+    virtual void removeAllChildrenWithCleanup(bool cleanup) override;
+
+    LODGroup();
+    virtual ~LODGroup();
+
+protected:
+    struct Level
+    {
+        Node* node;
+        float minScreenSize;
+    };
+
+    float computeScreenSize(const Mat4& transform) const;
+    int selectLevel(float screenSize) const;
+    void updateFade(int level);
+
+    std::vector<Level> _levels;
+    int _currentLevel     = -1;
+    int _fadingLevel      = -1;
+    float _screenSize     = 0.0f;
+    float _boundingRadius = 0.0f;
+    float _fadeDuration   = 0.0f;
+    float _fadeTime       = 0.0f;
+    unsigned int _frame   = 0;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -0,0 +1,189 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/LightClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ax
+{
+
+void LightClusterGrid::setProjection(const Mat4& projection, float nearPlane, float farPlane)
+{
+    if (!_boundsDirty && std::equal(projection.m, projection.m + 16, _projection.m) && _nearPlane == nearPlane &&
+        _farPlane == farPlane)
+        return;
+    _boundsDirty = false;
+
+    _projection  = projection;
+    _nearPlane   = nearPlane;
+    _farPlane    = farPlane;
+    _perspective = projection.m[11] != 0.0f;
+    AXASSERT(!_perspective || (nearPlane > 0.0f && farPlane > nearPlane), "Invalid perspective planes");
+
+    _sliceScale = _perspective ? CLUSTER_Z / std::log(farPlane / nearPlane) : CLUSTER_Z / (farPlane - nearPlane);
+
+    // the view space corners of the tiles at the depth of a slice boundary
+    const Mat4 inverse = projection.getInversed();
+    auto corners       = [&](int slice, std::vector<Vec3>& points) {
+        float depth = _perspective ? nearPlane * std::pow(farPlane / nearPlane, float(slice) / CLUSTER_Z)
+                                   : nearPlane + (farPlane - nearPlane) * slice / CLUSTER_Z;
+        float z     = projection.m[10] * -depth + projection.m[14];
+        float w     = projection.m[11] * -depth + projection.m[15];
+        points.clear();
+        for (int y = 0; y <= CLUSTER_Y; ++y)
+        {
+            for (int x = 0; x <= CLUSTER_X; ++x)
+            {
+                Vec4 p = inverse * Vec4(2.0f * x / CLUSTER_X - 1.0f, 2.0f * y / CLUSTER_Y - 1.0f, z / w, 1.0f);
+                points.emplace_back(p.x / p.w, p.y / p.w, p.z / p.w);
+            }
+        }
+    };
+
+    _bounds.resize(CLUSTER_COUNT);
+    std::vector<Vec3> nearCorners, farCorners;
+    corners(0, farCorners);
+    for (int z = 0; z < CLUSTER_Z; ++z)
+    {
+        std::swap(nearCorners, farCorners);
+        corners(z + 1, farCorners);
+        for (int y = 0; y < CLUSTER_Y; ++y)
+        {
+            for (int x = 0; x < CLUSTER_X; ++x)
+            {
+                auto& box = _bounds[x + CLUSTER_X * (y + CLUSTER_Y * z)];
+                box.reset();
+                for (int i = 0; i < 4; ++i)
+                {
+                    int corner = x + (i & 1) + (CLUSTER_X + 1) * (y + (i >> 1));
+                    box.updateMinMax(&nearCorners[corner], 1);
+                    box.updateMinMax(&farCorners[corner], 1);
+                }
+            }
+        }
+    }
+}
+
+float LightClusterGrid::getSlice(float depth) const
+{
+    return _perspective ? std::log((std::max)(depth / _nearPlane, 1.0f)) * _sliceScale
+                        : (std::max)(depth - _nearPlane, 0.0f) * _sliceScale;
+}
+
+void LightClusterGrid::build(const Mat4& view, std::span<const Vec4> spheres)
+{
+    AXASSERT(!_boundsDirty, "The projection must be set before lights are binned");
+
+    _view           = view;
+    _viewProjection = _projection * view;
+    _pairs.clear();
+
+    for (uint32_t light = 0; light < spheres.size(); ++light)
+    {
+        const auto& sphere = spheres[light];
+        Vec3 center;
+        view.transformPoint(Vec3(sphere.x, sphere.y, sphere.z), &center);
+        float radius = sphere.w;
+
+        float minDepth = (std::max)(-center.z - radius, _nearPlane);
+        float maxDepth = (std::min)(-center.z + radius, _farPlane);
+        if (minDepth > maxDepth)
+            continue;
+
+        // the screen rect of the part of the sphere bounds in front of the near plane, both projections keep
+        // a box in front of the eye inside the hull of its projected corners
+        Vec2 ndcMin(1.0f, 1.0f), ndcMax(-1.0f, -1.0f);
+        for (int i = 0; i < 8; ++i)
+        {
+            Vec4 corner(center.x + ((i & 1) ? radius : -radius), center.y + ((i & 2) ? radius : -radius),
+                        (i & 4) ? -maxDepth : -minDepth, 1.0f);
+            Vec4 clip = _projection * corner;
+            Vec2 ndc(clip.x / clip.w, clip.y / clip.w);
+            ndcMin.set((std::min)(ndcMin.x, ndc.x), (std::min)(ndcMin.y, ndc.y));
+            ndcMax.set((std::max)(ndcMax.x, ndc.x), (std::max)(ndcMax.y, ndc.y));
+        }
+        if (ndcMax.x < -1.0f || ndcMax.y < -1.0f || ndcMin.x > 1.0f || ndcMin.y > 1.0f)
+            continue;
+
+        auto tile = [](float ndc, int count) {
+            return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * count)), 0, count - 1);
+        };
+        int x0 = tile(ndcMin.x, CLUSTER_X), x1 = tile(ndcMax.x, CLUSTER_X);
+        int y0 = tile(ndcMin.y, CLUSTER_Y), y1 = tile(ndcMax.y, CLUSTER_Y);
+        int z0 = (std::min)(static_cast<int>(getSlice(minDepth)), CLUSTER_Z - 1);
+        int z1 = (std::min)(static_cast<int>(getSlice(maxDepth)), CLUSTER_Z - 1);
+
+        float radiusSq = radius * radius;
+        for (int z = z0; z <= z1; ++z)
+        {
+            for (int y = y0; y <= y1; ++y)
+            {
+                for (int x = x0; x <= x1; ++x)
+                {
+                    uint32_t cluster = x + CLUSTER_X * (y + CLUSTER_Y * z);
+                    const auto& box  = _bounds[cluster];
+                    Vec3 closest(std::clamp(center.x, box._min.x, box._max.x),
+                                 std::clamp(center.y, box._min.y, box._max.y),
+                                 std::clamp(center.z, box._min.z, box._max.z));
+                    if (closest.distanceSquared(center) <= radiusSq)
+                        _pairs.emplace_back(cluster, light);
+                }
+            }
+        }
+    }
+
+    // counting sort by cluster, the lights of a cluster stay in order
+    _offsets.assign(CLUSTER_COUNT + 1, 0);
+    for (auto&& pair : _pairs)
+        ++_offsets[pair.first + 1];
+    for (int i = 0; i < CLUSTER_COUNT; ++i)
+        _offsets[i + 1] += _offsets[i];
+
+    _indices.resize(_pairs.size());
+    _cursors.assign(_offsets.begin(), _offsets.end() - 1);
+    for (auto&& pair : _pairs)
+        _indices[_cursors[pair.first]++] = pair.second;
+}
+
+int LightClusterGrid::getCluster(const Vec3& position) const
+{
+    Vec4 clip = _viewProjection * Vec4(position.x, position.y, position.z, 1.0f);
+    int x     = static_cast<int>(std::clamp((clip.x / clip.w * 0.5f + 0.5f) * CLUSTER_X, 0.0f, CLUSTER_X - 1.0f));
+    int y     = static_cast<int>(std::clamp((clip.y / clip.w * 0.5f + 0.5f) * CLUSTER_Y, 0.0f, CLUSTER_Y - 1.0f));
+
+    Vec3 viewPosition;
+    _view.transformPoint(position, &viewPosition);
+    int z = (std::min)(static_cast<int>(getSlice(-viewPosition.z)), CLUSTER_Z - 1);
+    return x + CLUSTER_X * (y + CLUSTER_Y * z);
+}
+
+void LightClusterGrid::getShaderParams(Vec4& depth, Vec4& params) const
+{
+    // the negated third row of the view matrix
+    depth.set(-_view.m[2], -_view.m[6], -_view.m[10], -_view.m[14]);
+    params.set(_nearPlane, _sliceScale, 0.0f, _perspective ? 1.0f : 0.0f);
+}
+
+}  // namespace ax
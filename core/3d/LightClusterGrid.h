@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "math/Mat4.h"
+#include "3d/AABB.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief LightClusterGrid, bins light spheres into the froxels of a camera for clustered forward shading.
+ *
+ * The view frustum is divided into CLUSTER_X * CLUSTER_Y screen tiles and CLUSTER_Z depth slices, the slices
+ * are exponential for perspective projections and linear for orthographic ones. Each light is tested against
+ * the view space bounds of the froxels it may touch, and the lights of all clusters are stored as one index
+ * list with an offset per cluster, the layout the clustered mesh shaders read. The froxel bounds are only
+ * computed again when the projection changes.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL LightClusterGrid
+{
+public:
+    /** The size of the grid, the clustered shaders must use the same values. */
+    static constexpr int CLUSTER_X     = 16;
+    static constexpr int CLUSTER_Y     = 9;
+    static constexpr int CLUSTER_Z     = 24;
+    static constexpr int CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+
+    /**
+     * Sets the projection of the camera, the near and far planes are the distances along the view direction.
+     */
+    void setProjection(const Mat4& projection, float nearPlane, float farPlane);
+
+    /**
+     * Bins lights, the previous result is discarded.
+     * @param view The view matrix of the camera.
+     * @param spheres The lights in world space, xyz the center and w the range.
+     */
+    void build(const Mat4& view, std::span<const Vec4> spheres);
+
+    /** The cluster containing a world space position inside the frustum, computed like the shaders do. */
+    int getCluster(const Vec3& position) const;
+
+    /** The first entry of each cluster in the index list, with one more entry past the last cluster. */
+    const std::vector<uint32_t>& getOffsets() const { return _offsets; }
+
+    /** The lights of all clusters as indices into the spheres passed to `build`. */
+    const std::vector<uint32_t>& getIndices() const { return _indices; }
+
+    /**
+     * The values the shaders compute the cluster from.
+     * @param depth The view space depth of a world position is dot(depth, (position, 1)).
+     * @param params The near plane, the slice scale and whether slices are exponential in w.
+     */
+    void getShaderParams(Vec4& depth, Vec4& params) const;
+
+    const Mat4& getViewProjection() const { return _viewProjection; }
+
+protected:
+    float getSlice(float depth) const;
+
+    Mat4 _projection;
+    Mat4 _view;
+    Mat4 _viewProjection;
+    float _nearPlane  = 0.0f;
+    float _farPlane   = 0.0f;
+    float _sliceScale = 0.0f;
+    bool _perspective = true;
+    bool _boundsDirty = true;
+
+    std::vector<AABB> _bounds;  // view space bounds of each froxel
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _indices;
+    std::vector<std::pair<uint32_t, uint32_t>> _pairs;  // cluster and light, before sorting by cluster
+    std::vector<uint32_t> _cursors;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
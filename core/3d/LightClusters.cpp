@@ -0,0 +1,260 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/LightClusters.h"
+#include "2d/Camera.h"
+#include "2d/Light.h"
+#include "2d/Scene.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
+#include "renderer/Pass.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/Texture.h"
+
+namespace ax
+{
+
+LightClusters* LightClusters::_instance = nullptr;
+
+LightClusters* LightClusters::getInstance()
+{
+    if (!_instance)
+        _instance = new LightClusters();
+    return _instance;
+}
+
+void LightClusters::destroyInstance()
+{
+    AX_SAFE_DELETE(_instance);
+}
+
+bool LightClusters::isSupported()
+{
+#if defined(AX_GLES_PROFILE) && AX_GLES_PROFILE == 200
+    // no texelFetch or float textures in ES 2.0
+    return false;
+#else
+    return true;
+#endif
+}
+
+LightClusters::LightClusters()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    _afterDrawListener =
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { reset(); });
+    _recreatedListener = dispatcher->addCustomEventListener(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        for (auto&& clusters : _clusters)
+            releaseTextures(*clusters);
+    });
+}
+
+LightClusters::~LightClusters()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(_afterDrawListener);
+    dispatcher->removeEventListener(_recreatedListener);
+
+    for (auto&& clusters : _clusters)
+        releaseTextures(*clusters);
+}
+
+void LightClusters::bind(Pass* pass, Scene* scene, unsigned int lightMask)
+{
+    auto camera = Camera::getVisitingCamera();
+    if (!camera)
+        return;
+
+    auto clusters = getClusters(scene, camera);
+    pass->setUniformLightClusters(TEXTURE_SLOT, clusters->textures[_textureIndex]);
+
+    const auto& matrix = clusters->grid.getViewProjection();
+    pass->setUniformLightClusterMatrix(matrix.m, sizeof(matrix.m));
+    pass->setUniformLightClusterDepth(&clusters->depth, sizeof(clusters->depth));
+    pass->setUniformLightClusterParams(&clusters->params, sizeof(clusters->params));
+
+    int mask = static_cast<int>(lightMask);
+    pass->setUniformLightMask(&mask, sizeof(mask));
+}
+
+LightClusters::Clusters* LightClusters::getClusters(Scene* scene, const Camera* camera)
+{
+    Clusters* clusters = nullptr;
+    for (auto&& it : _clusters)
+    {
+        if (it->camera == camera)
+        {
+            clusters = it.get();
+            break;
+        }
+    }
+    if (!clusters)
+    {
+        clusters         = _clusters.emplace_back(std::make_unique<Clusters>()).get();
+        clusters->camera = camera;
+    }
+
+    clusters->used = true;
+    if (!clusters->built)
+    {
+        build(*clusters, scene, camera);
+        upload(*clusters);
+        clusters->built = true;
+    }
+    return clusters;
+}
+
+void LightClusters::build(Clusters& clusters, Scene* scene, const Camera* camera)
+{
+    _spheres.clear();
+    _lights.clear();
+    for (const auto& light : scene->getLights())
+    {
+        auto type = light->getLightType();
+        if (!light->isEnabled() || (type != LightType::POINT && type != LightType::SPOT))
+            continue;
+
+        Mat4 mat           = light->getNodeToWorldTransform();
+        float intensity    = light->getIntensity() / 255.0f;
+        const Color3B& col = light->getDisplayedColor();
+        Vec3 position(mat.m[12], mat.m[13], mat.m[14]);
+        Vec3 color(col.r * intensity, col.g * intensity, col.b * intensity);
+        auto flag = static_cast<float>(light->getLightFlag());
+
+        if (type == LightType::POINT)
+        {
+            auto pointLight = static_cast<PointLight*>(light);
+            float range     = pointLight->getRange();
+            _spheres.emplace_back(position.x, position.y, position.z, range);
+            _lights.emplace_back(position.x, position.y, position.z, 1.0f / range);
+            _lights.emplace_back(color.x, color.y, color.z, flag);
+            // no direction, the spot attenuation is always 1
+            _lights.emplace_back(0.0f, 0.0f, 0.0f, -2.0f);
+            _lights.emplace_back(-3.0f, 0.0f, 0.0f, 0.0f);
+        }
+        else
+        {
+            auto spotLight = static_cast<SpotLight*>(light);
+            float range    = spotLight->getRange();
+            Vec3 dir       = spotLight->getDirectionInWorld();
+            dir.normalize();
+            _spheres.emplace_back(position.x, position.y, position.z, range);
+            _lights.emplace_back(position.x, position.y, position.z, 1.0f / range);
+            _lights.emplace_back(color.x, color.y, color.z, flag);
+            _lights.emplace_back(dir.x, dir.y, dir.z, spotLight->getCosInnerAngle());
+            _lights.emplace_back(spotLight->getCosOuterAngle(), 0.0f, 0.0f, 0.0f);
+        }
+    }
+
+    clusters.grid.setProjection(camera->getProjectionMatrix(), camera->getNearPlane(), camera->getFarPlane());
+    clusters.grid.build(camera->getViewMatrix(), _spheres);
+    clusters.grid.getShaderParams(clusters.depth, clusters.params);
+
+    // the cluster headers follow the lights
+    clusters.params.z = static_cast<float>(_lights.size());
+
+    _lightCount = _spheres.size();
+    _indexCount = clusters.grid.getIndices().size();
+}
+
+void LightClusters::upload(Clusters& clusters)
+{
+    const auto& offsets = clusters.grid.getOffsets();
+    const auto& indices = clusters.grid.getIndices();
+
+    _texels = _lights;
+    for (int i = 0; i < LightClusterGrid::CLUSTER_COUNT; ++i)
+        _texels.emplace_back(static_cast<float>(offsets[i]), static_cast<float>(offsets[i + 1] - offsets[i]), 0.0f,
+                             0.0f);
+    for (size_t i = 0; i < indices.size(); i += 4)
+    {
+        float texel[4]{};
+        for (size_t j = i; j < (std::min)(i + 4, indices.size()); ++j)
+            texel[j - i] = static_cast<float>(indices[j]);
+        _texels.emplace_back(texel[0], texel[1], texel[2], texel[3]);
+    }
+
+    // pad to whole rows of the texture
+    int height = static_cast<int>((_texels.size() + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH);
+    _texels.resize(static_cast<size_t>(height) * TEXTURE_WIDTH);
+
+    auto& texture  = clusters.textures[_textureIndex];
+    auto& capacity = clusters.textureHeights[_textureIndex];
+    if (!texture || capacity < height)
+    {
+        AX_SAFE_RELEASE(texture);
+
+        capacity = 8;
+        while (capacity < height)
+            capacity *= 2;
+
+        backend::TextureDescriptor descriptor;
+        descriptor.textureType       = backend::TextureType::TEXTURE_2D;
+        descriptor.textureFormat     = backend::PixelFormat::RGBA32F;
+        descriptor.textureUsage      = backend::TextureUsage::READ;
+        descriptor.width             = TEXTURE_WIDTH;
+        descriptor.height            = capacity;
+        descriptor.samplerDescriptor = backend::SamplerDescriptor(
+            backend::SamplerFilter::NEAREST, backend::SamplerFilter::NEAREST,
+            backend::SamplerAddressMode::CLAMP_TO_EDGE, backend::SamplerAddressMode::CLAMP_TO_EDGE);
+        texture = backend::DriverBase::getInstance()->newTexture(descriptor);
+
+        _texels.resize(static_cast<size_t>(capacity) * TEXTURE_WIDTH);
+        static_cast<backend::Texture2DBackend*>(texture)->updateData(reinterpret_cast<uint8_t*>(_texels.data()),
+                                                                     TEXTURE_WIDTH, capacity, 0);
+    }
+    else
+        static_cast<backend::Texture2DBackend*>(texture)->updateSubData(0, 0, TEXTURE_WIDTH, height, 0,
+                                                                        reinterpret_cast<uint8_t*>(_texels.data()));
+}
+
+void LightClusters::reset()
+{
+    if (_clusters.empty())
+        return;
+
+    // forget the cameras which didn't draw a clustered mesh in this frame
+    std::erase_if(_clusters, [this](const std::unique_ptr<Clusters>& clusters) {
+        if (clusters->used)
+            return false;
+        releaseTextures(*clusters);
+        return true;
+    });
+
+    for (auto&& clusters : _clusters)
+        clusters->built = clusters->used = false;
+    _textureIndex = (_textureIndex + 1) % TEXTURE_COUNT;
+}
+
+void LightClusters::releaseTextures(Clusters& clusters)
+{
+    for (int i = 0; i < TEXTURE_COUNT; ++i)
+    {
+        AX_SAFE_RELEASE_NULL(clusters.textures[i]);
+        clusters.textureHeights[i] = 0;
+    }
+}
+
+}  // namespace ax
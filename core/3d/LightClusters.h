@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+
+#include "3d/LightClusterGrid.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+class Pass;
+class Scene;
+class Camera;
+class EventListenerCustom;
+
+namespace backend
+{
+class TextureBackend;
+}
+
+/**
+ * @brief LightClusters, the point and spot lights of the scene binned per camera for clustered forward shading.
+ *
+ * Materials of type MeshMaterial::MaterialType::DIFFUSE_CLUSTERED evaluate only the lights of the froxel a
+ * fragment is in, instead of the AX_MAX_POINT_LIGHT and AX_MAX_SPOT_LIGHT lights of the uniform path, so
+ * scenes can have dozens of dynamic lights. The lights are binned the first time a mesh of a camera is drawn
+ * in a frame, and uploaded into one RGBA32F texture per camera: four texels per light, followed by the offset
+ * and count of each cluster and the light indices, four per texel. Directional and ambient lights are still
+ * passed as uniforms.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL LightClusters
+{
+public:
+    /** The texels in a row of the clusters texture, the shaders must use the same value. */
+    static constexpr int TEXTURE_WIDTH = 1024;
+
+    /** The texture slot of the clusters, after the textures of the mesh materials and the bone palette. */
+    static constexpr int TEXTURE_SLOT = 3;
+
+    static LightClusters* getInstance();
+    static void destroyInstance();
+
+    /** Whether fragment shaders can read float textures, the clustered material falls back to DIFFUSE otherwise. */
+    static bool isSupported();
+
+    /**
+     * Binds the clusters of the visiting camera to a pass, they are built when the camera asks the first time
+     * in this frame.
+     * @param lightMask The light flags the mesh is lit by.
+     */
+    void bind(Pass* pass, Scene* scene, unsigned int lightMask);
+
+    /** The point and spot lights binned for the last camera. */
+    size_t getLightCount() const { return _lightCount; }
+
+    /** The light indices of all clusters of the last camera. */
+    size_t getIndexCount() const { return _indexCount; }
+
+protected:
+    LightClusters();
+    ~LightClusters();
+
+    // the textures of a camera rotate so the one in flight on the GPU is not written
+    static constexpr int TEXTURE_COUNT = 3;
+
+    struct Clusters
+    {
+        const Camera* camera = nullptr;  // weak ref, only compared
+        LightClusterGrid grid;
+        Vec4 depth;
+        Vec4 params;
+        bool built = false;
+        bool used  = false;
+
+        backend::TextureBackend* textures[TEXTURE_COUNT]{};
+        int textureHeights[TEXTURE_COUNT]{};
+    };
+
+    Clusters* getClusters(Scene* scene, const Camera* camera);
+    void build(Clusters& clusters, Scene* scene, const Camera* camera);
+    void upload(Clusters& clusters);
+    void reset();
+    void releaseTextures(Clusters& clusters);
+
+    std::vector<std::unique_ptr<Clusters>> _clusters;
+    std::vector<Vec4> _spheres;
+    std::vector<Vec4> _lights;  // four texels per light
+    std::vector<Vec4> _texels;
+    int _textureIndex  = 0;
+    size_t _lightCount = 0;
+    size_t _indexCount = 0;
+
+    EventListenerCustom* _afterDrawListener = nullptr;
+    EventListenerCustom* _recreatedListener = nullptr;
+
+    static LightClusters* _instance;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
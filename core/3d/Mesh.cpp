@@ -26,9 +26,13 @@
 
 #include "3d/Mesh.h"
 #include "3d/MeshSkin.h"
+#include "3d/BonePalette.h"
+#include "3d/LightClusters.h"
+#include "3d/CascadedShadowMap.h"
 #include "3d/Skeleton3D.h"
 #include "3d/MeshVertexIndexData.h"
 #include "3d/VertexAttribBinding.h"
+#include "2d/Camera.h"
 #include "2d/Light.h"
 #include "2d/Scene.h"
 #include "base/EventDispatcher.h"
@@ -41,6 +45,7 @@
 #include "renderer/Renderer.h"
 #include "renderer/backend/Buffer.h"
 #include "renderer/backend/Program.h"
+#include "renderer/backend/ProgramManager.h"
 #include "renderer/RenderConsts.h"
 #include "math/Mat4.h"
 
@@ -97,15 +102,21 @@ Mesh::Mesh()
     , _visible(true)
     , _instancing(false)
     , _instanceTransformBuffer(nullptr)
+    , _instanceTransformDirty(false)
     , _instanceTransformBufferDirty(false)
     , _instanceCount(0)
     , _dynamicInstancing(false)
     , _instanceMatrixCache(nullptr)
+    , _instanceCulling(false)
+    , _visibleInstanceCount(0)
+    , _cullingFrame(0)
+    , _cullingCamera(nullptr)
     , meshIndexFormat(CustomCommand::IndexFormat::U_SHORT)
     , _meshIndexData(nullptr)
     , _blend(BlendFunc::ALPHA_NON_PREMULTIPLIED)
     , _blendDirty(true)
     , _material(nullptr)
+    , _depthPrePassState(nullptr)
     , _texFile("")
 {}
 Mesh::~Mesh()
@@ -119,6 +130,7 @@ Mesh::~Mesh()
     AX_SAFE_RELEASE(_skin);
     AX_SAFE_RELEASE(_meshIndexData);
     AX_SAFE_RELEASE(_material);
+    AX_SAFE_RELEASE(_depthPrePassState);
     AX_SAFE_RELEASE(_instanceTransformBuffer);
     AX_SAFE_DELETE_ARRAY(_instanceMatrixCache);
 }
@@ -148,11 +160,28 @@ void Mesh::addInstanceChild(Node* child)
     }
 }
 
+void Mesh::setInstanceTransforms(std::span<const Mat4> transforms, std::span<const Color4F> colors)
+{
+    AXASSERT(_instancing, "Instancing should be enabled on this mesh.");
+    AXASSERT(colors.empty() || colors.size() == transforms.size(), "Either no colors or one per transform");
+
+    _instanceTransforms.assign(transforms.begin(), transforms.end());
+    _instanceColors.assign(colors.begin(), colors.end());
+    _instanceTransformDirty = true;
+
+    if (_instanceTransforms.size() > _instanceCount)
+    {
+        _instanceCount                = static_cast<int>(_instanceTransforms.size());
+        _instanceTransformBufferDirty = true;
+    }
+}
+
 void Mesh::shrinkToFitInstances()
 {
-    if (_instanceCount > _instances.size())
+    auto count = _instanceTransforms.empty() ? _instances.size() : _instanceTransforms.size();
+    if (_instanceCount > count)
     {
-        _instanceCount                = _instances.size();
+        _instanceCount                = static_cast<int>(count);
         _instanceTransformBufferDirty = true;
     }
 }
@@ -167,6 +196,12 @@ void Mesh::setDynamicInstancing(bool dynamic)
     _dynamicInstancing = dynamic;
 }
 
+void Mesh::setInstanceCulling(bool culling)
+{
+    _instanceCulling        = culling;
+    _instanceTransformDirty = true;
+}
+
 backend::Buffer* Mesh::getVertexBuffer() const
 {
     return _meshIndexData->getVertexBuffer();
@@ -444,55 +479,9 @@ void Mesh::draw(Renderer* renderer,
         flags |= Node::FLAGS_RENDER_AS_3D;
 
     if (_instancing && _instanceCount > 0)
-    {
-        if (!_instanceTransformBuffer || _instanceTransformBufferDirty)
-        {
-            AX_SAFE_RELEASE(_instanceTransformBuffer);
-            AX_SAFE_DELETE_ARRAY(_instanceMatrixCache);
-
-            _instanceTransformBuffer = backend::DriverBase::getInstance()->newBuffer(
-                _instanceCount * 64, backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
-
-            _instanceMatrixCache = new float[_instanceCount * 16];
-            for (int i = 0; i < _instanceCount; i++)
-            {
-                _instanceMatrixCache[i * 16 + 0]  = 1.0f;
-                _instanceMatrixCache[i * 16 + 1]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 2]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 3]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 4]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 5]  = 1.0f;
-                _instanceMatrixCache[i * 16 + 6]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 7]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 8]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 9]  = 0.0f;
-                _instanceMatrixCache[i * 16 + 10] = 1.0f;
-                _instanceMatrixCache[i * 16 + 11] = 0.0f;
-                _instanceMatrixCache[i * 16 + 12] = 0.0f;
-                _instanceMatrixCache[i * 16 + 13] = 0.0f;
-                _instanceMatrixCache[i * 16 + 14] = 0.0f;
-                _instanceMatrixCache[i * 16 + 15] = 1.0f;
-            }
-
-            // Fill the buffer with identity matrix.
-            _instanceTransformBuffer->updateData(_instanceMatrixCache, _instanceCount * 64);
-
-            _instanceTransformBufferDirty = false;
-        }
-
-        if (_instanceTransformDirty || _dynamicInstancing)
-        {
-            _instanceTransformDirty = false;
-
-            int memOffset = 0;
-            for (auto& _ : _instances)
-            {
-                auto& mat = _->getNodeToParentTransform();
-                std::copy(mat.m, mat.m + 16, _instanceMatrixCache + 16 * memOffset++);
-            }
-            _instanceTransformBuffer->updateSubData(_instanceMatrixCache, 0, _instanceCount * 64);
-        }
-    }
+        updateInstanceBuffer(transform, color);
+    else
+        _visibleInstanceCount = 0;
 
     // TODO
     //     _meshCommand.init(globalZ,
@@ -514,19 +503,38 @@ void Mesh::draw(Renderer* renderer,
     // 'u_color' and others
     const auto scene = Director::getInstance()->getRunningScene();
     auto technique   = _material->_currentTechnique;
+    auto& commands   = _meshCommands[technique->getName()];
+    size_t passIndex = 0;
     for (const auto pass : technique->_passes)
     {
-        pass->setUniformColor(&color, sizeof(color));
+        // the color is applied per draw, the meshes may share the pass
+        Vec4 drawColor = color;
 
         if (_skin)
-            pass->setUniformMatrixPalette(_skin->getMatrixPalette(), _skin->getMatrixPaletteSizeInBytes());
+        {
+            if (pass->hasBonePalette())
+            {
+                int offset = _skin->getBonePaletteOffset();
+                pass->setUniformPaletteOffset(&offset, sizeof(offset));
+                BonePalette::getInstance()->addPass(pass);
+            }
+            else
+                pass->setUniformMatrixPalette(_skin->getMatrixPalette(), _skin->getMatrixPaletteSizeInBytes());
+        }
 
         if (scene && !scene->getLights().empty())
         {
-            setLightUniforms(pass, scene, color, lightMask);
+            drawColor = setLightUniforms(pass, scene, color, lightMask);
         }
+
+        // bound without lights too, the clusters are empty then
+        if (scene && pass->hasLightClusters())
+            LightClusters::getInstance()->bind(pass, scene, lightMask);
+        if (scene && pass->hasShadowMap())
+            CascadedShadowMap::bind(pass, lightMask);
+
+        commands[passIndex++].setColor(drawColor);
     }
-    auto& commands = _meshCommands[technique->getName()];
 
     for (auto&& command : commands)
     {
@@ -535,20 +543,197 @@ void Mesh::draw(Renderer* renderer,
         command.setTransparent(isTransparent);
         command.set3D(!_material->isForce2DQueue());
         command.setWireframe(wireframe);
-        if (_instancing && _instances.size() > 0)
+        if (_instancing && _visibleInstanceCount > 0)
         {
             command.setDrawType(CustomCommand::DrawType::ELEMENT_INSTANCE);
-            command.setInstanceBuffer(_instanceTransformBuffer, _instances.size());
+            command.setInstanceBuffer(_instanceTransformBuffer, _visibleInstanceCount);
         }
         else if (_instancing)
             return;
     }
 
     _meshIndexData->setPrimitiveType(_material->_drawPrimitive);
+    if (_material->isDepthPrePass() && !isTransparent && globalZ == 0 && !_skin && !_instancing && !wireframe &&
+        !_material->isForce2DQueue())
+        drawDepthPrePass(renderer, globalZ, transform);
     _material->draw(commands.data(), globalZ, getVertexBuffer(), getIndexBuffer(), getPrimitiveType(), getIndexFormat(),
                     static_cast<unsigned int>(getIndexCount()), transform);
 }
 
+void Mesh::drawDepthPrePass(Renderer* renderer, float globalZOrder, const Mat4& transform)
+{
+    // the depth must be computed like the opaque pass does, by the same matrices and expression
+    auto pass              = _material->_currentTechnique->_passes.at(0);
+    const auto programType = pass->hasProjectionMatrix() ? backend::ProgramType::DEPTH_PREPASS_3D
+                                                         : backend::ProgramType::SHADOW_DEPTH_3D;
+    if (!_depthPrePassState || _depthPrePassState->getProgram()->getProgramType() != programType)
+    {
+        AX_SAFE_RELEASE(_depthPrePassState);
+        auto program       = backend::ProgramManager::getInstance()->getBuiltinProgram(programType);
+        _depthPrePassState = new backend::ProgramState(program);
+
+        // the layout of the mesh vertices, built like VertexAttribBinding does
+        auto vertexData        = _meshIndexData->getMeshVertexData();
+        auto vertexLayout      = _depthPrePassState->getMutableVertexLayout();
+        const auto& attributes = program->getActiveAttributes();
+        int offset             = 0;
+        for (ssize_t k = 0; k < vertexData->getMeshVertexAttribCount(); ++k)
+        {
+            const auto& meshAttribute = vertexData->getMeshVertexAttrib(k);
+            auto name                 = shaderinfos::getAttributeName(meshAttribute.vertexAttrib);
+            auto it                   = attributes.find(name);
+            if (it != attributes.end())
+                vertexLayout->setAttrib(name, it->second.location, meshAttribute.type, offset,
+                                        meshAttribute.isNormalized());
+            offset += meshAttribute.getAttribSizeBytes();
+        }
+        vertexLayout->setStride(offset);
+
+        auto& descriptor                        = _depthPrePassCommand.getPipelineDescriptor();
+        descriptor.programState                 = _depthPrePassState;
+        descriptor.blendDescriptor.blendEnabled = false;
+        descriptor.blendDescriptor.writeMask    = backend::ColorWriteMask::NONE;
+        _depthPrePassCommand.setTransparent(false);
+        _depthPrePassCommand.setDepthPrePass(true);
+        _depthPrePassCommand.setDrawType(MeshCommand::DrawType::ELEMENT);
+    }
+
+    // the matrices of Pass::updateMVPUniform
+    auto& matrixP = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    if (programType == backend::ProgramType::DEPTH_PREPASS_3D)
+    {
+        _depthPrePassState->setUniform(_depthPrePassState->getUniformLocation("u_MVMatrix"), transform.m,
+                                       sizeof(transform.m));
+        _depthPrePassState->setUniform(_depthPrePassState->getUniformLocation("u_PMatrix"), matrixP.m,
+                                       sizeof(matrixP.m));
+    }
+    else
+    {
+        auto mvp = matrixP * transform;
+        _depthPrePassState->setUniform(_depthPrePassState->getUniformLocation("u_MVPMatrix"), mvp.m, sizeof(mvp.m));
+    }
+
+    _depthPrePassCommand.init(globalZOrder, transform);
+    _depthPrePassCommand.set3D(true);
+    _depthPrePassCommand.setPrimitiveType(getPrimitiveType());
+    _depthPrePassCommand.setVertexBuffer(getVertexBuffer());
+    _depthPrePassCommand.setIndexBuffer(getIndexBuffer(), getIndexFormat());
+    _depthPrePassCommand.setIndexDrawInfo(0, getIndexCount());
+    renderer->addCommand(&_depthPrePassCommand);
+}
+
+void Mesh::updateInstanceBuffer(const Mat4& transform, const Vec4& color)
+{
+    if (!_instanceTransformBuffer || _instanceTransformBufferDirty)
+    {
+        AX_SAFE_RELEASE(_instanceTransformBuffer);
+        AX_SAFE_DELETE_ARRAY(_instanceMatrixCache);
+
+        _instanceTransformBuffer = backend::DriverBase::getInstance()->newBuffer(
+            _instanceCount * 64, backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
+
+        _instanceMatrixCache = new float[_instanceCount * 16];
+        for (int i = 0; i < _instanceCount; i++)
+            std::copy(Mat4::IDENTITY.m, Mat4::IDENTITY.m + 16, _instanceMatrixCache + 16 * i);
+
+        // Fill the buffer with identity matrix.
+        _instanceTransformBuffer->updateData(_instanceMatrixCache, _instanceCount * 64);
+
+        _instanceTransformBufferDirty = false;
+        _instanceTransformDirty       = true;
+    }
+
+    const bool useTransforms = !_instanceTransforms.empty();
+    const int count = useTransforms ? static_cast<int>(_instanceTransforms.size()) : static_cast<int>(_instances.size());
+    auto instanceTransform = [this, useTransforms](int i) -> const Mat4& {
+        return useTransforms ? _instanceTransforms[i] : _instances[i]->getNodeToParentTransform();
+    };
+
+    // colored instances are packed as the first three rows of the affine transform followed by the color,
+    // which is tinted by the node color here since the packed layout has no room for it in the shader
+    const bool packColors = useTransforms && !_instanceColors.empty();
+    if (packColors && _instanceTint != color)
+    {
+        _instanceTint           = color;
+        _instanceTransformDirty = true;
+    }
+    auto writeInstance = [this, packColors, &color](int i, const Mat4& mat, int slot) {
+        float* dst = _instanceMatrixCache + 16 * slot;
+        if (!packColors)
+        {
+            std::copy(mat.m, mat.m + 16, dst);
+            return;
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            dst[row * 4 + 0] = mat.m[row];
+            dst[row * 4 + 1] = mat.m[4 + row];
+            dst[row * 4 + 2] = mat.m[8 + row];
+            dst[row * 4 + 3] = mat.m[12 + row];
+        }
+        auto& c  = _instanceColors[i];
+        dst[12] = c.r * color.x;
+        dst[13] = c.g * color.y;
+        dst[14] = c.b * color.z;
+        dst[15] = c.a * color.w;
+    };
+
+    auto camera = _instanceCulling ? Camera::getVisitingCamera() : nullptr;
+    if (camera)
+    {
+        // the commands and the instance buffer are shared by all cameras drawing the mesh,
+        // so the survivors of one camera can't be drawn when a second one comes in the same frame
+        auto frame = Director::getInstance()->getTotalFrames();
+        if (_cullingFrame == frame && _cullingCamera != camera)
+            camera = nullptr;
+        _cullingFrame  = frame;
+        _cullingCamera = camera;
+    }
+
+    if (camera)
+    {
+        // compact the transforms of the instances in the frustum to the front of the buffer
+        Mat4 worldTransform;
+        _instanceBounds.clear();
+        _instanceBounds.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            Mat4::multiply(transform, instanceTransform(i), &worldTransform);
+
+            AABB aabb = _aabb;
+            aabb.transform(worldTransform);
+            _instanceBounds.add(aabb);
+        }
+        camera->cullInFrustum(_instanceBounds, _instanceVisibility);
+
+        int visibleCount = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            if (BoundsBatch::isVisible(_instanceVisibility, i))
+                writeInstance(i, instanceTransform(i), visibleCount++);
+        }
+        if (visibleCount > 0)
+            _instanceTransformBuffer->updateSubData(_instanceMatrixCache, 0, visibleCount * 64);
+
+        _visibleInstanceCount = visibleCount;
+        // the buffer is in culling order now, upload all again when culling is skipped
+        _instanceTransformDirty = true;
+    }
+    else
+    {
+        if (_instanceTransformDirty || (_dynamicInstancing && !useTransforms))
+        {
+            _instanceTransformDirty = false;
+
+            for (int i = 0; i < count; ++i)
+                writeInstance(i, instanceTransform(i), i);
+            if (count > 0)
+                _instanceTransformBuffer->updateSubData(_instanceMatrixCache, 0, count * 64);
+        }
+        _visibleInstanceCount = count;
+    }
+}
+
 void Mesh::setSkin(MeshSkin* skin)
 {
     if (_skin != skin)
@@ -638,7 +823,7 @@ void Mesh::bindMeshCommand()
     }
 }
 
-void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigned int lightmask)
+Vec4 Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigned int lightmask)
 {
     AXASSERT(pass, "Invalid Pass");
     AXASSERT(scene, "Invalid scene");
@@ -651,6 +836,11 @@ void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigne
 
     auto bindings = pass->getVertexAttributeBinding();
 
+    // the point and spot lights of a clustered pass are read from the clusters texture
+    const bool clustered = pass->hasLightClusters();
+    // the shadowed directional light is passed with its shadow map
+    const BaseLight* shadowLight = pass->hasShadowMap() ? CascadedShadowMap::getShadowLight(lightmask) : nullptr;
+
     if (bindings && bindings->hasAttribute(shaderinfos::VertexKey::VERTEX_ATTRIB_NORMAL))
     {
         resetLightUniformValues();
@@ -669,7 +859,7 @@ void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigne
                 {
                 case LightType::DIRECTIONAL:
                 {
-                    if (enabledDirLightNum < maxDirLight)
+                    if (light != shadowLight && enabledDirLightNum < maxDirLight)
                     {
                         auto dirLight = static_cast<DirectionLight*>(light);
                         Vec3 dir      = dirLight->getDirectionInWorld();
@@ -684,7 +874,7 @@ void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigne
                 break;
                 case LightType::POINT:
                 {
-                    if (enabledPointLightNum < maxPointLight)
+                    if (!clustered && enabledPointLightNum < maxPointLight)
                     {
                         auto pointLight    = static_cast<PointLight*>(light);
                         Mat4 mat           = pointLight->getNodeToWorldTransform();
@@ -699,7 +889,7 @@ void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigne
                 break;
                 case LightType::SPOT:
                 {
-                    if (enabledSpotLightNum < maxSpotLight)
+                    if (!clustered && enabledSpotLightNum < maxSpotLight)
                     {
                         auto spotLight = static_cast<SpotLight*>(light);
                         Vec3 dir       = spotLight->getDirectionInWorld();
@@ -799,11 +989,11 @@ void Mesh::setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigne
             ambient.x /= 255.f;
             ambient.y /= 255.f;
             ambient.z /= 255.f;
-            // override the uniform value of u_color using the calculated color
-            auto fcolor = Vec4(color.x * ambient.x, color.y * ambient.y, color.z * ambient.z, color.w);
-            pass->setUniformColor(&fcolor, sizeof(fcolor));
+            // draw with the color modulated by the ambient lights
+            return Vec4(color.x * ambient.x, color.y * ambient.y, color.z * ambient.z, color.w);
         }
     }
+    return color;
 }
 
 void Mesh::setBlendFunc(const BlendFunc& blendFunc)
@@ -27,10 +27,12 @@
 
 #include <string>
 #include <map>
+#include <span>
 
 #include "3d/Bundle3DData.h"
 #include "3d/AABB.h"
 #include "3d/3DProgramInfo.h"
+#include "3d/Frustum.h"
 
 #include "base/Object.h"
 #include "math/Math.h"
@@ -53,6 +55,7 @@ class Material;
 class Renderer;
 class Scene;
 class Pass;
+class Camera;
 
 namespace backend
 {
@@ -252,6 +255,7 @@ public:
      has a mat4 attribute set on the location of total vertex attributes +1
      */
     void enableInstancing(bool instance, int count = 0);
+    bool isInstancing() const { return _instancing; }
 
     /** Set this to true and instancing objects within this mesh renderer
     will be recalculated each frame, use it when you plan to move objects,
@@ -269,19 +273,43 @@ public:
     */
     void addInstanceChild(Node* child);
 
+    /** Sets the transforms of the instances from a contiguous array, in the space of the owning node.
+    * They take the place of the instance children and are uploaded once, call it again when they change.
+    * Pass colors, one per transform, to tint each instance, the transform and the color are packed in
+    * one mat4 then, which needs a material of type `MeshMaterial::MaterialType::UNLIT_INSTANCE_COLOR`
+    * or a custom one reading the same layout: rows 0 to 2 of the transform and the color last.
+    * An empty array gets back to the instance children.
+    */
+    void setInstanceTransforms(std::span<const Mat4> transforms, std::span<const Color4F> colors = {});
+    std::span<const Mat4> getInstanceTransforms() const { return _instanceTransforms; }
+
     /** shrinks the instance transform buffer after many steps of expansion to increase performance. */
     void shrinkToFitInstances();
 
     /** rebuilds the instance transform buffer next frame. */
     void rebuildInstances();
 
+    /** Set this to true to cull the instances against the frustum of the visiting camera
+    and draw only the visible ones in the instanced draw, the transforms of the visible
+    instances are uploaded every frame. When several cameras draw the mesh in one frame
+    all instances are drawn. */
+    void setInstanceCulling(bool culling);
+    bool isInstanceCulling() const { return _instanceCulling; }
+
+    /** The number of instances of the last draw. */
+    int getVisibleInstanceCount() const { return _visibleInstanceCount; }
+
     Mesh();
     virtual ~Mesh();
 
 protected:
     void resetLightUniformValues();
-    void setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigned int lightmask);
+    /** sets the light uniforms of a pass, returns the color to draw it with */
+    Vec4 setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigned int lightmask);
     void bindMeshCommand();
+    void updateInstanceBuffer(const Mat4& transform, const Vec4& color);
+    /** adds the depth-only draw of the mesh, see Material::setDepthPrePass */
+    void drawDepthPrePass(Renderer* renderer, float globalZOrder, const Mat4& transform);
 
     std::map<NTextureData::Usage, Texture2D*> _textures;  // textures that submesh is using
     MeshSkin* _skin;                                      // skin
@@ -293,8 +321,17 @@ protected:
     bool _instanceTransformBufferDirty;
     int _instanceCount;
     std::vector<Node*> _instances;
+    std::vector<Mat4> _instanceTransforms;
+    std::vector<Color4F> _instanceColors;
+    Vec4 _instanceTint;
     float* _instanceMatrixCache;
     bool _dynamicInstancing;
+    bool _instanceCulling;
+    int _visibleInstanceCount;
+    unsigned int _cullingFrame;
+    const Camera* _cullingCamera;
+    BoundsBatch _instanceBounds;  ///< world bounds of the instances, culled at once
+    std::vector<uint32_t> _instanceVisibility;
 
     CustomCommand::IndexFormat meshIndexFormat;
 
@@ -307,6 +344,8 @@ protected:
     AABB _aabb;
     std::function<void()> _visibleChanged;
     std::unordered_map<std::string, std::vector<MeshCommand>> _meshCommands;
+    MeshCommand _depthPrePassCommand;
+    backend::ProgramState* _depthPrePassState;
 
     /// light parameters
     std::vector<Vec3> _dirLightUniformColorValues;
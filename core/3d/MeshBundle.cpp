@@ -0,0 +1,617 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/MeshBundle.h"
+#include "3d/Bundle3D.h"
+#include "3d/BundleReader.h"
+#include "3d/MeshVertexIndexData.h"
+#include "platform/FileUtils.h"
+#include "renderer/backend/Buffer.h"
+#include "renderer/backend/DriverBase.h"
+#include "base/axstd.h"
+
+namespace ax
+{
+
+// all the integers are little endian, the offsets are from the start of the file
+struct MeshBundle::FileHeader
+{
+    char magic[4];  // "C3M\0"
+    uint32_t version;
+    uint32_t meshCount;
+    uint32_t meshTableOffset;  // MeshEntry[meshCount]
+    uint32_t sceneOffset;      // materials and nodes, read with BundleReader
+    uint32_t sceneSize;
+    uint32_t fileSize;
+    uint32_t reserved;
+};
+
+struct MeshBundle::MeshEntry
+{
+    uint32_t sizePerVertex;
+    uint32_t vertexOffset;  // aligned to BLOB_ALIGNMENT
+    uint32_t vertexSize;
+    uint32_t subMeshCount;
+    uint32_t subMeshOffset;  // SubMeshEntry[subMeshCount]
+    uint32_t attribCount;
+    uint32_t attribs[MAX_ATTRIB_COUNT];  // backend::VertexFormat | shaderinfos::VertexKey << 16
+};
+
+struct MeshBundle::SubMeshEntry
+{
+    uint32_t indexOffset;  // aligned to BLOB_ALIGNMENT
+    uint32_t indexSize;
+    uint32_t indexFormat;  // backend::IndexFormat
+    uint32_t idOffset;
+    uint32_t idLength;
+    uint32_t reserved;
+    float aabb[6];  // min, max
+};
+
+static constexpr char C3M_MAGIC[4] = {'C', '3', 'M', '\0'};
+
+namespace
+{
+class BlobWriter
+{
+public:
+    template <typename T>
+    size_t write(const T& value)
+    {
+        return writeBytes(&value, sizeof(T));
+    }
+
+    size_t writeBytes(const void* data, size_t size)
+    {
+        size_t offset = _buffer.size();
+        _buffer.resize(offset + size);
+        if (size)
+            memcpy(_buffer.data() + offset, data, size);
+        return offset;
+    }
+
+    // same layout as BundleReader::readString
+    void writeString(std::string_view str)
+    {
+        write(static_cast<uint32_t>(str.size()));
+        writeBytes(str.data(), str.size());
+    }
+
+    void align(size_t alignment)
+    {
+        size_t size = (_buffer.size() + alignment - 1) & ~(alignment - 1);
+        _buffer.resize(size, 0);
+    }
+
+    template <typename T>
+    T* at(size_t offset)
+    {
+        return reinterpret_cast<T*>(_buffer.data() + offset);
+    }
+
+    size_t size() const { return _buffer.size(); }
+    const uint8_t* data() const { return _buffer.data(); }
+
+private:
+    axstd::pod_vector<uint8_t> _buffer;
+};
+
+void writeNode(BlobWriter& writer, const NodeData* node)
+{
+    writer.writeString(node->id);
+    writer.writeBytes(node->transform.m, sizeof(node->transform.m));
+
+    writer.write(static_cast<uint32_t>(node->modelNodeDatas.size()));
+    for (auto&& model : node->modelNodeDatas)
+    {
+        writer.writeString(model->subMeshId);
+        writer.writeString(model->materialId);
+        writer.write(static_cast<uint32_t>(model->bones.size()));
+        for (auto&& bone : model->bones)
+            writer.writeString(bone);
+        writer.write(static_cast<uint32_t>(model->invBindPose.size()));
+        for (auto&& mat : model->invBindPose)
+            writer.writeBytes(mat.m, sizeof(mat.m));
+    }
+
+    writer.write(static_cast<uint32_t>(node->children.size()));
+    for (auto&& child : node->children)
+        writeNode(writer, child);
+}
+
+NodeData* readNode(BundleReader& reader)
+{
+    auto node      = new NodeData();
+    uint32_t count = 0;
+    node->id       = reader.readString();
+    if (!reader.readMatrix(node->transform.m) || reader.read(&count, 4, 1) != 1)
+        goto FAILED;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto model = new ModelData();
+        node->modelNodeDatas.emplace_back(model);
+        model->subMeshId  = reader.readString();
+        model->materialId = reader.readString();
+
+        uint32_t boneCount = 0;
+        if (reader.read(&boneCount, 4, 1) != 1)
+            goto FAILED;
+        for (uint32_t k = 0; k < boneCount; ++k)
+            model->bones.emplace_back(reader.readString());
+
+        uint32_t matCount = 0;
+        if (reader.read(&matCount, 4, 1) != 1)
+            goto FAILED;
+        model->invBindPose.resize(matCount);
+        for (auto&& mat : model->invBindPose)
+        {
+            if (!reader.readMatrix(mat.m))
+                goto FAILED;
+        }
+    }
+
+    if (reader.read(&count, 4, 1) != 1)
+        goto FAILED;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto child = readNode(reader);
+        if (!child)
+            goto FAILED;
+        node->children.emplace_back(child);
+    }
+    return node;
+
+FAILED:
+    delete node;
+    return nullptr;
+}
+
+bool readNodes(BundleReader& reader, std::vector<NodeData*>& nodes)
+{
+    uint32_t count = 0;
+    if (reader.read(&count, 4, 1) != 1)
+        return false;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto node = readNode(reader);
+        if (!node)
+            return false;
+        nodes.emplace_back(node);
+    }
+    return true;
+}
+}  // namespace
+
+bool MeshBundle::write(std::string_view fullPath,
+                       const MeshDatas& meshdatas,
+                       const MaterialDatas& materialdatas,
+                       const NodeDatas& nodedatas,
+                       std::string_view modelDir)
+{
+    BlobWriter writer;
+    const auto meshCount = static_cast<uint32_t>(meshdatas.meshDatas.size());
+
+    writer.write(FileHeader{});
+    writer.align(BLOB_ALIGNMENT);
+    const size_t meshTableOffset = writer.size();
+    for (uint32_t i = 0; i < meshCount; ++i)
+        writer.write(MeshEntry{});
+
+    for (uint32_t i = 0; i < meshCount; ++i)
+    {
+        auto meshdata = meshdatas.meshDatas[i];
+        if (meshdata->attribs.size() > MAX_ATTRIB_COUNT)
+        {
+            AXLOGW("MeshBundle: too many vertex attributes in mesh {} of '{}'", i, fullPath);
+            return false;
+        }
+
+        writer.align(BLOB_ALIGNMENT);
+        const auto subMeshCount  = static_cast<uint32_t>(meshdata->subMeshIndices.size());
+        const size_t subMeshOffset = writer.size();
+        for (uint32_t k = 0; k < subMeshCount; ++k)
+            writer.write(SubMeshEntry{});
+
+        writer.align(BLOB_ALIGNMENT);
+        const size_t vertexOffset = writer.writeBytes(meshdata->vertex.data(), meshdata->vertex.size() * sizeof(float));
+
+        auto entry           = writer.at<MeshEntry>(meshTableOffset + i * sizeof(MeshEntry));
+        entry->sizePerVertex = meshdata->getPerVertexSize();
+        entry->vertexOffset  = static_cast<uint32_t>(vertexOffset);
+        entry->vertexSize    = static_cast<uint32_t>(meshdata->vertex.size() * sizeof(float));
+        entry->subMeshCount  = subMeshCount;
+        entry->subMeshOffset = static_cast<uint32_t>(subMeshOffset);
+        entry->attribCount   = static_cast<uint32_t>(meshdata->attribs.size());
+        for (size_t a = 0; a < meshdata->attribs.size(); ++a)
+        {
+            auto& attrib      = meshdata->attribs[a];
+            entry->attribs[a] = static_cast<uint32_t>(attrib.type) | (static_cast<uint32_t>(attrib.vertexAttrib) << 16);
+        }
+
+        for (uint32_t k = 0; k < subMeshCount; ++k)
+        {
+            auto& indices = meshdata->subMeshIndices[k];
+            AABB aabb     = k < meshdata->subMeshAABB.size()
+                                ? meshdata->subMeshAABB[k]
+                                : Bundle3D::calculateAABB(meshdata->vertex, meshdata->getPerVertexSize(), indices);
+            std::string_view id = k < meshdata->subMeshIds.size() ? std::string_view{meshdata->subMeshIds[k]} : "";
+
+            writer.align(BLOB_ALIGNMENT);
+            const size_t indexOffset = writer.writeBytes(indices.data(), indices.bsize());
+            const size_t idOffset    = writer.writeBytes(id.data(), id.size());
+
+            auto subEntry         = writer.at<SubMeshEntry>(subMeshOffset + k * sizeof(SubMeshEntry));
+            subEntry->indexOffset = static_cast<uint32_t>(indexOffset);
+            subEntry->indexSize   = static_cast<uint32_t>(indices.bsize());
+            subEntry->indexFormat = static_cast<uint32_t>(indices.format());
+            subEntry->idOffset    = static_cast<uint32_t>(idOffset);
+            subEntry->idLength    = static_cast<uint32_t>(id.size());
+            memcpy(subEntry->aabb, &aabb._min, sizeof(float) * 3);
+            memcpy(subEntry->aabb + 3, &aabb._max, sizeof(float) * 3);
+        }
+    }
+
+    // materials and nodes
+    writer.align(BLOB_ALIGNMENT);
+    const size_t sceneOffset = writer.size();
+    writer.write(static_cast<uint32_t>(materialdatas.materials.size()));
+    for (auto&& material : materialdatas.materials)
+    {
+        writer.writeString(material.id);
+        writer.write(static_cast<uint32_t>(material.textures.size()));
+        for (auto&& texture : material.textures)
+        {
+            // file names in the model directory are stored relative to it
+            std::string_view filename = texture.filename;
+            const bool relative = !modelDir.empty() && filename.size() > modelDir.size() && filename.starts_with(modelDir);
+            if (relative)
+                filename.remove_prefix(modelDir.size());
+
+            writer.writeString(texture.id);
+            writer.writeString(filename);
+            writer.write(static_cast<uint32_t>(relative));
+            writer.write(static_cast<uint32_t>(texture.type));
+            writer.write(static_cast<uint32_t>(texture.wrapS));
+            writer.write(static_cast<uint32_t>(texture.wrapT));
+        }
+    }
+    writer.write(static_cast<uint32_t>(nodedatas.skeleton.size()));
+    for (auto&& node : nodedatas.skeleton)
+        writeNode(writer, node);
+    writer.write(static_cast<uint32_t>(nodedatas.nodes.size()));
+    for (auto&& node : nodedatas.nodes)
+        writeNode(writer, node);
+
+    auto header = writer.at<FileHeader>(0);
+    memcpy(header->magic, C3M_MAGIC, sizeof(C3M_MAGIC));
+    header->version         = VERSION;
+    header->meshCount       = meshCount;
+    header->meshTableOffset = static_cast<uint32_t>(meshTableOffset);
+    header->sceneOffset     = static_cast<uint32_t>(sceneOffset);
+    header->sceneSize       = static_cast<uint32_t>(writer.size() - sceneOffset);
+    header->fileSize        = static_cast<uint32_t>(writer.size());
+
+    return FileUtils::writeBinaryToFile(writer.data(), writer.size(), fullPath);
+}
+
+bool MeshBundle::convert(std::string_view srcPath, std::string_view dstFullPath, VertexCompressionFlags compression)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(srcPath);
+    if (fullPath.empty())
+        return false;
+
+    MeshDatas meshdatas;
+    MaterialDatas materialdatas;
+    NodeDatas nodedatas;
+
+    bool ret        = false;
+    std::string ext = FileUtils::getPathExtension(fullPath);
+    if (ext == ".obj")
+    {
+        ret = Bundle3D::loadObj(meshdatas, materialdatas, nodedatas, fullPath);
+    }
+    else if (ext == ".c3b" || ext == ".c3t")
+    {
+        auto bundle = Bundle3D::createBundle();
+        ret         = bundle->load(fullPath) && bundle->loadMeshDatas(meshdatas) &&
+              bundle->loadMaterials(materialdatas) && bundle->loadNodes(nodedatas);
+        Bundle3D::destroyBundle(bundle);
+    }
+
+    if (!ret)
+    {
+        AXLOGW("MeshBundle: failed to convert '{}'", srcPath);
+        return false;
+    }
+
+    for (auto meshdata : meshdatas.meshDatas)
+        VertexCompression::compress(*meshdata, compression);
+
+    // the texture paths are only relative when the .c3m file is written next to the model
+    std::string_view modelDir = fullPath;
+    modelDir                  = modelDir.substr(0, modelDir.find_last_of('/') + 1);
+    if (dstFullPath.substr(0, dstFullPath.find_last_of('/') + 1) != modelDir)
+        modelDir = {};
+    return write(dstFullPath, meshdatas, materialdatas, nodedatas, modelDir);
+}
+
+MeshBundle::~MeshBundle()
+{
+    clear();
+}
+
+bool MeshBundle::load(std::string_view path)
+{
+    clear();
+
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
+    if (fullPath.empty())
+        return false;
+
+    std::error_code error;
+    _mapping.map(fullPath, error);
+    if (!error && _mapping.size() > 0)
+    {
+        _data = reinterpret_cast<const uint8_t*>(_mapping.data());
+        _size = _mapping.size();
+    }
+    else
+    {
+        // not a regular file, e.g. in the apk
+        _buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+        _data   = _buffer.getBytes();
+        _size   = static_cast<size_t>(_buffer.getSize());
+    }
+
+    if (!_data || !validate())
+    {
+        AXLOGW("MeshBundle: '{}' is not a valid c3m file", path);
+        clear();
+        return false;
+    }
+
+    _modelDir = fullPath.substr(0, fullPath.find_last_of('/') + 1);
+    return true;
+}
+
+void MeshBundle::clear()
+{
+    _mapping.unmap();
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _modelDir.clear();
+}
+
+bool MeshBundle::validate() const
+{
+    if (_size < sizeof(FileHeader))
+        return false;
+
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    if (memcmp(header->magic, C3M_MAGIC, sizeof(C3M_MAGIC)) != 0 || header->version != VERSION ||
+        header->fileSize != _size)
+        return false;
+
+    auto inFile = [this](size_t offset, size_t size) { return offset <= _size && size <= _size - offset; };
+    if (!inFile(header->meshTableOffset, size_t{header->meshCount} * sizeof(MeshEntry)) ||
+        !inFile(header->sceneOffset, header->sceneSize))
+        return false;
+
+    auto entries = reinterpret_cast<const MeshEntry*>(_data + header->meshTableOffset);
+    for (uint32_t i = 0; i < header->meshCount; ++i)
+    {
+        auto& entry = entries[i];
+        if (entry.attribCount > MAX_ATTRIB_COUNT || entry.sizePerVertex == 0 ||
+            !inFile(entry.vertexOffset, entry.vertexSize) ||
+            !inFile(entry.subMeshOffset, size_t{entry.subMeshCount} * sizeof(SubMeshEntry)))
+            return false;
+
+        auto subEntries = reinterpret_cast<const SubMeshEntry*>(_data + entry.subMeshOffset);
+        for (uint32_t k = 0; k < entry.subMeshCount; ++k)
+        {
+            auto& subEntry = subEntries[k];
+            if (!inFile(subEntry.indexOffset, subEntry.indexSize) || !inFile(subEntry.idOffset, subEntry.idLength) ||
+                subEntry.indexFormat > static_cast<uint32_t>(backend::IndexFormat::U_INT))
+                return false;
+        }
+    }
+    return true;
+}
+
+const MeshBundle::MeshEntry* MeshBundle::getMeshEntry(int mesh) const
+{
+    AXASSERT(mesh >= 0 && mesh < getMeshCount(), "invalid mesh index");
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    return reinterpret_cast<const MeshEntry*>(_data + header->meshTableOffset) + mesh;
+}
+
+const MeshBundle::SubMeshEntry* MeshBundle::getSubMeshEntry(int mesh, int subMesh) const
+{
+    auto entry = getMeshEntry(mesh);
+    AXASSERT(subMesh >= 0 && subMesh < static_cast<int>(entry->subMeshCount), "invalid sub mesh index");
+    return reinterpret_cast<const SubMeshEntry*>(_data + entry->subMeshOffset) + subMesh;
+}
+
+int MeshBundle::getMeshCount() const
+{
+    return _data ? static_cast<int>(reinterpret_cast<const FileHeader*>(_data)->meshCount) : 0;
+}
+
+int MeshBundle::getSubMeshCount(int mesh) const
+{
+    return static_cast<int>(getMeshEntry(mesh)->subMeshCount);
+}
+
+std::span<const float> MeshBundle::getVertices(int mesh) const
+{
+    auto entry = getMeshEntry(mesh);
+    return {reinterpret_cast<const float*>(_data + entry->vertexOffset), entry->vertexSize / sizeof(float)};
+}
+
+std::span<const uint8_t> MeshBundle::getIndices(int mesh, int subMesh) const
+{
+    auto subEntry = getSubMeshEntry(mesh, subMesh);
+    return {_data + subEntry->indexOffset, subEntry->indexSize};
+}
+
+backend::IndexFormat MeshBundle::getIndexFormat(int mesh, int subMesh) const
+{
+    return static_cast<backend::IndexFormat>(getSubMeshEntry(mesh, subMesh)->indexFormat);
+}
+
+void MeshBundle::createMeshVertexDatas(Vector<MeshVertexData*>& meshVertexDatas) const
+{
+    auto driver = backend::DriverBase::getInstance();
+    for (int i = 0, count = getMeshCount(); i < count; ++i)
+    {
+        auto entry    = getMeshEntry(i);
+        auto vertices = getVertices(i);
+
+        auto vertexdata            = new MeshVertexData();
+        vertexdata->_sizePerVertex = entry->sizePerVertex;
+        vertexdata->_attribs.resize(entry->attribCount);
+        for (uint32_t a = 0; a < entry->attribCount; ++a)
+        {
+            vertexdata->_attribs[a].type         = static_cast<backend::VertexFormat>(entry->attribs[a] & 0xffff);
+            vertexdata->_attribs[a].vertexAttrib = static_cast<shaderinfos::VertexKey>(entry->attribs[a] >> 16);
+        }
+
+        vertexdata->_vertexBuffer =
+            driver->newBuffer(vertices.size_bytes(), backend::BufferType::VERTEX, backend::BufferUsage::STATIC);
+        if (vertexdata->_vertexBuffer)
+        {
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+            vertexdata->_vertexData.assign(vertices.begin(), vertices.end());
+            vertexdata->_vertexBuffer->usingDefaultStoredData(false);
+#endif
+            // uploaded straight from the mapped file
+            vertexdata->_vertexBuffer->updateData(vertices.data(), vertices.size_bytes());
+        }
+
+        for (int k = 0; k < static_cast<int>(entry->subMeshCount); ++k)
+        {
+            auto subEntry    = getSubMeshEntry(i, k);
+            auto indices     = getIndices(i, k);
+            auto indexBuffer = driver->newBuffer(indices.size(), backend::BufferType::INDEX, backend::BufferUsage::STATIC);
+            indexBuffer->autorelease();
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+            indexBuffer->usingDefaultStoredData(false);
+#endif
+            indexBuffer->updateData(indices.data(), indices.size());
+
+            std::string_view id{reinterpret_cast<const char*>(_data + subEntry->idOffset), subEntry->idLength};
+            AABB aabb(Vec3(subEntry->aabb[0], subEntry->aabb[1], subEntry->aabb[2]),
+                      Vec3(subEntry->aabb[3], subEntry->aabb[4], subEntry->aabb[5]));
+            auto indexdata = MeshIndexData::create(id, vertexdata, indexBuffer, aabb);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+            IndexArray indexArray(static_cast<backend::IndexFormat>(subEntry->indexFormat));
+            indexArray.bresize(indices.size());
+            memcpy(indexArray.data(), indices.data(), indices.size());
+            indexdata->setIndexData(indexArray);
+#endif
+            vertexdata->_indices.pushBack(indexdata);
+        }
+
+        vertexdata->autorelease();
+        meshVertexDatas.pushBack(vertexdata);
+    }
+}
+
+bool MeshBundle::loadMaterials(MaterialDatas& materialdatas) const
+{
+    materialdatas.resetData();
+    if (!_data)
+        return false;
+
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    BundleReader reader;
+    reader.init(reinterpret_cast<char*>(const_cast<uint8_t*>(_data + header->sceneOffset)), header->sceneSize);
+
+    uint32_t materialCount = 0;
+    if (reader.read(&materialCount, 4, 1) != 1)
+        return false;
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        auto& material        = materialdatas.materials.emplace_back();
+        material.id           = reader.readString();
+        uint32_t textureCount = 0;
+        if (reader.read(&textureCount, 4, 1) != 1)
+            return false;
+        for (uint32_t k = 0; k < textureCount; ++k)
+        {
+            auto& texture    = material.textures.emplace_back();
+            texture.id       = reader.readString();
+            texture.filename = reader.readString();
+            uint32_t values[4];
+            if (reader.read(values, 4, 4) != 4)
+                return false;
+            if (values[0] && !texture.filename.empty())
+                texture.filename.insert(0, _modelDir);
+            texture.type  = static_cast<NTextureData::Usage>(values[1]);
+            texture.wrapS = static_cast<backend::SamplerAddressMode>(values[2]);
+            texture.wrapT = static_cast<backend::SamplerAddressMode>(values[3]);
+        }
+    }
+    return true;
+}
+
+bool MeshBundle::loadNodes(NodeDatas& nodedatas) const
+{
+    nodedatas.resetData();
+    if (!_data)
+        return false;
+
+    auto header = reinterpret_cast<const FileHeader*>(_data);
+    BundleReader reader;
+    reader.init(reinterpret_cast<char*>(const_cast<uint8_t*>(_data + header->sceneOffset)), header->sceneSize);
+
+    // skip the materials
+    uint32_t materialCount = 0;
+    if (reader.read(&materialCount, 4, 1) != 1)
+        return false;
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        reader.readString();
+        uint32_t textureCount = 0;
+        if (reader.read(&textureCount, 4, 1) != 1)
+            return false;
+        for (uint32_t k = 0; k < textureCount; ++k)
+        {
+            reader.readString();
+            reader.readString();
+            if (reader.seek(sizeof(uint32_t) * 4, SEEK_CUR) == false)
+                return false;
+        }
+    }
+
+    if (!readNodes(reader, nodedatas.skeleton) || !readNodes(reader, nodedatas.nodes))
+    {
+        nodedatas.resetData();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace ax
@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <span>
+#include <string>
+
+#include "base/Data.h"
+#include "base/Vector.h"
+#include "3d/Bundle3DData.h"
+#include "3d/VertexCompression.h"
+#include "mio/mio.hpp"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+class MeshVertexData;
+
+/**
+ * @brief MeshBundle, a binary model format laid out for the GPU, the .c3m files.
+ *
+ * The vertex and index data of every mesh is stored in blobs aligned to BLOB_ALIGNMENT, in the layout of
+ * the vertex and index buffers. The file is memory mapped and the blobs are uploaded to the backend buffers
+ * straight from the mapping, nothing is parsed or copied into intermediate MeshDatas. Only the nodes and the
+ * materials, which are small, are read into NodeDatas and MaterialDatas. On platforms where the file isn't
+ * mappable, e.g. the assets of an android apk, the file is read into memory instead.
+ *
+ * A .c3m file is created from a .c3b, .c3t or .obj model with MeshBundle::convert, it is loaded with
+ * MeshRenderer::create like the other model formats. The animations stay in the source model.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL MeshBundle
+{
+public:
+    /** The file format version, files of other versions are rejected. */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The alignment of the vertex and index blobs in the file. */
+    static constexpr uint32_t BLOB_ALIGNMENT = 16;
+
+    /** The max vertex attribute count of a mesh. */
+    static constexpr uint32_t MAX_ATTRIB_COUNT = 16;
+
+    /**
+     * Write mesh, material and node datas to a .c3m file.
+     *
+     * @param modelDir the directory the texture file names are made relative to, so the file can be moved
+     * along with its textures
+     */
+    static bool write(std::string_view fullPath,
+                      const MeshDatas& meshdatas,
+                      const MaterialDatas& materialdatas,
+                      const NodeDatas& nodedatas,
+                      std::string_view modelDir = "");
+
+    /**
+     * Convert a .c3b, .c3t or .obj model to a .c3m file.
+     *
+     * @param compression the vertex attributes packed into smaller formats, see VertexCompression
+     */
+    static bool convert(std::string_view srcPath,
+                        std::string_view dstFullPath,
+                        VertexCompressionFlags compression = VertexCompressionFlags::NONE);
+
+    MeshBundle() = default;
+    ~MeshBundle();
+
+    MeshBundle(const MeshBundle&)            = delete;
+    MeshBundle& operator=(const MeshBundle&) = delete;
+
+    /** Map a .c3m file and validate its tables. */
+    bool load(std::string_view path);
+
+    /** Unmap the file. */
+    void clear();
+
+    bool isLoaded() const { return _data != nullptr; }
+
+    int getMeshCount() const;
+    int getSubMeshCount(int mesh) const;
+
+    /** The interleaved vertices of a mesh, they point into the mapped file. */
+    std::span<const float> getVertices(int mesh) const;
+
+    /** The indices of a sub mesh, they point into the mapped file. */
+    std::span<const uint8_t> getIndices(int mesh, int subMesh) const;
+    backend::IndexFormat getIndexFormat(int mesh, int subMesh) const;
+
+    /** Create the vertex and index buffers of the meshes, must be called on the render thread. */
+    void createMeshVertexDatas(Vector<MeshVertexData*>& meshVertexDatas) const;
+
+    bool loadMaterials(MaterialDatas& materialdatas) const;
+    bool loadNodes(NodeDatas& nodedatas) const;
+
+protected:
+    struct FileHeader;
+    struct MeshEntry;
+    struct SubMeshEntry;
+
+    const MeshEntry* getMeshEntry(int mesh) const;
+    const SubMeshEntry* getSubMeshEntry(int mesh, int subMesh) const;
+    bool validate() const;
+
+    std::string _modelDir;
+
+    mio::mmap_source _mapping;
+    Data _buffer;  // used when the file can't be mapped
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -26,6 +26,8 @@
 
 #include "3d/MeshMaterial.h"
 #include "3d/Mesh.h"
+#include "3d/BonePalette.h"
+#include "3d/LightClusters.h"
 #include "platform/FileUtils.h"
 #include "renderer/Texture2D.h"
 #include "base/Director.h"
@@ -43,11 +45,14 @@ MeshMaterialCache* MeshMaterialCache::_cacheInstance = nullptr;
 std::unordered_map<std::string, MeshMaterial*> MeshMaterial::_materials;
 MeshMaterial* MeshMaterial::_unLitMaterial         = nullptr;
 MeshMaterial* MeshMaterial::_unLitInstanceMaterial = nullptr;
+MeshMaterial* MeshMaterial::_unLitInstanceColorMaterial = nullptr;
+MeshMaterial* MeshMaterial::_diffuseInstanceMaterial    = nullptr;
 MeshMaterial* MeshMaterial::_unLitNoTexMaterial    = nullptr;
 MeshMaterial* MeshMaterial::_vertexLitMaterial     = nullptr;
 MeshMaterial* MeshMaterial::_diffuseMaterial       = nullptr;
 MeshMaterial* MeshMaterial::_diffuseNoTexMaterial  = nullptr;
 MeshMaterial* MeshMaterial::_bumpedDiffuseMaterial = nullptr;
+MeshMaterial* MeshMaterial::_diffuseClusteredMaterial = nullptr;
 
 MeshMaterial* MeshMaterial::_unLitMaterialSkin         = nullptr;
 MeshMaterial* MeshMaterial::_vertexLitMaterialSkin     = nullptr;
@@ -59,11 +64,14 @@ MeshMaterial* MeshMaterial::_quadColorMaterial = nullptr;
 
 backend::ProgramState* MeshMaterial::_unLitMaterialProgState         = nullptr;
 backend::ProgramState* MeshMaterial::_unLitInstanceMaterialProgState = nullptr;
+backend::ProgramState* MeshMaterial::_unLitInstanceColorMaterialProgState = nullptr;
+backend::ProgramState* MeshMaterial::_diffuseInstanceMaterialProgState    = nullptr;
 backend::ProgramState* MeshMaterial::_unLitNoTexMaterialProgState    = nullptr;
 backend::ProgramState* MeshMaterial::_vertexLitMaterialProgState     = nullptr;
 backend::ProgramState* MeshMaterial::_diffuseMaterialProgState       = nullptr;
 backend::ProgramState* MeshMaterial::_diffuseNoTexMaterialProgState  = nullptr;
 backend::ProgramState* MeshMaterial::_bumpedDiffuseMaterialProgState = nullptr;
+backend::ProgramState* MeshMaterial::_diffuseClusteredMaterialProgState = nullptr;
 
 backend::ProgramState* MeshMaterial::_unLitMaterialSkinProgState         = nullptr;
 backend::ProgramState* MeshMaterial::_vertexLitMaterialSkinProgState     = nullptr;
@@ -75,7 +83,11 @@ backend::ProgramState* MeshMaterial::_quadColorMaterialProgState            = nu
 
 void MeshMaterial::createBuiltInMaterial()
 {
-    auto* program               = backend::Program::getBuiltinProgram(backend::ProgramType::SKINPOSITION_TEXTURE_3D);
+    // the skinned materials read the palettes of all meshes from one texture when the GPU can
+    const bool bonePalette = BonePalette::isSupported();
+
+    auto* program = backend::Program::getBuiltinProgram(
+        bonePalette ? backend::ProgramType::SKINPOSITION_TEXTURE_3D_PALETTE : backend::ProgramType::SKINPOSITION_TEXTURE_3D);
     _unLitMaterialSkinProgState = new backend::ProgramState(program);
     _unLitMaterialSkin          = new MeshMaterial();
     if (_unLitMaterialSkin && _unLitMaterialSkin->initWithProgramState(_unLitMaterialSkinProgState))
@@ -83,7 +95,9 @@ void MeshMaterial::createBuiltInMaterial()
         _unLitMaterialSkin->_type = MeshMaterial::MaterialType::UNLIT;
     }
 
-    program = backend::Program::getBuiltinProgram(backend::ProgramType::SKINPOSITION_NORMAL_TEXTURE_3D);
+    program = backend::Program::getBuiltinProgram(bonePalette
+                                                      ? backend::ProgramType::SKINPOSITION_NORMAL_TEXTURE_3D_PALETTE
+                                                      : backend::ProgramType::SKINPOSITION_NORMAL_TEXTURE_3D);
     _diffuseMaterialSkinProgState = new backend::ProgramState(program);
     _diffuseMaterialSkin          = new MeshMaterial();
     if (_diffuseMaterialSkin && _diffuseMaterialSkin->initWithProgramState(_diffuseMaterialSkinProgState))
@@ -115,6 +129,23 @@ void MeshMaterial::createBuiltInMaterial()
         _unLitInstanceMaterial->_type = MeshMaterial::MaterialType::UNLIT_INSTANCE;
     }
 
+    program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_3D_INSTANCE);
+    _unLitInstanceColorMaterialProgState = new backend::ProgramState(program);
+    _unLitInstanceColorMaterial          = new MeshMaterial();
+    if (_unLitInstanceColorMaterial &&
+        _unLitInstanceColorMaterial->initWithProgramState(_unLitInstanceColorMaterialProgState))
+    {
+        _unLitInstanceColorMaterial->_type = MeshMaterial::MaterialType::UNLIT_INSTANCE_COLOR;
+    }
+
+    program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_NORMAL_TEXTURE_3D_INSTANCE);
+    _diffuseInstanceMaterialProgState = new backend::ProgramState(program);
+    _diffuseInstanceMaterial          = new MeshMaterial();
+    if (_diffuseInstanceMaterial && _diffuseInstanceMaterial->initWithProgramState(_diffuseInstanceMaterialProgState))
+    {
+        _diffuseInstanceMaterial->_type = MeshMaterial::MaterialType::DIFFUSE_INSTANCE;
+    }
+
     program                      = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_3D);
     _unLitNoTexMaterialProgState = new backend::ProgramState(program);
     _unLitNoTexMaterial          = new MeshMaterial();
@@ -139,7 +170,21 @@ void MeshMaterial::createBuiltInMaterial()
         _bumpedDiffuseMaterial->_type = MeshMaterial::MaterialType::BUMPED_DIFFUSE;
     }
 
-    program = backend::Program::getBuiltinProgram(backend::ProgramType::SKINPOSITION_BUMPEDNORMAL_TEXTURE_3D);
+    if (LightClusters::isSupported())
+    {
+        program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_NORMAL_TEXTURE_3D_CLUSTERED);
+        _diffuseClusteredMaterialProgState = new backend::ProgramState(program);
+        _diffuseClusteredMaterial          = new MeshMaterial();
+        if (_diffuseClusteredMaterial &&
+            _diffuseClusteredMaterial->initWithProgramState(_diffuseClusteredMaterialProgState))
+        {
+            _diffuseClusteredMaterial->_type = MeshMaterial::MaterialType::DIFFUSE_CLUSTERED;
+        }
+    }
+
+    program = backend::Program::getBuiltinProgram(
+        bonePalette ? backend::ProgramType::SKINPOSITION_BUMPEDNORMAL_TEXTURE_3D_PALETTE
+                    : backend::ProgramType::SKINPOSITION_BUMPEDNORMAL_TEXTURE_3D);
     _bumpedDiffuseMaterialSkinProgState = new backend::ProgramState(program);
     _bumpedDiffuseMaterialSkin          = new MeshMaterial();
     if (_bumpedDiffuseMaterialSkin &&
@@ -169,23 +214,31 @@ void MeshMaterial::releaseBuiltInMaterial()
 {
     AX_SAFE_RELEASE_NULL(_unLitMaterial);
     AX_SAFE_RELEASE_NULL(_unLitMaterialSkin);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterial);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceColorMaterial);
+    AX_SAFE_RELEASE_NULL(_diffuseInstanceMaterial);
 
     AX_SAFE_RELEASE_NULL(_unLitNoTexMaterial);
     AX_SAFE_RELEASE_NULL(_vertexLitMaterial);
     AX_SAFE_RELEASE_NULL(_diffuseMaterial);
     AX_SAFE_RELEASE_NULL(_diffuseNoTexMaterial);
     AX_SAFE_RELEASE_NULL(_bumpedDiffuseMaterial);
+    AX_SAFE_RELEASE_NULL(_diffuseClusteredMaterial);
 
     AX_SAFE_RELEASE_NULL(_vertexLitMaterialSkin);
     AX_SAFE_RELEASE_NULL(_diffuseMaterialSkin);
     AX_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialSkin);
     // release program states
     AX_SAFE_RELEASE_NULL(_unLitMaterialProgState);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceMaterialProgState);
+    AX_SAFE_RELEASE_NULL(_unLitInstanceColorMaterialProgState);
+    AX_SAFE_RELEASE_NULL(_diffuseInstanceMaterialProgState);
     AX_SAFE_RELEASE_NULL(_unLitNoTexMaterialProgState);
     AX_SAFE_RELEASE_NULL(_vertexLitMaterialProgState);
     AX_SAFE_RELEASE_NULL(_diffuseMaterialProgState);
     AX_SAFE_RELEASE_NULL(_diffuseNoTexMaterialProgState);
     AX_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialProgState);
+    AX_SAFE_RELEASE_NULL(_diffuseClusteredMaterialProgState);
 
     AX_SAFE_RELEASE_NULL(_unLitMaterialSkinProgState);
     AX_SAFE_RELEASE_NULL(_vertexLitMaterialSkinProgState);
@@ -246,6 +299,14 @@ MeshMaterial* MeshMaterial::createBuiltInMaterial(MaterialType type, bool skinne
         material = skinned ? /* TODO: implement instanced hardware skinning */ nullptr : _unLitInstanceMaterial;
         break;
 
+    case MeshMaterial::MaterialType::UNLIT_INSTANCE_COLOR:
+        material = skinned ? nullptr : _unLitInstanceColorMaterial;
+        break;
+
+    case MeshMaterial::MaterialType::DIFFUSE_INSTANCE:
+        material = skinned ? nullptr : _diffuseInstanceMaterial;
+        break;
+
     case MeshMaterial::MaterialType::UNLIT_NOTEX:
         material = _unLitNoTexMaterial;
         break;
@@ -266,6 +327,14 @@ MeshMaterial* MeshMaterial::createBuiltInMaterial(MaterialType type, bool skinne
         material = skinned ? _bumpedDiffuseMaterialSkin : _bumpedDiffuseMaterial;
         break;
 
+    case MeshMaterial::MaterialType::DIFFUSE_CLUSTERED:
+        // skinned meshes and GPUs without float textures keep the light uniforms
+        if (skinned)
+            material = _diffuseMaterialSkin;
+        else
+            material = _diffuseClusteredMaterial ? _diffuseClusteredMaterial : _diffuseMaterial;
+        break;
+
     case MeshMaterial::MaterialType::QUAD_TEXTURE:
         material = _quadTextureMaterial;
         break;
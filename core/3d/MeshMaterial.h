@@ -59,13 +59,16 @@ public:
     enum class MaterialType
     {
         // Built in materials
-        UNLIT,           // unlit material
-        UNLIT_INSTANCE,  // unlit instance material
+        UNLIT,                 // unlit material
+        UNLIT_INSTANCE,        // unlit instance material
+        UNLIT_INSTANCE_COLOR,  // unlit instance material with per instance colors
+        DIFFUSE_INSTANCE,      // diffuse instance material
         UNLIT_NOTEX,     // unlit material (without texture)
         VERTEX_LIT,      // vertex lit
         DIFFUSE,         // diffuse (pixel lighting)
         DIFFUSE_NOTEX,   // diffuse (without texture)
         BUMPED_DIFFUSE,  // bumped diffuse
+        DIFFUSE_CLUSTERED,  // diffuse with the point and spot lights read from LightClusters
         QUAD_TEXTURE,    // textured quad material
         QUAD_COLOR,      // colored quad material (without texture)
 
@@ -78,8 +81,10 @@ public:
      */
     enum class InstanceMaterialType
     {
-        NO_INSTANCING,  // disabled instancing
-        UNLIT_INSTANCE,  // unlit instance material
+        NO_INSTANCING,         // disabled instancing
+        UNLIT_INSTANCE,        // unlit instance material
+        UNLIT_INSTANCE_COLOR,  // unlit instance material with per instance colors
+        DIFFUSE_INSTANCE,      // diffuse (pixel lighting) instance material
 
         // Custom material
         CUSTOM,  // Create from a material file
@@ -140,11 +145,14 @@ protected:
     static std::unordered_map<std::string, MeshMaterial*> _materials;  // cached material
     static MeshMaterial* _unLitMaterial;
     static MeshMaterial* _unLitInstanceMaterial;
+    static MeshMaterial* _unLitInstanceColorMaterial;
+    static MeshMaterial* _diffuseInstanceMaterial;
     static MeshMaterial* _unLitNoTexMaterial;
     static MeshMaterial* _vertexLitMaterial;
     static MeshMaterial* _diffuseMaterial;
     static MeshMaterial* _diffuseNoTexMaterial;
     static MeshMaterial* _bumpedDiffuseMaterial;
+    static MeshMaterial* _diffuseClusteredMaterial;
 
     static MeshMaterial* _unLitMaterialSkin;
     static MeshMaterial* _vertexLitMaterialSkin;
@@ -156,11 +164,14 @@ protected:
 
     static backend::ProgramState* _unLitMaterialProgState;
     static backend::ProgramState* _unLitInstanceMaterialProgState;
+    static backend::ProgramState* _unLitInstanceColorMaterialProgState;
+    static backend::ProgramState* _diffuseInstanceMaterialProgState;
     static backend::ProgramState* _unLitNoTexMaterialProgState;
     static backend::ProgramState* _vertexLitMaterialProgState;
     static backend::ProgramState* _diffuseMaterialProgState;
     static backend::ProgramState* _diffuseNoTexMaterialProgState;
     static backend::ProgramState* _bumpedDiffuseMaterialProgState;
+    static backend::ProgramState* _diffuseClusteredMaterialProgState;
 
     static backend::ProgramState* _unLitMaterialSkinProgState;
     static backend::ProgramState* _vertexLitMaterialSkinProgState;
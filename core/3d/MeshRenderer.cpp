@@ -28,8 +28,11 @@
 #include "3d/ObjLoader.h"
 #include "3d/MeshSkin.h"
 #include "3d/Bundle3D.h"
+#include "3d/MeshBundle.h"
+#include "3d/MeshSimplifier.h"
 #include "3d/MeshMaterial.h"
 #include "3d/AttachNode.h"
+#include "3d/CascadedShadowMap.h"
 #include "3d/Mesh.h"
 
 #include "base/Director.h"
@@ -37,20 +40,41 @@
 #include "base/Utils.h"
 #include "2d/Light.h"
 #include "2d/Camera.h"
+#include "2d/Scene.h"
 #include "base/Macros.h"
 #include "platform/PlatformMacros.h"
 #include "platform/FileUtils.h"
+#include "platform/Image.h"
 #include "renderer/TextureCache.h"
 #include "renderer/Renderer.h"
 #include "renderer/Material.h"
 #include "renderer/Technique.h"
 #include "renderer/Pass.h"
 
+#include <chrono>
+#include <deque>
+
 namespace ax
 {
 
 static MeshMaterial* getMeshRendererMaterialForAttribs(MeshVertexData* meshVertexData, bool usesLight);
 
+namespace
+{
+VertexCompressionFlags s_vertexCompression = VertexCompressionFlags::NONE;
+
+void compressMeshDatas(MeshDatas* meshdatas)
+{
+    if (!s_vertexCompression)
+        return;
+    for (auto meshdata : meshdatas->meshDatas)
+    {
+        if (meshdata)
+            VertexCompression::compress(*meshdata, s_vertexCompression);
+    }
+}
+}  // namespace
+
 MeshRenderer* MeshRenderer::create()
 {
     auto mesh = new MeshRenderer();
@@ -84,6 +108,22 @@ MeshRenderer* MeshRenderer::create(std::string_view modelPath, std::string_view
     return nullptr;
 }
 
+MeshRenderer* MeshRenderer::createSimplified(std::string_view modelPath, float ratio, std::string_view texturePath)
+{
+    AXASSERT(modelPath.length() >= 4, "Invalid filename.");
+
+    auto meshRenderer = new MeshRenderer();
+    if (meshRenderer->initWithSimplifiedFile(modelPath, ratio))
+    {
+        meshRenderer->setModelTexture(modelPath, texturePath);
+        meshRenderer->_contentSize = meshRenderer->getBoundingBox().size;
+        meshRenderer->autorelease();
+        return meshRenderer;
+    }
+    AX_SAFE_DELETE(meshRenderer);
+    return nullptr;
+}
+
 void MeshRenderer::createAsync(std::string_view modelPath,
                                const std::function<void(MeshRenderer*, void*)>& callback,
                                void* callbackparam)
@@ -113,15 +153,152 @@ void MeshRenderer::createAsync(std::string_view modelPath,
     meshRenderer->_asyncLoadParam.materialdatas     = new MaterialDatas();
     meshRenderer->_asyncLoadParam.meshdatas         = new MeshDatas();
     meshRenderer->_asyncLoadParam.nodeDatas         = new NodeDatas();
+    meshRenderer->_asyncLoadParam.meshBundle        = new MeshBundle();
+    // a full path, the worker must not resolve paths through the FileUtils cache
+    meshRenderer->_asyncLoadParam.texFullPath =
+        texturePath.empty() ? std::string{} : FileUtils::getInstance()->fullPathForFilename(texturePath);
 
     auto director = Director::getInstance();
     director->getJobSystem()->enqueue(
         [director, meshRenderer] {
         auto& loadParam  = meshRenderer->_asyncLoadParam;
         loadParam.result = meshRenderer->loadFromFile(loadParam.modelFullPath, loadParam.nodeDatas, loadParam.meshdatas,
-                                                      loadParam.materialdatas);
+                                                      loadParam.materialdatas, loadParam.meshBundle);
+        if (loadParam.result)
+        {
+            compressMeshDatas(loadParam.meshdatas);
+            meshRenderer->decodeAsyncTextures(&loadParam);
+        }
     },
-        [meshRenderer] { meshRenderer->afterAsyncLoad(&meshRenderer->_asyncLoadParam); });
+        [meshRenderer] { meshRenderer->scheduleAsyncUploads(&meshRenderer->_asyncLoadParam); });
+}
+
+namespace
+{
+// the main thread steps of the asynchronous loads, run within a time budget per frame
+struct AsyncUploadQueue
+{
+    std::deque<std::function<void()>> steps;
+    float budget = 4.0f;  // in milliseconds
+
+    void push(std::function<void()> step)
+    {
+        auto scheduler = Director::getInstance()->getScheduler();
+        if (!scheduler->isScheduled("MeshRenderer::asyncUpload"sv, this))
+            scheduler->schedule([this](float) { update(); }, this, 0, false, "MeshRenderer::asyncUpload"sv);
+        steps.emplace_back(std::move(step));
+    }
+
+    void update()
+    {
+        auto start = std::chrono::steady_clock::now();
+        while (!steps.empty())
+        {
+            auto step = std::move(steps.front());
+            steps.pop_front();
+            step();
+            if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget)
+                break;
+        }
+
+        if (steps.empty())
+            Director::getInstance()->getScheduler()->unschedule("MeshRenderer::asyncUpload"sv, this);
+    }
+};
+
+AsyncUploadQueue s_asyncUploadQueue;
+}  // namespace
+
+void MeshRenderer::setAsyncUploadBudget(float milliseconds)
+{
+    s_asyncUploadQueue.budget = milliseconds;
+}
+
+float MeshRenderer::getAsyncUploadBudget()
+{
+    return s_asyncUploadQueue.budget;
+}
+
+void MeshRenderer::setVertexCompression(VertexCompressionFlags flags)
+{
+    s_vertexCompression = flags;
+}
+
+VertexCompressionFlags MeshRenderer::getVertexCompression()
+{
+    return s_vertexCompression;
+}
+
+void MeshRenderer::decodeAsyncTextures(void* param)
+{
+    auto asyncParam = (MeshRenderer::AsyncLoadParam*)param;
+
+    std::vector<std::string_view> paths;
+    if (!asyncParam->texFullPath.empty())
+        paths.emplace_back(asyncParam->texFullPath);
+    for (const auto& material : asyncParam->materialdatas->materials)
+    {
+        for (const auto& texture : material.textures)
+        {
+            // the bundles resolve the textures to full paths, skip the ones that aren't
+            if (!texture.filename.empty() && FileUtils::getInstance()->isAbsolutePath(texture.filename))
+                paths.emplace_back(texture.filename);
+        }
+    }
+
+    for (auto path : paths)
+    {
+        auto found = std::find_if(asyncParam->images.begin(), asyncParam->images.end(),
+                                  [path](const auto& image) { return image.first == path; });
+        if (found != asyncParam->images.end())
+            continue;
+
+        auto image = new Image();
+        if (image->initWithImageFile(path))
+            asyncParam->images.emplace_back(std::string{path}, image);
+        else
+            image->release();
+    }
+}
+
+void MeshRenderer::scheduleAsyncUploads(void* param)
+{
+    auto asyncParam = (MeshRenderer::AsyncLoadParam*)param;
+    if (!asyncParam->result)
+    {
+        afterAsyncLoad(param);
+        return;
+    }
+
+    // one step per texture and per mesh, the textures land in the cache the nodes look them up from
+    for (auto&& image : asyncParam->images)
+    {
+        s_asyncUploadQueue.push([this, asyncParam, image] {
+            _director->getTextureCache()->addImage(image.second, image.first);
+            image.second->release();
+        });
+    }
+    asyncParam->images.clear();
+
+    _meshVertexDatas.clear();
+    if (asyncParam->meshBundle->isLoaded())
+    {
+        s_asyncUploadQueue.push([this, asyncParam] {
+            asyncParam->meshBundle->createMeshVertexDatas(_meshVertexDatas);
+            AX_SAFE_DELETE(asyncParam->meshBundle);
+        });
+    }
+    for (auto meshdata : asyncParam->meshdatas->meshDatas)
+    {
+        if (meshdata)
+            s_asyncUploadQueue.push([this, meshdata] { _meshVertexDatas.pushBack(MeshVertexData::create(*meshdata)); });
+    }
+
+    s_asyncUploadQueue.push([this, asyncParam] {
+        // the vertex datas are created, initFrom only creates the nodes
+        asyncParam->meshdatas->resetData();
+        afterAsyncLoad(asyncParam);
+    });
 }
 
 void MeshRenderer::afterAsyncLoad(void* param)
@@ -133,11 +310,10 @@ void MeshRenderer::afterAsyncLoad(void* param)
         if (asyncParam->result)
         {
             _meshes.clear();
-            _meshVertexDatas.clear();
             AX_SAFE_RELEASE_NULL(_skeleton);
             removeAllAttachNode();
 
-            // create in the main thread
+            // create in the main thread, the vertex datas were created by the upload steps
             auto& meshdatas     = asyncParam->meshdatas;
             auto& materialdatas = asyncParam->materialdatas;
             auto& nodeDatas     = asyncParam->nodeDatas;
@@ -166,11 +342,13 @@ void MeshRenderer::afterAsyncLoad(void* param)
             AX_SAFE_DELETE(meshdatas);
             AX_SAFE_DELETE(materialdatas);
             AX_SAFE_DELETE(nodeDatas);
+            AX_SAFE_DELETE(asyncParam->meshBundle);
 
             setModelTexture(asyncParam->modelPath, asyncParam->texPath);
         }
         else
         {
+            AX_SAFE_DELETE(asyncParam->meshBundle);
             AXLOGW("file load failed: {}\n", asyncParam->modelPath);
         }
         asyncParam->afterLoadCallback(this, asyncParam->callbackParam);
@@ -236,7 +414,8 @@ bool MeshRenderer::loadFromCache(std::string_view path)
 bool MeshRenderer::loadFromFile(std::string_view path,
                                 NodeDatas* nodedatas,
                                 MeshDatas* meshdatas,
-                                MaterialDatas* materialdatas)
+                                MaterialDatas* materialdatas,
+                                MeshBundle* meshBundle)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
 
@@ -261,6 +440,12 @@ bool MeshRenderer::loadFromFile(std::string_view path,
 
         return ret;
     }
+    else if (ext == ".c3m" && meshBundle)
+    {
+        // the meshes stay in the mapped file until their buffers are created
+        return meshBundle->load(fullPath) && meshBundle->loadMaterials(*materialdatas) &&
+               meshBundle->loadNodes(*nodedatas);
+    }
     return false;
 }
 
@@ -272,6 +457,7 @@ MeshRenderer::MeshRenderer()
     , _shaderUsingLight(false)
     , _forceDepthWrite(false)
     , _wireframe(false)
+    , _castShadow(false)
     , _usingAutogeneratedGLProgram(true)
     , _transparentMaterialHint(false)
     , _meshTextureHint(0)
@@ -279,6 +465,8 @@ MeshRenderer::MeshRenderer()
 
 MeshRenderer::~MeshRenderer()
 {
+    if (_castShadow)
+        CascadedShadowMap::removeCaster(this);
     _meshes.clear();
     _meshVertexDatas.clear();
     AX_SAFE_RELEASE_NULL(_skeleton);
@@ -308,8 +496,11 @@ bool MeshRenderer::initWithFile(std::string_view path)
     MeshDatas* meshdatas         = new MeshDatas();
     MaterialDatas* materialdatas = new MaterialDatas();
     NodeDatas* nodeDatas         = new NodeDatas();
-    if (loadFromFile(path, nodeDatas, meshdatas, materialdatas))
+    MeshBundle meshBundle;
+    if (loadFromFile(path, nodeDatas, meshdatas, materialdatas, &meshBundle))
     {
+        compressMeshDatas(meshdatas);
+        meshBundle.createMeshVertexDatas(_meshVertexDatas);
         if (initFrom(*nodeDatas, *meshdatas, *materialdatas))
         {
             // add to cache
@@ -335,6 +526,64 @@ bool MeshRenderer::initWithFile(std::string_view path)
     return false;
 }
 
+bool MeshRenderer::initWithSimplifiedFile(std::string_view path, float ratio)
+{
+    _aabbDirty = true;
+    _meshes.clear();
+    _meshVertexDatas.clear();
+    AX_SAFE_RELEASE_NULL(_skeleton);
+    removeAllAttachNode();
+
+    auto cacheKey = fmt::format("{}#lod{}", path, ratio);
+    if (loadFromCache(cacheKey))
+        return true;
+
+    MeshDatas* meshdatas         = new MeshDatas();
+    MaterialDatas* materialdatas = new MaterialDatas();
+    NodeDatas* nodeDatas         = new NodeDatas();
+    if (loadFromFile(path, nodeDatas, meshdatas, materialdatas))
+    {
+        for (auto meshdata : meshdatas->meshDatas)
+        {
+            int positionOffset = 0;
+            for (const auto& attrib : meshdata->attribs)
+            {
+                if (attrib.vertexAttrib == shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION)
+                    break;
+                positionOffset += attrib.getAttribSizeBytes() / sizeof(float);
+            }
+
+            // the sub mesh AABBs still hold, the simplified triangles use a subset of the vertices
+            for (auto&& indices : meshdata->subMeshIndices)
+                indices = MeshSimplifier::simplify(meshdata->vertex, meshdata->vertexSizeInFloat, positionOffset,
+                                                   indices, ratio);
+        }
+        compressMeshDatas(meshdatas);
+
+        if (initFrom(*nodeDatas, *meshdatas, *materialdatas))
+        {
+            auto data             = new MeshRendererCache::MeshRenderData();
+            data->materialdatas   = materialdatas;
+            data->nodedatas       = nodeDatas;
+            data->meshVertexDatas = _meshVertexDatas;
+            for (const auto mesh : _meshes)
+            {
+                data->programStates.pushBack(mesh->getProgramState());
+            }
+
+            MeshRendererCache::getInstance()->addMeshRenderData(cacheKey, data);
+            AX_SAFE_DELETE(meshdatas);
+            _contentSize = getBoundingBox().size;
+            return true;
+        }
+    }
+    AX_SAFE_DELETE(meshdatas);
+    AX_SAFE_DELETE(materialdatas);
+    AX_SAFE_DELETE(nodeDatas);
+
+    return false;
+}
+
 bool MeshRenderer::initFrom(const NodeDatas& nodeDatas, const MeshDatas& meshdatas, const MaterialDatas& materialdatas)
 {
     for (const auto& it : meshdatas.meshDatas)
@@ -491,6 +740,19 @@ void MeshRenderer::setMaterial(Material* material, int meshIndex)
     _usingAutogeneratedGLProgram = false;
 }
 
+void MeshRenderer::setSharedMaterial(Material* material)
+{
+    AXASSERT(material, "Invalid Material");
+
+    for (auto&& mesh : _meshes)
+    {
+        // the matrix palette of a skin is set to the pass by each mesh
+        mesh->setMaterial(mesh->getSkin() ? material->clone() : material);
+    }
+
+    _usingAutogeneratedGLProgram = false;
+}
+
 Material* MeshRenderer::getMaterial(int meshIndex) const
 {
     AXASSERT(meshIndex >= 0 && meshIndex < _meshes.size(), "Invalid meshIndex.");
@@ -704,19 +966,35 @@ void MeshRenderer::enableInstancing(MeshMaterial::InstanceMaterialType instanceM
     switch (instanceMat)
     {
     case MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE:
-    {
-        auto mat = MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::UNLIT_INSTANCE, false);
-        enableInstancing(mat, count);
-    }
+        enableInstancing(MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::UNLIT_INSTANCE, false), count);
+        break;
+    case MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE_COLOR:
+        enableInstancing(
+            MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::UNLIT_INSTANCE_COLOR, false), count);
+        break;
+    case MeshMaterial::InstanceMaterialType::DIFFUSE_INSTANCE:
+        enableInstancing(MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::DIFFUSE_INSTANCE, false),
+                         count);
+        break;
+    default:
+        break;
     }
 }
 
 void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 {
+    AXASSERT(instanceMat, "Invalid instance material");
+
+    // the instance material replaces the generated ones, it must not be swapped when the lights change
+    _usingAutogeneratedGLProgram = false;
+
+    bool first = true;
     for (auto&& mesh : _meshes)
     {
         mesh->enableInstancing(true, MAX(1, count));
-        mesh->setMaterial(instanceMat);
+        // every mesh binds its own vertex layout and textures to the material
+        mesh->setMaterial(first ? instanceMat : instanceMat->clone());
+        first = false;
     }
 }
 
@@ -744,6 +1022,20 @@ void MeshRenderer::addInstanceChild(Node* child, bool active)
     }
 }
 
+void MeshRenderer::setInstanceTransforms(std::span<const Mat4> transforms, std::span<const Color4F> colors)
+{
+    if (_meshes.empty())
+        return;
+
+    if (!_meshes.at(0)->isInstancing())
+        enableInstancing(colors.empty() ? MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE
+                                        : MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE_COLOR,
+                         static_cast<int>(transforms.size()));
+
+    for (auto&& mesh : _meshes)
+        mesh->setInstanceTransforms(transforms, colors);
+}
+
 void MeshRenderer::shrinkToFitInstances()
 {
     for (auto&& mesh : _meshes)
@@ -756,6 +1048,12 @@ void MeshRenderer::rebuildInstances()
         mesh->rebuildInstances();
 }
 
+void MeshRenderer::setInstanceCulling(bool culling)
+{
+    for (auto&& mesh : _meshes)
+        mesh->setInstanceCulling(culling);
+}
+
 void MeshRenderer::setTexture(std::string_view texFile)
 {
     auto tex = _director->getTextureCache()->addImage(texFile);
@@ -814,11 +1112,15 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
     // quick return if not visible. children won't be drawn.
     if (!_visible)
     {
+        // the transform isn't tracked while hidden, the bounds are refit every frame instead
+        _boundsDirty = _boundsScene != nullptr;
         return;
     }
 
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
     flags |= FLAGS_RENDER_AS_3D;
+    if (_boundsScene && ((flags & FLAGS_TRANSFORM_DIRTY) || _aabbDirty))
+        _boundsDirty = true;
 
     //
     _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
@@ -856,8 +1158,31 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
     _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 }
 
+void MeshRenderer::onEnter()
+{
+    Node::onEnter();
+
+    auto scene = getScene();
+    if (scene && scene->isBoundsTreeEnabled() && !_boundsScene)
+        scene->addBoundsNode(this);
+}
+
+void MeshRenderer::onExit()
+{
+    if (_boundsScene)
+        _boundsScene->removeBoundsNode(this);
+
+    Node::onExit();
+}
+
 void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    // culled by the bounds tree of the scene, the moved ones are drawn until their bounds are refit and the
+    // instanced ones always, their bounds don't cover the instances
+    if (_boundsScene && !_boundsDirty && _boundsScene->isCulledByBoundsTree(this) &&
+        (_meshes.empty() || !_meshes.at(0)->isInstancing()))
+        return;
+
 #if AX_USE_CULLING
     // TODO new-renderer: interface isVisibleInFrustum removal
     //  camera clipping
@@ -934,6 +1259,18 @@ AABB MeshRenderer::getAABBRecursively()
     return getAABBRecursivelyImp(this);
 }
 
+void MeshRenderer::setCastShadow(bool value)
+{
+    if (_castShadow == value)
+        return;
+
+    _castShadow = value;
+    if (value)
+        CascadedShadowMap::addCaster(this);
+    else
+        CascadedShadowMap::removeCaster(this);
+}
+
 const AABB& MeshRenderer::getAABB() const
 {
     Mat4 nodeToWorldTransform(getNodeToWorldTransform());
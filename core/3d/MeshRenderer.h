@@ -28,6 +28,7 @@
 #define __AX_MESH_RENDERER_H__
 
 #include <unordered_map>
+#include <span>
 
 #include "base/Vector.h"
 #include "base/Types.h"
@@ -37,6 +38,7 @@
 #include "3d/Skeleton3D.h"  // needs to be included for lua-bindings
 #include "3d/AABB.h"
 #include "3d/Bundle3DData.h"
+#include "3d/VertexCompression.h"
 #include "3d/MeshVertexIndexData.h"
 #include "3d/MeshMaterial.h"
 
@@ -52,8 +54,10 @@ class Mesh;
 class Texture2D;
 class MeshSkin;
 class AttachNode;
+class MeshBundle;
+class Image;
 struct NodeData;
-/** @brief MeshRenderer: A mesh can be loaded from model files, .obj, .c3t, .c3b
+/** @brief MeshRenderer: A mesh can be loaded from model files, .obj, .c3t, .c3b, .c3m
  *and a mesh renderer renders a list of these loaded meshes with specified materials
  */
 class AX_DLL MeshRenderer : public Node, public BlendProtocol
@@ -73,6 +77,19 @@ public:
     /** creates a MeshRenderer. A mesh can only have one texture, the default texture can be overridden with 'texturePath' */
     static MeshRenderer* create(std::string_view modelPath, std::string_view texturePath);
 
+    /**
+     * Creates a MeshRenderer with a simplified version of a model, to be used as a lower level of detail in a
+     * LODGroup. The triangles of every sub mesh are reduced to ratio with MeshSimplifier, the vertex data is
+     * shared with the source model so skinning and materials keep working. The simplified data is cached per
+     * model and ratio. .c3m bundles keep their meshes in the mapped file and are not supported.
+     *
+     * @param modelPath a .c3b, .c3t or .obj model
+     * @param ratio the fraction of the triangles to keep, 0 - 1
+     */
+    static MeshRenderer* createSimplified(std::string_view modelPath,
+                                          float ratio,
+                                          std::string_view texturePath = "");
+
     /** create 3d mesh asynchronously
      * If the 3d model was previously loaded, it will create a new 3d mesh and the callback will be called once.
      * Otherwise it will load the model file in a new thread, and when the 3d mesh is loaded, the callback will be
@@ -91,6 +108,23 @@ public:
                             const std::function<void(MeshRenderer*, void*)>& callback,
                             void* callbackparam);
 
+    /**
+     * Set the time in milliseconds the asynchronous loads may spend on the main thread per frame.
+     * Files are read, parsed and the textures decoded on the job system threads, only the texture
+     * and buffer uploads and the node creation run on the main thread, spread over the frames by this
+     * budget. At least one upload step runs every frame. The default is 4ms.
+     */
+    static void setAsyncUploadBudget(float milliseconds);
+    static float getAsyncUploadBudget();
+
+    /**
+     * Set the vertex attributes packed into smaller formats when .obj, .c3b and .c3t models are loaded, see
+     * VertexCompression. Only the models loaded afterwards are packed, the cached ones keep their vertices.
+     * The .c3m files are packed when they are converted instead. The default is NONE.
+     */
+    static void setVertexCompression(VertexCompressionFlags flags);
+    static VertexCompressionFlags getVertexCompression();
+
     /** set diffuse texture, set the first mesh's texture if multiple textures exist */
     void setTexture(std::string_view texFile);
     void setTexture(Texture2D* texture);
@@ -186,6 +220,11 @@ public:
     void setWireframe(bool value) { _wireframe = value; }
     bool isWireframe() const { return _wireframe; }
 
+    /** Whether the meshes are drawn into the cascades of the CascadedShadowMap nodes of the scene, the default is
+     false. */
+    void setCastShadow(bool value);
+    bool isCastShadow() const { return _castShadow; }
+
     /** render all meshes within this mesh renderer */
     virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
 
@@ -202,6 +241,14 @@ public:
      */
     void setMaterial(Material* material, int meshIndex);
 
+    /** Sets a material to all the meshes without cloning it, the mesh renderers of a model can share one material.
+     * The meshes share the program state of the material, i.e. its uniforms and textures, only their transform and
+     * color are set per draw. With material reordering enabled, see Renderer::setMaterialReorderEnabled, the opaque
+     * meshes sharing a material are drawn one after the other.
+     * The meshes must have the same vertex format and the same light mask, the skinned meshes get a clone.
+     */
+    void setSharedMaterial(Material* material);
+
     /** Gets the material of a specific mesh in this mesh renderer.
      *
      * @param meshIndex Index of the mesh to get the material from. 0 is the default index.
@@ -218,14 +265,21 @@ public:
 
     bool initWithFile(std::string_view path);
 
+    bool initWithSimplifiedFile(std::string_view path, float ratio);
+
     bool initFrom(const NodeDatas& nodedatas, const MeshDatas& meshdatas, const MaterialDatas& materialdatas);
 
     /** load a mesh renderer from cache, returns true if succeeded, false otherwise. */
     bool loadFromCache(std::string_view path);
 
     /** load a file and feed it's content into meshedatas, nodedatas and materialdatas, obj file and .mtl file
-     should be in the same directory. */
-    bool loadFromFile(std::string_view path, NodeDatas* nodedatas, MeshDatas* meshdatas, MaterialDatas* materialdatas);
+     should be in the same directory. A .c3m file is mapped into meshBundle instead of meshdatas, its buffers are
+     created by MeshBundle::createMeshVertexDatas. */
+    bool loadFromFile(std::string_view path,
+                      NodeDatas* nodedatas,
+                      MeshDatas* meshdatas,
+                      MaterialDatas* materialdatas,
+                      MeshBundle* meshBundle = nullptr);
 
     /**
      * Visits this MeshRenderer's children and draws them recursively.
@@ -234,6 +288,9 @@ public:
      */
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
 
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
     /** generate default material. */
     void genMaterial(bool useLight = false);
 
@@ -249,6 +306,10 @@ public:
     void onAABBDirty() { _aabbDirty = true; }
 
     void afterAsyncLoad(void* param);
+    /** decode the textures of the loaded materials, called from the loading thread */
+    void decodeAsyncTextures(void* param);
+    /** queue the texture and buffer uploads of the loaded model, the last step calls afterAsyncLoad */
+    void scheduleAsyncUploads(void* param);
 
     static AABB getAABBRecursivelyImp(Node* node);
 
@@ -290,12 +351,27 @@ public:
     */
     void addInstanceChild(Node* child, bool active = false);
 
+    /** Sets the transforms of the instances from a contiguous array, in the space of this node,
+    and draws them with one instanced draw per mesh. Instancing is enabled with the unlit instance
+    material when it isn't yet, `MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE_COLOR` when colors
+    are given. The arrays are copied, call it again when they change.
+    @param transforms The instance transforms, they replace the instance children.
+    @param colors Optional, one color per transform, needs a material reading colored instances.
+    @see Mesh::setInstanceTransforms */
+    void setInstanceTransforms(std::span<const Mat4> transforms, std::span<const Color4F> colors = {});
+
     /** shrinks the instance transform buffer after many steps of expansion to increase performance. */
     void shrinkToFitInstances();
 
     /** rebuilds the instance transform buffer next frame. */
     void rebuildInstances();
 
+    /** Set this to true to draw only the instances in the frustum of the visiting camera,
+    each instance is culled by the AABB of the mesh in its transform. Disabled by default,
+    it pays off when a large part of the instances is out of view.
+    @see Mesh::setInstanceCulling */
+    void setInstanceCulling(bool culling);
+
 protected:
     /** set specific mesh texture, for private use (create mesh stage) only */
     Texture2D* setMeshTexture(Mesh* mesh,
@@ -324,10 +400,17 @@ protected:
     bool _shaderUsingLight;  // Is the current shader using lighting?
     bool _forceDepthWrite;   // Always write to depth buffer
     bool _wireframe;         // render in wireframe mode
+    bool _castShadow;        // drawn into the shadow maps
     bool _usingAutogeneratedGLProgram;
     bool _transparentMaterialHint; // Generate transparent materials when building from files
     unsigned short _meshTextureHint; // Whether model file has texture config
 
+    friend class Scene;
+    Scene* _boundsScene = nullptr;  // the scene whose bounds tree holds this mesh renderer
+    int _boundsProxy    = -1;       // the proxy in the bounds tree
+    size_t _boundsIndex = 0;        // the index in the bounds nodes of the scene
+    bool _boundsDirty   = false;    // moved since the bounds were refit
+
     struct AsyncLoadParam
     {
         std::function<void(MeshRenderer*, void*)> afterLoadCallback;  // callback after loading is finished
@@ -339,6 +422,9 @@ protected:
         MeshDatas* meshdatas;
         MaterialDatas* materialdatas;
         NodeDatas* nodeDatas;
+        MeshBundle* meshBundle;
+        std::string texFullPath;
+        std::vector<std::pair<std::string, Image*>> images;  // decoded textures, key is the full path
     };
     AsyncLoadParam _asyncLoadParam;
 };
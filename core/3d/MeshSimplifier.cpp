@@ -0,0 +1,322 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/MeshSimplifier.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+
+namespace ax
+{
+
+namespace
+{
+// symmetric 4x4 error quadric of the planes around a vertex
+struct Quadric
+{
+    double a[10] = {};
+
+    void addPlane(const Vec3& n, double d, double weight)
+    {
+        a[0] += weight * n.x * n.x;
+        a[1] += weight * n.x * n.y;
+        a[2] += weight * n.x * n.z;
+        a[3] += weight * n.x * d;
+        a[4] += weight * n.y * n.y;
+        a[5] += weight * n.y * n.z;
+        a[6] += weight * n.y * d;
+        a[7] += weight * n.z * n.z;
+        a[8] += weight * n.z * d;
+        a[9] += weight * d * d;
+    }
+
+    void add(const Quadric& q)
+    {
+        for (int i = 0; i < 10; ++i)
+            a[i] += q.a[i];
+    }
+
+    double error(const Vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x + a[4] * y * y + 2 * a[5] * y * z +
+               2 * a[6] * y + a[7] * z * z + 2 * a[8] * z + a[9];
+    }
+};
+
+struct Triangle
+{
+    uint32_t v[3];       // welded vertices
+    uint32_t corner[3];  // vertices of the index array
+    bool alive;
+};
+
+struct Collapse
+{
+    double cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromStamp;
+    uint32_t toStamp;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+struct PositionKey
+{
+    uint32_t bits[3];
+    bool operator==(const PositionKey& other) const
+    {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey& key) const
+    {
+        return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+    }
+};
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+    return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+}
+}  // namespace
+
+IndexArray MeshSimplifier::simplify(std::span<const float> vertices,
+                                    int floatsPerVertex,
+                                    int positionOffset,
+                                    const IndexArray& indices,
+                                    float ratio,
+                                    float* error)
+{
+    AXASSERT(floatsPerVertex >= positionOffset + 3, "invalid vertex layout");
+
+    if (error)
+        *error = 0.0f;
+
+    const bool shortIndices  = indices.format() == backend::IndexFormat::U_SHORT;
+    const size_t vertexCount = vertices.size() / floatsPerVertex;
+    const size_t indexCount  = indices.size() - indices.size() % 3;
+    if (ratio >= 1.0f || indexCount == 0 || vertexCount == 0)
+        return indices;
+
+    auto readIndex = [&](size_t i) -> uint32_t {
+        return shortIndices ? indices.at<uint16_t>(i) : indices.at<uint32_t>(i);
+    };
+    auto position = [&](uint32_t v) {
+        const float* p = vertices.data() + v * floatsPerVertex + positionOffset;
+        return Vec3(p[0], p[1], p[2]);
+    };
+
+    // weld the vertices sharing a position, their topology is simplified together
+    std::vector<uint32_t> welded(vertexCount);
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> positions;
+        positions.reserve(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            PositionKey key;
+            memcpy(key.bits, vertices.data() + v * floatsPerVertex + positionOffset, sizeof(key.bits));
+            welded[v] = positions.emplace(key, v).first->second;
+        }
+    }
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(indexCount / 3);
+    for (size_t i = 0; i < indexCount; i += 3)
+    {
+        Triangle t;
+        for (int k = 0; k < 3; ++k)
+        {
+            t.corner[k] = readIndex(i + k);
+            AXASSERT(t.corner[k] < vertexCount, "index out of range");
+            t.v[k] = welded[t.corner[k]];
+        }
+        t.alive = t.v[0] != t.v[1] && t.v[1] != t.v[2] && t.v[0] != t.v[2];
+        if (t.alive)
+            triangles.emplace_back(t);
+    }
+
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    std::unordered_map<uint64_t, int> edgeUses;
+    for (uint32_t i = 0; i < triangles.size(); ++i)
+    {
+        auto& t = triangles[i];
+        Vec3 p0 = position(t.v[0]), p1 = position(t.v[1]), p2 = position(t.v[2]);
+        Vec3 n;
+        Vec3::cross(p1 - p0, p2 - p0, &n);
+        float area2 = n.length();
+        if (area2 > 0.0f)
+        {
+            n *= 1.0f / area2;
+            for (auto v : t.v)
+                quadrics[v].addPlane(n, -n.dot(p0), area2 * 0.5);
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            vertexTriangles[t.v[k]].emplace_back(i);
+            ++edgeUses[edgeKey(t.v[k], t.v[(k + 1) % 3])];
+        }
+    }
+
+    // keep the open borders and the non manifold edges
+    std::vector<bool> locked(vertexCount, false);
+    for (auto&& edge : edgeUses)
+    {
+        if (edge.second != 2)
+        {
+            locked[edge.first >> 32]        = true;
+            locked[edge.first & 0xffffffff] = true;
+        }
+    }
+
+    std::vector<uint32_t> stamps(vertexCount, 0);
+    std::vector<bool> removed(vertexCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (locked[from])
+            return;
+        Quadric q = quadrics[from];
+        q.add(quadrics[to]);
+        queue.push(Collapse{q.error(position(to)), from, to, stamps[from], stamps[to]});
+    };
+    for (auto&& edge : edgeUses)
+    {
+        auto a = static_cast<uint32_t>(edge.first >> 32), b = static_cast<uint32_t>(edge.first & 0xffffffff);
+        pushCollapse(a, b);
+        pushCollapse(b, a);
+    }
+
+    const size_t targetCount = static_cast<size_t>(triangles.size() * (std::max)(ratio, 0.0f));
+    size_t aliveCount        = triangles.size();
+    double maxError          = 0;
+    std::vector<uint32_t> neighbours;
+    while (aliveCount > targetCount && !queue.empty())
+    {
+        auto collapse = queue.top();
+        queue.pop();
+        const uint32_t from = collapse.from, to = collapse.to;
+        if (removed[from] || removed[to] || stamps[from] != collapse.fromStamp || stamps[to] != collapse.toStamp)
+            continue;
+
+        // reject the collapses flipping a remaining triangle
+        const Vec3 target = position(to);
+        bool flips        = false;
+        for (auto index : vertexTriangles[from])
+        {
+            auto& t = triangles[index];
+            if (!t.alive || t.v[0] == to || t.v[1] == to || t.v[2] == to)
+                continue;
+            Vec3 p[3], q[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                p[k] = position(t.v[k]);
+                q[k] = t.v[k] == from ? target : p[k];
+            }
+            Vec3 before, after;
+            Vec3::cross(p[1] - p[0], p[2] - p[0], &before);
+            Vec3::cross(q[1] - q[0], q[2] - q[0], &after);
+            if (before.dot(after) <= 0.0f)
+            {
+                flips = true;
+                break;
+            }
+        }
+        if (flips)
+            continue;
+
+        removed[from] = true;
+        quadrics[to].add(quadrics[from]);
+        maxError = (std::max)(maxError, collapse.cost);
+        for (auto index : vertexTriangles[from])
+        {
+            auto& t = triangles[index];
+            if (!t.alive)
+                continue;
+            if (t.v[0] == to || t.v[1] == to || t.v[2] == to)
+            {
+                t.alive = false;
+                --aliveCount;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                if (t.v[k] == from)
+                {
+                    t.v[k]      = to;
+                    t.corner[k] = to;
+                }
+            }
+            vertexTriangles[to].emplace_back(index);
+        }
+        vertexTriangles[from].clear();
+
+        // the quadric of the target changed, requeue its edges
+        ++stamps[to];
+        auto& toTriangles = vertexTriangles[to];
+        toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(),
+                                         [&](uint32_t index) { return !triangles[index].alive; }),
+                          toTriangles.end());
+        neighbours.clear();
+        for (auto index : toTriangles)
+        {
+            for (auto v : triangles[index].v)
+            {
+                if (v != to)
+                    neighbours.emplace_back(v);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (auto v : neighbours)
+        {
+            pushCollapse(v, to);
+            pushCollapse(to, v);
+        }
+    }
+
+    IndexArray result(indices.format());
+    for (auto&& t : triangles)
+    {
+        if (!t.alive)
+            continue;
+        for (auto corner : t.corner)
+        {
+            if (shortIndices)
+                result.emplace_back(static_cast<uint16_t>(corner));
+            else
+                result.emplace_back(corner);
+        }
+    }
+
+    if (error)
+        *error = static_cast<float>(maxError);
+    return result;
+}
+
+}  // namespace ax
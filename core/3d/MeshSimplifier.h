@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <span>
+
+#include "3d/Bundle3DData.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief MeshSimplifier, reduces the triangles of a mesh for its lower levels of detail.
+ *
+ * Edges are collapsed in the order of their quadric error, each collapse moves a vertex onto one of its
+ * neighbours, so the vertices are never changed and the simplified index array keeps using the vertex buffer
+ * of the source mesh. Vertices sharing a position, e.g. on texture seams, are collapsed together, the vertices
+ * on open borders are kept so the silhouette doesn't tear, and collapses flipping a triangle are rejected.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL MeshSimplifier
+{
+public:
+    /**
+     * Simplify a triangle list.
+     *
+     * @param vertices interleaved vertices
+     * @param floatsPerVertex the vertex stride in floats
+     * @param positionOffset the offset in floats of the xyz position in a vertex
+     * @param indices triangle list indices
+     * @param ratio the fraction of the triangles to keep, 0 - 1
+     * @param error the largest quadric error of the collapses, optional
+     * @return the indices of the simplified triangles, in the format of indices
+     */
+    static IndexArray simplify(std::span<const float> vertices,
+                               int floatsPerVertex,
+                               int positionOffset,
+                               const IndexArray& indices,
+                               float ratio,
+                               float* error = nullptr);
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -26,6 +26,8 @@
 #include "3d/MeshSkin.h"
 #include "3d/Bundle3D.h"
 #include "3d/Skeleton3D.h"
+#include "3d/BonePalette.h"
+#include "base/Director.h"
 
 namespace ax
 {
@@ -125,6 +127,17 @@ ssize_t MeshSkin::getMatrixPaletteSizeInBytes() const
     return _skinBones.size() * PALETTE_ROWS * sizeof(_matrixPalette[0]);
 }
 
+int MeshSkin::getBonePaletteOffset()
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (_bonePaletteOffset < 0 || _bonePaletteFrame != frame)
+    {
+        _bonePaletteFrame  = frame;
+        _bonePaletteOffset = BonePalette::getInstance()->append(getMatrixPalette(), getMatrixPaletteSize());
+    }
+    return _bonePaletteOffset;
+}
+
 void MeshSkin::removeAllBones()
 {
     _skinBones.clear();
@@ -80,6 +80,11 @@ public:
     /**getSkinBoneCount() * 3 * sizeof(Vec4) */
     ssize_t getMatrixPaletteSizeInBytes() const;
 
+    /**append the matrix palette to the bone palette texture, once per frame for all meshes sharing the skin
+     * @return the index of the first texel of the palette in the texture
+     * @see BonePalette */
+    int getBonePaletteOffset();
+
     /**get root bone of the skin*/
     Bone3D* getRootBone() const;
 
@@ -108,6 +113,9 @@ protected:
     // Each 4x3 row-wise matrix is represented as 3 Vec4's.
     // The number of Vec4's is (_skinBones.size() * 3).
     std::vector<Vec4> _matrixPalette;
+
+    unsigned int _bonePaletteFrame = 0;
+    int _bonePaletteOffset         = -1;
 };
 
 // end of 3d group
@@ -34,6 +34,7 @@
 #include "3d/Mesh.h"
 #include "3d/Bundle3D.h"
 
+#include "base/Allocator.h"
 #include "base/Macros.h"
 #include "base/EventCustom.h"
 #include "base/EventListenerCustom.h"
@@ -61,6 +62,7 @@ MeshIndexData* MeshIndexData::create(std::string_view id,
     meshindex->_indexBuffer = indexbuffer;
     meshindex->_vertexData  = vertexData;
     indexbuffer->retain();
+    Memory::trackAllocation(MemoryTag::MESH, indexbuffer->getSize());
     meshindex->_aabb = aabb;
 
     meshindex->autorelease();
@@ -93,6 +95,8 @@ void MeshIndexData::setIndexData(const ax::MeshData::IndexArray& indexdata)
 
 MeshIndexData::~MeshIndexData()
 {
+    if (_indexBuffer)
+        Memory::trackDeallocation(MemoryTag::MESH, _indexBuffer->getSize());
     AX_SAFE_RELEASE(_indexBuffer);
     _indexData.clear();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -122,6 +126,7 @@ MeshVertexData* MeshVertexData::create(const MeshData& meshdata, CustomCommand::
 
     if (vertexdata->_vertexBuffer)
     {
+        Memory::trackAllocation(MemoryTag::MESH, vertexdata->_vertexBuffer->getSize());
 #if AX_ENABLE_CACHE_TEXTURE_DATA
         vertexdata->setVertexData(meshdata.vertex);
         vertexdata->_vertexBuffer->usingDefaultStoredData(false);
@@ -193,6 +198,8 @@ MeshVertexData::MeshVertexData()
 
 MeshVertexData::~MeshVertexData()
 {
+    if (_vertexBuffer)
+        Memory::trackDeallocation(MemoryTag::MESH, _vertexBuffer->getSize());
     AX_SAFE_RELEASE(_vertexBuffer);
     _indices.clear();
     _vertexData.clear();
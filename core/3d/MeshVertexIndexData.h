@@ -110,6 +110,7 @@ class AX_DLL MeshVertexData : public Object
 {
     friend class MeshRenderer;
     friend class Mesh;
+    friend class MeshBundle;
 
 public:
     /**create*/
@@ -46,11 +46,7 @@ MotionStreak3D::MotionStreak3D()
     , _positionR2D(0.f, 0.f)
     , _sweepAxis(0.f, 1.f, 0.f)
     , _stroke(0.0f)
-    , _fadeDelta(0.0f)
     , _minSeg(0.0f)
-    , _maxPoints(0)
-    , _nuPoints(0)
-    , _previousNuPoints(0)
 {}
 
 MotionStreak3D::~MotionStreak3D()
@@ -107,24 +103,17 @@ bool MotionStreak3D::initWithFade(float fade, float minSeg, float stroke, const
     _minSeg = (minSeg == -1.0f) ? stroke / 5.0f : minSeg;
     _minSeg *= _minSeg;
 
-    _stroke    = stroke;
-    _fadeDelta = 1.0f / fade;
+    _stroke = stroke;
 
-    _maxPoints = (int)(fade * 60.0f) + 2;
-    _nuPoints  = 0;
-
-    _pointState.resize(_maxPoints);
-    _pointVertexes.resize(_maxPoints);
-
-    _vertexData.resize(_maxPoints * 2);
+    _trail.init((unsigned int)(fade * 60.0f) + 2, fade);
 
     // Set blend mode
     _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
 
     // shader state
-    this->setProgramStateByProgramId(ProgramType::POSITION_TEXTURE_COLOR);
+    this->setProgramStateByProgramId(ProgramType::MOTION_STREAK);
 
-    _customCommand.getPipelineDescriptor().programState = _programState;
+    _trail.setProgramState(_programState);
 
     initCustomCommand();
 
@@ -137,20 +126,15 @@ bool MotionStreak3D::initWithFade(float fade, float minSeg, float stroke, const
 
 void MotionStreak3D::initCustomCommand()
 {
-    _customCommand.setDrawType(CustomCommand::DrawType::ARRAY);
-    _customCommand.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE_STRIP);
-
-    auto& pipelineDescriptor  = _customCommand.getPipelineDescriptor();
-
-    auto& blend                  = pipelineDescriptor.blendDescriptor;
-    blend.blendEnabled           = true;
-    blend.sourceAlphaBlendFactor = blend.sourceRGBBlendFactor = _blendFunc.src;
-    blend.destinationAlphaBlendFactor = blend.destinationRGBBlendFactor = _blendFunc.dst;
+    for (int i = 0; i < 2; ++i)
+    {
+        auto& blend = _trail.getCommand(i).getPipelineDescriptor().blendDescriptor;
+        blend.blendEnabled           = true;
+        blend.sourceAlphaBlendFactor = blend.sourceRGBBlendFactor = _blendFunc.src;
+        blend.destinationAlphaBlendFactor = blend.destinationRGBBlendFactor = _blendFunc.dst;
+    }
 
-    _locMVP     = _programState->getUniformLocation("u_MVPMatrix");
     _locTexture = _programState->getUniformLocation("u_tex0");
-
-    _customCommand.createVertexBuffer(sizeof(VertexData), _vertexData.size(), CustomCommand::BufferUsage::DYNAMIC);
 }
 
 void MotionStreak3D::setPosition(const Vec2& position)
@@ -234,13 +218,7 @@ void MotionStreak3D::setPositionY(float y)
 void MotionStreak3D::tintWithColor(const Color3B& colors)
 {
     setColor(colors);
-
-    // Fast assignation
-    for (unsigned int i = 0; i < _nuPoints * 2; i++)
-    {
-        auto& color = _vertexData[i].color;
-        color.set(colors.r, colors.g, colors.b, color.a);
-    }
+    _trail.setColor(colors);
 }
 
 Texture2D* MotionStreak3D::getTexture() const
@@ -294,133 +272,58 @@ void MotionStreak3D::update(float delta)
         return;
     }
 
-    delta *= _fadeDelta;
-
-    unsigned int newIdx, newIdx2, i, i2;
-    unsigned int mov = 0;
-
-    // Update current points
-    for (i = 0; i < _nuPoints; i++)
-    {
-        _pointState[i] -= delta;
-
-        if (_pointState[i] <= 0)
-            mov++;
-        else
-        {
-            newIdx = i - mov;
-
-            if (mov > 0)
-            {
-                // Move data
-                _pointState[newIdx] = _pointState[i];
-
-                // Move point
-                _pointVertexes[newIdx] = _pointVertexes[i];
-
-                // Move vertices
-                i2                           = i * 2;
-                newIdx2                      = newIdx * 2;
-                _vertexData[newIdx2].pos     = _vertexData[i2].pos;
-                _vertexData[newIdx2 + 1].pos = _vertexData[i2 + 1].pos;
-
-                // Move color
-                _vertexData[newIdx2].color     = _vertexData[i2].color;
-                _vertexData[newIdx2 + 1].color = _vertexData[i2 + 1].color;
-            }
-            else
-                newIdx2 = newIdx * 2;
-
-            const uint8_t op                 = (uint8_t)(_pointState[newIdx] * 255.0f);
-            _vertexData[newIdx2].color.a     = op;
-            _vertexData[newIdx2 + 1].color.a = op;
-        }
-    }
-    _nuPoints -= mov;
+    _trail.update(delta);
 
     // Append new point
-    bool appendNewPoint = true;
-    if (_nuPoints >= _maxPoints)
+    const auto count = _trail.getPointCount();
+    if (_trail.isFull())
     {
-        appendNewPoint = false;
+        return;
     }
 
-    else if (_nuPoints > 0)
+    if (count > 0)
     {
-        bool a1 = (_pointVertexes[_nuPoints - 1] - _positionR).lengthSquared() < _minSeg;
-        bool a2 = (_nuPoints == 1) ? false
-                                   : ((_pointVertexes[_nuPoints - 2] - _positionR).lengthSquared() < (_minSeg * 2.0f));
+        bool a1 = (_trail.getPoint(count - 1) - _positionR).lengthSquared() < _minSeg;
+        bool a2 = (count == 1) ? false : ((_trail.getPoint(count - 2) - _positionR).lengthSquared() < (_minSeg * 2.0f));
         if (a1 || a2)
         {
-            appendNewPoint = false;
-        }
-    }
-
-    if (appendNewPoint)
-    {
-        _pointVertexes[_nuPoints] = _positionR;
-        _pointState[_nuPoints]    = 1.0f;
-
-        // Color assignment
-        _vertexData[_nuPoints * 2].color     = Color4B(_displayedColor, 255);
-        _vertexData[_nuPoints * 2 + 1].color = Color4B(_displayedColor, 255);
-
-        // Generate polygon
-        {
-            float stroke                       = _stroke * 0.5f;
-            _vertexData[_nuPoints * 2].pos     = _pointVertexes[_nuPoints] + (_sweepAxis * stroke);
-            _vertexData[_nuPoints * 2 + 1].pos = _pointVertexes[_nuPoints] - (_sweepAxis * stroke);
+            return;
         }
-
-        _nuPoints++;
     }
 
-    // Updated Tex Coords only if they are different than previous step
-    if (_nuPoints && _previousNuPoints != _nuPoints)
-    {
-        float texDelta = 1.0f / _nuPoints;
-        for (i = 0; i < _nuPoints; i++)
-        {
-            _vertexData[i * 2].texPos     = Tex2F(0, texDelta * i);
-            _vertexData[i * 2 + 1].texPos = Tex2F(1, texDelta * i);
-        }
-
-        _previousNuPoints = _nuPoints;
-    }
+    // the strip spans the sweep axis, the shader scales it by the stroke
+    _trail.append(_positionR, _sweepAxis, Color4B(_displayedColor, 255));
 }
 
 void MotionStreak3D::reset()
 {
-    _nuPoints = 0;
+    _trail.reset();
 }
 
 void MotionStreak3D::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    if (_nuPoints <= 1)
+    auto pmatrix           = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    const int commandCount = _trail.prepareCommands(pmatrix * transform, _stroke);
+    if (commandCount == 0)
         return;
+
     auto beforeCommand = renderer->nextCallbackCommand();
     auto afterCommand = renderer->nextCallbackCommand();
 
     beforeCommand->init(_globalZOrder);
     afterCommand->init(_globalZOrder);
-    _customCommand.init(_globalZOrder, transform, flags);
-
-    auto pmatrix   = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
-    auto mvpMatrix = pmatrix * transform;
-
-    _programState->setUniform(_locMVP, mvpMatrix.m, sizeof(mvpMatrix.m));
 
     beforeCommand->func = AX_CALLBACK_0(MotionStreak3D::onBeforeDraw, this);
     afterCommand->func  = AX_CALLBACK_0(MotionStreak3D::onAfterDraw, this);
 
-    _customCommand.updateVertexBuffer(_vertexData.data(), sizeof(_vertexData[0]) * _nuPoints * 2);
-
-    _customCommand.setVertexDrawInfo(0, _nuPoints * 2);
-
     renderer->addCommand(beforeCommand);
-    renderer->addCommand(&_customCommand);
+    for (int i = 0; i < commandCount; ++i)
+    {
+        auto& command = _trail.getCommand(i);
+        command.init(_globalZOrder, transform, flags);
+        renderer->addCommand(&command);
+    }
     renderer->addCommand(afterCommand);
-    AX_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, _nuPoints * 2);
 }
 
 void MotionStreak3D::onBeforeDraw()
@@ -27,11 +27,9 @@ THE SOFTWARE.
 
 #include "base/Protocols.h"
 #include "2d/Node.h"
-#include "renderer/CustomCommand.h"
+#include "renderer/TrailBuffer.h"
 #include "renderer/CallbackCommand.h"
 
-#include <vector>
-
 namespace ax
 {
 
@@ -44,6 +42,8 @@ class Texture2D;
 
 /** @class MotionStreak3D.
  * @brief Creates a trailing path. It is created from a line segment sweeping along the path.
+ *
+ * The points are kept in a TrailBuffer, see MotionStreak.
  */
 class AX_DLL MotionStreak3D : public Node, public TextureProtocol
 {
@@ -171,13 +171,6 @@ protected:
 
     void initCustomCommand();
 
-    struct VertexData
-    {
-        Vec3 pos;
-        Color4B color;
-        Tex2F texPos;
-    };
-
     bool _startingPositionInitialized;
 
     /** texture used for the motion streak */
@@ -188,27 +181,15 @@ protected:
     Vec3 _sweepAxis;
 
     float _stroke;
-    float _fadeDelta;
     float _minSeg;
 
-    unsigned int _maxPoints;
-    unsigned int _nuPoints;
-    unsigned int _previousNuPoints;
-
-    /** Pointers */
-    std::vector<Vec3> _pointVertexes;
-    std::vector<float> _pointState;
-
-    std::vector<VertexData> _vertexData;
-
-    CustomCommand _customCommand;
+    TrailBuffer _trail;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(MotionStreak3D);
 
     //CallbackCommand _beforeCommand;
     //CallbackCommand _afterCommand;
-    backend::UniformLocation _locMVP;
     backend::UniformLocation _locTexture;
 
     void onBeforeDraw();
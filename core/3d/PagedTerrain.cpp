@@ -0,0 +1,646 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/PagedTerrain.h"
+#include "2d/Camera.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
+#include "base/JobSystem.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/Renderer.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+// the result of a page load, written by the worker thread
+struct PagedTerrain::LoadTask
+{
+    int _index = 0;
+    std::string _fullPath;
+    std::vector<uint8_t> _heights;
+    uint8_t _minHeight = 0;
+    uint8_t _maxHeight = 0;
+    bool _result       = false;
+};
+
+PagedTerrain::PagedTerrainData::PagedTerrainData()
+    : _pagesX(0)
+    , _pagesY(0)
+    , _pageSize(0)
+    , _textureSize(32)
+    , _mapHeight(2)
+    , _mapScale(0.1f)
+    , _skirtHeightRatio(1)
+{}
+
+PagedTerrain::PagedTerrainData::PagedTerrainData(std::string_view pagePattern,
+                                                 int pagesX,
+                                                 int pagesY,
+                                                 int pageSize,
+                                                 std::string_view textureSrc,
+                                                 float textureSize,
+                                                 float mapHeight,
+                                                 float mapScale)
+    : _pagePattern(pagePattern)
+    , _pagesX(pagesX)
+    , _pagesY(pagesY)
+    , _pageSize(pageSize)
+    , _textureSrc(textureSrc)
+    , _textureSize(textureSize)
+    , _mapHeight(mapHeight)
+    , _mapScale(mapScale)
+    , _skirtHeightRatio(1)
+{}
+
+PagedTerrain* PagedTerrain::create(const PagedTerrainData& data)
+{
+    auto terrain = new PagedTerrain();
+    if (terrain->initWithTerrainData(data))
+    {
+        terrain->autorelease();
+        return terrain;
+    }
+    AX_SAFE_DELETE(terrain);
+    return nullptr;
+}
+
+bool PagedTerrain::isSupported()
+{
+#if defined(AX_GLES_PROFILE) && AX_GLES_PROFILE == 200
+    // no vertex texture fetch in ES 2.0
+    return false;
+#else
+    return true;
+#endif
+}
+
+bool PagedTerrain::splitHeightMap(std::string_view heightMap,
+                                  std::string_view pagePattern,
+                                  int pageSize,
+                                  int* pagesX,
+                                  int* pagesY)
+{
+    AXASSERT(pageSize > 0 && (pageSize & (pageSize - 1)) == 0, "the page size must be a power of two");
+
+    Image image;
+    if (!image.initWithImageFile(heightMap) || image.isCompressed())
+        return false;
+
+    const int width  = image.getWidth();
+    const int height = image.getHeight();
+    const int stride = (std::max)(image.getBitPerPixel() / 8, 1);
+    const int columns = (std::max)((width - 2) / pageSize + 1, 1);
+    const int rows    = (std::max)((height - 2) / pageSize + 1, 1);
+    const int side    = pageSize + 1;
+    auto data         = image.getData();
+
+    std::vector<uint8_t> pixels(side * side * 4);
+    for (int py = 0; py < rows; ++py)
+    {
+        for (int px = 0; px < columns; ++px)
+        {
+            for (int y = 0; y < side; ++y)
+            {
+                int sy = (std::min)(py * pageSize + y, height - 1);
+                for (int x = 0; x < side; ++x)
+                {
+                    int sx     = (std::min)(px * pageSize + x, width - 1);
+                    auto value = data[(sy * width + sx) * stride];
+                    auto pixel = &pixels[(y * side + x) * 4];
+                    pixel[0] = pixel[1] = pixel[2] = value;
+                    pixel[3]                       = 255;
+                }
+            }
+
+            Image page;
+            page.initWithRawData(pixels.data(), pixels.size(), side, side, 8);
+            if (!page.saveToFile(fmt::format(fmt::runtime(pagePattern), px, py)))
+                return false;
+        }
+    }
+
+    if (pagesX)
+        *pagesX = columns;
+    if (pagesY)
+        *pagesY = rows;
+    return true;
+}
+
+PagedTerrain::PagedTerrain() : _lightDir(-1, -1, 0)
+{
+    _lightDir.normalize();
+}
+
+PagedTerrain::~PagedTerrain()
+{
+    if (_rendererRecreatedListener)
+        _eventDispatcher->removeEventListener(_rendererRecreatedListener);
+
+    // the pending loads retain the terrain, none is left here
+    releasePages();
+    releaseGrids();
+    AX_SAFE_RELEASE(_texture);
+}
+
+bool PagedTerrain::initWithTerrainData(const PagedTerrainData& data)
+{
+    AXASSERT(data._pageSize > 0 && (data._pageSize & (data._pageSize - 1)) == 0,
+             "the page size must be a power of two");
+    AXASSERT(data._pageSize >= (1 << (MAX_LOD - 1)), "the page size is too small for the levels of detail");
+
+    if (!isSupported() || data._pagesX <= 0 || data._pagesY <= 0)
+        return false;
+
+    _terrainData = data;
+    _pages.resize(data._pagesX * data._pagesY, nullptr);
+
+    float pageWorldSize = data._pageSize * data._mapScale;
+    setLODDistance(pageWorldSize * 1.5f, pageWorldSize * 2.5f, pageWorldSize * 3.5f);
+
+    auto image = new Image();
+    if (image->initWithImageFile(data._textureSrc))
+    {
+        _texture = new Texture2D();
+        _texture->initWithImage(image);
+        _texture->generateMipmap();
+        Texture2D::TexParams texParam;
+        texParam.sAddressMode = backend::SamplerAddressMode::REPEAT;
+        texParam.tAddressMode = backend::SamplerAddressMode::REPEAT;
+        texParam.minFilter    = backend::SamplerFilter::LINEAR;
+        texParam.magFilter    = backend::SamplerFilter::LINEAR;
+        _texture->setTexParameters(texParam);
+    }
+    delete image;
+    if (!_texture)
+        return false;
+
+    setProgramStateByProgramId(backend::ProgramType::TERRAIN_3D_PAGED);
+    setAnchorPoint(Vec2(0, 0));
+
+    // the pages are reloaded, the grids recreated on the next draw
+    _rendererRecreatedListener =
+        _eventDispatcher->addCustomEventListener(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        for (int i = 0, count = static_cast<int>(_pages.size()); i < count; ++i)
+        {
+            if (_pages[i] && _pages[i]->_state == Page::State::LOADED)
+                releasePage(i);
+        }
+        releaseGrids();
+    });
+    return true;
+}
+
+void PagedTerrain::setLODDistance(float lod1, float lod2, float lod3)
+{
+    _lodDistance[0] = lod1;
+    _lodDistance[1] = lod2;
+    _lodDistance[2] = lod3;
+}
+
+void PagedTerrain::setLightDir(const Vec3& lightDir)
+{
+    _lightDir = lightDir;
+    for (auto page : _pages)
+    {
+        if (page && page->_programState)
+            page->_programState->setUniform(page->_programState->getUniformLocation("u_lightDir"), &_lightDir,
+                                           sizeof(_lightDir));
+    }
+}
+
+float PagedTerrain::getHeight(float x, float z) const
+{
+    Vec3 local(x, 0, z);
+    getWorldToNodeTransform().transformPoint(&local);
+
+    const int pageSize = _terrainData._pageSize;
+    float sx           = local.x / _terrainData._mapScale + _terrainData._pagesX * pageSize / 2.0f;
+    float sz           = local.z / _terrainData._mapScale + _terrainData._pagesY * pageSize / 2.0f;
+    if (sx < 0 || sz < 0 || sx >= _terrainData._pagesX * pageSize || sz >= _terrainData._pagesY * pageSize)
+        return 0;
+
+    int px    = static_cast<int>(sx) / pageSize;
+    int py    = static_cast<int>(sz) / pageSize;
+    auto page = _pages[py * _terrainData._pagesX + px];
+    if (!page || page->_state != Page::State::LOADED)
+        return 0;
+
+    // the page holds one more sample on each side, the bilinear filter never leaves it
+    float fx = sx - px * pageSize, fz = sz - py * pageSize;
+    int i = static_cast<int>(fx), j = static_cast<int>(fz);
+    float u = fx - i, v = fz - j;
+    const int side = pageSize + 1;
+    auto sample    = [&](int a, int b) {
+        return page->_heights[b * side + a] / 255.0f * _terrainData._mapHeight - 0.5f * _terrainData._mapHeight;
+    };
+    float h = (1 - u) * (1 - v) * sample(i, j) + u * (1 - v) * sample(i + 1, j) + (1 - u) * v * sample(i, j + 1) +
+              u * v * sample(i + 1, j + 1);
+
+    local.y = h;
+    getNodeToWorldTransform().transformPoint(&local);
+    return local.y;
+}
+
+bool PagedTerrain::isPageLoaded(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= _terrainData._pagesX || y >= _terrainData._pagesY)
+        return false;
+    auto page = _pages[y * _terrainData._pagesX + x];
+    return page && page->_state == Page::State::LOADED;
+}
+
+int PagedTerrain::getLoadedPageCount() const
+{
+    return static_cast<int>(std::count_if(_pages.begin(), _pages.end(), [](const Page* page) {
+        return page && page->_state == Page::State::LOADED;
+    }));
+}
+
+size_t PagedTerrain::getResidentBytes() const
+{
+    const size_t side = _terrainData._pageSize + 1;
+    return getLoadedPageCount() * side * side * 2;
+}
+
+void PagedTerrain::updateResidency(const Vec3& cameraPos)
+{
+    const int pageSize = _terrainData._pageSize;
+    const float pageWorldSize = pageSize * _terrainData._mapScale;
+    const int cx = static_cast<int>(std::floor(cameraPos.x / pageWorldSize + _terrainData._pagesX / 2.0f));
+    const int cy = static_cast<int>(std::floor(cameraPos.z / pageWorldSize + _terrainData._pagesY / 2.0f));
+
+    // release first, a page moving out of the radius frees its memory before new ones are requested
+    for (int y = 0; y < _terrainData._pagesY; ++y)
+    {
+        for (int x = 0; x < _terrainData._pagesX; ++x)
+        {
+            int index = y * _terrainData._pagesX + x;
+            auto page = _pages[index];
+            if (page && page->_state != Page::State::LOADING &&
+                (std::max)(std::abs(x - cx), std::abs(y - cy)) > _loadRadius + 1)
+                releasePage(index);
+        }
+    }
+
+    // request the nearest pages first
+    for (int ring = 0; ring <= _loadRadius && _pendingLoads < _maxPendingLoads; ++ring)
+    {
+        for (int y = cy - ring; y <= cy + ring; ++y)
+        {
+            for (int x = cx - ring; x <= cx + ring; ++x)
+            {
+                if ((std::max)(std::abs(x - cx), std::abs(y - cy)) != ring || x < 0 || y < 0 ||
+                    x >= _terrainData._pagesX || y >= _terrainData._pagesY)
+                    continue;
+                if (_pendingLoads >= _maxPendingLoads)
+                    return;
+                if (!_pages[y * _terrainData._pagesX + x])
+                    requestPage(x, y);
+            }
+        }
+    }
+}
+
+void PagedTerrain::requestPage(int x, int y)
+{
+    int index     = y * _terrainData._pagesX + x;
+    auto page     = new Page();
+    page->_x      = x;
+    page->_y      = y;
+    _pages[index] = page;
+    ++_pendingLoads;
+
+    // resolved here, FileUtils isn't thread safe for relative paths
+    auto task       = std::make_shared<LoadTask>();
+    task->_index    = index;
+    task->_fullPath =
+        FileUtils::getInstance()->fullPathForFilename(fmt::format(fmt::runtime(_terrainData._pagePattern), x, y));
+    const int side  = _terrainData._pageSize + 1;
+
+    retain();
+    _director->getJobSystem()->enqueue(
+        [task, side] {
+        Image image;
+        if (task->_fullPath.empty() || !image.initWithImageFile(task->_fullPath) || image.isCompressed() ||
+            image.getWidth() < side || image.getHeight() < side)
+            return;
+
+        // keep the first channel, in the layout of the texture
+        const int stride = (std::max)(image.getBitPerPixel() / 8, 1);
+        const int width  = image.getWidth();
+        auto data        = image.getData();
+        task->_heights.resize(side * side);
+        for (int j = 0; j < side; ++j)
+        {
+            for (int i = 0; i < side; ++i)
+                task->_heights[j * side + i] = data[(j * width + i) * stride];
+        }
+        auto range        = std::minmax_element(task->_heights.begin(), task->_heights.end());
+        task->_minHeight  = *range.first;
+        task->_maxHeight  = *range.second;
+        task->_result     = true;
+    },
+        [this, task] {
+        --_pendingLoads;
+        finishPage(*task);
+        release();
+    });
+}
+
+void PagedTerrain::finishPage(LoadTask& task)
+{
+    auto page = _pages[task._index];
+    AXASSERT(page && page->_state == Page::State::LOADING, "the loading pages are never released");
+    if (!task._result)
+    {
+        AXLOGW("PagedTerrain: failed to load page {}", task._fullPath);
+        page->_state = Page::State::FAILED;
+        return;
+    }
+
+    const int side  = _terrainData._pageSize + 1;
+    page->_heights  = std::move(task._heights);
+    page->_heightMap = new Texture2D();
+    page->_heightMap->initWithData(page->_heights.data(), page->_heights.size(), backend::PixelFormat::R8, side, side);
+    Texture2D::TexParams texParam;
+    texParam.sAddressMode = backend::SamplerAddressMode::CLAMP_TO_EDGE;
+    texParam.tAddressMode = backend::SamplerAddressMode::CLAMP_TO_EDGE;
+    texParam.minFilter    = backend::SamplerFilter::NEAREST;
+    texParam.magFilter    = backend::SamplerFilter::NEAREST;
+    page->_heightMap->setTexParameters(texParam);
+
+    auto height   = [this](uint8_t value) {
+        return value / 255.0f * _terrainData._mapHeight - 0.5f * _terrainData._mapHeight;
+    };
+    const int pageSize = _terrainData._pageSize;
+    const float scale  = _terrainData._mapScale;
+    const float x0     = (page->_x * pageSize - _terrainData._pagesX * pageSize / 2.0f) * scale;
+    const float z0     = (page->_y * pageSize - _terrainData._pagesY * pageSize / 2.0f) * scale;
+    const float skirt  = _terrainData._mapHeight * _terrainData._skirtHeightRatio;
+    page->_aabb.set(Vec3(x0, height(task._minHeight) - skirt, z0),
+                    Vec3(x0 + pageSize * scale, height(task._maxHeight), z0 + pageSize * scale));
+
+    initPageState(page);
+    page->_state = Page::State::LOADED;
+}
+
+void PagedTerrain::initPageState(Page* page)
+{
+    auto ps             = _programState->clone();
+    page->_programState = ps;
+
+    float pageOrigin[4] = {
+        static_cast<float>(page->_x * _terrainData._pageSize), static_cast<float>(page->_y * _terrainData._pageSize),
+        _terrainData._pagesX * _terrainData._pageSize / 2.0f, _terrainData._pagesY * _terrainData._pageSize / 2.0f};
+    float mapParams[4] = {_terrainData._mapScale, _terrainData._mapHeight,
+                          _terrainData._mapHeight * _terrainData._skirtHeightRatio, 1.0f / _terrainData._textureSize};
+    ps->setUniform(ps->getUniformLocation("u_pageOrigin"), pageOrigin, sizeof(pageOrigin));
+    ps->setUniform(ps->getUniformLocation("u_mapParams"), mapParams, sizeof(mapParams));
+    ps->setTexture(ps->getUniformLocation("u_heightMap"), 6, page->_heightMap->getBackendTexture());
+
+    int zero = 0;
+    ps->setUniform(ps->getUniformLocation("u_has_alpha"), &zero, sizeof(zero));
+    ps->setUniform(ps->getUniformLocation("u_has_light_map"), &zero, sizeof(zero));
+    ps->setUniform(ps->getUniformLocation("u_lightDir"), &_lightDir, sizeof(_lightDir));
+    ps->setTexture(ps->getUniformLocation("u_tex0"), 0, _texture->getBackendTexture());
+#ifdef AX_USE_METAL
+    ps->setTexture(ps->getUniformLocation("u_lightMap"), 5, _texture->getBackendTexture());
+#endif
+
+    auto& command = page->_command;
+    command.init(_globalZOrder);
+    command.setTransparent(false);
+    command.set3D(true);
+    command.setPrimitiveType(MeshCommand::PrimitiveType::TRIANGLE);
+    command.setDrawType(MeshCommand::DrawType::ELEMENT);
+    command.setBeforeCallback(AX_CALLBACK_0(PagedTerrain::onBeforeDraw, this));
+    command.setAfterCallback(AX_CALLBACK_0(PagedTerrain::onAfterDraw, this));
+    command.getPipelineDescriptor().programState                    = ps;
+    command.getPipelineDescriptor().blendDescriptor.blendEnabled = false;
+}
+
+void PagedTerrain::releasePage(int index)
+{
+    auto page = _pages[index];
+    AX_SAFE_RELEASE(page->_heightMap);
+    AX_SAFE_RELEASE(page->_programState);
+    delete page;
+    _pages[index] = nullptr;
+}
+
+void PagedTerrain::releasePages()
+{
+    for (int i = 0, count = static_cast<int>(_pages.size()); i < count; ++i)
+    {
+        if (_pages[i])
+            releasePage(i);
+    }
+}
+
+void PagedTerrain::createGrids()
+{
+    const int pageSize = _terrainData._pageSize;
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    for (int lod = 0; lod < MAX_LOD; ++lod)
+    {
+        const int step = 1 << lod;
+        const int n    = pageSize / step;
+        const int side = n + 1;
+        vertices.clear();
+        indices.clear();
+
+        for (int r = 0; r <= n; ++r)
+        {
+            for (int c = 0; c <= n; ++c)
+                vertices.emplace_back(static_cast<float>(c * step), static_cast<float>(r * step), 0.0f);
+        }
+        // same winding as Terrain
+        for (int r = 0; r < n; ++r)
+        {
+            for (int c = 0; c < n; ++c)
+            {
+                uint32_t index = r * side + c;
+                indices.insert(indices.end(),
+                               {index, index + side, index + 1, index + 1, index + side, index + side + 1});
+            }
+        }
+
+        // skirts along the border, hiding the cracks between levels, drawn from both sides
+        auto addSkirt = [&](auto&& gridIndex) {
+            auto first = static_cast<uint32_t>(vertices.size());
+            for (int k = 0; k <= n; ++k)
+            {
+                auto v = vertices[gridIndex(k)];
+                vertices.emplace_back(v.x, v.y, 1.0f);
+            }
+            for (int k = 0; k < n; ++k)
+            {
+                uint32_t a = gridIndex(k), b = gridIndex(k + 1), sa = first + k, sb = first + k + 1;
+                indices.insert(indices.end(), {a, b, sa, b, sb, sa, a, sa, b, b, sa, sb});
+            }
+        };
+        addSkirt([&](int k) { return static_cast<uint32_t>(k); });
+        addSkirt([&](int k) { return static_cast<uint32_t>(n * side + k); });
+        addSkirt([&](int k) { return static_cast<uint32_t>(k * side); });
+        addSkirt([&](int k) { return static_cast<uint32_t>(k * side + n); });
+
+        auto driver             = backend::DriverBase::getInstance();
+        auto& grid              = _grids[lod];
+        grid._vertexBuffer      = driver->newBuffer(vertices.size() * sizeof(Vec3), backend::BufferType::VERTEX,
+                                                    backend::BufferUsage::STATIC);
+        grid._vertexBuffer->updateData(vertices.data(), vertices.size() * sizeof(Vec3));
+        grid._indexCount = static_cast<unsigned int>(indices.size());
+        if (vertices.size() <= 65536)
+        {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            grid._indexFormat = backend::IndexFormat::U_SHORT;
+            grid._indexBuffer = driver->newBuffer(shortIndices.size() * sizeof(uint16_t), backend::BufferType::INDEX,
+                                                  backend::BufferUsage::STATIC);
+            grid._indexBuffer->updateData(shortIndices.data(), shortIndices.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            grid._indexFormat = backend::IndexFormat::U_INT;
+            grid._indexBuffer = driver->newBuffer(indices.size() * sizeof(uint32_t), backend::BufferType::INDEX,
+                                                  backend::BufferUsage::STATIC);
+            grid._indexBuffer->updateData(indices.data(), indices.size() * sizeof(uint32_t));
+        }
+    }
+}
+
+void PagedTerrain::releaseGrids()
+{
+    for (auto&& grid : _grids)
+    {
+        AX_SAFE_RELEASE_NULL(grid._vertexBuffer);
+        AX_SAFE_RELEASE_NULL(grid._indexBuffer);
+        grid._indexCount = 0;
+    }
+}
+
+void PagedTerrain::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    auto camera = Camera::getVisitingCamera();
+    if (!camera)
+        return;
+
+    auto modelMatrix = getNodeToWorldTransform();
+    Vec3 cameraPos;
+    camera->getNodeToWorldTransform().getTranslation(&cameraPos);
+    getWorldToNodeTransform().transformPoint(&cameraPos);
+
+    // the pages are streamed around the first camera drawing the terrain in a frame
+    auto frame = _director->getTotalFrames();
+    if (frame != _frame)
+    {
+        _frame = frame;
+        updateResidency(cameraPos);
+    }
+
+    if (!_grids[0]._vertexBuffer)
+        createGrids();
+
+    auto& projectionMatrix = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    auto finalMatrix       = projectionMatrix * transform;
+
+    // the loaded pages are culled at once, in the order of _pages
+    if (_isEnableFrustumCull)
+    {
+        _pageBounds.clear();
+        for (auto page : _pages)
+        {
+            if (!page || page->_state != Page::State::LOADED)
+                continue;
+            AABB aabb = page->_aabb;
+            aabb.transform(modelMatrix);
+            _pageBounds.add(aabb);
+        }
+        camera->cullInFrustum(_pageBounds, _pageVisibility);
+    }
+
+    size_t loadedIndex = 0;
+    for (auto page : _pages)
+    {
+        if (!page || page->_state != Page::State::LOADED)
+            continue;
+
+        if (_isEnableFrustumCull && !BoundsBatch::isVisible(_pageVisibility, loadedIndex++))
+            continue;
+
+        float distance = page->_aabb.getCenter().distance(cameraPos);
+        int lod        = 0;
+        while (lod < MAX_LOD - 1 && distance > _lodDistance[lod])
+            ++lod;
+
+        auto& grid = _grids[lod];
+        auto ps    = page->_programState;
+        ps->setUniform(ps->getUniformLocation("u_MVPMatrix"), &finalMatrix.m, sizeof(finalMatrix.m));
+
+        auto& command = page->_command;
+        command.setVertexBuffer(grid._vertexBuffer);
+        command.setIndexBuffer(grid._indexBuffer, grid._indexFormat);
+        command.setIndexDrawInfo(0, grid._indexCount);
+        renderer->addCommand(&command);
+        AX_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, grid._indexCount);
+    }
+}
+
+void PagedTerrain::onBeforeDraw()
+{
+    _stateBlockOld.save();
+    _stateBlock.apply();
+}
+
+void PagedTerrain::onAfterDraw()
+{
+    _stateBlockOld.apply();
+}
+
+void PagedTerrain::StateBlock::save()
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    depthWrite    = renderer->getDepthWrite();
+    depthTest     = renderer->getDepthTest();
+    cullFace      = renderer->getCullMode();
+    winding       = renderer->getWinding();
+}
+
+void PagedTerrain::StateBlock::apply()
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setDepthTest(depthTest);
+    renderer->setDepthWrite(depthWrite);
+    renderer->setCullMode(cullFace);
+    renderer->setWinding(winding);
+}
+
+}  // namespace ax
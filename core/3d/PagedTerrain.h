@@ -0,0 +1,263 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "2d/Node.h"
+#include "renderer/MeshCommand.h"
+#include "renderer/backend/Types.h"
+#include "3d/AABB.h"
+#include "3d/Frustum.h"
+
+namespace ax
+{
+
+class Texture2D;
+class EventListenerCustom;
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * PagedTerrain
+ * Renders height maps too large to be kept in memory, such as 8k x 8k maps on mobile devices.
+ *
+ * The height map is split into square pages, each one an image file, see splitHeightMap. Only the pages around
+ * the camera are resident: they are decoded on the job system threads and uploaded as single channel textures,
+ * the pages moving out of the load radius are released. No vertex data is generated per page, all pages draw
+ * one shared grid mesh per level of detail and the vertex shader reads the heights from the page texture and
+ * computes the normals from the neighbouring heights. The levels of detail of neighbouring pages are joined by
+ * skirts.
+ *
+ * The heights use the conventions of Terrain, a sample is _mapScale apart from its neighbours and its height
+ * ranges from -_mapHeight / 2 to _mapHeight / 2, the terrain is centered on its position. The surface is one
+ * texture repeated over the terrain. The vertex texture fetch isn't available on OpenGL ES 2.0, see isSupported.
+ */
+class AX_DLL PagedTerrain : public Node
+{
+public:
+    /** the maximum amount of the levels of detail */
+    static const int MAX_LOD = 4;
+
+    /**
+     * PagedTerrainData
+     * The parameters of a PagedTerrain.
+     */
+    struct AX_DLL PagedTerrainData
+    {
+        /**empty constructor*/
+        PagedTerrainData();
+        /**
+         * @param pagePattern the path of the page images, formatted with the page column and row, e.g.
+         * "terrain/height_{}_{}.png"
+         * @param pagesX the page columns
+         * @param pagesY the page rows
+         * @param pageSize the samples per page side, a power of two
+         * @param textureSrc the surface texture
+         */
+        PagedTerrainData(std::string_view pagePattern,
+                         int pagesX,
+                         int pagesY,
+                         int pageSize,
+                         std::string_view textureSrc,
+                         float textureSize = 32,
+                         float mapHeight   = 2,
+                         float mapScale    = 0.1);
+        /**the page image path pattern*/
+        std::string _pagePattern;
+        /**the page columns and rows*/
+        int _pagesX;
+        int _pagesY;
+        /**the samples per page side, a page image is _pageSize + 1 pixels wide, its last column and row are the
+         * first ones of the next page*/
+        int _pageSize;
+        /**the surface texture source path*/
+        std::string _textureSrc;
+        /**the samples covered by one repeat of the surface texture*/
+        float _textureSize;
+        /**terrain Maximum height*/
+        float _mapHeight;
+        /**terrain scale factor,you can combine setScale later.*/
+        float _mapScale;
+        /**the skirt height ratio, of _mapHeight*/
+        float _skirtHeightRatio;
+    };
+
+    /**create entry*/
+    static PagedTerrain* create(const PagedTerrainData& data);
+
+    /** Whether the paged terrain can be rendered by the current backend. */
+    static bool isSupported();
+
+    /**
+     * Split a height map into page images, the pages on the right and bottom borders are padded with the last
+     * sample. Intended for tools and tests, the whole height map is decoded at once.
+     *
+     * @param heightMap the source height map
+     * @param pagePattern the full path of the page images, formatted with the page column and row
+     * @param pageSize the samples per page side, a power of two
+     * @param pagesX receives the page columns, optional
+     * @param pagesY receives the page rows, optional
+     */
+    static bool splitHeightMap(std::string_view heightMap,
+                               std::string_view pagePattern,
+                               int pageSize,
+                               int* pagesX = nullptr,
+                               int* pagesY = nullptr);
+
+    /**
+     * Set the radius in pages around the camera of the resident pages, the pages further than radius + 1 are
+     * released. The default is 2.
+     */
+    void setLoadRadius(int pages) { _loadRadius = pages; }
+    int getLoadRadius() const { return _loadRadius; }
+
+    /** Set the maximum amount of pages loading at the same time, the default is 4. */
+    void setMaxPendingLoads(int count) { _maxPendingLoads = count; }
+    int getPendingLoadCount() const { return _pendingLoads; }
+
+    /**
+     * Set threshold distance of each LOD level, the distance is measured from the camera to the page center.
+     * The defaults are 1.5, 2.5 and 3.5 page sizes.
+     */
+    void setLODDistance(float lod1, float lod2, float lod3);
+
+    /**
+     set directional light for the terrain
+     @param lightDir The direction of directional light, in the terrain's local space.
+     */
+    void setLightDir(const Vec3& lightDir);
+
+    /**Switch frustum Culling Flag*/
+    void setIsEnableFrustumCull(bool boolValue) { _isEnableFrustumCull = boolValue; }
+
+    /**get specified world position's height mapping to the terrain, use bi-linear interpolation method
+     * @return the height of the position, 0 if it's out of the terrain or its page isn't resident
+     */
+    float getHeight(float x, float z) const;
+
+    /** Whether the page at the column and row is resident. */
+    bool isPageLoaded(int x, int y) const;
+
+    int getLoadedPageCount() const;
+
+    /** The bytes of the resident heights, each page is kept once on the CPU for getHeight and once on the GPU. */
+    size_t getResidentBytes() const;
+
+    /** get the terrain's size in samples */
+    Vec2 getTerrainSize() const
+    {
+        return Vec2(static_cast<float>(_terrainData._pagesX * _terrainData._pageSize),
+                    static_cast<float>(_terrainData._pagesY * _terrainData._pageSize));
+    }
+
+    // Overrides, internal use only
+    virtual void draw(Renderer* renderer, const Mat4& transform, uint32_t flags) override;
+
+    PagedTerrain();
+    virtual ~PagedTerrain();
+    bool initWithTerrainData(const PagedTerrainData& data);
+
+protected:
+    struct LoadTask;
+
+    struct Page
+    {
+        enum class State
+        {
+            LOADING,
+            LOADED,
+            /**not requested again until it leaves the load radius*/
+            FAILED,
+        };
+        State _state = State::LOADING;
+        int _x       = 0;
+        int _y       = 0;
+        /**the heights of the samples, for getHeight*/
+        std::vector<uint8_t> _heights;
+        Texture2D* _heightMap              = nullptr;
+        backend::ProgramState* _programState = nullptr;
+        /**AABB in local space*/
+        AABB _aabb;
+        MeshCommand _command;
+    };
+
+    /**the shared grid of a level of detail, positions in samples, z is 1 for the skirt vertices*/
+    struct Grid
+    {
+        backend::Buffer* _vertexBuffer   = nullptr;
+        backend::Buffer* _indexBuffer    = nullptr;
+        backend::IndexFormat _indexFormat = backend::IndexFormat::U_SHORT;
+        unsigned int _indexCount         = 0;
+    };
+
+    /** load the pages in the load radius of the camera, release the ones out of it */
+    void updateResidency(const Vec3& cameraPos);
+    void requestPage(int x, int y);
+    void finishPage(LoadTask& task);
+    void releasePage(int index);
+    void releasePages();
+    void createGrids();
+    void releaseGrids();
+    void initPageState(Page* page);
+
+    void onBeforeDraw();
+    void onAfterDraw();
+
+    PagedTerrainData _terrainData;
+    std::vector<Page*> _pages;
+    Grid _grids[MAX_LOD];
+    int _loadRadius      = 2;
+    int _maxPendingLoads = 4;
+    int _pendingLoads    = 0;
+    float _lodDistance[MAX_LOD - 1];
+    Vec3 _lightDir;
+    bool _isEnableFrustumCull = true;
+    BoundsBatch _pageBounds;
+    std::vector<uint32_t> _pageVisibility;
+    Texture2D* _texture       = nullptr;
+    unsigned int _frame       = 0;
+    EventListenerCustom* _rendererRecreatedListener = nullptr;
+
+    struct StateBlock
+    {
+        bool depthWrite            = true;
+        bool depthTest             = true;
+        backend::CullMode cullFace = backend::CullMode::FRONT;
+        backend::Winding winding   = backend::Winding::CLOCK_WISE;
+        void apply();
+        void save();
+    };
+    StateBlock _stateBlock;
+    StateBlock _stateBlockOld;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/ShadowCascades.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ax
+{
+
+void ShadowCascades::computeSplits(int count, float nearPlane, float farPlane, float lambda, float* splits)
+{
+    // the logarithmic splits need a positive near plane, orthographic cameras may have none
+    if (nearPlane <= 0.0f)
+        lambda = 0.0f;
+
+    for (int i = 1; i <= count; ++i)
+    {
+        float p       = float(i) / count;
+        float log     = lambda > 0.0f ? nearPlane * std::pow(farPlane / nearPlane, p) : 0.0f;
+        float uniform = nearPlane + (farPlane - nearPlane) * p;
+        splits[i - 1] = lambda * log + (1.0f - lambda) * uniform;
+    }
+    splits[count - 1] = farPlane;
+}
+
+void ShadowCascades::setCascadeCount(int count)
+{
+    AXASSERT(count > 0 && count <= MAX_CASCADES, "Invalid cascade count");
+    _cascadeCount = std::clamp(count, 1, MAX_CASCADES);
+}
+
+void ShadowCascades::update(const Mat4& view,
+                            const Mat4& projection,
+                            float nearPlane,
+                            float farPlane,
+                            const Vec3& lightDirection)
+{
+    AXASSERT(farPlane > nearPlane, "Invalid shadow distance");
+    computeSplits(_cascadeCount, nearPlane, farPlane, _lambda, _splits);
+
+    const Mat4 inverseProjection = projection.getInversed();
+    auto toView                  = [&](float x, float y, float depth) {
+        float z = projection.m[10] * -depth + projection.m[14];
+        float w = projection.m[11] * -depth + projection.m[15];
+        Vec4 p  = inverseProjection * Vec4(x, y, z / w, 1.0f);
+        return Vec3(p.x / p.w, p.y / p.w, p.z / p.w);
+    };
+
+    Vec3 direction = lightDirection.getNormalized();
+    Vec3 up        = std::abs(direction.y) > 0.99f ? Vec3::UNIT_Z : Vec3::UNIT_Y;
+    Mat4 lightRotation;
+    Mat4::createLookAt(Vec3::ZERO, direction, up, &lightRotation);
+
+    const Mat4 inverseView = view.getInversed();
+    float sliceNear        = nearPlane;
+    for (int i = 0; i < _cascadeCount; ++i)
+    {
+        // the sphere is fitted in view space, so only a change of the projection changes its radius
+        Vec3 corners[8];
+        Vec3 center;
+        int k = 0;
+        for (float depth : {sliceNear, _splits[i]})
+        {
+            for (float y : {-1.0f, 1.0f})
+            {
+                for (float x : {-1.0f, 1.0f})
+                {
+                    corners[k] = toView(x, y, depth);
+                    center += corners[k++];
+                }
+            }
+        }
+        center *= 1.0f / 8;
+
+        float radius = 0.0f;
+        for (auto&& corner : corners)
+            radius = (std::max)(radius, center.distance(corner));
+        sliceNear = _splits[i];
+
+        Vec3 worldCenter, lightCenter;
+        inverseView.transformPoint(center, &worldCenter);
+        lightRotation.transformPoint(worldCenter, &lightCenter);
+
+        // snapped to whole texels, the rasterized casters don't change when the camera moves less than one
+        float texel   = 2.0f * radius / _mapSize;
+        lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+        lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+        lightCenter.z = std::floor(lightCenter.z / texel) * texel;
+
+        Mat4 translation;
+        Mat4::createTranslation(-lightCenter, &translation);
+        _lightView[i]   = translation * lightRotation;
+        _radius[i]      = radius;
+        _casterDepth[i] = radius;
+    }
+}
+
+bool ShadowCascades::addCaster(int cascade, const AABB& bounds)
+{
+    AXASSERT(cascade >= 0 && cascade < _cascadeCount, "Invalid cascade");
+    if (bounds.isEmpty())
+        return false;
+
+    AABB box = bounds;
+    box.transform(_lightView[cascade]);
+
+    // outside of the sides, or behind all receivers of the cascade
+    float radius = _radius[cascade];
+    if (box._max.x < -radius || box._min.x > radius || box._max.y < -radius || box._min.y > radius ||
+        box._max.z < -radius)
+        return false;
+
+    _casterDepth[cascade] = (std::max)(_casterDepth[cascade], box._max.z);
+    return true;
+}
+
+void ShadowCascades::computeMatrices()
+{
+    for (int i = 0; i < _cascadeCount; ++i)
+    {
+        // the light looks down -z, the near plane is at the caster nearest to the light
+        float radius = _radius[i];
+        Mat4 projection;
+        Mat4::createOrthographicOffCenter(-radius, radius, -radius, radius, -_casterDepth[i], radius, &projection);
+        _viewProjection[i] = projection * _lightView[i];
+    }
+}
+
+}  // namespace ax
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "math/Mat4.h"
+#include "3d/AABB.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief ShadowCascades, fits the cascades of a directional light shadow map to the view frustum of a camera.
+ *
+ * The frustum is split along the view direction with the practical split scheme, a blend of logarithmic and
+ * uniform splits. Each cascade covers the bounding sphere of its slice, so its size doesn't change when the
+ * camera rotates, and its center is snapped to the texels of the shadow map, so static shadows don't shimmer
+ * when the camera moves and the matrices of a cascade only change after the camera moved by a texel. The depth
+ * range of a cascade covers the sphere and is extended towards the light to include the casters in front of it.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL ShadowCascades
+{
+public:
+    static constexpr int MAX_CASCADES = 4;
+
+    /**
+     * Computes the far distances of the cascades.
+     * @param lambda The blend of the logarithmic splits, 0 for uniform splits and 1 for logarithmic ones.
+     */
+    static void computeSplits(int count, float nearPlane, float farPlane, float lambda, float* splits);
+
+    /** Sets the amount of cascades, from 1 to MAX_CASCADES. */
+    void setCascadeCount(int count);
+    int getCascadeCount() const { return _cascadeCount; }
+
+    /** Sets the blend of the logarithmic splits, the default is 0.75. */
+    void setSplitLambda(float lambda) { _lambda = lambda; }
+    float getSplitLambda() const { return _lambda; }
+
+    /** Sets the texels per side of the shadow map of a cascade, the centers of the cascades snap to them. */
+    void setMapSize(int size) { _mapSize = size; }
+    int getMapSize() const { return _mapSize; }
+
+    /**
+     * Fits the cascades to a view frustum, the casters have to be added again.
+     * @param nearPlane The distance of the first cascade.
+     * @param farPlane The distance of the end of the last cascade, the shadow distance.
+     * @param lightDirection The world space direction the light shines towards.
+     */
+    void update(const Mat4& view, const Mat4& projection, float nearPlane, float farPlane, const Vec3& lightDirection);
+
+    /**
+     * Tests the world space bounds of a caster against a cascade, the depth range of the cascade grows to
+     * include the casters in front of it.
+     * @return Whether the caster may cast a shadow into the cascade.
+     */
+    bool addCaster(int cascade, const AABB& bounds);
+
+    /** Computes the view projections of the cascades, after all casters have been added. */
+    void computeMatrices();
+
+    /** The view distance the cascade ends at. */
+    float getSplit(int cascade) const { return _splits[cascade]; }
+
+    /** The radius of the sphere a cascade covers. */
+    float getRadius(int cascade) const { return _radius[cascade]; }
+
+    /** The light view of a cascade, centered on the snapped center of the cascade. */
+    const Mat4& getLightView(int cascade) const { return _lightView[cascade]; }
+
+    /** The matrix transforming world positions into the clip space of a cascade. */
+    const Mat4& getViewProjection(int cascade) const { return _viewProjection[cascade]; }
+
+    /** The depth range of a cascade along the light direction. */
+    float getDepthRange(int cascade) const { return _radius[cascade] + _casterDepth[cascade]; }
+
+protected:
+    int _cascadeCount = 3;
+    int _mapSize      = 1024;
+    float _lambda     = 0.75f;
+
+    float _splits[MAX_CASCADES]{};
+    float _radius[MAX_CASCADES]{};
+    float _casterDepth[MAX_CASCADES]{};  // the light view z of the caster nearest to the light
+    Mat4 _lightView[MAX_CASCADES];
+    Mat4 _viewProjection[MAX_CASCADES];
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -56,6 +56,18 @@ Skybox* Skybox::create(std::string_view positive_x,
     return ret;
 }
 
+Skybox* Skybox::create(std::string_view cubeMapPath)
+{
+    auto ret = new Skybox();
+    if (ret->init(cubeMapPath))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    AX_SAFE_DELETE(ret);
+    return nullptr;
+}
+
 bool Skybox::init()
 {
     _customCommand.setTransparent(false);
@@ -98,6 +110,17 @@ bool Skybox::init(std::string_view positive_x,
     return true;
 }
 
+bool Skybox::init(std::string_view cubeMapPath)
+{
+    auto texture = TextureCube::create(cubeMapPath);
+    if (texture == nullptr)
+        return false;
+
+    init();
+    setTexture(texture);
+    return true;
+}
+
 void Skybox::initBuffers()
 {
 
@@ -66,6 +66,12 @@ public:
                           std::string_view positive_z,
                           std::string_view negative_z);
 
+    /** create skybox from a KTX2 cube map, see TextureCube::create(std::string_view).
+     @param cubeMapPath the KTX2 file, with 6 square faces.
+     @return  A new skybox, nullptr if the cube map can't be loaded.
+     */
+    static Skybox* create(std::string_view cubeMapPath);
+
     /**texture getter and setter*/
     void setTexture(TextureCube*);
 
@@ -100,6 +106,11 @@ public:
               std::string_view positive_z,
               std::string_view negative_z);
 
+    /**
+     * initialize with a KTX2 cube map
+     */
+    bool init(std::string_view cubeMapPath);
+
 protected:
     /**
      * init internal buffers for Skybox.
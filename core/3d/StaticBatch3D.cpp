@@ -0,0 +1,296 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/StaticBatch3D.h"
+#include "3d/Mesh.h"
+#include "renderer/Texture2D.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+struct StaticBatch3D::Batch
+{
+    std::vector<MeshVertexAttrib> attribs;
+    const NTextureData* diffuse = nullptr;  // owned by the models
+    const NTextureData* normal  = nullptr;
+    bool transparent            = false;
+
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+};
+
+static bool isSameFormat(const std::vector<MeshVertexAttrib>& a, const std::vector<MeshVertexAttrib>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const MeshVertexAttrib& x, const MeshVertexAttrib& y) {
+        return x.vertexAttrib == y.vertexAttrib && x.type == y.type;
+    });
+}
+
+static bool isSameTexture(const NTextureData* a, const NTextureData* b)
+{
+    return a == b || (a && b && a->filename == b->filename);
+}
+
+static void transformVertex(float* vertex,
+                            const std::vector<MeshVertexAttrib>& attribs,
+                            const Mat4& transform,
+                            const Mat4& normalMatrix)
+{
+    for (const auto& attrib : attribs)
+    {
+        const int size = attrib.getAttribSizeBytes() / static_cast<int>(sizeof(float));
+        if (size >= 3)
+        {
+            Vec3 value(vertex);
+            switch (attrib.vertexAttrib)
+            {
+            case shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION:
+                transform.transformPoint(&value);
+                break;
+            case shaderinfos::VertexKey::VERTEX_ATTRIB_NORMAL:
+                normalMatrix.transformVector(&value);
+                value.normalize();
+                break;
+            case shaderinfos::VertexKey::VERTEX_ATTRIB_TANGENT:
+            case shaderinfos::VertexKey::VERTEX_ATTRIB_BINORMAL:
+                transform.transformVector(&value);
+                value.normalize();
+                break;
+            default:
+                break;
+            }
+            std::copy_n(&value.x, 3, vertex);
+        }
+        vertex += size;
+    }
+}
+
+static void setTextureParams(Texture2D* texture, const NTextureData& textureData)
+{
+    if (!texture)
+        return;
+
+    // like MeshRenderer::createNode
+    Texture2D::TexParams texParams;
+    texParams.minFilter    = backend::SamplerFilter::LINEAR;
+    texParams.magFilter    = backend::SamplerFilter::LINEAR;
+    texParams.sAddressMode = textureData.wrapS;
+    texParams.tAddressMode = textureData.wrapT;
+    texture->setTexParameters(texParams);
+}
+
+StaticBatch3D* StaticBatch3D::create()
+{
+    auto batch = new StaticBatch3D();
+    if (batch->init())
+    {
+        batch->autorelease();
+        return batch;
+    }
+    AX_SAFE_DELETE(batch);
+    return nullptr;
+}
+
+StaticBatch3D::StaticBatch3D() {}
+
+StaticBatch3D::~StaticBatch3D() {}
+
+bool StaticBatch3D::addModel(std::string_view modelPath, const Mat4& transform)
+{
+    auto it = _models.find(modelPath);
+    if (it == _models.end())
+    {
+        auto model = std::make_unique<Model>();
+        if (!loadFromFile(modelPath, &model->nodeDatas, &model->meshDatas, &model->materialDatas))
+        {
+            AXLOGW("warning: StaticBatch3D can't load {}", modelPath);
+            return false;
+        }
+        it = _models.emplace(std::string{modelPath}, std::move(model)).first;
+    }
+
+    _placements.emplace_back(Placement{it->second.get(), transform});
+    _dirty = true;
+    return true;
+}
+
+void StaticBatch3D::clearModels()
+{
+    _placements.clear();
+    _models.clear();
+    _meshes.clear();
+    _meshVertexDatas.clear();
+    _sourceMeshCount = 0;
+    _aabbDirty       = true;
+    _dirty           = false;
+}
+
+void StaticBatch3D::build()
+{
+    _dirty           = false;
+    _sourceMeshCount = 0;
+    _meshes.clear();
+    _meshVertexDatas.clear();
+    _aabbDirty = true;
+
+    std::vector<Batch> batches;
+    for (const auto& placement : _placements)
+    {
+        for (const auto node : placement.model->nodeDatas.nodes)
+        {
+            if (node)
+                appendNode(batches, *placement.model, node, placement.transform);
+        }
+    }
+
+    for (auto& batch : batches)
+    {
+        int floatsPerVertex = 0;
+        for (const auto& attrib : batch.attribs)
+            floatsPerVertex += attrib.getAttribSizeBytes() / static_cast<int>(sizeof(float));
+
+        // 16 bit indices as long as they address all the vertices
+        const size_t vertexCount = batch.vertices.size() / floatsPerVertex;
+        IndexArray indices(vertexCount > 0x10000 ? backend::IndexFormat::U_INT : backend::IndexFormat::U_SHORT);
+        for (auto index : batch.indices)
+        {
+            if (indices.format() == backend::IndexFormat::U_INT)
+                indices.emplace_back<uint32_t>(index);
+            else
+                indices.emplace_back<uint16_t>(static_cast<uint16_t>(index));
+        }
+
+        auto mesh = Mesh::create(batch.vertices, floatsPerVertex, indices, batch.attribs);
+        addMesh(mesh);
+        if (batch.diffuse)
+            setTextureParams(setMeshTexture(mesh, batch.diffuse->filename), *batch.diffuse);
+        if (batch.normal)
+            setTextureParams(setMeshTexture(mesh, batch.normal->filename, NTextureData::Usage::Normal), *batch.normal);
+    }
+
+    genMaterial(_shaderUsingLight);
+    for (ssize_t i = 0, size = _meshes.size(); i < size; ++i)
+        _meshes.at(i)->getMaterial()->setTransparent(batches[i].transparent);
+}
+
+void StaticBatch3D::appendNode(std::vector<Batch>& batches,
+                               const Model& model,
+                               const NodeData* node,
+                               const Mat4& parentTransform)
+{
+    const Mat4 transform = parentTransform * node->transform;
+    for (const auto modelData : node->modelNodeDatas)
+    {
+        if (!modelData || !modelData->bones.empty())
+            continue;
+
+        const MeshData* meshData  = nullptr;
+        const IndexArray* subMesh = nullptr;
+        for (const auto data : model.meshDatas.meshDatas)
+        {
+            auto it = std::find(data->subMeshIds.begin(), data->subMeshIds.end(), modelData->subMeshId);
+            if (it != data->subMeshIds.end())
+            {
+                meshData = data;
+                subMesh  = &data->subMeshIndices[it - data->subMeshIds.begin()];
+                break;
+            }
+        }
+        if (!subMesh)
+            continue;
+
+        // the material lookup of MeshRenderer::createNode
+        const auto& materials         = model.materialDatas;
+        const NMaterialData* material = modelData->materialId.empty() && !materials.materials.empty()
+                                            ? &materials.materials[0]
+                                            : materials.getMaterialData(modelData->materialId);
+        Batch key;
+        if (material)
+        {
+            key.diffuse     = material->getTextureData(NTextureData::Usage::Diffuse);
+            key.normal      = material->getTextureData(NTextureData::Usage::Normal);
+            key.transparent = material->getTextureData(NTextureData::Usage::Transparency) != nullptr;
+        }
+
+        auto batch = std::find_if(batches.begin(), batches.end(), [&](const Batch& other) {
+            return other.transparent == key.transparent && isSameTexture(other.diffuse, key.diffuse) &&
+                   isSameTexture(other.normal, key.normal) && isSameFormat(other.attribs, meshData->attribs);
+        });
+        if (batch == batches.end())
+        {
+            key.attribs = meshData->attribs;
+            batch       = batches.emplace(batches.end(), std::move(key));
+        }
+
+        appendMesh(batch->vertices, batch->indices, *meshData, *subMesh, transform);
+        ++_sourceMeshCount;
+    }
+
+    for (const auto child : node->children)
+    {
+        if (child)
+            appendNode(batches, model, child, transform);
+    }
+}
+
+void StaticBatch3D::appendMesh(std::vector<float>& vertices,
+                               std::vector<uint32_t>& indices,
+                               const MeshData& meshData,
+                               const IndexArray& subMeshIndices,
+                               const Mat4& transform)
+{
+    const size_t floatsPerVertex = meshData.getPerVertexSize() / sizeof(float);
+    const size_t vertexCount     = meshData.vertex.size() / floatsPerVertex;
+    uint32_t next                = static_cast<uint32_t>(vertices.size() / floatsPerVertex);
+
+    Mat4 normalMatrix = transform.getInversed();
+    normalMatrix.transpose();
+
+    // the merged index of each source vertex, the vertices are appended when first used
+    std::vector<uint32_t> merged(vertexCount, UINT32_MAX);
+    subMeshIndices.for_each([&](uint32_t index) {
+        AXASSERT(index < vertexCount, "invalid index");
+        auto& mergedIndex = merged[index];
+        if (mergedIndex == UINT32_MAX)
+        {
+            mergedIndex = next++;
+            auto source = meshData.vertex.data() + index * floatsPerVertex;
+            auto offset = vertices.size();
+            vertices.insert(vertices.end(), source, source + floatsPerVertex);
+            transformVertex(vertices.data() + offset, meshData.attribs, transform, normalMatrix);
+        }
+        indices.emplace_back(mergedIndex);
+    });
+}
+
+void StaticBatch3D::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_dirty)
+        build();
+
+    MeshRenderer::visit(renderer, parentTransform, parentFlags);
+}
+
+}  // namespace ax
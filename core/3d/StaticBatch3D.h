@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+
+#include "3d/MeshRenderer.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief StaticBatch3D, a MeshRenderer merging the static meshes of placed models at load time.
+ *
+ * The meshes sharing a vertex format, textures and transparency are concatenated into one vertex and index buffer
+ * and drawn with one MeshCommand, their vertices baked in the space of the batch. Each model file is loaded once
+ * per batch whatever the number of placements. The batch moves as a whole, its meshes can't move on their own.
+ * Skinned meshes are skipped.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL StaticBatch3D : public MeshRenderer
+{
+public:
+    static StaticBatch3D* create();
+
+    /**
+     * Place the meshes of a model in the batch, merged on the next visit or build.
+     *
+     * @param modelPath a .obj, .c3b or .c3t file
+     * @param transform the transform of the model in the space of the batch
+     * @return false if the model can't be loaded
+     */
+    bool addModel(std::string_view modelPath, const Mat4& transform = Mat4::IDENTITY);
+
+    /** Remove the placed models and the merged meshes, the loaded model files are released. */
+    void clearModels();
+
+    /** Merge the placed models into the meshes of the batch, done by the first visit after a model was added. */
+    void build();
+
+    /** The number of meshes placed in the batch, before merging. */
+    size_t getSourceMeshCount() const { return _sourceMeshCount; }
+
+    /**
+     * Append the vertices of a sub mesh transformed by a matrix to merged vertices, and its indices offset to them.
+     * Only the vertices used by the indices are appended. Positions are transformed as points, normals by the
+     * inverse transpose and tangents and binormals as directions, the other attributes are copied.
+     *
+     * @param vertices the merged vertices, in the format of meshData
+     * @param indices the merged indices
+     * @param meshData the mesh holding the sub mesh vertices
+     * @param subMeshIndices the triangle indices of the sub mesh
+     * @param transform the matrix transforming the sub mesh into the merged space
+     */
+    static void appendMesh(std::vector<float>& vertices,
+                           std::vector<uint32_t>& indices,
+                           const MeshData& meshData,
+                           const IndexArray& subMeshIndices,
+                           const Mat4& transform);
+
+    virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
+
+    StaticBatch3D();
+    virtual ~StaticBatch3D();
+
+protected:
+    struct Model
+    {
+        NodeDatas nodeDatas;
+        MeshDatas meshDatas;
+        MaterialDatas materialDatas;
+    };
+    struct Placement
+    {
+        const Model* model;
+        Mat4 transform;
+    };
+    struct Batch;
+
+    void appendNode(std::vector<Batch>& batches, const Model& model, const NodeData* node, const Mat4& parentTransform);
+
+    hlookup::string_map<std::unique_ptr<Model>> _models;
+    std::vector<Placement> _placements;
+    size_t _sourceMeshCount = 0;
+    bool _dirty             = false;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -360,6 +360,73 @@ float Terrain::getHeight(const Vec2& pos, Vec3* normal) const
     return getHeight(pos.x, pos.y, normal);
 }
 
+namespace
+{
+// the queries of a range of a batched query
+constexpr size_t QUERY_RANGE_SIZE = 64;
+
+/** Calls fn(begin, end) by ranges of QUERY_RANGE_SIZE, on the JobSystem workers from PARALLEL_QUERY_THRESHOLD. */
+template <typename Fn>
+void forEachQueryRange(size_t count, Fn&& fn)
+{
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    if (count < Terrain::PARALLEL_QUERY_THRESHOLD || jobSystem->getWorkerCount() == 0)
+    {
+        for (size_t begin = 0; begin < count; begin += QUERY_RANGE_SIZE)
+            fn(begin, (std::min)(begin + QUERY_RANGE_SIZE, count));
+        return;
+    }
+    jobSystem->wait(jobSystem->parallelFor(count, QUERY_RANGE_SIZE, std::forward<Fn>(fn)));
+}
+}  // namespace
+
+void Terrain::getHeights(std::span<const Vec2> positions, std::span<float> heights, std::span<Vec3> normals) const
+{
+    AXASSERT(heights.size() >= positions.size(), "A height per position is needed");
+    AXASSERT(normals.empty() || normals.size() >= positions.size(), "A normal per position is needed");
+
+    // the positions are mapped to the cells of the height map like in getHeight
+    Vec2 tl(-1 * _terrainData._mapScale * _imageWidth / 2, -1 * _terrainData._mapScale * _imageHeight / 2);
+    auto mulResult = getNodeToWorldTransform() * Vec4(tl.x, 0.0f, tl.y, 1.0f);
+    tl.set(mulResult.x, mulResult.z);
+    Vec2 size(_imageWidth * _terrainData._mapScale, _imageHeight * _terrainData._mapScale);
+    mulResult = getNodeToWorldTransform() * Vec4(size.x, 0.0f, size.y, 0.0f);
+    size.set(mulResult.x, mulResult.z);
+
+    Mat4 toCells;
+    toCells.m[0]       = _imageWidth / size.x;
+    toCells.m[5]       = _imageHeight / size.y;
+    toCells.m[12]      = -tl.x * toCells.m[0];
+    toCells.m[13]      = -tl.y * toCells.m[5];
+    const float scaleY = getScaleY();
+
+    forEachQueryRange(positions.size(), [&](size_t begin, size_t end) {
+        Vec2 cells[QUERY_RANGE_SIZE];
+        const size_t count = end - begin;
+        MathUtil::transformVec2(toCells, positions.data() + begin, cells, count);
+        MathUtil::sampleBilinear(_heightField.data(), _imageWidth, _imageHeight, cells, heights.data() + begin,
+                                 count);
+        for (size_t i = begin; i < end; ++i)
+            heights[i] *= scaleY;
+
+        if (normals.empty())
+            return;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& normal = normals[begin + i];
+            if (!(cells[i].x >= 0 && cells[i].x < _imageWidth - 1 && cells[i].y >= 0 && cells[i].y < _imageHeight - 1))
+            {
+                normal.setZero();
+                continue;
+            }
+
+            const float* cell = _heightField.data() + int(cells[i].y) * _imageWidth + int(cells[i].x);
+            normal.set((cell[1] - cell[_imageWidth]) * scaleY, 2, (cell[_imageWidth + 1] - cell[0]) * scaleY);
+            normal.normalize();
+        }
+    });
+}
+
 float Terrain::getImageHeight(int pixel_x, int pixel_y) const
 {
     int byte_stride = 1;
@@ -385,6 +452,7 @@ void Terrain::loadVertices()
 {
     _maxHeight = -99999;
     _minHeight = 99999;
+    _heightField.resize(_imageWidth * _imageHeight);
     for (int i = 0; i < _imageHeight; ++i)
     {
         for (int j = 0; j < _imageWidth; j++)
@@ -396,6 +464,7 @@ void Terrain::loadVertices()
                                i * _terrainData._mapScale - _imageHeight / 2 * _terrainData._mapScale);  // z
             v._texcoord = Tex2F(j * 1.0 / _imageWidth, i * 1.0 / _imageHeight);
             _vertices.emplace_back(v);
+            _heightField[i * _imageWidth + j] = height;
 
             // update the min & max height;
             if (height > _maxHeight)
@@ -584,6 +653,24 @@ bool Terrain::getIntersectionPoint(const Ray& ray_, Vec3& intersectionPoint) con
     return hasIntersect;
 }
 
+void Terrain::getIntersectionPoints(std::span<const Ray> rays, std::span<RayHit> hits) const
+{
+    AXASSERT(hits.size() >= rays.size(), "A hit per ray is needed");
+
+    forEachQueryRange(rays.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto& hit    = hits[i];
+            float entry  = 0.0f;
+            hit.distance = FLT_MAX;
+            hit.hit      = rays[i].intersects(_quadRoot->_worldSpaceAABB, &entry) &&
+                           _quadRoot->getIntersectionPoint(rays[i], hit.distance, hit.point);
+            if (!hit.hit)
+                hit.distance = 0.0f;
+        }
+    });
+}
+
 void Terrain::setMaxDetailMapAmount(int max_value)
 {
     _maxDetailMapValue = max_value;
@@ -1610,6 +1697,49 @@ void Terrain::QuadTree::preCalculateAABB(const Mat4& worldTransform)
     }
 }
 
+bool Terrain::QuadTree::getIntersectionPoint(const Ray& ray, float& distance, Vec3& intersectionPoint) const
+{
+    bool found = false;
+    if (_isTerminal)
+    {
+        for (const auto& triangle : _chunk->_trianglesList)
+        {
+            Vec3 p;
+            if (triangle.getIntersectPoint(ray, p))
+            {
+                float dist = ray._origin.distance(p);
+                if (dist < distance)
+                {
+                    distance          = dist;
+                    intersectionPoint = p;
+                    found             = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    // the children are visited nearest first, the ones farther than a hit can't have a closer one
+    const QuadTree* children[4] = {_tl, _tr, _bl, _br};
+    float entries[4];
+    int order[4] = {0, 1, 2, 3};
+    for (int i = 0; i < 4; ++i)
+    {
+        entries[i] = 0.0f;
+        if (!ray.intersects(children[i]->_worldSpaceAABB, &entries[i]))
+            entries[i] = FLT_MAX;
+    }
+    std::sort(order, order + 4, [&entries](int a, int b) { return entries[a] < entries[b]; });
+
+    for (int i : order)
+    {
+        if (entries[i] >= distance)
+            break;
+        found |= children[i]->getIntersectionPoint(ray, distance, intersectionPoint);
+    }
+    return found;
+}
+
 Terrain::QuadTree::~QuadTree()
 {
     if (_tl)
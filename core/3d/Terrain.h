@@ -25,6 +25,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "2d/Node.h"
@@ -117,6 +118,17 @@ public:
         float _detailMapSize;
     };
 
+    /** The hit of a ray, see getIntersectionPoints. */
+    struct RayHit
+    {
+        Vec3 point;
+        float distance = 0.0f;
+        bool hit       = false;
+    };
+
+    /** The query count from which the batched queries are spread over the JobSystem workers. */
+    static constexpr size_t PARALLEL_QUERY_THRESHOLD = 64;
+
     /**
      * Triangle
      */
@@ -314,6 +326,8 @@ private:
         void cullByCamera(const Camera* camera, const Mat4& worldTransform);
         /**precalculate the AABB(In world space) of each quad*/
         void preCalculateAABB(const Mat4& worldTransform);
+        /**recursively find the nearest hit closer than distance, the AABB of this node is hit by the ray*/
+        bool getIntersectionPoint(const Ray& ray, float& distance, Vec3& intersectionPoint) const;
         QuadTree* _tl;
         QuadTree* _tr;
         QuadTree* _bl;
@@ -375,6 +389,15 @@ public:
      **/
     float getHeight(const Vec2& pos, Vec3* normal = nullptr) const;
 
+    /**get the heights of many positions (X,Z) at once, like getHeight.
+     * The positions are mapped to the height map in a batch and sampled by the SIMD kernel of
+     * MathUtil::sampleBilinear, on the JobSystem workers when there are many.
+     * @param positions the positions (X,Z)
+     * @param heights the height of each position, 0 out of the terrain bounds
+     * @param normals the normal of each position, computed when it isn't empty
+     **/
+    void getHeights(std::span<const Vec2> positions, std::span<float> heights, std::span<Vec3> normals = {}) const;
+
     /**get the normal of the specified position in terrain
      * @return the normal vector of the specified position of the terrain.
      * @note the fast normal calculation may not get precise normal vector.
@@ -418,6 +441,16 @@ public:
      */
     bool getIntersectionPoint(const Ray& ray, Vec3& intersectionPoint) const;
 
+    /**
+     * Ray-Terrain intersection of many rays at once, like projectiles or picking.
+     * The rays descend the quad tree by the AABBs of its nodes, which bound the min and max heights of their chunks,
+     * nearest node first, and skip the nodes farther than the closest hit. The rays are cast on the JobSystem workers
+     * when there are many.
+     * @param rays the rays in world space
+     * @param hits the hit of each ray
+     */
+    void getIntersectionPoints(std::span<const Ray> rays, std::span<RayHit> hits) const;
+
     /**
      * set the MaxDetailAmount.
      */
@@ -533,6 +566,7 @@ protected:
     Chunk* _chunkesArray[MAX_CHUNKES][MAX_CHUNKES];
     std::vector<TerrainVertexData> _vertices;
     std::vector<unsigned int> _indices;
+    std::vector<float> _heightField;  // the heights of the height map, by row, for the batched queries
     int _imageWidth;
     int _imageHeight;
     Vec2 _chunkSize;
@@ -97,7 +97,7 @@ bool VertexAttribBinding::init(MeshIndexData* meshIndexData, Pass* pass, MeshCom
     {
         auto meshattribute = meshVertexData->getMeshVertexAttrib(k);
         setVertexAttribPointer(vertexLayout, shaderinfos::getAttributeName(meshattribute.vertexAttrib),
-                               meshattribute.type, false,
+                               meshattribute.type, meshattribute.isNormalized(),
                                offset, 1 << k);
         offset += meshattribute.getAttribSizeBytes();
     }
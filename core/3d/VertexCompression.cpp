@@ -0,0 +1,260 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "3d/VertexCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ax
+{
+
+namespace
+{
+backend::VertexFormat getCompressedFormat(const MeshVertexAttrib& attrib, VertexCompressionFlags flags)
+{
+    using backend::VertexFormat;
+    using shaderinfos::VertexKey;
+
+    switch (attrib.vertexAttrib)
+    {
+    case VertexKey::VERTEX_ATTRIB_POSITION:
+        if (attrib.type == VertexFormat::FLOAT3 && !!(flags & VertexCompressionFlags::POSITION))
+            return VertexFormat::HALF4;
+        break;
+    case VertexKey::VERTEX_ATTRIB_TEX_COORD:
+    case VertexKey::VERTEX_ATTRIB_TEX_COORD1:
+    case VertexKey::VERTEX_ATTRIB_TEX_COORD2:
+    case VertexKey::VERTEX_ATTRIB_TEX_COORD3:
+        if (attrib.type == VertexFormat::FLOAT2 && !!(flags & VertexCompressionFlags::TEX_COORD))
+            return VertexFormat::HALF2;
+        break;
+    case VertexKey::VERTEX_ATTRIB_NORMAL:
+    case VertexKey::VERTEX_ATTRIB_TANGENT:
+    case VertexKey::VERTEX_ATTRIB_BINORMAL:
+        if (attrib.type == VertexFormat::FLOAT3 && !!(flags & VertexCompressionFlags::NORMAL))
+            return VertexFormat::SHORT4;
+        break;
+    case VertexKey::VERTEX_ATTRIB_BLEND_WEIGHT:
+        if (attrib.type == VertexFormat::FLOAT4 && !!(flags & VertexCompressionFlags::BLEND_WEIGHT))
+            return VertexFormat::UBYTE4;
+        break;
+    default:
+        break;
+    }
+    return attrib.type;
+}
+
+int16_t toSnorm16(float value)
+{
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+void packBlendWeights(const float* weights, uint8_t* out)
+{
+    int sum     = 0;
+    int largest = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i] = static_cast<uint8_t>(std::lround(std::clamp(weights[i], 0.0f, 1.0f) * 255.0f));
+        sum += out[i];
+        if (out[i] > out[largest])
+            largest = i;
+    }
+
+    // the rounded weights must still add up to one, the largest weight takes the difference
+    if (sum != 0)
+        out[largest] = static_cast<uint8_t>(std::clamp(out[largest] + 255 - sum, 0, 255));
+}
+}  // namespace
+
+uint16_t VertexCompression::toHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const int exponent  = static_cast<int>((bits >> 23) & 0xff);
+    uint32_t mantissa   = bits & 0x7fffff;
+
+    // infinity and nan
+    if (exponent == 0xff)
+        return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+    const int halfExponent = exponent - 127 + 15;
+    if (halfExponent >= 31)
+        return static_cast<uint16_t>(sign | 0x7c00);
+
+    uint32_t half;
+    uint32_t remainder;
+    uint32_t halfway;
+    if (halfExponent <= 0)
+    {
+        // denormal, or too small for a half
+        if (halfExponent < -10)
+            return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000;
+        const int shift = 14 - halfExponent;
+        half            = mantissa >> shift;
+        remainder       = mantissa & ((1u << shift) - 1);
+        halfway         = 1u << (shift - 1);
+    }
+    else
+    {
+        half      = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1fff;
+        halfway   = 0x1000;
+    }
+
+    // a carry out of the mantissa increments the exponent, up to infinity
+    if (remainder > halfway || (remainder == halfway && (half & 1)))
+        ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float VertexCompression::fromHalf(uint16_t value)
+{
+    const uint32_t sign     = (value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1f;
+    const uint32_t mantissa = value & 0x3ff;
+
+    if (exponent == 0)
+    {
+        const float denormal = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -denormal : denormal;
+    }
+
+    uint32_t bits;
+    if (exponent == 31)
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    else
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+bool VertexCompression::compress(MeshData& meshData, VertexCompressionFlags flags)
+{
+    const int stride = meshData.getPerVertexSize();
+    if (!flags || stride == 0 || meshData.vertex.empty())
+        return false;
+
+    std::vector<MeshVertexAttrib> attribs = meshData.attribs;
+    int positionOffset                    = -1;
+    int offset                            = 0;
+    bool changed                          = false;
+    for (auto&& attrib : attribs)
+    {
+        if (attrib.vertexAttrib == shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION)
+            positionOffset = offset;
+        offset += attrib.getAttribSizeBytes();
+
+        const auto format = getCompressedFormat(attrib, flags);
+        changed |= format != attrib.type;
+        attrib.type = format;
+    }
+    if (!changed)
+        return false;
+
+    const auto* vertices     = reinterpret_cast<const uint8_t*>(meshData.vertex.data());
+    const size_t vertexCount = meshData.vertex.size() * sizeof(float) / stride;
+
+    // the bounds are taken from the float positions, before they are packed
+    if (meshData.subMeshAABB.size() != meshData.subMeshIndices.size() && positionOffset >= 0)
+    {
+        meshData.subMeshAABB.clear();
+        for (auto&& indices : meshData.subMeshIndices)
+        {
+            AABB aabb;
+            indices.for_each([&](uint32_t index) {
+                Vec3 point;
+                memcpy(&point, vertices + index * stride + positionOffset, sizeof(point));
+                aabb.updateMinMax(&point, 1);
+            });
+            meshData.subMeshAABB.emplace_back(aabb);
+        }
+    }
+
+    int packedStride = 0;
+    for (auto&& attrib : attribs)
+        packedStride += attrib.getAttribSizeBytes();
+
+    std::vector<float> packed(vertexCount * packedStride / sizeof(float));
+    auto* out = reinterpret_cast<uint8_t*>(packed.data());
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        const uint8_t* src = vertices + v * stride;
+        for (size_t a = 0; a < attribs.size(); ++a)
+        {
+            const int srcSize = meshData.attribs[a].getAttribSizeBytes();
+            const int dstSize = attribs[a].getAttribSizeBytes();
+            if (meshData.attribs[a].type == attribs[a].type)
+            {
+                memcpy(out, src, srcSize);
+                src += srcSize;
+                out += dstSize;
+                continue;
+            }
+
+            // the packed attributes are float vectors of 2 to 4 components, a missing w is one
+            float values[4] = {0, 0, 0, 1};
+            memcpy(values, src, srcSize);
+            switch (attribs[a].type)
+            {
+            case backend::VertexFormat::HALF4:
+            case backend::VertexFormat::HALF2:
+            {
+                uint16_t halves[4];
+                for (int i = 0; i < dstSize / 2; ++i)
+                    halves[i] = toHalf(values[i]);
+                memcpy(out, halves, dstSize);
+                break;
+            }
+            case backend::VertexFormat::SHORT4:
+            {
+                // the fourth component is never read, the shaders take the xyz of the normals
+                const int16_t shorts[4] = {toSnorm16(values[0]), toSnorm16(values[1]), toSnorm16(values[2]), 0};
+                memcpy(out, shorts, sizeof(shorts));
+                break;
+            }
+            case backend::VertexFormat::UBYTE4:
+                packBlendWeights(values, out);
+                break;
+            default:
+                break;
+            }
+            src += srcSize;
+            out += dstSize;
+        }
+    }
+
+    meshData.vertex.swap(packed);
+    meshData.vertexSizeInFloat = packedStride / sizeof(float);
+    meshData.attribs.swap(attribs);
+    return true;
+}
+
+}  // namespace ax
@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+#pragma once
+
+#include "3d/Bundle3DData.h"
+#include "base/bitmask.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/** The vertex attributes VertexCompression::compress packs into smaller formats. */
+enum class VertexCompressionFlags : uint8_t
+{
+    NONE         = 0,
+    POSITION     = 1 << 0,  //!< FLOAT3 positions to HALF4
+    TEX_COORD    = 1 << 1,  //!< FLOAT2 texture coords to HALF2
+    NORMAL       = 1 << 2,  //!< FLOAT3 normals, tangents and binormals to normalized SHORT4
+    BLEND_WEIGHT = 1 << 3,  //!< FLOAT4 blend weights to normalized UBYTE4
+    ALL          = POSITION | TEX_COORD | NORMAL | BLEND_WEIGHT
+};
+AX_ENABLE_BITMASK_OPS(VertexCompressionFlags)
+
+/**
+ * @brief VertexCompression, packs the float vertices of a mesh into smaller vertex formats.
+ *
+ * The packed attributes are widened back to floats by the vertex fetch, see MeshVertexAttrib::isNormalized, so
+ * the shaders don't change. A mesh with positions, normals, texture coords and tangents shrinks from 44 to 28
+ * bytes per vertex. Half positions keep 11 significant bits, which suits models of a few hundred units around
+ * their origin, large or far from the origin models should keep their float positions.
+ *
+ * The vertices stay in MeshData::vertex, the packed formats are multiples of 4 bytes, and the missing sub mesh
+ * AABBs are computed before packing since Bundle3D::calculateAABB reads float positions.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL VertexCompression
+{
+public:
+    /**
+     * Pack the vertex attributes selected by flags, the attributes in other formats are left alone.
+     *
+     * @return whether any attribute was packed
+     */
+    static bool compress(MeshData& meshData, VertexCompressionFlags flags);
+
+    /** Convert to an IEEE half float, rounded to the nearest even. */
+    static uint16_t toHalf(float value);
+    static float fromHalf(uint16_t value);
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
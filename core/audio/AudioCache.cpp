@@ -30,8 +30,10 @@
 
 #include "audio/AudioCache.h"
 #include <thread>
+#include "base/Allocator.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "platform/FileUtils.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
@@ -59,6 +61,8 @@ AudioCache::AudioCache()
     , _id(++__idIndex)
     , _isLoadingFinished(false)
     , _isSkipReadDataTask(false)
+    , _keepCompressed(false)
+    , _pcmSize(0)
 {
     AXLOGV("AudioCache() {}, id={}", fmt::ptr(this), _id);
     for (int i = 0; i < QUEUEBUFFER_NUM; ++i)
@@ -82,8 +86,9 @@ AudioCache::~AudioCache()
         AXLOGV("id={}, waiting readData thread to finish ...", _id);
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
-    // wait for the 'readDataTask' task to exit
+    // wait for the 'readDataTask' task and a decode to exit
     _readDataTaskMutex.lock();
+    _decodeMutex.lock();
 
     if (_state == State::READY)
     {
@@ -91,6 +96,7 @@ AudioCache::~AudioCache()
         {
             AXLOGV("~AudioCache(id={}), delete buffer: {}", _id, _alBufferId);
             alDeleteBuffers(1, &_alBufferId);
+            Memory::trackDeallocation(MemoryTag::AUDIO, _pcmSize);
             _alBufferId = INVALID_AL_BUFFER_ID;
         }
     }
@@ -103,10 +109,11 @@ AudioCache::~AudioCache()
     {
         for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
         {
-            free(_queBuffers[index]);
+            Memory::deallocate(_queBuffers[index], _queBufferSize[index], MemoryTag::AUDIO);
         }
     }
     AXLOGV("~AudioCache() {}, id={}, end", fmt::ptr(this), _id);
+    _decodeMutex.unlock();
     _readDataTaskMutex.unlock();
 }
 
@@ -124,14 +131,11 @@ void AudioCache::readDataTask(unsigned int selfId)
         if (decoder == nullptr || !decoder->open(_fileFullPath))
             break;
 
-        const uint32_t originalTotalFrames = decoder->getTotalFrames();
-        const uint32_t sampleRate          = decoder->getSampleRate();
-        const uint32_t channelCount        = decoder->getChannelCount();
-        const auto sourceFormat            = decoder->getSourceFormat();
-
-        uint32_t totalFrames     = originalTotalFrames;
-        uint32_t dataSize        = decoder->framesToBytes(totalFrames);
-        uint32_t remainingFrames = totalFrames;
+        const uint32_t totalFrames  = decoder->getTotalFrames();
+        const uint32_t sampleRate   = decoder->getSampleRate();
+        const uint32_t channelCount = decoder->getChannelCount();
+        const auto sourceFormat     = decoder->getSourceFormat();
+        const uint32_t dataSize     = decoder->framesToBytes(totalFrames);
 
         switch (sourceFormat)
         {
@@ -171,120 +175,19 @@ void AudioCache::readDataTask(unsigned int selfId)
 
         if (dataSize <= PCMDATA_CACHEMAXSIZE)
         {
-            uint32_t framesRead = 0;
-            const uint32_t framesToReadOnce =
-                std::min(totalFrames, static_cast<uint32_t>(sampleRate * QUEUEBUFFER_TIME_STEP * QUEUEBUFFER_NUM));
-
-            alGenBuffers(1, &_alBufferId);
-            auto alError = alGetError();
-            if (alError != AL_NO_ERROR)
+            if (_keepCompressed)
             {
-                AXLOGE("{}: attaching audio to buffer fail: {:#x}", __FUNCTION__, alError);
-                break;
-            }
-
-            std::vector<char> pcmBuffer(dataSize, 0);
-            auto pcmData = pcmBuffer.data();
-
-            if (*_isDestroyed)
-                break;
-
-            framesRead = decoder->readFixedFrames((std::min)(framesToReadOnce, remainingFrames),
-                                                  pcmData + decoder->framesToBytes(_framesRead));
-            _framesRead += framesRead;
-            remainingFrames -= framesRead;
-
-            if (*_isDestroyed)
-                break;
-
-            uint32_t frames = 0;
-            while (!*_isDestroyed && _framesRead < originalTotalFrames)
-            {
-                frames = (std::min)(framesToReadOnce, remainingFrames);
-                if (_framesRead + frames > originalTotalFrames)
+                // decoded when played, worth it when the file is at least twice smaller than the pcm data
+                auto data = FileUtils::getInstance()->getDataFromFile(_fileFullPath);
+                if (!data.isNull() && static_cast<uint32_t>(data.getSize()) <= dataSize / 2)
                 {
-                    frames = originalTotalFrames - _framesRead;
-                }
-                framesRead = decoder->read(frames, pcmData + decoder->framesToBytes(_framesRead));
-                if (framesRead == 0)
+                    _compressedData = std::make_shared<Data>(std::move(data));
+                    _state          = State::READY;
                     break;
-                _framesRead += framesRead;
-                remainingFrames -= framesRead;
-            }
-
-            if (*_isDestroyed)
-                break;
-
-            if (_framesRead < originalTotalFrames)
-            {
-                memset(pcmData + decoder->framesToBytes(_framesRead), 0x00,
-                       decoder->framesToBytes(totalFrames - _framesRead));
-            }
-
-#if AX_USE_ALSOFT
-            AXLOGV("pcm buffer was loaded successfully, total frames: {}, total read frames: {}, remainingFrames: {}",
-                  totalFrames, _framesRead, remainingFrames);
-            if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                alBufferi(_alBufferId, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-            alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
-#else
-#    if !AX_USE_ALSOFT
-            /// Apple OpenAL framework, try adjust frames
-            /// May don't need, xcode11 sdk works well
-            uint32_t adjustFrames = 0;
-            BREAK_IF_ERR_LOG(!decoder->seek(totalFrames), "AudioDecoder::seek({}) error", totalFrames);
-
-            char* tmpBuf = (char*)malloc(decoder->framesToBytes(framesToReadOnce));
-            std::vector<char> adjustFrameBuf;
-            adjustFrameBuf.reserve(decoder->framesToBytes(framesToReadOnce));
-
-            // Adjust total frames by setting position to the end of frames and try to read more data.
-            // This is a workaround for https://github.com/cocos2d/cocos2d-x/issues/16938
-            do
-            {
-                framesRead = decoder->read(framesToReadOnce, tmpBuf);
-                if (framesRead > 0)
-                {
-                    adjustFrames += framesRead;
-                    adjustFrameBuf.insert(adjustFrameBuf.end(), tmpBuf, tmpBuf + decoder->framesToBytes(framesRead));
                 }
-
-            } while (framesRead > 0);
-
-            if (adjustFrames > 0)
-            {
-                AXLOGV("Orignal total frames: {}, adjust frames: {}, current total frames: {}", totalFrames,
-                      adjustFrames, totalFrames + adjustFrames);
-                totalFrames += adjustFrames;
-                _totalFrames = remainingFrames = totalFrames;
-            }
-
-            free(tmpBuf);
-
-            // Reset to frame 0
-            BREAK_IF_ERR_LOG(!decoder->seek(0), "AudioDecoder::seek(0) failed!");
-
-            if (adjustFrames > 0)
-            {
-                pcmBuffer.insert(pcmBuffer.end(), adjustFrameBuf.data(), adjustFrameBuf.data() + adjustFrameBuf.size());
-                pcmData  = pcmBuffer.data();
-                dataSize = static_cast<uint32_t>(pcmBuffer.size());
-            }
-#    endif /* Adjust frames, may not needed */
-            AXLOGV(
-                "pcm buffer was loaded successfully, total frames: {}, total read frames: {}, adjust frames: {}, "
-                "remainingFrames: {}",
-                totalFrames, _framesRead, adjustFrames, remainingFrames);
-            _framesRead += adjustFrames;
-            alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
-#endif
-            alError = alGetError();
-            if (alError != AL_NO_ERROR)
-            {
-                AXLOGE("{}:alBufferData error code:{:#x}", __FUNCTION__, alError);
-                break;
             }
 
+            BREAK_IF(!decodeBuffer(decoder));
             _state = State::READY;
         }
         else
@@ -296,7 +199,7 @@ void AudioCache::readDataTask(unsigned int selfId)
 
             for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
             {
-                _queBuffers[index]    = (char*)malloc(queBufferBytes);
+                _queBuffers[index]    = (char*)Memory::allocate(queBufferBytes, MemoryTag::AUDIO);
                 _queBufferSize[index] = queBufferBytes;
 
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
@@ -331,6 +234,187 @@ void AudioCache::readDataTask(unsigned int selfId)
     AXLOGV("readDataTask end, cache id={}", selfId);
 }
 
+bool AudioCache::decodeBuffer(AudioDecoder* decoder)
+{
+    const uint32_t originalTotalFrames = decoder->getTotalFrames();
+    const uint32_t sampleRate          = decoder->getSampleRate();
+    [[maybe_unused]] const auto sourceFormat = decoder->getSourceFormat();
+
+    uint32_t totalFrames     = originalTotalFrames;
+    uint32_t dataSize        = decoder->framesToBytes(totalFrames);
+    uint32_t remainingFrames = totalFrames;
+
+    _framesRead = 0;
+
+    bool ret = false;
+    do
+    {
+        uint32_t framesRead = 0;
+        const uint32_t framesToReadOnce =
+            std::min(totalFrames, static_cast<uint32_t>(sampleRate * QUEUEBUFFER_TIME_STEP * QUEUEBUFFER_NUM));
+
+        alGenBuffers(1, &_alBufferId);
+        auto alError = alGetError();
+        if (alError != AL_NO_ERROR)
+        {
+            AXLOGE("{}: attaching audio to buffer fail: {:#x}", __FUNCTION__, alError);
+            break;
+        }
+
+        // reused by the next decodes of the thread
+        static thread_local std::vector<char> pcmBuffer;
+        pcmBuffer.assign(dataSize, 0);
+        auto pcmData = pcmBuffer.data();
+
+        if (*_isDestroyed)
+            break;
+
+        framesRead = decoder->readFixedFrames((std::min)(framesToReadOnce, remainingFrames),
+                                              pcmData + decoder->framesToBytes(_framesRead));
+        _framesRead += framesRead;
+        remainingFrames -= framesRead;
+
+        if (*_isDestroyed)
+            break;
+
+        uint32_t frames = 0;
+        while (!*_isDestroyed && _framesRead < originalTotalFrames)
+        {
+            frames = (std::min)(framesToReadOnce, remainingFrames);
+            if (_framesRead + frames > originalTotalFrames)
+            {
+                frames = originalTotalFrames - _framesRead;
+            }
+            framesRead = decoder->read(frames, pcmData + decoder->framesToBytes(_framesRead));
+            if (framesRead == 0)
+                break;
+            _framesRead += framesRead;
+            remainingFrames -= framesRead;
+        }
+
+        if (*_isDestroyed)
+            break;
+
+        if (_framesRead < originalTotalFrames)
+        {
+            memset(pcmData + decoder->framesToBytes(_framesRead), 0x00,
+                   decoder->framesToBytes(totalFrames - _framesRead));
+        }
+
+#if AX_USE_ALSOFT
+        AXLOGV("pcm buffer was loaded successfully, total frames: {}, total read frames: {}, remainingFrames: {}",
+              totalFrames, _framesRead, remainingFrames);
+        if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+            alBufferi(_alBufferId, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
+        alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
+#else
+#    if !AX_USE_ALSOFT
+        /// Apple OpenAL framework, try adjust frames
+        /// May don't need, xcode11 sdk works well
+        uint32_t adjustFrames = 0;
+        BREAK_IF_ERR_LOG(!decoder->seek(totalFrames), "AudioDecoder::seek({}) error", totalFrames);
+
+        char* tmpBuf = (char*)malloc(decoder->framesToBytes(framesToReadOnce));
+        std::vector<char> adjustFrameBuf;
+        adjustFrameBuf.reserve(decoder->framesToBytes(framesToReadOnce));
+
+        // Adjust total frames by setting position to the end of frames and try to read more data.
+        // This is a workaround for https://github.com/cocos2d/cocos2d-x/issues/16938
+        do
+        {
+            framesRead = decoder->read(framesToReadOnce, tmpBuf);
+            if (framesRead > 0)
+            {
+                adjustFrames += framesRead;
+                adjustFrameBuf.insert(adjustFrameBuf.end(), tmpBuf, tmpBuf + decoder->framesToBytes(framesRead));
+            }
+
+        } while (framesRead > 0);
+
+        if (adjustFrames > 0)
+        {
+            AXLOGV("Orignal total frames: {}, adjust frames: {}, current total frames: {}", totalFrames,
+                  adjustFrames, totalFrames + adjustFrames);
+            totalFrames += adjustFrames;
+            _totalFrames = remainingFrames = totalFrames;
+        }
+
+        free(tmpBuf);
+
+        // Reset to frame 0
+        BREAK_IF_ERR_LOG(!decoder->seek(0), "AudioDecoder::seek(0) failed!");
+
+        if (adjustFrames > 0)
+        {
+            pcmBuffer.insert(pcmBuffer.end(), adjustFrameBuf.data(), adjustFrameBuf.data() + adjustFrameBuf.size());
+            pcmData  = pcmBuffer.data();
+            dataSize = static_cast<uint32_t>(pcmBuffer.size());
+        }
+#    endif /* Adjust frames, may not needed */
+        AXLOGV(
+            "pcm buffer was loaded successfully, total frames: {}, total read frames: {}, adjust frames: {}, "
+            "remainingFrames: {}",
+            totalFrames, _framesRead, adjustFrames, remainingFrames);
+        _framesRead += adjustFrames;
+        alBufferData(_alBufferId, _format, pcmData, (ALsizei)dataSize, (ALsizei)sampleRate);
+#endif
+        alError = alGetError();
+        if (alError != AL_NO_ERROR)
+        {
+            AXLOGE("{}:alBufferData error code:{:#x}", __FUNCTION__, alError);
+            break;
+        }
+
+        // the PCM data is copied by OpenAL
+        _pcmSize = dataSize;
+        ret      = true;
+        Memory::trackAllocation(MemoryTag::AUDIO, dataSize);
+    } while (false);
+
+    if (!ret && _alBufferId != INVALID_AL_BUFFER_ID && alIsBuffer(_alBufferId))
+    {
+        alDeleteBuffers(1, &_alBufferId);
+        _alBufferId = INVALID_AL_BUFFER_ID;
+    }
+    return ret;
+}
+
+bool AudioCache::decodeCompressed(bool& decoded)
+{
+    std::lock_guard<std::mutex> lck(_decodeMutex);
+    decoded = false;
+    if (_alBufferId != INVALID_AL_BUFFER_ID)
+        return true;
+    if (*_isDestroyed)
+        return false;
+
+    AudioDecoder* decoder = AudioDecoderManager::createDecoder(_fileFullPath);
+    if (decoder != nullptr)
+    {
+        decoder->setMemorySource(_compressedData);
+        decoded = decoder->open(_fileFullPath) && decodeBuffer(decoder);
+    }
+    AudioDecoderManager::destroyDecoder(decoder);
+    return decoded;
+}
+
+bool AudioCache::isBufferDecoded() const
+{
+    return _alBufferId != INVALID_AL_BUFFER_ID;
+}
+
+void AudioCache::releaseBuffer()
+{
+    std::lock_guard<std::mutex> lck(_decodeMutex);
+    if (_alBufferId != INVALID_AL_BUFFER_ID && alIsBuffer(_alBufferId))
+    {
+        AXLOGV("AudioCache(id={}), release buffer: {}", _id, _alBufferId);
+        alDeleteBuffers(1, &_alBufferId);
+        Memory::trackDeallocation(MemoryTag::AUDIO, _pcmSize);
+    }
+    _alBufferId = INVALID_AL_BUFFER_ID;
+}
+
 void AudioCache::addPlayCallback(const std::function<void()>& callback)
 {
     std::lock_guard<std::mutex> lk(_playCallbackMutex);
@@ -42,6 +42,8 @@ namespace ax
 
 class AudioEngineImpl;
 class AudioPlayer;
+class AudioDecoder;
+class Data;
 
 class AX_DLL AudioCache
 {
@@ -65,6 +67,16 @@ protected:
     void setSkipReadDataTask(bool isSkip) { _isSkipReadDataTask = isSkip; };
     void readDataTask(unsigned int selfId);
 
+    /** Decodes all the frames to the buffer. */
+    bool decodeBuffer(AudioDecoder* decoder);
+
+    /** Decodes the compressed data to the buffer when it isn't, decoded is set when it was. */
+    bool decodeCompressed(bool& decoded);
+    bool isBufferDecoded() const;
+
+    /** Deletes the decoded buffer of the compressed data, it must not be attached to a source. */
+    void releaseBuffer();
+
     void invokingPlayCallbacks();
 
     void invokingLoadCallbacks();
@@ -95,6 +107,7 @@ protected:
     std::vector<std::function<void(bool)>> _loadCallbacks;
 
     std::mutex _readDataTaskMutex;
+    std::mutex _decodeMutex;
 
     State _state;
 
@@ -104,8 +117,16 @@ protected:
     bool _isLoadingFinished;
     bool _isSkipReadDataTask;
 
+    /* Compressed short effects, see AudioEngine::setDecodedCacheBudget
+     * The file is kept when the decoded data of a short effect is at least twice bigger, it's decoded when played.
+     */
+    bool _keepCompressed;
+    std::shared_ptr<Data> _compressedData;
+    uint32_t _pcmSize;
+
     friend class AudioEngineImpl;
     friend class AudioPlayer;
+    friend class AudioStreamer;
 };
 
 }
@@ -0,0 +1,171 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "audio/AudioConvert.h"
+#include "base/Macros.h"
+
+#include <algorithm>
+#include <cmath>
+
+// the NEON kernels round with vcvtnq, which only AArch64 has
+#if defined(AX_SSE_INTRINSICS)
+#    define AX_AUDIO_SSE 1
+#elif defined(AX_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define AX_AUDIO_NEON 1
+#endif
+
+namespace ax
+{
+
+namespace AudioConvert
+{
+
+static constexpr float S16_SCALE = 32768.0f;
+static constexpr float S32_SCALE = 1.0f / 2147483648.0f;
+
+static inline int16_t toS16(float v)
+{
+    v = std::min(std::max(v * S16_SCALE, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(std::lrintf(v));
+}
+
+#if defined(AX_AUDIO_SSE)
+static inline __m128i toS32x4(__m128 v)
+{
+    v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, _mm_set1_ps(S16_SCALE)), _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+    return _mm_cvtps_epi32(v);
+}
+#elif defined(AX_AUDIO_NEON)
+static inline int16x4_t toS16x4(float32x4_t v)
+{
+    v = vminq_f32(vmaxq_f32(vmulq_n_f32(v, S16_SCALE), vdupq_n_f32(-32768.0f)), vdupq_n_f32(32767.0f));
+    return vqmovn_s32(vcvtnq_s32_f32(v));
+}
+#endif
+
+void planarFloatToS16(const float* const* planes, uint32_t channels, size_t frames, int16_t* dst)
+{
+    size_t i = 0;
+    if (channels == 1)
+    {
+        const float* mono = planes[0];
+#if defined(AX_AUDIO_SSE)
+        for (; i + 8 <= frames; i += 8)
+        {
+            __m128i lo = toS32x4(_mm_loadu_ps(mono + i));
+            __m128i hi = toS32x4(_mm_loadu_ps(mono + i + 4));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(lo, hi));
+        }
+#elif defined(AX_AUDIO_NEON)
+        for (; i + 8 <= frames; i += 8)
+            vst1q_s16(dst + i, vcombine_s16(toS16x4(vld1q_f32(mono + i)), toS16x4(vld1q_f32(mono + i + 4))));
+#endif
+        for (; i < frames; ++i)
+            dst[i] = toS16(mono[i]);
+    }
+    else if (channels == 2)
+    {
+        const float* left  = planes[0];
+        const float* right = planes[1];
+#if defined(AX_AUDIO_SSE)
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128i l = toS32x4(_mm_loadu_ps(left + i));
+            __m128i r = toS32x4(_mm_loadu_ps(right + i));
+            __m128i lr = _mm_packs_epi32(_mm_unpacklo_epi32(l, r), _mm_unpackhi_epi32(l, r));
+            _mm_storeu_si128((__m128i*)(dst + i * 2), lr);
+        }
+#elif defined(AX_AUDIO_NEON)
+        for (; i + 8 <= frames; i += 8)
+        {
+            int16x8x2_t lr;
+            lr.val[0] = vcombine_s16(toS16x4(vld1q_f32(left + i)), toS16x4(vld1q_f32(left + i + 4)));
+            lr.val[1] = vcombine_s16(toS16x4(vld1q_f32(right + i)), toS16x4(vld1q_f32(right + i + 4)));
+            vst2q_s16(dst + i * 2, lr);
+        }
+#endif
+        for (; i < frames; ++i)
+        {
+            dst[i * 2]     = toS16(left[i]);
+            dst[i * 2 + 1] = toS16(right[i]);
+        }
+    }
+    else
+    {
+        for (; i < frames; ++i)
+        {
+            for (uint32_t c = 0; c < channels; ++c)
+                *dst++ = toS16(planes[c][i]);
+        }
+    }
+}
+
+void s24ToFloat(const uint8_t* src, size_t samples, float* dst)
+{
+    size_t i = 0;
+    // SSE2 has no byte shuffle to spread the 3 bytes samples, it keeps the scalar loop
+#if defined(AX_AUDIO_NEON)
+    for (; i + 16 <= samples; i += 16)
+    {
+        // the bytes of a sample land in the upper 24 bits of a 32 bits lane
+        uint8x16x3_t b  = vld3q_u8(src + i * 3);
+        uint8x16x2_t lo = vzipq_u8(vdupq_n_u8(0), b.val[0]);
+        uint8x16x2_t hi = vzipq_u8(b.val[1], b.val[2]);
+        for (int k = 0; k < 2; ++k)
+        {
+            uint16x8x2_t w = vzipq_u16(vreinterpretq_u16_u8(lo.val[k]), vreinterpretq_u16_u8(hi.val[k]));
+            for (int m = 0; m < 2; ++m)
+            {
+                float32x4_t v = vcvtq_f32_s32(vreinterpretq_s32_u16(w.val[m]));
+                vst1q_f32(dst + i + k * 8 + m * 4, vmulq_n_f32(v, S32_SCALE));
+            }
+        }
+    }
+#endif
+    for (; i < samples; ++i)
+    {
+        const uint8_t* p = src + i * 3;
+        auto v = static_cast<int32_t>(uint32_t{p[0]} << 8 | uint32_t{p[1]} << 16 | uint32_t{p[2]} << 24);
+        dst[i] = static_cast<float>(v) * S32_SCALE;
+    }
+}
+
+void s32ToFloat(const int32_t* src, size_t samples, float* dst)
+{
+    size_t i = 0;
+#if defined(AX_AUDIO_SSE)
+    const __m128 scale = _mm_set1_ps(S32_SCALE);
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(src + i))), scale));
+#elif defined(AX_AUDIO_NEON)
+    for (; i + 4 <= samples; i += 4)
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + i)), S32_SCALE));
+#endif
+    for (; i < samples; ++i)
+        dst[i] = static_cast<float>(src[i]) * S32_SCALE;
+}
+
+}  // namespace AudioConvert
+
+}  // namespace ax
@@ -0,0 +1,57 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * The PCM sample conversions of the audio decoders, for the formats the decoder libraries or OpenAL don't take
+ * directly. The bulk of the samples is converted with SSE2 or NEON, the remainder with the scalar code, both give
+ * the same samples.
+ */
+namespace AudioConvert
+{
+
+/**
+ * Interleaves the channel planes of float samples, e.g. the output of ov_read_float, into 16 bits samples.
+ * The samples are scaled by 32768, rounded to the nearest and clamped, like ov_read does.
+ */
+AX_DLL void planarFloatToS16(const float* const* planes, uint32_t channels, size_t frames, int16_t* dst);
+
+/** Converts packed little endian 24 bits samples to float samples in [-1, 1). */
+AX_DLL void s24ToFloat(const uint8_t* src, size_t samples, float* dst);
+
+/** Converts 32 bits samples to float samples in [-1, 1]. */
+AX_DLL void s32ToFloat(const int32_t* src, size_t samples, float* dst);
+
+}  // namespace AudioConvert
+
+}  // namespace ax
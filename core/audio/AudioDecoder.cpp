@@ -33,6 +33,51 @@
 namespace ax
 {
 
+namespace
+{
+class MemorySourceStream : public IFileStream
+{
+public:
+    explicit MemorySourceStream(std::shared_ptr<const Data> data) : _data(std::move(data)) {}
+
+    bool open(std::string_view, IFileStream::Mode) override { return false; }
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        int64_t position = origin == SEEK_SET ? offset : (origin == SEEK_CUR ? _position + offset : size() + offset);
+        if (!_data || position < 0)
+            return -1;
+        _position = (std::min)(position, size());
+        return _position;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_data)
+            return -1;
+        auto count = static_cast<unsigned int>((std::min)(static_cast<int64_t>(size), this->size() - _position));
+        if (count > 0)
+            memcpy(buf, _data->getBytes() + _position, count);
+        _position += count;
+        return static_cast<int>(count);
+    }
+
+    int write(const void*, unsigned int) const override { return -1; }
+    int64_t tell() const override { return _data ? _position : -1; }
+    int64_t size() const override { return _data ? _data->getSize() : -1; }
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const Data> _data;
+    mutable int64_t _position = 0;
+};
+}  // namespace
+
 AudioDecoder::AudioDecoder()
     : _isOpened(false)
     , _totalFrames(0)
@@ -45,6 +90,13 @@ AudioDecoder::AudioDecoder()
 
 AudioDecoder::~AudioDecoder() {}
 
+std::unique_ptr<IFileStream> AudioDecoder::openStream(std::string_view path) const
+{
+    if (_memorySource)
+        return std::make_unique<MemorySourceStream>(_memorySource);
+    return FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+}
+
 bool AudioDecoder::isOpened() const
 {
     return _isOpened;
@@ -27,8 +27,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 #include <string>
 #include "platform/IFileStream.h"
+#include "base/Data.h"
 
 namespace ax
 {
@@ -52,7 +54,7 @@ enum class AUDIO_SOURCE_FORMAT : uint16_t
 /**
  * @brief The class for decoding compressed audio file to PCM buffer.
  */
-class AudioDecoder
+class AX_DLL AudioDecoder
 {
 public:
     static const uint32_t INVALID_FRAME_INDEX = UINT32_MAX;
@@ -63,6 +65,12 @@ public:
      */
     virtual bool open(std::string_view path) = 0;
 
+    /**
+     * @brief Decodes a copy of the file kept in memory instead of reading the file, call it before open.
+     * @note The .ogg decoder and the minimp3 .mp3 decoder support it, the others read the file.
+     */
+    void setMemorySource(std::shared_ptr<const Data> data) { _memorySource = std::move(data); }
+
     /**
      * @brief Checks whether decoder has opened file successfully.
      * @return true if succeed, otherwise false.
@@ -138,6 +146,10 @@ protected:
     AudioDecoder();
     virtual ~AudioDecoder();
 
+    /** Opens the file, or a stream over the memory source when one is set. */
+    std::unique_ptr<IFileStream> openStream(std::string_view path) const;
+
+    std::shared_ptr<const Data> _memorySource;
     bool _isOpened;
     uint32_t _totalFrames;
     uint32_t _bytesPerBlock;  // Same as bytesPerFrame when _samplesPerBlock is 1
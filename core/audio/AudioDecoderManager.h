@@ -34,7 +34,7 @@ namespace ax
 
 class AudioDecoder;
 
-class AudioDecoderManager
+class AX_DLL AudioDecoderManager
 {
 public:
     static bool init();
@@ -131,7 +131,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !AX_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = openStream(fullPath);
         if (!_fileStream)
         {
             AXLOGE("Trouble with minimp3(1): {}\n", strerror(errno));
@@ -27,6 +27,7 @@
 #define LOG_TAG "AudioDecoderOgg"
 
 #include "audio/AudioDecoderOgg.h"
+#include "audio/AudioConvert.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 
@@ -72,7 +73,7 @@ AudioDecoderOgg::~AudioDecoderOgg()
 
 bool AudioDecoderOgg::open(std::string_view fullPath)
 {
-    auto fs = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto fs = openStream(fullPath).release();
     if (!fs)
     {
         AXLOGE("Trouble with ogg(1): {}\n", strerror(errno));
@@ -106,10 +107,20 @@ void AudioDecoderOgg::close()
 
 uint32_t AudioDecoderOgg::read(uint32_t framesToRead, char* pcmBuf)
 {
+    // decodes to float, the conversion to 16 bits samples is vectorized unlike the one of ov_read
+    float** planes     = nullptr;
     int currentSection = 0;
-    int bytesToRead    = framesToBytes(framesToRead);
-    int32_t bytesRead  = static_cast<int32_t>(ov_read(&_vf, pcmBuf, bytesToRead, 0, 2, 1, &currentSection));
-    return bytesToFrames(bytesRead);
+    long framesRead;
+    do
+        framesRead = ov_read_float(&_vf, &planes, static_cast<int>(framesToRead), &currentSection);
+    while (framesRead == OV_HOLE);  // a gap in the data, the decoding goes on after it
+
+    if (framesRead <= 0)
+        return 0;
+
+    AudioConvert::planarFloatToS16(planes, _channelCount, static_cast<size_t>(framesRead),
+                                   reinterpret_cast<int16_t*>(pcmBuf));
+    return static_cast<uint32_t>(framesRead);
 }
 
 bool AudioDecoderOgg::seek(uint32_t frameOffset)
@@ -27,6 +27,7 @@
 #include <stddef.h>
 #include <assert.h>
 #include "audio/AudioDecoderWav.h"
+#include "audio/AudioConvert.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 
@@ -107,8 +108,23 @@ static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
 
     int bitDepth = (fmtInfo.BitsPerSample);
 
+    // The extensible format gives the PCM or float format in its sub-format
+    auto audioFormat = fmtInfo.AudioFormat;
+    if (audioFormat == WAV_FORMAT::EXT)
+    {
+        if (IsEqualGUID(fmtInfo.ExtParams.SubFormat, WAV_SUBTYPE_PCM))
+            audioFormat = WAV_FORMAT::PCM;
+        else if (IsEqualGUID(fmtInfo.ExtParams.SubFormat, WAV_SUBTYPE_IEEE_FLOAT))
+            audioFormat = WAV_FORMAT::IEEE;
+        else
+        {
+            fileStream.reset();
+            return false;
+        }
+    }
+
     // Read PCM data or extensible data if exists.
-    switch (fmtInfo.AudioFormat)
+    switch (audioFormat)
     {  // Check supported format
     case WAV_FORMAT::PCM:
     case WAV_FORMAT::IEEE:
@@ -124,11 +140,11 @@ static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
             wavf->SourceFormat = AUDIO_SOURCE_FORMAT::PCM_24;
             break;
         case 32:
-            wavf->SourceFormat = (fmtInfo.AudioFormat == WAV_FORMAT::IEEE) ? AUDIO_SOURCE_FORMAT::PCM_FLT32
+            wavf->SourceFormat = (audioFormat == WAV_FORMAT::IEEE) ? AUDIO_SOURCE_FORMAT::PCM_FLT32
                                                                            : AUDIO_SOURCE_FORMAT::PCM_32;
             break;
         case 64:
-            wavf->SourceFormat = (fmtInfo.AudioFormat == WAV_FORMAT::IEEE) ? AUDIO_SOURCE_FORMAT::PCM_FLT64
+            wavf->SourceFormat = (audioFormat == WAV_FORMAT::IEEE) ? AUDIO_SOURCE_FORMAT::PCM_FLT64
                                                                            : AUDIO_SOURCE_FORMAT::PCM_64;
             break;
         }
@@ -137,7 +153,7 @@ static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
         wavf->SourceFormat = AUDIO_SOURCE_FORMAT::MULAW;
         break;
     case WAV_FORMAT::ALAW:
-        wavf->SourceFormat = AUDIO_SOURCE_FORMAT::MULAW;
+        wavf->SourceFormat = AUDIO_SOURCE_FORMAT::ALAW;
         break;
     case WAV_FORMAT::ADPCM:
         wavf->SourceFormat = AUDIO_SOURCE_FORMAT::ADPCM;
@@ -145,15 +161,6 @@ static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
     case WAV_FORMAT::IMA_ADPCM:
         wavf->SourceFormat = AUDIO_SOURCE_FORMAT::IMA_ADPCM;
         break;
-    case WAV_FORMAT::EXT:
-        // Check sub-format.
-        if (!IsEqualGUID(fmtInfo.ExtParams.SubFormat, WAV_SUBTYPE_PCM) &&
-            !IsEqualGUID(fmtInfo.ExtParams.SubFormat, WAV_SUBTYPE_IEEE_FLOAT))
-        {
-            fileStream.reset();
-            return false;
-        }
-        break;
     default:
         AXLOGW("The wav format {} doesn't supported currently!", (int)fmtInfo.AudioFormat);
         fileStream.reset();
@@ -217,6 +224,13 @@ bool AudioDecoderWav::open(std::string_view fullPath)
 
         _totalFrames = bytesToFrames(_wavf.FileHeader.PcmData.ChunkSize);
 
+        // OpenAL has no 24 and 32 bits integer formats, their samples are converted to float when read
+        if (_sourceFormat == AUDIO_SOURCE_FORMAT::PCM_24 || _sourceFormat == AUDIO_SOURCE_FORMAT::PCM_32)
+        {
+            _sourceFormat  = AUDIO_SOURCE_FORMAT::PCM_FLT32;
+            _bytesPerBlock = sizeof(float) * _channelCount;
+        }
+
         _isOpened = true;
         return true;
     }
@@ -249,14 +263,35 @@ void AudioDecoderWav::close()
 
 uint32_t AudioDecoderWav::read(uint32_t framesToRead, char* pcmBuf)
 {
-    auto bytesToRead  = framesToBytes(framesToRead);
-    int32_t bytesRead = wav_read(&_wavf, pcmBuf, bytesToRead);
-    return bytesToFrames(bytesRead);
+    if (_wavf.SourceFormat == _sourceFormat)
+    {
+        auto bytesToRead  = framesToBytes(framesToRead);
+        int32_t bytesRead = wav_read(&_wavf, pcmBuf, bytesToRead);
+        return bytesToFrames(bytesRead);
+    }
+
+    const uint32_t blockAlign = _wavf.FileHeader.Fmt.BlockAlign;
+    _readBuffer.resize(static_cast<size_t>(framesToRead) * blockAlign);
+    int32_t bytesRead = wav_read(&_wavf, _readBuffer.data(), framesToRead * blockAlign);
+    if (bytesRead <= 0)
+        return 0;
+
+    const uint32_t framesRead = bytesRead / blockAlign;
+    const size_t samples      = static_cast<size_t>(framesRead) * _channelCount;
+    if (_wavf.SourceFormat == AUDIO_SOURCE_FORMAT::PCM_24)
+        AudioConvert::s24ToFloat(reinterpret_cast<const uint8_t*>(_readBuffer.data()), samples,
+                                 reinterpret_cast<float*>(pcmBuf));
+    else
+        AudioConvert::s32ToFloat(reinterpret_cast<const int32_t*>(_readBuffer.data()), samples,
+                                 reinterpret_cast<float*>(pcmBuf));
+    return framesRead;
 }
 
 bool AudioDecoderWav::seek(uint32_t frameOffset)
 {
-    auto offset = framesToBytes(frameOffset);
+    // the file offset, the frames of the converted formats are smaller in the file
+    auto offset = _wavf.SourceFormat == _sourceFormat ? framesToBytes(frameOffset)
+                                                      : frameOffset * _wavf.FileHeader.Fmt.BlockAlign;
     return wav_seek(&_wavf, offset) == offset;
 }
 }  // namespace ax
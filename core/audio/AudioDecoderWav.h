@@ -26,6 +26,7 @@
 
 #include "audio/AudioDecoder.h"
 #include <memory>
+#include <vector>
 
 #if !defined(MAKE_FOURCC)
 #    define MAKE_FOURCC(a, b, c, d) ((uint32_t)((a) | ((b) << 8) | ((c) << 16) | (((uint32_t)(d)) << 24)))
@@ -169,6 +170,7 @@ protected:
     ~AudioDecoderWav();
 
     mutable WAV_FILE _wavf;
+    std::vector<char> _readBuffer;  // the file samples of the formats converted when read
 };
 
 }  // namespace ax
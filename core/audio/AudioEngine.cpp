@@ -27,10 +27,14 @@
 #include "platform/PlatformConfig.h"
 
 #include "audio/AudioEngine.h"
+#include <algorithm>
+#include <cmath>
 #include <condition_variable>
 #include <queue>
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
 
 #include "audio/AudioEngineImpl.h"
 
@@ -51,14 +55,28 @@ hlookup::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 hlookup::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
 unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+size_t AudioEngine::_decodedCacheBudget                        = 0;
+bool AudioEngine::_lowLatencyOutput                            = false;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
 
 bool AudioEngine::_isEnabled                                  = true;
+std::vector<AUDIO_ID> AudioEngine::_pendingVoices;
+std::vector<AUDIO_ID> AudioEngine::_virtualVoices;
+bool AudioEngine::_voicesScheduled = false;
 
 AudioEngine::AudioInfo::AudioInfo()
-    : profileHelper(nullptr), volume(1.0f), loop(false), duration(TIME_UNKNOWN), state(AudioState::INITIALIZING)
+    : profileHelper(nullptr)
+    , volume(1.0f)
+    , pitch(1.0f)
+    , loop(false)
+    , duration(TIME_UNKNOWN)
+    , state(AudioState::INITIALIZING)
+    , priority(0)
+    , time(0.0f)
+    , virtualize(false)
+    , voice(VoiceState::PENDING)
 {}
 
 AudioEngine::AudioInfo::~AudioInfo() {}
@@ -69,6 +87,12 @@ void AudioEngine::end()
     // fix #127
     uncacheAll();
 
+    if (_voicesScheduled)
+    {
+        _voicesScheduled = false;
+        Director::getInstance()->getScheduler()->unschedule("AudioEngine::updateVoices", _audioEngineImpl);
+    }
+
     delete _audioEngineImpl;
     _audioEngineImpl = nullptr;
 
@@ -94,7 +118,7 @@ bool AudioEngine::lazyInit()
 
 AUDIO_ID AudioEngine::play2d(std::string_view filePath, bool loop, float volume, const AudioProfile* profile)
 {
-    return play2d(filePath, ax::AudioPlayerSettings{loop, volume, 0.0f});
+    return play2d(filePath, ax::AudioPlayerSettings{loop, volume, 0.0f}, profile);
 }
 
 AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSettings& settings, const AudioProfile* profile)
@@ -126,29 +150,15 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSetting
             profileHelper->profile = *profile;
         }
 
-        if (_audioIDInfoMap.size() >= _maxInstances)
-        {
-            AXLOGE("Fail to play {} cause by limited max instance of AudioEngine", filePath);
-            break;
-        }
-        if (profileHelper)
+        if (profileHelper && profileHelper->profile.minDelay > TIME_DELAY_PRECISION)
         {
-            if (profileHelper->profile.maxInstances != 0 &&
-                profileHelper->audioIDs.size() >= profileHelper->profile.maxInstances)
+            auto currTime = utils::gettime();
+            if (profileHelper->lastPlayTime > TIME_DELAY_PRECISION &&
+                currTime - profileHelper->lastPlayTime <= profileHelper->profile.minDelay)
             {
-                AXLOGE("Fail to play {} cause by limited max instance of AudioProfile", filePath);
+                AXLOGE("Fail to play {} cause by limited minimum delay", filePath);
                 break;
             }
-            if (profileHelper->profile.minDelay > TIME_DELAY_PRECISION)
-            {
-                auto currTime = utils::gettime();
-                if (profileHelper->lastPlayTime > TIME_DELAY_PRECISION &&
-                    currTime - profileHelper->lastPlayTime <= profileHelper->profile.minDelay)
-                {
-                    AXLOGE("Fail to play {} cause by limited minimum delay", filePath);
-                    break;
-                }
-            }
         }
 
         float volume = settings.volume;
@@ -161,24 +171,30 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSetting
             volume = 1.0f;
         }
 
-        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time);
-        if (ret != INVALID_AUDIO_ID)
-        {
-            _audioPathIDMap[filePath.data()].emplace_back(ret);
-            auto it = _audioPathIDMap.find(filePath);
+        // the voice is played by the voice update at the end of the frame, by the order of the priorities
+        _audioEngineImpl->preload(filePath, nullptr);
+        ret = _audioEngineImpl->newAudioID();
 
-            auto& audioRef    = _audioIDInfoMap[ret];
-            audioRef.volume   = volume;
-            audioRef.loop     = settings.loop;
-            audioRef.filePath = it->first;
+        _audioPathIDMap[filePath.data()].emplace_back(ret);
+        auto it = _audioPathIDMap.find(filePath);
 
-            if (profileHelper)
-            {
-                profileHelper->lastPlayTime = utils::gettime();
-                profileHelper->audioIDs.emplace_back(ret);
-            }
-            audioRef.profileHelper = profileHelper;
+        auto& audioRef      = _audioIDInfoMap[ret];
+        audioRef.volume     = volume;
+        audioRef.loop       = settings.loop;
+        audioRef.filePath   = it->first;
+        audioRef.priority   = settings.priority;
+        audioRef.time       = std::max(settings.time, 0.0f);
+        audioRef.virtualize = settings.virtualize;
+
+        if (profileHelper)
+        {
+            profileHelper->lastPlayTime = utils::gettime();
+            profileHelper->audioIDs.emplace_back(ret);
         }
+        audioRef.profileHelper = profileHelper;
+
+        _pendingVoices.emplace_back(ret);
+        scheduleVoiceUpdate();
     } while (0);
 
     return ret;
@@ -189,7 +205,8 @@ void AudioEngine::setLoop(AUDIO_ID audioID, bool loop)
     auto it = _audioIDInfoMap.find(audioID);
     if (it != _audioIDInfoMap.end() && it->second.loop != loop)
     {
-        _audioEngineImpl->setLoop(audioID, loop);
+        if (it->second.voice == VoiceState::REAL)
+            _audioEngineImpl->setLoop(audioID, loop);
         it->second.loop = loop;
     }
 }
@@ -203,8 +220,15 @@ void AudioEngine::setVolume(AUDIO_ID audioID, float volume)
 
         if (it->second.volume != volume)
         {
-            _audioEngineImpl->setVolume(audioID, volume);
             it->second.volume = volume;
+
+            // a silent voice is virtual, it gets a voice back by the voice update
+            if (it->second.voice != VoiceState::REAL)
+                scheduleVoiceUpdate();
+            else if (volume > 0.0f)
+                _audioEngineImpl->setVolume(audioID, volume);
+            else
+                virtualizeVoice(audioID, it->second);
         }
     }
 }
@@ -218,7 +242,8 @@ void AudioEngine::setPitch(AUDIO_ID audioID, float pitch)
 
         if (it->second.pitch != pitch)
         {
-            _audioEngineImpl->setPitch(audioID, pitch);
+            if (it->second.voice == VoiceState::REAL)
+                _audioEngineImpl->setPitch(audioID, pitch);
             it->second.pitch = pitch;
         }
     }
@@ -298,6 +323,11 @@ void AudioEngine::remove(AUDIO_ID audioID)
     auto it = _audioIDInfoMap.find(audioID);
     if (it != _audioIDInfoMap.end())
     {
+        auto& voices = it->second.voice == VoiceState::PENDING ? _pendingVoices : _virtualVoices;
+        auto voiceIt = std::find(voices.begin(), voices.end(), audioID);
+        if (voiceIt != voices.end())
+            voices.erase(voiceIt);
+
         if (it->second.profileHelper)
         {
             it->second.profileHelper->audioIDs.remove(audioID);
@@ -324,6 +354,8 @@ void AudioEngine::stopAll()
     }
     _audioPathIDMap.clear();
     _audioIDInfoMap.clear();
+    _pendingVoices.clear();
+    _virtualVoices.clear();
 }
 
 void AudioEngine::uncache(std::string_view filePath)
@@ -380,7 +412,9 @@ float AudioEngine::getDuration(AUDIO_ID audioID)
     {
         if (it->second.duration == TIME_UNKNOWN)
         {
-            it->second.duration = _audioEngineImpl->getDuration(audioID);
+            it->second.duration = it->second.voice == VoiceState::REAL
+                                      ? _audioEngineImpl->getDuration(audioID)
+                                      : _audioEngineImpl->getFileDuration(it->second.filePath);
         }
         return it->second.duration;
     }
@@ -391,6 +425,11 @@ float AudioEngine::getDuration(AUDIO_ID audioID)
 bool AudioEngine::setCurrentTime(AUDIO_ID audioID, float time)
 {
     auto it = _audioIDInfoMap.find(audioID);
+    if (it != _audioIDInfoMap.end() && it->second.voice != VoiceState::REAL)
+    {
+        it->second.time = std::max(time, 0.0f);
+        return true;
+    }
     if (it != _audioIDInfoMap.end() && it->second.state != AudioState::INITIALIZING)
     {
         return _audioEngineImpl->setCurrentTime(audioID, time);
@@ -402,6 +441,10 @@ bool AudioEngine::setCurrentTime(AUDIO_ID audioID, float time)
 float AudioEngine::getCurrentTime(AUDIO_ID audioID)
 {
     auto it = _audioIDInfoMap.find(audioID);
+    if (it != _audioIDInfoMap.end() && it->second.voice != VoiceState::REAL)
+    {
+        return it->second.time;
+    }
     if (it != _audioIDInfoMap.end() && it->second.state != AudioState::INITIALIZING)
     {
         return _audioEngineImpl->getCurrentTime(audioID);
@@ -414,7 +457,9 @@ void AudioEngine::setFinishCallback(AUDIO_ID audioID, const std::function<void(A
     auto it = _audioIDInfoMap.find(audioID);
     if (it != _audioIDInfoMap.end())
     {
-        _audioEngineImpl->setFinishCallback(audioID, callback);
+        it->second.finishCallback = callback;
+        if (it->second.voice == VoiceState::REAL)
+            _audioEngineImpl->setFinishCallback(audioID, callback);
     }
 }
 
@@ -534,6 +579,207 @@ int AudioEngine::getPlayingAudioCount()
     return static_cast<int>(_audioIDInfoMap.size());
 }
 
+bool AudioEngine::isVirtual(AUDIO_ID audioID)
+{
+    auto it = _audioIDInfoMap.find(audioID);
+    return it != _audioIDInfoMap.end() && it->second.voice == VoiceState::VIRTUAL;
+}
+
+void AudioEngine::scheduleVoiceUpdate()
+{
+    if (!_voicesScheduled && _audioEngineImpl)
+    {
+        _voicesScheduled = true;
+        Director::getInstance()->getScheduler()->schedule(&AudioEngine::updateVoices, _audioEngineImpl, 0.0f, false,
+                                                          "AudioEngine::updateVoices");
+    }
+}
+
+void AudioEngine::updateVoices(float dt)
+{
+    // the virtual voices keep their position, and finish like the real ones
+    auto virtualVoices = _virtualVoices;
+    for (auto audioID : virtualVoices)
+    {
+        auto it = _audioIDInfoMap.find(audioID);
+        if (it == _audioIDInfoMap.end() || it->second.state == AudioState::PAUSED)
+            continue;
+
+        auto& info = it->second;
+        info.time += dt * info.pitch;
+
+        auto duration = getDuration(audioID);
+        if (duration > 0.0f && info.time >= duration)
+        {
+            if (info.loop)
+            {
+                info.time = std::fmod(info.time, duration);
+            }
+            else
+            {
+                auto finishCallback = std::move(info.finishCallback);
+                std::string filePath{info.filePath};
+                remove(audioID);
+                if (finishCallback)
+                    finishCallback(audioID, filePath);
+            }
+        }
+    }
+
+    // the new voices and the audible virtual ones, by the order of their priorities then the oldest first
+    std::vector<AUDIO_ID> candidates;
+    candidates.swap(_pendingVoices);
+    for (auto vit = _virtualVoices.begin(); vit != _virtualVoices.end();)
+    {
+        // uncache drops the instances of a file without removing them
+        auto it = _audioIDInfoMap.find(*vit);
+        if (it == _audioIDInfoMap.end())
+        {
+            vit = _virtualVoices.erase(vit);
+            continue;
+        }
+        if (it->second.volume > 0.0f && it->second.state != AudioState::PAUSED)
+            candidates.emplace_back(*vit);
+        ++vit;
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](AUDIO_ID lhs, AUDIO_ID rhs) {
+        auto lhsPriority = _audioIDInfoMap[lhs].priority;
+        auto rhsPriority = _audioIDInfoMap[rhs].priority;
+        return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : lhs < rhs;
+    });
+
+    for (auto audioID : candidates)
+    {
+        auto it = _audioIDInfoMap.find(audioID);
+        if (it == _audioIDInfoMap.end())
+            continue;
+
+        auto& info      = it->second;
+        auto wasVirtual = info.voice == VoiceState::VIRTUAL;
+        if (realizeVoice(audioID, info))
+        {
+            if (wasVirtual)
+                _virtualVoices.erase(std::find(_virtualVoices.begin(), _virtualVoices.end(), audioID));
+        }
+        else if (!wasVirtual)
+        {
+            if (info.virtualize || info.volume <= 0.0f)
+            {
+                info.voice = VoiceState::VIRTUAL;
+                info.state = AudioState::PLAYING;
+                _virtualVoices.emplace_back(audioID);
+            }
+            else
+            {
+                AXLOGW("Fail to play {} cause by the voices used by higher priorities", info.filePath);
+                remove(audioID);
+            }
+        }
+    }
+
+    if (_pendingVoices.empty() && _virtualVoices.empty())
+    {
+        _voicesScheduled = false;
+        Director::getInstance()->getScheduler()->unschedule("AudioEngine::updateVoices", _audioEngineImpl);
+    }
+}
+
+bool AudioEngine::realizeVoice(AUDIO_ID audioID, AudioInfo& info)
+{
+    if (info.volume <= 0.0f || !makeRoom(info))
+        return false;
+
+    if (!_audioEngineImpl->play2d(audioID, info.filePath, info.loop, info.volume, info.time))
+        return false;
+
+    info.voice = VoiceState::REAL;
+    if (info.pitch != 1.0f)
+        _audioEngineImpl->setPitch(audioID, info.pitch);
+    if (info.finishCallback)
+        _audioEngineImpl->setFinishCallback(audioID, info.finishCallback);
+    return true;
+}
+
+bool AudioEngine::makeRoom(const AudioInfo& info)
+{
+    auto profileHelper = info.profileHelper;
+    for (;;)
+    {
+        unsigned int voiceCount   = 0;
+        unsigned int profileCount = 0;
+        for (auto&& item : _audioIDInfoMap)
+        {
+            if (item.second.voice == VoiceState::REAL)
+            {
+                ++voiceCount;
+                if (item.second.profileHelper == profileHelper)
+                    ++profileCount;
+            }
+        }
+
+        bool profileFull = profileHelper && profileHelper->profile.maxInstances != 0 &&
+                           profileCount >= profileHelper->profile.maxInstances;
+        bool engineFull  = voiceCount >= _maxInstances || !_audioEngineImpl->hasFreeSource();
+        if (!profileFull && !engineFull)
+            return true;
+
+        // the lowest priority, the oldest first, in the profile when it is the limit
+        AUDIO_ID victimID  = INVALID_AUDIO_ID;
+        AudioInfo* victim = nullptr;
+        for (auto&& item : _audioIDInfoMap)
+        {
+            auto& other = item.second;
+            if (other.voice != VoiceState::REAL || other.priority >= info.priority ||
+                (profileFull && other.profileHelper != profileHelper))
+                continue;
+            if (!victim || other.priority < victim->priority ||
+                (other.priority == victim->priority && item.first < victimID))
+            {
+                victimID = item.first;
+                victim   = &other;
+            }
+        }
+
+        if (!victim)
+            return false;
+
+        if (victim->virtualize)
+            virtualizeVoice(victimID, *victim);
+        else
+            stop(victimID);
+    }
+}
+
+void AudioEngine::virtualizeVoice(AUDIO_ID audioID, AudioInfo& info)
+{
+    auto time = _audioEngineImpl->virtualize(audioID);
+    if (time > 0.0f)
+        info.time = time;
+    info.voice = VoiceState::VIRTUAL;
+    info.state = info.state == AudioState::INITIALIZING ? AudioState::PLAYING : info.state;
+    _virtualVoices.emplace_back(audioID);
+    scheduleVoiceUpdate();
+}
+
+void AudioEngine::setDecodedCacheBudget(size_t budget)
+{
+    _decodedCacheBudget = budget;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->trimDecodedCaches();
+    }
+}
+
+AudioEngine::CacheStats AudioEngine::getCacheStats()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getCacheStats() : CacheStats{};
+}
+
+float AudioEngine::getOutputLatency()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getOutputLatency() : TIME_UNKNOWN;
+}
+
 void AudioEngine::setEnabled(bool isEnabled)
 {
     if (_isEnabled != isEnabled)
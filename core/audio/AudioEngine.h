@@ -33,6 +33,7 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifdef ERROR
 #    undef ERROR
@@ -57,6 +58,8 @@ struct AX_DLL AudioPlayerSettings
     bool loop = false; // Whether audio instance loop or not.
     float volume = 1.0f; // Volume value (range from 0.0 to 1.0).
     float time = 0.0f; // The initial time offset when play audio
+    int priority = 0; // The voices of a lower priority are stopped for it when the voices are all used.
+    bool virtualize = false; // Tracks its position silently when it has no voice, instead of being dropped.
 };
 
 /**
@@ -70,7 +73,7 @@ class AX_DLL AudioProfile
 public:
     // Profile name can't be empty.
     std::string name;
-    // The maximum number of simultaneous audio instance.
+    // The maximum number of simultaneous voices of the instances, a new instance takes the voice of a lower priority.
     unsigned int maxInstances;
 
     /* Minimum delay in between sounds */
@@ -107,6 +110,16 @@ public:
         PAUSED
     };
 
+    /** The memory used by the audio caches, see setDecodedCacheBudget. */
+    struct CacheStats
+    {
+        size_t compressedBytes = 0;  // the short effects kept compressed
+        size_t decodedBytes    = 0;  // the decoded effects, by the preload or when played
+        uint32_t hits          = 0;  // plays of a compressed effect which was decoded
+        uint32_t misses        = 0;  // plays of a compressed effect which had to be decoded
+        uint32_t evictions     = 0;  // decoded effects dropped over the budget
+    };
+
     static const int INVALID_AUDIO_ID;
 
     static const float TIME_UNKNOWN;
@@ -152,6 +165,10 @@ public:
      * @param profile A profile for audio instance. When profile is not specified, default profile will be used.
      * @return An audio ID. It allows you to dynamically change the behavior of an audio instance on the fly.
      *
+     * @note The instances played in a frame get their voices at the end of the frame, the highest priorities first.
+     * When the voices are all used, the voice of a lower priority instance is taken, otherwise the instance is
+     * dropped, or becomes virtual with the virtualize setting.
+     *
      * @see `AudioProfile`, `AudioPlayerSettings`
      */
     static AUDIO_ID play2d(std::string_view filePath,
@@ -338,6 +355,45 @@ public:
      */
     static int getPlayingAudioCount();
 
+    /**
+     * Checks whether an audio instance is virtual, it has no voice and only tracks its position.
+     * An instance is virtual while its volume is 0, or when it has the virtualize setting and was refused a voice or
+     * had its voice taken by a higher priority. It gets a voice back when one frees, by the order of the priorities.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     */
+    static bool isVirtual(AUDIO_ID audioID);
+
+    /**
+     * Keeps the short effects compressed in memory, they are decoded when played.
+     * The decoded effects which were played the most recently are kept up to budget bytes, the others are dropped and
+     * decoded again by their next play. An .ogg or .mp3 effect is kept compressed when it is at least twice smaller
+     * than decoded. 0, the default, decodes the short effects when they are preloaded and keeps them.
+     *
+     * @note It applies to the files preloaded after the call.
+     */
+    static void setDecodedCacheBudget(size_t budget);
+    static size_t getDecodedCacheBudget() { return _decodedCacheBudget; }
+
+    /** Gets the memory used by the audio caches. */
+    static CacheStats getCacheStats();
+
+    /**
+     * Requests the lowest output latency the device can give, for the games which play sounds in time with the input.
+     * On Android the output is mixed in smaller periods and, with the Oboe backend of an engine built with
+     * AX_WITH_OBOE, the stream is opened in the exclusive mode when the device allows it. It costs CPU time and battery.
+     *
+     * @note The device is opened once with the settings, it has to be called before the first use of AudioEngine.
+     */
+    static void setLowLatencyOutput(bool enabled) { _lowLatencyOutput = enabled; }
+    static bool isLowLatencyOutput() { return _lowLatencyOutput; }
+
+    /**
+     * Gets the time in seconds a sample takes from the mixer to the output, as reported by the device.
+     * It's TIME_UNKNOWN when the device doesn't report it or the AudioEngine isn't initialized.
+     */
+    static float getOutputLatency();
+
     /**
      * Whether to enable playing audios
      * @note If it's disabled, current playing audios will be stopped and the later 'preload', 'play2d' methods will
@@ -353,6 +409,23 @@ protected:
     static void addTask(const std::function<void()>& task);
     static void remove(AUDIO_ID audioID);
 
+    enum class VoiceState
+    {
+        PENDING,  // played by the next voice update
+        REAL,
+        VIRTUAL
+    };
+
+    struct AudioInfo;
+
+    /** Plays the pending voices by the order of their priorities, and tracks or revives the virtual ones. */
+    static void updateVoices(float dt);
+    static void scheduleVoiceUpdate();
+    static bool realizeVoice(AUDIO_ID audioID, AudioInfo& info);
+    /** Frees a voice within the limits for a new one, from a voice of a lower priority when they are used. */
+    static bool makeRoom(const AudioInfo& info);
+    static void virtualizeVoice(AUDIO_ID audioID, AudioInfo& info);
+
     struct ProfileHelper
     {
         AudioProfile profile;
@@ -375,6 +448,12 @@ protected:
         float duration;
         AudioState state;
 
+        int priority;
+        float time;  // the position to play from, tracked while the voice is virtual
+        bool virtualize;
+        VoiceState voice;
+        std::function<void(AUDIO_ID, std::string_view)> finishCallback;  // kept for a virtual voice
+
         AudioInfo();
         ~AudioInfo();
 
@@ -396,6 +475,15 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static size_t _decodedCacheBudget;
+
+    static bool _lowLatencyOutput;
+
+    // the voices waiting for the voice update, and the virtual ones
+    static std::vector<AUDIO_ID> _pendingVoices;
+    static std::vector<AUDIO_ID> _virtualVoices;
+    static bool _voicesScheduled;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
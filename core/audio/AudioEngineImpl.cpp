@@ -40,6 +40,9 @@
 #include "base/Scheduler.h"
 #include "base/Utils.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #if AX_USE_ALSOFT
 #    include "alc/inprogext.h"
 #endif
@@ -75,6 +78,30 @@ static void ccALResumeDevice()
 #endif
 }
 
+#if AX_USE_ALSOFT && AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
+// openal-soft reads its settings once, from the file ALSOFT_CONF names, when the first device is opened
+static void ccALConfigLowLatency()
+{
+    if (getenv("ALSOFT_CONF"))
+        return;  // the app ships its own settings
+
+    // 2 periods of 256 frames, about 5ms each at 48kHz, instead of 3 of 1024
+    static constexpr std::string_view config =
+        "[general]\n"
+        "period_size = 256\n"
+        "periods = 2\n"
+        "\n"
+        "[oboe]\n"
+        "exclusive = true\n";
+
+    auto path = ax::FileUtils::getInstance()->getWritablePath() + "alsoft.conf";
+    if (ax::FileUtils::getInstance()->writeStringToFile(config, path))
+        setenv("ALSOFT_CONF", path.c_str(), 1);
+    else
+        AXLOGW("Failed to write the low latency audio settings to {}", path);
+}
+#endif
+
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
 
 #    if TARGET_OS_SIMULATOR
@@ -308,24 +335,19 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
     if (notificationID != AL_BUFFERS_PROCESSED)
         return;
 
-    AudioPlayer* player = nullptr;
-    s_instance->_threadMutex.lock();
-    for (const auto& e : s_instance->_audioPlayers)
-    {
-        player = e.second;
-        if (player->_alSource == sid && player->_streamingSource)
-        {
-            player->wakeupRotateThread();
-        }
-    }
-    s_instance->_threadMutex.unlock();
+    s_instance->_streamer->wakeup();
 }
 #endif
 
 namespace ax
 {
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _streamer(std::make_unique<AudioStreamer>())
+    , _decodedBytes(0)
+    , _scheduled(false)
+    , _currentAudioID(0)
+    , _scheduler(nullptr)
 {
     s_instance = this;
 }
@@ -337,6 +359,9 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    // the streaming thread calls OpenAL, stop it before the context is destroyed
+    _streamer.reset();
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -371,6 +396,11 @@ bool AudioEngineImpl::init()
         s_AudioEngineSessionHandler = [[AudioEngineSessionHandler alloc] init];
 #endif
 
+#if AX_USE_ALSOFT && AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
+        if (AudioEngine::isLowLatencyOutput())
+            ccALConfigLowLatency();
+#endif
+
         s_ALDevice = alcOpenDevice(nullptr);
 
         if (s_ALDevice)
@@ -504,8 +534,9 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     {
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
-        audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        unsigned int cacheId      = audioCache->_id;
+        audioCache->_fileFullPath   = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_keepCompressed = AudioEngine::getDecodedCacheBudget() > 0;
+        unsigned int cacheId        = audioCache->_id;
         auto isCacheDestroyed     = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
             if (*isCacheDestroyed)
@@ -529,26 +560,27 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
-AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
+bool AudioEngineImpl::play2d(AUDIO_ID audioID, std::string_view filePath, bool loop, float volume, float time)
 {
     if (s_ALDevice == nullptr)
     {
-        return AudioEngine::INVALID_AUDIO_ID;
+        return false;
     }
 
     ALuint alSource = findValidSource();
     if (alSource == AL_INVALID)
     {
-        return AudioEngine::INVALID_AUDIO_ID;
+        return false;
     }
 
     auto player = new AudioPlayer;
     if (player == nullptr)
     {
-        return AudioEngine::INVALID_AUDIO_ID;
+        return false;
     }
 
     player->_alSource = alSource;
+    player->_streamer = _streamer.get();
     player->_loop     = loop;
     player->_volume   = volume;
     player->_pitch    = 1.0f;
@@ -562,15 +594,36 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     if (audioCache == nullptr)
     {
         delete player;
-        return AudioEngine::INVALID_AUDIO_ID;
+        _unusedSourcesPool.push(alSource);
+        return false;
     }
 
     player->setCache(audioCache);
     _threadMutex.lock();
-    _audioPlayers.emplace(++_currentAudioID, player);
+    _audioPlayers.emplace(audioID, player);
     _threadMutex.unlock();
 
-    audioCache->addPlayCallback(std::bind(&AudioEngineImpl::_play2d, this, audioCache, _currentAudioID));
+    if (audioCache->_state == AudioCache::State::READY && audioCache->_compressedData &&
+        !audioCache->isBufferDecoded())
+    {
+        // decode it on a worker rather than in the play call
+        AudioEngine::addTask([this, audioCache, audioID, isDestroyed = audioCache->_isDestroyed]() {
+            if (!*isDestroyed)
+            {
+                _play2d(audioCache, audioID);
+                return;
+            }
+
+            std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+            auto iter = _audioPlayers.find(audioID);
+            if (iter != _audioPlayers.end())
+                iter->second->_removeByAudioEngine = true;
+        });
+    }
+    else
+    {
+        audioCache->addPlayCallback(std::bind(&AudioEngineImpl::_play2d, this, audioCache, audioID));
+    }
 
     if (!_scheduled)
     {
@@ -578,11 +631,17 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
         _scheduler->schedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this, 0.05f, false);
     }
 
-    return _currentAudioID;
+    return true;
 }
 
 void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
 {
+    // A compressed effect is decoded before locking, the loading of the other caches plays under the lock
+    bool decoded   = false;
+    bool hasBuffer = true;
+    if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY && cache->_compressedData)
+        hasBuffer = cache->decodeCompressed(decoded);
+
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
     auto iter = _audioPlayers.find(audioID);
     if (iter == _audioPlayers.end())
@@ -590,8 +649,11 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     auto player = iter->second;
 
     // Note: It maybe in sub thread or main thread :(
-    if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY)
+    if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY && hasBuffer)
     {
+        if (cache->_compressedData)
+            _touchDecodedCache(cache, decoded);
+
         if (player->play2d())
         {
             _scheduler->runOnAxmolThread([audioID]() {
@@ -609,6 +671,87 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     }
 }
 
+void AudioEngineImpl::_touchDecodedCache(AudioCache* cache, bool decoded)
+{
+    if (decoded)
+        ++_cacheStats.misses;
+    else
+        ++_cacheStats.hits;
+
+    auto it = std::find(_decodedCaches.begin(), _decodedCaches.end(), cache);
+    if (it != _decodedCaches.end())
+    {
+        _decodedCaches.splice(_decodedCaches.begin(), _decodedCaches, it);
+    }
+    else if (cache->isBufferDecoded())
+    {
+        _decodedCaches.push_front(cache);
+        _decodedBytes += cache->_pcmSize;
+        trimDecodedCaches();
+    }
+}
+
+void AudioEngineImpl::trimDecodedCaches()
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    const auto budget = AudioEngine::getDecodedCacheBudget();
+    if (_decodedBytes <= budget)
+        return;
+
+    // the buffers attached to a source, or about to be, are kept
+    std::unordered_set<AudioCache*> usedCaches;
+    for (auto&& item : _audioPlayers)
+    {
+        if (!item.second->_removeByAudioEngine && item.second->_audioCache)
+            usedCaches.emplace(item.second->_audioCache);
+    }
+
+    for (auto it = _decodedCaches.end(); it != _decodedCaches.begin() && _decodedBytes > budget;)
+    {
+        auto cache = *--it;
+        if (usedCaches.find(cache) != usedCaches.end())
+            continue;
+
+        cache->releaseBuffer();
+        _decodedBytes -= cache->_pcmSize;
+        ++_cacheStats.evictions;
+        it = _decodedCaches.erase(it);
+    }
+}
+
+AudioEngine::CacheStats AudioEngineImpl::getCacheStats()
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    auto stats         = _cacheStats;
+    stats.decodedBytes = _decodedBytes;
+    for (auto&& item : _audioCaches)
+    {
+        auto cache = item.second.get();
+        if (cache->_state != AudioCache::State::READY)
+            continue;
+
+        if (cache->_compressedData)
+            stats.compressedBytes += static_cast<size_t>(cache->_compressedData->getSize());
+        else if (cache->isBufferDecoded())
+            stats.decodedBytes += cache->_pcmSize;
+    }
+    return stats;
+}
+
+float AudioEngineImpl::getOutputLatency()
+{
+#if AX_USE_ALSOFT
+    if (s_ALDevice && alcIsExtensionPresent(s_ALDevice, "ALC_SOFT_device_clock"))
+    {
+        ALCint64SOFT latency = 0;
+        alcGetInteger64vSOFT(s_ALDevice, ALC_DEVICE_LATENCY_SOFT, 1, &latency);
+        if (alcGetError(s_ALDevice) == ALC_NO_ERROR)
+            return static_cast<float>(static_cast<double>(latency) / 1e9);
+    }
+#endif
+    return AudioEngine::TIME_UNKNOWN;
+}
+
 ALuint AudioEngineImpl::findValidSource()
 {
     ALuint sourceId = AL_INVALID;
@@ -753,6 +896,10 @@ bool AudioEngineImpl::resume(AUDIO_ID audioID)
         ret = false;
         AXLOGE("{}: audio id = {}, error = {:#x}\n", __FUNCTION__, audioID, error);
     }
+    else if (player->_streamingSource)
+    {
+        _streamer->wakeup();
+    }
 
     return ret;
 }
@@ -790,6 +937,30 @@ void AudioEngineImpl::stopAll()
     _updatePlayers(true);
 }
 
+float AudioEngineImpl::virtualize(AUDIO_ID audioID)
+{
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioID);
+    if (iter == _audioPlayers.end())
+        return 0.0f;
+
+    auto player   = iter->second;
+    float time    = getCurrentTime(audioID);
+    auto alSource = player->_alSource;
+    _audioPlayers.erase(iter);
+    delete player;
+    _unusedSourcesPool.push(alSource);
+    return time;
+}
+
+float AudioEngineImpl::getFileDuration(std::string_view filePath)
+{
+    auto it = _audioCaches.find(filePath);
+    if (it != _audioCaches.end() && it->second->_state == AudioCache::State::READY)
+        return it->second->_duration;
+    return AudioEngine::TIME_UNKNOWN;
+}
+
 float AudioEngineImpl::getDuration(AUDIO_ID audioID)
 {
     std::lock_guard<std::recursive_mutex> lck(_threadMutex);
@@ -955,6 +1126,10 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
         }
     }
 
+    // the effects kept over the budget while playing
+    if (_decodedBytes > AudioEngine::getDecodedCacheBudget())
+        trimDecodedCaches();
+
     // don't invoke finish callback when stop/stopAll to avoid stack overflow
     if (AX_LIKELY(!forStop))
     {
@@ -983,7 +1158,21 @@ void AudioEngineImpl::_unscheduleUpdate()
 
 void AudioEngineImpl::uncache(std::string_view filePath)
 {
-    _audioCaches.erase(filePath);
+    auto it = _audioCaches.find(filePath);
+    if (it == _audioCaches.end())
+        return;
+
+    {
+        std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+        auto decodedIt = std::find(_decodedCaches.begin(), _decodedCaches.end(), it->second.get());
+        if (decodedIt != _decodedCaches.end())
+        {
+            _decodedBytes -= it->second->_pcmSize;
+            _decodedCaches.erase(decodedIt);
+        }
+    }
+
+    _audioCaches.erase(it);
 }
 
 void AudioEngineImpl::uncacheAll()
@@ -992,6 +1181,12 @@ void AudioEngineImpl::uncacheAll()
     for (auto&& player : _audioPlayers)
         player.second->setCache(nullptr);
 
+    {
+        std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+        _decodedCaches.clear();
+        _decodedBytes = 0;
+    }
+
     _audioCaches.clear();
 }
 }
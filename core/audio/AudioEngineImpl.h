@@ -29,13 +29,16 @@
 
 #    include "platform/PlatformConfig.h"
 
+#    include <list>
 #    include <unordered_map>
 #    include <queue>
 
 #    include "base/Object.h"
+#    include "audio/AudioEngine.h"
 #    include "audio/AudioMacros.h"
 #    include "audio/AudioCache.h"
 #    include "audio/AudioPlayer.h"
+#    include "audio/AudioStreamer.h"
 
 namespace ax
 {
@@ -49,7 +52,14 @@ public:
     ~AudioEngineImpl();
 
     bool init();
-    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time);
+    AUDIO_ID newAudioID() { return ++_currentAudioID; }
+    bool play2d(AUDIO_ID audioID, std::string_view fileFullPath, bool loop, float volume, float time);
+    bool hasFreeSource() const { return !_unusedSourcesPool.empty(); }
+
+    /** Stops the player of an audio instance which becomes virtual, returns its position. */
+    float virtualize(AUDIO_ID audioID);
+    /** Gets the duration of a loaded file, AudioEngine::TIME_UNKNOWN when it isn't. */
+    float getFileDuration(std::string_view filePath);
     void setVolume(AUDIO_ID audioID, float volume);
     void setPitch(AUDIO_ID audioID, float pitch);
     void setLoop(AUDIO_ID audioID, bool loop);
@@ -67,11 +77,17 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    /** Drops the least recently played decoded effects over AudioEngine::getDecodedCacheBudget. */
+    void trimDecodedCaches();
+    AudioEngine::CacheStats getCacheStats();
+    float getOutputLatency();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
     void _play2d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
+    void _touchDecodedCache(AudioCache* cache, bool decoded);
     ALuint findValidSource();
 #if defined(__APPLE__) && !AX_USE_ALSOFT
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
@@ -88,6 +104,14 @@ private:
     std::unordered_map<AUDIO_ID, AudioPlayer*> _audioPlayers;
     std::recursive_mutex _threadMutex;
 
+    // refills the streaming sources of all the players
+    std::unique_ptr<AudioStreamer> _streamer;
+
+    // the compressed caches with a decoded buffer, the most recently played first
+    std::list<AudioCache*> _decodedCaches;
+    size_t _decodedBytes;
+    AudioEngine::CacheStats _cacheStats;
+
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
@@ -30,10 +30,9 @@
 #include "audio/AudioPlayer.h"
 #include "audio/AudioCache.h"
 #include "platform/FileUtils.h"
-#include "audio/AudioDecoder.h"
-#include "audio/AudioDecoderManager.h"
+#include "audio/AudioStreamer.h"
 
-#include "yasio/thread_name.hpp"
+#include <thread>
 
 namespace ax
 {
@@ -51,12 +50,9 @@ AudioPlayer::AudioPlayer()
     , _ready(false)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
+    , _streamer(nullptr)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
+    , _streamFinished(false)
     , _id(++__playerIdIndex)
 {
     memset(_bufferIds, 0, sizeof(_bufferIds));
@@ -101,43 +97,28 @@ void AudioPlayer::destroy()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
-            {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                AXLOGV("{}", "rotateBufferThread exited!");
+            _streamer->remove(this);
+            AXLOGV("{}", "stream removed!");
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
-                // some specific OpenAL implement defects existed on iOS platform
-                // refer to: https://github.com/cocos2d/cocos2d-x/issues/18597
-                ALint sourceState;
-                ALint bufferProcessed = 0;
-                alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-                if (sourceState == AL_PLAYING)
+            // some specific OpenAL implement defects existed on iOS platform
+            // refer to: https://github.com/cocos2d/cocos2d-x/issues/18597
+            ALint sourceState;
+            ALint bufferProcessed = 0;
+            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+            if (sourceState == AL_PLAYING)
+            {
+                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+                while (bufferProcessed < QUEUEBUFFER_NUM)
                 {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
                     alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    while (bufferProcessed < QUEUEBUFFER_NUM)
-                    {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
-                        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    }
-                    alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                    CHECK_AL_ERROR_DEBUG();
                 }
-                AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
-#endif
+                alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+                CHECK_AL_ERROR_DEBUG();
             }
+            AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
+#endif
         }
     } while (false);
 
@@ -218,26 +199,23 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed)
-                break;
-
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
+        }
 
-            alSourcePlay(_alSource);
+        alSourcePlay(_alSource);
+        if (_streamingSource)
+        {
+            // the first buffers are the ones preloaded by the cache
+            _streamer->add(this, _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
         }
 
         auto alError = alGetError();
@@ -275,159 +253,10 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
-{
-    yasio::set_thread_name("axmol-audio");
-
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
-    {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
-
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
-
-        if (offsetFrame != 0)
-        {
-            decoder->seek(offsetFrame);
-        }
-
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
-
-        while (!_isDestroyed)
-        {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
-            {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
-                {
-                    bufferProcessed--;
-                    if (_timeDirty)
-                    {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
-                        decoder->seek(offsetFrame);
-                    }
-                    else
-                    {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
-                }
-            }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
-
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
-                {
-                    needToExitThread = true;
-                }
-                else
-                {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        AXLOGE("{}", "Error restarting playback!");
-                        needToExitThread = true;
-                    }
-                }
-            }
-
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
-            {
-                break;
-            }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
-            {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-            }
-
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-#endif
-        }
-
-    } while (false);
-
-    AXLOGV("{}", "Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
-}
-
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
-{
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
-}
-#endif
-
 bool AudioPlayer::isFinished() const
 {
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _streamFinished;
     else
     {
         ALint sourceState;
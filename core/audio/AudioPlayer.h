@@ -28,10 +28,9 @@
 
 #include "platform/PlatformConfig.h"
 
+#include <atomic>
 #include <string>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
 
 #include "audio/AudioMacros.h"
 #include "platform/PlatformMacros.h"
@@ -42,10 +41,12 @@ namespace ax
 
 class AudioCache;
 class AudioEngineImpl;
+class AudioStreamer;
 
 class AX_DLL AudioPlayer
 {
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 
 public:
     AudioPlayer();
@@ -62,11 +63,7 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
 
     AudioCache* _audioCache;
 
@@ -84,14 +81,9 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    AudioStreamer* _streamer;  // refills the buffers of the streaming source
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    std::atomic_bool _streamFinished;
 
     std::mutex _play2dMutex;
 
@@ -0,0 +1,301 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#define LOG_TAG "AudioStreamer"
+
+#include "audio/AudioStreamer.h"
+#include "audio/AudioPlayer.h"
+#include "audio/AudioCache.h"
+#include "audio/AudioDecoder.h"
+#include "audio/AudioDecoderManager.h"
+
+#include <algorithm>
+
+#include "yasio/thread_name.hpp"
+
+namespace ax
+{
+
+AudioStreamer::Stream::~Stream()
+{
+    AudioDecoderManager::destroyDecoder(decoder);
+}
+
+AudioStreamer::~AudioStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _exit = true;
+    }
+    _condition.notify_one();
+
+    if (_thread.joinable())
+        _thread.join();
+
+    _streams.clear();
+}
+
+void AudioStreamer::add(AudioPlayer* player, uint32_t offsetFrame)
+{
+    auto stream          = std::make_unique<Stream>();
+    stream->player       = player;
+    stream->decoder      = nullptr;
+    stream->offsetFrame  = offsetFrame;
+    stream->ringHead     = 0;
+    stream->ringCount    = 0;
+    stream->decoderEnded = false;
+    stream->opened       = false;
+
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _streams.emplace_back(std::move(stream));
+        _wakeup = true;
+
+        if (!_thread.joinable())
+            _thread = std::thread(&AudioStreamer::run, this);
+    }
+    _condition.notify_one();
+}
+
+void AudioStreamer::remove(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    auto it = std::find_if(_streams.begin(), _streams.end(),
+                           [player](const std::unique_ptr<Stream>& stream) { return stream->player == player; });
+    if (it != _streams.end())
+        _streams.erase(it);
+}
+
+void AudioStreamer::wakeup()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _wakeup = true;
+    }
+    _condition.notify_one();
+}
+
+void AudioStreamer::run()
+{
+    yasio::set_thread_name("axmol-audio");
+
+    std::unique_lock<std::mutex> lck(_mutex);
+    while (!_exit)
+    {
+        _wakeup = false;
+
+        auto now     = Clock::now();
+        auto nextDue = Clock::time_point::max();
+        for (auto it = _streams.begin(); it != _streams.end();)
+        {
+            auto due = Clock::time_point::max();
+            if (service(**it, now, due))
+            {
+                nextDue = std::min(nextDue, due);
+                ++it;
+            }
+            else
+            {
+                AXLOGV("Stream of player id={} finished", (*it)->player->_id);
+                (*it)->player->_streamFinished = true;
+                it = _streams.erase(it);
+            }
+        }
+
+        auto woken = [this] { return _wakeup || _exit; };
+        if (nextDue == Clock::time_point::max())
+            _condition.wait(lck, woken);
+        else
+            _condition.wait_until(lck, nextDue, woken);
+    }
+}
+
+bool AudioStreamer::service(Stream& stream, Clock::time_point now, Clock::time_point& due)
+{
+    auto& player  = *stream.player;
+    auto alSource = player._alSource;
+
+    if (!stream.opened)
+    {
+        stream.opened  = true;
+        auto& fullPath = player._audioCache->_fileFullPath;
+        stream.decoder = AudioDecoderManager::createDecoder(fullPath);
+        if (stream.decoder == nullptr || !stream.decoder->open(fullPath))
+            return false;
+
+        stream.framesPerBuffer = player._audioCache->_queBufferFrames;
+        stream.bufferSize      = stream.decoder->framesToBytes(stream.framesPerBuffer);
+        stream.ring.reset(new char[static_cast<size_t>(stream.bufferSize) * DECODE_AHEAD_BUFFERS]);
+
+        if (stream.offsetFrame != 0)
+            stream.decoder->seek(stream.offsetFrame);
+    }
+
+    ALint sourceState;
+    alGetSourcei(alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PLAYING)
+    {
+        ALint bufferProcessed = 0;
+        alGetSourcei(alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+        for (; bufferProcessed > 0; --bufferProcessed)
+        {
+            /*
+             While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+             already played. Those buffers can then be filled with new data or discarded. New or refilled
+             buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+             always a new buffer to play in the queue, the source will continue to play.
+             */
+            if (!queueNextBuffer(stream))
+                return false;
+        }
+
+        decodeAhead(stream);
+
+        // The head of the queue is playing, wake up once it played and half of the next buffer did, the source
+        // still has a buffer and a half queued then. The sources due at about the same time share the wake up.
+        ALint sampleOffset = 0;
+        ALfloat pitch      = 1.0f;
+        alGetSourcei(alSource, AL_SAMPLE_OFFSET, &sampleOffset);
+        alGetSourcef(alSource, AL_PITCH, &pitch);
+        if (pitch <= 0.0f)
+            pitch = 1.0f;
+
+        auto headFrames = std::max(static_cast<int>(stream.framesPerBuffer) - sampleOffset, 0) +
+                          static_cast<int>(stream.framesPerBuffer / 2);
+        auto seconds = headFrames / (stream.decoder->getSampleRate() * pitch);
+        due = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+    }
+    /* Make sure the source hasn't underrun */
+    else if (sourceState != AL_PAUSED)
+    {
+        ALint queued;
+
+        /* If no buffers are queued, playback is finished */
+        alGetSourcei(alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+            return false;
+
+        alSourcePlay(alSource);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            AXLOGE("{}", "Error restarting playback!");
+            return false;
+        }
+        due = now + std::chrono::milliseconds(static_cast<int>(QUEUEBUFFER_TIME_STEP * 1000) / 2);
+    }
+    else
+    {
+        // woken up by the resume
+        decodeAhead(stream);
+    }
+
+    return true;
+}
+
+bool AudioStreamer::queueNextBuffer(Stream& stream)
+{
+    auto& player = *stream.player;
+    auto decoder = stream.decoder;
+
+    if (player._timeDirty)
+    {
+        player._timeDirty = false;
+        clearAhead(stream);
+        decoder->seek(static_cast<uint32_t>(player._currTime * decoder->getSampleRate() * decoder->getChannelCount()));
+    }
+    else
+    {
+        player._currTime += QUEUEBUFFER_TIME_STEP;
+        if (player._currTime > player._audioCache->_duration)
+        {
+            if (player._loop)
+            {
+                player._currTime = 0.0f;
+            }
+            else
+            {
+                player._currTime = player._audioCache->_duration;
+            }
+        }
+    }
+
+    if (stream.ringCount == 0)
+    {
+        decodeAhead(stream);
+        if (stream.ringCount == 0 && player._loop)
+        {
+            clearAhead(stream);
+            decoder->seek(0);
+            decodeAhead(stream);
+        }
+        if (stream.ringCount == 0)
+            return false;
+    }
+
+    auto slot       = stream.ringHead;
+    auto frames     = stream.ringFrames[slot];
+    stream.ringHead = (stream.ringHead + 1) % DECODE_AHEAD_BUFFERS;
+    --stream.ringCount;
+
+    ALuint bid;
+    alSourceUnqueueBuffers(player._alSource, 1, &bid);
+#if AX_USE_ALSOFT
+    const auto sourceFormat = decoder->getSourceFormat();
+    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
+#endif
+    alBufferData(bid, player._audioCache->_format, stream.ring.get() + static_cast<size_t>(slot) * stream.bufferSize,
+                 decoder->framesToBytes(frames), decoder->getSampleRate());
+    alSourceQueueBuffers(player._alSource, 1, &bid);
+
+    return true;
+}
+
+void AudioStreamer::decodeAhead(Stream& stream)
+{
+    while (stream.ringCount < DECODE_AHEAD_BUFFERS && !stream.decoderEnded)
+    {
+        auto slot   = (stream.ringHead + stream.ringCount) % DECODE_AHEAD_BUFFERS;
+        auto frames = stream.decoder->readFixedFrames(
+            stream.framesPerBuffer, stream.ring.get() + static_cast<size_t>(slot) * stream.bufferSize);
+        if (frames == 0)
+        {
+            stream.decoderEnded = true;
+            break;
+        }
+        stream.ringFrames[slot] = frames;
+        ++stream.ringCount;
+    }
+}
+
+void AudioStreamer::clearAhead(Stream& stream)
+{
+    stream.ringHead     = 0;
+    stream.ringCount    = 0;
+    stream.decoderEnded = false;
+}
+
+}  // namespace ax
+
+#undef LOG_TAG
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformConfig.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio/AudioMacros.h"
+#include "audio/alconfig.h"
+
+namespace ax
+{
+
+class AudioDecoder;
+class AudioPlayer;
+
+/**
+ * @brief The thread refilling the queued buffers of all the streaming AudioPlayers.
+ *
+ * One thread serves every streaming source, it sleeps until the queue of a source is about to run low, computed from
+ * the playing offset of the source, or until it is woken by a new stream, a resume or a notification of the OpenAL
+ * implementation. The sources due at about the same time are refilled by the same wake up. Each stream decodes a few
+ * buffers ahead, so a refill only copies a decoded buffer to OpenAL and the decoding is spread between the refills.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL AudioStreamer
+{
+public:
+    /** The decoded buffers a stream keeps ahead of its queue. */
+    static constexpr int DECODE_AHEAD_BUFFERS = QUEUEBUFFER_NUM;
+
+    AudioStreamer() = default;
+    ~AudioStreamer();
+
+    AudioStreamer(const AudioStreamer&)            = delete;
+    AudioStreamer& operator=(const AudioStreamer&) = delete;
+
+    /** Streams the file of a player from a frame, its buffers must be queued to its source. */
+    void add(AudioPlayer* player, uint32_t offsetFrame);
+
+    /** Stops streaming a player, the streamer doesn't use the player anymore when it returns. */
+    void remove(AudioPlayer* player);
+
+    /** Wakes the thread up to check the sources now, after a resume or a buffer processed notification. */
+    void wakeup();
+
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stream
+    {
+        AudioPlayer* player;
+        AudioDecoder* decoder;
+        uint32_t offsetFrame;  // seeked to by the first service
+        uint32_t framesPerBuffer;
+        uint32_t bufferSize;
+        std::unique_ptr<char[]> ring;  // DECODE_AHEAD_BUFFERS buffers of bufferSize bytes
+        uint32_t ringFrames[DECODE_AHEAD_BUFFERS];
+        int ringHead;
+        int ringCount;
+        bool decoderEnded;  // the ring holds the end of the file
+        bool opened;
+
+        ~Stream();
+    };
+
+    void run();
+
+    /** Refills the processed buffers of a stream and computes when it's due again, false when it finished. */
+    bool service(Stream& stream, Clock::time_point now, Clock::time_point& due);
+
+    /** Replaces a processed buffer of a stream with its next one, false at the end of the file. */
+    bool queueNextBuffer(Stream& stream);
+
+    void decodeAhead(Stream& stream);
+    void clearAhead(Stream& stream);
+
+    std::thread _thread;
+    std::mutex _mutex;  // held by the thread while it serves the streams
+    std::condition_variable _condition;
+    std::vector<std::unique_ptr<Stream>> _streams;
+    bool _wakeup = false;
+    bool _exit   = false;
+};
+
+}  // namespace ax
@@ -41,6 +41,8 @@ THE SOFTWARE.
 #ifndef AX_CORE_PROFILE
 #    include "base/AsyncTaskPool.h"
 #endif
+#include "base/Async.h"
+#include "base/AssetPreloader.h"
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
 #include "base/Logging.h"
@@ -53,6 +55,8 @@ THE SOFTWARE.
 #include "base/Profiling.h"
 #include "base/Properties.h"
 #include "base/Object.h"
+#include "base/ObjectArena.h"
+#include "base/PerformanceGovernor.h"
 #include "base/RefPtr.h"
 #include "base/Scheduler.h"
 #include "base/UserDefault.h"
@@ -69,6 +73,9 @@ THE SOFTWARE.
 // EventDispatcher
 #include "base/EventAcceleration.h"
 #include "base/EventCustom.h"
+#include "base/InlineTask.h"
+#include "base/Allocator.h"
+#include "base/InternedString.h"
 #include "base/EventDispatcher.h"
 #include "base/EventFocus.h"
 #include "base/EventKeyboard.h"
@@ -111,6 +118,7 @@ THE SOFTWARE.
 #include "2d/ActionTiledGrid.h"
 #include "2d/ActionTween.h"
 #include "2d/TweenFunction.h"
+#include "2d/TweenSystem.h"
 #include "2d/ActionCoroutine.h"
 
 // 2d nodes
@@ -127,6 +135,7 @@ THE SOFTWARE.
 #include "2d/MenuItem.h"
 #include "2d/MotionStreak.h"
 #include "2d/Node.h"
+#include "2d/NodePool.h"
 #include "2d/NodeGrid.h"
 #include "2d/ParticleBatchNode.h"
 #include "2d/ParticleExamples.h"
@@ -136,6 +145,8 @@ THE SOFTWARE.
 #include "2d/ProtectedNode.h"
 #include "2d/RenderTexture.h"
 #include "2d/Scene.h"
+#include "2d/SpatialGrid.h"
+#include "2d/TransformBatch.h"
 #include "2d/Transition.h"
 #include "2d/TransitionPageTurn.h"
 #include "2d/TransitionProgress.h"
@@ -155,11 +166,16 @@ THE SOFTWARE.
 #include "renderer/GroupCommand.h"
 #include "renderer/Material.h"
 #include "renderer/Pass.h"
+#include "renderer/PostProcessGraph.h"
 #include "renderer/QuadCommand.h"
 #include "renderer/RenderCommand.h"
 #include "renderer/RenderCommandPool.h"
 #include "renderer/RenderState.h"
+#include "renderer/RenderTargetPool.h"
 #include "renderer/Renderer.h"
+#include "renderer/StaticBatch.h"
+#include "renderer/TrailBuffer.h"
+#include "renderer/DynamicResolution.h"
 #include "renderer/Technique.h"
 #include "renderer/Texture2D.h"
 #include "renderer/TextureCube.h"
@@ -179,10 +195,13 @@ THE SOFTWARE.
 #include "platform/Device.h"
 #include "platform/FileUtils.h"
 #include "platform/FileStream.h"
+#include "platform/FileView.h"
+#include "platform/PackArchive.h"
 #include "platform/Image.h"
 #include "platform/PlatformConfig.h"
 #include "platform/PlatformMacros.h"
 #include "platform/SAXParser.h"
+#include "platform/GLViewNull.h"
 
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_IOS)
 #    include "platform/ios/Application-ios.h"
@@ -243,6 +262,7 @@ THE SOFTWARE.
 #include "2d/SpriteBatchNode.h"
 #include "2d/SpriteFrame.h"
 #include "2d/SpriteFrameCache.h"
+#include "2d/DynamicAtlas.h"
 
 // text_input_node
 #include "2d/TextFieldTTF.h"
@@ -254,6 +274,7 @@ THE SOFTWARE.
 #include "2d/ParallaxNode.h"
 #include "2d/TMXObjectGroup.h"
 #include "2d/TMXXMLParser.h"
+#include "2d/TMXBundle.h"
 #include "2d/TileMapAtlas.h"
 #include "2d/FastTMXLayer.h"
 #include "2d/FastTMXTiledMap.h"
@@ -269,10 +290,21 @@ THE SOFTWARE.
 #include "3d/AttachNode.h"
 #include "3d/BillBoard.h"
 #include "3d/Frustum.h"
+#include "3d/BoundsTree.h"
 #include "3d/Mesh.h"
 #include "3d/MeshSkin.h"
+#include "3d/BonePalette.h"
+#include "3d/LightClusterGrid.h"
+#include "3d/LightClusters.h"
+#include "3d/ShadowCascades.h"
+#include "3d/CascadedShadowMap.h"
 #include "3d/MotionStreak3D.h"
 #include "3d/MeshVertexIndexData.h"
+#include "3d/MeshBundle.h"
+#include "3d/MeshSimplifier.h"
+#include "3d/VertexCompression.h"
+#include "3d/LODGroup.h"
+#include "3d/StaticBatch3D.h"
 #include "3d/OBB.h"
 #include "3d/Plane.h"
 #include "3d/Ray.h"
@@ -281,6 +313,7 @@ THE SOFTWARE.
 #include "3d/MeshRenderer.h"
 #include "3d/MeshMaterial.h"
 #include "3d/Terrain.h"
+#include "3d/PagedTerrain.h"
 #include "3d/VertexAttribBinding.h"
 
 namespace ax
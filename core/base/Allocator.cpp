@@ -0,0 +1,187 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/Allocator.h"
+#include "base/Logging.h"
+
+#include <atomic>
+#include <iterator>
+#include <new>
+
+namespace ax
+{
+
+namespace
+{
+
+class DefaultAllocator : public Allocator
+{
+public:
+    void* allocate(std::size_t size, std::size_t alignment) override
+    {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(size, std::nothrow);
+        return ::operator new(size, std::align_val_t(alignment), std::nothrow);
+    }
+
+    void deallocate(void* ptr, std::size_t /*size*/, std::size_t alignment) override
+    {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(ptr);
+        else
+            ::operator delete(ptr, std::align_val_t(alignment));
+    }
+};
+
+struct TagCounters
+{
+    std::atomic<std::size_t> liveBytes{0};
+    std::atomic<std::size_t> peakBytes{0};
+    std::atomic<std::size_t> budget{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+
+    // counted during the frame, copied to the last frame ones by endFrame
+    std::atomic<uint64_t> frameAllocations{0};
+    std::atomic<std::size_t> frameBytes{0};
+    std::atomic<uint64_t> lastFrameAllocations{0};
+    std::atomic<std::size_t> lastFrameBytes{0};
+
+    bool overBudget = false;  // axmol thread, see endFrame
+};
+
+// constant initialized, the objects created by the static initializers are accounted too
+constinit DefaultAllocator s_defaultAllocator;
+constinit std::atomic<Allocator*> s_allocator{&s_defaultAllocator};
+constinit TagCounters s_tags[static_cast<int>(MemoryTag::COUNT)];
+
+TagCounters& counters(MemoryTag tag)
+{
+    AX_ASSERT(tag < MemoryTag::COUNT);
+    return s_tags[static_cast<int>(tag)];
+}
+
+}  // namespace
+
+void Memory::setAllocator(Allocator* allocator)
+{
+    s_allocator.store(allocator ? allocator : &s_defaultAllocator, std::memory_order_release);
+}
+
+Allocator* Memory::getAllocator()
+{
+    return s_allocator.load(std::memory_order_acquire);
+}
+
+void* Memory::allocate(std::size_t size, MemoryTag tag, std::size_t alignment)
+{
+    auto ptr = getAllocator()->allocate(size, alignment);
+    if (ptr)
+        trackAllocation(tag, size);
+    return ptr;
+}
+
+void Memory::deallocate(void* ptr, std::size_t size, MemoryTag tag, std::size_t alignment)
+{
+    if (!ptr)
+        return;
+    getAllocator()->deallocate(ptr, size, alignment);
+    trackDeallocation(tag, size);
+}
+
+void Memory::trackAllocation(MemoryTag tag, std::size_t size)
+{
+    auto& tagCounters = counters(tag);
+    tagCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+    auto live = tagCounters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    auto peak = tagCounters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !tagCounters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+}
+
+void Memory::trackDeallocation(MemoryTag tag, std::size_t size)
+{
+    auto& tagCounters = counters(tag);
+    tagCounters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+Memory::TagStats Memory::getStats(MemoryTag tag)
+{
+    auto& tagCounters = counters(tag);
+    TagStats stats;
+    stats.liveBytes        = tagCounters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes        = tagCounters.peakBytes.load(std::memory_order_relaxed);
+    stats.budget           = tagCounters.budget.load(std::memory_order_relaxed);
+    stats.allocations      = tagCounters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations    = tagCounters.deallocations.load(std::memory_order_relaxed);
+    stats.frameAllocations = tagCounters.lastFrameAllocations.load(std::memory_order_relaxed);
+    stats.frameBytes       = tagCounters.lastFrameBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Memory::setBudget(MemoryTag tag, std::size_t budget)
+{
+    counters(tag).budget.store(budget, std::memory_order_relaxed);
+}
+
+bool Memory::isOverBudget(MemoryTag tag)
+{
+    auto& tagCounters = counters(tag);
+    auto budget       = tagCounters.budget.load(std::memory_order_relaxed);
+    return budget > 0 && tagCounters.liveBytes.load(std::memory_order_relaxed) > budget;
+}
+
+void Memory::endFrame()
+{
+    for (int i = 0; i < static_cast<int>(MemoryTag::COUNT); ++i)
+    {
+        auto& tagCounters = s_tags[i];
+        tagCounters.lastFrameAllocations.store(tagCounters.frameAllocations.exchange(0, std::memory_order_relaxed),
+                                               std::memory_order_relaxed);
+        tagCounters.lastFrameBytes.store(tagCounters.frameBytes.exchange(0, std::memory_order_relaxed),
+                                         std::memory_order_relaxed);
+
+        // warned once per excess, again once the tag went back under its budget
+        auto tag        = static_cast<MemoryTag>(i);
+        bool overBudget = isOverBudget(tag);
+        if (overBudget && !tagCounters.overBudget)
+            AXLOGW("Memory: {} uses {} bytes, over its budget of {} bytes", getTagName(tag),
+                   tagCounters.liveBytes.load(std::memory_order_relaxed),
+                   tagCounters.budget.load(std::memory_order_relaxed));
+        tagCounters.overBudget = overBudget;
+    }
+}
+
+std::string_view Memory::getTagName(MemoryTag tag)
+{
+    static const std::string_view names[] = {"general", "object", "texture", "font", "audio", "mesh"};
+    static_assert(std::size(names) == static_cast<size_t>(MemoryTag::COUNT));
+    return tag < MemoryTag::COUNT ? names[static_cast<int>(tag)] : std::string_view{};
+}
+
+}  // namespace ax
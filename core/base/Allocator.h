@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/** The subsystems the memory of the engine is accounted to, see Memory. */
+enum class MemoryTag : uint8_t
+{
+    GENERAL,
+    OBJECT,   // the Object instances, see Object::operator new
+    TEXTURE,  // the storage of the textures, tracked with their size on the GPU
+    FONT,     // the pixels of the font atlas pages being filled
+    AUDIO,    // the decoded PCM data and the stream buffers
+    MESH,     // the vertex and index buffers of the 3D meshes
+    COUNT
+};
+
+/** @class Allocator
+ * @brief The allocator the engine allocations go through, see Memory::setAllocator.
+ *
+ * The default one uses the aligned operator new, plug mimalloc, rpmalloc or a budgeted arena by implementing it.
+ * It's called from any thread.
+ */
+class AX_DLL Allocator
+{
+public:
+    virtual ~Allocator() = default;
+
+    /** Returns nullptr when the memory can't be allocated. */
+    virtual void* allocate(std::size_t size, std::size_t alignment) = 0;
+
+    /** The size and the alignment are the ones of the allocation, the size is 0 when it's unknown. */
+    virtual void deallocate(void* ptr, std::size_t size, std::size_t alignment) = 0;
+};
+
+/** @class Memory
+ * @brief Routes the engine allocations through the Allocator and accounts them by MemoryTag.
+ *
+ * The memory allocated by other means, the GPU memory of the textures or the buffers of OpenAL, is reported with
+ * trackAllocation and trackDeallocation. The counters are atomic, the memory is accounted from any thread.
+ @code
+ Memory::setBudget(MemoryTag::TEXTURE, 256 * 1024 * 1024);
+ auto stats = Memory::getStats(MemoryTag::TEXTURE);
+ AXLOGI("textures: {} bytes, {} allocations last frame", stats.liveBytes, stats.frameAllocations);
+ @endcode
+ */
+class AX_DLL Memory
+{
+public:
+    struct TagStats
+    {
+        std::size_t liveBytes     = 0;
+        std::size_t peakBytes     = 0;
+        std::size_t budget        = 0;  // 0 without budget
+        uint64_t allocations      = 0;  // since the start
+        uint64_t deallocations    = 0;
+        uint64_t frameAllocations = 0;  // during the last frame, see endFrame
+        std::size_t frameBytes    = 0;
+    };
+
+    /** Sets the allocator, nullptr restores the default one.
+     *
+     * The memory is freed by the allocator which allocated it, set it before the engine starts.
+     */
+    static void setAllocator(Allocator* allocator);
+    static Allocator* getAllocator();
+
+    /** Allocates with the allocator and accounts the memory to a tag, returns nullptr on failure. */
+    static void* allocate(std::size_t size, MemoryTag tag, std::size_t alignment = alignof(std::max_align_t));
+
+    /** Frees the memory of allocate, with its size, tag and alignment. */
+    static void deallocate(void* ptr,
+                           std::size_t size,
+                           MemoryTag tag,
+                           std::size_t alignment = alignof(std::max_align_t));
+
+    /** Accounts memory which isn't allocated by allocate. */
+    static void trackAllocation(MemoryTag tag, std::size_t size);
+    static void trackDeallocation(MemoryTag tag, std::size_t size);
+
+    static TagStats getStats(MemoryTag tag);
+
+    /** Sets the live bytes a tag shouldn't exceed, 0 removes the budget. A warning is logged when it's exceeded. */
+    static void setBudget(MemoryTag tag, std::size_t budget);
+    static bool isOverBudget(MemoryTag tag);
+
+    /** Ends the frame of the per frame counts and checks the budgets, called by the Director. */
+    static void endFrame();
+
+    static std::string_view getTagName(MemoryTag tag);
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
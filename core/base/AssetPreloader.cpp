@@ -0,0 +1,615 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/AssetPreloader.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "2d/FontAtlasCache.h"
+#include "2d/Label.h"
+#include "2d/SpriteFrameCache.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/JsonWriter.h"
+#include "base/PaddedString.h"
+#include "base/Scheduler.h"
+#include "platform/FileUtils.h"
+#include "renderer/TextureCache.h"
+
+#if defined(AX_ENABLE_AUDIO)
+#    include "audio/AudioEngine.h"
+#endif
+#if defined(AX_ENABLE_3D)
+#    include "3d/MeshRenderer.h"
+#endif
+
+namespace ax
+{
+
+static const std::string_view ASSET_PRELOADER_COMMIT_KEY = "axmol.assetPreloader.commit"sv;
+
+// the manifests nest includes up to this depth, deeper ones are include cycles
+static constexpr int MAX_MANIFEST_DEPTH = 16;
+
+static AssetPreloader* s_sharedAssetPreloader = nullptr;
+
+static std::string makeAssetKey(AssetType type, std::string_view path, float fontSize)
+{
+    return type == AssetType::FontTTF ? fmt::format("{} {} {}", static_cast<int>(type), fontSize, path)
+                                      : fmt::format("{} {}", static_cast<int>(type), path);
+}
+
+static const std::string_view s_assetTypeNames[] = {"texture"sv, "spriteSheet"sv, "fontTTF"sv,
+                                                    "fontFNT"sv, "audio"sv,       "model"sv};
+
+std::string_view AssetManifest::getTypeName(AssetType type)
+{
+    return s_assetTypeNames[static_cast<int>(type)];
+}
+
+bool AssetManifest::initWithFile(std::string_view filePath)
+{
+    clear();
+    return load(filePath, 0);
+}
+
+bool AssetManifest::load(std::string_view filePath, int depth)
+{
+    using namespace simdjson;
+
+    if (depth >= MAX_MANIFEST_DEPTH)
+    {
+        AXLOGE("AssetManifest: {} is included too deeply, is there an include cycle?", filePath);
+        return false;
+    }
+
+    try
+    {
+        auto strJson = PaddedString::load(filePath);
+        if (strJson.size() == 0)
+        {
+            AXLOGE("AssetManifest: can't read {}", filePath);
+            return false;
+        }
+
+        ondemand::parser parser;
+        ondemand::document manifest = parser.iterate(strJson);
+        ondemand::object root       = manifest.get_object();
+
+        ondemand::array includes;
+        if (root["include"].get(includes) == SUCCESS)
+        {
+            for (std::string_view include : includes)
+                load(include, depth + 1);
+        }
+
+        ondemand::array assets;
+        if (root["assets"].get(assets) != SUCCESS)
+            return true;
+
+        for (ondemand::object item : assets)
+        {
+            std::string_view typeName = item["type"];
+            auto it = std::find(std::begin(s_assetTypeNames), std::end(s_assetTypeNames), typeName);
+            if (it == std::end(s_assetTypeNames))
+            {
+                AXLOGW("AssetManifest: unknown asset type {} in {}", typeName, filePath);
+                continue;
+            }
+
+            std::string_view path = item["path"];
+            double fontSize       = 0;
+            int64_t priority      = 0;
+            item["size"].get(fontSize);
+            item["priority"].get(priority);
+
+            auto& asset = addAsset(static_cast<AssetType>(it - std::begin(s_assetTypeNames)), path,
+                                   static_cast<int>(priority), static_cast<float>(fontSize));
+
+            std::string_view texture;
+            if (item["texture"].get(texture) == SUCCESS)
+                asset.texture = texture;
+
+            ondemand::array dependencies;
+            if (item["dependencies"].get(dependencies) == SUCCESS)
+            {
+                for (std::string_view dependency : dependencies)
+                    asset.dependencies.emplace_back(dependency);
+            }
+        }
+    }
+    catch (const simdjson::simdjson_error& ex)
+    {
+        AXLOGE("AssetManifest: invalid manifest {}, {}", filePath, ex.what());
+        return false;
+    }
+    return true;
+}
+
+bool AssetManifest::writeToFile(std::string_view fullPath) const
+{
+    JsonWriter<true> writer;
+    writer.writeStartObject();
+    writer.writeStartArray("assets");
+    for (auto& asset : _assets)
+    {
+        writer.writeStartObject();
+        writer.writeString("type", getTypeName(asset.type));
+        writer.writeString("path", asset.path);
+        if (!asset.texture.empty())
+            writer.writeString("texture", asset.texture);
+        if (asset.type == AssetType::FontTTF)
+            writer.writeNumber("size", static_cast<double>(asset.fontSize));
+        if (asset.priority != 0)
+            writer.writeNumber("priority", asset.priority);
+        if (!asset.dependencies.empty())
+        {
+            writer.writeStartArray("dependencies");
+            for (auto& dependency : asset.dependencies)
+                writer.writeStringValue(dependency);
+            writer.writeEndArray();
+        }
+        writer.writeEndObject();
+    }
+    writer.writeEndArray();
+    writer.writeEndObject();
+
+    return FileUtils::getInstance()->writeStringToFile(static_cast<std::string_view>(writer), fullPath);
+}
+
+AssetManifest::Asset& AssetManifest::addAsset(AssetType type, std::string_view path, int priority, float fontSize)
+{
+    auto [it, added] = _indices.emplace(makeAssetKey(type, path, fontSize), _assets.size());
+    if (!added)
+    {
+        auto& asset    = _assets[it->second];
+        asset.priority = std::max(asset.priority, priority);
+        return asset;
+    }
+
+    auto& asset    = _assets.emplace_back();
+    asset.type     = type;
+    asset.path     = path;
+    asset.fontSize = fontSize;
+    asset.priority = priority;
+    return asset;
+}
+
+void AssetManifest::addManifest(const AssetManifest& other)
+{
+    for (auto& asset : other._assets)
+    {
+        auto& added = addAsset(asset.type, asset.path, asset.priority, asset.fontSize);
+        if (added.texture.empty())
+            added.texture = asset.texture;
+        for (auto& dependency : asset.dependencies)
+        {
+            if (std::find(added.dependencies.begin(), added.dependencies.end(), dependency) ==
+                added.dependencies.end())
+                added.dependencies.emplace_back(dependency);
+        }
+    }
+}
+
+void AssetManifest::clear()
+{
+    _assets.clear();
+    _indices.clear();
+}
+
+float AssetPreloader::Request::getProgress() const
+{
+    return _assets.empty() ? 1.0f : static_cast<float>(_loaded + _failed) / static_cast<float>(_assets.size());
+}
+
+void AssetPreloader::Request::cancel()
+{
+    _cancelled = true;
+    _onProgress = nullptr;
+    _onComplete = nullptr;
+    _assets.clear();
+    _loaded = _failed = 0;
+}
+
+AssetPreloader* AssetPreloader::getInstance()
+{
+    if (!s_sharedAssetPreloader)
+        s_sharedAssetPreloader = new AssetPreloader();
+    return s_sharedAssetPreloader;
+}
+
+void AssetPreloader::destroyInstance()
+{
+    AX_SAFE_DELETE(s_sharedAssetPreloader);
+}
+
+AssetPreloader::~AssetPreloader()
+{
+    if (!_commits.empty())
+        Director::getInstance()->getScheduler()->unschedule(ASSET_PRELOADER_COMMIT_KEY, this);
+}
+
+std::shared_ptr<AssetPreloader::Request> AssetPreloader::preload(std::string_view manifestPath,
+                                                                 ProgressCallback onProgress,
+                                                                 CompleteCallback onComplete,
+                                                                 int priority)
+{
+    AssetManifest manifest;
+    manifest.initWithFile(manifestPath);
+    return preload(manifest, std::move(onProgress), std::move(onComplete), priority);
+}
+
+std::shared_ptr<AssetPreloader::Request> AssetPreloader::preload(const AssetManifest& manifest,
+                                                                 ProgressCallback onProgress,
+                                                                 CompleteCallback onComplete,
+                                                                 int priority)
+{
+    // drop the assets and the requests released since the last preload
+    std::erase_if(_assets, [](auto& item) { return item.second.expired(); });
+    std::erase_if(_requests, [](auto& request) { return request.expired(); });
+
+    auto request         = std::make_shared<Request>();
+    request->_onProgress = std::move(onProgress);
+    request->_onComplete = std::move(onComplete);
+    _requests.emplace_back(request);
+
+    auto& assets = manifest.getAssets();
+    std::vector<std::shared_ptr<AssetState>> created;
+    std::unordered_map<std::string_view, std::shared_ptr<AssetState>> byPath;
+    request->_assets.reserve(assets.size());
+    for (auto& asset : assets)
+    {
+        auto state = acquireAsset(asset.type, asset.path, asset.fontSize, asset.priority + priority, created);
+        if (state->texture.empty())
+            state->texture = asset.texture;
+        request->_assets.emplace_back(state);
+        byPath.emplace(asset.path, state);
+    }
+
+    // the dependencies are wired for the new assets only, the others are already loading
+    size_t index = 0;
+    for (auto& asset : assets)
+    {
+        auto& state = request->_assets[index++];
+        if (state->status != Status::Waiting ||
+            std::find(created.begin(), created.end(), state) == created.end())
+            continue;
+
+        for (auto& path : asset.dependencies)
+        {
+            auto it = byPath.find(path);
+            if (it != byPath.end())
+                addDependency(state, it->second);
+            else
+                AXLOGW("AssetPreloader: {} depends on {}, which isn't in the manifest", asset.path, path);
+        }
+
+        // the texture of a sprite sheet is loaded first, decoded on the workers
+        if (asset.type == AssetType::SpriteSheet && !state->texture.empty())
+            addDependency(state, acquireAsset(AssetType::Texture, state->texture, 0, state->priority, created));
+    }
+
+    for (auto& state : request->_assets)
+    {
+        if (state->status == Status::Loaded)
+            ++request->_loaded;
+        else if (state->status == Status::Failed)
+            ++request->_failed;
+        else
+            state->requests.emplace_back(request);
+    }
+
+    if (request->isDone())
+    {
+        if (request->_onComplete)
+            request->_onComplete(*request);
+        return request;
+    }
+
+    std::stable_sort(created.begin(), created.end(),
+                     [](auto& lhs, auto& rhs) { return lhs->priority > rhs->priority; });
+    for (auto& state : created)
+    {
+        if (state->status == Status::Waiting && state->pendingDependencies == 0)
+            start(state);
+    }
+    return request;
+}
+
+float AssetPreloader::getProgress() const
+{
+    size_t done = 0, total = 0;
+    for (auto& weak : _requests)
+    {
+        auto request = weak.lock();
+        if (request && !request->isDone())
+        {
+            done += request->_loaded + request->_failed;
+            total += request->_assets.size();
+        }
+    }
+    return total ? static_cast<float>(done) / static_cast<float>(total) : 1.0f;
+}
+
+std::shared_ptr<AssetPreloader::AssetState> AssetPreloader::acquireAsset(
+    AssetType type,
+    std::string_view path,
+    float fontSize,
+    int priority,
+    std::vector<std::shared_ptr<AssetState>>& created)
+{
+    auto& weak = _assets[makeAssetKey(type, path, fontSize)];
+    if (auto state = weak.lock())
+    {
+        state->priority = std::max(state->priority, priority);
+        return state;
+    }
+
+    auto state      = std::make_shared<AssetState>();
+    state->type     = type;
+    state->path     = path;
+    state->fontSize = fontSize;
+    state->priority = priority;
+    weak            = state;
+    created.emplace_back(state);
+    return state;
+}
+
+void AssetPreloader::addDependency(const std::shared_ptr<AssetState>& asset,
+                                   const std::shared_ptr<AssetState>& dependency)
+{
+    // a dependency on an asset which depends on this one would never start
+    std::vector<AssetState*> stack{dependency.get()};
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+        if (current == asset.get())
+        {
+            AXLOGW("AssetPreloader: the dependency of {} on {} is a cycle, it is ignored", asset->path,
+                   dependency->path);
+            return;
+        }
+        for (auto& next : current->dependencies)
+            stack.emplace_back(next.get());
+    }
+
+    asset->dependencies.emplace_back(dependency);
+    if (dependency->status == Status::Loaded || dependency->status == Status::Failed)
+        return;
+
+    ++asset->pendingDependencies;
+    dependency->dependents.emplace_back(asset);
+}
+
+void AssetPreloader::start(const std::shared_ptr<AssetState>& asset)
+{
+    if (asset->type == AssetType::SpriteSheet)
+    {
+        startSpriteSheet(asset);
+        return;
+    }
+
+    asset->status = Status::Loading;
+    std::weak_ptr<AssetState> weak = asset;
+    switch (asset->type)
+    {
+    case AssetType::Texture:
+        Director::getInstance()->getTextureCache()->addImageAsync(
+            asset->path,
+            [this, weak](Texture2D* texture) {
+            if (auto asset = weak.lock())
+            {
+                asset->object = texture;
+                finish(asset, texture != nullptr);
+            }
+        },
+            asset->priority);
+        break;
+    case AssetType::FontTTF:
+    case AssetType::FontFNT:
+        queueCommit(asset);
+        break;
+    case AssetType::Audio:
+#if defined(AX_ENABLE_AUDIO)
+        AudioEngine::preload(asset->path, [this, weak](bool loaded) {
+            if (auto asset = weak.lock())
+                finish(asset, loaded);
+        });
+#else
+        finish(asset, false);
+#endif
+        break;
+    case AssetType::Model:
+#if defined(AX_ENABLE_3D)
+        MeshRenderer::createAsync(
+            asset->path, asset->texture,
+            [this, weak](MeshRenderer* meshRenderer, void*) {
+            if (auto asset = weak.lock())
+                finish(asset, meshRenderer != nullptr);
+        },
+            nullptr);
+#else
+        finish(asset, false);
+#endif
+        break;
+    default:
+        break;
+    }
+}
+
+void AssetPreloader::startSpriteSheet(const std::shared_ptr<AssetState>& asset)
+{
+    if (asset->status == Status::Loading || !asset->texture.empty() ||
+        FileUtils::getPathExtension(asset->path) == ".ssb")
+    {
+        // the texture is loaded, or the binary sheet loads it from its mapped file
+        asset->status = Status::Loading;
+        queueCommit(asset);
+        return;
+    }
+
+    // the texture of a plist sheet is named in its metadata, the plist is parsed on a worker to find it
+    asset->status = Status::Loading;
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(asset->path);
+    auto texture  = std::make_shared<std::string>();
+    Director::getInstance()
+        ->getJobSystem()
+        ->schedule(
+            [fullPath, texture] {
+        auto fileUtils = FileUtils::getInstance();
+        auto dict      = fileUtils->getValueMapFromFile(fullPath);
+        auto it        = dict.find("metadata");
+        if (it != dict.end() && it->second.getType() == Value::Type::MAP)
+        {
+            auto& metadata = it->second.asValueMap();
+            auto name      = metadata.find("textureFileName");
+            if (name != metadata.end() && !name->second.asString().empty())
+                *texture = fileUtils->fullPathFromRelativeFile(name->second.asString(), fullPath);
+        }
+    },
+            JobPriority::Low)
+        .thenOnAxmolThread([this, weak = std::weak_ptr<AssetState>(asset), texture] {
+        auto asset = weak.lock();
+        if (!asset)
+            return;
+
+        if (texture->empty())
+        {
+            // SpriteFrameCache looks for the .png of the sheet
+            queueCommit(asset);
+            return;
+        }
+
+        asset->texture = *texture;
+        std::vector<std::shared_ptr<AssetState>> created;
+        addDependency(asset, acquireAsset(AssetType::Texture, asset->texture, 0, asset->priority, created));
+        for (auto& state : created)
+            start(state);
+        if (asset->pendingDependencies == 0)
+            queueCommit(asset);
+    });
+}
+
+void AssetPreloader::finish(const std::shared_ptr<AssetState>& asset, bool loaded)
+{
+    asset->status = loaded ? Status::Loaded : Status::Failed;
+    if (!loaded)
+        AXLOGW("AssetPreloader: failed to load {}", asset->path);
+
+    auto dependents = std::move(asset->dependents);
+    for (auto& weak : dependents)
+    {
+        auto dependent = weak.lock();
+        if (dependent && --dependent->pendingDependencies == 0)
+            start(dependent);
+    }
+
+    auto requests = std::move(asset->requests);
+    for (auto& weak : requests)
+    {
+        auto request = weak.lock();
+        if (!request || request->_cancelled)
+            continue;
+
+        ++(loaded ? request->_loaded : request->_failed);
+        if (request->_onProgress)
+            request->_onProgress(request->getProgress());
+        if (request->isDone() && request->_onComplete)
+            request->_onComplete(*request);
+    }
+}
+
+void AssetPreloader::queueCommit(const std::shared_ptr<AssetState>& asset)
+{
+    if (asset->committing)
+        return;
+    asset->committing = true;
+
+    if (_commits.empty())
+        Director::getInstance()->getScheduler()->schedule([this](float) { updateCommits(); }, this, 0, false,
+                                                          ASSET_PRELOADER_COMMIT_KEY);
+    _commits.emplace_back(CommitTask{asset->priority, _commitOrder++, asset});
+    std::push_heap(_commits.begin(), _commits.end());
+}
+
+void AssetPreloader::commit(const std::shared_ptr<AssetState>& asset)
+{
+    switch (asset->type)
+    {
+    case AssetType::SpriteSheet:
+    {
+        auto cache = SpriteFrameCache::getInstance();
+        if (!cache->isSpriteFramesWithFileLoaded(asset->path))
+        {
+            uint32_t format = FileUtils::getPathExtension(asset->path) == ".ssb" ? SpriteSheetFormat::BINARY
+                                                                                 : SpriteSheetFormat::PLIST;
+            auto it = std::find_if(asset->dependencies.begin(), asset->dependencies.end(), [&asset](auto& dependency) {
+                return dependency->type == AssetType::Texture && dependency->path == asset->texture;
+            });
+            if (it != asset->dependencies.end() && (*it)->object)
+                cache->addSpriteFramesWithFile(asset->path, static_cast<Texture2D*>((*it)->object.get()), format);
+            else
+                cache->addSpriteFramesWithFile(asset->path, format);
+        }
+        finish(asset, cache->isSpriteFramesWithFileLoaded(asset->path));
+        break;
+    }
+    case AssetType::FontTTF:
+    {
+        TTFConfig config(asset->path, asset->fontSize);
+        asset->object = FontAtlasCache::getFontAtlasTTF(&config);
+        finish(asset, asset->object != nullptr);
+        break;
+    }
+    case AssetType::FontFNT:
+        asset->object = FontAtlasCache::getFontAtlasFNT(asset->path);
+        finish(asset, asset->object != nullptr);
+        break;
+    default:
+        break;
+    }
+}
+
+void AssetPreloader::updateCommits()
+{
+    using clock_type = std::chrono::steady_clock;
+
+    const auto endTime = clock_type::now() + std::chrono::duration_cast<clock_type::duration>(
+                                                 std::chrono::duration<float>(_commitBudget));
+    // at least one asset is committed per frame
+    do
+    {
+        std::pop_heap(_commits.begin(), _commits.end());
+        auto asset = _commits.back().asset.lock();
+        _commits.pop_back();
+        if (asset)
+            commit(asset);
+    } while (!_commits.empty() && clock_type::now() < endTime);
+
+    if (_commits.empty())
+        Director::getInstance()->getScheduler()->unschedule(ASSET_PRELOADER_COMMIT_KEY, this);
+}
+
+}  // namespace ax
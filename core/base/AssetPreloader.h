@@ -0,0 +1,258 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "base/Object.h"
+#include "base/RefPtr.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+enum class AssetType : uint8_t
+{
+    Texture,
+    SpriteSheet,  // a .plist or .ssb sprite sheet
+    FontTTF,
+    FontFNT,
+    Audio,
+    Model,  // a 3D model, loaded with MeshRenderer::createAsync
+};
+
+/**
+ * @brief The list of the assets a scene or a layout uses, preloaded with AssetPreloader.
+ *
+ * A manifest is a json file, usually generated when the scenes and the layouts are exported:
+ *
+ *     { "include": ["common.manifest"],
+ *       "assets": [{ "type": "spriteSheet", "path": "ui.plist", "texture": "ui.png", "priority": 1 },
+ *                  { "type": "fontTTF", "path": "fonts/arial.ttf", "size": 24 },
+ *                  { "type": "model", "path": "orc.c3b", "dependencies": ["orc.plist"] }] }
+ *
+ * The manifests of "include" are merged in. "texture" is the texture of a sprite sheet or a model, by default the
+ * one the file names. "dependencies" are the paths of the assets which are loaded first, "size" is the size of a
+ * TTF font, the assets of a higher "priority" are loaded first.
+ */
+class AX_DLL AssetManifest
+{
+public:
+    struct Asset
+    {
+        AssetType type;
+        std::string path;
+        std::string texture;
+        float fontSize = 0;
+        int priority   = 0;
+        std::vector<std::string> dependencies;
+    };
+
+    /** The names of the types in the manifest files. */
+    static std::string_view getTypeName(AssetType type);
+
+    /** Loads a manifest file with the manifests it includes, returns false when it can't be read. */
+    bool initWithFile(std::string_view filePath);
+
+    bool writeToFile(std::string_view fullPath) const;
+
+    /** Adds an asset, the asset is returned when it is already listed. The reference is valid until the next add. */
+    Asset& addAsset(AssetType type, std::string_view path, int priority = 0, float fontSize = 0);
+
+    void addManifest(const AssetManifest& other);
+
+    const std::vector<Asset>& getAssets() const { return _assets; }
+    bool empty() const { return _assets.empty(); }
+    void clear();
+
+protected:
+    bool load(std::string_view filePath, int depth);
+
+    std::vector<Asset> _assets;
+    std::unordered_map<std::string, size_t> _indices;  // by the keys of the assets
+};
+
+/**
+ * @brief Preloads the assets of a manifest in the background, with a single progress value.
+ *
+ * The assets are loaded by their caches, so a scene created once the preload completes finds them there: the
+ * textures in TextureCache, the sprite frames in SpriteFrameCache, the fonts in FontAtlasCache, the sounds with
+ * AudioEngine::preload and the models in the MeshRenderer cache. The files are read and decoded on the JobSystem
+ * workers, an asset already loaded or loading for another request isn't loaded twice.
+ *
+ * The texture uploads are spread over the frames by the budget of TextureCache::setAsyncUploadBudget and the models
+ * by the one of MeshRenderer. The sprite frames and the font atlases are created on the axmol thread within the
+ * commit budget of the preloader, so the frames of a transition don't hitch.
+ *
+ * The textures and the font atlases are kept loaded as long as the request is held, even when a cache is trimmed.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL AssetPreloader
+{
+protected:
+    struct AssetState;
+
+public:
+    class AX_DLL Request
+    {
+    public:
+        /** The share of the assets done, loaded or failed, from 0 to 1. */
+        float getProgress() const;
+        bool isDone() const { return _loaded + _failed == _assets.size(); }
+
+        size_t getAssetCount() const { return _assets.size(); }
+        size_t getLoadedCount() const { return _loaded; }
+        size_t getFailedCount() const { return _failed; }
+
+        /** Drops the callbacks and the assets of the request, the loads other requests wait for go on. */
+        void cancel();
+        bool isCancelled() const { return _cancelled; }
+
+    private:
+        friend class AssetPreloader;
+
+        std::vector<std::shared_ptr<AssetState>> _assets;
+        std::function<void(float)> _onProgress;
+        std::function<void(Request&)> _onComplete;
+        size_t _loaded  = 0;
+        size_t _failed  = 0;
+        bool _cancelled = false;
+    };
+
+    using ProgressCallback = std::function<void(float progress)>;
+    using CompleteCallback = std::function<void(Request& request)>;
+
+    /** The default time spent creating the sprite frames and the font atlases per frame, in seconds. */
+    static constexpr float DEFAULT_COMMIT_BUDGET = 0.004f;
+
+    static AssetPreloader* getInstance();
+    static void destroyInstance();
+
+    AssetPreloader() = default;
+    ~AssetPreloader();
+
+    /**
+     * Preloads the assets of a manifest.
+     * The callbacks are invoked on the axmol thread, onProgress after every asset done and onComplete once all of
+     * them are, the failed assets included. They are invoked only while the request is held, or before preload
+     * returns for the assets which are already loaded.
+     * @param priority Added to the priorities of the assets, the requests of a higher priority are loaded first.
+     * @return The request, it keeps its assets loaded until it is released.
+     */
+    std::shared_ptr<Request> preload(const AssetManifest& manifest,
+                                     ProgressCallback onProgress = nullptr,
+                                     CompleteCallback onComplete = nullptr,
+                                     int priority                = 0);
+
+    /** Preloads the assets of a manifest file, see AssetManifest::initWithFile. */
+    std::shared_ptr<Request> preload(std::string_view manifestPath,
+                                     ProgressCallback onProgress = nullptr,
+                                     CompleteCallback onComplete = nullptr,
+                                     int priority                = 0);
+
+    /** The progress over all the requests which aren't done, 1 when there are none. */
+    float getProgress() const;
+
+    /** Sets the time spent creating the sprite frames and the font atlases per frame, at least one is created per
+     * frame. */
+    void setCommitBudget(float seconds) { _commitBudget = seconds; }
+    float getCommitBudget() const { return _commitBudget; }
+
+protected:
+    enum class Status : uint8_t
+    {
+        Waiting,  // for its dependencies
+        Loading,
+        Loaded,
+        Failed,
+    };
+
+    struct AssetState
+    {
+        AssetType type;
+        Status status = Status::Waiting;
+        std::string path;
+        std::string texture;
+        float fontSize  = 0;
+        int priority    = 0;
+        bool committing = false;
+
+        uint32_t pendingDependencies = 0;
+        std::vector<std::shared_ptr<AssetState>> dependencies;  // kept loaded with the asset
+        std::vector<std::weak_ptr<AssetState>> dependents;
+        std::vector<std::weak_ptr<Request>> requests;
+
+        RefPtr<Object> object;  // the texture or the font atlas
+    };
+
+    struct CommitTask
+    {
+        int priority;
+        uint64_t order;
+        std::weak_ptr<AssetState> asset;
+
+        // the heap top is the highest priority, then the first queued
+        bool operator<(const CommitTask& other) const
+        {
+            return priority != other.priority ? priority < other.priority : order > other.order;
+        }
+    };
+
+    std::shared_ptr<AssetState> acquireAsset(AssetType type,
+                                             std::string_view path,
+                                             float fontSize,
+                                             int priority,
+                                             std::vector<std::shared_ptr<AssetState>>& created);
+    void addDependency(const std::shared_ptr<AssetState>& asset, const std::shared_ptr<AssetState>& dependency);
+
+    /** Starts an asset whose dependencies are done, called again for a sprite sheet once its texture is. */
+    void start(const std::shared_ptr<AssetState>& asset);
+    void startSpriteSheet(const std::shared_ptr<AssetState>& asset);
+    void finish(const std::shared_ptr<AssetState>& asset, bool loaded);
+
+    void queueCommit(const std::shared_ptr<AssetState>& asset);
+    void commit(const std::shared_ptr<AssetState>& asset);
+    void updateCommits();
+
+    std::unordered_map<std::string, std::weak_ptr<AssetState>> _assets;  // by the keys of the assets
+    std::vector<std::weak_ptr<Request>> _requests;
+    std::vector<CommitTask> _commits;  // a heap by priority then order
+    uint64_t _commitOrder = 0;
+    float _commitBudget   = DEFAULT_COMMIT_BUDGET;
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
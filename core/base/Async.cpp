@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/Async.h"
+
+#include "base/Director.h"
+#include "base/Scheduler.h"
+#include "platform/FileUtils.h"
+
+namespace ax
+{
+
+namespace detail
+{
+void resumeAfterJob(std::function<void()> job, JobPriority priority, axstd::coroutine_handle<> handle)
+{
+    Director::getInstance()->getJobSystem()->schedule(std::move(job), priority).thenOnAxmolThread([handle] {
+        handle.resume();
+    });
+}
+}  // namespace detail
+
+// posted again until the frame count changed, the functions posted while they run wait for the next update
+static void resumeAfterFrame(axstd::coroutine_handle<> handle, unsigned int frame)
+{
+    auto director = Director::getInstance();
+    director->getScheduler()->runOnAxmolThread([director, handle, frame] {
+        if (director->getTotalFrames() == frame)
+            resumeAfterFrame(handle, frame);
+        else
+            handle.resume();
+    });
+}
+
+void NextFrameAwaiter::await_suspend(axstd::coroutine_handle<> handle) const
+{
+    resumeAfterFrame(handle, Director::getInstance()->getTotalFrames());
+}
+
+void TimeSlice::syncFrame()
+{
+    const auto frame = Director::getInstance()->getTotalFrames();
+    if (!_started || frame != _frame)
+    {
+        _start   = std::chrono::steady_clock::now();
+        _frame   = frame;
+        _started = true;
+    }
+}
+
+bool TimeSlice::isExpired()
+{
+    syncFrame();
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() - _start).count() >= _budget;
+}
+
+void TimeSlice::await_suspend(axstd::coroutine_handle<> handle) const
+{
+    resumeAfterFrame(handle, _frame);
+}
+
+void TimeSlice::await_resume()
+{
+    syncFrame();
+}
+
+void JobHandleAwaiter::await_suspend(axstd::coroutine_handle<> handle) const
+{
+    job.thenOnAxmolThread([handle] { handle.resume(); });
+}
+
+Task<Data> readFileAsync(std::string filename)
+{
+    co_return co_await runAsync(
+        [filename = std::move(filename)] { return FileUtils::getInstance()->getDataFromFile(filename); },
+        JobPriority::Low);
+}
+
+}  // namespace ax
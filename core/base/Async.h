@@ -0,0 +1,357 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "base/Data.h"
+#include "base/JobSystem.h"
+#include "base/Macros.h"
+
+#if __has_include(<coroutine>)
+#    include <coroutine>
+namespace axstd
+{
+using suspend_always = std::suspend_always;
+using suspend_never  = std::suspend_never;
+template <typename _Ty = void>
+using coroutine_handle = std::coroutine_handle<_Ty>;
+}  // namespace axstd
+#elif __has_include(<experimental/coroutine>)
+// fallback to experimental, currently only for android, in the future may don't required,
+// for example: we upgrade ndk in the future releases of axmol
+#    include <experimental/coroutine>
+namespace axstd
+{
+using suspend_always = std::experimental::suspend_always;
+using suspend_never  = std::experimental::suspend_never;
+template <typename _Ty = void>
+using coroutine_handle = std::experimental::coroutine_handle<_Ty>;
+}  // namespace axstd
+#else
+#    error This compiler missing c++20 coroutine
+#endif
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+template <typename T = void>
+class Task;
+
+namespace detail
+{
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        void await_suspend(axstd::coroutine_handle<Promise> handle) noexcept
+        {
+            auto& promise = handle.promise();
+            if (promise._continuation)
+                promise._continuation.resume();
+            else if (promise._detached)
+                handle.destroy();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    // started right away, on the thread calling the coroutine
+    axstd::suspend_never initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() { AXASSERT(false, "An exception escaped an ax::Task coroutine"); }
+
+protected:
+    template <typename T>
+    friend class ax::Task;
+
+    axstd::coroutine_handle<> _continuation;
+    bool _detached = false;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        _value.emplace(std::forward<U>(value));
+    }
+
+    T takeValue() { return std::move(*_value); }
+
+private:
+    std::optional<T> _value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+    void takeValue() const noexcept {}
+};
+
+/** Schedules a job, the coroutine is resumed on the axmol thread once it is done. */
+AX_DLL void resumeAfterJob(std::function<void()> job, JobPriority priority, axstd::coroutine_handle<> handle);
+}  // namespace detail
+
+/**
+ * @brief The return type of the coroutines awaiting the asynchronous operations of the engine.
+ *
+ * A task starts right away on the thread calling it, and runs until its first co_await of an operation which isn't
+ * done yet. The asynchronous operations of the engine, runAsync, readFileAsync, TextureCache::loadTextureAsync,
+ * HttpClient::sendAsync and network::downloadFileAsync, are tasks too, so they run while the caller goes on until
+ * it awaits them. They resume their caller on the axmol thread, like nextFrame and awaitJob, so the code of a task
+ * runs on the axmol thread only, between the frames.
+ *
+ * A task can be awaited by another one, once, which gets its result. The task object can also be dropped, the
+ * coroutine still runs to its end. Nothing cancels a task, so the objects it uses must outlive it, or be retained by
+ * it, and its parameters are better taken by value.
+ @code
+ Task<void> loadLevel(RefPtr<Node> root)
+ {
+     // the layout is read and parsed while the texture is decoded
+     auto texture = Director::getInstance()->getTextureCache()->loadTextureAsync("level/atlas.png");
+     Data layout  = co_await readFileAsync("level/layout.json");
+     auto level   = co_await runAsync([layout] { return parseLevel(layout); });
+     buildLevel(root, level, co_await texture);
+ }
+ @endcode
+ * @js NA
+ * @lua NA
+ */
+template <typename T>
+class Task
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using handle       = axstd::coroutine_handle<promise_type>;
+
+    Task() = default;
+    Task(Task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    bool isDone() const { return !_handle || _handle.done(); }
+
+    // awaitable by another coroutine, once
+    bool await_ready() const noexcept { return _handle.done(); }
+    void await_suspend(axstd::coroutine_handle<> awaiting) noexcept { _handle.promise()._continuation = awaiting; }
+    T await_resume() { return _handle.promise().takeValue(); }
+
+private:
+    friend promise_type;
+
+    explicit Task(handle h) noexcept : _handle(h) {}
+
+    // a running coroutine destroys itself when it ends
+    void reset() noexcept
+    {
+        if (!_handle)
+            return;
+        if (_handle.done())
+            _handle.destroy();
+        else
+            _handle.promise()._detached = true;
+        _handle = nullptr;
+    }
+
+    handle _handle;
+};
+
+namespace detail
+{
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(axstd::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(axstd::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+}  // namespace detail
+
+/** Resumes the awaiting coroutine on the axmol thread, in the next frame. */
+struct AX_DLL NextFrameAwaiter
+{
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(axstd::coroutine_handle<> handle) const;
+    void await_resume() const noexcept {}
+};
+
+inline NextFrameAwaiter nextFrame()
+{
+    return {};
+}
+
+/**
+ * @brief Spreads a long coroutine over several frames.
+ *
+ * Awaiting the slice goes on right away until the coroutine ran for the budget in the current frame, it is resumed
+ * on the next frame otherwise. The time is counted from the first await of a frame, or from the resume.
+ @code
+ Task<void> fillList(ui::ListView* list, std::vector<Item> items)
+ {
+     TimeSlice slice(0.004f);
+     for (auto& item : items)
+     {
+         list->pushBackCustomItem(createItemView(item));
+         co_await slice;
+     }
+ }
+ @endcode
+ */
+class AX_DLL TimeSlice
+{
+public:
+    explicit TimeSlice(float seconds) : _budget(seconds) {}
+
+    /** Whether the budget of the current frame is used up. */
+    bool isExpired();
+
+    void setBudget(float seconds) { _budget = seconds; }
+    float getBudget() const { return _budget; }
+
+    bool await_ready() { return !isExpired(); }
+    void await_suspend(axstd::coroutine_handle<> handle) const;
+    void await_resume();
+
+private:
+    /** Restarts the slice in a new frame. */
+    void syncFrame();
+
+    std::chrono::steady_clock::time_point _start;
+    unsigned int _frame = 0;
+    bool _started       = false;
+    float _budget;
+};
+
+/** Runs a function on the JobSystem workers once awaited, the awaiting coroutine is resumed on the axmol thread with
+ its result. */
+template <typename R>
+class JobAwaiter
+{
+public:
+    explicit JobAwaiter(std::function<R()> function, JobPriority priority)
+        : _function(std::move(function)), _priority(priority)
+    {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(axstd::coroutine_handle<> handle)
+    {
+        detail::resumeAfterJob(
+            [this] {
+                if constexpr (std::is_void_v<R>)
+                    _function();
+                else
+                    _result.emplace(_function());
+            },
+            _priority, handle);
+    }
+
+    R await_resume()
+    {
+        if constexpr (!std::is_void_v<R>)
+            return std::move(*_result);
+    }
+
+private:
+    using Result = std::conditional_t<std::is_void_v<R>, bool, R>;
+
+    std::function<R()> _function;
+    std::optional<Result> _result;
+    JobPriority _priority;
+};
+
+namespace detail
+{
+template <typename R>
+Task<R> runJob(std::function<R()> function, JobPriority priority)
+{
+    co_return co_await JobAwaiter<R>(std::move(function), priority);
+}
+}  // namespace detail
+
+/** Runs a function on the JobSystem workers right away, the function must not touch the scene. */
+template <typename Fn, typename R = std::invoke_result_t<std::decay_t<Fn>&>>
+Task<R> runAsync(Fn&& function, JobPriority priority = JobPriority::Normal)
+{
+    return detail::runJob(std::function<R()>(std::forward<Fn>(function)), priority);
+}
+
+/** Resumes the awaiting coroutine on the axmol thread once a job of the task graph is done. */
+struct AX_DLL JobHandleAwaiter
+{
+    JobHandle job;
+
+    bool await_ready() const noexcept { return job.isDone(); }
+    void await_suspend(axstd::coroutine_handle<> handle) const;
+    void await_resume() const noexcept {}
+};
+
+inline JobHandleAwaiter awaitJob(JobHandle job)
+{
+    return JobHandleAwaiter{std::move(job)};
+}
+
+/** Reads a file on the JobSystem workers, see FileUtils::getDataFromFile. */
+AX_DLL Task<Data> readFileAsync(std::string filename);
+
+// end of base group
+/** @} */
+
+}  // namespace ax
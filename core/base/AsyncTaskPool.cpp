@@ -26,6 +26,10 @@ THE SOFTWARE.
 
 #include "base/AsyncTaskPool.h"
 
+#include <algorithm>
+
+#include "base/JobSystem.h"
+
 namespace ax
 {
 
@@ -48,6 +52,76 @@ void AsyncTaskPool::destroyInstance()
 
 AsyncTaskPool::AsyncTaskPool() {}
 
-AsyncTaskPool::~AsyncTaskPool() {}
+AsyncTaskPool::~AsyncTaskPool()
+{
+    std::unique_lock<std::mutex> lock(_queueMutex);
+    _stop = true;
+    for (auto&& tasks : _tasks)
+        tasks.clear();
+
+    // the tasks being run finish first
+    _idleCondition.wait(lock, [this] {
+        return std::none_of(std::begin(_running), std::end(_running), [](bool running) { return running; });
+    });
+}
+
+void AsyncTaskPool::stopTasks(TaskType type)
+{
+    std::unique_lock<std::mutex> lock(_queueMutex);
+    _tasks[(int)type].clear();
+}
+
+void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
+                            TaskCallBack callback,
+                            void* callbackParam,
+                            std::function<void()> task)
+{
+    const int index = (int)type;
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+
+        // don't allow enqueueing after stopping the pool
+        if (_stop)
+        {
+            AX_ASSERT(0 && "already stop");
+            return;
+        }
+
+        _tasks[index].emplace_back(AsyncTask{std::move(task), std::move(callback), callbackParam});
+        if (_running[index])
+            return;
+        _running[index] = true;
+    }
+
+    Director::getInstance()->getJobSystem()->schedule([this, index] { runTasks(index); }, JobPriority::Low);
+}
+
+void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, std::function<void()> task)
+{
+    enqueue(type, [](void*) {}, nullptr, std::move(task));
+}
+
+void AsyncTaskPool::runTasks(int type)
+{
+    for (;;)
+    {
+        AsyncTask task;
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            auto& tasks = _tasks[type];
+            if (tasks.empty())
+            {
+                _running[type] = false;
+                _idleCondition.notify_all();
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task.task();
+        Director::getInstance()->getScheduler()->runOnAxmolThread(std::bind(task.callback, task.callbackParam));
+    }
+}
 
 }
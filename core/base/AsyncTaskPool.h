@@ -29,15 +29,10 @@ THE SOFTWARE.
 #include "platform/PlatformMacros.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
-#include <vector>
-#include <queue>
-#include <memory>
-#include <thread>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
-#include <future>
 #include <functional>
-#include <stdexcept>
 
 /**
  * @addtogroup base
@@ -49,6 +44,7 @@ namespace ax
 /**
  * @class AsyncTaskPool
  * @brief This class allows to perform background operations without having to manipulate threads.
+ * The tasks run on the JobSystem workers, the tasks of a type one after the other in the order they were enqueued.
  * @js NA
  */
 class AX_DLL AsyncTaskPool
@@ -84,7 +80,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, the tasks of a type run one after the other.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task
      * thread.
      * @param callbackParam parameter used by the callback.
@@ -96,7 +92,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, the tasks of a type run one after the other.
      * @param task: task can be lambda function to be performed off thread.
      * @lua NA
      */
@@ -106,125 +102,27 @@ public:
     ~AsyncTaskPool();
 
 protected:
-    // thread tasks internally used
-    class ThreadTasks
+    struct AsyncTask
     {
-        struct AsyncTaskCallBack
-        {
-            TaskCallBack callback;
-            void* callbackParam;
-        };
-
-    public:
-        ThreadTasks() : _stop(false)
-        {
-            _thread = std::thread([this] {
-                for (;;)
-                {
-                    std::function<void()> task;
-                    AsyncTaskCallBack callback;
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        this->_condition.wait(lock, [this] { return this->_stop || !this->_tasks.empty(); });
-                        if (this->_stop && this->_tasks.empty())
-                            return;
-                        task     = std::move(this->_tasks.front());
-                        callback = std::move(this->_taskCallBacks.front());
-                        this->_tasks.pop();
-                        this->_taskCallBacks.pop();
-                    }
-
-                    task();
-                    Director::getInstance()->getScheduler()->runOnAxmolThread(
-                        std::bind(callback.callback, callback.callbackParam));
-                }
-            });
-        }
-        ~ThreadTasks()
-        {
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                _stop = true;
-
-                while (_tasks.size())
-                    _tasks.pop();
-                while (_taskCallBacks.size())
-                    _taskCallBacks.pop();
-            }
-            _condition.notify_all();
-            _thread.join();
-        }
-        void clear()
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            while (_tasks.size())
-                _tasks.pop();
-            while (_taskCallBacks.size())
-                _taskCallBacks.pop();
-        }
-
-        void enqueue(TaskCallBack callback, void* callbackParam, std::function<void()> task)
-        {
-            AsyncTaskCallBack taskCallBack;
-            taskCallBack.callback      = std::move(callback);
-            taskCallBack.callbackParam = callbackParam;
-
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-
-                // don't allow enqueueing after stopping the pool
-                if (_stop)
-                {
-                    AX_ASSERT(0 && "already stop");
-                    return;
-                }
-
-                _tasks.push(std::move(task));
-                _taskCallBacks.push(std::move(taskCallBack));
-            }
-            _condition.notify_one();
-        }
-
-    private:
-        // need to keep track of thread so we can join them
-        std::thread _thread;
-        // the task queue
-        std::queue<std::function<void()>> _tasks;
-        std::queue<AsyncTaskCallBack> _taskCallBacks;
-
-        // synchronization
-        std::mutex _queueMutex;
-        std::condition_variable _condition;
-        bool _stop;
+        std::function<void()> task;
+        TaskCallBack callback;
+        void* callbackParam;
     };
 
-    // tasks
-    ThreadTasks _threadTasks[int(TaskType::TASK_MAX_TYPE)];
+    /** Runs the tasks of a type until there is none left, on a JobSystem worker. */
+    void runTasks(int type);
 
-    static AsyncTaskPool* s_asyncTaskPool;
-};
-
-inline void AsyncTaskPool::stopTasks(TaskType type)
-{
-    auto& threadTask = _threadTasks[(int)type];
-    threadTask.clear();
-}
-
-inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
-                                   TaskCallBack callback,
-                                   void* callbackParam,
-                                   std::function<void()> task)
-{
-    auto& threadTask = _threadTasks[(int)type];
+    // the tasks waiting by type, a type has one JobSystem job at most running them
+    std::deque<AsyncTask> _tasks[int(TaskType::TASK_MAX_TYPE)];
+    bool _running[int(TaskType::TASK_MAX_TYPE)]{};
+    bool _stop = false;
 
-    threadTask.enqueue(std::move(callback), callbackParam, std::move(task));
-}
+    // synchronization
+    std::mutex _queueMutex;
+    std::condition_variable _idleCondition;
 
-inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, std::function<void()> task)
-{
-    enqueue(
-        type, [](void*) {}, nullptr, std::move(task));
-}
+    static AsyncTaskPool* s_asyncTaskPool;
+};
 
 }
 // end group
@@ -134,6 +134,8 @@ PoolManager::~PoolManager()
 {
     AXLOGD("deallocing PoolManager: {}", fmt::ptr(this));
 
+    releaseDeferredObjects();
+
     while (!_releasePoolStack.empty())
     {
         AutoreleasePool* pool = _releasePoolStack.back();
@@ -157,6 +159,27 @@ bool PoolManager::isObjectInPools(Object* obj) const
     return false;
 }
 
+void PoolManager::addDeferredRelease(Object* object)
+{
+    std::lock_guard<std::mutex> lock(_deferredMutex);
+    _deferredReleases.emplace_back(object);
+}
+
+void PoolManager::releaseDeferredObjects()
+{
+    {
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        if (_deferredReleases.empty())
+            return;
+        _releasingObjects.swap(_deferredReleases);
+    }
+
+    // the destructors may defer releases again, they are released in the next frame
+    for (auto object : _releasingObjects)
+        object->release();
+    _releasingObjects.clear();
+}
+
 void PoolManager::push(AutoreleasePool* pool)
 {
     _releasePoolStack.emplace_back(pool);
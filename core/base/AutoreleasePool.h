@@ -27,6 +27,7 @@ THE SOFTWARE.
 #ifndef __AUTORELEASEPOOL_H__
 #define __AUTORELEASEPOOL_H__
 
+#include <mutex>
 #include <vector>
 #include <string>
 #include "base/Object.h"
@@ -165,6 +166,12 @@ public:
 
     bool isObjectInPools(Object* obj) const;
 
+    /** Queue a release for releaseDeferredObjects, thread safe. See Object::releaseDeferred. */
+    void addDeferredRelease(Object* object);
+
+    /** Release the queued objects, called by the Director every frame after the current pool is cleared. */
+    void releaseDeferredObjects();
+
     friend class AutoreleasePool;
 
 private:
@@ -177,6 +184,10 @@ private:
     static PoolManager* s_singleInstance;
 
     std::vector<AutoreleasePool*> _releasePoolStack;
+
+    std::mutex _deferredMutex;
+    std::vector<Object*> _deferredReleases;
+    std::vector<Object*> _releasingObjects;
 };
 /**
  * @endcond
@@ -237,14 +237,23 @@ THE SOFTWARE.
 #    define AX_NODE_DEBUG_VERIFY_EVENT_LISTENERS 0
 #endif
 
-/** @def AX_ENABLE_PROFILERS
- * If enabled, will activate various profilers within cocos2d. This statistical data will be output to the console
- * once per second showing average time (in milliseconds) required to execute the specific routine(s).
- * Useful for debugging purposes only. It is recommended to leave it disabled.
- * To enable set it to a value different than 0. Disabled by default.
+/** @def AX_ENABLE_TRACE
+ * If enabled, the engine main loop, loaders and JobSystem workers are instrumented with trace markers, see
+ * `ax::Tracer`. Nothing is recorded until `Tracer::start` is invoked, a marker then costs one atomic load.
+ * To disable set it to 0. Enabled by default.
+ */
+#ifndef AX_ENABLE_TRACE
+#    define AX_ENABLE_TRACE 1
+#endif
+
+/** @def AX_ENABLE_ATOMIC_REFCOUNT
+ * If enabled, the reference count of `ax::Object` is atomic, so objects may be retained and released by the
+ * JobSystem workers. The last release of an object holding GPU resources or nodes should still happen on the
+ * axmol thread, workers hand their references back with `Object::releaseDeferred`.
+ * Atomic increments cost a few cycles more, so it is disabled by default.
  */
-#ifndef AX_ENABLE_PROFILERS
-#    define AX_ENABLE_PROFILERS 0
+#ifndef AX_ENABLE_ATOMIC_REFCOUNT
+#    define AX_ENABLE_ATOMIC_REFCOUNT 0
 #endif
 
 /** Enable Lua engine debug log. */
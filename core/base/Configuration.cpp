@@ -69,7 +69,7 @@ bool Configuration::init()
 {
     _valueDict["axmol.version"] = Value(axmolVersion());
 
-#if AX_ENABLE_PROFILERS
+#if AX_ENABLE_TRACE
     _valueDict["axmol.compiled_with_profiler"] = Value(true);
 #else
     _valueDict["axmol.compiled_with_profiler"] = Value(false);
@@ -108,12 +108,6 @@ Configuration::~Configuration()
 std::string Configuration::getInfo() const
 {
     // And Dump some warnings as well
-#if AX_ENABLE_PROFILERS
-    AXLOGD(
-        "axmol: **** WARNING **** AX_ENABLE_PROFILERS is defined. Disable it when you finish profiling (from "
-        "ccConfig.h)\n");
-#endif
-
 #if AX_ENABLE_GL_STATE_CACHE == 0
     AXLOGD(
         "axmol: **** WARNING **** AX_ENABLE_GL_STATE_CACHE is disabled. To improve performance, enable it (from "
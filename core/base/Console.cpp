@@ -33,6 +33,7 @@
 #include <locale>
 #include <sstream>
 #include <optional>
+#include <map>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -45,11 +46,17 @@
 
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/ObjectArena.h"
+#include "base/Allocator.h"
+#include "base/Profiling.h"
 #include "platform/PlatformConfig.h"
 #include "base/Configuration.h"
 #include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "renderer/TextureCache.h"
+#include "renderer/Renderer.h"
 #include "base/Utils.h"
 #include "base/UTF8.h"
 
@@ -356,18 +363,24 @@ Console::Console()
     , _bindAddress()
 {
     createCommandAllocator();
+    createCommandAllocations();
+    createCommandBatches();
     createCommandConfig();
     createCommandDebugMsg();
     createCommandDirector();
     createCommandExit();
     createCommandFileUtils();
     createCommandFps();
+    createCommandFrameTimes();
     createCommandHelp();
+    createCommandProfiler();
     createCommandProjection();
+    createCommandRenderQueue();
     createCommandResolution();
     createCommandSceneGraph();
     createCommandTexture();
     createCommandTouch();
+    createCommandTrace();
     createCommandUpload();
     createCommandVersion();
 }
@@ -614,6 +627,7 @@ void Console::loop()
             {
                 _watcher.mod_event(fd, 0, yasio::socket_event::read);
                 _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end());
+                removeClientStreams(fd);
             }
         }
 
@@ -633,6 +647,21 @@ void Console::loop()
                 _DebugStringsMutex.unlock();
             }
         }
+
+        /* Any message for a single client ? */
+        if (!_clientMessages.empty())
+        {
+            if (_DebugStringsMutex.try_lock())
+            {
+                for (const auto& [fd, str] : _clientMessages)
+                {
+                    if (std::find(_fds.begin(), _fds.end(), fd) != _fds.end())
+                        Console::Utility::sendToConsole(fd, str.c_str(), str.length());
+                }
+                _clientMessages.clear();
+                _DebugStringsMutex.unlock();
+            }
+        }
     }
 
     // clean up: ignore stdin, stdout and stderr
@@ -842,10 +871,30 @@ void Console::addClient()
 
 void Console::createCommandAllocator()
 {
-    addCommand({"allocator", "Display allocator diagnostics for all allocators. Args: [-h | help | ]",
+    addCommand({"allocator", "Print the memory of the engine by tag, see Memory. Args: [-h | help | ]",
                 AX_CALLBACK_2(Console::commandAllocator, this)});
 }
 
+void Console::createCommandAllocations()
+{
+    addCommand({"allocations", "Print the allocations of the last frame. Args: [-h | help | on | off | ]",
+                AX_CALLBACK_2(Console::commandAllocations, this)});
+    addSubCommand("allocations", {"on", "Count the objects created per frame by type, see ObjectArena.",
+                                  AX_CALLBACK_2(Console::commandAllocationsSubCommandOnOff, this)});
+    addSubCommand("allocations", {"off", "Stop counting the objects created per frame.",
+                                  AX_CALLBACK_2(Console::commandAllocationsSubCommandOnOff, this)});
+}
+
+void Console::createCommandBatches()
+{
+    addCommand({"batches", "Print the batch breaks of the last frame. Args: [-h | help | on | off | ]",
+                AX_CALLBACK_2(Console::commandBatches, this)});
+    addSubCommand("batches", {"on", "Record the batch breaks, see Renderer::setBatchDiagnosticsEnabled.",
+                              AX_CALLBACK_2(Console::commandBatchesSubCommandOnOff, this)});
+    addSubCommand("batches", {"off", "Stop recording the batch breaks.",
+                              AX_CALLBACK_2(Console::commandBatchesSubCommandOnOff, this)});
+}
+
 void Console::createCommandConfig()
 {
     addCommand({"config", "Print the Configuration object. Args: [-h | help | ]",
@@ -904,11 +953,36 @@ void Console::createCommandFps()
                           AX_CALLBACK_2(Console::commandFpsSubCommandOnOff, this)});
 }
 
+void Console::createCommandFrameTimes()
+{
+    addCommand({"frametimes",
+                "Print the frame time histogram. Args: [-h | help | on | off | reset | stream | ]",
+                AX_CALLBACK_2(Console::commandFrameTimes, this)});
+    addSubCommand("frametimes", {"on", "Collect the frame times.",
+                                 AX_CALLBACK_2(Console::commandFrameTimesSubCommandOnOff, this)});
+    addSubCommand("frametimes", {"off", "Stop collecting the frame times and streaming them.",
+                                 AX_CALLBACK_2(Console::commandFrameTimesSubCommandOnOff, this)});
+    addSubCommand("frametimes", {"reset", "Clear the frame time histogram.",
+                                 AX_CALLBACK_2(Console::commandFrameTimesSubCommandReset, this)});
+    addSubCommand("frametimes", {"stream", "Start or stop sending the histogram of every second to this client.",
+                                 AX_CALLBACK_2(Console::commandFrameTimesSubCommandStream, this)});
+}
+
 void Console::createCommandHelp()
 {
     addCommand({"help", "Print this message. Args: [ ]", AX_CALLBACK_2(Console::commandHelp, this)});
 }
 
+void Console::createCommandProfiler()
+{
+    addCommand({"profiler", "Print the CPU and GPU timings of the last frame. Args: [-h | help | on | off | ]",
+                AX_CALLBACK_2(Console::commandProfiler, this)});
+    addSubCommand("profiler", {"on", "Measure the frame timings, see Renderer::setProfilingEnabled.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandOnOff, this)});
+    addSubCommand("profiler", {"off", "Stop measuring the frame timings.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandOnOff, this)});
+}
+
 void Console::createCommandProjection()
 {
     addCommand({"projection", "Change or print the current projection. Args: [-h | help | 2d | 3d | ]",
@@ -919,6 +993,12 @@ void Console::createCommandProjection()
                                  AX_CALLBACK_2(Console::commandProjectionSubCommand3d, this)});
 }
 
+void Console::createCommandRenderQueue()
+{
+    addCommand({"renderqueue", "Print the sorted render queues of the next frame. Args: [-h | help | ]",
+                AX_CALLBACK_2(Console::commandRenderQueue, this)});
+}
+
 void Console::createCommandResolution()
 {
     addCommand({"resolution",
@@ -949,6 +1029,19 @@ void Console::createCommandTouch()
                             AX_CALLBACK_2(Console::commandTouchSubCommandSwipe, this)});
 }
 
+void Console::createCommandTrace()
+{
+    addCommand({"trace", "Capture the trace markers and frame timings. Args: [-h | help | start | stop | send | ]",
+                AX_CALLBACK_2(Console::commandTrace, this)});
+    addSubCommand("trace", {"start", "Start recording, with the renderer profiling for the GPU timings.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandStart, this)});
+    addSubCommand("trace", {"stop", "trace stop [path]: stop recording and save the Chrome trace JSON, by default to "
+                                    "trace.json in the writable path.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandStop, this)});
+    addSubCommand("trace", {"send", "Send the Chrome trace JSON to this client.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandSend, this)});
+}
+
 void Console::createCommandUpload()
 {
     addCommand(
@@ -966,13 +1059,120 @@ void Console::createCommandVersion()
 
 void Console::commandAllocator(socket_native_type fd, std::string_view /*args*/)
 {
-#if AX_ENABLE_ALLOCATOR_DIAGNOSTICS
-    auto info = allocator::AllocatorDiagnostics::instance()->diagnostics();
-    Console::Utility::mydprintf(fd, info.c_str());
-#else
-    Console::Utility::mydprintf(
-        fd, "allocator diagnostics not available. AX_ENABLE_ALLOCATOR_DIAGNOSTICS must be set to 1 in ccConfig.h\n");
-#endif
+    // the counters are atomic, no need to go through the axmol thread
+    std::string info = fmt::format("{:<8} {:>12} {:>12} {:>12} {:>14} {:>14}\n", "tag", "live bytes", "peak bytes",
+                                   "budget", "allocs/frame", "bytes/frame");
+    for (int i = 0; i < static_cast<int>(MemoryTag::COUNT); ++i)
+    {
+        auto tag   = static_cast<MemoryTag>(i);
+        auto stats = Memory::getStats(tag);
+        fmt::format_to(std::back_inserter(info), "{:<8} {:>12} {:>12} {:>12} {:>14} {:>14}{}\n",
+                       Memory::getTagName(tag), stats.liveBytes, stats.peakBytes, stats.budget, stats.frameAllocations, stats.frameBytes,
+                       Memory::isOverBudget(tag) ? " over budget" : "");
+    }
+    Console::Utility::mydprintf(fd, "%s", info.c_str());
+}
+
+void Console::commandAllocations(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd]() {
+        auto renderer    = Director::getInstance()->getRenderer();
+        std::string info = fmt::format("Renderer heap allocations: {}\n", renderer->getFrameHeapAllocations());
+
+        auto arena = ObjectArena::getInstance();
+        if (arena->isCreationStatsEnabled())
+        {
+            size_t autoreleased = 0, arenaCount = 0;
+            for (auto&& stats : arena->getLastFrameCreations())
+            {
+                autoreleased += stats.autoreleased;
+                arenaCount += stats.arena;
+            }
+            fmt::format_to(std::back_inserter(info), "Objects created: {} autoreleased, {} in the arena\n",
+                           autoreleased, arenaCount);
+            for (auto&& stats : arena->getLastFrameCreations())
+                fmt::format_to(std::back_inserter(info), "  {}: {} autoreleased, {} in the arena\n", stats.typeName,
+                               stats.autoreleased, stats.arena);
+        }
+        else
+            info += "Object creation stats are: off\n";
+
+        Console::Utility::mydprintf(fd, "%s", info.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandAllocationsSubCommandOnOff(socket_native_type /*fd*/, std::string_view args)
+{
+    bool state       = (args.compare("on") == 0);
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([state]() { ObjectArena::getInstance()->setCreationStatsEnabled(state); });
+}
+
+void Console::commandBatches(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd]() {
+        auto renderer = Director::getInstance()->getRenderer();
+        if (!renderer->isBatchDiagnosticsEnabled())
+        {
+            Console::Utility::mydprintf(fd, "Batch diagnostics are: off\n");
+            Console::Utility::sendPrompt(fd);
+            return;
+        }
+
+        static const char* const reasonNames[] = {"texture", "program", "blend func",
+                                                  "skip batching", "buffer full", "other command"};
+        static_assert(AX_ARRAYSIZE(reasonNames) == (size_t)Renderer::BatchBreak::COUNT);
+
+        const auto& counts = renderer->getBatchBreakCounts();
+        std::string info   = fmt::format("Draw calls: {}\n", renderer->getDrawnBatches());
+        for (size_t reason = 0; reason < counts.size(); ++reason)
+            fmt::format_to(std::back_inserter(info), "  {}: {}\n", reasonNames[reason], counts[reason]);
+
+        // the same break between the same nodes is printed once, the most frequent first
+        using BreakKey = std::tuple<Renderer::BatchBreak, const Node*, const Node*>;
+        std::map<BreakKey, uint32_t> aggregated;
+        for (auto&& info : renderer->getBatchBreaks())
+            ++aggregated[BreakKey{info.reason, info.previousNode, info.node}];
+
+        std::vector<std::pair<BreakKey, uint32_t>> sorted(aggregated.begin(), aggregated.end());
+        std::stable_sort(sorted.begin(), sorted.end(), [](auto& lhs, auto& rhs) { return lhs.second > rhs.second; });
+
+        // the recorded nodes may be gone, only the ones still in the scene are described
+        std::unordered_map<const Node*, Node*> liveNodes;
+        std::function<void(Node*)> collect = [&](Node* node) {
+            liveNodes.emplace(node, node);
+            for (auto child : node->getChildren())
+                collect(child);
+        };
+        if (auto scene = Director::getInstance()->getRunningScene())
+            collect(scene);
+        auto describe = [&](const Node* node) -> std::string {
+            auto it = liveNodes.find(node);
+            return it != liveNodes.end() ? it->second->getDescription() : std::string{"<unknown>"};
+        };
+
+        const size_t count = (std::min)(sorted.size(), size_t{20});
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& [key, times] = sorted[i];
+            fmt::format_to(std::back_inserter(info), "{:>4}x {}: {} -> {}\n", times,
+                           reasonNames[(size_t)std::get<0>(key)], describe(std::get<1>(key)),
+                           describe(std::get<2>(key)));
+        }
+
+        Console::Utility::mydprintf(fd, "%s", info.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandBatchesSubCommandOnOff(socket_native_type /*fd*/, std::string_view args)
+{
+    bool state       = (args.compare("on") == 0);
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([state]() { Director::getInstance()->getRenderer()->setBatchDiagnosticsEnabled(state); });
 }
 
 void Console::commandConfig(socket_native_type fd, std::string_view /*args*/)
@@ -1030,6 +1230,7 @@ void Console::commandExit(socket_native_type fd, std::string_view /*args*/)
 {
     _watcher.mod_event(fd, 0, yasio::socket_event::read);
     _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end());
+    removeClientStreams(fd);
     closesocket(fd);
 }
 
@@ -1057,11 +1258,105 @@ void Console::commandFpsSubCommandOnOff(socket_native_type /*fd*/, std::string_v
     sched->runOnAxmolThread(std::bind(&Director::setStatsDisplay, dir, state));
 }
 
+void Console::commandFrameTimes(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this, fd]() {
+        if (!_frameTimeListener)
+            Console::Utility::mydprintf(fd, "Frame times are: off\n");
+        else
+            Console::Utility::mydprintf(fd, "%s\n", _frameTimes.toString().c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandFrameTimesSubCommandOnOff(socket_native_type /*fd*/, std::string_view args)
+{
+    bool state       = (args.compare("on") == 0);
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this, state]() {
+        auto eventDispatcher = Director::getInstance()->getEventDispatcher();
+        if (state && !_frameTimeListener)
+        {
+            _frameTimes         = FrameTimeHistogram{};
+            _streamedFrameTimes = FrameTimeHistogram{};
+            _streamElapsed      = 0;
+            _frameTimeListener  = eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW,
+                                                                          [this](EventCustom*) { updateFrameTimes(); });
+        }
+        else if (!state && _frameTimeListener)
+        {
+            eventDispatcher->removeEventListener(_frameTimeListener);
+            _frameTimeListener = nullptr;
+            _frameTimeStreams.clear();
+        }
+    });
+}
+
+void Console::commandFrameTimesSubCommandReset(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this]() { _frameTimes = FrameTimeHistogram{}; });
+}
+
+void Console::commandFrameTimesSubCommandStream(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this, fd]() {
+        if (!_frameTimeListener)
+        {
+            Console::Utility::mydprintf(fd, "Frame times are: off, type [frametimes on] first\n");
+            Console::Utility::sendPrompt(fd);
+            return;
+        }
+
+        auto it = std::find(_frameTimeStreams.begin(), _frameTimeStreams.end(), fd);
+        if (it != _frameTimeStreams.end())
+            _frameTimeStreams.erase(it);
+        else
+            _frameTimeStreams.emplace_back(fd);
+    });
+}
+
 void Console::commandHelp(socket_native_type fd, std::string_view /*args*/)
 {
     sendHelp(fd, _commands, "\nAvailable commands:\n");
 }
 
+void Console::commandProfiler(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd]() {
+        auto renderer = Director::getInstance()->getRenderer();
+        if (!renderer->isProfilingEnabled())
+        {
+            Console::Utility::mydprintf(fd, "Profiler is: off\n");
+            Console::Utility::sendPrompt(fd);
+            return;
+        }
+
+        const auto& profile = renderer->getFrameProfile();
+        std::string info    = fmt::format(
+            "CPU visit: {:.3f} ms, sort: {:.3f} ms, encode: {:.3f} ms, submit: {:.3f} ms\n"
+               "GPU: {:.3f} ms{}\n",
+            profile.visit, profile.sort, profile.encode, profile.submit, profile.gpu,
+            renderer->isGPUTimerSupported() ? "" : " (timer queries not supported)");
+        for (auto&& sample : profile.gpuTimers)
+            fmt::format_to(std::back_inserter(info), "{:>{}}{}: {:.3f} ms\n", "", sample.depth * 2 + 2, sample.label,
+                           sample.milliseconds);
+
+        Console::Utility::mydprintf(fd, "%s", info.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandProfilerSubCommandOnOff(socket_native_type /*fd*/, std::string_view args)
+{
+    bool state       = (args.compare("on") == 0);
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([state]() { Director::getInstance()->getRenderer()->setProfilingEnabled(state); });
+}
+
 void Console::commandProjection(socket_native_type fd, std::string_view /*args*/)
 {
     auto director = Director::getInstance();
@@ -1100,6 +1395,17 @@ void Console::commandProjectionSubCommand3d(socket_native_type /*fd*/, std::stri
     sched->runOnAxmolThread([=]() { director->setProjection(Director::Projection::_3D); });
 }
 
+void Console::commandRenderQueue(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd]() {
+        Director::getInstance()->getRenderer()->captureRenderQueues([fd](std::string info) {
+            Console::Utility::sendToConsole(fd, info.c_str(), info.length());
+            Console::Utility::sendPrompt(fd);
+        });
+    });
+}
+
 void Console::commandResolution(socket_native_type /*fd*/, std::string_view args)
 {
     int policy;
@@ -1281,6 +1587,58 @@ void Console::commandTouchSubCommandSwipe(socket_native_type fd, std::string_vie
 
 static char invalid_filename_char[] = {':', '/', '\\', '?', '%', '*', '<', '>', '"', '|', '\r', '\n', '\t'};
 
+void Console::commandTrace(socket_native_type fd, std::string_view /*args*/)
+{
+    Console::Utility::mydprintf(fd, "Trace is: %s\n", Tracer::isRecording() ? "recording" : "off");
+}
+
+void Console::commandTraceSubCommandStart(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this]() {
+        // the renderer adds its frame timings to the trace while profiling
+        auto renderer = Director::getInstance()->getRenderer();
+        if (!renderer->isProfilingEnabled())
+        {
+            renderer->setProfilingEnabled(true);
+            _traceEnabledProfiling = true;
+        }
+        Tracer::getInstance()->start();
+    });
+}
+
+void Console::commandTraceSubCommandStop(socket_native_type fd, std::string_view args)
+{
+    // the args are "stop [path]"
+    std::string path{args.substr((std::min)(args.size(), std::string_view{"stop"}.size()))};
+    Console::Utility::trim(path);
+
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this, fd, path = std::move(path)]() {
+        auto tracer = Tracer::getInstance();
+        tracer->stop();
+        if (_traceEnabledProfiling)
+        {
+            Director::getInstance()->getRenderer()->setProfilingEnabled(false);
+            _traceEnabledProfiling = false;
+        }
+
+        auto file = path.empty() ? FileUtils::getInstance()->getWritablePath() + "trace.json" : path;
+        if (tracer->saveChromeTrace(file))
+            Console::Utility::mydprintf(fd, "Trace saved to: %s\n", file.c_str());
+        else
+            Console::Utility::mydprintf(fd, "Can't write the trace to: %s\n", file.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
+void Console::commandTraceSubCommandSend(socket_native_type fd, std::string_view /*args*/)
+{
+    auto json = Tracer::getInstance()->toChromeTrace();
+    json += '\n';
+    Console::Utility::sendToConsole(fd, json.c_str(), json.length());
+}
+
 void Console::commandUpload(socket_native_type fd)
 {
     ssize_t n, rc;
@@ -1387,6 +1745,64 @@ void Console::printSceneGraphBoot(socket_native_type fd)
     Console::Utility::sendPrompt(fd);
 }
 
+void Console::FrameTimeHistogram::add(float seconds)
+{
+    // the upper bounds of the buckets in milliseconds, the last one has none
+    static const float bounds[BUCKET_COUNT - 1] = {8.4f, 16.7f, 25.0f, 33.4f, 50.0f, 66.7f, 100.0f};
+
+    const float milliseconds = seconds * 1000.0f;
+    auto bucket = std::upper_bound(std::begin(bounds), std::end(bounds), milliseconds) - std::begin(bounds);
+    ++buckets[bucket];
+    ++frames;
+    totalSeconds += seconds;
+    maxSeconds = (std::max)(maxSeconds, seconds);
+}
+
+std::string Console::FrameTimeHistogram::toString() const
+{
+    static const char* const labels[BUCKET_COUNT] = {"<8.4", "<16.7", "<25", "<33.4", "<50", "<66.7", "<100", ">=100"};
+
+    std::string info = fmt::format("frames: {} avg: {:.2f} ms max: {:.2f} ms |", frames,
+                                   frames ? totalSeconds * 1000.0f / frames : 0.0f, maxSeconds * 1000.0f);
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        fmt::format_to(std::back_inserter(info), " {}: {}", labels[i], buckets[i]);
+    return info;
+}
+
+void Console::updateFrameTimes()
+{
+    const float dt = Director::getInstance()->getDeltaTime();
+    _frameTimes.add(dt);
+    if (_frameTimeStreams.empty())
+        return;
+
+    _streamedFrameTimes.add(dt);
+    _streamElapsed += dt;
+    if (_streamElapsed < 1.0f)
+        return;
+
+    auto line = _streamedFrameTimes.toString();
+    line += '\n';
+    {
+        std::lock_guard<std::mutex> lock(_DebugStringsMutex);
+        for (auto fd : _frameTimeStreams)
+            _clientMessages.emplace_back(fd, line);
+    }
+    _watcher.wakeup();
+
+    _streamedFrameTimes = FrameTimeHistogram{};
+    _streamElapsed      = 0;
+}
+
+void Console::removeClientStreams(socket_native_type fd)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([this, fd]() {
+        _frameTimeStreams.erase(std::remove(_frameTimeStreams.begin(), _frameTimeStreams.end(), fd),
+                                _frameTimeStreams.end());
+    });
+}
+
 void Console::printFileUtils(socket_native_type fd)
 {
     FileUtils* fu = FileUtils::getInstance();
@@ -52,6 +52,8 @@ typedef SSIZE_T ssize_t;
 namespace ax
 {
 
+class EventListenerCustom;
+
 /** Console is helper class that lets the developer control the game from TCP connection.
  Console will spawn a new thread that will listen to a specified TCP port.
  Console has a basic token parser. Each token is associated with an std::function<void(int)>.
@@ -214,23 +216,33 @@ protected:
 
     // create a map of command.
     void createCommandAllocator();
+    void createCommandAllocations();
+    void createCommandBatches();
     void createCommandConfig();
     void createCommandDebugMsg();
     void createCommandDirector();
     void createCommandExit();
     void createCommandFileUtils();
     void createCommandFps();
+    void createCommandFrameTimes();
     void createCommandHelp();
+    void createCommandProfiler();
     void createCommandProjection();
+    void createCommandRenderQueue();
     void createCommandResolution();
     void createCommandSceneGraph();
     void createCommandTexture();
     void createCommandTouch();
+    void createCommandTrace();
     void createCommandUpload();
     void createCommandVersion();
 
     // Add commands here
     void commandAllocator(socket_native_type fd, std::string_view args);
+    void commandAllocations(socket_native_type fd, std::string_view args);
+    void commandAllocationsSubCommandOnOff(socket_native_type fd, std::string_view args);
+    void commandBatches(socket_native_type fd, std::string_view args);
+    void commandBatchesSubCommandOnOff(socket_native_type fd, std::string_view args);
     void commandConfig(socket_native_type fd, std::string_view args);
     void commandDebugMsg(socket_native_type fd, std::string_view args);
     void commandDebugMsgSubCommandOnOff(socket_native_type fd, std::string_view args);
@@ -244,10 +256,17 @@ protected:
     void commandFileUtilsSubCommandFlush(socket_native_type fd, std::string_view args);
     void commandFps(socket_native_type fd, std::string_view args);
     void commandFpsSubCommandOnOff(socket_native_type fd, std::string_view args);
+    void commandFrameTimes(socket_native_type fd, std::string_view args);
+    void commandFrameTimesSubCommandOnOff(socket_native_type fd, std::string_view args);
+    void commandFrameTimesSubCommandReset(socket_native_type fd, std::string_view args);
+    void commandFrameTimesSubCommandStream(socket_native_type fd, std::string_view args);
     void commandHelp(socket_native_type fd, std::string_view args);
+    void commandProfiler(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandOnOff(socket_native_type fd, std::string_view args);
     void commandProjection(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand2d(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand3d(socket_native_type fd, std::string_view args);
+    void commandRenderQueue(socket_native_type fd, std::string_view args);
     void commandResolution(socket_native_type fd, std::string_view args);
     void commandResolutionSubCommandEmpty(socket_native_type fd, std::string_view args);
     void commandSceneGraph(socket_native_type fd, std::string_view args);
@@ -255,6 +274,10 @@ protected:
     void commandTexturesSubCommandFlush(socket_native_type fd, std::string_view args);
     void commandTouchSubCommandTap(socket_native_type fd, std::string_view args);
     void commandTouchSubCommandSwipe(socket_native_type fd, std::string_view args);
+    void commandTrace(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandStart(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandStop(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandSend(socket_native_type fd, std::string_view args);
     void commandUpload(socket_native_type fd);
     void commandVersion(socket_native_type fd, std::string_view args);
     // file descriptor: socket, console, etc.
@@ -279,6 +302,30 @@ protected:
 
     std::string _bindAddress;
 
+    /** The frame time counts by duration, see the frametimes command. */
+    struct FrameTimeHistogram
+    {
+        static constexpr size_t BUCKET_COUNT = 8;
+
+        std::array<uint32_t, BUCKET_COUNT> buckets{};
+        uint32_t frames    = 0;
+        float totalSeconds = 0;
+        float maxSeconds   = 0;
+
+        void add(float seconds);
+        std::string toString() const;
+    };
+
+    // the frame times are updated and streamed on the axmol thread, the console lives as long as the director
+    EventListenerCustom* _frameTimeListener = nullptr;
+    FrameTimeHistogram _frameTimes;
+    FrameTimeHistogram _streamedFrameTimes;
+    float _streamElapsed = 0;
+    std::vector<socket_native_type> _frameTimeStreams;
+    // the messages for a single client, sent by the console thread, guarded by _DebugStringsMutex
+    std::vector<std::pair<socket_native_type, std::string>> _clientMessages;
+    bool _traceEnabledProfiling = false;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Console);
 
@@ -286,6 +333,8 @@ private:
     int printSceneGraph(socket_native_type fd, Node* node, int level);
     void printSceneGraphBoot(socket_native_type fd);
     void printFileUtils(socket_native_type fd);
+    void updateFrameTimes();
+    void removeClientStreams(socket_native_type fd);
 
     /** send help message to console */
     static void sendHelp(socket_native_type fd, const hlookup::string_map<Command*>& commands, const char* msg);
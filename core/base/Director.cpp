@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include <string>
 
 #include "2d/SpriteFrameCache.h"
+#include "2d/DynamicAtlas.h"
 #include "platform/FileUtils.h"
 
 #include "2d/ActionManager.h"
@@ -46,6 +47,7 @@ THE SOFTWARE.
 #include "renderer/TextureCache.h"
 #include "renderer/Renderer.h"
 #include "renderer/RenderState.h"
+#include "renderer/Material.h"
 #include "2d/Camera.h"
 #include "base/UserDefault.h"
 #include "base/Utils.h"
@@ -56,7 +58,14 @@ THE SOFTWARE.
 #include "base/EventCustom.h"
 #include "base/Logging.h"
 #include "base/AutoreleasePool.h"
+#include "base/ObjectArena.h"
+#include "base/Allocator.h"
 #include "base/Configuration.h"
+#include "base/Profiling.h"
+#include "base/AssetPreloader.h"
+#include "base/PerformanceGovernor.h"
+#include "base/FrameRecorder.h"
+#include "base/RefPtr.h"
 #ifndef AX_CORE_PROFILE
 #    include "base/AsyncTaskPool.h"
 #endif
@@ -116,6 +125,8 @@ bool Director::init()
 
     _scenesStack.reserve(15);
 
+    Tracer::getInstance()->setThreadName("axmol");
+
     // FPS
     _lastUpdate = std::chrono::steady_clock::now();
 
@@ -132,24 +143,25 @@ bool Director::init()
     _scheduler->scheduleUpdate(_actionManager, Scheduler::PRIORITY_SYSTEM, false);
 
     _eventDispatcher = new EventDispatcher();
+    _frameRecorder   = new FrameRecorder();
 
-    _beforeSetNextScene = new EventCustom(EVENT_BEFORE_SET_NEXT_SCENE);
+    _beforeSetNextScene = new EventCustom(EventId::intern(EVENT_BEFORE_SET_NEXT_SCENE));
     _beforeSetNextScene->setUserData(this);
-    _afterSetNextScene = new EventCustom(EVENT_AFTER_SET_NEXT_SCENE);
+    _afterSetNextScene = new EventCustom(EventId::intern(EVENT_AFTER_SET_NEXT_SCENE));
     _afterSetNextScene->setUserData(this);
-    _eventAfterDraw = new EventCustom(EVENT_AFTER_DRAW);
+    _eventAfterDraw = new EventCustom(EventId::intern(EVENT_AFTER_DRAW));
     _eventAfterDraw->setUserData(this);
-    _eventBeforeDraw = new EventCustom(EVENT_BEFORE_DRAW);
+    _eventBeforeDraw = new EventCustom(EventId::intern(EVENT_BEFORE_DRAW));
     _eventBeforeDraw->setUserData(this);
-    _eventAfterVisit = new EventCustom(EVENT_AFTER_VISIT);
+    _eventAfterVisit = new EventCustom(EventId::intern(EVENT_AFTER_VISIT));
     _eventAfterVisit->setUserData(this);
-    _eventBeforeUpdate = new EventCustom(EVENT_BEFORE_UPDATE);
+    _eventBeforeUpdate = new EventCustom(EventId::intern(EVENT_BEFORE_UPDATE));
     _eventBeforeUpdate->setUserData(this);
-    _eventAfterUpdate = new EventCustom(EVENT_AFTER_UPDATE);
+    _eventAfterUpdate = new EventCustom(EventId::intern(EVENT_AFTER_UPDATE));
     _eventAfterUpdate->setUserData(this);
-    _eventProjectionChanged = new EventCustom(EVENT_PROJECTION_CHANGED);
+    _eventProjectionChanged = new EventCustom(EventId::intern(EVENT_PROJECTION_CHANGED));
     _eventProjectionChanged->setUserData(this);
-    _eventResetDirector = new EventCustom(EVENT_RESET);
+    _eventResetDirector = new EventCustom(EventId::intern(EVENT_RESET));
     // init TextureCache
     initTextureCache();
     initMatrixStack();
@@ -192,6 +204,7 @@ Director::~Director()
 #ifdef AX_ENABLE_CONSOLE
     delete _console;
 #endif
+    AX_SAFE_DELETE(_frameRecorder);
     AX_SAFE_RELEASE(_eventDispatcher);
 
     Configuration::destroyInstance();
@@ -204,6 +217,7 @@ Director::~Director()
 
     /** clean auto release pool. */
     PoolManager::destroyInstance();
+    ObjectArena::destroyInstance();
 
     AX_SAFE_DELETE(_jobSystem);
 
@@ -274,6 +288,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    AX_TRACE_SCOPE("Director::drawScene");
+
     _renderer->beginFrame();
 
     // calculate "global" dt
@@ -282,7 +298,9 @@ void Director::drawScene()
     if (_glView)
     {
         _glView->pollEvents();
+        _glView->dispatchCoalescedEvents();
     }
+    _frameRecorder->dispatchInput();
 
     // tick before glClear: issue #533
     if (!_paused)
@@ -292,6 +310,9 @@ void Director::drawScene()
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
     }
 
+    // the render thread submits the previous frame during the update, the visit updates the buffers it uses
+    _renderer->waitForRenderThread();
+
     _renderer->clear(ClearFlag::ALL, _clearColor, 1, 0, -10000.0);
 
     _eventDispatcher->dispatchEvent(_eventBeforeDraw);
@@ -353,6 +374,8 @@ void Director::drawScene()
 
     _renderer->endFrame();
 
+    _frameRecorder->endFrame();
+
     if (_statsDisplay)
     {
 #if !AX_STRIP_FPS
@@ -380,6 +403,9 @@ void Director::calculateDeltaTime()
             _lastUpdate = now;
         }
         _deltaTime = MAX(0, _deltaTime);
+
+        if (_deltaTimeSmoothing)
+            smoothDeltaTime();
     }
 
 #if _AX_DEBUG
@@ -389,6 +415,52 @@ void Director::calculateDeltaTime()
         _deltaTime = 1 / 60.0f;
     }
 #endif
+
+    // a recording advances by a fixed delta time, a replay by the recorded ones
+    _deltaTime = _frameRecorder->beginFrame(_deltaTime);
+}
+
+void Director::smoothDeltaTime()
+{
+    const float rawDeltaTime = _deltaTime;
+    if (_animationInterval <= 0 || rawDeltaTime > _animationInterval * 4)
+    {
+        _deltaTimeHistorySize = 0;
+        _deltaTimeDrift       = 0;
+        return;
+    }
+
+    _deltaTimeHistory[_deltaTimeHistoryNext] = rawDeltaTime;
+    _deltaTimeHistoryNext                    = (_deltaTimeHistoryNext + 1) % _deltaTimeHistory.size();
+    _deltaTimeHistorySize                    = (std::min)(_deltaTimeHistorySize + 1, _deltaTimeHistory.size());
+
+    float smoothed = 0;
+    for (size_t i = 0; i < _deltaTimeHistorySize; ++i)
+        smoothed += _deltaTimeHistory[i];
+    smoothed /= _deltaTimeHistorySize;
+
+    // the frames are presented on a vsync, so the delta should be a whole number of intervals
+    const float intervals = std::round(smoothed / _animationInterval);
+    if (intervals >= 1 && std::abs(smoothed - intervals * _animationInterval) < _animationInterval * 0.1f)
+        smoothed = intervals * _animationInterval;
+
+    // keep the game time with the real time, the drift is paid back by half intervals at most
+    _deltaTimeDrift += rawDeltaTime - smoothed;
+    if (std::abs(_deltaTimeDrift) > _animationInterval * 0.5f)
+    {
+        const float payback = std::clamp(_deltaTimeDrift, -_animationInterval * 0.5f, _animationInterval * 0.5f);
+        smoothed += payback;
+        _deltaTimeDrift -= payback;
+    }
+    _deltaTime = (std::max)(smoothed, 0.0f);
+}
+
+void Director::setDeltaTimeSmoothingEnabled(bool enabled)
+{
+    _deltaTimeSmoothing   = enabled;
+    _deltaTimeHistorySize = 0;
+    _deltaTimeHistoryNext = 0;
+    _deltaTimeDrift       = 0;
 }
 
 float Director::getDeltaTime() const
@@ -495,11 +567,22 @@ void Director::resetMatrixStack()
     initMatrixStack();
 }
 
+std::stack<Mat4>& Director::getModelViewMatrixStack() const
+{
+    // JobSystem workers visiting parallel visit roots use their own modelview stack, see Node::setParallelVisitRoot
+    if (std::this_thread::get_id() != _axmol_thread_id)
+    {
+        static thread_local std::stack<Mat4> workerStack{std::deque<Mat4>{Mat4::IDENTITY}};
+        return workerStack;
+    }
+    return const_cast<std::stack<Mat4>&>(_modelViewMatrixStack);
+}
+
 void Director::popMatrix(MATRIX_STACK_TYPE type)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.pop();
+        getModelViewMatrixStack().pop();
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -519,7 +602,7 @@ void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = Mat4::IDENTITY;
+        getModelViewMatrixStack().top() = Mat4::IDENTITY;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -539,7 +622,7 @@ void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = mat;
+        getModelViewMatrixStack().top() = mat;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -559,7 +642,7 @@ void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() *= mat;
+        getModelViewMatrixStack().top() *= mat;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -579,7 +662,8 @@ void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
     if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        _modelViewMatrixStack.push(_modelViewMatrixStack.top());
+        auto& modelViewStack = getModelViewMatrixStack();
+        modelViewStack.push(modelViewStack.top());
     }
     else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -599,7 +683,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
 {
     if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        return _modelViewMatrixStack.top();
+        return getModelViewMatrixStack().top();
     }
     else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -611,7 +695,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
     }
 
     AXASSERT(false, "unknown matrix stack type, will return modelview matrix instead");
-    return _modelViewMatrixStack.top();
+    return getModelViewMatrixStack().top();
 }
 
 void Director::setProjection(Projection projection)
@@ -675,6 +759,8 @@ void Director::purgeCachedData()
 {
     FontFNT::purgeCachedData();
     FontAtlasCache::purgeCachedData();
+    // the cached materials hold their textures
+    Material::purgeCachedData();
 
     if (s_SharedDirector->getGLView())
     {
@@ -860,6 +946,20 @@ void Director::replaceScene(Scene* scene)
     _nextScene = scene;
 }
 
+Task<void> Director::replaceSceneAsync(Scene* scene, Scene::BuildFunc build, float frameBudget)
+{
+    RefPtr<Scene> keep(scene);
+    co_await scene->prepareAsync(std::move(build), frameBudget);
+    replaceScene(scene);
+}
+
+Task<void> Director::pushSceneAsync(Scene* scene, Scene::BuildFunc build, float frameBudget)
+{
+    RefPtr<Scene> keep(scene);
+    co_await scene->prepareAsync(std::move(build), frameBudget);
+    pushScene(scene);
+}
+
 void Director::pushScene(Scene* scene)
 {
     AXASSERT(scene, "the scene should not null");
@@ -981,6 +1081,9 @@ void Director::reset()
     auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
 
+    // writes the recording or the report
+    _frameRecorder->stop();
+
     if (_runningScene)
     {
 #if AX_ENABLE_GC_FOR_NATIVE_OBJECTS
@@ -1048,15 +1151,22 @@ void Director::reset()
     AX_SAFE_RELEASE_NULL(_FPSLabel);
     AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
     AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+    AX_SAFE_RELEASE_NULL(_frameAllocsLabel);
+
+    // the preloaded textures and font atlases are released before their caches are purged
+    AssetPreloader::destroyInstance();
+    PerformanceGovernor::destroyInstance();
 
     // purge bitmap cache
     FontFNT::purgeCachedData();
     FontAtlasCache::purgeCachedData();
+    Material::purgeCachedData();
 
     FontFreeType::shutdownFreeType();
 
     // purge all managed caches
     AnimationCache::destroyInstance();
+    DynamicAtlas::destroyInstance();
     SpriteFrameCache::destroyInstance();
     FileUtils::destroyInstance();
 #ifndef AX_CORE_PROFILE
@@ -1080,6 +1190,7 @@ void Director::cleanupDirector()
     AX_SAFE_RELEASE(_FPSLabel);
     AX_SAFE_RELEASE(_drawnVerticesLabel);
     AX_SAFE_RELEASE(_drawnBatchesLabel);
+    AX_SAFE_RELEASE(_frameAllocsLabel);
 
     AX_SAFE_RELEASE(_runningScene);
     AX_SAFE_RELEASE(_notificationNode);
@@ -1111,6 +1222,8 @@ void Director::restartDirector()
 
     // release the objects
     PoolManager::getInstance()->getCurrentPool()->clear();
+    PoolManager::getInstance()->releaseDeferredObjects();
+    ObjectArena::getInstance()->drain();
 
     // Restart animation
     startAnimation();
@@ -1236,12 +1349,13 @@ void Director::showStats()
     }
 
     static uint32_t prevCalls = 0;
-    static uint32_t prevVerts = 0;
+    static uint32_t prevVerts  = 0;
+    static uint32_t prevAllocs = UINT32_MAX;
 
     ++_frames;
     _accumDt += _deltaTime;
 
-    if (_statsDisplay && _FPSLabel && _drawnBatchesLabel && _drawnVerticesLabel)
+    if (_statsDisplay && _FPSLabel && _drawnBatchesLabel && _drawnVerticesLabel && _frameAllocsLabel)
     {
         char buffer[30] = {0};
 
@@ -1272,7 +1386,17 @@ void Director::showStats()
             prevVerts = currentVerts;
         }
 
+        // heap allocations for transient render commands, should stay at 0 in steady state
+        auto currentAllocs = (uint32_t)_renderer->getFrameHeapAllocations();
+        if (currentAllocs != prevAllocs)
+        {
+            snprintf(buffer, sizeof(buffer), "Allocs:%6u", currentAllocs);
+            _frameAllocsLabel->setString(buffer);
+            prevAllocs = currentAllocs;
+        }
+
         const Mat4& identity = Mat4::IDENTITY;
+        _frameAllocsLabel->visit(_renderer, identity, 0);
         _drawnVerticesLabel->visit(_renderer, identity, 0);
         _drawnBatchesLabel->visit(_renderer, identity, 0);
         _FPSLabel->visit(_renderer, identity, 0);
@@ -1302,15 +1426,18 @@ void Director::createStatsLabel()
     std::string fpsString          = "00.0";
     std::string drawBatchString    = "000";
     std::string drawVerticesString = "00000";
+    std::string frameAllocsString  = "0";
     if (_FPSLabel)
     {
         fpsString          = _FPSLabel->getString();
         drawBatchString    = _drawnBatchesLabel->getString();
         drawVerticesString = _drawnVerticesLabel->getString();
+        frameAllocsString  = _frameAllocsLabel->getString();
 
         AX_SAFE_RELEASE_NULL(_FPSLabel);
         AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
         AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+        AX_SAFE_RELEASE_NULL(_frameAllocsLabel);
         _textureCache->removeTextureForKey("/ax_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -1357,6 +1484,11 @@ void Director::createStatsLabel()
     _drawnVerticesLabel->setIgnoreContentScaleFactor(true);
     _drawnVerticesLabel->setScale(scaleFactor);
 
+    _frameAllocsLabel = LabelAtlas::create(frameAllocsString, texture, 12, 32, '.');
+    _frameAllocsLabel->retain();
+    _frameAllocsLabel->setIgnoreContentScaleFactor(true);
+    _frameAllocsLabel->setScale(scaleFactor);
+
     setStatsAnchor();
 }
 
@@ -1379,66 +1511,77 @@ void Director::setStatsAnchor(AnchorPreset anchor)
         {
         case AnchorPreset::BOTTOM_LEFT:
             _fpsPosition = Vec2(0, 0);
+            _frameAllocsLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::CENTER_LEFT:
-            _fpsPosition = Vec2(0, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(0, safeSize.height / 2 - height_spacing * 2);
+            _frameAllocsLabel->setAnchorPoint({0, 0.0});
             _drawnVerticesLabel->setAnchorPoint({0, 0.0});
             _drawnBatchesLabel->setAnchorPoint({0, 0.0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::TOP_LEFT:
-            _fpsPosition = Vec2(0, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(0, safeSize.height - height_spacing * 4);
+            _frameAllocsLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::BOTTOM_RIGHT:
             _fpsPosition = Vec2(safeSize.width, 0);
+            _frameAllocsLabel->setAnchorPoint({1, 0});
             _drawnVerticesLabel->setAnchorPoint({1, 0});
             _drawnBatchesLabel->setAnchorPoint({1, 0});
             _FPSLabel->setAnchorPoint({1, 0});
             break;
         case AnchorPreset::CENTER_RIGHT:
-            _fpsPosition = Vec2(safeSize.width, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(safeSize.width, safeSize.height / 2 - height_spacing * 2);
+            _frameAllocsLabel->setAnchorPoint({1, 0.0});
             _drawnVerticesLabel->setAnchorPoint({1, 0.0});
             _drawnBatchesLabel->setAnchorPoint({1, 0.0});
             _FPSLabel->setAnchorPoint({1, 0.0});
             break;
         case AnchorPreset::TOP_RIGHT:
-            _fpsPosition = Vec2(safeSize.width, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(safeSize.width, safeSize.height - height_spacing * 4);
+            _frameAllocsLabel->setAnchorPoint({1, 0});
             _drawnVerticesLabel->setAnchorPoint({1, 0});
             _drawnBatchesLabel->setAnchorPoint({1, 0});
             _FPSLabel->setAnchorPoint({1, 0});
             break;
         case AnchorPreset::BOTTOM_CENTER:
             _fpsPosition = Vec2(safeSize.width / 2, 0);
+            _frameAllocsLabel->setAnchorPoint({0.5, 0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0});
             _FPSLabel->setAnchorPoint({0.5, 0});
             break;
         case AnchorPreset::CENTER:
-            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height / 2 - height_spacing * 2);
+            _frameAllocsLabel->setAnchorPoint({0.5, 0.0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0.0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0.0});
             _FPSLabel->setAnchorPoint({0.5, 0.0});
             break;
         case AnchorPreset::TOP_CENTER:
-            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height - height_spacing * 4);
+            _frameAllocsLabel->setAnchorPoint({0.5, 0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0});
             _FPSLabel->setAnchorPoint({0.5, 0});
             break;
         default:  // FPSPosition::BOTTOM_LEFT
             _fpsPosition = Vec2(0, 0);
+            _frameAllocsLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         }
 
+        _frameAllocsLabel->setPosition(Vec2(0, height_spacing * 3.0f) + _fpsPosition + safeOrigin);
         _drawnVerticesLabel->setPosition(Vec2(0, height_spacing * 2.0f) + _fpsPosition + safeOrigin);
         _drawnBatchesLabel->setPosition(Vec2(0, height_spacing * 1.0f) + _fpsPosition + safeOrigin);
         _FPSLabel->setPosition(Vec2(0, height_spacing * 0.0f) + _fpsPosition + safeOrigin);
@@ -1563,6 +1706,10 @@ void Director::mainLoop()
 
         // release the objects
         PoolManager::getInstance()->getCurrentPool()->clear();
+        PoolManager::getInstance()->releaseDeferredObjects();
+        ObjectArena::getInstance()->drain();
+
+        Memory::endFrame();
     }
 }
 
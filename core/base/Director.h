@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include <stack>
 #include <thread>
 #include <chrono>
+#include <array>
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
@@ -68,6 +69,7 @@ class EventListenerCustom;
 class TextureCache;
 class Renderer;
 class Camera;
+class FrameRecorder;
 
 /**
  @brief Class that creates and handles the main Window and manages how
@@ -154,6 +156,15 @@ public:
     /** Sets the FPS value. FPS = 1/interval. */
     void setAnimationInterval(float interval);
 
+    /**
+     * Smooth the delta time: it's averaged over the last frames and snapped to a whole number of animation
+     * intervals when it's close to one, so the motion doesn't follow the timer and vsync jitter. The drift from the
+     * real time is paid back over the next frames, a hitch of more than 4 intervals isn't smoothed. Disabled by
+     * default.
+     */
+    void setDeltaTimeSmoothingEnabled(bool enabled);
+    bool isDeltaTimeSmoothingEnabled() const { return _deltaTimeSmoothing; }
+
     /** Whether the FPS on the bottom-left corner of the screen is displayed or not. */
     bool isStatsDisplay() { return _statsDisplay; }
     /** Display the FPS on the bottom-left corner of the screen. */
@@ -317,6 +328,21 @@ public:
      */
     void replaceScene(Scene* scene);
 
+    /** Builds a scene over several frames with Scene::prepareAsync, then replaces the running scene with it.
+     * The running scene goes on while the new one is built.
+     * @js NA
+     * @lua NA
+     */
+    Task<void> replaceSceneAsync(Scene* scene,
+                                 Scene::BuildFunc build,
+                                 float frameBudget = Scene::DEFAULT_PREPARE_BUDGET);
+
+    /** Builds a scene over several frames with Scene::prepareAsync, then pushes it like pushScene.
+     * @js NA
+     * @lua NA
+     */
+    Task<void> pushSceneAsync(Scene* scene, Scene::BuildFunc build, float frameBudget = Scene::DEFAULT_PREPARE_BUDGET);
+
     /** Ends the execution, releases the running scene.
      * @lua endToLua
      */
@@ -443,6 +469,10 @@ public:
      */
     Renderer* getRenderer() const { return _renderer; }
 
+    /** Returns the FrameRecorder, which records the input and the delta times of the frames to replay them.
+     */
+    FrameRecorder* getFrameRecorder() const { return _frameRecorder; }
+
 #ifdef AX_ENABLE_CONSOLE
     /** Returns the Console associated with this director.
      * @since v3.0
@@ -561,12 +591,15 @@ protected:
 
     /** calculates delta time since last time it was called */
     void calculateDeltaTime();
+    /** see setDeltaTimeSmoothingEnabled */
+    void smoothDeltaTime();
 
     // textureCache creation or release
     void initTextureCache();
     void destroyTextureCache();
 
     void initMatrixStack();
+    std::stack<Mat4>& getModelViewMatrixStack() const;
 
     std::stack<Mat4> _modelViewMatrixStack;
     std::stack<Mat4> _textureMatrixStack;
@@ -600,6 +633,13 @@ protected:
     float _deltaTime              = 0.0f;
     bool _deltaTimePassedByCaller = false;
 
+    /* the raw delta times of the last frames and the drift of the smoothed ones, see setDeltaTimeSmoothingEnabled */
+    bool _deltaTimeSmoothing = false;
+    std::array<float, 4> _deltaTimeHistory{};
+    size_t _deltaTimeHistorySize = 0;
+    size_t _deltaTimeHistoryNext = 0;
+    float _deltaTimeDrift        = 0.0f;
+
     /* The _glView, where everything is rendered, GLView is a abstract class,cocos2d-x provide GLViewImpl
      which inherit from it as default renderer context,you can have your own by inherit from it*/
     GLView* _glView = nullptr;
@@ -619,6 +659,7 @@ protected:
     LabelAtlas* _FPSLabel           = nullptr;
     LabelAtlas* _drawnBatchesLabel  = nullptr;
     LabelAtlas* _drawnVerticesLabel = nullptr;
+    LabelAtlas* _frameAllocsLabel   = nullptr;
 
     /** Whether or not the Director is paused */
     bool _paused = false;
@@ -667,6 +708,7 @@ protected:
     /* Console for the director */
     Console* _console = nullptr;
 #endif
+    FrameRecorder* _frameRecorder = nullptr;
     bool _isStatusLabelUpdated = true;
 
     /* whether or not the director is in a valid state */
@@ -25,10 +25,87 @@
 
 #include "base/EventCustom.h"
 #include "base/Event.h"
+#include "base/Macros.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 namespace ax
 {
 
+namespace
+{
+struct EventIdRegistry
+{
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, uint32_t> indices;  // by hash, the names are compared on a collision
+    std::deque<std::string> names;                        // by index, never moved
+};
+
+EventIdRegistry& getEventIdRegistry()
+{
+    static EventIdRegistry registry;
+    return registry;
+}
+}  // namespace
+
+EventId EventId::intern(std::string_view name, uint64_t hash)
+{
+    AXASSERT(hash == hashEventName(name), "The hash isn't the one of the name");
+
+    auto& registry = getEventIdRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto range = registry.indices.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const auto& interned = registry.names[it->second];
+        if (interned == name)
+            return EventId(it->second, interned);
+    }
+
+    auto index = static_cast<uint32_t>(registry.names.size());
+    registry.names.emplace_back(name);
+    registry.indices.emplace(hash, index);
+    return EventId(index, registry.names.back());
+}
+
+EventId EventId::find(std::string_view name)
+{
+    auto& registry = getEventIdRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto range = registry.indices.equal_range(hashEventName(name));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const auto& interned = registry.names[it->second];
+        if (interned == name)
+            return EventId(it->second, interned);
+    }
+    return EventId();
+}
+
+EventId EventId::fromIndex(uint32_t index)
+{
+    auto& registry = getEventIdRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    AXASSERT(index < registry.names.size(), "Invalid event id index");
+    return EventId(index, registry.names[index]);
+}
+
+uint32_t EventId::getInternedCount()
+{
+    auto& registry = getEventIdRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return static_cast<uint32_t>(registry.names.size());
+}
+
 EventCustom::EventCustom(std::string_view eventName) : Event(Type::CUSTOM), _userData(nullptr), _eventName(eventName) {}
 
+EventCustom::EventCustom(EventId eventId)
+    : Event(Type::CUSTOM), _userData(nullptr), _eventName(eventId.getName()), _eventId(eventId)
+{}
+
 }
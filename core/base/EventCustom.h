@@ -27,6 +27,7 @@
 #define _AX_CUSTOMEVENT_H_
 
 #include <string>
+#include <string_view>
 #include "base/Event.h"
 
 /**
@@ -37,6 +38,66 @@
 namespace ax
 {
 
+/** The FNV-1a hash of a custom event name, it can be computed at compile time. */
+constexpr uint64_t hashEventName(std::string_view name)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/** @class EventId
+ * @brief An interned custom event name.
+ *
+ * The ids are small indices shared by all the EventDispatchers, which find the listeners of an id in a flat array
+ * instead of hashing the name for every dispatch. The listeners are still added by name, an id and its name reach
+ * the same listeners. Intern the names of the events dispatched often once, and keep the ids.
+ @code
+ // the hash of the name is computed at compile time
+ static constexpr auto ENEMY_SPAWNED_HASH = hashEventName("enemy_spawned");
+ static const EventId ENEMY_SPAWNED       = EventId::intern("enemy_spawned", ENEMY_SPAWNED_HASH);
+
+ eventDispatcher->dispatchCustomEvent(ENEMY_SPAWNED, enemy);
+ @endcode
+ */
+class AX_DLL EventId
+{
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /** Interns a name, the same name always gives the same id. Thread safe. */
+    static EventId intern(std::string_view name) { return intern(name, hashEventName(name)); }
+    /** Interns a name with its hash computed by hashEventName. */
+    static EventId intern(std::string_view name, uint64_t hash);
+
+    /** The id of a name if it was interned, an invalid id otherwise. */
+    static EventId find(std::string_view name);
+
+    /** The id of an index lower than getInternedCount. */
+    static EventId fromIndex(uint32_t index);
+
+    static uint32_t getInternedCount();
+
+    EventId() = default;
+
+    bool isValid() const { return _index != INVALID_INDEX; }
+    uint32_t getIndex() const { return _index; }
+    std::string_view getName() const { return _name; }
+
+    bool operator==(const EventId& other) const { return _index == other._index; }
+    bool operator!=(const EventId& other) const { return _index != other._index; }
+
+private:
+    EventId(uint32_t index, std::string_view name) : _index(index), _name(name) {}
+
+    uint32_t _index = INVALID_INDEX;
+    std::string_view _name;  // owned by the registry
+};
+
 /** @class EventCustom
  * @brief Custom event.
  */
@@ -50,6 +111,12 @@ public:
      */
     EventCustom(std::string_view eventName);
 
+    /** Constructor of an event dispatched by its interned id.
+     *
+     * @param eventId An interned name of the custom event.
+     */
+    EventCustom(EventId eventId);
+
     /** Sets user data.
      *
      * @param data The user data pointer, it's a void*.
@@ -68,9 +135,13 @@ public:
      */
     std::string_view getEventName() const { return _eventName; }
 
+    /** Gets the interned id of the event, invalid when it was created by name. */
+    EventId getEventId() const { return _eventId; }
+
 protected:
     void* _userData;  ///< User data
     std::string _eventName;
+    EventId _eventId;
 };
 
 }
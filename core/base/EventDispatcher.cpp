@@ -41,6 +41,7 @@
 #include "2d/Scene.h"
 #include "base/Director.h"
 #include "base/EventType.h"
+#include "base/Profiling.h"
 #include "2d/Camera.h"
 #include "2d/ProtectedNode.h"
 
@@ -214,7 +215,7 @@ EventDispatcher::~EventDispatcher()
     removeAllEventListeners();
 }
 
-void EventDispatcher::visitTarget(Node* node, bool isRootNode)
+void EventDispatcher::visitTarget(Node* node, std::vector<Node*>& nodes)
 {
     auto* protectedNode = dynamic_cast<ProtectedNode*>(node);
     if (protectedNode)
@@ -239,7 +240,7 @@ void EventDispatcher::visitTarget(Node* node, bool isRootNode)
                 child = children.at(childIndex);
 
                 if (child && child->getLocalZOrder() < 0)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
                 else
                     break;
             }
@@ -249,35 +250,35 @@ void EventDispatcher::visitTarget(Node* node, bool isRootNode)
                 child = protectedChildren.at(protectedChildIndex);
 
                 if (child && child->getLocalZOrder() < 0)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
                 else
                     break;
             }
 
             if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
             {
-                _globalZOrderNodeMap[node->getGlobalZOrder()].emplace_back(node);
+                nodes.emplace_back(node);
             }
 
             for (; childIndex < childrenCount; childIndex++)
             {
                 child = children.at(childIndex);
                 if (child)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
             }
 
             for (; protectedChildIndex < protectedChildrenCount; protectedChildIndex++)
             {
                 child = protectedChildren.at(protectedChildIndex);
                 if (child)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
             }
         }
         else
         {
             if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
             {
-                _globalZOrderNodeMap[node->getGlobalZOrder()].emplace_back(node);
+                nodes.emplace_back(node);
             }
         }
     }
@@ -299,55 +300,31 @@ void EventDispatcher::visitTarget(Node* node, bool isRootNode)
                 child = children.at(i);
 
                 if (child && child->getLocalZOrder() < 0)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
                 else
                     break;
             }
 
             if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
             {
-                _globalZOrderNodeMap[node->getGlobalZOrder()].emplace_back(node);
+                nodes.emplace_back(node);
             }
 
             for (; i < childrenCount; i++)
             {
                 child = children.at(i);
                 if (child)
-                    visitTarget(child, false);
+                    visitTarget(child, nodes);
             }
         }
         else
         {
             if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
             {
-                _globalZOrderNodeMap[node->getGlobalZOrder()].emplace_back(node);
+                nodes.emplace_back(node);
             }
         }
     }
-
-    if (isRootNode)
-    {
-        std::vector<float> globalZOrders;
-        globalZOrders.reserve(_globalZOrderNodeMap.size());
-
-        for (const auto& e : _globalZOrderNodeMap)
-        {
-            globalZOrders.emplace_back(e.first);
-        }
-
-        std::stable_sort(globalZOrders.begin(), globalZOrders.end(),
-                         [](const float a, const float b) { return a < b; });
-
-        for (const auto& globalZ : globalZOrders)
-        {
-            for (const auto& n : _globalZOrderNodeMap[globalZ])
-            {
-                _nodePriorityMap[n] = ++_nodePriorityIndex;
-            }
-        }
-
-        _globalZOrderNodeMap.clear();
-    }
 }
 
 void EventDispatcher::pauseEventListenersForTarget(Node* target, bool recursive /* = false */)
@@ -418,6 +395,7 @@ void EventDispatcher::removeEventListenersForTarget(Node* target, bool recursive
     // Don't want any dangling pointers or the possibility of dealing with deleted objects..
     _nodePriorityMap.erase(target);
     _dirtyNodes.erase(target);
+    _reorderedNodes.erase(target);
 
     auto listenerIter = _nodeListenersMap.find(target);
     if (listenerIter != _nodeListenersMap.end())
@@ -530,6 +508,7 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
 
         listeners = new EventListenerVector();
         _listenerMap.emplace(listenerID, listeners);
+        setListenersForId(listenerID, listeners);
     }
     else
     {
@@ -547,6 +526,10 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
 
         associateNodeAndEventListener(node, listener);
 
+        // a node without rank is placed by a walk of the whole scene graph
+        if (_nodePriorityMap.find(node) == _nodePriorityMap.end())
+            _nodePrioritiesDirty = true;
+
         if (!node->isRunning())
         {
             listener->setPaused(true);
@@ -738,6 +721,7 @@ void EventDispatcher::removeEventListener(EventListener* listener)
         if (iter->second->empty())
         {
             _priorityDirtyFlagMap.erase(listener->getListenerID());
+            setListenersForId(iter->first, nullptr);
             auto list = iter->second;
             iter      = _listenerMap.erase(iter);
             AX_SAFE_DELETE(list);
@@ -966,6 +950,27 @@ void EventDispatcher::dispatchEvent(Event* event, bool forced)
     if (!_isEnabled && !forced)
         return;
 
+    if (_inputFilter)
+    {
+        const auto type = event->getType();
+        if ((type == Event::Type::TOUCH || type == Event::Type::KEYBOARD || type == Event::Type::MOUSE) &&
+            !_inputFilter(event))
+            return;
+    }
+
+    // an interned custom event finds its listeners in the flat array, there is nothing to do without one, like for
+    // most of the events of the Director
+    EventListenerVector* listeners = nullptr;
+    EventId eventId;
+    if (event->getType() == Event::Type::CUSTOM)
+    {
+        eventId = static_cast<EventCustom*>(event)->getEventId();
+        if (eventId.isValid() && (listeners = getListeners(eventId)) == nullptr)
+            return;
+    }
+
+    AX_TRACE_SCOPE("EventDispatcher::dispatchEvent");
+
     updateDirtyFlagForSceneGraph();
 
     DispatchGuard guard(_inDispatch);
@@ -976,20 +981,24 @@ void EventDispatcher::dispatchEvent(Event* event, bool forced)
         return;
     }
 
-    auto listenerID = __getListenerID(event);
-
-    sortEventListeners(listenerID);
+    if (eventId.isValid())
+    {
+        sortEventListeners(eventId.getName());
+    }
+    else
+    {
+        auto listenerID = __getListenerID(event);
+        sortEventListeners(listenerID);
+        listeners = getListeners(listenerID);
+    }
 
     auto pfnDispatchEventToListeners = &EventDispatcher::dispatchEventToListeners;
     if (event->getType() == Event::Type::MOUSE)
     {
         pfnDispatchEventToListeners = &EventDispatcher::dispatchTouchEventToListeners;
     }
-    auto iter = _listenerMap.find(listenerID);
-    if (iter != _listenerMap.end())
+    if (listeners)
     {
-        auto listeners = iter->second;
-
         auto onEvent = [&event](EventListener* listener) -> bool {
             event->setCurrentTarget(listener->getAssociatedNode());
             listener->_onEvent(event);
@@ -1009,6 +1018,16 @@ void EventDispatcher::dispatchCustomEvent(std::string_view eventName, void* opti
     dispatchEvent(&ev, forced);
 }
 
+void EventDispatcher::dispatchCustomEvent(EventId eventId, void* optionalUserData, bool forced)
+{
+    if ((!_isEnabled && !forced) || !getListeners(eventId))
+        return;
+
+    EventCustom ev(eventId);
+    ev.setUserData(optionalUserData);
+    dispatchEvent(&ev, forced);
+}
+
 bool EventDispatcher::hasEventListener(std::string_view listenerID) const
 {
     return getListeners(listenerID) != nullptr;
@@ -1016,6 +1035,10 @@ bool EventDispatcher::hasEventListener(std::string_view listenerID) const
 
 void EventDispatcher::dispatchTouchEvent(EventTouch* event)
 {
+    // the culling bounds and point are computed again for each touch event
+    ++_touchEventStamp;
+    _cullingTouch = nullptr;
+
     sortEventListeners(EventListenerTouchOneByOne::LISTENER_ID);
     sortEventListeners(EventListenerTouchAllAtOnce::LISTENER_ID);
 
@@ -1058,7 +1081,7 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
 
                 if (eventCode == EventTouch::EventCode::BEGAN)
                 {
-                    if (listener->onTouchBegan)
+                    if (listener->onTouchBegan && !isTouchOutsideListenerBounds(listener, touches))
                     {
                         isClaimed = listener->onTouchBegan(touches, event);
                         if (isClaimed && listener->_isRegistered)
@@ -1214,7 +1237,7 @@ void EventDispatcher::updateListeners(Event* event)
     if (_inDispatch > 1)
         return;
 
-    auto onUpdateListeners = [this](const EventListener::ListenerID& listenerID) {
+    auto onUpdateListeners = [this](std::string_view listenerID) {
         auto listenersIter = _listenerMap.find(listenerID);
         if (listenersIter == _listenerMap.end())
             return;
@@ -1282,6 +1305,10 @@ void EventDispatcher::updateListeners(Event* event)
         onUpdateListeners(EventListenerTouchOneByOne::LISTENER_ID);
         onUpdateListeners(EventListenerTouchAllAtOnce::LISTENER_ID);
     }
+    else if (event->getType() == Event::Type::CUSTOM && static_cast<EventCustom*>(event)->getEventId().isValid())
+    {
+        onUpdateListeners(static_cast<EventCustom*>(event)->getEventId().getName());
+    }
     else
     {
         onUpdateListeners(__getListenerID(event));
@@ -1294,6 +1321,7 @@ void EventDispatcher::updateListeners(Event* event)
         if (iter->second->empty())
         {
             _priorityDirtyFlagMap.erase(iter->first);
+            setListenersForId(iter->first, nullptr);
             delete iter->second;
             iter = _listenerMap.erase(iter);
         }
@@ -1384,28 +1412,159 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(std::string_view li
     if (sceneGraphListeners == nullptr)
         return;
 
-    // Reset priority index
-    _nodePriorityIndex = 0;
-    _nodePriorityMap.clear();
+    updateNodePriorities(rootNode);
+    ++_sortStats.sorts;
 
-    visitTarget(rootNode, true);
+    struct SortKey
+    {
+        float globalZOrder;
+        int priority;
+        EventListener* listener;
+    };
 
-    // After sort: priority < 0, > 0
-    std::stable_sort(sceneGraphListeners->begin(), sceneGraphListeners->end(),
-                     [this](const EventListener* l1, const EventListener* l2) {
-                         return _nodePriorityMap[l1->getAssociatedNode()] > _nodePriorityMap[l2->getAssociatedNode()];
-                     });
+    std::vector<SortKey> keys;
+    keys.reserve(sceneGraphListeners->size());
+    for (auto&& l : *sceneGraphListeners)
+    {
+        auto node = l->getAssociatedNode();
+        auto iter = _nodePriorityMap.find(node);
+        keys.emplace_back(SortKey{node->getGlobalZOrder(), iter != _nodePriorityMap.end() ? iter->second : 0, l});
+    }
+
+    // After sort: the node drawn last first, by global Z order then by draw order
+    std::stable_sort(keys.begin(), keys.end(), [](const SortKey& k1, const SortKey& k2) {
+        if (k1.globalZOrder != k2.globalZOrder)
+            return k1.globalZOrder > k2.globalZOrder;
+        return k1.priority > k2.priority;
+    });
+
+    for (size_t i = 0, count = keys.size(); i < count; ++i)
+        (*sceneGraphListeners)[i] = keys[i].listener;
 
 #if DUMP_LISTENER_ITEM_PRIORITY_INFO
     AXLOGI("-----------------------------------");
-    for (auto&& l : *sceneGraphListeners)
+    for (auto&& key : keys)
     {
-        AXLOGI("listener priority: node ([{}]{}), priority ({})", typeid(*l->_node).name(), l->_node,
-            _nodePriorityMap[l->_node]);
+        AXLOGI("listener priority: node ([{}]{}), global z ({}), priority ({})", typeid(*key.listener->_node).name(),
+               fmt::ptr(key.listener->_node), key.globalZOrder, key.priority);
     }
 #endif
 }
 
+void EventDispatcher::updateNodePriorities(Node* rootNode)
+{
+    if (!_nodePrioritiesDirty && rootNode == _nodePriorityRoot)
+    {
+        bool ranked = true;
+        for (auto node : _reorderedNodes)
+        {
+            // skip the nodes out of the scene, they are placed by a full walk when they enter it
+            auto parent = node;
+            while (parent && parent != rootNode)
+                parent = parent->getParent();
+
+            if (parent && !rankReorderedNodes(node))
+            {
+                ranked = false;
+                break;
+            }
+        }
+        _reorderedNodes.clear();
+
+        if (ranked)
+            return;
+    }
+
+    _visitedNodes.clear();
+    _visitingTargets = true;
+    visitTarget(rootNode, _visitedNodes);
+    _visitingTargets = false;
+
+    _nodePriorityIndex = 0;
+    _nodePriorityMap.clear();
+    for (auto node : _visitedNodes)
+        _nodePriorityMap[node] = ++_nodePriorityIndex;
+
+    _nodePriorityRoot    = rootNode;
+    _nodePrioritiesDirty = false;
+    _reorderedNodes.clear();
+    ++_sortStats.fullWalks;
+}
+
+bool EventDispatcher::rankReorderedNodes(Node* node)
+{
+    _visitedNodes.clear();
+    _visitingTargets = true;
+    visitTarget(node, _visitedNodes);
+    _visitingTargets = false;
+
+    // the nodes under a node are ranked after each other, reordering them only swaps their ranks
+    std::vector<int> ranks;
+    ranks.reserve(_visitedNodes.size());
+    for (auto visited : _visitedNodes)
+    {
+        auto iter = _nodePriorityMap.find(visited);
+        if (iter == _nodePriorityMap.end())
+            return false;
+        ranks.emplace_back(iter->second);
+    }
+
+    std::sort(ranks.begin(), ranks.end());
+    for (size_t i = 0, count = ranks.size(); i < count; ++i)
+        _nodePriorityMap[_visitedNodes[i]] = ranks[i];
+
+    ++_sortStats.partialWalks;
+    return true;
+}
+
+bool EventDispatcher::isTouchOutsideListenerBounds(EventListenerTouchOneByOne* listener, Touch* touch)
+{
+    auto node   = listener->_node;
+    auto camera = Camera::getVisitingCamera();
+    if (!listener->_boundsCulling || !node || !camera)
+        return false;
+
+    if (touch != _cullingTouch || camera != _cullingCamera)
+    {
+        _cullingTouch  = touch;
+        _cullingCamera = camera;
+
+        // where the ray of the touch crosses the z = 0 plane of the world
+        auto location = touch->getLocation();
+        auto nearP    = camera->unprojectGL(Vec3(location.x, location.y, -1.0f));
+        auto farP     = camera->unprojectGL(Vec3(location.x, location.y, 1.0f));
+        auto dz       = farP.z - nearP.z;
+
+        _cullingPointValid = std::abs(dz) > FLT_EPSILON;
+        if (_cullingPointValid)
+        {
+            float t       = -nearP.z / dz;
+            _cullingPoint = Vec2(nearP.x + t * (farP.x - nearP.x), nearP.y + t * (farP.y - nearP.y));
+        }
+    }
+
+    if (!_cullingPointValid)
+        return false;
+
+    if (listener->_cullingStamp != _touchEventStamp)
+    {
+        listener->_cullingStamp = _touchEventStamp;
+
+        // only a node in the z = 0 plane has its content rect under the culling point
+        const auto& transform     = node->getNodeToWorldTransform();
+        listener->_cullingInPlane = transform.m[2] == 0 && transform.m[6] == 0 && transform.m[14] == 0;
+        if (listener->_cullingInPlane)
+        {
+            auto bounds = RectApplyTransform(Rect(Vec2::ZERO, node->getContentSize()), transform);
+            // a margin for the rounding of the hit test in the node space
+            listener->_cullingBounds.setRect(bounds.origin.x - 1.0f, bounds.origin.y - 1.0f, bounds.size.width + 2.0f,
+                                             bounds.size.height + 2.0f);
+        }
+    }
+
+    return listener->_cullingInPlane && !listener->_cullingBounds.containsPoint(_cullingPoint);
+}
+
 void EventDispatcher::sortEventListenersOfFixedPriority(std::string_view listenerID)
 {
     auto listeners = getListeners(listenerID);
@@ -1454,6 +1613,31 @@ EventDispatcher::EventListenerVector* EventDispatcher::getListeners(std::string_
     return nullptr;
 }
 
+EventDispatcher::EventListenerVector* EventDispatcher::getListeners(EventId eventId)
+{
+    AXASSERT(eventId.isValid(), "Invalid event id");
+
+    auto index = eventId.getIndex();
+    if (index >= _listenersById.size())
+    {
+        // the ids interned since the last lookup are resolved by name once
+        auto first = static_cast<uint32_t>(_listenersById.size());
+        _listenersById.resize(index + 1);
+        for (auto i = first; i < index; ++i)
+            _listenersById[i] = getListeners(EventId::fromIndex(i).getName());
+        _listenersById[index] = getListeners(eventId.getName());
+    }
+    return _listenersById[index];
+}
+
+void EventDispatcher::setListenersForId(std::string_view listenerID, EventListenerVector* listeners)
+{
+    // the ids out of the flat array are resolved when they are looked up
+    auto eventId = EventId::find(listenerID);
+    if (eventId.isValid() && eventId.getIndex() < _listenersById.size())
+        _listenersById[eventId.getIndex()] = listeners;
+}
+
 void EventDispatcher::removeEventListenersForListenerID(std::string_view listenerID)
 {
     auto listenerItemIter = _listenerMap.find(listenerID);
@@ -1501,6 +1685,7 @@ void EventDispatcher::removeEventListenersForListenerID(std::string_view listene
         {
             listeners->clear();
             delete listeners;
+            setListenersForId(listenerID, nullptr);
             _listenerMap.erase(listenerItemIter);
         }
     }
@@ -1579,6 +1764,7 @@ void EventDispatcher::removeAllEventListeners()
     if (!_inDispatch && cleanMap)
     {
         _listenerMap.clear();
+        _listenersById.clear();
     }
 }
 
@@ -1594,18 +1780,37 @@ bool EventDispatcher::isEnabled() const
 
 void EventDispatcher::setDirtyForNode(Node* node)
 {
+    // the node may have moved in the scene graph, it is ranked by a walk from the root
+    if (setDirtyForListenerNodes(node))
+        _nodePrioritiesDirty = true;
+}
+
+void EventDispatcher::setDirtyForReorder(Node* node)
+{
+    // the walk of the scene graph sorts the children it visits
+    if (!_visitingTargets && setDirtyForListenerNodes(node) && !_nodePrioritiesDirty)
+        _reorderedNodes.insert(node);
+}
+
+bool EventDispatcher::setDirtyForListenerNodes(Node* node)
+{
+    bool found = false;
+
     // Mark the node dirty only when there is an eventlistener associated with it.
     if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
     {
         _dirtyNodes.insert(node);
+        found = true;
     }
 
     // Also set the dirty flag for node's children
     const auto& children = node->getChildren();
     for (const auto& child : children)
     {
-        setDirtyForNode(child);
+        found |= setDirtyForListenerNodes(child);
     }
+
+    return found;
 }
 
 void EventDispatcher::setDirty(std::string_view listenerID, DirtyFlag flag)
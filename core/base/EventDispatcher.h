@@ -36,6 +36,8 @@
 #include "platform/PlatformMacros.h"
 #include "base/EventListener.h"
 #include "base/Event.h"
+#include "base/EventCustom.h"
+#include "math/Vec2.h"
 #include "platform/StdC.h"
 
 /**
@@ -48,6 +50,9 @@ namespace ax
 
 class Event;
 class EventTouch;
+class EventListenerTouchOneByOne;
+class Touch;
+class Camera;
 class Node;
 class EventCustom;
 class EventListenerCustom;
@@ -164,6 +169,13 @@ public:
      */
     bool isEnabled() const;
 
+    /** Sets a filter which sees the touch, keyboard and mouse events before their listeners, the events it returns
+     * false for aren't dispatched. The FrameRecorder records the input with it.
+     *
+     * @param filter The filter, or nullptr to remove it.
+     */
+    void setInputFilter(std::function<bool(Event*)> filter) { _inputFilter = std::move(filter); }
+
     /////////////////////////////////////////////
 
     /** Dispatches the event.
@@ -183,6 +195,14 @@ public:
      */
     void dispatchCustomEvent(std::string_view eventName, void* optionalUserData = nullptr, bool forced = false);
 
+    /** Dispatches a Custom Event by its interned id, its listeners are found without hashing the name.
+     *
+     * @param eventId The interned name of the event which needs to be dispatched.
+     * @param optionalUserData The optional user data, it's a void*, the default value is nullptr.
+     * @param forced If the event should be sent out regardless of enabled state
+     */
+    void dispatchCustomEvent(EventId eventId, void* optionalUserData = nullptr, bool forced = false);
+
     /** Query whether the specified event listener id has been added.
      *
      * @param listenerID The listenerID of the event listener id.
@@ -191,6 +211,17 @@ public:
      */
     bool hasEventListener(std::string_view listenerID) const;
 
+    /** Counts the sorting of the listeners with scene graph priority, for profiling. */
+    struct SortStats
+    {
+        uint32_t sorts        = 0;  ///< listeners of an event type sorted by scene graph priority
+        uint32_t fullWalks    = 0;  ///< whole scene graph walked to rank the nodes of the listeners
+        uint32_t partialWalks = 0;  ///< children of a reordered node walked instead
+    };
+
+    const SortStats& getSortStats() const { return _sortStats; }
+    void resetSortStats() { _sortStats = {}; }
+
     /////////////////////////////////////////////
 
     /** Constructor of EventDispatcher.
@@ -216,6 +247,13 @@ protected:
     /** Sets the dirty flag for a node. */
     void setDirtyForNode(Node* node);
 
+    /** Sets the dirty flag for the children of a node which were reordered, only the nodes under it are ranked again.
+     */
+    void setDirtyForReorder(Node* node);
+
+    /** Marks the nodes with listeners under a node, returns whether there is one. */
+    bool setDirtyForListenerNodes(Node* node);
+
     /**
      *  The vector to store event listeners with scene graph based priority and fixed priority.
      */
@@ -258,6 +296,12 @@ protected:
     /** Gets event the listener list for the event listener type. */
     EventListenerVector* getListeners(std::string_view listenerID) const;
 
+    /** Gets the listener list of an interned custom event, from the flat array of the ids. */
+    EventListenerVector* getListeners(EventId eventId);
+
+    /** Updates the flat array of the ids when the listener list of a type is created or deleted. */
+    void setListenersForId(std::string_view listenerID, EventListenerVector* listeners);
+
     /** Update dirty flag */
     void updateDirtyFlagForSceneGraph();
 
@@ -317,9 +361,18 @@ protected:
     /** Sets the dirty flag for a specified listener ID */
     void setDirty(std::string_view listenerID, DirtyFlag flag);
 
-    /** Walks though scene graph to get the draw order for each node, it's called before sorting event listener with
-     * scene graph priority */
-    void visitTarget(Node* node, bool isRootNode);
+    /** Walks though scene graph to get the draw order of the nodes with listeners, it's called before sorting event
+     * listener with scene graph priority */
+    void visitTarget(Node* node, std::vector<Node*>& nodes);
+
+    /** Ranks the nodes with listeners in the draw order, from the root or from the reordered nodes only. */
+    void updateNodePriorities(Node* rootNode);
+
+    /** Ranks again the nodes under a reordered node with the ranks they had, false when one of them had none. */
+    bool rankReorderedNodes(Node* node);
+
+    /** Whether a touch begins outside the node of a listener culled by bounds, seen by the visiting camera. */
+    bool isTouchOutsideListenerBounds(EventListenerTouchOneByOne* listener, Touch* touch);
 
     /** Remove all listeners in _toRemoveListeners list and cleanup */
     void cleanToRemovedListeners();
@@ -327,17 +380,40 @@ protected:
     /** Listeners map */
     hlookup::string_map<EventListenerVector*> _listenerMap;
 
+    /** The listeners of the interned custom events by id index, the ids from the size on aren't resolved yet */
+    std::vector<EventListenerVector*> _listenersById;
+
     /** The map of dirty flag */
     hlookup::string_map<DirtyFlag> _priorityDirtyFlagMap;
 
     /** The map of node and event listeners */
     std::unordered_map<Node*, std::vector<EventListener*>*> _nodeListenersMap;
 
-    /** The map of node and its event priority */
+    /** The map of node and its rank in the draw order, the global Z order is compared first */
     std::unordered_map<Node*, int> _nodePriorityMap;
 
-    /** key: Global Z Order, value: Sorted Nodes */
-    std::unordered_map<float, std::vector<Node*>> _globalZOrderNodeMap;
+    /** The root the nodes were ranked from */
+    Node* _nodePriorityRoot = nullptr;
+
+    /** Whether the nodes must be ranked from the root */
+    bool _nodePrioritiesDirty = true;
+
+    /** The nodes whose children were reordered since the nodes were ranked */
+    std::set<Node*> _reorderedNodes;
+
+    /** Whether the scene graph is walked, the children it sorts need no ranking */
+    bool _visitingTargets = false;
+
+    std::vector<Node*> _visitedNodes;
+
+    SortStats _sortStats;
+
+    /** The touch and camera the culling point is computed for, in the current touch event */
+    Touch* _cullingTouch         = nullptr;
+    const Camera* _cullingCamera = nullptr;
+    bool _cullingPointValid      = false;
+    uint32_t _touchEventStamp    = 0;
+    Vec2 _cullingPoint;
 
     /** The listeners to be added after dispatching event */
     std::vector<EventListener*> _toAddedListeners;
@@ -354,6 +430,8 @@ protected:
     /** Whether to enable dispatching event */
     bool _isEnabled;
 
+    std::function<bool(Event*)> _inputFilter;
+
     int _nodePriorityIndex;
 
     std::set<std::string> _internalCustomListenerIDs;
@@ -234,6 +234,7 @@ private:
     bool _isPressed;
 
     friend class EventListenerKeyboard;
+    friend class FrameRecorder;
 };
 
 }
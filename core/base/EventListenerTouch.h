@@ -29,6 +29,7 @@
 #define _AX_TOUCHEVENTLISTENER_H_
 
 #include "base/EventListener.h"
+#include "math/Math.h"
 #include <vector>
 
 /**
@@ -71,6 +72,17 @@ public:
      */
     bool isSwallowTouches();
 
+    /** Whether to skip the listener for the touches which begin outside the content rect of its node.
+     *
+     * The bounds of the node in the world are computed once per touch event, so the listeners of a crowded UI are
+     * not called for every touch. Only for a listener of a node in the z = 0 plane of the world which can't claim
+     * a touch outside its content rect, like the ones of ui::Widget. Off by default.
+     *
+     * @param enabled True to skip the listener for the touches outside its node.
+     */
+    void setBoundsCulling(bool enabled) { _boundsCulling = enabled; }
+    bool isBoundsCulling() const { return _boundsCulling; }
+
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
     virtual bool checkAvailable() override;
@@ -91,6 +103,12 @@ public:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _boundsCulling = false;
+
+    // the bounds of the node in the world, computed by the EventDispatcher for its touch event of this stamp
+    Rect _cullingBounds;
+    uint32_t _cullingStamp = 0;
+    bool _cullingInPlane   = false;
 
     friend class EventDispatcher;
 };
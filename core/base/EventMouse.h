@@ -195,6 +195,7 @@ private:
     Vec2 _prevPoint;
 
     friend class EventListenerMouse;
+    friend class FrameRecorder;
 };
 
 }
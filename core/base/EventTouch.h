@@ -27,6 +27,7 @@
 #define _AX_TOUCHEVENT_H_
 
 #include "base/Event.h"
+#include "math/Vec2.h"
 #include <vector>
 
 /**
@@ -58,6 +59,15 @@ public:
         CANCELLED
     };
 
+    /** A move of a touch, the moves of a frame are coalesced into one MOVED event, see GLView::setInputCoalescing. */
+    struct Sample
+    {
+        int touchId;          // see Touch::getID
+        Vec2 locationInView;  // see Touch::getLocationInView, converted with Director::convertToGL
+        float force;
+        float maxForce;
+    };
+
     /**
      * Constructor.
      * @js NA
@@ -76,6 +86,14 @@ public:
      */
     const std::vector<Touch*>& getTouches() const { return _touches; }
 
+    /** Gets the moves coalesced into a MOVED event, the oldest first, the last move of a touch is its location.
+     *
+     * @return The moves of the touches, empty when the moves aren't coalesced.
+     * @js NA
+     * @lua NA
+     */
+    const std::vector<Sample>& getHistory() const { return _history; }
+
 #if TOUCH_PERF_DEBUG
     /** Set the event code.
      *
@@ -92,8 +110,10 @@ public:
 private:
     EventCode _eventCode;
     std::vector<Touch*> _touches;
+    std::vector<Sample> _history;
 
     friend class GLView;
+    friend class FrameRecorder;
 };
 
 }
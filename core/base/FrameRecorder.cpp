@@ -0,0 +1,399 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/FrameRecorder.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventKeyboard.h"
+#include "base/EventMouse.h"
+#include "base/EventTouch.h"
+#include "base/Logging.h"
+#include "base/Touch.h"
+#include "platform/FileUtils.h"
+#include "renderer/Renderer.h"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
+#include "fmt/format.h"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace ax
+{
+
+static constexpr std::string_view RECORDING_MAGIC = "AXRC"sv;
+static constexpr uint32_t RECORDING_VERSION       = 1;
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+bool FrameRecorder::startRecording(std::string_view path, float fixedDeltaTime)
+{
+    stop();
+
+    if (path.empty() || fixedDeltaTime <= 0)
+        return false;
+
+    _state          = State::RECORDING;
+    _path           = path;
+    _fixedDeltaTime = fixedDeltaTime;
+
+    Director::getInstance()->getEventDispatcher()->setInputFilter(AX_CALLBACK_1(FrameRecorder::filterInput, this));
+    return true;
+}
+
+bool FrameRecorder::startReplay(std::string_view path,
+                                std::string_view reportPath,
+                                std::function<void()> finishedCallback)
+{
+    stop();
+
+    if (!load(path))
+        return false;
+
+    _state            = State::REPLAYING;
+    _reportPath       = reportPath;
+    _finishedCallback = std::move(finishedCallback);
+    _report           = "frame,dt,cpu_ms,visit_ms,sort_ms,encode_ms,submit_ms,gpu_ms,batches,vertices\n";
+
+    auto director = Director::getInstance();
+    auto renderer = director->getRenderer();
+    _wasProfiling = renderer->isProfilingEnabled();
+    renderer->setProfilingEnabled(true);
+
+    director->getEventDispatcher()->setInputFilter(AX_CALLBACK_1(FrameRecorder::filterInput, this));
+    return true;
+}
+
+void FrameRecorder::stop()
+{
+    if (_state == State::RECORDING)
+    {
+        if (!save())
+            AXLOGE("FrameRecorder: can't write the recording to {}", _path);
+    }
+    else if (_state == State::REPLAYING)
+    {
+        if (!_reportPath.empty() && !FileUtils::getInstance()->writeStringToFile(_report, _reportPath))
+            AXLOGE("FrameRecorder: can't write the report to {}", _reportPath);
+        Director::getInstance()->getRenderer()->setProfilingEnabled(_wasProfiling);
+    }
+    else
+        return;
+
+    cleanup();
+}
+
+float FrameRecorder::beginFrame(float deltaTime)
+{
+    if (_state == State::IDLE)
+        return deltaTime;
+
+    _inFrame    = true;
+    _frameStart = std::chrono::steady_clock::now();
+
+    if (_state == State::RECORDING)
+    {
+        _frames.emplace_back().deltaTime = _fixedDeltaTime;
+        return _fixedDeltaTime;
+    }
+    return _frames[_frameIndex].deltaTime;
+}
+
+void FrameRecorder::dispatchInput()
+{
+    if (!_inFrame)
+        return;
+
+    if (_state == State::RECORDING)
+    {
+        // the input received since the last frame, the platforms without event polling deliver it between frames
+        auto& events = _frames.back().events;
+        events.insert(events.end(), std::make_move_iterator(_pendingInput.begin()),
+                      std::make_move_iterator(_pendingInput.end()));
+        _pendingInput.clear();
+        return;
+    }
+
+    auto eventDispatcher = Director::getInstance()->getEventDispatcher();
+    _dispatching         = true;
+    for (const auto& input : _frames[_frameIndex].events)
+    {
+        switch (input.type)
+        {
+        case Event::Type::TOUCH:
+            dispatchTouches(input);
+            break;
+        case Event::Type::KEYBOARD:
+        {
+            EventKeyboard event(static_cast<EventKeyboard::KeyCode>(input.code), input.button != 0);
+            eventDispatcher->dispatchEvent(&event);
+            break;
+        }
+        case Event::Type::MOUSE:
+        {
+            EventMouse event(static_cast<EventMouse::MouseEventType>(input.code));
+            event.setMouseInfo(input.x, input.y, static_cast<EventMouse::MouseButton>(input.button));
+            event.setScrollData(input.scrollX, input.scrollY);
+            eventDispatcher->dispatchEvent(&event);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    _dispatching = false;
+}
+
+void FrameRecorder::endFrame()
+{
+    if (!_inFrame)
+        return;
+    _inFrame = false;
+
+    if (_state == State::REPLAYING)
+    {
+        auto renderer        = Director::getInstance()->getRenderer();
+        const auto& profile  = renderer->getFrameProfile();
+        const auto frameTime = std::chrono::steady_clock::now() - _frameStart;
+        fmt::format_to(std::back_inserter(_report), "{},{:.6f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{},{}\n",
+                       _frameIndex, _frames[_frameIndex].deltaTime,
+                       std::chrono::duration<double, std::milli>(frameTime).count(), profile.visit, profile.sort,
+                       profile.encode, profile.submit, profile.gpu, renderer->getDrawnBatches(),
+                       renderer->getDrawnVertices());
+    }
+
+    if (++_frameIndex == _frames.size() && _state == State::REPLAYING)
+        finishReplay();
+}
+
+bool FrameRecorder::filterInput(Event* event)
+{
+    // while replaying only the recorded input is dispatched
+    if (_state == State::REPLAYING)
+        return _dispatching;
+
+    recordInput(event);
+    return true;
+}
+
+void FrameRecorder::recordInput(Event* event)
+{
+    InputEvent input;
+    input.type = event->getType();
+    switch (input.type)
+    {
+    case Event::Type::TOUCH:
+    {
+        auto touchEvent = static_cast<EventTouch*>(event);
+        input.code      = static_cast<int>(touchEvent->getEventCode());
+        for (auto touch : touchEvent->getTouches())
+        {
+            const auto location = touch->getLocationInView();
+            input.touches.emplace_back(TouchPoint{touch->getID(), location.x, location.y});
+        }
+        break;
+    }
+    case Event::Type::KEYBOARD:
+    {
+        auto keyboardEvent = static_cast<EventKeyboard*>(event);
+        input.code         = static_cast<int>(keyboardEvent->_keyCode);
+        input.button       = keyboardEvent->_isPressed ? 1 : 0;
+        break;
+    }
+    case Event::Type::MOUSE:
+    {
+        auto mouseEvent     = static_cast<EventMouse*>(event);
+        const auto location = mouseEvent->getLocationInView();
+        input.code          = static_cast<int>(mouseEvent->_mouseEventType);
+        input.button        = static_cast<int>(mouseEvent->getMouseButton());
+        input.x             = location.x;
+        input.y             = location.y;
+        input.scrollX       = mouseEvent->getScrollX();
+        input.scrollY       = mouseEvent->getScrollY();
+        break;
+    }
+    default:
+        return;
+    }
+    _pendingInput.emplace_back(std::move(input));
+}
+
+void FrameRecorder::dispatchTouches(const InputEvent& input)
+{
+    EventTouch event;
+    event._eventCode = static_cast<EventTouch::EventCode>(input.code);
+    for (const auto& point : input.touches)
+    {
+        auto& touch = _touches[point.id];
+        if (!touch)
+            touch = new Touch();
+        touch->setTouchInfo(point.id, point.x, point.y);
+        event._touches.emplace_back(touch);
+    }
+
+    Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
+
+    if (event._eventCode == EventTouch::EventCode::ENDED || event._eventCode == EventTouch::EventCode::CANCELLED)
+    {
+        for (const auto& point : input.touches)
+        {
+            auto it = _touches.find(point.id);
+            if (it != _touches.end())
+            {
+                it->second->release();
+                _touches.erase(it);
+            }
+        }
+    }
+}
+
+bool FrameRecorder::load(std::string_view path)
+{
+    auto data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull())
+    {
+        AXLOGE("FrameRecorder: can't read the recording {}", path);
+        return false;
+    }
+
+    yasio::ibstream_view ibs(data.getBytes(), data.getSize());
+    try
+    {
+        if (ibs.read_bytes(static_cast<int>(RECORDING_MAGIC.size())) != RECORDING_MAGIC ||
+            ibs.read<uint32_t>() != RECORDING_VERSION)
+        {
+            AXLOGE("FrameRecorder: {} isn't a recording of this version", path);
+            return false;
+        }
+
+        _frames.resize(ibs.read<uint32_t>());
+        for (auto& frame : _frames)
+        {
+            frame.deltaTime = ibs.read<float>();
+            frame.events.resize(ibs.read<uint32_t>());
+            for (auto& input : frame.events)
+            {
+                input.type   = static_cast<Event::Type>(ibs.read<uint8_t>());
+                input.code   = ibs.read<int32_t>();
+                input.button = ibs.read<int32_t>();
+                if (input.type == Event::Type::MOUSE)
+                {
+                    input.x       = ibs.read<float>();
+                    input.y       = ibs.read<float>();
+                    input.scrollX = ibs.read<float>();
+                    input.scrollY = ibs.read<float>();
+                }
+                else if (input.type == Event::Type::TOUCH)
+                {
+                    input.touches.resize(ibs.read<uint32_t>());
+                    for (auto& point : input.touches)
+                    {
+                        point.id = ibs.read<int32_t>();
+                        point.x  = ibs.read<float>();
+                        point.y  = ibs.read<float>();
+                    }
+                }
+            }
+        }
+    }
+    catch (const std::out_of_range&)
+    {
+        AXLOGE("FrameRecorder: the recording {} is truncated", path);
+        _frames.clear();
+        return false;
+    }
+
+    return !_frames.empty();
+}
+
+bool FrameRecorder::save() const
+{
+    yasio::obstream obs;
+    obs.write_bytes(RECORDING_MAGIC);
+    obs.write<uint32_t>(RECORDING_VERSION);
+    obs.write<uint32_t>(static_cast<uint32_t>(_frames.size()));
+    for (const auto& frame : _frames)
+    {
+        obs.write<float>(frame.deltaTime);
+        obs.write<uint32_t>(static_cast<uint32_t>(frame.events.size()));
+        for (const auto& input : frame.events)
+        {
+            obs.write<uint8_t>(static_cast<uint8_t>(input.type));
+            obs.write<int32_t>(input.code);
+            obs.write<int32_t>(input.button);
+            if (input.type == Event::Type::MOUSE)
+            {
+                obs.write<float>(input.x);
+                obs.write<float>(input.y);
+                obs.write<float>(input.scrollX);
+                obs.write<float>(input.scrollY);
+            }
+            else if (input.type == Event::Type::TOUCH)
+            {
+                obs.write<uint32_t>(static_cast<uint32_t>(input.touches.size()));
+                for (const auto& point : input.touches)
+                {
+                    obs.write<int32_t>(point.id);
+                    obs.write<float>(point.x);
+                    obs.write<float>(point.y);
+                }
+            }
+        }
+    }
+
+    const auto& buffer = obs.buffer();
+    return FileUtils::writeBinaryToFile(buffer.data(), buffer.size(), _path);
+}
+
+void FrameRecorder::finishReplay()
+{
+    auto callback = std::move(_finishedCallback);
+    stop();
+    if (callback)
+        callback();
+}
+
+void FrameRecorder::cleanup()
+{
+    Director::getInstance()->getEventDispatcher()->setInputFilter(nullptr);
+
+    for (auto& item : _touches)
+        item.second->release();
+    _touches.clear();
+
+    _state = State::IDLE;
+    _path.clear();
+    _reportPath.clear();
+    _finishedCallback = nullptr;
+    _frames.clear();
+    _pendingInput.clear();
+    _frameIndex = 0;
+    _inFrame    = false;
+    _report.clear();
+}
+
+}  // namespace ax
@@ -0,0 +1,163 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "base/Event.h"
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+class Touch;
+
+/**
+ * Records the input and the delta times of the frames, to replay the same workload on another build and compare
+ * the frame timings, e.g. in performance regression runs.
+ *
+ * While recording the frames advance by a fixed delta time, whatever time they actually take, and the touch,
+ * keyboard and mouse events the EventDispatcher receives are saved with the frame they're dispatched in. A replay
+ * feeds the recorded delta times and dispatches the recorded events in their frames, the live input is ignored
+ * meanwhile. It writes a CSV report with a line per frame: its CPU time, the phases of the renderer frame profile
+ * (the ones it adds to the trace as counters), the GPU time and the draw stats.
+ *
+ * The recordings replay deterministically as long as the app doesn't depend on the wall clock or an unseeded
+ * random generator. The controller, acceleration and text input events aren't recorded.
+ *
+ * @code
+ * auto recorder = Director::getInstance()->getFrameRecorder();
+ * recorder->startReplay("benchmarks/menu.axrec", "menu-report.csv", [] { Director::getInstance()->end(); });
+ * @endcode
+ */
+class AX_DLL FrameRecorder
+{
+public:
+    enum class State
+    {
+        IDLE,
+        RECORDING,
+        REPLAYING,
+    };
+
+    FrameRecorder() = default;
+    ~FrameRecorder();
+
+    /**
+     * Starts recording, the recording is written to the file when stop() is invoked.
+     * @param path The file the recording is written to.
+     * @param fixedDeltaTime The delta time of each recorded frame, in seconds.
+     */
+    bool startRecording(std::string_view path, float fixedDeltaTime = 1.0f / 60);
+
+    /**
+     * Replays a recording from its next frame. The renderer profiling is enabled until the replay ends.
+     * @param path The recording file.
+     * @param reportPath The file the CSV report is written to when the replay ends, none if empty.
+     * @param finishedCallback Invoked once the last recorded frame was replayed.
+     * @return false if the recording can't be loaded.
+     */
+    bool startReplay(std::string_view path,
+                     std::string_view reportPath,
+                     std::function<void()> finishedCallback = nullptr);
+
+    /** Writes the recording or the report of the replay so far, and stops. */
+    void stop();
+
+    State getState() const { return _state; }
+
+    /** The frames recorded or replayed since the start. */
+    unsigned int getFrameIndex() const { return _frameIndex; }
+    unsigned int getFrameCount() const { return static_cast<unsigned int>(_frames.size()); }
+
+    /** Invoked by the Director once the delta time of the frame is calculated, returns the one to use. */
+    float beginFrame(float deltaTime);
+
+    /** Invoked by the Director after the window events were dispatched, dispatches the replayed ones. */
+    void dispatchInput();
+
+    /** Invoked by the Director at the end of a frame. */
+    void endFrame();
+
+private:
+    struct TouchPoint
+    {
+        int id;
+        float x;
+        float y;
+    };
+
+    struct InputEvent
+    {
+        Event::Type type = Event::Type::TOUCH;
+        int code         = 0;  ///< EventTouch::EventCode, EventKeyboard::KeyCode or EventMouse::MouseEventType.
+        int button       = 0;  ///< EventMouse::MouseButton, or 1 if the key is pressed.
+        float x          = 0;  ///< The mouse location in view.
+        float y          = 0;
+        float scrollX    = 0;
+        float scrollY    = 0;
+        std::vector<TouchPoint> touches;  ///< Their locations in view.
+    };
+
+    struct Frame
+    {
+        float deltaTime = 0;
+        std::vector<InputEvent> events;
+    };
+
+    bool filterInput(Event* event);
+    void recordInput(Event* event);
+    void dispatchTouches(const InputEvent& input);
+
+    bool load(std::string_view path);
+    bool save() const;
+    void finishReplay();
+    void cleanup();
+
+    State _state = State::IDLE;
+    std::string _path;
+    std::string _reportPath;
+    std::function<void()> _finishedCallback;
+
+    std::vector<Frame> _frames;
+    unsigned int _frameIndex = 0;
+    float _fixedDeltaTime    = 0;
+    bool _inFrame            = false;
+
+    std::vector<InputEvent> _pendingInput;  // recorded since the last frame
+    bool _dispatching = false;              // the replayed events are being dispatched
+    std::unordered_map<int, Touch*> _touches;
+
+    std::chrono::steady_clock::time_point _frameStart;
+    std::string _report;
+    bool _wasProfiling = false;
+};
+
+}  // namespace ax
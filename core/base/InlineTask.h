@@ -0,0 +1,172 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/** @class InlineTask
+ * @brief A move only `void()` callable, stored in place when it fits in INLINE_SIZE bytes.
+ *
+ * Unlike std::function, the lambdas capturing a few pointers or a RefPtr don't allocate, and the callables which
+ * can't be copied are accepted. The larger ones, or those which may throw when moved, are allocated on the heap.
+ */
+class InlineTask
+{
+public:
+    static constexpr size_t INLINE_SIZE = 56;
+
+    InlineTask() = default;
+    InlineTask(std::nullptr_t) {}
+
+    template <typename F,
+              typename T = std::decay_t<F>,
+              typename   = std::enable_if_t<!std::is_same_v<T, InlineTask> && std::is_invocable_v<T&>>>
+    InlineTask(F&& f)
+    {
+        if constexpr (std::is_pointer_v<T> || IsStdFunction<T>::value)
+        {
+            // an empty function gives an empty task
+            if (!f)
+                return;
+        }
+
+        if constexpr (FITS_INLINE<T>)
+        {
+            new (_storage) T(std::forward<F>(f));
+            _ops = &LocalOps<T>::OPS;
+        }
+        else
+        {
+            *reinterpret_cast<T**>(_storage) = new T(std::forward<F>(f));
+            _ops                             = &HeapOps<T>::OPS;
+        }
+    }
+
+    InlineTask(InlineTask&& other) noexcept { moveFrom(other); }
+    InlineTask& operator=(InlineTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineTask(const InlineTask&)            = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    ~InlineTask() { reset(); }
+
+    void operator()() { _ops->invoke(_storage); }
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+    /** Whether the callable is stored in place, false for an empty task. */
+    bool isInline() const { return _ops && _ops->local; }
+
+    void reset()
+    {
+        if (_ops)
+        {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops
+    {
+        void (*invoke)(void*);
+        void (*move)(void* dst, void* src);  // move constructs dst and destroys src
+        void (*destroy)(void*);
+        bool local;
+    };
+
+    template <typename T>
+    struct IsStdFunction : std::false_type
+    {};
+    template <typename R, typename... Args>
+    struct IsStdFunction<std::function<R(Args...)>> : std::true_type
+    {};
+
+    template <typename T>
+    static constexpr bool FITS_INLINE = sizeof(T) <= INLINE_SIZE && alignof(T) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    struct LocalOps
+    {
+        static void invoke(void* p) { (*static_cast<T*>(p))(); }
+        static void move(void* dst, void* src)
+        {
+            new (dst) T(std::move(*static_cast<T*>(src)));
+            static_cast<T*>(src)->~T();
+        }
+        static void destroy(void* p) { static_cast<T*>(p)->~T(); }
+
+        static constexpr Ops OPS{&invoke, &move, &destroy, true};
+    };
+
+    template <typename T>
+    struct HeapOps
+    {
+        static void invoke(void* p) { (**static_cast<T**>(p))(); }
+        static void move(void* dst, void* src) { *static_cast<T**>(dst) = *static_cast<T**>(src); }
+        static void destroy(void* p) { delete *static_cast<T**>(p); }
+
+        static constexpr Ops OPS{&invoke, &move, &destroy, false};
+    };
+
+    void moveFrom(InlineTask& other) noexcept
+    {
+        if (other._ops)
+        {
+            other._ops->move(_storage, other._storage);
+            _ops       = other._ops;
+            other._ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char _storage[INLINE_SIZE];
+    const Ops* _ops = nullptr;
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
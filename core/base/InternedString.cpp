@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/InternedString.h"
+
+#include "xxhash/xxhash.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace ax
+{
+
+struct InternedStringTable
+{
+    using Entry = InternedString::Entry;
+
+    static InternedStringTable& getInstance()
+    {
+        static InternedStringTable table;
+        return table;
+    }
+
+    const Entry* find(std::string_view str, uint64_t hash) const
+    {
+        auto range = entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second->str == str)
+                return it->second;
+        }
+        return nullptr;
+    }
+
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, const Entry*> entries;  // by hash, the strings are compared on a collision
+    std::deque<Entry> storage;                                // never moved
+    size_t bytes = 0;
+};
+
+InternedString InternedString::intern(std::string_view str)
+{
+    if (str.empty())
+        return InternedString();
+
+    const uint64_t hash = XXH3_64bits(str.data(), str.length());
+
+    auto& table = InternedStringTable::getInstance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (auto* entry = table.find(str, hash))
+        return InternedString(entry);
+
+    auto& entry = table.storage.emplace_back(Entry{std::string{str}, hash});
+    table.entries.emplace(hash, &entry);
+    table.bytes += sizeof(Entry) + (entry.str.capacity() > std::string().capacity() ? entry.str.capacity() + 1 : 0);
+    return InternedString(&entry);
+}
+
+InternedString InternedString::find(std::string_view str)
+{
+    if (str.empty())
+        return InternedString();
+
+    const uint64_t hash = XXH3_64bits(str.data(), str.length());
+
+    auto& table = InternedStringTable::getInstance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return InternedString(table.find(str, hash));
+}
+
+size_t InternedString::getInternedCount()
+{
+    auto& table = InternedStringTable::getInstance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.storage.size();
+}
+
+size_t InternedString::getMemoryUsage()
+{
+    auto& table = InternedStringTable::getInstance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.bytes;
+}
+
+}  // namespace ax
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+
+#include <string>
+#include <string_view>
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/** @class InternedString
+ * @brief A string stored once in a global table, with its hash computed once.
+ *
+ * Equal strings are interned to the same entry, so two interned strings are compared by pointer. The entries are
+ * never freed, intern names and keys, not arbitrary text. The node names and the scheduler keys are interned.
+ @code
+ static const InternedString PLAYER("player");
+ if (node->getInternedName() == PLAYER)
+     ...
+ @endcode
+ */
+class AX_DLL InternedString
+{
+public:
+    /** Interns a string, the same string always gives the same entry. Thread safe. */
+    static InternedString intern(std::string_view str);
+
+    /** The entry of a string if it was interned, an empty InternedString otherwise.
+     *
+     * Looking for a name that was never interned can't match any interned one, which returns early.
+     */
+    static InternedString find(std::string_view str);
+
+    /** The number of interned strings and the bytes they hold. */
+    static size_t getInternedCount();
+    static size_t getMemoryUsage();
+
+    /** The empty string, it isn't stored in the table. */
+    InternedString() = default;
+    explicit InternedString(std::string_view str) : InternedString(intern(str)) {}
+
+    bool empty() const { return _entry == nullptr; }
+    std::string_view view() const { return _entry ? std::string_view{_entry->str} : std::string_view{}; }
+    const char* c_str() const { return _entry ? _entry->str.c_str() : ""; }
+    /** XXH3 64 bits, 0 for the empty string. */
+    uint64_t hash() const { return _entry ? _entry->hash : 0; }
+
+    operator std::string_view() const { return view(); }
+
+    bool operator==(const InternedString& other) const { return _entry == other._entry; }
+    bool operator!=(const InternedString& other) const { return _entry != other._entry; }
+
+private:
+    friend struct InternedStringTable;
+
+    struct Entry
+    {
+        std::string str;
+        uint64_t hash;
+    };
+
+    explicit InternedString(const Entry* entry) : _entry(entry) {}
+
+    const Entry* _entry = nullptr;  // owned by the table
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
@@ -25,92 +25,120 @@
 
 #include "base/JobSystem.h"
 #include "base/Director.h"
+#include "base/Scheduler.h"
+#include "base/Profiling.h"
 #include "yasio/thread_name.hpp"
 
-#include <queue>
+#include <atomic>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
+#include <algorithm>
+#include <cstdio>
 #include <stdexcept>
 
 #if defined(__EMSCRIPTEN__)
 #    include <emscripten/emscripten.h>
+#elif defined(__APPLE__)
+#    include <sys/sysctl.h>
 #endif
 
 namespace ax
 {
 
 #pragma region JobExecutor
+
+// the executor and the queue of the worker running on this thread
+static thread_local JobExecutor* s_executor     = nullptr;
+static thread_local size_t s_queueIndex         = 0;
+static thread_local JobThreadData* s_threadData = nullptr;
+
 class JobExecutor
 {
 public:
-    explicit JobExecutor(std::span<std::shared_ptr<JobThreadData>> tdds) : stop(false)
+    using Task = std::function<void(JobThreadData*)>;
+
+    static constexpr int LANE_COUNT = 3;
+
+    explicit JobExecutor(std::span<std::shared_ptr<JobThreadData>> tdds)
     {
-        for (auto thread_data : tdds)
-            workers.emplace_back([this, thread_data] {
+        for (size_t i = 0; i < tdds.size(); ++i)
+            queues.emplace_back(std::make_unique<WorkQueue>());
+
+        for (size_t i = 0; i < tdds.size(); ++i)
+            workers.emplace_back([this, i, thread_data = tdds[i]] {
+                s_executor   = this;
+                s_queueIndex = i;
+                s_threadData = thread_data.get();
+
                 thread_data->init();
                 yasio::set_thread_name(thread_data->name());
+                Tracer::getInstance()->setThreadName(thread_data->name());
                 for (;;)
                 {
-                    std::function<void(JobThreadData*)> task;
+                    Task task;
+                    if (pop(task, JobPriority::Low))
                     {
-                        std::unique_lock<std::mutex> lock(this->queue_mutex);
-                        this->condition.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
-                        if (this->stop && this->tasks.empty())
-                            break;
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
+                        AX_TRACE_SCOPE("JobSystem::task");
+                        task(thread_data.get());
+                        continue;
                     }
 
-                    task(thread_data.get());
+                    std::unique_lock<std::mutex> lock(this->sleep_mutex);
+                    this->condition.wait(lock, [this] { return this->stop || this->pending.load() != 0; });
+                    if (this->stop && this->pending.load() == 0)
+                        break;
                 }
                 thread_data->finz();
             });
     }
-    template <class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F(Args...)>::type>
-    {
-        using return_type = typename std::invoke_result<F(Args...)>::type;
 
-        auto task = std::make_shared<std::packaged_task<return_type(size_t)>>(
-            std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...));
+    void push(Task task, JobPriority priority)
+    {
+        // don't allow enqueueing after stopping the pool
+        if (stop)
+            throw std::runtime_error("enqueue on stopped executor");
 
-        std::future<return_type> res = task->get_future();
+        // a worker keeps the jobs it schedules, the others are spread over the queues
+        const size_t index =
+            s_executor == this ? s_queueIndex : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
+            auto& queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.lanes[static_cast<int>(priority)].emplace_back(std::move(task));
+        }
+        pending.fetch_add(1);
 
-            tasks.emplace([task](JobThreadData* thread_data) { (*task)(thread_data); });
+        // taken, so a worker can't miss the wake up between its check and its wait
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
         }
         condition.notify_one();
-        return res;
     }
 
-    template <class F, class... Args>
-    void enqueue_v(F&& f, Args&&... args)
+    /** Runs a pending job of a priority down to lowest on the calling thread, returns false when there is none. */
+    bool runPending(JobPriority lowest, JobThreadData* thread_data)
     {
-        auto task = std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...);
+        Task task;
+        if (!pop(task, lowest))
+            return false;
 
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+        AX_TRACE_SCOPE("JobSystem::task");
+        task(thread_data);
+        return true;
+    }
 
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
+    size_t size() const { return workers.size(); }
+
+    size_t pendingCount() const { return pending.load(std::memory_order_relaxed); }
 
-            tasks.emplace(std::move(task));
-        }
-        condition.notify_one();
-    }
     ~JobExecutor()
     {
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            std::unique_lock<std::mutex> lock(sleep_mutex);
             stop = true;
         }
         condition.notify_all();
@@ -119,22 +147,156 @@ public:
     }
 
 private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> lanes[LANE_COUNT];
+    };
+
+    /** Takes the newest job of the own queue of a worker, or steals the oldest one of another queue, by lane. */
+    bool pop(Task& task, JobPriority lowest)
+    {
+        const bool owner   = s_executor == this;
+        const size_t first = owner ? s_queueIndex : 0;
+        const size_t count = queues.size();
+        for (int lane = 0; lane <= static_cast<int>(lowest); ++lane)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& queue = *queues[(first + i) % count];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                auto& jobs = queue.lanes[lane];
+                if (jobs.empty())
+                    continue;
+
+                if (owner && i == 0)
+                {
+                    task = std::move(jobs.back());
+                    jobs.pop_back();
+                }
+                else
+                {
+                    task = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                pending.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
     // need to keep track of threads so we can join them
     std::vector<std::thread> workers;
 
-    // the task queue
-    std::queue<std::function<void(JobThreadData*)>> tasks;
+    // the task queues, one per worker
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> next_queue{0};
 
     // synchronization
-    std::mutex queue_mutex;
+    std::mutex sleep_mutex;
     std::condition_variable condition;
-    bool stop;
+    std::atomic<bool> stop{false};
 };
 
 #pragma endregion
 
+#pragma region JobNode
+class JobNode
+{
+public:
+    JobSystem* system;
+    std::function<void()> task;
+    JobPriority priority;
+    bool onAxmolThread;
+
+    // one for each job it waits for, plus one held while it is being set up
+    std::atomic<uint32_t> dependencies{1};
+    std::atomic<bool> done{false};
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<JobNode>> continuations;
+};
+
+#pragma endregion
+
+#pragma region JobHandle
+
+bool JobHandle::isDone() const
+{
+    return !_node || _node->done.load();
+}
+
+JobHandle JobHandle::then(std::function<void()> task, JobPriority priority) const
+{
+    AXASSERT(_node, "Can't continue an empty job handle");
+    auto system = _node->system;
+    auto handle = system->createNode(std::move(task), priority, false);
+    system->addDependency(handle._node, _node);
+    system->release(handle._node);
+    return handle;
+}
+
+JobHandle JobHandle::thenOnAxmolThread(std::function<void()> task) const
+{
+    AXASSERT(_node, "Can't continue an empty job handle");
+    auto system = _node->system;
+    auto handle = system->createNode(std::move(task), JobPriority::High, true);
+    system->addDependency(handle._node, _node);
+    system->release(handle._node);
+    return handle;
+}
+
+#pragma endregion
+
 #pragma region JobSystem
 
+#if !defined(__EMSCRIPTEN__) && !defined(AX_PLATFORM_PC)
+/**
+ * Counts the performance and the efficiency cores of a hybrid (big.LITTLE) CPU, the cores of the lowest maximum
+ * frequency are the efficiency ones. Returns false when the topology is unknown or the cores are all alike.
+ */
+static bool detectCoreTopology(int& performanceCores, int& efficiencyCores)
+{
+    performanceCores = efficiencyCores = 0;
+#    if defined(__APPLE__)
+    int value   = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname("hw.perflevel0.physicalcpu", &value, &size, nullptr, 0) != 0)
+        return false;
+    performanceCores = value;
+    size             = sizeof(value);
+    if (sysctlbyname("hw.perflevel1.physicalcpu", &value, &size, nullptr, 0) == 0)
+        efficiencyCores = value;
+#    elif defined(__linux__)
+    std::vector<long> frequencies;
+    const int coreCount = static_cast<int>(std::thread::hardware_concurrency());
+    for (int core = 0; core < coreCount; ++core)
+    {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", core);
+        auto file = fopen(path, "r");
+        if (!file)
+            return false;
+        long frequency = 0;
+        const bool read = fscanf(file, "%ld", &frequency) == 1;
+        fclose(file);
+        if (!read)
+            return false;
+        frequencies.emplace_back(frequency);
+    }
+    if (frequencies.empty())
+        return false;
+
+    const long lowest = *std::min_element(frequencies.begin(), frequencies.end());
+    for (auto frequency : frequencies)
+        ++(frequency > lowest ? performanceCores : efficiencyCores);
+#    endif
+    return performanceCores > 0 && efficiencyCores > 0;
+}
+#endif
+
 static int clampThreads(int nThreads)
 {
     if (nThreads <= 0)
@@ -143,7 +305,12 @@ static int clampThreads(int nThreads)
 #    if defined(AX_PLATFORM_PC)
         nThreads = (std::max)(static_cast<int>(std::thread::hardware_concurrency() * 3 / 2), 2);
 #    else
-        nThreads = (std::clamp)(static_cast<int>(std::thread::hardware_concurrency()) - 2, 2, 8);
+        // one performance core is left to the axmol thread, the efficiency ones are shared with the system
+        int performanceCores, efficiencyCores;
+        if (detectCoreTopology(performanceCores, efficiencyCores))
+            nThreads = (std::clamp)(performanceCores - 1 + efficiencyCores / 2, 2, 8);
+        else
+            nThreads = (std::clamp)(static_cast<int>(std::thread::hardware_concurrency()) - 2, 2, 8);
 #    endif
 #else
 #    if defined(__EMSCRIPTEN_PTHREADS__)
@@ -197,7 +364,7 @@ JobSystem::~JobSystem()
 void JobSystem::enqueue_v(std::function<void(JobThreadData*)> task)
 {
     if (_executor)
-        _executor->enqueue_v(std::move(task));
+        _executor->push(std::move(task), JobPriority::Normal);
     else
         task(_mainThreadData);
 }
@@ -222,7 +389,7 @@ void JobSystem::enqueue(std::shared_ptr<JobThreadTask> task)
         }
     };
     if (_executor)
-        _executor->enqueue_v(std::move(taskw));
+        _executor->push(std::move(taskw), JobPriority::Normal);
     else
         taskw(_mainThreadData);
 }
@@ -237,11 +404,163 @@ void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
             Director::getInstance()->getScheduler()->runOnAxmolThread(done_);
     };
     if (_executor)
-        _executor->enqueue_v(taskw);
+        _executor->push(std::move(taskw), JobPriority::Normal);
     else
         taskw(_mainThreadData);
 }
 
+JobHandle JobSystem::schedule(std::function<void()> task, JobPriority priority)
+{
+    auto handle = createNode(std::move(task), priority, false);
+    release(handle._node);
+    return handle;
+}
+
+JobHandle JobSystem::whenAll(std::span<const JobHandle> handles)
+{
+    auto handle = createNode(nullptr, JobPriority::High, false);
+    for (auto&& dependency : handles)
+        addDependency(handle._node, dependency._node);
+    release(handle._node);
+    return handle;
+}
+
+JobHandle JobSystem::parallelFor(size_t count,
+                                 size_t grainSize,
+                                 std::function<void(size_t begin, size_t end)> fn,
+                                 JobPriority priority)
+{
+    grainSize               = (std::max)(grainSize, size_t{1});
+    const size_t rangeCount = (count + grainSize - 1) / grainSize;
+    if (rangeCount <= 1 || !_executor)
+    {
+        return schedule([count, fn = std::move(fn)] {
+            if (count)
+                fn(0, count);
+        }, priority);
+    }
+
+    // the ranges are taken one by one by the jobs, a slow range doesn't hold back the ones after it
+    struct Ranges
+    {
+        std::function<void(size_t, size_t)> fn;
+        std::atomic<size_t> next{0};
+        size_t count;
+        size_t grainSize;
+        size_t rangeCount;
+    };
+    auto ranges        = std::make_shared<Ranges>();
+    ranges->fn         = std::move(fn);
+    ranges->count      = count;
+    ranges->grainSize  = grainSize;
+    ranges->rangeCount = rangeCount;
+
+    // one more job than workers, for the thread waiting on the handle
+    const size_t jobCount = (std::min)(rangeCount, _executor->size() + 1);
+    auto handle           = createNode(nullptr, priority, false);
+    for (size_t job = 0; job < jobCount; ++job)
+    {
+        auto range = schedule(
+            [ranges] {
+                for (size_t index; (index = ranges->next.fetch_add(1)) < ranges->rangeCount;)
+                {
+                    const size_t begin = index * ranges->grainSize;
+                    ranges->fn(begin, (std::min)(ranges->count, begin + ranges->grainSize));
+                }
+            },
+            priority);
+        addDependency(handle._node, range._node);
+    }
+    release(handle._node);
+    return handle;
+}
+
+void JobSystem::wait(const JobHandle& handle)
+{
+    if (!handle.valid())
+        return;
+
+    AX_TRACE_SCOPE("JobSystem::wait");
+    auto threadData = s_threadData ? s_threadData : _mainThreadData;
+    while (!handle.isDone())
+    {
+        // only the frame critical jobs, a long loading job would delay the thread waiting
+        if (!_executor || !_executor->runPending(JobPriority::High, threadData))
+            std::this_thread::yield();
+    }
+}
+
+size_t JobSystem::getWorkerCount() const
+{
+    return _executor ? _executor->size() : 0;
+}
+
+size_t JobSystem::getPendingJobCount() const
+{
+    return _executor ? _executor->pendingCount() : 0;
+}
+
+JobHandle JobSystem::createNode(std::function<void()> task, JobPriority priority, bool onAxmolThread)
+{
+    auto node           = std::make_shared<JobNode>();
+    node->system        = this;
+    node->task          = std::move(task);
+    node->priority      = priority;
+    node->onAxmolThread = onAxmolThread;
+    return JobHandle{std::move(node)};
+}
+
+void JobSystem::addDependency(const std::shared_ptr<JobNode>& node, const std::shared_ptr<JobNode>& dependency)
+{
+    if (!dependency)
+        return;
+
+    node->dependencies.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done.load())
+        {
+            dependency->continuations.emplace_back(node);
+            return;
+        }
+    }
+    release(node);
+}
+
+void JobSystem::release(const std::shared_ptr<JobNode>& node)
+{
+    if (node->dependencies.fetch_sub(1) == 1)
+        submit(node);
+}
+
+void JobSystem::submit(const std::shared_ptr<JobNode>& node)
+{
+    if (node->onAxmolThread)
+        Director::getInstance()->getScheduler()->runOnAxmolThread([this, node] { run(node); });
+    else if (node->task && _executor)
+        _executor->push([this, node](JobThreadData*) { run(node); }, node->priority);
+    else
+        run(node);
+}
+
+void JobSystem::run(const std::shared_ptr<JobNode>& node)
+{
+    if (node->task)
+    {
+        node->task();
+        node->task = nullptr;  // the captures are released with the job, not with the last handle
+    }
+
+    std::vector<std::shared_ptr<JobNode>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(node->mutex);
+        node->done.store(true);
+        continuations.swap(node->continuations);
+    }
+    for (auto&& continuation : continuations)
+        release(continuation);
+}
+
 #pragma endregion
 
 }  // namespace ax
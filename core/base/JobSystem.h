@@ -39,6 +39,7 @@ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
 #include <memory>
 #include <string>
 #include <span>
+#include <functional>
 #include "base/Config.h"
 #include "platform/PlatformDefine.h"
 
@@ -47,6 +48,43 @@ namespace ax
 
 class JobExecutor;
 class JobSystem;
+class JobNode;
+
+/** The lanes of the job queues, a worker takes the jobs of a higher priority first. */
+enum class JobPriority
+{
+    High,    // frame critical, the current frame waits for it
+    Normal,  // the default
+    Low,     // loading and other background work
+};
+
+/**
+ * A handle on a job of the task graph, see JobSystem::schedule.
+ * It is cheap to copy, and can be continued from any thread. An empty handle is done.
+ */
+class AX_API JobHandle
+{
+public:
+    JobHandle() = default;
+
+    bool valid() const { return _node != nullptr; }
+
+    /** Whether the job ran, it never blocks. */
+    bool isDone() const;
+
+    /** Schedules a job run once this one is done. */
+    JobHandle then(std::function<void()> task, JobPriority priority = JobPriority::Normal) const;
+
+    /** Runs a function on the axmol thread once this job is done, with Scheduler::runOnAxmolThread. */
+    JobHandle thenOnAxmolThread(std::function<void()> task) const;
+
+private:
+    friend class JobSystem;
+
+    explicit JobHandle(std::shared_ptr<JobNode> node) : _node(std::move(node)) {}
+
+    std::shared_ptr<JobNode> _node;
+};
 class JobThreadData
 {
 public:
@@ -102,10 +140,51 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /**
+     * Schedules a job of the task graph.
+     * Every worker has its own queue, the jobs scheduled by a job go to the queue of its worker and the idle workers
+     * steal from the others. Without workers, the job runs right away.
+     */
+    JobHandle schedule(std::function<void()> task, JobPriority priority = JobPriority::Normal);
+
+    /** Returns a handle done once all the jobs are done. */
+    JobHandle whenAll(std::span<const JobHandle> handles);
+
+    /**
+     * Calls fn(begin, end) over [0, count) by ranges of grainSize, on as many workers as there are ranges.
+     * Pass the handle to wait for the ranges to be done, or continue it.
+     */
+    JobHandle parallelFor(size_t count,
+                          size_t grainSize,
+                          std::function<void(size_t begin, size_t end)> fn,
+                          JobPriority priority = JobPriority::High);
+
+    /**
+     * Waits for a job, the calling thread runs the pending high priority jobs meanwhile.
+     * A job continued on the axmol thread must not be waited for on it.
+     */
+    void wait(const JobHandle& handle);
+
+    /** The worker thread count, 0 when the jobs run on the thread scheduling them. */
+    size_t getWorkerCount() const;
+
+    /** The jobs queued and not started yet, all priorities, for the performance tools. */
+    size_t getPendingJobCount() const;
+
  protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
+    JobHandle createNode(std::function<void()> task, JobPriority priority, bool onAxmolThread);
+    /** Makes a job wait for another one, or not when it is done already. */
+    void addDependency(const std::shared_ptr<JobNode>& node, const std::shared_ptr<JobNode>& dependency);
+    /** Drops a dependency of a job, it is queued with its last one. */
+    void release(const std::shared_ptr<JobNode>& node);
+    void submit(const std::shared_ptr<JobNode>& node);
+    void run(const std::shared_ptr<JobNode>& node);
+
 private:
+    friend class JobHandle;
+
     JobExecutor* _executor{nullptr};
     JobThreadData* _mainThreadData{nullptr};
 };
@@ -26,7 +26,9 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "base/Object.h"
+#include "base/Allocator.h"
 #include "base/AutoreleasePool.h"
+#include "base/ObjectArena.h"
 #include "base/Macros.h"
 #include "base/ScriptSupport.h"
 
@@ -47,6 +49,7 @@ static void untrackRef(Object* ref);
 
 Object::Object()
     : _referenceCount(1)  // when the Object is created, the reference count of it is 1
+    , _arenaAllocated(false)
 #if AX_ENABLE_SCRIPT_BINDING
     , _luaID(0)
 #endif
@@ -61,6 +64,28 @@ Object::Object()
 #endif
 }
 
+#if AX_ENABLE_ATOMIC_REFCOUNT
+Object::Object(const Object& other)
+    : _referenceCount(other.getReferenceCount())
+    , _arenaAllocated(other._arenaAllocated)
+#    if AX_ENABLE_SCRIPT_BINDING
+    , _ID(other._ID)
+    , _luaID(other._luaID)
+#    endif
+{}
+
+Object& Object::operator=(const Object& other)
+{
+    _referenceCount.store(other.getReferenceCount(), std::memory_order_relaxed);
+    _arenaAllocated = other._arenaAllocated;
+#    if AX_ENABLE_SCRIPT_BINDING
+    _ID    = other._ID;
+    _luaID = other._luaID;
+#    endif
+    return *this;
+}
+#endif
+
 Object::~Object()
 {
 #if AX_ENABLE_SCRIPT_BINDING
@@ -81,15 +106,25 @@ Object::~Object()
 void Object::retain()
 {
     AXASSERT(_referenceCount > 0, "reference count should be greater than 0");
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    // a new reference is made from an existing one, nothing needs to be ordered
+    _referenceCount.fetch_add(1, std::memory_order_relaxed);
+#else
     ++_referenceCount;
+#endif
 }
 
 void Object::release()
 {
     AXASSERT(_referenceCount > 0, "reference count should be greater than 0");
-    --_referenceCount;
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    // the writes made through the other references must be visible to the thread destroying the object
+    const bool destroy = _referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#else
+    const bool destroy = --_referenceCount == 0;
+#endif
 
-    if (_referenceCount == 0)
+    if (destroy)
     {
 #if defined(_AX_DEBUG) && (_AX_DEBUG > 0)
         auto poolManager = PoolManager::getInstance();
@@ -130,19 +165,77 @@ void Object::release()
 #if AX_OBJECT_LEAK_DETECTION
         untrackRef(this);
 #endif
-        delete this;
+        if (_arenaAllocated)
+            ObjectArena::destroy(this);
+        else
+            delete this;
     }
 }
 
+void* Object::operator new(std::size_t size)
+{
+    if (auto ptr = Memory::allocate(size, MemoryTag::OBJECT, __STDCPP_DEFAULT_NEW_ALIGNMENT__))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* Object::operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Memory::allocate(size, MemoryTag::OBJECT, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* Object::operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto ptr = Memory::allocate(size, MemoryTag::OBJECT, static_cast<std::size_t>(alignment)))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* Object::operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Memory::allocate(size, MemoryTag::OBJECT, static_cast<std::size_t>(alignment));
+}
+
+void Object::operator delete(void* ptr, std::size_t size) noexcept
+{
+    Memory::deallocate(ptr, size, MemoryTag::OBJECT, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void Object::operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept
+{
+    Memory::deallocate(ptr, size, MemoryTag::OBJECT, static_cast<std::size_t>(alignment));
+}
+
+void Object::operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    Memory::getAllocator()->deallocate(ptr, 0, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void Object::operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    Memory::getAllocator()->deallocate(ptr, 0, static_cast<std::size_t>(alignment));
+}
+
 Object* Object::autorelease()
 {
     PoolManager::getInstance()->getCurrentPool()->addObject(this);
+    if (ObjectArena::isCreationStatsEnabled())
+        ObjectArena::getInstance()->recordCreation(typeid(*this), true);
     return this;
 }
 
+void Object::releaseDeferred()
+{
+    PoolManager::getInstance()->addDeferredRelease(this);
+}
+
 unsigned int Object::getReferenceCount() const
 {
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    return _referenceCount.load(std::memory_order_relaxed);
+#else
     return _referenceCount;
+#endif
 }
 
 #if AX_OBJECT_LEAK_DETECTION
@@ -31,6 +31,13 @@ THE SOFTWARE.
 #include "platform/PlatformMacros.h"
 #include "base/Config.h"
 
+#include <cstddef>
+#include <new>
+
+#if AX_ENABLE_ATOMIC_REFCOUNT
+#    include <atomic>
+#endif
+
 #define AX_OBJECT_LEAK_DETECTION 0
 
 /**
@@ -108,6 +115,19 @@ public:
      */
     Object* autorelease();
 
+    /**
+     * Releases the ownership on the axmol thread, after the autorelease pool of the current frame is cleared.
+     *
+     * Unlike release and autorelease, it may be called from any thread, so workers can drop the references they
+     * were given without destroying a texture or a node off the axmol thread. Retaining on a worker needs
+     * AX_ENABLE_ATOMIC_REFCOUNT.
+     *
+     * @see PoolManager::releaseDeferredObjects
+     * @js NA
+     * @lua NA
+     */
+    void releaseDeferred();
+
     /**
      * Returns the Object's current reference count.
      *
@@ -116,6 +136,24 @@ public:
      */
     unsigned int getReferenceCount() const;
 
+    /**
+     * The Objects are allocated with Memory::allocate and accounted to MemoryTag::OBJECT.
+     *
+     * The nothrow deletes only run when a constructor throws, without the size their memory stays accounted.
+     * @js NA
+     * @lua NA
+     */
+    static void* operator new(std::size_t size);
+    static void* operator new(std::size_t size, const std::nothrow_t&) noexcept;
+    static void* operator new(std::size_t size, std::align_val_t alignment);
+    static void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept;
+    static void* operator new(std::size_t /*size*/, void* where) noexcept { return where; }
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+    static void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept;
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept;
+    static void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept;
+    static void operator delete(void* /*ptr*/, void* /*where*/) noexcept {}
+
 protected:
     /**
      * Constructor
@@ -125,6 +163,12 @@ protected:
      */
     Object();
 
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    /// copy the members like the implicit functions of the non-atomic count do, std::atomic isn't copyable
+    Object(const Object& other);
+    Object& operator=(const Object& other);
+#endif
+
 public:
     /**
      * Destructor
@@ -136,9 +180,17 @@ public:
 
 protected:
     /// count of references
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    std::atomic<unsigned int> _referenceCount;
+#else
     unsigned int _referenceCount;
+#endif
+
+    /// created by an ObjectArena, destroyed in place
+    bool _arenaAllocated;
 
     friend class AutoreleasePool;
+    friend class ObjectArena;
 
 #if AX_ENABLE_SCRIPT_BINDING
 public:
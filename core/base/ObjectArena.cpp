@@ -0,0 +1,227 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/ObjectArena.h"
+#include "base/Allocator.h"
+#include "base/Macros.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+// the blocks start with their Block, the objects follow their Header
+static constexpr size_t alignSize(size_t size)
+{
+    return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+
+ObjectArena* ObjectArena::s_sharedArena = nullptr;
+uint32_t ObjectArena::s_generation      = 0;
+bool ObjectArena::_statsEnabled         = false;
+
+ObjectArena* ObjectArena::getInstance()
+{
+    if (s_sharedArena == nullptr)
+        s_sharedArena = new ObjectArena();
+    return s_sharedArena;
+}
+
+void ObjectArena::destroyInstance()
+{
+    delete s_sharedArena;
+    s_sharedArena = nullptr;
+}
+
+ObjectArena::ObjectArena() : _generation(++s_generation) {}
+
+ObjectArena::~ObjectArena()
+{
+    drain();
+
+    // the blocks still holding retained objects are freed by the release of their last object
+    if (_current && _current->liveObjects == 0)
+        freeBlock(_current);
+    _current = nullptr;
+    purge();
+}
+
+// the blocks are accounted to MemoryTag::OBJECT like the Objects on the heap
+static void* allocateBlock(size_t size)
+{
+    if (auto ptr = Memory::allocate(size, MemoryTag::OBJECT))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+ObjectArena::Header* ObjectArena::allocate(size_t size)
+{
+    const size_t slotSize = sizeof(Header) + alignSize(size);
+
+    Block* block;
+    if (alignSize(sizeof(Block)) + slotSize > BLOCK_SIZE)
+    {
+        // dedicated block, never current
+        block = static_cast<Block*>(allocateBlock(alignSize(sizeof(Block)) + slotSize));
+        *block = Block{_generation, nullptr, alignSize(sizeof(Block)) + slotSize, alignSize(sizeof(Block)), 0};
+        _capacity += block->size;
+        ++_heapAllocations;
+    }
+    else
+    {
+        // the previous current block is recycled by the release of its last object
+        if (!_current || _current->offset + slotSize > _current->size)
+            _current = acquireBlock();
+        block = _current;
+    }
+
+    auto header   = reinterpret_cast<Header*>(reinterpret_cast<uint8_t*>(block) + block->offset);
+    header->block = block;
+    block->offset += slotSize;
+    ++block->liveObjects;
+    ++_liveObjects;
+    return header;
+}
+
+void ObjectArena::link(Header* header, Object* obj)
+{
+    header->object = obj;
+    header->next   = nullptr;
+    if (_lastPending)
+        _lastPending->next = header;
+    else
+        _pending = header;
+    _lastPending = header;
+}
+
+ObjectArena::Block* ObjectArena::acquireBlock()
+{
+    Block* block = _freeList;
+    if (block)
+        _freeList = block->next;
+    else
+    {
+        block = static_cast<Block*>(allocateBlock(BLOCK_SIZE));
+        _capacity += BLOCK_SIZE;
+        ++_heapAllocations;
+    }
+    *block = Block{_generation, nullptr, BLOCK_SIZE, alignSize(sizeof(Block)), 0};
+    return block;
+}
+
+void ObjectArena::recycle(Block* block)
+{
+    if (block->size != BLOCK_SIZE)
+        freeBlock(block);
+    else if (block == _current)
+        block->offset = alignSize(sizeof(Block));
+    else
+    {
+        block->next = _freeList;
+        _freeList   = block;
+    }
+}
+
+void ObjectArena::freeBlock(Block* block)
+{
+    _capacity -= block->size;
+    Memory::deallocate(block, block->size, MemoryTag::OBJECT);
+}
+
+void ObjectArena::destroy(Object* obj)
+{
+    // the most derived object starts right after its header
+    auto header = static_cast<Header*>(dynamic_cast<void*>(obj)) - 1;
+    auto block  = header->block;
+
+    obj->~Object();
+
+    auto arena = s_sharedArena;
+    if (arena && arena->_generation == block->generation)
+    {
+        --arena->_liveObjects;
+        if (--block->liveObjects == 0)
+            arena->recycle(block);
+    }
+    else if (--block->liveObjects == 0)
+        Memory::deallocate(block, block->size, MemoryTag::OBJECT);
+}
+
+void ObjectArena::drain()
+{
+    // an object released here may recycle the block of its header, but not the blocks of the next pending ones
+    auto header = _pending;
+    _pending = _lastPending = nullptr;
+    while (header)
+    {
+        auto next = header->next;
+        header->object->release();
+        header = next;
+    }
+
+    if (!_statsEnabled)
+        return;
+
+    _lastFrameCreations.clear();
+    for (auto&& [type, stats] : _creations)
+    {
+        if (stats.autoreleased + stats.arena == 0)
+            continue;
+        _lastFrameCreations.emplace_back(stats);
+        stats.autoreleased = stats.arena = 0;
+    }
+    std::sort(_lastFrameCreations.begin(), _lastFrameCreations.end(),
+              [](const CreationStats& a, const CreationStats& b) {
+                  return a.autoreleased + a.arena > b.autoreleased + b.arena;
+              });
+}
+
+void ObjectArena::purge()
+{
+    while (_freeList)
+    {
+        auto block = _freeList;
+        _freeList  = block->next;
+        freeBlock(block);
+    }
+}
+
+void ObjectArena::setCreationStatsEnabled(bool enabled)
+{
+    _statsEnabled = enabled;
+    _creations.clear();
+    _lastFrameCreations.clear();
+}
+
+void ObjectArena::recordCreation(const std::type_info& type, bool autoreleased)
+{
+    auto& stats = _creations[type];
+    if (stats.typeName.empty())
+        stats.typeName = type.name();
+    if (autoreleased)
+        ++stats.autoreleased;
+    else
+        ++stats.arena;
+}
+
+}  // namespace ax
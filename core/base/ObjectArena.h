@@ -0,0 +1,170 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/Object.h"
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+namespace ax
+{
+
+/**
+ Frame arena for transient Objects.
+ `create` constructs an Object in a bump allocated block instead of the heap, the arena owns the first reference
+ like an autorelease pool and `drain`, called by the Director after the autorelease pool is cleared, releases all
+ the objects created since the previous drain with one walk over an intrusive list, without a vector of pointers.
+ An object retained past the frame stays alive and is destroyed in place by its last `release`, its block is reused
+ once all its objects are gone, so a long lived object pins its block, keep the arena for objects which die within
+ a frame or two. The arena is used from the axmol thread only.
+
+ The arena also keeps the per-frame creation stats of `setCreationStatsEnabled`, the objects autoreleased and the
+ objects created in the arena, by type.
+*/
+class AX_DLL ObjectArena
+{
+public:
+    /**The size of one block, objects bigger than it get a dedicated block.*/
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    /**The objects of one type created during a frame.*/
+    struct CreationStats
+    {
+        std::string typeName;
+        size_t autoreleased = 0;
+        size_t arena        = 0;
+    };
+
+    static ObjectArena* getInstance();
+    static void destroyInstance();
+
+    ObjectArena(const ObjectArena&)            = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    /**Construct an Object in the arena with a reference count of 1, it's released by the next `drain`.*/
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<Object, T>, "ObjectArena only creates Objects");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over aligned types are not supported");
+
+        auto header          = allocate(sizeof(T));
+        auto obj             = new (header + 1) T(std::forward<Args>(args)...);
+        obj->_arenaAllocated = true;
+        link(header, obj);
+        if (_statsEnabled)
+            recordCreation(typeid(T), false);
+        return obj;
+    }
+
+    /**Release the objects created since the previous drain and start the creation stats of a new frame.*/
+    void drain();
+
+    /**The objects created by the arena and not destroyed yet.*/
+    size_t getLiveObjects() const { return _liveObjects; }
+
+    /**The number of blocks allocated since the last `clearHeapAllocations`.*/
+    size_t getHeapAllocations() const { return _heapAllocations; }
+    void clearHeapAllocations() { _heapAllocations = 0; }
+
+    /**The bytes of all blocks owned by the arena.*/
+    size_t getCapacity() const { return _capacity; }
+
+    /**Release the memory of the unused blocks.*/
+    void purge();
+
+    /**Enables the creation stats, it costs a hash lookup by autoreleased object.*/
+    void setCreationStatsEnabled(bool enabled);
+    static bool isCreationStatsEnabled() { return _statsEnabled; }
+
+    /**The creation stats of the last drained frame, the most created types first.*/
+    const std::vector<CreationStats>& getLastFrameCreations() const { return _lastFrameCreations; }
+
+    /**Counts an object creation of the current frame, Object::autorelease counts the autoreleased ones.*/
+    void recordCreation(const std::type_info& type, bool autoreleased);
+
+    /**Destroys an object of the arena in place, called by Object::release.*/
+    static void destroy(Object* obj);
+
+private:
+    struct Block
+    {
+        uint32_t generation;  // of the arena which allocated it
+        Block* next;          // in the free list
+        size_t size;
+        size_t offset;
+        size_t liveObjects;
+    };
+
+    struct alignas(std::max_align_t) Header
+    {
+        Block* block;
+        Object* object;
+        Header* next;
+    };
+
+    ObjectArena();
+    ~ObjectArena();
+
+    Header* allocate(size_t size);
+    void link(Header* header, Object* obj);
+    Block* acquireBlock();
+    void recycle(Block* block);
+    void freeBlock(Block* block);
+
+    static bool _statsEnabled;
+
+    static ObjectArena* s_sharedArena;
+    static uint32_t s_generation;
+
+    uint32_t _generation = 0;
+    Block* _current      = nullptr;
+    Block* _freeList     = nullptr;
+    Header* _pending     = nullptr;
+    Header* _lastPending = nullptr;
+
+    size_t _liveObjects     = 0;
+    size_t _heapAllocations = 0;
+    size_t _capacity        = 0;
+
+    std::unordered_map<std::type_index, CreationStats> _creations;
+    std::vector<CreationStats> _lastFrameCreations;
+};
+
+}  // namespace ax
+
+/**
+ end of base group
+ @}
+ */
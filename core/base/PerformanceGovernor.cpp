@@ -0,0 +1,258 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/PerformanceGovernor.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventCustom.h"
+#include "base/EventListenerCustom.h"
+#include "2d/ParticleSystem.h"
+#include "renderer/DynamicResolution.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+const char* PerformanceGovernor::EVENT_LEVEL_CHANGED = "performance_governor_level_changed";
+
+static PerformanceGovernor* s_sharedGovernor = nullptr;
+
+// the thermal headroom where the device is throttled is 1.0, step down before reaching it
+static constexpr float HEADROOM_REDUCED = 0.75f;
+static constexpr float HEADROOM_LOW     = 0.9f;
+// the seconds ahead the thermal headroom is forecast
+static constexpr int HEADROOM_FORECAST = 10;
+
+PerformanceGovernor* PerformanceGovernor::getInstance()
+{
+    if (!s_sharedGovernor)
+        s_sharedGovernor = new PerformanceGovernor();
+    return s_sharedGovernor;
+}
+
+void PerformanceGovernor::destroyInstance()
+{
+    delete s_sharedGovernor;
+    s_sharedGovernor = nullptr;
+}
+
+PerformanceGovernor::PerformanceGovernor() {}
+
+PerformanceGovernor::~PerformanceGovernor()
+{
+    setEnabled(false);
+    setDynamicResolution(nullptr);
+}
+
+void PerformanceGovernor::setEnabled(bool enabled)
+{
+    if (_enabled == enabled)
+        return;
+
+    _enabled             = enabled;
+    auto director        = Director::getInstance();
+    auto eventDispatcher = director->getEventDispatcher();
+    if (enabled)
+    {
+        _animationInterval  = director->getAnimationInterval();
+        _targetWorkDuration = 0;
+        _recoveryTime       = 0.0f;
+        _frameStart = _lastPoll = std::chrono::steady_clock::now();
+
+        _beforeUpdateListener =
+            eventDispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) {
+            onFrameBegin();
+        });
+        _afterDrawListener =
+            eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) {
+            onFrameEnd();
+        });
+        poll();
+    }
+    else
+    {
+        eventDispatcher->removeEventListener(_beforeUpdateListener);
+        eventDispatcher->removeEventListener(_afterDrawListener);
+        _beforeUpdateListener = nullptr;
+        _afterDrawListener    = nullptr;
+
+        if (_level != Level::NORMAL)
+        {
+            _level = Level::NORMAL;
+            applyLevel();
+        }
+    }
+}
+
+void PerformanceGovernor::setFrameRate(Level level, float framesPerSecond)
+{
+    _frameRates[(size_t)level] = framesPerSecond;
+    if (_enabled && level == _level)
+        applyLevel();
+}
+
+void PerformanceGovernor::setParticleFactor(Level level, float factor)
+{
+    _particleFactors[(size_t)level] = factor;
+    if (_enabled && level == _level)
+        applyLevel();
+}
+
+void PerformanceGovernor::setResolutionFactor(Level level, float factor)
+{
+    _resolutionFactors[(size_t)level] = factor;
+    if (_enabled && level == _level)
+        applyLevel();
+}
+
+void PerformanceGovernor::setDynamicResolution(DynamicResolution* dynamicResolution)
+{
+    if (_dynamicResolution)
+        _dynamicResolution->setScaleRange(_minResolutionScale, _maxResolutionScale);
+
+    AX_SAFE_RETAIN(dynamicResolution);
+    AX_SAFE_RELEASE(_dynamicResolution);
+    _dynamicResolution = dynamicResolution;
+    if (dynamicResolution)
+    {
+        _minResolutionScale = dynamicResolution->getMinScale();
+        _maxResolutionScale = dynamicResolution->getMaxScale();
+        if (_enabled)
+            applyLevel();
+    }
+}
+
+PerformanceGovernor::Level PerformanceGovernor::evaluate(Device::ThermalState thermalState,
+                                                         float thermalHeadroom,
+                                                         float batteryLevel,
+                                                         bool powerSaveMode)
+{
+    // NOMINAL to CRITICAL map to NORMAL to MINIMUM
+    Level level = static_cast<Level>(thermalState);
+
+    // the forecast headroom tells the throttling ahead of the thermal state
+    if (thermalHeadroom >= HEADROOM_LOW)
+        level = std::max(level, Level::LOW);
+    else if (thermalHeadroom >= HEADROOM_REDUCED)
+        level = std::max(level, Level::REDUCED);
+
+    if (powerSaveMode || (batteryLevel >= 0.0f && batteryLevel < LOW_BATTERY))
+        level = std::max(level, Level::REDUCED);
+
+    return level;
+}
+
+bool PerformanceGovernor::step(Level level, float elapsed)
+{
+    if (level > _level)
+    {
+        _level        = level;
+        _recoveryTime = 0.0f;
+        return true;
+    }
+
+    if (level == _level)
+    {
+        _recoveryTime = 0.0f;
+        return false;
+    }
+
+    _recoveryTime += elapsed;
+    if (_recoveryTime < RECOVERY_TIME)
+        return false;
+
+    _level        = static_cast<Level>(static_cast<int>(_level) - 1);
+    _recoveryTime = 0.0f;
+    return true;
+}
+
+void PerformanceGovernor::onFrameBegin()
+{
+    _frameStart = std::chrono::steady_clock::now();
+}
+
+void PerformanceGovernor::onFrameEnd()
+{
+    using namespace std::chrono;
+    auto now = steady_clock::now();
+
+    // the frame budget follows the animation interval, which the governor may cap
+    auto targetWorkDuration =
+        static_cast<int64_t>(Director::getInstance()->getAnimationInterval() * 1000000000.0);
+    if (targetWorkDuration != _targetWorkDuration)
+    {
+        _targetWorkDuration = targetWorkDuration;
+        Device::setTargetWorkDuration(targetWorkDuration);
+    }
+    Device::reportActualWorkDuration(duration_cast<nanoseconds>(now - _frameStart).count());
+
+    if (duration<float>(now - _lastPoll).count() >= POLL_INTERVAL)
+        poll();
+}
+
+void PerformanceGovernor::poll()
+{
+    auto now      = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float>(now - _lastPoll).count();
+    _lastPoll     = now;
+
+    _thermalState    = Device::getThermalState();
+    _thermalHeadroom = Device::getThermalHeadroom(HEADROOM_FORECAST);
+    _batteryLevel    = Device::getBatteryLevel();
+    _powerSaveMode   = Device::isPowerSaveMode();
+
+    const Level previous = _level;
+    if (!step(evaluate(_thermalState, _thermalHeadroom, _batteryLevel, _powerSaveMode), elapsed))
+        return;
+
+    if (previous == Level::NORMAL)
+        _animationInterval = Director::getInstance()->getAnimationInterval();
+    applyLevel();
+
+    Level level = _level;
+    Director::getInstance()->getEventDispatcher()->dispatchCustomEvent(EVENT_LEVEL_CHANGED, &level);
+}
+
+void PerformanceGovernor::applyLevel()
+{
+    const size_t index = static_cast<size_t>(_level);
+
+    auto director   = Director::getInstance();
+    float interval  = _animationInterval;
+    const float cap = _frameRates[index];
+    if (cap > 0.0f)
+        interval = std::max(interval, 1.0f / cap);
+    if (director->getAnimationInterval() != interval)
+        director->setAnimationInterval(interval);
+
+    ParticleSystem::setTotalParticleCountFactor(_particleFactors[index]);
+
+    if (_dynamicResolution)
+    {
+        const float maxScale = std::max(_maxResolutionScale * _resolutionFactors[index], 0.1f);
+        _dynamicResolution->setScaleRange(std::min(_minResolutionScale, maxScale), maxScale);
+    }
+}
+
+}  // namespace ax
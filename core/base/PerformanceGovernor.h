@@ -0,0 +1,170 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "platform/Device.h"
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+namespace ax
+{
+
+class DynamicResolution;
+class EventListenerCustom;
+
+/**
+ Steps the rendering load down before the OS throttles the device hard, and back up once it cooled down.
+ Once enabled, the governor polls the thermal state, the thermal headroom and the battery of the `Device` every
+ second, and evaluates a performance level from them. Each level has a frame rate cap, a factor of the particle
+ budget of the ParticleSystems and a factor of the resolution of a `DynamicResolution`, and a change of level
+ dispatches `EVENT_LEVEL_CHANGED` for the game to adjust its own settings.
+
+ A worse level is applied right away, a better one only after it lasted `RECOVERY_TIME`, one level at a time.
+ The governor also reports the work duration of each frame to the performance hints of the OS (ADPF on Android),
+ so the CPU clocks follow the frame load.
+*/
+class AX_DLL PerformanceGovernor
+{
+public:
+    enum class Level
+    {
+        NORMAL,
+        REDUCED,
+        LOW,
+        MINIMUM,
+        COUNT
+    };
+
+    /** Dispatched when the level changed, the user data of the EventCustom is the new Level. */
+    static const char* EVENT_LEVEL_CHANGED;
+
+    /** The seconds between two polls of the device state. */
+    static constexpr float POLL_INTERVAL = 1.0f;
+    /** The seconds a better level has to last before the governor steps up. */
+    static constexpr float RECOVERY_TIME = 10.0f;
+    /** The battery level below which the level is at least REDUCED. */
+    static constexpr float LOW_BATTERY = 0.15f;
+
+    static PerformanceGovernor* getInstance();
+    static void destroyInstance();
+
+    PerformanceGovernor(const PerformanceGovernor&)            = delete;
+    PerformanceGovernor& operator=(const PerformanceGovernor&) = delete;
+
+    /** Starts or stops the governor, stopping it restores the settings of the NORMAL level. */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    Level getLevel() const { return _level; }
+
+    /** The device state of the last poll. */
+    Device::ThermalState getThermalState() const { return _thermalState; }
+    float getThermalHeadroom() const { return _thermalHeadroom; }
+    float getBatteryLevel() const { return _batteryLevel; }
+    bool isPowerSaveMode() const { return _powerSaveMode; }
+
+    /**
+     * The frame rate cap of a level, 0 keeps the animation interval set by the application.
+     * By default NORMAL and REDUCED keep it, LOW caps at 45 and MINIMUM at 30 frames per second.
+     */
+    void setFrameRate(Level level, float framesPerSecond);
+    float getFrameRate(Level level) const { return _frameRates[(size_t)level]; }
+
+    /** The factor of the total particles of the ParticleSystems at a level, 1, 0.75, 0.5 and 0.25 by default. */
+    void setParticleFactor(Level level, float factor);
+    float getParticleFactor(Level level) const { return _particleFactors[(size_t)level]; }
+
+    /**
+     * The factor of the largest scale of the DynamicResolution at a level, 1, 0.85, 0.7 and 0.5 by default.
+     * @see setDynamicResolution
+     */
+    void setResolutionFactor(Level level, float factor);
+    float getResolutionFactor(Level level) const { return _resolutionFactors[(size_t)level]; }
+
+    /** The dynamic resolution to limit, its scale range at the time is the one of the NORMAL level. */
+    void setDynamicResolution(DynamicResolution* dynamicResolution);
+    DynamicResolution* getDynamicResolution() const { return _dynamicResolution; }
+
+    /** The level for a device state, the worst of the levels of each reading. */
+    static Level evaluate(Device::ThermalState thermalState,
+                          float thermalHeadroom,
+                          float batteryLevel,
+                          bool powerSaveMode);
+
+    /**
+     * Moves the level toward the evaluated one, called on each poll.
+     * @param level The evaluated level.
+     * @param elapsed The seconds since the previous step.
+     * @return true if the level changed.
+     */
+    bool step(Level level, float elapsed);
+
+protected:
+    PerformanceGovernor();
+    ~PerformanceGovernor();
+
+    void onFrameBegin();
+    void onFrameEnd();
+    void poll();
+    void applyLevel();
+
+    bool _enabled       = false;
+    Level _level        = Level::NORMAL;
+    float _recoveryTime = 0.0f;
+
+    Device::ThermalState _thermalState = Device::ThermalState::NOMINAL;
+    float _thermalHeadroom             = -1.0f;
+    float _batteryLevel                = -1.0f;
+    bool _powerSaveMode                = false;
+
+    std::array<float, (size_t)Level::COUNT> _frameRates{0.0f, 0.0f, 45.0f, 30.0f};
+    std::array<float, (size_t)Level::COUNT> _particleFactors{1.0f, 0.75f, 0.5f, 0.25f};
+    std::array<float, (size_t)Level::COUNT> _resolutionFactors{1.0f, 0.85f, 0.7f, 0.5f};
+
+    // the settings of the application, restored at the NORMAL level
+    float _animationInterval              = 0.0f;
+    DynamicResolution* _dynamicResolution = nullptr;
+    float _minResolutionScale             = 0.5f;
+    float _maxResolutionScale             = 1.0f;
+
+    std::chrono::steady_clock::time_point _frameStart;
+    std::chrono::steady_clock::time_point _lastPoll;
+    int64_t _targetWorkDuration = 0;
+
+    EventListenerCustom* _beforeUpdateListener = nullptr;
+    EventListenerCustom* _afterDrawListener    = nullptr;
+};
+
+}  // namespace ax
+
+/**
+ end of base group
+ @}
+ */
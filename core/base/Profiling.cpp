@@ -26,144 +26,151 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "base/Profiling.h"
+#include "platform/FileUtils.h"
 
-using namespace std;
+#include "fmt/format.h"
 
 namespace ax
 {
 
-// Profiling Categories
-/* set to false the categories that you don't want to profile */
-bool kProfilerCategorySprite      = false;
-bool kProfilerCategoryBatchSprite = false;
-bool kProfilerCategoryParticles   = false;
+std::atomic<bool> Tracer::s_recording{false};
 
-static Profiler* g_sSharedProfiler = nullptr;
-
-Profiler* Profiler::getInstance()
+namespace
+{
+void appendJsonString(std::string& out, std::string_view str)
 {
-    if (!g_sSharedProfiler)
+    out += '"';
+    for (auto c : str)
     {
-        g_sSharedProfiler = new Profiler();
-        g_sSharedProfiler->init();
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            out += c;
     }
-
-    return g_sSharedProfiler;
+    out += '"';
 }
+}  // namespace
 
-ProfilingTimer* Profiler::createAndAddTimerWithName(const char* timerName)
+Tracer* Tracer::getInstance()
 {
-    ProfilingTimer* t = new ProfilingTimer();
-    t->initWithName(timerName);
-    _activeTimers.insert(timerName, t);
-    t->release();
-
-    return t;
+    // never destroyed, the threads keep a pointer to their buffer
+    static Tracer* s_tracer = new Tracer();
+    return s_tracer;
 }
 
-void Profiler::releaseTimer(const char* timerName)
+Tracer::Tracer() : _epoch(std::chrono::steady_clock::now()) {}
+
+void Tracer::start()
 {
-    _activeTimers.erase(timerName);
+    clear();
+    s_recording.store(true, std::memory_order_relaxed);
 }
 
-void Profiler::releaseAllTimers()
+void Tracer::stop()
 {
-    _activeTimers.clear();
+    s_recording.store(false, std::memory_order_relaxed);
 }
 
-bool Profiler::init()
+void Tracer::clear()
 {
-    return true;
+    std::lock_guard<std::mutex> lck(_mutex);
+    for (auto&& buffer : _buffers)
+        buffer->written.store(0, std::memory_order_release);
 }
 
-Profiler::~Profiler() {}
-
-void Profiler::displayTimers()
+Tracer::ThreadBuffer* Tracer::getThreadBuffer()
 {
-    for (auto&& iter : _activeTimers)
+    thread_local ThreadBuffer* s_buffer = nullptr;
+    if (!s_buffer)
     {
-        ProfilingTimer* timer = iter.second;
-        AXLOGI("{}", timer->getDescription());
+        std::lock_guard<std::mutex> lck(_mutex);
+        auto& buffer = _buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer->tid  = static_cast<int>(_buffers.size());
+        s_buffer     = buffer.get();
     }
+    return s_buffer;
 }
 
-// implementation of ProfilingTimer
-
-ProfilingTimer::ProfilingTimer()
-    : _averageTime1(0), _averageTime2(0), minTime(100000000), maxTime(0), totalTime(0), numberOfCalls(0)
-{}
-
-bool ProfilingTimer::initWithName(const char* timerName)
+void Tracer::setThreadName(std::string_view name)
 {
-    _nameStr = timerName;
-    return true;
+    auto buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lck(_mutex);
+    buffer->name = name;
 }
 
-ProfilingTimer::~ProfilingTimer() {}
-
-std::string ProfilingTimer::getDescription() const
+void Tracer::addEvent(const char* name, int64_t start, int64_t end)
 {
-    static char s_description[512] = {0};
+    auto buffer  = getThreadBuffer();
+    auto written = buffer->written.load(std::memory_order_relaxed);
 
-    snprintf(s_description, sizeof(s_description), "%s ::\tavg1: %u,\tavg2: %u,\tmin: %u,\tmax: %u,\ttotal: %.2fs,\tnr calls: %d",
-            _nameStr.c_str(), _averageTime1, _averageTime2, minTime, maxTime, totalTime / 1000000., numberOfCalls);
-    return s_description;
+    buffer->events[written % EVENTS_PER_THREAD] = Event{name, start, end - start, 0.0};
+    // publish the event, toChromeTrace reads the slots below the count
+    buffer->written.store(written + 1, std::memory_order_release);
 }
 
-void ProfilingTimer::reset()
+void Tracer::addCounter(const char* name, double milliseconds)
 {
-    numberOfCalls = 0;
-    _averageTime1 = 0;
-    _averageTime2 = 0;
-    totalTime     = 0;
-    minTime       = 100000000;
-    maxTime       = 0;
-    _startTime    = chrono::high_resolution_clock::now();
+    auto buffer  = getThreadBuffer();
+    auto written = buffer->written.load(std::memory_order_relaxed);
+
+    buffer->events[written % EVENTS_PER_THREAD] = Event{name, now(), -1, milliseconds};
+    buffer->written.store(written + 1, std::memory_order_release);
 }
 
-void ProfilingBeginTimingBlock(const char* timerName)
+std::string Tracer::toChromeTrace()
 {
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
-    if (!timer)
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first       = true;
+    auto separate    = [&json, &first] {
+        if (!first)
+            json += ',';
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lck(_mutex);
+    std::vector<Event> events;
+    for (auto&& buffer : _buffers)
     {
-        timer = p->createAndAddTimerWithName(timerName);
+        if (!buffer->name.empty())
+        {
+            separate();
+            json += fmt::format("{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":",
+                                buffer->tid);
+            appendJsonString(json, buffer->name);
+            json += "}}";
+        }
+
+        // copy first, then drop the slots the owning thread overwrote meanwhile
+        auto written = buffer->written.load(std::memory_order_acquire);
+        auto begin   = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (auto i = begin; i < written; ++i)
+            events.emplace_back(buffer->events[i % EVENTS_PER_THREAD]);
+
+        // while recording the slot of the next event may be half written
+        auto rewritten = buffer->written.load(std::memory_order_acquire) + (isRecording() ? 1 : 0);
+        auto valid     = rewritten > EVENTS_PER_THREAD ? rewritten - EVENTS_PER_THREAD : 0;
+        for (auto i = (std::max)(begin, valid); i < written; ++i)
+        {
+            auto& event = events[i - begin];
+            separate();
+            json += event.duration < 0 ? "{\"ph\":\"C\",\"name\":" : "{\"ph\":\"X\",\"name\":";
+            appendJsonString(json, event.name);
+            if (event.duration < 0)
+                json += fmt::format(",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"ms\":{:.3f}}}}}", buffer->tid,
+                                    event.start / 1000.0, event.value);
+            else
+                json += fmt::format(",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", buffer->tid,
+                                    event.start / 1000.0, event.duration / 1000.0);
+        }
     }
-
-    timer->numberOfCalls++;
-
-    // should be the last instruction in order to be more reliable
-    timer->_startTime = chrono::high_resolution_clock::now();
+    json += "]}";
+    return json;
 }
 
-void ProfilingEndTimingBlock(const char* timerName)
+bool Tracer::saveChromeTrace(std::string_view path)
 {
-    // should be the 1st instruction in order to be more reliable
-    auto now = chrono::high_resolution_clock::now();
-
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
-
-    AXASSERT(timer, "CCProfilingTimer  not found");
-
-    int32_t duration =
-        static_cast<int32_t>(chrono::duration_cast<chrono::microseconds>(now - timer->_startTime).count());
-
-    timer->totalTime += duration;
-    timer->_averageTime1 = (timer->_averageTime1 + duration) / 2.0f;
-    timer->_averageTime2 = timer->totalTime / timer->numberOfCalls;
-    timer->maxTime       = MAX(timer->maxTime, duration);
-    timer->minTime       = MIN(timer->minTime, duration);
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), path);
 }
 
-void ProfilingResetTimingBlock(const char* timerName)
-{
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
-
-    AXASSERT(timer, "CCProfilingTimer not found");
-
-    timer->reset();
-}
-
-}
+}  // namespace ax
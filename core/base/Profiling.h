@@ -26,139 +26,143 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 
-#ifndef __SUPPORT_CCPROFILING_H__
-#define __SUPPORT_CCPROFILING_H__
-/// @cond DO_NOT_SHOW
+#pragma once
 
-#include <string>
+#include <atomic>
 #include <chrono>
-#include "base/Config.h"
-#include "base/Object.h"
-#include "base/Map.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
-namespace ax
-{
+#include "base/Config.h"
+#include "platform/PlatformMacros.h"
 
 /**
- * @addtogroup global
+ * @addtogroup base
  * @{
  */
 
-class ProfilingTimer;
-
-/** Profiler
- cocos2d builtin profiler.
+namespace ax
+{
 
- To use it, enable set the AX_ENABLE_PROFILERS=1 in the ccConfig.h file
- */
+/**
+ Records scoped trace markers of the engine threads, to export them as Chrome trace JSON which chrome://tracing and
+ ui.perfetto.dev load. Each thread writes into its own ring buffer without locking, only the newest
+ `EVENTS_PER_THREAD` events of a thread are kept. When not recording a marker costs one atomic load.
 
-class AX_DLL Profiler
+ Markers are added with `AX_TRACE_SCOPE("name")`, the name must be a string literal.
+*/
+class AX_DLL Tracer
 {
 public:
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ~Profiler();
-    /** display the timers
-     * @js NA
-     * @lua NA
-     */
-    void displayTimers();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    bool init();
+    /** The ring buffer capacity of each thread. */
+    static constexpr size_t EVENTS_PER_THREAD = 16 * 1024;
 
-public:
-    /** returns the singleton
-     * @js NA
-     * @lua NA
-     */
-    static Profiler* getInstance();
+    static Tracer* getInstance();
 
-    /** Creates and adds a new timer
-     * @js NA
-     * @lua NA
-     */
-    ProfilingTimer* createAndAddTimerWithName(const char* timerName);
-    /** releases a timer
-     * @js NA
-     * @lua NA
-     */
-    void releaseTimer(const char* timerName);
-    /** releases all timers
-     * @js NA
-     * @lua NA
-     */
-    void releaseAllTimers();
+    /** Start recording, the events recorded before are dropped. */
+    void start();
+    void stop();
+    static bool isRecording() { return s_recording.load(std::memory_order_relaxed); }
 
-    Map<std::string, ProfilingTimer*> _activeTimers;
-};
+    /** Drop the recorded events. */
+    void clear();
+
+    /** Name the calling thread in the exported trace. */
+    void setThreadName(std::string_view name);
 
-class ProfilingTimer : public Object
-{
-public:
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ProfilingTimer();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ~ProfilingTimer();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    bool initWithName(const char* timerName);
-    /**
-     * @js NA
-     * @lua NA
-     */
-    virtual std::string getDescription() const;
     /**
-     * @js NA
-     * @lua NA
+     * Export the recorded events in the Chrome trace event format, can be invoked while recording.
+     * @return The JSON document.
      */
-    const std::chrono::high_resolution_clock::time_point& getStartTime() { return _startTime; }
+    std::string toChromeTrace();
 
-    /** resets the timer properties
-     * @js NA
-     * @lua NA
-     */
-    void reset();
-
-    std::string _nameStr;
-    std::chrono::high_resolution_clock::time_point _startTime;
-    int32_t _averageTime1;
-    int32_t _averageTime2;
-    int32_t minTime;
-    int32_t maxTime;
-    int32_t totalTime;
-    int32_t numberOfCalls;
-};
+    /** Write `toChromeTrace` to a file, return false if the file can't be written. */
+    bool saveChromeTrace(std::string_view path);
 
-extern void AX_DLL ProfilingBeginTimingBlock(const char* timerName);
-extern void AX_DLL ProfilingEndTimingBlock(const char* timerName);
-extern void AX_DLL ProfilingResetTimingBlock(const char* timerName);
+    /** A timestamp in nanoseconds since the tracer creation. */
+    int64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch)
+            .count();
+    }
 
-/*
- * cocos2d profiling categories
- * used to enable / disable profilers with granularity
- */
+    /** Add a complete event to the buffer of the calling thread, see TraceScope. */
+    void addEvent(const char* name, int64_t start, int64_t end);
 
-extern bool kProfilerCategorySprite;
-extern bool kProfilerCategoryBatchSprite;
-extern bool kProfilerCategoryParticles;
+    /**
+     * Add a sample of a counter in milliseconds, shown as a graph by the trace viewers. The name must be a string
+     * literal. The renderer adds its frame timings while its profiling is enabled.
+     */
+    void addCounter(const char* name, double milliseconds);
+
+private:
+    struct Event
+    {
+        const char* name;
+        int64_t start;
+        int64_t duration;  // -1 for a counter
+        double value;      // the counter value
+    };
+
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events{new Event[EVENTS_PER_THREAD]};
+        // the number of events written, the slot of an event is its index modulo the capacity
+        std::atomic<uint64_t> written{0};
+        std::string name;
+        int tid = 0;
+    };
+
+    Tracer();
+    ThreadBuffer* getThreadBuffer();
+
+    static std::atomic<bool> s_recording;
+
+    std::chrono::steady_clock::time_point _epoch;
+    std::mutex _mutex;  // guards the buffer list and the thread names
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+};
 
-// end of global group
-/// @}
+/** Adds a complete event to the Tracer from its construction to its destruction. */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) : _name(Tracer::isRecording() ? name : nullptr)
+    {
+        if (_name)
+            _start = Tracer::getInstance()->now();
+    }
+    ~TraceScope()
+    {
+        if (_name)
+        {
+            auto tracer = Tracer::getInstance();
+            tracer->addEvent(_name, _start, tracer->now());
+        }
+    }
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;
+    int64_t _start = 0;
+};
+
+}  // namespace ax
 
-}
+#if AX_ENABLE_TRACE
+#    define AX_TRACE_CONCAT_(a, b) a##b
+#    define AX_TRACE_CONCAT(a, b)  AX_TRACE_CONCAT_(a, b)
+#    define AX_TRACE_SCOPE(name)   ax::TraceScope AX_TRACE_CONCAT(_axTraceScope, __LINE__)(name)
+#else
+#    define AX_TRACE_SCOPE(name) (void)0
+#endif
 
-/// @endcond
-#endif  // __SUPPORT_CCPROFILING_H__
+/**
+ end of base group
+ @}
+ */
@@ -28,9 +28,15 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "base/Scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
 #include "base/Macros.h"
 #include "base/Director.h"
+#include "base/JobSystem.h"
 #include "base/ScriptSupport.h"
+#include "base/Profiling.h"
 
 namespace ax
 {
@@ -58,6 +64,7 @@ void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float del
     _repeat        = repeat;
     _runForever    = (_repeat == AX_REPEAT_FOREVER) ? true : false;
     _timesExecuted = 0;
+    _armed         = false;
 }
 
 void Timer::update(float dt)
@@ -163,7 +170,7 @@ bool TimerTargetCallback::initWithCallback(Scheduler* scheduler,
     _scheduler = scheduler;
     _target    = target;
     _callback  = callback;
-    _key       = key;
+    _key       = InternedString(key);
     setupTimerWithInterval(seconds, repeat, delay);
     return true;
 }
@@ -178,7 +185,7 @@ void TimerTargetCallback::trigger(float dt)
 
 void TimerTargetCallback::cancel()
 {
-    _scheduler->unschedule(_key, _target);
+    _scheduler->unschedule(_key.view(), _target);
 }
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -208,8 +215,116 @@ void TimerScriptHandler::cancel() {}
 
 #endif
 
+// TimerList
+
+void TimerList::pushBack(Timer* timer)
+{
+    AXASSERT(!timer->_list, "the timer is already in a list");
+    timer->_list = this;
+    timer->_prev = _tail;
+    timer->_next = nullptr;
+    if (_tail)
+        _tail->_next = timer;
+    else
+        _head = timer;
+    _tail = timer;
+}
+
+void TimerList::remove(Timer* timer)
+{
+    AXASSERT(timer->_list == this, "the timer isn't in this list");
+    if (timer->_prev)
+        timer->_prev->_next = timer->_next;
+    else
+        _head = timer->_next;
+    if (timer->_next)
+        timer->_next->_prev = timer->_prev;
+    else
+        _tail = timer->_prev;
+    timer->_list = nullptr;
+    timer->_prev = timer->_next = nullptr;
+}
+
+// TimerWheel
+
+void TimerWheel::add(Timer* timer)
+{
+    // the timers due before the current tick wait in its slot, it is visited by the next advance
+    uint64_t tick        = (std::max)(toTick(timer->_deadline), _currentTick);
+    const uint64_t delta = tick - _currentTick;
+
+    TimerList* slot;
+    if (delta < ROOT_SIZE)
+        slot = &_root[tick & (ROOT_SIZE - 1)];
+    else if (delta < (uint64_t{1} << (ROOT_BITS + LEVEL_BITS)))
+        slot = &_levels[0][(tick >> ROOT_BITS) & (LEVEL_SIZE - 1)];
+    else if (delta < (uint64_t{1} << (ROOT_BITS + 2 * LEVEL_BITS)))
+        slot = &_levels[1][(tick >> (ROOT_BITS + LEVEL_BITS)) & (LEVEL_SIZE - 1)];
+    else
+    {
+        // farther than the wheel spans, it is placed again by the cascades until it fits
+        constexpr uint64_t maxDelta = (uint64_t{1} << (ROOT_BITS + 3 * LEVEL_BITS)) - 1;
+        if (delta > maxDelta)
+            tick = _currentTick + maxDelta;
+        slot = &_levels[2][(tick >> (ROOT_BITS + 2 * LEVEL_BITS)) & (LEVEL_SIZE - 1)];
+    }
+    slot->pushBack(timer);
+}
+
+void TimerWheel::cascade(int level, uint64_t index)
+{
+    auto& slot = _levels[level][index];
+    while (auto timer = slot.front())
+    {
+        slot.remove(timer);
+        add(timer);
+    }
+}
+
+void TimerWheel::advance(double now, std::vector<Timer*>& due)
+{
+    const uint64_t nowTick = toTick(now);
+    for (;;)
+    {
+        auto& slot = _root[_currentTick & (ROOT_SIZE - 1)];
+        for (auto timer = slot.front(); timer;)
+        {
+            auto next = timer->_next;
+            if (timer->_deadline <= now)
+            {
+                slot.remove(timer);
+                due.emplace_back(timer);
+            }
+            timer = next;
+        }
+
+        if (_currentTick >= nowTick)
+            break;
+
+        // entering a new span of the root, the matching slots of the upper levels move down
+        if ((++_currentTick & (ROOT_SIZE - 1)) == 0)
+        {
+            for (int level = 0; level < LEVELS; ++level)
+            {
+                const uint64_t index = (_currentTick >> (ROOT_BITS + level * LEVEL_BITS)) & (LEVEL_SIZE - 1);
+                cascade(level, index);
+                if (index != 0)
+                    break;
+            }
+        }
+    }
+}
+
 // implementation of Scheduler
 
+// the scheduler running its parallel phase on this thread, with the batch index of the callback being called
+struct ParallelSlot
+{
+    Scheduler* scheduler;
+    size_t index;
+};
+static thread_local ParallelSlot s_parallelSlot{nullptr, 0};
+
 // Priority level reserved for system services.
 const int Scheduler::PRIORITY_SYSTEM = INT_MIN;
 
@@ -218,15 +333,13 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler()
     : _timeScale(1.0f)
-    , _currentTarget(nullptr)
-    , _currentTargetSalvaged(false)
     , _indexMapLocked(false)
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
 #endif
 {
     // I don't expect to have more than 30 functions to all per frame
-    _actionsToPerform.reserve(30);
+    _carriedActions.reserve(30);
 }
 
 Scheduler::~Scheduler()
@@ -267,22 +380,27 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
     }
 
-    auto& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto& timers      = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
     }
     else
     {
-        auto timerIt = std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
+        InternedString internedKey(key);
+        auto timerIt = std::find_if(timers.begin(), timers.end(), [internedKey](Timer* const itimer) {
             TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(itimer);
-            return timer && !timer->isExhausted() && key == timer->getKey();
+            return timer && !timer->isExhausted() && internedKey == timer->getInternedKey();
         });
         if (timerIt != timers.end())
         {
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            auto timer = *timerIt;
+            unlinkTimer(timer, false);
+            timer->setupTimerWithInterval(interval, repeat, delay);
+            placeTimer(timerHandle, timer);
             return;
         }
     }
@@ -290,6 +408,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     TimerTargetCallback* timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     timers.pushBack(timer);
+    placeTimer(timerHandle, timer);
     timer->release();
 }
 
@@ -301,6 +420,11 @@ void Scheduler::unschedule(std::string_view key, void* target)
         return;
     }
 
+    // a key that was never interned was never scheduled
+    auto internedKey = InternedString::find(key);
+    if (internedKey.empty())
+        return;
+
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
@@ -309,34 +433,9 @@ void Scheduler::unschedule(std::string_view key, void* target)
         {
             TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(timerHandle.timers[i]);
 
-            if (timer && key == timer->getKey())
+            if (timer && internedKey == timer->getInternedKey())
             {
-                if (timer == timerHandle.currentTimer && (!timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
-                timerHandle.timers.erase(i);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
-                if (timerHandle.timers.empty())
-                {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
-                }
-
+                removeTimer(timerIt, i);
                 return;
             }
         }
@@ -451,11 +550,16 @@ bool Scheduler::isScheduled(std::string_view key, const void* target) const
     if (timerIt == _timersMap.end())
         return false;
 
-    auto&& timers    = timerIt->second.timers;
-    const bool found = !timers.empty() && std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
-                                              auto timer = dynamic_cast<TimerTargetCallback*>(itimer);
-                                              return (timer && !timer->isExhausted() && key == timer->getKey());
-                                          }) != timers.end();
+    auto internedKey = InternedString::find(key);
+    if (internedKey.empty())
+        return false;
+
+    auto&& timers = timerIt->second.timers;
+    const bool found =
+        !timers.empty() && std::find_if(timers.begin(), timers.end(), [internedKey](Timer* const itimer) {
+            auto timer = dynamic_cast<TimerTargetCallback*>(itimer);
+            return (timer && !timer->isExhausted() && internedKey == timer->getInternedKey());
+        }) != timers.end();
 
     return found;
 }
@@ -487,6 +591,57 @@ void Scheduler::unscheduleUpdate(void* target)
     }
 }
 
+void Scheduler::scheduleParallel(const ccSchedulerFunc& callback, void* target, bool paused)
+{
+    auto parallelIt = _parallelIndexMap.find(target);
+    if (parallelIt != _parallelIndexMap.end())
+    {
+        parallelIt->second->callback = callback;
+        return;
+    }
+
+    // the list isn't walked by the serial updates, so it is appended to even when they run
+    auto sched = new SchedHandle(&_parallelList, callback, target, 0, paused);
+    _parallelList.emplace_back(sched);
+    _parallelIndexMap.emplace(target, sched);
+}
+
+void Scheduler::unscheduleParallel(void* target)
+{
+    auto parallelIt = _parallelIndexMap.find(target);
+    if (parallelIt == _parallelIndexMap.end())
+        return;
+
+    auto sched = parallelIt->second;
+    if (!_indexMapLocked)
+    {
+        axstd::erase(_parallelList, sched);
+        delete sched;
+    }
+    else
+    {
+        sched->markedForDeletion = true;
+        _updateDeleteVector.emplace_back(sched);
+    }
+
+    _parallelIndexMap.erase(parallelIt);
+}
+
+bool Scheduler::isScheduledParallel(const void* target) const
+{
+    return _parallelIndexMap.find(const_cast<void*>(target)) != _parallelIndexMap.end();
+}
+
+void Scheduler::runAfterParallelUpdates(std::function<void()> function)
+{
+    // each batch index is only touched by the thread calling its callback
+    auto& slot = s_parallelSlot;
+    if (slot.scheduler == this)
+        _parallelDeferred[slot.index].emplace_back(std::move(function));
+    else
+        runOnAxmolThread(std::move(function));
+}
+
 void Scheduler::unscheduleAll()
 {
     unscheduleAllWithMinPriority(PRIORITY_SYSTEM);
@@ -538,6 +693,19 @@ void Scheduler::unscheduleAllWithMinPriority(int minPriority)
     for (auto target: targets)
         unscheduleUpdate(target);
 
+    // the parallel callbacks count as priority 0
+    if (minPriority <= 0)
+    {
+        targets.clear();
+        for (auto&& entry : _parallelList)
+        {
+            if (!entry->markedForDeletion)
+                targets.push_back(entry->target);
+        }
+        for (auto target : targets)
+            unscheduleParallel(target);
+    }
+
 #if AX_ENABLE_SCRIPT_BINDING
     _scriptHandlerEntries.clear();
 #endif
@@ -557,30 +725,132 @@ void Scheduler::unscheduleAllForTarget(void* target)
         unscheduleAllForTarget(timerIt);
     else
         unscheduleUpdate(target);
+
+    unscheduleParallel(target);
 }
 
 void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt)
 {
     auto const target = timerIt->first;
     auto& timerHandle = timerIt->second;
-    if (timerHandle.timers.contains(timerHandle.currentTimer) && (!timerHandle.currentTimer->isAborted()))
+    for (auto timer : timerHandle.timers)
     {
-        timerHandle.currentTimer->retain();
-        timerHandle.currentTimer->setAborted();
+        unlinkTimer(timer, false);
+        timer->setAborted();
     }
     timerHandle.timers.clear();
 
-    if (_currentTarget == &timerHandle)
+    // the update doesn't walk the map, the timers being triggered are retained by it
+    timerIt = _timersMap.erase(timerIt);
+
+    unscheduleUpdate(target);
+}
+
+void Scheduler::placeTimer(const TimerHandle& timerHandle, Timer* timer)
+{
+    if (timerHandle.paused)
+        timer->_state = Timer::State::Parked;
+    else
+        linkTimer(timer);
+}
+
+void Scheduler::removeTimer(std::unordered_map<void*, TimerHandle>::iterator timerIt, ssize_t index)
+{
+    auto& timers = timerIt->second.timers;
+    auto timer   = timers.at(index);
+    unlinkTimer(timer, false);
+    timer->setAborted();
+
+    timers.erase(index);
+    if (timers.empty())
+        _timersMap.erase(timerIt);
+}
+
+void Scheduler::linkTimer(Timer* timer)
+{
+    if (!timer->_armed)
     {
-        _currentTargetSalvaged = true;
-        ++timerIt;
+        timer->_state = Timer::State::New;
+        _newTimers.pushBack(timer);
+    }
+    else if (timer->usesWheel())
+    {
+        timer->_deadline = _timerTime + timer->_remaining;
+        timer->_state    = Timer::State::Wheel;
+        _timerWheel.add(timer);
     }
     else
     {
-        timerIt = _timersMap.erase(timerIt);
+        timer->_state = Timer::State::Frame;
+        _frameTimers.pushBack(timer);
     }
+}
 
-    unscheduleUpdate(target);
+void Scheduler::unlinkTimer(Timer* timer, bool park)
+{
+    if (timer->_state == Timer::State::Wheel || timer->_state == Timer::State::Due)
+        timer->_remaining = timer->_deadline - _timerTime;
+    if (timer->_list)
+        timer->_list->remove(timer);
+    timer->_state = park ? Timer::State::Parked : Timer::State::Detached;
+}
+
+void Scheduler::pauseTimers(TimerHandle& timerHandle)
+{
+    if (timerHandle.paused)
+        return;
+
+    timerHandle.paused = true;
+    for (auto timer : timerHandle.timers)
+        unlinkTimer(timer, true);
+}
+
+void Scheduler::resumeTimers(TimerHandle& timerHandle)
+{
+    if (!timerHandle.paused)
+        return;
+
+    timerHandle.paused = false;
+    for (auto timer : timerHandle.timers)
+    {
+        if (timer->_state == Timer::State::Parked)
+            linkTimer(timer);
+    }
+}
+
+void Scheduler::triggerDueTimer(Timer* timer)
+{
+    do
+    {
+        const bool delayed = timer->_useDelay;
+        timer->_useDelay   = false;
+        timer->_timesExecuted += 1;  // important to increment before call trigger
+        // the next deadline is set first, the callback may pause the target
+        timer->_deadline += timer->_interval;
+        timer->trigger(delayed ? timer->_delay : timer->_interval);
+
+        // unscheduled, rescheduled or paused by the callback
+        if (timer->_state != Timer::State::Due)
+            return;
+
+        if (timer->isExhausted())
+        {
+            timer->cancel();
+            return;
+        }
+
+        if (timer->_interval <= 0)
+        {
+            // the delay is over, triggered every frame from now
+            timer->_elapsed = 0;
+            timer->_state   = Timer::State::Frame;
+            _frameTimers.pushBack(timer);
+            return;
+        }
+    } while (timer->_deadline <= _timerTime);
+
+    timer->_state = Timer::State::Wheel;
+    _timerWheel.add(timer);
 }
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -614,7 +884,7 @@ void Scheduler::resumeTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = false;
+        resumeTimers(timerIt->second);
     }
 
     // update selector
@@ -623,6 +893,13 @@ void Scheduler::resumeTarget(void* target)
     {
         updateIt->second->paused = false;
     }
+
+    // parallel callback
+    auto parallelIt = _parallelIndexMap.find(target);
+    if (parallelIt != _parallelIndexMap.end())
+    {
+        parallelIt->second->paused = false;
+    }
 }
 
 void Scheduler::pauseTarget(void* target)
@@ -633,7 +910,7 @@ void Scheduler::pauseTarget(void* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        timerIt->second.paused = true;
+        pauseTimers(timerIt->second);
     }
 
     // update selector
@@ -642,6 +919,13 @@ void Scheduler::pauseTarget(void* target)
     {
         updateIt->second->paused = true;
     }
+
+    // parallel callback
+    auto parallelIt = _parallelIndexMap.find(target);
+    if (parallelIt != _parallelIndexMap.end())
+    {
+        parallelIt->second->paused = true;
+    }
 }
 
 bool Scheduler::isTargetPaused(void* target)
@@ -662,6 +946,12 @@ bool Scheduler::isTargetPaused(void* target)
         return updateIt->second->paused;
     }
 
+    auto parallelIt = _parallelIndexMap.find(target);
+    if (parallelIt != _parallelIndexMap.end())
+    {
+        return parallelIt->second->paused;
+    }
+
     return false;  // should never get here
 }
 
@@ -677,7 +967,7 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        pauseTimers(timerHandle);
         idsWithSelectors.insert(target);
     }
 
@@ -701,6 +991,12 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
             entry->paused = true;
             idsWithSelectors.insert(entry->target);
         }
+
+        for (auto&& entry : _parallelList)
+        {
+            entry->paused = true;
+            idsWithSelectors.insert(entry->target);
+        }
     }
 
     for (auto&& entry : _updatesPosList)
@@ -723,21 +1019,113 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
     }
 }
 
-void Scheduler::runOnAxmolThread(std::function<void()> action)
+void Scheduler::updateParallel(float dt)
+{
+    for (auto&& entry : _parallelList)
+    {
+        if ((!entry->paused) && (!entry->markedForDeletion))
+            _parallelBatch.emplace_back(entry);
+    }
+
+    const size_t count = _parallelBatch.size();
+    if (count == 0)
+        return;
+
+    AX_TRACE_SCOPE("Scheduler::updateParallel");
+
+    if (_parallelDeferred.size() < count)
+        _parallelDeferred.resize(count);
+
+    auto run = [this, dt](size_t begin, size_t end) {
+        auto& slot     = s_parallelSlot;
+        slot.scheduler = this;
+        for (size_t index = begin; index < end; ++index)
+        {
+            slot.index = index;
+            _parallelBatch[index]->callback(dt);
+        }
+        slot.scheduler = nullptr;
+    };
+
+    auto jobSystem =
+        _parallelThreshold && count >= _parallelThreshold ? Director::getInstance()->getJobSystem() : nullptr;
+    if (!jobSystem)
+        run(0, count);
+    else  // the callbacks are taken one by one, they are few and heavy, the axmol thread runs some while it waits
+        jobSystem->wait(jobSystem->parallelFor(count, 1, run));
+
+    // the deferred functions may schedule, unschedule or defer again, which goes to runOnAxmolThread
+    for (size_t index = 0; index < count; ++index)
+    {
+        auto& deferred = _parallelDeferred[index];
+        for (size_t i = 0; i < deferred.size(); ++i)
+            deferred[i]();
+        deferred.clear();
+    }
+
+    _parallelBatch.clear();
+}
+
+void Scheduler::runOnAxmolThread(InlineTask action)
 {
-    std::lock_guard<std::mutex> lock(_performMutex);
-    _actionsToPerform.emplace_back(std::move(action));
+    if (action)
+        _pendingActions.enqueue(std::move(action));
 }
 
 void Scheduler::removeAllPendingActions()
 {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _actionsToPerform.clear();
+    // the functions carried from a previous frame belong to the axmol thread, they are dropped by its next update
+    _discardPendingActions.store(true, std::memory_order_release);
+    InlineTask action;
+    while (_pendingActions.try_dequeue(action))
+        action.reset();
+}
+
+void Scheduler::runPendingActions()
+{
+    if (_discardPendingActions.exchange(false, std::memory_order_acquire))
+        _carriedActions.clear();
+
+    // only the functions queued so far, the ones queued while they run wait for the next frame
+    size_t count = _pendingActions.size_approx();
+    if (count != 0)
+    {
+        const size_t carried = _carriedActions.size();
+        _carriedActions.resize(carried + count);
+        count = _pendingActions.try_dequeue_bulk(_carriedActions.begin() + carried, count);
+        _carriedActions.resize(carried + count);
+    }
+
+    if (_carriedActions.empty())
+        return;
+
+    using clock_type    = std::chrono::steady_clock;
+    const auto start    = clock_type::now();
+    const bool budgeted = _pendingActionsBudget > 0;
+
+    size_t done = 0;
+    while (done < _carriedActions.size())
+    {
+        // moved out first, a function may queue others
+        InlineTask action = std::move(_carriedActions[done++]);
+        action();
+
+        if (_discardPendingActions.exchange(false, std::memory_order_acquire))
+        {
+            _carriedActions.clear();
+            return;
+        }
+        if (budgeted && std::chrono::duration<float>(clock_type::now() - start).count() >= _pendingActionsBudget)
+            break;
+    }
+    _carriedActions.erase(_carriedActions.begin(), _carriedActions.begin() + done);
 }
 
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_TRACE_SCOPE("Scheduler::update");
+
     // active waitlist
     if (!_waitList.empty())
         activeWaitList();
@@ -753,6 +1141,10 @@ void Scheduler::update(float dt)
     // Selector callbacks
     //
 
+    // the parallel safe callbacks run first, their deferred functions are called before the updates
+    if (!_parallelList.empty())
+        updateParallel(dt);
+
     // Iterate over all the Updates' selectors
     // updates with priority < 0
     for (auto&& entry : _updatesNegList)
@@ -781,44 +1173,50 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
-    {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
+    // Trigger the custom selectors, only the every frame timers and the due ones are visited
+    _timerTime += dt;
 
-        if (!_currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
+    // collected first, the callbacks may schedule, unschedule or pause any timer
+    for (auto timer = _frameTimers.front(); timer; timer = timer->_next)
+        _firingTimers.emplace_back(timer);
+    const size_t frameTimerCount = _firingTimers.size();
 
-                elt->currentTimer->update(dt);
+    _timerWheel.advance(_timerTime, _firingTimers);
+    for (size_t i = frameTimerCount; i < _firingTimers.size(); ++i)
+        _firingTimers[i]->_state = Timer::State::Due;
+    std::sort(_firingTimers.begin() + frameTimerCount, _firingTimers.end(),
+              [](const Timer* lhs, const Timer* rhs) { return lhs->_deadline < rhs->_deadline; });
+    for (auto timer : _firingTimers)
+        timer->retain();
 
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
+    // the timers scheduled since the last update start counting now, like the first Timer::update
+    while (auto timer = _newTimers.front())
+    {
+        _newTimers.remove(timer);
+        timer->_armed         = true;
+        timer->_elapsed       = 0;
+        timer->_timesExecuted = 0;
+        timer->_remaining     = timer->_useDelay ? timer->_delay : timer->_interval;
+        linkTimer(timer);
+    }
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
+    for (size_t i = 0; i < _firingTimers.size(); ++i)
+    {
+        auto timer = _firingTimers[i];
+        if (i < frameTimerCount)
         {
-            it = _timersMap.erase(it);
+            if (timer->_state == Timer::State::Frame)
+                timer->update(dt);
         }
-        else
-            ++it;
+        else if (timer->_state == Timer::State::Due)
+            triggerDueTimer(timer);
     }
 
+    // the unscheduled timers are deleted here
+    for (auto timer : _firingTimers)
+        timer->release();
+    _firingTimers.clear();
+
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
     {
@@ -829,7 +1227,6 @@ void Scheduler::update(float dt)
     _updateDeleteVector.clear();
 
     _indexMapLocked = false;
-    _currentTarget  = nullptr;
 
 #if AX_ENABLE_SCRIPT_BINDING
     //
@@ -856,22 +1253,7 @@ void Scheduler::update(float dt)
     //
     // Functions allocated from another thread
     //
-
-    // Testing size is faster than locking / unlocking.
-    // And almost never there will be functions scheduled to be called.
-    if (!_actionsToPerform.empty())
-    {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if
-        // new functions are added in callback, it will cause thread deadlock.
-        auto temp = std::move(_actionsToPerform);
-        _performMutex.unlock();
-
-        for (const auto& function : temp)
-        {
-            function();
-        }
-    }
+    runPendingActions();
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector,
@@ -897,7 +1279,8 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
     }
 
-    auto&& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto&& timers     = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -912,7 +1295,10 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
         {
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            auto timer = *timerIt;
+            unlinkTimer(timer, false);
+            timer->setupTimerWithInterval(interval, repeat, delay);
+            placeTimer(timerHandle, timer);
             return;
         }
     }
@@ -920,6 +1306,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     TimerTargetSelector* timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     timers.pushBack(timer);
+    placeTimer(timerHandle, timer);
     timer->release();
 }
 
@@ -960,40 +1347,14 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        auto& timerHandle = timerIt->second;
-        auto&& timers     = timerHandle.timers;
+        auto&& timers = timerIt->second.timers;
         for (int i = 0; i < timers.size(); ++i)
         {
             TimerTargetSelector* timer = dynamic_cast<TimerTargetSelector*>(timers[i]);
 
             if (timer && selector == timer->getSelector())
             {
-                if (timer == timerHandle.currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
-                timers.erase(i);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
-                if (timers.empty())
-                {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
-                }
-
+                removeTimer(timerIt, i);
                 return;
             }
         }
@@ -29,10 +29,13 @@ THE SOFTWARE.
 #ifndef __CCSCHEDULER_H__
 #define __CCSCHEDULER_H__
 
+#include <atomic>
 #include <functional>
-#include <mutex>
 #include <set>
+#include "concurrentqueue/concurrentqueue.h"
 #include "base/axstd.h"
+#include "base/InlineTask.h"
+#include "base/InternedString.h"
 #include "base/Object.h"
 #include "base/Vector.h"
 
@@ -46,6 +49,8 @@ typedef std::function<void(float)> ccSchedulerFunc;
 /**
  * @cond
  */
+class TimerList;
+
 class AX_DLL Timer : public Object
 {
 protected:
@@ -64,6 +69,24 @@ public:
     void update(float dt);
 
 protected:
+    friend class Scheduler;
+    friend class TimerList;
+    friend class TimerWheel;
+
+    // where the scheduler keeps the timer
+    enum class State : uint8_t
+    {
+        Detached,
+        New,     // starts counting at the next update
+        Frame,   // updated every frame, interval 0
+        Wheel,   // waits for its deadline in the timer wheel
+        Due,     // being triggered by the update
+        Parked,  // its target is paused
+    };
+
+    /** Whether the timer waits in the timer wheel, it is updated every frame otherwise. */
+    bool usesWheel() const { return _useDelay || _interval > 0; }
+
     Scheduler* _scheduler;  // weak ref
     float _elapsed;
     bool _runForever;
@@ -73,6 +96,14 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    State _state     = State::Detached;
+    bool _armed      = false;  // counting, from the first update after it was scheduled
+    TimerList* _list = nullptr;
+    Timer* _prev     = nullptr;
+    Timer* _next     = nullptr;
+    double _deadline  = 0;  // of the next trigger in the scheduler time, wheel timers only
+    double _remaining = 0;  // to the deadline while parked
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -115,7 +146,8 @@ public:
                           float delay);
 
     const ccSchedulerFunc& getCallback() const { return _callback; }
-    std::string_view getKey() const { return _key; }
+    std::string_view getKey() const { return _key.view(); }
+    InternedString getInternedKey() const { return _key; }
 
     virtual void trigger(float dt) override;
     virtual void cancel() override;
@@ -123,7 +155,7 @@ public:
 protected:
     void* _target;
     ccSchedulerFunc _callback;
-    std::string _key;
+    InternedString _key;  // the keys of the timers are compared by pointer
 };
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -143,6 +175,57 @@ private:
 
 #endif
 
+/** An intrusive list of timers, a timer is in one list at most. */
+class AX_DLL TimerList
+{
+public:
+    void pushBack(Timer* timer);
+    void remove(Timer* timer);
+
+    Timer* front() const { return _head; }
+    bool empty() const { return _head == nullptr; }
+
+private:
+    Timer* _head = nullptr;
+    Timer* _tail = nullptr;
+};
+
+/**
+ * A hierarchical timing wheel holding the interval timers by deadline.
+ *
+ * The deadlines are bucketed in ticks, the root level has a slot per tick, the upper levels a slot per 64 times the
+ * span of a slot of the level below, and their slots are cascaded down as the time reaches them. Advancing the
+ * wheel only visits the slots of the elapsed ticks, so its cost follows the due timers instead of the scheduled ones.
+ * The timers are still due by their exact deadline, the ticks only bucket them.
+ */
+class AX_DLL TimerWheel
+{
+public:
+    /** The span of a tick in seconds. */
+    static constexpr double TICK = 1.0 / 1024;
+
+    void add(Timer* timer);
+
+    /** Removes the timers whose deadline is reached by now and appends them to due, in no particular order. */
+    void advance(double now, std::vector<Timer*>& due);
+
+private:
+    static constexpr int ROOT_BITS  = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS     = 3;  // above the root
+
+    static constexpr uint64_t ROOT_SIZE  = uint64_t{1} << ROOT_BITS;
+    static constexpr uint64_t LEVEL_SIZE = uint64_t{1} << LEVEL_BITS;
+
+    static uint64_t toTick(double time) { return time > 0 ? static_cast<uint64_t>(time / TICK) : 0; }
+
+    void cascade(int level, uint64_t index);
+
+    TimerList _root[ROOT_SIZE];
+    TimerList _levels[LEVELS][LEVEL_SIZE];
+    uint64_t _currentTick = 0;  // its root slot is visited by every advance until the time leaves the tick
+};
+
 /**
  * @endcond
  */
@@ -172,8 +255,6 @@ struct SchedHandle
 struct TimerHandle
 {
     Vector<Timer*> timers;
-    int timerIndex;
-    Timer* currentTimer;
     bool paused;
 };
 
@@ -210,6 +291,9 @@ public:
      */
     static const int PRIORITY_NON_SYSTEM_MIN;
 
+    /** The callback count the parallel update phase is spread over the workers from. */
+    static constexpr size_t DEFAULT_PARALLEL_THRESHOLD = 8;
+
     /**
      * Constructor
      *
@@ -327,6 +411,44 @@ public:
         this->schedulePerFrame([target](float dt) { target->update(dt); }, target, priority, paused);
     }
 
+    /** Schedules the 'parallelUpdate' method of a target in the parallel update phase.
+     @see scheduleParallel
+     @lua NA
+     */
+    template <class T>
+    void scheduleParallelUpdate(T* target, bool paused)
+    {
+        this->scheduleParallel([target](float dt) { target->parallelUpdate(dt); }, target, paused);
+    }
+
+    /** Schedules a parallel safe callback, it will be called every frame in the parallel update phase.
+     The phase runs before the 'update' callbacks, its callbacks are spread over the JobSystem workers and run in no
+     particular order. They must not change the scene graph, nor any state shared with another callback, nor call the
+     scheduler except runAfterParallelUpdates, which defers a change to the axmol thread.
+     A target has one parallel callback, it is paused, resumed and unscheduled with the other callbacks of the target.
+     If it is already scheduled, only the callback is updated.
+     @param callback The callback function.
+     @param target The target of the callback function.
+     @param paused Whether or not to pause the schedule.
+     @lua NA
+     */
+    void scheduleParallel(const ccSchedulerFunc& callback, void* target, bool paused);
+
+    /** Defers a function from a parallel callback to the axmol thread.
+     The functions deferred during the parallel update phase are called once it is over, before the 'update'
+     callbacks, grouped by target in the order the targets were scheduled, so the result doesn't depend on which
+     worker ran what. Called anywhere else, it is the same as runOnAxmolThread.
+     This function is thread safe.
+     @lua NA
+     */
+    void runAfterParallelUpdates(std::function<void()> function);
+
+    /** Sets the callback count the parallel update phase is spread over the workers from, 0 to always run it on the
+     axmol thread. Default is DEFAULT_PARALLEL_THRESHOLD.
+     */
+    void setParallelThreshold(size_t count) { _parallelThreshold = count; }
+    size_t getParallelThreshold() const { return _parallelThreshold; }
+
 #if AX_ENABLE_SCRIPT_BINDING
     // Schedule for script bindings.
     /** The scheduled script callback will be called every 'interval' seconds.
@@ -366,6 +488,12 @@ public:
      */
     void unscheduleUpdate(void* target);
 
+    /** Unschedules the parallel callback for a given target.
+     @param target The target to be unscheduled.
+     @lua NA
+     */
+    void unscheduleParallel(void* target);
+
     /** Unschedules all selectors for a given target.
      This also includes the "update" selector.
      @param target The target to be unscheduled.
@@ -417,6 +545,11 @@ public:
      */
     bool isScheduled(SEL_SCHEDULE selector, const Object* target) const;
 
+    /** Checks whether a parallel callback is scheduled for a given target.
+     @lua NA
+     */
+    bool isScheduledParallel(const void* target) const;
+
     /////////////////////////////////////
 
     /** Pauses the target.
@@ -464,13 +597,25 @@ public:
       */
     void resumeTargets(const std::set<void*>& targetsToResume);
 
-    /** Calls a function on the cocos2d thread. Useful when you need to call a cocos2d function from another thread.
-     This function is thread safe.
-     @param function The function to be run in cocos2d thread.
+    /** Calls a function on the axmol thread. Useful when you need to call an axmol function from another thread.
+     This function is thread safe and lock free, the functions queued by a thread are called in the order it queued
+     them, the functions queued while they run are called on the next frame.
+     @param action The function to be run in axmol thread, lambdas of up to InlineTask::INLINE_SIZE bytes don't
+     allocate.
      @since v3.0
      @js NA
      */
-    void runOnAxmolThread(std::function<void()> action);
+    void runOnAxmolThread(InlineTask action);
+
+    /** Sets the time in seconds spent calling the functions queued by runOnAxmolThread each frame, 0 is unlimited,
+     the default. The functions left once it is used up are called first on the next frame, at least one function is
+     called per frame.
+     */
+    void setPendingActionsBudget(float seconds) { _pendingActionsBudget = seconds; }
+    float getPendingActionsBudget() const { return _pendingActionsBudget; }
+    /** The number of functions waiting to be called on the axmol thread, approximate while other threads queue. */
+    size_t getPendingActionCount() const { return _pendingActions.size_approx() + _carriedActions.size(); }
+
 #ifndef AX_CORE_PROFILE
     AX_DEPRECATED(2.1) void performFunctionInCocosThread(std::function<void()> action)
     {
@@ -513,6 +658,26 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    /** Runs the parallel callbacks, then the functions they deferred. */
+    void updateParallel(float dt);
+
+    /** Calls the functions queued by runOnAxmolThread, within the pending actions budget. */
+    void runPendingActions();
+
+    // timer wheel specific
+
+    /** Links a timer just (re)initialized, or parks it when its target is paused. */
+    void placeTimer(const TimerHandle& timerHandle, Timer* timer);
+    void removeTimer(std::unordered_map<void*, TimerHandle>::iterator timerIt, ssize_t index);
+    /** Puts a timer of a running target where it waits, a new timer starts counting at the next update. */
+    void linkTimer(Timer* timer);
+    /** Takes a timer out of the lists, parked timers are linked again when their target resumes. */
+    void unlinkTimer(Timer* timer, bool park);
+    void pauseTimers(TimerHandle& timerHandle);
+    void resumeTimers(TimerHandle& timerHandle);
+    /** Triggers a due wheel timer, with the repeats it missed, and puts it back in the wheel. */
+    void triggerDueTimer(Timer* timer);
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -526,13 +691,23 @@ protected:
     // weak reference SchedHandle map used to fetch quickly the list entries for pause,delete,etc
     std::unordered_map<void*, SchedHandle*> _schedIndexMap;
 
+    // the parallel safe callbacks, in the order they were scheduled
+    axstd::pod_vector<SchedHandle*> _parallelList;
+    std::unordered_map<void*, SchedHandle*> _parallelIndexMap;
+    axstd::pod_vector<SchedHandle*> _parallelBatch;  // the ones running this frame
+    std::vector<std::vector<std::function<void()>>> _parallelDeferred;  // by batch index
+    size_t _parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+
     // the vector holds list entries that needs to be deleted after update
     axstd::pod_vector<SchedHandle*> _updateDeleteVector;
 
-    // Used for "selectors with interval"
+    // Used for "selectors with interval", the map owns the timers, the update only visits the ones due
     std::unordered_map<void*, TimerHandle> _timersMap;
-    struct TimerHandle* _currentTarget;
-    bool _currentTargetSalvaged;
+    TimerWheel _timerWheel;
+    TimerList _frameTimers;  // interval 0, updated every frame
+    TimerList _newTimers;    // scheduled since the last update
+    std::vector<Timer*> _firingTimers;
+    double _timerTime = 0;  // the scaled time of the timers, in seconds
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
@@ -540,9 +715,11 @@ protected:
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
 #endif
 
-    // Used for "perform action"
-    std::vector<std::function<void()>> _actionsToPerform;
-    std::mutex _performMutex;
+    // Used for "perform action", the functions not called within the budget are carried to the next frame
+    moodycamel::ConcurrentQueue<InlineTask> _pendingActions;
+    std::vector<InlineTask> _carriedActions;
+    std::atomic<bool> _discardPendingActions{false};
+    float _pendingActionsBudget = 0;
 };
 
 // end of base group
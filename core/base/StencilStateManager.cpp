@@ -34,7 +34,9 @@ namespace ax
 
 int StencilStateManager::s_layer = -1;
 
-StencilStateManager::StencilStateManager()
+StencilStateManager::StencilStateManager() {}
+
+void StencilStateManager::initCommand()
 {
     auto& pipelineDescriptor        = _customCommand.getPipelineDescriptor();
     auto* program                   = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_UCOLOR);
@@ -63,6 +65,10 @@ StencilStateManager::~StencilStateManager()
 
 void StencilStateManager::drawFullScreenQuadClearStencil(float globalZOrder)
 {
+    // most layouts and clipping nodes never clip, so the program is loaded on first use
+    if (!_programState)
+        initCommand();
+
     _customCommand.init(globalZOrder);
     Director::getInstance()->getRenderer()->addCommand(&_customCommand);
     _programState->setUniform(_mvpMatrixLocaiton, Mat4::IDENTITY.m, sizeof(Mat4::IDENTITY.m));
@@ -57,6 +57,7 @@ private:
      */
     void drawFullScreenQuadClearStencil(float globalZOrder);
 
+    void initCommand();
     void updateLayerMask();
     void onBeforeDrawQuadCmd();
     void onAfterDrawQuadCmd();
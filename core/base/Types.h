@@ -95,6 +95,24 @@ struct V2F_C4B_T2F
     Tex2F texCoords;
 };
 
+/** @struct V2F_C4B_T2F_T4F_C4B
+ * A vertex of an analytic DrawNode shape: a V2F_C4B_T2F whose tex coords are the position in the shape, with the
+ * shape parameters and a border color 4B.
+ */
+struct V2F_C4B_T2F_T4F_C4B
+{
+    /// vertices (2F)
+    Vec2 vertices;
+    /// fill color (4B)
+    Color4B colors;
+    /// position in the shape, relative to its center (2F)
+    Tex2F texCoords;
+    /// half extents (xy), corner radius (z) and border width (w) (4F)
+    Vec4 params;
+    /// border color (4B)
+    Color4B borderColors;
+};
+
 /** @struct V2F_C4B_PF
  *
  */
@@ -29,6 +29,7 @@
 #include "platform/Common.h"
 #include "base/Logging.h"
 #include "ConvertUTF.h"
+#include <bit>
 #include <limits>
 
 using namespace llvm;
@@ -315,19 +316,187 @@ bool utfConvert(const std::basic_string_view<From>& from,
     return true;
 };
 
+// the UTF-8 paths skip the ascii runs 16 bytes at a time, text is mostly ascii
+#if defined(AX_SSE_INTRINSICS)
+#    define AX_UTF8_SSE 1
+#elif defined(AX_NEON_INTRINSICS) && AX_64BITS
+#    define AX_UTF8_NEON 1
+#endif
+
+// the length of the leading ascii run
+static size_t getAsciiPrefixLength(const uint8_t* str, size_t len)
+{
+    size_t i = 0;
+#if defined(AX_UTF8_SSE)
+    for (; i + 16 <= len; i += 16)
+    {
+        const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)));
+        if (mask != 0)
+            return i + std::countr_zero(static_cast<unsigned int>(mask));
+    }
+#elif defined(AX_UTF8_NEON)
+    for (; i + 16 <= len; i += 16)
+    {
+        // NEON has no movemask, the 0xff lanes of the non ascii bytes are narrowed to a nibble each
+        const uint8x16_t nonAscii = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(str + i)), vdupq_n_s8(0));
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(nonAscii), 4)), 0);
+        if (mask != 0)
+            return i + std::countr_zero(mask) / 4;
+    }
+#else
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, str + i, sizeof(word));
+        if (word & 0x8080808080808080ull)
+            break;
+    }
+#endif
+    while (i < len && str[i] < 0x80)
+        ++i;
+    return i;
+}
+
+// decodes the non ascii sequence at str, returns its length, or 0 if it is ill-formed, see the table 3-7 of the
+// Unicode standard: no overlong forms, surrogates or code points above U+10FFFF
+static int decodeUTF8Sequence(const uint8_t* str, size_t len, char32_t& codePoint)
+{
+    const uint8_t lead = str[0];
+    if (lead < 0xC2 || lead > 0xF4)
+        return 0;
+
+    if (lead < 0xE0)
+    {
+        if (len < 2 || (str[1] & 0xC0) != 0x80)
+            return 0;
+        codePoint = ((lead & 0x1F) << 6) | (str[1] & 0x3F);
+        return 2;
+    }
+
+    if (lead < 0xF0)
+    {
+        const uint8_t low  = lead == 0xE0 ? 0xA0 : 0x80;
+        const uint8_t high = lead == 0xED ? 0x9F : 0xBF;
+        if (len < 3 || str[1] < low || str[1] > high || (str[2] & 0xC0) != 0x80)
+            return 0;
+        codePoint = ((lead & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+        return 3;
+    }
+
+    const uint8_t low  = lead == 0xF0 ? 0x90 : 0x80;
+    const uint8_t high = lead == 0xF4 ? 0x8F : 0xBF;
+    if (len < 4 || str[1] < low || str[1] > high || (str[2] & 0xC0) != 0x80 || (str[3] & 0xC0) != 0x80)
+        return 0;
+    codePoint = ((lead & 0x07) << 18) | ((str[1] & 0x3F) << 12) | ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+    return 4;
+}
+
+template <typename To>
+static bool decodeUTF8(std::string_view utf8, std::basic_string<To>& to)
+{
+    const auto* str  = reinterpret_cast<const uint8_t*>(utf8.data());
+    const size_t len = utf8.length();
+
+    // a code point takes as many UTF-8 bytes as UTF-16 or UTF-32 units at least
+    std::basic_string<To> working(len, 0);
+    To* out = working.data();
+    for (size_t i = 0; i < len;)
+    {
+        const size_t ascii = getAsciiPrefixLength(str + i, len - i);
+        for (size_t k = 0; k < ascii; ++k)
+            out[k] = static_cast<To>(str[i + k]);
+        out += ascii;
+        i += ascii;
+        if (i == len)
+            break;
+
+        char32_t codePoint;
+        const int sequenceLength = decodeUTF8Sequence(str + i, len - i, codePoint);
+        if (sequenceLength == 0)
+            return false;
+        i += sequenceLength;
+
+        if constexpr (sizeof(To) == 2)
+        {
+            if (codePoint >= 0x10000)
+            {
+                codePoint -= 0x10000;
+                *out++ = static_cast<To>(0xD800 + (codePoint >> 10));
+                *out++ = static_cast<To>(0xDC00 + (codePoint & 0x3FF));
+                continue;
+            }
+        }
+        *out++ = static_cast<To>(codePoint);
+    }
+
+    working.resize(out - working.data());
+    to = std::move(working);
+    return true;
+}
+
+template <typename From>
+static bool encodeUTF8(std::basic_string_view<From> from, std::string& to)
+{
+    // 3 bytes per UTF-16 unit, a surrogate pair takes 4, and 4 bytes per UTF-32 unit
+    std::string working(from.length() * (sizeof(From) == 2 ? 3 : 4), 0);
+    auto* out = reinterpret_cast<uint8_t*>(working.data());
+    for (size_t i = 0, len = from.length(); i < len; ++i)
+    {
+        char32_t codePoint = from[i];
+        if (codePoint < 0x80)
+        {
+            *out++ = static_cast<uint8_t>(codePoint);
+            continue;
+        }
+
+        if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+        {
+            // only UTF-16 may hold surrogates, in pairs
+            if constexpr (sizeof(From) != 2)
+                return false;
+            if (codePoint >= 0xDC00 || i + 1 == len || from[i + 1] < 0xDC00 || from[i + 1] > 0xDFFF)
+                return false;
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (from[++i] - 0xDC00);
+        }
+
+        if (codePoint < 0x800)
+        {
+            *out++ = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+        }
+        else if (codePoint < 0x10000)
+        {
+            *out++ = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+            *out++ = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+        }
+        else if (codePoint <= 0x10FFFF)
+        {
+            *out++ = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+            *out++ = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+            *out++ = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+        }
+        else
+            return false;
+        *out++ = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+    }
+
+    working.resize(reinterpret_cast<char*>(out) - working.data());
+    to = std::move(working);
+    return true;
+}
+
 bool UTF8ToUTF16(std::string_view utf8, std::u16string& outUtf16)
 {
-    return utfConvert(utf8, outUtf16, ConvertUTF8toUTF16);
+    return decodeUTF8(utf8, outUtf16);
 }
 
 bool UTF8ToUTF32(std::string_view utf8, std::u32string& outUtf32)
 {
-    return utfConvert(utf8, outUtf32, ConvertUTF8toUTF32);
+    return decodeUTF8(utf8, outUtf32);
 }
 
 bool UTF16ToUTF8(std::u16string_view utf16, std::string& outUtf8)
 {
-    return utfConvert(utf16, outUtf8, ConvertUTF16toUTF8);
+    return encodeUTF8(utf16, outUtf8);
 }
 
 bool UTF16ToUTF32(std::u16string_view utf16, std::u32string& outUtf32)
@@ -337,7 +506,7 @@ bool UTF16ToUTF32(std::u16string_view utf16, std::u32string& outUtf32)
 
 bool UTF32ToUTF8(std::u32string_view utf32, std::string& outUtf8)
 {
-    return utfConvert(utf32, outUtf8, ConvertUTF32toUTF8);
+    return encodeUTF8(utf32, outUtf8);
 }
 
 bool UTF32ToUTF16(std::u32string_view utf32, std::u16string& outUtf16)
@@ -402,7 +571,28 @@ std::vector<char16_t> getChar16VectorFromUTF16String(const std::u16string& utf16
 
 int32_t getCharacterCountInUTF8String(std::string_view utf8)
 {
-    return getUTF8StringLength((const UTF8*)utf8.data());
+    // counts up to the terminator like it always did, 0 for ill-formed strings
+    utf8 = utf8.substr(0, utf8.find('\0'));
+
+    const auto* str  = reinterpret_cast<const uint8_t*>(utf8.data());
+    const size_t len = utf8.length();
+    int32_t count    = 0;
+    for (size_t i = 0; i < len;)
+    {
+        const size_t ascii = getAsciiPrefixLength(str + i, len - i);
+        count += static_cast<int32_t>(ascii);
+        i += ascii;
+        if (i == len)
+            break;
+
+        char32_t codePoint;
+        const int sequenceLength = decodeUTF8Sequence(str + i, len - i, codePoint);
+        if (sequenceLength == 0)
+            return 0;
+        i += sequenceLength;
+        ++count;
+    }
+    return count;
 }
 
 bool hasNonAsciiUTF8(const char* str, size_t len)
@@ -451,7 +641,20 @@ bool detectNonAsciiUTF8(const char* str, size_t len, bool restrictUTF8, bool* pA
 
 bool isLegalUTF8String(const char* str, size_t len)
 {
-    return ::isLegalUTF8String((const UTF8**)&str, (const UTF8*)str + len);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(str);
+    for (size_t i = 0; i < len;)
+    {
+        i += getAsciiPrefixLength(bytes + i, len - i);
+        if (i == len)
+            break;
+
+        char32_t codePoint;
+        const int sequenceLength = decodeUTF8Sequence(bytes + i, len - i, codePoint);
+        if (sequenceLength == 0)
+            return false;
+        i += sequenceLength;
+    }
+    return true;
 }
 
 StringUTF8::StringUTF8() {}
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include <sys/stat.h>
 
 #include <inttypes.h>
+#include <mutex>
 #include <sstream>
 
 #include "openssl/aes.h"
@@ -50,11 +51,15 @@ THE SOFTWARE.
 #include "platform/FileUtils.h"
 #include "pugixml/pugixml.hpp"
 #include "base/Utils.h"
+#include "base/Director.h"
 
 #define USER_DEFAULT_PLAIN_MODE 0
 
 typedef int32_t udflen_t;
 
+// the log isn't compacted below this size
+#define USER_DEFAULT_COMPACTION_MIN_SIZE (64 * 1024)
+
 namespace ax
 {
 
@@ -91,6 +96,37 @@ static void ud_write_v_s(UserDefault* ud, yasio::obstream& obs, const cxx17::str
         ud->encrypt(obs.data() + value_offset, value.length(), AES_ENCRYPT);
 }
 
+static void ud_write_entity(UserDefault* ud,
+                            bool encrypted,
+                            yasio::obstream& obs,
+                            const cxx17::string_view key,
+                            const cxx17::string_view value)
+{
+    if (encrypted)
+    {
+        ud_write_v_s(ud, obs, key);
+        ud_write_v_s(ud, obs, value);
+    }
+    else
+    {
+        obs.write_v(key);
+        obs.write_v(value);
+    }
+}
+
+struct UserDefault::Compaction
+{
+    std::mutex mutex;  // held by the worker, the UserDefault waits for it when it's destroyed
+    UserDefault* owner = nullptr;
+    hlookup::string_map<std::string> values;
+    std::string filePath;
+    int count    = 0;  // of the entities written by the worker
+    size_t size  = 0;
+    bool written = false;
+    std::string pending;  // the entities appended to the log meanwhile
+    int pendingCount = 0;
+};
+
 void UserDefault::setEncryptEnabled(bool enabled, cxx17::string_view key, cxx17::string_view iv)
 {
     _encryptEnabled = enabled;
@@ -124,6 +160,11 @@ void UserDefault::encrypt(char* inout, size_t size, int enc)
 
 UserDefault::~UserDefault()
 {
+    if (_compaction)
+    {
+        std::lock_guard<std::mutex> lock(_compaction->mutex);
+        _compaction->owner = nullptr;
+    }
     closeFileMapping();
 }
 
@@ -301,33 +342,12 @@ void UserDefault::setStringForKey(const char* pKey, std::string_view value)
     if (_rwmmap)
     {
         yasio::obstream obs;
-        if (_encryptEnabled)
-        {
-            ud_write_v_s(this, obs, pKey);
-            ud_write_v_s(this, obs, value);
-        }
-        else
-        {
-            obs.write_v(pKey);
-            obs.write_v(value);
-        }
-
-        if ((_realSize + obs.length() + sizeof(udflen_t)) < _curMapSize)
-        {  // fast append entity without flush
-            // increase entities count
-            yasio::obstream::swrite(_rwmmap->data(), 1 + yasio::ibstream::sread<udflen_t>(_rwmmap->data()));
-
-            // append entity
-            ::memcpy(_rwmmap->data() + sizeof(udflen_t) + _realSize, obs.data(), obs.length());
-            _realSize += static_cast<int>(obs.length());
-        }
-        else
-        {
-            flush();
-        }
+        ud_write_entity(this, _encryptEnabled, obs, pKey, value);
+        appendEntities(std::string_view{obs.data(), obs.length()}, 1);
     }
 #else
-    flush();
+    if (!_batching)
+        flush();
 #endif
 }
 
@@ -343,9 +363,163 @@ void UserDefault::updateValueForKey(std::string_view key, std::string_view value
 {
     auto it = _values.find(key);
     if (it != _values.end())
+    {
+        _liveSize = _liveSize - it->second.size() + value.size();
         it->second = value;
+    }
     else
+    {
+        _liveSize += key.size() + value.size();
         _values.emplace(key, value);
+    }
+}
+
+bool UserDefault::eraseValueForKey(std::string_view key)
+{
+    auto it = _values.find(key);
+    if (it == _values.end())
+        return false;
+
+    _liveSize -= it->first.size() + it->second.size();
+    _values.erase(it);
+    return true;
+}
+
+void UserDefault::appendEntities(std::string_view entities, int count)
+{
+    if (_batching)
+    {
+        _batchEntities.append(entities);
+        _batchCount += count;
+        return;
+    }
+
+    const auto required = static_cast<int>(sizeof(udflen_t) + _realSize + entities.size());
+    if (required > _curMapSize)
+    {  // the log grows, the entities written stay in place
+        auto mapSize = _curMapSize;
+        while (required > mapSize)
+            mapSize <<= 1;  // X2
+        if (!remapFile(mapSize))
+            return;
+    }
+
+    // the entities before their count, a crash in between leaves the log as it was
+    ::memcpy(_rwmmap->data() + sizeof(udflen_t) + _realSize, entities.data(), entities.size());
+    yasio::obstream::swrite(_rwmmap->data(), count + yasio::ibstream::sread<udflen_t>(_rwmmap->data()));
+    _realSize += static_cast<int>(entities.size());
+
+    if (_compaction)
+    {
+        _compaction->pending.append(entities);
+        _compaction->pendingCount += count;
+    }
+    else if (_realSize > USER_DEFAULT_COMPACTION_MIN_SIZE && static_cast<size_t>(_realSize) > 2 * _liveSize)
+        compactAsync();
+}
+
+bool UserDefault::remapFile(int mapSize)
+{
+    std::error_code error;
+    _rwmmap->unmap();
+    if (_fileStream.resize(mapSize))
+        _rwmmap->map(_fileStream.nativeHandle(), 0, mapSize, error);
+
+    if (error || !_rwmmap->is_mapped())
+    {
+        // don't persist this time, the values written before are still in the file
+        closeFileMapping();
+        AXLOGW("UserDefault failed to map '{}' with {} bytes.", _filePath, mapSize);
+        return false;
+    }
+    _curMapSize = mapSize;
+    return true;
+}
+
+void UserDefault::compactAsync()
+{
+    auto compaction      = std::make_shared<Compaction>();
+    compaction->owner    = this;
+    compaction->values   = _values;
+    compaction->filePath = _filePath + ".tmp";
+    _compaction          = compaction;
+
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    jobSystem
+        ->schedule(
+            [compaction, encrypted = _encryptEnabled] {
+                std::lock_guard<std::mutex> lock(compaction->mutex);
+                if (!compaction->owner)
+                    return;
+
+                yasio::obstream obs;
+                obs.write<udflen_t>(static_cast<udflen_t>(compaction->values.size()));
+                for (auto&& item : compaction->values)
+                    ud_write_entity(compaction->owner, encrypted, obs, item.first, item.second);
+
+                compaction->count   = static_cast<int>(compaction->values.size());
+                compaction->size    = obs.length();
+                compaction->written = FileUtils::writeBinaryToFile(obs.data(), obs.length(), compaction->filePath);
+                compaction->values.clear();
+            },
+            JobPriority::Low)
+        .thenOnAxmolThread([weak = std::weak_ptr<Compaction>(compaction)] {
+            auto compaction = weak.lock();
+            if (compaction && compaction->owner)
+                compaction->owner->finishCompaction(compaction);
+        });
+}
+
+void UserDefault::finishCompaction(const std::shared_ptr<Compaction>& compaction)
+{
+    if (_compaction != compaction)
+        return;
+    _compaction.reset();
+
+    const auto total = compaction->size + compaction->pending.size();
+    int mapSize      = 4096;
+    while (total > static_cast<size_t>(mapSize))
+        mapSize <<= 1;  // X2
+
+    // the entities appended meanwhile follow the values, then the file replaces the log, complete
+    bool completed = false;
+    if (compaction->written && _rwmmap)
+    {
+        char count[sizeof(udflen_t)];
+        yasio::obstream::swrite(count, static_cast<udflen_t>(compaction->count + compaction->pendingCount));
+
+        auto& pending = compaction->pending;
+        FileStream fs;
+        completed = fs.open(compaction->filePath, IFileStream::Mode::OVERLAPPED) &&
+                    fs.seek(0, SEEK_END) == static_cast<int64_t>(compaction->size) &&
+                    fs.write(pending.data(), static_cast<unsigned int>(pending.size())) ==
+                        static_cast<int>(pending.size()) &&
+                    fs.seek(0, SEEK_SET) == 0 && fs.write(count, sizeof(count)) == sizeof(count) &&
+                    fs.resize(mapSize);
+        fs.close();
+    }
+
+    if (completed)
+    {
+        closeFileMapping();
+        completed = FileUtils::getInstance()->renameFile(compaction->filePath, _filePath);
+
+        // the compacted log or the previous one if it can't be replaced
+        if (_fileStream.open(_filePath, IFileStream::Mode::OVERLAPPED))
+        {
+            _curMapSize = static_cast<int>(_fileStream.size());
+            _rwmmap     = std::make_shared<mio::mmap_sink>(_fileStream.nativeHandle(), 0, mio::map_entire_file);
+            if (!_rwmmap->is_mapped())
+                closeFileMapping();
+            else if (completed)
+                _realSize = static_cast<int>(total - sizeof(udflen_t));
+        }
+        if (!_rwmmap)
+            AXLOGW("UserDefault failed to map '{}' after its compaction.", _filePath);
+    }
+
+    if (!completed)
+        FileUtils::getInstance()->removeFile(compaction->filePath);
 }
 
 UserDefault* UserDefault::getInstance()
@@ -386,6 +560,11 @@ void UserDefault::lazyInit()
 
     int filesize = static_cast<int>(_fileStream.size());
 
+    // a compacted file left by an interrupted compaction
+    const auto compactedPath = _filePath + ".tmp";
+    if (FileUtils::getInstance()->isFileExist(compactedPath))
+        FileUtils::getInstance()->removeFile(compactedPath);
+
     if (filesize < _curMapSize)
     {  // construct a empty file mapping
         if (!_fileStream.resize(_curMapSize))
@@ -400,6 +579,7 @@ void UserDefault::lazyInit()
         _rwmmap = std::make_shared<mio::mmap_sink>(_fileStream.nativeHandle(), 0, mio::map_entire_file);
         if (_rwmmap->is_mapped())
         {  // no error
+            _curMapSize = filesize;
             yasio::ibstream_view ibs(_rwmmap->data(), _rwmmap->length());
 
             if (ibs.length() > 0)
@@ -414,13 +594,19 @@ void UserDefault::lazyInit()
                         std::string value(ibs.read_v());
                         this->encrypt(key, AES_DECRYPT);
                         this->encrypt(value, AES_DECRYPT);
-                        updateValueForKey(key, value);
+                        if (!key.empty() && key[0] == '\0')
+                            eraseValueForKey(std::string_view{key}.substr(1));
+                        else
+                            updateValueForKey(key, value);
                     }
                     else
                     {
                         std::string_view key(ibs.read_v());
                         std::string_view value(ibs.read_v());
-                        updateValueForKey(key, value);
+                        if (!key.empty() && key[0] == '\0')
+                            eraseValueForKey(key.substr(1));
+                        else
+                            updateValueForKey(key, value);
                     }
                 }
                 _realSize = static_cast<int>(ibs.seek(0, SEEK_CUR) - sizeof(udflen_t));
@@ -463,50 +649,17 @@ void UserDefault::lazyInit()
 void UserDefault::flush()
 {
 #if !USER_DEFAULT_PLAIN_MODE
+    commit();
     if (_rwmmap)
     {
-        yasio::obstream obs;
-        obs.write<int>(static_cast<int>(this->_values.size()));
-        for (auto&& item : this->_values)
-        {
-            if (_encryptEnabled)
-            {
-                ud_write_v_s(this, obs, item.first);
-                ud_write_v_s(this, obs, item.second);
-            }
-            else
-            {
-                obs.write_v(item.first);
-                obs.write_v(item.second);
-            }
-        }
-
         std::error_code error;
-        if (obs.length() > _curMapSize)
-        {
-            _rwmmap->unmap();
-            while (obs.length() > _curMapSize)
-                _curMapSize <<= 1;  // X2
-
-            if (!_fileStream.resize(_curMapSize))
-                AXLOGW("UserDefault::flush failed to truncate '{}'.", _filePath);
-
-            _rwmmap->map(_fileStream.nativeHandle(), 0, _curMapSize, error);
-        }
-
-        if (!error && _rwmmap->is_mapped())
-        {  // mapping status is good
-            ::memcpy(_rwmmap->data(), obs.data(), obs.length());
-            _realSize = static_cast<int>(obs.length() - sizeof(udflen_t));
-        }
-        else
-        {
-            // close file mapping and do a simple workaround fix to don't do persist later at this time
-            closeFileMapping();
-            ::remove(_filePath.c_str());
-        }
+        _rwmmap->sync(error);
+        if (error)
+            AXLOGW("UserDefault::flush failed to sync '{}'.", _filePath);
     }
 #else
+    _batching = false;
+
     pugi::xml_document doc;
     doc.load_string(R"(<?xml version="1.0" ?>
 <r />)");
@@ -522,8 +675,47 @@ void UserDefault::flush()
 
 void UserDefault::deleteValueForKey(const char* key)
 {
-    if (this->_values.erase(key) > 0)
+    lazyInit();
+
+    if (!key || !eraseValueForKey(key))
+        return;
+
+#if !USER_DEFAULT_PLAIN_MODE
+    if (_rwmmap)
+    {
+        // a deleted key is logged after a 0 byte, which the keys set can't hold, with an empty value
+        std::string deletedKey(1, '\0');
+        deletedKey += key;
+
+        yasio::obstream obs;
+        ud_write_entity(this, _encryptEnabled, obs, deletedKey, ""sv);
+        appendEntities(std::string_view{obs.data(), obs.length()}, 1);
+    }
+#else
+    if (!_batching)
         flush();
+#endif
+}
+
+void UserDefault::beginBatch()
+{
+    _batching = true;
+}
+
+void UserDefault::commit()
+{
+    if (!_batching)
+        return;
+
+    _batching = false;
+#if !USER_DEFAULT_PLAIN_MODE
+    if (_rwmmap && _batchCount > 0)
+        appendEntities(_batchEntities, _batchCount);
+#else
+    flush();
+#endif
+    _batchEntities.clear();
+    _batchCount = 0;
 }
 
 void UserDefault::setFileName(std::string_view nameFile)
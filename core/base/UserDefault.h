@@ -209,11 +209,25 @@ public:
 
     /**
      * Since we reimplement UserDefault with file mapping io,
-     * you don't needs call this function manually
+     * you don't needs call this function manually.
+     * It commits the batch and syncs the file mapping, it doesn't rewrite the storage file.
      * @js NA
      */
     virtual void flush();
 
+    /**
+     * Starts a batch, the values set and deleted until commit are written to the storage file by commit, all at once.
+     * A crash before the commit loses the whole batch, never a part of it.
+     * @js NA
+     */
+    void beginBatch();
+
+    /**
+     * Writes the values set and deleted since beginBatch.
+     * @js NA
+     */
+    void commit();
+
     /**
      * delete any value by key,
      * @param key The key to delete value.
@@ -280,6 +294,25 @@ protected:
     // Update value without lazyInit
     void updateValueForKey(std::string_view key, std::string_view value);
 
+    // Erase value without lazyInit
+    bool eraseValueForKey(std::string_view key);
+
+    /*
+     * The storage file is a log, the values set and deleted are appended to it, so a write costs the size of the
+     * value only. When the log is much larger than the values, it's compacted on a worker: the values are written to
+     * another file, which replaces the log on the axmol thread once complete.
+     */
+    struct Compaction;
+
+    // Writes entities at the end of the log, or in the batch
+    void appendEntities(std::string_view entities, int count);
+
+    // Maps the storage file with another size, the file grows to it
+    bool remapFile(int mapSize);
+
+    void compactAsync();
+    void finishCompaction(const std::shared_ptr<Compaction>& compaction);
+
 protected:
     hlookup::string_map<std::string> _values;
 
@@ -293,6 +326,13 @@ protected:
     int _realSize     = 0;     // real data size without key/value entities count field
     bool _initialized = false;
 
+    size_t _liveSize = 0;  // the size of the keys and values, to compare with the log
+    std::shared_ptr<Compaction> _compaction;
+
+    std::string _batchEntities;
+    int _batchCount = 0;
+    bool _batching  = false;
+
     // encrpyt args
     bool _encryptEnabled = false;
     std::string _key;
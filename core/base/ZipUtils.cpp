@@ -38,6 +38,9 @@
 #include <memory>
 
 #include <zlib.h>
+#if defined(AX_WITH_FASTLZ)
+#    include "fastlz/fastlz.h"
+#endif
 #include <assert.h>
 #include <stdlib.h>
 #include <set>
@@ -45,6 +48,7 @@
 #include "base/Data.h"
 #include "base/Macros.h"
 #include "platform/FileUtils.h"
+#include "base/Director.h"
 #include <map>
 #include <mutex>
 
@@ -406,10 +410,17 @@ bool ZipUtils::isGZipBuffer(const unsigned char* buffer, ssize_t len)
 
 int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, unsigned char** out)
 {
-    struct CCZHeader* header = (struct CCZHeader*)buffer;
+    if (!isCCZBuffer(buffer, bufferLen))
+    {
+        AXLOGW("Invalid CCZ file");
+        return -1;
+    }
+
+    auto header = (const struct CCZHeader*)buffer;
+    axstd::byte_buffer decrypted;
 
     // verify header
-    if (header->sig[0] == 'C' && header->sig[1] == 'C' && header->sig[2] == 'Z' && header->sig[3] == '!')
+    if (header->sig[3] == '!')
     {
         // verify header version
         unsigned int version = AX_SWAP_INT16_BIG_TO_HOST(header->version);
@@ -418,18 +429,10 @@ int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, u
             AXLOGW("Unsupported CCZ header format");
             return -1;
         }
-
-        // verify compression format
-        if (AX_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB)
-        {
-            AXLOGW("CCZ Unsupported compression method");
-            return -1;
-        }
     }
-    else if (header->sig[0] == 'C' && header->sig[1] == 'C' && header->sig[2] == 'Z' && header->sig[3] == 'p')
+    else
     {
         // encrypted ccz file
-        header = (struct CCZHeader*)buffer;
 
         // verify header version
         unsigned int version = AX_SWAP_INT16_BIG_TO_HOST(header->version);
@@ -439,15 +442,12 @@ int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, u
             return -1;
         }
 
-        // verify compression format
-        if (AX_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB)
-        {
-            AXLOGW("CCZ Unsupported compression method");
-            return -1;
-        }
+        // decrypt a copy, the buffer could be a read only mapping of the file
+        decrypted.assign(buffer, buffer + bufferLen);
+        buffer = decrypted.data();
+        header = (const struct CCZHeader*)buffer;
 
-        // decrypt
-        unsigned int* ints = (unsigned int*)(buffer + 12);
+        unsigned int* ints = (unsigned int*)(decrypted.data() + 12);
         ssize_t enclen     = (bufferLen - 12) / 4;
 
         decodeEncodedPvr(ints, enclen);
@@ -464,11 +464,6 @@ int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, u
         }
 #endif
     }
-    else
-    {
-        AXLOGW("Invalid CCZ file");
-        return -1;
-    }
 
     unsigned int len = AX_SWAP_INT32_BIG_TO_HOST(header->len);
     if (!len)
@@ -479,11 +474,34 @@ int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, u
 
     axstd::byte_buffer outBuffer(len);
 
-    unsigned long destlen = len;
-    size_t source         = (size_t)buffer + sizeof(*header);
-    int ret = uncompress(outBuffer.data(), &destlen, (Bytef*)source, static_cast<uLong>(bufferLen - sizeof(*header)));
+    auto source       = buffer + sizeof(*header);
+    auto sourceLength = static_cast<size_t>(bufferLen - sizeof(*header));
+    bool inflated     = false;
+    switch (AX_SWAP_INT16_BIG_TO_HOST(header->compression_type))
+    {
+    case CCZ_COMPRESSION_ZLIB:
+    {
+        unsigned long destlen = len;
+        inflated = uncompress(outBuffer.data(), &destlen, source, static_cast<uLong>(sourceLength)) == Z_OK;
+        break;
+    }
+#if defined(AX_WITH_FASTLZ)
+    case CCZ_COMPRESSION_FASTLZ:
+        inflated = fastlz_decompress(source, static_cast<int>(sourceLength), outBuffer.data(), static_cast<int>(len)) ==
+                   static_cast<int>(len);
+        break;
+#endif
+    case CCZ_COMPRESSION_NONE:
+        inflated = sourceLength >= len;
+        if (inflated)
+            memcpy(outBuffer.data(), source, len);
+        break;
+    default:
+        AXLOGW("CCZ Unsupported compression method");
+        return -1;
+    }
 
-    if (ret != Z_OK)
+    if (!inflated)
     {
         AXLOGW("CCZ: Failed to uncompress data");
         return -1;
@@ -492,6 +510,54 @@ int ZipUtils::inflateCCZBuffer(const unsigned char* buffer, ssize_t bufferLen, u
     return len;
 }
 
+yasio::byte_buffer ZipUtils::compressCCZ(const void* in, size_t inlen, int compressionType)
+{
+    yasio::byte_buffer output;
+
+    // fastlz doesn't take less than 16 bytes
+    if (compressionType == CCZ_COMPRESSION_FASTLZ && inlen < 16)
+        compressionType = CCZ_COMPRESSION_NONE;
+
+    CCZHeader header{};
+    memcpy(header.sig, "CCZ!", 4);
+    header.compression_type = AX_SWAP_INT16_BIG_TO_HOST(static_cast<unsigned short>(compressionType));
+    header.version          = AX_SWAP_INT16_BIG_TO_HOST(static_cast<unsigned short>(2));
+    header.len              = AX_SWAP_INT32_BIG_TO_HOST(static_cast<unsigned int>(inlen));
+
+    size_t compressedLen = 0;
+    switch (compressionType)
+    {
+    case CCZ_COMPRESSION_ZLIB:
+    {
+        uLong destlen = compressBound(static_cast<uLong>(inlen));
+        output.resize(sizeof(header) + destlen);
+        if (compress(output.data() + sizeof(header), &destlen, (const Bytef*)in, static_cast<uLong>(inlen)) != Z_OK)
+            return {};
+        compressedLen = destlen;
+        break;
+    }
+#if defined(AX_WITH_FASTLZ)
+    case CCZ_COMPRESSION_FASTLZ:
+        // the output must be 5% larger than the input and 66 bytes at least
+        output.resize(sizeof(header) + inlen + inlen / 16 + 66);
+        compressedLen = fastlz_compress_level(2, in, static_cast<int>(inlen), output.data() + sizeof(header));
+        break;
+#endif
+    case CCZ_COMPRESSION_NONE:
+        output.resize(sizeof(header) + inlen);
+        memcpy(output.data() + sizeof(header), in, inlen);
+        compressedLen = inlen;
+        break;
+    default:
+        AXLOGW("CCZ Unsupported compression method");
+        return {};
+    }
+
+    memcpy(output.data(), &header, sizeof(header));
+    output.resize(sizeof(header) + compressedLen);
+    return output;
+}
+
 int ZipUtils::inflateCCZFile(const char* path, unsigned char** out)
 {
     AXASSERT(out, "Invalid pointer for buffer!");
@@ -542,6 +608,11 @@ struct ZipEntryInfo
     unz_file_pos pos;
     uint64_t uncompressed_size;
     uint64_t offset;
+
+    // the entries opened by vopen read through their own handle, left open between the reads
+    unzFile stream = nullptr;
+    uint64_t streamOffset = 0;
+    std::unique_ptr<ourmemory_s> memfs;
 };
 
 struct ZipFilePrivate
@@ -663,6 +734,30 @@ struct ZipFilePrivate
     }
     // End of Overrides
 
+    /** Opens another handle of the zip file, the handles don't share a position so each thread can use its own. */
+    unzFile openHandle(std::unique_ptr<ourmemory_s>& handleMemfs)
+    {
+        if (!memfs)
+            return unzOpen2_64(zipFileName.c_str(), &functionOverrides);
+
+        zlib_filefunc_def memory_file = {0};
+        handleMemfs.reset(new ourmemory_t{memfs->base, memfs->size, 0, 0, 0});
+        fill_memory_filefunc(&memory_file, handleMemfs.get());
+        return unzOpen2(nullptr, &memory_file);
+    }
+
+    static bool readEntry(unzFile handle, ZipEntryInfo& entry, ResizableBuffer* buffer)
+    {
+        if (unzGoToFilePos(handle, &entry.pos) != UNZ_OK || unzOpenCurrentFile(handle) != UNZ_OK)
+            return false;
+
+        // the size in the central directory is exact, no buffer grows
+        buffer->resize(entry.uncompressed_size);
+        int nSize = unzReadCurrentFile(handle, buffer->buffer(), static_cast<unsigned int>(entry.uncompressed_size));
+        unzCloseCurrentFile(handle);
+        return nSize == (int)entry.uncompressed_size;
+    }
+
     std::string zipFileName;
     unzFile zipFile;
     std::mutex zipFileMtx;
@@ -816,27 +911,57 @@ bool ZipFile::getFileData(std::string_view fileName, ResizableBuffer* buffer)
         ZipFilePrivate::FileListContainer::iterator it = _data->fileList.find(fileName);
         AX_BREAK_IF(it == _data->fileList.end());
 
-        ZipEntryInfo& fileInfo = it->second;
-
         std::unique_lock<std::mutex> lck(_data->zipFileMtx);
 
-        int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
-        AX_BREAK_IF(UNZ_OK != nRet);
-
-        nRet = unzOpenCurrentFile(_data->zipFile);
-        AX_BREAK_IF(UNZ_OK != nRet);
-
-        buffer->resize(fileInfo.uncompressed_size);
-        int AX_UNUSED nSize =
-            unzReadCurrentFile(_data->zipFile, buffer->buffer(), static_cast<unsigned int>(fileInfo.uncompressed_size));
-        AXASSERT(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-        unzCloseCurrentFile(_data->zipFile);
-        res = true;
+        res = ZipFilePrivate::readEntry(_data->zipFile, it->second, buffer);
+        AXASSERT(res, "the file size is wrong");
     } while (0);
 
     return res;
 }
 
+std::vector<Data> ZipFile::getFilesData(std::span<const std::string> fileNames)
+{
+    std::vector<Data> results(fileNames.size());
+    if (!_data->zipFile || fileNames.empty())
+        return results;
+
+    // a range of names per worker, read in the order of the central directory through a handle of the range
+    std::vector<std::pair<ZipEntryInfo*, size_t>> entries;
+    entries.reserve(fileNames.size());
+    for (size_t index = 0; index < fileNames.size(); ++index)
+    {
+        auto it = _data->fileList.find(fileNames[index]);
+        if (it != _data->fileList.end())
+            entries.emplace_back(&it->second, index);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](auto& a, auto& b) { return a.first->pos.num_of_file < b.first->pos.num_of_file; });
+
+    if (entries.empty())
+        return results;
+
+    auto jobSystem        = Director::getInstance()->getJobSystem();
+    const auto rangeCount = (std::min)(entries.size(), jobSystem->getWorkerCount() + 1);
+    const auto grainSize  = (entries.size() + rangeCount - 1) / rangeCount;
+    jobSystem->wait(jobSystem->parallelFor(entries.size(), grainSize, [&](size_t begin, size_t end) {
+        std::unique_ptr<ourmemory_s> memfs;
+        auto handle = _data->openHandle(memfs);
+        if (!handle)
+            return;
+        for (auto i = begin; i < end; ++i)
+        {
+            auto& [entry, index] = entries[i];
+            ResizableBufferAdapter<Data> buffer(&results[index]);
+            if (!ZipFilePrivate::readEntry(handle, *entry, &buffer))
+                results[index].clear();
+        }
+        unzClose(handle);
+    }));
+
+    return results;
+}
+
 std::string ZipFile::getFirstFilename()
 {
     if (unzGoToFirstFile(_data->zipFile) != UNZ_OK)
@@ -892,7 +1017,7 @@ ZipEntryInfo* ZipFile::vopen(std::string_view fileName)
 {
     auto it = _data->fileList.find(fileName);
     if (it != _data->fileList.end())
-        return &it->second;
+        return new ZipEntryInfo{it->second.pos, it->second.uncompressed_size, 0};
 
     return nullptr;
 }
@@ -904,19 +1029,49 @@ int ZipFile::vread(ZipEntryInfo* entry, void* buf, unsigned int size)
     {
         AX_BREAK_IF(entry == nullptr || entry->offset >= entry->uncompressed_size);
 
-        std::unique_lock<std::mutex> lck(_data->zipFileMtx);
+        if (entry->stream && entry->offset != entry->streamOffset &&
+            unzSeek64(entry->stream, entry->offset, SEEK_SET) == UNZ_OK)
+            entry->streamOffset = entry->offset;
 
-        int nRet = unzGoToFilePos(_data->zipFile, &entry->pos);
-        AX_BREAK_IF(UNZ_OK != nRet);
+        // a compressed entry can't seek, it's inflated again from the start to go back
+        if (entry->stream && entry->offset < entry->streamOffset)
+        {
+            unzCloseCurrentFile(entry->stream);
+            unzClose(entry->stream);
+            entry->stream = nullptr;
+        }
+        if (!entry->stream)
+        {
+            entry->stream = _data->openHandle(entry->memfs);
+            AX_BREAK_IF(!entry->stream);
+            entry->streamOffset = 0;
+            if (unzGoToFilePos(entry->stream, &entry->pos) != UNZ_OK || unzOpenCurrentFile(entry->stream) != UNZ_OK)
+            {
+                unzClose(entry->stream);
+                entry->stream = nullptr;
+                break;
+            }
+        }
 
-        nRet = unzOpenCurrentFile(_data->zipFile);
-        unzSeek64(_data->zipFile, entry->offset, SEEK_SET);
-        n = unzReadCurrentFile(_data->zipFile, buf, size);
+        // skip forward by reading
+        char skipped[4096];
+        while (entry->streamOffset < entry->offset)
+        {
+            auto skip =
+                static_cast<unsigned int>((std::min)(entry->offset - entry->streamOffset, (uint64_t)sizeof(skipped)));
+            auto read = unzReadCurrentFile(entry->stream, skipped, skip);
+            if (read <= 0)
+                break;
+            entry->streamOffset += read;
+        }
+        AX_BREAK_IF(entry->streamOffset != entry->offset);
+
+        n = unzReadCurrentFile(entry->stream, buf, size);
         if (n > 0)
+        {
             entry->offset += n;
-
-        unzCloseCurrentFile(_data->zipFile);
-
+            entry->streamOffset = entry->offset;
+        }
     } while (false);
 
     return n;
@@ -953,7 +1108,14 @@ int64_t ZipFile::vseek(ZipEntryInfo* entry, int64_t offset, int origin)
 void ZipFile::vclose(ZipEntryInfo* entry)
 {
     if (entry != nullptr)
-        entry->offset = 0;
+    {
+        if (entry->stream)
+        {
+            unzCloseCurrentFile(entry->stream);
+            unzClose(entry->stream);
+        }
+        delete entry;
+    }
 }
 
 int64_t ZipFile::vsize(ZipEntryInfo* entry)
@@ -72,7 +72,8 @@ enum
     CCZ_COMPRESSION_ZLIB,  /** zlib format. */
     CCZ_COMPRESSION_BZIP2, /** bzip2 format (not supported yet). */
     CCZ_COMPRESSION_GZIP,  /** gzip format (not supported yet). */
-    CCZ_COMPRESSION_NONE,  /** plain (not supported yet). */
+    CCZ_COMPRESSION_NONE,  /** plain. */
+    CCZ_COMPRESSION_FASTLZ, /** fastlz format, several times faster to inflate than zlib, when built with fastlz. */
 };
 
 class AX_DLL ZipUtils
@@ -156,6 +157,15 @@ public:
      */
     static int inflateCCZBuffer(const unsigned char* buffer, ssize_t len, unsigned char** out);
 
+    /**
+     * Compresses a buffer in the CCZ format, with one of the CCZ_COMPRESSION methods, except bzip2 and gzip.
+     * The files compressed with CCZ_COMPRESSION_FASTLZ are inflated faster, but they are larger than with zlib.
+     * Images, plist and xml files loaded through SAXParser are recognized and inflated whatever the method.
+     *
+     * @return The CCZ buffer, empty if the compression fails.
+     */
+    static yasio::byte_buffer compressCCZ(const void* in, size_t inlen, int compressionType);
+
     /**
      * Test a file is a CCZ format file or not.
      *
@@ -297,12 +307,20 @@ public:
      */
     bool getFileData(std::string_view fileName, ResizableBuffer* buffer);
 
+    /**
+     * Get the data of several files, read on the JobSystem workers through a handle of the zip file each, and waits
+     * for them.
+     * @param fileNames File names
+     * @return The data in the order of the names, null for the files which can't be read.
+     */
+    std::vector<Data> getFilesData(std::span<const std::string> fileNames);
+
     std::string getFirstFilename();
     std::string getNextFilename();
 
     /**
-     * zipFile Streaming support, !!!important, the file in zip must no compress level, otherwise
-     *  stream seek doesn't work.
+     * zipFile Streaming support, every vopen returns a stream reading through its own handle of the zip file, release it
+     * with vclose. The reads are sequential, a backward seek in a compressed file inflates it again from the start.
      */
     ZipEntryInfo* vopen(std::string_view fileName);
     int vread(ZipEntryInfo*, void* buf, unsigned int size);
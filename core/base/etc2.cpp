@@ -39,6 +39,9 @@
 #include <algorithm>
 #include <limits>
 
+#include "base/Director.h"
+#include "base/JobSystem.h"
+
 static const char ketc2Magic[] = {'P', 'K', 'M', ' ', '2', '0'};
 
 static const etc2_uint32 ETC2_PKM_FORMAT_OFFSET         = 6;
@@ -992,7 +995,25 @@ int etc2_decode_image(int format, const etc2_byte* input, etc2_byte* output, etc
     if (loadTexture) {
         size_t inputRowPitch = ComputeETC2RowPitch(width, 4 /*blockWidth*/, bytesPerPixel);
         size_t inputDepthPitch = ComputeETC2DepthPitch(height, 4 /*blockHeight*/, inputRowPitch);
-        loadTexture(width, height, 1, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+
+        // the block rows are decoded independently, split them over the workers for the large images
+        size_t blockRows = (height + 3) / 4;
+        auto jobSystem = ax::Director::getInstance()->getJobSystem();
+        size_t workerCount = jobSystem->getWorkerCount();
+        if (workerCount == 0 || blockRows < 16)
+        {
+            loadTexture(width, height, 1, input, inputRowPitch, inputDepthPitch, output, outputRowPitch,
+                        outputDepthPitch);
+            return 0;
+        }
+
+        size_t grainSize = std::max<size_t>(4, blockRows / (workerCount * 4));
+        auto handle = jobSystem->parallelFor(blockRows, grainSize, [=](size_t begin, size_t end) {
+            size_t rows = std::min<size_t>(height - begin * 4, (end - begin) * 4);
+            loadTexture(width, rows, 1, input + begin * inputRowPitch, inputRowPitch, inputDepthPitch,
+                        output + begin * 4 * outputRowPitch, outputRowPitch, outputDepthPitch);
+        });
+        jobSystem->wait(handle);
         return 0;
     }
 
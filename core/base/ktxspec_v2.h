@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <stdint.h>
+
+#define KTX_V2_HEADER_SIZE 80
+
+#define KTX_V2_MAGIC "KTX 20"
+
+// ktxv2 header, refer to: https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+struct KTXv2Header
+{
+    // the VkFormat values of the formats axmol can upload or decode
+    struct VkFormat
+    {
+        enum
+        {
+            UNDEFINED = 0,  // Basis Universal
+
+            R8_UNORM       = 9,
+            R8G8_UNORM     = 16,
+            R8G8B8_UNORM   = 23,
+            R8G8B8_SRGB    = 29,
+            R8G8B8A8_UNORM = 37,
+            R8G8B8A8_SRGB  = 43,
+            B8G8R8A8_UNORM = 44,
+            B8G8R8A8_SRGB  = 50,
+
+            BC1_RGB_UNORM_BLOCK  = 131,
+            BC1_RGB_SRGB_BLOCK   = 132,
+            BC1_RGBA_UNORM_BLOCK = 133,
+            BC1_RGBA_SRGB_BLOCK  = 134,
+            BC2_UNORM_BLOCK      = 135,
+            BC2_SRGB_BLOCK       = 136,
+            BC3_UNORM_BLOCK      = 137,
+            BC3_SRGB_BLOCK       = 138,
+
+            ETC2_R8G8B8_UNORM_BLOCK   = 147,
+            ETC2_R8G8B8_SRGB_BLOCK    = 148,
+            ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+            ETC2_R8G8B8A8_SRGB_BLOCK  = 152,
+
+            // the ASTC formats run from ASTC_4x4_UNORM_BLOCK to ASTC_12x12_SRGB_BLOCK, unorm and srgb alternating
+            ASTC_4x4_UNORM_BLOCK  = 157,
+            ASTC_12x12_SRGB_BLOCK = 184,
+
+            PVRTC1_2BPP_UNORM_BLOCK_IMG = 1000054000,
+            PVRTC1_4BPP_UNORM_BLOCK_IMG = 1000054001,
+            PVRTC1_2BPP_SRGB_BLOCK_IMG  = 1000054004,
+            PVRTC1_4BPP_SRGB_BLOCK_IMG  = 1000054005,
+        };
+    };
+
+    struct SupercompressionScheme
+    {
+        enum
+        {
+            NONE      = 0,
+            BASIS_LZ  = 1,
+            ZSTANDARD = 2,
+            ZLIB      = 3,
+        };
+    };
+
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+// follows the header, one per mip level, level 0 first
+struct KTXv2LevelIndex
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// the basic block of the data format descriptor
+struct KTXv2BasicDFD
+{
+    struct ColorModel
+    {
+        enum
+        {
+            ETC1S = 163,
+            UASTC = 166,
+        };
+    };
+
+    struct Flags
+    {
+        enum
+        {
+            ALPHA_PREMULTIPLIED = 1,
+        };
+    };
+
+    uint32_t totalSize;
+    uint32_t vendorIdAndDescriptorType;
+    uint16_t versionNumber;
+    uint16_t descriptorBlockSize;
+    uint8_t colorModel;
+    uint8_t colorPrimaries;
+    uint8_t transferFunction;
+    uint8_t flags;
+};
@@ -22,20 +22,26 @@ This file was modified to fit the axmol project
 
 #include "math/MathUtil.h"
 #include "math/Mat4.h"
+#include "math/Vec2.h"
+#include "math/Vec3.h"
 #include "base/Macros.h"
+#include <algorithm>
 
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID)
 #    include <cpu-features.h>
 #endif
 
-#if defined(AX_SSE_INTRINSICS)
+// the SIMD kernels fall back to the C ones for the remainders of arrays
+#include "math/MathUtil.inl"
+
+#if defined(AX_WASM_SIMD_INTRINSICS)
+#    include "math/MathUtilWasm.inl"
+#elif defined(AX_SSE_INTRINSICS)
 #    include "math/MathUtilSSE.inl"
 #elif defined(AX_NEON_INTRINSICS)
 #    include "math/MathUtilNeon.inl"
 #endif
 
-#include "math/MathUtil.inl"
-
 NS_AX_MATH_BEGIN
 
 void MathUtil::smooth(float* x, float target, float elapsedTime, float responseTime)
@@ -317,4 +323,66 @@ void MathUtil::transformIndices(uint16_t* dst, const uint16_t* src, size_t count
 #endif
 }
 
+// the NEON kernels of 32 bits builds are used when the CPU supports them only
+#if defined(AX_SSE_INTRINSICS)
+#    define AX_ARRAY_KERNEL(call) MathUtilSSE::call
+#elif defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1)
+#    define AX_ARRAY_KERNEL(call) MathUtilNeon::call
+#elif defined(AX_NEON_INTRINSICS)
+#    define AX_ARRAY_KERNEL(call) (isNeon32Enabled() ? MathUtilNeon::call : MathUtilC::call)
+#else
+#    define AX_ARRAY_KERNEL(call) MathUtilC::call
+#endif
+
+void MathUtil::transformVec2(const Mat4& m, const Vec2* src, Vec2* dst, size_t count)
+{
+    static_assert(sizeof(Vec2) == sizeof(float) * 2);
+    AX_ARRAY_KERNEL(transformVec2(m.m, &src->x, &dst->x, count));
+}
+
+void MathUtil::transformVec3(const Mat4& m, const Vec3* src, Vec3* dst, size_t count)
+{
+    static_assert(sizeof(Vec3) == sizeof(float) * 3);
+    AX_ARRAY_KERNEL(transformVec3(m.m, &src->x, &dst->x, count));
+}
+
+void MathUtil::transformVec2(const Mat4& m, const float* x, const float* y, float* dstX, float* dstY, size_t count)
+{
+    AX_ARRAY_KERNEL(transformVec2(m.m, x, y, dstX, dstY, count));
+}
+
+void MathUtil::addScaled(float* dst, const float* src, float scale, size_t count)
+{
+    AX_ARRAY_KERNEL(addScaled(dst, src, scale, count));
+}
+
+void MathUtil::lerp(const float* from, const float* to, float alpha, float* dst, size_t count)
+{
+    AX_ARRAY_KERNEL(lerp(from, to, alpha, dst, count));
+}
+
+void MathUtil::clamp(float* values, size_t count, float min, float max)
+{
+    AX_ARRAY_KERNEL(clamp(values, count, min, max));
+}
+
+void MathUtil::sampleBilinear(const float* grid,
+                              int width,
+                              int height,
+                              const Vec2* points,
+                              float* dst,
+                              size_t count,
+                              float outside)
+{
+    // the kernels read the cells around the points out of the grid too
+    if (width < 2 || height < 2)
+    {
+        std::fill(dst, dst + count, outside);
+        return;
+    }
+    AX_ARRAY_KERNEL(sampleBilinear(grid, width, height, &points->x, dst, count, outside));
+}
+
+#undef AX_ARRAY_KERNEL
+
 NS_AX_MATH_END
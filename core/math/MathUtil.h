@@ -39,7 +39,10 @@ namespace ax
 
 NS_AX_MATH_BEGIN
 
+class Vec2;
+class Vec3;
 class Vec4;
+class Mat4;
 
 /**
  * Defines a math utility class.
@@ -51,6 +54,7 @@ class AX_DLL MathUtil
     friend class Mat4;
     friend class Vec3;
     friend class Renderer;
+    friend class StaticBatch;
 
 public:
     /**
@@ -94,6 +98,49 @@ public:
      */
     static float lerp(float from, float to, float alpha);
 
+    /**
+     * @name Array kernels
+     * SIMD kernels processing arrays, dst may be the source in all of them.
+     * @{
+     */
+
+    /**
+     * Transform the points of src by a matrix, z = 0 and w = 1 are assumed and the result isn't divided by w.
+     */
+    static void transformVec2(const Mat4& m, const Vec2* src, Vec2* dst, size_t count);
+
+    /** Transform the points of src by a matrix, w = 1 is assumed and the result isn't divided by w. */
+    static void transformVec3(const Mat4& m, const Vec3* src, Vec3* dst, size_t count);
+
+    /** Transform the points of the x and y arrays by a matrix like transformVec2. */
+    static void transformVec2(const Mat4& m, const float* x, const float* y, float* dstX, float* dstY, size_t count);
+
+    /** Transform the positions of vertices by a matrix, the colors and texture coordinates are copied. */
+    static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform);
+
+    /** dst[i] += src[i] * scale */
+    static void addScaled(float* dst, const float* src, float scale, size_t count);
+
+    /** dst[i] = from[i] + (to[i] - from[i]) * alpha */
+    static void lerp(const float* from, const float* to, float alpha, float* dst, size_t count);
+
+    /** Clamp the values to [min, max]. */
+    static void clamp(float* values, size_t count, float min, float max);
+
+    /**
+     * Sample a grid of width x height values bilinearly at points in grid cells, the value of cell (x, y) is
+     * grid[y * width + x]. The points out of [0, width - 1) x [0, height - 1) get outside.
+     */
+    static void sampleBilinear(const float* grid,
+                               int width,
+                               int height,
+                               const Vec2* points,
+                               float* dst,
+                               size_t count,
+                               float outside = 0.0f);
+
+    /** @} */
+
 private:
     // Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -119,7 +166,6 @@ private:
 
     static void crossVec3(const float* v1, const float* v2, float* dst);
 
-    static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform);
     static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset);
 };
 
@@ -203,7 +203,8 @@ public:
             dst->vertices.x = pos.x * m[0] + pos.y * m[4] + pos.z * m[8] + m[12];
             dst->vertices.y = pos.x * m[1] + pos.y * m[5] + pos.z * m[9] + m[13];
             dst->vertices.z = pos.x * m[2] + pos.y * m[6] + pos.z * m[10] + m[14];
-            memcpy(&dst->colors, &src->colors, sizeof(V3F_C4B_T2F::colors) + sizeof(V3F_C4B_T2F::texCoords));
+            if (dst != src)
+                memcpy(&dst->colors, &src->colors, sizeof(V3F_C4B_T2F::colors) + sizeof(V3F_C4B_T2F::texCoords));
             ++dst;
             ++src;
         }
@@ -219,6 +220,95 @@ public:
             ++src;
         }
     }
+
+    inline static void transformVec2(const float* m, const float* src, float* dst, size_t count)
+    {
+        for (size_t i = 0; i < count * 2; i += 2)
+        {
+            float x    = src[i];
+            float y    = src[i + 1];
+            dst[i]     = x * m[0] + y * m[4] + m[12];
+            dst[i + 1] = x * m[1] + y * m[5] + m[13];
+        }
+    }
+
+    inline static void transformVec3(const float* m, const float* src, float* dst, size_t count)
+    {
+        for (size_t i = 0; i < count * 3; i += 3)
+        {
+            float x    = src[i];
+            float y    = src[i + 1];
+            float z    = src[i + 2];
+            dst[i]     = x * m[0] + y * m[4] + z * m[8] + m[12];
+            dst[i + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+            dst[i + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+        }
+    }
+
+    inline static void transformVec2(const float* m,
+                                     const float* x,
+                                     const float* y,
+                                     float* dstX,
+                                     float* dstY,
+                                     size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float px = x[i];
+            float py = y[i];
+            dstX[i]  = px * m[0] + py * m[4] + m[12];
+            dstY[i]  = px * m[1] + py * m[5] + m[13];
+        }
+    }
+
+    inline static void addScaled(float* dst, const float* src, float scale, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] += src[i] * scale;
+    }
+
+    inline static void lerp(const float* from, const float* to, float alpha, float* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = from[i] + (to[i] - from[i]) * alpha;
+    }
+
+    inline static void clamp(float* values, size_t count, float min, float max)
+    {
+        for (size_t i = 0; i < count; ++i)
+            values[i] = values[i] < min ? min : (values[i] > max ? max : values[i]);
+    }
+
+    inline static void sampleBilinear(const float* grid,
+                                      int width,
+                                      int height,
+                                      const float* points,
+                                      float* dst,
+                                      size_t count,
+                                      float outside)
+    {
+        const float maxX = static_cast<float>(width - 1);
+        const float maxY = static_cast<float>(height - 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float px = points[i * 2];
+            float py = points[i * 2 + 1];
+            if (!(px >= 0 && px < maxX && py >= 0 && py < maxY))
+            {
+                dst[i] = outside;
+                continue;
+            }
+
+            int ix            = static_cast<int>(px);
+            int iy            = static_cast<int>(py);
+            float u           = px - ix;
+            float v           = py - iy;
+            const float* cell = grid + iy * width + ix;
+            float top         = cell[0] + (cell[1] - cell[0]) * u;
+            float bottom      = cell[width] + (cell[width + 1] - cell[width]) * u;
+            dst[i]            = top + (bottom - top) * v;
+        }
+    }
 };
 
 NS_AX_MATH_END
@@ -146,6 +146,137 @@ struct MathUtilNeon
         vst1_lane_f32(dst + 2, vget_high_f32(prod), 0);  // Store the 3rd element
     }
 
+    inline static void transformVec2(const float* m, const float* src, float* dst, size_t count)
+    {
+        float32x4_t m12 = vdupq_n_f32(m[12]), m13 = vdupq_n_f32(m[13]);
+
+        // 4 points at a time, vld2q deinterleaves them to x and y lanes
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x2_t v = vld2q_f32(src + i * 2);
+            float32x4x2_t r;
+            r.val[0] = vmlaq_n_f32(vmlaq_n_f32(m12, v.val[0], m[0]), v.val[1], m[4]);
+            r.val[1] = vmlaq_n_f32(vmlaq_n_f32(m13, v.val[0], m[1]), v.val[1], m[5]);
+            vst2q_f32(dst + i * 2, r);
+        }
+        MathUtilC::transformVec2(m, src + i * 2, dst + i * 2, count - i);
+    }
+
+    inline static void transformVec3(const float* m, const float* src, float* dst, size_t count)
+    {
+        float32x4_t m12 = vdupq_n_f32(m[12]), m13 = vdupq_n_f32(m[13]), m14 = vdupq_n_f32(m[14]);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x3_t v = vld3q_f32(src + i * 3);
+            float32x4x3_t r;
+            r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(m12, v.val[0], m[0]), v.val[1], m[4]), v.val[2], m[8]);
+            r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(m13, v.val[0], m[1]), v.val[1], m[5]), v.val[2], m[9]);
+            r.val[2] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(m14, v.val[0], m[2]), v.val[1], m[6]), v.val[2], m[10]);
+            vst3q_f32(dst + i * 3, r);
+        }
+        MathUtilC::transformVec3(m, src + i * 3, dst + i * 3, count - i);
+    }
+
+    inline static void transformVec2(const float* m,
+                                     const float* x,
+                                     const float* y,
+                                     float* dstX,
+                                     float* dstY,
+                                     size_t count)
+    {
+        float32x4_t m12 = vdupq_n_f32(m[12]), m13 = vdupq_n_f32(m[13]);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t px = vld1q_f32(x + i);
+            float32x4_t py = vld1q_f32(y + i);
+            vst1q_f32(dstX + i, vmlaq_n_f32(vmlaq_n_f32(m12, px, m[0]), py, m[4]));
+            vst1q_f32(dstY + i, vmlaq_n_f32(vmlaq_n_f32(m13, px, m[1]), py, m[5]));
+        }
+        MathUtilC::transformVec2(m, x + i, y + i, dstX + i, dstY + i, count - i);
+    }
+
+    inline static void addScaled(float* dst, const float* src, float scale, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), scale));
+        MathUtilC::addScaled(dst + i, src + i, scale, count - i);
+    }
+
+    inline static void lerp(const float* from, const float* to, float alpha, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t f = vld1q_f32(from + i);
+            vst1q_f32(dst + i, vmlaq_n_f32(f, vsubq_f32(vld1q_f32(to + i), f), alpha));
+        }
+        MathUtilC::lerp(from + i, to + i, alpha, dst + i, count - i);
+    }
+
+    inline static void clamp(float* values, size_t count, float min, float max)
+    {
+        float32x4_t lo = vdupq_n_f32(min), hi = vdupq_n_f32(max);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(values + i, vminq_f32(vmaxq_f32(vld1q_f32(values + i), lo), hi));
+        MathUtilC::clamp(values + i, count - i, min, max);
+    }
+
+    inline static void sampleBilinear(const float* grid,
+                                      int width,
+                                      int height,
+                                      const float* points,
+                                      float* dst,
+                                      size_t count,
+                                      float outside)
+    {
+        float32x4_t zero = vdupq_n_f32(0.0f), out = vdupq_n_f32(outside);
+        float32x4_t maxX = vdupq_n_f32(static_cast<float>(width - 1));
+        float32x4_t maxY = vdupq_n_f32(static_cast<float>(height - 1));
+        int32x4_t w      = vdupq_n_s32(width);
+        int32_t index[4];
+        float h00[4], h10[4], h01[4], h11[4];
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x2_t p = vld2q_f32(points + i * 2);
+
+            // the points out of the grid, NaN included, sample the first cell and get outside
+            uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(p.val[0], zero), vcltq_f32(p.val[0], maxX)),
+                                          vandq_u32(vcgeq_f32(p.val[1], zero), vcltq_f32(p.val[1], maxY)));
+            float32x4_t px    = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(p.val[0]), inside));
+            float32x4_t py    = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(p.val[1]), inside));
+
+            int32x4_t ix  = vcvtq_s32_f32(px);
+            int32x4_t iy  = vcvtq_s32_f32(py);
+            float32x4_t u = vsubq_f32(px, vcvtq_f32_s32(ix));
+            float32x4_t v = vsubq_f32(py, vcvtq_f32_s32(iy));
+            vst1q_s32(index, vmlaq_s32(ix, iy, w));
+
+            for (int k = 0; k < 4; ++k)
+            {
+                const float* cell = grid + index[k];
+                h00[k]            = cell[0];
+                h10[k]            = cell[1];
+                h01[k]            = cell[width];
+                h11[k]            = cell[width + 1];
+            }
+
+            float32x4_t top    = vmlaq_f32(vld1q_f32(h00), vsubq_f32(vld1q_f32(h10), vld1q_f32(h00)), u);
+            float32x4_t bottom = vmlaq_f32(vld1q_f32(h01), vsubq_f32(vld1q_f32(h11), vld1q_f32(h01)), u);
+            vst1q_f32(dst + i, vbslq_f32(inside, vmlaq_f32(top, vsubq_f32(bottom, top), v), out));
+        }
+        MathUtilC::sampleBilinear(grid, width, height, points + i * 2, dst + i, count - i, outside);
+    }
+
 #if AX_64BITS
     inline static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform)
     {
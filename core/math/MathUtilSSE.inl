@@ -241,12 +241,15 @@ struct MathUtilSSE
             v          = _mm_add_ps(
                 _mm_add_ps(_mm_mul_ps(m[0], _mm_shuffle_ps(v, v, 0)), _mm_mul_ps(m[1], _mm_shuffle_ps(v, v, 0x55))),
                 _mm_add_ps(_mm_mul_ps(m[2], _mm_shuffle_ps(v, v, 0xaa)), _mm_mul_ps(m[3], _mm_shuffle_ps(v, v, 0xff))));
-            _mm_storeu_ps((float*)&dst[i].vertices, v);
 
-            // Copy tex coords and colors
+            // Copy tex coords and colors, read first since the 4 floats stored overlap the colors of dst,
+            // which may be src
             // dst[i].texCoords = src[i].texCoords;
             // dst[i].colors    = src[i].colors;
-            memcpy(&dst[i].colors, &src[i].colors, sizeof(V3F_C4B_T2F::colors) + sizeof(V3F_C4B_T2F::texCoords));
+            uint8_t attribs[sizeof(V3F_C4B_T2F::colors) + sizeof(V3F_C4B_T2F::texCoords)];
+            memcpy(attribs, &src[i].colors, sizeof(attribs));
+            _mm_storeu_ps((float*)&dst[i].vertices, v);
+            memcpy(&dst[i].colors, attribs, sizeof(attribs));
         }
     }
 
@@ -269,6 +272,138 @@ struct MathUtilSSE
             dst[rounded_count + i] = src[rounded_count + i] + offset;
         }
     }
+
+    static void transformVec2(const float* m, const float* src, float* dst, size_t count)
+    {
+        __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+        __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]);
+
+        // 4 points at a time: deinterleave to x and y lanes, transform, interleave back
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a  = _mm_loadu_ps(src + i * 2);      // x0 y0 x1 y1
+            __m128 b  = _mm_loadu_ps(src + i * 2 + 4);  // x2 y2 x3 y3
+            __m128 x  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 y  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), m12);
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m5)), m13);
+            _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(rx, ry));
+            _mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(rx, ry));
+        }
+        MathUtilC::transformVec2(m, src + i * 2, dst + i * 2, count - i);
+    }
+
+    static void transformVec3(const float* m, const float* src, float* dst, size_t count)
+    {
+        __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+
+        for (size_t i = 0; i < count * 3; i += 3)
+        {
+            __m128 xy  = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[i])), _mm_mul_ps(c1, _mm_set1_ps(src[i + 1])));
+            __m128 res = _mm_add_ps(xy, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(src[i + 2])), c3));
+
+            // 3 floats only, a 4th one would overwrite the next point
+            _mm_storel_pi((__m64*)(dst + i), res);
+            _mm_store_ss(dst + i + 2, _mm_movehl_ps(res, res));
+        }
+    }
+
+    static void transformVec2(const float* m, const float* x, const float* y, float* dstX, float* dstY, size_t count)
+    {
+        __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+        __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 px = _mm_loadu_ps(x + i);
+            __m128 py = _mm_loadu_ps(y + i);
+            _mm_storeu_ps(dstX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m0), _mm_mul_ps(py, m4)), m12));
+            _mm_storeu_ps(dstY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m1), _mm_mul_ps(py, m5)), m13));
+        }
+        MathUtilC::transformVec2(m, x + i, y + i, dstX + i, dstY + i, count - i);
+    }
+
+    static void addScaled(float* dst, const float* src, float scale, size_t count)
+    {
+        __m128 s = _mm_set1_ps(scale);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s)));
+        MathUtilC::addScaled(dst + i, src + i, scale, count - i);
+    }
+
+    static void lerp(const float* from, const float* to, float alpha, float* dst, size_t count)
+    {
+        __m128 a = _mm_set1_ps(alpha);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 f = _mm_loadu_ps(from + i);
+            _mm_storeu_ps(dst + i, _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to + i), f), a)));
+        }
+        MathUtilC::lerp(from + i, to + i, alpha, dst + i, count - i);
+    }
+
+    static void clamp(float* values, size_t count, float min, float max)
+    {
+        __m128 lo = _mm_set1_ps(min), hi = _mm_set1_ps(max);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(values + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(values + i), lo), hi));
+        MathUtilC::clamp(values + i, count - i, min, max);
+    }
+
+    static void sampleBilinear(const float* grid,
+                               int width,
+                               int height,
+                               const float* points,
+                               float* dst,
+                               size_t count,
+                               float outside)
+    {
+        __m128 zero = _mm_setzero_ps(), out = _mm_set1_ps(outside), w = _mm_set1_ps(static_cast<float>(width));
+        __m128 maxX = _mm_set1_ps(static_cast<float>(width - 1)), maxY = _mm_set1_ps(static_cast<float>(height - 1));
+        alignas(16) int index[4];
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 p0 = _mm_loadu_ps(points + i * 2);
+            __m128 p1 = _mm_loadu_ps(points + i * 2 + 4);
+            __m128 px = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 py = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+
+            // the points out of the grid, NaN included, sample the first cell and get outside
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(px, zero), _mm_cmplt_ps(px, maxX)),
+                                       _mm_and_ps(_mm_cmpge_ps(py, zero), _mm_cmplt_ps(py, maxY)));
+            px            = _mm_and_ps(px, inside);
+            py            = _mm_and_ps(py, inside);
+
+            // truncated, the indices are exact below 2^24 cells
+            __m128 fx = _mm_cvtepi32_ps(_mm_cvttps_epi32(px));
+            __m128 fy = _mm_cvtepi32_ps(_mm_cvttps_epi32(py));
+            __m128 u  = _mm_sub_ps(px, fx);
+            __m128 v  = _mm_sub_ps(py, fy);
+            _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(fy, w), fx)));
+
+            const float *c0 = grid + index[0], *c1 = grid + index[1], *c2 = grid + index[2], *c3 = grid + index[3];
+            __m128 h00 = _mm_setr_ps(c0[0], c1[0], c2[0], c3[0]);
+            __m128 h10 = _mm_setr_ps(c0[1], c1[1], c2[1], c3[1]);
+            __m128 h01 = _mm_setr_ps(c0[width], c1[width], c2[width], c3[width]);
+            __m128 h11 = _mm_setr_ps(c0[width + 1], c1[width + 1], c2[width + 1], c3[width + 1]);
+
+            __m128 top    = _mm_add_ps(h00, _mm_mul_ps(_mm_sub_ps(h10, h00), u));
+            __m128 bottom = _mm_add_ps(h01, _mm_mul_ps(_mm_sub_ps(h11, h01), u));
+            __m128 h      = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), v));
+            _mm_storeu_ps(dst + i, _mm_or_ps(_mm_and_ps(inside, h), _mm_andnot_ps(inside, out)));
+        }
+        MathUtilC::sampleBilinear(grid, width, height, points + i * 2, dst + i, count - i, outside);
+    }
 };
 
 #endif
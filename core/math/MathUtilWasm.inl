@@ -0,0 +1,320 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <wasm_simd128.h>
+
+NS_AX_MATH_BEGIN
+
+#ifdef AX_WASM_SIMD_INTRINSICS
+
+/**
+ * The kernels of the wasm-simd builds, written with the wasm SIMD128 intrinsics instead of the SSE ones emscripten
+ * emulates. Mat4 keeps its __m128 columns, they are loaded and stored as v128_t.
+ */
+struct MathUtilWasm
+{
+    static v128_t madd(v128_t a, v128_t b, v128_t c)
+    {
+#    if defined(__wasm_relaxed_simd__)
+        return wasm_f32x4_relaxed_madd(a, b, c);
+#    else
+        return wasm_f32x4_add(wasm_f32x4_mul(a, b), c);
+#    endif
+    }
+
+    static void addMatrix(const _xm128_t m[4], float scalar, _xm128_t dst[4])
+    {
+        v128_t s = wasm_f32x4_splat(scalar);
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, wasm_f32x4_add(wasm_v128_load(m + i), s));
+    }
+
+    static void addMatrix(const _xm128_t m1[4], const _xm128_t m2[4], _xm128_t dst[4])
+    {
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, wasm_f32x4_add(wasm_v128_load(m1 + i), wasm_v128_load(m2 + i)));
+    }
+
+    static void subtractMatrix(const _xm128_t m1[4], const _xm128_t m2[4], _xm128_t dst[4])
+    {
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, wasm_f32x4_sub(wasm_v128_load(m1 + i), wasm_v128_load(m2 + i)));
+    }
+
+    static void multiplyMatrix(const _xm128_t m[4], float scalar, _xm128_t dst[4])
+    {
+        v128_t s = wasm_f32x4_splat(scalar);
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, wasm_f32x4_mul(wasm_v128_load(m + i), s));
+    }
+
+    static void multiplyMatrix(const _xm128_t m1[4], const _xm128_t m2[4], _xm128_t dst[4])
+    {
+        v128_t a0 = wasm_v128_load(m1), a1 = wasm_v128_load(m1 + 1);
+        v128_t a2 = wasm_v128_load(m1 + 2), a3 = wasm_v128_load(m1 + 3);
+
+        // dst may be m1 or m2, the columns are all computed before being stored
+        v128_t res[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            v128_t b = wasm_v128_load(m2 + i);
+            v128_t c = wasm_f32x4_mul(a0, wasm_i32x4_shuffle(b, b, 0, 0, 0, 0));
+            c        = madd(a1, wasm_i32x4_shuffle(b, b, 1, 1, 1, 1), c);
+            c        = madd(a2, wasm_i32x4_shuffle(b, b, 2, 2, 2, 2), c);
+            res[i]   = madd(a3, wasm_i32x4_shuffle(b, b, 3, 3, 3, 3), c);
+        }
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, res[i]);
+    }
+
+    static void negateMatrix(const _xm128_t m[4], _xm128_t dst[4])
+    {
+        for (int i = 0; i < 4; ++i)
+            wasm_v128_store(dst + i, wasm_f32x4_neg(wasm_v128_load(m + i)));
+    }
+
+    static void transposeMatrix(const _xm128_t m[4], _xm128_t dst[4])
+    {
+        v128_t m0 = wasm_v128_load(m), m1 = wasm_v128_load(m + 1);
+        v128_t m2 = wasm_v128_load(m + 2), m3 = wasm_v128_load(m + 3);
+
+        v128_t tmp0 = wasm_i32x4_shuffle(m0, m1, 0, 1, 4, 5);
+        v128_t tmp2 = wasm_i32x4_shuffle(m0, m1, 2, 3, 6, 7);
+        v128_t tmp1 = wasm_i32x4_shuffle(m2, m3, 0, 1, 4, 5);
+        v128_t tmp3 = wasm_i32x4_shuffle(m2, m3, 2, 3, 6, 7);
+
+        wasm_v128_store(dst, wasm_i32x4_shuffle(tmp0, tmp1, 0, 2, 4, 6));
+        wasm_v128_store(dst + 1, wasm_i32x4_shuffle(tmp0, tmp1, 1, 3, 5, 7));
+        wasm_v128_store(dst + 2, wasm_i32x4_shuffle(tmp2, tmp3, 0, 2, 4, 6));
+        wasm_v128_store(dst + 3, wasm_i32x4_shuffle(tmp2, tmp3, 1, 3, 5, 7));
+    }
+
+    static v128_t transform(const _xm128_t m[4], float x, float y, float z, float w)
+    {
+        v128_t res = wasm_f32x4_mul(wasm_v128_load(m), wasm_f32x4_splat(x));
+        res        = madd(wasm_v128_load(m + 1), wasm_f32x4_splat(y), res);
+        res        = madd(wasm_v128_load(m + 2), wasm_f32x4_splat(z), res);
+        return madd(wasm_v128_load(m + 3), wasm_f32x4_splat(w), res);
+    }
+
+    static void transformVec4(const _xm128_t m[4], float x, float y, float z, float w, float* dst /*vec3*/)
+    {
+        v128_t res = transform(m, x, y, z, w);
+        wasm_v128_store64_lane(dst, res, 0);
+        wasm_v128_store32_lane(dst + 2, res, 2);
+    }
+
+    static void transformVec4(const _xm128_t m[4], const float* v /*vec4*/, float* dst /*vec4*/)
+    {
+        wasm_v128_store(dst, transform(m, v[0], v[1], v[2], v[3]));
+    }
+
+    static void crossVec3(const float* v1, const float* v2, float* dst)
+    {
+        v128_t a = wasm_f32x4_make(v1[0], v1[1], v1[2], 0.0f);
+        v128_t b = wasm_f32x4_make(v2[0], v2[1], v2[2], 0.0f);
+
+        v128_t a_yzx = wasm_i32x4_shuffle(a, a, 1, 2, 0, 3);
+        v128_t b_yzx = wasm_i32x4_shuffle(b, b, 1, 2, 0, 3);
+        v128_t res   = wasm_f32x4_sub(wasm_f32x4_mul(a, b_yzx), wasm_f32x4_mul(a_yzx, b));
+        res          = wasm_i32x4_shuffle(res, res, 1, 2, 0, 3);
+
+        wasm_v128_store64_lane(dst, res, 0);
+        wasm_v128_store32_lane(dst + 2, res, 2);
+    }
+
+    static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform)
+    {
+        v128_t c0 = wasm_v128_load(transform.col), c1 = wasm_v128_load(transform.col + 1);
+        v128_t c2 = wasm_v128_load(transform.col + 2), c3 = wasm_v128_load(transform.col + 3);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& vert = src[i].vertices;
+            v128_t v   = madd(c0, wasm_f32x4_splat(vert.x), c3);
+            v          = madd(c1, wasm_f32x4_splat(vert.y), v);
+            v          = madd(c2, wasm_f32x4_splat(vert.z), v);
+
+            // 3 floats only, unlike the SSE kernel the colors don't have to be saved
+            dst[i].texCoords = src[i].texCoords;
+            dst[i].colors    = src[i].colors;
+            wasm_v128_store64_lane(&dst[i].vertices, v, 0);
+            wasm_v128_store32_lane(&dst[i].vertices.z, v, 2);
+        }
+    }
+
+    static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset)
+    {
+        v128_t offsets = wasm_i16x8_splat(static_cast<int16_t>(offset));
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            wasm_v128_store(dst + i, wasm_i16x8_add(wasm_v128_load(src + i), offsets));
+        for (; i < count; ++i)
+            dst[i] = src[i] + offset;
+    }
+
+    static void transformVec2(const float* m, const float* src, float* dst, size_t count)
+    {
+        v128_t m0 = wasm_f32x4_splat(m[0]), m1 = wasm_f32x4_splat(m[1]);
+        v128_t m4 = wasm_f32x4_splat(m[4]), m5 = wasm_f32x4_splat(m[5]);
+        v128_t m12 = wasm_f32x4_splat(m[12]), m13 = wasm_f32x4_splat(m[13]);
+
+        // 4 points at a time: deinterleave to x and y lanes, transform, interleave back
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            v128_t a  = wasm_v128_load(src + i * 2);      // x0 y0 x1 y1
+            v128_t b  = wasm_v128_load(src + i * 2 + 4);  // x2 y2 x3 y3
+            v128_t x  = wasm_i32x4_shuffle(a, b, 0, 2, 4, 6);
+            v128_t y  = wasm_i32x4_shuffle(a, b, 1, 3, 5, 7);
+            v128_t rx = madd(x, m0, madd(y, m4, m12));
+            v128_t ry = madd(x, m1, madd(y, m5, m13));
+            wasm_v128_store(dst + i * 2, wasm_i32x4_shuffle(rx, ry, 0, 4, 1, 5));
+            wasm_v128_store(dst + i * 2 + 4, wasm_i32x4_shuffle(rx, ry, 2, 6, 3, 7));
+        }
+        MathUtilC::transformVec2(m, src + i * 2, dst + i * 2, count - i);
+    }
+
+    static void transformVec3(const float* m, const float* src, float* dst, size_t count)
+    {
+        v128_t c0 = wasm_v128_load(m), c1 = wasm_v128_load(m + 4);
+        v128_t c2 = wasm_v128_load(m + 8), c3 = wasm_v128_load(m + 12);
+
+        for (size_t i = 0; i < count * 3; i += 3)
+        {
+            v128_t res = madd(c0, wasm_f32x4_splat(src[i]), c3);
+            res        = madd(c1, wasm_f32x4_splat(src[i + 1]), res);
+            res        = madd(c2, wasm_f32x4_splat(src[i + 2]), res);
+
+            // 3 floats only, a 4th one would overwrite the next point
+            wasm_v128_store64_lane(dst + i, res, 0);
+            wasm_v128_store32_lane(dst + i + 2, res, 2);
+        }
+    }
+
+    static void transformVec2(const float* m, const float* x, const float* y, float* dstX, float* dstY, size_t count)
+    {
+        v128_t m0 = wasm_f32x4_splat(m[0]), m1 = wasm_f32x4_splat(m[1]);
+        v128_t m4 = wasm_f32x4_splat(m[4]), m5 = wasm_f32x4_splat(m[5]);
+        v128_t m12 = wasm_f32x4_splat(m[12]), m13 = wasm_f32x4_splat(m[13]);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            v128_t px = wasm_v128_load(x + i);
+            v128_t py = wasm_v128_load(y + i);
+            wasm_v128_store(dstX + i, madd(px, m0, madd(py, m4, m12)));
+            wasm_v128_store(dstY + i, madd(px, m1, madd(py, m5, m13)));
+        }
+        MathUtilC::transformVec2(m, x + i, y + i, dstX + i, dstY + i, count - i);
+    }
+
+    static void addScaled(float* dst, const float* src, float scale, size_t count)
+    {
+        v128_t s = wasm_f32x4_splat(scale);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            wasm_v128_store(dst + i, madd(wasm_v128_load(src + i), s, wasm_v128_load(dst + i)));
+        MathUtilC::addScaled(dst + i, src + i, scale, count - i);
+    }
+
+    static void lerp(const float* from, const float* to, float alpha, float* dst, size_t count)
+    {
+        v128_t a = wasm_f32x4_splat(alpha);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            v128_t f = wasm_v128_load(from + i);
+            wasm_v128_store(dst + i, madd(wasm_f32x4_sub(wasm_v128_load(to + i), f), a, f));
+        }
+        MathUtilC::lerp(from + i, to + i, alpha, dst + i, count - i);
+    }
+
+    static void clamp(float* values, size_t count, float min, float max)
+    {
+        v128_t lo = wasm_f32x4_splat(min), hi = wasm_f32x4_splat(max);
+
+        // pmin/pmax are the single instruction ones, with the NaN handling of _mm_min_ps/_mm_max_ps
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            wasm_v128_store(values + i, wasm_f32x4_pmin(hi, wasm_f32x4_pmax(lo, wasm_v128_load(values + i))));
+        MathUtilC::clamp(values + i, count - i, min, max);
+    }
+
+    static void sampleBilinear(const float* grid,
+                               int width,
+                               int height,
+                               const float* points,
+                               float* dst,
+                               size_t count,
+                               float outside)
+    {
+        v128_t zero = wasm_f32x4_splat(0.0f), out = wasm_f32x4_splat(outside), w = wasm_i32x4_splat(width);
+        v128_t maxX = wasm_f32x4_splat(static_cast<float>(width - 1));
+        v128_t maxY = wasm_f32x4_splat(static_cast<float>(height - 1));
+        alignas(16) int index[4];
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            v128_t p0 = wasm_v128_load(points + i * 2);
+            v128_t p1 = wasm_v128_load(points + i * 2 + 4);
+            v128_t px = wasm_i32x4_shuffle(p0, p1, 0, 2, 4, 6);
+            v128_t py = wasm_i32x4_shuffle(p0, p1, 1, 3, 5, 7);
+
+            // the points out of the grid, NaN included, sample the first cell and get outside
+            v128_t inside = wasm_v128_and(wasm_v128_and(wasm_f32x4_ge(px, zero), wasm_f32x4_lt(px, maxX)),
+                                          wasm_v128_and(wasm_f32x4_ge(py, zero), wasm_f32x4_lt(py, maxY)));
+            px            = wasm_v128_and(px, inside);
+            py            = wasm_v128_and(py, inside);
+
+            v128_t ix = wasm_i32x4_trunc_sat_f32x4(px);
+            v128_t iy = wasm_i32x4_trunc_sat_f32x4(py);
+            v128_t u  = wasm_f32x4_sub(px, wasm_f32x4_convert_i32x4(ix));
+            v128_t v  = wasm_f32x4_sub(py, wasm_f32x4_convert_i32x4(iy));
+            wasm_v128_store(index, wasm_i32x4_add(wasm_i32x4_mul(iy, w), ix));
+
+            const float *c0 = grid + index[0], *c1 = grid + index[1], *c2 = grid + index[2], *c3 = grid + index[3];
+            v128_t h00 = wasm_f32x4_make(c0[0], c1[0], c2[0], c3[0]);
+            v128_t h10 = wasm_f32x4_make(c0[1], c1[1], c2[1], c3[1]);
+            v128_t h01 = wasm_f32x4_make(c0[width], c1[width], c2[width], c3[width]);
+            v128_t h11 = wasm_f32x4_make(c0[width + 1], c1[width + 1], c2[width + 1], c3[width + 1]);
+
+            v128_t top    = madd(wasm_f32x4_sub(h10, h00), u, h00);
+            v128_t bottom = madd(wasm_f32x4_sub(h11, h01), u, h01);
+            wasm_v128_store(dst + i, wasm_v128_bitselect(madd(wasm_f32x4_sub(bottom, top), v, top), out, inside));
+        }
+        MathUtilC::sampleBilinear(grid, width, height, points + i * 2, dst + i, count - i, outside);
+    }
+};
+
+// the wasm-simd builds define AX_SSE_INTRINSICS too, for the SSE code of the engine outside of MathUtil
+using MathUtilSSE = MathUtilWasm;
+
+#endif
+
+NS_AX_MATH_END
@@ -28,6 +28,10 @@
 #if defined(__APPLE__)
 
 #    import <AVFoundation/AVFoundation.h>
+#    if defined(AX_USE_METAL)
+#        import <CoreVideo/CoreVideo.h>
+#        include "renderer/backend/Macros.h"
+#    endif
 
 @class AVMediaSessionHandler;
 
@@ -37,6 +41,8 @@ namespace ax
 class AvfMediaEngine : public MediaEngine
 {
 public:
+    ~AvfMediaEngine();
+
     void fireMediaEvent(MEMediaEventType event)
     {
         if (_onMediaEvent)
@@ -73,6 +79,12 @@ public:
     void internalPause();
 
 private:
+#if defined(AX_USE_METAL)
+    // wraps the planes of a decoded frame in MTLTextures, so the frame is drawn without a copy
+    bool transferNativeFrame(CVPixelBufferRef videoFrame);
+    void releaseNativeFrame(int index);
+#endif
+
     std::function<void(MEMediaEventType)> _onMediaEvent;
     std::function<void(const MEVideoFrame&)> _onVideoFrame;
     MEVideoPixelFormat _videoPF = MEVideoPixelFormat::INVALID;
@@ -83,6 +95,12 @@ private:
     AVPlayerItem* _playerItem = nil;
     AVPlayerItemOutput* _playerOutput = nil;
     AVMediaSessionHandler* _sessionHandler = nil;
+#if defined(AX_USE_METAL)
+    CVMetalTextureCacheRef _textureCache = nullptr;
+    // the textures of the last frames, kept while the GPU may still sample them
+    CVMetalTextureRef _nativeFrames[MAX_INFLIGHT_BUFFER + 1][2]{};
+    int _nativeFrameIndex = 0;
+#endif
 
     bool _bAutoPlay = false;
     bool _repeatEnabled = false;
@@ -36,6 +36,10 @@
 #    import <UIKit/UIKit.h>
 #endif
 
+#if defined(AX_USE_METAL)
+#    include "renderer/backend/metal/DriverMTL.h"
+#endif
+
 using namespace ax;
 
 #define AX_ALIGN_ANY(x, a) ((((x) + (a) - 1) / (a)) * (a))
@@ -391,6 +395,14 @@ bool AvfMediaEngine::transferVideoFrame()
     if (!videoFrame)
         return false;
 
+#if defined(AX_USE_METAL)
+    if (transferNativeFrame(videoFrame))
+    {
+        CVPixelBufferRelease(videoFrame);
+        return true;
+    }
+#endif
+
     auto& videoDim = _videoExtent;
     MEIntPoint bufferDim;
 
@@ -439,6 +451,78 @@ bool AvfMediaEngine::transferVideoFrame()
     CVPixelBufferUnlockBaseAddress(videoFrame, kCVPixelBufferLock_ReadOnly);
 
     CVPixelBufferRelease(videoFrame);
+    return true;
+}
+
+#if defined(AX_USE_METAL)
+bool AvfMediaEngine::transferNativeFrame(CVPixelBufferRef videoFrame)
+{
+    if (!_textureCache)
+    {
+        auto driver = static_cast<backend::DriverMTL*>(backend::DriverBase::getInstance());
+        if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, driver->getMTLDevice(), nil, &_textureCache) !=
+            kCVReturnSuccess)
+        {
+            _textureCache = nullptr;
+            return false;
+        }
+    }
+
+    // the slot of a frame the GPU is done with
+    releaseNativeFrame(_nativeFrameIndex);
+    auto& planes = _nativeFrames[_nativeFrameIndex];
+
+    const bool planar = CVPixelBufferIsPlanar(videoFrame);
+    const size_t planeCount = planar ? 2 : 1;
+    for (size_t i = 0; i < planeCount; ++i)
+    {
+        auto width  = planar ? CVPixelBufferGetWidthOfPlane(videoFrame, i) : CVPixelBufferGetWidth(videoFrame);
+        auto height = planar ? CVPixelBufferGetHeightOfPlane(videoFrame, i) : CVPixelBufferGetHeight(videoFrame);
+        auto format = !planar ? MTLPixelFormatBGRA8Unorm : (i == 0 ? MTLPixelFormatR8Unorm : MTLPixelFormatRG8Unorm);
+        if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, _textureCache, videoFrame, nil, format, width,
+                                                      height, i, &planes[i]) != kCVReturnSuccess)
+        {
+            releaseNativeFrame(_nativeFrameIndex);
+            return false;
+        }
+    }
+    _nativeFrameIndex = (_nativeFrameIndex + 1) % (MAX_INFLIGHT_BUFFER + 1);
+
+    // the textures have the size of the planes, no row pitch to crop
+    MEIntPoint bufferDim{static_cast<int>(CVMetalTextureGetTexture(planes[0]).width),
+                         static_cast<int>(CVMetalTextureGetTexture(planes[0]).height)};
+    MEVideoFrame frame{nullptr, nullptr, 0, MEVideoPixelDesc{_videoPF, bufferDim}, _videoExtent};
+    frame._vpd._rotation = _videoRotation;
+    for (size_t i = 0; i < planeCount; ++i)
+        frame._nativePlanes[i] = reinterpret_cast<uintptr_t>((void*)CVMetalTextureGetTexture(planes[i]));
+    _onVideoFrame(frame);
+
+    CVMetalTextureCacheFlush(_textureCache, 0);
+    return true;
+}
+
+void AvfMediaEngine::releaseNativeFrame(int index)
+{
+    for (auto& plane : _nativeFrames[index])
+    {
+        if (plane)
+        {
+            CFRelease(plane);
+            plane = nullptr;
+        }
+    }
+}
+#endif
+
+AvfMediaEngine::~AvfMediaEngine()
+{
+    close();
+#if defined(AX_USE_METAL)
+    for (int i = 0; i <= MAX_INFLIGHT_BUFFER; ++i)
+        releaseNativeFrame(i);
+    if (_textureCache)
+        CFRelease(_textureCache);
+#endif
 }
 
 bool AvfMediaEngine::close()
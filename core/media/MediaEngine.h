@@ -172,6 +172,9 @@ struct MEVideoFrame
     const uint8_t* _cbcrDataPointer;
     MEVideoPixelDesc _vpd;  // the video pixel desc
     MEIntPoint _videoDim;   // the video size
+    // the planes as images of the renderer, e.g. id<MTLTexture>, when the engine decodes to GPU surfaces, the data
+    // pointers are null then
+    uintptr_t _nativePlanes[2]{};
 #if defined(_DEBUG) || !defined(_NDEBUG)
     YCbCrBiPlanarPixelInfo _ycbcrDesc{};
 #endif
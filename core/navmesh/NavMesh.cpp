@@ -26,12 +26,20 @@
 #include "navmesh/NavMesh.h"
 #if defined(AX_ENABLE_NAVMESH)
 
+#    include "base/Director.h"
+#    include "base/EventDispatcher.h"
+#    include "base/EventListenerCustom.h"
+#    include "3d/Bundle3D.h"
 #    include "platform/FileUtils.h"
 #    include "renderer/Renderer.h"
 #    include "recast/DetourCommon.h"
 #    include "recast/DetourDebugDraw.h"
 #    include <sstream>
 
+#    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+#        include "physics3d/Physics3D.h"
+#    endif
+
 namespace ax
 {
 
@@ -90,6 +98,90 @@ static unsigned char* parseRow(unsigned char* buf, unsigned char* bufEnd, char*
 static const int TILECACHESET_MAGIC   = 'T' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'TSET';
 static const int TILECACHESET_VERSION = 1;
 static const int MAX_AGENTS           = 128;
+static const int MAX_POLYS            = 256;
+static const int MAX_SMOOTH           = 2048;
+static const int MAX_PATH_QUERIES     = 8;
+static const float QUERY_EXTENTS[3]   = {2, 4, 2};
+static const int LAYERS_PER_TILE      = 4;  // expected, for the tile count of a navmesh built at runtime
+static const int MAX_TILE_LAYERS      = 32;
+
+#    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+/** Collects the triangles of a concave shape, in world coordinate system. */
+class TriangleCollector : public btTriangleCallback
+{
+public:
+    TriangleCollector(std::vector<Vec3>& triangles, const Mat4& transform, bool faceUp)
+        : _triangles(triangles), _transform(transform), _faceUp(faceUp)
+    {}
+
+    void processTriangle(btVector3* triangle, int /*partId*/, int /*triangleIndex*/) override
+    {
+        Vec3 v[3];
+        for (int i = 0; i < 3; ++i)
+            _transform.transformPoint(convertbtVector3ToVec3(triangle[i]), &v[i]);
+
+        Vec3 normal;
+        Vec3::cross(v[1] - v[0], v[2] - v[0], &normal);
+        if (_faceUp && normal.y < 0)
+            std::swap(v[1], v[2]);
+        _triangles.insert(_triangles.end(), v, v + 3);
+    }
+
+protected:
+    std::vector<Vec3>& _triangles;
+    const Mat4& _transform;
+    bool _faceUp;
+};
+
+static void appendBox(std::vector<Vec3>& triangles, const Vec3& min, const Vec3& max, const Mat4& transform)
+{
+    // corner i has the max coordinates of the bits of i, x first
+    static const int FACES[12][3] = {{2, 6, 7}, {2, 7, 3}, {0, 1, 5}, {0, 5, 4}, {0, 2, 3}, {0, 3, 1},
+                                     {4, 5, 7}, {4, 7, 6}, {0, 4, 6}, {0, 6, 2}, {1, 3, 7}, {1, 7, 5}};
+    Vec3 corners[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        transform.transformPoint(Vec3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z),
+                                 &corners[i]);
+    }
+    for (auto&& face : FACES)
+    {
+        for (int corner : face)
+            triangles.push_back(corners[corner]);
+    }
+}
+
+static void appendShapeTriangles(const btCollisionShape* shape, const Mat4& transform, std::vector<Vec3>& triangles)
+{
+    if (shape->isCompound())
+    {
+        auto compound = static_cast<const btCompoundShape*>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); ++i)
+        {
+            appendShapeTriangles(compound->getChildShape(i),
+                                 transform * convertbtTransformToMat4(compound->getChildTransform(i)), triangles);
+        }
+    }
+    else if (shape->isConcave())
+    {
+        // the winding of the terrain triangles isn't kept, they face up
+        TriangleCollector collector(triangles, transform, shape->getShapeType() == TERRAIN_SHAPE_PROXYTYPE);
+        btVector3 aabbMax(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        static_cast<const btConcaveShape*>(shape)->processAllTriangles(&collector, -aabbMax, aabbMax);
+    }
+    else if (shape->getShapeType() == BOX_SHAPE_PROXYTYPE)
+    {
+        auto halfExtents = convertbtVector3ToVec3(static_cast<const btBoxShape*>(shape)->getHalfExtentsWithMargin());
+        appendBox(triangles, -halfExtents, halfExtents, transform);
+    }
+    else
+    {
+        btVector3 min, max;
+        shape->getAabb(btTransform::getIdentity(), min, max);
+        appendBox(triangles, convertbtVector3ToVec3(min), convertbtVector3ToVec3(max), transform);
+    }
+}
+#    endif
 
 NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath)
 {
@@ -113,10 +205,28 @@ NavMesh::NavMesh()
     , _meshProcess(nullptr)
     , _geomData(nullptr)
     , _isDebugDrawEnabled(false)
+    , _nextPathRequestId(INVALID_PATH_REQUEST + 1)
+    , _pathQueryIterations(DEFAULT_PATH_QUERY_ITERATIONS)
+    , _asyncUpdate(false)
+    , _crowdUpdated(false)
+    , _afterDrawListener(nullptr)
+    , _nextGeometryId(INVALID_GEOMETRY + 1)
 {}
 
 NavMesh::~NavMesh()
 {
+    waitAsyncUpdate();
+    if (_afterDrawListener)
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterDrawListener);
+    for (auto&& build : _tileBuilds)
+    {
+        Director::getInstance()->getJobSystem()->wait(build.job);
+        for (auto&& layer : *build.layers)
+            dtFree(layer.data);
+    }
+    for (auto&& pathQuery : _pathQueries)
+        dtFreeNavMeshQuery(pathQuery.query);
+
     dtFreeTileCache(_tileCache);
     dtFreeCrowd(_crowed);
     dtFreeNavMesh(_navMesh);
@@ -139,6 +249,54 @@ NavMesh::~NavMesh()
     _obstacleList.clear();
 }
 
+NavMesh* NavMesh::create(const NavMeshBuildParams& params)
+{
+    auto ref = new NavMesh();
+    if (ref->initWithBuildParams(params))
+    {
+        ref->autorelease();
+        return ref;
+    }
+    AX_SAFE_DELETE(ref);
+    return nullptr;
+}
+
+bool NavMesh::initWithBuildParams(const NavMeshBuildParams& params)
+{
+    _tileBuilder        = std::make_unique<NavMeshTileBuilder>(params);
+    auto& builderParams = _tileBuilder->getParams();
+    int tileCount       = _tileBuilder->getTileCountX() * _tileBuilder->getTileCountY();
+
+    _geomData                  = new GeomData;
+    _geomData->offMeshConCount = 0;
+
+    dtTileCacheParams cacheParams;
+    memset(&cacheParams, 0, sizeof(cacheParams));
+    memcpy(cacheParams.orig, &builderParams.bounds._min, sizeof(cacheParams.orig));
+    cacheParams.cs                     = builderParams.cellSize;
+    cacheParams.ch                     = builderParams.cellHeight;
+    cacheParams.width                  = builderParams.tileSize;
+    cacheParams.height                 = builderParams.tileSize;
+    cacheParams.walkableHeight         = builderParams.agentHeight;
+    cacheParams.walkableRadius         = builderParams.agentRadius;
+    cacheParams.walkableClimb          = builderParams.agentMaxClimb;
+    cacheParams.maxSimplificationError = builderParams.maxSimplificationError;
+    cacheParams.maxTiles               = tileCount * LAYERS_PER_TILE;
+    cacheParams.maxObstacles           = builderParams.maxObstacles;
+
+    // the bits of a polygon reference left to the polygons of a tile
+    int tileBits = std::min((int)dtIlog2(dtNextPow2(cacheParams.maxTiles)), 14);
+    dtNavMeshParams meshParams;
+    memset(&meshParams, 0, sizeof(meshParams));
+    memcpy(meshParams.orig, &builderParams.bounds._min, sizeof(meshParams.orig));
+    meshParams.tileWidth  = builderParams.tileSize * builderParams.cellSize;
+    meshParams.tileHeight = builderParams.tileSize * builderParams.cellSize;
+    meshParams.maxTiles   = 1 << tileBits;
+    meshParams.maxPolys   = 1 << (22 - tileBits);
+
+    return initTileCache(meshParams, cacheParams);
+}
+
 bool NavMesh::initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath)
 {
     _navFilePath  = navFilePath;
@@ -177,12 +335,42 @@ bool NavMesh::loadNavMeshFile()
         return false;
     }
 
+    if (!initTileCache(header.meshParams, header.cacheParams))
+        return false;
+
+    // Read tiles.
+    for (int i = 0; i < header.numTiles; ++i)
+    {
+        TileCacheTileHeader tileHeader = *((TileCacheTileHeader*)(data.getBytes() + offset));
+        offset += sizeof(TileCacheTileHeader);
+        if (!tileHeader.tileRef || !tileHeader.dataSize)
+            break;
+
+        unsigned char* tileData = (unsigned char*)dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM);
+        if (!tileData)
+            break;
+        memcpy(tileData, (data.getBytes() + offset), tileHeader.dataSize);
+        offset += tileHeader.dataSize;
+
+        dtCompressedTileRef tile = 0;
+        _tileCache->addTile(tileData, tileHeader.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile);
+
+        if (tile)
+            _tileCache->buildNavMeshTile(tile, _navMesh);
+    }
+
+    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
+    return true;
+}
+
+bool NavMesh::initTileCache(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams)
+{
     _navMesh = dtAllocNavMesh();
     if (!_navMesh)
     {
         return false;
     }
-    dtStatus status = _navMesh->init(&header.meshParams);
+    dtStatus status = _navMesh->init(&meshParams);
     if (dtStatusFailed(status))
     {
         return false;
@@ -197,45 +385,23 @@ bool NavMesh::loadNavMeshFile()
     _allocator   = new LinearAllocator(32000);
     _compressor  = new FastLZCompressor();
     _meshProcess = new MeshProcess(_geomData);
-    status       = _tileCache->init(&header.cacheParams, _allocator, _compressor, _meshProcess);
+    status       = _tileCache->init(&cacheParams, _allocator, _compressor, _meshProcess);
 
     if (dtStatusFailed(status))
     {
         return false;
     }
 
-    // Read tiles.
-    for (int i = 0; i < header.numTiles; ++i)
-    {
-        TileCacheTileHeader tileHeader = *((TileCacheTileHeader*)(data.getBytes() + offset));
-        offset += sizeof(TileCacheTileHeader);
-        if (!tileHeader.tileRef || !tileHeader.dataSize)
-            break;
-
-        unsigned char* tileData = (unsigned char*)dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM);
-        if (!tileData)
-            break;
-        memcpy(tileData, (data.getBytes() + offset), tileHeader.dataSize);
-        offset += tileHeader.dataSize;
-
-        dtCompressedTileRef tile = 0;
-        _tileCache->addTile(tileData, tileHeader.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile);
-
-        if (tile)
-            _tileCache->buildNavMeshTile(tile, _navMesh);
-    }
-
     // create crowed
     _crowed = dtAllocCrowd();
-    _crowed->init(MAX_AGENTS, header.cacheParams.walkableRadius, _navMesh);
+    _crowed->init(MAX_AGENTS, cacheParams.walkableRadius, _navMesh);
 
     // create NavMeshQuery
     _navMeshQuery = dtAllocNavMeshQuery();
     _navMeshQuery->init(_navMesh, 2048);
 
     _agentList.assign(MAX_AGENTS, nullptr);
-    _obstacleList.assign(header.cacheParams.maxObstacles, nullptr);
-    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
+    _obstacleList.assign(cacheParams.maxObstacles, nullptr);
     return true;
 }
 
@@ -435,11 +601,13 @@ void NavMesh::addNavMeshObstacle(NavMeshObstacle* obstacle)
 
 void NavMesh::removeNavMeshAgent(NavMeshAgent* agent)
 {
+    waitAsyncUpdate();
     auto iter = std::find(_agentList.begin(), _agentList.end(), agent);
     if (iter != _agentList.end())
     {
         agent->removeFrom(_crowed);
         agent->setNavMeshQuery(nullptr);
+        agent->_navMesh = nullptr;
         agent->release();
         _agentList[iter - _agentList.begin()] = nullptr;
     }
@@ -447,11 +615,13 @@ void NavMesh::removeNavMeshAgent(NavMeshAgent* agent)
 
 void NavMesh::addNavMeshAgent(NavMeshAgent* agent)
 {
+    waitAsyncUpdate();
     auto iter = std::find(_agentList.begin(), _agentList.end(), nullptr);
     if (iter != _agentList.end())
     {
         agent->addTo(_crowed);
         agent->setNavMeshQuery(_navMeshQuery);
+        agent->_navMesh = this;
         agent->retain();
         _agentList[iter - _agentList.begin()] = agent;
     }
@@ -471,61 +641,24 @@ void NavMesh::debugDraw(Renderer* renderer)
 {
     if (_isDebugDrawEnabled)
     {
+        waitAsyncUpdate();
         _debugDraw.clear();
         dtDraw();
         _debugDraw.draw(renderer);
     }
 }
 
-void NavMesh::update(float dt)
-{
-    for (auto&& iter : _agentList)
-    {
-        if (iter)
-            iter->preUpdate(dt);
-    }
-
-    for (auto&& iter : _obstacleList)
-    {
-        if (iter)
-            iter->preUpdate(dt);
-    }
-
-    if (_crowed)
-        _crowed->update(dt, nullptr);
-
-    if (_tileCache)
-        _tileCache->update(dt, _navMesh);
-
-    for (auto&& iter : _agentList)
-    {
-        if (iter)
-            iter->postUpdate(dt);
-    }
-
-    for (auto&& iter : _obstacleList)
-    {
-        if (iter)
-            iter->postUpdate(dt);
-    }
-}
-
-void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints)
+/** Iterates over the polygons of a path to find the smooth path on the detail mesh surface. */
+static void smoothPath(dtNavMesh* navMesh,
+                       dtNavMeshQuery* navMeshQuery,
+                       const dtQueryFilter& filter,
+                       dtPolyRef startRef,
+                       const Vec3& start,
+                       const Vec3& end,
+                       dtPolyRef* polys,
+                       int npolys,
+                       std::vector<Vec3>& pathPoints)
 {
-    static const int MAX_POLYS  = 256;
-    static const int MAX_SMOOTH = 2048;
-    float ext[3];
-    ext[0] = 2;
-    ext[1] = 4;
-    ext[2] = 2;
-    dtQueryFilter filter;
-    dtPolyRef startRef, endRef;
-    dtPolyRef polys[MAX_POLYS];
-    int npolys = 0;
-    _navMeshQuery->findNearestPoly(&start.x, ext, &filter, &startRef, 0);
-    _navMeshQuery->findNearestPoly(&end.x, ext, &filter, &endRef, 0);
-    _navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
-
     if (npolys)
     {
         //// Iterate over the path to find smooth path on the detail mesh surface.
@@ -534,8 +667,8 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
         // int npolys = npolys;
 
         float iterPos[3], targetPos[3];
-        _navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
-        _navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
+        navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
+        navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
 
         static const float STEP_SIZE = 0.5f;
         static const float SLOP      = 0.01f;
@@ -556,7 +689,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             unsigned char steerPosFlag;
             dtPolyRef steerPosRef;
 
-            if (!getSteerTarget(_navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
+            if (!getSteerTarget(navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
                                 steerPosRef))
                 break;
 
@@ -579,13 +712,13 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             float result[3];
             dtPolyRef visited[16];
             int nvisited = 0;
-            _navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
+            navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
 
             npolys = fixupCorridor(polys, npolys, MAX_POLYS, visited, nvisited);
-            npolys = fixupShortcuts(polys, npolys, _navMeshQuery);
+            npolys = fixupShortcuts(polys, npolys, navMeshQuery);
 
             float h = 0;
-            _navMeshQuery->getPolyHeight(polys[0], result, &h);
+            navMeshQuery->getPolyHeight(polys[0], result, &h);
             result[1] = h;
             dtVcopy(iterPos, result);
 
@@ -622,7 +755,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                 npolys -= npos;
 
                 // Handle the connection.
-                dtStatus status = _navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
+                dtStatus status = navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
                 if (dtStatusSucceed(status))
                 {
                     if (nsmoothPath < MAX_SMOOTH)
@@ -643,7 +776,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                     // Move position at the other side of the off-mesh link.
                     dtVcopy(iterPos, endPos);
                     float eh = 0.0f;
-                    _navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
+                    navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
                     iterPos[1] = eh;
                 }
             }
@@ -661,6 +794,412 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
     }
 }
 
+void NavMesh::update(float dt)
+{
+    waitAsyncUpdate();
+    applyAsyncUpdate();
+    finishPathQueries();
+
+    if (_tileBuilder)
+    {
+        finishTileBuilds();
+        startTileBuilds();
+    }
+
+    for (auto&& iter : _agentList)
+    {
+        if (iter)
+            iter->preUpdate(dt);
+    }
+
+    for (auto&& iter : _obstacleList)
+    {
+        if (iter)
+            iter->preUpdate(dt);
+    }
+
+    if (_crowed && !_asyncUpdate)
+        _crowed->update(dt, nullptr);
+
+    if (_tileCache)
+        _tileCache->update(dt, _navMesh);
+
+    if (!_asyncUpdate)
+    {
+        for (auto&& iter : _agentList)
+        {
+            if (iter)
+                iter->postUpdate(dt);
+        }
+    }
+
+    for (auto&& iter : _obstacleList)
+    {
+        if (iter)
+            iter->postUpdate(dt);
+    }
+
+    // the navmesh tiles aren't changed until the next update, the workers only read them
+    startPathQueries();
+
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    JobHandle jobs[2];
+    size_t jobCount = 0;
+    if (_crowed && _asyncUpdate)
+    {
+        _crowdUpdated    = true;
+        jobs[jobCount++] = jobSystem->schedule([this, dt] { _crowed->update(dt, nullptr); }, JobPriority::High);
+    }
+    if (std::any_of(_pathQueries.begin(), _pathQueries.end(), [](const PathQuery& q) { return q.active; }))
+    {
+        jobs[jobCount++] = jobSystem->parallelFor(_pathQueries.size(), 1, [this](size_t begin, size_t end) {
+            for (auto i = begin; i < end; ++i)
+            {
+                if (_pathQueries[i].active && !_pathQueries[i].done)
+                    updatePathQuery(_pathQueries[i]);
+            }
+        });
+    }
+    if (jobCount == 0)
+        return;
+
+    // waited for by the after draw listener, so the jobs run while the frame renders
+    if (!_afterDrawListener)
+    {
+        _afterDrawListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+            Director::EVENT_AFTER_DRAW, [this](EventCustom*) { waitAsyncUpdate(); });
+    }
+    _asyncJob = jobCount == 1 ? jobs[0] : jobSystem->whenAll(std::span<const JobHandle>(jobs, jobCount));
+}
+
+NavMesh::GeometryId NavMesh::addGeometry(const std::vector<Vec3>& triangles, const Mat4& transform)
+{
+    return insertGeometry(Geometry{triangles, nullptr}, transform);
+}
+
+NavMesh::GeometryId NavMesh::addGeometry(std::string_view modelPath, const Mat4& transform)
+{
+    auto triangles = Bundle3D::getTrianglesList(modelPath);
+    if (triangles.empty())
+    {
+        AXLOGW("NavMesh: no triangle in the model {}", modelPath);
+        return INVALID_GEOMETRY;
+    }
+    return insertGeometry(Geometry{std::move(triangles), nullptr}, transform);
+}
+
+#    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+NavMesh::GeometryId NavMesh::addGeometry(Physics3DShape* shape, const Mat4& transform)
+{
+    // the shape is kept as triangles in its own coordinate system, to be moved
+    Geometry geometry;
+    appendShapeTriangles(shape->getbtShape(), Mat4::IDENTITY, geometry.triangles);
+    return insertGeometry(std::move(geometry), transform);
+}
+#    endif
+
+NavMesh::GeometryId NavMesh::insertGeometry(Geometry&& geometry, const Mat4& transform)
+{
+    if (!_tileBuilder)
+    {
+        AXLOGW("NavMesh: the geometry is only used by the navmeshes created with build parameters");
+        return INVALID_GEOMETRY;
+    }
+
+    auto id    = _nextGeometryId++;
+    auto& slot = _geometries[id];
+    slot       = std::move(geometry);
+    transformGeometry(slot, transform);
+    return id;
+}
+
+void NavMesh::transformGeometry(Geometry& geometry, const Mat4& transform)
+{
+    if (geometry.world)
+        rebuildTiles(geometry.world->bounds);
+
+    // shared with the tile builds using the previous transform
+    auto world = std::make_shared<NavMeshTileBuilder::Geometry>();
+    world->triangles.resize(geometry.triangles.size());
+    for (size_t i = 0; i < geometry.triangles.size(); ++i)
+        transform.transformPoint(geometry.triangles[i], &world->triangles[i]);
+    world->bounds.updateMinMax(world->triangles.data(), world->triangles.size());
+    geometry.world = std::move(world);
+
+    rebuildTiles(geometry.world->bounds);
+}
+
+void NavMesh::setGeometryTransform(GeometryId id, const Mat4& transform)
+{
+    auto iter = _geometries.find(id);
+    if (iter != _geometries.end())
+        transformGeometry(iter->second, transform);
+}
+
+void NavMesh::removeGeometry(GeometryId id)
+{
+    auto iter = _geometries.find(id);
+    if (iter != _geometries.end())
+    {
+        rebuildTiles(iter->second.world->bounds);
+        _geometries.erase(iter);
+    }
+}
+
+void NavMesh::rebuildTiles(const AABB& bounds)
+{
+    if (_tileBuilder && !bounds.isEmpty())
+        _tileBuilder->forEachTile(bounds, [this](int tx, int ty) { _dirtyTiles.emplace(tx, ty); });
+}
+
+void NavMesh::startTileBuilds()
+{
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    // a tile by worker at a time, without workers a tile by update
+    const size_t maxBuilds = std::max(jobSystem->getWorkerCount(), size_t{1});
+    for (auto iter = _dirtyTiles.begin(); iter != _dirtyTiles.end() && _tileBuilds.size() < maxBuilds;)
+    {
+        auto [tx, ty] = *iter;
+        // a tile changed while it is built is built again once it is done
+        if (std::any_of(_tileBuilds.begin(), _tileBuilds.end(),
+                        [tx, ty](const TileBuild& build) { return build.tx == tx && build.ty == ty; }))
+        {
+            ++iter;
+            continue;
+        }
+        iter = _dirtyTiles.erase(iter);
+
+        auto bounds = _tileBuilder->getTileBounds(tx, ty, true);
+        std::vector<std::shared_ptr<const NavMeshTileBuilder::Geometry>> geometries;
+        for (auto&& item : _geometries)
+        {
+            if (item.second.world->bounds.intersects(bounds))
+                geometries.push_back(item.second.world);
+        }
+
+        TileBuild build{tx, ty, JobHandle{}, std::make_shared<std::vector<NavMeshTileBuilder::Layer>>()};
+        build.job = jobSystem->schedule(
+            [builder = _tileBuilder.get(), compressor = _compressor, tx, ty, geometries = std::move(geometries),
+             layers = build.layers] {
+                if (!builder->build(tx, ty, geometries, compressor, *layers))
+                    AXLOGW("NavMesh: a layer of the tile ({}, {}) couldn't be compressed", tx, ty);
+            },
+            JobPriority::Low);
+        _tileBuilds.emplace_back(std::move(build));
+    }
+}
+
+void NavMesh::finishTileBuilds()
+{
+    for (auto iter = _tileBuilds.begin(); iter != _tileBuilds.end();)
+    {
+        if (!iter->job.isDone())
+        {
+            ++iter;
+            continue;
+        }
+        replaceTile(iter->tx, iter->ty, *iter->layers);
+        iter = _tileBuilds.erase(iter);
+    }
+}
+
+void NavMesh::replaceTile(int tx, int ty, std::vector<NavMeshTileBuilder::Layer>& layers)
+{
+    dtCompressedTileRef tiles[MAX_TILE_LAYERS];
+    int tileCount = _tileCache->getTilesAt(tx, ty, tiles, MAX_TILE_LAYERS);
+    for (int i = 0; i < tileCount; ++i)
+        _tileCache->removeTile(tiles[i], nullptr, nullptr);
+    for (int layer = 0; layer < MAX_TILE_LAYERS; ++layer)
+    {
+        if (auto tile = _navMesh->getTileRefAt(tx, ty, layer))
+            _navMesh->removeTile(tile, nullptr, nullptr);
+    }
+
+    for (auto&& layer : layers)
+    {
+        dtCompressedTileRef tile = 0;
+        if (dtStatusFailed(_tileCache->addTile(layer.data, layer.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile)))
+            dtFree(layer.data);
+    }
+    layers.clear();
+    _tileCache->buildNavMeshTilesAt(tx, ty, _navMesh);
+
+    // the obstacles are marked on the tiles they touch when they are added, the ones on the tile are added again
+    auto bounds = _tileBuilder->getTileBounds(tx, ty);
+    for (auto&& obstacle : _obstacleList)
+    {
+        auto ob = obstacle ? _tileCache->getObstacleByRef(obstacle->_obstacleID) : nullptr;
+        if (!ob)
+            continue;
+
+        float bmin[3], bmax[3];
+        _tileCache->getObstacleBounds(ob, bmin, bmax);
+        if (bmin[0] <= bounds._max.x && bmax[0] >= bounds._min.x && bmin[2] <= bounds._max.z &&
+            bmax[2] >= bounds._min.z)
+        {
+            obstacle->removeFrom(_tileCache);
+            obstacle->addTo(_tileCache);
+        }
+    }
+}
+
+void NavMesh::setAsyncUpdate(bool async)
+{
+    if (_asyncUpdate == async)
+        return;
+
+    waitAsyncUpdate();
+    applyAsyncUpdate();
+    _asyncUpdate = async;
+}
+
+void NavMesh::waitAsyncUpdate()
+{
+    if (!_asyncJob.valid())
+        return;
+
+    Director::getInstance()->getJobSystem()->wait(_asyncJob);
+    _asyncJob = JobHandle{};
+}
+
+void NavMesh::applyAsyncUpdate()
+{
+    if (!_crowdUpdated)
+        return;
+
+    _crowdUpdated = false;
+    for (auto&& iter : _agentList)
+    {
+        if (iter)
+            iter->postUpdate(0);
+    }
+}
+
+NavMesh::PathRequestId NavMesh::findPathAsync(const Vec3& start, const Vec3& end, PathCallback callback)
+{
+    auto id = _nextPathRequestId++;
+    if (_nextPathRequestId == INVALID_PATH_REQUEST)
+        ++_nextPathRequestId;
+    _pathRequests.emplace_back(PathRequest{id, start, end, std::move(callback)});
+    return id;
+}
+
+bool NavMesh::cancelPathRequest(PathRequestId id)
+{
+    auto iter = std::find_if(_pathRequests.begin(), _pathRequests.end(),
+                             [id](const PathRequest& request) { return request.id == id; });
+    if (iter != _pathRequests.end())
+    {
+        _pathRequests.erase(iter);
+        return true;
+    }
+
+    for (auto&& pathQuery : _pathQueries)
+    {
+        if (pathQuery.active && pathQuery.request.id == id)
+        {
+            // searched on a worker, dropped once it is done
+            waitAsyncUpdate();
+            pathQuery.active  = false;
+            pathQuery.request = PathRequest{};
+            return true;
+        }
+    }
+    return false;
+}
+
+void NavMesh::startPathQueries()
+{
+    if (_pathRequests.empty() || !_navMesh)
+        return;
+
+    if (_pathQueries.empty())
+    {
+        auto workerCount = Director::getInstance()->getJobSystem()->getWorkerCount();
+        _pathQueries.resize(std::clamp(workerCount, size_t{1}, size_t{MAX_PATH_QUERIES}));
+        for (auto&& pathQuery : _pathQueries)
+        {
+            pathQuery.query = dtAllocNavMeshQuery();
+            pathQuery.query->init(_navMesh, 2048);
+        }
+    }
+
+    for (auto&& pathQuery : _pathQueries)
+    {
+        if (_pathRequests.empty())
+            break;
+        if (pathQuery.active)
+            continue;
+
+        pathQuery.request = std::move(_pathRequests.front());
+        pathQuery.active  = true;
+        pathQuery.started = false;
+        pathQuery.done    = false;
+        pathQuery.pathPoints.clear();
+        _pathRequests.pop_front();
+    }
+}
+
+void NavMesh::finishPathQueries()
+{
+    for (auto&& pathQuery : _pathQueries)
+    {
+        if (!pathQuery.active || !pathQuery.done)
+            continue;
+
+        // freed first, the callback may request another path
+        auto request      = std::move(pathQuery.request);
+        pathQuery.active  = false;
+        pathQuery.request = PathRequest{};
+        if (request.callback)
+            request.callback(request.id, pathQuery.pathPoints);
+    }
+}
+
+void NavMesh::updatePathQuery(PathQuery& pathQuery)
+{
+    auto query    = pathQuery.query;
+    auto& request = pathQuery.request;
+    dtQueryFilter filter;
+    if (!pathQuery.started)
+    {
+        pathQuery.started = true;
+        dtPolyRef endRef  = 0;
+        query->findNearestPoly(&request.start.x, QUERY_EXTENTS, &filter, &pathQuery.startRef, 0);
+        query->findNearestPoly(&request.end.x, QUERY_EXTENTS, &filter, &endRef, 0);
+        auto status = query->initSlicedFindPath(pathQuery.startRef, endRef, &request.start.x, &request.end.x, &filter);
+        if (dtStatusFailed(status))
+        {
+            pathQuery.done = true;
+            return;
+        }
+    }
+
+    auto status = query->updateSlicedFindPath(_pathQueryIterations, nullptr);
+    if (dtStatusInProgress(status))
+        return;
+
+    dtPolyRef polys[MAX_POLYS];
+    int npolys = 0;
+    if (dtStatusSucceed(status))
+        query->finalizeSlicedFindPath(polys, &npolys, MAX_POLYS);
+    smoothPath(_navMesh, query, filter, pathQuery.startRef, request.start, request.end, polys, npolys,
+               pathQuery.pathPoints);
+    pathQuery.done = true;
+}
+
+void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints)
+{
+    dtQueryFilter filter;
+    dtPolyRef startRef, endRef;
+    dtPolyRef polys[MAX_POLYS];
+    int npolys = 0;
+    _navMeshQuery->findNearestPoly(&start.x, QUERY_EXTENTS, &filter, &startRef, 0);
+    _navMeshQuery->findNearestPoly(&end.x, QUERY_EXTENTS, &filter, &endRef, 0);
+    _navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
+    smoothPath(_navMesh, _navMeshQuery, filter, startRef, start, end, polys, npolys, pathPoints);
+}
+
 }
 
 #endif  // AX_ENABLE_NAVMESH
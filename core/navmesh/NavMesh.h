@@ -30,16 +30,23 @@
 #include "base/Config.h"
 #if defined(AX_ENABLE_NAVMESH)
 
+#    include "base/JobSystem.h"
 #    include "base/Object.h"
 #    include "math/Vec3.h"
 #    include "recast/DetourNavMesh.h"
 #    include "recast/DetourNavMeshQuery.h"
 #    include "recast/DetourCrowd.h"
 #    include "recast/DetourTileCache.h"
+#    include <deque>
+#    include <functional>
+#    include <memory>
+#    include <set>
 #    include <string>
+#    include <unordered_map>
 #    include <vector>
 
 #    include "navmesh/NavMeshAgent.h"
+#    include "navmesh/NavMeshBuilder.h"
 #    include "navmesh/NavMeshDebugDraw.h"
 #    include "navmesh/NavMeshObstacle.h"
 #    include "navmesh/NavMeshUtils.h"
@@ -52,10 +59,24 @@ namespace ax
  * @{
  */
 class Renderer;
+class EventListenerCustom;
+class Physics3DShape;
 /** @brief NavMesh: The NavMesh information container, include mesh, tileCache, and so on. */
 class AX_DLL NavMesh : public Object
 {
 public:
+    using PathRequestId = uint32_t;
+    /** Called on the axmol thread with the request and the key points of its path, empty when no path was found. */
+    using PathCallback = std::function<void(PathRequestId, const std::vector<Vec3>& pathPoints)>;
+
+    using GeometryId = uint32_t;
+
+    static constexpr PathRequestId INVALID_PATH_REQUEST = 0;
+    static constexpr GeometryId INVALID_GEOMETRY        = 0;
+
+    /** The search iterations a path query does on each update, the default of setPathQueryIterations. */
+    static constexpr int DEFAULT_PATH_QUERY_ITERATIONS = 256;
+
     /**
     Create navmesh
 
@@ -64,6 +85,51 @@ public:
     */
     static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath);
 
+    /**
+    Create an empty navmesh, its tiles are built at runtime from the geometry added to it.
+
+    The tiles are built on the JobSystem workers and replace the previous ones on a later update, so the agents walk
+    on the tiles already built meanwhile. Adding, moving or removing geometry only rebuilds the tiles it overlaps.
+
+    @param params The size of the cells and tiles, and the agents walking on the navmesh.
+    */
+    static NavMesh* create(const NavMeshBuildParams& params);
+
+    /**
+    Add triangles to the geometry of a navmesh created with build parameters.
+
+    @param triangles The vertices of the triangles, three by triangle, counter clockwise seen from their front side.
+    @param transform The transform to world coordinate system.
+    @return The id of the geometry, to move or remove it.
+    */
+    GeometryId addGeometry(const std::vector<Vec3>& triangles, const Mat4& transform = Mat4::IDENTITY);
+
+    /**
+    Add the triangles of a model file, like the one a MeshRenderer was created from with its
+    getNodeToWorldTransform().
+    */
+    GeometryId addGeometry(std::string_view modelPath, const Mat4& transform);
+
+#    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+    /**
+    Add the triangles of a physics shape, like the one of a rigid body with the transform of its node. The convex
+    shapes other than the boxes are added as their bounding box.
+    */
+    GeometryId addGeometry(Physics3DShape* shape, const Mat4& transform);
+#    endif
+
+    /** Move a geometry, the tiles it overlaps before and after are rebuilt. */
+    void setGeometryTransform(GeometryId id, const Mat4& transform);
+
+    /** Remove a geometry, the tiles it overlaps are rebuilt. */
+    void removeGeometry(GeometryId id);
+
+    /** Rebuild the tiles overlapping bounds, in world coordinate system. */
+    void rebuildTiles(const AABB& bounds);
+
+    /** Get the count of tiles waiting to be built or being built. */
+    size_t getPendingTileCount() const { return _dirtyTiles.size() + _tileBuilds.size(); }
+
     /** update navmesh. */
     void update(float dt);
 
@@ -97,11 +163,50 @@ public:
     */
     void findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints);
 
+    /**
+    find a path on navmesh on the JobSystem workers
+
+    The requests are queued and searched on the workers while the frame renders, each running query with its own
+    dtNavMeshQuery. A query is time sliced, it does a few search iterations on each update, so a long path takes
+    several frames instead of a spike. The callback is called by a later update.
+
+    @param start The start search position in world coordinate system.
+    @param end The end search position in world coordinate system.
+    @param callback Called on the axmol thread with the key points of the path.
+    @return The id of the request, to cancel it.
+    */
+    PathRequestId findPathAsync(const Vec3& start, const Vec3& end, PathCallback callback);
+
+    /** Cancel a path request, its callback isn't called. Return false when it was done already. */
+    bool cancelPathRequest(PathRequestId id);
+
+    /** Set the search iterations a path query does on each update. */
+    void setPathQueryIterations(int iterations) { _pathQueryIterations = iterations; }
+    int getPathQueryIterations() const { return _pathQueryIterations; }
+
+    /**
+    Set whether the crowd of agents is updated on a worker thread.
+
+    The crowd is updated while the frame renders, the agents move their nodes with its results on the next update,
+    so they are one frame behind. The obstacles are still updated on the axmol thread.
+
+    @param async A bool object, default value is false.
+    */
+    void setAsyncUpdate(bool async);
+
+    /** Check whether the crowd of agents is updated on a worker thread. */
+    bool isAsyncUpdate() const { return _asyncUpdate; }
+
+    /** Wait for the crowd update and the path queries running on the workers, done before the agents are read. */
+    void waitAsyncUpdate();
+
     NavMesh();
     virtual ~NavMesh();
 
 protected:
     bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath);
+    bool initWithBuildParams(const NavMeshBuildParams& params);
+    bool initTileCache(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams);
     bool read();
     bool loadNavMeshFile();
     bool loadGeomFile();
@@ -110,6 +215,53 @@ protected:
     void drawObstacles();
     void drawOffMeshConnections();
 
+    struct PathRequest
+    {
+        PathRequestId id;
+        Vec3 start;
+        Vec3 end;
+        PathCallback callback;
+    };
+
+    /** A query of the workers, it searches a request over several updates. */
+    struct PathQuery
+    {
+        dtNavMeshQuery* query = nullptr;
+        PathRequest request;
+        dtPolyRef startRef = 0;
+        bool active        = false;
+        bool started       = false;
+        bool done          = false;
+        std::vector<Vec3> pathPoints;
+    };
+
+    /** Moves the nodes of the agents with the crowd updated on the worker. */
+    void applyAsyncUpdate();
+    void startPathQueries();
+    void finishPathQueries();
+    void updatePathQuery(PathQuery& pathQuery);
+
+    struct Geometry
+    {
+        std::vector<Vec3> triangles;  // before the transform
+        std::shared_ptr<const NavMeshTileBuilder::Geometry> world;
+    };
+
+    struct TileBuild
+    {
+        int tx;
+        int ty;
+        JobHandle job;
+        std::shared_ptr<std::vector<NavMeshTileBuilder::Layer>> layers;
+    };
+
+    GeometryId insertGeometry(Geometry&& geometry, const Mat4& transform);
+    void transformGeometry(Geometry& geometry, const Mat4& transform);
+    void startTileBuilds();
+    void finishTileBuilds();
+    /** Replaces the layers of a tile in the tile cache and the navmesh, and refreshes the obstacles on it. */
+    void replaceTile(int tx, int ty, std::vector<NavMeshTileBuilder::Layer>& layers);
+
 protected:
     dtNavMesh* _navMesh;
     dtNavMeshQuery* _navMeshQuery;
@@ -126,6 +278,22 @@ protected:
     std::string _navFilePath;
     std::string _geomFilePath;
     bool _isDebugDrawEnabled;
+
+    std::deque<PathRequest> _pathRequests;
+    std::vector<PathQuery> _pathQueries;
+    PathRequestId _nextPathRequestId;
+    int _pathQueryIterations;
+
+    bool _asyncUpdate;
+    bool _crowdUpdated;  // on the worker, not applied to the agents yet
+    JobHandle _asyncJob;
+    EventListenerCustom* _afterDrawListener;
+
+    std::unique_ptr<NavMeshTileBuilder> _tileBuilder;  // for the navmeshes built at runtime
+    std::unordered_map<GeometryId, Geometry> _geometries;
+    GeometryId _nextGeometryId;
+    std::set<std::pair<int, int>> _dirtyTiles;
+    std::vector<TileBuild> _tileBuilds;
 };
 
 /** @} */
@@ -80,6 +80,7 @@ ax::NavMeshAgent::NavMeshAgent()
     , _userData(nullptr)
     , _crowd(nullptr)
     , _navMeshQuery(nullptr)
+    , _navMesh(nullptr)
 {}
 
 ax::NavMeshAgent::~NavMeshAgent() {}
@@ -181,6 +182,7 @@ unsigned char NavMeshAgent::getObstacleAvoidanceType() const
 
 Vec3 NavMeshAgent::getCurrentVelocity() const
 {
+    waitCrowdUpdate();
     if (_crowd)
     {
         auto agent = _crowd->getAgent(_agentID);
@@ -241,6 +243,7 @@ void NavMeshAgent::move(const Vec3& destination, const MoveCallback& callback)
 
 OffMeshLinkData NavMeshAgent::getCurrentOffMeshLinkData()
 {
+    waitCrowdUpdate();
     OffMeshLinkData data;
     if (_crowd && isOnOffMeshLink())
     {
@@ -273,6 +276,7 @@ void ax::NavMeshAgent::completeOffMeshLink()
 
 void NavMeshAgent::setAutoTraverseOffMeshLink(bool isAuto)
 {
+    waitCrowdUpdate();
     if (_crowd && isOnOffMeshLink())
     {
         auto agentAnim = _crowd->getEditableAgentAnim(_agentID);
@@ -317,6 +321,12 @@ void NavMeshAgent::pause()
     _needUpdateAgent = true;
 }
 
+void NavMeshAgent::waitCrowdUpdate() const
+{
+    if (_navMesh)
+        _navMesh->waitAsyncUpdate();
+}
+
 void NavMeshAgent::preUpdate(float delta)
 {
     if (_state != DT_CROWDAGENT_STATE_INVALID)
@@ -350,6 +360,7 @@ void NavMeshAgent::postUpdate(float /*delta*/)
 
 void NavMeshAgent::syncToNode()
 {
+    waitCrowdUpdate();
     const dtCrowdAgent* agent = nullptr;
     if (_crowd)
     {
@@ -386,6 +397,7 @@ void NavMeshAgent::syncToNode()
 
 void NavMeshAgent::syncToAgent()
 {
+    waitCrowdUpdate();
     if (_crowd)
     {
         auto agent     = _crowd->getEditableAgent(_agentID);
@@ -412,6 +424,7 @@ void NavMeshAgent::syncToAgent()
 
 Vec3 NavMeshAgent::getVelocity() const
 {
+    waitCrowdUpdate();
     const dtCrowdAgent* agent = nullptr;
     if (_crowd)
     {
@@ -39,6 +39,8 @@ class dtNavMeshQuery;
 namespace ax
 {
 
+class NavMesh;
+
 /**
  * @addtogroup 3d
  * @{
@@ -211,6 +213,8 @@ private:
     void preUpdate(float delta);
     void postUpdate(float delta);
     static void convertTodtAgentParam(const NavMeshAgentParam& inParam, dtCrowdAgentParams& outParam);
+    /** Waits for the crowd when the navmesh updates it on a worker thread. */
+    void waitCrowdUpdate() const;
 
 private:
     MoveCallback _moveCallback;
@@ -228,6 +232,7 @@ private:
     void* _userData;
     dtCrowd* _crowd;
     dtNavMeshQuery* _navMeshQuery;
+    NavMesh* _navMesh;
 };
 
 /** @} */
@@ -0,0 +1,549 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "navmesh/NavMeshBuilder.h"
+#if defined(AX_ENABLE_NAVMESH)
+
+#    include "recast/DetourAlloc.h"
+#    include "recast/DetourTileCache.h"
+#    include "recast/DetourTileCacheBuilder.h"
+
+#    include <algorithm>
+#    include <cmath>
+#    include <climits>
+
+namespace ax
+{
+
+namespace
+{
+
+constexpr int MAX_LAYERS      = 32;
+constexpr int SPAN_HEIGHT_MAX = 0xffff;  // cells
+constexpr int NOT_CONNECTED   = -1;
+constexpr int NO_SPAN         = -1;
+
+constexpr int DIR_OFFSET_X[4] = {-1, 0, 1, 0};
+constexpr int DIR_OFFSET_Y[4] = {0, 1, 0, -1};
+
+struct Span
+{
+    int smin;
+    int smax;
+    int next;
+    bool walkable;
+};
+
+/** The solid spans of the cells of a tile and its border, sorted from the bottom in a list per cell. */
+class Heightfield
+{
+public:
+    Heightfield(int size, int mergeThreshold)
+        : _size(size), _mergeThreshold(mergeThreshold), _cells(size * size, NO_SPAN)
+    {}
+
+    int getSize() const { return _size; }
+    int first(int x, int y) const { return _cells[x + y * _size]; }
+    const Span& span(int i) const { return _spans[i]; }
+
+    /** Adds a span, merged with the spans it overlaps like Recast does. */
+    void addSpan(int x, int y, int smin, int smax, bool walkable)
+    {
+        int& head = _cells[x + y * _size];
+        int prev  = NO_SPAN;
+        int cur   = head;
+        while (cur != NO_SPAN)
+        {
+            auto& s = _spans[cur];
+            if (s.smin > smax)
+                break;
+            if (s.smax < smin)
+            {
+                prev = cur;
+                cur  = s.next;
+                continue;
+            }
+
+            smin = std::min(smin, s.smin);
+            smax = std::max(smax, s.smax);
+            // the top of the merged span is walkable when one of the tops close to it is
+            if (std::abs(smax - s.smax) <= _mergeThreshold)
+                walkable = walkable || s.walkable;
+
+            int next  = s.next;
+            s.next    = _freeSpan;
+            _freeSpan = cur;
+            if (prev == NO_SPAN)
+                head = next;
+            else
+                _spans[prev].next = next;
+            cur = next;
+        }
+
+        int i;
+        if (_freeSpan != NO_SPAN)
+        {
+            i         = _freeSpan;
+            _freeSpan = _spans[i].next;
+        }
+        else
+        {
+            i = static_cast<int>(_spans.size());
+            _spans.emplace_back();
+        }
+        _spans[i] = Span{smin, smax, prev == NO_SPAN ? head : _spans[prev].next, walkable};
+        if (prev == NO_SPAN)
+            head = i;
+        else
+            _spans[prev].next = i;
+    }
+
+protected:
+    int _size;
+    int _mergeThreshold;
+    int _freeSpan = NO_SPAN;
+    std::vector<int> _cells;
+    std::vector<Span> _spans;
+};
+
+/** A walkable top of a span. */
+struct Surface
+{
+    int y;
+    int clearance;
+    int con[4]         = {NOT_CONNECTED, NOT_CONNECTED, NOT_CONNECTED, NOT_CONNECTED};  // the surfaces stepped to
+    int layer          = 0;
+    unsigned char dist = 0xff;  // to the border of the walkable area
+    bool walkable      = true;
+};
+
+/** Divides a convex polygon by the plane at x on an axis, to out1 below it and out2 above it. */
+void dividePoly(const float* in, int nin, float* out1, int* nout1, float* out2, int* nout2, float x, int axis)
+{
+    float d[12];
+    for (int i = 0; i < nin; ++i)
+        d[i] = x - in[i * 3 + axis];
+
+    int m = 0, n = 0;
+    for (int i = 0, j = nin - 1; i < nin; j = i, ++i)
+    {
+        bool ina = d[j] >= 0;
+        bool inb = d[i] >= 0;
+        if (ina != inb)
+        {
+            float s = d[j] / (d[j] - d[i]);
+            for (int k = 0; k < 3; ++k)
+                out1[m * 3 + k] = out2[n * 3 + k] = in[j * 3 + k] + (in[i * 3 + k] - in[j * 3 + k]) * s;
+            ++m;
+            ++n;
+            // the points on the plane were added already
+            if (d[i] > 0)
+            {
+                std::copy_n(in + i * 3, 3, out1 + m * 3);
+                ++m;
+            }
+            else if (d[i] < 0)
+            {
+                std::copy_n(in + i * 3, 3, out2 + n * 3);
+                ++n;
+            }
+        }
+        else
+        {
+            if (d[i] >= 0)
+            {
+                std::copy_n(in + i * 3, 3, out1 + m * 3);
+                ++m;
+                if (d[i] != 0)
+                    continue;
+            }
+            std::copy_n(in + i * 3, 3, out2 + n * 3);
+            ++n;
+        }
+    }
+    *nout1 = m;
+    *nout2 = n;
+}
+
+/** Adds the spans a triangle covers, clipped to the cells row by row then column by column. */
+void rasterizeTriangle(const Vec3& v0,
+                       const Vec3& v1,
+                       const Vec3& v2,
+                       bool walkable,
+                       Heightfield& hf,
+                       const Vec3& origin,
+                       float cs,
+                       float ch,
+                       float heightRange)
+{
+    const int size  = hf.getSize();
+    const float ics = 1.0f / cs;
+    const float ich = 1.0f / ch;
+
+    float minZ = std::min({v0.z, v1.z, v2.z}), maxZ = std::max({v0.z, v1.z, v2.z});
+    float minX = std::min({v0.x, v1.x, v2.x}), maxX = std::max({v0.x, v1.x, v2.x});
+    if (maxX < origin.x || minX > origin.x + size * cs || maxZ < origin.z || minZ > origin.z + size * cs)
+        return;
+
+    float buf[7 * 3 * 4];
+    float* in    = buf;
+    float* inrow = buf + 7 * 3;
+    float* p1    = inrow + 7 * 3;
+    float* p2    = p1 + 7 * 3;
+
+    std::copy_n(&v0.x, 3, in);
+    std::copy_n(&v1.x, 3, in + 3);
+    std::copy_n(&v2.x, 3, in + 6);
+    int nvin = 3;
+
+    int z0 = std::clamp((int)((minZ - origin.z) * ics), -1, size - 1);
+    int z1 = std::clamp((int)((maxZ - origin.z) * ics), 0, size - 1);
+    for (int z = z0; z <= z1; ++z)
+    {
+        int nvrow;
+        float cz = origin.z + z * cs;
+        dividePoly(in, nvin, inrow, &nvrow, p1, &nvin, cz + cs, 2);
+        std::swap(in, p1);
+        if (nvrow < 3 || z < 0)
+            continue;
+
+        float rowMinX = inrow[0], rowMaxX = inrow[0];
+        for (int i = 1; i < nvrow; ++i)
+        {
+            rowMinX = std::min(rowMinX, inrow[i * 3]);
+            rowMaxX = std::max(rowMaxX, inrow[i * 3]);
+        }
+        int x0 = (int)((rowMinX - origin.x) * ics);
+        int x1 = (int)((rowMaxX - origin.x) * ics);
+        if (x1 < 0 || x0 >= size)
+            continue;
+        x0 = std::clamp(x0, -1, size - 1);
+        x1 = std::clamp(x1, 0, size - 1);
+
+        int nv, nv2 = nvrow;
+        for (int x = x0; x <= x1; ++x)
+        {
+            float cx = origin.x + x * cs;
+            dividePoly(inrow, nv2, p1, &nv, p2, &nv2, cx + cs, 0);
+            std::swap(inrow, p2);
+            if (nv < 3 || x < 0)
+                continue;
+
+            float smin = p1[1], smax = p1[1];
+            for (int i = 1; i < nv; ++i)
+            {
+                smin = std::min(smin, p1[i * 3 + 1]);
+                smax = std::max(smax, p1[i * 3 + 1]);
+            }
+            smin -= origin.y;
+            smax -= origin.y;
+            if (smax < 0.0f || smin > heightRange)
+                continue;
+
+            int ismin = std::clamp((int)std::floor(std::max(smin, 0.0f) * ich), 0, SPAN_HEIGHT_MAX);
+            int ismax = std::clamp((int)std::ceil(std::min(smax, heightRange) * ich), ismin + 1, SPAN_HEIGHT_MAX);
+            hf.addSpan(x, z, ismin, ismax, walkable);
+        }
+    }
+}
+
+}  // namespace
+
+NavMeshTileBuilder::NavMeshTileBuilder(const NavMeshBuildParams& params) : _params(params)
+{
+    _params.tileSize         = std::clamp(_params.tileSize, 16, 255);
+    _params.maxLayersPerTile = std::clamp(_params.maxLayersPerTile, 1, MAX_LAYERS);
+
+    float tileWidth   = _params.cellSize * _params.tileSize;
+    _tileCountX       = std::max(1, (int)std::ceil((_params.bounds._max.x - _params.bounds._min.x) / tileWidth));
+    _tileCountY       = std::max(1, (int)std::ceil((_params.bounds._max.z - _params.bounds._min.z) / tileWidth));
+    _walkableHeight   = (int)std::ceil(_params.agentHeight / _params.cellHeight);
+    _walkableClimb    = (int)std::floor(_params.agentMaxClimb / _params.cellHeight);
+    _walkableRadius   = (int)std::ceil(_params.agentRadius / _params.cellSize);
+    _borderSize       = _walkableRadius + 3;
+    _walkableSlopeCos = std::cos(MATH_DEG_TO_RAD(_params.agentMaxSlope));
+}
+
+AABB NavMeshTileBuilder::getTileBounds(int tx, int ty, bool withBorder) const
+{
+    float tileWidth = _params.cellSize * _params.tileSize;
+    float border    = withBorder ? _borderSize * _params.cellSize : 0.0f;
+    Vec3 min(_params.bounds._min.x + tx * tileWidth - border, _params.bounds._min.y,
+             _params.bounds._min.z + ty * tileWidth - border);
+    Vec3 max(min.x + tileWidth + border * 2, _params.bounds._max.y, min.z + tileWidth + border * 2);
+    return AABB(min, max);
+}
+
+bool NavMeshTileBuilder::build(int tx,
+                               int ty,
+                               std::span<const std::shared_ptr<const Geometry>> geometries,
+                               dtTileCacheCompressor* compressor,
+                               std::vector<Layer>& layers) const
+{
+    layers.clear();
+
+    const float cs        = _params.cellSize;
+    const float ch        = _params.cellHeight;
+    const int size        = _params.tileSize + _borderSize * 2;
+    const AABB tileBounds = getTileBounds(tx, ty, true);
+    const Vec3& origin    = tileBounds._min;
+
+    // rasterize the triangles
+    Heightfield hf(size, _walkableClimb);
+    float heightRange = _params.bounds._max.y - _params.bounds._min.y;
+    for (auto&& geometry : geometries)
+    {
+        if (!geometry->bounds.intersects(tileBounds))
+            continue;
+
+        auto& triangles = geometry->triangles;
+        for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+        {
+            Vec3 normal;
+            Vec3::cross(triangles[i + 1] - triangles[i], triangles[i + 2] - triangles[i], &normal);
+            normal.normalize();
+            rasterizeTriangle(triangles[i], triangles[i + 1], triangles[i + 2], normal.y > _walkableSlopeCos, hf,
+                              origin, cs, ch, heightRange);
+        }
+    }
+
+    // the walkable tops with room for an agent
+    std::vector<Surface> surfaces;
+    std::vector<int> cellSurfaces(size * size + 1);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            cellSurfaces[x + y * size] = static_cast<int>(surfaces.size());
+
+            bool previousWalkable = false;
+            int previousTop       = 0;
+            for (int i = hf.first(x, y); i != NO_SPAN; i = hf.span(i).next)
+            {
+                auto& s       = hf.span(i);
+                bool walkable = s.walkable;
+                // a low obstacle on a walkable span, like a curb, can be stepped on
+                if (!walkable && previousWalkable && std::abs(s.smax - previousTop) <= _walkableClimb)
+                    walkable = true;
+                previousWalkable = s.walkable;
+                previousTop      = s.smax;
+
+                int top = s.next != NO_SPAN ? hf.span(s.next).smin : SPAN_HEIGHT_MAX;
+                if (walkable && top - s.smax >= _walkableHeight)
+                    surfaces.push_back(Surface{s.smax, top - s.smax});
+            }
+        }
+    }
+    cellSurfaces[size * size] = static_cast<int>(surfaces.size());
+
+    if (surfaces.empty())
+        return true;
+
+    // connect the neighbors an agent can step to
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            for (int i = cellSurfaces[x + y * size]; i < cellSurfaces[x + y * size + 1]; ++i)
+            {
+                auto& s = surfaces[i];
+                for (int dir = 0; dir < 4; ++dir)
+                {
+                    int nx = x + DIR_OFFSET_X[dir];
+                    int ny = y + DIR_OFFSET_Y[dir];
+                    if (nx < 0 || ny < 0 || nx >= size || ny >= size)
+                        continue;
+
+                    for (int j = cellSurfaces[nx + ny * size]; j < cellSurfaces[nx + ny * size + 1]; ++j)
+                    {
+                        auto& ns   = surfaces[j];
+                        int bottom = std::max(s.y, ns.y);
+                        int top    = std::min(s.y + s.clearance, ns.y + ns.clearance);
+                        if (top - bottom >= _walkableHeight && std::abs(ns.y - s.y) <= _walkableClimb)
+                        {
+                            s.con[dir] = j;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // erode the walkable area by the agent radius, with the chamfer distance to the borders in half cells
+    for (auto&& s : surfaces)
+    {
+        if (std::count(std::begin(s.con), std::end(s.con), NOT_CONNECTED) != 0)
+            s.dist = 0;
+    }
+    auto relax = [&](Surface& s, int dir, int diagonalDir) {
+        if (s.con[dir] == NOT_CONNECTED)
+            return;
+        auto& a = surfaces[s.con[dir]];
+        s.dist  = (unsigned char)std::min<int>(s.dist, a.dist + 2);
+        if (a.con[diagonalDir] != NOT_CONNECTED)
+            s.dist = (unsigned char)std::min<int>(s.dist, surfaces[a.con[diagonalDir]].dist + 3);
+    };
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            for (int i = cellSurfaces[x + y * size]; i < cellSurfaces[x + y * size + 1]; ++i)
+            {
+                relax(surfaces[i], 0, 3);
+                relax(surfaces[i], 3, 2);
+            }
+        }
+    }
+    for (int y = size - 1; y >= 0; --y)
+    {
+        for (int x = size - 1; x >= 0; --x)
+        {
+            for (int i = cellSurfaces[x + y * size]; i < cellSurfaces[x + y * size + 1]; ++i)
+            {
+                relax(surfaces[i], 2, 1);
+                relax(surfaces[i], 1, 0);
+            }
+        }
+    }
+
+    // stack the surfaces of each cell in layers
+    const int erodeDist = _walkableRadius * 2;
+    for (int c = 0; c < size * size; ++c)
+    {
+        int layer = 0;
+        for (int i = cellSurfaces[c]; i < cellSurfaces[c + 1]; ++i)
+        {
+            auto& s    = surfaces[i];
+            s.walkable = s.dist >= erodeDist && layer < _params.maxLayersPerTile;
+            if (s.walkable)
+                s.layer = layer++;
+        }
+    }
+
+    // the layers of the tile, without its border
+    const int width = _params.tileSize;
+    std::vector<int> heights(width * width);
+    std::vector<unsigned char> layerHeights(width * width);
+    std::vector<unsigned char> areas(width * width);
+    std::vector<unsigned char> cons(width * width);
+    bool succeeded = true;
+    for (int layer = 0; layer < _params.maxLayersPerTile; ++layer)
+    {
+        std::fill(heights.begin(), heights.end(), INT_MAX);
+        std::fill(areas.begin(), areas.end(), DT_TILECACHE_NULL_AREA);
+        std::fill(cons.begin(), cons.end(), 0);
+
+        int hmin = INT_MAX, hmax = INT_MIN;
+        int minx = width, maxx = 0, miny = width, maxy = 0;
+        for (int y = 0; y < width; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                int c = (x + _borderSize) + (y + _borderSize) * size;
+                for (int i = cellSurfaces[c]; i < cellSurfaces[c + 1]; ++i)
+                {
+                    auto& s = surfaces[i];
+                    if (!s.walkable || s.layer != layer)
+                        continue;
+
+                    int idx              = x + y * width;
+                    int h                = s.y;
+                    unsigned char portal = 0, con = 0;
+                    for (int dir = 0; dir < 4; ++dir)
+                    {
+                        if (s.con[dir] == NOT_CONNECTED || !surfaces[s.con[dir]].walkable)
+                            continue;
+
+                        auto& ns = surfaces[s.con[dir]];
+                        int nx   = x + DIR_OFFSET_X[dir];
+                        int ny   = y + DIR_OFFSET_Y[dir];
+                        if (ns.layer != layer || nx < 0 || ny < 0 || nx >= width || ny >= width)
+                        {
+                            // to another layer or tile, the height matches on both sides of the portal
+                            portal |= (unsigned char)(1 << dir);
+                            h = std::max(h, ns.y);
+                        }
+                        else
+                            con |= (unsigned char)(1 << dir);
+                    }
+
+                    heights[idx] = h;
+                    areas[idx]   = DT_TILECACHE_WALKABLE_AREA;
+                    cons[idx]    = (unsigned char)((portal << 4) | con);
+                    hmin         = std::min(hmin, h);
+                    hmax         = std::max(hmax, h);
+                    minx         = std::min(minx, x);
+                    maxx         = std::max(maxx, x);
+                    miny         = std::min(miny, y);
+                    maxy         = std::max(maxy, y);
+                    break;
+                }
+            }
+        }
+
+        // the surfaces of a cell are in consecutive layers, the next ones are empty too
+        if (hmin > hmax)
+            break;
+
+        for (int idx = 0; idx < width * width; ++idx)
+            layerHeights[idx] = (unsigned char)std::min<int64_t>((int64_t)heights[idx] - hmin, 0xff);
+        hmax = std::min(hmax, hmin + 0xff);
+
+        dtTileCacheLayerHeader header;
+        header.magic   = DT_TILECACHE_MAGIC;
+        header.version = DT_TILECACHE_VERSION;
+        header.tx      = tx;
+        header.ty      = ty;
+        header.tlayer  = layer;
+        header.bmin[0] = origin.x + _borderSize * cs;
+        header.bmin[1] = origin.y + hmin * ch;
+        header.bmin[2] = origin.z + _borderSize * cs;
+        header.bmax[0] = header.bmin[0] + width * cs;
+        header.bmax[1] = origin.y + hmax * ch;
+        header.bmax[2] = header.bmin[2] + width * cs;
+        header.hmin    = (unsigned short)hmin;
+        header.hmax    = (unsigned short)hmax;
+        header.width   = (unsigned char)width;
+        header.height  = (unsigned char)width;
+        header.minx    = (unsigned char)minx;
+        header.maxx    = (unsigned char)maxx;
+        header.miny    = (unsigned char)miny;
+        header.maxy    = (unsigned char)maxy;
+
+        Layer result{nullptr, 0};
+        auto status = dtBuildTileCacheLayer(compressor, &header, layerHeights.data(), areas.data(), cons.data(),
+                                            &result.data, &result.dataSize);
+        if (dtStatusFailed(status))
+        {
+            succeeded = false;
+            continue;
+        }
+        layers.emplace_back(result);
+    }
+    return succeeded;
+}
+
+}  // namespace ax
+
+#endif  // AX_ENABLE_NAVMESH
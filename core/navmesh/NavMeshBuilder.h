@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "base/Config.h"
+#if defined(AX_ENABLE_NAVMESH)
+
+#    include "3d/AABB.h"
+#    include "math/Math.h"
+
+#    include <memory>
+#    include <span>
+#    include <vector>
+
+struct dtTileCacheCompressor;
+
+namespace ax
+{
+
+/**
+ * @addtogroup 3d
+ * @{
+ */
+
+/** @brief The parameters of a navmesh built at runtime, the distances are in world units. */
+struct AX_DLL NavMeshBuildParams
+{
+    AABB bounds;                           ///< The region the tiles cover, its height bounds the walkable heights.
+    float cellSize               = 0.3f;   ///< The width of the cells the geometry is rasterized to.
+    float cellHeight             = 0.2f;   ///< The height of the cells.
+    int tileSize                 = 48;     ///< The width of a tile in cells. [Limit: 16 to 255]
+    float agentHeight            = 2.0f;
+    float agentRadius            = 0.6f;
+    float agentMaxClimb          = 0.9f;
+    float agentMaxSlope          = 45.0f;  ///< The steepest walkable slope in degrees.
+    float maxSimplificationError = 1.3f;   ///< How far the polygon edges may stray from the walkable area.
+    int maxLayersPerTile         = 4;      ///< The floors a tile can have, the higher ones are dropped.
+    int maxObstacles             = 128;
+};
+
+/**
+ * @brief Rasterizes triangles to the tile cache layers of a navmesh tile.
+ *
+ * The triangles are rasterized to columns of spans like Recast does, the tops of the spans with room for an agent
+ * and a gentle enough slope are walkable, and the walkable area is eroded by the agent radius. The walkable surfaces
+ * of a tile are stacked in layers, the tile cache builds the polygons of the layers. A builder is immutable, the tiles
+ * can be built on any thread.
+ */
+class AX_DLL NavMeshTileBuilder
+{
+public:
+    /** Triangles in world coordinate system, three vertices each. */
+    struct Geometry
+    {
+        std::vector<Vec3> triangles;
+        AABB bounds;
+    };
+
+    /** A compressed layer, allocated with dtAlloc. */
+    struct Layer
+    {
+        unsigned char* data;
+        int dataSize;
+    };
+
+    explicit NavMeshTileBuilder(const NavMeshBuildParams& params);
+
+    const NavMeshBuildParams& getParams() const { return _params; }
+    int getTileCountX() const { return _tileCountX; }
+    int getTileCountY() const { return _tileCountY; }
+
+    /** The bounds of a tile, with the border rasterized around it when withBorder is true. */
+    AABB getTileBounds(int tx, int ty, bool withBorder = false) const;
+
+    /** Calls fn(tx, ty) for the tiles overlapping bounds. */
+    template <typename Fn>
+    void forEachTile(const AABB& bounds, Fn&& fn) const
+    {
+        auto scale = 1.0f / (_params.cellSize * _params.tileSize);
+        int minX   = std::max(0, (int)std::floor((bounds._min.x - _params.bounds._min.x) * scale));
+        int minY   = std::max(0, (int)std::floor((bounds._min.z - _params.bounds._min.z) * scale));
+        int maxX   = std::min(_tileCountX - 1, (int)std::floor((bounds._max.x - _params.bounds._min.x) * scale));
+        int maxY   = std::min(_tileCountY - 1, (int)std::floor((bounds._max.z - _params.bounds._min.z) * scale));
+        for (int ty = minY; ty <= maxY; ++ty)
+        {
+            for (int tx = minX; tx <= maxX; ++tx)
+                fn(tx, ty);
+        }
+    }
+
+    /**
+     * Builds the layers of a tile from the geometries overlapping it, the previous content of layers is cleared.
+     * @return false when a layer couldn't be compressed, the layers built are still returned.
+     */
+    bool build(int tx,
+               int ty,
+               std::span<const std::shared_ptr<const Geometry>> geometries,
+               dtTileCacheCompressor* compressor,
+               std::vector<Layer>& layers) const;
+
+protected:
+    NavMeshBuildParams _params;
+    int _tileCountX;
+    int _tileCountY;
+    int _borderSize;      // cells
+    int _walkableHeight;  // cells
+    int _walkableClimb;   // cells
+    int _walkableRadius;  // cells
+    float _walkableSlopeCos;
+};
+
+/** @} */
+
+}  // namespace ax
+
+#endif  // AX_ENABLE_NAVMESH
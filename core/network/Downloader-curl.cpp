@@ -40,6 +40,7 @@
 #    include "network/Downloader.h"
 #    include "platform/FileStream.h"
 #    include "openssl/md5.h"
+#    include "yasio/string_view.hpp"
 #    include "yasio/xxsocket.hpp"
 #    include "yasio/thread_name.hpp"
 
@@ -54,6 +55,10 @@
 
 #    define AX_CURL_POLL_TIMEOUT_MS 1000
 
+// the resume state of a download in segments, 'AXSG'
+#    define AX_SEGMENTS_FILE_SIGNATURE 0x47535841
+#    define AX_MAX_SEGMENTS_PER_TASK 64
+
 enum
 {
     kCheckSumStateSucceed = 1,
@@ -105,6 +110,10 @@ public:
 
         _fs.reset();
         _fsMd5.reset();
+        _fsSegments.reset();
+
+        if (_headers)
+            curl_slist_free_all(_headers);
     }
 
     bool init(std::string_view filename, std::string_view tempSuffix)
@@ -205,6 +214,17 @@ public:
                 _fsMd5->seek(0, SEEK_SET);
                 _fsMd5->read(&_md5State, sizeof(_md5State));
             }
+
+            // resume a download in segments
+            _segmentsFileName = _tempFileName + ".segments";
+            if (!restoreSegments())
+            {
+                _errCode         = DownloadTask::ERROR_OPEN_FILE_FAILED;
+                _errCodeInternal = 0;
+                _errDescription  = "Can't reopen file:";
+                _errDescription.append(_tempFileName);
+                break;
+            }
             ret = true;
         } while (0);
 
@@ -218,13 +238,13 @@ public:
         if (!_cancelled)
         {
             _cancelled = true;
-            if (this->_sockfd != -1)
+            for (auto sockfd : this->_sockfds)
             {
                 // may cause curl CURLE_SEND_ERROR(55) or CURLE_RECV_ERROR(56)
-                if (::shutdown(this->_sockfd, SD_BOTH) == -1)
-                    ::closesocket(this->_sockfd);
-                this->_sockfd = -1;
+                if (::shutdown(sockfd, SD_BOTH) == -1)
+                    ::closesocket(sockfd);
             }
+            this->_sockfds.clear();
         }
     }
 
@@ -234,8 +254,10 @@ public:
 
         if (!_cancelled)
         {
-            this->_sockfd = ::socket(addr->family, addr->socktype, addr->protocol);
-            return this->_sockfd;
+            auto sockfd = ::socket(addr->family, addr->socktype, addr->protocol);
+            if (sockfd != -1)
+                this->_sockfds.emplace_back(sockfd);
+            return sockfd;
         }
         return -1;
     }
@@ -308,7 +330,305 @@ public:
         return ret;
     }
 
+    // counts the bytes of a data task streamed to Downloader::onDataTaskReceived
+    size_t countDataProc(size_t bytes_transferred)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _bytesReceived += bytes_transferred;
+        _totalBytesReceived += bytes_transferred;
+        curl_easy_getinfo(_curl, CURLINFO_SPEED_DOWNLOAD_T, &_speed);
+        return bytes_transferred;
+    }
+
+    // a range of a file downloaded in segments
+    struct Segment
+    {
+        DownloadTaskCURL* owner;
+        int64_t offset;
+        int64_t size;
+        int64_t received;
+        CURL* curl;
+        bool started;
+    };
+
+    /*
+     * Splits the file in segments when it is large enough, it is downloaded in a single stream otherwise.
+     */
+    bool initSegments(int64_t totalBytes, uint32_t maxSegments, int64_t minSegmentSize)
+    {
+        auto count = std::min<int64_t>(std::min<uint32_t>(maxSegments, AX_MAX_SEGMENTS_PER_TASK),
+                                       totalBytes / std::max<int64_t>(minSegmentSize, 1));
+        if (count < 2)
+            return false;
+
+        // the segments are written at their offsets
+        _fs = FileUtils::getInstance()->openFileStream(_tempFileName, IFileStream::Mode::OVERLAPPED);
+        if (!_fs)
+            return false;
+
+        _segments.resize(static_cast<size_t>(count));
+        for (int64_t i = 0; i < count; ++i)
+        {
+            auto& segment  = _segments[i];
+            segment.owner  = this;
+            segment.offset = totalBytes * i / count;
+            segment.size   = totalBytes * (i + 1) / count - segment.offset;
+        }
+        _totalBytesExpected = totalBytes;
+        _hashedBytes        = 0;
+        MD5_Init(&_md5State);
+
+        // the state is saved before the file grows, a file without it is resumed as a single stream
+        if (!saveSegmentsProc() || !_fs->resize(totalBytes))
+        {
+            _segments.clear();
+            _fsSegments.reset();
+            FileUtils::getInstance()->removeFile(_segmentsFileName);
+            return false;
+        }
+        return true;
+    }
+
+    size_t writeSegmentProc(Segment& segment, const unsigned char* buffer, size_t size)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        if (!segment.started)
+        {
+            // a server which ignores the range sends the whole file
+            long responseCode = 0;
+            curl_easy_getinfo(segment.curl, CURLINFO_RESPONSE_CODE, &responseCode);
+            if (responseCode != 206)
+            {
+                setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, CURLE_RANGE_ERROR,
+                             fmt::format("The server doesn't accept ranges: {}", responseCode));
+                return 0;
+            }
+            segment.started = true;
+        }
+
+        if (static_cast<int64_t>(size) > segment.size - segment.received)
+        {
+            setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, CURLE_RANGE_ERROR, "The server sent more than the range");
+            return 0;
+        }
+
+        _fs->seek(segment.offset + segment.received, SEEK_SET);
+        auto ret = _fs->write(buffer, static_cast<unsigned int>(size));
+        if (ret <= 0)
+            return 0;
+
+        segment.received += ret;
+        _bytesReceived += ret;
+        _totalBytesReceived += ret;
+
+        if (_hashSegments)
+            hashSegmentsProc(&segment, buffer, ret);
+        saveSegmentsProc();
+
+        curl_off_t speed = 0;
+        _speed           = 0;
+        for (auto& other : _segments)
+        {
+            if (other.curl && curl_easy_getinfo(other.curl, CURLINFO_SPEED_DOWNLOAD_T, &speed) == CURLE_OK)
+                _speed += speed;
+        }
+
+        return ret;
+    }
+
+    /*
+     * Called when all the segments are downloaded, completes the digest of the file.
+     */
+    void finishSegmentsProc()
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        if (_hashSegments)
+        {
+            hashSegmentsProc(nullptr, nullptr, 0);
+            _fsMd5->seek(0, SEEK_SET);
+            _fsMd5->write(&_md5State, sizeof(_md5State));
+        }
+    }
+
+    Segment* findSegment(CURL* curl)
+    {
+        for (auto& segment : _segments)
+            if (segment.curl == curl)
+                return &segment;
+        return nullptr;
+    }
+
+    bool hasSegmentTransfers() const
+    {
+        for (auto& segment : _segments)
+            if (segment.curl)
+                return true;
+        return false;
+    }
+
+    void applySpeedLimitProc(int64_t speedLimit)
+    {
+        if (speedLimit == _appliedSpeedLimit)
+            return;
+        _appliedSpeedLimit = speedLimit;
+
+        if (_segments.empty())
+        {
+            curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, (curl_off_t)speedLimit);
+            return;
+        }
+
+        // shared by the segments downloading
+        int64_t transfers = 0;
+        for (auto& segment : _segments)
+            transfers += segment.curl ? 1 : 0;
+        auto segmentLimit = speedLimit > 0 ? std::max<int64_t>(speedLimit / std::max<int64_t>(transfers, 1), 1) : 0;
+        for (auto& segment : _segments)
+        {
+            if (segment.curl)
+                curl_easy_setopt(segment.curl, CURLOPT_MAX_RECV_SPEED_LARGE, (curl_off_t)segmentLimit);
+        }
+    }
+
 private:
+    struct SegmentsFileHeader
+    {
+        uint32_t signature;
+        uint32_t segmentCount;
+        int64_t totalBytes;
+        int64_t hashedBytes;
+        MD5state_st md5State;
+    };
+
+    struct SegmentRecord
+    {
+        int64_t offset;
+        int64_t size;
+        int64_t received;
+    };
+
+    /*
+     * Restores the segments of a previous download, returns false when the file can't be reopened.
+     */
+    bool restoreSegments()
+    {
+        auto pFileUtils = FileUtils::getInstance();
+        auto fs         = pFileUtils->openFileStream(_segmentsFileName, IFileStream::Mode::READ);
+        if (!fs)
+            return true;
+
+        SegmentsFileHeader header;
+        std::vector<SegmentRecord> records;
+        bool valid = fs->read(&header, sizeof(header)) == sizeof(header) &&
+                     header.signature == AX_SEGMENTS_FILE_SIGNATURE && header.segmentCount > 0 &&
+                     header.segmentCount <= AX_MAX_SEGMENTS_PER_TASK;
+        if (valid)
+        {
+            records.resize(header.segmentCount);
+            auto recordsSize = static_cast<int>(sizeof(SegmentRecord) * records.size());
+            valid            = fs->read(records.data(), recordsSize) == recordsSize;
+        }
+        fs.reset();
+
+        if (!valid)
+        {
+            // the offsets of the bytes downloaded are lost
+            pFileUtils->removeFile(_segmentsFileName);
+            _fs = pFileUtils->openFileStream(_tempFileName, IFileStream::Mode::WRITE);
+            _totalBytesReceived = _transferOffset = 0;
+            return !!_fs;
+        }
+
+        _fs = pFileUtils->openFileStream(_tempFileName, IFileStream::Mode::OVERLAPPED);
+        if (!_fs)
+            return false;
+
+        _segments.resize(records.size());
+        _totalBytesReceived = 0;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            auto& segment    = _segments[i];
+            segment.owner    = this;
+            segment.offset   = records[i].offset;
+            segment.size     = records[i].size;
+            segment.received = records[i].received;
+            _totalBytesReceived += segment.received;
+        }
+        _transferOffset     = _totalBytesReceived;
+        _totalBytesExpected = header.totalBytes;
+        _hashedBytes        = header.hashedBytes;
+        _md5State           = header.md5State;
+        return true;
+    }
+
+    bool saveSegmentsProc()
+    {
+        if (!_fsSegments)
+        {
+            _fsSegments = FileUtils::getInstance()->openFileStream(_segmentsFileName, IFileStream::Mode::OVERLAPPED);
+            if (!_fsSegments)
+                return false;
+        }
+
+        SegmentsFileHeader header;
+        header.signature    = AX_SEGMENTS_FILE_SIGNATURE;
+        header.segmentCount = static_cast<uint32_t>(_segments.size());
+        header.totalBytes   = _totalBytesExpected;
+        header.hashedBytes  = _hashedBytes;
+        header.md5State     = _md5State;
+
+        _recordsBuffer.resize(_segments.size());
+        for (size_t i = 0; i < _segments.size(); ++i)
+            _recordsBuffer[i] = SegmentRecord{_segments[i].offset, _segments[i].size, _segments[i].received};
+
+        auto recordsSize = static_cast<int>(sizeof(SegmentRecord) * _recordsBuffer.size());
+        _fsSegments->seek(0, SEEK_SET);
+        return _fsSegments->write(&header, sizeof(header)) == sizeof(header) &&
+               _fsSegments->write(_recordsBuffer.data(), recordsSize) == recordsSize;
+    }
+
+    /*
+     * Hashes the bytes downloaded in order after the ones hashed, the bytes just written by a segment are hashed from
+     * the buffer, the ones a later segment downloaded earlier are read back from the file.
+     */
+    void hashSegmentsProc(const Segment* written, const unsigned char* buffer, size_t size)
+    {
+        for (auto& segment : _segments)
+        {
+            auto end = segment.offset + segment.received;
+            if (_hashedBytes < end)
+            {
+                auto writtenBegin = end - static_cast<int64_t>(size);
+                if (&segment == written && _hashedBytes >= writtenBegin)
+                {
+                    ::MD5_Update(&_md5State, buffer + (_hashedBytes - writtenBegin),
+                                 static_cast<size_t>(end - _hashedBytes));
+                    _hashedBytes = end;
+                }
+                else
+                    hashFileProc(end);
+            }
+            if (segment.received < segment.size)
+                break;
+        }
+    }
+
+    void hashFileProc(int64_t end)
+    {
+        _hashBuffer.resize(64 * 1024);
+        _fs->seek(_hashedBytes, SEEK_SET);
+        while (_hashedBytes < end)
+        {
+            auto n = _fs->read(_hashBuffer.data(),
+                               static_cast<unsigned int>(std::min<int64_t>(end - _hashedBytes, _hashBuffer.size())));
+            if (n <= 0)
+                break;
+            ::MD5_Update(&_md5State, _hashBuffer.data(), n);
+            _hashedBytes += n;
+        }
+    }
+
     friend class DownloaderCURL;
 
     // for lock object instance
@@ -319,8 +639,9 @@ private:
 
     curl_off_t _speed = 0;
     CURL* _curl = nullptr;
-    curl_socket_t _sockfd = -1;  // store the sockfd to support cancel download manually
+    std::vector<curl_socket_t> _sockfds;  // store the sockfds to support cancel download manually
     bool _cancelled       = false;
+    int64_t _appliedSpeedLimit = 0;
 
     // progress
     bool _alreadyDownloaded = false;
@@ -339,10 +660,22 @@ private:
     std::string _checksumFileName;
     std::vector<unsigned char> _buf;
     std::unique_ptr<IFileStream> _fs{};
+    curl_slist* _headers = nullptr;  // the request headers of a data task
 
     // calculate md5 in downloading time support
     std::unique_ptr<IFileStream> _fsMd5{};  // store md5 state realtime
     MD5state_st _md5State;
+
+    // download in segments support
+    std::vector<Segment> _segments;  // empty for a single stream
+    CURL* _probeCurl = nullptr;      // asks the size of the file and whether the server accepts ranges
+    bool _acceptRanges = false;
+    bool _hashSegments = false;      // hashed in order when the task has a checksum
+    int64_t _hashedBytes = 0;
+    std::string _segmentsFileName;
+    std::unique_ptr<IFileStream> _fsSegments{};  // store the segments state realtime
+    std::vector<SegmentRecord> _recordsBuffer;
+    std::vector<unsigned char> _hashBuffer;
 };
 int DownloadTaskCURL::_sSerialId;
 std::mutex DownloadTaskCURL::_sStoragePathSetMutex;
@@ -432,6 +765,8 @@ public:
     }
 
 private:
+    using TransferMap = std::unordered_map<CURL*, std::shared_ptr<DownloadTask>>;
+
     static size_t _outputDataCallbackProc(void* buffer, size_t size, size_t count, DownloadTaskCURL* coTask)
     {
         // AXLOGD("    _outputDataCallbackProc: size({}), count({})", size, count);
@@ -439,6 +774,58 @@ private:
         return coTask->writeDataProc((unsigned char*)buffer, size, count);
     }
 
+    static size_t _outputStreamCallbackProc(void* buffer, size_t size, size_t count, DownloadTask* task)
+    {
+        auto coTask      = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+        auto& onTaskData = coTask->owner.onTaskData;
+        if (onTaskData && onTaskData(*task, (unsigned char*)buffer, size * count))
+            return coTask->countDataProc(size * count);
+        return coTask->writeDataProc((unsigned char*)buffer, size, count);
+    }
+
+    static size_t _dataHeaderCallbackProc(char* buffer, size_t size, size_t count, DownloadTask* task)
+    {
+        using namespace cxx17;  // for string_view literal
+        cxx17::string_view header{buffer, size * count};
+        if (cxx20::starts_with(header, "HTTP/"_sv))
+        {
+            // the headers of a redirect target follow
+            auto code         = header.find(' ');
+            task->notModified = code != header.npos && header.substr(code + 1, 3) == "304"_sv;
+            if (!task->notModified)
+                task->etag.clear();  // of the request, the response has its own
+        }
+        else if (cxx20::ic::starts_with(header, "ETag:"_sv))
+        {
+            header.remove_prefix(5);
+            while (!header.empty() && (header.front() == ' ' || header.front() == '\t'))
+                header.remove_prefix(1);
+            while (!header.empty() && (header.back() == '\r' || header.back() == '\n' || header.back() == ' '))
+                header.remove_suffix(1);
+            task->etag = header;
+        }
+        return size * count;
+    }
+
+    static size_t _outputSegmentCallbackProc(void* buffer,
+                                             size_t size,
+                                             size_t count,
+                                             DownloadTaskCURL::Segment* segment)
+    {
+        return segment->owner->writeSegmentProc(*segment, (unsigned char*)buffer, size * count);
+    }
+
+    static size_t _probeHeaderCallbackProc(char* buffer, size_t size, size_t count, DownloadTaskCURL* coTask)
+    {
+        using namespace cxx17;  // for string_view literal
+        cxx17::string_view header{buffer, size * count};
+        if (cxx20::starts_with(header, "HTTP/"_sv))
+            coTask->_acceptRanges = false;  // the headers of a redirect target follow
+        else if (cxx20::ic::starts_with(header, "Accept-Ranges:"_sv) && header.find("bytes") != header.npos)
+            coTask->_acceptRanges = true;
+        return size * count;
+    }
+
     static int _progressCallbackProc(DownloadTask* task,
                                      curl_off_t dltotal,
                                      curl_off_t dlnow,
@@ -487,8 +874,23 @@ private:
         curl_easy_setopt(handle, CURLOPT_XFERINFODATA, task.get());
 
         // set write func
-        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, _outputDataCallbackProc);
-        curl_easy_setopt(handle, CURLOPT_WRITEDATA, coTask);
+        if (task->storagePath.empty())
+        {
+            // a data task is streamed to the downloader, and revalidated with its ETag
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, _outputStreamCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, task.get());
+            curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, _dataHeaderCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_HEADERDATA, task.get());
+            if (!task->etag.empty() && !coTask->_headers)
+                coTask->_headers = curl_slist_append(nullptr, fmt::format("If-None-Match: {}", task->etag).c_str());
+            if (coTask->_headers)
+                curl_easy_setopt(handle, CURLOPT_HTTPHEADER, coTask->_headers);
+        }
+        else
+        {
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, _outputDataCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, coTask);
+        }
 
         curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1L);
         curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
@@ -534,6 +936,113 @@ private:
         return CURLE_OK;
     }
 
+    // creates a curl handle for a task, a segment of it, or the probe of its size, and adds it to the multi handle
+    CURL* _addTransferProc(CURLM* curlmHandle,
+                           std::shared_ptr<DownloadTask>& task,
+                           TransferMap& coTaskMap,
+                           DownloadTaskCURL::Segment* segment,
+                           bool probe = false)
+    {
+        auto coTask      = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+        CURL* curlHandle = curl_easy_init();
+        if (nullptr == curlHandle)
+        {
+            coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, 0, "Alloc curl handle failed.");
+            return nullptr;
+        }
+
+        _initCurlHandleProc(curlHandle, task);
+        if (probe)
+        {
+            curl_easy_setopt(curlHandle, CURLOPT_NOBODY, 1L);
+            curl_easy_setopt(curlHandle, CURLOPT_NOPROGRESS, 1L);
+            curl_easy_setopt(curlHandle, CURLOPT_HEADERFUNCTION, _probeHeaderCallbackProc);
+            curl_easy_setopt(curlHandle, CURLOPT_HEADERDATA, coTask);
+            coTask->_probeCurl = curlHandle;
+        }
+        else if (segment)
+        {
+            char buf[128];
+            snprintf(buf, sizeof(buf), "%" PRId64 "-%" PRId64, segment->offset + segment->received,
+                     segment->offset + segment->size - 1);
+            curl_easy_setopt(curlHandle, CURLOPT_RANGE, buf);
+            curl_easy_setopt(curlHandle, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)0);
+            curl_easy_setopt(curlHandle, CURLOPT_WRITEFUNCTION, _outputSegmentCallbackProc);
+            curl_easy_setopt(curlHandle, CURLOPT_WRITEDATA, segment);
+            segment->curl    = curlHandle;
+            segment->started = false;
+        }
+        coTask->_appliedSpeedLimit = -1;  // applied to the new transfer before it runs
+
+        auto mcode = curl_multi_add_handle(curlmHandle, curlHandle);
+        if (CURLM_OK != mcode)
+        {
+            coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
+            curl_easy_cleanup(curlHandle);
+            if (segment)
+                segment->curl = nullptr;
+            if (probe)
+                coTask->_probeCurl = nullptr;
+            return nullptr;
+        }
+
+        AXLOGD("    _threadProc task create curl handle:{}", fmt::ptr(curlHandle));
+        coTaskMap[curlHandle] = task;
+        return curlHandle;
+    }
+
+    // starts the transfers of a task, returns false when the task is finished
+    bool _startTransfersProc(CURLM* curlmHandle, std::shared_ptr<DownloadTask>& task, TransferMap& coTaskMap)
+    {
+        auto coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+        if (coTask->_segments.empty())
+            return _addTransferProc(curlmHandle, task, coTaskMap, nullptr) != nullptr;
+
+        bool started = false;
+        for (auto& segment : coTask->_segments)
+        {
+            if (segment.received == segment.size)
+                continue;
+            if (!_addTransferProc(curlmHandle, task, coTaskMap, &segment))
+            {
+                _removeSegmentTransfersProc(curlmHandle, *coTask, coTaskMap);
+                return false;
+            }
+            started = true;
+        }
+
+        // all the segments were downloaded before the task was interrupted
+        if (!started)
+            coTask->finishSegmentsProc();
+        return started;
+    }
+
+    void _removeSegmentTransfersProc(CURLM* curlmHandle, DownloadTaskCURL& coTask, TransferMap& coTaskMap)
+    {
+        for (auto& segment : coTask._segments)
+        {
+            if (segment.curl)
+            {
+                curl_multi_remove_handle(curlmHandle, segment.curl);
+                curl_easy_cleanup(segment.curl);
+                coTaskMap.erase(segment.curl);
+                segment.curl = nullptr;
+            }
+        }
+    }
+
+    static std::string _curlErrorDesc(CURL* curlHandle, CURLcode errCode)
+    {
+        std::string errorMsg = curl_easy_strerror(errCode);
+        if (errCode == CURLE_HTTP_RETURNED_ERROR)
+        {
+            long responeCode = 0;
+            curl_easy_getinfo(curlHandle, CURLINFO_RESPONSE_CODE, &responeCode);
+            fmt::format_to(std::back_inserter(errorMsg), FMT_COMPILE(": {}"), responeCode);
+        }
+        return errorMsg;
+    }
+
     void _threadProc()
     {
         yasio::set_thread_name("axmol-dl");
@@ -545,7 +1054,7 @@ private:
         uint32_t countOfMaxProcessingTasks = this->hints.countOfMaxProcessingTasks;
         // init curl content
         CURLM* curlmHandle = curl_multi_init();
-        std::unordered_map<CURL*, std::shared_ptr<DownloadTask>> coTaskMap;
+        TransferMap coTaskMap;
         int runningHandles = 0;
         CURLMcode mcode    = CURLM_OK;
         int rc             = 0;  // select return code
@@ -563,6 +1072,13 @@ private:
                 }
             }
 
+            // the speed limits changed since the last poll, or of the new transfers
+            for (auto&& item : coTaskMap)
+            {
+                auto coTask = static_cast<DownloadTaskCURL*>(item.second->_coTask.get());
+                coTask->applySpeedLimitProc(item.second->getSpeedLimit());
+            }
+
             if (runningHandles)
             {
                 int nret = 0;
@@ -599,41 +1115,62 @@ private:
 
                         // remove from multi-handle
                         curl_multi_remove_handle(curlmHandle, curlHandle);
-                        do
+                        coTaskMap.erase(curlHandle);
+
+                        auto coTask   = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+                        bool finished = true;
+                        if (curlHandle == coTask->_probeCurl)
                         {
-                            auto coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
-                            if (CURLE_OK != errCode)
+                            coTask->_probeCurl       = nullptr;
+                            curl_off_t contentLength = -1;
+                            if (CURLE_OK == errCode)
+                                curl_easy_getinfo(curlHandle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+                            curl_easy_cleanup(curlHandle);
+
+                            // a single stream when the server doesn't accept ranges, or the probe failed
+                            if (coTask->_acceptRanges && contentLength > 0)
+                                coTask->initSegments(contentLength, hints.segmentsPerTask, hints.minSegmentSize);
+                            finished = !_startTransfersProc(curlmHandle, task, coTaskMap);
+                        }
+                        else if (!coTask->_segments.empty())
+                        {
+                            auto segment  = coTask->findSegment(curlHandle);
+                            segment->curl = nullptr;
+                            if (CURLE_OK != errCode || segment->received != segment->size)
                             {
-                                std::string errorMsg = curl_easy_strerror(errCode);
-                                if (errCode == CURLE_HTTP_RETURNED_ERROR) {
-                                    long responeCode = 0;
-                                    curl_easy_getinfo(curlHandle, CURLINFO_RESPONSE_CODE, &responeCode);
-                                    fmt::format_to(std::back_inserter(errorMsg), FMT_COMPILE(": {}"), responeCode);
+                                // keep the error of a write callback, the transfer then fails with CURLE_WRITE_ERROR
+                                if (DownloadTask::ERROR_NO_ERROR == coTask->_errCode)
+                                {
+                                    if (CURLE_OK != errCode)
+                                        coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, errCode,
+                                                             _curlErrorDesc(curlHandle, errCode));
+                                    else
+                                        coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, CURLE_PARTIAL_FILE,
+                                                             "The range was received partially");
                                 }
-
-                                coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, std::move(errorMsg));
-                                break;
+                                _removeSegmentTransfersProc(curlmHandle, *coTask, coTaskMap);
                             }
+                            curl_easy_cleanup(curlHandle);
 
-                            // after get header info success
-                            // wrapper.second->_totalBytesReceived inited by local file size
-                            // if the local file size equal with the content size from header, the file has
-                            // downloaded finish
-                            if (coTask->_totalBytesReceived &&
-                                coTask->_totalBytesReceived == coTask->_totalBytesExpected)
-                            {
-                                // the file has download complete
-                                // break to move this task to finish queue
-                                break;
-                            }
-                        } while (0);
+                            finished = !coTask->hasSegmentTransfers();
+                            if (!finished)
+                                coTask->_appliedSpeedLimit = -1;  // shared by the segments left
+                            else if (DownloadTask::ERROR_NO_ERROR == coTask->_errCode)
+                                coTask->finishSegmentsProc();
+                        }
+                        else
+                        {
+                            if (CURLE_OK != errCode)
+                                coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, errCode,
+                                                     _curlErrorDesc(curlHandle, errCode));
 
-                        curl_easy_cleanup(curlHandle);
+                            curl_easy_cleanup(curlHandle);
+                        }
                         AXLOGD("    _threadProc task clean cur handle :{} with errCode:{}", fmt::ptr(curlHandle),
                                static_cast<int>(errCode));
 
-                        // remove from coTaskMap
-                        coTaskMap.erase(curlHandle);
+                        if (!finished)
+                            continue;
 
                         // remove from _processSet
                         {
@@ -652,9 +1189,13 @@ private:
             // process tasks in _requestList
             while (true)
             {
-                // Check for set task limit
-                if (countOfMaxProcessingTasks && coTaskMap.size() >= countOfMaxProcessingTasks)
-                    break;
+                // Check for set task limit, a task downloaded in segments has several transfers
+                if (countOfMaxProcessingTasks)
+                {
+                    std::lock_guard<std::mutex> lock(_processMutex);
+                    if (_processSet.size() >= countOfMaxProcessingTasks)
+                        break;
+                }
 
                 // get task wrapper from request queue
                 std::shared_ptr<DownloadTask> task;
@@ -691,30 +1232,20 @@ private:
                     continue;
                 }
 
-                // create curl handle from task and add into curl multi handle
-                CURL* curlHandle = curl_easy_init();
-
-                if (nullptr == curlHandle)
-                {
-                    coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, 0, "Alloc curl handle failed.");
-                    finishTask(task);
-                    continue;
-                }
-
-                // init curl handle for get header info
-                _initCurlHandleProc(curlHandle, task);
-
-                // add curl handle to process list
-                mcode = curl_multi_add_handle(curlmHandle, curlHandle);
-                if (CURLM_OK != mcode)
+                // a large file is split when the server accepts ranges, its size is asked first
+                coTask->_hashSegments = !task->checksum.empty();
+                bool started;
+                if (coTask->_segments.empty() && hints.segmentsPerTask > 1 && !task->storagePath.empty() &&
+                    coTask->_totalBytesReceived == 0)
+                    started = _addTransferProc(curlmHandle, task, coTaskMap, nullptr, true) != nullptr;
+                else
+                    started = _startTransfersProc(curlmHandle, task, coTaskMap);
+                if (!started)
                 {
-                    coTask->setErrorDesc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
                     finishTask(task);
                     continue;
                 }
 
-                AXLOGD("    _threadProc task create curl handle:{}", fmt::ptr(curlHandle));
-                coTaskMap[curlHandle] = task;
                 std::lock_guard<std::mutex> lock(_processMutex);
                 _processSet.insert(task);
             }
@@ -876,6 +1407,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task)
             auto pFileUtils = FileUtils::getInstance();
             coTask._fs.reset();
             coTask._fsMd5.reset();
+            coTask._fsSegments.reset();
 
             if (coTask._alreadyDownloaded)  // No need to download
             {
@@ -889,6 +1421,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task)
                     coTask._errDescription  = "";
 
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._segmentsFileName);
 
                     onTaskProgress(task);
 
@@ -901,6 +1434,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task)
                     coTask._errDescription  = "Check file md5 succeed, but the origin file is missing!";
                     pFileUtils->removeFile(coTask._checksumFileName);
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._segmentsFileName);
                 }
 
                 break;
@@ -913,6 +1447,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task)
                     // If CURLE_RANGE_ERROR, means the server not support resume from download.
                     pFileUtils->removeFile(coTask._checksumFileName);
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._segmentsFileName);
                 }
                 break;
             }
@@ -942,12 +1477,15 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task)
 
                 pFileUtils->removeFile(coTask._checksumFileName);
                 pFileUtils->removeFile(coTask._tempFileName);
+                pFileUtils->removeFile(coTask._segmentsFileName);
                 break;
             }
 
             // Rename file work fine.
             if (pFileUtils->renameFile(coTask._tempFileName, coTask._fileName))
             {
+                pFileUtils->removeFile(coTask._segmentsFileName);
+
                 auto lock = std::lock_guard<std::mutex>(DownloadTaskCURL::_sStoragePathSetMutex);
 
                 // success, remove storage from set
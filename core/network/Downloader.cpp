@@ -37,12 +37,68 @@
 #include <ctype.h>
 #include <algorithm>
 
+#include "base/Director.h"
+#include "base/Scheduler.h"
+
 namespace ax
 {
 
 namespace network
 {
 
+namespace
+{
+struct DownloadAwaiter
+{
+    std::string_view srcUrl;
+    std::string_view storagePath;  // empty to download to memory
+    std::string_view checksum;
+    std::unique_ptr<Downloader> downloader;
+    DownloadResult result;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(axstd::coroutine_handle<> handle)
+    {
+        // resumed after the callback returned, the downloader is deleted with the awaiter
+        auto resume = [handle] {
+            Director::getInstance()->getScheduler()->runOnAxmolThread([handle] { handle.resume(); });
+        };
+
+        downloader = std::make_unique<Downloader>();
+        downloader->onFileTaskSuccess = [resume](const DownloadTask&) { resume(); };
+        downloader->onDataTaskSuccess = [this, resume](const DownloadTask&, std::vector<unsigned char>& data) {
+            result.data = std::move(data);
+            resume();
+        };
+        downloader->onTaskError = [this, resume](const DownloadTask&, int errorCode, int errorCodeInternal,
+                                                 std::string_view errorStr) {
+            result.errorCode         = errorCode;
+            result.errorCodeInternal = errorCodeInternal;
+            result.errorStr          = errorStr;
+            resume();
+        };
+
+        if (storagePath.empty())
+            downloader->createDownloadDataTask(srcUrl);
+        else
+            downloader->createDownloadFileTask(srcUrl, storagePath, "", checksum);
+    }
+
+    DownloadResult await_resume() { return std::move(result); }
+};
+}  // namespace
+
+Task<DownloadResult> downloadFileAsync(std::string srcUrl, std::string storagePath, std::string checksum)
+{
+    co_return co_await DownloadAwaiter{srcUrl, storagePath, checksum};
+}
+
+Task<DownloadResult> downloadDataAsync(std::string srcUrl)
+{
+    co_return co_await DownloadAwaiter{srcUrl, {}, {}};
+}
+
 DownloadTask::DownloadTask()
 {
     AXLOGD("Construct DownloadTask {}", fmt::ptr(this));
@@ -98,6 +154,13 @@ Downloader::Downloader(const DownloaderHints& hints)
         }
     };
 
+    _impl->onTaskData = [this](const DownloadTask& task, const unsigned char* data, size_t size) {
+        if (!onDataTaskReceived)
+            return false;
+        onDataTaskReceived(task, data, size);
+        return true;
+    };
+
     _impl->onTaskFinish = [this](const DownloadTask& task, int errorCode, int errorCodeInternal,
                                  std::string_view errorStr, std::vector<unsigned char>& data) {
         if (DownloadTask::ERROR_NO_ERROR != errorCode)
@@ -134,9 +197,11 @@ Downloader::~Downloader()
 }
 
 std::shared_ptr<DownloadTask> Downloader::createDownloadDataTask(std::string_view srcUrl,
-                                                                 std::string_view identifier /* = ""*/)
+                                                                 std::string_view identifier /* = ""*/,
+                                                                 std::string_view etag /* = ""*/)
 {
-    auto task = std::make_shared<DownloadTask>(srcUrl, identifier);
+    auto task  = std::make_shared<DownloadTask>(srcUrl, identifier);
+    task->etag = etag;
 
     do
     {
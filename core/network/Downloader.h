@@ -26,12 +26,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <memory>
 #include <vector>
 
 #include "platform/PlatformMacros.h"
+#include "base/Async.h"
 
 namespace ax
 {
@@ -88,13 +90,23 @@ public:
     // Cancel the download, it's useful for ios platform switch wifi to 4g
     void cancel();
 
+    // Limit the download speed in bytes per second, 0 for no limit, it can be changed while downloading
+    void setSpeedLimit(int64_t bytesPerSecond) { _speedLimit = bytesPerSecond; }
+    int64_t getSpeedLimit() const { return _speedLimit; }
+
     std::string checksum;  // The MD5 checksum for check only when download finished.
     bool background;       // Does the task is background (all callback will invoke on downloader thread)
 
+    // The ETag of the response to a data task. The one given to createDownloadDataTask is sent as If-None-Match,
+    // when the server answers 304 the task succeeds without data and notModified is set.
+    std::string etag;
+    bool notModified = false;
+
 private:
     friend class Downloader;
     friend class DownloaderCURL;
     std::unique_ptr<IDownloadTask> _coTask;
+    std::atomic<int64_t> _speedLimit{0};
 };
 
 class AX_DLL DownloaderHints
@@ -103,6 +115,11 @@ public:
     uint32_t countOfMaxProcessingTasks;
     uint32_t timeoutInSeconds;
     std::string tempFileNameSuffix;
+
+    // The ranges a file task is downloaded in at the same time when the server accepts ranges, 1 for a single stream
+    uint32_t segmentsPerTask = 1;
+    // The minimum size of a range, a small file is split in fewer ranges
+    int64_t minSegmentSize = 4 * 1024 * 1024;
 };
 
 class AX_DLL Downloader final
@@ -116,6 +133,10 @@ public:
 
     std::function<void(const DownloadTask& task)> onFileTaskSuccess;
 
+    // Receives the bytes of the data tasks as they arrive, on the downloader thread. The data isn't buffered then,
+    // onDataTaskSuccess gets it only from the downloaders which can't stream. Set it before creating the tasks.
+    std::function<void(const DownloadTask& task, const unsigned char* data, size_t size)> onDataTaskReceived;
+
     std::function<void(const DownloadTask& task)> onTaskProgress;
 
     std::function<void(const DownloadTask& task, int errorCode, int errorCodeInternal, std::string_view errorStr)>
@@ -138,7 +159,9 @@ public:
         onTaskError = callback;
     };
 
-    std::shared_ptr<DownloadTask> createDownloadDataTask(std::string_view srcUrl, std::string_view identifier = "");
+    std::shared_ptr<DownloadTask> createDownloadDataTask(std::string_view srcUrl,
+                                                         std::string_view identifier = "",
+                                                         std::string_view etag       = "");
 
     std::shared_ptr<DownloadTask> createDownloadFileTask(std::string_view srcUrl,
                                                          std::string_view storagePath,
@@ -151,5 +174,25 @@ private:
     std::unique_ptr<IDownloaderImpl> _impl;
 };
 
+/** The result of a download, see downloadFileAsync and downloadDataAsync. */
+struct AX_DLL DownloadResult
+{
+    int errorCode         = DownloadTask::ERROR_NO_ERROR;
+    int errorCodeInternal = 0;
+    std::string errorStr;
+    std::vector<unsigned char> data;  // by downloadDataAsync
+
+    bool succeeded() const { return errorCode == DownloadTask::ERROR_NO_ERROR; }
+};
+
+/**
+ * Downloads a file with its own Downloader, as a task a coroutine can await, see ax::Task.
+ * The task ends on the axmol thread.
+ */
+AX_DLL Task<DownloadResult> downloadFileAsync(std::string srcUrl, std::string storagePath, std::string checksum = "");
+
+/** Downloads to memory with its own Downloader, as a task a coroutine can await, see ax::Task. */
+AX_DLL Task<DownloadResult> downloadDataAsync(std::string srcUrl);
+
 }  // namespace network
 }  // namespace ax
@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "network/HttpClient.h"
+
+#include <thread>
+
+#include "base/Director.h"
+#include "base/Scheduler.h"
+
+namespace ax
+{
+
+namespace network
+{
+
+Task<RefPtr<HttpResponse>> sendAsync(RefPtr<HttpRequest> request)
+{
+    struct ResponseAwaiter
+    {
+        HttpRequest* request;
+        RefPtr<HttpResponse> response;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(axstd::coroutine_handle<> handle)
+        {
+            request->setResponseCallback([this, handle](HttpClient*, HttpResponse* received) {
+                response = received;
+
+                // on a worker when the client dispatches there
+                auto director = Director::getInstance();
+                if (std::this_thread::get_id() == director->getAxmolThreadId())
+                    handle.resume();
+                else
+                    director->getScheduler()->runOnAxmolThread([handle] { handle.resume(); });
+            });
+            HttpClient::getInstance()->send(request);
+        }
+
+        RefPtr<HttpResponse> await_resume() { return std::move(response); }
+    };
+
+    co_return co_await ResponseAwaiter{request.get()};
+}
+
+}  // namespace network
+
+}  // namespace ax
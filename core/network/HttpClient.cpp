@@ -62,6 +62,16 @@ static void __clearQueueUnsafe(_Cont& queue, _Fty pred)
     }
 }
 
+static std::string makeOrigin(const Uri& uri)
+{
+    std::string origin{uri.getScheme()};
+    origin += "://";
+    origin += uri.getHost();
+    origin += ':';
+    origin += std::to_string(uri.getPort());
+    return origin;
+}
+
 // HttpClient implementation
 HttpClient* HttpClient::getInstance()
 {
@@ -118,6 +128,7 @@ HttpClient::HttpClient()
     , _dispatchOnWorkThread(false)
     , _timeoutForConnect(30)
     , _timeoutForRead(60)
+    , _keepAliveTimeout(DEFAULT_KEEP_ALIVE_TIMEOUT)
     , _cookie(nullptr)
     , _clearResponsePredicate(nullptr)
 {
@@ -182,6 +193,12 @@ void HttpClient::tickInput()
 void HttpClient::handleNetworkStatusChanged()
 {
     _service->set_option(YOPT_S_DNS_DIRTY, 1);
+
+    // the idle connections were likely lost with the previous network
+    _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+        closeIdleChannels(_idleChannels.size());
+        return true;
+    });
 }
 
 void HttpClient::setNameServers(std::string_view servers)
@@ -199,10 +216,69 @@ void HttpClient::send(HttpRequest* request)
     if (!request)
         return;
 
-    auto response = new HttpResponse(request);
+    auto response         = new HttpResponse(request);
+    response->_sentTime   = HttpResponse::Clock::now();
+    response->_timingMark = response->_sentTime;
     response->setLocation(request->getUrl(), false);
-    processResponse(response, -1);
-    response->release();
+    if (response->validateUri())
+    {
+        queueResponse(response);
+
+        // the channels are only assigned on the network thread
+        _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+            dispatchPendingResponses();
+            return true;
+        });
+    }
+    else
+        finishResponse(response);
+}
+
+void HttpClient::queueResponse(HttpResponse* response)
+{
+    auto priority = response->getHttpRequest()->getPriority();
+
+    auto lck = _pendingResponseQueue.get_lock();
+    auto it  = _pendingResponseQueue.unsafe_begin();
+    while (it != _pendingResponseQueue.unsafe_end() && (*it)->getHttpRequest()->getPriority() >= priority)
+        ++it;
+    _pendingResponseQueue.unsafe_insert(it, response);
+}
+
+void HttpClient::dispatchPendingResponses()
+{
+    size_t starved = 0;
+    for (;;)
+    {
+        HttpResponse* response = nullptr;
+        int channelIndex       = -1;
+        bool reuseConnection   = false;
+        starved                = 0;
+
+        auto lck = _pendingResponseQueue.get_lock();
+        for (auto it = _pendingResponseQueue.unsafe_begin(); it != _pendingResponseQueue.unsafe_end(); ++it)
+        {
+            channelIndex    = (*it)->_staleRetried ? -1 : tryTakeIdleChannel(makeOrigin((*it)->getRequestUri()));
+            reuseConnection = channelIndex != -1;
+            if (!reuseConnection)
+                channelIndex = tryTakeAvailChannel();
+            if (channelIndex != -1)
+            {
+                response = *it;
+                _pendingResponseQueue.unsafe_erase(it);
+                break;
+            }
+            ++starved;
+        }
+        lck.unlock();
+
+        if (!response)
+            break;
+        processResponse(response, channelIndex, reuseConnection);
+    }
+
+    // the idle connections left are to other hosts, close them for the requests waiting
+    closeIdleChannels(starved);
 }
 
 int HttpClient::tryTakeAvailChannel()
@@ -217,32 +293,211 @@ int HttpClient::tryTakeAvailChannel()
     return -1;
 }
 
-void HttpClient::processResponse(HttpResponse* response, int channelIndex)
+int HttpClient::tryTakeIdleChannel(std::string_view origin)
 {
-    response->retain();
+    // the most recently used first, the least likely to be closed by the server
+    for (auto it = _idleChannels.rbegin(); it != _idleChannels.rend(); ++it)
+    {
+        int channelIndex = *it;
+        if (_channelStates[channelIndex].origin == origin)
+        {
+            _idleChannels.erase(std::next(it).base());
+            return channelIndex;
+        }
+    }
+    return -1;
+}
 
-    if (response->validateUri())
+void HttpClient::keepChannelAlive(yasio::io_channel* channel)
+{
+    int channelIndex = channel->index();
+    _idleChannels.push_back(channelIndex);
+
+    auto& timerForIdle = channel->get_user_timer();
+    timerForIdle.cancel();
+    timerForIdle.expires_from_now(std::chrono::seconds(getKeepAliveTimeout()));
+    timerForIdle.async_wait([this, channelIndex](io_service& s) {
+        auto it = std::find(_idleChannels.begin(), _idleChannels.end(), channelIndex);
+        if (it != _idleChannels.end())
+        {
+            _idleChannels.erase(it);
+            s.close(channelIndex);
+        }
+        return true;
+    });
+}
+
+void HttpClient::recycleChannel(yasio::io_channel* channel)
+{
+    int channelIndex = channel->index();
+    auto it          = std::find(_idleChannels.begin(), _idleChannels.end(), channelIndex);
+    if (it != _idleChannels.end())
+        _idleChannels.erase(it);
+
+    auto& state = _channelStates[channelIndex];
+    state.origin.clear();
+    state.transport = nullptr;
+
+    channel->get_user_timer().cancel();
+    _availChannelQueue.push_front(channelIndex);
+}
+
+void HttpClient::closeIdleChannels(size_t count)
+{
+    for (; count > 0 && !_idleChannels.empty(); --count)
+    {
+        int channelIndex = _idleChannels.front();
+        _idleChannels.pop_front();
+        _service->close(channelIndex);  // recycled on YEK_ON_CLOSE
+    }
+}
+
+void HttpClient::processResponse(HttpResponse* response, int channelIndex, bool reuseConnection)
+{
+    auto channel     = _service->channel_at(channelIndex);
+    channel->ud_.ptr = response;
+
+    response->markTiming(response->_timing.queued);
+    response->_connectionReused = reuseConnection;
+    if (reuseConnection)
+    {
+        sendRequest(response, channel);
+        return;
+    }
+
+    auto& requestUri                    = response->getRequestUri();
+    _channelStates[channelIndex].origin = makeOrigin(requestUri);
+    _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
+                         (int)requestUri.getPort());
+    if (requestUri.isSecure())
+        _service->open(channelIndex, YCK_SSL_CLIENT);
+    else
+        _service->open(channelIndex, YCK_TCP_CLIENT);
+}
+
+void HttpClient::sendRequest(HttpResponse* response, yasio::io_channel* channel)
+{
+    obstream obs;
+    bool usePostData = false;
+    auto request     = response->getHttpRequest();
+    switch (request->getRequestType())
     {
-        if (channelIndex == -1)
-            channelIndex = tryTakeAvailChannel();
+    case HttpRequest::Type::GET:
+        obs.write_bytes("GET");
+        break;
+    case HttpRequest::Type::PATCH:
+        obs.write_bytes("PATCH");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::POST:
+        obs.write_bytes("POST");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::DELETE:
+        obs.write_bytes("DELETE");
+        break;
+    case HttpRequest::Type::PUT:
+        obs.write_bytes("PUT");
+        usePostData = true;
+        break;
+    default:
+        obs.write_bytes("GET");
+        break;
+    }
+    obs.write_bytes(" ");
+
+    auto& uri = response->getRequestUri();
+    obs.write_bytes(uri.getPathEtc());
 
-        if (channelIndex != -1)
+    obs.write_bytes(" HTTP/1.1\r\n");
+
+    obs.write_bytes("Host: ");
+    obs.write_bytes(uri.getHost());
+    obs.write_bytes("\r\n");
+
+    // process custom headers
+    struct HeaderFlag
+    {
+        enum
         {
-            auto channelHandle = _service->channel_at(channelIndex);
-            auto& requestUri = response->getRequestUri();
-            channelHandle->ud_.ptr = response;
-            _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
-                                 (int)requestUri.getPort());
-            if (requestUri.isSecure())
-                _service->open(channelIndex, YCK_SSL_CLIENT);
-            else
-                _service->open(channelIndex, YCK_TCP_CLIENT);
+            UESR_AGENT   = 1,
+            CONTENT_TYPE = 1 << 1,
+            ACCEPT       = 1 << 2,
+            CONNECTION   = 1 << 3,
+        };
+    };
+    int headerFlags = 0;
+    auto& headers   = request->getHeaders();
+    if (!headers.empty())
+    {
+        using namespace cxx17;  // for string_view literal
+        for (auto&& header : headers)
+        {
+            obs.write_bytes(header);
+            obs.write_bytes("\r\n");
+
+            if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
+                headerFlags |= HeaderFlag::UESR_AGENT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
+                headerFlags |= HeaderFlag::CONTENT_TYPE;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
+                headerFlags |= HeaderFlag::ACCEPT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Connection:"_sv))
+                headerFlags |= HeaderFlag::CONNECTION;
         }
-        else
-            _pendingResponseQueue.emplace_back(response);
+    }
+
+    if (_cookie)
+    {
+        auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
+        if (!cookies.empty())
+        {
+            obs.write_bytes("Cookie: ");
+            obs.write_bytes(cookies);
+        }
+    }
+
+    if (!(headerFlags & HeaderFlag::UESR_AGENT))
+        obs.write_bytes("User-Agent: yasio-http\r\n");
+
+    if (!(headerFlags & HeaderFlag::ACCEPT))
+        obs.write_bytes("Accept: */*;q=0.8\r\n");
+
+    // HTTP/1.1 connections are persistent unless one side closes them
+    if (!(headerFlags & HeaderFlag::CONNECTION) && getKeepAliveTimeout() <= 0)
+        obs.write_bytes("Connection: close\r\n");
+
+    if (usePostData)
+    {
+        if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
+            obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
+
+        char strContentLength[128] = {0};
+        auto requestData           = request->getRequestData();
+        auto requestDataSize       = request->getRequestDataSize();
+        snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
+                 static_cast<int>(requestDataSize));
+        obs.write_bytes(strContentLength);
+
+        if (requestData && requestDataSize > 0)
+            obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
     }
     else
-        finishResponse(response);
+    {
+        obs.write_bytes("\r\n");
+    }
+
+    int channelIndex = channel->index();
+    _service->write(_channelStates[channelIndex].transport, std::move(obs.buffer()));
+
+    auto& timerForRead = channel->get_user_timer();
+    timerForRead.cancel();
+    timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
+    timerForRead.async_wait([response, channelIndex](io_service& s) {
+        response->updateInternalCode(yasio::errc::read_timeout);
+        s.close(channelIndex);  // timeout
+        return true;
+    });
 }
 
 void HttpClient::handleNetworkEvent(yasio::io_event* event)
@@ -250,7 +505,19 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
     int channelIndex       = event->cindex();
     auto channel           = _service->channel_at(event->cindex());
     HttpResponse* response = (HttpResponse*)channel->ud_.ptr;
-    assert(response);
+
+    if (!response)
+    {
+        // an idle connection, closed by the server or by the keep alive timeout
+        if (event->kind() == YEK_ON_CLOSE)
+        {
+            recycleChannel(channel);
+            dispatchPendingResponses();
+        }
+        else if (event->kind() == YEK_ON_PACKET)
+            _service->close(channelIndex);  // nothing was requested
+        return;
+    }
 
     bool responseFinished = response->isFinished();
     switch (event->kind())
@@ -264,133 +531,44 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
         if (response->isFinished())
         {
             response->updateInternalCode(yasio::errc::eof);
-            _service->close(event->cindex());
+            if (!responseFinished && response->isKeepAlive() && getKeepAliveTimeout() > 0)
+            {
+                handleNetworkEOF(response, channel, yasio::errc::eof);
+                keepChannelAlive(channel);
+                dispatchPendingResponses();
+            }
+            else
+                _service->close(event->cindex());
         }
         break;
     case YEK_ON_OPEN:
         if (event->status() == 0)
         {
-            obstream obs;
-            bool usePostData = false;
-            auto request     = response->getHttpRequest();
-            switch (request->getRequestType())
-            {
-            case HttpRequest::Type::GET:
-                obs.write_bytes("GET");
-                break;
-            case HttpRequest::Type::PATCH:
-                obs.write_bytes("PATCH");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::POST:
-                obs.write_bytes("POST");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::DELETE:
-                obs.write_bytes("DELETE");
-                break;
-            case HttpRequest::Type::PUT:
-                obs.write_bytes("PUT");
-                usePostData = true;
-                break;
-            default:
-                obs.write_bytes("GET");
-                break;
-            }
-            obs.write_bytes(" ");
-
-            auto& uri = response->getRequestUri();
-            obs.write_bytes(uri.getPathEtc());
-
-            obs.write_bytes(" HTTP/1.1\r\n");
-
-            obs.write_bytes("Host: ");
-            obs.write_bytes(uri.getHost());
-            obs.write_bytes("\r\n");
-
-            // process custom headers
-            struct HeaderFlag
-            {
-                enum
-                {
-                    UESR_AGENT   = 1,
-                    CONTENT_TYPE = 1 << 1,
-                    ACCEPT       = 1 << 2,
-                };
-            };
-            int headerFlags = 0;
-            auto& headers   = request->getHeaders();
-            if (!headers.empty())
-            {
-                using namespace cxx17;  // for string_view literal
-                for (auto&& header : headers)
-                {
-                    obs.write_bytes(header);
-                    obs.write_bytes("\r\n");
-
-                    if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
-                        headerFlags |= HeaderFlag::UESR_AGENT;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
-                        headerFlags |= HeaderFlag::CONTENT_TYPE;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
-                        headerFlags |= HeaderFlag::ACCEPT;
-                }
-            }
-
-            if (_cookie)
-            {
-                auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
-                if (!cookies.empty())
-                {
-                    obs.write_bytes("Cookie: ");
-                    obs.write_bytes(cookies);
-                }
-            }
-
-            if (!(headerFlags & HeaderFlag::UESR_AGENT))
-                obs.write_bytes("User-Agent: yasio-http\r\n");
-
-            if (!(headerFlags & HeaderFlag::ACCEPT))
-                obs.write_bytes("Accept: */*;q=0.8\r\n");
-
-            if (usePostData)
-            {
-                if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
-                    obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
-
-                char strContentLength[128] = {0};
-                auto requestData           = request->getRequestData();
-                auto requestDataSize       = request->getRequestDataSize();
-                snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
-                         static_cast<int>(requestDataSize));
-                obs.write_bytes(strContentLength);
-
-                if (requestData && requestDataSize > 0)
-                    obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
-            }
-            else
-            {
-                obs.write_bytes("\r\n");
-            }
-
-            _service->write(event->transport(), std::move(obs.buffer()));
-
-            auto& timerForRead = channel->get_user_timer();
-            timerForRead.cancel();
-            timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
-            timerForRead.async_wait([=](io_service& s) {
-                response->updateInternalCode(yasio::errc::read_timeout);
-                s.close(channelIndex);  // timeout
-                return true;
-            });
+            _channelStates[channelIndex].transport = event->transport();
+            response->markTiming(response->_timing.connect);
+            sendRequest(response, channel);
         }
         else
         {
             handleNetworkEOF(response, channel, event->status());
+            recycleChannel(channel);
+            dispatchPendingResponses();
         }
         break;
     case YEK_ON_CLOSE:
-        handleNetworkEOF(response, channel, event->status());
+        if (response->isConnectionReused() && !response->hasReceivedData() && response->getInternalCode() == 0 &&
+            !response->_staleRetried && response->getHttpRequest()->getRequestType() != HttpRequest::Type::POST &&
+            response->getHttpRequest()->getRequestType() != HttpRequest::Type::PATCH)
+        {
+            // the server closed the idle connection before it got the request, send it again on a new one
+            channel->ud_.ptr        = nullptr;
+            response->_staleRetried = true;
+            _pendingResponseQueue.push_front(response);
+        }
+        else
+            handleNetworkEOF(response, channel, event->status());
+        recycleChannel(channel);
+        dispatchPendingResponses();
         break;
     }
 }
@@ -409,28 +587,11 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
     case 307:
         if (response->tryRedirect())
         {
-            processResponse(response, channel->index());
-            response->release();
+            _pendingResponseQueue.push_front(response);
             break;
         }
     default:
         finishResponse(response);
-
-        // try process pending response
-        auto lck = _pendingResponseQueue.get_lock();
-        if (!_pendingResponseQueue.unsafe_empty())
-        {
-            auto pendingResponse = _pendingResponseQueue.unsafe_front();
-            _pendingResponseQueue.unsafe_pop_front();
-            lck.unlock();
-
-            processResponse(pendingResponse, channel->index());
-            pendingResponse->release();
-        }
-        else
-        {  // recycle channel
-            _availChannelQueue.push_front(channel->index());
-        }
     }
 }
 
@@ -446,6 +607,9 @@ void HttpClient::finishResponse(HttpResponse* response)
             _cookie->updateOrAddCookie(cookieIt->second, response->_requestUri);
     }
 
+    response->_timing.total =
+        std::chrono::duration<float>(HttpResponse::Clock::now() - response->_sentTime).count();
+
     if (!syncState)
     {
         if (_dispatchOnWorkThread || std::this_thread::get_id() == Director::getInstance()->getAxmolThreadId())
@@ -513,6 +677,18 @@ int HttpClient::getTimeoutForRead()
     return _timeoutForRead;
 }
 
+void HttpClient::setKeepAliveTimeout(int value)
+{
+    std::lock_guard<std::recursive_mutex> lock(_keepAliveTimeoutMutex);
+    _keepAliveTimeout = value;
+}
+
+int HttpClient::getKeepAliveTimeout()
+{
+    std::lock_guard<std::recursive_mutex> lock(_keepAliveTimeoutMutex);
+    return _keepAliveTimeout;
+}
+
 std::string_view HttpClient::getCookieFilename()
 {
     std::lock_guard<std::recursive_mutex> lock(_cookieFileMutex);
@@ -66,6 +66,11 @@ public:
      */
     static const int MAX_CHANNELS       = 21;
 
+    /**
+     * How many seconds an idle connection is kept open by default.
+     */
+    static const int DEFAULT_KEEP_ALIVE_TIMEOUT = 15;
+
     /**
      * Get instance of HttpClient.
      *
@@ -150,6 +155,21 @@ public:
      */
     int getTimeoutForRead();
 
+    /**
+     * Set how many seconds a connection is kept open after a response, for the next request to the same host.
+     * A request to a host with an idle connection skips the name resolution, TCP and TLS handshakes.
+     *
+     * @param value the timeout in seconds, 0 to close the connection after every response.
+     */
+    void setKeepAliveTimeout(int value);
+
+    /**
+     * Get how many seconds a connection is kept open after a response.
+     *
+     * @return int the timeout in seconds.
+     */
+    int getKeepAliveTimeout();
+
     HttpCookie* getCookie() const { return _cookie; }
 
     std::recursive_mutex& getCookieFileMutex() { return _cookieFileMutex; }
@@ -201,10 +221,32 @@ private:
     HttpClient();
     virtual ~HttpClient();
 
-    void processResponse(HttpResponse* response, int channelIndex);
+    // the state of a channel, only used on the network thread
+    struct ChannelState
+    {
+        std::string origin;  // scheme://host:port of the connection
+        yasio::transport_handle_t transport = nullptr;
+    };
+
+    void queueResponse(HttpResponse* response);
+
+    // assigns the pending responses to the idle connections of their host, or to the free channels
+    void dispatchPendingResponses();
+
+    void processResponse(HttpResponse* response, int channelIndex, bool reuseConnection);
+
+    void sendRequest(HttpResponse* response, yasio::io_channel* channel);
 
     int tryTakeAvailChannel();
 
+    int tryTakeIdleChannel(std::string_view origin);
+
+    void keepChannelAlive(yasio::io_channel* channel);
+
+    void recycleChannel(yasio::io_channel* channel);
+
+    void closeIdleChannels(size_t count);
+
     void handleNetworkEvent(yasio::io_event* event);
 
     void handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode);
@@ -228,6 +270,9 @@ private:
     int _timeoutForRead;
     std::recursive_mutex _timeoutForReadMutex;
 
+    int _keepAliveTimeout;
+    std::recursive_mutex _keepAliveTimeoutMutex;
+
     Scheduler* _scheduler;
 
     ConcurrentDeque<HttpResponse*> _pendingResponseQueue;
@@ -235,6 +280,9 @@ private:
 
     ConcurrentDeque<int> _availChannelQueue;
 
+    ChannelState _channelStates[MAX_CHANNELS];
+    std::deque<int> _idleChannels;  // the least recently used first
+
     std::string _cookieFilename;
     std::recursive_mutex _cookieFileMutex;
 
@@ -258,3 +306,23 @@ private:
 #include "network/HttpClient-wasm.h"
 
 #endif
+
+#include "base/Async.h"
+#include "base/RefPtr.h"
+
+namespace ax
+{
+
+namespace network
+{
+
+/**
+ * Sends a request with HttpClient::send, as a task a coroutine can await, see ax::Task.
+ * The response callback of the request is replaced, the task gives the response instead, on the axmol thread.
+ * @lua NA
+ */
+AX_DLL Task<RefPtr<HttpResponse>> sendAsync(RefPtr<HttpRequest> request);
+
+}  // namespace network
+
+}
@@ -101,6 +101,16 @@ public:
         UNKNOWN,
     };
 
+    /**
+     * The order the pending requests are sent in, when all the connections of HttpClient are busy.
+     */
+    enum class Priority
+    {
+        LOW,
+        NORMAL,
+        HIGH,
+    };
+
     /**
      *  Constructor.
      *   Because HttpRequest object will be used between UI thread and network thread,
@@ -251,6 +261,13 @@ public:
     void setHosts(std::vector<std::string> hosts) { _hosts = std::move(hosts); }
     const std::vector<std::string>& getHosts() const { return _hosts; }
 
+    /**
+     * Set the priority of the request, the requests of a higher priority are sent first, the ones of a same
+     * priority in the order they are sent.
+     */
+    void setPriority(Priority priority) { _priority = priority; }
+    Priority getPriority() const { return _priority; }
+
 private:
     void setSync(bool sync)
     {
@@ -279,6 +296,7 @@ protected:
     void* _pUserData;                   /// You can add your customed data here
     std::vector<std::string> _headers;  /// custom http headers
     std::vector<std::string> _hosts;
+    Priority _priority = Priority::NORMAL;
 
     std::shared_ptr<std::promise<HttpResponse*>> _syncState;
 };
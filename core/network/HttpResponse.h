@@ -28,6 +28,7 @@
 #ifndef __HTTP_RESPONSE__
 #define __HTTP_RESPONSE__
 #include <ctype.h>
+#include <chrono>
 #include <map>
 #include <unordered_map>
 #include "network/HttpRequest.h"
@@ -59,6 +60,17 @@ class AX_DLL HttpResponse : public TSFRefCountedBase
 public:
     using ResponseHeaderMap = std::multimap<std::string, std::string>;
 
+    /**
+     * The time the stages of a request took, in seconds. The times of the redirects are added up.
+     */
+    struct Timing
+    {
+        float queued    = 0;  /// waiting for a free connection
+        float connect   = 0;  /// the name resolution, TCP and TLS handshakes, 0 on a reused connection
+        float firstByte = 0;  /// from the request written to the first byte of the response
+        float total     = 0;  /// from HttpClient::send to the end of the response
+    };
+
     /**
      * Constructor, it's used by HttpClient internal, users don't need to create HttpResponse manually.
      * @param request the corresponding HttpRequest which leads to this response.
@@ -130,7 +142,29 @@ public:
 
     const ResponseHeaderMap& getResponseHeaders() const { return _responseHeaders; }
 
+    const Timing& getTiming() const { return _timing; }
+
+    /**
+     * Whether the response was received on a connection kept alive by a previous request to the same host.
+     */
+    bool isConnectionReused() const { return _connectionReused; }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /** Adds the time since the previous mark to a stage of the timing. */
+    void markTiming(float& stage)
+    {
+        auto now = Clock::now();
+        stage += std::chrono::duration<float>(now - _timingMark).count();
+        _timingMark = now;
+    }
+
+    /** Whether the server keeps the connection open after the response. */
+    bool isKeepAlive() const { return _keepAlive; }
+
+    bool hasReceivedData() const { return _receivedData; }
+
     void setResponseCode(int value) { _responseCode = value; }
 
     void updateInternalCode(int value)
@@ -146,6 +180,12 @@ private:
 
     void handleInput(const char* d, size_t n)
     {
+        if (!_receivedData)
+        {
+            _receivedData     = true;
+            _timing.firstByte = 0;
+            markTiming(_timing.firstByte);
+        }
         enum llhttp_errno err = llhttp_execute(&_context, d, n);
         if (err != HPE_OK)
         {
@@ -197,6 +237,8 @@ private:
             _currentHeader.clear();
             _responseCode = -1;
             _internalCode = 0;
+            _receivedData = false;
+            _keepAlive    = false;
 
             /* Initialize user callbacks and settings */
             llhttp_settings_init(&_contextSettings);
@@ -261,6 +303,7 @@ private:
         auto thiz           = (HttpResponse*)context->data;
         thiz->_responseCode = context->status_code;
         thiz->_finished     = true;
+        thiz->_keepAlive    = llhttp_should_keep_alive(context) != 0;
         return 0;
     }
 
@@ -277,6 +320,13 @@ protected:
     ResponseHeaderMap _responseHeaders;  /// the returned raw header data. You can also dump it as a string
     int _responseCode = -1;              /// the status code returned from server, e.g. 200, 404
     int _internalCode = 0;               /// the ret code of perform
+    bool _receivedData     = false;
+    bool _keepAlive        = false;
+    bool _connectionReused = false;
+    bool _staleRetried     = false;  /// resent on a new connection after a reused one was closed by the server
+    Timing _timing;
+    Clock::time_point _sentTime;
+    Clock::time_point _timingMark;
     llhttp_t _context;
     llhttp_settings_t _contextSettings;
 };
@@ -53,6 +53,9 @@ public:
 
     std::function<void(const DownloadTask& task)> onTaskProgress;
 
+    // returns false when the data isn't consumed, it's buffered for onTaskFinish then
+    std::function<bool(const DownloadTask& task, const unsigned char* data, size_t size)> onTaskData;
+
     std::function<void(const DownloadTask& task,
                        int errorCode,
                        int errorCodeInternal,
@@ -0,0 +1,507 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cmath>
+
+#include "yasio/yasio.hpp"
+
+#include "network/RealtimeClient.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
+
+using namespace yasio;
+
+#define RT_RELIABLE_CHANNEL   0
+#define RT_UNRELIABLE_CHANNEL 1
+
+#define RT_PING_SIZE (1 + 12)  // type, sequence and timestamp
+
+// the largest packet of the TCP channel
+#define RT_MAX_STREAM_PACKET_LENGTH (1 << 24)  // 16M
+
+#define RT_MAX_POOLED_BUFFERS     256
+#define RT_MAX_POOLED_BUFFER_SIZE (64 * 1024)
+
+namespace ax
+{
+
+namespace network
+{
+
+static inline void writeBE16(char* p, uint16_t value)
+{
+    p[0] = static_cast<char>(value >> 8);
+    p[1] = static_cast<char>(value);
+}
+
+static inline void writeBE32(char* p, uint32_t value)
+{
+    writeBE16(p, static_cast<uint16_t>(value >> 16));
+    writeBE16(p + 2, static_cast<uint16_t>(value));
+}
+
+static inline uint16_t readBE16(const char* p)
+{
+    return static_cast<uint16_t>((static_cast<uint8_t>(p[0]) << 8) | static_cast<uint8_t>(p[1]));
+}
+
+static inline uint32_t readBE32(const char* p)
+{
+    return (static_cast<uint32_t>(readBE16(p)) << 16) | readBE16(p + 2);
+}
+
+RealtimeClient::RealtimeClient()
+{
+    _service   = new yasio::io_service(2);
+    _scheduler = Director::getInstance()->getScheduler();
+    _service->set_option(yasio::YOPT_S_FORWARD_PACKET, 1);  // the packets are copied to the pooled buffers
+    _service->set_option(yasio::YOPT_S_DNS_QUERIES_TIMEOUT, 3);
+    _service->set_option(yasio::YOPT_S_DNS_QUERIES_TRIES, 1);
+    _service->start([this](yasio::event_ptr&& e) { handleNetworkEvent(e.get()); });
+
+    _scheduler->schedule([this](float) { dispatchEvents(); }, this, 0, false, "#");
+}
+
+RealtimeClient::~RealtimeClient()
+{
+    delete _service;
+
+    _scheduler->unscheduleAllForTarget(this);
+}
+
+bool RealtimeClient::open(Delegate* delegate, std::string_view host, uint16_t reliablePort, uint16_t unreliablePort)
+{
+    if (_state != State::CLOSED || (reliablePort == 0 && unreliablePort == 0))
+        return false;
+
+    _delegate = delegate;
+
+    {
+        std::lock_guard<std::mutex> lck(_statsMtx);
+        _stats      = Stats{};
+        _rttSampled = false;
+    }
+    _sendSequence = 0;
+
+    _channelEnabled[RT_RELIABLE_CHANNEL]   = reliablePort != 0;
+    _channelEnabled[RT_UNRELIABLE_CHANNEL] = unreliablePort != 0;
+
+    std::string hostName{host};
+    _state = State::CONNECTING;
+    if (reliablePort)
+    {
+        _service->set_option(YOPT_C_REMOTE_ENDPOINT, RT_RELIABLE_CHANNEL, hostName.c_str(), (int)reliablePort);
+#if defined(YASIO_ENABLE_KCP)
+        _service->set_option(YOPT_C_KCP_CONV, RT_RELIABLE_CHANNEL, (int)_kcpConv);
+        _service->set_option(YOPT_C_KCP_NODELAY, RT_RELIABLE_CHANNEL, 1, 10, 2, 1);  // the fast mode of KCP
+        _service->open(RT_RELIABLE_CHANNEL, YCK_KCP_CLIENT);
+#else
+        _service->open(RT_RELIABLE_CHANNEL, YCK_TCP_CLIENT);
+#endif
+    }
+    if (unreliablePort)
+    {
+        _service->set_option(YOPT_C_REMOTE_ENDPOINT, RT_UNRELIABLE_CHANNEL, hostName.c_str(), (int)unreliablePort);
+        _service->open(RT_UNRELIABLE_CHANNEL, YCK_UDP_CLIENT);
+    }
+    return true;
+}
+
+void RealtimeClient::close()
+{
+    State state = _state;
+    if (state == State::CONNECTING || state == State::OPEN)
+        closeChannels();
+}
+
+bool RealtimeClient::send(Channel channel, const void* data, size_t len)
+{
+    if (_state != State::OPEN)
+        return false;
+
+    int ret;
+    if (channel == Channel::UNRELIABLE)
+    {
+        char header[2];
+        writeBE16(header, _sendSequence++);
+        ret = writePacket(channel, PacketType::DATA, header, sizeof(header), static_cast<const char*>(data), len);
+    }
+    else
+        ret = writePacket(channel, PacketType::DATA, nullptr, 0, static_cast<const char*>(data), len);
+    if (ret < 0)
+        return false;
+
+    std::lock_guard<std::mutex> lck(_statsMtx);
+    ++_stats.packetsSent;
+    _stats.bytesSent += len;
+    return true;
+}
+
+RealtimeClient::Stats RealtimeClient::getStats() const
+{
+    std::lock_guard<std::mutex> lck(_statsMtx);
+    auto stats = _stats;
+    if (stats.packetsLost)
+        stats.packetLoss = static_cast<float>(stats.packetsLost) / (stats.packetsReceived + stats.packetsLost);
+    return stats;
+}
+
+int RealtimeClient::writePacket(Channel channel,
+                                PacketType type,
+                                const char* header,
+                                size_t headerLen,
+                                const char* data,
+                                size_t len)
+{
+    auto transport = _transports[(int)channel].load();
+    if (!transport)
+        return -1;
+
+#if defined(YASIO_ENABLE_KCP)
+    constexpr bool stream = false;
+#else
+    bool stream = channel == Channel::RELIABLE;
+#endif
+    size_t packetLen = 1 + headerLen + len;
+
+    yasio::sbyte_buffer buffer;
+    buffer.resize((stream ? 4 : 0) + packetLen);
+    auto p = buffer.data();
+    if (stream)
+    {
+        writeBE32(p, static_cast<uint32_t>(packetLen));
+        p += 4;
+    }
+    *p++ = static_cast<char>(type);
+    if (headerLen)
+        memcpy(p, header, headerLen);
+    if (len)
+        memcpy(p + headerLen, data, len);
+    return _service->write(transport, std::move(buffer));
+}
+
+void RealtimeClient::postEvent(ClientEvent&& event)
+{
+    std::lock_guard<std::mutex> lck(_eventsMtx);
+    _events.emplace_back(std::move(event));
+}
+
+void RealtimeClient::handleNetworkEvent(yasio::io_event* event)
+{
+    int index = event->cindex();
+    switch (event->kind())
+    {
+    case YEK_ON_OPEN:
+        if (event->status() == 0)
+        {
+            _transports[index] = event->transport();
+            ++_openChannels;
+
+            // closed, or another channel failed, while connecting
+            if (_state != State::CONNECTING)
+            {
+                _service->close(index);
+                break;
+            }
+            if (_openChannels != (int)_channelEnabled[0] + (int)_channelEnabled[1])
+                break;
+
+            _state  = State::OPEN;
+            _opened             = true;
+            _lastReceiveTime    = yasio::clock();
+            _pingSequence       = 0;
+            _hasReceiveSequence = false;
+            _streamData.clear();
+            postEvent(ClientEvent{ClientEvent::Type::ON_OPEN});
+
+            if (_pingInterval > 0)
+                _service->schedule(std::chrono::milliseconds(_pingInterval),
+                                   [this](io_service&) { return checkPing(); });
+        }
+        else
+        {
+            if (_state == State::CONNECTING)
+            {
+                AXLOGW("RealtimeClient: connect channel {} fail, status: {}", index, event->status());
+                postEvent(ClientEvent{ClientEvent::Type::ON_ERROR, static_cast<Channel>(index),
+                                      ErrorCode::CONNECTION_FAILURE});
+                closeChannels();
+            }
+            if (_openChannels == 0)
+                _state = State::CLOSED;
+        }
+        break;
+    case YEK_ON_PACKET:
+    {
+        auto&& pkt = event->packet_view();
+#if !defined(YASIO_ENABLE_KCP)
+        if (index == RT_RELIABLE_CHANNEL)
+            handleStreamData(pkt.data(), pkt.size());
+        else
+#endif
+            handlePacket(static_cast<Channel>(index), pkt.data(), pkt.size());
+        break;
+    }
+    case YEK_ON_CLOSE:
+        _transports[index] = nullptr;
+        if (_state == State::OPEN)
+        {
+            postEvent(ClientEvent{ClientEvent::Type::ON_ERROR, static_cast<Channel>(index), ErrorCode::CONNECTION_LOST});
+            closeChannels();
+        }
+        if (--_openChannels == 0)
+        {
+            _state = State::CLOSED;
+            if (_opened)
+            {
+                _opened = false;
+                postEvent(ClientEvent{ClientEvent::Type::ON_CLOSE});
+            }
+        }
+        break;
+    }
+}
+
+void RealtimeClient::closeChannels()
+{
+    _state = State::CLOSING;
+    for (int index = 0; index < 2; ++index)
+        if (_channelEnabled[index])
+            _service->close(index);
+}
+
+void RealtimeClient::handleStreamData(const char* data, size_t len)
+{
+    // the stream packets are parsed in place unless a partial one is pending
+    if (!_streamData.empty())
+    {
+        _streamData.append(data, data + len);
+        data = _streamData.data();
+        len  = _streamData.size();
+    }
+
+    size_t offset = 0;
+    while (len - offset >= 4)
+    {
+        auto packetLen = readBE32(data + offset);
+        if (packetLen == 0 || packetLen > RT_MAX_STREAM_PACKET_LENGTH)
+        {
+            AXLOGE("RealtimeClient: invalid packet length: {}", packetLen);
+            _streamData.clear();
+            closeChannels();
+            return;
+        }
+        if (len - offset - 4 < packetLen)
+            break;
+        handlePacket(Channel::RELIABLE, data + offset + 4, packetLen);
+        offset += 4 + packetLen;
+    }
+
+    if (data == _streamData.data())
+        _streamData.erase(_streamData.begin(), _streamData.begin() + offset);
+    else if (offset != len)
+        _streamData.assign(data + offset, data + len);
+}
+
+void RealtimeClient::handlePacket(Channel channel, const char* data, size_t len)
+{
+    _lastReceiveTime = yasio::clock();
+    if (len == 0)
+        return;
+
+    switch (static_cast<uint8_t>(data[0]))
+    {
+    case PacketType::DATA:
+    {
+        ++data;
+        --len;
+        if (channel == Channel::UNRELIABLE)
+        {
+            if (len < 2)
+                return;
+            auto sequence = readBE16(data);
+            data += 2;
+            len -= 2;
+
+            int16_t gap = static_cast<int16_t>(sequence - _receiveSequence);
+            if (_hasReceiveSequence && gap <= 0)
+            {
+                std::lock_guard<std::mutex> lck(_statsMtx);
+                ++_stats.packetsDropped;
+                return;
+            }
+            if (_hasReceiveSequence && gap > 1)
+            {
+                std::lock_guard<std::mutex> lck(_statsMtx);
+                _stats.packetsLost += gap - 1;
+            }
+            _receiveSequence    = sequence;
+            _hasReceiveSequence = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(_statsMtx);
+            ++_stats.packetsReceived;
+            _stats.bytesReceived += len;
+        }
+
+        auto buffer = takePooledBuffer();
+        buffer.assign(data, data + len);
+        postEvent(ClientEvent{ClientEvent::Type::ON_PACKET, channel, ErrorCode{}, std::move(buffer)});
+        break;
+    }
+    case PacketType::PING:
+        // the server measures its round trip time too
+        if (len == RT_PING_SIZE)
+            writePacket(channel, PacketType::PONG, nullptr, 0, data + 1, len - 1);
+        break;
+    case PacketType::PONG:
+        handlePong(data, len);
+        break;
+    }
+}
+
+void RealtimeClient::handlePong(const char* data, size_t len)
+{
+    if (len != RT_PING_SIZE)
+        return;
+
+    auto sentTime = (static_cast<int64_t>(readBE32(data + 5)) << 32) | readBE32(data + 9);
+    auto rtt      = static_cast<float>(yasio::highp_clock() - sentTime) / 1000.0f;
+    if (rtt < 0)
+        return;
+
+    // smoothed like the retransmission timer of TCP, RFC 6298
+    std::lock_guard<std::mutex> lck(_statsMtx);
+    if (!_rttSampled)
+    {
+        _stats.rtt    = rtt;
+        _stats.jitter = rtt / 2;
+        _rttSampled   = true;
+    }
+    else
+    {
+        _stats.jitter = 0.75f * _stats.jitter + 0.25f * std::abs(_stats.rtt - rtt);
+        _stats.rtt    = 0.875f * _stats.rtt + 0.125f * rtt;
+    }
+}
+
+bool RealtimeClient::checkPing()
+{
+    if (_state != State::OPEN)
+        return true;
+
+    if (_timeout > 0 && yasio::clock() - _lastReceiveTime > _timeout)
+    {
+        postEvent(ClientEvent{ClientEvent::Type::ON_ERROR, Channel::RELIABLE, ErrorCode::TIME_OUT});
+        closeChannels();
+        return true;
+    }
+
+    char payload[RT_PING_SIZE - 1];
+    auto now = static_cast<uint64_t>(yasio::highp_clock());
+    writeBE32(payload, _pingSequence++);
+    writeBE32(payload + 4, static_cast<uint32_t>(now >> 32));
+    writeBE32(payload + 8, static_cast<uint32_t>(now));
+    auto channel = _transports[RT_UNRELIABLE_CHANNEL] ? Channel::UNRELIABLE : Channel::RELIABLE;
+    writePacket(channel, PacketType::PING, nullptr, 0, payload, sizeof(payload));
+    return false;
+}
+
+void RealtimeClient::dispatchEvents()
+{
+    {
+        std::lock_guard<std::mutex> lck(_eventsMtx);
+        if (_events.empty())
+            return;
+        _dispatchingEvents.swap(_events);
+    }
+
+    for (auto&& event : _dispatchingEvents)
+    {
+        // the consecutive packets are delivered together
+        if (event.type == ClientEvent::Type::ON_PACKET)
+        {
+            _packetBatch.emplace_back(Packet{event.data.data(), event.data.size(), event.channel});
+            continue;
+        }
+        dispatchPacketBatch();
+
+        if (!_delegate)
+            continue;
+        switch (event.type)
+        {
+        case ClientEvent::Type::ON_OPEN:
+            _delegate->onOpen(this);
+            break;
+        case ClientEvent::Type::ON_CLOSE:
+            _delegate->onClose(this);
+            break;
+        case ClientEvent::Type::ON_ERROR:
+            _delegate->onError(this, event.error);
+            break;
+        default:
+            break;
+        }
+    }
+    dispatchPacketBatch();
+
+    for (auto&& event : _dispatchingEvents)
+        if (event.type == ClientEvent::Type::ON_PACKET)
+            recyclePooledBuffer(std::move(event.data));
+    _dispatchingEvents.clear();
+}
+
+void RealtimeClient::dispatchPacketBatch()
+{
+    if (_packetBatch.empty())
+        return;
+    if (_delegate)
+        _delegate->onPackets(this, _packetBatch);
+    _packetBatch.clear();
+}
+
+yasio::sbyte_buffer RealtimeClient::takePooledBuffer()
+{
+    std::lock_guard<std::mutex> lck(_bufferPoolMtx);
+    if (_bufferPool.empty())
+        return {};
+    auto buffer = std::move(_bufferPool.back());
+    _bufferPool.pop_back();
+    return buffer;
+}
+
+void RealtimeClient::recyclePooledBuffer(yasio::sbyte_buffer&& buffer)
+{
+    if (buffer.capacity() == 0 || buffer.capacity() > RT_MAX_POOLED_BUFFER_SIZE)
+        return;
+    buffer.clear();
+    std::lock_guard<std::mutex> lck(_bufferPoolMtx);
+    if (_bufferPool.size() < RT_MAX_POOLED_BUFFERS)
+        _bufferPool.emplace_back(std::move(buffer));
+}
+
+}  // namespace network
+
+}  // namespace ax
@@ -0,0 +1,248 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#if !defined(__EMSCRIPTEN__)
+
+#    include <string>
+#    include <vector>
+#    include <mutex>
+#    include <atomic>
+#    include <span>
+
+#    include "platform/PlatformMacros.h"
+#    include "yasio/yasio_fwd.hpp"
+#    include "yasio/byte_buffer.hpp"
+
+namespace ax
+{
+
+class Scheduler;
+
+namespace network
+{
+
+/**
+ * @brief A low latency client for the realtime games, with a reliable and an unreliable channel to a server.
+ *
+ * The reliable channel runs over KCP when axmol is built with AX_WITH_KCP, over TCP otherwise, its packets arrive
+ * in order. The unreliable channel runs over UDP, its packets may be lost, and the ones older than the last packet
+ * received are dropped. The packets received are delivered to the delegate on the axmol thread, once per frame with
+ * all the packets of the frame. The client pings the server to measure the round trip time and its jitter.
+ *
+ * The protocol the server must speak, the integers are big endian:
+ *  - every packet starts with a type byte, 0 for data, 1 for ping and 2 for pong;
+ *  - the unreliable data packets have a 16 bits sequence number after the type, incremented per packet;
+ *  - the 12 bytes after the type of a ping are sent back as is in a pong, on the same channel;
+ *  - over TCP, every packet is prefixed with its 32 bits length.
+ * The pings are sent on the unreliable channel when it's open, on the reliable one otherwise.
+ *
+ * All the public methods have to be invoked on the axmol thread, the client mustn't be deleted in the callbacks
+ * of its delegate.
+ */
+class AX_DLL RealtimeClient
+{
+public:
+    enum class Channel : uint8_t
+    {
+        RELIABLE,
+        UNRELIABLE,
+    };
+
+    enum class State
+    {
+        CLOSED,
+        CONNECTING,
+        OPEN,
+        CLOSING,
+    };
+
+    enum class ErrorCode
+    {
+        CONNECTION_FAILURE,
+        CONNECTION_LOST,
+        TIME_OUT,
+    };
+
+    /** A packet received, its bytes are valid in the onPackets call only. */
+    struct Packet
+    {
+        const char* data;
+        size_t size;
+        Channel channel;
+    };
+
+    struct Stats
+    {
+        float rtt                = 0;  // the smoothed round trip time in milliseconds
+        float jitter             = 0;  // the mean deviation of the round trip time in milliseconds
+        float packetLoss         = 0;  // the ratio of unreliable packets lost, from the gaps of their sequence
+        uint32_t packetsSent     = 0;
+        uint32_t packetsReceived = 0;
+        uint32_t packetsLost     = 0;
+        uint32_t packetsDropped  = 0;  // the unreliable packets older than the last one received
+        uint64_t bytesSent       = 0;
+        uint64_t bytesReceived   = 0;
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() {}
+        virtual void onOpen(RealtimeClient* client) {}
+        /** Called once per frame with the packets received since the previous frame, in order. */
+        virtual void onPackets(RealtimeClient* client, std::span<const Packet> packets) = 0;
+        virtual void onClose(RealtimeClient* client) {}
+        virtual void onError(RealtimeClient* client, ErrorCode error) {}
+    };
+
+    /** The milliseconds between two pings. */
+    static constexpr int DEFAULT_PING_INTERVAL = 1000;
+
+    /** The milliseconds without any packet received the connection is lost after. */
+    static constexpr int DEFAULT_TIMEOUT = 10000;
+
+    RealtimeClient();
+    ~RealtimeClient();
+
+    RealtimeClient(const RealtimeClient&)            = delete;
+    RealtimeClient& operator=(const RealtimeClient&) = delete;
+
+    /**
+     * Connects to a server, the delegate gets onOpen when the channels are open or onError.
+     *
+     * @param delegate The delegate of the client.
+     * @param host The host of the server.
+     * @param reliablePort The port of the reliable channel, 0 to not open it.
+     * @param unreliablePort The port of the unreliable channel, 0 to not open it.
+     */
+    bool open(Delegate* delegate, std::string_view host, uint16_t reliablePort, uint16_t unreliablePort);
+
+    /** Closes the channels, the delegate gets onClose when they are closed. */
+    void close();
+
+    /** Sends a packet, it fails when the client isn't open or the channel wasn't opened. */
+    bool send(Channel channel, const void* data, size_t len);
+
+    State getState() const { return _state; }
+
+    Stats getStats() const;
+
+    /** Set the conversation id of the KCP channel, it must match the server's. It must be set before open. */
+    void setKcpConversation(uint32_t conv) { _kcpConv = conv; }
+    uint32_t getKcpConversation() const { return _kcpConv; }
+
+    /** Set the milliseconds between two pings, it must be set before open. */
+    void setPingInterval(int interval) { _pingInterval = interval; }
+    int getPingInterval() const { return _pingInterval; }
+
+    /** Set the milliseconds without any packet received the connection is lost after, 0 to never time out. */
+    void setTimeout(int timeout) { _timeout = timeout; }
+    int getTimeout() const { return _timeout; }
+
+protected:
+    enum PacketType : uint8_t
+    {
+        DATA,
+        PING,
+        PONG,
+    };
+
+    struct ClientEvent
+    {
+        enum class Type
+        {
+            ON_OPEN,
+            ON_CLOSE,
+            ON_ERROR,
+            ON_PACKET,
+        };
+
+        Type type;
+        Channel channel;
+        ErrorCode error;
+        yasio::sbyte_buffer data;
+    };
+
+    // on the network thread
+    void handleNetworkEvent(yasio::io_event* event);
+    void handleStreamData(const char* data, size_t len);
+    void handlePacket(Channel channel, const char* data, size_t len);
+    void handlePong(const char* data, size_t len);
+    bool checkPing();
+    void closeChannels();
+
+    int writePacket(Channel channel, PacketType type, const char* header, size_t headerLen, const char* data, size_t len);
+    void postEvent(ClientEvent&& event);
+
+    // on the axmol thread
+    void dispatchEvents();
+    void dispatchPacketBatch();
+
+    yasio::sbyte_buffer takePooledBuffer();
+    void recyclePooledBuffer(yasio::sbyte_buffer&& buffer);
+
+    yasio::io_service* _service = nullptr;
+    Scheduler* _scheduler       = nullptr;
+    Delegate* _delegate         = nullptr;
+
+    std::atomic<State> _state{State::CLOSED};
+    std::atomic<yasio::transport_handle_t> _transports[2]{};
+    bool _channelEnabled[2]{};
+
+    // for the network thread
+    int _openChannels         = 0;
+    bool _opened              = false;  // the client was open, its close is reported
+    int64_t _lastReceiveTime  = 0;
+    uint32_t _pingSequence    = 0;
+    uint16_t _receiveSequence = 0;
+    bool _hasReceiveSequence  = false;
+    yasio::sbyte_buffer _streamData;  // the partial packets of the TCP channel
+
+    // for the axmol thread
+    uint16_t _sendSequence = 0;
+    std::vector<ClientEvent> _dispatchingEvents;
+    std::vector<Packet> _packetBatch;
+
+    std::vector<ClientEvent> _events;
+    std::mutex _eventsMtx;
+
+    Stats _stats;
+    bool _rttSampled = false;
+    mutable std::mutex _statsMtx;
+
+    std::vector<yasio::sbyte_buffer> _bufferPool;
+    std::mutex _bufferPoolMtx;
+
+    uint32_t _kcpConv = 1;
+    int _pingInterval = DEFAULT_PING_INTERVAL;
+    int _timeout      = DEFAULT_TIMEOUT;
+};
+
+}  // namespace network
+
+}  // namespace ax
+
+#endif
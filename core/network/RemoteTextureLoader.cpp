@@ -0,0 +1,398 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "network/RemoteTextureLoader.h"
+
+#include "2d/DynamicAtlas.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/Utils.h"
+#include "network/Downloader.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/TextureCache.h"
+#include "renderer/backend/PixelFormatUtils.h"
+
+namespace ax
+{
+
+namespace network
+{
+
+static RemoteTextureLoader* s_sharedRemoteTextureLoader = nullptr;
+
+static constexpr uint32_t CACHED_IMAGE_VERSION = 1;
+
+// the header of a cached image, followed by its ETag and its data
+struct CachedImageHeader
+{
+    char magic[4];  // AXRT
+    uint32_t version;
+    uint32_t encoded;  // 1 when the data is the GPU compressed image as received, RGBA8 pixels otherwise
+    uint32_t width;
+    uint32_t height;
+    uint32_t premultipliedAlpha;
+    uint32_t etagLength;
+};
+
+RemoteTextureLoader::Request::~Request()
+{
+    AX_SAFE_RELEASE(cachedImage);
+    AX_SAFE_RELEASE(image);
+}
+
+RemoteTextureLoader* RemoteTextureLoader::getInstance()
+{
+    if (!s_sharedRemoteTextureLoader)
+        s_sharedRemoteTextureLoader = new RemoteTextureLoader();
+    return s_sharedRemoteTextureLoader;
+}
+
+void RemoteTextureLoader::destroyInstance()
+{
+    AX_SAFE_DELETE(s_sharedRemoteTextureLoader);
+}
+
+RemoteTextureLoader::RemoteTextureLoader()
+{
+    _cacheDirectory = FileUtils::getInstance()->getWritablePath();
+    _cacheDirectory.append("remote-textures/");
+}
+
+RemoteTextureLoader::~RemoteTextureLoader()
+{
+    cancelAll();
+}
+
+void RemoteTextureLoader::loadTexture(std::string_view url, TextureCallback callback)
+{
+    if (auto texture = Director::getInstance()->getTextureCache()->getTextureForKey(url))
+    {
+        callback(texture);
+        return;
+    }
+    addRequest(url)->textureCallbacks.emplace_back(std::move(callback));
+}
+
+void RemoteTextureLoader::loadSpriteFrame(std::string_view url, SpriteFrameCallback callback)
+{
+    if (auto frame = DynamicAtlas::getInstance()->getSpriteFrame(url))
+    {
+        callback(frame);
+        return;
+    }
+    addRequest(url)->frameCallbacks.emplace_back(std::move(callback));
+}
+
+void RemoteTextureLoader::cancel(std::string_view url)
+{
+    auto it = _requests.find(url);
+    if (it == _requests.end())
+        return;
+
+    auto request = it->second;
+    _requests.erase(it);
+    if (request->task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_downloadsMutex);
+            _downloads.erase(request->task->identifier);
+        }
+        request->task->cancel();
+    }
+}
+
+void RemoteTextureLoader::cancelAll()
+{
+    while (!_requests.empty())
+        cancel(_requests.begin()->first);
+}
+
+void RemoteTextureLoader::setCacheDirectory(std::string_view path)
+{
+    _cacheDirectory = path;
+    if (!_cacheDirectory.empty() && _cacheDirectory.back() != '/')
+        _cacheDirectory.push_back('/');
+}
+
+void RemoteTextureLoader::removeCachedImage(std::string_view url)
+{
+    FileUtils::getInstance()->removeFile(fmt::format("{}{}.axrt", _cacheDirectory, utils::getStringMD5Hash(url)));
+}
+
+void RemoteTextureLoader::removeAllCachedImages()
+{
+    FileUtils::getInstance()->removeDirectory(_cacheDirectory);
+}
+
+std::shared_ptr<RemoteTextureLoader::Request> RemoteTextureLoader::addRequest(std::string_view url)
+{
+    auto it = _requests.find(url);
+    if (it != _requests.end())
+        return it->second;
+
+    auto request       = std::make_shared<Request>();
+    request->url       = url;
+    request->cachePath = fmt::format("{}{}.axrt", _cacheDirectory, utils::getStringMD5Hash(url));
+    _requests.emplace(request->url, request);
+
+    // the cached image is read before anything is downloaded
+    auto weak = std::weak_ptr<Request>(request);
+    Director::getInstance()
+        ->getJobSystem()
+        ->schedule(
+            [weak] {
+        if (auto request = weak.lock())
+            request->cachedImage = readCachedImage(request->cachePath, &request->etag);
+    },
+            JobPriority::Low)
+        .thenOnAxmolThread([this, weak] {
+        auto request = weak.lock();
+        if (!request)
+            return;
+
+        if (request->cachedImage && !_revalidate)
+        {
+            std::swap(request->image, request->cachedImage);
+            finish(request);
+        }
+        else
+            download(request);
+    });
+    return request;
+}
+
+void RemoteTextureLoader::download(const std::shared_ptr<Request>& request)
+{
+    if (!_downloader)
+    {
+        _downloader = std::make_unique<Downloader>();
+
+        // the bytes go straight to the buffer the worker decodes
+        _downloader->onDataTaskReceived = [this](const DownloadTask& task, const unsigned char* data, size_t size) {
+            std::lock_guard<std::mutex> lock(_downloadsMutex);
+            auto it = _downloads.find(task.identifier);
+            if (it != _downloads.end())
+                it->second->data.insert(it->second->data.end(), data, data + size);
+        };
+        _downloader->onDataTaskSuccess = [this](const DownloadTask& task, std::vector<unsigned char>& data) {
+            onDownloaded(task, data);
+        };
+        _downloader->onTaskError = [this](const DownloadTask& task, int /*errorCode*/, int /*errorCodeInternal*/,
+                                          std::string_view errorStr) { onDownloadFailed(task, errorStr); };
+    }
+
+    auto identifier = fmt::to_string(++_downloadSerial);
+    {
+        std::lock_guard<std::mutex> lock(_downloadsMutex);
+        _downloads.emplace(identifier, request);
+    }
+    request->task = _downloader->createDownloadDataTask(request->url, identifier,
+                                                        request->cachedImage ? std::string_view{request->etag} : ""sv);
+}
+
+std::shared_ptr<RemoteTextureLoader::Request> RemoteTextureLoader::takeDownload(const DownloadTask& task)
+{
+    std::lock_guard<std::mutex> lock(_downloadsMutex);
+    auto it = _downloads.find(task.identifier);
+    if (it == _downloads.end())
+        return nullptr;
+
+    auto request = std::move(it->second);
+    _downloads.erase(it);
+    return request;
+}
+
+void RemoteTextureLoader::onDownloaded(const DownloadTask& task, std::vector<unsigned char>& data)
+{
+    auto request = takeDownload(task);
+    if (!request)
+        return;
+
+    if (task.notModified && request->cachedImage)
+    {
+        std::swap(request->image, request->cachedImage);
+        finish(request);
+        return;
+    }
+
+    // the downloaders which can't stream buffer the data
+    if (!data.empty())
+        request->data.swap(data);
+
+    // decoded on a worker, then cached while the texture is uploaded
+    auto weak      = std::weak_ptr<Request>(request);
+    auto cacheData = std::make_shared<Data>();
+    auto decoded   = Director::getInstance()->getJobSystem()->schedule(
+        [weak, cacheData, etag = task.etag] {
+        auto request = weak.lock();
+        if (!request)
+            return;
+
+        auto image = new Image();
+        if (image->initWithImageData(request->data.data(), static_cast<ssize_t>(request->data.size())))
+        {
+            *cacheData     = encodeCachedImage(image, etag, request->data.data(), request->data.size());
+            request->image = image;
+        }
+        else
+        {
+            AXLOGW("RemoteTextureLoader: can't decode {}", request->url);
+            image->release();
+        }
+        std::vector<unsigned char>().swap(request->data);
+    },
+        JobPriority::Low);
+
+    decoded.then(
+        [cacheData, cacheDirectory = _cacheDirectory, cachePath = request->cachePath] {
+        if (cacheData->isNull())
+            return;
+
+        // written aside then renamed, a cached image is never read half written
+        auto fileUtils = FileUtils::getInstance();
+        auto tempPath  = cachePath + ".tmp";
+        if (fileUtils->createDirectories(cacheDirectory) && fileUtils->writeDataToFile(*cacheData, tempPath))
+            fileUtils->renameFile(tempPath, cachePath);
+    },
+        JobPriority::Low);
+
+    decoded.thenOnAxmolThread([this, weak] {
+        if (auto request = weak.lock())
+            finish(request);
+    });
+}
+
+void RemoteTextureLoader::onDownloadFailed(const DownloadTask& task, std::string_view errorStr)
+{
+    auto request = takeDownload(task);
+    if (!request)
+        return;
+
+    AXLOGW("RemoteTextureLoader: can't download {}: {}", request->url, errorStr);
+    finish(request);
+}
+
+void RemoteTextureLoader::finish(const std::shared_ptr<Request>& request)
+{
+    auto it = _requests.find(request->url);
+    if (it == _requests.end() || it->second != request)
+        return;
+    _requests.erase(it);
+    request->task.reset();
+
+    // the cached image is used when the download failed
+    if (!request->image)
+        std::swap(request->image, request->cachedImage);
+
+    Texture2D* texture = nullptr;
+    SpriteFrame* frame = nullptr;
+    if (request->image)
+    {
+        if (!request->textureCallbacks.empty())
+            texture = Director::getInstance()->getTextureCache()->addImage(request->image, request->url);
+        if (!request->frameCallbacks.empty())
+            frame = DynamicAtlas::getInstance()->addImage(request->image, request->url);
+    }
+
+    for (auto& callback : request->textureCallbacks)
+        callback(texture);
+    for (auto& callback : request->frameCallbacks)
+        callback(frame);
+}
+
+Image* RemoteTextureLoader::readCachedImage(std::string_view path, std::string* etag)
+{
+    auto data = FileUtils::getInstance()->getDataFromFile(path);
+
+    CachedImageHeader header;
+    if (static_cast<size_t>(data.getSize()) < sizeof(header))
+        return nullptr;
+    memcpy(&header, data.getBytes(), sizeof(header));
+    if (memcmp(header.magic, "AXRT", 4) != 0 || header.version != CACHED_IMAGE_VERSION ||
+        data.getSize() - sizeof(header) < header.etagLength)
+        return nullptr;
+
+    auto payload    = data.getBytes() + sizeof(header) + header.etagLength;
+    auto payloadLen = data.getSize() - sizeof(header) - header.etagLength;
+
+    auto image = new Image();
+    bool ok    = false;
+    if (header.encoded)
+        ok = image->initWithImageData(payload, payloadLen);
+    else if (payloadLen == static_cast<ssize_t>(header.width) * header.height * 4)
+        ok = image->initWithRawData(payload, payloadLen, header.width, header.height, 8, header.premultipliedAlpha);
+    if (!ok)
+    {
+        image->release();
+        return nullptr;
+    }
+
+    etag->assign(reinterpret_cast<const char*>(data.getBytes()) + sizeof(header), header.etagLength);
+    return image;
+}
+
+Data RemoteTextureLoader::encodeCachedImage(Image* image,
+                                            std::string_view etag,
+                                            const uint8_t* data,
+                                            size_t dataLen)
+{
+    CachedImageHeader header;
+    memcpy(header.magic, "AXRT", 4);
+    header.version            = CACHED_IMAGE_VERSION;
+    header.encoded            = image->isCompressed() ? 1 : 0;
+    header.width              = image->getWidth();
+    header.height             = image->getHeight();
+    header.premultipliedAlpha = image->hasPremultipliedAlpha() ? 1 : 0;
+    header.etagLength         = static_cast<uint32_t>(etag.size());
+
+    // the GPU compressed images are kept as received, the others as the pixels they are uploaded with
+    const uint8_t* payload = data;
+    size_t payloadLen      = dataLen;
+    unsigned char* pixels  = nullptr;
+    if (!header.encoded)
+    {
+        if (backend::PixelFormatUtils::convertDataToFormat(image->getData(), image->getDataLen(),
+                                                           image->getPixelFormat(), backend::PixelFormat::RGBA8,
+                                                           &pixels, &payloadLen) != backend::PixelFormat::RGBA8)
+        {
+            if (pixels != image->getData())
+                free(pixels);
+            return Data{};
+        }
+        payload = pixels;
+    }
+
+    Data result;
+    auto out = result.resize(sizeof(header) + etag.size() + payloadLen);
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), etag.data(), etag.size());
+    memcpy(out + sizeof(header) + etag.size(), payload, payloadLen);
+    if (pixels && pixels != image->getData())
+        free(pixels);
+    return result;
+}
+
+}  // namespace network
+}  // namespace ax
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "base/hlookup.h"
+#include "base/Data.h"
+
+namespace ax
+{
+
+class Image;
+class Texture2D;
+class SpriteFrame;
+
+namespace network
+{
+
+class Downloader;
+class DownloadTask;
+
+/**
+ * @brief Loads the textures of remote images, like avatars and banners, and caches them on disk.
+ *
+ * The downloader streams the bytes of an image straight into the buffer the worker decodes, nothing else buffers
+ * the payload. Once the last byte is in, the image is decoded on a JobSystem worker and written to the disk cache
+ * in the layout it is uploaded with: the RGBA8 pixels of the decoded images, or the data as received for the GPU
+ * compressed ones (ASTC, ETC, KTX2...). A cached image is read on a worker and uploaded without decoding.
+ *
+ * The cache is keyed by the url, and the ETag of the response is stored along. Cached images are used as they are,
+ * or revalidated with If-None-Match when setRevalidate is on, a 304 answer reuses the cached file.
+ *
+ * The textures are added to TextureCache with the url as their key, the sprite frames are packed in
+ * DynamicAtlas::getInstance(), named by the url.
+ * @js NA
+ * @lua NA
+ */
+class AX_DLL RemoteTextureLoader
+{
+public:
+    /** Called on the axmol thread, with nullptr when the image can't be loaded. */
+    using TextureCallback     = std::function<void(Texture2D* texture)>;
+    using SpriteFrameCallback = std::function<void(SpriteFrame* frame)>;
+
+    static RemoteTextureLoader* getInstance();
+    static void destroyInstance();
+
+    RemoteTextureLoader();
+    ~RemoteTextureLoader();
+
+    /** Loads the texture of an image, the callback is invoked right away when it is loaded already. */
+    void loadTexture(std::string_view url, TextureCallback callback);
+
+    /** Loads an image in the dynamic atlas, the callback is invoked right away when it is packed already. */
+    void loadSpriteFrame(std::string_view url, SpriteFrameCallback callback);
+
+    /** Drops the callbacks of an image, its download is cancelled. */
+    void cancel(std::string_view url);
+    void cancelAll();
+
+    bool isLoading(std::string_view url) const { return _requests.find(url) != _requests.end(); }
+
+    /** The directory of the cached images, "remote-textures/" in the writable path by default. */
+    void setCacheDirectory(std::string_view path);
+    const std::string& getCacheDirectory() const { return _cacheDirectory; }
+
+    /** Whether the cached images are revalidated with the server before being used, off by default. */
+    void setRevalidate(bool revalidate) { _revalidate = revalidate; }
+    bool isRevalidate() const { return _revalidate; }
+
+    void removeCachedImage(std::string_view url);
+    void removeAllCachedImages();
+
+protected:
+    struct Request
+    {
+        ~Request();
+
+        std::string url;
+        std::string cachePath;
+        std::string etag;  // of the cached image
+        std::shared_ptr<DownloadTask> task;
+        std::vector<unsigned char> data;  // streamed by the downloader thread
+        Image* cachedImage = nullptr;     // revalidated with the server
+        Image* image       = nullptr;
+        std::vector<TextureCallback> textureCallbacks;
+        std::vector<SpriteFrameCallback> frameCallbacks;
+    };
+
+    std::shared_ptr<Request> addRequest(std::string_view url);
+    void download(const std::shared_ptr<Request>& request);
+    void onDownloaded(const DownloadTask& task, std::vector<unsigned char>& data);
+    void onDownloadFailed(const DownloadTask& task, std::string_view errorStr);
+    void finish(const std::shared_ptr<Request>& request);
+    std::shared_ptr<Request> takeDownload(const DownloadTask& task);
+
+    /** Reads and encodes the cached images, in the worker threads. */
+    static Image* readCachedImage(std::string_view path, std::string* etag);
+    static Data encodeCachedImage(Image* image, std::string_view etag, const uint8_t* data, size_t dataLen);
+
+    std::unique_ptr<Downloader> _downloader;
+    hlookup::string_map<std::shared_ptr<Request>> _requests;
+
+    std::mutex _downloadsMutex;  // the downloads are streamed in the downloader thread
+    std::unordered_map<std::string, std::shared_ptr<Request>> _downloads;  // by the identifiers of the tasks
+    unsigned int _downloadSerial = 0;
+
+    std::string _cacheDirectory;
+    bool _revalidate = false;
+};
+
+}  // namespace network
+}  // namespace ax
@@ -28,11 +28,18 @@
 #include "network/WebSocket.h"
 
 #include "fmt/format.h"
+#include "zlib.h"
 
 using namespace yasio;
 
 #define WS_MAX_PAYLOAD_LENGTH (1 << 24)  // 16M
 
+// the smaller messages aren't worth compressing
+#define WS_DEFLATE_THRESHOLD 64
+
+#define WS_MAX_POOLED_BUFFERS     16
+#define WS_MAX_POOLED_BUFFER_SIZE (256 * 1024)
+
 namespace ax
 {
 
@@ -168,9 +175,12 @@ struct WebSocketProtocol
                          const char* buf,
                          size_t len,
                          ws::detail::opcode opcode /* = WS_OPCODE_BINARY */,
-                         bool fin = true)
+                         bool fin        = true,
+                         bool compressed = false)
     {
         int flags = (int)opcode;
+        if (compressed)
+            flags |= WS_RSV1;
 
         // role == WS_CLIENT
         uint32_t key = ax::random();
@@ -191,6 +201,33 @@ struct WebSocketProtocol
     }
 };
 
+// The permessage-deflate extension, RFC 7692
+struct WebSocket::PerMessageDeflate
+{
+    ~PerMessageDeflate()
+    {
+        inflateEnd(&inflater);
+        if (compressOutgoing)
+            deflateEnd(&deflater);
+    }
+
+    z_stream inflater{};
+    z_stream deflater{};
+    std::mutex deflaterMtx;  // the compressed messages must be written in the order they were compressed
+    bool compressOutgoing        = false;
+    bool serverNoContextTakeover = false;
+    bool clientNoContextTakeover = false;
+};
+
+static std::string_view trimExtensionParam(std::string_view param)
+{
+    while (!param.empty() && (param.front() == ' ' || param.front() == '\t'))
+        param.remove_prefix(1);
+    while (!param.empty() && (param.back() == ' ' || param.back() == '\t'))
+        param.remove_suffix(1);
+    return param;
+}
+
 WebSocket::WebSocket() : _isDestroyed(std::make_shared<std::atomic<bool>>(false)), _delegate(nullptr)
 {
     _service        = new yasio::io_service();
@@ -277,6 +314,16 @@ void WebSocket::dispatchEvents()
             auto event = _eventQueue.front();
             _eventQueue.unsafe_pop_front();
 
+            // the consecutive messages are delivered together
+            if (event->getType() == Event::Type::ON_MESSAGE)
+            {
+                auto messageEvent = static_cast<MessageEvent*>(event);
+                _messageBatch.emplace_back(messageEvent);
+                _messageBatchEvents.emplace_back(messageEvent);
+                continue;
+            }
+            dispatchMessageBatch();
+
             switch (event->getType())
             {
             case Event::Type::ON_OPEN:
@@ -288,16 +335,52 @@ void WebSocket::dispatchEvents()
             case Event::Type::ON_ERROR:
                 _delegate->onError(this, static_cast<ErrorEvent*>(event)->getErrorCode());
                 break;
-            case Event::Type::ON_MESSAGE:
-                _delegate->onMessage(this, WebSocket::Data{static_cast<MessageEvent*>(event)});
+            default:
                 break;
             }
 
             event->release();
         }
+        dispatchMessageBatch();
     }
 }
 
+void WebSocket::dispatchMessageBatch()
+{
+    if (_messageBatch.empty())
+        return;
+
+    _delegate->onMessages(this, _messageBatch);
+
+    for (auto event : _messageBatchEvents)
+    {
+        recyclePooledBuffer(std::move(event->getMessage()));
+        event->release();
+    }
+    _messageBatch.clear();
+    _messageBatchEvents.clear();
+}
+
+yasio::sbyte_buffer WebSocket::takePooledBuffer()
+{
+    std::lock_guard<std::mutex> lck(_bufferPoolMtx);
+    if (_bufferPool.empty())
+        return {};
+    auto buffer = std::move(_bufferPool.back());
+    _bufferPool.pop_back();
+    return buffer;
+}
+
+void WebSocket::recyclePooledBuffer(yasio::sbyte_buffer&& buffer)
+{
+    if (buffer.capacity() == 0 || buffer.capacity() > WS_MAX_POOLED_BUFFER_SIZE)
+        return;
+    buffer.clear();
+    std::lock_guard<std::mutex> lck(_bufferPoolMtx);
+    if (_bufferPool.size() < WS_MAX_POOLED_BUFFERS)
+        _bufferPool.emplace_back(std::move(buffer));
+}
+
 void WebSocket::setupParsers()
 {
     /// http parser for handshake
@@ -337,15 +420,30 @@ int WebSocket::on_frame_header(websocket_parser* parser)
     int opcode    = parser->flags & WS_OP_MASK;
 
     std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
+
+    // the control frames aren't fragmented, but may come between the fragments of a message
+    ws->_controlFrame = (opcode & 0x8) != 0;
+    if (ws->_controlFrame)
+    {
+        ws->_controlData.clear();
+        return 0;
+    }
+
     auto& message = ws->_receivedData;
 
     if (opcode != WS_OP_CONTINUE)
-        ws->_opcode = opcode;
-    auto length         = parser->length;
-    auto reserve_length = (std::min)(length + 1, static_cast<size_t>(WS_MAX_PAYLOAD_LENGTH));
-    if (reserve_length > ws->_receivedData.capacity())
     {
-        message.reserve(reserve_length);
+        ws->_opcode     = opcode;
+        ws->_compressed = ws->_deflate && (parser->flags & WS_RSV1);
+    }
+    if (!ws->_fragmentHandler && !ws->_compressed)
+    {
+        auto length         = parser->length;
+        auto reserve_length = (std::min)(length + 1, static_cast<size_t>(WS_MAX_PAYLOAD_LENGTH));
+        if (reserve_length > ws->_receivedData.capacity())
+        {
+            message.reserve(reserve_length);
+        }
     }
     switch (ws->_frameState)
     {
@@ -359,13 +457,22 @@ int WebSocket::on_frame_header(websocket_parser* parser)
 
 int WebSocket::on_frame_body(websocket_parser* parser, const char* at, size_t length)
 {
-    WebSocket* ws   = static_cast<WebSocket*>(parser->data);
-    ws->_frameState = FrameState::BODY;
+    WebSocket* ws = static_cast<WebSocket*>(parser->data);
     if (parser->flags & WS_HAS_MASK)
         websocket_parser_decode(const_cast<char*>(at), at, length, parser);
 
     std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
-    ws->_receivedData.append(at, at + length);
+    if (ws->_controlFrame)
+    {
+        ws->_controlData.append(at, at + length);
+        return 0;
+    }
+
+    ws->_frameState = FrameState::BODY;
+    if (!ws->_compressed)
+        ws->receiveMessageData(at, length);
+    else if (!ws->inflateMessageData(at, length))
+        return -1;
     return 0;
 }
 
@@ -373,38 +480,105 @@ int WebSocket::on_frame_end(websocket_parser* parser)
 {
     WebSocket* ws = static_cast<WebSocket*>(parser->data);
 
-    ws->_frameState = FrameState::END;
-    if (parser->flags & WS_FIN)
+    std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
+    if (ws->_controlFrame)
     {
-        ws->_frameState = FrameState::FIN;
-
-        std::unique_lock<std::recursive_mutex> lck(ws->_receivedDataMtx);
-        switch (ws->_opcode)
+        switch (parser->flags & WS_OP_MASK)
         {
-        case WS_OP_TEXT:
-        case WS_OP_BINARY:
-            AX_ASSERT(!ws->_receivedData.empty());
-            ws->_eventQueue.emplace_back(new MessageEvent{std::move(ws->_receivedData), ws->_opcode == WS_OP_BINARY});
-            break;
         case WS_OP_CLOSE:
             AXLOGD("WS: control frame: CLOSE");
             break;
         case WS_OP_PING:
             AXLOGD("WS: control frame: PING");
-            WebSocketProtocol::sendFrame(*ws, ws->_receivedData.data(), ws->_receivedData.size(),
+            WebSocketProtocol::sendFrame(*ws, ws->_controlData.data(), ws->_controlData.size(),
                                          ws::detail::opcode::pong);
             break;
         case WS_OP_PONG:
             AXLOGD("WS: control frame: PONG");
-            if (ws->_receivedData.size() != 4 || 0 != memcmp(ws->_receivedData.data(), "WSWS", 4))
+            if (ws->_controlData.size() != 4 || 0 != memcmp(ws->_controlData.data(), "WSWS", 4))
                 AXLOGD("WS: Unsolicited PONG frame from server (possible keep-alive)\n\n");
             break;
         }
+        return 0;
+    }
+
+    ws->_frameState = FrameState::END;
+    if (parser->flags & WS_FIN)
+    {
+        ws->_frameState = FrameState::FIN;
+
+        if (ws->_opcode != WS_OP_TEXT && ws->_opcode != WS_OP_BINARY)
+            return 0;
+
+        if (ws->_compressed)
+        {
+            // the deflate tail the sender removed, RFC 7692 7.2.2
+            static const char deflateTail[] = {'\x00', '\x00', '\xff', '\xff'};
+            if (!ws->inflateMessageData(deflateTail, sizeof(deflateTail)))
+                return -1;
+            if (ws->_deflate->serverNoContextTakeover)
+                inflateReset(&ws->_deflate->inflater);
+        }
+
+        bool isBinary = ws->_opcode == WS_OP_BINARY;
+        if (ws->_fragmentHandler)
+            ws->_fragmentHandler(nullptr, 0, isBinary, true);
+        else
+        {
+            ws->_eventQueue.emplace_back(new MessageEvent{std::move(ws->_receivedData), isBinary});
+            ws->_receivedData = ws->takePooledBuffer();
+        }
     }
 
     return 0;
 }
 
+void WebSocket::receiveMessageData(const char* data, size_t len)
+{
+    if (_fragmentHandler)
+        _fragmentHandler(data, len, _opcode == WS_OP_BINARY, false);
+    else
+        _receivedData.append(data, data + len);
+}
+
+bool WebSocket::inflateMessageData(const char* data, size_t len)
+{
+    auto& inflater    = _deflate->inflater;
+    inflater.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    inflater.avail_in = static_cast<uInt>(len);
+
+    char chunk[16384];
+    do
+    {
+        inflater.next_out  = reinterpret_cast<Bytef*>(chunk);
+        inflater.avail_out = sizeof(chunk);
+        int ret            = inflate(&inflater, Z_SYNC_FLUSH);
+        if (ret == Z_STREAM_END)
+            inflateReset(&inflater);
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            AXLOGE("WS: inflate message fail, error: {}", ret);
+            break;
+        }
+
+        auto produced = sizeof(chunk) - inflater.avail_out;
+        if (produced)
+            receiveMessageData(chunk, produced);
+        if (_receivedData.size() > WS_MAX_PAYLOAD_LENGTH)
+        {
+            AXLOGE("WS: inflated message too large");
+            break;
+        }
+        if (ret == Z_BUF_ERROR || (inflater.avail_out != 0 && inflater.avail_in == 0))
+            return true;
+    } while (true);
+
+    // the connection can't go on with a broken inflater
+    _state = State::CLOSING;
+    _service->close(0);
+    return false;
+}
+
 /**
  *  @brief Sends string data to websocket server.
  *
@@ -415,7 +589,7 @@ void WebSocket::send(std::string_view message)
 {
     if (!_transport || message.empty())
         return;
-    WebSocketProtocol::sendFrame(*this, message.data(), message.length(), ws::detail::opcode::text);
+    sendMessage(message.data(), message.length(), WS_OP_TEXT);
 }
 
 /**
@@ -429,7 +603,38 @@ void WebSocket::send(const void* data, unsigned int len)
 {
     if (!_transport || len == 0)
         return;
-    WebSocketProtocol::sendFrame(*this, static_cast<const char*>(data), len, ws::detail::opcode::binary);
+    sendMessage(static_cast<const char*>(data), len, WS_OP_BINARY);
+}
+
+void WebSocket::sendMessage(const char* data, size_t len, int opcode)
+{
+    if (_deflate && _deflate->compressOutgoing && len >= WS_DEFLATE_THRESHOLD)
+    {
+        std::lock_guard<std::mutex> lck(_deflate->deflaterMtx);
+        auto& deflater = _deflate->deflater;
+
+        yasio::sbyte_buffer compressed;
+        compressed.resize(deflateBound(&deflater, static_cast<uLong>(len)) + 16);
+        deflater.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        deflater.avail_in  = static_cast<uInt>(len);
+        deflater.next_out  = reinterpret_cast<Bytef*>(compressed.data());
+        deflater.avail_out = static_cast<uInt>(compressed.size());
+
+        // the flush is complete when some output space is left
+        if (deflate(&deflater, Z_SYNC_FLUSH) == Z_OK && deflater.avail_in == 0 && deflater.avail_out != 0)
+        {
+            // removes the 00 00 ff ff tail of the flush, RFC 7692 7.2.1
+            auto size = compressed.size() - deflater.avail_out - 4;
+            if (_deflate->clientNoContextTakeover)
+                deflateReset(&deflater);
+            WebSocketProtocol::sendFrame(*this, compressed.data(), size, (ws::detail::opcode)opcode, true, true);
+            return;
+        }
+
+        // the next messages mustn't refer to this one, it's sent uncompressed
+        deflateReset(&deflater);
+    }
+    WebSocketProtocol::sendFrame(*this, data, len, (ws::detail::opcode)opcode);
 }
 
 /**
@@ -498,6 +703,64 @@ void WebSocket::generateHandshakeSecKey()
     _verifySecKey = utils::base64Encode(std::span{digest});
 }
 
+void WebSocket::negotiatePerMessageDeflate()
+{
+    _deflate.reset();
+    if (!_perMessageDeflate)
+        return;
+
+    auto it = _responseHeaders.find("sec-websocket-extensions");
+    if (it == _responseHeaders.end())
+        return;
+
+    // only the first extension accepted is used
+    std::string_view value = it->second;
+    value                  = value.substr(0, value.find(','));
+
+    bool accepted                = false;
+    bool serverNoContextTakeover = false;
+    bool clientNoContextTakeover = false;
+    int clientMaxWindowBits      = MAX_WBITS;
+    for (size_t offset = 0; offset != std::string_view::npos;)
+    {
+        auto end   = value.find(';', offset);
+        auto param = trimExtensionParam(value.substr(offset, end == std::string_view::npos ? end : end - offset));
+        offset     = end == std::string_view::npos ? end : end + 1;
+
+        auto eq   = param.find('=');
+        auto name = trimExtensionParam(param.substr(0, eq));
+        if (!accepted)
+        {
+            if (name != "permessage-deflate")
+                return;
+            accepted = true;
+        }
+        else if (name == "server_no_context_takeover")
+            serverNoContextTakeover = true;
+        else if (name == "client_no_context_takeover")
+            clientNoContextTakeover = true;
+        else if (name == "client_max_window_bits" && eq != std::string_view::npos)
+        {
+            auto bits = trimExtensionParam(param.substr(eq + 1));
+            if (bits.size() > 2 && bits.front() == '"' && bits.back() == '"')
+                bits = bits.substr(1, bits.size() - 2);
+            clientMaxWindowBits = atoi(std::string{bits}.c_str());
+        }
+    }
+
+    auto deflate = std::make_unique<PerMessageDeflate>();
+    if (inflateInit2(&deflate->inflater, -MAX_WBITS) != Z_OK)
+        return;
+    deflate->serverNoContextTakeover = serverNoContextTakeover;
+    deflate->clientNoContextTakeover = clientNoContextTakeover;
+
+    // zlib can't compress with a raw window of 8 bits, the messages are then sent uncompressed
+    if (clientMaxWindowBits >= 9 && clientMaxWindowBits <= MAX_WBITS)
+        deflate->compressOutgoing = deflateInit2(&deflate->deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                                 -clientMaxWindowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    _deflate = std::move(deflate);
+}
+
 void WebSocket::handleNetworkEvent(yasio::io_event* event)
 {
     int channelIndex = event->cindex();
@@ -529,6 +792,8 @@ void WebSocket::handleNetworkEvent(yasio::io_event* event)
 
                 if (error == ErrorCode::OK)
                 {
+                    negotiatePerMessageDeflate();
+
                     _state             = State::OPEN;
                     auto& timerForRead = channel->get_user_timer();
                     timerForRead.cancel();
@@ -603,6 +868,9 @@ void WebSocket::handleNetworkEvent(yasio::io_event* event)
                 obs.write_bytes("\r\n");
             }
 
+            if (_perMessageDeflate)
+                obs.write_bytes("Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n");
+
             for (auto&& header : _headers)
             {
                 obs.write_bytes(header);
@@ -44,6 +44,8 @@
 #    include <atomic>
 #    include <condition_variable>
 #    include <future>
+#    include <functional>
+#    include <span>
 
 #    include "platform/PlatformMacros.h"
 #    include "platform/StdC.h"
@@ -217,6 +219,19 @@ public:
          * @param data Data object for message.
          */
         virtual void onMessage(WebSocket* ws, const Data& data) = 0;
+        /**
+         * This function is called once per frame with the messages received since the previous frame, in order.
+         * The default implementation calls onMessage for each of them, override it to handle them together.
+         * The bytes of the messages are reused after the call returns.
+         *
+         * @param ws The WebSocket object connected.
+         * @param messages The messages received.
+         */
+        virtual void onMessages(WebSocket* ws, std::span<const Data> messages)
+        {
+            for (auto&& message : messages)
+                onMessage(ws, message);
+        }
         /**
          * When the WebSocket object connected wants to close or the protocol won't get used at all and current
          * _readyState is State::CLOSING,this function is to be called.
@@ -315,7 +330,33 @@ public:
      */
     const std::vector<std::string>& getHeaders() const { return _headers; }
 
+    /**
+     * Receives the messages in fragments on the websocket thread, as they arrive, instead of assembled and delivered
+     * to the delegate on the axmol thread. The last call for a message has fin set, it may have no data.
+     */
+    using FragmentHandler = std::function<void(const char* data, size_t len, bool isBinary, bool fin)>;
+
+    /**
+     * Set the handler of the message fragments, it must be set before open.
+     *
+     * @param handler The handler, nullptr to deliver the messages to the delegate.
+     */
+    void setFragmentHandler(FragmentHandler handler) { _fragmentHandler = std::move(handler); }
+
+    /**
+     * Set whether to ask the server for the permessage-deflate extension, it must be set before open.
+     * The messages are then compressed when the server accepts it.
+     */
+    void setPerMessageDeflate(bool enabled) { _perMessageDeflate = enabled; }
+
+    /**
+     * Whether the server accepted the permessage-deflate extension.
+     */
+    bool isPerMessageDeflateAccepted() const { return !!_deflate; }
+
 protected:
+    struct PerMessageDeflate;
+
     void purgePendingEvents();
     void dispatchEvents();
 
@@ -323,6 +364,18 @@ protected:
     void generateHandshakeSecKey();
     void handleNetworkEvent(yasio::io_event* event);
 
+    void negotiatePerMessageDeflate();
+    void sendMessage(const char* data, size_t len, int opcode);
+
+    // passes the bytes of a message to the fragment handler, or appends them to the received data
+    void receiveMessageData(const char* data, size_t len);
+    bool inflateMessageData(const char* data, size_t len);
+
+    void dispatchMessageBatch();
+
+    yasio::sbyte_buffer takePooledBuffer();
+    void recyclePooledBuffer(yasio::sbyte_buffer&& buffer);
+
     void do_handshake(const char* d, size_t n)
     {
         enum llhttp_errno err = llhttp_execute(&_context, d, n);
@@ -416,6 +469,8 @@ protected:
     };
     FrameState _frameState = FrameState::BEGIN;
     int _opcode            = 0;
+    bool _controlFrame     = false;
+    bool _compressed       = false;  // the message received has the RSV1 bit of permessage-deflate
 
     std::string _currentHeader;
     std::string _currentHeaderValue;
@@ -429,6 +484,19 @@ protected:
     // for receiveData
     yasio::sbyte_buffer _receivedData;
     std::recursive_mutex _receivedDataMtx;
+    yasio::sbyte_buffer _controlData;  // the control frames may come between the fragments of a message
+    FragmentHandler _fragmentHandler;
+
+    // the buffers of the messages delivered, reused for the next ones
+    std::vector<yasio::sbyte_buffer> _bufferPool;
+    std::mutex _bufferPoolMtx;
+
+    // for dispatchEvents
+    std::vector<Data> _messageBatch;
+    std::vector<MessageEvent*> _messageBatchEvents;
+
+    bool _perMessageDeflate = false;
+    std::unique_ptr<PerMessageDeflate> _deflate;
 
     EventListenerCustom* _resetDirectorListener;
 
@@ -33,6 +33,7 @@
 #    include "chipmunk/chipmunk_private.h"
 
 #    include "2d/Scene.h"
+#    include "2d/Sprite.h"
 #    include "physics/PhysicsShape.h"
 #    include "physics/PhysicsJoint.h"
 #    include "physics/PhysicsWorld.h"
@@ -112,6 +113,11 @@ PhysicsBody::PhysicsBody()
     , _recordScaleX(1.f)
     , _recordScaleY(1.f)
     , _fixedUpdate(false)
+    , _previousStepRotation(0.0f)
+    , _hasPreviousStep(false)
+    , _shownRotation(0.0f)
+    , _shown(false)
+    , _ownerSprite(nullptr)
 {
     _name = COMPONENT_NAME;
 }
@@ -930,16 +936,36 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
         setScale(scaleX, scaleY);
     }
 
-    // set rotation
-    if (_recordedRotation != rotation)
+    auto worldPosition = _ownerCenterOffset;
+    nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
+
+    if (_shown && _world && _world->isAsyncStep())
     {
-        setRotation(rotation);
+        // the node shows an interpolated transform, it's only pushed to the body when the game changed it
+        constexpr float tolerance = 0.01f;
+        if (std::abs(rotation - _shownRotation) > tolerance)
+        {
+            setRotation(rotation);
+            _hasPreviousStep = false;
+        }
+        if (std::abs(worldPosition.x - _shownPosition.x) > tolerance ||
+            std::abs(worldPosition.y - _shownPosition.y) > tolerance)
+        {
+            setPosition(worldPosition.x, worldPosition.y);
+            _hasPreviousStep = false;
+        }
     }
+    else
+    {
+        // set rotation
+        if (_recordedRotation != rotation)
+        {
+            setRotation(rotation);
+        }
 
-    // set position
-    auto worldPosition = _ownerCenterOffset;
-    nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
-    setPosition(worldPosition.x, worldPosition.y);
+        // set position
+        setPosition(worldPosition.x, worldPosition.y);
+    }
 
     _recordPosX = worldPosition.x;
     _recordPosY = worldPosition.y;
@@ -967,6 +993,95 @@ void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float pare
 
     // set Node rotation
     _owner->setRotation(getRotation() - parentRotation);
+    _shown = false;
+}
+
+void PhysicsBody::afterAsyncSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha)
+{
+    auto position = getPosition();
+    auto rotation = getRotation();
+    if (_hasPreviousStep)
+    {
+        position = _previousStepPosition.lerp(position, alpha);
+        rotation = _previousStepRotation + (rotation - _previousStepRotation) * alpha;
+    }
+
+    Vec3 positionInParent(position.x, position.y, 0.f);
+    parentToWorldTransform.getInversed().transformVector(positionInParent.x, positionInParent.y, positionInParent.z,
+                                                         1.f, &positionInParent);
+    _owner->setPosition(positionInParent.x - _offset.x, positionInParent.y - _offset.y);
+    _owner->setRotation(rotation - parentRotation);
+
+    _shownPosition = position;
+    _shownRotation = rotation;
+    _shown         = true;
+}
+
+void PhysicsBody::writeBack(const Mat4& worldToParentTransform, float parentRotation)
+{
+    auto position        = getPosition();
+    bool positionChanged = _recordPosX != position.x || _recordPosY != position.y;
+    setOwnerTransform(worldToParentTransform, position, getRotation() - parentRotation, positionChanged);
+    _shown = false;
+}
+
+void PhysicsBody::writeBackInterpolated(const Mat4& worldToParentTransform, float parentRotation, float alpha)
+{
+    auto position = getPosition();
+    auto rotation = getRotation();
+    if (_hasPreviousStep)
+    {
+        position = _previousStepPosition.lerp(position, alpha);
+        rotation = _previousStepRotation + (rotation - _previousStepRotation) * alpha;
+    }
+    setOwnerTransform(worldToParentTransform, position, rotation - parentRotation, true);
+
+    _shownPosition = position;
+    _shownRotation = rotation;
+    _shown         = true;
+}
+
+void PhysicsBody::setOwnerTransform(const Mat4& worldToParentTransform,
+                                    const Vec2& worldPosition,
+                                    float rotation,
+                                    bool positionChanged)
+{
+    Vec2 position = _owner->_position;
+    if (positionChanged)
+    {
+        Vec3 positionInParent(worldPosition.x, worldPosition.y, 0.f);
+        worldToParentTransform.transformVector(positionInParent.x, positionInParent.y, positionInParent.z, 1.f,
+                                               &positionInParent);
+        position.set(positionInParent.x - _offset.x, positionInParent.y - _offset.y);
+    }
+
+    bool rotationChanged = _owner->_rotationZ_X != rotation || _owner->_rotationZ_Y != rotation;
+    if (!rotationChanged && position == _owner->_position && !_owner->_usingNormalizedPosition)
+        return;
+
+    if (_ownerSprite && _ownerSprite->getBatchNode())
+    {
+        _owner->setPosition(position.x, position.y);
+        _owner->setRotation(rotation);
+        return;
+    }
+
+    _owner->_position                = position;
+    _owner->_usingNormalizedPosition = false;
+    if (rotationChanged)
+    {
+        _owner->_rotationZ_X = _owner->_rotationZ_Y = rotation;
+        _owner->updateRotationQuat();
+    }
+    _owner->setTransformDirty();
+}
+
+void PhysicsBody::recordPreviousStep()
+{
+    // doesn't use getRotation, which caches the rotation read by the axmol thread
+    _previousStepPosition = getPosition();
+    _previousStepRotation = static_cast<float>(-cpBodyGetAngle(_cpBody) * 180.0 / M_PI) - _rotationOffset;
+    _hasPreviousStep      = true;
 }
 
 void PhysicsBody::onEnter()
@@ -982,6 +1097,7 @@ void PhysicsBody::onExit()
 void PhysicsBody::onAdd()
 {
     _owner->_physicsBody = this;
+    _ownerSprite         = dynamic_cast<Sprite*>(_owner);
     auto contentSize     = _owner->getContentSize();
     _ownerCenterOffset.x = 0.5f * contentSize.width;
     _ownerCenterOffset.y = 0.5f * contentSize.height;
@@ -1000,6 +1116,7 @@ void PhysicsBody::onRemove()
     removeFromPhysicsWorld();
 
     _owner->_physicsBody = nullptr;
+    _ownerSprite         = nullptr;
 }
 
 void PhysicsBody::addToPhysicsWorld()
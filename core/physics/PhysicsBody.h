@@ -41,6 +41,7 @@ namespace ax
 {
 
 class Node;
+class Sprite;
 class PhysicsWorld;
 class PhysicsJoint;
 
@@ -570,6 +571,20 @@ protected:
                           float rotation);
     void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation);
 
+    /** Shows the body interpolated between its last two steps, for the asynchronous step of the world. */
+    void afterAsyncSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha);
+    /** Records the body before the last step, on the thread stepping the world. */
+    void recordPreviousStep();
+
+    /** The batched afterSimulation, see PhysicsWorld::setBatchedWriteback. */
+    void writeBack(const Mat4& worldToParentTransform, float parentRotation);
+    void writeBackInterpolated(const Mat4& worldToParentTransform, float parentRotation, float alpha);
+    /** Writes the owner transform fields directly, with a single dirty flag update. */
+    void setOwnerTransform(const Mat4& worldToParentTransform,
+                           const Vec2& worldPosition,
+                           float rotation,
+                           bool positionChanged);
+
 protected:
     std::vector<PhysicsJoint*> _joints;
     Vector<PhysicsShape*> _shapes;
@@ -616,6 +631,17 @@ protected:
     // fixed update state
     bool _fixedUpdate;
 
+    // the interpolation of the asynchronous step, in world coordinates
+    Vec2 _previousStepPosition;
+    float _previousStepRotation;
+    bool _hasPreviousStep;
+    Vec2 _shownPosition;
+    float _shownRotation;
+    bool _shown;
+
+    // the sprites in a batch node are written with their setters
+    Sprite* _ownerSprite;
+
     friend class PhysicsWorld;
     friend class PhysicsShape;
     friend class PhysicsJoint;
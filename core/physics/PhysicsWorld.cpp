@@ -140,6 +140,14 @@ void PhysicsWorldCallback::collisionSeparateCallbackFunc(cpArbiter* arb, cpSpace
 {
     PhysicsContact* contact = static_cast<PhysicsContact*>(cpArbiterGetUserData(arb));
 
+    if (world->_asyncStepping)
+    {
+        // the arbiter is recycled after the step, the event is sent without contact data
+        contact->_contactInfo = nullptr;
+        world->_asyncContactEvents.emplace_back(PhysicsWorld::AsyncContactEvent{contact, true});
+        return;
+    }
+
     world->collisionSeparateCallback(*contact);
 
     delete contact;
@@ -399,6 +407,13 @@ bool PhysicsWorld::collisionBeginCallback(PhysicsContact& contact)
         }
     }
 
+    if (_asyncStepping)
+    {
+        if (contact.isNotificationEnabled())
+            _asyncContactEvents.emplace_back(AsyncContactEvent{&contact, false});
+        return ret;
+    }
+
     if (contact.isNotificationEnabled())
     {
         contact.setEventCode(PhysicsContact::EventCode::BEGIN);
@@ -411,7 +426,7 @@ bool PhysicsWorld::collisionBeginCallback(PhysicsContact& contact)
 
 bool PhysicsWorld::collisionPreSolveCallback(PhysicsContact& contact)
 {
-    if (!contact.isNotificationEnabled())
+    if (!contact.isNotificationEnabled() || _asyncStepping)
     {
         return true;
     }
@@ -425,7 +440,7 @@ bool PhysicsWorld::collisionPreSolveCallback(PhysicsContact& contact)
 
 void PhysicsWorld::collisionPostSolveCallback(PhysicsContact& contact)
 {
-    if (!contact.isNotificationEnabled())
+    if (!contact.isNotificationEnabled() || _asyncStepping)
     {
         return;
     }
@@ -518,6 +533,181 @@ PhysicsShape* PhysicsWorld::getShape(const Vec2& point) const
     return shape == nullptr ? nullptr : static_cast<PhysicsShape*>(cpShapeGetUserData(shape));
 }
 
+namespace
+{
+// the queries of a range of a batched query
+constexpr size_t QUERY_RANGE_SIZE = 32;
+
+/** Calls fn(begin, end) by ranges of QUERY_RANGE_SIZE, on the JobSystem workers from PARALLEL_QUERY_THRESHOLD. */
+template <typename Fn>
+void forEachQueryRange(size_t count, Fn&& fn)
+{
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    if (count < PhysicsWorld::PARALLEL_QUERY_THRESHOLD || jobSystem->getWorkerCount() == 0)
+    {
+        for (size_t begin = 0; begin < count; begin += QUERY_RANGE_SIZE)
+            fn(begin, (std::min)(begin + QUERY_RANGE_SIZE, count));
+        return;
+    }
+    jobSystem->wait(jobSystem->parallelFor(count, QUERY_RANGE_SIZE, std::forward<Fn>(fn)));
+}
+
+/** Runs query(i, shapes) for each query, every range gathers its shapes, then they are merged in order. */
+template <typename Query>
+void runShapeQueries(size_t count,
+                     PhysicsQueryResults& results,
+                     std::vector<std::vector<PhysicsShape*>>& ranges,
+                     Query&& query)
+{
+    results.shapes.clear();
+    results.offsets.assign(count + 1, 0);
+    const size_t rangeCount = (count + QUERY_RANGE_SIZE - 1) / QUERY_RANGE_SIZE;
+    if (ranges.size() < rangeCount)
+        ranges.resize(rangeCount);
+
+    // the offsets hold the shape count of each query until the merge
+    forEachQueryRange(count, [&](size_t begin, size_t end) {
+        auto& shapes = ranges[begin / QUERY_RANGE_SIZE];
+        shapes.clear();
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto found = shapes.size();
+            query(i, shapes);
+            results.offsets[i + 1] = static_cast<uint32_t>(shapes.size() - found);
+        }
+    });
+
+    for (size_t i = 0; i < rangeCount; ++i)
+        results.shapes.insert(results.shapes.end(), ranges[i].begin(), ranges[i].end());
+    for (size_t i = 0; i < count; ++i)
+        results.offsets[i + 1] += results.offsets[i];
+}
+
+// the spatial indexes are only read, unlike the queries of cpSpace which lock the space
+bool matchCategory(cpShape* shape, int categoryMask)
+{
+    return (static_cast<PhysicsShape*>(cpShapeGetUserData(shape))->getCategoryBitmask() & categoryMask) != 0;
+}
+
+struct RayCastFirstContext
+{
+    cpVect start;
+    cpVect end;
+    int categoryMask;
+};
+
+cpFloat rayCastFirstFunc(RayCastFirstContext* context, cpShape* shape, cpSegmentQueryInfo* out)
+{
+    cpSegmentQueryInfo info;
+    if (!shape->sensor && matchCategory(shape, context->categoryMask) &&
+        cpShapeSegmentQuery(shape, context->start, context->end, 0, &info) && info.alpha < out->alpha)
+    {
+        *out = info;
+    }
+    return out->alpha;
+}
+
+struct ShapeQueryContext
+{
+    cpBB bb;
+    cpVect point;
+    int categoryMask;
+    std::vector<PhysicsShape*>* shapes;
+};
+
+cpCollisionID queryRectsFunc(ShapeQueryContext* context, cpShape* shape, cpCollisionID id, void* /*data*/)
+{
+    if (cpBBIntersects(context->bb, shape->bb) && matchCategory(shape, context->categoryMask))
+        context->shapes->push_back(static_cast<PhysicsShape*>(cpShapeGetUserData(shape)));
+    return id;
+}
+
+cpCollisionID queryPointsFunc(ShapeQueryContext* context, cpShape* shape, cpCollisionID id, void* /*data*/)
+{
+    if (matchCategory(shape, context->categoryMask))
+    {
+        cpPointQueryInfo info;
+        cpShapePointQuery(shape, context->point, &info);
+        if (info.shape && info.distance < 0)
+            context->shapes->push_back(static_cast<PhysicsShape*>(cpShapeGetUserData(shape)));
+    }
+    return id;
+}
+}  // namespace
+
+void PhysicsWorld::rayCastFirst(std::span<const PhysicsRay> rays,
+                                std::span<PhysicsRayCastInfo> hits,
+                                int categoryMask)
+{
+    AXASSERT(hits.size() >= rays.size(), "a hit per ray");
+
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+    // the spatial indexes mustn't change meanwhile
+    waitAsyncStep();
+
+    forEachQueryRange(rays.size(), [this, rays, hits, categoryMask](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i)
+        {
+            auto& ray                   = rays[i];
+            RayCastFirstContext context = {PhysicsHelper::vec22cpv(ray.start), PhysicsHelper::vec22cpv(ray.end),
+                                           categoryMask};
+            cpSegmentQueryInfo info     = {nullptr, context.end, cpvzero, 1.0f};
+            cpSpatialIndexSegmentQuery(_cpSpace->staticShapes, &context, context.start, context.end, 1.0f,
+                                       (cpSpatialIndexSegmentQueryFunc)rayCastFirstFunc, &info);
+            cpSpatialIndexSegmentQuery(_cpSpace->dynamicShapes, &context, context.start, context.end, info.alpha,
+                                       (cpSpatialIndexSegmentQueryFunc)rayCastFirstFunc, &info);
+
+            hits[i] = {
+                info.shape ? static_cast<PhysicsShape*>(cpShapeGetUserData(info.shape)) : nullptr,
+                ray.start,
+                ray.end,
+                PhysicsHelper::cpv2vec2(info.point),
+                PhysicsHelper::cpv2vec2(info.normal),
+                static_cast<float>(info.alpha),
+                nullptr,
+            };
+        }
+    });
+}
+
+void PhysicsWorld::queryRects(std::span<const Rect> rects, PhysicsQueryResults& results, int categoryMask)
+{
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+    waitAsyncStep();
+
+    runShapeQueries(rects.size(), results, _queryRanges, [this, rects, categoryMask](size_t i, auto& shapes) {
+        ShapeQueryContext context = {PhysicsHelper::rect2cpbb(rects[i]), cpvzero, categoryMask, &shapes};
+        cpSpatialIndexQuery(_cpSpace->dynamicShapes, &context, context.bb, (cpSpatialIndexQueryFunc)queryRectsFunc,
+                            nullptr);
+        cpSpatialIndexQuery(_cpSpace->staticShapes, &context, context.bb, (cpSpatialIndexQueryFunc)queryRectsFunc,
+                            nullptr);
+    });
+}
+
+void PhysicsWorld::queryPoints(std::span<const Vec2> points, PhysicsQueryResults& results, int categoryMask)
+{
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+    waitAsyncStep();
+
+    runShapeQueries(points.size(), results, _queryRanges, [this, points, categoryMask](size_t i, auto& shapes) {
+        auto point                = PhysicsHelper::vec22cpv(points[i]);
+        ShapeQueryContext context = {cpBBNewForCircle(point, 0.0f), point, categoryMask, &shapes};
+        cpSpatialIndexQuery(_cpSpace->dynamicShapes, &context, context.bb, (cpSpatialIndexQueryFunc)queryPointsFunc,
+                            nullptr);
+        cpSpatialIndexQuery(_cpSpace->staticShapes, &context, context.bb, (cpSpatialIndexQueryFunc)queryPointsFunc,
+                            nullptr);
+    });
+}
+
 bool PhysicsWorld::init()
 {
     do
@@ -929,8 +1119,180 @@ void PhysicsWorld::step(float delta)
     }
 }
 
+void PhysicsWorld::setAsyncStep(bool async)
+{
+    if (_asyncStep == async)
+        return;
+
+    if (async)
+    {
+        _afterDrawListener = _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW,
+                                                                      [this](EventCustom*) { waitAsyncStep(); });
+    }
+    else
+    {
+        waitAsyncStep();
+        _eventDispatcher->removeEventListener(_afterDrawListener);
+        _afterDrawListener = nullptr;
+    }
+
+    _asyncStep   = async;
+    _updateTime  = 0.0f;
+    _asyncAlpha  = 0.0f;
+    bool damping = async || _fixedRate > 0;
+    for (auto&& body : _bodies)
+    {
+        body->setFixedUpdate(damping);
+        body->_hasPreviousStep = false;
+    }
+}
+
+#    if AX_TARGET_PLATFORM != AX_PLATFORM_WIN32
+static void solveIslands(cpHastySpaceIslandFunc func, void* data, unsigned long count, void* userData)
+{
+    auto jobSystem = static_cast<JobSystem*>(userData);
+    // a few ranges per thread, the islands are of any size
+    const size_t grainSize = (std::max)(size_t{1}, count / ((jobSystem->getWorkerCount() + 1) * 4));
+    jobSystem->wait(jobSystem->parallelFor(count, grainSize, [func, data](size_t begin, size_t end) {
+        for (auto island = begin; island < end; ++island)
+            func(static_cast<unsigned long>(island), data);
+    }));
+}
+#    endif
+
+void PhysicsWorld::setParallelSolver(bool parallel)
+{
+    if (_parallelSolver == parallel)
+        return;
+
+#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
+    AXLOGW("PhysicsWorld: the parallel solver needs a chipmunk hasty space, it isn't available on Win32");
+#    else
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    if (parallel && jobSystem->getWorkerCount() == 0)
+    {
+        AXLOGW("PhysicsWorld: no JobSystem worker, the islands are solved on one thread");
+        return;
+    }
+
+    // not while the asynchronous step solves
+    waitAsyncStep();
+    _parallelSolver = parallel;
+    cpHastySpaceSetIslandSolver(_cpSpace, parallel ? solveIslands : nullptr, jobSystem);
+#    endif
+}
+
+void PhysicsWorld::waitAsyncStep()
+{
+    if (!_asyncJob.valid())
+        return;
+
+    Director::getInstance()->getJobSystem()->wait(_asyncJob);
+    _asyncJob = JobHandle{};
+
+    // locked like during the step, the bodies removed by the listeners are removed with the next update
+    cpSpaceLock(_cpSpace);
+    for (auto&& event : _asyncContactEvents)
+    {
+        auto contact = event.contact;
+        if (contact->isNotificationEnabled())
+        {
+            contact->setEventCode(event.separate ? PhysicsContact::EventCode::SEPARATE
+                                                 : PhysicsContact::EventCode::BEGIN);
+            contact->setWorld(this);
+            _eventDispatcher->dispatchEvent(contact);
+        }
+        if (event.separate)
+            delete contact;
+    }
+    _asyncContactEvents.clear();
+    cpSpaceUnlock(_cpSpace, cpTrue);
+}
+
+void PhysicsWorld::updateAsync(float delta)
+{
+    waitAsyncStep();
+
+    if (_preUpdateCallback)
+        _preUpdateCallback();
+
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+
+    // pushes the nodes the game changed to their bodies
+    auto sceneToWorldTransform = _scene->getNodeToParentTransform();
+    beforeSimulation(_scene, sceneToWorldTransform, 1.f, 1.f, 0.f);
+
+    if (!_delayAddJoints.empty() || !_delayRemoveJoints.empty())
+    {
+        updateJoints();
+    }
+
+    // the nodes show the last two steps with the part of a step left when they were scheduled
+    if (_batchedWriteback)
+        writeBackBodies(true);
+    else
+        afterAsyncSimulation(_scene, sceneToWorldTransform, 0.f);
+
+    if (_debugDrawMask != DEBUGDRAW_NONE)
+    {
+        debugDraw();
+    }
+
+    const float step = 1.0f / (_fixedRate ? _fixedRate : DEFAULT_ASYNC_UPDATE_RATE);
+    const float dt   = step * _speed;
+    int steps        = 0;
+    _updateTime += delta;
+    while (_updateTime > step)
+    {
+        _updateTime -= step;
+        _scene->fixedUpdate(dt);
+        ++steps;
+    }
+    _asyncAlpha = _updateTime / step;
+
+    if (_postUpdateCallback)
+        _postUpdateCallback();
+
+    if (steps == 0)
+        return;
+
+    // waited for by the after draw listener, so the step runs while the frame renders
+    _asyncJob = Director::getInstance()->getJobSystem()->schedule(
+        [this, steps, dt] {
+            _asyncStepping = true;
+            for (int i = 0; i < steps; ++i)
+            {
+                if (i == steps - 1)
+                {
+                    for (auto&& body : _bodies)
+                        body->recordPreviousStep();
+                }
+                for (auto&& body : _bodies)
+                {
+                    body->fixedUpdate(dt);
+                }
+#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
+                cpSpaceStep(_cpSpace, dt);
+#    else
+                cpHastySpaceStep(_cpSpace, dt);
+#    endif
+            }
+            _asyncStepping = false;
+        },
+        JobPriority::High);
+}
+
 void PhysicsWorld::update(float delta, bool userCall /* = false*/)
 {
+    if (_asyncStep && !userCall)
+    {
+        updateAsync(delta);
+        return;
+    }
+
 
     if (_preUpdateCallback)
         _preUpdateCallback();  // fix #11154
@@ -1014,7 +1376,10 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
 
     // Update physics position, should loop as the same sequence as node tree.
     // PhysicsWorld::afterSimulation() will depend on the sequence.
-    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+    if (_batchedWriteback)
+        writeBackBodies(false);
+    else
+        afterSimulation(_scene, sceneToWorldTransform, 0.f);
 
     if (_postUpdateCallback)
         _postUpdateCallback();  // fix #11154
@@ -1049,10 +1414,18 @@ PhysicsWorld::PhysicsWorld()
     , _debugDraw(nullptr)
     , _debugDrawMask(DEBUGDRAW_NONE)
     , _eventDispatcher(nullptr)
+    , _asyncStep(false)
+    , _asyncStepping(false)
+    , _asyncAlpha(0.0f)
+    , _afterDrawListener(nullptr)
+    , _batchedWriteback(false)
+    , _parallelSolver(false)
 {}
 
 PhysicsWorld::~PhysicsWorld()
 {
+    if (_asyncStep)
+        setAsyncStep(false);
     removeAllJoints(true);
     removeAllBodies();
     if (_cpSpace)
@@ -1103,6 +1476,59 @@ void PhysicsWorld::afterSimulation(Node* node, const Mat4& parentToWorldTransfor
         afterSimulation(child, nodeToWorldTransform, nodeRotation);
 }
 
+void PhysicsWorld::afterAsyncSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation)
+{
+    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
+    auto nodeRotation         = parentRotation + node->getRotation();
+
+    auto physicsBody = node->getPhysicsBody();
+    if (physicsBody)
+    {
+        physicsBody->afterAsyncSimulation(parentToWorldTransform, parentRotation, _asyncAlpha);
+    }
+
+    for (auto&& child : node->getChildren())
+        afterAsyncSimulation(child, nodeToWorldTransform, nodeRotation);
+}
+
+void PhysicsWorld::writeBackBodies(bool interpolated)
+{
+    // the bodies of a parent share its inverted transform
+    _writebackParents.clear();
+    for (auto&& body : _bodies)
+    {
+        auto owner  = body->getOwner();
+        auto parent = owner ? owner->getParent() : nullptr;
+        if (!parent)
+            continue;
+
+        // a body shown interpolated is written until it shows where it fell asleep
+        if (body->isResting() && (!interpolated || !body->_hasPreviousStep))
+            continue;
+
+        auto it = _writebackParents.find(parent);
+        if (it == _writebackParents.end())
+        {
+            ParentTransform transform;
+            transform.worldToNode   = parent->getWorldToNodeTransform();
+            transform.worldRotation = 0.f;
+            for (auto node = parent; node; node = node->getParent())
+                transform.worldRotation += node->getRotation();
+            it = _writebackParents.emplace(parent, transform).first;
+        }
+
+        if (interpolated)
+        {
+            bool resting = body->isResting();
+            body->writeBackInterpolated(it->second.worldToNode, it->second.worldRotation, resting ? 1.f : _asyncAlpha);
+            if (resting)
+                body->_hasPreviousStep = false;
+        }
+        else
+            body->writeBack(it->second.worldToNode, it->second.worldRotation);
+    }
+}
+
 void PhysicsWorld::setPostUpdateCallback(const std::function<void()>& callback)
 {
     _postUpdateCallback = callback;
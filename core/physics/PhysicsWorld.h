@@ -31,7 +31,10 @@
 #if defined(AX_ENABLE_PHYSICS)
 
 #    include <list>
+#    include <span>
+#    include <unordered_map>
 #    include "base/Vector.h"
+#    include "base/JobSystem.h"
 #    include "math/Math.h"
 #    include "physics/PhysicsBody.h"
 
@@ -52,6 +55,7 @@ class Scene;
 class DrawNode;
 class PhysicsDebugDraw;
 class EventDispatcher;
+class EventListenerCustom;
 
 class PhysicsWorld;
 
@@ -87,6 +91,26 @@ typedef std::function<bool(PhysicsWorld& world, const PhysicsRayCastInfo& info,
 typedef std::function<bool(PhysicsWorld&, PhysicsShape&, void*)> PhysicsQueryRectCallbackFunc;
 typedef PhysicsQueryRectCallbackFunc PhysicsQueryPointCallbackFunc;
 
+/** A ray of PhysicsWorld::rayCastFirst. */
+struct PhysicsRay
+{
+    Vec2 start;
+    Vec2 end;
+};
+
+/** The shapes found by a batched query of PhysicsWorld, by query. */
+struct AX_DLL PhysicsQueryResults
+{
+    std::vector<PhysicsShape*> shapes;
+    std::vector<uint32_t> offsets;  ///< the shapes of query i are in [offsets[i], offsets[i + 1])
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    std::span<PhysicsShape* const> get(size_t query) const
+    {
+        return {shapes.data() + offsets[query], shapes.data() + offsets[query + 1]};
+    }
+};
+
 /**
  * @addtogroup physics
  * @{
@@ -212,6 +236,39 @@ public:
      */
     PhysicsShape* getShape(const Vec2& point) const;
 
+    /** The query count from which the batched queries are spread over the JobSystem workers. */
+    static constexpr size_t PARALLEL_QUERY_THRESHOLD = 64;
+
+    /**
+     * Finds the closest shape hit by each ray, like line of sight checks.
+     *
+     * The shapes are searched in the spatial indexes of the world, without a callback per shape, and the rays are
+     * cast on the JobSystem workers when there are many. The sensors are ignored, like the shapes whose category
+     * bitmask doesn't match the mask.
+     * @param   rays   The rays to cast.
+     * @param   hits   A hit per ray, its shape is nullptr and its fraction 1 when the ray hits nothing.
+     * @param   categoryMask   The categories of the shapes which can be hit.
+     */
+    void rayCastFirst(std::span<const PhysicsRay> rays, std::span<PhysicsRayCastInfo> hits, int categoryMask = -1);
+
+    /**
+     * Finds the shapes overlapping each rect, like queryRect, but in a batch.
+     *
+     * @param   rects   The rects to query.
+     * @param   results   The shapes of each rect, the vectors of the results are reused.
+     * @param   categoryMask   The categories of the shapes which can be found.
+     */
+    void queryRects(std::span<const Rect> rects, PhysicsQueryResults& results, int categoryMask = -1);
+
+    /**
+     * Finds the shapes containing each point, like queryPoint, but in a batch.
+     *
+     * @param   points   The points to query.
+     * @param   results   The shapes of each point, the vectors of the results are reused.
+     * @param   categoryMask   The categories of the shapes which can be found.
+     */
+    void queryPoints(std::span<const Vec2> points, PhysicsQueryResults& results, int categoryMask = -1);
+
     /**
      * Get all the bodies that in this physics world.
      *
@@ -402,6 +459,65 @@ public:
      */
     void step(float delta);
 
+    /** The update rate of the asynchronous step when no fixed update rate is set. */
+    static constexpr int DEFAULT_ASYNC_UPDATE_RATE = 60;
+
+    /**
+     * Set whether the physics world is stepped on a worker thread while the frame renders.
+     *
+     * The world is stepped at the fixed update rate, DEFAULT_ASYNC_UPDATE_RATE when none is set, and the nodes show
+     * their bodies interpolated between the last two steps, one step behind the simulation. A node moved or rotated
+     * by the game moves its body like in the synchronous step.
+     * The contact listeners get the begin and separate events on the axmol thread once the step is done, the
+     * presolve and postsolve events aren't sent and the begin events can't reject a contact, use the bitmasks
+     * and groups of the shapes instead. The world mustn't be changed while the frame renders.
+     * @attention if you setAutoStep(false), this won't work.
+     * @param async A bool object, default value is false.
+     */
+    void setAsyncStep(bool async);
+
+    /**
+     * Get whether the physics world is stepped on a worker thread.
+     *
+     * @return A bool object.
+     */
+    bool isAsyncStep() const { return _asyncStep; }
+
+    /**
+     * Set whether the bodies are written back to their nodes in a batch after a step.
+     *
+     * The bodies are walked in their array instead of the scene graph, the sleeping ones are skipped, and the nodes'
+     * position and rotation fields are written directly with a single dirty flag update, without their virtual
+     * setters. It is much faster with many bodies, but the nodes overriding setPosition or setRotation don't see
+     * the physics changes.
+     * @param batched A bool object, default value is false.
+     */
+    void setBatchedWriteback(bool batched) { _batchedWriteback = batched; }
+
+    /**
+     * Get whether the bodies are written back to their nodes in a batch.
+     *
+     * @return A bool object.
+     */
+    bool isBatchedWriteback() const { return _batchedWriteback; }
+
+    /**
+     * Set whether the islands of bodies, the groups touching or jointed together, are solved in parallel.
+     *
+     * The islands are solved on the JobSystem workers, on the steps with more than 50 contacts and joints. They share
+     * no dynamic body, so the simulation is the same as with the solver on one thread. It isn't available on Win32,
+     * where the physics space is a plain chipmunk space.
+     * @param parallel A bool object, default value is false.
+     */
+    void setParallelSolver(bool parallel);
+
+    /**
+     * Get whether the islands of bodies are solved in parallel.
+     *
+     * @return A bool object.
+     */
+    bool isParallelSolver() const { return _parallelSolver; }
+
 protected:
     static PhysicsWorld* construct(Scene* scene);
     bool init();
@@ -410,6 +526,9 @@ protected:
     virtual void addShape(PhysicsShape* shape);
     virtual void removeShape(PhysicsShape* shape);
     virtual void update(float delta, bool userCall = false);
+    void updateAsync(float delta);
+    /** Waits for the asynchronous step and sends the contact events it recorded. */
+    void waitAsyncStep();
 
     virtual void debugDraw();
 
@@ -425,6 +544,8 @@ protected:
     virtual void removeBodyOrDelay(PhysicsBody* body);
     virtual void updateBodies();
     virtual void updateJoints();
+    /** The batched afterSimulation, interpolated for the asynchronous step. */
+    void writeBackBodies(bool interpolated);
 
 protected:
     Vec2 _gravity;
@@ -455,6 +576,35 @@ protected:
     std::function<void()> _preUpdateCallback;
     std::function<void()> _postUpdateCallback;
 
+    // the asynchronous step
+    struct AsyncContactEvent
+    {
+        PhysicsContact* contact;
+        bool separate;  // the contact is deleted once its event is sent
+    };
+
+    bool _asyncStep;
+    bool _asyncStepping;  // the contact callbacks run on the worker
+    float _asyncAlpha;
+    JobHandle _asyncJob;
+    std::vector<AsyncContactEvent> _asyncContactEvents;
+    EventListenerCustom* _afterDrawListener;
+
+    // the batched writeback
+    struct ParentTransform
+    {
+        Mat4 worldToNode;
+        float worldRotation;
+    };
+
+    bool _batchedWriteback;
+    std::unordered_map<Node*, ParentTransform> _writebackParents;
+
+    bool _parallelSolver;
+
+    // the shapes found by each range of a batched query, merged once the ranges are done
+    std::vector<std::vector<PhysicsShape*>> _queryRanges;
+
 protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
@@ -465,6 +615,7 @@ protected:
                           float nodeParentScaleY,
                           float parentRotation);
     void afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation);
+    void afterAsyncSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation);
 
     friend class Node;
     friend class Sprite;
@@ -88,6 +88,7 @@ bool Physics3DRigidBody::init(Physics3DRigidBodyDes* info)
     _type           = Physics3DObject::PhysicsObjType::RIGID_BODY;
     _physics3DShape = info->shape;
     _physics3DShape->retain();
+    _btRigidBody->setUserPointer(this);
     if (info->disableSleep)
         _btRigidBody->setActivationState(DISABLE_DEACTIVATION);
     return true;
@@ -532,6 +533,7 @@ bool Physics3DCollider::init(Physics3DColliderDes* info)
     _physics3DShape = info->shape;
     _physics3DShape->retain();
     _btGhostObject = new btCollider(this);
+    _btGhostObject->setUserPointer(this);
     _btGhostObject->setCollisionShape(_physics3DShape->getbtShape());
 
     setTrigger(info->isTrigger);
@@ -31,6 +31,7 @@
 #include "base/Object.h"
 #include "base/Config.h"
 
+#include <span>
 #include <vector>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
@@ -71,6 +72,34 @@ struct AX_DLL Physics3DCollisionInfo
     Physics3DObject* objB;
     std::vector<CollisionPoint> collisionPointList;
 };
+
+/**
+ * @brief A pair of Physics3DObjects in contact, see Physics3DWorld::addContactListener.
+ */
+struct AX_DLL Physics3DContact
+{
+    Physics3DObject* objA;
+    Physics3DObject* objB;
+    uint32_t firstPoint;  // index of the first point in Physics3DContactBatch::points
+    uint32_t pointCount;  // 0 for the ended contacts
+};
+
+/**
+ * @brief The contacts of a step, by phase. The buffers are reused by the next step, they must not be kept.
+ * A pair touching by several manifolds, like with compound shapes, has a contact per manifold.
+ */
+struct AX_DLL Physics3DContactBatch
+{
+    std::span<const Physics3DContact> began;       // pairs which started touching at this step
+    std::span<const Physics3DContact> persisting;  // pairs which were touching at the previous step too
+    std::span<const Physics3DContact> ended;       // pairs which stopped touching, not the removed objects
+    std::span<const Physics3DCollisionInfo::CollisionPoint> points;
+
+    std::span<const Physics3DCollisionInfo::CollisionPoint> getPoints(const Physics3DContact& contact) const
+    {
+        return points.subspan(contact.firstPoint, contact.pointCount);
+    }
+};
 /**
  * @brief Inherit from Object, base class
  */
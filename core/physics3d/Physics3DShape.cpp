@@ -30,10 +30,75 @@
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 #        include "bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
+#        include "base/hlookup.h"
+#        include "platform/FileUtils.h"
+#        include "mio/mio.hpp"
+#        include "tsl/robin_map.h"
 
 namespace ax
 {
 
+namespace
+{
+constexpr char COOKED_MESH_MAGIC[4]    = {'A', 'X', 'C', 'M'};
+constexpr uint32_t COOKED_MESH_VERSION = 1;
+constexpr size_t COOKED_MESH_ALIGNMENT = 16;
+
+// the bvh is saved in the memory layout of bullet, the files of other layouts are rejected
+constexpr uint32_t COOKED_MESH_LAYOUT = static_cast<uint32_t>(sizeof(void*) | (sizeof(btScalar) << 8) |
+                                                              (sizeof(btOptimizedBvh) << 16));
+
+struct CookedMeshHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t layout;
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t bvhSize;
+    uint64_t vertexOffset;  // btScalar x, y, z per vertex
+    uint64_t indexOffset;   // int32 i0, i1, i2 per triangle
+    uint64_t bvhOffset;
+    uint64_t fileSize;
+};
+
+struct VertexHash
+{
+    size_t operator()(const Vec3& v) const
+    {
+        uint32_t bits[3];
+        memcpy(bits, &v, sizeof(bits));
+        return (static_cast<size_t>(bits[0]) * 73856093) ^ (static_cast<size_t>(bits[1]) * 19349663) ^
+               (static_cast<size_t>(bits[2]) * 83492791);
+    }
+};
+
+size_t alignOffset(size_t offset)
+{
+    return (offset + COOKED_MESH_ALIGNMENT - 1) & ~(COOKED_MESH_ALIGNMENT - 1);
+}
+
+// weak refs to the alive shapes of the cooked files, by full path
+hlookup::string_map<Physics3DShape*> s_cookedMeshShapes;
+}  // namespace
+
+struct Physics3DShape::CookedMesh
+{
+    std::string fullPath;
+    mio::mmap_source mapping;
+    Data buffer;  // used when the file can't be mapped
+    void* bvhMemory     = nullptr;
+    btOptimizedBvh* bvh = nullptr;  // deserialized in place in bvhMemory
+
+    ~CookedMesh()
+    {
+        if (bvh)
+            bvh->~btOptimizedBvh();
+        if (bvhMemory)
+            btAlignedFree(bvhMemory);
+    }
+};
+
 Physics3DShape::ShapeType Physics3DShape::getShapeType() const
 {
     return _shapeType;
@@ -50,6 +115,10 @@ Physics3DShape::~Physics3DShape()
 {
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     AX_SAFE_DELETE(_btShape);
+    AX_SAFE_DELETE(_meshInterface);
+    if (_cookedMesh)
+        s_cookedMeshShapes.erase(_cookedMesh->fullPath);
+    _cookedMesh.reset();
     AX_SAFE_DELETE_ARRAY(_heightfieldData);
     for (auto&& iter : _compoundChildShapes)
     {
@@ -107,6 +176,78 @@ Physics3DShape* Physics3DShape::createMesh(const ax::Vec3* triangles, int numTri
     return shape;
 }
 
+bool Physics3DShape::cookMesh(const ax::Vec3* triangles, int numTriangles, std::string_view fullPath)
+{
+    // the vertices shared by the triangles are welded
+    std::vector<btScalar> vertices;
+    std::vector<int32_t> indices(numTriangles * 3);
+    tsl::robin_map<Vec3, int32_t, VertexHash> vertexIndices;
+    for (int i = 0; i < numTriangles * 3; ++i)
+    {
+        auto [it, inserted] = vertexIndices.emplace(triangles[i], static_cast<int32_t>(vertexIndices.size()));
+        if (inserted)
+        {
+            vertices.emplace_back(triangles[i].x);
+            vertices.emplace_back(triangles[i].y);
+            vertices.emplace_back(triangles[i].z);
+        }
+        indices[i] = it->second;
+    }
+    int vertexCount = static_cast<int>(vertexIndices.size());
+
+    btTriangleIndexVertexArray meshInterface(numTriangles, indices.data(), 3 * sizeof(int32_t), vertexCount,
+                                             vertices.data(), 3 * sizeof(btScalar));
+    btBvhTriangleMeshShape shape(&meshInterface, true);
+    auto bvh         = shape.getOptimizedBvh();
+    unsigned bvhSize = bvh->calculateSerializeBufferSize();
+    void* bvhMemory  = btAlignedAlloc(bvhSize, COOKED_MESH_ALIGNMENT);
+    bool serialized  = bvh->serializeInPlace(bvhMemory, bvhSize, false);
+
+    size_t vertexOffset = alignOffset(sizeof(CookedMeshHeader));
+    size_t indexOffset  = alignOffset(vertexOffset + vertices.size() * sizeof(btScalar));
+    size_t bvhOffset    = alignOffset(indexOffset + indices.size() * sizeof(int32_t));
+    std::vector<uint8_t> file(bvhOffset + bvhSize);
+
+    CookedMeshHeader header{};
+    memcpy(header.magic, COOKED_MESH_MAGIC, sizeof(COOKED_MESH_MAGIC));
+    header.version       = COOKED_MESH_VERSION;
+    header.layout        = COOKED_MESH_LAYOUT;
+    header.vertexCount   = static_cast<uint32_t>(vertexCount);
+    header.triangleCount = static_cast<uint32_t>(numTriangles);
+    header.bvhSize       = bvhSize;
+    header.vertexOffset  = vertexOffset;
+    header.indexOffset   = indexOffset;
+    header.bvhOffset     = bvhOffset;
+    header.fileSize      = file.size();
+    memcpy(file.data(), &header, sizeof(header));
+    memcpy(file.data() + vertexOffset, vertices.data(), vertices.size() * sizeof(btScalar));
+    memcpy(file.data() + indexOffset, indices.data(), indices.size() * sizeof(int32_t));
+    memcpy(file.data() + bvhOffset, bvhMemory, bvhSize);
+    btAlignedFree(bvhMemory);
+
+    return serialized && FileUtils::writeBinaryToFile(file.data(), file.size(), fullPath);
+}
+
+Physics3DShape* Physics3DShape::createCookedMesh(std::string_view path)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
+    if (fullPath.empty())
+        return nullptr;
+
+    auto it = s_cookedMeshShapes.find(fullPath);
+    if (it != s_cookedMeshShapes.end())
+        return it->second;
+
+    auto shape = new Physics3DShape();
+    if (!shape->initCookedMesh(fullPath))
+    {
+        delete shape;
+        return nullptr;
+    }
+    shape->autorelease();
+    return shape;
+}
+
 Physics3DShape* Physics3DShape::createHeightfield(int heightStickWidth,
                                                   int heightStickLength,
                                                   const void* heightfieldData,
@@ -115,11 +256,12 @@ Physics3DShape* Physics3DShape::createHeightfield(int heightStickWidth,
                                                   float maxHeight,
                                                   bool useFloatDatam,
                                                   bool flipQuadEdges,
-                                                  bool useDiamondSubdivision)
+                                                  bool useDiamondSubdivision,
+                                                  bool copyData)
 {
     auto shape = new Physics3DShape();
     shape->initHeightfield(heightStickWidth, heightStickLength, heightfieldData, heightScale, minHeight, maxHeight,
-                           useFloatDatam, flipQuadEdges, useDiamondSubdivision);
+                           useFloatDatam, flipQuadEdges, useDiamondSubdivision, copyData);
     shape->autorelease();
     return shape;
 }
@@ -173,7 +315,64 @@ bool Physics3DShape::initMesh(const ax::Vec3* triangles, int numTriangles)
         mesh->addTriangle(convertVec3TobtVector3(triangles[i]), convertVec3TobtVector3(triangles[i + 1]),
                           convertVec3TobtVector3(triangles[i + 2]));
     }
-    _btShape = new btBvhTriangleMeshShape(mesh, true);
+    _meshInterface = mesh;
+    _btShape       = new btBvhTriangleMeshShape(mesh, true);
+    return true;
+}
+
+bool Physics3DShape::initCookedMesh(std::string_view fullPath)
+{
+    auto cooked         = std::make_unique<CookedMesh>();
+    const uint8_t* data = nullptr;
+    size_t size         = 0;
+
+    std::error_code error;
+    cooked->mapping.map(std::string{fullPath}, error);
+    if (!error && cooked->mapping.size() > 0)
+    {
+        data = reinterpret_cast<const uint8_t*>(cooked->mapping.data());
+        size = cooked->mapping.size();
+    }
+    else
+    {
+        // not a regular file, e.g. in the apk
+        cooked->buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+        data           = cooked->buffer.getBytes();
+        size           = static_cast<size_t>(cooked->buffer.getSize());
+    }
+
+    auto header = reinterpret_cast<const CookedMeshHeader*>(data);
+    if (!data || size < sizeof(CookedMeshHeader) || memcmp(header->magic, COOKED_MESH_MAGIC, 4) != 0 ||
+        header->version != COOKED_MESH_VERSION || header->layout != COOKED_MESH_LAYOUT || header->fileSize != size ||
+        header->vertexOffset + header->vertexCount * 3 * sizeof(btScalar) > size ||
+        header->indexOffset + header->triangleCount * 3 * sizeof(int32_t) > size ||
+        header->bvhOffset + header->bvhSize > size)
+    {
+        AXLOGW("Physics3DShape: '{}' is not a cooked mesh of this platform", fullPath);
+        return false;
+    }
+
+    // the bvh is fixed up in place, so it is copied out of the read only mapping
+    cooked->bvhMemory = btAlignedAlloc(header->bvhSize, COOKED_MESH_ALIGNMENT);
+    memcpy(cooked->bvhMemory, data + header->bvhOffset, header->bvhSize);
+    cooked->bvh = btOptimizedBvh::deSerializeInPlace(cooked->bvhMemory, header->bvhSize, false);
+    if (!cooked->bvh)
+        return false;
+
+    // the vertices and indices are read from the mapping
+    _meshInterface = new btTriangleIndexVertexArray(
+        static_cast<int>(header->triangleCount),
+        reinterpret_cast<int*>(const_cast<uint8_t*>(data + header->indexOffset)), 3 * sizeof(int32_t),
+        static_cast<int>(header->vertexCount),
+        reinterpret_cast<btScalar*>(const_cast<uint8_t*>(data + header->vertexOffset)), 3 * sizeof(btScalar));
+    auto meshShape = new btBvhTriangleMeshShape(_meshInterface, true, false);
+    meshShape->setOptimizedBvh(cooked->bvh);
+
+    _shapeType       = ShapeType::MESH;
+    _btShape         = meshShape;
+    cooked->fullPath = fullPath;
+    _cookedMesh      = std::move(cooked);
+    s_cookedMeshShapes.emplace(_cookedMesh->fullPath, this);
     return true;
 }
 
@@ -185,7 +384,8 @@ bool Physics3DShape::initHeightfield(int heightStickWidth,
                                      float maxHeight,
                                      bool useFloatDatam,
                                      bool flipQuadEdges,
-                                     bool useDiamondSubdivision)
+                                     bool useDiamondSubdivision,
+                                     bool copyData)
 {
     _shapeType                  = ShapeType::HEIGHT_FIELD;
     PHY_ScalarType type         = PHY_UCHAR;
@@ -195,10 +395,15 @@ bool Physics3DShape::initHeightfield(int heightStickWidth,
         type = PHY_FLOAT;
         dataSizeInByte *= sizeof(float);
     }
-    _heightfieldData = new unsigned char[dataSizeInByte];
-    memcpy(_heightfieldData, heightfieldData, dataSizeInByte);
-    auto heightfield = new btHeightfieldTerrainShape(heightStickWidth, heightStickLength, _heightfieldData, heightScale,
-                                                     minHeight, maxHeight, 1, type, flipQuadEdges);
+    const void* data = heightfieldData;
+    if (copyData)
+    {
+        _heightfieldData = new unsigned char[dataSizeInByte];
+        memcpy(_heightfieldData, heightfieldData, dataSizeInByte);
+        data = _heightfieldData;
+    }
+    auto heightfield = new btHeightfieldTerrainShape(heightStickWidth, heightStickLength, data, heightScale, minHeight,
+                                                     maxHeight, 1, type, flipQuadEdges);
     heightfield->setUseDiamondSubdivision(useDiamondSubdivision);
     _btShape = heightfield;
     return true;
@@ -27,6 +27,8 @@
 #ifndef __PHYSICS_3D_SHAPE_H__
 #define __PHYSICS_3D_SHAPE_H__
 
+#include <memory>
+
 #include "base/Object.h"
 #include "base/Config.h"
 #include "math/Math.h"
@@ -36,6 +38,7 @@
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 
 class btCollisionShape;
+class btStridingMeshInterface;
 
 namespace ax
 {
@@ -108,6 +111,24 @@ public:
      */
     static Physics3DShape* createMesh(const ax::Vec3* triangles, int numTriangles);
 
+    /**
+     * Cook a triangle mesh into a file, its shared vertices and the quantized bvh of Bullet laid out to be loaded
+     * by createCookedMesh without building the bvh again. The bvh is saved in the memory layout of Bullet, so a
+     * cooked file is only loaded by builds for the same platform, it is created again on another one.
+     * @param triangles The pointer of triangle list
+     * @param numTriangles The number of triangles.
+     * @param fullPath The path of the cooked file.
+     */
+    static bool cookMesh(const ax::Vec3* triangles, int numTriangles, std::string_view fullPath);
+
+    /**
+     * create mesh from a file written by cookMesh. The file is memory mapped and the vertices are read from the
+     * mapping, only the bvh is copied. The shapes are shared: while a shape of the file is alive, it is returned
+     * again instead of loading the file twice.
+     * @return The shape, or null if the file is missing or was cooked for another platform.
+     */
+    static Physics3DShape* createCookedMesh(std::string_view path);
+
     /**
      * create heightfield
      * @param heightStickWidth The Width of heightfield
@@ -116,6 +137,7 @@ public:
      * @param minHeight The minHeight of heightfield.
      * @param maxHeight The maxHeight of heightfield.
      * @param flipQuadEdges if flip QuadEdges
+     * @param copyData false to use the data in place, it must then outlive the shape.
      */
     static Physics3DShape* createHeightfield(int heightStickWidth,
                                              int heightStickLength,
@@ -125,7 +147,8 @@ public:
                                              float maxHeight,
                                              bool useFloatDatam,
                                              bool flipQuadEdges,
-                                             bool useDiamondSubdivision = false);
+                                             bool useDiamondSubdivision = false,
+                                             bool copyData              = true);
 
     /**
      * create Compound Shape
@@ -146,6 +169,7 @@ public:
     bool initCapsule(float radius, float height);
     bool initConvexHull(const ax::Vec3* points, int numPoints);
     bool initMesh(const ax::Vec3* triangles, int numTriangles);
+    bool initCookedMesh(std::string_view fullPath);
     bool initHeightfield(int heightStickWidth,
                          int heightStickLength,
                          const void* heightfieldData,
@@ -154,14 +178,19 @@ public:
                          float maxHeight,
                          bool useFloatDatam,
                          bool flipQuadEdges,
-                         bool useDiamondSubdivision);
+                         bool useDiamondSubdivision,
+                         bool copyData = true);
     bool initCompoundShape(const std::vector<std::pair<Physics3DShape*, Mat4>>& shapes);
 
 protected:
     ShapeType _shapeType;  // shape type
 
 #        if (AX_ENABLE_BULLET_INTEGRATION)
+    struct CookedMesh;
+
     btCollisionShape* _btShape;
+    btStridingMeshInterface* _meshInterface = nullptr;  // the triangles of a mesh shape
+    std::unique_ptr<CookedMesh> _cookedMesh;              // the mapping of a cooked mesh file
     unsigned char* _heightfieldData;
     std::vector<Physics3DShape*> _compoundChildShapes;
 #        endif
@@ -26,23 +26,122 @@
 
 #include "physics3d/Physics3D.h"
 #include "renderer/Renderer.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 
+#        include <chrono>
+
+#        if BT_THREADSAFE
+#            include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#            include "bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#            include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+
+// defined by btThreads.cpp but not declared by its header, they tell the solvers not to nest their parallel loops
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+#        endif
+
 namespace ax
 {
 
+#        if BT_THREADSAFE
+namespace
+{
+/**
+ * Runs the parallel loops of Bullet on the JobSystem workers, Bullet has a single task scheduler for the process.
+ * The thread indexes of Bullet are given on first use, 0 is the axmol thread, the workers take the next ones, so the
+ * thread count is the worker count plus the axmol thread.
+ */
+class JobSystemTaskScheduler : public btITaskScheduler
+{
+public:
+    explicit JobSystemTaskScheduler(JobSystem* jobSystem)
+        : btITaskScheduler("JobSystem")
+        , _jobSystem(jobSystem)
+        , _numThreads((std::min)(static_cast<int>(jobSystem->getWorkerCount()) + 1, int(BT_MAX_THREAD_COUNT)))
+    {}
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return _numThreads; }
+    // the threads are the ones of the JobSystem
+    void setNumThreads(int) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        const int count = iEnd - iBegin;
+        if (count <= grainSize || _numThreads <= 1)
+        {
+            body.forLoop(iBegin, iEnd);
+            return;
+        }
+
+        btPushThreadsAreRunning();
+        _jobSystem->wait(_jobSystem->parallelFor(count, grainSize, [iBegin, &body](size_t begin, size_t end) {
+            body.forLoop(iBegin + static_cast<int>(begin), iBegin + static_cast<int>(end));
+        }));
+        btPopThreadsAreRunning();
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        const int count = iEnd - iBegin;
+        if (count <= grainSize || _numThreads <= 1)
+            return body.sumLoop(iBegin, iEnd);
+
+        // a sum per range, added in order so that the result doesn't depend on the scheduling
+        grainSize = (std::max)(grainSize, 1);
+        std::vector<btScalar> sums((count + grainSize - 1) / grainSize);
+        btPushThreadsAreRunning();
+        _jobSystem->wait(
+            _jobSystem->parallelFor(count, grainSize, [iBegin, grainSize, &body, &sums](size_t begin, size_t end) {
+                sums[begin / grainSize] = body.sumLoop(iBegin + static_cast<int>(begin), iBegin + static_cast<int>(end));
+            }));
+        btPopThreadsAreRunning();
+
+        btScalar sum = 0;
+        for (auto value : sums)
+            sum += value;
+        return sum;
+    }
+
+private:
+    JobSystem* _jobSystem;
+    int _numThreads;
+};
+
+/** Sets the task scheduler of Bullet on first use, returns the thread count, 1 without workers. */
+int setupTaskScheduler()
+{
+    static JobSystemTaskScheduler* scheduler = nullptr;
+    if (!scheduler)
+    {
+        auto jobSystem = Director::getInstance()->getJobSystem();
+        if (!jobSystem || jobSystem->getWorkerCount() == 0)
+            return 1;
+        // never deleted, Bullet keeps it until the process ends
+        scheduler = new JobSystemTaskScheduler(jobSystem);
+        btSetTaskScheduler(scheduler);
+    }
+    return scheduler->getNumThreads();
+}
+}  // namespace
+#        endif  // BT_THREADSAFE
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _multithreaded(false)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
     , _broadphase(nullptr)
     , _solver(nullptr)
+    , _solverMt(nullptr)
     , _ghostCallback(nullptr)
     , _debugDrawer(nullptr)
 {}
@@ -56,6 +155,7 @@ Physics3DWorld::~Physics3DWorld()
     AX_SAFE_DELETE(_broadphase);
     AX_SAFE_DELETE(_ghostCallback);
     AX_SAFE_DELETE(_solver);
+    AX_SAFE_DELETE(_solverMt);
     AX_SAFE_DELETE(_btPhyiscsWorld);
     AX_SAFE_DELETE(_debugDrawer);
     for (auto&& it : _physicsComponents)
@@ -87,21 +187,44 @@ bool Physics3DWorld::init(Physics3DWorldDes* info)
     _collisionConfiguration = new btDefaultCollisionConfiguration();
     //_collisionConfiguration->setConvexConvexMultipointIterations();
 
-    /// use the default collision dispatcher. For parallel processing you can use a different dispatcher (see
-    /// Extras/BulletMultiThreaded)
-    _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
-
     _broadphase = new btDbvtBroadphase();
 
-    /// the default constraint solver. For parallel processing you can use a different solver (see
-    /// Extras/BulletMultiThreaded)
-    btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
-    _solver                                  = sol;
-
     btGhostPairCallback* ghostCallback = new btGhostPairCallback();
     _ghostCallback                     = ghostCallback;
 
-    _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+#        if BT_THREADSAFE
+    if (info->isMultithreaded)
+    {
+        const int numThreads = setupTaskScheduler();
+        if (numThreads > 1)
+        {
+            /// the islands are solved in parallel by a pool of solvers, the large islands by the multithreaded one
+            _dispatcher     = new btCollisionDispatcherMt(_collisionConfiguration);
+            auto solverPool = new btConstraintSolverPoolMt(numThreads);
+            _solver         = solverPool;
+            _solverMt       = new btSequentialImpulseConstraintSolverMt();
+            _btPhyiscsWorld =
+                new btDiscreteDynamicsWorldMt(_dispatcher, _broadphase, solverPool, _solverMt, _collisionConfiguration);
+            _multithreaded = true;
+        }
+        else
+            AXLOGW("Physics3DWorld: no JobSystem worker, the world is stepped on the axmol thread");
+    }
+#        else
+    if (info->isMultithreaded)
+        AXLOGW("Physics3DWorld: Bullet is built without BT_THREADSAFE, the world is stepped on the axmol thread");
+#        endif
+
+    if (!_btPhyiscsWorld)
+    {
+        /// use the default collision dispatcher
+        _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+
+        /// the default constraint solver
+        _solver = new btSequentialImpulseConstraintSolver();
+
+        _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    }
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(info->gravity));
     if (info->isDebugDrawEnabled)
     {
@@ -159,6 +282,7 @@ void Physics3DWorld::removePhysics3DObject(Physics3DObject* physicsObj)
         {
             _btPhyiscsWorld->removeCollisionObject(static_cast<Physics3DCollider*>(physicsObj)->getGhostObject());
         }
+        forgetContacts(physicsObj);
         physicsObj->release();
         _objects.erase(it);
         _collisionCheckingFlag         = true;
@@ -181,6 +305,7 @@ void Physics3DWorld::removeAllPhysics3DObjects()
         it->release();
     }
     _objects.clear();
+    _previousContacts.clear();
     _collisionCheckingFlag         = true;
     _needGhostPairCallbackChecking = true;
 }
@@ -260,13 +385,18 @@ void Physics3DWorld::stepSimulate(float dt)
 {
     if (_btPhyiscsWorld)
     {
+        using clock    = std::chrono::steady_clock;
+        auto stepStart = clock::now();
+
         setGhostPairCallback();
         // should sync kinematic node before simulation
         for (auto&& it : _physicsComponents)
         {
             it->preSimulate();
         }
-        _btPhyiscsWorld->stepSimulation(dt, 3);
+        auto simulationStart = clock::now();
+        _stepStats.subSteps  = _btPhyiscsWorld->stepSimulation(dt, 3);
+        auto simulationEnd   = clock::now();
         // sync dynamic node after simulation
         for (auto&& it : _physicsComponents)
         {
@@ -274,6 +404,16 @@ void Physics3DWorld::stepSimulate(float dt)
         }
         if (needCollisionChecking())
             collisionChecking();
+
+        using ms = std::chrono::duration<float, std::milli>;
+        _stepStats.simulationTime = ms(simulationEnd - simulationStart).count();
+        _stepStats.stepTime       = ms(clock::now() - stepStart).count();
+        _stepStats.averageSimulationTime =
+            _stepStats.steps == 0 ? _stepStats.simulationTime
+                                  : _stepStats.averageSimulationTime +
+                                        (_stepStats.simulationTime - _stepStats.averageSimulationTime) / 60.f;
+        _stepStats.maxSimulationTime = (std::max)(_stepStats.maxSimulationTime, _stepStats.simulationTime);
+        ++_stepStats.steps;
     }
 }
 
@@ -330,6 +470,9 @@ bool Physics3DWorld::sweepShape(Physics3DShape* shape,
 
 Physics3DObject* Physics3DWorld::getPhysicsObject(const btCollisionObject* btObj)
 {
+    // set by Physics3DRigidBody and Physics3DCollider
+    if (auto obj = static_cast<Physics3DObject*>(btObj->getUserPointer()))
+        return obj;
     for (auto&& it : _objects)
     {
         if (it->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
@@ -346,8 +489,28 @@ Physics3DObject* Physics3DWorld::getPhysicsObject(const btCollisionObject* btObj
     return nullptr;
 }
 
-void Physics3DWorld::collisionChecking()
+static bool lessContactPair(const Physics3DContact& a, const Physics3DContact& b)
+{
+    auto a0 = (std::min)(a.objA, a.objB), b0 = (std::min)(b.objA, b.objB);
+    if (a0 != b0)
+        return std::less<>{}(a0, b0);
+    return std::less<>{}((std::max)(a.objA, a.objB), (std::max)(b.objA, b.objB));
+}
+
+static bool sameContactPair(const Physics3DContact& a, const Physics3DContact& b)
 {
+    return (a.objA == b.objA && a.objB == b.objB) || (a.objA == b.objB && a.objB == b.objA);
+}
+
+void Physics3DWorld::gatherContacts()
+{
+    int listenerPhases = 0;
+    for (auto&& entry : _contactListeners)
+        listenerPhases |= entry.phases;
+    const bool listenerPoints = (listenerPhases & (CONTACT_BEGIN | CONTACT_PERSIST)) != 0;
+
+    _contacts.clear();
+    _contactPoints.clear();
     int numManifolds = _dispatcher->getNumManifolds();
     for (int i = 0; i < numManifolds; ++i)
     {
@@ -355,43 +518,153 @@ void Physics3DWorld::collisionChecking()
         int numContacts                       = contactManifold->getNumContacts();
         if (0 < numContacts)
         {
-            const btCollisionObject* obA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
-            const btCollisionObject* obB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-            Physics3DObject* poA         = getPhysicsObject(obA);
-            Physics3DObject* poB         = getPhysicsObject(obB);
-            if (poA->needCollisionCallback() || poB->needCollisionCallback())
+            Physics3DObject* poA = getPhysicsObject(static_cast<const btCollisionObject*>(contactManifold->getBody0()));
+            Physics3DObject* poB = getPhysicsObject(static_cast<const btCollisionObject*>(contactManifold->getBody1()));
+            if (!poA || !poB)
+                continue;
+            const bool callbacks = poA->needCollisionCallback() || poB->needCollisionCallback();
+            if (!callbacks && listenerPhases == 0)
+                continue;
+
+            Physics3DContact contact = {poA, poB, static_cast<uint32_t>(_contactPoints.size()), 0};
+            if (callbacks || listenerPoints)
             {
-                Physics3DCollisionInfo ci;
-                ci.objA = poA;
-                ci.objB = poB;
                 for (int c = 0; c < numContacts; ++c)
                 {
-                    btManifoldPoint& pt                       = contactManifold->getContactPoint(c);
-                    Physics3DCollisionInfo::CollisionPoint cp = {
-                        convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
-                        convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
-                        convertbtVector3ToVec3(pt.m_normalWorldOnB)};
-                    ci.collisionPointList.emplace_back(cp);
+                    btManifoldPoint& pt = contactManifold->getContactPoint(c);
+                    _contactPoints.push_back(
+                        {convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
+                         convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
+                         convertbtVector3ToVec3(pt.m_normalWorldOnB)});
                 }
+                contact.pointCount = static_cast<uint32_t>(numContacts);
+            }
+            _contacts.push_back(contact);
+        }
+    }
 
-                if (poA->needCollisionCallback())
-                {
-                    poA->getCollisionCallback()(ci);
-                }
-                if (poB->needCollisionCallback())
-                {
-                    poB->getCollisionCallback()(ci);
-                }
+    _beganContacts.clear();
+    _persistingContacts.clear();
+    _endedContacts.clear();
+    if (_contactListeners.empty())
+    {
+        _previousContacts.clear();
+        return;
+    }
+
+    // both sorted by pair, the previous contacts have a single one per pair
+    std::sort(_contacts.begin(), _contacts.end(), lessContactPair);
+    size_t p = 0;
+    for (auto&& contact : _contacts)
+    {
+        while (p < _previousContacts.size() && lessContactPair(_previousContacts[p], contact))
+            _endedContacts.push_back(_previousContacts[p++]);
+        if (p < _previousContacts.size() && sameContactPair(_previousContacts[p], contact))
+        {
+            ++p;
+            _persistingContacts.push_back(contact);
+        }
+        else if (p > 0 && sameContactPair(_previousContacts[p - 1], contact))
+            _persistingContacts.push_back(contact);  // another manifold of the pair
+        else
+            _beganContacts.push_back(contact);
+    }
+    while (p < _previousContacts.size())
+        _endedContacts.push_back(_previousContacts[p++]);
+    for (auto&& contact : _endedContacts)
+        contact.firstPoint = contact.pointCount = 0;
+
+    _previousContacts.assign(_contacts.begin(), _contacts.end());
+    _previousContacts.erase(std::unique(_previousContacts.begin(), _previousContacts.end(), sameContactPair),
+                            _previousContacts.end());
+}
+
+void Physics3DWorld::collisionChecking()
+{
+    gatherContacts();
+
+    _dispatchingContacts = true;
+    for (auto&& contact : _contacts)
+    {
+        auto poA = contact.objA;
+        auto poB = contact.objB;
+        if (poA->needCollisionCallback() || poB->needCollisionCallback())
+        {
+            _collisionInfo.objA = poA;
+            _collisionInfo.objB = poB;
+            auto points         = _contactPoints.data() + contact.firstPoint;
+            _collisionInfo.collisionPointList.assign(points, points + contact.pointCount);
+
+            if (poA->needCollisionCallback())
+            {
+                poA->getCollisionCallback()(_collisionInfo);
+            }
+            if (poB->needCollisionCallback())
+            {
+                poB->getCollisionCallback()(_collisionInfo);
             }
         }
     }
+
+    for (size_t i = 0; i < _contactListeners.size(); ++i)
+    {
+        auto& entry = _contactListeners[i];
+        if (!entry.listener)
+            continue;  // removed meanwhile
+        Physics3DContactBatch batch;
+        if (entry.phases & CONTACT_BEGIN)
+            batch.began = _beganContacts;
+        if (entry.phases & CONTACT_PERSIST)
+            batch.persisting = _persistingContacts;
+        if (entry.phases & CONTACT_END)
+            batch.ended = _endedContacts;
+        batch.points = _contactPoints;
+        // copied, the listener may add or remove listeners
+        auto listener = entry.listener;
+        listener(batch);
+    }
+    _dispatchingContacts = false;
+
+    _contactListeners.erase(std::remove_if(_contactListeners.begin(), _contactListeners.end(),
+                                           [](const ContactListenerEntry& entry) { return !entry.listener; }),
+                            _contactListeners.end());
+}
+
+int Physics3DWorld::addContactListener(ContactListener listener, int phases)
+{
+    int id = _nextContactListenerId++;
+    _contactListeners.push_back({std::move(listener), phases, id});
+    _collisionCheckingFlag = true;
+    return id;
+}
+
+void Physics3DWorld::removeContactListener(int id)
+{
+    auto it = std::find_if(_contactListeners.begin(), _contactListeners.end(),
+                           [id](const ContactListenerEntry& entry) { return entry.id == id; });
+    if (it == _contactListeners.end())
+        return;
+    if (_dispatchingContacts)
+        it->listener = nullptr;  // erased after the dispatch
+    else
+        _contactListeners.erase(it);
+    _collisionCheckingFlag = true;
+}
+
+void Physics3DWorld::forgetContacts(Physics3DObject* obj)
+{
+    _previousContacts.erase(std::remove_if(_previousContacts.begin(), _previousContacts.end(),
+                                           [obj](const Physics3DContact& contact) {
+                                               return contact.objA == obj || contact.objB == obj;
+                                           }),
+                            _previousContacts.end());
 }
 
 bool Physics3DWorld::needCollisionChecking()
 {
     if (_collisionCheckingFlag)
     {
-        _needCollisionChecking = false;
+        _needCollisionChecking = !_contactListeners.empty();
         for (auto&& it : _objects)
         {
             if (it->getCollisionCallback() != nullptr)
@@ -401,6 +674,8 @@ bool Physics3DWorld::needCollisionChecking()
             }
         }
         _collisionCheckingFlag = false;
+        if (!_needCollisionChecking)
+            _previousContacts.clear();
     }
     return _needCollisionChecking;
 }
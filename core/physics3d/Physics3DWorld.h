@@ -30,6 +30,9 @@
 #include "math/Math.h"
 #include "base/Object.h"
 #include "base/Config.h"
+#include "physics3d/Physics3DObject.h"
+
+#include <functional>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
@@ -39,7 +42,7 @@ class btDynamicsWorld;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 struct btDbvtBroadphase;
-class btSequentialImpulseConstraintSolver;
+class btConstraintSolver;
 class btGhostPairCallback;
 class btRigidBody;
 class btCollisionObject;
@@ -64,10 +67,12 @@ class Renderer;
 struct AX_DLL Physics3DWorldDes
 {
     bool isDebugDrawEnabled;  // using physics debug draw?, false by default
+    bool isMultithreaded;     // step the islands and the solver on the JobSystem workers?, false by default
     ax::Vec3 gravity;    // gravity, (0, -9.8, 0)
     Physics3DWorldDes()
     {
         isDebugDrawEnabled = false;
+        isMultithreaded    = false;
         gravity            = ax::Vec3(0.f, -9.8f, 0.f);
     }
 };
@@ -122,6 +127,47 @@ public:
     /** Simulate one frame. */
     void stepSimulate(float dt);
 
+    /**
+     * Whether the world is stepped by the Bullet multithreaded world, see Physics3DWorldDes::isMultithreaded.
+     * It is false when Bullet is built without BT_THREADSAFE, or when the JobSystem has no worker.
+     */
+    bool isMultithreaded() const { return _multithreaded; }
+
+    /** Times the steps of the world, in milliseconds, for profiling. */
+    struct StepStats
+    {
+        float simulationTime        = 0;  ///< Bullet stepSimulation of the last step
+        float stepTime              = 0;  ///< whole last step, with the sync of the components and the collisions
+        float averageSimulationTime = 0;  ///< moving average of simulationTime over about the last 60 steps
+        float maxSimulationTime     = 0;  ///< since the last reset
+        int subSteps                = 0;  ///< fixed sub steps simulated by the last step
+        uint32_t steps              = 0;  ///< since the last reset
+    };
+
+    const StepStats& getStepStats() const { return _stepStats; }
+    void resetStepStats() { _stepStats = {}; }
+
+    /** The phases of the contacts, combined in the mask of a contact listener. */
+    enum ContactPhase
+    {
+        CONTACT_BEGIN   = 1 << 0,
+        CONTACT_PERSIST = 1 << 1,
+        CONTACT_END     = 1 << 2,
+        CONTACT_ALL     = CONTACT_BEGIN | CONTACT_PERSIST | CONTACT_END,
+    };
+
+    using ContactListener = std::function<void(const Physics3DContactBatch& batch)>;
+
+    /**
+     * Adds a function called once per step with all the contacts of the world, the spans of the phases out of the
+     * mask are empty. The contacts are gathered in buffers reused from step to step, and the contact points are
+     * only gathered when a listener wants the beginning or persisting contacts.
+     *
+     * @return An id for removeContactListener.
+     */
+    int addContactListener(ContactListener listener, int phases = CONTACT_ALL);
+    void removeContactListener(int id);
+
     /** Enable or disable debug drawing. */
     void setDebugDrawEnable(bool enableDebugDraw);
 
@@ -162,19 +208,45 @@ public:
 protected:
     void removePhysics3DConstraintFromBullet(Physics3DConstraint* constraint);
 
+    /** Gathers the contacts of the step in the buffers, by phase. */
+    void gatherContacts();
+    /** Drops an object from the contacts of the previous step, it doesn't get an ended contact. */
+    void forgetContacts(Physics3DObject* obj);
+
+    struct ContactListenerEntry
+    {
+        ContactListener listener;
+        int phases;
+        int id;
+    };
+
     std::vector<Physics3DObject*> _objects;
     std::vector<Physics3DConstraint*> _constraints;
     std::vector<Physics3DComponent*> _physicsComponents;  // physics3d components
     bool _needCollisionChecking;
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
+    bool _multithreaded;
+    StepStats _stepStats;
+
+    std::vector<ContactListenerEntry> _contactListeners;
+    int _nextContactListenerId = 1;
+    bool _dispatchingContacts  = false;
+    std::vector<Physics3DContact> _contacts;          // touching at this step, sorted by pair
+    std::vector<Physics3DContact> _previousContacts;  // a contact per pair, sorted by pair
+    std::vector<Physics3DContact> _beganContacts;
+    std::vector<Physics3DContact> _persistingContacts;
+    std::vector<Physics3DContact> _endedContacts;
+    std::vector<Physics3DCollisionInfo::CollisionPoint> _contactPoints;
+    Physics3DCollisionInfo _collisionInfo;  // reused for the collision callbacks of the objects
 
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     btDynamicsWorld* _btPhyiscsWorld;
     btDefaultCollisionConfiguration* _collisionConfiguration;
     btCollisionDispatcher* _dispatcher;
     btDbvtBroadphase* _broadphase;
-    btSequentialImpulseConstraintSolver* _solver;
+    btConstraintSolver* _solver;    // a solver pool when multithreaded
+    btConstraintSolver* _solverMt;  // the multithreaded solver of the large islands
     btGhostPairCallback* _ghostCallback;
     Physics3DDebugDrawer* _debugDrawer;
 #        endif  // AX_ENABLE_BULLET_INTEGRATION
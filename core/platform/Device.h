@@ -79,6 +79,15 @@ public:
         NotificationFeedbackTypeError
     };
 
+    /** Defines the thermal state of the device, as reported by the OS. */
+    enum class ThermalState
+    {
+        NOMINAL,  /** No throttling. */
+        FAIR,     /** Slightly elevated, light throttling may start. */
+        SERIOUS,  /** The performance is reduced by the OS. */
+        CRITICAL, /** The performance is heavily reduced, the device needs to cool down. */
+    };
+
     /**
      *  Gets the DPI of device
      *  @return The DPI of device.
@@ -156,6 +165,43 @@ public:
      */
     static void selectionChanged();
 
+    /**
+     * Gets the thermal state of the device.
+     * Supported on Android 10+, iOS and macOS, NOMINAL on the other platforms.
+     */
+    static ThermalState getThermalState();
+
+    /**
+     * Gets the forecast of the thermal headroom, 1.0 is where the device is heavily throttled.
+     * Supported on Android 11+ only.
+     * @param forecastSeconds How many seconds in the future to forecast, between 0 and 60.
+     * @return The headroom or a negative value if it isn't supported.
+     */
+    static float getThermalHeadroom(int forecastSeconds);
+
+    /**
+     * Gets the battery level from 0 to 1.
+     * @return The level or a negative value if the device has no battery or the platform doesn't report it.
+     */
+    static float getBatteryLevel();
+
+    /** Whether the user enabled the power save (low power) mode of the device. */
+    static bool isPowerSaveMode();
+
+    /**
+     * Sets the target duration of the work of a frame for the performance hints of the OS, it creates the hint
+     * session for the calling thread on first use.
+     * Supported on Android 12+ (ADPF), invoking it has no effect on the other platforms.
+     * @param nanoseconds The target duration, typically the animation interval.
+     */
+    static void setTargetWorkDuration(int64_t nanoseconds);
+
+    /**
+     * Reports the actual duration of the work of a frame, see setTargetWorkDuration.
+     * @param nanoseconds The duration of the work, without the wait for the vsync.
+     */
+    static void reportActualWorkDuration(int64_t nanoseconds);
+
     /**
      * Gets texture data for text.
      */
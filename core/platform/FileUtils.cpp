@@ -30,12 +30,18 @@ THE SOFTWARE.
 #include <stack>
 #include <sstream>
 #include <algorithm>
+#include <bit>
+#include <climits>
 
 #include "base/Data.h"
 #include "base/Macros.h"
 #include "base/Director.h"
+#include "base/UTF8.h"
+#include "base/ZipUtils.h"
 #include "platform/SAXParser.h"
 #include "platform/FileStream.h"
+#include "platform/PackArchive.h"
+#include "mio/mio.hpp"
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -135,6 +141,31 @@ public:
         return _rootDict;
     }
 
+    // parses in place, the data are modified
+    ValueMap dictionaryWithData(Data& data)
+    {
+        _resultType = SAX_RESULT_DICT;
+        SAXParser parser;
+
+        AXASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
+        parser.setDelegator(this);
+
+        parser.parseIntrusive((char*)data.getBytes(), data.getSize());
+        return _rootDict;
+    }
+
+    ValueVector arrayWithData(Data& data)
+    {
+        _resultType = SAX_RESULT_ARRAY;
+        SAXParser parser;
+
+        AXASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
+        parser.setDelegator(this);
+
+        parser.parseIntrusive((char*)data.getBytes(), data.getSize());
+        return _rootArray;
+    }
+
     ValueVector arrayWithContentsOfFile(std::string_view fileName)
     {
         _resultType = SAX_RESULT_ARRAY;
@@ -340,15 +371,267 @@ public:
     }
 };
 
+/*
+ * Reads the binary property lists, "bplist00", written by Xcode and plutil.
+ * The objects are read straight from their table into Values, there is no text to parse, and the counts of the
+ * arrays and dictionaries are known before reading them. The integers are ints when they fit, the reals, dates and
+ * data are read like the XML reader does, as doubles and strings.
+ */
+class BinaryPlistReader
+{
+public:
+    static constexpr size_t TRAILER_SIZE = 32;
+    static constexpr int MAX_DEPTH       = 256;
+
+    static bool isBinaryPlist(const void* data, size_t size)
+    {
+        return data && size >= 8 + TRAILER_SIZE && memcmp(data, "bplist00", 8) == 0;
+    }
+
+    BinaryPlistReader(const void* data, size_t size) : _data(static_cast<const uint8_t*>(data)), _size(size) {}
+
+    bool readRoot(Value& root)
+    {
+        if (!isBinaryPlist(_data, _size))
+            return false;
+
+        auto trailer     = _data + _size - TRAILER_SIZE;
+        _offsetIntSize   = trailer[6];
+        _objectRefSize   = trailer[7];
+        _objectCount     = readUInt(trailer + 8, 8);
+        auto topObject   = readUInt(trailer + 16, 8);
+        _offsetTable     = readUInt(trailer + 24, 8);
+        if (_offsetIntSize == 0 || _offsetIntSize > 8 || _objectRefSize == 0 || _objectRefSize > 8 ||
+            _offsetTable > _size - TRAILER_SIZE ||
+            _objectCount > (_size - TRAILER_SIZE - _offsetTable) / _offsetIntSize)
+            return false;
+
+        return readObject(topObject, root, 0);
+    }
+
+private:
+    static uint64_t readUInt(const uint8_t* p, size_t size)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < size; ++i)
+            value = (value << 8) | p[i];
+        return value;
+    }
+
+    // the objects lie between the header and the offset table
+    bool objectOffset(uint64_t ref, uint64_t& offset) const
+    {
+        if (ref >= _objectCount)
+            return false;
+        offset = readUInt(_data + _offsetTable + ref * _offsetIntSize, _offsetIntSize);
+        return offset >= 8 && offset < _offsetTable;
+    }
+
+    bool fits(uint64_t offset, uint64_t count, uint64_t size) const
+    {
+        return offset <= _offsetTable && count <= (_offsetTable - offset) / size;
+    }
+
+    // the count of a data, string or collection is in the low nibble, or in an int object following the marker
+    bool readCount(uint64_t& offset, uint64_t& count) const
+    {
+        count = _data[offset++] & 0x0F;
+        if (count != 0x0F)
+            return true;
+
+        if (offset >= _offsetTable || (_data[offset] >> 4) != 0x1)
+            return false;
+        const size_t size = size_t{1} << (_data[offset] & 0x0F);
+        if (size > 8 || !fits(offset + 1, size, 1))
+            return false;
+        count = readUInt(_data + offset + 1, size);
+        offset += 1 + size;
+        return true;
+    }
+
+    bool readString(uint64_t ref, std::string& str) const
+    {
+        uint64_t offset, count;
+        if (!objectOffset(ref, offset))
+            return false;
+
+        const auto type = _data[offset] >> 4;
+        if ((type != 0x5 && type != 0x6 && type != 0x4) || !readCount(offset, count))
+            return false;
+
+        if (type != 0x6)
+        {  // ascii or data
+            if (!fits(offset, count, 1))
+                return false;
+            str.assign(reinterpret_cast<const char*>(_data + offset), count);
+            return true;
+        }
+
+        // UTF-16 big endian
+        if (!fits(offset, count, 2))
+            return false;
+        std::u16string utf16(count, u'\0');
+        for (uint64_t i = 0; i < count; ++i)
+            utf16[i] = static_cast<char16_t>(readUInt(_data + offset + i * 2, 2));
+        return StringUtils::UTF16ToUTF8(utf16, str);
+    }
+
+    bool readObject(uint64_t ref, Value& value, int depth) const
+    {
+        uint64_t offset, count;
+        if (depth > MAX_DEPTH || !objectOffset(ref, offset))
+            return false;
+
+        const uint8_t marker = _data[offset];
+        switch (marker >> 4)
+        {
+        case 0x0:  // null, false, true or fill
+            value = marker == 0x08 || marker == 0x09 ? Value(marker == 0x09) : Value::Null;
+            return true;
+        case 0x1:
+        {
+            // the 16 bytes integers are the unsigned ones above INT64_MAX, their low 8 bytes hold them
+            size_t size = size_t{1} << (marker & 0x0F);
+            if (size > 16 || !fits(offset + 1, size, 1))
+                return false;
+            if (size == 16)
+            {
+                value = Value(readUInt(_data + offset + 9, 8));
+                return true;
+            }
+            // the 8 bytes integers are signed, the smaller ones unsigned
+            auto integer = static_cast<int64_t>(readUInt(_data + offset + 1, size));
+            value = integer >= INT_MIN && integer <= INT_MAX ? Value(static_cast<int>(integer)) : Value(integer);
+            return true;
+        }
+        case 0x2:
+        case 0x3:  // real, or date as the seconds since 2001
+        {
+            size_t size = size_t{1} << (marker & 0x0F);
+            if ((size != 4 && size != 8) || !fits(offset + 1, size, 1))
+                return false;
+            auto bits = readUInt(_data + offset + 1, size);
+            if (size == 4)
+                value = Value(static_cast<double>(std::bit_cast<float>(static_cast<uint32_t>(bits))));
+            else
+                value = Value(std::bit_cast<double>(bits));
+            return true;
+        }
+        case 0x4:
+        case 0x5:
+        case 0x6:
+        {
+            std::string str;
+            if (!readString(ref, str))
+                return false;
+            value = Value(std::move(str));
+            return true;
+        }
+        case 0x8:  // uid
+        {
+            size_t size = (marker & 0x0F) + 1;
+            if (size > 8 || !fits(offset + 1, size, 1))
+                return false;
+            value = Value(static_cast<int>(readUInt(_data + offset + 1, size)));
+            return true;
+        }
+        case 0xA:
+        case 0xC:  // array or set
+        {
+            if (!readCount(offset, count) || !fits(offset, count, _objectRefSize))
+                return false;
+            ValueVector array;
+            array.reserve(count);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                if (!readObject(readUInt(_data + offset + i * _objectRefSize, _objectRefSize), array.emplace_back(),
+                                depth + 1))
+                    return false;
+            }
+            value = Value(std::move(array));
+            return true;
+        }
+        case 0xD:
+        {
+            // the refs of the keys, then of the values
+            if (!readCount(offset, count) || count > SIZE_MAX / 2 || !fits(offset, count * 2, _objectRefSize))
+                return false;
+            ValueMap dict;
+            dict.reserve(count);
+            std::string key;
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                auto keyRef   = readUInt(_data + offset + i * _objectRefSize, _objectRefSize);
+                auto valueRef = readUInt(_data + offset + (count + i) * _objectRefSize, _objectRefSize);
+                if (!readString(keyRef, key) || !readObject(valueRef, dict[key], depth + 1))
+                    return false;
+            }
+            value = Value(std::move(dict));
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    const uint8_t* _data;
+    size_t _size;
+    uint64_t _offsetTable   = 0;
+    uint64_t _objectCount   = 0;
+    uint8_t _offsetIntSize  = 0;
+    uint8_t _objectRefSize  = 0;
+};
+
+// reads a plist file, inflated when it's compressed in the CCZ format
+static Data readPlistFile(const FileUtils* fileUtils, std::string_view fullPath)
+{
+    Data data = fileUtils->getDataFromFile(fullPath);
+    if (ZipUtils::isCCZBuffer(data.getBytes(), data.getSize()))
+    {
+        uint8_t* inflated = nullptr;
+        auto len          = ZipUtils::inflateCCZBuffer(data.getBytes(), data.getSize(), &inflated);
+        Data inflatedData;
+        if (len > 0)
+            inflatedData.fastSet(inflated, len);
+        data = std::move(inflatedData);
+    }
+    return data;
+}
+
 ValueMap FileUtils::getValueMapFromFile(std::string_view filename) const
 {
     const std::string fullPath = fullPathForFilename(filename);
+    Data data                  = readPlistFile(this, fullPath);
+    if (data.isNull())
+        return ValueMap{};
+
+    if (BinaryPlistReader::isBinaryPlist(data.getBytes(), data.getSize()))
+    {
+        Value root;
+        BinaryPlistReader reader(data.getBytes(), data.getSize());
+        if (!reader.readRoot(root) || root.getType() != Value::Type::MAP)
+        {
+            AXLOGW("FileUtils: invalid binary plist {}", fullPath);
+            return ValueMap{};
+        }
+        return std::move(root.asValueMap());
+    }
+
     DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath);
+    return tMaker.dictionaryWithData(data);
 }
 
 ValueMap FileUtils::getValueMapFromData(const char* filedata, int filesize) const
 {
+    if (BinaryPlistReader::isBinaryPlist(filedata, filesize))
+    {
+        Value root;
+        BinaryPlistReader reader(filedata, filesize);
+        if (reader.readRoot(root) && root.getType() == Value::Type::MAP)
+            return std::move(root.asValueMap());
+        return ValueMap{};
+    }
+
     DictMaker tMaker;
     return tMaker.dictionaryWithDataOfFile(filedata, filesize);
 }
@@ -356,8 +639,24 @@ ValueMap FileUtils::getValueMapFromData(const char* filedata, int filesize) cons
 ValueVector FileUtils::getValueVectorFromFile(std::string_view filename) const
 {
     const std::string fullPath = fullPathForFilename(filename);
+    Data data                  = readPlistFile(this, fullPath);
+    if (data.isNull())
+        return ValueVector{};
+
+    if (BinaryPlistReader::isBinaryPlist(data.getBytes(), data.getSize()))
+    {
+        Value root;
+        BinaryPlistReader reader(data.getBytes(), data.getSize());
+        if (!reader.readRoot(root) || root.getType() != Value::Type::VECTOR)
+        {
+            AXLOGW("FileUtils: invalid binary plist {}", fullPath);
+            return ValueVector{};
+        }
+        return std::move(root.asValueVector());
+    }
+
     DictMaker tMaker;
-    return tMaker.arrayWithContentsOfFile(fullPath);
+    return tMaker.arrayWithData(data);
 }
 
 /*
@@ -566,6 +865,139 @@ Data FileUtils::getDataFromFile(std::string_view filename) const
     getContents(filename, &d);
     return d;
 }
+
+FileView FileUtils::getMappedContents(std::string_view filename) const
+{
+    if (filename.empty())
+        return {};
+
+    const auto fullPath = fullPathForFilename(filename);
+    if (fullPath.empty())
+        return {};
+
+    std::string_view entryPath;
+    if (auto mounted = findMountedArchive(fullPath, entryPath))
+    {
+        auto entry = mounted->archive->find(entryPath);
+        if (!entry)
+            return {};
+        if (entry->compression == PackArchive::Compression::NONE)
+            return FileView{mounted->archive, mounted->archive->getStoredData(*entry),
+                            static_cast<size_t>(entry->size), true};
+    }
+    else
+    {
+        auto mapping = std::make_shared<mio::mmap_source>();
+        std::error_code error;
+        mapping->map(fullPath, error);
+        if (!error && mapping->size() > 0)
+        {
+            auto bytes = reinterpret_cast<const uint8_t*>(mapping->data());
+            auto size  = mapping->size();
+            return FileView{std::move(mapping), bytes, size, true};
+        }
+    }
+
+    // compressed, empty or not a regular file, e.g. in the apk
+    auto data = std::make_shared<Data>(getDataFromFile(fullPath));
+    if (data->isNull())
+        return {};
+    auto bytes = data->getBytes();
+    auto size  = static_cast<size_t>(data->getSize());
+    return FileView{std::move(data), bytes, size, false};
+}
+
+void FileUtils::readAsync(std::vector<std::string> filenames,
+                          std::function<void(std::vector<Data>)> callback,
+                          JobPriority priority) const
+{
+    struct ArchiveReads
+    {
+        std::shared_ptr<PackArchive> archive;
+        std::vector<std::pair<const PackArchive::Entry*, size_t>> entries;
+    };
+    struct Batch
+    {
+        std::vector<Data> results;
+        std::vector<ArchiveReads> archives;
+        std::vector<std::pair<std::string, size_t>> files;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->results.resize(filenames.size());
+    for (size_t index = 0; index < filenames.size(); ++index)
+    {
+        auto fullPath = fullPathForFilename(filenames[index]);
+        if (fullPath.empty())
+            continue;
+
+        std::string_view entryPath;
+        auto mounted = findMountedArchive(fullPath, entryPath);
+        if (!mounted)
+        {
+            batch->files.emplace_back(std::move(fullPath), index);
+            continue;
+        }
+
+        auto entry = mounted->archive->find(entryPath);
+        if (!entry)
+            continue;
+        auto it = std::find_if(batch->archives.begin(), batch->archives.end(),
+                               [mounted](const ArchiveReads& reads) { return reads.archive == mounted->archive; });
+        if (it == batch->archives.end())
+            it = batch->archives.insert(batch->archives.end(), ArchiveReads{mounted->archive, {}});
+        it->entries.emplace_back(entry, index);
+    }
+
+    auto readArchive = [batch](ArchiveReads& reads) {
+        // in the order they are stored, the neighbours are prefetched as one range
+        auto& entries = reads.entries;
+        std::sort(entries.begin(), entries.end(), [](auto& a, auto& b) { return a.first->offset < b.first->offset; });
+        for (size_t begin = 0, end = 0; begin < entries.size(); begin = end)
+        {
+            auto rangeEnd = entries[begin].first->offset + entries[begin].first->storedSize;
+            for (end = begin + 1; end < entries.size() && entries[end].first->offset <= rangeEnd + PackArchive::ALIGNMENT;
+                 ++end)
+                rangeEnd = (std::max)(rangeEnd, entries[end].first->offset + entries[end].first->storedSize);
+            reads.archive->prefetch(entries[begin].first->offset, rangeEnd - entries[begin].first->offset);
+        }
+        for (auto&& [entry, index] : entries)
+        {
+            ResizableBufferAdapter<Data> buffer(&batch->results[index]);
+            if (!reads.archive->read(*entry, &buffer))
+                batch->results[index].clear();
+        }
+    };
+
+    auto done = [batch, callback = std::move(callback)] { callback(std::move(batch->results)); };
+
+    const auto jobCount = batch->archives.size() + batch->files.size();
+    if (jobCount == 0)
+    {
+        Director::getInstance()->getScheduler()->runOnAxmolThread(std::move(done));
+        return;
+    }
+
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    jobSystem
+        ->parallelFor(
+            jobCount, 1,
+            [batch, readArchive](size_t begin, size_t end) {
+                for (auto job = begin; job < end; ++job)
+                {
+                    if (job < batch->archives.size())
+                        readArchive(batch->archives[job]);
+                    else
+                    {
+                        auto& [fullPath, index] = batch->files[job - batch->archives.size()];
+                        FileUtils::getInstance()->getContents(fullPath, &batch->results[index]);
+                    }
+                }
+            },
+            priority)
+        .thenOnAxmolThread(std::move(done));
+}
+
 #ifndef AX_CORE_PROFILE
 void FileUtils::getDataFromFile(std::string_view filename, std::function<void(Data)> callback) const
 {
@@ -584,6 +1016,15 @@ FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuf
 
     const auto fullPath = fileUtils->fullPathForFilename(filename);
 
+    std::string_view entryPath;
+    if (auto mounted = fileUtils->findMountedArchive(fullPath, entryPath))
+    {
+        auto entry = mounted->archive->find(entryPath);
+        if (!entry)
+            return Status::NotExists;
+        return mounted->archive->read(*entry, buffer) ? Status::OK : Status::ReadFailed;
+    }
+
     FileStream fileStream;
     fileStream.open(fullPath, IFileStream::Mode::READ);
     if (!fileStream)
@@ -664,29 +1105,27 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
         return "";
     }
 
-    /*
-     * As we know, this function 'fullPathForFilename' will be calling when load any file, how to ensure this thread
-     * safe Step: a. call this function at main-thread always b. use the really fullPath to call
-     * getStringFromFile/getDataFromFile at sub-thread c. then this function will call again with really fullPath d.
-     * then isAbsolutePath avoid to access _fullPathCache _fullPathCache concurrent
-     */
     if (isAbsolutePath(filename))
     {
         return std::string{filename};
     }
 
-    // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end())
+    // Already Cached ? The cache is locked, the search paths and the archives are changed on the axmol thread only
+    std::string fullpath;
+    if (_fullPathCache.find(filename, fullpath))
     {
-        return cacheIter->second;
+        return fullpath;
     }
 
-    std::string fullpath;
-
-    for (const auto& searchIt : _searchPathArray)
+    for (size_t index = 0; index <= _searchPathArray.size(); ++index)
     {
-        fullpath = this->getPathForFilename(filename, searchIt);
+        if (_mountedArchives.empty() || !findInArchives(filename, index, fullpath))
+        {
+            if (index == _searchPathArray.size())
+                break;
+            if (!findInManifest(filename, _searchPathArray[index], fullpath))
+                fullpath = this->getPathForFilename(filename, _searchPathArray[index]);
+        }
 
         if (!fullpath.empty())
         {
@@ -705,6 +1144,129 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
     return std::string{};
 }
 
+bool FileUtils::mountArchive(std::string_view archivePath, int position)
+{
+    auto fullPath = fullPathForFilename(archivePath);
+    if (fullPath.empty())
+        return false;
+
+    auto archive = std::make_shared<PackArchive>();
+    if (!archive->open(fullPath))
+        return false;
+
+    unmountArchive(fullPath);
+    _mountedArchives.emplace_back(MountedArchive{std::move(archive), fullPath.append("/"), position});
+    _fullPathCache.clear();
+    return true;
+}
+
+bool FileUtils::loadPathManifest(std::string_view manifestPath)
+{
+    auto content = getStringFromFile(manifestPath);
+    if (content.empty())
+        return false;
+
+    _pathManifest.clear();
+    std::string_view lines{content};
+    while (!lines.empty())
+    {
+        auto end  = lines.find('\n');
+        auto line = lines.substr(0, end);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            _pathManifest.emplace(line);
+        lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+    }
+    _fullPathCache.clear();
+    return !_pathManifest.empty();
+}
+
+void FileUtils::unloadPathManifest()
+{
+    _pathManifest.clear();
+    _fullPathCache.clear();
+}
+
+bool FileUtils::writePathManifest(std::string_view dirPath, std::string_view manifestPath) const
+{
+    auto root = fullPathForDirectory(dirPath);
+    if (root.empty())
+        return false;
+
+    std::vector<std::string> files;
+    listFilesRecursively(root, &files);
+    std::sort(files.begin(), files.end());
+
+    std::string manifest;
+    for (auto& file : files)
+    {
+        if (file.back() != '/' && file.starts_with(root))
+            manifest.append(file, root.size()).push_back('\n');
+    }
+    return writeStringToFile(manifest, manifestPath);
+}
+
+bool FileUtils::findInManifest(std::string_view filename, std::string_view searchPath, std::string& fullPath) const
+{
+    // the relative names are probed, like ../file or ./file
+    if (_pathManifest.empty() || !searchPath.starts_with(_defaultResRootPath) ||
+        filename.find("./") != std::string_view::npos)
+        return false;
+
+    std::string path{searchPath.substr(_defaultResRootPath.size())};
+    path += filename;
+    if (_pathManifest.find(path) != _pathManifest.end())
+        fullPath.assign(_defaultResRootPath).append(path);
+    else
+        fullPath.clear();
+    return true;
+}
+
+bool FileUtils::unmountArchive(std::string_view archivePath)
+{
+    auto root = fullPathForFilename(archivePath).append("/");
+    auto it   = std::find_if(_mountedArchives.begin(), _mountedArchives.end(),
+                             [&root](const MountedArchive& mounted) { return mounted.root == root; });
+    if (it == _mountedArchives.end())
+        return false;
+
+    _mountedArchives.erase(it);
+    _fullPathCache.clear();
+    return true;
+}
+
+const FileUtils::MountedArchive* FileUtils::findMountedArchive(std::string_view fullPath,
+                                                               std::string_view& entryPath) const
+{
+    for (auto&& mounted : _mountedArchives)
+    {
+        if (fullPath.starts_with(mounted.root))
+        {
+            entryPath = fullPath.substr(mounted.root.size());
+            return &mounted;
+        }
+    }
+    return nullptr;
+}
+
+bool FileUtils::findInArchives(std::string_view filename, size_t position, std::string& fullPath) const
+{
+    // the last mounted archive first
+    const auto last = _searchPathArray.size();
+    for (auto it = _mountedArchives.rbegin(); it != _mountedArchives.rend(); ++it)
+    {
+        auto mountedPosition = it->position < 0 ? last : (std::min)(static_cast<size_t>(it->position), last);
+        if (mountedPosition == position && it->archive->find(filename))
+        {
+            fullPath = it->root;
+            fullPath += filename;
+            return true;
+        }
+    }
+    return false;
+}
+
 std::string FileUtils::fullPathForDirectory(std::string_view dir) const
 {
     auto result = std::string();
@@ -720,12 +1282,7 @@ std::string FileUtils::fullPathForDirectory(std::string_view dir) const
     else
     {
         // Already Cached ?
-        auto cacheIter = _fullPathCacheDir.find(dir);
-        if (cacheIter != _fullPathCacheDir.end())
-        {
-            result = cacheIter->second;
-        }
-        else
+        if (!_fullPathCacheDir.find(dir, result))
         {
             std::string longdir{dir};
 
@@ -899,6 +1456,9 @@ bool FileUtils::isFileExist(std::string_view filename) const
 {
     if (isAbsolutePath(filename))
     {
+        std::string_view entryPath;
+        if (auto mounted = findMountedArchive(filename, entryPath))
+            return mounted->archive->find(entryPath) != nullptr;
         return isFileExistInternal(filename);
     }
     else
@@ -1037,6 +1597,13 @@ void FileUtils::listFilesRecursivelyAsync(std::string_view dirPath,
 
 std::unique_ptr<IFileStream> FileUtils::openFileStream(std::string_view filePath, IFileStream::Mode mode) const
 {
+    std::string_view entryPath;
+    if (auto mounted = findMountedArchive(filePath, entryPath))
+    {
+        auto entry = mounted->archive->find(entryPath);
+        return entry && mode == IFileStream::Mode::READ ? PackArchive::openStream(mounted->archive, *entry) : nullptr;
+    }
+
     FileStream fs;
     return fs.open(filePath, mode) ? std::make_unique<FileStream>(std::move(fs)) : nullptr;
 }
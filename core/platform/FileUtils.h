@@ -35,6 +35,8 @@ THE SOFTWARE.
 #include <memory>
 
 #include "platform/IFileStream.h"
+#include "platform/FileView.h"
+#include "platform/PathCache.h"
 #include "platform/PlatformMacros.h"
 #include "base/Types.h"
 #include "base/Value.h"
@@ -48,6 +50,8 @@ THE SOFTWARE.
 namespace ax
 {
 
+class PackArchive;
+
 /**
  * @addtogroup platform
  * @{
@@ -150,6 +154,23 @@ public:
      */
     virtual Data getDataFromFile(std::string_view filename) const;
 
+    /**
+     *  Gets a read only view of a file without copying it when possible, it's mapped for a regular file or an
+     *  uncompressed file of a mounted archive. Meant for the files parsed once and dropped, or kept as they are.
+     *  @return A null view if the file can't be read.
+     */
+    virtual FileView getMappedContents(std::string_view filename) const;
+
+    /**
+     *  Reads files on the JobSystem workers, then calls back on the axmol thread with their data in the order of
+     *  the names, null for the files which can't be read. The names are resolved by the caller, on the axmol thread.
+     *  The files of a mounted archive are read by one job in the order they are stored, the other files by a job
+     *  each, so the reads overlap.
+     */
+    void readAsync(std::vector<std::string> filenames,
+                   std::function<void(std::vector<Data>)> callback,
+                   JobPriority priority = JobPriority::Low) const;
+
     enum class Status
     {
         OK                 = 0,
@@ -348,6 +369,38 @@ public:
      */
     virtual const std::vector<std::string>& getOriginalSearchPaths() const;
 
+    /**
+     *  Mounts a packed archive created by PackArchive::pack. Its files are found by fullPathForFilename as
+     *  "<full path of the archive>/<path in the archive>", and read from the archive by getContents and
+     *  openFileStream. The archives mounted last are looked up first.
+     *
+     *  @param archivePath The path of the .axpak file, it could be a relative or an absolute path.
+     *  @param position The index of the search path the archive is looked up before, -1 to look it up after all
+     *         of them.
+     *  @return Returns false if the file isn't a valid archive.
+     *  @note Mount the archives on the axmol thread before loading their files, the lookups aren't locked.
+     */
+    bool mountArchive(std::string_view archivePath, int position = 0);
+    bool unmountArchive(std::string_view archivePath);
+
+    /**
+     *  Loads a manifest of the files under the default resource root path, a text file with a path relative to the
+     *  root per line. While a manifest is loaded, fullPathForFilename looks the files under the root up in it
+     *  instead of probing the file system, so the manifest must list every file, write it with writePathManifest
+     *  when packaging. It's meant to be loaded at startup in release builds.
+     *
+     *  @return Returns false if the manifest can't be read.
+     */
+    bool loadPathManifest(std::string_view manifestPath);
+
+    /** Drops the manifest, the files are looked up on the file system again. */
+    void unloadPathManifest();
+
+    bool isPathManifestLoaded() const { return !_pathManifest.empty(); }
+
+    /** Writes a manifest of the files under a directory, see loadPathManifest. */
+    bool writePathManifest(std::string_view dirPath, std::string_view manifestPath) const;
+
     /**
      *  Gets the writable path that may not be in the format of an absolute path
      *  @return  The path that can be write/read a file in
@@ -767,10 +820,10 @@ public:
                                            std::function<void(std::vector<std::string>)> callback) const;
 #endif
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache; }
+    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
 
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir; }
+    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir.snapshot(); }
 
     /**
      *  Checks whether a file exists without considering search paths and resolution orders.
@@ -836,6 +889,22 @@ protected:
     virtual std::string getFullPathForFilenameWithinDirectory(std::string_view directory,
                                                               std::string_view filename) const;
 
+    struct MountedArchive
+    {
+        std::shared_ptr<PackArchive> archive;
+        std::string root;  // the full path of the archive with a trailing '/'
+        int position;
+    };
+
+    /** Finds the mounted archive of a full path, and the path in the archive. */
+    const MountedArchive* findMountedArchive(std::string_view fullPath, std::string_view& entryPath) const;
+
+    /** Finds a file in the archives mounted before a search path. */
+    bool findInArchives(std::string_view filename, size_t position, std::string& fullPath) const;
+
+    /** Finds a file under a search path in the manifest, returns false when the manifest doesn't cover the path. */
+    bool findInManifest(std::string_view filename, std::string_view searchPath, std::string& fullPath) const;
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
@@ -858,15 +927,25 @@ protected:
 
     /**
      *  The full path cache for normal files. When a file is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  This variable is used for improving the performance of file search, it's safe to use on any thread.
      */
-    mutable hlookup::string_map<std::string> _fullPathCache;
+    mutable PathCache _fullPathCache;
 
     /**
      *  The full path cache for directories. When a diretory is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
      */
-    mutable hlookup::string_map<std::string> _fullPathCacheDir;
+    mutable PathCache _fullPathCacheDir;
+
+    /**
+     * The files under the default resource root path, see loadPathManifest.
+     */
+    hlookup::string_set _pathManifest;
+
+    /**
+     * The mounted archives, see mountArchive.
+     */
+    std::vector<MountedArchive> _mountedArchives;
 
     /**
      * Writable path.
@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * A read only view of the content of a file, see FileUtils::getMappedContents.
+ * The bytes of a regular file or of an uncompressed file in a mounted archive are mapped, the others are read in a
+ * buffer owned by the view. The copies of a view share its bytes, they live as long as one of the copies.
+ */
+class AX_DLL FileView
+{
+public:
+    FileView() = default;
+    FileView(std::shared_ptr<const void> owner, const uint8_t* data, size_t size, bool mapped)
+        : _owner(std::move(owner)), _data(data), _size(size), _mapped(mapped)
+    {}
+
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+    std::string_view view() const { return std::string_view{reinterpret_cast<const char*>(_data), _size}; }
+
+    bool isNull() const { return _data == nullptr; }
+    /** Whether the bytes are mapped rather than read in a buffer. */
+    bool isMapped() const { return _mapped; }
+
+    explicit operator bool() const { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const void> _owner;
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+    bool _mapped         = false;
+};
+
+// end of platform group
+/** @} */
+
+}  // namespace ax
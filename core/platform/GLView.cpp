@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "renderer/Renderer.h"
+#include <algorithm>
 
 namespace ax
 {
@@ -122,6 +123,18 @@ GLView::~GLView() {}
 
 void GLView::pollEvents() {}
 
+void GLView::dispatchCoalescedEvents()
+{
+    dispatchTouchMoves();
+}
+
+void GLView::setInputCoalescing(bool enabled)
+{
+    if (!enabled)
+        dispatchCoalescedEvents();
+    _inputCoalescing = enabled;
+}
+
 void GLView::updateDesignResolutionSize()
 {
     if (_screenSize.width > 0 && _screenSize.height > 0 && _designResolutionSize.width > 0 &&
@@ -300,6 +313,8 @@ void GLView::handleTouchesBegin(int num, intptr_t ids[], float xs[], float ys[])
     int unusedIndex = 0;
     EventTouch touchEvent;
 
+    dispatchTouchMoves();
+
     for (int i = 0; i < num; ++i)
     {
         id = ids[i];
@@ -372,7 +387,12 @@ void GLView::handleTouchesMove(int num, intptr_t ids[], float xs[], float ys[],
 
         AXLOGV("Moving touches with id: {}, x={}, y={}, force={}, maxFource={}", (int)id, x, y, force, maxForce);
         Touch* touch = g_touches[iter->second];
-        if (touch)
+        if (touch && _inputCoalescing)
+        {
+            // dispatched once per frame, see dispatchTouchMoves
+            _touchMoves.push_back({iter->second, Vec2(transformInputX(x), transformInputY(y)), force, maxForce});
+        }
+        else if (touch)
         {
             touch->setTouchInfo(iter->second, transformInputX(x), transformInputY(y), force, maxForce);
 
@@ -388,7 +408,8 @@ void GLView::handleTouchesMove(int num, intptr_t ids[], float xs[], float ys[],
 
     if (touchEvent._touches.empty())
     {
-        AXLOGD("touchesMoved: size = 0");
+        if (_touchMoves.empty())
+            AXLOGD("touchesMoved: size = 0");
         return;
     }
 
@@ -408,6 +429,8 @@ void GLView::handleTouchesOfEndOrCancel(EventTouch::EventCode eventCode,
     float y     = 0.0f;
     EventTouch touchEvent;
 
+    dispatchTouchMoves();
+
     for (int i = 0; i < num; ++i)
     {
         id = ids[i];
@@ -459,6 +482,47 @@ void GLView::handleTouchesOfEndOrCancel(EventTouch::EventCode eventCode,
     }
 }
 
+void GLView::dispatchTouchMoves()
+{
+    if (_touchMoves.empty())
+        return;
+
+    EventTouch touchEvent;
+    touchEvent._history.swap(_touchMoves);
+
+    // the touches get their latest move, in the order of their first move
+    int lastMoves[EventTouch::MAX_TOUCHES];
+    std::fill(std::begin(lastMoves), std::end(lastMoves), -1);
+    for (int i = 0; i < static_cast<int>(touchEvent._history.size()); ++i)
+    {
+        auto index = touchEvent._history[i].touchId;
+        if (lastMoves[index] < 0 && g_touches[index])
+            touchEvent._touches.emplace_back(g_touches[index]);
+        lastMoves[index] = i;
+    }
+
+    for (auto&& touch : touchEvent._touches)
+    {
+        auto& sample = touchEvent._history[lastMoves[touch->getID()]];
+        touch->setTouchInfo(sample.touchId, sample.locationInView.x, sample.locationInView.y, sample.force,
+                            sample.maxForce);
+    }
+
+    if (!touchEvent._touches.empty())
+    {
+        touchEvent._eventCode = EventTouch::EventCode::MOVED;
+        auto dispatcher       = Director::getInstance()->getEventDispatcher();
+        dispatcher->dispatchEvent(&touchEvent);
+    }
+
+    // the samples keep their capacity for the next frame
+    if (_touchMoves.empty())
+    {
+        touchEvent._history.clear();
+        _touchMoves.swap(touchEvent._history);
+    }
+}
+
 void GLView::handleTouchesEnd(int num, intptr_t ids[], float xs[], float ys[])
 {
     handleTouchesOfEndOrCancel(EventTouch::EventCode::ENDED, num, ids, xs, ys);
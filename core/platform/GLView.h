@@ -166,6 +166,17 @@ public:
     /** Polls the events. */
     virtual void pollEvents();
 
+    /** Dispatches the input events coalesced since the last frame, called by the Director after pollEvents. */
+    virtual void dispatchCoalescedEvents();
+
+    /** Sets whether the touch and mouse moves are coalesced into one event per frame, enabled by default.
+     * High rate touch panels and mice report several moves per frame, with the coalescing one MOVED event carries the
+     * latest location of each touch, and its moves in EventTouch::getHistory. The moves are dispatched before the
+     * touches beginning or ending, so the events keep their order.
+     */
+    void setInputCoalescing(bool enabled);
+    bool isInputCoalescing() const { return _inputCoalescing; }
+
     /**
      * Get the frame size of EGL view.
      * In general, it returns the screen size since the EGL view is a fullscreen view.
@@ -455,6 +466,8 @@ protected:
     void updateDesignResolutionSize();
 
     void handleTouchesOfEndOrCancel(EventTouch::EventCode eventCode, int num, intptr_t ids[], float xs[], float ys[]);
+    /** Dispatches the touch moves coalesced so far. */
+    void dispatchTouchMoves();
 
     // real screen size
     Vec2 _screenSize;
@@ -468,6 +481,9 @@ protected:
     float _scaleX;
     float _scaleY;
     ResolutionPolicy _resolutionPolicy;
+
+    std::vector<EventTouch::Sample> _touchMoves;  // coalesced until the next frame
+    bool _inputCoalescing = true;
 };
 
 // end of platform group
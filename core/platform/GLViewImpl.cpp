@@ -735,6 +735,12 @@ void GLViewImpl::pollEvents()
     glfwPollEvents();
 }
 
+void GLViewImpl::dispatchCoalescedEvents()
+{
+    GLView::dispatchCoalescedEvents();
+    dispatchMouseMove();
+}
+
 void GLViewImpl::enableRetina(bool enabled)
 {
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_MAC)
@@ -1072,6 +1078,8 @@ void GLViewImpl::onGLFWError(int errorID, const char* errorDesc)
 
 void GLViewImpl::onGLFWMouseCallBack(GLFWwindow* /*window*/, int button, int action, int /*modify*/)
 {
+    dispatchMouseMove();
+
     if (!_isTouchDevice)
     {
         if (GLFW_MOUSE_BUTTON_LEFT == button)
@@ -1140,13 +1148,23 @@ void GLViewImpl::onGLFWMouseMoveCallBack(GLFWwindow* window, double x, double y)
         }
     }
 
+    _mouseMoved = true;
+    if (!_inputCoalescing)
+        dispatchMouseMove();
+}
+
+void GLViewImpl::dispatchMouseMove()
+{
+    if (!_mouseMoved)
+        return;
+    _mouseMoved = false;
+
     float cursorX = transformInputX(_mouseX);
     float cursorY = transformInputY(_mouseY);
 
     EventMouse event(EventMouse::MouseEventType::MOUSE_MOVE);
     // Set current button
-    EventMouse::MouseButton mouseButton{EventMouse::MouseButton::BUTTON_UNSET};
-    event.setMouseInfo(cursorX, cursorY, checkMouseButton(window));
+    event.setMouseInfo(cursorX, cursorY, checkMouseButton(_mainWindow));
     Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
 }
 
@@ -1200,6 +1218,8 @@ void GLViewImpl::onWebTouchCallback(int eventType, const EmscriptenTouchEvent* t
 
 void GLViewImpl::onGLFWMouseScrollCallback(GLFWwindow* window, double x, double y)
 {
+    dispatchMouseMove();
+
     EventMouse event(EventMouse::MouseEventType::MOUSE_SCROLL);
     float cursorX = transformInputX(_mouseX);
     float cursorY = transformInputY(_mouseY);
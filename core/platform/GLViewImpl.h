@@ -72,6 +72,7 @@ public:
 
     bool windowShouldClose() override;
     void pollEvents() override;
+    void dispatchCoalescedEvents() override;
     GLFWwindow* getWindow() const { return _mainWindow; }
 
     bool isFullscreen() const;
@@ -176,6 +177,8 @@ protected:
     void onWebTouchCallback(int eventType, const EmscriptenTouchEvent* touchEvent);
 #endif
     void onGLFWMouseScrollCallback(GLFWwindow* window, double x, double y);
+    /** Dispatches the mouse move coalesced since the last frame. */
+    void dispatchMouseMove();
     void onGLFWKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
     void onGLFWCharCallback(GLFWwindow* window, unsigned int character);
     void onGLFWWindowPosCallback(GLFWwindow* windows, int x, int y);
@@ -205,6 +208,7 @@ protected:
 
     float _mouseX;
     float _mouseY;
+    bool _mouseMoved = false;  // coalesced until the next frame
 
 public:
     // View will trigger an event when window is resized, gains or loses focus
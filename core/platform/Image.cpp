@@ -104,6 +104,7 @@ struct dirent* readdir$INODE64(DIR* dir)
 } /* extern "C" */
 
 #include "base/ktxspec_v1.h"
+#include "base/ktxspec_v2.h"
 
 #include "base/s3tc.h"
 #include "base/atitc.h"
@@ -540,6 +541,178 @@ static uint32_t makeFourCC(char ch0, char ch1, char ch2, char ch3)
 }
 }  // namespace
 
+namespace
+{
+enum class KTX2Decoder
+{
+    NONE,  // uploaded as is
+    BGRA8,
+    S3TC,
+    ETC2,
+    ASTC,
+    PVRTC,
+};
+
+struct KTX2FormatInfo
+{
+    backend::PixelFormat pixelFormat;
+    bool hardware;  // false when the device can't sample the format, the levels are decoded to RGBA8
+    KTX2Decoder decoder;
+    int decodeFlag;  // S3TCDecodeFlag, the ETC2 format or 1 for PVRTC 2bpp
+    uint32_t blockWidth;
+    uint32_t blockHeight;
+};
+
+static bool getKTX2FormatInfo(uint32_t vkFormat, KTX2FormatInfo& info)
+{
+    using VkFormat = KTXv2Header::VkFormat;
+
+    auto config = Configuration::getInstance();
+    info        = KTX2FormatInfo{backend::PixelFormat::NONE, true, KTX2Decoder::NONE, 0, 1, 1};
+    switch (vkFormat)
+    {
+    case VkFormat::R8_UNORM:
+        info.pixelFormat = backend::PixelFormat::R8;
+        return true;
+    case VkFormat::R8G8_UNORM:
+        info.pixelFormat = backend::PixelFormat::RG8;
+        return true;
+    case VkFormat::R8G8B8_UNORM:
+    case VkFormat::R8G8B8_SRGB:
+        info.pixelFormat = backend::PixelFormat::RGB8;
+        return true;
+    case VkFormat::R8G8B8A8_UNORM:
+    case VkFormat::R8G8B8A8_SRGB:
+        info.pixelFormat = backend::PixelFormat::RGBA8;
+        return true;
+    case VkFormat::B8G8R8A8_UNORM:
+    case VkFormat::B8G8R8A8_SRGB:
+        info.pixelFormat = backend::PixelFormat::BGRA8;
+        info.hardware    = config->supportsBGRA8888();
+        info.decoder     = KTX2Decoder::BGRA8;
+        return true;
+    case VkFormat::BC1_RGB_UNORM_BLOCK:
+    case VkFormat::BC1_RGB_SRGB_BLOCK:
+    case VkFormat::BC1_RGBA_UNORM_BLOCK:
+    case VkFormat::BC1_RGBA_SRGB_BLOCK:
+        info = KTX2FormatInfo{backend::PixelFormat::S3TC_DXT1, config->supportsS3TC(), KTX2Decoder::S3TC,
+                              (int)S3TCDecodeFlag::DXT1, 4, 4};
+        return true;
+    case VkFormat::BC2_UNORM_BLOCK:
+    case VkFormat::BC2_SRGB_BLOCK:
+        info = KTX2FormatInfo{backend::PixelFormat::S3TC_DXT3, config->supportsS3TC(), KTX2Decoder::S3TC,
+                              (int)S3TCDecodeFlag::DXT3, 4, 4};
+        return true;
+    case VkFormat::BC3_UNORM_BLOCK:
+    case VkFormat::BC3_SRGB_BLOCK:
+        info = KTX2FormatInfo{backend::PixelFormat::S3TC_DXT5, config->supportsS3TC(), KTX2Decoder::S3TC,
+                              (int)S3TCDecodeFlag::DXT5, 4, 4};
+        return true;
+    case VkFormat::ETC2_R8G8B8_UNORM_BLOCK:
+    case VkFormat::ETC2_R8G8B8_SRGB_BLOCK:
+        info = KTX2FormatInfo{backend::PixelFormat::ETC2_RGB, config->supportsETC2(), KTX2Decoder::ETC2,
+                              ETC2_RGB_NO_MIPMAPS, 4, 4};
+        return true;
+    case VkFormat::ETC2_R8G8B8A8_UNORM_BLOCK:
+    case VkFormat::ETC2_R8G8B8A8_SRGB_BLOCK:
+        info = KTX2FormatInfo{backend::PixelFormat::ETC2_RGBA, config->supportsETC2(), KTX2Decoder::ETC2,
+                              ETC2_RGBA_NO_MIPMAPS, 4, 4};
+        return true;
+    case VkFormat::PVRTC1_2BPP_UNORM_BLOCK_IMG:
+    case VkFormat::PVRTC1_2BPP_SRGB_BLOCK_IMG:
+        info = KTX2FormatInfo{backend::PixelFormat::PVRTC2A, config->supportsPVRTC(), KTX2Decoder::PVRTC, 1, 8, 4};
+        return true;
+    case VkFormat::PVRTC1_4BPP_UNORM_BLOCK_IMG:
+    case VkFormat::PVRTC1_4BPP_SRGB_BLOCK_IMG:
+        info = KTX2FormatInfo{backend::PixelFormat::PVRTC4A, config->supportsPVRTC(), KTX2Decoder::PVRTC, 0, 4, 4};
+        return true;
+    default:
+        break;
+    }
+
+    if (vkFormat >= VkFormat::ASTC_4x4_UNORM_BLOCK && vkFormat <= VkFormat::ASTC_12x12_SRGB_BLOCK)
+    {
+        struct AstcBlock
+        {
+            uint32_t width;
+            uint32_t height;
+            backend::PixelFormat pixelFormat;  // NONE when the renderer has no such format
+        };
+        static const AstcBlock astcBlocks[] = {
+            {4, 4, backend::PixelFormat::ASTC4x4},   {5, 4, backend::PixelFormat::NONE},
+            {5, 5, backend::PixelFormat::ASTC5x5},   {6, 5, backend::PixelFormat::NONE},
+            {6, 6, backend::PixelFormat::ASTC6x6},   {8, 5, backend::PixelFormat::ASTC8x5},
+            {8, 6, backend::PixelFormat::ASTC8x6},   {8, 8, backend::PixelFormat::ASTC8x8},
+            {10, 5, backend::PixelFormat::ASTC10x5}, {10, 6, backend::PixelFormat::NONE},
+            {10, 8, backend::PixelFormat::NONE},     {10, 10, backend::PixelFormat::NONE},
+            {12, 10, backend::PixelFormat::NONE},    {12, 12, backend::PixelFormat::NONE},
+        };
+        auto& block = astcBlocks[(vkFormat - VkFormat::ASTC_4x4_UNORM_BLOCK) / 2];
+        info        = KTX2FormatInfo{block.pixelFormat,
+                              block.pixelFormat != backend::PixelFormat::NONE && config->supportsASTC(),
+                              KTX2Decoder::ASTC,
+                              0,
+                              block.width,
+                              block.height};
+        return true;
+    }
+
+    return false;
+}
+
+static bool decodeKTX2Level(const KTX2FormatInfo& info,
+                            const uint8_t* in,
+                            size_t inLen,
+                            uint8_t* out,
+                            uint32_t width,
+                            uint32_t height)
+{
+    // the decoders trust the sizes
+    size_t blocks = (size_t)((width + info.blockWidth - 1) / info.blockWidth) *
+                    ((height + info.blockHeight - 1) / info.blockHeight);
+
+    size_t blockBytes = 16;
+    if (info.decoder == KTX2Decoder::BGRA8)
+        blockBytes = 4;
+    else if (info.decoder == KTX2Decoder::PVRTC)
+    {
+        // a PVRTC image has 2x2 blocks at least
+        blocks     = (std::max)(blocks, (size_t)4);
+        blockBytes = 8;
+    }
+    else if (info.pixelFormat == backend::PixelFormat::S3TC_DXT1 || info.pixelFormat == backend::PixelFormat::ETC2_RGB)
+        blockBytes = 8;
+    if (inLen < blocks * blockBytes)
+        return false;
+
+    switch (info.decoder)
+    {
+    case KTX2Decoder::BGRA8:
+        for (size_t i = 0, count = (size_t)width * height; i < count; ++i, in += 4, out += 4)
+        {
+            out[0] = in[2];
+            out[1] = in[1];
+            out[2] = in[0];
+            out[3] = in[3];
+        }
+        return true;
+    case KTX2Decoder::S3TC:
+        s3tc_decode(const_cast<uint8_t*>(in), out, width, height, (S3TCDecodeFlag)info.decodeFlag);
+        return true;
+    case KTX2Decoder::ETC2:
+        return etc2_decode_image(info.decodeFlag, in, out, width, height) == 0;
+    case KTX2Decoder::ASTC:
+        return astc_decompress_image(in, static_cast<uint32_t>(inLen), out, width, height, info.blockWidth,
+                                     info.blockHeight) == 0;
+    case KTX2Decoder::PVRTC:
+        PVRTDecompressPVRTC(in, width, height, out, info.decodeFlag != 0);
+        return true;
+    default:
+        return false;
+    }
+}
+}  // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Implement Image
 //////////////////////////////////////////////////////////////////////////
@@ -569,6 +742,7 @@ Image::Image()
     , _fileType(Format::UNKNOWN)
     , _pixelFormat(backend::PixelFormat::NONE)
     , _numberOfMipmaps(0)
+    , _numberOfFaces(1)
     , _hasPremultipliedAlpha(false)
 {}
 
@@ -587,36 +761,40 @@ Image::~Image()
 
 bool Image::initWithImageFile(std::string_view path)
 {
-    bool ret  = false;
-    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
-
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
-
-    if (!data.isNull())
-    {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
-    }
-
-    return ret;
+    return initWithImageFileThreadSafe(FileUtils::getInstance()->fullPathForFilename(path));
 }
 
 bool Image::initWithImageFileThreadSafe(std::string_view fullpath)
 {
-    bool ret  = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    auto contents = FileUtils::getInstance()->getMappedContents(_filePath);
+    if (contents.isNull())
+        return false;
+
+    // the formats decoded to pixels only read the file, they use the view instead of a copy
+    auto bytes = contents.data();
+    auto size  = static_cast<ssize_t>(contents.size());
+    if (ZipUtils::isCCZBuffer(bytes, size) || ZipUtils::isGZipBuffer(bytes, size))
+        return initWithImageData(bytes, size);
 
-    if (!data.isNull())
+    switch (detectFormat(bytes, size))
     {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
+    case Format::PNG:
+    case Format::JPG:
+    case Format::WEBP:
+    case Format::BMP:
+        return initWithImageData(bytes, size);
+    default:
+    {
+        // the GPU formats keep the file bytes as their pixels, they own a copy
+        auto buf = static_cast<uint8_t*>(malloc(size));
+        if (!buf)
+            return false;
+        memcpy(buf, bytes, size);
+        return initWithImageData(buf, size, true);
+    }
     }
-
-    return ret;
 }
 
 bool Image::initWithImageData(const uint8_t* data, ssize_t dataLen)
@@ -688,6 +866,9 @@ bool Image::initWithImageData(uint8_t* data, ssize_t dataLen, bool ownData)
         case Format::ASTC:
             ret = initWithASTCData(unpackedData, unpackedLen, ownData);
             break;
+        case Format::KTX2:
+            ret = initWithKTX2Data(unpackedData, unpackedLen, ownData);
+            break;
         case Format::BMP:
             ret = initWithBmpData(unpackedData, unpackedLen);
             break;
@@ -821,6 +1002,11 @@ bool Image::isASTC(const uint8_t* data, ssize_t /*dataLen*/)
     return (magicval & 0x0FFFFFFF) == (ASTC_MAGIC_ID & 0x0FFFFFFF);  // wildcard check
 }
 
+bool Image::isKtx2(const uint8_t* data, ssize_t dataLen)
+{
+    return dataLen >= KTX_V2_HEADER_SIZE && memcmp(data + 1, KTX_V2_MAGIC, sizeof(KTX_V2_MAGIC) - 1) == 0;
+}
+
 bool Image::isJpg(const uint8_t* data, ssize_t dataLen)
 {
     if (dataLen <= 4)
@@ -898,6 +1084,10 @@ Image::Format Image::detectFormat(const uint8_t* data, ssize_t dataLen)
     {
         return Format::ASTC;
     }
+    else if (isKtx2(data, dataLen))
+    {
+        return Format::KTX2;
+    }
     else if (dataLen >= KTX_V1_HEADER_SIZE)
     {  // Check whether ktxspec v1.1 file format
         auto header = (KTXv1Header*)data;
@@ -2049,6 +2239,180 @@ bool Image::initWithASTCData(uint8_t* data, ssize_t dataLen, bool ownData)
     return false;
 }
 
+bool Image::initWithKTX2Data(uint8_t* data, ssize_t dataLen, bool ownData)
+{
+    auto header = reinterpret_cast<const KTXv2Header*>(data);
+
+    do
+    {
+        _width  = header->pixelWidth;
+        _height = header->pixelHeight;
+
+        if (0 == _width || 0 == _height)
+            break;
+
+        if (header->pixelDepth > 1 || header->layerCount > 1 || (header->faceCount != 1 && header->faceCount != 6))
+        {
+            AXLOGW("The KTX2 texture arrays and 3D textures aren't supported");
+            break;
+        }
+        const int faceCount = static_cast<int>(header->faceCount);
+        if (faceCount == 6 && _width != _height)
+        {
+            AXLOGW("The faces of the KTX2 cube map aren't square");
+            break;
+        }
+
+        const int levelCount = (std::max)(static_cast<int>(header->levelCount), 1);
+        if (levelCount > MIPMAP_MAX ||
+            KTX_V2_HEADER_SIZE + levelCount * sizeof(KTXv2LevelIndex) > static_cast<size_t>(dataLen))
+            break;
+        auto levels = reinterpret_cast<const KTXv2LevelIndex*>(data + KTX_V2_HEADER_SIZE);
+
+        bool premultipliedAlpha = false;
+        if (header->dfdByteLength >= sizeof(KTXv2BasicDFD) &&
+            header->dfdByteOffset + header->dfdByteLength <= static_cast<size_t>(dataLen))
+        {
+            auto dfd = reinterpret_cast<const KTXv2BasicDFD*>(data + header->dfdByteOffset);
+            if (header->vkFormat == KTXv2Header::VkFormat::UNDEFINED &&
+                (dfd->colorModel == KTXv2BasicDFD::ColorModel::ETC1S ||
+                 dfd->colorModel == KTXv2BasicDFD::ColorModel::UASTC))
+            {
+                AXLOGW("The KTX2 Basis Universal textures aren't supported, transcode them to a GPU format");
+                break;
+            }
+            premultipliedAlpha = (dfd->flags & KTXv2BasicDFD::Flags::ALPHA_PREMULTIPLIED) != 0;
+        }
+
+        KTX2FormatInfo info;
+        if (!getKTX2FormatInfo(header->vkFormat, info))
+        {
+            AXLOGW("The KTX2 vkFormat {} isn't supported", header->vkFormat);
+            break;
+        }
+
+        const auto scheme = header->supercompressionScheme;
+        if (scheme != KTXv2Header::SupercompressionScheme::NONE && scheme != KTXv2Header::SupercompressionScheme::ZLIB)
+        {
+            AXLOGW("The KTX2 supercompression scheme {} isn't supported", scheme);
+            break;
+        }
+
+        // the levels are addressed in the file, or in one buffer they are inflated to, level 0 first
+        const uint8_t* levelData[MIPMAP_MAX];
+        size_t levelLen[MIPMAP_MAX];
+        uint8_t* inflated = nullptr;
+        bool valid        = true;
+        if (scheme == KTXv2Header::SupercompressionScheme::ZLIB)
+        {
+            size_t inflatedLen = 0;
+            for (int i = 0; i < levelCount; ++i)
+                inflatedLen += static_cast<size_t>(levels[i].uncompressedByteLength);
+            inflated = static_cast<uint8_t*>(malloc(inflatedLen));
+
+            size_t offset = 0;
+            for (int i = 0; i < levelCount && valid; ++i)
+            {
+                auto& level = levels[i];
+                valid       = inflated && level.byteOffset + level.byteLength <= static_cast<uint64_t>(dataLen);
+                if (valid)
+                {
+                    auto levelBuffer = ZipUtils::decompressGZ(data + level.byteOffset, level.byteLength,
+                                                              static_cast<int>(level.uncompressedByteLength));
+                    valid            = levelBuffer.size() == level.uncompressedByteLength;
+                    if (valid)
+                        memcpy(inflated + offset, levelBuffer.data(), levelBuffer.size());
+                }
+                levelData[i] = inflated + offset;
+                levelLen[i]  = static_cast<size_t>(level.uncompressedByteLength);
+                offset += levelLen[i];
+            }
+        }
+        else
+        {
+            for (int i = 0; i < levelCount && valid; ++i)
+            {
+                auto& level  = levels[i];
+                valid        = level.byteOffset + level.byteLength <= static_cast<uint64_t>(dataLen);
+                levelData[i] = data + level.byteOffset;
+                levelLen[i]  = static_cast<size_t>(level.byteLength);
+            }
+        }
+
+        if (!valid)
+        {
+            AXLOGW("The KTX2 file is truncated or corrupted");
+            free(inflated);
+            break;
+        }
+
+        _numberOfMipmaps = levelCount;
+        if (info.hardware)
+        {
+            _pixelFormat = info.pixelFormat;
+            if (inflated)
+            {
+                _data    = inflated;
+                _dataLen = levelLen[0];
+            }
+            else
+            {
+                forwardPixels(data, dataLen, 0, ownData);
+                _offset  = static_cast<ssize_t>(levels[0].byteOffset);
+                _dataLen = _offset + levelLen[0];
+            }
+            for (int i = 0; i < levelCount; ++i)
+            {
+                _mipmaps[i].address = _data + (levelData[i] - (inflated ? inflated : data));
+                _mipmaps[i].len     = static_cast<int>(levelLen[i]);
+            }
+        }
+        else
+        {
+            AXLOGW("Hardware decoder of the KTX2 vkFormat {} not present. Using software decoder", header->vkFormat);
+
+            size_t decodedLen = 0;
+            for (int i = 0; i < levelCount; ++i)
+                decodedLen += (size_t)(std::max)(_width >> i, 1) * (std::max)(_height >> i, 1) * 4 * faceCount;
+            _data    = static_cast<uint8_t*>(malloc(decodedLen));
+            _dataLen = 0;
+
+            for (int i = 0; i < levelCount && valid; ++i)
+            {
+                uint32_t width  = (std::max)(_width >> i, 1);
+                uint32_t height = (std::max)(_height >> i, 1);
+
+                // the faces of a level have the same size
+                const size_t faceLen = levelLen[i] / faceCount;
+                _mipmaps[i].address  = _data + _dataLen;
+                _mipmaps[i].len      = static_cast<int>(width * height * 4 * faceCount);
+                for (int face = 0; face < faceCount && valid; ++face)
+                    valid = decodeKTX2Level(info, levelData[i] + face * faceLen, faceLen,
+                                            _mipmaps[i].address + face * width * height * 4, width, height);
+                _dataLen += _mipmaps[i].len;
+            }
+            free(inflated);
+
+            if (!valid)
+            {
+                AX_SAFE_FREE(_data);
+                _dataLen         = 0;
+                _numberOfMipmaps = 0;
+                break;
+            }
+            _dataLen     = _mipmaps[0].len;
+            _pixelFormat = backend::PixelFormat::RGBA8;
+        }
+
+        _hasPremultipliedAlpha = premultipliedAlpha;
+        _numberOfFaces         = faceCount;
+
+        return true;
+    } while (false);
+
+    return false;
+}
+
 bool Image::initWithS3TCData(uint8_t* data, ssize_t dataLen, bool ownData)
 {
     const uint32_t FOURCC_DXT1 = makeFourCC('D', 'X', 'T', '1');
@@ -2622,12 +2986,7 @@ void Image::premultiplyAlpha()
               "The pixel format should be RGBA8888 or RG88.");
 
     if (_pixelFormat ==  backend::PixelFormat::RGBA8) {
-        unsigned int* fourBytes = (unsigned int*)_data;
-        for (int i = 0; i < _width * _height; i++)
-        {
-            uint8_t* p   = _data + i * 4;
-            fourBytes[i] = AX_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
-        }
+        backend::PixelFormatUtils::premultiplyAlpha(_data, static_cast<size_t>(_width) * _height * 4);
     }
     else
     {
@@ -68,6 +68,8 @@ class AX_DLL Image : public Object
 {
 public:
     friend class TextureCache;
+    friend class VolatileTextureMgr;
+    friend class TextureCube;
     /**
      * @js ctor
      */
@@ -103,6 +105,8 @@ public:
         TGA,
         //! ASTC
         ASTC,
+        //! KTX2
+        KTX2,
         //! Raw Data
         RAW_DATA,
         //! Unknown format
@@ -179,6 +183,8 @@ public:
     int getHeight() { return _height; }
     int getNumberOfMipmaps() { return _numberOfMipmaps; }
     MipmapInfo* getMipmaps() { return _mipmaps; }
+    /** 6 for the cube maps, whose faces are stored one after the other in each mipmap level, +X first. */
+    int getNumberOfFaces() { return _numberOfFaces; }
     bool hasPremultipliedAlpha() { return _hasPremultipliedAlpha; }
     std::string getFilePath() const { return _filePath; }
 
@@ -217,6 +223,7 @@ protected:
     bool initWithASTCData(uint8_t* data, ssize_t dataLen, bool ownData);
     bool initWithS3TCData(uint8_t* data, ssize_t dataLen, bool ownData);
     bool initWithATITCData(uint8_t* data, ssize_t dataLen, bool ownData);
+    bool initWithKTX2Data(uint8_t* data, ssize_t dataLen, bool ownData);
 
     // fast forward pixels to GPU if ownData
     void forwardPixels(uint8_t* data, ssize_t dataLen, int offset, bool ownData);
@@ -246,6 +253,7 @@ protected:
     backend::PixelFormat _pixelFormat;
     MipmapInfo _mipmaps[MIPMAP_MAX];  // pointer to mipmap images
     int _numberOfMipmaps;
+    int _numberOfFaces;
     // false if we can't auto detect the image is premultiplied or not.
     bool _hasPremultipliedAlpha;
     std::string _filePath;
@@ -274,6 +282,7 @@ protected:
     bool isEtc2(const uint8_t* data, ssize_t dataLen);
     bool isS3TC(const uint8_t* data, ssize_t dataLen);
     bool isASTC(const uint8_t* data, ssize_t dataLen);
+    bool isKtx2(const uint8_t* data, ssize_t dataLen);
 };
 
 // end of platform group
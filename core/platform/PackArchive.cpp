@@ -0,0 +1,393 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "platform/PackArchive.h"
+#include "platform/FileUtils.h"
+#include "platform/FileStream.h"
+#include "base/Logging.h"
+
+#include <algorithm>
+#include <vector>
+#include <zlib.h>
+#if AX_TARGET_PLATFORM != AX_PLATFORM_WIN32 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+#include "xxhash/xxhash.h"
+
+namespace ax
+{
+
+static const char AXPK_MAGIC[4] = {'A', 'X', 'P', 'K'};
+static const uint32_t EMPTY_BUCKET = UINT32_MAX;
+
+// the file starts with the header and the stored files, the tables follow them, see PackArchive::pack
+struct PackArchive::FileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t bucketCount;  // a power of two, bigger than the entry count
+    uint64_t entryOffset;
+    uint64_t bucketOffset;
+    uint64_t nameOffset;
+    uint64_t nameSize;
+};
+
+class PackArchive::EntryStream : public IFileStream
+{
+public:
+    EntryStream(std::shared_ptr<const PackArchive> archive, const Entry& entry) : _archive(std::move(archive))
+    {
+        if (entry.compression == Compression::NONE)
+            _data = _archive->_data + entry.offset;
+        else
+        {
+            ResizableBufferAdapter<std::vector<uint8_t>> buffer(&_inflated);
+            if (!_archive->read(entry, &buffer))
+                return;
+            _data = _inflated.data();
+        }
+        _size = static_cast<int64_t>(entry.size);
+        _open = true;
+    }
+
+    bool open(std::string_view, IFileStream::Mode) override { return false; }
+    int close() override
+    {
+        _open = false;
+        _inflated.clear();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        int64_t position = origin == SEEK_SET ? offset : (origin == SEEK_CUR ? _position + offset : _size + offset);
+        if (!_open || position < 0)
+            return -1;
+        _position = (std::min)(position, _size);
+        return _position;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_open)
+            return -1;
+        auto count = static_cast<unsigned int>((std::min)(static_cast<int64_t>(size), _size - _position));
+        if (count > 0)
+            memcpy(buf, _data + _position, count);
+        _position += count;
+        return static_cast<int>(count);
+    }
+
+    int write(const void*, unsigned int) const override { return -1; }
+    int64_t tell() const override { return _open ? _position : -1; }
+    int64_t size() const override { return _open ? _size : -1; }
+    bool isOpen() const override { return _open; }
+
+private:
+    std::shared_ptr<const PackArchive> _archive;
+    std::vector<uint8_t> _inflated;
+    const uint8_t* _data      = nullptr;
+    int64_t _size             = 0;
+    mutable int64_t _position = 0;
+    bool _open                = false;
+};
+
+static uint64_t hashPath(std::string_view path)
+{
+    return XXH3_64bits(path.data(), path.size());
+}
+
+static bool writeAll(FileStream& stream, const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        auto chunk = static_cast<unsigned int>((std::min)(size, size_t{1} << 30));
+        if (stream.write(bytes, chunk) != static_cast<int>(chunk))
+            return false;
+        bytes += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+static bool writePadding(FileStream& stream, uint64_t& offset, size_t alignment)
+{
+    static const uint8_t zeros[PackArchive::ALIGNMENT] = {};
+    auto padding = static_cast<size_t>((alignment - offset % alignment) % alignment);
+    offset += padding;
+    return writeAll(stream, zeros, padding);
+}
+
+bool PackArchive::pack(std::string_view srcDir, std::string_view dstFullPath, bool compress)
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto root      = fileUtils->fullPathForDirectory(srcDir);
+    if (root.empty() || !fileUtils->isDirectoryExist(root))
+    {
+        AXLOGW("PackArchive: {} is not a directory", srcDir);
+        return false;
+    }
+    if (root.back() != '/')
+        root += '/';
+
+    std::vector<std::string> files;
+    fileUtils->listFilesRecursively(root, &files);
+    files.erase(std::remove_if(files.begin(), files.end(), [](auto& path) { return path.back() == '/'; }),
+                files.end());
+    std::sort(files.begin(), files.end());
+
+    FileStream stream;
+    if (!stream.open(dstFullPath, IFileStream::Mode::WRITE))
+        return false;
+
+    FileHeader header{};
+    uint64_t offset = sizeof(FileHeader);
+    if (!writeAll(stream, &header, sizeof(header)))
+        return false;
+
+    std::vector<Entry> entries;
+    std::string names;
+    entries.reserve(files.size());
+    for (auto&& path : files)
+    {
+        std::string_view name{path};
+        name.remove_prefix((std::min)(root.size(), path.size()));
+        if (name.empty())
+            continue;
+
+        auto data = fileUtils->getDataFromFile(path);
+
+        Entry entry{};
+        entry.hash       = hashPath(name);
+        entry.size       = static_cast<uint64_t>(data.getSize());
+        entry.storedSize = entry.size;
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(name.size());
+        names.append(name);
+
+        // only keep the deflated files which save an eighth of their size
+        const uint8_t* stored = data.getBytes();
+        std::vector<uint8_t> deflated;
+        if (compress && entry.size > 0)
+        {
+            uLongf deflatedSize = compressBound(static_cast<uLong>(entry.size));
+            deflated.resize(deflatedSize);
+            if (compress2(deflated.data(), &deflatedSize, stored, static_cast<uLong>(entry.size), Z_BEST_COMPRESSION) ==
+                    Z_OK &&
+                deflatedSize < entry.size - entry.size / 8)
+            {
+                entry.compression = Compression::DEFLATE;
+                entry.storedSize  = deflatedSize;
+                stored            = deflated.data();
+            }
+        }
+
+        if (!writePadding(stream, offset, ALIGNMENT))
+            return false;
+        entry.offset = offset;
+        if (!writeAll(stream, stored, static_cast<size_t>(entry.storedSize)))
+            return false;
+        offset += entry.storedSize;
+        entries.emplace_back(entry);
+    }
+
+    // open addressing, at most half full so a miss ends quickly
+    uint32_t bucketCount = 2;
+    while (bucketCount < entries.size() * 2)
+        bucketCount *= 2;
+    std::vector<uint32_t> buckets(bucketCount, EMPTY_BUCKET);
+    for (uint32_t index = 0; index < entries.size(); ++index)
+    {
+        auto bucket = static_cast<uint32_t>(entries[index].hash) & (bucketCount - 1);
+        while (buckets[bucket] != EMPTY_BUCKET)
+            bucket = (bucket + 1) & (bucketCount - 1);
+        buckets[bucket] = index;
+    }
+
+    memcpy(header.magic, AXPK_MAGIC, sizeof(AXPK_MAGIC));
+    header.version     = VERSION;
+    header.entryCount  = static_cast<uint32_t>(entries.size());
+    header.bucketCount = bucketCount;
+
+    if (!writePadding(stream, offset, alignof(Entry)))
+        return false;
+    header.entryOffset = offset;
+    offset += entries.size() * sizeof(Entry);
+    header.bucketOffset = offset;
+    offset += buckets.size() * sizeof(uint32_t);
+    header.nameOffset = offset;
+    header.nameSize   = names.size();
+
+    if (!writeAll(stream, entries.data(), entries.size() * sizeof(Entry)) ||
+        !writeAll(stream, buckets.data(), buckets.size() * sizeof(uint32_t)) ||
+        !writeAll(stream, names.data(), names.size()))
+        return false;
+
+    return stream.seek(0, SEEK_SET) == 0 && writeAll(stream, &header, sizeof(header));
+}
+
+bool PackArchive::open(std::string_view fullPath)
+{
+    std::error_code error;
+    _mapping.map(fullPath, error);
+    if (!error && _mapping.size() > 0)
+    {
+        _data = reinterpret_cast<const uint8_t*>(_mapping.data());
+        _size = _mapping.size();
+    }
+    else
+    {
+        // not a regular file, e.g. in the apk
+        _buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+        _data   = _buffer.getBytes();
+        _size   = static_cast<size_t>(_buffer.getSize());
+    }
+
+    if (_data && validate())
+        return true;
+
+    AXLOGW("PackArchive: {} is not a valid archive", fullPath);
+    _mapping.unmap();
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    return false;
+}
+
+bool PackArchive::validate()
+{
+    if (_size < sizeof(FileHeader))
+        return false;
+
+    _header = reinterpret_cast<const FileHeader*>(_data);
+    if (memcmp(_header->magic, AXPK_MAGIC, sizeof(AXPK_MAGIC)) != 0 || _header->version != VERSION)
+        return false;
+
+    auto bucketCount = _header->bucketCount;
+    if (bucketCount <= _header->entryCount || (bucketCount & (bucketCount - 1)) != 0 ||
+        _header->entryOffset % alignof(Entry) != 0 ||
+        _header->entryOffset + uint64_t{_header->entryCount} * sizeof(Entry) > _header->bucketOffset ||
+        _header->bucketOffset + uint64_t{bucketCount} * sizeof(uint32_t) > _header->nameOffset ||
+        _header->nameOffset + _header->nameSize > _size)
+        return false;
+
+    _entries = reinterpret_cast<const Entry*>(_data + _header->entryOffset);
+    _buckets = reinterpret_cast<const uint32_t*>(_data + _header->bucketOffset);
+    _names   = reinterpret_cast<const char*>(_data + _header->nameOffset);
+
+    for (uint32_t index = 0; index < _header->entryCount; ++index)
+    {
+        auto& entry = _entries[index];
+        if (entry.offset + entry.storedSize > _header->entryOffset ||
+            uint64_t{entry.nameOffset} + entry.nameLength > _header->nameSize)
+            return false;
+    }
+    for (uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        if (_buckets[bucket] != EMPTY_BUCKET && _buckets[bucket] >= _header->entryCount)
+            return false;
+    }
+    return true;
+}
+
+const PackArchive::Entry* PackArchive::find(std::string_view path) const
+{
+    if (!_data)
+        return nullptr;
+
+    const auto hash = hashPath(path);
+    const auto mask = _header->bucketCount - 1;
+    for (auto bucket = static_cast<uint32_t>(hash) & mask;; bucket = (bucket + 1) & mask)
+    {
+        auto index = _buckets[bucket];
+        if (index == EMPTY_BUCKET)
+            return nullptr;
+        auto& entry = _entries[index];
+        if (entry.hash == hash && getName(entry) == path)
+            return &entry;
+    }
+}
+
+size_t PackArchive::getEntryCount() const
+{
+    return _data ? _header->entryCount : 0;
+}
+
+const PackArchive::Entry* PackArchive::getEntry(size_t index) const
+{
+    return index < getEntryCount() ? &_entries[index] : nullptr;
+}
+
+std::string_view PackArchive::getName(const Entry& entry) const
+{
+    return std::string_view{_names + entry.nameOffset, entry.nameLength};
+}
+
+void PackArchive::prefetch(uint64_t offset, uint64_t size) const
+{
+#if AX_TARGET_PLATFORM != AX_PLATFORM_WIN32 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+    if (!_mapping.is_mapped() || size == 0 || offset + size > _size)
+        return;
+
+    static const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto begin = reinterpret_cast<uintptr_t>(_data + offset) & ~(pageSize - 1);
+    auto end   = reinterpret_cast<uintptr_t>(_data + offset + size);
+    posix_madvise(reinterpret_cast<void*>(begin), end - begin, POSIX_MADV_WILLNEED);
+#endif
+}
+
+bool PackArchive::read(const Entry& entry, ResizableBuffer* buffer) const
+{
+    buffer->resize(static_cast<size_t>(entry.size));
+    if (entry.size == 0)
+        return true;
+
+    const auto stored = _data + entry.offset;
+    if (entry.compression == Compression::NONE)
+    {
+        memcpy(buffer->buffer(), stored, static_cast<size_t>(entry.size));
+        return true;
+    }
+
+    uLongf size = static_cast<uLongf>(entry.size);
+    if (uncompress(static_cast<Bytef*>(buffer->buffer()), &size, stored, static_cast<uLong>(entry.storedSize)) !=
+            Z_OK ||
+        size != entry.size)
+    {
+        AXLOGW("PackArchive: failed to inflate {}", getName(entry));
+        buffer->resize(0);
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<IFileStream> PackArchive::openStream(std::shared_ptr<const PackArchive> archive, const Entry& entry)
+{
+    auto stream = std::make_unique<EntryStream>(std::move(archive), entry);
+    return stream->isOpen() ? std::move(stream) : nullptr;
+}
+
+}  // namespace ax
@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "platform/IFileStream.h"
+#include "base/Data.h"
+#include "mio/mio.hpp"
+
+namespace ax
+{
+
+class ResizableBuffer;
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * @brief A read only archive of packed files, mounted in FileUtils with FileUtils::mountArchive.
+ *
+ * An .axpak file holds the files of a directory tree and a hash table of their paths, opening it maps the file and
+ * a lookup is one hash and a probe or two, instead of a file system query by search path. The stored files are
+ * aligned, the uncompressed ones are read straight from the mapping, the ones which shrink with deflate are stored
+ * compressed and inflated when read. An archive which isn't a regular file, e.g. in the apk, is read in memory.
+ *
+ * An archive is created with PackArchive::pack. It is only read once opened, so it's safe to use from any thread.
+ */
+class AX_DLL PackArchive
+{
+public:
+    /** The file format version, files of other versions are rejected. */
+    static constexpr uint32_t VERSION = 1;
+
+    /** The alignment of the stored files in the archive. */
+    static constexpr size_t ALIGNMENT = 16;
+
+    enum class Compression : uint32_t
+    {
+        NONE,
+        DEFLATE,
+    };
+
+    /** A file of the archive. */
+    struct Entry
+    {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t size;        ///< the size of the file
+        uint64_t storedSize;  ///< the size in the archive
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        Compression compression;
+        uint32_t reserved;
+    };
+
+    /**
+     * Pack the files of a directory, their paths in the archive are relative to it.
+     * @param compress Whether the files which shrink with deflate are stored compressed.
+     */
+    static bool pack(std::string_view srcDir, std::string_view dstFullPath, bool compress = true);
+
+    bool open(std::string_view fullPath);
+    bool isOpen() const { return _data != nullptr; }
+
+    /** Find a file by its path in the archive, with '/' separators. */
+    const Entry* find(std::string_view path) const;
+
+    size_t getEntryCount() const;
+    const Entry* getEntry(size_t index) const;
+    std::string_view getName(const Entry& entry) const;
+
+    /** The bytes of a file in the archive, compressed if the file is. */
+    const uint8_t* getStoredData(const Entry& entry) const { return _data + entry.offset; }
+
+    /** Tells the system a range of the archive is read soon, for the mapped archives. */
+    void prefetch(uint64_t offset, uint64_t size) const;
+
+    /** Read a whole file, inflated if compressed. */
+    bool read(const Entry& entry, ResizableBuffer* buffer) const;
+
+    /** Open a read stream on a file, the stream keeps the archive alive. */
+    static std::unique_ptr<IFileStream> openStream(std::shared_ptr<const PackArchive> archive, const Entry& entry);
+
+protected:
+    struct FileHeader;
+    class EntryStream;
+
+    bool validate();
+
+    mio::mmap_source _mapping;
+    Data _buffer;  // the archive when it can't be mapped
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+
+    const FileHeader* _header = nullptr;
+    const Entry* _entries     = nullptr;
+    const uint32_t* _buckets  = nullptr;
+    const char* _names        = nullptr;
+};
+
+// end of platform group
+/** @} */
+
+}  // namespace ax
@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include "base/hlookup.h"
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * The full path caches of FileUtils, which the loaders of the worker threads look up concurrently.
+ * The paths are spread over shards with a lock each, the lookups only take a shared lock, so they don't wait for each
+ * other, and an insert only blocks the lookups of its shard.
+ */
+class PathCache
+{
+public:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    /** Copies the path of a key into result, returns false when it isn't cached. */
+    bool find(std::string_view key, std::string& result) const
+    {
+        auto& shard = shardOf(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.paths.find(key);
+        if (it == shard.paths.end())
+            return false;
+        result = it->second;
+        return true;
+    }
+
+    void emplace(std::string_view key, std::string_view path)
+    {
+        auto& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.paths.emplace(key, path);
+    }
+
+    void clear()
+    {
+        for (auto& shard : _shards)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.paths.clear();
+        }
+    }
+
+    /** Returns a copy of all the cached paths. */
+    hlookup::string_map<std::string> snapshot() const
+    {
+        hlookup::string_map<std::string> paths;
+        for (auto& shard : _shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            paths.insert(shard.paths.begin(), shard.paths.end());
+        }
+        return paths;
+    }
+
+private:
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        hlookup::string_map<std::string> paths;
+    };
+
+    Shard& shardOf(std::string_view key) { return _shards[hlookup::string_hash{}(key) % SHARD_COUNT]; }
+    const Shard& shardOf(std::string_view key) const { return _shards[hlookup::string_hash{}(key) % SHARD_COUNT]; }
+
+    std::array<Shard, SHARD_COUNT> _shards;
+};
+
+// end of platform group
+/** @} */
+
+}  // namespace ax
@@ -32,6 +32,7 @@
 #include <vector>  // because its based on windows 8 build :P
 
 #include "platform/FileUtils.h"
+#include "base/ZipUtils.h"
 #include "xsxml/xsxml.hpp"
 
 namespace ax
@@ -116,6 +117,15 @@ bool SAXParser::parse(std::string_view filename, ParseOption opt)
 {
     bool ret  = false;
     Data data = FileUtils::getInstance()->getDataFromFile(filename);
+    if (ZipUtils::isCCZBuffer(data.getBytes(), data.getSize()))
+    {
+        uint8_t* inflated = nullptr;
+        auto len          = ZipUtils::inflateCCZBuffer(data.getBytes(), data.getSize(), &inflated);
+        Data inflatedData;
+        if (len > 0)
+            inflatedData.fastSet(inflated, len);
+        data = std::move(inflatedData);
+    }
     if (!data.isNull())
     {
         ret = parseIntrusive((char*)data.getBytes(), data.getSize(), opt);
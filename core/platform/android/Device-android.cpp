@@ -212,6 +212,40 @@ void Device::selectionChanged()
     JniHelper::callStaticVoidMethod(deviceHelperClassName, "selectionChanged");
 }
 
+Device::ThermalState Device::getThermalState()
+{
+    // PowerManager.THERMAL_STATUS_*, SEVERE and above are critical
+    int status = JniHelper::callStaticIntMethod(deviceHelperClassName, "getThermalStatus");
+    if (status >= 3)
+        return ThermalState::CRITICAL;
+    return static_cast<ThermalState>(status);
+}
+
+float Device::getThermalHeadroom(int forecastSeconds)
+{
+    return JniHelper::callStaticFloatMethod(deviceHelperClassName, "getThermalHeadroom", forecastSeconds);
+}
+
+float Device::getBatteryLevel()
+{
+    return JniHelper::callStaticFloatMethod(deviceHelperClassName, "getBatteryLevel");
+}
+
+bool Device::isPowerSaveMode()
+{
+    return JniHelper::callStaticBooleanMethod(deviceHelperClassName, "isPowerSaveMode");
+}
+
+void Device::setTargetWorkDuration(int64_t nanoseconds)
+{
+    JniHelper::callStaticVoidMethod(deviceHelperClassName, "setTargetWorkDuration", nanoseconds);
+}
+
+void Device::reportActualWorkDuration(int64_t nanoseconds)
+{
+    JniHelper::callStaticVoidMethod(deviceHelperClassName, "reportActualWorkDuration", nanoseconds);
+}
+
 }
 
 // this method is called by BitmapHelper
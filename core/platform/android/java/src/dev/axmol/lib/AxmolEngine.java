@@ -41,10 +41,14 @@ import android.content.pm.PackageManager.NameNotFoundException;
 import android.content.res.AssetFileDescriptor;
 import android.content.res.AssetManager;
 import android.net.Uri;
+import android.os.BatteryManager;
 import android.os.Build;
 import android.os.Environment;
 import android.os.IBinder;
 import android.os.ParcelFileDescriptor;
+import android.os.PerformanceHintManager;
+import android.os.PowerManager;
+import android.os.Process;
 import android.os.Vibrator;
 import android.preference.PreferenceManager.OnActivityResultListener;
 import android.util.DisplayMetrics;
@@ -99,6 +103,9 @@ public class AxmolEngine {
     private static AxmolEngineListener sAxmolEngineListener;
     private static Set<OnActivityResultListener> onActivityResultListeners = new LinkedHashSet<OnActivityResultListener>();
     private static Vibrator sVibrateService = null;
+    private static PowerManager sPowerManager = null;
+    // PerformanceHintManager.Session, Android 12+
+    private static Object sPerformanceHintSession = null;
 
     // The absolute path to the OBB if it exists, else the absolute path to the APK.
     private static String sAssetsPath = "";
@@ -149,6 +156,7 @@ public class AxmolEngine {
             BitmapHelper.setContext(activity);
 
             AxmolEngine.sVibrateService = (Vibrator)activity.getSystemService(Context.VIBRATOR_SERVICE);
+            AxmolEngine.sPowerManager = (PowerManager)activity.getSystemService(Context.POWER_SERVICE);
 
             sInited = true;
         }
@@ -302,6 +310,65 @@ public class AxmolEngine {
         ((AxmolActivity)sActivity).selectionChanged();
     }
 
+    @SuppressLint("NewApi")
+    public static int getThermalStatus() {
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q && sPowerManager != null) {
+            return sPowerManager.getCurrentThermalStatus();
+        }
+        return PowerManager.THERMAL_STATUS_NONE;
+    }
+
+    @SuppressLint("NewApi")
+    public static float getThermalHeadroom(int forecastSeconds) {
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.R && sPowerManager != null) {
+            float headroom = sPowerManager.getThermalHeadroom(forecastSeconds);
+            // NaN when the device doesn't support it or it's called too often
+            if (!Float.isNaN(headroom)) {
+                return headroom;
+            }
+        }
+        return -1.0f;
+    }
+
+    public static float getBatteryLevel() {
+        BatteryManager batteryManager = (BatteryManager)sActivity.getSystemService(Context.BATTERY_SERVICE);
+        if (batteryManager != null) {
+            int capacity = batteryManager.getIntProperty(BatteryManager.BATTERY_PROPERTY_CAPACITY);
+            if (capacity >= 0 && capacity <= 100) {
+                return capacity / 100.0f;
+            }
+        }
+        return -1.0f;
+    }
+
+    public static boolean isPowerSaveMode() {
+        return sPowerManager != null && sPowerManager.isPowerSaveMode();
+    }
+
+    // called on the GL thread, the session hints the scheduler about that thread
+    @SuppressLint("NewApi")
+    public static void setTargetWorkDuration(long nanoseconds) {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.S || nanoseconds <= 0) {
+            return;
+        }
+        if (sPerformanceHintSession == null) {
+            PerformanceHintManager manager =
+                (PerformanceHintManager)sActivity.getSystemService(Context.PERFORMANCE_HINT_SERVICE);
+            if (manager != null) {
+                sPerformanceHintSession = manager.createHintSession(new int[]{Process.myTid()}, nanoseconds);
+            }
+        } else {
+            ((PerformanceHintManager.Session)sPerformanceHintSession).updateTargetWorkDuration(nanoseconds);
+        }
+    }
+
+    @SuppressLint("NewApi")
+    public static void reportActualWorkDuration(long nanoseconds) {
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.S && sPerformanceHintSession != null && nanoseconds > 0) {
+            ((PerformanceHintManager.Session)sPerformanceHintSession).reportActualWorkDuration(nanoseconds);
+        }
+    }
+
  	public static String getVersion() {
  		try {
  			String version = AxmolActivity.getContext().getPackageManager().getPackageInfo(AxmolActivity.getContext().getPackageName(), 0).versionName;
@@ -165,6 +165,7 @@ public class AxmolGLSurfaceView extends GLSurfaceView {
     @Override
     public void setRenderer(GLSurfaceView.Renderer renderer) {
         this.mRenderer = (AxmolRenderer) renderer;
+        this.mRenderer.setSurfaceView(this);
         super.setRenderer(this.mRenderer);
     }
 
@@ -25,6 +25,9 @@
 package dev.axmol.lib;
 
 import android.opengl.GLSurfaceView;
+import android.os.Build;
+import android.view.Display;
+import android.view.Surface;
 
 import javax.microedition.khronos.egl.EGLConfig;
 import javax.microedition.khronos.opengles.GL10;
@@ -39,12 +42,15 @@ public class AxmolRenderer implements GLSurfaceView.Renderer {
     // The final animation interval which is used in 'onDrawFrame'
     private static long sAnimationInterval = (long) (1.0f / 60f * AxmolRenderer.NANOSECONDSPERSECOND);
     private static long FPS_CONTROL_THRESHOLD = (long) (1.0f / 1200.0f * AxmolRenderer.NANOSECONDSPERSECOND);
+    private static volatile boolean sAnimationIntervalChanged = true;
 
     // ===========================================================
     // Fields
     // ===========================================================
 
     private long mLastTickInNanoSeconds;
+    private long mRefreshPeriod = (long) (1.0f / 60f * AxmolRenderer.NANOSECONDSPERSECOND);
+    private GLSurfaceView mSurfaceView;
     private int mScreenWidth;
     private int mScreenHeight;
     private static boolean gNativeInitialized = false;
@@ -61,6 +67,11 @@ public class AxmolRenderer implements GLSurfaceView.Renderer {
 
     public static void setAnimationInterval(float interval) {
         sAnimationInterval = (long) (interval * AxmolRenderer.NANOSECONDSPERSECOND);
+        sAnimationIntervalChanged = true;
+    }
+
+    public void setSurfaceView(final GLSurfaceView surfaceView) {
+        this.mSurfaceView = surfaceView;
     }
 
     public void setScreenWidthAndHeight(final int surfaceWidth, final int surfaceHeight) {
@@ -91,30 +102,67 @@ public class AxmolRenderer implements GLSurfaceView.Renderer {
     @Override
     public void onSurfaceChanged(final GL10 GL10, final int width, final int height) {
         AxmolRenderer.nativeOnSurfaceChanged(width, height);
+        sAnimationIntervalChanged = true;
     }
 
     @Override
     public void onDrawFrame(final GL10 gl) {
+        if (sAnimationIntervalChanged) {
+            sAnimationIntervalChanged = false;
+            this.updateFrameRate();
+        }
+
         /*
-         * Render time MUST be counted in, or the FPS will slower than appointed.
-         */
-        AxmolRenderer.nativeRender();
-        /*
-         * No need to use algorithm in default(60,90,120... FPS) situation,
-         * since onDrawFrame() was called by system 60 times per second by default.
+         * The buffer swap waits for a vsync, so the frames can only be spaced by whole refresh periods. Waiting for
+         * the rest of the interval after a frame made them alternate between two periods, wait instead until half
+         * a period before the deadline of the frame, its swap then lands on the right vsync.
          */
         if (AxmolRenderer.sAnimationInterval > AxmolRenderer.FPS_CONTROL_THRESHOLD) {
-            final long interval = System.nanoTime() - this.mLastTickInNanoSeconds;
+            final long periods = Math.max(1, Math.round((double) sAnimationInterval / this.mRefreshPeriod));
+            final long interval = periods * this.mRefreshPeriod;
+            long now = System.nanoTime();
+
+            if (periods > 1) {
+                final long deadline = this.mLastTickInNanoSeconds + interval - this.mRefreshPeriod / 2;
+                if (now < deadline) {
+                    try {
+                        Thread.sleep((deadline - now) / AxmolRenderer.NANOSECONDSPERMICROSECOND);
+                    } catch (final Exception e) {
+                    }
+                    now = System.nanoTime();
+                }
+            }
 
-            if (interval < AxmolRenderer.sAnimationInterval) {
+            // advance by the interval to keep the frames aligned, unless more than a frame late
+            final long next = this.mLastTickInNanoSeconds + interval;
+            this.mLastTickInNanoSeconds = now - next > interval ? now : next;
+        }
+
+        AxmolRenderer.nativeRender();
+    }
+
+    /*
+     * Ask the display for a refresh rate the animation interval divides, 90 and 120 Hz included, and read back the
+     * refresh period the pacing is aligned to.
+     */
+    private void updateFrameRate() {
+        if (this.mSurfaceView == null)
+            return;
+
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.R) {
+            final Surface surface = this.mSurfaceView.getHolder().getSurface();
+            if (surface != null && surface.isValid()) {
+                final float frameRate = (float) AxmolRenderer.NANOSECONDSPERSECOND / AxmolRenderer.sAnimationInterval;
                 try {
-                    Thread.sleep((AxmolRenderer.sAnimationInterval - interval) / AxmolRenderer.NANOSECONDSPERMICROSECOND);
+                    surface.setFrameRate(frameRate, Surface.FRAME_RATE_COMPATIBILITY_DEFAULT);
                 } catch (final Exception e) {
                 }
             }
-
-            this.mLastTickInNanoSeconds = System.nanoTime();
         }
+
+        final Display display = this.mSurfaceView.getDisplay();
+        if (display != null && display.getRefreshRate() > 0)
+            this.mRefreshPeriod = (long) (AxmolRenderer.NANOSECONDSPERSECOND / display.getRefreshRate());
     }
 
     // ===========================================================
@@ -762,4 +762,46 @@ void Device::selectionChanged()
 #endif
 }
 
+Device::ThermalState Device::getThermalState()
+{
+    switch ([NSProcessInfo processInfo].thermalState)
+    {
+    case NSProcessInfoThermalStateFair:
+        return ThermalState::FAIR;
+    case NSProcessInfoThermalStateSerious:
+        return ThermalState::SERIOUS;
+    case NSProcessInfoThermalStateCritical:
+        return ThermalState::CRITICAL;
+    default:
+        return ThermalState::NOMINAL;
+    }
+}
+
+float Device::getThermalHeadroom(int /*forecastSeconds*/)
+{
+    return -1.0f;
+}
+
+float Device::getBatteryLevel()
+{
+#if !defined(AX_TARGET_OS_TVOS)
+    UIDevice* device = [UIDevice currentDevice];
+    if (!device.batteryMonitoringEnabled)
+        device.batteryMonitoringEnabled = YES;
+    // -1 when the battery state is unknown, e.g. in the simulator
+    return device.batteryLevel;
+#else
+    return -1.0f;
+#endif
+}
+
+bool Device::isPowerSaveMode()
+{
+    return [NSProcessInfo processInfo].lowPowerModeEnabled;
+}
+
+void Device::setTargetWorkDuration(int64_t /*nanoseconds*/) {}
+
+void Device::reportActualWorkDuration(int64_t /*nanoseconds*/) {}
+
 }
@@ -28,6 +28,7 @@
 @interface CCDirectorCaller : NSObject {
     id displayLink;
     int interval;
+    NSInteger framesPerSecond;
     BOOL isAppActive;
     CFTimeInterval lastDisplayTime;
 }
@@ -39,6 +39,7 @@ static id s_sharedDirectorCaller;
 + (id)displayLinkWithTarget:(id)arg1 selector:(SEL)arg2;
 - (void)addToRunLoop:(id)arg1 forMode:(id)arg2;
 - (void)setFrameInterval:(NSInteger)interval;
+- (void)setPreferredFramesPerSecond:(NSInteger)framesPerSecond;
 - (void)invalidate;
 @end
 
@@ -78,7 +79,8 @@ static id s_sharedDirectorCaller;
                    name:UIApplicationWillResignActiveNotification
                  object:nil];
 
-        self.interval = 1;
+        self.interval   = 1;
+        framesPerSecond = 60;
     }
     return self;
 }
@@ -111,7 +113,12 @@ static id s_sharedDirectorCaller;
     [self stopMainLoop];
 
     displayLink = [NSClassFromString(@"CADisplayLink") displayLinkWithTarget:self selector:@selector(doCaller:)];
-    [displayLink setFrameInterval:self.interval];
+    // the preferred rate follows the display up to 120 Hz on ProMotion screens, and the system picks a rate the
+    // display can keep evenly. The frame interval is a divisor of 60 Hz
+    if ([displayLink respondsToSelector:@selector(setPreferredFramesPerSecond:)])
+        [displayLink setPreferredFramesPerSecond:framesPerSecond];
+    else
+        [displayLink setFrameInterval:self.interval];
     [displayLink addToRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
 }
 
@@ -126,11 +133,10 @@ static id s_sharedDirectorCaller;
     // Director::setAnimationInterval() is called, we should invalidate it first
     [self stopMainLoop];
 
-    self.interval = 60.0 * intervalNew;
+    framesPerSecond = MAX(1, (NSInteger)lround(1.0 / intervalNew));
+    self.interval   = MAX(1, (int)lround(60.0 * intervalNew));
 
-    displayLink = [NSClassFromString(@"CADisplayLink") displayLinkWithTarget:self selector:@selector(doCaller:)];
-    [displayLink setFrameInterval:self.interval];
-    [displayLink addToRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
+    [self startMainLoop];
 }
 
 - (void)doCaller:(id)sender
@@ -158,7 +164,7 @@ static id s_sharedDirectorCaller;
     CGFloat clockFrequency = (CGFloat)timeBaseInfo.denom / (CGFloat)timeBaseInfo.numer;
     clockFrequency *= 1000000000.0;
     // convert absolute time to seconds and should minus one frame time interval
-    lastDisplayTime = (mach_absolute_time() / clockFrequency) - ((1.0 / 60) * self.interval);
+    lastDisplayTime = (mach_absolute_time() / clockFrequency) - (1.0 / framesPerSecond);
 }
 
 @end
@@ -60,29 +60,30 @@ int Application::run()
         return 1;
     }
 
-    std::chrono::steady_clock::time_point lastTime{};
-
-    constexpr std::chrono::nanoseconds _1ms{1000000};
-
     auto director = Director::getInstance();
     auto glView   = director->getGLView();
 
     // Retain glView to avoid glView being released in the while loop
     glView->retain();
 
+    auto nextFrame = std::chrono::steady_clock::now();
     while (!glView->windowShouldClose())
     {
-        lastTime = std::chrono::steady_clock::now();
-
         director->mainLoop();
         glView->pollEvents();
 
-        auto interval = std::chrono::steady_clock::now() - lastTime;
-        auto waitDuration = _animationInterval - interval - _1ms;
-        if (waitDuration.count() > 0)
-            std::this_thread::sleep_for(waitDuration);
+        // wait for a deadline instead of the rest of the interval, so the oversleeps don't add up
+        nextFrame += _animationInterval;
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextFrame)
+            std::this_thread::sleep_until(nextFrame);
         else
+        {
+            // more than a frame late, restart the pacing instead of rushing the missed frames
+            if (now - nextFrame > _animationInterval)
+                nextFrame = now;
             std::this_thread::yield();
+        }
     }
 
     /* Only work on Desktop
@@ -454,4 +454,40 @@ void Device::prepareSelectionFeedbackGenerator() {}
 
 void Device::selectionChanged() {}
 
+Device::ThermalState Device::getThermalState()
+{
+    switch ([NSProcessInfo processInfo].thermalState)
+    {
+    case NSProcessInfoThermalStateFair:
+        return ThermalState::FAIR;
+    case NSProcessInfoThermalStateSerious:
+        return ThermalState::SERIOUS;
+    case NSProcessInfoThermalStateCritical:
+        return ThermalState::CRITICAL;
+    default:
+        return ThermalState::NOMINAL;
+    }
+}
+
+float Device::getThermalHeadroom(int /*forecastSeconds*/)
+{
+    return -1.0f;
+}
+
+float Device::getBatteryLevel()
+{
+    return -1.0f;
+}
+
+bool Device::isPowerSaveMode()
+{
+    if (@available(macOS 12.0, *))
+        return [NSProcessInfo processInfo].lowPowerModeEnabled;
+    return false;
+}
+
+void Device::setTargetWorkDuration(int64_t /*nanoseconds*/) {}
+
+void Device::reportActualWorkDuration(int64_t /*nanoseconds*/) {}
+
 }
@@ -103,7 +103,12 @@ int Application::run()
         interval = nNow.QuadPart - nLast.QuadPart;
         if (interval >= _animationInterval.QuadPart)
         {
-            nLast.QuadPart = nNow.QuadPart;
+            // advance by an interval instead of restarting from now, so the frames don't drift with the timer
+            // granularity, unless more than a frame late
+            if (interval < 2 * _animationInterval.QuadPart)
+                nLast.QuadPart += _animationInterval.QuadPart;
+            else
+                nLast.QuadPart = nNow.QuadPart;
             director->mainLoop();
             glView->pollEvents();
         }
@@ -511,4 +511,34 @@ void Device::prepareSelectionFeedbackGenerator() {}
 
 void Device::selectionChanged() {}
 
+Device::ThermalState Device::getThermalState()
+{
+    return ThermalState::NOMINAL;
+}
+
+float Device::getThermalHeadroom(int /*forecastSeconds*/)
+{
+    return -1.0f;
+}
+
+float Device::getBatteryLevel()
+{
+    SYSTEM_POWER_STATUS status;
+    // 128 means no system battery, 255 an unknown level
+    if (!GetSystemPowerStatus(&status) || (status.BatteryFlag & 128) || status.BatteryLifePercent > 100)
+        return -1.0f;
+    return status.BatteryLifePercent / 100.0f;
+}
+
+bool Device::isPowerSaveMode()
+{
+    SYSTEM_POWER_STATUS status;
+    // the battery saver
+    return GetSystemPowerStatus(&status) && status.SystemStatusFlag == 1;
+}
+
+void Device::setTargetWorkDuration(int64_t /*nanoseconds*/) {}
+
+void Device::reportActualWorkDuration(int64_t /*nanoseconds*/) {}
+
 }
@@ -575,6 +575,30 @@ void Device::prepareSelectionFeedbackGenerator() {}
 
 void Device::selectionChanged() {}
 
+Device::ThermalState Device::getThermalState()
+{
+    return ThermalState::NOMINAL;
+}
+
+float Device::getThermalHeadroom(int /*forecastSeconds*/)
+{
+    return -1.0f;
+}
+
+float Device::getBatteryLevel()
+{
+    return -1.0f;
+}
+
+bool Device::isPowerSaveMode()
+{
+    return false;
+}
+
+void Device::setTargetWorkDuration(int64_t /*nanoseconds*/) {}
+
+void Device::reportActualWorkDuration(int64_t /*nanoseconds*/) {}
+
 }
 
 #endif  // (AX_TARGET_PLATFORM == AX_PLATFORM_WINRT)
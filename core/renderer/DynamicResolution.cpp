@@ -0,0 +1,273 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/DynamicResolution.h"
+#include "renderer/Renderer.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramState.h"
+#include "renderer/backend/RenderTarget.h"
+#include "base/Director.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ax
+{
+
+namespace
+{
+// the delta time can't go below the vsync interval, a frame within this tolerance of the target was on time
+constexpr float VSYNC_TOLERANCE = 1.05f;
+// the weight of a new frame in the average frame time
+constexpr float SMOOTHING = 0.1f;
+}  // namespace
+
+DynamicResolution* DynamicResolution::create(float minScale, float maxScale)
+{
+    auto ret = new DynamicResolution();
+    ret->setScaleRange(minScale, maxScale);
+    ret->setScale(maxScale);
+    ret->autorelease();
+    return ret;
+}
+
+DynamicResolution::~DynamicResolution()
+{
+    releaseTarget();
+    AX_SAFE_RELEASE(_programState);
+}
+
+void DynamicResolution::setScaleRange(float minScale, float maxScale)
+{
+    _minScale = std::max(minScale, 0.1f);
+    _maxScale = std::max(maxScale, _minScale);
+    _scale    = std::clamp(_scale, _minScale, _maxScale);
+}
+
+void DynamicResolution::setScale(float scale)
+{
+    _scale    = std::clamp(scale, _minScale, _maxScale);
+    _cooldown = COOLDOWN_FRAMES;
+}
+
+bool DynamicResolution::update(float frameTime)
+{
+    if (!_adaptive || frameTime <= 0.0f)
+        return false;
+
+    // a single slow frame, a load or a hitch, shouldn't drop the resolution
+    _averageFrameTime =
+        _averageFrameTime > 0.0f ? _averageFrameTime + (frameTime - _averageFrameTime) * SMOOTHING : frameTime;
+
+    // the measured time lags behind a change, the GPU time is the one of a frame a few frames ago
+    if (_cooldown > 0)
+    {
+        --_cooldown;
+        return false;
+    }
+
+    // the time spent on the pixels goes with the square of the scale
+    float scale = _scale;
+    if (_averageFrameTime > _targetFrameTime)
+        scale = std::max(_scale * std::sqrt(_targetFrameTime / _averageFrameTime), _scale - MAX_SCALE_DOWN);
+    else if (_averageFrameTime < _targetFrameTime * _headroom)
+        scale = std::min(_scale * std::sqrt(_targetFrameTime * _headroom / _averageFrameTime), _scale + MAX_SCALE_UP);
+
+    scale = std::clamp(scale, _minScale, _maxScale);
+    if (std::abs(scale - _scale) < 0.01f)
+        return false;
+
+    _scale    = scale;
+    _cooldown = COOLDOWN_FRAMES;
+    return true;
+}
+
+float DynamicResolution::measureFrameTime(Renderer* renderer) const
+{
+    const auto& profile = renderer->getFrameProfile();
+    if (renderer->isProfilingEnabled() && profile.gpu > 0)
+        return static_cast<float>(profile.gpu);
+
+    // a frame on time is counted as one with headroom, or the scale would never recover
+    float deltaTime = Director::getInstance()->getDeltaTime() * 1000.0f;
+    return deltaTime <= _targetFrameTime * VSYNC_TOLERANCE ? _targetFrameTime * _headroom * 0.5f : deltaTime;
+}
+
+void DynamicResolution::begin(Renderer* renderer)
+{
+    // a camera may be rendered more than once in a frame, e.g. for each eye
+    auto director = Director::getInstance();
+    if (_lastFrame != director->getTotalFrames())
+    {
+        _lastFrame = director->getTotalFrames();
+        update(measureFrameTime(renderer));
+    }
+
+    // the viewport of the camera, the target is allocated for the largest scale so a change of scale is free
+    _oldViewport     = renderer->getViewport();
+    const int width  = std::max(1, static_cast<int>(std::ceil(_oldViewport.width * _maxScale)));
+    const int height = std::max(1, static_cast<int>(std::ceil(_oldViewport.height * _maxScale)));
+    if (width != _width || height != _height)
+    {
+        releaseTarget();
+        createTarget(width, height);
+    }
+    if (!_programState)
+        initCommand();
+
+    const int scaledWidth  = std::clamp(static_cast<int>(std::lround(_oldViewport.width * _scale)), 1, width);
+    const int scaledHeight = std::clamp(static_cast<int>(std::lround(_oldViewport.height * _scale)), 1, height);
+    Vec2 uvScale(static_cast<float>(scaledWidth) / width, static_cast<float>(scaledHeight) / height);
+    if (uvScale != _uvScale)
+    {
+        _uvScale = uvScale;
+        updateVertices(uvScale.x, uvScale.y);
+    }
+
+    _oldRenderTarget = renderer->getRenderTarget();
+    renderer->setRenderTarget(_renderTarget);
+    renderer->setViewPort(0, 0, scaledWidth, scaledHeight);
+
+    // the camera may only clear the depth, the last frame must not show through
+    renderer->clear(ClearFlag::ALL, Color4F(0, 0, 0, 0), 1.0f, 0, std::numeric_limits<float>::lowest());
+}
+
+void DynamicResolution::end(Renderer* renderer)
+{
+    renderer->setRenderTarget(_oldRenderTarget);
+    renderer->setViewPort(_oldViewport.x, _oldViewport.y, _oldViewport.width, _oldViewport.height);
+
+    Vec2 texelSize(1.0f / _width, 1.0f / _height);
+    _programState->setUniform(_locTexelSize, &texelSize, sizeof(texelSize));
+    _programState->setUniform(_locSharpness, &_sharpness, sizeof(_sharpness));
+
+    // drawn right away, before the next camera
+    _customCommand.init(0.0f);
+    renderer->addCommand(&_customCommand);
+    renderer->render();
+}
+
+void DynamicResolution::createTarget(int width, int height)
+{
+    // the depth and stencil are cleared in begin() and never read back, they don't need memory of their own
+    auto renderTargetPool = Director::getInstance()->getRenderer()->getRenderTargetPool();
+    _color =
+        renderTargetPool->acquireTexture(width, height, backend::PixelFormat::RGBA8, !!AX_ENABLE_PREMULTIPLIED_ALPHA);
+    _color->retain();
+    _color->setAntiAliasTexParameters();
+
+    _depthStencil = renderTargetPool->acquireTransientDepthStencil(width, height);
+    _depthStencil->retain();
+
+    _renderTarget = backend::DriverBase::getInstance()->newRenderTarget(
+        _color->getBackendTexture(), _depthStencil->getBackendTexture(), _depthStencil->getBackendTexture());
+    _renderTarget->setTransientAttachments(backend::TargetBufferFlags::DEPTH_AND_STENCIL);
+
+    _width   = width;
+    _height  = height;
+    _uvScale = Vec2::ZERO;
+    if (_programState)
+        _programState->setTexture(_locTexture, 0, _color->getBackendTexture());
+}
+
+void DynamicResolution::releaseTarget()
+{
+    AX_SAFE_RELEASE_NULL(_renderTarget);
+    AX_SAFE_RELEASE_NULL(_color);
+    AX_SAFE_RELEASE_NULL(_depthStencil);
+    _width = _height = 0;
+}
+
+void DynamicResolution::initCommand()
+{
+    auto program  = backend::Program::getBuiltinProgram(backend::ProgramType::UPSCALE_SHARPEN);
+    _programState = new backend::ProgramState(program);
+
+    _locMVPMatrix = _programState->getUniformLocation("u_MVPMatrix");
+    _locTexture   = _programState->getUniformLocation("u_tex0");
+    _locTexelSize = _programState->getUniformLocation("u_texelSize");
+    _locSharpness = _programState->getUniformLocation("u_sharpness");
+
+    // the quad is given in normalized device coordinates
+    _programState->setUniform(_locMVPMatrix, Mat4::IDENTITY.m, sizeof(Mat4::IDENTITY.m));
+    _programState->setTexture(_locTexture, 0, _color->getBackendTexture());
+
+    auto& pipelineDescriptor        = _customCommand.getPipelineDescriptor();
+    pipelineDescriptor.programState = _programState;
+
+    // the transparent parts of the offscreen target let the previous cameras show through
+    auto& blend                     = pipelineDescriptor.blendDescriptor;
+    blend.blendEnabled              = true;
+    blend.sourceRGBBlendFactor      = blend.sourceAlphaBlendFactor      = backend::BlendFactor::ONE;
+    blend.destinationRGBBlendFactor = blend.destinationAlphaBlendFactor = backend::BlendFactor::ONE_MINUS_SRC_ALPHA;
+
+    _vertices.resize(4);
+    _vertices[0].vertices = Vec3(-1, -1, 0);
+    _vertices[1].vertices = Vec3(1, -1, 0);
+    _vertices[2].vertices = Vec3(1, 1, 0);
+    _vertices[3].vertices = Vec3(-1, 1, 0);
+
+    _vertices[0].colors = _vertices[1].colors = _vertices[2].colors = _vertices[3].colors = Color4B::WHITE;
+
+    uint16_t indices[6] = {0, 1, 2, 2, 3, 0};
+    _customCommand.createVertexBuffer(sizeof(_vertices[0]), _vertices.size(), CustomCommand::BufferUsage::DYNAMIC);
+    _customCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, sizeof(indices) / sizeof(indices[0]),
+                                     CustomCommand::BufferUsage::STATIC);
+    _customCommand.updateIndexBuffer(indices, sizeof(indices));
+
+    _customCommand.setBeforeCallback(AX_CALLBACK_0(DynamicResolution::onBeforeDraw, this));
+    _customCommand.setAfterCallback(AX_CALLBACK_0(DynamicResolution::onAfterDraw, this));
+}
+
+void DynamicResolution::updateVertices(float u, float v)
+{
+    // the scaled image is in the corner of the target where the viewport starts
+#if defined(AX_USE_GL)
+    _vertices[0].texCoords = Tex2F(0, 0);
+    _vertices[1].texCoords = Tex2F(u, 0);
+    _vertices[2].texCoords = Tex2F(u, v);
+    _vertices[3].texCoords = Tex2F(0, v);
+#else
+    _vertices[0].texCoords = Tex2F(0, 1);
+    _vertices[1].texCoords = Tex2F(u, 1);
+    _vertices[2].texCoords = Tex2F(u, 1 - v);
+    _vertices[3].texCoords = Tex2F(0, 1 - v);
+#endif
+    _customCommand.updateVertexBuffer(_vertices.data(), sizeof(_vertices[0]) * _vertices.size());
+}
+
+void DynamicResolution::onBeforeDraw()
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    _depthTest    = renderer->getDepthTest();
+    renderer->setDepthTest(false);
+}
+
+void DynamicResolution::onAfterDraw()
+{
+    Director::getInstance()->getRenderer()->setDepthTest(_depthTest);
+}
+
+}  // namespace ax
@@ -0,0 +1,160 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "base/Object.h"
+#include "renderer/CustomCommand.h"
+#include "base/Types.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+class Renderer;
+class Texture2D;
+
+namespace backend
+{
+class ProgramState;
+class RenderTarget;
+}  // namespace backend
+
+/**
+ Renders what a camera sees at a fraction of the screen resolution, see `Camera::setDynamicResolution`.
+ The camera draws into an offscreen target, which is upscaled to the viewport with a sharpening filter before the
+ next camera draws, so a 3D camera can be scaled while the UI camera drawn after it stays native.
+
+ The scale is driven by the GPU time of the frames when the renderer profiling is enabled and the backend has GPU
+ timers, see `Renderer::setProfilingEnabled`, otherwise by the delta time of the Director.
+*/
+class AX_DLL DynamicResolution : public Object
+{
+public:
+    /** The frames to wait after a change of the scale before the next one, so the time can settle. */
+    static constexpr int COOLDOWN_FRAMES = 15;
+    /** The largest change of the scale in a frame, the scale drops faster than it recovers. */
+    static constexpr float MAX_SCALE_DOWN = 0.1f;
+    static constexpr float MAX_SCALE_UP   = 0.05f;
+
+    static DynamicResolution* create(float minScale = 0.5f, float maxScale = 1.0f);
+
+    DynamicResolution() = default;
+    ~DynamicResolution() override;
+
+    /** The frame time to stay under in milliseconds, 1000 / 60 by default. */
+    void setTargetFrameTime(float milliseconds) { _targetFrameTime = milliseconds; }
+    float getTargetFrameTime() const { return _targetFrameTime; }
+
+    /**
+     * The scale only goes up again when the frame time is below this fraction of the target time, 0.8 by default.
+     * The gap between both keeps the scale from oscillating.
+     */
+    void setHeadroom(float headroom) { _headroom = headroom; }
+    float getHeadroom() const { return _headroom; }
+
+    /** The range of the scale of the resolution, the offscreen target is allocated for the largest one. */
+    void setScaleRange(float minScale, float maxScale);
+    float getMinScale() const { return _minScale; }
+    float getMaxScale() const { return _maxScale; }
+
+    /** Set the scale of the resolution, it is clamped to the scale range. */
+    void setScale(float scale);
+    float getScale() const { return _scale; }
+
+    /** Whether the scale follows the frame time, true by default. Disable it to set the scale manually. */
+    void setAdaptive(bool adaptive) { _adaptive = adaptive; }
+    bool isAdaptive() const { return _adaptive; }
+
+    /** The strength of the sharpening of the upscale, from 0 (bilinear only) to 1. 0.5 by default. */
+    void setSharpness(float sharpness) { _sharpness = sharpness; }
+    float getSharpness() const { return _sharpness; }
+
+    /**
+     * Feed the time of a frame in milliseconds to the controller, called once per frame by `begin`.
+     * @return true if the scale changed.
+     */
+    bool update(float frameTime);
+
+    /** The time the controller works with, the frame times smoothed over the last frames. */
+    float getAverageFrameTime() const { return _averageFrameTime; }
+
+    /**
+     * Redirect the rendering to the scaled offscreen target, called by `Scene::render` after the camera was applied.
+     */
+    void begin(Renderer* renderer);
+
+    /** Restore the render target and draw the upscaled image, after the camera rendered. */
+    void end(Renderer* renderer);
+
+protected:
+    float measureFrameTime(Renderer* renderer) const;
+    void createTarget(int width, int height);
+    void releaseTarget();
+    void initCommand();
+    void updateVertices(float u, float v);
+    void onBeforeDraw();
+    void onAfterDraw();
+
+    float _targetFrameTime  = 1000.0f / 60.0f;
+    float _headroom         = 0.8f;
+    float _minScale         = 0.5f;
+    float _maxScale         = 1.0f;
+    float _scale            = 1.0f;
+    float _sharpness        = 0.5f;
+    float _averageFrameTime = 0.0f;
+    int _cooldown           = 0;
+    bool _adaptive          = true;
+
+    unsigned int _lastFrame = 0;
+    int _width              = 0;
+    int _height             = 0;
+    Vec2 _uvScale;
+    Texture2D* _color                       = nullptr;
+    Texture2D* _depthStencil                = nullptr;
+    backend::RenderTarget* _renderTarget    = nullptr;
+    backend::RenderTarget* _oldRenderTarget = nullptr;
+    Viewport _oldViewport;
+
+    backend::ProgramState* _programState = nullptr;
+    backend::UniformLocation _locMVPMatrix;
+    backend::UniformLocation _locTexture;
+    backend::UniformLocation _locTexelSize;
+    backend::UniformLocation _locSharpness;
+    CustomCommand _customCommand;
+    std::vector<V3F_C4B_T2F> _vertices;
+    bool _depthTest = false;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -0,0 +1,134 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/InstancedBillBoardCommand.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <string.h>
+
+namespace ax
+{
+
+static const size_t INSTANCE_RESERVED_SIZE = 64;
+
+bool InstancedBillBoardCommand::makeInstance(const V3F_C4B_T2F_Quad& quad,
+                                             const Vec2& anchorPoint,
+                                             const Mat4& transform,
+                                             bool viewPlaneOriented,
+                                             Instance& instance)
+{
+    const auto& bl = quad.bl.vertices;
+    const auto& br = quad.br.vertices;
+    const auto& tl = quad.tl.vertices;
+    const auto& tr = quad.tr.vertices;
+    if (bl.y != br.y || bl.x != tl.x || tr.x != br.x || tr.y != tl.y || bl.z != 0 || br.z != 0 || tl.z != 0 ||
+        tr.z != 0)
+        return false;
+
+    // one color per instance
+    const auto& color = quad.bl.colors;
+    if (quad.br.colors != color || quad.tl.colors != color || quad.tr.colors != color)
+        return false;
+
+    float flags = viewPlaneOriented ? 1.0f : 0.0f;
+
+    Tex2F uvX(quad.br.texCoords.u - quad.bl.texCoords.u, quad.br.texCoords.v - quad.bl.texCoords.v);
+    Tex2F uvY(quad.tl.texCoords.u - quad.bl.texCoords.u, quad.tl.texCoords.v - quad.bl.texCoords.v);
+    if (uvX.v == 0 && uvY.u == 0)
+    {
+        instance.uvSize = Tex2F(uvX.u, uvY.v);
+    }
+    else if (uvX.u == 0 && uvY.v == 0)
+    {
+        // rotated texture rect: the shader swaps the quad coordinates
+        instance.uvSize = Tex2F(uvY.u, uvX.v);
+        flags += 2.0f;
+    }
+    else
+        return false;
+
+    // the billboard keeps the scale of its transform, not its rotation
+    const float scaleX = Vec3(transform.m[0], transform.m[1], transform.m[2]).length();
+    const float scaleY = Vec3(transform.m[4], transform.m[5], transform.m[6]).length();
+
+    transform.transformPoint(Vec3(anchorPoint.x, anchorPoint.y, 0), &instance.anchor);
+    instance.flags = flags;
+    instance.offset.set((bl.x - anchorPoint.x) * scaleX, (bl.y - anchorPoint.y) * scaleY);
+    instance.size.set((br.x - bl.x) * scaleX, (tl.y - bl.y) * scaleY);
+    instance.uvOrigin = quad.bl.texCoords;
+    instance.color    = Color4F(color);
+    return true;
+}
+
+InstancedBillBoardCommand::InstancedBillBoardCommand()
+    : InstancedCommand(backend::ProgramType::POSITION_TEXTURE_COLOR_BILLBOARD_INSTANCE, INSTANCE_RESERVED_SIZE)
+{
+    setTransparent(true);
+    set3D(true);
+
+    _vpMatrixLocation      = _programState->getUniformLocation("u_VPMatrix");
+    _cameraPosLocation     = _programState->getUniformLocation("u_cameraPos");
+    _cameraUpLocation      = _programState->getUniformLocation("u_cameraUp");
+    _cameraForwardLocation = _programState->getUniformLocation("u_cameraForward");
+}
+
+void InstancedBillBoardCommand::init(float depth,
+                                     Texture2D* texture,
+                                     const BlendFunc& blendFunc,
+                                     const Mat4& projection,
+                                     const Mat4& cameraTransform)
+{
+    CustomCommand::init(0, blendFunc);
+    _depth = depth;
+
+    _texture         = texture->getBackendTexture();
+    _blendFunc       = blendFunc;
+    _projection      = projection;
+    _cameraTransform = cameraTransform;
+    _instances.clear();
+
+    // the camera axes, the shader turns the quads with them
+    const Vec3 cameraPos(cameraTransform.m[12], cameraTransform.m[13], cameraTransform.m[14]);
+    Vec3 cameraUp, cameraForward;
+    cameraTransform.transformVector(Vec3(0.0f, 1.0f, 0.0f), &cameraUp);
+    cameraTransform.transformVector(Vec3(0.0f, 0.0f, -1.0f), &cameraForward);
+
+    _programState->setTexture(_texture);
+    _programState->setUniform(_vpMatrixLocation, projection.m, sizeof(projection.m));
+    _programState->setUniform(_cameraPosLocation, &cameraPos, sizeof(cameraPos));
+    _programState->setUniform(_cameraUpLocation, &cameraUp, sizeof(cameraUp));
+    _programState->setUniform(_cameraForwardLocation, &cameraForward, sizeof(cameraForward));
+}
+
+bool InstancedBillBoardCommand::isCompatible(Texture2D* texture,
+                                             const BlendFunc& blendFunc,
+                                             const Mat4& projection,
+                                             const Mat4& cameraTransform) const
+{
+    return _texture == texture->getBackendTexture() && _blendFunc == blendFunc &&
+           memcmp(_projection.m, projection.m, sizeof(projection.m)) == 0 &&
+           memcmp(_cameraTransform.m, cameraTransform.m, sizeof(cameraTransform.m)) == 0;
+}
+
+}  // namespace ax
@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "renderer/InstancedCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+namespace backend
+{
+class TextureBackend;
+}  // namespace backend
+
+class Texture2D;
+
+/**The per instance data of `InstancedBillBoardCommand`, it matches the layout of the mat4 instance attribute.*/
+struct BillBoardInstance
+{
+    Vec3 anchor;     ///< the anchor point, in world coordinates
+    float flags;     ///< 1 when oriented to the view plane, +2 when the texture rect is rotated
+    Vec2 offset;     ///< the quad bottom left corner from the anchor point, scaled
+    Vec2 size;       ///< the quad size, scaled
+    Tex2F uvOrigin;  ///< the texture coordinates of the bottom left corner
+    Tex2F uvSize;    ///< the texture coordinates delta along the width and the height
+    Color4F color;
+};
+
+/**
+ Command used to draw many billboard quads sharing a texture and a blend function with one instanced draw.
+ The vertex shader turns every quad towards the camera, so the billboards don't compute a rotation matrix on the CPU.
+ The billboards of a command are drawn in the order they were added, they aren't sorted by depth with each other.
+ The commands are owned and pooled by the renderer, see `Renderer::addInstancedBillBoard`.
+*/
+class AX_DLL InstancedBillBoardCommand : public InstancedCommand<BillBoardInstance>
+{
+public:
+    /**
+    Convert a billboard quad to an instance.
+    @param quad the quad, in the billboard coordinates.
+    @param anchorPoint the point the billboard turns around, in the billboard coordinates.
+    @param transform the billboard to world transform, only its translation and scale are kept.
+    @param viewPlaneOriented whether the quad faces the view plane rather than the camera position.
+    @return false if the quad isn't a rectangle with one color and aligned texture coordinates.
+    */
+    static bool makeInstance(const V3F_C4B_T2F_Quad& quad,
+                             const Vec2& anchorPoint,
+                             const Mat4& transform,
+                             bool viewPlaneOriented,
+                             Instance& instance);
+
+    InstancedBillBoardCommand();
+
+    /**Init the command for the billboards seen by a camera, the instances queued previously are discarded.*/
+    void init(float depth,
+              Texture2D* texture,
+              const BlendFunc& blendFunc,
+              const Mat4& projection,
+              const Mat4& cameraTransform);
+
+    /**Whether a billboard with these properties can be added to this command.*/
+    bool isCompatible(Texture2D* texture,
+                      const BlendFunc& blendFunc,
+                      const Mat4& projection,
+                      const Mat4& cameraTransform) const;
+
+protected:
+    backend::UniformLocation _vpMatrixLocation;
+    backend::UniformLocation _cameraPosLocation;
+    backend::UniformLocation _cameraUpLocation;
+    backend::UniformLocation _cameraForwardLocation;
+
+    backend::TextureBackend* _texture = nullptr;
+    BlendFunc _blendFunc              = BlendFunc::DISABLE;
+    Mat4 _projection;
+    Mat4 _cameraTransform;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
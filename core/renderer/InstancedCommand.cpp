@@ -0,0 +1,71 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/InstancedCommand.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramState.h"
+#include "renderer/backend/Buffer.h"
+
+namespace ax
+{
+
+InstancedQuadCommand::InstancedQuadCommand(uint32_t programType)
+{
+    // the unit quad, with the vertex order and indices of a sprite quad
+    static const Vec2 vertices[] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    static const uint16_t indices[] = {0, 1, 2, 3, 2, 1};
+
+    createVertexBuffer(sizeof(Vec2), 4, BufferUsage::STATIC);
+    updateVertexBuffer(vertices, sizeof(vertices));
+    createIndexBuffer(IndexFormat::U_SHORT, 6, BufferUsage::STATIC);
+    updateIndexBuffer(indices, sizeof(indices));
+    setIndexDrawInfo(0, 6);
+    setDrawType(DrawType::ELEMENT_INSTANCE);
+
+    _programState                    = new backend::ProgramState(backend::Program::getBuiltinProgram(programType));
+    _pipelineDescriptor.programState = _programState;
+}
+
+InstancedQuadCommand::~InstancedQuadCommand()
+{
+    AX_SAFE_RELEASE(_instanceBuffer);
+    AX_SAFE_RELEASE(_programState);
+}
+
+void InstancedQuadCommand::uploadInstances(const void* instances, size_t count, size_t instanceSize)
+{
+    if (count > _instanceCapacity)
+    {
+        // grow geometrically to avoid recreating the buffer every frame while the scene grows
+        _instanceCapacity = (std::max)(count, _instanceCapacity * 2);
+        AX_SAFE_RELEASE(_instanceBuffer);
+        _instanceBuffer = backend::DriverBase::getInstance()->newBuffer(
+            _instanceCapacity * instanceSize, backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
+    }
+
+    if (count > 0)
+        _instanceBuffer->updateSubData(instances, 0, count * instanceSize);
+    setInstanceBuffer(_instanceBuffer, static_cast<int>(count));
+}
+
+}  // namespace ax
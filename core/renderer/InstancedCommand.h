@@ -0,0 +1,164 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "renderer/CustomCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+namespace backend
+{
+class TextureBackend;
+class ProgramState;
+}  // namespace backend
+
+/**
+ The base of the commands drawing many quads with one instanced draw of a shared unit quad, the vertex shader maps
+ the unit quad with the per instance data. It owns the program state of the command and the instance buffer.
+*/
+class AX_DLL InstancedQuadCommand : public CustomCommand
+{
+public:
+    ~InstancedQuadCommand();
+
+protected:
+    /**Creates the unit quad, with the vertex order and indices of a sprite quad, and a state of the builtin program.*/
+    explicit InstancedQuadCommand(uint32_t programType);
+
+    /**Upload the instances to the instance buffer and draw all of them.*/
+    void uploadInstances(const void* instances, size_t count, size_t instanceSize);
+
+    backend::Buffer* _instanceBuffer = nullptr;
+    size_t _instanceCapacity         = 0;
+
+    backend::ProgramState* _programState = nullptr;
+};
+
+/**
+ An `InstancedQuadCommand` queuing instances of the type `_Instance`, which must match the layout of the mat4
+ instance attribute.
+*/
+template <typename _Instance>
+class InstancedCommand : public InstancedQuadCommand
+{
+public:
+    using Instance = _Instance;
+    static_assert(sizeof(Instance) == sizeof(float) * 16, "Instance must be a mat4");
+
+    void addInstance(const Instance& instance) { _instances.emplace_back(instance); }
+    size_t getQueuedInstanceCount() const { return _instances.size(); }
+
+    /**Upload the queued instances, the renderer invokes it once before rendering the frame.*/
+    void commit() { uploadInstances(_instances.data(), _instances.size(), sizeof(Instance)); }
+
+protected:
+    InstancedCommand(uint32_t programType, size_t reservedInstances) : InstancedQuadCommand(programType)
+    {
+        _instances.reserve(reservedInstances);
+    }
+
+    std::vector<Instance> _instances;
+};
+
+/**
+ The pool of the instanced commands of a type, owned by the renderer. The used commands are at the front, they are
+ reused by the next frame once `reset` is invoked.
+*/
+template <typename _Command>
+class InstancedCommandPool
+{
+public:
+    InstancedCommandPool() = default;
+    InstancedCommandPool(const InstancedCommandPool&)            = delete;
+    InstancedCommandPool& operator=(const InstancedCommandPool&) = delete;
+    ~InstancedCommandPool() { destroy(); }
+
+    /**
+    The last command obtained from the pool if it's still the last one of the render queue, so an instance added to
+    it keeps the draw order, or nullptr.
+    */
+    _Command* getJoinable(int renderQueueID, ssize_t queueSize) const
+    {
+        return _used > 0 && _lastQueueID == renderQueueID && _lastQueueSize == queueSize ? _commands[_used - 1]
+                                                                                        : nullptr;
+    }
+
+    /**Obtain a command for a new batch, `allocated` is set when a command had to be created.*/
+    _Command* obtain(bool& allocated)
+    {
+        allocated = _used == _commands.size();
+        if (allocated)
+            _commands.emplace_back(new _Command());
+        return _commands[_used++];
+    }
+
+    /**Remember the render queue and its size once the command obtained last was added to it.*/
+    void setLastQueue(int renderQueueID, ssize_t queueSize)
+    {
+        _lastQueueID   = renderQueueID;
+        _lastQueueSize = queueSize;
+    }
+
+    void commit()
+    {
+        for (size_t i = 0; i < _used; ++i)
+            _commands[i]->commit();
+    }
+
+    void reset()
+    {
+        _used        = 0;
+        _lastQueueID = -1;
+    }
+
+    void destroy()
+    {
+        for (auto&& cmd : _commands)
+            delete cmd;
+        _commands.clear();
+        reset();
+    }
+
+private:
+    std::vector<_Command*> _commands;
+    size_t _used = 0;
+    // the queue and its size when the last command was added, an instance joins it only if nothing was added since
+    int _lastQueueID       = -1;
+    ssize_t _lastQueueSize = 0;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/InstancedProgressCommand.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <cmath>
+#include <string.h>
+
+namespace ax
+{
+
+static const size_t INSTANCE_RESERVED_SIZE = 16;
+static const float RECTANGLE_TOLERANCE     = 1e-3f;
+
+bool InstancedProgressCommand::makeInstance(const V3F_C4B_T2F_Quad& quad,
+                                            bool rotated,
+                                            const Mat4& mv,
+                                            float progress,
+                                            Instance& instance)
+{
+    // the sprite must be flat and face the camera, the unit quad is mapped in 2D
+    const auto& bl = quad.bl.vertices;
+    const auto& br = quad.br.vertices;
+    const auto& tl = quad.tl.vertices;
+    const auto& tr = quad.tr.vertices;
+    if (mv.m[2] != 0 || mv.m[6] != 0 || bl.z != br.z || bl.z != tl.z || bl.z != tr.z)
+        return false;
+
+    // like ProgressTimer, only the bottom left and the top right corners are used, the quad must be a rectangle
+    if (std::abs(br.x - tr.x) > RECTANGLE_TOLERANCE || std::abs(br.y - bl.y) > RECTANGLE_TOLERANCE ||
+        std::abs(tl.x - bl.x) > RECTANGLE_TOLERANCE || std::abs(tl.y - tr.y) > RECTANGLE_TOLERANCE)
+        return false;
+
+    // one color per instance
+    const auto& color = quad.bl.colors;
+    if (quad.br.colors != color || quad.tl.colors != color || quad.tr.colors != color)
+        return false;
+
+    mv.transformPoint(bl, &instance.origin);
+
+    const float width  = tr.x - bl.x;
+    const float height = tr.y - bl.y;
+    instance.axisX.set(mv.m[0] * width, mv.m[1] * width);
+    instance.axisY.set(mv.m[4] * height, mv.m[5] * height);
+
+    instance.progress = clampf(progress, 0, 1) + (rotated ? 2.0f : 0.0f);
+    instance.uvOrigin = quad.bl.texCoords;
+    instance.uvSize   = Tex2F(quad.tr.texCoords.u - quad.bl.texCoords.u, quad.tr.texCoords.v - quad.bl.texCoords.v);
+    instance.color    = Color4F(color);
+    return true;
+}
+
+InstancedProgressCommand::InstancedProgressCommand()
+    : InstancedCommand(backend::ProgramType::PROGRESS_INSTANCE, INSTANCE_RESERVED_SIZE)
+{
+    _mvpMatrixLocation = _programState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+    _shapeLocation     = _programState->getUniformLocation("u_shape");
+    _modeLocation      = _programState->getUniformLocation("u_mode");
+}
+
+void InstancedProgressCommand::init(float globalZOrder,
+                                    Texture2D* texture,
+                                    const BlendFunc& blendFunc,
+                                    const Mat4& projection,
+                                    const ProgressShape& shape)
+{
+    CustomCommand::init(globalZOrder, blendFunc);
+
+    _texture    = texture->getBackendTexture();
+    _blendFunc  = blendFunc;
+    _projection = projection;
+    _shape      = shape;
+    _instances.clear();
+
+    const Vec4 shapeParams(shape.midpoint.x, shape.midpoint.y, shape.barChangeRate.x, shape.barChangeRate.y);
+    const float mode = (shape.bar ? 2.0f : 0.0f) + (shape.reverse ? 1.0f : 0.0f);
+
+    _programState->setTexture(_texture);
+    _programState->setUniform(_mvpMatrixLocation, projection.m, sizeof(projection.m));
+    _programState->setUniform(_shapeLocation, &shapeParams, sizeof(shapeParams));
+    _programState->setUniform(_modeLocation, &mode, sizeof(mode));
+}
+
+bool InstancedProgressCommand::isCompatible(float globalZOrder,
+                                            Texture2D* texture,
+                                            const BlendFunc& blendFunc,
+                                            const Mat4& projection,
+                                            const ProgressShape& shape) const
+{
+    return _globalOrder == globalZOrder && _texture == texture->getBackendTexture() && _blendFunc == blendFunc &&
+           _shape.bar == shape.bar && _shape.reverse == shape.reverse && _shape.midpoint == shape.midpoint &&
+           (!shape.bar || _shape.barChangeRate == shape.barChangeRate) &&
+           memcmp(_projection.m, projection.m, sizeof(projection.m)) == 0;
+}
+
+}  // namespace ax
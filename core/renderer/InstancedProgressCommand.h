@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "renderer/InstancedCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+namespace backend
+{
+class TextureBackend;
+}  // namespace backend
+
+class Texture2D;
+
+/** The progress of a progress timer drawn by `InstancedProgressCommand`, see `ProgressTimer`. */
+struct ProgressShape
+{
+    float progress = 0;  ///< from 0 to 1
+    Vec2 midpoint;
+    Vec2 barChangeRate;
+    bool bar     = false;
+    bool reverse = false;
+};
+
+/**The per instance data of `InstancedProgressCommand`, it matches the layout of the mat4 instance attribute.*/
+struct ProgressInstance
+{
+    Vec2 axisX;      ///< the sprite bottom edge
+    Vec2 axisY;      ///< the sprite left edge
+    Vec3 origin;     ///< the sprite bottom left corner
+    float progress;  ///< from 0 to 1, +2 when the texture rect is rotated
+    Tex2F uvOrigin;  ///< the texture coordinates of the bottom left corner
+    Tex2F uvSize;    ///< the texture coordinates of the top right corner minus uvOrigin
+    Color4F color;
+};
+
+/**
+ Command used to draw many progress timers sharing a texture, a blend function and a shape with one instanced draw.
+ The geometry of a timer is its whole sprite quad, the shaders hide the part which isn't reached by its progress,
+ so changing the percentage only changes one float of its `Instance`.
+ The commands are owned and pooled by the renderer, see `Renderer::addInstancedProgress`.
+*/
+class AX_DLL InstancedProgressCommand : public InstancedCommand<ProgressInstance>
+{
+public:
+    /**
+    Convert a sprite quad transformed by the model view to an instance.
+    @return false if the quad isn't a rectangle with one color in a plane facing the camera, so it can't be drawn
+    instanced.
+    */
+    static bool makeInstance(const V3F_C4B_T2F_Quad& quad,
+                             bool rotated,
+                             const Mat4& mv,
+                             float progress,
+                             Instance& instance);
+
+    InstancedProgressCommand();
+
+    /**Init the command for the timers of a shape, the instances queued previously are discarded.*/
+    void init(float globalZOrder,
+              Texture2D* texture,
+              const BlendFunc& blendFunc,
+              const Mat4& projection,
+              const ProgressShape& shape);
+
+    /**Whether a timer with these properties can be added to this command, its progress doesn't matter.*/
+    bool isCompatible(float globalZOrder,
+                      Texture2D* texture,
+                      const BlendFunc& blendFunc,
+                      const Mat4& projection,
+                      const ProgressShape& shape) const;
+
+protected:
+    backend::UniformLocation _mvpMatrixLocation;
+    backend::UniformLocation _shapeLocation;
+    backend::UniformLocation _modeLocation;
+
+    backend::TextureBackend* _texture = nullptr;
+    BlendFunc _blendFunc              = BlendFunc::DISABLE;
+    Mat4 _projection;
+    ProgressShape _shape;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
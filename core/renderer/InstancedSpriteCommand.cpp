@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/InstancedSpriteCommand.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <cmath>
+#include <string.h>
+
+namespace ax
+{
+
+static const size_t INSTANCE_RESERVED_SIZE = 64;
+static const float PARALLELOGRAM_TOLERANCE = 1e-3f;
+
+bool InstancedSpriteCommand::makeInstance(const V3F_C4B_T2F_Quad& quad, const Mat4& mv, Instance& instance)
+{
+    // the quad must be flat and face the camera, the unit quad is mapped in 2D
+    if (mv.m[2] != 0 || mv.m[6] != 0 || quad.bl.vertices.z != quad.br.vertices.z ||
+        quad.bl.vertices.z != quad.tl.vertices.z)
+        return false;
+
+    const auto& bl = quad.bl.vertices;
+    const auto& br = quad.br.vertices;
+    const auto& tl = quad.tl.vertices;
+    const auto& tr = quad.tr.vertices;
+    if (std::abs(tr.x - (br.x + tl.x - bl.x)) > PARALLELOGRAM_TOLERANCE ||
+        std::abs(tr.y - (br.y + tl.y - bl.y)) > PARALLELOGRAM_TOLERANCE)
+        return false;
+
+    // one color per instance
+    const auto& color = quad.bl.colors;
+    if (quad.br.colors != color || quad.tl.colors != color || quad.tr.colors != color)
+        return false;
+
+    Vec3 origin;
+    mv.transformPoint(bl, &origin);
+
+    Vec2 axisX(br.x - bl.x, br.y - bl.y);
+    Vec2 axisY(tl.x - bl.x, tl.y - bl.y);
+
+    Tex2F uvX(quad.br.texCoords.u - quad.bl.texCoords.u, quad.br.texCoords.v - quad.bl.texCoords.v);
+    Tex2F uvY(quad.tl.texCoords.u - quad.bl.texCoords.u, quad.tl.texCoords.v - quad.bl.texCoords.v);
+    if (uvX.v == 0 && uvY.u == 0)
+    {
+        instance.uvSize = Tex2F(uvX.u, uvY.v);
+    }
+    else if (uvX.u == 0 && uvY.v == 0)
+    {
+        // rotated texture rect: swap the axes so the texture u coordinate follows axisX
+        std::swap(axisX, axisY);
+        instance.uvSize = Tex2F(uvY.u, uvX.v);
+    }
+    else
+        return false;
+
+    instance.axisX.set(mv.m[0] * axisX.x + mv.m[4] * axisX.y, mv.m[1] * axisX.x + mv.m[5] * axisX.y);
+    instance.axisY.set(mv.m[0] * axisY.x + mv.m[4] * axisY.y, mv.m[1] * axisY.x + mv.m[5] * axisY.y);
+    instance.origin   = origin;
+    instance.reserved = 0;
+    instance.uvOrigin = quad.bl.texCoords;
+
+    instance.color    = Color4F(color);
+    return true;
+}
+
+InstancedSpriteCommand::InstancedSpriteCommand()
+    : InstancedCommand(backend::ProgramType::POSITION_TEXTURE_COLOR_INSTANCE, INSTANCE_RESERVED_SIZE)
+{
+    _mvpMatrixLocation = _programState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+}
+
+void InstancedSpriteCommand::init(float globalZOrder,
+                                  Texture2D* texture,
+                                  const BlendFunc& blendFunc,
+                                  const Mat4& projection)
+{
+    CustomCommand::init(globalZOrder, blendFunc);
+
+    _texture    = texture->getBackendTexture();
+    _blendFunc  = blendFunc;
+    _projection = projection;
+    _instances.clear();
+
+    _programState->setTexture(_texture);
+    _programState->setUniform(_mvpMatrixLocation, projection.m, sizeof(projection.m));
+}
+
+bool InstancedSpriteCommand::isCompatible(float globalZOrder,
+                                          Texture2D* texture,
+                                          const BlendFunc& blendFunc,
+                                          const Mat4& projection) const
+{
+    return _globalOrder == globalZOrder && _texture == texture->getBackendTexture() && _blendFunc == blendFunc &&
+           memcmp(_projection.m, projection.m, sizeof(projection.m)) == 0;
+}
+
+}  // namespace ax
@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "renderer/InstancedCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+namespace backend
+{
+class TextureBackend;
+}  // namespace backend
+
+class Texture2D;
+
+/**The per instance data of `InstancedSpriteCommand`, it matches the layout of the mat4 instance attribute.*/
+struct SpriteInstance
+{
+    Vec2 axisX;      ///< the quad bottom edge
+    Vec2 axisY;      ///< the quad left edge
+    Vec3 origin;     ///< the quad bottom left corner
+    float reserved;  ///< padding
+    Tex2F uvOrigin;  ///< the texture coordinates of the bottom left corner
+    Tex2F uvSize;    ///< the texture coordinates delta along axisX and axisY
+    Color4F color;
+};
+
+/**
+ Command used to draw many sprite quads sharing a texture and a blend function with one instanced draw.
+ Instead of transforming the four vertices of every quad on the CPU, the renderer uploads one `Instance`
+ per quad and the vertex shader maps a shared unit quad with it.
+ The commands are owned and pooled by the renderer, see `Renderer::addInstancedQuad`.
+*/
+class AX_DLL InstancedSpriteCommand : public InstancedCommand<SpriteInstance>
+{
+public:
+    /**
+    Convert a sprite quad transformed by the model view to an instance.
+    @return false if the quad isn't a parallelogram in a plane facing the camera, or if its texture coordinates
+    aren't aligned with its edges, so it can't be drawn instanced.
+    */
+    static bool makeInstance(const V3F_C4B_T2F_Quad& quad, const Mat4& mv, Instance& instance);
+
+    InstancedSpriteCommand();
+
+    /**Init the command for a new batch, the instances queued previously are discarded.*/
+    void init(float globalZOrder, Texture2D* texture, const BlendFunc& blendFunc, const Mat4& projection);
+
+    /**Whether a quad with these properties can be added to this command.*/
+    bool isCompatible(float globalZOrder,
+                      Texture2D* texture,
+                      const BlendFunc& blendFunc,
+                      const Mat4& projection) const;
+
+protected:
+    backend::UniformLocation _mvpMatrixLocation;
+
+    backend::TextureBackend* _texture = nullptr;
+    BlendFunc _blendFunc              = BlendFunc::DISABLE;
+    Mat4 _projection;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -68,22 +68,103 @@ std::string replaceDefines(std::string_view compileTimeDefines)
 static const char* getOptionalString(Properties* properties, const char* key, const char* defaultValue);
 static bool isValidUniform(const char* name);
 
+// the parsed materials, by full path
+static hlookup::string_map<Material*> s_prototypes;
+
 Material* Material::createWithFilename(std::string_view filepath)
 {
-    AXLOGD("Loading material: {}", filepath);
     auto validfilename = FileUtils::getInstance()->fullPathForFilename(filepath);
     if (!validfilename.empty())
     {
-        auto mat = new Material();
-        if (mat->initWithFile(validfilename))
+        auto prototype = getPrototype(validfilename);
+        if (prototype)
+            return prototype->clone();
+    }
+
+    return nullptr;
+}
+
+void Material::createWithFilenameAsync(std::string_view filepath, std::function<void(Material*)> callback)
+{
+    auto validfilename = FileUtils::getInstance()->fullPathForFilename(filepath);
+    if (validfilename.empty())
+    {
+        callback(nullptr);
+        return;
+    }
+
+    auto it = s_prototypes.find(validfilename);
+    if (it != s_prototypes.end())
+    {
+        callback(it->second->clone());
+        return;
+    }
+
+    // the properties are parsed on a worker, the programs and textures are created on the main thread
+    auto properties = std::make_shared<Properties*>(nullptr);
+    Director::getInstance()->getJobSystem()->enqueue(
+        [properties, validfilename] {
+        AXLOGD("Loading material: {}", validfilename);
+        *properties = Properties::createNonRefCounted(validfilename);
+    },
+        [properties, validfilename, callback = std::move(callback)] {
+        // the file may have been loaded while this one was parsed
+        Material* prototype = nullptr;
+        auto it             = s_prototypes.find(validfilename);
+        if (it != s_prototypes.end())
+            prototype = it->second;
+        else if (*properties)
         {
-            mat->autorelease();
-            return mat;
+            prototype = new Material();
+            prototype->initWithProperties(*properties);
+            addPrototype(validfilename, prototype);
+            prototype->release();
         }
-        delete mat;
+        AX_SAFE_DELETE(*properties);
+
+        callback(prototype ? prototype->clone() : nullptr);
+    });
+}
+
+Material* Material::getPrototype(std::string_view fullPath)
+{
+    auto it = s_prototypes.find(fullPath);
+    if (it != s_prototypes.end())
+        return it->second;
+
+    AXLOGD("Loading material: {}", fullPath);
+    auto prototype = new Material();
+    if (!prototype->initWithFile(fullPath))
+    {
+        delete prototype;
+        return nullptr;
     }
+    addPrototype(fullPath, prototype);
+    prototype->release();
+    return prototype;
+}
 
-    return nullptr;
+void Material::addPrototype(std::string_view fullPath, Material* prototype)
+{
+    prototype->retain();
+    s_prototypes.emplace(fullPath, prototype);
+}
+
+void Material::removeCachedMaterial(std::string_view path)
+{
+    auto it = s_prototypes.find(FileUtils::getInstance()->fullPathForFilename(path));
+    if (it != s_prototypes.end())
+    {
+        it->second->release();
+        s_prototypes.erase(it);
+    }
+}
+
+void Material::purgeCachedData()
+{
+    for (auto&& it : s_prototypes)
+        it.second->release();
+    s_prototypes.clear();
 }
 
 Material* Material::createWithProperties(Properties* materialProperties)
@@ -131,9 +212,10 @@ bool Material::initWithFile(std::string_view validfilename)
 {
     // Warning: properties is not a "Object" object, must be manually deleted
     Properties* properties = Properties::createNonRefCounted(validfilename);
+    if (!properties)
+        return false;
 
-    // get the first material
-    parseProperties((strlen(properties->getNamespace()) > 0) ? properties : properties->getNextNamespace());
+    initWithProperties(properties);
 
     AX_SAFE_DELETE(properties);
     return true;
@@ -141,7 +223,10 @@ bool Material::initWithFile(std::string_view validfilename)
 
 bool Material::initWithProperties(Properties* materialProperties)
 {
-    return parseProperties(materialProperties);
+    // get the first material of a file
+    if (strlen(materialProperties->getNamespace()) == 0)
+        materialProperties = materialProperties->getNextNamespace();
+    return materialProperties && parseProperties(materialProperties);
 }
 
 void Material::draw(MeshCommand* meshCommands,
@@ -503,6 +588,13 @@ void Material::setForce2DQueue(bool value)
     getStateBlock().setBlend(_force2DQueue || _isTransparent);
 }
 
+void Material::setDepthPrePass(bool value)
+{
+    _depthPrePass = value;
+    // the opaque pass finds the depth written by the pre-pass
+    getStateBlock().setDepthFunction(value ? DepthFunction::LESS_EQUAL : DepthFunction::LESS);
+}
+
 Material::Material() : _name(""), _currentTechnique(nullptr), _target(nullptr) {}
 
 Material::~Material() {}
@@ -521,10 +613,15 @@ Material* Material::clone() const
     }
 
     // current technique
-    auto name                   = _currentTechnique->getName();
-    material->_currentTechnique = material->getTechniqueByName(name);
-    material->_textureSlots     = material->_textureSlots;
-    material->_textureSlotIndex = material->_textureSlotIndex;
+    if (_currentTechnique)
+        material->_currentTechnique = material->getTechniqueByName(_currentTechnique->getName());
+    material->_name             = _name;
+    material->_textureSlots     = _textureSlots;
+    material->_textureSlotIndex = _textureSlotIndex;
+    material->_isTransparent    = _isTransparent;
+    material->_force2DQueue     = _force2DQueue;
+    material->_depthPrePass     = _depthPrePass;
+    material->_drawPrimitive    = _drawPrimitive;
     material->autorelease();
     return material;
 }
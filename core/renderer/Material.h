@@ -32,6 +32,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <functional>
 
 #include "renderer/RenderState.h"
 #include "renderer/Technique.h"
@@ -78,10 +79,26 @@ public:
      *
      * @param url The URL pointing to the Properties object defining the material.
      *
+     * Each file is parsed once, the materials are clones of a prototype kept in a cache by full path, which share
+     * the uniform values of the prototype until they change them.
+     *
      * @return A new Material or NULL if there was an error.
      */
     static Material* createWithFilename(std::string_view path);
 
+    /**
+     * Creates a Material like createWithFilename(), but the file is read and parsed on the job system threads, like
+     * the models loaded by MeshRenderer::createAsync(). The callback is called from the main thread with the new
+     * material, or nullptr if there was an error. It is called immediately when the file is cached already.
+     */
+    static void createWithFilenameAsync(std::string_view path, std::function<void(Material*)> callback);
+
+    /** Removes the prototype of a file from the cache, the next material created from it parses it again. */
+    static void removeCachedMaterial(std::string_view path);
+
+    /** Removes all the prototypes from the cache. */
+    static void purgeCachedData();
+
     /** Creates a Material with a GLProgramState.
      It will only contain one Technique and one Pass.
      Added in order to support legacy code.
@@ -178,6 +195,19 @@ public:
      */
     bool isForce2DQueue() const { return _force2DQueue; }
 
+    /**
+     * Draw the opaque meshes using this material in a depth-only pre-pass before the opaque 3D queue, so their
+     * fragment shaders only run for the visible fragments. Worth it for expensive fragment shaders, the meshes are
+     * drawn twice. Skinned and instanced meshes aren't pre-passed.
+     * The depth function of the material becomes LESS_EQUAL.
+     */
+    void setDepthPrePass(bool value);
+
+    /**
+     * Is the material drawn in the depth pre-pass?
+     */
+    bool isDepthPrePass() const { return _depthPrePass; }
+
 protected:
     Material();
     ~Material();
@@ -185,6 +215,10 @@ protected:
     bool initWithFile(std::string_view file);
     bool initWithProperties(Properties* materialProperties);
 
+    /** Gets the prototype parsed from a full path, parses it when it isn't cached yet. */
+    static Material* getPrototype(std::string_view fullPath);
+    static void addPrototype(std::string_view fullPath, Material* prototype);
+
     void setTarget(Node* target);
 
     bool parseProperties(Properties* properties);
@@ -214,6 +248,7 @@ protected:
 
     bool _isTransparent = false;  // is this mesh transparent.
     bool _force2DQueue = false;   // render meshes using this material in 2D render queue.
+    bool _depthPrePass = false;   // draw the opaque meshes in the depth pre-pass.
 
     ax::backend::PrimitiveType _drawPrimitive =
         ax::backend::PrimitiveType::TRIANGLE;  // primitive draw type for meshes
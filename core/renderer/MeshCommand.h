@@ -74,11 +74,26 @@ public:
 
     void init(float globalZOrder, const Mat4& transform);
 
+    /**
+    Sets the color of the draw. Like the transform, it is applied to the pass when the command is drawn, so the meshes
+    sharing a material don't overwrite each other's color.
+    */
+    void setColor(const Vec4& color)
+    {
+        _color    = color;
+        _hasColor = true;
+    }
+    const Vec4& getColor() const { return _color; }
+    bool hasColor() const { return _hasColor; }
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void listenRendererRecreated(EventCustom* event);
 #endif
 
 protected:
+    Vec4 _color;
+    bool _hasColor = false;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _rendererRecreatedListener;
 #endif
@@ -112,6 +112,7 @@ Pass* Pass::clone() const
 {
     auto pass          = new Pass();
     pass->_renderState = _renderState;
+    pass->_name        = _name;
 
     pass->setProgramState(_programState->clone());
 
@@ -137,6 +138,8 @@ void Pass::setProgramState(backend::ProgramState* programState)
         AX_SAFE_RELEASE(_programState);
         _programState = programState;
         AX_SAFE_RETAIN(_programState);
+        // meshes sharing a program are drawn interleaved, keep their uniforms in their own buffers
+        _programState->setUniformBufferOwned(true);
         initUniformLocations();
         _hashDirty = true;
     }
@@ -156,6 +159,26 @@ void Pass::initUniformLocations()
 
     _locColor         = ps->getUniformLocation("u_color");
     _locMatrixPalette = ps->getUniformLocation("u_matrixPalette");
+    _locBonePalette   = ps->getUniformLocation("u_bonePalette");
+    _locPaletteOffset = ps->getUniformLocation("u_paletteOffset");
+
+    _locLightClusters      = ps->getUniformLocation("u_lightClusters");
+    _locLightClusterMatrix = ps->getUniformLocation("u_clusterMatrix");
+    _locLightClusterDepth  = ps->getUniformLocation("u_clusterDepth");
+    _locLightClusterParams = ps->getUniformLocation("u_clusterParams");
+    _locLightMask          = ps->getUniformLocation("u_lightMask");
+
+    _locShadowMaps[0]    = ps->getUniformLocation("u_shadowMap0");
+    _locShadowMaps[1]    = ps->getUniformLocation("u_shadowMap1");
+    _locShadowMaps[2]    = ps->getUniformLocation("u_shadowMap2");
+    _locShadowMaps[3]    = ps->getUniformLocation("u_shadowMap3");
+    _locShadowMatrices   = ps->getUniformLocation("u_shadowMatrices");
+    _locShadowSplits     = ps->getUniformLocation("u_shadowSplits");
+    _locShadowDepth      = ps->getUniformLocation("u_shadowDepth");
+    _locShadowBias       = ps->getUniformLocation("u_shadowBias");
+    _locShadowParams     = ps->getUniformLocation("u_shadowParams");
+    _locShadowLightColor = ps->getUniformLocation("u_shadowLightColor");
+    _locShadowLightDir   = ps->getUniformLocation("u_shadowLightDirection");
 
     _locDirLightColor = ps->getUniformLocation(s_dirLightUniformColorName);
     _locDirLightDir   = ps->getUniformLocation(s_dirLightUniformDirName);
@@ -234,6 +257,8 @@ void Pass::onBeforeVisitCmd(MeshCommand* command)
     _renderState.bindPass(this, command);
 
     updateMVPUniform(command->getMV());
+    if (command->hasColor())
+        setUniformColor(&command->getColor(), sizeof(Vec4));
 }
 
 void Pass::onAfterVisitCmd(MeshCommand* command)
@@ -285,6 +310,21 @@ void Pass::setUniformNormTexture(uint32_t slot, backend::TextureBackend* tex)
     _programState->setTexture(_locNormalTexture, slot, tex);
 }
 
+void Pass::setUniformBonePalette(uint32_t slot, backend::TextureBackend* tex)
+{
+    _programState->setTexture(_locBonePalette, slot, tex);
+}
+
+void Pass::setUniformLightClusters(uint32_t slot, backend::TextureBackend* tex)
+{
+    _programState->setTexture(_locLightClusters, slot, tex);
+}
+
+void Pass::setUniformShadowMap(int cascade, uint32_t slot, backend::TextureBackend* tex)
+{
+    _programState->setTexture(_locShadowMaps[cascade], slot, tex);
+}
+
 #define TRY_SET_UNIFORM(loc)                                         \
     do                                                               \
     {                                                                \
@@ -304,6 +344,66 @@ void Pass::setUniformMatrixPalette(const void* data, size_t dataLen)
     TRY_SET_UNIFORM(_locMatrixPalette);
 }
 
+void Pass::setUniformPaletteOffset(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locPaletteOffset);
+}
+
+void Pass::setUniformLightClusterMatrix(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locLightClusterMatrix);
+}
+
+void Pass::setUniformLightClusterDepth(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locLightClusterDepth);
+}
+
+void Pass::setUniformLightClusterParams(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locLightClusterParams);
+}
+
+void Pass::setUniformLightMask(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locLightMask);
+}
+
+void Pass::setUniformShadowMatrices(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowMatrices);
+}
+
+void Pass::setUniformShadowSplits(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowSplits);
+}
+
+void Pass::setUniformShadowDepth(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowDepth);
+}
+
+void Pass::setUniformShadowBias(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowBias);
+}
+
+void Pass::setUniformShadowParams(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowParams);
+}
+
+void Pass::setUniformShadowLightColor(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowLightColor);
+}
+
+void Pass::setUniformShadowLightDir(const void* data, size_t dataLen)
+{
+    TRY_SET_UNIFORM(_locShadowLightDir);
+}
+
 void Pass::setUniformDirLightColor(const void* data, size_t dataLen)
 {
     TRY_SET_UNIFORM(_locDirLightColor);
@@ -114,6 +114,33 @@ public:
     void setUniformColor(const void*, size_t);          // ucolor
     void setUniformMatrixPalette(const void*, size_t);  // u_matrixPalette
 
+    void setUniformBonePalette(uint32_t slot, backend::TextureBackend*);  // u_bonePalette
+    void setUniformPaletteOffset(const void*, size_t);                    // u_paletteOffset
+    /** Whether the program reads the matrix palette from the bone palette texture. */
+    bool hasBonePalette() const { return _locBonePalette; }
+
+    void setUniformLightClusters(uint32_t slot, backend::TextureBackend*);  // u_lightClusters
+    void setUniformLightClusterMatrix(const void*, size_t);                 // u_clusterMatrix
+    void setUniformLightClusterDepth(const void*, size_t);                  // u_clusterDepth
+    void setUniformLightClusterParams(const void*, size_t);                 // u_clusterParams
+    void setUniformLightMask(const void*, size_t);                          // u_lightMask
+    /** Whether the program reads the point and spot lights from the light clusters texture. */
+    bool hasLightClusters() const { return _locLightClusters; }
+
+    void setUniformShadowMap(int cascade, uint32_t slot, backend::TextureBackend*);  // u_shadowMap0 to 3
+    void setUniformShadowMatrices(const void*, size_t);                              // u_shadowMatrices
+    void setUniformShadowSplits(const void*, size_t);                                // u_shadowSplits
+    void setUniformShadowDepth(const void*, size_t);                                 // u_shadowDepth
+    void setUniformShadowBias(const void*, size_t);                                  // u_shadowBias
+    void setUniformShadowParams(const void*, size_t);                                // u_shadowParams
+    void setUniformShadowLightColor(const void*, size_t);                            // u_shadowLightColor
+    void setUniformShadowLightDir(const void*, size_t);                              // u_shadowLightDirection
+    /** Whether the program receives the shadows of a CascadedShadowMap. */
+    bool hasShadowMap() const { return _locShadowMaps[0]; }
+
+    /** Whether the program projects the positions with u_MVMatrix and u_PMatrix rather than u_MVPMatrix. */
+    bool hasProjectionMatrix() const { return _locPMatrix; }
+
     void setUniformDirLightColor(const void*, size_t);
     void setUniformDirLightDir(const void*, size_t);
 
@@ -161,6 +188,23 @@ private:
 
     backend::UniformLocation _locColor;          // ucolor
     backend::UniformLocation _locMatrixPalette;  // u_matrixPalette
+    backend::UniformLocation _locBonePalette;    // u_bonePalette
+    backend::UniformLocation _locPaletteOffset;  // u_paletteOffset
+
+    backend::UniformLocation _locLightClusters;       // u_lightClusters
+    backend::UniformLocation _locLightClusterMatrix;  // u_clusterMatrix
+    backend::UniformLocation _locLightClusterDepth;   // u_clusterDepth
+    backend::UniformLocation _locLightClusterParams;  // u_clusterParams
+    backend::UniformLocation _locLightMask;           // u_lightMask
+
+    backend::UniformLocation _locShadowMaps[4];       // u_shadowMap0 to 3, one per cascade
+    backend::UniformLocation _locShadowMatrices;      // u_shadowMatrices
+    backend::UniformLocation _locShadowSplits;        // u_shadowSplits
+    backend::UniformLocation _locShadowDepth;         // u_shadowDepth
+    backend::UniformLocation _locShadowBias;          // u_shadowBias
+    backend::UniformLocation _locShadowParams;        // u_shadowParams
+    backend::UniformLocation _locShadowLightColor;    // u_shadowLightColor
+    backend::UniformLocation _locShadowLightDir;      // u_shadowLightDirection
 
     backend::UniformLocation _locDirLightColor;
     backend::UniformLocation _locDirLightDir;
@@ -0,0 +1,536 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/PostProcessGraph.h"
+#include "renderer/Renderer.h"
+#include "renderer/Texture2D.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramState.h"
+#include "renderer/backend/RenderTarget.h"
+#include "base/Director.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
+namespace ax
+{
+
+namespace
+{
+constexpr int MAX_INPUTS = 4;
+
+int getTargetSize(float size, float scale)
+{
+    return std::max(1, static_cast<int>(std::ceil(size * scale)));
+}
+}  // namespace
+
+// implementation of PostProcessPass
+
+PostProcessPass::PostProcessPass(Type type, std::vector<std::string> inputs, std::string_view output, float scale)
+    : _type(type), _inputs(std::move(inputs)), _output(output), _scale(std::max(scale, 0.01f))
+{
+    AXASSERT(!_inputs.empty() && _inputs.size() <= MAX_INPUTS, "A post process pass reads 1 to 4 inputs");
+}
+
+PostProcessPass::~PostProcessPass()
+{
+    AX_SAFE_RELEASE(_programState);
+}
+
+PostProcessPass* PostProcessPass::createColor(std::string_view input,
+                                              std::string_view output,
+                                              const Mat4& colorMatrix,
+                                              const Vec4& colorOffset)
+{
+    auto ret = new PostProcessPass(Type::COLOR, {std::string{input}}, output, 1.0f);
+    ret->setColorMatrix(colorMatrix, colorOffset);
+    ret->autorelease();
+    return ret;
+}
+
+PostProcessPass* PostProcessPass::createComposite(std::string_view input,
+                                                  std::string_view addedInput,
+                                                  std::string_view output,
+                                                  float weight)
+{
+    auto ret = new PostProcessPass(Type::COLOR, {std::string{input}, std::string{addedInput}}, output, 1.0f);
+    ret->setWeight(weight);
+    ret->autorelease();
+    return ret;
+}
+
+PostProcessPass* PostProcessPass::createThreshold(std::string_view input,
+                                                  std::string_view output,
+                                                  float threshold,
+                                                  float scale)
+{
+    auto ret = new PostProcessPass(Type::THRESHOLD, {std::string{input}}, output, scale);
+    ret->setThreshold(threshold);
+    ret->autorelease();
+    return ret;
+}
+
+PostProcessPass* PostProcessPass::createBlur(std::string_view input,
+                                             std::string_view output,
+                                             const Vec2& direction,
+                                             float scale)
+{
+    auto ret = new PostProcessPass(Type::BLUR, {std::string{input}}, output, scale);
+    ret->setDirection(direction);
+    ret->autorelease();
+    return ret;
+}
+
+PostProcessPass* PostProcessPass::createCustom(backend::Program* program,
+                                               const std::vector<std::string>& inputs,
+                                               std::string_view output,
+                                               float scale)
+{
+    auto ret           = new PostProcessPass(Type::CUSTOM, inputs, output, scale);
+    ret->_programState = new backend::ProgramState(program);
+    ret->autorelease();
+    return ret;
+}
+
+void PostProcessPass::setColorMatrix(const Mat4& colorMatrix, const Vec4& colorOffset)
+{
+    _colorMatrix = colorMatrix;
+    _colorOffset = colorOffset;
+}
+
+void PostProcessPass::initCommand()
+{
+    if (!_programState)
+    {
+        auto type = backend::ProgramType::POST_PROCESS_COLOR;
+        if (_type == Type::THRESHOLD)
+            type = backend::ProgramType::POST_PROCESS_THRESHOLD;
+        else if (_type == Type::BLUR)
+            type = backend::ProgramType::POST_PROCESS_BLUR;
+        _programState = new backend::ProgramState(backend::Program::getBuiltinProgram(type));
+    }
+
+    auto locMVPMatrix = _programState->getUniformLocation("u_MVPMatrix");
+    _programState->setUniform(locMVPMatrix, Mat4::IDENTITY.m, sizeof(Mat4::IDENTITY.m));
+
+    for (int i = 0; i < MAX_INPUTS; ++i)
+    {
+        auto location = _programState->getUniformLocation("u_tex" + std::to_string(i));
+        if (!location)
+            break;
+        _locTextures.push_back(location);
+    }
+    _locTexelSize   = _programState->getUniformLocation("u_texelSize");
+    _locColorMatrix = _programState->getUniformLocation("u_colorMatrix");
+    _locColorOffset = _programState->getUniformLocation("u_colorOffset");
+    _locWeight      = _programState->getUniformLocation("u_weight");
+    _locThreshold   = _programState->getUniformLocation("u_threshold");
+    _locDirection   = _programState->getUniformLocation("u_direction");
+
+    auto& pipelineDescriptor        = _customCommand.getPipelineDescriptor();
+    pipelineDescriptor.programState = _programState;
+
+    // the premultiplied result is blended over the previous cameras when the pass writes the screen
+    auto& blend                     = pipelineDescriptor.blendDescriptor;
+    blend.sourceRGBBlendFactor      = blend.sourceAlphaBlendFactor      = backend::BlendFactor::ONE;
+    blend.destinationRGBBlendFactor = blend.destinationAlphaBlendFactor = backend::BlendFactor::ONE_MINUS_SRC_ALPHA;
+
+    // all the targets are written and read with the same orientation
+    V3F_C4B_T2F vertices[4];
+    vertices[0].vertices = Vec3(-1, -1, 0);
+    vertices[1].vertices = Vec3(1, -1, 0);
+    vertices[2].vertices = Vec3(1, 1, 0);
+    vertices[3].vertices = Vec3(-1, 1, 0);
+#if defined(AX_USE_GL)
+    vertices[0].texCoords = Tex2F(0, 0);
+    vertices[1].texCoords = Tex2F(1, 0);
+    vertices[2].texCoords = Tex2F(1, 1);
+    vertices[3].texCoords = Tex2F(0, 1);
+#else
+    vertices[0].texCoords = Tex2F(0, 1);
+    vertices[1].texCoords = Tex2F(1, 1);
+    vertices[2].texCoords = Tex2F(1, 0);
+    vertices[3].texCoords = Tex2F(0, 0);
+#endif
+    for (auto& vertex : vertices)
+        vertex.colors = Color4B::WHITE;
+
+    uint16_t indices[6] = {0, 1, 2, 2, 3, 0};
+    _customCommand.createVertexBuffer(sizeof(vertices[0]), 4, CustomCommand::BufferUsage::STATIC);
+    _customCommand.updateVertexBuffer(vertices, sizeof(vertices));
+    _customCommand.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, 6, CustomCommand::BufferUsage::STATIC);
+    _customCommand.updateIndexBuffer(indices, sizeof(indices));
+
+    _customCommand.setBeforeCallback(AX_CALLBACK_0(PostProcessPass::onBeforeDraw, this));
+    _customCommand.setAfterCallback(AX_CALLBACK_0(PostProcessPass::onAfterDraw, this));
+    _commandReady = true;
+}
+
+void PostProcessPass::onBeforeDraw()
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    _depthTest    = renderer->getDepthTest();
+    renderer->setDepthTest(false);
+}
+
+void PostProcessPass::onAfterDraw()
+{
+    Director::getInstance()->getRenderer()->setDepthTest(_depthTest);
+}
+
+// implementation of PostProcessGraph
+
+PostProcessGraph* PostProcessGraph::create()
+{
+    auto ret = new PostProcessGraph();
+    ret->autorelease();
+    return ret;
+}
+
+PostProcessGraph::~PostProcessGraph()
+{
+    releaseTargets();
+    for (auto&& target : _targets)
+        AX_SAFE_RELEASE(target.renderTarget);
+    AX_SAFE_RELEASE(_sceneTarget.renderTarget);
+}
+
+void PostProcessGraph::addPass(PostProcessPass* pass)
+{
+    _passes.pushBack(pass);
+    _dirty = true;
+}
+
+void PostProcessGraph::removePass(PostProcessPass* pass)
+{
+    _passes.eraseObject(pass);
+    _dirty = true;
+}
+
+void PostProcessGraph::removeAllPasses()
+{
+    _passes.clear();
+    _dirty = true;
+}
+
+bool PostProcessGraph::compile()
+{
+    AXASSERT(!_running, "The passes can't be compiled while the graph runs");
+
+    _dirty    = false;
+    _compiled = false;
+    _draws.clear();
+    for (auto&& target : _targets)
+        AX_SAFE_RELEASE(target.renderTarget);
+    _targets.clear();
+
+    // the pass writing each name
+    const auto count = _passes.size();
+    std::unordered_map<std::string_view, size_t> producers;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& output = _passes.at(i)->getOutput();
+        if (output == SCENE || !producers.emplace(output, i).second)
+        {
+            AXLOGW("PostProcessGraph: '{}' is written more than once", output);
+            return false;
+        }
+    }
+
+    auto screen = producers.find(SCREEN);
+    if (screen == producers.end())
+    {
+        AXLOGW("PostProcessGraph: no pass writes the screen");
+        return false;
+    }
+
+    // the passes the screen depends on, each one after the passes it reads
+    enum
+    {
+        UNVISITED,
+        VISITING,
+        VISITED
+    };
+    std::vector<int> states(count, UNVISITED);
+    std::vector<size_t> order;
+    std::function<bool(size_t)> visit = [&](size_t index) {
+        states[index] = VISITING;
+        for (auto&& input : _passes.at(index)->getInputs())
+        {
+            if (input == SCENE)
+                continue;
+            auto producer = producers.find(input);
+            if (producer == producers.end())
+            {
+                AXLOGW("PostProcessGraph: '{}' is read but no pass writes it", input);
+                return false;
+            }
+            if (states[producer->second] == VISITING)
+            {
+                AXLOGW("PostProcessGraph: the passes writing '{}' depend on each other", input);
+                return false;
+            }
+            if (states[producer->second] == UNVISITED && !visit(producer->second))
+                return false;
+        }
+        states[index] = VISITED;
+        order.push_back(index);
+        return true;
+    };
+    if (!visit(screen->second))
+        return false;
+
+    std::vector<int> readers(count, 0);
+    for (auto index : order)
+        for (auto&& input : _passes.at(index)->getInputs())
+            if (input != SCENE)
+                ++readers[producers[input]];
+
+    // a color pass is merged into the color pass writing its only input, when nothing else reads that input
+    std::vector<size_t> drawOf(count);
+    for (auto index : order)
+    {
+        auto pass = _passes.at(index);
+        if (pass->getType() == PostProcessPass::Type::COLOR && pass->getInputs().size() == 1 &&
+            pass->getInputs()[0] != SCENE)
+        {
+            const auto producer = producers[pass->getInputs()[0]];
+            auto& draw          = _draws[drawOf[producer]];
+            if (readers[producer] == 1 && draw.passes[0]->getType() == PostProcessPass::Type::COLOR &&
+                draw.passes.back()->getScale() == pass->getScale())
+            {
+                draw.passes.push_back(pass);
+                drawOf[index] = drawOf[producer];
+                continue;
+            }
+        }
+        drawOf[index] = _draws.size();
+        _draws.push_back(Draw{{pass}, {}, SCREEN_TARGET});
+    }
+
+    // the last draw reading the output of each draw
+    std::vector<size_t> lastReads(_draws.size(), 0);
+    for (size_t i = 0; i < _draws.size(); ++i)
+        for (auto&& input : _draws[i].passes[0]->getInputs())
+            if (input != SCENE)
+                lastReads[drawOf[producers[input]]] = i;
+
+    // a target is reused once the draws reading it are done, the inputs of a draw are never its output
+    std::vector<int> freeTargets;
+    for (size_t i = 0; i < _draws.size(); ++i)
+    {
+        auto& draw = _draws[i];
+        for (auto&& input : draw.passes[0]->getInputs())
+            draw.inputs.push_back(input == SCENE ? SCENE_TARGET : _draws[drawOf[producers[input]]].output);
+
+        auto last = draw.passes.back();
+        if (last->getOutput() != SCREEN)
+        {
+            auto it = std::find_if(freeTargets.begin(), freeTargets.end(),
+                                   [&](int target) { return _targets[target].scale == last->getScale(); });
+            if (it != freeTargets.end())
+            {
+                draw.output = *it;
+                freeTargets.erase(it);
+            }
+            else
+            {
+                draw.output = static_cast<int>(_targets.size());
+                _targets.push_back(Target{last->getScale()});
+            }
+        }
+
+        for (size_t j = 0; j < i; ++j)
+            if (lastReads[j] == i && _draws[j].output >= 0)
+                freeTargets.push_back(_draws[j].output);
+    }
+
+    _compiled = true;
+    return true;
+}
+
+void PostProcessGraph::begin(Renderer* renderer)
+{
+    if (_dirty)
+        compile();
+    if (!_compiled)
+        return;
+    _running = true;
+
+    _oldViewport     = renderer->getViewport();
+    const int width  = getTargetSize(static_cast<float>(_oldViewport.width), 1.0f);
+    const int height = getTargetSize(static_cast<float>(_oldViewport.height), 1.0f);
+
+    // the depth of the scene is only needed while the camera renders
+    auto renderTargetPool = renderer->getRenderTargetPool();
+    _sceneTarget.texture  = renderTargetPool->acquireTexture(width, height, backend::PixelFormat::RGBA8,
+                                                             !!AX_ENABLE_PREMULTIPLIED_ALPHA);
+    _sceneTarget.texture->retain();
+    _sceneTarget.texture->setAntiAliasTexParameters();
+    _sceneDepthStencil = renderTargetPool->acquireTransientDepthStencil(width, height);
+    _sceneDepthStencil->retain();
+
+    if (!_sceneTarget.renderTarget)
+    {
+        _sceneTarget.renderTarget = backend::DriverBase::getInstance()->newRenderTarget();
+        _sceneTarget.renderTarget->setTransientAttachments(backend::TargetBufferFlags::DEPTH_AND_STENCIL);
+    }
+    _sceneTarget.renderTarget->setColorAttachment(_sceneTarget.texture->getBackendTexture());
+    _sceneTarget.renderTarget->setDepthAttachment(_sceneDepthStencil->getBackendTexture());
+    _sceneTarget.renderTarget->setStencilAttachment(_sceneDepthStencil->getBackendTexture());
+
+    _oldRenderTarget = renderer->getRenderTarget();
+    renderer->setRenderTarget(_sceneTarget.renderTarget);
+    renderer->setViewPort(0, 0, width, height);
+
+    // the camera may only clear the depth, the last frame must not show through
+    renderer->clear(ClearFlag::ALL, Color4F(0, 0, 0, 0), 1.0f, 0, std::numeric_limits<float>::lowest());
+}
+
+void PostProcessGraph::end(Renderer* renderer)
+{
+    if (!_running)
+        return;
+
+    acquireTargets(renderer);
+    for (auto&& draw : _draws)
+        drawPass(renderer, draw);
+
+    renderer->setRenderTarget(_oldRenderTarget);
+    renderer->setViewPort(_oldViewport.x, _oldViewport.y, _oldViewport.width, _oldViewport.height);
+
+    // back to the pool, for the graphs of the other cameras
+    releaseTargets();
+    _running = false;
+}
+
+void PostProcessGraph::acquireTargets(Renderer* renderer)
+{
+    auto renderTargetPool = renderer->getRenderTargetPool();
+    for (auto&& target : _targets)
+    {
+        const int width  = getTargetSize(static_cast<float>(_oldViewport.width), target.scale);
+        const int height = getTargetSize(static_cast<float>(_oldViewport.height), target.scale);
+        target.texture   = renderTargetPool->acquireTexture(width, height, backend::PixelFormat::RGBA8,
+                                                            !!AX_ENABLE_PREMULTIPLIED_ALPHA);
+        target.texture->retain();
+        target.texture->setAntiAliasTexParameters();
+
+        // each draw covers its whole target
+        if (!target.renderTarget)
+        {
+            target.renderTarget = backend::DriverBase::getInstance()->newRenderTarget();
+            target.renderTarget->setOverwrittenAttachments(backend::TargetBufferFlags::COLOR0);
+        }
+        target.renderTarget->setColorAttachment(target.texture->getBackendTexture());
+    }
+}
+
+void PostProcessGraph::releaseTargets()
+{
+    for (auto&& target : _targets)
+        AX_SAFE_RELEASE_NULL(target.texture);
+    AX_SAFE_RELEASE_NULL(_sceneTarget.texture);
+    AX_SAFE_RELEASE_NULL(_sceneDepthStencil);
+}
+
+Texture2D* PostProcessGraph::getInputTexture(int input) const
+{
+    return input == SCENE_TARGET ? _sceneTarget.texture : _targets[input].texture;
+}
+
+void PostProcessGraph::drawPass(Renderer* renderer, const Draw& draw)
+{
+    auto pass = draw.passes[0];
+    if (!pass->_commandReady)
+        pass->initCommand();
+
+    auto& blend        = pass->_customCommand.getPipelineDescriptor().blendDescriptor;
+    blend.blendEnabled = draw.output == SCREEN_TARGET;
+    if (draw.output == SCREEN_TARGET)
+    {
+        renderer->setRenderTarget(_oldRenderTarget);
+        renderer->setViewPort(_oldViewport.x, _oldViewport.y, _oldViewport.width, _oldViewport.height);
+    }
+    else
+    {
+        auto texture = _targets[draw.output].texture;
+        renderer->setRenderTarget(_targets[draw.output].renderTarget);
+        renderer->setViewPort(0, 0, texture->getPixelsWide(), texture->getPixelsHigh());
+    }
+
+    auto programState = pass->_programState;
+    for (size_t i = 0; i < pass->_locTextures.size(); ++i)
+    {
+        // the unused samplers of a builtin pass read the first input
+        auto texture = getInputTexture(draw.inputs[i < draw.inputs.size() ? i : 0]);
+        programState->setTexture(pass->_locTextures[i], static_cast<int>(i), texture->getBackendTexture());
+    }
+
+    auto input = getInputTexture(draw.inputs[0]);
+    Vec2 texelSize(1.0f / input->getPixelsWide(), 1.0f / input->getPixelsHigh());
+    switch (pass->getType())
+    {
+    case PostProcessPass::Type::COLOR:
+    {
+        // the matrices of the merged passes are applied in a row
+        Mat4 colorMatrix = pass->getColorMatrix();
+        Vec4 colorOffset = pass->getColorOffset();
+        for (size_t i = 1; i < draw.passes.size(); ++i)
+        {
+            const auto& matrix = draw.passes[i]->getColorMatrix();
+            colorMatrix        = matrix * colorMatrix;
+            colorOffset        = matrix * colorOffset + draw.passes[i]->getColorOffset();
+        }
+        float weight = draw.inputs.size() > 1 ? pass->getWeight() : 0.0f;
+        programState->setUniform(pass->_locColorMatrix, colorMatrix.m, sizeof(colorMatrix.m));
+        programState->setUniform(pass->_locColorOffset, &colorOffset, sizeof(colorOffset));
+        programState->setUniform(pass->_locWeight, &weight, sizeof(weight));
+        break;
+    }
+    case PostProcessPass::Type::THRESHOLD:
+        programState->setUniform(pass->_locThreshold, &pass->_threshold, sizeof(pass->_threshold));
+        break;
+    case PostProcessPass::Type::BLUR:
+    {
+        Vec2 direction(pass->_direction.x * texelSize.x, pass->_direction.y * texelSize.y);
+        programState->setUniform(pass->_locDirection, &direction, sizeof(direction));
+        break;
+    }
+    case PostProcessPass::Type::CUSTOM:
+        if (pass->_locTexelSize)
+            programState->setUniform(pass->_locTexelSize, &texelSize, sizeof(texelSize));
+        break;
+    }
+
+    // drawn right away, the next pass reads the target
+    pass->_customCommand.init(0.0f);
+    renderer->addCommand(&pass->_customCommand);
+    renderer->render();
+}
+
+}  // namespace ax
@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/Object.h"
+#include "base/Types.h"
+#include "base/Vector.h"
+#include "renderer/CustomCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+class Renderer;
+class Texture2D;
+
+namespace backend
+{
+class Program;
+class ProgramState;
+class RenderTarget;
+}  // namespace backend
+
+/**
+ A fullscreen pass of a `PostProcessGraph`. It reads its inputs and writes its output by name, `PostProcessGraph::SCENE`
+ is what the camera rendered and `PostProcessGraph::SCREEN` the target the camera rendered to before.
+*/
+class AX_DLL PostProcessPass : public Object
+{
+public:
+    enum class Type
+    {
+        COLOR,      ///< A color matrix, with an optional second input added to the first one.
+        THRESHOLD,  ///< Keeps the colors brighter than a threshold, the input of a bloom.
+        BLUR,       ///< A gaussian blur along a direction, a pass for each axis makes a separable blur.
+        CUSTOM,     ///< A program of the application.
+    };
+
+    /** Transforms the input by a color matrix, the color passes in a row are merged into a single draw. */
+    static PostProcessPass* createColor(std::string_view input,
+                                        std::string_view output,
+                                        const Mat4& colorMatrix = Mat4::IDENTITY,
+                                        const Vec4& colorOffset = Vec4::ZERO);
+
+    /** Adds the weighted second input to the first one, e.g. to composite a bloom. A color matrix can follow. */
+    static PostProcessPass* createComposite(std::string_view input,
+                                            std::string_view addedInput,
+                                            std::string_view output,
+                                            float weight = 1.0f);
+
+    /** Keeps the part of the colors above the threshold, at a scale of the resolution of the viewport. */
+    static PostProcessPass* createThreshold(std::string_view input,
+                                            std::string_view output,
+                                            float threshold = 0.8f,
+                                            float scale     = 0.5f);
+
+    /** Blurs along the direction, in texels of the input, at a scale of the resolution of the viewport. */
+    static PostProcessPass* createBlur(std::string_view input,
+                                       std::string_view output,
+                                       const Vec2& direction,
+                                       float scale = 0.5f);
+
+    /**
+     * Draws with a program of the application using the positionTextureColor vertex shader, the inputs are bound to
+     * u_tex0, u_tex1... and u_texelSize is set to the texel size of the first input when the program has it.
+     * The other uniforms are set on `getProgramState`.
+     */
+    static PostProcessPass* createCustom(backend::Program* program,
+                                         const std::vector<std::string>& inputs,
+                                         std::string_view output,
+                                         float scale = 1.0f);
+
+    ~PostProcessPass() override;
+
+    Type getType() const { return _type; }
+    const std::vector<std::string>& getInputs() const { return _inputs; }
+    const std::string& getOutput() const { return _output; }
+
+    /** The resolution of the output relative to the viewport, the scale of a pass writing the screen is ignored. */
+    float getScale() const { return _scale; }
+
+    void setColorMatrix(const Mat4& colorMatrix, const Vec4& colorOffset = Vec4::ZERO);
+    const Mat4& getColorMatrix() const { return _colorMatrix; }
+    const Vec4& getColorOffset() const { return _colorOffset; }
+
+    /** The weight of the second input of a composite. */
+    void setWeight(float weight) { _weight = weight; }
+    float getWeight() const { return _weight; }
+
+    void setThreshold(float threshold) { _threshold = threshold; }
+    float getThreshold() const { return _threshold; }
+
+    void setDirection(const Vec2& direction) { _direction = direction; }
+    const Vec2& getDirection() const { return _direction; }
+
+    /** The program state of the pass, created on its first draw for the builtin passes. */
+    backend::ProgramState* getProgramState() const { return _programState; }
+
+protected:
+    friend class PostProcessGraph;
+
+    PostProcessPass(Type type, std::vector<std::string> inputs, std::string_view output, float scale);
+
+    void initCommand();
+    void onBeforeDraw();
+    void onAfterDraw();
+
+    Type _type;
+    std::vector<std::string> _inputs;
+    std::string _output;
+    float _scale = 1.0f;
+
+    Mat4 _colorMatrix;
+    Vec4 _colorOffset;
+    float _weight    = 1.0f;
+    float _threshold = 0.8f;
+    Vec2 _direction;
+
+    backend::ProgramState* _programState = nullptr;
+    std::vector<backend::UniformLocation> _locTextures;
+    backend::UniformLocation _locTexelSize;
+    backend::UniformLocation _locColorMatrix;
+    backend::UniformLocation _locColorOffset;
+    backend::UniformLocation _locWeight;
+    backend::UniformLocation _locThreshold;
+    backend::UniformLocation _locDirection;
+    CustomCommand _customCommand;
+    bool _commandReady = false;
+    bool _depthTest    = false;
+};
+
+/**
+ Renders what a camera sees offscreen and runs a chain of fullscreen passes on it, see `Camera::setPostProcess`.
+
+ The passes are declared with the names of what they read and write, the graph orders them by their dependencies
+ and skips the ones the screen doesn't depend on. A color pass whose input is only read by it is merged into the color
+ pass writing that input, its color matrix is folded into the draw of the other one. The intermediate targets are
+ aliased, a pass writes a target whose content no later pass reads any more, and they come from the
+ `RenderTargetPool` only while the graph runs so the graphs of other cameras share them.
+
+ Each pass overwrites its whole target, so the content of the target is never loaded, and the depth of the scene
+ never outlives its pass: on tile based GPUs neither costs any bandwidth.
+*/
+class AX_DLL PostProcessGraph : public Object
+{
+public:
+    /** The color the camera rendered. */
+    static constexpr std::string_view SCENE = "scene";
+    /** The target the camera rendered to without the graph, the graph draws its result there with blending. */
+    static constexpr std::string_view SCREEN = "screen";
+
+    static PostProcessGraph* create();
+
+    ~PostProcessGraph() override;
+
+    void addPass(PostProcessPass* pass);
+    void removePass(PostProcessPass* pass);
+    void removeAllPasses();
+    const Vector<PostProcessPass*>& getPasses() const { return _passes; }
+
+    /**
+     * Orders, culls and merges the passes, and assigns their targets. `begin` calls it after a change of the passes.
+     * @return false when the screen isn't written, a name is written twice, or the passes depend on each other.
+     */
+    bool compile();
+
+    /** The draws of the compiled graph, after the culling and the merges. */
+    size_t getDrawCount() const { return _draws.size(); }
+    /** The passes of a draw, the first one draws with the color matrices of the others folded in. */
+    const std::vector<PostProcessPass*>& getDrawPasses(size_t draw) const { return _draws[draw].passes; }
+    /** The target a draw writes, -1 for the screen. */
+    int getDrawTarget(size_t draw) const { return _draws[draw].output; }
+    /** The intermediate targets of the compiled graph, after the aliasing. */
+    size_t getTargetCount() const { return _targets.size(); }
+
+    /** Redirect the rendering to the offscreen scene target, called by `Scene::render` after the camera was applied. */
+    void begin(Renderer* renderer);
+
+    /** Run the passes and restore the render target, after the camera rendered. */
+    void end(Renderer* renderer);
+
+protected:
+    static constexpr int SCENE_TARGET  = -2;
+    static constexpr int SCREEN_TARGET = -1;
+
+    struct Draw
+    {
+        std::vector<PostProcessPass*> passes;
+        std::vector<int> inputs;
+        int output = SCREEN_TARGET;
+    };
+
+    struct Target
+    {
+        float scale                         = 1.0f;
+        Texture2D* texture                  = nullptr;
+        backend::RenderTarget* renderTarget = nullptr;
+    };
+
+    Texture2D* getInputTexture(int input) const;
+    void acquireTargets(Renderer* renderer);
+    void releaseTargets();
+    void drawPass(Renderer* renderer, const Draw& draw);
+
+    Vector<PostProcessPass*> _passes;
+    std::vector<Draw> _draws;
+    std::vector<Target> _targets;
+    bool _dirty    = true;
+    bool _compiled = false;
+    bool _running  = false;
+
+    Target _sceneTarget;
+    Texture2D* _sceneDepthStencil           = nullptr;
+    backend::RenderTarget* _oldRenderTarget = nullptr;
+    Viewport _oldViewport;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -98,6 +98,10 @@ public:
     bool isWireframe() const { return _isWireframe; }
     /**Set wireframe render mode for this command.*/
     void setWireframe(bool value) { _isWireframe = value; }
+    /**Whether the command only fills the depth buffer ahead of the opaque 3D queue, see Material::setDepthPrePass.*/
+    bool isDepthPrePass() const { return _isDepthPrePass; }
+    /**Set the command drawn in the depth pre-pass or not.*/
+    void setDepthPrePass(bool value) { _isDepthPrePass = value; }
     /// Can use the result to change the descriptor content.
     inline PipelineDescriptor& getPipelineDescriptor() { return _pipelineDescriptor; }
 
@@ -135,6 +139,9 @@ protected:
     /** Polygon render mode set to LINE, which represents wireframe mode. */
     bool _isWireframe = false;
 
+    /** Drawn in the depth pre-pass, before the opaque 3D objects. */
+    bool _isDepthPrePass = false;
+
     Mat4 _mv;
 
     PipelineDescriptor _pipelineDescriptor;
@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/RenderCommandArena.h"
+#include "base/Macros.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+RenderCommandArena::~RenderCommandArena()
+{
+    purge();
+}
+
+void* RenderCommandArena::allocate(size_t size, size_t alignment)
+{
+    AXASSERT(alignment <= alignof(std::max_align_t), "Over aligned types are not supported");
+
+    for (; _currentBlock < _blocks.size(); ++_currentBlock, _offset = 0)
+    {
+        auto& block   = _blocks[_currentBlock];
+        size_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= block.size)
+        {
+            _offset = offset + size;
+            return block.data + offset;
+        }
+    }
+
+    // grow: no block left with enough room, the new one becomes current
+    size_t blockSize = (std::max)(size, BLOCK_SIZE);
+    _blocks.emplace_back(Block{static_cast<uint8_t*>(::operator new(blockSize)), blockSize});
+    ++_heapAllocations;
+
+    _currentBlock = _blocks.size() - 1;
+    _offset       = size;
+    return _blocks.back().data;
+}
+
+void RenderCommandArena::destroyObjects()
+{
+    // objects are linked in reverse creation order
+    for (auto node = _destructors; node; node = node->next)
+        node->dtor(node->obj);
+    _destructors = nullptr;
+}
+
+void RenderCommandArena::reset()
+{
+    destroyObjects();
+    _currentBlock = 0;
+    _offset       = 0;
+}
+
+void RenderCommandArena::purge()
+{
+    reset();
+    for (auto&& block : _blocks)
+        ::operator delete(block.data);
+    _blocks.clear();
+}
+
+size_t RenderCommandArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (auto&& block : _blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+}  // namespace ax
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "platform/PlatformMacros.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+/**
+ Frame scoped linear allocator for transient render commands.
+ Objects are bump allocated from blocks which are kept across frames, so once the arena has grown to
+ the per-frame peak no more heap allocations happen. `reset` destroys all objects created since the
+ previous reset in reverse creation order and rewinds the arena. An arena is not thread-safe, each
+ thread recording commands owns its own one, see `RenderCommandRecorder`.
+*/
+class AX_DLL RenderCommandArena
+{
+public:
+    /**The size of one block, allocations bigger than it get a dedicated block.*/
+    static const size_t BLOCK_SIZE = 16 * 1024;
+
+    RenderCommandArena() = default;
+    ~RenderCommandArena();
+
+    RenderCommandArena(const RenderCommandArena&)            = delete;
+    RenderCommandArena& operator=(const RenderCommandArena&) = delete;
+
+    /**Allocate uninitialized memory, it's released by the next `reset`.*/
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**Construct an object in the arena, its destructor is invoked by the next `reset`.*/
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        auto obj = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            auto node  = new (allocate(sizeof(DestructorNode), alignof(DestructorNode))) DestructorNode;
+            node->obj  = obj;
+            node->dtor = [](void* p) { static_cast<T*>(p)->~T(); };
+            node->next = _destructors;
+            _destructors = node;
+        }
+        return obj;
+    }
+
+    /**Destroy all objects and rewind, blocks are kept for reuse.*/
+    void reset();
+
+    /**Release the memory of all blocks.*/
+    void purge();
+
+    /**The number of heap allocations performed since the last `clearHeapAllocations`.*/
+    size_t getHeapAllocations() const { return _heapAllocations; }
+    void clearHeapAllocations() { _heapAllocations = 0; }
+
+    /**The bytes of all blocks owned by the arena.*/
+    size_t getCapacity() const;
+
+private:
+    struct Block
+    {
+        uint8_t* data;
+        size_t size;
+    };
+
+    struct DestructorNode
+    {
+        void* obj;
+        void (*dtor)(void*);
+        DestructorNode* next;
+    };
+
+    void destroyObjects();
+
+    std::vector<Block> _blocks;
+    size_t _currentBlock = 0;
+    size_t _offset       = 0;
+
+    DestructorNode* _destructors = nullptr;
+    size_t _heapAllocations      = 0;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
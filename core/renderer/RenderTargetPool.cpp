@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/RenderTargetPool.h"
+#include "renderer/Texture2D.h"
+
+namespace ax
+{
+
+RenderTargetPool::~RenderTargetPool()
+{
+    for (auto&& entry : _entries)
+        entry.texture->release();
+}
+
+Texture2D* RenderTargetPool::acquireTexture(int width, int height, backend::PixelFormat format, bool premultipliedAlpha)
+{
+    return acquire(width, height, format, premultipliedAlpha, false);
+}
+
+Texture2D* RenderTargetPool::acquireTransientDepthStencil(int width, int height)
+{
+    return acquire(width, height, backend::PixelFormat::D24S8, false, true);
+}
+
+Texture2D* RenderTargetPool::acquire(int width,
+                                     int height,
+                                     backend::PixelFormat format,
+                                     bool premultipliedAlpha,
+                                     bool transient)
+{
+    for (auto&& entry : _entries)
+    {
+        if (entry.width != width || entry.height != height || entry.format != format ||
+            entry.premultipliedAlpha != premultipliedAlpha || entry.transient != transient)
+            continue;
+
+        // a transient texture is shared, the others are taken back once only the pool holds them
+        if (transient || entry.texture->getReferenceCount() == 1)
+        {
+            entry.lastUsedFrame = _frame;
+            return entry.texture;
+        }
+    }
+
+    backend::TextureDescriptor descriptor;
+    descriptor.width         = width;
+    descriptor.height        = height;
+    descriptor.textureUsage  = backend::TextureUsage::RENDER_TARGET;
+    descriptor.textureFormat = format;
+    descriptor.transient     = transient;
+
+    auto texture = new Texture2D();
+    texture->updateTextureDescriptor(descriptor, premultipliedAlpha);
+    _entries.push_back(Entry{texture, width, height, format, premultipliedAlpha, transient, _frame});
+    return texture;
+}
+
+void RenderTargetPool::endFrame()
+{
+    ++_frame;
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->texture->getReferenceCount() > 1)
+            it->lastUsedFrame = _frame;
+        else if (_frame - it->lastUsedFrame > MAX_UNUSED_FRAMES)
+        {
+            it->texture->release();
+            it = _entries.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+void RenderTargetPool::purge()
+{
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->texture->getReferenceCount() == 1)
+        {
+            it->texture->release();
+            it = _entries.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+size_t RenderTargetPool::getMemoryUsage() const
+{
+    size_t usage = 0;
+    for (auto&& entry : _entries)
+    {
+        // nothing is allocated for a memoryless texture, it is counted anyway
+        usage += (size_t)entry.width * entry.height * entry.texture->getBitsPerPixelForFormat() / 8;
+    }
+    return usage;
+}
+
+}  // namespace ax
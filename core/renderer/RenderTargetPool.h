@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "renderer/backend/Enums.h"
+
+namespace ax
+{
+
+class Texture2D;
+
+/**
+ * Reuses the render target textures across frames and passes, the grids of the effects and the render textures of
+ * the same size share a few of them. A texture goes back to the pool once nothing else references it, the ones unused
+ * for MAX_UNUSED_FRAMES frames are released.
+ *
+ * The transient depth stencil textures are shared by all the render targets of their size at once, their content
+ * doesn't outlive a render pass, see backend::RenderTarget::setTransientAttachments. They are memoryless on the tile
+ * based GPUs of Apple.
+ */
+class AX_DLL RenderTargetPool
+{
+public:
+    static constexpr unsigned int MAX_UNUSED_FRAMES = 120;
+
+    ~RenderTargetPool();
+
+    /**
+     * A render target texture referenced by nothing else, created when there is none. It isn't retained for the
+     * caller, and keeps the content and the sampler parameters of its last user.
+     */
+    Texture2D* acquireTexture(int width, int height, backend::PixelFormat format, bool premultipliedAlpha = false);
+
+    /** The depth stencil texture shared by the render targets of the size with transient depth and stencil. */
+    Texture2D* acquireTransientDepthStencil(int width, int height);
+
+    /** Releases the textures unused for too long, the renderer calls it at the end of each frame. */
+    void endFrame();
+
+    /** Releases all the textures referenced by nothing else. */
+    void purge();
+
+    size_t getTextureCount() const { return _entries.size(); }
+    size_t getMemoryUsage() const;
+
+private:
+    struct Entry
+    {
+        Texture2D* texture;
+        int width;
+        int height;
+        backend::PixelFormat format;
+        bool premultipliedAlpha;
+        bool transient;
+        unsigned int lastUsedFrame;
+    };
+
+    Texture2D* acquire(int width, int height, backend::PixelFormat format, bool premultipliedAlpha, bool transient);
+
+    std::vector<Entry> _entries;
+    unsigned int _frame = 0;
+};
+
+}  // namespace ax
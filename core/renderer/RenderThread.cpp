@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/RenderThread.h"
+#include "renderer/backend/DeferredCommandBuffer.h"
+
+namespace ax
+{
+
+RenderThread::RenderThread(backend::CommandBuffer* commandBuffer) : _commandBuffer(commandBuffer)
+{
+    _commandBuffer->retain();
+    for (auto&& frame : _frames)
+        frame = new backend::DeferredCommandBuffer(_commandBuffer);
+
+    _thread = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this] { return _submittedFrame == nullptr; });
+        _exiting = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+
+    // the recorded objects are released on the axmol thread
+    for (auto&& frame : _frames)
+        frame->release();
+    _commandBuffer->release();
+}
+
+backend::CommandBuffer* RenderThread::beginFrame()
+{
+    // the other frame may still be submitted, this one was submitted two frames ago
+    _recordingFrame = 1 - _recordingFrame;
+    auto frame      = _frames[_recordingFrame];
+    frame->reset();
+    return frame;
+}
+
+void RenderThread::submit()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this] { return _submittedFrame == nullptr; });
+        _submittedFrame = _frames[_recordingFrame];
+    }
+    _condition.notify_all();
+}
+
+void RenderThread::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this] { return _submittedFrame == nullptr; });
+}
+
+void RenderThread::run()
+{
+    for (;;)
+    {
+        backend::DeferredCommandBuffer* frame = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _submittedFrame != nullptr || _exiting; });
+            if (_exiting)
+                return;
+            frame = _submittedFrame;
+        }
+
+        _commandBuffer->beginFrame();
+        frame->execute(_commandBuffer);
+        _commandBuffer->endFrame();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _submittedFrame = nullptr;
+        }
+        _condition.notify_all();
+    }
+}
+
+}  // namespace ax
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+namespace backend
+{
+class CommandBuffer;
+class DeferredCommandBuffer;
+}  // namespace backend
+
+/**
+ * The thread which submits the frames recorded by the Renderer to the backend, see Renderer::setRenderThreadEnabled.
+ * The frames are double buffered: one is recorded on the axmol thread while the previous one is submitted.
+ */
+class RenderThread
+{
+public:
+    /** @param commandBuffer The backend command buffer, only used by the render thread from now on. */
+    explicit RenderThread(backend::CommandBuffer* commandBuffer);
+
+    /** Waits for the submitted frame and joins the thread. */
+    ~RenderThread();
+
+    /** Returns the command buffer recording the next frame, must be invoked once the previous frame is waited for. */
+    backend::CommandBuffer* beginFrame();
+
+    /** Submits the recorded frame, it is begun, encoded and ended on the render thread. */
+    void submit();
+
+    /** Waits for the submitted frame to be ended on the backend. */
+    void wait();
+
+private:
+    void run();
+
+    backend::CommandBuffer* _commandBuffer = nullptr;
+    backend::DeferredCommandBuffer* _frames[2]{};
+    int _recordingFrame = 0;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    backend::DeferredCommandBuffer* _submittedFrame = nullptr;
+    bool _exiting                                   = false;
+};
+
+}  // namespace ax
@@ -26,22 +26,31 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
 #include "renderer/CallbackCommand.h"
 #include "renderer/GroupCommand.h"
+#include "renderer/InstancedBillBoardCommand.h"
+#include "renderer/InstancedProgressCommand.h"
+#include "renderer/InstancedSpriteCommand.h"
 #include "renderer/MeshCommand.h"
 #include "renderer/Material.h"
 #include "renderer/Technique.h"
 #include "renderer/Pass.h"
 #include "renderer/Texture2D.h"
+#include "renderer/RenderThread.h"
 
 #include "base/Configuration.h"
 #include "base/Director.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
+#include "base/JobSystem.h"
+#include "base/Profiling.h"
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "xxhash.h"
@@ -53,29 +62,111 @@ namespace ax
 {
 
 // helper
-static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
+// Maps a float to an uint32 with the same ordering, -0.0 and 0.0 excepted
+static inline uint32_t orderedFloatBits(float value)
 {
-    return a->getGlobalOrder() < b->getGlobalOrder();
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
 }
 
-static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
+static inline uint64_t makeSortKey(uint32_t order, size_t sequence)
 {
-    return a->getDepth() > b->getDepth();
+    return (static_cast<uint64_t>(order) << 32) | static_cast<uint32_t>(sequence);
+}
+
+static inline uint64_t makeSortKey(RenderQueue::QUEUE_GROUP group, RenderCommand* command, size_t sequence)
+{
+    switch (group)
+    {
+    // transparent 3D objects are drawn back to front, opaque ones front to back
+    case RenderQueue::QUEUE_GROUP::TRANSPARENT_3D:
+        return makeSortKey(~orderedFloatBits(command->getDepth()), sequence);
+    case RenderQueue::QUEUE_GROUP::OPAQUE_3D:
+    case RenderQueue::QUEUE_GROUP::DEPTH_PREPASS_3D:
+        return makeSortKey(orderedFloatBits(command->getDepth()), sequence);
+    default:
+        return makeSortKey(orderedFloatBits(command->getGlobalOrder()), sequence);
+    }
+}
+
+// LSD radix sort on the high 32 bits of the keys, the low 32 bits being the ascending emplacing sequence,
+// the result is the same as a stable sort by order.
+static void radixSortKeys(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+{
+    static const size_t RADIX_SORT_THRESHOLD = 128;
+    const size_t count                       = keys.size();
+    if (count < RADIX_SORT_THRESHOLD)
+    {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    scratch.resize(count);
+    uint64_t* src = keys.data();
+    uint64_t* dst = scratch.data();
+    for (int shift = 32; shift < 64; shift += 8)
+    {
+        size_t offsets[256] = {0};
+        for (size_t i = 0; i < count; ++i)
+            ++offsets[(src[i] >> shift) & 0xff];
+
+        // most commands share few orders, skip the passes where all keys have the same digit
+        if (offsets[(src[0] >> shift) & 0xff] == count)
+            continue;
+
+        size_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            auto n = offset;
+            offset = sum;
+            sum += n;
+        }
+        for (size_t i = 0; i < count; ++i)
+            dst[offsets[(src[i] >> shift) & 0xff]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != keys.data())
+        keys.swap(scratch);
 }
 
 // queue
 RenderQueue::RenderQueue() {}
 
+bool RenderQueue::isSortedQueue(QUEUE_GROUP group) const
+{
+    switch (group)
+    {
+    case QUEUE_GROUP::GLOBALZ_NEG:
+    case QUEUE_GROUP::GLOBALZ_POS:
+    case QUEUE_GROUP::TRANSPARENT_3D:
+    case QUEUE_GROUP::DEPTH_PREPASS_3D:
+        return true;
+    case QUEUE_GROUP::OPAQUE_3D:
+        return _opaqueFrontToBack;
+    default:
+        return false;
+    }
+}
+
 void RenderQueue::emplace_back(RenderCommand* command)
 {
+    auto push = [this, command](QUEUE_GROUP group) {
+        auto& commands = _commands[group];
+        if (isSortedQueue(group))
+            _sortKeys[group].emplace_back(makeSortKey(group, command, commands.size()));
+        commands.emplace_back(command);
+    };
+
     float z = command->getGlobalOrder();
     if (z < 0)
     {
-        _commands[QUEUE_GROUP::GLOBALZ_NEG].emplace_back(command);
+        push(QUEUE_GROUP::GLOBALZ_NEG);
     }
     else if (z > 0)
     {
-        _commands[QUEUE_GROUP::GLOBALZ_POS].emplace_back(command);
+        push(QUEUE_GROUP::GLOBALZ_POS);
     }
     else
     {
@@ -83,16 +174,20 @@ void RenderQueue::emplace_back(RenderCommand* command)
         {
             if (command->isTransparent())
             {
-                _commands[QUEUE_GROUP::TRANSPARENT_3D].emplace_back(command);
+                push(QUEUE_GROUP::TRANSPARENT_3D);
+            }
+            else if (command->isDepthPrePass())
+            {
+                push(QUEUE_GROUP::DEPTH_PREPASS_3D);
             }
             else
             {
-                _commands[QUEUE_GROUP::OPAQUE_3D].emplace_back(command);
+                push(QUEUE_GROUP::OPAQUE_3D);
             }
         }
         else
         {
-            _commands[QUEUE_GROUP::GLOBALZ_ZERO].emplace_back(command);
+            push(QUEUE_GROUP::GLOBALZ_ZERO);
         }
     }
 }
@@ -111,12 +206,235 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]),
-                     std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]),
-                     compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]),
-                     compareRenderCommand);
+    for (int index = 0; index < QUEUE_GROUP::QUEUE_COUNT; ++index)
+    {
+        auto group = static_cast<QUEUE_GROUP>(index);
+        if (!isSortedQueue(group))
+            continue;
+
+        auto& commands = _commands[index];
+        auto& keys     = _sortKeys[index];
+        if (commands.size() < 2)
+        {
+            keys.clear();
+            continue;
+        }
+
+        // the sub queue was modified through getSubQueue(), rebuild the keys
+        if (keys.size() != commands.size())
+        {
+            keys.clear();
+            for (size_t i = 0, size = commands.size(); i < size; ++i)
+                keys.emplace_back(makeSortKey(group, commands[i], i));
+        }
+
+        radixSortKeys(keys, _sortKeysScratch);
+
+        _commandsScratch.resize(commands.size());
+        for (size_t i = 0, size = keys.size(); i < size; ++i)
+            _commandsScratch[i] = commands[static_cast<uint32_t>(keys[i])];
+        commands.swap(_commandsScratch);
+        keys.clear();
+    }
+
+    if (_materialReorder)
+    {
+        reorderByMaterial(_commands[QUEUE_GROUP::GLOBALZ_NEG]);
+        reorderByMaterial(_commands[QUEUE_GROUP::GLOBALZ_ZERO]);
+        reorderByMaterial(_commands[QUEUE_GROUP::GLOBALZ_POS]);
+        if (!_opaqueFrontToBack)
+            sortByState(_commands[QUEUE_GROUP::OPAQUE_3D]);
+    }
+}
+
+// Bounds of a batchable TrianglesCommand lying in the z=0 plane of the 2D world, other commands can't be reordered
+static bool getReorderBounds(RenderCommand* command, Rect& bounds)
+{
+    if (command->getType() != RenderCommand::Type::TRIANGLES_COMMAND || command->isSkipBatching())
+        return false;
+
+    auto cmd     = static_cast<TrianglesCommand*>(command);
+    auto& mv     = cmd->getModelView();
+    auto verts   = cmd->getVertices();
+    auto count   = cmd->getVertexCount();
+    if (count == 0 || mv.m[2] != 0 || mv.m[6] != 0 || mv.m[14] != 0)
+        return false;
+
+    // local bounds first, then transform the corners: cheaper than transforming every vertex
+    float minX = verts[0].vertices.x, maxX = minX;
+    float minY = verts[0].vertices.y, maxY = minY;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& v = verts[i].vertices;
+        if (v.z != 0)
+            return false;
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+    }
+
+    const Vec2 corners[4] = {{minX, minY}, {maxX, minY}, {minX, maxY}, {maxX, maxY}};
+    float left = FLT_MAX, right = -FLT_MAX, bottom = FLT_MAX, top = -FLT_MAX;
+    for (auto&& corner : corners)
+    {
+        float x  = mv.m[0] * corner.x + mv.m[4] * corner.y + mv.m[12];
+        float y  = mv.m[1] * corner.x + mv.m[5] * corner.y + mv.m[13];
+        left     = std::min(left, x);
+        right    = std::max(right, x);
+        bottom   = std::min(bottom, y);
+        top      = std::max(top, y);
+    }
+    bounds.setRect(left, bottom, right - left, top - bottom);
+    return true;
+}
+
+static inline bool overlaps(const Rect& a, const Rect& b)
+{
+    // touching edges don't overlap
+    return a.origin.x < b.origin.x + b.size.width && b.origin.x < a.origin.x + a.size.width &&
+           a.origin.y < b.origin.y + b.size.height && b.origin.y < a.origin.y + a.size.height;
+}
+
+void RenderQueue::reorderByMaterial(std::vector<RenderCommand*>& commands)
+{
+    // reorder runs of commands with the same globalZOrder, the queue is sorted by it
+    const size_t size = commands.size();
+    size_t first      = 0;
+    while (first < size)
+    {
+        float z     = commands[first]->getGlobalOrder();
+        size_t last = first + 1;
+        while (last < size && commands[last]->getGlobalOrder() == z)
+            ++last;
+        if (last - first > 2)
+            reorderRun(commands.data() + first, last - first);
+        first = last;
+    }
+}
+
+void RenderQueue::reorderRun(RenderCommand** commands, size_t count)
+{
+    // bound the scanning cost, a command rarely joins a batch farther than this
+    static const size_t MAX_BATCHES_LOOKBACK = 16;
+    static const uint32_t BARRIER            = UINT32_MAX;
+
+    _reorderBatches.clear();
+    _reorderBatchOf.resize(count);
+
+    // a command joins the latest batch with the same material when it doesn't overlap any batch after that one,
+    // commands which can't be reordered become barrier batches
+    for (size_t i = 0; i < count; ++i)
+    {
+        Rect bounds;
+        if (!getReorderBounds(commands[i], bounds))
+        {
+            _reorderBatchOf[i] = static_cast<uint32_t>(_reorderBatches.size());
+            _reorderBatches.emplace_back(ReorderBatch{BARRIER, Rect::ZERO, 1});
+            continue;
+        }
+
+        auto materialID = static_cast<TrianglesCommand*>(commands[i])->getMaterialID();
+        size_t target   = _reorderBatches.size();
+        for (size_t b = _reorderBatches.size(), lookback = 0; b > 0 && lookback < MAX_BATCHES_LOOKBACK;
+             --b, ++lookback)
+        {
+            auto& batch = _reorderBatches[b - 1];
+            if (batch.materialID == materialID)
+            {
+                target = b - 1;
+                break;
+            }
+            if (batch.materialID == BARRIER || overlaps(batch.bounds, bounds))
+                break;
+        }
+
+        if (target == _reorderBatches.size())
+        {
+            _reorderBatches.emplace_back(ReorderBatch{materialID, bounds, 1});
+        }
+        else
+        {
+            auto& batch = _reorderBatches[target];
+            batch.bounds.merge(bounds);
+            ++batch.count;
+        }
+        _reorderBatchOf[i] = static_cast<uint32_t>(target);
+    }
+
+    if (_reorderBatches.size() == count)
+        return;
+
+    // stable counting sort by batch
+    uint32_t offset = 0;
+    for (auto& batch : _reorderBatches)
+    {
+        auto n      = batch.count;
+        batch.count = offset;
+        offset += n;
+    }
+    _commandsScratch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        _commandsScratch[_reorderBatches[_reorderBatchOf[i]].count++] = commands[i];
+    std::copy_n(_commandsScratch.data(), count, commands);
+}
+
+void RenderQueue::sortByState(std::vector<RenderCommand*>& commands)
+{
+    // the other commands may change the renderer states, they stay between the runs of mesh commands
+    const size_t size = commands.size();
+    size_t first      = 0;
+    while (first < size)
+    {
+        if (commands[first]->getType() != RenderCommand::Type::MESH_COMMAND)
+        {
+            ++first;
+            continue;
+        }
+        size_t last = first + 1;
+        while (last < size && commands[last]->getType() == RenderCommand::Type::MESH_COMMAND)
+            ++last;
+        if (last - first > 1)
+            sortRunByState(commands.data() + first, last - first);
+        first = last;
+    }
+}
+
+void RenderQueue::sortRunByState(RenderCommand** commands, size_t count)
+{
+    _stateKeys.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto cmd          = static_cast<MeshCommand*>(commands[i]);
+        auto programState = cmd->getPipelineDescriptor().programState;
+
+        // the cloned materials of a model have their own program state but the same textures
+        uint64_t textures = 0;
+        if (programState)
+        {
+            for (auto&& [location, info] : programState->getFragmentTextureInfos())
+            {
+                auto hash = XXH3_64bits(info.textures.data(), info.textures.size() * sizeof(info.textures[0]));
+                textures += hash ^ static_cast<uint64_t>(location);
+            }
+        }
+
+        auto program = programState ? programState->getProgram() : nullptr;
+        _stateKeys.emplace_back(StateKey{reinterpret_cast<uintptr_t>(program), textures,
+                                         reinterpret_cast<uintptr_t>(programState),
+                                         reinterpret_cast<uintptr_t>(cmd->getVertexBuffer()),
+                                         static_cast<uint32_t>(i)});
+    }
+
+    std::sort(_stateKeys.begin(), _stateKeys.end(), [](const StateKey& a, const StateKey& b) {
+        return std::tie(a.program, a.textures, a.programState, a.vertexBuffer, a.sequence) <
+               std::tie(b.program, b.textures, b.programState, b.vertexBuffer, b.sequence);
+    });
+
+    _commandsScratch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        _commandsScratch[i] = commands[_stateKeys[i].sequence];
+    std::copy_n(_commandsScratch.data(), count, commands);
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -140,6 +458,7 @@ void RenderQueue::clear()
     for (int i = 0; i < QUEUE_GROUP::QUEUE_COUNT; ++i)
     {
         _commands[i].clear();
+        _sortKeys[i].clear();
     }
 }
 
@@ -149,9 +468,22 @@ void RenderQueue::realloc(size_t reserveSize)
     {
         _commands[i].clear();
         _commands[i].reserve(reserveSize);
+        _sortKeys[i].clear();
+        if (isSortedQueue(static_cast<QUEUE_GROUP>(i)))
+            _sortKeys[i].reserve(reserveSize);
     }
 }
 
+// recorder
+void RenderCommandRecorder::clear()
+{
+    _commands.clear();
+    _groupStack.clear();
+}
+
+// the recorder of the parallel visit root being visited on current thread
+static thread_local RenderCommandRecorder* s_currentRecorder = nullptr;
+
 //
 //
 //
@@ -175,20 +507,27 @@ Renderer::Renderer()
 
 Renderer::~Renderer()
 {
+    AX_SAFE_DELETE(_renderThread);
+
     _renderGroups.clear();
 
-    for (auto&& clearCommand : _callbackCommandsPool)
-        delete clearCommand;
-    _callbackCommandsPool.clear();
+    // the group commands release their render queue ID to the manager
+    _commandArena.purge();
 
-    for (auto&& clearCommand : _groupCommandPool)
-        delete clearCommand;
-    _groupCommandPool.clear();
+    for (auto&& recorder : _recorderPool)
+        delete recorder;
+    _recorderPool.clear();
+
+    _instancedSprites.destroy();
+    _instancedBillBoards.destroy();
+    _instancedProgresses.destroy();
 
     _groupCommandManager->release();
 
     free(_triBatchesToDraw);
 
+    AX_SAFE_RELEASE(_ringVertexBuffer);
+    AX_SAFE_RELEASE(_ringIndexBuffer);
     AX_SAFE_RELEASE(_depthStencilState);
     AX_SAFE_RELEASE(_commandBuffer);
     AX_SAFE_RELEASE(_renderPipeline);
@@ -198,15 +537,15 @@ Renderer::~Renderer()
 
 void Renderer::init()
 {
-    // Should invoke _triangleCommandBufferManager.init() first.
-    _triangleCommandBufferManager.init();
-    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
-    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+    // Should create the batch buffers first.
+    createBatchBuffers();
 
     auto driver    = backend::DriverBase::getInstance();
     _commandBuffer = driver->newCommandBuffer();
-    _dsDesc.flags = DepthStencilFlags::ALL;
-    _defaultRT    = driver->newDefaultRenderTarget();
+    _defaultRT     = driver->newDefaultRenderTarget();
+
+    _encodeState.dsDesc.flags   = DepthStencilFlags::ALL;
+    _encodeState.commandBuffer = _commandBuffer;
 
     _currentRT      = _defaultRT;
     _renderPipeline = driver->newRenderPipeline();
@@ -231,7 +570,8 @@ void Renderer::addCallbackCommand(std::function<void()> func, float globalZOrder
 
 void Renderer::addCommand(RenderCommand* command)
 {
-    int renderQueueID = _commandGroupStack.top();
+    auto recorder     = s_currentRecorder;
+    int renderQueueID = recorder ? recorder->_groupStack.back() : _commandGroupStack.top();
     addCommand(command, renderQueueID);
 }
 
@@ -241,49 +581,338 @@ void Renderer::addCommand(RenderCommand* command, int renderQueueID)
     AXASSERT(renderQueueID >= 0, "Invalid render queue");
     AXASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
 
+    if (auto recorder = s_currentRecorder)
+    {
+        recorder->_commands.emplace_back(command, renderQueueID);
+        return;
+    }
+
+    if (_batchDiagnosticsEnabled && _diagnosticsNode)
+        _commandNodes.insert_or_assign(command, _diagnosticsNode);
+
     _renderGroups[renderQueueID].emplace_back(command);
 }
 
-GroupCommand* Renderer::getNextGroupCommand()
+backend::Buffer* Renderer::streamVertices(const void* data, std::size_t size, std::size_t stride, std::size_t& offset)
+{
+    // the ring buffer is mapped by the axmol thread only, a region never spans its pages
+    if (!_ringVertexBuffer || s_currentRecorder || size > _vboSize * sizeof(_verts[0]))
+        return nullptr;
+
+    auto vertices = _ringVertexBuffer->mapRange(size, stride, offset);
+    if (!vertices)
+        return nullptr;
+
+    memcpy(vertices, data, size);
+    _ringVertexBuffer->unmapRange();
+    return _ringVertexBuffer;
+}
+
+template <typename _Command, typename _IsCompatible, typename _Init>
+void Renderer::addInstance(InstancedCommandPool<_Command>& pool,
+                           const typename _Command::Instance& instance,
+                           _IsCompatible&& isCompatible,
+                           _Init&& init)
+{
+    int renderQueueID = _commandGroupStack.top();
+    auto& queue       = _renderGroups[renderQueueID];
+
+    // join the last command only if it's still the last one of the queue, so the draw order is kept
+    auto cmd = pool.getJoinable(renderQueueID, queue.size());
+    if (!cmd || !isCompatible(cmd))
+    {
+        bool allocated = false;
+        cmd            = pool.obtain(allocated);
+        if (allocated)
+            ++_heapAllocations;
+
+        init(cmd);
+        addCommand(cmd, renderQueueID);
+        pool.setLastQueue(renderQueueID, queue.size());
+    }
+    cmd->addInstance(instance);
+}
+
+bool Renderer::addInstancedQuad(const V3F_C4B_T2F_Quad& quad,
+                                const Mat4& modelView,
+                                Texture2D* texture,
+                                const BlendFunc& blendFunc,
+                                float globalZOrder,
+                                const Mat4& projection)
+{
+    // the pool is owned by the axmol thread
+    if (s_currentRecorder)
+        return false;
+
+    InstancedSpriteCommand::Instance instance;
+    if (!InstancedSpriteCommand::makeInstance(quad, modelView, instance))
+        return false;
+
+    addInstance(
+        _instancedSprites, instance,
+        [&](InstancedSpriteCommand* cmd) { return cmd->isCompatible(globalZOrder, texture, blendFunc, projection); },
+        [&](InstancedSpriteCommand* cmd) { cmd->init(globalZOrder, texture, blendFunc, projection); });
+    return true;
+}
+
+bool Renderer::addInstancedBillBoard(const V3F_C4B_T2F_Quad& quad,
+                                     const Vec2& anchorPoint,
+                                     const Mat4& transform,
+                                     bool viewPlaneOriented,
+                                     Texture2D* texture,
+                                     const BlendFunc& blendFunc,
+                                     const Mat4& projection)
+{
+    // the pool is owned by the axmol thread
+    auto camera = Camera::getVisitingCamera();
+    if (s_currentRecorder || !camera)
+        return false;
+
+    InstancedBillBoardCommand::Instance instance;
+    if (!InstancedBillBoardCommand::makeInstance(quad, anchorPoint, transform, viewPlaneOriented, instance))
+        return false;
+
+    const auto& cameraTransform = camera->getNodeToWorldTransform();
+    addInstance(
+        _instancedBillBoards, instance,
+        [&](InstancedBillBoardCommand* cmd) {
+            return cmd->isCompatible(texture, blendFunc, projection, cameraTransform);
+        },
+        [&](InstancedBillBoardCommand* cmd) {
+            cmd->init(camera->getDepthInView(transform), texture, blendFunc, projection, cameraTransform);
+        });
+    return true;
+}
+
+bool Renderer::addInstancedProgress(const V3F_C4B_T2F_Quad& quad,
+                                    bool rotated,
+                                    const Mat4& modelView,
+                                    const ProgressShape& shape,
+                                    Texture2D* texture,
+                                    const BlendFunc& blendFunc,
+                                    float globalZOrder,
+                                    const Mat4& projection)
+{
+    // the pool is owned by the axmol thread
+    if (s_currentRecorder)
+        return false;
+
+    InstancedProgressCommand::Instance instance;
+    if (!InstancedProgressCommand::makeInstance(quad, rotated, modelView, shape.progress, instance))
+        return false;
+
+    addInstance(
+        _instancedProgresses, instance,
+        [&](InstancedProgressCommand* cmd) {
+            return cmd->isCompatible(globalZOrder, texture, blendFunc, projection, shape);
+        },
+        [&](InstancedProgressCommand* cmd) { cmd->init(globalZOrder, texture, blendFunc, projection, shape); });
+    return true;
+}
+
+void Renderer::setBatchVertexCapacity(unsigned int vertexCount)
+{
+    AXASSERT(_queuedTriangleCommands.empty(), "The queued triangles should be flushed first");
+
+#if AX_GLES_PROFILE == 200
+    // 32-bit indices are an extension of OpenGL ES 2.0
+    const unsigned int maxVertexCount = VBO_SIZE;
+#else
+    const unsigned int maxVertexCount = MAX_VBO_SIZE;
+#endif
+    vertexCount = std::clamp(vertexCount, 4u, maxVertexCount);
+    if (vertexCount == _vboSize)
+        return;
+
+    _vboSize      = vertexCount;
+    _indexVboSize = vertexCount * 6 / 4;
+
+    // only initialized renderers have buffers
+    if (!_verts.empty())
+        createBatchBuffers();
+}
+
+void Renderer::createBatchBuffers()
+{
+    // 16-bit indices address up to 65536 vertices
+    _batchIndexFormat = _vboSize > 65536 ? backend::IndexFormat::U_INT : backend::IndexFormat::U_SHORT;
+    _batchIndexSize   = _batchIndexFormat == backend::IndexFormat::U_INT ? sizeof(uint32_t) : sizeof(uint16_t);
+
+    _verts.resize(_vboSize);
+    _indices.resize((_indexVboSize * _batchIndexSize + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    _fillVerts   = _verts.data();
+    _fillIndices = _indices.data();
+    ++_heapAllocations;
+
+    const size_t vertexBufferSize = _vboSize * sizeof(_verts[0]);
+    const size_t indexBufferSize  = _indexVboSize * _batchIndexSize;
+
+    _triangleCommandBufferManager.purge();
+    _triangleCommandBufferManager.init(vertexBufferSize, indexBufferSize);
+    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
+    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+
+#ifndef AX_USE_METAL
+    // the metal buffers are already triple-buffered by _triangleCommandBufferManager
+    AX_SAFE_RELEASE_NULL(_ringVertexBuffer);
+    AX_SAFE_RELEASE_NULL(_ringIndexBuffer);
+
+    auto driver       = backend::DriverBase::getInstance();
+    _ringVertexBuffer = driver->newRingBuffer(vertexBufferSize, backend::BufferType::VERTEX);
+    _ringIndexBuffer  = driver->newRingBuffer(indexBufferSize, backend::BufferType::INDEX);
+    if (!_ringVertexBuffer || !_ringIndexBuffer)
+    {
+        AX_SAFE_RELEASE_NULL(_ringVertexBuffer);
+        AX_SAFE_RELEASE_NULL(_ringIndexBuffer);
+    }
+#endif
+
+    _queuedTotalVertexCount = _queuedTotalIndexCount = 0;
+#ifdef AX_USE_METAL
+    _queuedVertexCount = _queuedIndexCount = 0;
+#endif
+}
+
+std::size_t Renderer::getElidedStateCalls() const
 {
-    if (_groupCommandPool.empty())
+    return _commandBuffer ? _commandBuffer->getElidedStateCalls() : 0;
+}
+
+RenderCommandRecorder* Renderer::acquireRecorder()
+{
+    RenderCommandRecorder* recorder = nullptr;
+    if (!_recorderPool.empty())
+    {
+        recorder = _recorderPool.back();
+        _recorderPool.pop_back();
+    }
+    else
     {
-        return new GroupCommand();
+        recorder = new RenderCommandRecorder();
+        ++_heapAllocations;
     }
 
-    auto* command = _groupCommandPool.back();
-    _groupCommandPool.pop_back();
-    command->reset();
+    // seed here since the group stack of axmol thread may change while the recording is in progress
+    recorder->_groupStack.emplace_back(_commandGroupStack.top());
+    return recorder;
+}
+
+void Renderer::beginRecording(RenderCommandRecorder* recorder)
+{
+    AXASSERT(!s_currentRecorder, "Nested recording is not supported");
+    s_currentRecorder = recorder;
+}
+
+void Renderer::endRecording()
+{
+    s_currentRecorder = nullptr;
+}
+
+void Renderer::submitRecording(RenderCommandRecorder* recorder)
+{
+    AXASSERT(!s_currentRecorder, "Cannot submit a recording while recording");
+    for (auto&& [command, renderQueueID] : recorder->_commands)
+        _renderGroups[renderQueueID].emplace_back(command);
+    recorder->clear();
+    // the recorded commands live in the recorder arena until clean()
+    _recorderPool.emplace_back(recorder);
+}
+
+bool Renderer::isRecording() const
+{
+    return s_currentRecorder != nullptr;
+}
+
+void Renderer::discardRecording(RenderCommandRecorder* recorder)
+{
+    recorder->clear();
+    _recorderPool.emplace_back(recorder);
+}
 
-    return command;
+void Renderer::beginStaticCapture(RenderCommandRecorder* recorder)
+{
+    beginRecording(recorder);
+    _staticCapturing         = true;
+    _instancingBeforeCapture = _spriteInstancingEnabled;
+    _spriteInstancingEnabled = false;
+}
+
+void Renderer::endStaticCapture()
+{
+    endRecording();
+    _staticCapturing         = false;
+    _spriteInstancingEnabled = _instancingBeforeCapture;
+}
+
+GroupCommand* Renderer::getNextGroupCommand()
+{
+    // GroupCommand::init may create render queue, see Renderer::pushGroup
+    AXASSERT(!s_currentRecorder, "GroupCommand is not supported inside a parallel visit root");
+    return _commandArena.create<GroupCommand>();
 }
 
 void Renderer::pushGroup(int renderQueueID)
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
-    _commandGroupStack.push(renderQueueID);
+    if (auto recorder = s_currentRecorder)
+        recorder->_groupStack.emplace_back(renderQueueID);
+    else
+        _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
-    _commandGroupStack.pop();
+    if (auto recorder = s_currentRecorder)
+        recorder->_groupStack.pop_back();
+    else
+        _commandGroupStack.pop();
 }
 
 int Renderer::createRenderQueue()
 {
+    AXASSERT(!s_currentRecorder, "Cannot create render queue inside a parallel visit root");
+
     RenderQueue newRenderQueue;
     _renderGroups.emplace_back(newRenderQueue);
     return (int)_renderGroups.size() - 1;
 }
 
+void Renderer::setMaterialReorderEnabled(int renderQueueID, bool enabled)
+{
+    AXASSERT(renderQueueID >= 0 && renderQueueID < (int)_renderGroups.size(), "Invalid render queue");
+    _renderGroups[renderQueueID].setMaterialReorderEnabled(enabled);
+}
+
+bool Renderer::isMaterialReorderEnabled(int renderQueueID) const
+{
+    AXASSERT(renderQueueID >= 0 && renderQueueID < (int)_renderGroups.size(), "Invalid render queue");
+    return _renderGroups[renderQueueID].isMaterialReorderEnabled();
+}
+
+void Renderer::setOpaqueFrontToBackEnabled(int renderQueueID, bool enabled)
+{
+    AXASSERT(renderQueueID >= 0 && renderQueueID < (int)_renderGroups.size(), "Invalid render queue");
+    _renderGroups[renderQueueID].setOpaqueFrontToBackEnabled(enabled);
+}
+
+bool Renderer::isOpaqueFrontToBackEnabled(int renderQueueID) const
+{
+    AXASSERT(renderQueueID >= 0 && renderQueueID < (int)_renderGroups.size(), "Invalid render queue");
+    return _renderGroups[renderQueueID].isOpaqueFrontToBackEnabled();
+}
+
 void Renderer::processGroupCommand(GroupCommand* command)
 {
     flush();
 
     int renderQueueID = ((GroupCommand*)command)->getRenderQueueID();
 
+    if (_profilingEnabled)
+        _encodeState.commandBuffer->beginGPUTimer(fmt::format("queue {}", renderQueueID));
     visitRenderQueue(_renderGroups[renderQueueID]);
+    if (_profilingEnabled)
+        _encodeState.commandBuffer->endGPUTimer();
 }
 
 void Renderer::processRenderCommand(RenderCommand* command)
@@ -299,14 +928,27 @@ void Renderer::processRenderCommand(RenderCommand* command)
         auto cmd = static_cast<TrianglesCommand*>(command);
 
         // flush own queue when buffer is full
-        if (_queuedTotalVertexCount + cmd->getVertexCount() > VBO_SIZE ||
-            _queuedTotalIndexCount + cmd->getIndexCount() > INDEX_VBO_SIZE)
+        if (_queuedTotalVertexCount + cmd->getVertexCount() > _vboSize ||
+            _queuedTotalIndexCount + cmd->getIndexCount() > _indexVboSize)
         {
-            AXASSERT(cmd->getVertexCount() >= 0 && cmd->getVertexCount() < VBO_SIZE,
+            if (_batchDiagnosticsEnabled && !_queuedTriangleCommands.empty())
+                recordBatchBreak(BatchBreak::BUFFER_FULL, _queuedTriangleCommands.back(), cmd);
+            _batchOverflowDemand = (std::max)(_batchOverflowDemand,
+                                              _queuedTotalVertexCount + static_cast<unsigned int>(cmd->getVertexCount()));
+            drawBatchedTriangles();
+
+            if (_batchBufferAutoGrow &&
+                (cmd->getVertexCount() > _vboSize || cmd->getIndexCount() > _indexVboSize))
+            {
+                // the command alone doesn't fit, grow now, the queue is empty
+                auto vertexCount = (std::max)(static_cast<unsigned int>(cmd->getVertexCount()),
+                                              static_cast<unsigned int>(cmd->getIndexCount()) * 4 / 6 + 1);
+                setBatchVertexCapacity(utils::nextPOT(vertexCount));
+            }
+            AXASSERT(cmd->getVertexCount() <= _vboSize,
                      "VBO for vertex is not big enough, please break the data down or use customized render command");
-            AXASSERT(cmd->getIndexCount() >= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE,
+            AXASSERT(cmd->getIndexCount() <= _indexVboSize,
                      "VBO for index is not big enough, please break the data down or use customized render command");
-            drawBatchedTriangles();
 
             _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
 #ifdef AX_USE_METAL
@@ -328,21 +970,25 @@ void Renderer::processRenderCommand(RenderCommand* command)
     }
     break;
     case RenderCommand::Type::MESH_COMMAND:
+        if (_batchDiagnosticsEnabled && !_queuedTriangleCommands.empty())
+            recordBatchBreak(BatchBreak::OTHER_COMMAND, _queuedTriangleCommands.back(), command);
         flush2D();
         drawMeshCommand(command);
         break;
     case RenderCommand::Type::GROUP_COMMAND:
         processGroupCommand(static_cast<GroupCommand*>(command));
-        _groupCommandPool.emplace_back(static_cast<GroupCommand*>(command));
         break;
     case RenderCommand::Type::CUSTOM_COMMAND:
+        if (_batchDiagnosticsEnabled && !_queuedTriangleCommands.empty())
+            recordBatchBreak(BatchBreak::OTHER_COMMAND, _queuedTriangleCommands.back(), command);
         flush();
         drawCustomCommand(command);
         break;
     case RenderCommand::Type::CALLBACK_COMMAND:
+        if (_batchDiagnosticsEnabled && !_queuedTriangleCommands.empty())
+            recordBatchBreak(BatchBreak::OTHER_COMMAND, _queuedTriangleCommands.back(), command);
         flush();
         static_cast<CallbackCommand*>(command)->execute();
-        _callbackCommandsPool.emplace_back(static_cast<CallbackCommand*>(command));
         break;
     default:
         assert(false);
@@ -371,13 +1017,25 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     setDepthTest(true);  // enable depth test in 3D queue by default
     setDepthWrite(true);
     setCullMode(backend::CullMode::BACK);
-    doVisitRenderQueue(queue.getSubQueue(RenderQueue::QUEUE_GROUP::OPAQUE_3D));
+    auto& prePassQueue     = queue.getSubQueue(RenderQueue::QUEUE_GROUP::DEPTH_PREPASS_3D);
+    auto& opaqueQueue      = queue.getSubQueue(RenderQueue::QUEUE_GROUP::OPAQUE_3D);
+    auto& transparentQueue = queue.getSubQueue(RenderQueue::QUEUE_GROUP::TRANSPARENT_3D);
+#if _AX_DEBUG
+    countOverdraw(prePassQueue, opaqueQueue);
+#endif
 
-    //
-    // Process 3D Transparent object
-    //
-    setDepthWrite(false);
-    doVisitRenderQueue(queue.getSubQueue(RenderQueue::QUEUE_GROUP::TRANSPARENT_3D));
+    // fill the depth buffer first, the opaque objects of the pre-pass then only shade their visible fragments
+    doVisitRenderQueue(prePassQueue);
+    if (!encode3DQueuesInParallel(opaqueQueue, transparentQueue))
+    {
+        doVisitRenderQueue(opaqueQueue);
+
+        //
+        // Process 3D Transparent object
+        //
+        setDepthWrite(false);
+        doVisitRenderQueue(transparentQueue);
+    }
     popStateBlock();
 
     //
@@ -393,6 +1051,17 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     popStateBlock();
 }
 
+void Renderer::countOverdraw(const std::vector<RenderCommand*>& prePass, const std::vector<RenderCommand*>& opaque)
+{
+    _overdrawStats.prePassDraws += prePass.size();
+    _overdrawStats.opaqueDraws += opaque.size();
+    for (size_t i = 1, size = opaque.size(); i < size; ++i)
+    {
+        if (opaque[i]->getDepth() < opaque[i - 1]->getDepth())
+            ++_overdrawStats.nearerDraws;
+    }
+}
+
 void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderCommands)
 {
     for (const auto& command : renderCommands)
@@ -402,19 +1071,142 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
     flush();
 }
 
+bool Renderer::encode3DQueuesInParallel(const std::vector<RenderCommand*>& opaque,
+                                        const std::vector<RenderCommand*>& transparent)
+{
+    const size_t commandCount = opaque.size() + transparent.size();
+    if (!_parallelEncodingEnabled || commandCount < 2 * _parallelEncodingMinCommands || isRecording())
+        return false;
+
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    if (!jobSystem)
+        return false;
+
+    // the commands must only touch the encode state, the commands sharing a program state would race on its uniforms
+    _parallelProgramStates.clear();
+    for (auto queue : {&opaque, &transparent})
+    {
+        for (auto command : *queue)
+        {
+            auto type = command->getType();
+            if (type != RenderCommand::Type::MESH_COMMAND && type != RenderCommand::Type::CUSTOM_COMMAND)
+                return false;
+            auto programState = static_cast<CustomCommand*>(command)->getPipelineDescriptor().programState;
+            if (!_parallelProgramStates.emplace(programState).second)
+                return false;
+        }
+    }
+
+    const size_t maxChunks = (std::max)(std::thread::hardware_concurrency(), 2u);
+    const size_t chunks    = (std::min)(commandCount / _parallelEncodingMinCommands, maxChunks);
+
+    // the parallel command buffers split the pass of the current render target
+    flush();
+    beginRenderPass();
+    endRenderPass();
+    if (!_encodeState.commandBuffer->beginParallelEncoding(static_cast<int>(chunks), _parallelCommandBuffers))
+        return false;
+
+    _parallelEncodeStates.assign(chunks, _encodeState);
+    auto encodeChunk = [this, &opaque, &transparent](size_t chunk, size_t begin, size_t end) {
+        auto& state            = _parallelEncodeStates[chunk];
+        state.commandBuffer    = _parallelCommandBuffers[chunk];
+        state.lastProgram      = nullptr;
+        state.lastProgramState = nullptr;
+        state.lastVertexBuffer = nullptr;
+        workerEncodeState()    = &state;
+
+        // the chunk starts with the default state of the queue it starts in, like the serial visit
+        setDepthWrite(begin < opaque.size());
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i == opaque.size())
+                setDepthWrite(false);
+            drawCustomCommand(i < opaque.size() ? opaque[i] : transparent[i - opaque.size()]);
+        }
+
+        workerEncodeState() = nullptr;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t pending        = chunks - 1;
+    const size_t perChunk = (commandCount + chunks - 1) / chunks;
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+    {
+        jobSystem->enqueue([&, chunk] {
+            encodeChunk(chunk, chunk * perChunk, (std::min)((chunk + 1) * perChunk, commandCount));
+
+            std::lock_guard<std::mutex> lck(mutex);
+            if (--pending == 0)
+                cond.notify_all();
+        });
+    }
+
+    // the axmol thread encodes the first chunk meanwhile
+    encodeChunk(0, 0, (std::min)(perChunk, commandCount));
+    {
+        std::unique_lock<std::mutex> lck(mutex);
+        cond.wait(lck, [&pending] { return pending == 0; });
+    }
+
+    _encodeState.commandBuffer->endParallelEncoding();
+    for (auto&& state : _parallelEncodeStates)
+    {
+        _drawnBatches += state.drawnBatches;
+        _drawnVertices += state.drawnVertices;
+        _stateChanges.programs += state.stateChanges.programs;
+        _stateChanges.programStates += state.stateChanges.programStates;
+        _stateChanges.vertexBuffers += state.stateChanges.vertexBuffers;
+    }
+    return true;
+}
+
 void Renderer::render()
 {
+    AX_TRACE_SCOPE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
+
+    // all instances of the frame are queued now
+    _instancedSprites.commit();
+    _instancedBillBoards.commit();
+    _instancedProgresses.commit();
+
     //    if (_glViewAssigned)
     {
+        using namespace std::chrono;
+        auto sortStart = _profilingEnabled ? steady_clock::now() : steady_clock::time_point{};
+
         // Process render commands
         // 1. Sort render commands based on ID
         for (auto&& renderqueue : _renderGroups)
         {
             renderqueue.sort();
         }
-        visitRenderQueue(_renderGroups[0]);
+
+        if (_renderQueueCapture)
+        {
+            auto callback       = std::move(_renderQueueCapture);
+            _renderQueueCapture = nullptr;
+            callback(describeRenderQueues());
+        }
+
+        if (_profilingEnabled)
+        {
+            auto encodeStart = steady_clock::now();
+            _profileSort += duration<double, std::milli>(encodeStart - sortStart).count();
+
+            _encodeState.commandBuffer->beginGPUTimer("queue 0");
+            visitRenderQueue(_renderGroups[0]);
+            _encodeState.commandBuffer->endGPUTimer();
+
+            _lastRenderEnd = steady_clock::now();
+            _profileEncode += duration<double, std::milli>(_lastRenderEnd - encodeStart).count();
+        }
+        else
+            visitRenderQueue(_renderGroups[0]);
     }
     clean();
     _isRendering = false;
@@ -422,12 +1214,155 @@ void Renderer::render()
 
 bool Renderer::beginFrame()
 {
+    // the render thread is started and stopped between two frames
+    if (_renderThreadEnabled != (_renderThread != nullptr))
+    {
+        if (_renderThread)
+            AX_SAFE_DELETE(_renderThread);
+        else if (_commandBuffer->isRenderThreadSupported())
+            _renderThread = new RenderThread(_commandBuffer);
+        else
+        {
+            AXLOGW("Renderer: the backend doesn't support the render thread");
+            _renderThreadEnabled = false;
+        }
+    }
+
+    if (_profilingEnabled)
+    {
+        _frameStart    = std::chrono::steady_clock::now();
+        _lastRenderEnd = _frameStart;
+        _profileSort = _profileEncode = 0;
+    }
+
+    if (_renderThread)
+    {
+        _encodeState.commandBuffer = _renderThread->beginFrame();
+        return true;
+    }
+    _encodeState.commandBuffer = _commandBuffer;
     return _commandBuffer->beginFrame();
 }
 
+void Renderer::waitForRenderThread()
+{
+    if (_renderThread)
+        _renderThread->wait();
+}
+
+void Renderer::setProfilingEnabled(bool enabled)
+{
+    _profilingEnabled = enabled;
+    _frameProfile     = FrameProfile{};
+    _profileSort = _profileEncode = 0;
+    _frameStart = _lastRenderEnd = std::chrono::steady_clock::now();
+}
+
+void Renderer::setBatchDiagnosticsEnabled(bool enabled)
+{
+    _batchDiagnosticsEnabled = enabled;
+    _diagnosticsNode         = nullptr;
+    _batchBreakCounts.fill(0);
+    _batchBreaks.clear();
+    _commandNodes.clear();
+}
+
+void Renderer::recordBatchBreak(BatchBreak reason, const RenderCommand* previous, const RenderCommand* command)
+{
+    ++_batchBreakCounts[(size_t)reason];
+
+    auto materialID = [](const RenderCommand* cmd) -> uint32_t {
+        return cmd->getType() == RenderCommand::Type::TRIANGLES_COMMAND
+                   ? static_cast<const TrianglesCommand*>(cmd)->getMaterialID()
+                   : 0;
+    };
+    auto nodeOf = [this](const RenderCommand* cmd) -> const Node* {
+        auto it = _commandNodes.find(cmd);
+        return it != _commandNodes.end() ? it->second : nullptr;
+    };
+    _batchBreaks.emplace_back(
+        BatchBreakInfo{reason, materialID(previous), materialID(command), nodeOf(previous), nodeOf(command)});
+}
+
+std::string Renderer::describeRenderQueues()
+{
+    static const char* const typeNames[] = {"unknown", "quad", "custom", "group", "mesh", "triangles", "callback"};
+
+    std::string info;
+    for (size_t queueID = 0; queueID < _renderGroups.size(); ++queueID)
+    {
+        const auto& queue = _renderGroups[queueID];
+        if (queue.size() == 0)
+            continue;
+
+        fmt::format_to(std::back_inserter(info), "queue {}: {} commands\n", queueID, queue.size());
+        for (ssize_t index = 0; index < queue.size(); ++index)
+        {
+            auto command = queue[index];
+            auto type    = command->getType();
+            fmt::format_to(std::back_inserter(info), "  {:>5} {:<9} z: {}", index, typeNames[(int)type],
+                           command->getGlobalOrder());
+            if (type == RenderCommand::Type::TRIANGLES_COMMAND)
+            {
+                auto cmd = static_cast<TrianglesCommand*>(command);
+                fmt::format_to(std::back_inserter(info), " material: {:08x} vertices: {}{}", cmd->getMaterialID(),
+                               cmd->getVertexCount(), cmd->isSkipBatching() ? " skip batching" : "");
+            }
+            else if (type == RenderCommand::Type::GROUP_COMMAND)
+                fmt::format_to(std::back_inserter(info), " -> queue {}",
+                               static_cast<GroupCommand*>(command)->getRenderQueueID());
+            info += command->is3D() ? " 3d\n" : "\n";
+        }
+    }
+    return info;
+}
+
+bool Renderer::isGPUTimerSupported() const
+{
+    return _commandBuffer->isGPUTimerSupported();
+}
+
 void Renderer::endFrame()
 {
-    _commandBuffer->endFrame();
+    if (_renderThread)
+        _renderThread->submit();
+    else
+        _commandBuffer->endFrame();
+
+    if (_profilingEnabled)
+    {
+        using namespace std::chrono;
+        auto frameEnd        = steady_clock::now();
+        _frameProfile.sort   = _profileSort;
+        _frameProfile.encode = _profileEncode;
+        _frameProfile.submit = duration<double, std::milli>(frameEnd - _lastRenderEnd).count();
+        _frameProfile.visit  = duration<double, std::milli>(frameEnd - _frameStart).count() - _profileSort -
+                              _profileEncode - _frameProfile.submit;
+
+        if (_commandBuffer->getGPUTimerResults(_frameProfile.gpuTimers))
+        {
+            _frameProfile.gpu = 0;
+            for (auto&& sample : _frameProfile.gpuTimers)
+                if (sample.depth == 0)
+                    _frameProfile.gpu += sample.milliseconds;
+        }
+
+        if (Tracer::isRecording())
+        {
+            auto tracer = Tracer::getInstance();
+            tracer->addCounter("CPU visit", _frameProfile.visit);
+            tracer->addCounter("CPU sort", _frameProfile.sort);
+            tracer->addCounter("CPU encode", _frameProfile.encode);
+            tracer->addCounter("CPU submit", _frameProfile.submit);
+            tracer->addCounter("GPU", _frameProfile.gpu);
+        }
+    }
+
+    if (_ringVertexBuffer)
+    {
+        _ringVertexBuffer->endFrame();
+        _ringIndexBuffer->endFrame();
+    }
 
 #ifdef AX_USE_METAL
     _triangleCommandBufferManager.putbackAllBuffers();
@@ -436,6 +1371,13 @@ void Renderer::endFrame()
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
+
+    _renderTargetPool.endFrame();
+
+    // the batches of the frame were split because the buffers were full, grow them for the next frames
+    if (_batchBufferAutoGrow && _batchOverflowDemand > _vboSize)
+        setBatchVertexCapacity(utils::nextPOT(_batchOverflowDemand));
+    _batchOverflowDemand = 0;
 }
 
 void Renderer::clean()
@@ -453,131 +1395,212 @@ void Renderer::clean()
 
     // Clear batch commands
     _queuedTriangleCommands.clear();
+
+    _instancedSprites.reset();
+    _instancedBillBoards.reset();
+    _instancedProgresses.reset();
+
+    // Destroy transient commands, all of them have been processed
+    _commandArena.reset();
+    for (auto&& recorder : _recorderPool)
+        recorder->_arena.reset();
+}
+
+size_t Renderer::getFrameHeapAllocations() const
+{
+    size_t allocations = _heapAllocations + _commandArena.getHeapAllocations();
+    for (auto&& recorder : _recorderPool)
+        allocations += recorder->_arena.getHeapAllocations();
+    return allocations;
+}
+
+void Renderer::clearDrawStats()
+{
+    _drawnBatches = _drawnVertices = 0;
+
+    _stateChanges                 = {};
+    _overdrawStats                = {};
+    _encodeState.lastProgram      = nullptr;
+    _encodeState.lastProgramState = nullptr;
+    _encodeState.lastVertexBuffer = nullptr;
+
+    _batchBreakCounts.fill(0);
+    _batchBreaks.clear();
+    _commandNodes.clear();
+
+    _heapAllocations = 0;
+    _commandArena.clearHeapAllocations();
+    for (auto&& recorder : _recorderPool)
+        recorder->_arena.clearHeapAllocations();
 }
 
 void Renderer::setDepthTest(bool value)
 {
+    auto& dsDesc = encodeState().dsDesc;
     if (value)
-        _dsDesc.addFlag(DepthStencilFlags::DEPTH_TEST);
+        dsDesc.addFlag(DepthStencilFlags::DEPTH_TEST);
     else
-        _dsDesc.removeFlag(DepthStencilFlags::DEPTH_TEST);
+        dsDesc.removeFlag(DepthStencilFlags::DEPTH_TEST);
 }
 
 void Renderer::setStencilTest(bool value)
 {
+    auto& dsDesc = encodeState().dsDesc;
     if (value)
-        _dsDesc.addFlag(DepthStencilFlags::STENCIL_TEST);
+        dsDesc.addFlag(DepthStencilFlags::STENCIL_TEST);
     else
-        _dsDesc.removeFlag(DepthStencilFlags::STENCIL_TEST);
+        dsDesc.removeFlag(DepthStencilFlags::STENCIL_TEST);
 }
 
 void Renderer::setDepthWrite(bool value)
 {
+    auto& dsDesc = encodeState().dsDesc;
     if (value)
-        _dsDesc.addFlag(DepthStencilFlags::DEPTH_WRITE);
+        dsDesc.addFlag(DepthStencilFlags::DEPTH_WRITE);
     else
-        _dsDesc.removeFlag(DepthStencilFlags::DEPTH_WRITE);
+        dsDesc.removeFlag(DepthStencilFlags::DEPTH_WRITE);
 }
 
 void Renderer::setDepthCompareFunction(backend::CompareFunction func)
 {
-    _dsDesc.depthCompareFunction = func;
+    encodeState().dsDesc.depthCompareFunction = func;
 }
 
 backend::CompareFunction Renderer::getDepthCompareFunction() const
 {
-    return _dsDesc.depthCompareFunction;
+    return encodeState().dsDesc.depthCompareFunction;
 }
 
 bool Renderer::Renderer::getDepthTest() const
 {
-    return bitmask::any(_dsDesc.flags, DepthStencilFlags::DEPTH_TEST);
+    return bitmask::any(encodeState().dsDesc.flags, DepthStencilFlags::DEPTH_TEST);
 }
 
 bool Renderer::getStencilTest() const
 {
-    return bitmask::any(_dsDesc.flags, DepthStencilFlags::STENCIL_TEST);
+    return bitmask::any(encodeState().dsDesc.flags, DepthStencilFlags::STENCIL_TEST);
 }
 
 bool Renderer::getDepthWrite() const
 {
-    return bitmask::any(_dsDesc.flags, DepthStencilFlags::DEPTH_WRITE);
+    return bitmask::any(encodeState().dsDesc.flags, DepthStencilFlags::DEPTH_WRITE);
 }
 
 void Renderer::setStencilCompareFunction(backend::CompareFunction func, unsigned int ref, unsigned int readMask)
 {
-    _dsDesc.frontFaceStencil.stencilCompareFunction = func;
-    _dsDesc.backFaceStencil.stencilCompareFunction  = func;
+    auto& dsDesc = encodeState().dsDesc;
+    dsDesc.frontFaceStencil.stencilCompareFunction = func;
+    dsDesc.backFaceStencil.stencilCompareFunction  = func;
 
-    _dsDesc.frontFaceStencil.readMask = readMask;
-    _dsDesc.backFaceStencil.readMask  = readMask;
+    dsDesc.frontFaceStencil.readMask = readMask;
+    dsDesc.backFaceStencil.readMask  = readMask;
 
-    _stencilRef = ref;
+    encodeState().stencilRef = ref;
 }
 
 void Renderer::setStencilOperation(backend::StencilOperation stencilFailureOp,
                                    backend::StencilOperation depthFailureOp,
                                    backend::StencilOperation stencilDepthPassOp)
 {
-    _dsDesc.frontFaceStencil.stencilFailureOperation = stencilFailureOp;
-    _dsDesc.backFaceStencil.stencilFailureOperation  = stencilFailureOp;
+    auto& dsDesc = encodeState().dsDesc;
+    dsDesc.frontFaceStencil.stencilFailureOperation = stencilFailureOp;
+    dsDesc.backFaceStencil.stencilFailureOperation  = stencilFailureOp;
 
-    _dsDesc.frontFaceStencil.depthFailureOperation = depthFailureOp;
-    _dsDesc.backFaceStencil.depthFailureOperation  = depthFailureOp;
+    dsDesc.frontFaceStencil.depthFailureOperation = depthFailureOp;
+    dsDesc.backFaceStencil.depthFailureOperation  = depthFailureOp;
 
-    _dsDesc.frontFaceStencil.depthStencilPassOperation = stencilDepthPassOp;
-    _dsDesc.backFaceStencil.depthStencilPassOperation  = stencilDepthPassOp;
+    dsDesc.frontFaceStencil.depthStencilPassOperation = stencilDepthPassOp;
+    dsDesc.backFaceStencil.depthStencilPassOperation  = stencilDepthPassOp;
 }
 
 void Renderer::setStencilWriteMask(unsigned int mask)
 {
-    _dsDesc.frontFaceStencil.writeMask = mask;
-    _dsDesc.backFaceStencil.writeMask  = mask;
+    auto& dsDesc = encodeState().dsDesc;
+    dsDesc.frontFaceStencil.writeMask = mask;
+    dsDesc.backFaceStencil.writeMask  = mask;
 }
 
 backend::StencilOperation Renderer::getStencilFailureOperation() const
 {
-    return _dsDesc.frontFaceStencil.stencilFailureOperation;
+    return encodeState().dsDesc.frontFaceStencil.stencilFailureOperation;
 }
 
 backend::StencilOperation Renderer::getStencilPassDepthFailureOperation() const
 {
-    return _dsDesc.frontFaceStencil.depthFailureOperation;
+    return encodeState().dsDesc.frontFaceStencil.depthFailureOperation;
 }
 
 backend::StencilOperation Renderer::getStencilDepthPassOperation() const
 {
-    return _dsDesc.frontFaceStencil.depthStencilPassOperation;
+    return encodeState().dsDesc.frontFaceStencil.depthStencilPassOperation;
 }
 
 backend::CompareFunction Renderer::getStencilCompareFunction() const
 {
-    return _dsDesc.depthCompareFunction;
+    return encodeState().dsDesc.depthCompareFunction;
 }
 
 unsigned int Renderer::getStencilReadMask() const
 {
-    return _dsDesc.frontFaceStencil.readMask;
+    return encodeState().dsDesc.frontFaceStencil.readMask;
 }
 
 unsigned int Renderer::getStencilWriteMask() const
 {
-    return _dsDesc.frontFaceStencil.writeMask;
+    return encodeState().dsDesc.frontFaceStencil.writeMask;
 }
 
 unsigned int Renderer::getStencilReferenceValue() const
 {
-    return _stencilRef;
+    return encodeState().stencilRef;
 }
 
 void Renderer::setDepthStencilDesc(const backend::DepthStencilDescriptor& dsDesc)
 {
-    _dsDesc = dsDesc;
+    encodeState().dsDesc = dsDesc;
 }
 
 const backend::DepthStencilDescriptor& Renderer::getDepthStencilDesc() const
 {
-    return _dsDesc;
+    return encodeState().dsDesc;
+}
+
+void Renderer::setCullMode(CullMode mode)
+{
+    encodeState().cullMode = mode;
+}
+
+CullMode Renderer::getCullMode() const
+{
+    return encodeState().cullMode;
+}
+
+void Renderer::setWinding(Winding winding)
+{
+    encodeState().winding = winding;
+}
+
+Winding Renderer::getWinding() const
+{
+    return encodeState().winding;
+}
+
+Renderer::EncodeState*& Renderer::workerEncodeState()
+{
+    static thread_local EncodeState* state = nullptr;
+    return state;
+}
+
+Renderer::EncodeState& Renderer::encodeState()
+{
+    auto state = workerEncodeState();
+    return state ? *state : _encodeState;
+}
+
+const Renderer::EncodeState& Renderer::encodeState() const
+{
+    auto state = workerEncodeState();
+    return state ? *state : _encodeState;
 }
 
 void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
@@ -590,17 +1613,26 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
 
 void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
 {
-    auto destVertices = &_verts[_filledVertex];
+    auto destVertices = &_fillVerts[_filledVertex];
     auto srcVertices = cmd->getVertices();
     auto vertexCount = cmd->getVertexCount();
     auto&& modelView = cmd->getModelView();
     MathUtil::transformVertices(destVertices, srcVertices, vertexCount, modelView);
 
-    auto destIndices = &_indices[_filledIndex];
     auto srcIndices = cmd->getIndices();
     auto indexCount = cmd->getIndexCount();
     auto offset = vertexBufferOffset + _filledVertex;
-    MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(offset));
+    if (_batchIndexFormat == backend::IndexFormat::U_SHORT)
+    {
+        auto destIndices = static_cast<uint16_t*>(_fillIndices) + _filledIndex;
+        MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(offset));
+    }
+    else
+    {
+        auto destIndices = static_cast<uint32_t*>(_fillIndices) + _filledIndex;
+        for (size_t i = 0; i < indexCount; ++i)
+            destIndices[i] = srcIndices[i] + offset;
+    }
 
     _filledVertex += vertexCount;
     _filledIndex += indexCount;
@@ -618,6 +1650,33 @@ void Renderer::drawBatchedTriangles()
 #else
     unsigned int vertexBufferFillOffset = 0;
     unsigned int indexBufferFillOffset  = 0;
+
+    // write the batch into GPU visible memory, no copy into the driver and no stall on the draws in flight
+    bool mappedRing = false;
+    if (_ringVertexBuffer)
+    {
+        size_t vertexCount = 0, indexCount = 0;
+        for (const auto& cmd : _queuedTriangleCommands)
+        {
+            vertexCount += cmd->getVertexCount();
+            indexCount += cmd->getIndexCount();
+        }
+
+        size_t vertexOffset = 0, indexOffset = 0;
+        auto vertices = _ringVertexBuffer->mapRange(vertexCount * sizeof(_verts[0]), sizeof(_verts[0]), vertexOffset);
+        auto indices =
+            vertices ? _ringIndexBuffer->mapRange(indexCount * _batchIndexSize, _batchIndexSize, indexOffset) : nullptr;
+        if (indices)
+        {
+            _fillVerts             = static_cast<V3F_C4B_T2F*>(vertices);
+            _fillIndices           = indices;
+            vertexBufferFillOffset = static_cast<unsigned int>(vertexOffset / sizeof(_verts[0]));
+            indexBufferFillOffset  = static_cast<unsigned int>(indexOffset / _batchIndexSize);
+            mappedRing             = true;
+        }
+        else if (vertices)
+            _ringVertexBuffer->unmapRange();
+    }
 #endif
 
     _triBatchesToDraw[0].offset        = indexBufferFillOffset;
@@ -627,6 +1686,7 @@ void Renderer::drawBatchedTriangles()
     int batchesTotal        = 0;
     uint32_t prevMaterialID = 0;
     bool firstCommand       = true;
+    bool prevBatchable      = true;
 
     _filledVertex = 0;
     _filledIndex  = 0;
@@ -651,6 +1711,19 @@ void Renderer::drawBatchedTriangles()
             // is this the first one?
             if (!firstCommand)
             {
+                if (_batchDiagnosticsEnabled)
+                {
+                    // the material ID hashes the texture, the batch ID of the program state and the blend func
+                    auto previous = _triBatchesToDraw[batchesTotal].cmd;
+                    auto reason   = BatchBreak::BLEND_FUNC;
+                    if (!batchable || !prevBatchable)
+                        reason = BatchBreak::SKIP_BATCHING;
+                    else if (previous->getTexture() != cmd->getTexture())
+                        reason = BatchBreak::TEXTURE;
+                    else if (previous->getBatchId() != cmd->getBatchId())
+                        reason = BatchBreak::PROGRAM;
+                    recordBatchBreak(reason, previous, cmd);
+                }
                 batchesTotal++;
                 _triBatchesToDraw[batchesTotal].offset =
                     _triBatchesToDraw[batchesTotal - 1].offset + _triBatchesToDraw[batchesTotal - 1].indicesToDraw;
@@ -670,35 +1743,55 @@ void Renderer::drawBatchedTriangles()
             _triBatchesToDrawCapacity *= 1.4;
             _triBatchesToDraw =
                 (TriBatchToDraw*)realloc(_triBatchesToDraw, sizeof(_triBatchesToDraw[0]) * _triBatchesToDrawCapacity);
+            ++_heapAllocations;
         }
 
         prevMaterialID = currentMaterialID;
+        prevBatchable  = batchable;
         firstCommand   = false;
     }
     batchesTotal++;
+
+    auto vertexBuffer = _vertexBuffer;
+    auto indexBuffer  = _indexBuffer;
 #ifdef AX_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
+    _vertexBuffer->updateSubData(_verts.data(), vertexBufferFillOffset * sizeof(_verts[0]),
+                                 _filledVertex * sizeof(_verts[0]));
+    _indexBuffer->updateSubData(_indices.data(), indexBufferFillOffset * _batchIndexSize,
+                                _filledIndex * _batchIndexSize);
 #else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
+    if (mappedRing)
+    {
+        _ringVertexBuffer->unmapRange();
+        _ringIndexBuffer->unmapRange();
+        _fillVerts   = _verts.data();
+        _fillIndices = _indices.data();
+        vertexBuffer = _ringVertexBuffer;
+        indexBuffer  = _ringIndexBuffer;
+    }
+    else
+    {
+        _vertexBuffer->updateData(_verts.data(), _filledVertex * sizeof(_verts[0]));
+        _indexBuffer->updateData(_indices.data(), _filledIndex * _batchIndexSize);
+    }
 #endif
 
     /************** 2: Draw *************/
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
-    _commandBuffer->setIndexBuffer(_indexBuffer);
+    auto commandBuffer = _encodeState.commandBuffer;
+    commandBuffer->setVertexBuffer(vertexBuffer);
+    commandBuffer->setIndexBuffer(indexBuffer);
 
     for (int i = 0; i < batchesTotal; ++i)
     {
         auto& drawInfo = _triBatchesToDraw[i];
-        _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
+        commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
         auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
-        _commandBuffer->setProgramState(pipelineDescriptor.programState);
-        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, backend::IndexFormat::U_SHORT,
-                                     drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
+        commandBuffer->setProgramState(pipelineDescriptor.programState);
+        countStateChanges(pipelineDescriptor.programState, vertexBuffer);
+        commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, _batchIndexFormat, drawInfo.indicesToDraw,
+                                    drawInfo.offset * _batchIndexSize);
 
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
@@ -723,34 +1816,47 @@ void Renderer::drawCustomCommand(RenderCommand* command)
         cmd->getBeforeCallback()();
 
     beginRenderPass();
-    _commandBuffer->setVertexBuffer(cmd->getVertexBuffer());
+    auto commandBuffer = encodeState().commandBuffer;
+    commandBuffer->setVertexBuffer(cmd->getVertexBuffer());
 
-    _commandBuffer->updatePipelineState(_currentRT, cmd->getPipelineDescriptor());
-    _commandBuffer->setProgramState(cmd->getPipelineDescriptor().programState);
+    commandBuffer->updatePipelineState(_currentRT, cmd->getPipelineDescriptor());
+    commandBuffer->setProgramState(cmd->getPipelineDescriptor().programState);
+    countStateChanges(cmd->getPipelineDescriptor().programState, cmd->getVertexBuffer());
 
-    auto drawType = cmd->getDrawType();
+    size_t drawnVertices = 0;
+    auto drawType        = cmd->getDrawType();
     if (CustomCommand::DrawType::ELEMENT == drawType)
     {
-        _commandBuffer->setIndexBuffer(cmd->getIndexBuffer());
-        _commandBuffer->drawElements(cmd->getPrimitiveType(), cmd->getIndexFormat(), cmd->getIndexDrawCount(),
-                                     cmd->getIndexDrawOffset(), cmd->isWireframe());
-        _drawnVertices += cmd->getIndexDrawCount();
+        commandBuffer->setIndexBuffer(cmd->getIndexBuffer());
+        commandBuffer->drawElements(cmd->getPrimitiveType(), cmd->getIndexFormat(), cmd->getIndexDrawCount(),
+                                    cmd->getIndexDrawOffset(), cmd->isWireframe());
+        drawnVertices = cmd->getIndexDrawCount();
     }
     else if (CustomCommand::DrawType::ELEMENT_INSTANCE == drawType)
     {
-        _commandBuffer->setIndexBuffer(cmd->getIndexBuffer());
-        _commandBuffer->setInstanceBuffer(cmd->getInstanceBuffer());
-        _commandBuffer->drawElementsInstanced(cmd->getPrimitiveType(), cmd->getIndexFormat(), cmd->getIndexDrawCount(),
-                                              cmd->getIndexDrawOffset(), cmd->getInstanceCount(), cmd->isWireframe());
-        _drawnVertices += cmd->getIndexDrawCount() * cmd->getInstanceCount();
+        commandBuffer->setIndexBuffer(cmd->getIndexBuffer());
+        commandBuffer->setInstanceBuffer(cmd->getInstanceBuffer());
+        commandBuffer->drawElementsInstanced(cmd->getPrimitiveType(), cmd->getIndexFormat(), cmd->getIndexDrawCount(),
+                                             cmd->getIndexDrawOffset(), cmd->getInstanceCount(), cmd->isWireframe());
+        drawnVertices = cmd->getIndexDrawCount() * cmd->getInstanceCount();
+    }
+    else
+    {
+        commandBuffer->drawArrays(cmd->getPrimitiveType(), cmd->getVertexDrawStart(), cmd->getVertexDrawCount(),
+                                  cmd->isWireframe());
+        drawnVertices = cmd->getVertexDrawCount();
+    }
+
+    if (auto worker = workerEncodeState())
+    {
+        ++worker->drawnBatches;
+        worker->drawnVertices += drawnVertices;
     }
     else
     {
-        _commandBuffer->drawArrays(cmd->getPrimitiveType(), cmd->getVertexDrawStart(), cmd->getVertexDrawCount(),
-                                   cmd->isWireframe());
-        _drawnVertices += cmd->getVertexDrawCount();
+        ++_drawnBatches;
+        _drawnVertices += drawnVertices;
     }
-    _drawnBatches++;
     endRenderPass();
 
     if (cmd->getAfterCallback())
@@ -763,6 +1869,30 @@ void Renderer::drawMeshCommand(RenderCommand* command)
     drawCustomCommand(command);
 }
 
+void Renderer::countStateChanges(backend::ProgramState* programState, backend::Buffer* vertexBuffer)
+{
+    auto& state   = encodeState();
+    auto worker   = workerEncodeState();
+    auto& changes = worker ? worker->stateChanges : _stateChanges;
+
+    auto program = programState ? programState->getProgram() : nullptr;
+    if (program != state.lastProgram)
+    {
+        ++changes.programs;
+        state.lastProgram = program;
+    }
+    if (programState != state.lastProgramState)
+    {
+        ++changes.programStates;
+        state.lastProgramState = programState;
+    }
+    if (vertexBuffer != state.lastVertexBuffer)
+    {
+        ++changes.vertexBuffers;
+        state.lastVertexBuffer = vertexBuffer;
+    }
+}
+
 void Renderer::flush()
 {
     flush2D();
@@ -788,6 +1918,10 @@ void Renderer::flushTriangles()
 // helpers
 bool Renderer::checkVisibility(const Mat4& transform, const Vec2& size)
 {
+    // a static batch keeps the triangles out of view too
+    if (_staticCapturing)
+        return true;
+
     auto director = Director::getInstance();
     auto scene    = director->getRunningScene();
 
@@ -828,15 +1962,25 @@ void Renderer::readPixels(backend::RenderTarget* rt,
         _defaultRT)  // read pixels from screen, metal renderer backend: screen texture must not be a framebufferOnly
         backend::DriverBase::getInstance()->setFrameBufferOnly(false);
 
-    _commandBuffer->readPixels(rt, std::move(callback));
+    // the pixels are read by the render thread, the callback runs on the axmol thread like without it
+    if (_renderThread)
+    {
+        callback = [callback = std::move(callback)](const backend::PixelBufferDescriptor& pbd) {
+            Director::getInstance()->getScheduler()->runOnAxmolThread(
+                [callback, pbd = backend::PixelBufferDescriptor(pbd)] { callback(pbd); });
+        };
+    }
+    _encodeState.commandBuffer->readPixels(rt, std::move(callback));
 }
 
 void Renderer::beginRenderPass()
 {
-    _commandBuffer->beginRenderPass(_currentRT, _renderPassDesc);
+    auto& state        = encodeState();
+    auto commandBuffer = state.commandBuffer;
+    commandBuffer->beginRenderPass(_currentRT, _renderPassDesc);
 
     // Disable depth/stencil access if render target has no relevant attachments.
-    auto depthStencil = _dsDesc;
+    auto depthStencil = state.dsDesc;
     if (!_currentRT->isDefaultRenderTarget())
     {
         if (!_currentRT->_depth)
@@ -845,19 +1989,19 @@ void Renderer::beginRenderPass()
             depthStencil.removeFlag(DepthStencilFlags::STENCIL_TEST);
     }
 
-    _commandBuffer->updateDepthStencilState(depthStencil);
-    _commandBuffer->setStencilReferenceValue(_stencilRef);
+    commandBuffer->updateDepthStencilState(depthStencil);
+    commandBuffer->setStencilReferenceValue(state.stencilRef);
 
-    _commandBuffer->setViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height);
-    _commandBuffer->setCullMode(_cullMode);
-    _commandBuffer->setWinding(_winding);
-    _commandBuffer->setScissorRect(_scissorState.isEnabled, _scissorState.rect.x, _scissorState.rect.y,
-                                   _scissorState.rect.width, _scissorState.rect.height);
+    commandBuffer->setViewport(_viewport.x, _viewport.y, _viewport.width, _viewport.height);
+    commandBuffer->setCullMode(state.cullMode);
+    commandBuffer->setWinding(state.winding);
+    commandBuffer->setScissorRect(_scissorState.isEnabled, _scissorState.rect.x, _scissorState.rect.y,
+                                  _scissorState.rect.width, _scissorState.rect.height);
 }
 
 void Renderer::endRenderPass()
 {
-    _commandBuffer->endRenderPass();
+    encodeState().commandBuffer->endRenderPass();
 }
 
 void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigned int stencil, float globalOrder)
@@ -883,26 +2027,21 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
         if (bitmask::any(flags, ClearFlag::STENCIL))
             descriptor.clearStencilValue = stencil;
 
-        _commandBuffer->setScissorRect(_scissorState.isEnabled, _scissorState.rect.x, _scissorState.rect.y,
-                                       _scissorState.rect.width, _scissorState.rect.height);
-        _commandBuffer->beginRenderPass(_currentRT, descriptor);
-        _commandBuffer->endRenderPass();
+        auto commandBuffer = _encodeState.commandBuffer;
+        commandBuffer->setScissorRect(_scissorState.isEnabled, _scissorState.rect.x, _scissorState.rect.y,
+                                      _scissorState.rect.width, _scissorState.rect.height);
+        commandBuffer->beginRenderPass(_currentRT, descriptor);
+        commandBuffer->endRenderPass();
     };
     addCommand(command);
 }
 
 CallbackCommand* Renderer::nextCallbackCommand()
 {
-    CallbackCommand* cmd = nullptr;
-    if (!_callbackCommandsPool.empty())
-    {
-        cmd = _callbackCommandsPool.back();
-        cmd->reset();
-        _callbackCommandsPool.pop_back();
-    }
-    else
-        cmd = new CallbackCommand();
-    return cmd;
+    // workers recording a parallel visit root use their own arena, no locking required
+    auto recorder = s_currentRecorder;
+    auto& arena   = recorder ? recorder->_arena : _commandArena;
+    return arena.create<CallbackCommand>();
 }
 
 const Color4F& Renderer::getClearColor() const
@@ -950,17 +2089,28 @@ void Renderer::setScissorRect(float x, float y, float width, float height)
 
 // TriangleCommandBufferManager
 Renderer::TriangleCommandBufferManager::~TriangleCommandBufferManager()
+{
+    purge();
+}
+
+void Renderer::TriangleCommandBufferManager::init(std::size_t vertexBufferSize, std::size_t indexBufferSize)
+{
+    _vertexBufferSize = vertexBufferSize;
+    _indexBufferSize  = indexBufferSize;
+    createBuffer();
+}
+
+void Renderer::TriangleCommandBufferManager::purge()
 {
     for (auto&& vertexBuffer : _vertexBufferPool)
         vertexBuffer->release();
+    _vertexBufferPool.clear();
 
     for (auto&& indexBuffer : _indexBufferPool)
         indexBuffer->release();
-}
+    _indexBufferPool.clear();
 
-void Renderer::TriangleCommandBufferManager::init()
-{
-    createBuffer();
+    _currentBufferIndex = 0;
 }
 
 void Renderer::TriangleCommandBufferManager::putbackAllBuffers()
@@ -998,13 +2148,11 @@ void Renderer::TriangleCommandBufferManager::createBuffer()
     // This change does fix the Android/OpenGL ES performance problem
     // If for some reason we get reports of performance issues on OpenGL implementations,
     // then we can just add pre-processor checks for OpenGL and have the updateData() allocate the full size after buffer creation.
-    auto vertexBuffer = driver->newBuffer(Renderer::VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
+    auto vertexBuffer = driver->newBuffer(_vertexBufferSize, backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
     if (!vertexBuffer)
         return;
 
-    auto indexBuffer = driver->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
+    auto indexBuffer = driver->newBuffer(_indexBufferSize, backend::BufferType::INDEX, backend::BufferUsage::DYNAMIC);
     if (!indexBuffer)
     {
         vertexBuffer->release();
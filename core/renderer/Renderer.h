@@ -30,11 +30,18 @@
 #include <array>
 #include <deque>
 #include <optional>
+#include <chrono>
+#include <functional>
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/RenderCommandArena.h"
+#include "renderer/InstancedCommand.h"
+#include "renderer/RenderTargetPool.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
+#include "tsl/robin_set.h"
+#include "tsl/robin_map.h"
 
 /**
  * @addtogroup renderer
@@ -63,8 +70,14 @@ class TrianglesCommand;
 class MeshCommand;
 class GroupCommand;
 class CallbackCommand;
+class InstancedSpriteCommand;
+class InstancedBillBoardCommand;
+class InstancedProgressCommand;
+struct ProgressShape;
 struct PipelineDescriptor;
 class Texture2D;
+class Node;
+class RenderThread;
 
 /** Class that knows how to sort `RenderCommand` objects.
  Since the commands that have `z == 0` are "pushed back" in
@@ -89,7 +102,9 @@ public:
         GLOBALZ_ZERO = 3,
         /**Objects with globalZ bigger than 0.*/
         GLOBALZ_POS = 4,
-        QUEUE_COUNT = 5,
+        /**Depth-only draws of opaque 3D objects with 0 globalZ, drawn before OPAQUE_3D.*/
+        DEPTH_PREPASS_3D = 5,
+        QUEUE_COUNT = 6,
     };
 
 public:
@@ -112,9 +127,69 @@ public:
     /**Get the number of render commands contained in a subqueue.*/
     ssize_t getSubQueueSize(QUEUE_GROUP group) const { return _commands[group].size(); }
 
+    /**
+    Enable/disable reordering 2D TrianglesCommands with the same globalZOrder by material ID to increase batching.
+    A command is only moved ahead of commands whose screen-space bounds it doesn't overlap, so the result looks the
+    same as the submission order.
+    The consecutive MeshCommands of the opaque 3D queue are also sorted by program, material and mesh, the depth test
+    makes their order invisible. Disabled by default.
+    */
+    void setMaterialReorderEnabled(bool enabled) { _materialReorder = enabled; }
+    bool isMaterialReorderEnabled() const { return _materialReorder; }
+
+    /**
+    Enable/disable sorting the opaque 3D queue front to back by the depth of the commands, so the depth test rejects
+    the hidden fragments before they are shaded. It takes precedence over the state sorting of
+    setMaterialReorderEnabled. The depth pre-pass queue is always sorted front to back. Disabled by default.
+    */
+    void setOpaqueFrontToBackEnabled(bool enabled) { _opaqueFrontToBack = enabled; }
+    bool isOpaqueFrontToBackEnabled() const { return _opaqueFrontToBack; }
+
+protected:
+    /**Reorder consecutive TrianglesCommands with the same globalZOrder, see setMaterialReorderEnabled.*/
+    void reorderByMaterial(std::vector<RenderCommand*>& commands);
+    void reorderRun(RenderCommand** first, size_t count);
+    /**Sort the consecutive MeshCommands of the opaque 3D queue by state, see setMaterialReorderEnabled.*/
+    void sortByState(std::vector<RenderCommand*>& commands);
+    void sortRunByState(RenderCommand** first, size_t count);
+    /**Whether the sub queue is sorted by its keys.*/
+    bool isSortedQueue(QUEUE_GROUP group) const;
+
 protected:
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
+    /**
+    Sort keys of the sub queues which need sorting, built while emplacing so `sort` doesn't chase command pointers.
+    A key packs the order (globalZ or depth) mapped to an ascending uint32 in the high 32 bits and the emplacing
+    sequence in the low 32 bits, which keeps the sort stable.
+    */
+    std::vector<uint64_t> _sortKeys[QUEUE_COUNT];
+    /**Scratch buffers of sort.*/
+    std::vector<uint64_t> _sortKeysScratch;
+    std::vector<RenderCommand*> _commandsScratch;
+
+    /**Batches of the material reordering, the bounds are the union of the bounds of their commands.*/
+    struct ReorderBatch
+    {
+        uint32_t materialID;
+        Rect bounds;
+        uint32_t count;
+    };
+    std::vector<ReorderBatch> _reorderBatches;
+    std::vector<uint32_t> _reorderBatchOf;
+    bool _materialReorder = false;
+    bool _opaqueFrontToBack = false;
+
+    /**Sort key of a MeshCommand of the opaque 3D queue, the sequence keeps the sort stable.*/
+    struct StateKey
+    {
+        uintptr_t program;
+        uint64_t textures;
+        uintptr_t programState;
+        uintptr_t vertexBuffer;
+        uint32_t sequence;
+    };
+    std::vector<StateKey> _stateKeys;
 
     /**Cull state.*/
     bool _isCullEnabled;
@@ -124,6 +199,32 @@ protected:
     bool _isDepthWrite;
 };
 
+/** Records the render commands emitted while a parallel visit root is visited on a JobSystem worker.
+ The recorded commands are submitted to the renderer on the axmol thread in visiting order, so the
+ content of the render queues is the same as a serial visit.
+ @see Node::setParallelVisitRoot
+*/
+class RenderCommandRecorder
+{
+public:
+    /**Return the number of recorded commands.*/
+    size_t size() const { return _commands.size(); }
+    /**Return the recorded commands, valid until the recorder is submitted or discarded.*/
+    const std::vector<std::pair<RenderCommand*, int>>& getCommands() const { return _commands; }
+    /**Clear all recorded commands.*/
+    void clear();
+
+protected:
+    friend class Renderer;
+
+    /**The recorded commands and the render queue ID they were added to.*/
+    std::vector<std::pair<RenderCommand*, int>> _commands;
+    /**Recorder owned render queue ID stack, seeded with the renderer current queue ID.*/
+    std::vector<int> _groupStack;
+    /**Transient commands created on the recording thread, reset by Renderer::clean.*/
+    RenderCommandArena _arena;
+};
+
 class GroupCommandManager;
 
 /* Class responsible for the rendering in.
@@ -133,10 +234,12 @@ Whenever possible prefer to use `TrianglesCommand` objects since the renderer wi
 class AX_DLL Renderer
 {
 public:
-    /**The max number of vertices in a vertex buffer object.*/
+    /**The default max number of vertices in a vertex buffer object, see setBatchVertexCapacity.*/
     static const int VBO_SIZE = 65536;
-    /**The max number of indices in a index buffer.*/
+    /**The default max number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The max number of vertices the batch buffers can grow to.*/
+    static const int MAX_VBO_SIZE = 1 << 20;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -169,6 +272,94 @@ public:
     /** Creates a render queue and returns its Id */
     int createRenderQueue();
 
+    /** Enable/disable reordering commands by material in a render queue, see RenderQueue::setMaterialReorderEnabled */
+    void setMaterialReorderEnabled(int renderQueueID, bool enabled);
+    bool isMaterialReorderEnabled(int renderQueueID) const;
+
+    /** Enable/disable sorting the opaque 3D commands of a render queue front to back,
+     * see RenderQueue::setOpaqueFrontToBackEnabled */
+    void setOpaqueFrontToBackEnabled(int renderQueueID, bool enabled);
+    bool isOpaqueFrontToBackEnabled(int renderQueueID) const;
+
+    /**
+     Enable/disable drawing the quads of sprites which use the default program with instanced draws,
+     consecutive quads sharing a texture and blend function are drawn with one call. Disabled by default.
+     */
+    void setSpriteInstancingEnabled(bool enabled) { _spriteInstancingEnabled = enabled; }
+    bool isSpriteInstancingEnabled() const { return _spriteInstancingEnabled; }
+
+    /**
+     Adds a sprite quad to the last added `InstancedSpriteCommand`, or to a new one when the quad can't join it.
+     @return false if the quad can't be drawn instanced, the caller should add a `TrianglesCommand` instead.
+     */
+    bool addInstancedQuad(const V3F_C4B_T2F_Quad& quad,
+                          const Mat4& modelView,
+                          Texture2D* texture,
+                          const BlendFunc& blendFunc,
+                          float globalZOrder,
+                          const Mat4& projection);
+
+    /**
+     Enable/disable drawing the billboards which use the default program with instanced draws, the vertex shader turns
+     them towards the camera. Consecutive billboards sharing a texture and blend function are drawn with one call,
+     without being sorted by depth with each other. Disabled by default.
+     */
+    void setBillBoardInstancingEnabled(bool enabled) { _billBoardInstancingEnabled = enabled; }
+    bool isBillBoardInstancingEnabled() const { return _billBoardInstancingEnabled; }
+
+    /**
+     Adds a billboard quad to the last added `InstancedBillBoardCommand`, or to a new one when it can't join it.
+     @param anchorPoint the point the billboard turns around, in the billboard coordinates.
+     @param transform the billboard to world transform, without the rotation towards the camera.
+     @return false if the quad can't be drawn instanced, the caller should add a `TrianglesCommand` instead.
+     */
+    bool addInstancedBillBoard(const V3F_C4B_T2F_Quad& quad,
+                               const Vec2& anchorPoint,
+                               const Mat4& transform,
+                               bool viewPlaneOriented,
+                               Texture2D* texture,
+                               const BlendFunc& blendFunc,
+                               const Mat4& projection);
+
+    /**
+     Adds a progress timer to the last added `InstancedProgressCommand`, or to a new one when it can't join it.
+     Used by the progress timers drawn by their shaders, see `ProgressTimer::setShaderProgressEnabled`.
+     @param rotated whether the texture rect of the quad is rotated.
+     @return false if the timer can't be drawn instanced, the caller should draw its vertices instead.
+     */
+    bool addInstancedProgress(const V3F_C4B_T2F_Quad& quad,
+                              bool rotated,
+                              const Mat4& modelView,
+                              const ProgressShape& shape,
+                              Texture2D* texture,
+                              const BlendFunc& blendFunc,
+                              float globalZOrder,
+                              const Mat4& projection);
+
+    /**
+     Copies vertices drawn only in the current frame into the ring vertex buffer, so no buffer is owned, grown or
+     updated in place by the caller. The region is kept until the GPU completed the frame.
+     @param offset Receives the offset in bytes of the vertices in the returned buffer, a multiple of stride.
+     @return The ring vertex buffer, or nullptr if the driver has no ring buffers, the vertices are bigger than a
+     page of it, or the caller is recording on a worker thread. The caller should then upload the vertices itself.
+     */
+    backend::Buffer* streamVertices(const void* data, std::size_t size, std::size_t stride, std::size_t& offset);
+
+    /**
+     Set the number of vertices the buffers batching TrianglesCommands can hold, the index capacity is 1.5 times it.
+     Above 65536 vertices the batches are drawn with 32-bit indices. Defaults to VBO_SIZE.
+     */
+    void setBatchVertexCapacity(unsigned int vertexCount);
+    unsigned int getBatchVertexCapacity() const { return _vboSize; }
+
+    /**
+     Enable/disable growing the batch buffers with the load: a TrianglesCommand which doesn't fit grows them instead
+     of asserting, and after a frame whose batches were split because the buffers were full, they are grown to hold
+     the whole frame, up to MAX_VBO_SIZE. Enabled by default.
+     */
+    void setBatchBufferAutoGrow(bool enabled) { _batchBufferAutoGrow = enabled; }
+    bool isBatchBufferAutoGrow() const { return _batchBufferAutoGrow; }
+
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
@@ -183,8 +374,104 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /** The state changes between consecutive custom, mesh and batched triangles draws. */
+    struct StateChanges
+    {
+        size_t programs      = 0;
+        size_t programStates = 0;  ///< the uniforms and textures, i.e. the materials
+        size_t vertexBuffers = 0;
+    };
+    /* returns the state changes of the last frame */
+    const StateChanges& getStateChanges() const { return _stateChanges; }
+    /** The overdraw indicators of the opaque 3D queues, only counted in debug builds. */
+    struct OverdrawStats
+    {
+        size_t prePassDraws = 0;  ///< the depth-only draws, see Material::setDepthPrePass
+        size_t opaqueDraws  = 0;
+        size_t nearerDraws  = 0;  ///< the opaque draws nearer than the draw before them, they may hide shaded fragments
+    };
+    /* returns the overdraw indicators of the last frame, always zero in release builds */
+    const OverdrawStats& getOverdrawStats() const { return _overdrawStats; }
+    /* returns the number of redundant backend state calls skipped in the last frame */
+    std::size_t getElidedStateCalls() const;
+    /* returns the number of heap allocations made by the renderer for transient commands in the last frame */
+    size_t getFrameHeapAllocations() const;
+
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats();
+
+    /** Why a batch of TrianglesCommands ended, see setBatchDiagnosticsEnabled. */
+    enum class BatchBreak
+    {
+        TEXTURE,        ///< the next command has another texture
+        PROGRAM,        ///< the next command has another program or other uniforms
+        BLEND_FUNC,     ///< the next command has another blend func
+        SKIP_BATCHING,  ///< the next or the previous command doesn't batch
+        BUFFER_FULL,    ///< the batch vertex or index buffer is full
+        OTHER_COMMAND,  ///< a mesh, custom or callback command flushed the batch
+        COUNT
+    };
+
+    /**
+     * A batch break of the last frame, between the last command of a batch and the one starting the next batch.
+     * The nodes which added them are only to be compared, they may be gone, nullptr when unknown.
+     */
+    struct BatchBreakInfo
+    {
+        BatchBreak reason;
+        uint32_t previousMaterialID;  ///< 0 when the command isn't a TrianglesCommand
+        uint32_t materialID;
+        const Node* previousNode;
+        const Node* node;
+    };
+
+    /**
+     * Records the batch breaks of the frames and the nodes which caused them, for the performance tools.
+     * Node::visit tells the renderer which node is visited, it costs a hash insertion per command while enabled.
+     * The commands of parallel visits and static batches have no node. Disabled by default.
+     */
+    void setBatchDiagnosticsEnabled(bool enabled);
+    bool isBatchDiagnosticsEnabled() const { return _batchDiagnosticsEnabled; }
+    /** The batch break count of the last frame by reason. */
+    const std::array<uint32_t, (size_t)BatchBreak::COUNT>& getBatchBreakCounts() const { return _batchBreakCounts; }
+    /** The batch breaks of the last frame in draw order. */
+    const std::vector<BatchBreakInfo>& getBatchBreaks() const { return _batchBreaks; }
+    /** Sets the node whose commands are added, returns the previous one, see setBatchDiagnosticsEnabled. */
+    const Node* setDiagnosticsNode(const Node* node)
+    {
+        auto previous    = _diagnosticsNode;
+        _diagnosticsNode = node;
+        return previous;
+    }
+
+    /** The CPU and GPU timings of a frame in milliseconds, see setProfilingEnabled. */
+    struct FrameProfile
+    {
+        double visit  = 0;  ///< update, visit and the rest of the frame on the axmol thread
+        double sort   = 0;  ///< sorting the render queues
+        double encode = 0;  ///< processing the render commands into the command buffer
+        double submit = 0;  ///< from the last render to the end of the frame: buffer swap and driver submission
+        double gpu    = 0;  ///< the GPU time of the latest frame the GPU finished, 0 if not supported
+        /** The GPU scopes of that frame: render queue 0 per render and one per GroupCommand, nested. */
+        std::vector<backend::GPUTimerSample> gpuTimers;
+    };
+
+    /**
+     * Measure where the frame time goes, to tell a CPU bound frame from a GPU bound one. The GPU time is measured
+     * with timer queries when the backend supports them, see `backend::CommandBuffer::isGPUTimerSupported`.
+     * Disabled by default, also see the `profiler` command of the Console.
+     */
+    void setProfilingEnabled(bool enabled);
+    bool isProfilingEnabled() const { return _profilingEnabled; }
+    bool isGPUTimerSupported() const;
+    /** The profile of the last frame, the GPU timings lag a few frames behind. */
+    const FrameProfile& getFrameProfile() const { return _frameProfile; }
+
+    /**
+     * Describe the sorted render queues of the next render, one line per command with its type, global order,
+     * material ID and vertex count, and pass the text to the callback. See the `renderqueue` Console command.
+     */
+    void captureRenderQueues(std::function<void(std::string)> callback) { _renderQueueCapture = std::move(callback); }
 
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
@@ -359,25 +646,25 @@ public:
      * Fixed-function state
      * @param mode Controls if primitives are culled when front facing, back facing, or not culled at all.
      */
-    void setCullMode(CullMode mode) { _cullMode = mode; }
+    void setCullMode(CullMode mode);
 
     /**
      * Get cull mode.
      * @return The cull mode.
      */
-    CullMode getCullMode() const { return _cullMode; }
+    CullMode getCullMode() const;
 
     /**
      * Fixed-function state
      * @param winding The winding order of front-facing primitives.
      */
-    void setWinding(Winding winding) { _winding = winding; }
+    void setWinding(Winding winding);
 
     /**
      * Get winding mode.
      * @return The winding mode.
      */
-    Winding getWinding() const { return _winding; }
+    Winding getWinding() const;
 
     /**
      * Fixed-function state
@@ -408,6 +695,10 @@ public:
     const ScissorRect& getScissorRect() const;  ///< Get scissor rectangle.
 
     backend::CommandBuffer* getCommandBuffer() const { return _commandBuffer ; }
+    backend::RenderPipeline* getRenderPipeline() const { return _renderPipeline; }
+
+    /** The render target textures shared by the offscreen passes. */
+    RenderTargetPool* getRenderTargetPool() { return &_renderTargetPool; }
 
     /** returns whether or not a rectangle is visible or not */
     bool checkVisibility(const Mat4& transform, const Vec2& size);
@@ -420,6 +711,68 @@ public:
 
     CallbackCommand* nextCallbackCommand();
 
+    /**
+     * Enable/disable visiting nodes flagged with `Node::setParallelVisitRoot` on JobSystem workers.
+     * Disabled by default.
+     */
+    void setParallelVisitEnabled(bool enabled) { _parallelVisitEnabled = enabled; }
+    bool isParallelVisitEnabled() const { return _parallelVisitEnabled; }
+
+    /**
+     * Enable/disable encoding the 3D opaque and transparent queues on JobSystem workers when the backend supports
+     * parallel encoding, i.e. Metal. The queues are split into ordered chunks of at least `minCommands` commands.
+     * Only queues made of mesh and custom commands which don't share program states are encoded in parallel, the
+     * before/after callbacks of the commands run on the workers and must only change the renderer state.
+     * Disabled by default.
+     */
+    void setParallelEncodingEnabled(bool enabled) { _parallelEncodingEnabled = enabled; }
+    bool isParallelEncodingEnabled() const { return _parallelEncodingEnabled; }
+    void setParallelEncodingMinCommands(unsigned int minCommands) { _parallelEncodingMinCommands = (std::max)(minCommands, 1u); }
+    unsigned int getParallelEncodingMinCommands() const { return _parallelEncodingMinCommands; }
+
+    /**
+     * Enable/disable the render thread. The frames are recorded with snapshots of the program states they use, and a
+     * dedicated thread begins, encodes and ends them on the backend while the axmol thread updates the next frame.
+     * The backend command buffer must support it, i.e. Metal, the render thread isn't started otherwise.
+     * The buffers and textures are still updated on the axmol thread, they must be updated while visiting the scene
+     * and not in the scheduled updates, which run while the previous frame is submitted.
+     * The change applies from the next frame. Disabled by default.
+     */
+    void setRenderThreadEnabled(bool enabled) { _renderThreadEnabled = enabled; }
+    bool isRenderThreadEnabled() const { return _renderThreadEnabled; }
+    /** Whether the frames are submitted by the render thread. */
+    bool isRenderThreadRunning() const { return _renderThread != nullptr; }
+
+    /** Waits for the render thread to submit the previous frame, the Director invokes it before visiting the scene. */
+    void waitForRenderThread();
+
+    /** Get a recorder from the recorder pool, must be invoked from the axmol thread. */
+    RenderCommandRecorder* acquireRecorder();
+
+    /**
+     * Redirect the commands added on the calling thread into the recorder until `endRecording` is invoked.
+     * The recording starts in the render queue which is current on the axmol thread.
+     */
+    void beginRecording(RenderCommandRecorder* recorder);
+    void endRecording();
+
+    /** Add the recorded commands in recording order and put the recorder back to the pool. */
+    void submitRecording(RenderCommandRecorder* recorder);
+
+    /** Whether the calling thread is recording commands for a parallel visit root. */
+    bool isRecording() const;
+
+    /** Put the recorder back to the pool without adding the recorded commands. */
+    void discardRecording(RenderCommandRecorder* recorder);
+
+    /**
+     * Record the commands of a subtree to bake them in a static batch, see `Node::setStaticBatch`.
+     * While capturing, visibility checks pass and sprites aren't instanced, so all triangles are recorded.
+     */
+    void beginStaticCapture(RenderCommandRecorder* recorder);
+    void endStaticCapture();
+    bool isStaticCapturing() const { return _staticCapturing; }
+
 protected:
     friend class Director;
     friend class GroupCommand;
@@ -436,8 +789,15 @@ protected:
         /**
          * Create a new vertex buffer and a index buffer and push it to cache.
          * @note Should invoke firstly.
+         * @param vertexBufferSize The size in bytes of the vertex buffers.
+         * @param indexBufferSize The size in bytes of the index buffers.
          */
-        void init();
+        void init(std::size_t vertexBufferSize, std::size_t indexBufferSize);
+
+        /**
+         * Release all buffers.
+         */
+        void purge();
 
         /**
          * Reset avalable buffer index to zero.
@@ -458,15 +818,36 @@ protected:
     private:
         void createBuffer();
 
-        int _currentBufferIndex = 0;
+        int _currentBufferIndex       = 0;
+        std::size_t _vertexBufferSize = 0;
+        std::size_t _indexBufferSize  = 0;
         std::vector<backend::Buffer*> _vertexBufferPool;
         std::vector<backend::Buffer*> _indexBufferPool;
     };
 
+    // the state the render passes are begun with, the workers encoding in parallel own a copy of it
+    struct EncodeState
+    {
+        backend::DepthStencilDescriptor dsDesc;
+        unsigned int stencilRef = 0;
+        CullMode cullMode       = CullMode::NONE;
+        Winding winding         = Winding::COUNTER_CLOCK_WISE;  // default front face is CCW in GL
+        backend::CommandBuffer* commandBuffer = nullptr;
+        // the draws of a worker, added to the stats when the parallel encoding is done
+        size_t drawnBatches  = 0;
+        size_t drawnVertices = 0;
+        StateChanges stateChanges;
+        // the state of the last draw
+        backend::Program* lastProgram           = nullptr;
+        backend::ProgramState* lastProgramState = nullptr;
+        backend::Buffer* lastVertexBuffer       = nullptr;
+    };
+
     inline GroupCommandManager* getGroupCommandManager() const { return _groupCommandManager; }
     void drawBatchedTriangles();
     void drawCustomCommand(RenderCommand* command);
     void drawMeshCommand(RenderCommand* command);
+    void countStateChanges(backend::ProgramState* programState, backend::Buffer* vertexBuffer);
 
     bool beginFrame();  /// Indicate the begining of a frame
     void endFrame();    /// Finish a frame.
@@ -485,8 +866,31 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
+    /**
+    Adds an instance to the last command of the pool if it can join it, or to a new command inited by init.
+    isCompatible(cmd) and init(cmd) are invoked with a command of the pool.
+    */
+    template <typename _Command, typename _IsCompatible, typename _Init>
+    void addInstance(InstancedCommandPool<_Command>& pool,
+                     const typename _Command::Instance& instance,
+                     _IsCompatible&& isCompatible,
+                     _Init&& init);
+    // the overdraw indicators of the opaque 3D queues, see getOverdrawStats
+    void countOverdraw(const std::vector<RenderCommand*>& prePass, const std::vector<RenderCommand*>& opaque);
+    // encode the 3D queues with parallel command buffers, return false if they must be visited serially
+    bool encode3DQueuesInParallel(const std::vector<RenderCommand*>& opaque,
+                                  const std::vector<RenderCommand*>& transparent);
+    // the state of the calling thread, a copy of it on the workers encoding in parallel
+    EncodeState& encodeState();
+    const EncodeState& encodeState() const;
+    // the state of the worker encoding on the calling thread, nullptr if none
+    static EncodeState*& workerEncodeState();
+
     void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
 
+    // (re)create the buffers batching TrianglesCommands with the current capacity
+    void createBatchBuffers();
+
     void pushStateBlock();
 
     void popStateBlock();
@@ -494,8 +898,6 @@ protected:
     backend::RenderPipeline* _renderPipeline = nullptr;
 
     Viewport _viewport;
-    CullMode _cullMode = CullMode::NONE;
-    Winding _winding   = Winding::COUNTER_CLOCK_WISE;  // default front face is CCW in GL
 
     std::stack<int> _commandGroupStack;
 
@@ -503,23 +905,57 @@ protected:
 
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
 
-    // the pool for callback commands
-    std::vector<CallbackCommand*> _callbackCommandsPool;
+    // the frame arena for callback and group commands, reset by clean()
+    RenderCommandArena _commandArena;
+
+    // the pooled instanced commands
+    InstancedCommandPool<InstancedSpriteCommand> _instancedSprites;
+    InstancedCommandPool<InstancedBillBoardCommand> _instancedBillBoards;
+    InstancedCommandPool<InstancedProgressCommand> _instancedProgresses;
+    bool _spriteInstancingEnabled    = false;
+    bool _billBoardInstancingEnabled = false;
 
-    std::vector<GroupCommand*> _groupCommandPool;
+    // the pool for parallel visit recorders
+    std::vector<RenderCommandRecorder*> _recorderPool;
+    bool _parallelVisitEnabled    = false;
+    bool _staticCapturing         = false;
+    bool _instancingBeforeCapture = false;
 
     // for TrianglesCommand
-    V3F_C4B_T2F _verts[VBO_SIZE];
-    unsigned short _indices[INDEX_VBO_SIZE];
+    std::vector<V3F_C4B_T2F> _verts;
+    std::vector<uint32_t> _indices;  // the storage of 16-bit or 32-bit indices, see _batchIndexFormat
+    unsigned int _vboSize                  = VBO_SIZE;
+    unsigned int _indexVboSize             = INDEX_VBO_SIZE;
+    backend::IndexFormat _batchIndexFormat = backend::IndexFormat::U_SHORT;
+    unsigned int _batchIndexSize           = sizeof(uint16_t);
+    bool _batchBufferAutoGrow              = true;
+    // the vertices the frame would have batched at once if the buffers were big enough
+    unsigned int _batchOverflowDemand = 0;
     backend::Buffer* _vertexBuffer = nullptr;
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
+    // the batches are written straight into them when the driver supports ring buffers
+    backend::Buffer* _ringVertexBuffer = nullptr;
+    backend::Buffer* _ringIndexBuffer  = nullptr;
+    // where fillVerticesAndIndices writes: the CPU arrays above, or the mapped ring buffers
+    V3F_C4B_T2F* _fillVerts = nullptr;
+    void* _fillIndices      = nullptr;
 
     backend::CommandBuffer* _commandBuffer = nullptr;
     backend::RenderPassDescriptor _renderPassDesc;
 
     backend::DepthStencilState* _depthStencilState = nullptr;
-    backend::DepthStencilDescriptor _dsDesc;
+
+    EncodeState _encodeState;
+    std::vector<EncodeState> _parallelEncodeStates;
+    std::vector<backend::CommandBuffer*> _parallelCommandBuffers;
+    tsl::robin_set<backend::ProgramState*> _parallelProgramStates;
+    bool _parallelEncodingEnabled             = false;
+    unsigned int _parallelEncodingMinCommands = 64;
+
+    // the encoding goes to the command buffer of the render thread, _encodeState.commandBuffer, when it runs
+    RenderThread* _renderThread = nullptr;
+    bool _renderThreadEnabled   = false;
 
     // Internal structure that has the information for the batches
     struct TriBatchToDraw
@@ -543,18 +979,38 @@ protected:
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
+    size_t _heapAllocations = 0;  // besides the arenas
+    StateChanges _stateChanges;
+    OverdrawStats _overdrawStats;
+
+    bool _profilingEnabled = false;
+    FrameProfile _frameProfile;
+    double _profileSort   = 0;
+    double _profileEncode = 0;
+    std::chrono::steady_clock::time_point _frameStart;
+    std::chrono::steady_clock::time_point _lastRenderEnd;
+
+    void recordBatchBreak(BatchBreak reason, const RenderCommand* previous, const RenderCommand* command);
+    std::string describeRenderQueues();
+
+    std::function<void(std::string)> _renderQueueCapture;
+
+    bool _batchDiagnosticsEnabled = false;
+    const Node* _diagnosticsNode  = nullptr;
+    tsl::robin_map<const RenderCommand*, const Node*> _commandNodes;
+    std::array<uint32_t, (size_t)BatchBreak::COUNT> _batchBreakCounts{};
+    std::vector<BatchBreakInfo> _batchBreaks;
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
 
     GroupCommandManager* _groupCommandManager = nullptr;
 
-    unsigned int _stencilRef = 0;
-
     backend::RenderTarget* _defaultRT = nullptr;
     backend::RenderTarget* _currentRT = nullptr;  // weak ref
 
     backend::RenderTarget* _offscreenRT = nullptr;
+    RenderTargetPool _renderTargetPool;
 
     Color4F _clearColor = Color4F::BLACK;
     ClearFlag _clearFlag;
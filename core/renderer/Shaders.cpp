@@ -77,11 +77,40 @@ AX_DLL const std::string_view positionNormalTexture_vert           = "positionNo
 AX_DLL const std::string_view skinPositionNormalTexture_vert       = "skinPositionNormalTexture_vs"sv;
 AX_DLL const std::string_view positionTexture3D_vert               = "positionTexture3D_vs"sv;
 AX_DLL const std::string_view positionTextureInstance_vert         = "positionTextureInstance_vs"sv;
+AX_DLL const std::string_view positionTextureColorInstance_vert    = "positionTextureColorInstance_vs"sv;
+AX_DLL const std::string_view billboardInstance_vert               = "billboardInstance_vs"sv;
+AX_DLL const std::string_view positionTextureColorInstance3D_vert  = "positionTextureColorInstance3D_vs"sv;
+AX_DLL const std::string_view positionNormalTextureInstance_vert   = "positionNormalTextureInstance_vs"sv;
+AX_DLL const std::string_view skinPositionTexturePalette_vert      = "skinPositionTexturePalette_vs"sv;
+AX_DLL const std::string_view skinPositionNormalTexturePalette_vert = "skinPositionNormalTexturePalette_vs"sv;
+AX_DLL const std::string_view skinPositionNormalTexturePalette_vert_1 = "skinPositionNormalTexturePalette_vs_1"sv;
 AX_DLL const std::string_view skinPositionTexture_vert             = "skinPositionTexture_vs"sv;
 AX_DLL const std::string_view skybox_frag                          = "skybox_fs"sv;
 AX_DLL const std::string_view skybox_vert                          = "skybox_vs"sv;
 AX_DLL const std::string_view terrain_frag                         = "terrain_fs"sv;
 AX_DLL const std::string_view terrain_vert                         = "terrain_vs"sv;
+AX_DLL const std::string_view terrainPaged_vert                    = "terrainPaged_vs"sv;
+AX_DLL const std::string_view positionNormalTextureClustered_vert  = "positionNormalTextureClustered_vs"sv;
+AX_DLL const std::string_view colorNormalTextureClustered_frag     = "colorNormalTextureClustered_fs"sv;
+AX_DLL const std::string_view shadowDepth_frag                     = "shadowDepth_fs"sv;
+AX_DLL const std::string_view depthPrePass_vert                    = "depthPrePass_vs"sv;
+AX_DLL const std::string_view particleGPU_vert                     = "particleGPU_vs"sv;
+AX_DLL const std::string_view motionStreak_vert                    = "motionStreak_vs"sv;
+AX_DLL const std::string_view gridEffect_vert                      = "gridEffect_vs"sv;
+AX_DLL const std::string_view tiledGridEffect_vert                 = "tiledGridEffect_vs"sv;
+AX_DLL const std::string_view progressInstance_vert                = "progressInstance_vs"sv;
+AX_DLL const std::string_view progressInstance_frag                = "progressInstance_fs"sv;
+AX_DLL const std::string_view drawNodeShape_vert                   = "drawNodeShape_vs"sv;
+AX_DLL const std::string_view drawNodeShape_frag                   = "drawNodeShape_fs"sv;
+AX_DLL const std::string_view label_msdfNormal_frag                = "label_msdfNormal_fs"sv;
+AX_DLL const std::string_view label_msdfOutline_frag               = "label_msdfOutline_fs"sv;
+AX_DLL const std::string_view label_msdfGlow_frag                  = "label_msdfGlow_fs"sv;
+AX_DLL const std::string_view upscaleSharpen_frag                  = "upscaleSharpen_fs"sv;
+AX_DLL const std::string_view positionTextureColorMask_vert        = "positionTextureColorMask_vs"sv;
+AX_DLL const std::string_view positionTextureColorMask_frag        = "positionTextureColorMask_fs"sv;
+AX_DLL const std::string_view postProcessColor_frag                = "postProcessColor_fs"sv;
+AX_DLL const std::string_view postProcessThreshold_frag            = "postProcessThreshold_fs"sv;
+AX_DLL const std::string_view postProcessBlur_frag                 = "postProcessBlur_fs"sv;
 AX_DLL const std::string_view colorNormalTexture_frag_1            = "colorNormalTexture_fs_1"sv;
 AX_DLL const std::string_view positionNormalTexture_vert_1         = "positionNormalTexture_vs_1"sv;
 AX_DLL const std::string_view skinPositionNormalTexture_vert_1     = "skinPositionNormalTexture_vs_1"sv;
@@ -91,11 +91,40 @@ extern AX_DLL const std::string_view positionNormalTexture_vert;
 extern AX_DLL const std::string_view skinPositionNormalTexture_vert;
 extern AX_DLL const std::string_view positionTexture3D_vert;
 extern AX_DLL const std::string_view positionTextureInstance_vert;
+extern AX_DLL const std::string_view positionTextureColorInstance_vert;
+extern AX_DLL const std::string_view billboardInstance_vert;
+extern AX_DLL const std::string_view positionTextureColorInstance3D_vert;
+extern AX_DLL const std::string_view positionNormalTextureInstance_vert;
+extern AX_DLL const std::string_view skinPositionTexturePalette_vert;
+extern AX_DLL const std::string_view skinPositionNormalTexturePalette_vert;
+extern AX_DLL const std::string_view skinPositionNormalTexturePalette_vert_1;
 extern AX_DLL const std::string_view skinPositionTexture_vert;
 extern AX_DLL const std::string_view skybox_frag;
 extern AX_DLL const std::string_view skybox_vert;
 extern AX_DLL const std::string_view terrain_frag;
 extern AX_DLL const std::string_view terrain_vert;
+extern AX_DLL const std::string_view terrainPaged_vert;
+extern AX_DLL const std::string_view positionNormalTextureClustered_vert;
+extern AX_DLL const std::string_view colorNormalTextureClustered_frag;
+extern AX_DLL const std::string_view shadowDepth_frag;
+extern AX_DLL const std::string_view depthPrePass_vert;
+extern AX_DLL const std::string_view particleGPU_vert;
+extern AX_DLL const std::string_view motionStreak_vert;
+extern AX_DLL const std::string_view gridEffect_vert;
+extern AX_DLL const std::string_view tiledGridEffect_vert;
+extern AX_DLL const std::string_view progressInstance_vert;
+extern AX_DLL const std::string_view progressInstance_frag;
+extern AX_DLL const std::string_view drawNodeShape_vert;
+extern AX_DLL const std::string_view drawNodeShape_frag;
+extern AX_DLL const std::string_view label_msdfNormal_frag;
+extern AX_DLL const std::string_view label_msdfOutline_frag;
+extern AX_DLL const std::string_view label_msdfGlow_frag;
+extern AX_DLL const std::string_view upscaleSharpen_frag;
+extern AX_DLL const std::string_view positionTextureColorMask_vert;
+extern AX_DLL const std::string_view positionTextureColorMask_frag;
+extern AX_DLL const std::string_view postProcessColor_frag;
+extern AX_DLL const std::string_view postProcessThreshold_frag;
+extern AX_DLL const std::string_view postProcessBlur_frag;
 
 
 /* blow is with normal map */
@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/StaticBatch.h"
+#include "renderer/Renderer.h"
+#include "renderer/TrianglesCommand.h"
+#include "renderer/backend/ProgramState.h"
+#include "base/Director.h"
+
+#include <limits>
+
+namespace ax
+{
+
+StaticBatch::Draw::~Draw()
+{
+    AX_SAFE_RELEASE(programState);
+}
+
+StaticBatch::~StaticBatch()
+{
+    clear();
+}
+
+bool StaticBatch::build(const std::vector<std::pair<RenderCommand*, int>>& commands, const Mat4& transform)
+{
+    clear();
+    if (commands.empty())
+        return true;
+
+    const int renderQueueID = commands.front().second;
+    _globalZOrder           = commands.front().first->getGlobalOrder();
+    for (auto&& [command, queueID] : commands)
+    {
+        if (command->getType() != RenderCommand::Type::TRIANGLES_COMMAND || command->is3D() ||
+            queueID != renderQueueID || command->getGlobalOrder() != _globalZOrder)
+            return false;
+    }
+
+    // the commands are in the space of the root at the time of the recording
+    Mat4 toRoot = transform.getInversed();
+
+    std::vector<V3F_C4B_T2F> vertices;
+    std::vector<uint16_t> indices;
+    TrianglesCommand* runStart = nullptr;
+    for (auto&& item : commands)
+    {
+        auto cmd = static_cast<TrianglesCommand*>(item.first);
+
+        // same rules as the renderer batching
+        bool sameMaterial = runStart && runStart->getMaterialID() != Renderer::MATERIAL_ID_DO_NOT_BATCH &&
+                            runStart->getMaterialID() == cmd->getMaterialID();
+        if (runStart && (!sameMaterial ||
+                         vertices.size() + cmd->getVertexCount() > std::numeric_limits<uint16_t>::max() + 1))
+        {
+            addDraw(runStart, vertices, indices);
+            vertices.clear();
+            indices.clear();
+        }
+        if (vertices.empty())
+            runStart = cmd;
+
+        auto offset = vertices.size();
+        vertices.resize(offset + cmd->getVertexCount());
+        Mat4 modelView = toRoot * cmd->getModelView();
+        MathUtil::transformVertices(vertices.data() + offset, cmd->getVertices(), cmd->getVertexCount(), modelView);
+
+        auto srcIndices = cmd->getIndices();
+        for (size_t i = 0, count = cmd->getIndexCount(); i < count; ++i)
+            indices.emplace_back(static_cast<uint16_t>(srcIndices[i] + offset));
+    }
+    if (runStart)
+        addDraw(runStart, vertices, indices);
+    return true;
+}
+
+void StaticBatch::addDraw(RenderCommand* source,
+                          const std::vector<V3F_C4B_T2F>& vertices,
+                          const std::vector<uint16_t>& indices)
+{
+    if (indices.empty())
+        return;
+
+    auto draw     = std::make_unique<Draw>();
+    auto& command = draw->command;
+    command.setDrawType(CustomCommand::DrawType::ELEMENT);
+    command.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE);
+    command.createVertexBuffer(sizeof(V3F_C4B_T2F), vertices.size(), CustomCommand::BufferUsage::STATIC);
+    command.updateVertexBuffer(vertices.data(), vertices.size() * sizeof(V3F_C4B_T2F));
+    command.createIndexBuffer(CustomCommand::IndexFormat::U_SHORT, indices.size(), CustomCommand::BufferUsage::STATIC);
+    command.updateIndexBuffer(indices.data(), indices.size() * sizeof(uint16_t));
+
+    // the program state of the source holds the texture it was recorded with, it may change afterwards
+    auto& pipelineDescriptor        = command.getPipelineDescriptor();
+    pipelineDescriptor              = source->getPipelineDescriptor();
+    draw->programState              = pipelineDescriptor.programState->clone();
+    pipelineDescriptor.programState = draw->programState;
+    draw->mvpLocation               = draw->programState->getUniformLocation(backend::Uniform::MVP_MATRIX);
+
+    _draws.emplace_back(std::move(draw));
+}
+
+void StaticBatch::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    const auto& projection = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    Mat4 mvp               = projection * transform;
+    for (auto&& draw : _draws)
+    {
+        draw->command.init(_globalZOrder, transform, flags);
+        if (draw->mvpLocation)
+            draw->programState->setUniform(draw->mvpLocation, mvp.m, sizeof(mvp.m));
+        renderer->addCommand(&draw->command);
+    }
+}
+
+void StaticBatch::clear()
+{
+    _draws.clear();
+}
+
+}  // namespace ax
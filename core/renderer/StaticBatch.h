@@ -0,0 +1,97 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "platform/PlatformMacros.h"
+#include "renderer/CustomCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+class Renderer;
+class RenderCommand;
+
+/**
+ The triangles of a subtree baked into static GPU buffers, see `Node::setStaticBatch`.
+ Consecutive triangles commands with the same material become one draw, the vertices are kept in the
+ space of the subtree root so the root can move without rebuilding the batch.
+*/
+class AX_DLL StaticBatch
+{
+public:
+    StaticBatch() = default;
+    ~StaticBatch();
+
+    StaticBatch(const StaticBatch&)            = delete;
+    StaticBatch& operator=(const StaticBatch&) = delete;
+
+    /**
+     * Bake the recorded commands.
+     * @param commands The recorded commands and their render queue ID.
+     * @param transform The model view transform of the subtree root when the commands were recorded.
+     * @return false if a command isn't a 2D triangles command or the commands don't share a render queue
+     * and global Z order, the batch is empty then.
+     */
+    bool build(const std::vector<std::pair<RenderCommand*, int>>& commands, const Mat4& transform);
+
+    /**Add the draws to the renderer with the current model view transform of the subtree root.*/
+    void draw(Renderer* renderer, const Mat4& transform, uint32_t flags);
+
+    /**Release the draws and their buffers.*/
+    void clear();
+
+    bool empty() const { return _draws.empty(); }
+    /**The number of draws, one per run of commands sharing a material.*/
+    size_t getDrawCount() const { return _draws.size(); }
+
+private:
+    struct Draw
+    {
+        ~Draw();
+
+        CustomCommand command;
+        backend::ProgramState* programState = nullptr;
+        backend::UniformLocation mvpLocation;
+    };
+
+    void addDraw(RenderCommand* source, const std::vector<V3F_C4B_T2F>& vertices, const std::vector<uint16_t>& indices);
+
+    std::vector<std::unique_ptr<Draw>> _draws;
+    float _globalZOrder = 0;
+};
+
+}  // namespace ax
+
+/**
+ end of support group
+ @}
+ */
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "platform/Image.h"
 #include "platform/GL.h"
 #include "base/Utils.h"
+#include "base/Allocator.h"
 #include "platform/Device.h"
 #include "base/Config.h"
 #include "base/Macros.h"
@@ -86,6 +87,8 @@ Texture2D::~Texture2D()
 
     AX_SAFE_DELETE(_ninePatchInfo);
 
+    if (_trackedMemorySize > 0)
+        Memory::trackDeallocation(MemoryTag::TEXTURE, _trackedMemorySize);
     AX_SAFE_RELEASE(_texture);
     AX_SAFE_RELEASE(_programState);
 }
@@ -196,6 +199,12 @@ bool Texture2D::updateWithImage(Image* image, backend::PixelFormat format, int i
         return false;
     }
 
+    if (image->getNumberOfFaces() != 1)
+    {
+        AXLOGW("axmol: Texture2D. Can't create Texture from the cube map: {}", image->getFilePath());
+        return false;
+    }
+
     if (this->_filePath.empty())
         this->_filePath = image->getFilePath();
 
@@ -421,6 +430,7 @@ bool Texture2D::updateWithMipmaps(MipmapInfo* mipmaps,
         _maxT        = 1;
 
         setPremultipliedAlpha(preMultipliedAlpha);
+        trackMemorySize();
     }
 
     // pitfall: we do merge RGB+A at at dual sampler shader, so must mark as _hasPremultipliedAlpha = true to makesure
@@ -445,6 +455,28 @@ bool Texture2D::updateWithSubData(void* data, int offsetX, int offsetY, int widt
     return false;
 }
 
+bool Texture2D::updateWithNativeTexture(uintptr_t handle,
+                                        backend::PixelFormat pixelFormat,
+                                        int pixelsWide,
+                                        int pixelsHigh,
+                                        int index)
+{
+    if (!handle || !_texture->updateNativeTexture(handle, pixelFormat, pixelsWide, pixelsHigh, index))
+        return false;
+
+    if (index == 0)
+    {
+        _contentSize = Vec2((float)pixelsWide, (float)pixelsHigh);
+        _pixelsWide  = pixelsWide;
+        _pixelsHigh  = pixelsHigh;
+        _pixelFormat = pixelFormat;
+        _maxS        = 1;
+        _maxT        = 1;
+        trackMemorySize();
+    }
+    return true;
+}
+
 // implementation Texture2D (Image)
 bool Texture2D::initWithImage(Image* image)
 {
@@ -464,6 +496,180 @@ bool Texture2D::initWithImage(Image* image, backend::PixelFormat format)
     return updateWithImage(image, format);
 }
 
+bool Texture2D::initWithImageStorage(Image* image, backend::PixelFormat format)
+{
+    if (image == nullptr || image->isCompressed() || image->getNumberOfMipmaps() > 1)
+        return false;
+
+    // RGBA8 is a render format on every backend, so the pixels are uploaded as they are
+    auto pixelFormat = image->getPixelFormat();
+    if (pixelFormat != PixelFormat::RGBA8 || (format != PixelFormat::NONE && format != pixelFormat))
+        return false;
+
+    int maxTextureSize = Configuration::getInstance()->getMaxTextureSize();
+    if (image->getWidth() > maxTextureSize || image->getHeight() > maxTextureSize)
+        return false;
+
+    this->_filePath = image->getFilePath();
+
+    return updateWithData(nullptr, image->getDataLen(), pixelFormat, pixelFormat, image->getWidth(),
+                          image->getHeight(), image->hasPremultipliedAlpha());
+}
+
+bool Texture2D::evictStorage()
+{
+    if (_storageEvicted || isRenderTarget() || (_samplerFlags & TextureSamplerFlag::DUAL_SAMPLER) ||
+        _pixelFormat == PixelFormat::NONE)
+        return false;
+
+    _storageMipmaps = hasMipmaps();
+    updatePlaceholderStorage();
+
+    _storageEvicted      = true;
+    _storageEvictedFrame = Director::getInstance()->getTotalFrames();
+    trackMemorySize();
+    return true;
+}
+
+void Texture2D::updatePlaceholderStorage()
+{
+    // the sampler isn't changed by the placeholder
+    backend::TextureDescriptor descriptor;
+    descriptor.width             = 1;
+    descriptor.height            = 1;
+    descriptor.textureFormat     = PixelFormat::RGBA8;
+    descriptor.samplerDescriptor = {backend::SamplerFilter::DONT_CARE, backend::SamplerFilter::DONT_CARE,
+                                    backend::SamplerAddressMode::DONT_CARE, backend::SamplerAddressMode::DONT_CARE};
+    _texture->updateTextureDescriptor(descriptor);
+
+    uint8_t pixel[4] = {0, 0, 0, 0};
+    _texture->updateData(pixel, 1, 1, 0);
+}
+
+bool Texture2D::restoreStorage(Image* image, backend::PixelFormat format)
+{
+    if (!_storageEvicted)
+        return true;
+
+    if (image == nullptr || image->getWidth() != _pixelsWide || image->getHeight() != _pixelsHigh)
+        return false;
+
+    // the placeholder is replaced by the full size storage, before the pixels are uploaded
+    backend::TextureDescriptor descriptor;
+    descriptor.width             = _pixelsWide;
+    descriptor.height            = _pixelsHigh;
+    descriptor.textureFormat     = _pixelFormat;
+    descriptor.samplerDescriptor = {backend::SamplerFilter::DONT_CARE, backend::SamplerFilter::DONT_CARE,
+                                    backend::SamplerAddressMode::DONT_CARE, backend::SamplerAddressMode::DONT_CARE};
+    _texture->updateTextureDescriptor(descriptor);
+
+    _storageEvicted = false;
+    if (_mipStreaming)
+        return updateWithImageMipLevel(image, _residentMipLevel);
+
+    if (!updateWithImage(image, format))
+        return false;
+
+    if (_storageMipmaps && image->getNumberOfMipmaps() <= 1)
+        generateMipmap();
+    return true;
+}
+
+void Texture2D::trackMemorySize()
+{
+    // the storage is reallocated by the backend when its size changes
+    auto size = getMemorySize();
+    if (size == _trackedMemorySize)
+        return;
+    if (_trackedMemorySize > 0)
+        Memory::trackDeallocation(MemoryTag::TEXTURE, _trackedMemorySize);
+    if (size > 0)
+        Memory::trackAllocation(MemoryTag::TEXTURE, size);
+    _trackedMemorySize = size;
+}
+
+size_t Texture2D::getMemorySize() const
+{
+    if (_storageEvicted)
+        return 0;
+
+    // the streamed textures only have the levels from the resident one on
+    size_t width  = std::max(_pixelsWide >> _residentMipLevel, 1);
+    size_t height = std::max(_pixelsHigh >> _residentMipLevel, 1);
+    size_t size   = width * height * getBitsPerPixelForFormat() / 8;
+    return hasMipmaps() ? size * 4 / 3 : size;
+}
+
+bool Texture2D::updateWithImageMipLevel(Image* image, int level)
+{
+    int mipLevelCount = image ? image->getNumberOfMipmaps() : 0;
+    if (mipLevelCount <= 1 || level < 0)
+        return false;
+
+    if (this->_filePath.empty())
+        this->_filePath = image->getFilePath();
+
+    level      = std::min(level, mipLevelCount - 1);
+    int width  = std::max(image->getWidth() >> level, 1);
+    int height = std::max(image->getHeight() >> level, 1);
+
+    // the storage is resized to the first level, the address modes set by the user are kept
+    auto pixelFormat = image->getPixelFormat();
+    bool antialias   = _flags & TextureFlag::ANTIALIAS_ENABLED;
+    backend::TextureDescriptor descriptor;
+    descriptor.width         = width;
+    descriptor.height        = height;
+    descriptor.textureFormat = pixelFormat;
+
+    auto& sampler        = descriptor.samplerDescriptor;
+    sampler.magFilter    = antialias ? backend::SamplerFilter::LINEAR : backend::SamplerFilter::NEAREST;
+    sampler.minFilter    = antialias ? backend::SamplerFilter::LINEAR_MIPMAP_NEAREST
+                                     : backend::SamplerFilter::NEAREST_MIPMAP_NEAREST;
+    sampler.sAddressMode = backend::SamplerAddressMode::DONT_CARE;
+    sampler.tAddressMode = backend::SamplerAddressMode::DONT_CARE;
+    if (level + 1 == mipLevelCount)
+        sampler.minFilter = sampler.magFilter;
+    _texture->updateTextureDescriptor(descriptor);
+
+    if (!updateWithMipmaps(image->getMipmaps() + level, mipLevelCount - level, pixelFormat, pixelFormat, width, height,
+                           image->hasPremultipliedAlpha()))
+        return false;
+
+    // the texture coordinates of the nodes are computed with the size of the image
+    _pixelsWide       = image->getWidth();
+    _pixelsHigh       = image->getHeight();
+    _contentSize      = Vec2((float)_pixelsWide, (float)_pixelsHigh);
+    _mipStreaming     = true;
+    _residentMipLevel = level;
+    _mipLevelCount    = mipLevelCount;
+    trackMemorySize();
+    return true;
+}
+
+void Texture2D::requestMipLevel(int level)
+{
+    uint64_t frame   = Director::getInstance()->getTotalFrames();
+    uint64_t request = (frame << 8) | static_cast<uint64_t>(std::clamp(level, 0, 254) + 1);
+    auto current     = _mipLevelRequest.load(std::memory_order_relaxed);
+    while ((current >> 8) != frame || (current & 0xff) > (request & 0xff))
+    {
+        if (_mipLevelRequest.compare_exchange_weak(current, request, std::memory_order_relaxed))
+            break;
+    }
+}
+
+int Texture2D::getRequestedMipLevel(unsigned int& frame) const
+{
+    auto request = _mipLevelRequest.load(std::memory_order_relaxed);
+    frame        = static_cast<unsigned int>(request >> 8);
+    return static_cast<int>(request & 0xff) - 1;
+}
+
+unsigned int Texture2D::getLastUsedFrame() const
+{
+    return _texture->getLastUsedFrame();
+}
+
 // implementation Texture2D (Text)
 bool Texture2D::initWithString(std::string_view text,
                                std::string_view fontName,
@@ -589,6 +795,7 @@ bool Texture2D::updateTextureDescriptor(const backend::TextureDescriptor& descri
     if (_pixelFormat == PixelFormat::NONE)
         _pixelFormat = descriptor.textureFormat;
 
+    trackMemorySize();
     return true;
 }
 
@@ -738,6 +945,7 @@ void Texture2D::generateMipmap()
              "Mipmap texture only works in POT textures");
 
     _texture->generateMipmaps();
+    trackMemorySize();
 }
 
 void Texture2D::initProgram()
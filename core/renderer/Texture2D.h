@@ -28,6 +28,7 @@ THE SOFTWARE.
 #pragma once
 
 #include <string>
+#include <atomic>
 #include <map>
 #include <unordered_map>
 
@@ -228,6 +229,20 @@ public:
      @param height Specifies the height of the texture subimage.
      */
     bool updateWithSubData(void* data, int offsetX, int offsetY, int width, int height, int index = 0);
+
+    /** Samples an image the platform owns, e.g. a video frame decoded on the GPU, instead of uploading its pixels.
+
+     @param handle The native image, see backend::Texture2DBackend::updateNativeTexture.
+     @param pixelFormat The pixel format of the image.
+     @param pixelsWide The width of the image.
+     @param pixelsHigh The height of the image.
+     @return false if the renderer backend can't sample the images of the platform.
+     */
+    bool updateWithNativeTexture(uintptr_t handle,
+                                 backend::PixelFormat pixelFormat,
+                                 int pixelsWide,
+                                 int pixelsHigh,
+                                 int index = 0);
     /**
     Drawing extensions to make it easy to draw basic quads using a Texture2D object.
     These functions require GL_TEXTURE_2D and both GL_VERTEX_ARRAY and GL_TEXTURE_COORD_ARRAY client states to be
@@ -260,6 +275,17 @@ public:
     **/
     bool initWithImage(Image* image, backend::PixelFormat format);
 
+    /**
+    Allocates the texture for an image without uploading its pixels.
+
+    The pixels are uploaded later with updateWithSubData, e.g. in row slices over several frames. Only the images
+    without mipmaps whose pixels don't need a conversion can be uploaded this way.
+    @param image An UIImage object.
+    @param format Texture pixel formats, see initWithImage.
+    @return false if the image can't be uploaded in parts, nothing is allocated then.
+    **/
+    bool initWithImageStorage(Image* image, backend::PixelFormat format);
+
     /** Initializes a texture from a string with dimensions, alignment, font name and font size.
 
      @param text A null terminated string.
@@ -346,6 +372,57 @@ public:
     /** Whether or not the texture has mip maps.*/
     bool hasMipmaps() const;
 
+    /** Frees the memory of the pixels by replacing them with a transparent 1x1 placeholder.
+     The size, the format and the texture parameters are kept, so the nodes using the texture keep their layout, the
+     pixels are restored with restoreStorage. See TextureCache::setMemoryBudget.
+     @return false if the texture can't be evicted, i.e. a render target or an ETC1 texture with a separate alpha.
+     */
+    bool evictStorage();
+
+    /** Restores the pixels of an evicted texture from its image, see initWithImage. */
+    bool restoreStorage(Image* image, backend::PixelFormat format);
+
+    /** Whether the pixels are replaced with a placeholder by evictStorage. */
+    bool isStorageEvicted() const { return _storageEvicted; }
+
+    /** The GPU memory of the pixels and the mipmaps in bytes, 0 when the texture is evicted. */
+    size_t getMemorySize() const;
+
+    /** The frame the texture was last drawn in, see Director::getTotalFrames. */
+    unsigned int getLastUsedFrame() const;
+
+    /** Uploads the mipmaps of an image from a level on, the smaller levels only.
+     The texture keeps the size of the image, so it's drawn with the lower resolution until a lower level is
+     uploaded, see TextureCache::setMipStreaming. The image must have mipmaps, e.g. a PVR, KTX or ASTC file.
+     @param level The first level to upload, 0 uploads all the levels.
+     */
+    bool updateWithImageMipLevel(Image* image, int level);
+
+    /** Whether the mipmaps are streamed, see updateWithImageMipLevel. */
+    bool isMipStreaming() const { return _mipStreaming; }
+
+    /** The first mipmap level uploaded by updateWithImageMipLevel. */
+    int getResidentMipLevel() const { return _residentMipLevel; }
+
+    /** The mipmap levels of the image of a streamed texture. */
+    int getMipLevelCount() const { return _mipLevelCount; }
+
+    /** Requests the mipmap level the texture is drawn with in this frame, the lowest level of a frame is kept.
+     Sprites request the level matching their texel density, other nodes drawing a streamed texture may call it.
+     */
+    void requestMipLevel(int level);
+
+    /** Gets the level requested in the latest frame it was requested in.
+     @param frame The frame of the request, see Director::getTotalFrames.
+     @return -1 if no level was requested yet.
+     */
+    int getRequestedMipLevel(unsigned int& frame) const;
+
+    /** Sets the residency priority, the textures of lower priority are evicted first when the TextureCache is over
+     its memory budget, 0 by default. */
+    void setResidencyPriority(int priority) { _residencyPriority = priority; }
+    int getResidencyPriority() const { return _residencyPriority; }
+
     /** Gets the pixel format of the texture. */
     backend::PixelFormat getPixelFormat() const;
 
@@ -420,6 +497,12 @@ private:
 
     void initProgram();
 
+    /** Replaces the storage with the transparent 1x1 placeholder of evictStorage. */
+    void updatePlaceholderStorage();
+
+    /** Accounts the change of getMemorySize to MemoryTag::TEXTURE, see Memory. */
+    void trackMemorySize();
+
 protected:
     /** pixel format of the texture */
     backend::PixelFormat _pixelFormat;
@@ -448,11 +531,25 @@ protected:
     NinePatchInfo* _ninePatchInfo;
     friend class SpriteFrameCache;
     friend class TextureCache;
+    friend class VolatileTextureMgr;
     friend class ui::Scale9Sprite;
 
     bool _valid;
     std::string _filePath;
 
+    bool _storageEvicted   = false;
+    bool _storageMipmaps   = false;  // whether the mipmaps are generated again when the storage is restored
+    bool _storageReloading = false;  // reloaded by the TextureCache or the VolatileTextureMgr
+    unsigned int _storageEvictedFrame = 0;
+    int _residencyPriority            = 0;
+    size_t _trackedMemorySize         = 0;
+
+    bool _mipStreaming        = false;
+    bool _mipStreamingLoading = false;  // loaded by the TextureCache
+    int _residentMipLevel     = 0;
+    int _mipLevelCount        = 0;
+    std::atomic<uint64_t> _mipLevelRequest{0};  // the frame << 8 | the level + 1, sprites are drawn by workers too
+
     backend::ProgramState* _programState = nullptr;
     backend::UniformLocation _mvpMatrixLocation;
     backend::UniformLocation _textureLocation;
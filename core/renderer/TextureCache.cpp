@@ -33,6 +33,9 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
@@ -42,6 +45,7 @@ THE SOFTWARE.
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
+#include "base/Profiling.h"
 #include "renderer/backend/DriverBase.h"
 
 using namespace std;
@@ -63,48 +67,77 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
-
-TextureCache::~TextureCache()
-{
-    AXLOGD("deallocing TextureCache: {}", fmt::ptr(this));
-
-    for (auto&& texture : _textures)
-        texture.second->release();
-
-    AX_SAFE_DELETE(_loadingThread);
-}
-
-std::string TextureCache::getDescription() const
-{
-    return fmt::format("<TextureCache | Number of textures = {}>", static_cast<int>(_textures.size()));
-}
-
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key)
+    AsyncStruct(std::string_view fn,
+                const std::function<void(Texture2D*)>& f,
+                std::string_view key,
+                int prio,
+                std::shared_ptr<AsyncLoadToken> tok)
         : filename(fn)
         , callback(f)
         , callbackKey(key)
+        , priority(prio)
+        , token(std::move(tok))
         , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
         , loadSuccess(false)
+        , texture(nullptr)
+        , uploadedRows(0)
     {}
 
     std::string filename;
     std::function<void(Texture2D*)> callback;
     std::string callbackKey;
+    int priority;
+    std::shared_ptr<AsyncLoadToken> token;
     Image image;
     Image imageAlpha;
     backend::PixelFormat pixelFormat;
     bool loadSuccess;
+    Texture2D* texture;  // the texture being uploaded in row slices
+    int uploadedRows;
 };
 
+TextureCache::TextureCache()
+    : _needQuit(false)
+    , _asyncLoaders(0)
+    , _asyncLoadingConcurrency(0)
+    , _asyncRefCount(0)
+    , _asyncUploadBudget(0)
+    , _asyncUploadTimeBudget(0)
+    , _uploadingStruct(nullptr)
+    , _memoryBudget(0)
+    , _minUnusedFrames(0)
+    , _mipStreamingMinSize(0)
+    , _mipStreamingInitialSize(0)
+    , _mipStreamingHoldFrames(0)
+{}
+
+TextureCache::~TextureCache()
+{
+    AXLOGD("deallocing TextureCache: {}", fmt::ptr(this));
+
+    for (auto&& texture : _textures)
+        texture.second->release();
+
+    if (_uploadingStruct)
+    {
+        AX_SAFE_RELEASE(_uploadingStruct->texture);
+        delete _uploadingStruct;
+    }
+}
+
+std::string TextureCache::getDescription() const
+{
+    return fmt::format("<TextureCache | Number of textures = {}>", static_cast<int>(_textures.size()));
+}
+
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
  - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
+ _responseQueue (JobSystem workers)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
  thread)
 
@@ -114,10 +147,13 @@ public:
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in JobSystem workers, delete in GL thread(by Image instance)
 
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - _requestQueue is sorted by priority, the loader jobs always pop the front, so at most
+ _asyncLoadingConcurrency requests are decoded at the same time, highest priority first.
+ - the responses arrive in the order the decoding finishes, not the order of the requests.
 
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
@@ -141,7 +177,7 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
  - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
+ _responseQueue (JobSystem workers)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
  thread)
 
@@ -151,10 +187,13 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in JobSystem workers, delete in GL thread(by Image instance)
 
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - _requestQueue is sorted by priority, the loader jobs always pop the front, so at most
+ _asyncLoadingConcurrency requests are decoded at the same time, highest priority first.
+ - the responses arrive in the order the decoding finishes, not the order of the requests.
 
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
@@ -174,6 +213,58 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, 0, callbackKey);
+}
+
+std::shared_ptr<TextureCache::AsyncLoadToken> TextureCache::addImageAsync(
+    std::string_view path,
+    const std::function<void(Texture2D*)>& callback,
+    int priority,
+    std::string_view callbackKey)
+{
+    auto token = std::make_shared<AsyncLoadToken>();
+    requestImageAsync(path, callback, priority, callbackKey, token);
+    return token;
+}
+
+Task<Texture2D*> TextureCache::loadTextureAsync(std::string path, int priority)
+{
+    struct TextureAwaiter
+    {
+        TextureCache* cache;
+        std::string_view path;
+        int priority;
+        Texture2D* texture = nullptr;
+
+        bool await_ready()
+        {
+            texture = cache->getTextureForKey(path);
+            return texture != nullptr;
+        }
+
+        void await_suspend(axstd::coroutine_handle<> handle)
+        {
+            cache->addImageAsync(
+                path,
+                [this, handle](Texture2D* loaded) {
+                    texture = loaded;
+                    handle.resume();
+                },
+                priority);
+        }
+
+        Texture2D* await_resume() const { return texture; }
+    };
+
+    co_return co_await TextureAwaiter{this, path, priority};
+}
+
+void TextureCache::requestImageAsync(std::string_view path,
+                                     const std::function<void(Texture2D*)>& callback,
+                                     int priority,
+                                     std::string_view callbackKey,
+                                     const std::shared_ptr<AsyncLoadToken>& token)
 {
     Texture2D* texture = nullptr;
 
@@ -198,14 +289,6 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _needQuit      = false;
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
@@ -215,13 +298,92 @@ void TextureCache::addImageAsync(std::string_view path,
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey);
+    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey, priority, token);
 
-    // add async struct into queue
+    // add async struct into queue, after the pending requests of the same or higher priority
     _asyncStructQueue.emplace_back(data);
     std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.emplace_back(data);
-    _sleepCondition.notify_one();
+    auto pos = std::find_if(_requestQueue.rbegin(), _requestQueue.rend(),
+                            [priority](AsyncStruct* request) { return request->priority >= priority; });
+    _requestQueue.insert(pos.base(), data);
+    ul.unlock();
+
+    dispatchAsyncLoaders();
+}
+
+std::shared_ptr<TextureCache::AsyncLoadToken> TextureCache::addImagesAsync(
+    std::span<const std::string> paths,
+    std::function<void(const std::vector<Texture2D*>&)> onAllLoaded,
+    int priority)
+{
+    // the loaded textures are retained until all the requests are done, they may be removed from the cache
+    // meanwhile, the state is freed with the callbacks of the requests, also if the batch is cancelled
+    struct BatchState
+    {
+        ~BatchState()
+        {
+            for (auto&& texture : textures)
+                AX_SAFE_RELEASE(texture);
+        }
+
+        std::vector<Texture2D*> textures;
+        size_t remaining;
+        std::function<void(const std::vector<Texture2D*>&)> onAllLoaded;
+    };
+
+    auto token = std::make_shared<AsyncLoadToken>();
+    if (paths.empty())
+    {
+        if (onAllLoaded)
+            onAllLoaded({});
+        return token;
+    }
+
+    auto state         = std::make_shared<BatchState>();
+    state->textures.resize(paths.size(), nullptr);
+    state->remaining   = paths.size();
+    state->onAllLoaded = std::move(onAllLoaded);
+
+    // the requests share the token of the batch, so the whole batch is cancelled with it
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        requestImageAsync(
+            paths[i],
+            [state, i](Texture2D* texture) {
+            AX_SAFE_RETAIN(texture);
+            state->textures[i] = texture;
+            if (--state->remaining == 0 && state->onAllLoaded)
+                state->onAllLoaded(state->textures);
+        },
+            priority, ""sv, token);
+    }
+    return token;
+}
+
+void TextureCache::setAsyncLoadingConcurrency(int concurrency)
+{
+    std::unique_lock<std::mutex> ul(_requestMutex);
+    _asyncLoadingConcurrency = std::max(concurrency, 0);
+    ul.unlock();
+
+    dispatchAsyncLoaders();
+}
+
+void TextureCache::dispatchAsyncLoaders()
+{
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    while (true)
+    {
+        std::unique_lock<std::mutex> ul(_requestMutex);
+        // no more loaders than pending requests, a loader keeps decoding until the request queue is empty
+        if (_needQuit || _asyncLoaders >= static_cast<int>(_requestQueue.size()) ||
+            (_asyncLoadingConcurrency > 0 && _asyncLoaders >= _asyncLoadingConcurrency))
+            break;
+        ++_asyncLoaders;
+        ul.unlock();
+
+        jobSystem->enqueue([this] { loadImages(); });
+    }
 }
 
 void TextureCache::unbindImageAsync(std::string_view callbackKey)
@@ -252,33 +414,32 @@ void TextureCache::unbindAllImageAsync()
     }
 }
 
-void TextureCache::loadImage()
+void TextureCache::loadImages()
 {
     AsyncStruct* asyncStruct = nullptr;
-    while (!_needQuit)
+    while (true)
     {
         std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        // pop the AsyncStruct of the highest priority from request queue
+        if (_needQuit || _requestQueue.empty())
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            --_asyncLoaders;
+            _loadersCondition.notify_all();
+            break;
         }
+        asyncStruct = _requestQueue.front();
+        _requestQueue.pop_front();
+        ul.unlock();
 
-        if (nullptr == asyncStruct)
+        // the cancelled requests go to the response queue undecoded, to be released in GL thread
+        if (asyncStruct->token->isCancelled())
         {
-            if (_needQuit)
-            {
-                break;
-            }
-            _sleepCondition.wait(ul);
+            std::lock_guard<std::mutex> lg(_responseMutex);
+            _responseQueue.emplace_back(asyncStruct);
             continue;
         }
-        ul.unlock();
+
+        AX_TRACE_SCOPE("TextureCache::loadImages");
 
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
@@ -298,34 +459,102 @@ void TextureCache::loadImage()
     }
 }
 
+void TextureCache::setAsyncUploadBudget(size_t bytesPerFrame, float maxMilliseconds)
+{
+    _asyncUploadBudget     = bytesPerFrame;
+    _asyncUploadTimeBudget = std::max(maxMilliseconds, 0.0f);
+}
+
+bool TextureCache::uploadAsyncImage(AsyncStruct* asyncStruct, size_t& budget, bool& uploaded)
+{
+    Image* image   = &asyncStruct->image;
+    size_t dataLen = image->getDataLen();
+
+    if (!asyncStruct->texture)
+    {
+        // the images over the budget are uploaded in row slices when possible, otherwise at the start of a frame
+        auto texture = new Texture2D();
+        if (dataLen <= budget || !texture->initWithImageStorage(image, asyncStruct->pixelFormat))
+        {
+            if (dataLen > budget && uploaded)
+            {
+                texture->release();
+                return false;
+            }
+
+            initTextureWithImage(texture, image, asyncStruct->pixelFormat);
+            asyncStruct->texture = texture;
+            budget -= std::min(budget, dataLen);
+            uploaded = true;
+            return true;
+        }
+        asyncStruct->texture = texture;
+    }
+
+    int height      = image->getHeight();
+    size_t rowPitch = dataLen / height;
+    int rows = static_cast<int>(std::min(budget / rowPitch, static_cast<size_t>(height - asyncStruct->uploadedRows)));
+    if (rows == 0)
+    {
+        if (uploaded)
+            return false;
+        rows = 1;
+    }
+
+    asyncStruct->texture->updateWithSubData(image->getData() + asyncStruct->uploadedRows * rowPitch, 0,
+                                            asyncStruct->uploadedRows, image->getWidth(), rows);
+    asyncStruct->uploadedRows += rows;
+    budget -= std::min(budget, rows * rowPitch);
+    uploaded = true;
+    return asyncStruct->uploadedRows == height;
+}
+
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    AX_TRACE_SCOPE("TextureCache::addImageAsyncCallBack");
+
+    size_t budget = _asyncUploadBudget > 0 ? _asyncUploadBudget : std::numeric_limits<size_t>::max();
+    bool uploaded = false;
+    auto start    = std::chrono::steady_clock::now();
+
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
     while (true)
     {
-        // pop an AsyncStruct from response queue
-        _responseMutex.lock();
-        if (_responseQueue.empty())
+        // stop once a budget is used up, the remaining responses are uploaded in the next frames
+        if (uploaded &&
+            (budget == 0 || (_asyncUploadTimeBudget > 0 &&
+                             std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+                                     .count() >= _asyncUploadTimeBudget)))
         {
-            asyncStruct = nullptr;
+            break;
         }
-        else
-        {
-            asyncStruct = _responseQueue.front();
-            _responseQueue.pop_front();
 
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            AX_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
+        // continue the texture uploaded in slices, or pop an AsyncStruct from response queue
+        asyncStruct      = _uploadingStruct;
+        _uploadingStruct = nullptr;
+        if (!asyncStruct)
+        {
+            _responseMutex.lock();
+            if (!_responseQueue.empty())
+            {
+                asyncStruct = _responseQueue.front();
+                _responseQueue.pop_front();
+            }
+            _responseMutex.unlock();
         }
-        _responseMutex.unlock();
 
         if (nullptr == asyncStruct)
         {
             break;
         }
 
+        if (asyncStruct->token->isCancelled())
+        {
+            finishAsyncStruct(asyncStruct);
+            continue;
+        }
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -337,11 +566,17 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             // convert image to texture
             if (asyncStruct->loadSuccess)
             {
-                Image* image = &(asyncStruct->image);
                 // generate texture in render thread
-                texture = new Texture2D();
+                if (!uploadAsyncImage(asyncStruct, budget, uploaded))
+                {
+                    _uploadingStruct = asyncStruct;
+                    break;
+                }
+
+                Image* image         = &(asyncStruct->image);
+                texture              = asyncStruct->texture;
+                asyncStruct->texture = nullptr;
 
-                texture->initWithImage(image, asyncStruct->pixelFormat);
                 // parse 9-patch info
                 this->parseNinePatchImage(image, texture, asyncStruct->filename);
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -372,9 +607,7 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             (asyncStruct->callback)(texture);
         }
 
-        // release the asyncStruct
-        delete asyncStruct;
-        --_asyncRefCount;
+        finishAsyncStruct(asyncStruct);
     }
 
     if (0 == _asyncRefCount)
@@ -384,6 +617,19 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
     }
 }
 
+void TextureCache::finishAsyncStruct(AsyncStruct* asyncStruct)
+{
+    // the requests are decoded in parallel, so the responses arrive out of order
+    auto queued = std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct);
+    AX_ASSERT(queued != _asyncStructQueue.end());
+    _asyncStructQueue.erase(queued);
+
+    // release the asyncStruct, with the texture of a cancelled sliced upload
+    AX_SAFE_RELEASE(asyncStruct->texture);
+    delete asyncStruct;
+    --_asyncRefCount;
+}
+
 Texture2D* TextureCache::getWhiteTexture()
 {
     constexpr std::string_view key = "/white-texture"sv;
@@ -465,7 +711,7 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 
             texture = new Texture2D();
 
-            if (texture->initWithImage(image, format))
+            if (initTextureWithImage(texture, image, format))
             {
 #if AX_ENABLE_CACHE_TEXTURE_DATA
                 // cache the texture file name
@@ -676,6 +922,205 @@ void TextureCache::removeUnusedTextures()
     }
 }
 
+void TextureCache::setMemoryBudget(size_t bytes, unsigned int minUnusedFrames)
+{
+    _memoryBudget    = bytes;
+    _minUnusedFrames = minUnusedFrames;
+    scheduleResidencyUpdate(_memoryBudget > 0 || _mipStreamingMinSize > 0);
+}
+
+void TextureCache::setMipStreaming(int minSize, int initialSize, unsigned int holdFrames)
+{
+    _mipStreamingMinSize     = std::max(minSize, 0);
+    _mipStreamingInitialSize = std::max(initialSize, 1);
+    _mipStreamingHoldFrames  = holdFrames;
+    scheduleResidencyUpdate(_memoryBudget > 0 || _mipStreamingMinSize > 0);
+}
+
+void TextureCache::scheduleResidencyUpdate(bool schedule)
+{
+    auto scheduler = Director::getInstance()->getScheduler();
+    bool scheduled = scheduler->isScheduled(AX_SCHEDULE_SELECTOR(TextureCache::updateResidency), this);
+    if (schedule && !scheduled)
+        scheduler->schedule(AX_SCHEDULE_SELECTOR(TextureCache::updateResidency), this, 0, false);
+    else if (!schedule && scheduled)
+        scheduler->unschedule(AX_SCHEDULE_SELECTOR(TextureCache::updateResidency), this);
+}
+
+size_t TextureCache::getMemoryUsage() const
+{
+    size_t usage = 0;
+    for (auto&& texture : _textures)
+        usage += texture.second->getMemorySize();
+    return usage;
+}
+
+void TextureCache::updateResidency(float /*dt*/)
+{
+    // the evicted textures drawn again since they were evicted are reloaded
+    auto frame   = Director::getInstance()->getTotalFrames();
+    size_t usage = 0;
+    for (auto&& texture : _textures)
+    {
+        auto tex = texture.second;
+        if (!tex->isStorageEvicted())
+        {
+            if (tex->isMipStreaming() && _mipStreamingMinSize > 0 && tex->getPath() == texture.first)
+                updateMipStreaming(tex, frame);
+            usage += tex->getMemorySize();
+        }
+        else if (!tex->_storageReloading && tex->getLastUsedFrame() >= tex->_storageEvictedFrame)
+        {
+            reloadEvictedTexture(tex);
+        }
+    }
+
+    if (_memoryBudget > 0 && usage > _memoryBudget)
+        trimToMemoryBudget(usage);
+}
+
+bool TextureCache::initTextureWithImage(Texture2D* texture, Image* image, PixelFormat format)
+{
+    // the large textures with mipmaps start with the small levels
+    if (_mipStreamingMinSize > 0 && image->getNumberOfMipmaps() > 1 &&
+        std::max(image->getWidth(), image->getHeight()) >= _mipStreamingMinSize)
+    {
+        int level = 0;
+        while (level + 1 < image->getNumberOfMipmaps() &&
+               (std::max(image->getWidth(), image->getHeight()) >> level) > _mipStreamingInitialSize)
+            ++level;
+        if (texture->updateWithImageMipLevel(image, level))
+            return true;
+    }
+    return texture->initWithImage(image, format);
+}
+
+int TextureCache::getInitialMipLevel(Texture2D* texture) const
+{
+    int level = 0;
+    int size  = std::max(texture->getPixelsWide(), texture->getPixelsHigh());
+    while (level + 1 < texture->getMipLevelCount() && (size >> level) > _mipStreamingInitialSize)
+        ++level;
+    return level;
+}
+
+void TextureCache::updateMipStreaming(Texture2D* texture, unsigned int frame)
+{
+    if (texture->_mipStreamingLoading)
+        return;
+
+    // the levels requested by the sprites are streamed in at once, the texture drops back to the initial levels
+    // only when it isn't drawn any more, so zooming doesn't reload it again and again
+    unsigned int requestFrame = 0;
+    int requested             = texture->getRequestedMipLevel(requestFrame);
+    int resident              = texture->getResidentMipLevel();
+    int level                 = resident;
+    if (requested >= 0 && frame - requestFrame <= _mipStreamingHoldFrames)
+        level = std::min(requested, resident);
+    else
+        level = std::max(getInitialMipLevel(texture), resident);
+    level = std::min(level, texture->getMipLevelCount() - 1);
+    if (level == resident)
+        return;
+
+    texture->_mipStreamingLoading = true;
+    texture->retain();
+
+    auto image = new Image();
+    Director::getInstance()->getJobSystem()->enqueue(
+        [image, path = texture->getPath()] { image->initWithImageFileThreadSafe(path); },
+        [texture, image, level] {
+        // a texture failing to load stays marked as loading, so it isn't retried every frame
+        if (texture->isStorageEvicted() || texture->updateWithImageMipLevel(image, level))
+            texture->_mipStreamingLoading = false;
+        else
+            AXLOGW("TextureCache: failed to stream the mip level {} of: {}", level, texture->getPath());
+        image->release();
+        texture->release();
+    });
+}
+
+void TextureCache::trimToMemoryBudget(size_t usage)
+{
+    struct Candidate
+    {
+        std::string_view key;
+        Texture2D* texture;
+        bool unreferenced;
+    };
+
+    // only the textures loaded from their file can be reloaded once evicted
+    auto frame = Director::getInstance()->getTotalFrames();
+    std::vector<Candidate> candidates;
+    for (auto&& texture : _textures)
+    {
+        auto tex = texture.second;
+        if (tex->isStorageEvicted() || tex->getMemorySize() == 0)
+            continue;
+
+        if (tex->getReferenceCount() == 1)
+            candidates.push_back({texture.first, tex, true});
+        else if (!tex->isRenderTarget() && tex->getPath() == texture.first &&
+                 frame - tex->getLastUsedFrame() >= _minUnusedFrames)
+            candidates.push_back({texture.first, tex, false});
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.texture->getResidencyPriority() != rhs.texture->getResidencyPriority())
+            return lhs.texture->getResidencyPriority() < rhs.texture->getResidencyPriority();
+        if (lhs.unreferenced != rhs.unreferenced)
+            return lhs.unreferenced;
+        return lhs.texture->getLastUsedFrame() < rhs.texture->getLastUsedFrame();
+    });
+
+    std::vector<std::string> removedKeys;
+    for (auto&& candidate : candidates)
+    {
+        if (usage <= _memoryBudget)
+            break;
+
+        auto size = candidate.texture->getMemorySize();
+        if (candidate.unreferenced)
+        {
+            AXLOGD("TextureCache: removing unused texture over the memory budget: {}", candidate.key);
+            removedKeys.emplace_back(candidate.key);
+        }
+        else if (!candidate.texture->evictStorage())
+        {
+            continue;
+        }
+        usage -= std::min(usage, size);
+    }
+
+    for (auto&& key : removedKeys)
+    {
+        auto it = _textures.find(key);
+        it->second->release();
+        _textures.erase(it);
+    }
+}
+
+void TextureCache::reloadEvictedTexture(Texture2D* texture)
+{
+    texture->_storageReloading = true;
+    texture->retain();
+
+    // the texture is restored even if it's removed from the cache meanwhile, it may still be drawn
+    auto image  = new Image();
+    auto format = texture->getPixelFormat();
+    Director::getInstance()->getJobSystem()->enqueue(
+        [image, path = texture->getPath()] { image->initWithImageFileThreadSafe(path); },
+        [texture, image, format] {
+        // a texture failing to reload stays marked as reloading, so it isn't retried every frame
+        if (texture->restoreStorage(image, format))
+            texture->_storageReloading = false;
+        else
+            AXLOGW("TextureCache: failed to reload the evicted texture: {}", texture->getPath());
+        image->release();
+        texture->release();
+    });
+}
+
 void TextureCache::removeTexture(Texture2D* texture)
 {
     if (!texture)
@@ -743,13 +1188,13 @@ std::string TextureCache::getTextureFilePath(ax::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // the loader jobs stop popping requests, wait for the images being decoded
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
+    _loadersCondition.wait(ul, [this] { return _asyncLoaders == 0; });
     ul.unlock();
-    if (_loadingThread)
-        _loadingThread->join();
+
+    setMemoryBudget(0);
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -815,6 +1260,12 @@ void TextureCache::renameTextureWithKey(std::string_view srcName, std::string_vi
 
 std::list<VolatileTexture*> VolatileTextureMgr::_textures;
 bool VolatileTextureMgr::_isReloading = false;
+std::vector<Texture2D*> VolatileTextureMgr::_pendingReloads;
+std::deque<std::pair<VolatileTexture*, Image*>> VolatileTextureMgr::_decodedReloads;
+std::deque<VolatileTexture*> VolatileTextureMgr::_memoryReloads;
+unsigned int VolatileTextureMgr::_reloadGeneration = 0;
+float VolatileTextureMgr::_reloadBudget           = VolatileTextureMgr::DEFAULT_RELOAD_BUDGET;
+bool VolatileTextureMgr::_keepFileData            = false;
 
 VolatileTexture::VolatileTexture(Texture2D* t)
     : _texture(t)
@@ -843,6 +1294,10 @@ void VolatileTextureMgr::addImageTexture(Texture2D* tt, std::string_view imageFi
     vt->_cashedImageType = VolatileTexture::kImageFile;
     vt->_fileName        = imageFileName;
     vt->_pixelFormat     = tt->getPixelFormat();
+    if (_keepFileData)
+        vt->_fileData = FileUtils::getInstance()->getDataFromFile(imageFileName);
+    else
+        vt->_fileData.clear();
 }
 
 void VolatileTextureMgr::addImage(Texture2D* tt, Image* image)
@@ -933,48 +1388,207 @@ void VolatileTextureMgr::removeTexture(Texture2D* t)
 
 void VolatileTextureMgr::reloadAllTextures()
 {
-    _isReloading = true;
     AXLOGD("reload all texture");
 
-    for (auto&& texture : _textures)
+    // the pixels of a reload in progress are lost too, its textures are reloaded again
+    ++_reloadGeneration;
+    for (auto&& decoded : _decodedReloads)
+        decoded.second->release();
+    _decodedReloads.clear();
+    _memoryReloads.clear();
+    for (auto&& texture : _pendingReloads)
+    {
+        texture->_storageEvicted   = false;
+        texture->_storageReloading = false;
+        texture->release();
+    }
+    _pendingReloads.clear();
+
+    // the textures drawn last are reloaded first
+    std::vector<VolatileTexture*> textures(_textures.begin(), _textures.end());
+    std::stable_sort(textures.begin(), textures.end(), [](VolatileTexture* lhs, VolatileTexture* rhs) {
+        return lhs->_texture->getLastUsedFrame() > rhs->_texture->getLastUsedFrame();
+    });
+
+    auto director        = Director::getInstance();
+    auto jobSystem       = director->getJobSystem();
+    const auto lastFrame = director->getTotalFrames();
+    for (auto vt : textures)
     {
-        VolatileTexture* vt = texture;
+        auto texture = vt->_texture;
+        if (vt->_cashedImageType == VolatileTexture::kInvalid)
+            continue;
 
-        switch (vt->_cashedImageType)
+        // the textures evicted by the TextureCache only need their placeholder, they are reloaded once drawn
+        if (texture->isStorageEvicted())
         {
-        case VolatileTexture::kImageFile:
-        {
-            reloadTexture(vt->_texture, vt->_fileName, vt->_pixelFormat);
+            texture->updatePlaceholderStorage();
+            continue;
+        }
 
-            // etc1 support check whether alpha texture exists & load it
-            Image image;
-            if (image.initWithImageFile(vt->_fileName + TextureCache::getETC1AlphaFileSuffix()))
-            {
-                vt->_texture->updateWithImage(&image, vt->_pixelFormat, 1);
-            }
+        if (!texture->evictStorage())
+        {
+            reloadTexture(vt);
+            continue;
         }
-        break;
-        case VolatileTexture::kImageData:
+
+        texture->retain();
+        texture->_storageReloading = true;
+        _pendingReloads.emplace_back(texture);
+
+        if (vt->_cashedImageType != VolatileTexture::kImageFile)
         {
-            vt->_texture->initWithData(vt->_textureData, vt->_dataLen, vt->_pixelFormat, vt->_textureSize.width,
-                                       vt->_textureSize.height);
+            _memoryReloads.emplace_back(vt);
+            continue;
         }
-        break;
-        case VolatileTexture::kString:
+
+        // the textures of the last frame are decoded first
+        auto image    = new Image();
+        auto decode   = [image, path = vt->_fileName, data = vt->_fileData] {
+            if (data.isNull())
+                image->initWithImageFileThreadSafe(path);
+            else
+                image->initWithImageData(data.getBytes(), data.getSize());
+        };
+        auto priority = lastFrame - texture->getLastUsedFrame() <= 1 ? JobPriority::High : JobPriority::Normal;
+        jobSystem->schedule(std::move(decode), priority)
+            .thenOnAxmolThread([vt, image, generation = _reloadGeneration] {
+                if (generation == _reloadGeneration)
+                    _decodedReloads.emplace_back(vt, image);
+                else
+                    image->release();
+            });
+    }
+
+    if (!_pendingReloads.empty())
+    {
+        director->getScheduler()->schedule([](float) { uploadReloadedTextures(); }, &_pendingReloads, 0, false,
+                                           "VolatileTextureMgr::uploadReloadedTextures");
+    }
+}
+
+void VolatileTextureMgr::uploadReloadedTextures()
+{
+    AX_TRACE_SCOPE("VolatileTextureMgr::uploadReloadedTextures");
+
+    const auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+        // the decoded files first, they are decoded by priority, the textures kept in memory in their order then
+        if (!_decodedReloads.empty())
         {
-            vt->_texture->initWithString(vt->_text, vt->_fontDefinition);
+            auto [vt, image] = _decodedReloads.front();
+            _decodedReloads.pop_front();
+            if (!restoreTexture(vt, image))
+                AXLOGW("VolatileTextureMgr: failed to reload the texture: {}", vt->_fileName);
+            image->release();
+            finishReload(vt->_texture);
         }
-        break;
-        case VolatileTexture::kImage:
+        else if (!_memoryReloads.empty())
         {
-            vt->_texture->initWithImage(vt->_uiImage, vt->_pixelFormat);
+            auto vt = _memoryReloads.front();
+            _memoryReloads.pop_front();
+            restoreTexture(vt, nullptr);
+            finishReload(vt->_texture);
         }
-        break;
-        default:
+        else
+        {
             break;
         }
+
+        if (_reloadBudget > 0 &&
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= _reloadBudget)
+            break;
+    }
+
+    if (_pendingReloads.empty())
+    {
+        Director::getInstance()->getScheduler()->unschedule("VolatileTextureMgr::uploadReloadedTextures",
+                                                            &_pendingReloads);
+    }
+}
+
+bool VolatileTextureMgr::restoreTexture(VolatileTexture* vt, Image* image)
+{
+    auto texture = vt->_texture;
+    bool ret     = false;
+
+    // the textures initialized again don't register themselves again
+    _isReloading = true;
+    switch (vt->_cashedImageType)
+    {
+    case VolatileTexture::kImageFile:
+        ret = texture->restoreStorage(image, vt->_pixelFormat);
+        break;
+    case VolatileTexture::kImage:
+        ret = texture->restoreStorage(vt->_uiImage, vt->_pixelFormat);
+        break;
+    case VolatileTexture::kImageData:
+        texture->_storageEvicted = false;
+        ret = texture->initWithData(vt->_textureData, vt->_dataLen, vt->_pixelFormat, vt->_textureSize.width,
+                                    vt->_textureSize.height);
+        break;
+    case VolatileTexture::kString:
+        texture->_storageEvicted = false;
+        ret                      = texture->initWithString(vt->_text, vt->_fontDefinition);
+        break;
+    default:
+        break;
+    }
+    _isReloading = false;
+
+    // a texture failing to reload stays marked as reloading, so the TextureCache doesn't retry it
+    if (ret)
+        texture->_storageReloading = false;
+    return ret;
+}
+
+void VolatileTextureMgr::finishReload(Texture2D* texture)
+{
+    auto it = std::find(_pendingReloads.begin(), _pendingReloads.end(), texture);
+    if (it != _pendingReloads.end())
+    {
+        _pendingReloads.erase(it);
+        texture->release();
     }
+}
 
+void VolatileTextureMgr::reloadTexture(VolatileTexture* vt)
+{
+    _isReloading = true;
+    switch (vt->_cashedImageType)
+    {
+    case VolatileTexture::kImageFile:
+    {
+        reloadTexture(vt->_texture, vt->_fileName, vt->_pixelFormat);
+
+        // etc1 support check whether alpha texture exists & load it
+        Image image;
+        if (image.initWithImageFile(vt->_fileName + TextureCache::getETC1AlphaFileSuffix()))
+        {
+            vt->_texture->updateWithImage(&image, vt->_pixelFormat, 1);
+        }
+    }
+    break;
+    case VolatileTexture::kImageData:
+    {
+        vt->_texture->initWithData(vt->_textureData, vt->_dataLen, vt->_pixelFormat, vt->_textureSize.width,
+                                   vt->_textureSize.height);
+    }
+    break;
+    case VolatileTexture::kString:
+    {
+        vt->_texture->initWithString(vt->_text, vt->_fontDefinition);
+    }
+    break;
+    case VolatileTexture::kImage:
+    {
+        vt->_texture->initWithImage(vt->_uiImage, vt->_pixelFormat);
+    }
+    break;
+    default:
+        break;
+    }
     _isReloading = false;
 }
 
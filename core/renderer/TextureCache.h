@@ -32,17 +32,23 @@ THE SOFTWARE.
 
 #include <mutex>
 #include <thread>
+#include <atomic>
 #include <condition_variable>
 #include <queue>
 #include <string>
+#include <vector>
+#include <memory>
+#include <span>
 #include <unordered_map>
 #include <functional>
 
+#include "base/Async.h"
 #include "base/Object.h"
 #include "renderer/Texture2D.h"
 #include "platform/Image.h"
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
+#    include <deque>
 #    include <list>
 #endif
 
@@ -124,6 +130,62 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** The token of async load requests, see addImageAsync and addImagesAsync.
+     * Cancelling it drops the callbacks of its requests, the images which aren't decoded yet are skipped.
+     */
+    class AsyncLoadToken
+    {
+    public:
+        void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+        bool isCancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> _cancelled{false};
+    };
+
+    /** Loads a texture asynchronously with a priority.
+     * The images are decoded on the JobSystem workers, see setAsyncLoadingConcurrency. The pending requests of higher
+     * priority are decoded first, requests of the same priority in the order they were added.
+     * @param priority The priority of the request, 0 is the priority of the other addImageAsync overloads.
+     * @param callbackKey The key for unbindImageAsync.
+     * @return The token to cancel the request with.
+     */
+    std::shared_ptr<AsyncLoadToken> addImageAsync(std::string_view path,
+                                                  const std::function<void(Texture2D*)>& callback,
+                                                  int priority,
+                                                  std::string_view callbackKey = "");
+
+    /** Loads a list of textures asynchronously, onAllLoaded is called once all of them are loaded.
+     * @param onAllLoaded The callback receiving the textures in the order of the paths, nullptr for the images
+     * failed to load.
+     * @return The token to cancel all the requests with, onAllLoaded isn't called once it's cancelled.
+     */
+    std::shared_ptr<AsyncLoadToken> addImagesAsync(std::span<const std::string> paths,
+                                                   std::function<void(const std::vector<Texture2D*>&)> onAllLoaded,
+                                                   int priority = 0);
+
+    /** Loads a texture asynchronously like addImageAsync, as a task a coroutine can await, see ax::Task.
+     * The texture is nullptr when the image failed to load. unbindAllImageAsync drops the request, the task never
+     * ends then.
+     */
+    Task<Texture2D*> loadTextureAsync(std::string path, int priority = 0);
+
+    /** Sets how many JobSystem workers decode the async load requests at most, 0 uses all of them, the default. */
+    void setAsyncLoadingConcurrency(int concurrency);
+    int getAsyncLoadingConcurrency() const { return _asyncLoadingConcurrency; }
+
+    /** Sets how much of the decoded async images is uploaded to the GPU per frame, 0 is unlimited, the default.
+     * The textures are created in the order their images are decoded until one of the budgets is used up, the others
+     * wait for the next frames, the images over the byte budget are uploaded in row slices over several frames when
+     * their pixels don't need a conversion. The callbacks are invoked once the textures are complete, at least one
+     * texture or slice is uploaded per frame.
+     * @param bytesPerFrame The pixel bytes uploaded per frame.
+     * @param maxMilliseconds The time spent creating the textures per frame.
+     */
+    void setAsyncUploadBudget(size_t bytesPerFrame, float maxMilliseconds = 0);
+    size_t getAsyncUploadBudget() const { return _asyncUploadBudget; }
+    float getAsyncUploadTimeBudget() const { return _asyncUploadTimeBudget; }
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
@@ -184,6 +246,29 @@ public:
      */
     void removeUnusedTextures();
 
+    /** Sets the GPU memory budget of the cached textures in bytes, 0 disables it, the default.
+     * While the textures are over the budget, the unreferenced textures are removed from the cache and the file
+     * textures which weren't drawn for minUnusedFrames are evicted, see Texture2D::evictStorage. The textures of
+     * lower residency priority go first, then the least recently drawn ones. An evicted texture is drawn with a
+     * transparent placeholder once it's used again, until it's reloaded from its file on the JobSystem workers.
+     * @param bytes The budget of the textures, the placeholders aren't counted.
+     * @param minUnusedFrames The frames a referenced texture must not be drawn in to be evicted.
+     */
+    void setMemoryBudget(size_t bytes, unsigned int minUnusedFrames = 60);
+    size_t getMemoryBudget() const { return _memoryBudget; }
+
+    /** Gets the GPU memory of the cached textures in bytes, see Texture2D::getMemorySize. */
+    size_t getMemoryUsage() const;
+
+    /** Enables streaming the mipmaps of the large textures, 0 disables it, the default.
+     * The textures loaded from files with mipmaps, e.g. PVR, KTX or ASTC, of at least minSize pixels are created with
+     * the levels up to initialSize pixels only, see Texture2D::updateWithImageMipLevel. The lower levels are loaded on
+     * the JobSystem workers once the sprites drawing the texture request them, see Texture2D::requestMipLevel, and
+     * dropped again when the texture isn't drawn for holdFrames.
+     */
+    void setMipStreaming(int minSize, int initialSize = 256, unsigned int holdFrames = 120);
+    int getMipStreamingMinSize() const { return _mipStreamingMinSize; }
+
     /** Deletes a texture from the cache given a texture.
      */
     void removeTexture(Texture2D* texture);
@@ -226,14 +311,28 @@ public:
 
 private:
     void addImageAsyncCallBack(float dt);
-    void loadImage();
+    void requestImageAsync(std::string_view path,
+                           const std::function<void(Texture2D*)>& callback,
+                           int priority,
+                           std::string_view callbackKey,
+                           const std::shared_ptr<AsyncLoadToken>& token);
+    void dispatchAsyncLoaders();
+    void loadImages();
+    void updateResidency(float dt);
+    void scheduleResidencyUpdate(bool schedule);
+    void trimToMemoryBudget(size_t usage);
+    bool initTextureWithImage(Texture2D* texture, Image* image, PixelFormat format);
+    int getInitialMipLevel(Texture2D* texture) const;
+    void updateMipStreaming(Texture2D* texture, unsigned int frame);
+    void reloadEvictedTexture(Texture2D* texture);
     void parseNinePatchImage(Image* image, Texture2D* texture, std::string_view path);
 
 public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
+    bool uploadAsyncImage(AsyncStruct* asyncStruct, size_t& budget, bool& uploaded);
+    void finishAsyncStruct(AsyncStruct* asyncStruct);
 
     std::deque<AsyncStruct*> _asyncStructQueue;
     std::deque<AsyncStruct*> _requestQueue;
@@ -242,12 +341,25 @@ protected:
     std::mutex _requestMutex;
     std::mutex _responseMutex;
 
-    std::condition_variable _sleepCondition;
+    std::condition_variable _loadersCondition;
 
     bool _needQuit;
+    int _asyncLoaders;  // the running loader jobs, guarded by _requestMutex
+    int _asyncLoadingConcurrency;
 
     int _asyncRefCount;
 
+    size_t _asyncUploadBudget;
+    float _asyncUploadTimeBudget;
+    AsyncStruct* _uploadingStruct;  // the response whose texture is uploaded in slices
+
+    size_t _memoryBudget;
+    unsigned int _minUnusedFrames;
+
+    int _mipStreamingMinSize;
+    int _mipStreamingInitialSize;
+    unsigned int _mipStreamingHoldFrames;
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
@@ -288,6 +400,7 @@ protected:
     backend::PixelFormat _pixelFormat;
 
     std::string _fileName;
+    Data _fileData;  // kept by VolatileTextureMgr::setKeepFileData
 
     std::string _text;
     FontDefinition _fontDefinition;
@@ -305,8 +418,33 @@ public:
                                const Vec2& contentSize);
     static void addImage(Texture2D* tt, Image* image);
     static void removeTexture(Texture2D* t);
+
+    /** Reloads the textures once the context of the renderer is recreated.
+     The textures get a transparent placeholder of their size first, see Texture2D::evictStorage. The image files are
+     decoded in parallel by the JobSystem, the textures drawn last before the context was lost first. Their pixels
+     are uploaded on the axmol thread within the reload budget, with the string textures and the images kept in
+     memory. The render targets and the textures with a separate alpha are reloaded right away.
+     */
     static void reloadAllTextures();
 
+    /** The time spent uploading the reloaded textures per frame by default, in seconds. */
+    static constexpr float DEFAULT_RELOAD_BUDGET = 0.008f;
+
+    /** Sets the time in seconds spent uploading the reloaded textures per frame, 0 is unlimited. At least one texture
+     is uploaded per frame. */
+    static void setReloadBudget(float seconds) { _reloadBudget = seconds; }
+    static float getReloadBudget() { return _reloadBudget; }
+
+    /** The number of textures still waiting for their pixels since the last reloadAllTextures. */
+    static size_t getPendingReloadCount() { return _pendingReloads.size(); }
+
+    /** Keeps the bytes of the image files in memory, so that reloading the textures doesn't read their files again.
+     The files of the textures added while it's enabled are read once more by addImageTexture, their compressed
+     bytes are kept as long as the textures. Disabled by default.
+     */
+    static void setKeepFileData(bool keep) { _keepFileData = keep; }
+    static bool isKeepingFileData() { return _keepFileData; }
+
 public:
     static std::list<VolatileTexture*> _textures;
     static bool _isReloading;
@@ -318,6 +456,19 @@ public:
 
 private:
     static void reloadTexture(Texture2D* texture, std::string_view filename, backend::PixelFormat pixelFormat);
+    /** Reloads a texture right away, without a placeholder. */
+    static void reloadTexture(VolatileTexture* vt);
+    /** Uploads the pixels of a texture with a placeholder, the image is the decoded file of a kImageFile texture. */
+    static bool restoreTexture(VolatileTexture* vt, Image* image);
+    static void uploadReloadedTextures();
+    static void finishReload(Texture2D* texture);
+
+    static std::vector<Texture2D*> _pendingReloads;  // retained until their pixels are uploaded
+    static std::deque<std::pair<VolatileTexture*, Image*>> _decodedReloads;
+    static std::deque<VolatileTexture*> _memoryReloads;  // the textures reloaded from memory, in priority order
+    static unsigned int _reloadGeneration;
+    static float _reloadBudget;
+    static bool _keepFileData;
 };
 
 #endif
@@ -30,6 +30,8 @@
 #include "renderer/backend/Texture.h"
 #include "renderer/backend/DriverBase.h"
 #include "renderer/backend/PixelFormatUtils.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
 
 namespace ax
 {
@@ -169,6 +171,96 @@ TextureCube* TextureCube::create(std::string_view positive_x,
     return nullptr;
 }
 
+TextureCube* TextureCube::create(std::string_view path)
+{
+    auto ret = new TextureCube();
+    if (ret->init(path))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    AX_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+void TextureCube::createAsync(std::string_view path, std::function<void(TextureCube*)> callback)
+{
+    auto image = new Image();
+    Director::getInstance()->getJobSystem()->enqueue(
+        [image, fullPath = FileUtils::getInstance()->fullPathForFilename(path)] {
+        image->initWithImageFileThreadSafe(fullPath);
+    }, [image, path = std::string{path}, callback = std::move(callback)] {
+        auto texture = new TextureCube();
+        texture->_imgPath.assign(1, path);
+        if (texture->initWithCubeMap(image))
+            texture->autorelease();
+        else
+            AX_SAFE_DELETE(texture);
+        image->release();
+        callback(texture);
+    });
+}
+
+bool TextureCube::init(std::string_view path)
+{
+    _imgPath.assign(1, std::string{path});
+
+    auto image = createImage(path);
+    if (!image)
+        return false;
+
+    bool ret = initWithCubeMap(image);
+    image->release();
+    return ret;
+}
+
+bool TextureCube::initWithCubeMap(Image* image)
+{
+    if (image->getNumberOfFaces() != 6)
+    {
+        AXLOGW("TextureCube: {} isn't a cube map", image->getFilePath());
+        return false;
+    }
+
+    const int size = image->getWidth();
+    backend::TextureDescriptor textureDescriptor;
+    textureDescriptor.width = textureDescriptor.height = size;
+    textureDescriptor.textureType                      = backend::TextureType::TEXTURE_CUBE;
+    textureDescriptor.textureFormat                    = image->getPixelFormat();
+    textureDescriptor.samplerDescriptor.minFilter      = backend::SamplerFilter::LINEAR;
+    textureDescriptor.samplerDescriptor.magFilter      = backend::SamplerFilter::LINEAR;
+    textureDescriptor.samplerDescriptor.sAddressMode   = backend::SamplerAddressMode::CLAMP_TO_EDGE;
+    textureDescriptor.samplerDescriptor.tAddressMode   = backend::SamplerAddressMode::CLAMP_TO_EDGE;
+
+    AX_SAFE_RELEASE_NULL(_texture);
+    _texture =
+        static_cast<backend::TextureCubemapBackend*>(backend::DriverBase::getInstance()->newTexture(textureDescriptor));
+    if (!_texture)
+        return false;
+
+    // a partial mipmap chain can't be sampled, only its first level is kept
+    int levelCount = image->getNumberOfMipmaps();
+    int fullCount  = 1;
+    for (int levelSize = size; levelSize > 1; levelSize >>= 1)
+        ++fullCount;
+    if (levelCount != fullCount)
+        levelCount = 1;
+
+    auto mipmaps = image->getMipmaps();
+    for (int level = 0; level < levelCount; ++level)
+    {
+        const size_t faceLen = mipmaps[level].len / 6;
+        for (int face = 0; face < 6; ++face)
+            _texture->updateFaceLevelData(static_cast<backend::TextureCubeFace>(face),
+                                          mipmaps[level].address + face * faceLen, faceLen, level);
+    }
+
+    // the min filter samples the mipmaps now they are uploaded
+    if (levelCount > 1)
+        _texture->updateSamplerDescriptor(textureDescriptor.samplerDescriptor);
+    return true;
+}
+
 bool TextureCube::init(std::string_view positive_x,
                        std::string_view negative_x,
                        std::string_view positive_y,
@@ -269,6 +361,8 @@ void TextureCube::setTexParameters(const Texture2D::TexParams& texParams)
 
 bool TextureCube::reloadTexture()
 {
+    if (_imgPath.size() == 1)
+        return init(_imgPath[0]);
     return init(_imgPath[0], _imgPath[1], _imgPath[2], _imgPath[3], _imgPath[4], _imgPath[5]);
 }
 
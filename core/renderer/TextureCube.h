@@ -31,11 +31,14 @@
 
 #include <string>
 #include <unordered_map>
+#include <functional>
 #include "base/Types.h"
 
 namespace ax
 {
 
+class Image;
+
 /**
  * @addtogroup _3d
  * @{
@@ -64,6 +67,20 @@ public:
                                std::string_view positive_z,
                                std::string_view negative_z);
 
+    /** create cube texture from a single KTX2 cube map file.
+       The faces and their mipmaps are uploaded in the format of the file, i.e. ASTC or ETC2, when the GPU supports
+       it, so they take a fraction of the memory of the RGBA faces.
+       @param path the KTX2 file, with 6 square faces.
+       @return  A new texture cube, nullptr if the file can't be loaded.
+    */
+    static TextureCube* create(std::string_view path);
+
+    /** load a KTX2 cube map in a worker thread, then create the texture on the axmol thread.
+       @param path the KTX2 file, with 6 square faces.
+       @param callback invoked with the texture, or nullptr if the file can't be loaded.
+    */
+    static void createAsync(std::string_view path, std::function<void(TextureCube*)> callback);
+
     /** Sets the min filter, mag filter, wrap s and wrap t texture parameters.
     If the texture size is NPOT (non power of 2), then in can only use GL_CLAMP_TO_EDGE in GL_TEXTURE_WRAP_{S,T}.
     */
@@ -93,6 +110,8 @@ protected:
               std::string_view negative_y,
               std::string_view positive_z,
               std::string_view negative_z);
+    bool init(std::string_view path);
+    bool initWithCubeMap(Image* image);
 
 private:
     std::vector<std::string> _imgPath;
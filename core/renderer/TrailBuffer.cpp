@@ -0,0 +1,180 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "renderer/TrailBuffer.h"
+#include "renderer/backend/ProgramState.h"
+
+#include <stddef.h>  // offsetof
+
+namespace ax
+{
+
+void TrailBuffer::init(unsigned int maxPoints, float fadeTime)
+{
+    AXASSERT(maxPoints > 1, "A trail needs 2 points at least");
+
+    _capacity = maxPoints;
+    _fadeTime = fadeTime;
+    _first = _count = 0;
+    _time           = 0;
+    _vertices.assign((_capacity + 1) * 2, Vertex{});
+
+    for (auto& command : _commands)
+    {
+        command.setDrawType(CustomCommand::DrawType::ARRAY);
+        command.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE_STRIP);
+    }
+    _commands[0].createVertexBuffer(sizeof(Vertex), _vertices.size(), CustomCommand::BufferUsage::DYNAMIC);
+    _commands[1].setVertexBuffer(_commands[0].getVertexBuffer());
+    uploadAll();
+}
+
+void TrailBuffer::setProgramState(backend::ProgramState* programState)
+{
+    _programState = programState;
+    for (auto& command : _commands)
+        command.getPipelineDescriptor().programState = programState;
+    if (!programState)
+        return;
+
+    _mvpMatrixLocation = programState->getUniformLocation("u_MVPMatrix");
+    _streakLocation    = programState->getUniformLocation("u_streak");
+
+    const auto& attributeInfo = programState->getProgram()->getActiveAttributes();
+    auto layout               = programState->getMutableVertexLayout();
+    auto iter                 = attributeInfo.find("a_position");
+    if (iter != attributeInfo.end())
+        layout->setAttrib("a_position", iter->second.location, backend::VertexFormat::FLOAT4,
+                          offsetof(Vertex, position), false);
+    iter = attributeInfo.find("a_texCoord");
+    if (iter != attributeInfo.end())
+        layout->setAttrib("a_texCoord", iter->second.location, backend::VertexFormat::FLOAT4, offsetof(Vertex, offset),
+                          false);
+    iter = attributeInfo.find("a_color");
+    if (iter != attributeInfo.end())
+        layout->setAttrib("a_color", iter->second.location, backend::VertexFormat::UBYTE4, offsetof(Vertex, color),
+                          true);
+    layout->setStride(sizeof(Vertex));
+}
+
+void TrailBuffer::update(float delta)
+{
+    _time += delta;
+    while (_count > 0 && _time - _vertices[_first * 2].appendTime >= _fadeTime)
+    {
+        _first = (_first + 1) % _capacity;
+        --_count;
+    }
+
+    if (_time >= REBASE_TIME)
+    {
+        for (auto& vertex : _vertices)
+            vertex.appendTime -= _time;
+        _time = 0;
+        uploadAll();
+    }
+}
+
+void TrailBuffer::reset()
+{
+    _first = _count = 0;
+}
+
+void TrailBuffer::append(const Vec3& point, const Vec3& offset, const Color4B& color)
+{
+    AXASSERT(!isFull(), "The trail is full");
+
+    const auto slot = slotOf(_count++);
+    auto* vertices  = &_vertices[slot * 2];
+    vertices[0]     = Vertex{point, _time, offset, 0.0f, color};
+    vertices[1]     = Vertex{point, _time, -offset, 1.0f, color};
+    uploadSlot(slot);
+}
+
+void TrailBuffer::setOffset(unsigned int index, const Vec3& offset)
+{
+    const auto slot = slotOf(index);
+    auto* vertices  = &_vertices[slot * 2];
+    if (vertices[0].offset == offset)
+        return;
+
+    vertices[0].offset = offset;
+    vertices[1].offset = -offset;
+    uploadSlot(slot);
+}
+
+void TrailBuffer::setColor(const Color3B& color)
+{
+    for (auto& vertex : _vertices)
+    {
+        vertex.color.r = color.r;
+        vertex.color.g = color.g;
+        vertex.color.b = color.b;
+    }
+    uploadAll();
+}
+
+int TrailBuffer::prepareCommands(const Mat4& mvpMatrix, float stroke)
+{
+    if (_count <= 1 || !_programState)
+        return 0;
+
+    const float streak[4] = {_time, 1.0f / _fadeTime, stroke * 0.5f, 0.0f};
+    _programState->setUniform(_mvpMatrixLocation, mvpMatrix.m, sizeof(mvpMatrix.m));
+    _programState->setUniform(_streakLocation, streak, sizeof(streak));
+
+    if (_first + _count <= _capacity)
+    {
+        _commands[0].setVertexDrawInfo(_first * 2, _count * 2);
+        return 1;
+    }
+
+    // up to the mirror of the first slot, then from the first slot
+    const auto tail = _capacity - _first;
+    _commands[0].setVertexDrawInfo(_first * 2, (tail + 1) * 2);
+    if (_count - tail < 2)
+        return 1;
+    _commands[1].setVertexDrawInfo(0, (_count - tail) * 2);
+    return 2;
+}
+
+void TrailBuffer::uploadSlot(unsigned int slot)
+{
+    _commands[0].updateVertexBuffer(&_vertices[slot * 2], slot * 2 * sizeof(Vertex), 2 * sizeof(Vertex));
+    if (slot == 0)
+    {
+        _vertices[_capacity * 2]     = _vertices[0];
+        _vertices[_capacity * 2 + 1] = _vertices[1];
+        _commands[0].updateVertexBuffer(&_vertices[_capacity * 2], _capacity * 2 * sizeof(Vertex),
+                                        2 * sizeof(Vertex));
+    }
+}
+
+void TrailBuffer::uploadAll()
+{
+    _vertices[_capacity * 2]     = _vertices[0];
+    _vertices[_capacity * 2 + 1] = _vertices[1];
+    _commands[0].updateVertexBuffer(_vertices.data(), _vertices.size() * sizeof(Vertex));
+}
+
+}  // namespace ax
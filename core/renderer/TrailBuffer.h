@@ -0,0 +1,129 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "base/Types.h"
+#include "math/Vec3.h"
+#include "renderer/CustomCommand.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+namespace ax
+{
+
+/**
+ The points of a trail in a ring buffer on the GPU, drawn as a triangle strip by the MOTION_STREAK program.
+ A point is uploaded once when it is appended, the vertex shader fades it out with its age and expands it to the
+ stroke, so a trail costs no vertex work per frame, see MotionStreak and MotionStreak3D.
+*/
+class AX_DLL TrailBuffer
+{
+public:
+    /**The two vertices of a point, on both sides of the strip.*/
+    struct Vertex
+    {
+        Vec3 position;
+        float appendTime;
+        Vec3 offset;  ///< to the edge of the strip, for a stroke of 1
+        float u;      ///< texture coordinate across the strip
+        Color4B color;
+    };
+
+    /**Time after which the clock is moved back, so the append times keep their precision.*/
+    static constexpr float REBASE_TIME = 4096.0f;
+
+    TrailBuffer() = default;
+
+    TrailBuffer(const TrailBuffer&)            = delete;
+    TrailBuffer& operator=(const TrailBuffer&) = delete;
+
+    /**
+     * Create the vertex buffer.
+     * @param maxPoints The points kept at most, no point is appended while the buffer is full.
+     * @param fadeTime The seconds a point lives.
+     */
+    void init(unsigned int maxPoints, float fadeTime);
+
+    /**Bind the vertex layout of Vertex to the program state of both draw commands.*/
+    void setProgramState(backend::ProgramState* programState);
+
+    /**Advance the clock and drop the points that faded out.*/
+    void update(float delta);
+
+    void reset();
+
+    bool isFull() const { return _count == _capacity; }
+    unsigned int getPointCount() const { return _count; }
+
+    /**A point, the oldest one is 0.*/
+    const Vec3& getPoint(unsigned int index) const { return _vertices[slotOf(index) * 2].position; }
+    const Vec3& getOffset(unsigned int index) const { return _vertices[slotOf(index) * 2].offset; }
+
+    /**Append a point, the strip spans offset on both sides of it for a stroke of 1.*/
+    void append(const Vec3& point, const Vec3& offset, const Color4B& color);
+    /**Change the offset of a point, the oldest one is 0.*/
+    void setOffset(unsigned int index, const Vec3& offset);
+    /**Change the color of all the points.*/
+    void setColor(const Color3B& color);
+
+    /**
+     * Set the uniforms of the draw commands.
+     * @return The number of commands to add, 2 when the points wrap around the end of the buffer, 0 for less than
+     * 2 points.
+     */
+    int prepareCommands(const Mat4& mvpMatrix, float stroke);
+    CustomCommand& getCommand(int index) { return _commands[index]; }
+
+private:
+    unsigned int slotOf(unsigned int index) const { return (_first + index) % _capacity; }
+    /**Upload the vertices of a slot, and of its mirror past the end for the first one.*/
+    void uploadSlot(unsigned int slot);
+    void uploadAll();
+
+    // 2 vertices per slot, the extra slot at the end mirrors the first one, so the strip drawn up to the end of the
+    // buffer joins the one starting again from the beginning
+    std::vector<Vertex> _vertices;
+    unsigned int _capacity = 0;
+    unsigned int _first    = 0;
+    unsigned int _count    = 0;
+
+    float _time     = 0;
+    float _fadeTime = 1.0f;
+
+    CustomCommand _commands[2];
+    backend::ProgramState* _programState = nullptr;
+    backend::UniformLocation _mvpMatrixLocation;
+    backend::UniformLocation _streakLocation;
+};
+
+}  // namespace ax
+
+// end of renderer group
+/// @}
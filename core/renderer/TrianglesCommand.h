@@ -103,6 +103,10 @@ public:
     const unsigned short* getIndices() const { return _triangles.indices; }
     /**Get the model view matrix.*/
     const Mat4& getModelView() const { return _mv; }
+    /**Get the texture, the blend func and the batch id of the program state the material id is generated from.*/
+    backend::TextureBackend* getTexture() const { return _texture; }
+    const BlendFunc& getBlendType() const { return _blendType; }
+    uint64_t getBatchId() const { return _batchId; }
 
     /** update material ID */
     void updateMaterialID();
@@ -74,6 +74,27 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) = 0;
 
+    /**
+     * Reserve a region of a ring buffer and map it for writing, see `DriverBase::newRingBuffer`.
+     * The written data is visible to the GPU after `unmapRange`, the region stays untouched until the GPU
+     * completed the frames which used it, so writing never stalls on draws in flight.
+     * @param size Specifies the size in bytes of the region.
+     * @param alignment Specifies the alignment in bytes of the region offset, not necessarily a power of two.
+     * @param offset Receives the offset in bytes of the region in the buffer.
+     * @return A pointer to the mapped region, or nullptr if the buffer isn't a ring buffer or can't be mapped.
+     */
+    virtual void* mapRange(std::size_t /*size*/, std::size_t /*alignment*/, std::size_t& /*offset*/) { return nullptr; }
+
+    /**
+     * Make the region mapped by `mapRange` visible to the GPU.
+     */
+    virtual void unmapRange() {}
+
+    /**
+     * Mark the end of a frame for a ring buffer, the regions written in the frame are fenced.
+     */
+    virtual void endFrame() {}
+
     /**
      * Get buffer size in bytes.
      * @return The buffer size in bytes.
@@ -221,6 +221,53 @@ public:
      */
     virtual void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) = 0;
 
+    /**
+     * The number of redundant state calls the backend skipped in the last frame, 0 when it doesn't track them.
+     */
+    virtual std::size_t getElidedStateCalls() const { return 0; }
+
+    /**
+     * Split the current render pass into `count` ordered command buffers which can be encoded concurrently, each
+     * one by a single thread. The GPU executes their commands in index order, before the commands encoded after
+     * `endParallelEncoding`. They have their own pipeline and depth stencil state and must be begun with the render
+     * target and descriptor of the current render pass.
+     * @param count The number of command buffers.
+     * @param commandBuffers Receives the command buffers, they are owned by this one.
+     * @return false if the backend doesn't support parallel encoding.
+     */
+    virtual bool beginParallelEncoding(int count, std::vector<CommandBuffer*>& commandBuffers) { return false; }
+
+    /**
+     * Finish the command buffers of `beginParallelEncoding`, must be invoked after all of them are encoded.
+     */
+    virtual void endParallelEncoding() {}
+
+    /**
+     * Whether the GPU time of timer scopes can be measured, GL_ARB_timer_query or GL_EXT_disjoint_timer_query
+     * on the OpenGL backend.
+     */
+    virtual bool isGPUTimerSupported() const { return false; }
+
+    /**
+     * Begin a GPU timer scope, scopes can be nested and must be ended in the frame they are begun in.
+     * @param label The name reported by `getGPUTimerResults`.
+     */
+    virtual void beginGPUTimer(std::string_view label) {}
+    virtual void endGPUTimer() {}
+
+    /**
+     * The GPU results are available a few frames later, get the timers of the latest frame the GPU finished.
+     * @param samples Receives the scopes in begin order.
+     * @return false if no frame finished since the last call, samples is unchanged then.
+     */
+    virtual bool getGPUTimerResults(std::vector<GPUTimerSample>& samples) { return false; }
+
+    /**
+     * Whether the frames can be begun, encoded and ended on another thread than the one creating and updating the
+     * resources, see `Renderer::setRenderThreadEnabled`.
+     */
+    virtual bool isRenderThreadSupported() const { return false; }
+
     /**
      * Update both front and back stencil reference value.
      * @param value Specifies stencil reference value.
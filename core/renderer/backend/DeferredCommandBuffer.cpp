@@ -0,0 +1,298 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "DeferredCommandBuffer.h"
+#include "Buffer.h"
+#include "RenderPipeline.h"
+#include "RenderTarget.h"
+
+NS_AX_BACKEND_BEGIN
+
+struct DeferredCommandBuffer::Executor
+{
+    CommandBuffer* commandBuffer;
+
+    void operator()(const SetDepthStencilState& command) const
+    {
+        commandBuffer->setDepthStencilState(command.state);
+    }
+    void operator()(const SetRenderPipeline& command) const { commandBuffer->setRenderPipeline(command.pipeline); }
+    void operator()(const BeginRenderPass& command) const
+    {
+        commandBuffer->beginRenderPass(command.target, command.descriptor);
+    }
+    void operator()(const UpdateDepthStencilState& command) const
+    {
+        commandBuffer->updateDepthStencilState(command.descriptor);
+    }
+    void operator()(const UpdatePipelineState& command) const
+    {
+        commandBuffer->updatePipelineState(command.target, command.descriptor);
+    }
+    void operator()(const SetViewport& command) const
+    {
+        commandBuffer->setViewport(command.x, command.y, command.width, command.height);
+    }
+    void operator()(const SetCullMode& command) const { commandBuffer->setCullMode(command.mode); }
+    void operator()(const SetWinding& command) const { commandBuffer->setWinding(command.winding); }
+    void operator()(const SetBuffer& command) const
+    {
+        switch (command.slot)
+        {
+        case BufferSlot::VERTEX:
+            commandBuffer->setVertexBuffer(command.buffer);
+            break;
+        case BufferSlot::INDEX:
+            commandBuffer->setIndexBuffer(command.buffer);
+            break;
+        case BufferSlot::INSTANCE:
+            commandBuffer->setInstanceBuffer(command.buffer);
+            break;
+        }
+    }
+    void operator()(const SetProgramState& command) const { commandBuffer->setProgramState(command.programState); }
+    void operator()(const SetStencilReference& command) const
+    {
+        commandBuffer->setStencilReferenceValue(command.front, command.back);
+    }
+    void operator()(const Draw& command) const
+    {
+        if (!command.indexed)
+            commandBuffer->drawArrays(command.primitiveType, command.start, command.count, command.wireframe);
+        else if (command.instanceCount == 0)
+            commandBuffer->drawElements(command.primitiveType, command.indexType, command.count, command.start,
+                                        command.wireframe);
+        else
+            commandBuffer->drawElementsInstanced(command.primitiveType, command.indexType, command.count,
+                                                 command.start, command.instanceCount, command.wireframe);
+    }
+    void operator()(const EndRenderPass&) const { commandBuffer->endRenderPass(); }
+    void operator()(const SetScissorRect& command) const
+    {
+        commandBuffer->setScissorRect(command.enabled, command.x, command.y, command.width, command.height);
+    }
+    void operator()(const ReadPixels& command) const { commandBuffer->readPixels(command.target, command.callback); }
+    void operator()(const GPUTimer& command) const
+    {
+        if (command.label.empty())
+            commandBuffer->endGPUTimer();
+        else
+            commandBuffer->beginGPUTimer(command.label);
+    }
+};
+
+DeferredCommandBuffer::DeferredCommandBuffer(CommandBuffer* target) : _target(target) {}
+
+DeferredCommandBuffer::~DeferredCommandBuffer()
+{
+    reset();
+}
+
+void DeferredCommandBuffer::execute(CommandBuffer* commandBuffer)
+{
+    Executor executor{commandBuffer};
+    for (auto&& command : _commands)
+        std::visit(executor, command);
+}
+
+void DeferredCommandBuffer::reset()
+{
+    _commands.clear();
+    for (auto&& object : _retainedObjects)
+        object->release();
+    _retainedObjects.clear();
+
+    _lastProgramState         = nullptr;
+    _lastSnapshot             = nullptr;
+    _stencilReferenceRecorded = false;
+}
+
+void DeferredCommandBuffer::retain(const Object* object)
+{
+    if (!object)
+        return;
+    auto mutableObject = const_cast<Object*>(object);
+    mutableObject->retain();
+    _retainedObjects.emplace_back(mutableObject);
+}
+
+ProgramState* DeferredCommandBuffer::snapshot(ProgramState* programState)
+{
+    if (!programState)
+        return nullptr;
+    if (programState == _lastProgramState)
+        return _lastSnapshot;
+
+    // the uniforms of the callbacks are resolved now, the callbacks belong to the recording thread
+    auto copy = programState->clone();
+    copy->setUniformBufferOwned(false);
+    for (auto&& [location, callback] : programState->getCallbackUniforms())
+        callback(copy, location);
+    _retainedObjects.emplace_back(copy);
+
+    _lastProgramState = programState;
+    _lastSnapshot     = copy;
+    return copy;
+}
+
+void DeferredCommandBuffer::addDraw(const Draw& draw)
+{
+    if (!_stencilReferenceRecorded || _recordedStencilFront != _stencilReferenceValueFront ||
+        _recordedStencilBack != _stencilReferenceValueBack)
+    {
+        _commands.emplace_back(SetStencilReference{_stencilReferenceValueFront, _stencilReferenceValueBack});
+        _stencilReferenceRecorded = true;
+        _recordedStencilFront     = _stencilReferenceValueFront;
+        _recordedStencilBack      = _stencilReferenceValueBack;
+    }
+    _commands.emplace_back(draw);
+
+    // the uniforms may change before the next draw
+    _lastProgramState = nullptr;
+    _lastSnapshot     = nullptr;
+}
+
+void DeferredCommandBuffer::setDepthStencilState(DepthStencilState* depthStencilState)
+{
+    retain(depthStencilState);
+    _commands.emplace_back(SetDepthStencilState{depthStencilState});
+}
+
+void DeferredCommandBuffer::setRenderPipeline(RenderPipeline* renderPipeline)
+{
+    retain(renderPipeline);
+    _commands.emplace_back(SetRenderPipeline{renderPipeline});
+}
+
+void DeferredCommandBuffer::beginRenderPass(const RenderTarget* renderTarget, const RenderPassDescriptor& descriptor)
+{
+    retain(renderTarget);
+    _commands.emplace_back(BeginRenderPass{renderTarget, descriptor});
+}
+
+void DeferredCommandBuffer::updateDepthStencilState(const DepthStencilDescriptor& descriptor)
+{
+    _commands.emplace_back(UpdateDepthStencilState{descriptor});
+}
+
+void DeferredCommandBuffer::updatePipelineState(const RenderTarget* rt, const PipelineDescriptor& descriptor)
+{
+    retain(rt);
+    PipelineDescriptor copy = descriptor;
+    copy.programState       = snapshot(descriptor.programState);
+    _commands.emplace_back(UpdatePipelineState{rt, copy});
+}
+
+void DeferredCommandBuffer::setViewport(int x, int y, unsigned int w, unsigned int h)
+{
+    _commands.emplace_back(SetViewport{x, y, w, h});
+}
+
+void DeferredCommandBuffer::setCullMode(CullMode mode)
+{
+    _commands.emplace_back(SetCullMode{mode});
+}
+
+void DeferredCommandBuffer::setWinding(Winding winding)
+{
+    _commands.emplace_back(SetWinding{winding});
+}
+
+void DeferredCommandBuffer::setVertexBuffer(Buffer* buffer)
+{
+    retain(buffer);
+    _commands.emplace_back(SetBuffer{BufferSlot::VERTEX, buffer});
+}
+
+void DeferredCommandBuffer::setProgramState(ProgramState* programState)
+{
+    _commands.emplace_back(SetProgramState{snapshot(programState)});
+}
+
+void DeferredCommandBuffer::setIndexBuffer(Buffer* buffer)
+{
+    retain(buffer);
+    _commands.emplace_back(SetBuffer{BufferSlot::INDEX, buffer});
+}
+
+void DeferredCommandBuffer::setInstanceBuffer(Buffer* buffer)
+{
+    retain(buffer);
+    _commands.emplace_back(SetBuffer{BufferSlot::INSTANCE, buffer});
+}
+
+void DeferredCommandBuffer::drawArrays(PrimitiveType primitiveType,
+                                       std::size_t start,
+                                       std::size_t count,
+                                       bool wireframe)
+{
+    addDraw(Draw{primitiveType, IndexFormat{}, start, count, 0, false, wireframe});
+}
+
+void DeferredCommandBuffer::drawElements(PrimitiveType primitiveType,
+                                         IndexFormat indexType,
+                                         std::size_t count,
+                                         std::size_t offset,
+                                         bool wireframe)
+{
+    addDraw(Draw{primitiveType, indexType, offset, count, 0, true, wireframe});
+}
+
+void DeferredCommandBuffer::drawElementsInstanced(PrimitiveType primitiveType,
+                                                  IndexFormat indexType,
+                                                  std::size_t count,
+                                                  std::size_t offset,
+                                                  int instanceCount,
+                                                  bool wireframe)
+{
+    addDraw(Draw{primitiveType, indexType, offset, count, instanceCount, true, wireframe});
+}
+
+void DeferredCommandBuffer::endRenderPass()
+{
+    _commands.emplace_back(EndRenderPass{});
+}
+
+void DeferredCommandBuffer::setScissorRect(bool isEnabled, float x, float y, float width, float height)
+{
+    _commands.emplace_back(SetScissorRect{isEnabled, x, y, width, height});
+}
+
+void DeferredCommandBuffer::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    retain(rt);
+    _commands.emplace_back(ReadPixels{rt, std::move(callback)});
+}
+
+void DeferredCommandBuffer::beginGPUTimer(std::string_view label)
+{
+    // an empty label would end the scope
+    _commands.emplace_back(GPUTimer{label.empty() ? std::string{" "} : std::string{label}});
+}
+
+void DeferredCommandBuffer::endGPUTimer()
+{
+    _commands.emplace_back(GPUTimer{});
+}
+
+NS_AX_BACKEND_END
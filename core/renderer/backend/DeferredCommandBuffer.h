@@ -0,0 +1,227 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "DepthStencilState.h"
+#include "renderer/PipelineDescriptor.h"
+
+NS_AX_BACKEND_BEGIN
+
+/**
+ * @addtogroup _backend
+ * @{
+ */
+
+/**
+ * @brief A command buffer which records the commands to replay them later on another command buffer.
+ *
+ * The program states are snapshotted when they are set, with their uniforms and textures, and the buffers and render
+ * targets are retained, so the objects used by a recorded frame can be changed or released once the frame is
+ * recorded. The contents of the buffers and textures aren't copied.
+ * Used by the render thread of the Renderer, see Renderer::setRenderThreadEnabled.
+ */
+class AX_DLL DeferredCommandBuffer : public CommandBuffer
+{
+public:
+    /** @param target The command buffer the recorded commands are replayed on, for the queries of its features. */
+    explicit DeferredCommandBuffer(CommandBuffer* target);
+    ~DeferredCommandBuffer() override;
+
+    /** Replays the recorded commands, between the beginFrame and endFrame of the command buffer. */
+    void execute(CommandBuffer* commandBuffer);
+
+    /** Drops the recorded commands and releases the objects they hold, must be invoked on the recording thread. */
+    void reset();
+
+    size_t getCommandCount() const { return _commands.size(); }
+
+    /** Frames are begun and ended by the command buffer executing them, these don't record anything. */
+    bool beginFrame() override { return true; }
+    void endFrame() override {}
+
+    void setDepthStencilState(DepthStencilState* depthStencilState) override;
+    void setRenderPipeline(RenderPipeline* renderPipeline) override;
+    void beginRenderPass(const RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) override;
+    void updateDepthStencilState(const DepthStencilDescriptor& descriptor) override;
+    void updatePipelineState(const RenderTarget* rt, const PipelineDescriptor& descriptor) override;
+    void setViewport(int x, int y, unsigned int w, unsigned int h) override;
+    void setCullMode(CullMode mode) override;
+    void setWinding(Winding winding) override;
+    void setVertexBuffer(Buffer* buffer) override;
+    void setProgramState(ProgramState* programState) override;
+    void setIndexBuffer(Buffer* buffer) override;
+    void setInstanceBuffer(Buffer* buffer) override;
+    void drawArrays(PrimitiveType primitiveType, std::size_t start, std::size_t count, bool wireframe = false) override;
+    void drawElements(PrimitiveType primitiveType,
+                      IndexFormat indexType,
+                      std::size_t count,
+                      std::size_t offset,
+                      bool wireframe = false) override;
+    void drawElementsInstanced(PrimitiveType primitiveType,
+                               IndexFormat indexType,
+                               std::size_t count,
+                               std::size_t offset,
+                               int instanceCount,
+                               bool wireframe = false) override;
+    void endRenderPass() override;
+    void setScissorRect(bool isEnabled, float x, float y, float width, float height) override;
+    void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
+
+    bool isGPUTimerSupported() const override { return _target->isGPUTimerSupported(); }
+    void beginGPUTimer(std::string_view label) override;
+    void endGPUTimer() override;
+    bool getGPUTimerResults(std::vector<GPUTimerSample>& samples) override
+    {
+        return _target->getGPUTimerResults(samples);
+    }
+
+protected:
+    enum class BufferSlot
+    {
+        VERTEX,
+        INDEX,
+        INSTANCE,
+    };
+
+    struct SetDepthStencilState
+    {
+        DepthStencilState* state;
+    };
+    struct SetRenderPipeline
+    {
+        RenderPipeline* pipeline;
+    };
+    struct BeginRenderPass
+    {
+        const RenderTarget* target;
+        RenderPassDescriptor descriptor;
+    };
+    struct UpdateDepthStencilState
+    {
+        DepthStencilDescriptor descriptor;
+    };
+    struct UpdatePipelineState
+    {
+        const RenderTarget* target;
+        PipelineDescriptor descriptor;
+    };
+    struct SetViewport
+    {
+        int x, y;
+        unsigned int width, height;
+    };
+    struct SetCullMode
+    {
+        CullMode mode;
+    };
+    struct SetWinding
+    {
+        Winding winding;
+    };
+    struct SetBuffer
+    {
+        BufferSlot slot;
+        Buffer* buffer;
+    };
+    struct SetProgramState
+    {
+        ProgramState* programState;
+    };
+    struct SetStencilReference
+    {
+        unsigned int front, back;
+    };
+    struct Draw
+    {
+        PrimitiveType primitiveType;
+        IndexFormat indexType;  // unused by drawArrays
+        std::size_t start;      // the vertex of drawArrays, the byte offset of the index of drawElements
+        std::size_t count;
+        int instanceCount;  // 0 when not instanced
+        bool indexed;
+        bool wireframe;
+    };
+    struct EndRenderPass
+    {};
+    struct SetScissorRect
+    {
+        bool enabled;
+        float x, y, width, height;
+    };
+    struct ReadPixels
+    {
+        RenderTarget* target;
+        std::function<void(const PixelBufferDescriptor&)> callback;
+    };
+    struct GPUTimer
+    {
+        std::string label;  // empty for the end of the scope
+    };
+
+    using Command = std::variant<SetDepthStencilState,
+                                 SetRenderPipeline,
+                                 BeginRenderPass,
+                                 UpdateDepthStencilState,
+                                 UpdatePipelineState,
+                                 SetViewport,
+                                 SetCullMode,
+                                 SetWinding,
+                                 SetBuffer,
+                                 SetProgramState,
+                                 SetStencilReference,
+                                 Draw,
+                                 EndRenderPass,
+                                 SetScissorRect,
+                                 ReadPixels,
+                                 GPUTimer>;
+
+    struct Executor;
+
+    /** A copy of a program state, with the uniforms of its callbacks resolved. */
+    ProgramState* snapshot(ProgramState* programState);
+    void retain(const Object* object);
+    void addDraw(const Draw& draw);
+
+    CommandBuffer* _target = nullptr;
+    std::vector<Command> _commands;
+    std::vector<Object*> _retainedObjects;
+
+    // the renderer sets the program state of a pipeline descriptor right after the pipeline state
+    ProgramState* _lastProgramState = nullptr;
+    ProgramState* _lastSnapshot     = nullptr;
+
+    // the stencil reference isn't set by a virtual, it is recorded with the draws which change it
+    bool _stencilReferenceRecorded     = false;
+    unsigned int _recordedStencilFront = 0;
+    unsigned int _recordedStencilBack  = 0;
+};
+
+// end of _backend group
+/// @}
+NS_AX_BACKEND_END
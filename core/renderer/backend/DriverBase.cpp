@@ -27,6 +27,7 @@
 
 NS_AX_BACKEND_BEGIN
 
-DriverBase* DriverBase::_instance = nullptr;
+DriverBase* DriverBase::_instance   = nullptr;
+bool DriverBase::_nullDriverEnabled = false;
 
 NS_AX_BACKEND_END
@@ -31,6 +31,7 @@
 #include "Texture.h"
 #include "DepthStencilState.h"
 #include "ShaderCache.h"
+#include "PipelineCache.h"
 
 #include "base/Object.h"
 
@@ -84,6 +85,13 @@ public:
     static DriverBase* getInstance();
     static void destroyInstance();
 
+    /**
+     * Makes getInstance create a DriverNull instead of the driver of the platform, nothing is drawn then, e.g. on a
+     * simulation server or a build machine without GPU. It has to be set before the driver is created, see GLViewNull.
+     */
+    static void setNullDriverEnabled(bool enabled) { _nullDriverEnabled = enabled; }
+    static bool isNullDriverEnabled() { return _nullDriverEnabled; }
+
     virtual ~DriverBase() = default;
 
     /**
@@ -103,6 +111,14 @@ public:
      */
     virtual Buffer* newBuffer(size_t size, BufferType type, BufferUsage usage) = 0;
 
+    /**
+     * New a ring Buffer object for data streamed every frame, not auto released. See `Buffer::mapRange`.
+     * @param pageSize Specifies the size in bytes of one page, a mapped region never spans pages.
+     * @param type Specifies the target buffer object.
+     * @return A Buffer object, or nullptr if the driver doesn't support ring buffers.
+     */
+    virtual Buffer* newRingBuffer(size_t /*pageSize*/, BufferType /*type*/) { return nullptr; }
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -145,6 +161,28 @@ public:
      */
     virtual Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) = 0;
 
+    /**
+     * Start compiling the shaders of a program in background threads when the driver supports it.
+     * Invoke it again until it returns true, then `newProgram` won't wait for the compilation.
+     * @return true if `newProgram` can create the program without waiting for background compilation.
+     */
+    virtual bool prepareProgram(std::string_view /*vertexShader*/, std::string_view /*fragmentShader*/)
+    {
+        return true;
+    }
+
+    /**
+     * Get the directory where the linked program binaries are cached, empty when the cache is disabled.
+     * @see `ProgramManager::setProgramBinaryCachePath`
+     */
+    std::string_view getProgramBinaryCachePath() const { return _programBinaryCachePath; }
+
+    /**
+     * Get the pipeline states created by the backend, including the ones recorded by the previous sessions.
+     * @see `ProgramManager::warmupPipelines`
+     */
+    PipelineCache* getPipelineCache() { return &_pipelineCache; }
+
     virtual void resetState() {};
 
     /// below is driver info
@@ -223,8 +261,12 @@ protected:
     int _maxTextureUnits   = 0;  ///< Maximum texture unit.
     int _maxSamplesAllowed = 0;  ///< Maximum sampler count.
 
+    std::string _programBinaryCachePath;  ///< Set by ProgramManager, empty: disabled.
+    PipelineCache _pipelineCache;
+
 private:
     static DriverBase* _instance;
+    static bool _nullDriverEnabled;
 };
 
 // end of _backend group
@@ -71,7 +71,10 @@ enum class VertexFormat : uint32_t
     INT,
     USHORT4,
     USHORT2,
-    UBYTE4
+    UBYTE4,
+    HALF4,
+    HALF2,
+    SHORT4
 };
 /** @typedef backend::PixelFormat
      Possible texture pixel formats
@@ -384,6 +387,33 @@ struct ProgramType
         VIDEO_TEXTURE_I420, // For some android 11 and older devices
         VIDEO_TEXTURE_BGR32,
 
+        POSITION_TEXTURE_COLOR_INSTANCE,      // positionTextureColorInstance_vert, positionTextureColor_frag
+        POSITION_TEXTURE_COLOR_3D_INSTANCE,   // positionTextureColorInstance3D_vert, positionTextureColor_frag
+        POSITION_NORMAL_TEXTURE_3D_INSTANCE,  // positionNormalTextureInstance_vert, colorNormalTexture_frag
+        SKINPOSITION_TEXTURE_3D_PALETTE,      // skinPositionTexturePalette_vert, colorTexture_frag
+        SKINPOSITION_NORMAL_TEXTURE_3D_PALETTE, // skinPositionNormalTexturePalette_vert, colorNormalTexture_frag
+        SKINPOSITION_BUMPEDNORMAL_TEXTURE_3D_PALETTE, // skinPositionNormalTexturePalette_vert, colorNormalTexture_frag
+        TERRAIN_3D_PAGED,                     // terrainPaged_vert,               terrain_frag
+        POSITION_NORMAL_TEXTURE_3D_CLUSTERED, // positionNormalTextureClustered_vert, colorNormalTextureClustered_frag
+        SHADOW_DEPTH_3D,                      // position_vert,                   shadowDepth_frag
+        SHADOW_DEPTH_SKIN_3D,                 // skinPositionTexture_vert,        shadowDepth_frag
+        PARTICLE_GPU,                         // particleGPU_vert,                positionTextureColor_frag
+        DRAW_NODE_SHAPE,                      // drawNodeShape_vert,              drawNodeShape_frag
+        LABEL_MSDF_NORMAL,                    // positionTextureColor_vert,       label_msdfNormal_frag
+        LABEL_MSDF_OUTLINE,                   // positionTextureColor_vert,       label_msdfOutline_frag
+        LABEL_MSDF_GLOW,                      // positionTextureColor_vert,       label_msdfGlow_frag
+        UPSCALE_SHARPEN,                      // positionTextureColor_vert,       upscaleSharpen_frag
+        POSITION_TEXTURE_COLOR_MASK,          // positionTextureColorMask_vert,   positionTextureColorMask_frag
+        POST_PROCESS_COLOR,                   // positionTextureColor_vert,       postProcessColor_frag
+        POST_PROCESS_THRESHOLD,               // positionTextureColor_vert,       postProcessThreshold_frag
+        POST_PROCESS_BLUR,                    // positionTextureColor_vert,       postProcessBlur_frag
+        POSITION_TEXTURE_COLOR_BILLBOARD_INSTANCE, // billboardInstance_vert,     positionTextureColor_frag
+        DEPTH_PREPASS_3D,                     // depthPrePass_vert,               shadowDepth_frag
+        MOTION_STREAK,                        // motionStreak_vert,               positionTextureColor_frag
+        GRID_EFFECT,                          // gridEffect_vert,                 positionTexture_frag
+        TILED_GRID_EFFECT,                    // tiledGridEffect_vert,            positionTexture_frag
+        PROGRESS_INSTANCE,                    // progressInstance_vert,           progressInstance_frag
+
         BUILTIN_COUNT,
 
         VIDEO_TEXTURE_RGB32 = POSITION_TEXTURE_COLOR,
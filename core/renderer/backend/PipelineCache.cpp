@@ -0,0 +1,299 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "PipelineCache.h"
+#include "platform/FileUtils.h"
+#include "base/Logging.h"
+
+#include "xxhash.h"
+#include <string.h>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+constexpr uint32_t PIPELINE_CACHE_MAGIC   = 0x53505841;  // AXPS
+constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+constexpr size_t MAX_HASHED_ATTRIBS = 32;
+
+struct PipelineCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+};
+
+template <typename T>
+void writeValue(std::string& out, T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+struct StateReader
+{
+    const uint8_t* ptr;
+    const uint8_t* end;
+
+    template <typename T>
+    bool read(T& value)
+    {
+        if (end - ptr < (ptrdiff_t)sizeof(T))
+            return false;
+        memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string& value, size_t size)
+    {
+        if (end - ptr < (ptrdiff_t)size)
+            return false;
+        value.assign(reinterpret_cast<const char*>(ptr), size);
+        ptr += size;
+        return true;
+    }
+
+    bool readState(PipelineStateDesc& desc)
+    {
+        uint16_t formats[MAX_COLOR_ATTCHMENT + 2];
+        uint8_t blend[8];
+        uint32_t stride;
+        uint8_t attribCount;
+        if (!read(desc.programId) || !read(formats) || !read(blend) || !read(stride) || !read(attribCount))
+            return false;
+
+        for (int i = 0; i < MAX_COLOR_ATTCHMENT; ++i)
+            desc.colorAttachments[i] = static_cast<PixelFormat>(formats[i]);
+        desc.depthAttachment   = static_cast<PixelFormat>(formats[MAX_COLOR_ATTCHMENT]);
+        desc.stencilAttachment = static_cast<PixelFormat>(formats[MAX_COLOR_ATTCHMENT + 1]);
+
+        auto& blendDescriptor                       = desc.blendDescriptor;
+        blendDescriptor.blendEnabled                = blend[0] != 0;
+        blendDescriptor.writeMask                   = static_cast<ColorWriteMask>(blend[1]);
+        blendDescriptor.rgbBlendOperation           = static_cast<BlendOperation>(blend[2]);
+        blendDescriptor.alphaBlendOperation         = static_cast<BlendOperation>(blend[3]);
+        blendDescriptor.sourceRGBBlendFactor        = static_cast<BlendFactor>(blend[4]);
+        blendDescriptor.destinationRGBBlendFactor   = static_cast<BlendFactor>(blend[5]);
+        blendDescriptor.sourceAlphaBlendFactor      = static_cast<BlendFactor>(blend[6]);
+        blendDescriptor.destinationAlphaBlendFactor = static_cast<BlendFactor>(blend[7]);
+
+        desc.vertexLayout = VertexLayout{};
+        desc.vertexLayout.setStride(stride);
+        for (uint8_t i = 0; i < attribCount; ++i)
+        {
+            uint8_t index, format, normalized, nameLength;
+            uint16_t offset;
+            std::string name;
+            if (!read(index) || !read(format) || !read(offset) || !read(normalized) || !read(nameLength) ||
+                !read(name, nameLength))
+                return false;
+            desc.vertexLayout.setAttrib(name, index, static_cast<VertexFormat>(format), offset, normalized != 0);
+        }
+        return true;
+    }
+};
+}  // namespace
+
+uint64_t PipelineCache::computeKey(uint64_t programId,
+                                   const VertexLayout& vertexLayout,
+                                   const PixelFormat colorAttachments[MAX_COLOR_ATTCHMENT],
+                                   PixelFormat depthAttachment,
+                                   PixelFormat stencilAttachment,
+                                   const BlendDescriptor& blendDescriptor)
+{
+    struct
+    {
+        uint64_t programId;
+        uint32_t vertexLayoutInfo[MAX_HASHED_ATTRIBS];
+        uint32_t colorAttachments[MAX_COLOR_ATTCHMENT];
+        uint32_t depthAttachment;
+        uint32_t stencilAttachment;
+        uint32_t blendInfo;
+    } hashMe;
+
+    memset(&hashMe, 0, sizeof(hashMe));
+    hashMe.programId = programId;
+
+    /*
+     stepFunction:1     stride:15       offest:10       format:5        needNormalized:1
+     bit31           bit30 ~ bit16   bit15 ~ bit6    bit5 ~ bit1     bit0
+     */
+    const uint32_t layoutInfo = ((uint32_t)vertexLayout.getVertexStepMode() & 0x1) << 31 |
+                                ((uint32_t)vertexLayout.getStride() & 0x7FFF) << 16;
+    for (const auto& it : vertexLayout.getAttributes())
+    {
+        auto& attribute = it.second;
+        assert(attribute.index < MAX_HASHED_ATTRIBS);
+        hashMe.vertexLayoutInfo[attribute.index & (MAX_HASHED_ATTRIBS - 1)] =
+            layoutInfo | ((uint32_t)attribute.offset & 0x3FF) << 6 | ((uint32_t)attribute.format & 0x1F) << 1 |
+            ((uint32_t)attribute.needToBeNormallized & 0x1);
+    }
+
+    for (int i = 0; i < MAX_COLOR_ATTCHMENT; ++i)
+        hashMe.colorAttachments[i] = (uint32_t)colorAttachments[i];
+    hashMe.depthAttachment   = (uint32_t)depthAttachment;
+    hashMe.stencilAttachment = (uint32_t)stencilAttachment;
+
+    /*
+     blendEnabled:1  writeMask:4  rgbOp:2  alphaOp:2  srcRGB:4  dstRGB:4  srcAlpha:4  dstAlpha:4
+     */
+    hashMe.blendInfo = (uint32_t)blendDescriptor.blendEnabled << 24 |
+                       ((uint32_t)blendDescriptor.writeMask & 0xF) << 20 |
+                       ((uint32_t)blendDescriptor.rgbBlendOperation & 0x3) << 18 |
+                       ((uint32_t)blendDescriptor.alphaBlendOperation & 0x3) << 16 |
+                       ((uint32_t)blendDescriptor.sourceRGBBlendFactor & 0xF) << 12 |
+                       ((uint32_t)blendDescriptor.destinationRGBBlendFactor & 0xF) << 8 |
+                       ((uint32_t)blendDescriptor.sourceAlphaBlendFactor & 0xF) << 4 |
+                       ((uint32_t)blendDescriptor.destinationAlphaBlendFactor & 0xF);
+
+    return XXH3_64bits(&hashMe, sizeof(hashMe));
+}
+
+uint64_t PipelineCache::computeKey(const PipelineStateDesc& desc)
+{
+    return computeKey(desc.programId, desc.vertexLayout, desc.colorAttachments, desc.depthAttachment,
+                      desc.stencilAttachment, desc.blendDescriptor);
+}
+
+void PipelineCache::setFilePath(std::string_view path)
+{
+    _states.clear();
+    _keys.clear();
+    _filePath  = path;
+    _fileValid = false;
+    if (_filePath.empty())
+        return;
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(_filePath))
+        return;
+
+    auto data  = fileUtils->getDataFromFile(_filePath);
+    _fileValid = deserialize(data.getBytes(), data.getSize());
+    if (!_fileValid)
+        AXLOGW("PipelineCache: ignoring the invalid file {}", _filePath);
+}
+
+bool PipelineCache::record(uint64_t key, const PipelineStateDesc& desc)
+{
+    if (!_keys.insert(key).second)
+        return false;
+    _states.push_back(desc);
+
+    if (_filePath.empty())
+        return true;
+
+    // the file is an append log, a state is persisted as soon as it's created since apps are often killed
+    auto fileUtils = FileUtils::getInstance();
+    if (_fileValid)
+    {
+        std::string data;
+        serializeState(desc, data);
+        auto stream = fileUtils->openFileStream(_filePath, IFileStream::Mode::APPEND);
+        _fileValid  = stream && stream->write(data.data(), static_cast<unsigned int>(data.size())) == (int)data.size();
+    }
+    else
+    {
+        auto slash = _filePath.find_last_of('/');
+        if (slash != std::string::npos)
+            fileUtils->createDirectories(std::string_view{_filePath}.substr(0, slash + 1));
+        _fileValid = fileUtils->writeStringToFile(serialize(), _filePath);
+    }
+    return true;
+}
+
+void PipelineCache::clear()
+{
+    _states.clear();
+    _keys.clear();
+    _fileValid = false;
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!_filePath.empty() && fileUtils->isFileExist(_filePath))
+        fileUtils->removeFile(_filePath);
+}
+
+std::string PipelineCache::serialize() const
+{
+    std::string data;
+    writeValue(data, PipelineCacheHeader{PIPELINE_CACHE_MAGIC, PIPELINE_CACHE_VERSION});
+    for (auto& desc : _states)
+        serializeState(desc, data);
+    return data;
+}
+
+bool PipelineCache::deserialize(const void* data, size_t size)
+{
+    _states.clear();
+    _keys.clear();
+
+    StateReader reader{static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size};
+    PipelineCacheHeader header;
+    if (!data || !reader.read(header) || header.magic != PIPELINE_CACHE_MAGIC ||
+        header.version != PIPELINE_CACHE_VERSION)
+        return false;
+
+    PipelineStateDesc desc;
+    while (reader.ptr < reader.end && reader.readState(desc))
+    {
+        if (_keys.insert(computeKey(desc)).second)
+            _states.push_back(desc);
+    }
+    return true;
+}
+
+void PipelineCache::serializeState(const PipelineStateDesc& desc, std::string& out)
+{
+    writeValue(out, desc.programId);
+    for (int i = 0; i < MAX_COLOR_ATTCHMENT; ++i)
+        writeValue(out, static_cast<uint16_t>(desc.colorAttachments[i]));
+    writeValue(out, static_cast<uint16_t>(desc.depthAttachment));
+    writeValue(out, static_cast<uint16_t>(desc.stencilAttachment));
+
+    auto& blendDescriptor = desc.blendDescriptor;
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.blendEnabled));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.writeMask));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.rgbBlendOperation));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.alphaBlendOperation));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.sourceRGBBlendFactor));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.destinationRGBBlendFactor));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.sourceAlphaBlendFactor));
+    writeValue(out, static_cast<uint8_t>(blendDescriptor.destinationAlphaBlendFactor));
+
+    auto& vertexLayout = desc.vertexLayout;
+    auto& attributes   = vertexLayout.getAttributes();
+    writeValue(out, static_cast<uint32_t>(vertexLayout.getStride()));
+    writeValue(out, static_cast<uint8_t>(attributes.size()));
+    for (const auto& it : attributes)
+    {
+        auto& attribute = it.second;
+        writeValue(out, static_cast<uint8_t>(attribute.index));
+        writeValue(out, static_cast<uint8_t>(attribute.format));
+        writeValue(out, static_cast<uint16_t>(attribute.offset));
+        writeValue(out, static_cast<uint8_t>(attribute.needToBeNormallized));
+        writeValue(out, static_cast<uint8_t>(attribute.name.size()));
+        out.append(attribute.name);
+    }
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "Macros.h"
+#include "Types.h"
+#include "VertexLayout.h"
+#include "platform/PlatformMacros.h"
+
+#include <string>
+#include <vector>
+#include "tsl/robin_set.h"
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _backend
+ * @{
+ */
+
+/**
+ * The state baked into a pipeline state object, enough to create it again in a later session.
+ */
+struct AX_DLL PipelineStateDesc
+{
+    uint64_t programId = 0;  ///< the id of a builtin or registered program, see ProgramManager::loadProgram
+    VertexLayout vertexLayout;
+    PixelFormat colorAttachments[MAX_COLOR_ATTCHMENT] = {PixelFormat::NONE, PixelFormat::NONE, PixelFormat::NONE,
+                                                         PixelFormat::NONE};
+    PixelFormat depthAttachment   = PixelFormat::NONE;
+    PixelFormat stencilAttachment = PixelFormat::NONE;
+    BlendDescriptor blendDescriptor;
+};
+
+/**
+ * Records the pipeline state objects created by the backends, which compile them on creation, keyed by a 64 bit
+ * hash of their state. The states are appended to a file of the program binary cache directory, so that the next
+ * sessions can create them ahead of their first use with ProgramManager::warmupPipelines.
+ */
+class AX_DLL PipelineCache
+{
+public:
+    /** The key of a pipeline state, the vertex attributes are hashed by index so their order doesn't matter. */
+    static uint64_t computeKey(uint64_t programId,
+                               const VertexLayout& vertexLayout,
+                               const PixelFormat colorAttachments[MAX_COLOR_ATTCHMENT],
+                               PixelFormat depthAttachment,
+                               PixelFormat stencilAttachment,
+                               const BlendDescriptor& blendDescriptor);
+    static uint64_t computeKey(const PipelineStateDesc& desc);
+
+    /**
+     * Set the file the states are recorded to, the states recorded by the previous sessions are loaded from it.
+     * @param path the file path, empty: the states aren't persisted.
+     */
+    void setFilePath(std::string_view path);
+    const std::string& getFilePath() const { return _filePath; }
+
+    /**
+     * Record a pipeline state created for the first time, nothing is done if it is known already.
+     * @return whether the state is new.
+     */
+    bool record(uint64_t key, const PipelineStateDesc& desc);
+    bool contains(uint64_t key) const { return _keys.find(key) != _keys.end(); }
+
+    /** The recorded states, in creation order. */
+    const std::vector<PipelineStateDesc>& getStates() const { return _states; }
+
+    /** Forget the recorded states and remove the file. */
+    void clear();
+
+    /** The states in the format of the file. */
+    std::string serialize() const;
+
+    /**
+     * Replace the states with the serialized ones, a truncated trailing state is dropped.
+     * @return false if the data isn't serialized states.
+     */
+    bool deserialize(const void* data, size_t size);
+
+private:
+    static void serializeState(const PipelineStateDesc& desc, std::string& out);
+
+    std::vector<PipelineStateDesc> _states;
+    tsl::robin_set<uint64_t> _keys;
+    std::string _filePath;
+    bool _fileValid = false;  ///< whether the file holds the states, so new ones can be appended
+};
+
+// end of _backend group
+/// @}
+NS_AX_BACKEND_END
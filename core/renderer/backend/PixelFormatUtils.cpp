@@ -25,6 +25,7 @@
 
 #include "PixelFormatUtils.h"
 #include "Macros.h"
+#include "platform/Image.h"  // AX_RGB_PREMULTIPLY_ALPHA
 
 namespace ax
 {
@@ -117,6 +118,31 @@ uint32_t computeRowPitch(PixelFormat format, uint32_t width)
 //////////////////////////////////////////////////////////////////////////
 // convertor function
 
+// the RGBA8 kernels convert the bulk of the pixels with SSE2 or NEON, the remainders with the scalar code
+#if defined(AX_SSE_INTRINSICS)
+#    define AX_PIXEL_SSE 1
+#elif defined(AX_NEON_INTRINSICS) && (AX_64BITS || AX_NEON_INTRINSICS > 1)
+#    define AX_PIXEL_NEON 1
+#endif
+
+#if defined(AX_PIXEL_SSE)
+// packs the low 16 bits of the 32 bits lanes, SSE2 has only the signed saturating pack
+static inline __m128i packLow16(__m128i v0, __m128i v1)
+{
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(v0, 16), 16), _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16));
+}
+
+template <int _Mask, int _Shift>
+static inline __m128i maskShift(__m128i v)
+{
+    v = _mm_and_si128(v, _mm_set1_epi32(_Mask));
+    if constexpr (_Shift >= 0)
+        return _mm_slli_epi32(v, _Shift);
+    else
+        return _mm_srli_epi32(v, -_Shift);
+}
+#endif
+
 // IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBB
 static void convertR8ToRGB8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
@@ -250,7 +276,20 @@ static void convertRG8ToR8(const unsigned char* data, size_t dataLen, unsigned c
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 static void convertRGB8ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 47; i < l; i += 48, outData += 64)
+    {
+        uint8x16x3_t rgb = vld3q_u8(data + i);
+        uint8x16x4_t px;
+        px.val[0] = rgb.val[0];
+        px.val[1] = rgb.val[1];
+        px.val[2] = rgb.val[2];
+        px.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(outData, px);
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *outData++ = data[i];      // R
         *outData++ = data[i + 1];  // G
@@ -262,7 +301,19 @@ static void convertRGB8ToRGBA8(const unsigned char* data, size_t dataLen, unsign
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
 static void convertRGBA8ToRGB8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 48)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16x3_t rgb;
+        rgb.val[0] = px.val[0];
+        rgb.val[1] = px.val[1];
+        rgb.val[2] = px.val[2];
+        vst3q_u8(outData, rgb);
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = data[i];      // R
         *outData++ = data[i + 1];  // G
@@ -286,7 +337,33 @@ static void convertRGB8ToRGB565(const unsigned char* data, size_t dataLen, unsig
 static void convertRGBA8ToRGB565(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i             = 0;
+#if defined(AX_PIXEL_SSE)
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i v[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)(data + i + k * 16));
+            v[k]      = _mm_or_si128(_mm_or_si128(maskShift<0xF8, 8>(p), maskShift<0xFC00, -5>(p)),
+                                     maskShift<0xF80000, -19>(p));
+        }
+        _mm_storeu_si128((__m128i*)out16, packLow16(v[0], v[1]));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16_t r    = vandq_u8(px.val[0], vdupq_n_u8(0xF8));
+        uint8x16_t g    = vandq_u8(px.val[1], vdupq_n_u8(0xFC));
+        uint8x16_t b    = vshrq_n_u8(px.val[2], 3);
+        vst1q_u16(out16, vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(r), 8), vshll_n_u8(vget_low_u8(g), 3)),
+                                   vmovl_u8(vget_low_u8(b))));
+        vst1q_u16(out16 + 8, vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(r), 8), vshll_n_u8(vget_high_u8(g), 3)),
+                                       vmovl_u8(vget_high_u8(b))));
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8         // R
                    | (data[i + 1] & 0x00FC) << 3   // G
@@ -306,7 +383,22 @@ static void convertRGB8ToR8(const unsigned char* data, size_t dataLen, unsigned
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA
 static void convertRGBA8ToR8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if defined(AX_PIXEL_SSE)
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+    {
+        __m128i v[4];
+        for (int k = 0; k < 4; ++k)
+            v[k] = _mm_and_si128(_mm_loadu_si128((const __m128i*)(data + i + k * 16)), mask);
+        _mm_storeu_si128((__m128i*)outData,
+                         _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+        vst1q_u8(outData, vld4q_u8(data + i).val[0]);
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = data[i];  // A
     }
@@ -325,7 +417,25 @@ static void convertRGB8ToRG8(const unsigned char* data, size_t dataLen, unsigned
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIIIAAAAAAAA
 static void convertRGBA8ToRG8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if defined(AX_PIXEL_SSE)
+    for (ssize_t l = dataLen - 31; i < l; i += 32, outData += 16)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        _mm_storeu_si128((__m128i*)outData, packLow16(v0, v1));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 32)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16x2_t rg;
+        rg.val[0] = px.val[0];
+        rg.val[1] = px.val[1];
+        vst2q_u8(outData, rg);
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = data[i];
         *outData++ = data[i + 1];
@@ -349,7 +459,34 @@ static void convertRGB8ToRGBA4(const unsigned char* data, size_t dataLen, unsign
 static void convertRGBA8ToRGBA4(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i             = 0;
+#if defined(AX_PIXEL_SSE)
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i v[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)(data + i + k * 16));
+            v[k]      = _mm_or_si128(_mm_or_si128(maskShift<0xF0, 8>(p), maskShift<0xF000, -4>(p)),
+                                     _mm_or_si128(maskShift<0xF00000, -16>(p), _mm_srli_epi32(p, 28)));
+        }
+        _mm_storeu_si128((__m128i*)out16, packLow16(v[0], v[1]));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16_t r    = vandq_u8(px.val[0], vdupq_n_u8(0xF0));
+        uint8x16_t g    = vandq_u8(px.val[1], vdupq_n_u8(0xF0));
+        // BBBBAAAA
+        uint8x16_t ba = vorrq_u8(vandq_u8(px.val[2], vdupq_n_u8(0xF0)), vshrq_n_u8(px.val[3], 4));
+        vst1q_u16(out16, vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(r), 8), vshll_n_u8(vget_low_u8(g), 4)),
+                                   vmovl_u8(vget_low_u8(ba))));
+        vst1q_u16(out16 + 8, vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(r), 8), vshll_n_u8(vget_high_u8(g), 4)),
+                                       vmovl_u8(vget_high_u8(ba))));
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F0) << 8        // R
                    | (data[i + 1] & 0x00F0) << 4  // G
@@ -375,7 +512,34 @@ static void convertRGB8ToRGB5A1(const unsigned char* data, size_t dataLen, unsig
 static void convertRGBA8ToRGB5A1(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
+    ssize_t i             = 0;
+#if defined(AX_PIXEL_SSE)
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i v[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)(data + i + k * 16));
+            v[k]      = _mm_or_si128(_mm_or_si128(maskShift<0xF8, 8>(p), maskShift<0xF800, -5>(p)),
+                                     _mm_or_si128(maskShift<0xF80000, -18>(p), _mm_srli_epi32(p, 31)));
+        }
+        _mm_storeu_si128((__m128i*)out16, packLow16(v[0], v[1]));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16_t r    = vandq_u8(px.val[0], vdupq_n_u8(0xF8));
+        uint8x16_t g    = vandq_u8(px.val[1], vdupq_n_u8(0xF8));
+        // 00BBBBBA
+        uint8x16_t ba = vorrq_u8(vshlq_n_u8(vshrq_n_u8(px.val[2], 3), 1), vshrq_n_u8(px.val[3], 7));
+        vst1q_u16(out16, vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(r), 8), vshll_n_u8(vget_low_u8(g), 3)),
+                                   vmovl_u8(vget_low_u8(ba))));
+        vst1q_u16(out16 + 8, vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(r), 8), vshll_n_u8(vget_high_u8(g), 3)),
+                                       vmovl_u8(vget_high_u8(ba))));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8         // R
                    | (data[i + 1] & 0x00F8) << 3   // G
@@ -862,6 +1026,50 @@ ax::backend::PixelFormat convertDataToFormat(const unsigned char* data,
         return originFormat;
     }
 }
+
+void premultiplyAlpha(unsigned char* data, size_t dataLen)
+{
+    ssize_t i = 0;
+#if defined(AX_PIXEL_SSE)
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i one       = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+    for (ssize_t l = dataLen - 15; i < l; i += 16)
+    {
+        __m128i p  = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i lo = _mm_unpacklo_epi8(p, zero);
+        __m128i hi = _mm_unpackhi_epi8(p, zero);
+        // c * (a + 1) >> 8, like AX_RGB_PREMULTIPLY_ALPHA
+        __m128i alo = _mm_add_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF), one);
+        __m128i ahi = _mm_add_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF), one);
+        lo          = _mm_srli_epi16(_mm_mullo_epi16(lo, alo), 8);
+        hi          = _mm_srli_epi16(_mm_mullo_epi16(hi, ahi), 8);
+        __m128i rgb = _mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi));
+        _mm_storeu_si128((__m128i*)(data + i), _mm_or_si128(rgb, _mm_and_si128(p, alphaMask)));
+    }
+#elif defined(AX_PIXEL_NEON)
+    for (ssize_t l = dataLen - 63; i < l; i += 64)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x8_t alo   = vget_low_u8(px.val[3]);
+        uint8x8_t ahi   = vget_high_u8(px.val[3]);
+        for (int c = 0; c < 3; ++c)
+        {
+            // c * a + c == c * (a + 1), at most 0xFF00
+            uint8x8_t clo = vget_low_u8(px.val[c]);
+            uint8x8_t chi = vget_high_u8(px.val[c]);
+            px.val[c]     = vcombine_u8(vshrn_n_u16(vaddw_u8(vmull_u8(clo, alo), clo), 8),
+                                        vshrn_n_u16(vaddw_u8(vmull_u8(chi, ahi), chi), 8));
+        }
+        vst4q_u8(data + i, px);
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        unsigned char* p  = data + i;
+        *(unsigned int*)p = AX_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
+    }
+}
 }  // namespace PixelFormatUtils
 }  // namespace backend
 
@@ -73,6 +73,9 @@ PixelFormat convertDataToFormat(const unsigned char* data,
                                 PixelFormat format,
                                 unsigned char** outData,
                                 size_t* outDataLen);
+
+/** Premultiply the RGBA8 pixels by their alpha in place, the results match AX_RGB_PREMULTIPLY_ALPHA. */
+void premultiplyAlpha(unsigned char* data, size_t dataLen);
 };  // namespace PixelFormatUtils
 }  // namespace backend
 }
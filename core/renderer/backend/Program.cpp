@@ -88,6 +88,32 @@ struct VertexLayoutHelper
         vertexLayout->setStride(sizeof(V2F_C4B_T2F));
     }
 
+    static void setupDrawNodeShape(Program* program)
+    {
+        auto vertexLayout = program->getVertexLayout();
+
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_POSITION,
+                                program->getAttributeLocation(backend::Attribute::POSITION),
+                                backend::VertexFormat::FLOAT2, 0, false);
+
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXCOORD,
+                                program->getAttributeLocation(backend::Attribute::TEXCOORD),
+                                backend::VertexFormat::FLOAT2, offsetof(V2F_C4B_T2F_T4F_C4B, texCoords), false);
+
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_COLOR, program->getAttributeLocation(backend::Attribute::COLOR),
+                                backend::VertexFormat::UBYTE4, offsetof(V2F_C4B_T2F_T4F_C4B, colors), true);
+
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXCOORD1,
+                                program->getAttributeLocation(backend::Attribute::TEXCOORD1),
+                                backend::VertexFormat::FLOAT4, offsetof(V2F_C4B_T2F_T4F_C4B, params), false);
+
+        vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXCOORD2,
+                                program->getAttributeLocation(backend::Attribute::TEXCOORD2),
+                                backend::VertexFormat::UBYTE4, offsetof(V2F_C4B_T2F_T4F_C4B, borderColors), true);
+
+        vertexLayout->setStride(sizeof(V2F_C4B_T2F_T4F_C4B));
+    }
+
     static void setupDrawNode3D(Program* program)
     {
         auto vertexLayout = program->getVertexLayout();
@@ -168,7 +194,7 @@ std::function<void(Program*)> Program::s_vertexLayoutSetupList[static_cast<int>(
     VertexLayoutHelper::setupDummy,    VertexLayoutHelper::setupPos,      VertexLayoutHelper::setupTexture,
     VertexLayoutHelper::setupSprite,   VertexLayoutHelper::setupDrawNode, VertexLayoutHelper::setupDrawNode3D,
     VertexLayoutHelper::setupSkyBox,   VertexLayoutHelper::setupPU3D,     VertexLayoutHelper::setupPosColor,
-    VertexLayoutHelper::setupTerrain3D};
+    VertexLayoutHelper::setupTerrain3D, VertexLayoutHelper::setupDrawNodeShape};
 
 Program::Program(std::string_view vs, std::string_view fs)
     : _vertexShader(vs), _fragmentShader(fs), _vertexLayout(new VertexLayout())
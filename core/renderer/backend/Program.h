@@ -58,6 +58,7 @@ enum class VertexLayoutType
     PU3D,        // V3F_C4B_T2F // same with sprite, TODO: reuse spriete
     posColor,    // V3F_C4B
     Terrain3D,   // V3F_T2F_V3F
+    DrawNodeShape, // V2F_C4B_T2F_T4F_C4B
     Count
 };
 
@@ -29,12 +29,20 @@
 #include "renderer/Shaders.h"
 #include "base/Macros.h"
 #include "base/Configuration.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
+#include "renderer/Renderer.h"
+#include "renderer/backend/RenderPipeline.h"
 
 #include "xxhash.h"
 #include <inttypes.h>
+#include <chrono>
+#include <algorithm>
 
 NS_AX_BACKEND_BEGIN
 
+static const std::string_view PROGRAM_WARMUP_KEY = "axmol.programManager.warmup"sv;
+
 ProgramManager* ProgramManager::_sharedProgramManager = nullptr;
 
 ProgramManager* ProgramManager::getInstance()
@@ -62,6 +70,8 @@ ProgramManager::ProgramManager()
 
 ProgramManager::~ProgramManager()
 {
+    if (!_warmupTasks.empty())
+        Director::getInstance()->getScheduler()->unschedule(PROGRAM_WARMUP_KEY, this);
     XXH64_freeState(_programIdGen);
 
     for (auto&& program : _cachedPrograms)
@@ -93,6 +103,8 @@ bool ProgramManager::init()
     fileUtils->addSearchPath("axslc"sv);
 #endif
 
+    setProgramBinaryCachePath(joinPath(fileUtils->getWritablePath(), "programs/"sv));
+
     registerProgram(ProgramType::POSITION_TEXTURE_COLOR, positionTextureColor_vert, positionTextureColor_frag,
                     VertexLayoutType::Sprite);
     registerProgram(ProgramType::DUAL_SAMPLER, positionTextureColor_vert, dualSampler_frag, VertexLayoutType::Sprite);
@@ -155,6 +167,56 @@ bool ProgramManager::init()
     registerProgram(ProgramType::VIDEO_TEXTURE_I420, positionTextureColor_vert, videoTextureI420_frag,
                     VertexLayoutType::Sprite);
 
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_INSTANCE, positionTextureColorInstance_vert,
+                    positionTextureColor_frag, VertexLayoutType::Pos);
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_3D_INSTANCE, positionTextureColorInstance3D_vert,
+                    positionTextureColor_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::POSITION_NORMAL_TEXTURE_3D_INSTANCE, positionNormalTextureInstance_vert,
+                    colorNormalTexture_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::SKINPOSITION_TEXTURE_3D_PALETTE, skinPositionTexturePalette_vert, colorTexture_frag,
+                    VertexLayoutType::Unspec);
+    registerProgram(ProgramType::SKINPOSITION_NORMAL_TEXTURE_3D_PALETTE, skinPositionNormalTexturePalette_vert,
+                    colorNormalTexture_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::SKINPOSITION_BUMPEDNORMAL_TEXTURE_3D_PALETTE, skinPositionNormalTexturePalette_vert_1,
+                    colorNormalTexture_frag_1, VertexLayoutType::Unspec);
+    // the paged terrain grid only has positions
+    registerProgram(ProgramType::TERRAIN_3D_PAGED, terrainPaged_vert, terrain_frag, VertexLayoutType::SkyBox);
+    registerProgram(ProgramType::POSITION_NORMAL_TEXTURE_3D_CLUSTERED, positionNormalTextureClustered_vert,
+                    colorNormalTextureClustered_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::SHADOW_DEPTH_3D, position_vert, shadowDepth_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::SHADOW_DEPTH_SKIN_3D, skinPositionTexture_vert, shadowDepth_frag,
+                    VertexLayoutType::Unspec);
+    registerProgram(ProgramType::PARTICLE_GPU, particleGPU_vert, positionTextureColor_frag, VertexLayoutType::Pos);
+    registerProgram(ProgramType::DRAW_NODE_SHAPE, drawNodeShape_vert, drawNodeShape_frag,
+                    VertexLayoutType::DrawNodeShape);
+    registerProgram(ProgramType::LABEL_MSDF_NORMAL, positionTextureColor_vert, label_msdfNormal_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::LABEL_MSDF_OUTLINE, positionTextureColor_vert, label_msdfOutline_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::LABEL_MSDF_GLOW, positionTextureColor_vert, label_msdfGlow_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::UPSCALE_SHARPEN, positionTextureColor_vert, upscaleSharpen_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_MASK, positionTextureColorMask_vert,
+                    positionTextureColorMask_frag, VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POST_PROCESS_COLOR, positionTextureColor_vert, postProcessColor_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POST_PROCESS_THRESHOLD, positionTextureColor_vert, postProcessThreshold_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POST_PROCESS_BLUR, positionTextureColor_vert, postProcessBlur_frag,
+                    VertexLayoutType::Sprite);
+    registerProgram(ProgramType::POSITION_TEXTURE_COLOR_BILLBOARD_INSTANCE, billboardInstance_vert,
+                    positionTextureColor_frag, VertexLayoutType::Pos);
+    // the color writes of the depth pre-pass are masked, any fragment shader does
+    registerProgram(ProgramType::DEPTH_PREPASS_3D, depthPrePass_vert, shadowDepth_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::MOTION_STREAK, motionStreak_vert, positionTextureColor_frag, VertexLayoutType::Unspec);
+    // the layouts of the grid vertices are set by the grids
+    registerProgram(ProgramType::GRID_EFFECT, gridEffect_vert, positionTexture_frag, VertexLayoutType::Unspec);
+    registerProgram(ProgramType::TILED_GRID_EFFECT, tiledGridEffect_vert, positionTexture_frag,
+                    VertexLayoutType::Unspec);
+    registerProgram(ProgramType::PROGRESS_INSTANCE, progressInstance_vert, progressInstance_frag,
+                    VertexLayoutType::Pos);
+
     // The builtin dual sampler shader registry
     ProgramStateRegistry::getInstance()->registerProgram(ProgramType::POSITION_TEXTURE_COLOR,
                                                          TextureSamplerFlag::DUAL_SAMPLER, ProgramType::DUAL_SAMPLER);
@@ -210,10 +272,24 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     auto fragFile   = fileUtils->fullPathForFilename(fsName);
     auto vertSource = fileUtils->getStringFromFile(vertFile);
     auto fragSource = fileUtils->getStringFromFile(fragFile);
-    auto program    = backend::DriverBase::getInstance()->newProgram(vertSource, fragSource);
+    return createProgram(vertSource, fragSource, progType, progId, vlt);
+}
+
+Program* ProgramManager::createProgram(std::string_view vertSource,
+                                       std::string_view fragSource,
+                                       uint32_t progType,
+                                       uint64_t progId,
+                                       VertexLayoutType vlt)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    auto program         = backend::DriverBase::getInstance()->newProgram(vertSource, fragSource);
 
     if (program)
     {
+        const auto loadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime);
+        _programLoadTimes.emplace_back(ProgramLoadTime{progId, loadTime.count()});
+        AXLOGD("Created program {} in {:.2f} ms", progId, loadTime.count());
+
         program->setProgramIds(progType, progId);
         if (vlt < VertexLayoutType::Count)
             program->setupVertexLayout(vlt);
@@ -307,4 +383,133 @@ void ProgramManager::unloadAllPrograms()
     _cachedPrograms.clear();
 }
 
+void ProgramManager::setProgramBinaryCachePath(std::string_view path)
+{
+    auto& cachePath = DriverBase::getInstance()->_programBinaryCachePath;
+    cachePath       = path;
+    if (!cachePath.empty() && cachePath.back() != '/')
+        cachePath.push_back('/');
+
+    auto pipelineCache = DriverBase::getInstance()->getPipelineCache();
+    pipelineCache->setFilePath(cachePath.empty() ? cachePath : cachePath + "pipelines.bin");
+}
+
+std::string_view ProgramManager::getProgramBinaryCachePath() const
+{
+    return DriverBase::getInstance()->getProgramBinaryCachePath();
+}
+
+void ProgramManager::warmupPrograms(std::vector<uint64_t> progIds, std::function<void()> callback)
+{
+    auto fileUtils = FileUtils::getInstance();
+
+    WarmupTask task;
+    task.callback = std::move(callback);
+    for (auto progId : progIds)
+    {
+        if (_cachedPrograms.find(progId) != _cachedPrograms.end())
+            continue;
+
+        const BuiltinRegInfo* info = nullptr;
+        uint32_t progType          = ProgramType::CUSTOM_PROGRAM;
+        if (progId < ProgramType::BUILTIN_COUNT)
+        {
+            info     = &_builtinRegistry[progId];
+            progType = static_cast<uint32_t>(progId);
+        }
+        else if (auto it = _customRegistry.find(progId); it != _customRegistry.end())
+            info = &it->second;
+
+        if (!info)
+        {
+            AXLOGW("ProgramManager: can't warmup the unregistered program {}", progId);
+            continue;
+        }
+
+        task.programs.emplace_back(
+            WarmupProgram{progId, progType, info->vlt,
+                          fileUtils->getStringFromFile(fileUtils->fullPathForFilename(info->vsName)),
+                          fileUtils->getStringFromFile(fileUtils->fullPathForFilename(info->fsName))});
+    }
+
+    if (_warmupTasks.empty())
+        Director::getInstance()->getScheduler()->schedule([this](float) { updateWarmup(); }, this, 0, false,
+                                                          PROGRAM_WARMUP_KEY);
+    _warmupTasks.emplace_back(std::move(task));
+}
+
+void ProgramManager::warmupPipelines(std::function<void()> callback)
+{
+    // the states of programs loaded without being registered can't be created again
+    std::vector<uint64_t> progIds;
+    std::vector<PipelineStateDesc> pipelines;
+    for (auto& state : DriverBase::getInstance()->getPipelineCache()->getStates())
+    {
+        const auto progId = state.programId;
+        if (progId >= ProgramType::BUILTIN_COUNT && _customRegistry.find(progId) == _customRegistry.end())
+            continue;
+        if (std::find(progIds.begin(), progIds.end(), progId) == progIds.end())
+            progIds.push_back(progId);
+        pipelines.push_back(state);
+    }
+
+    // the task loading the programs creates the states once they are loaded
+    warmupPrograms(std::move(progIds), std::move(callback));
+    _warmupTasks.back().pipelines = std::move(pipelines);
+}
+
+void ProgramManager::updateWarmup()
+{
+    using clock_type = std::chrono::steady_clock;
+
+    auto driver        = DriverBase::getInstance();
+    const auto endTime = clock_type::now() + std::chrono::duration_cast<clock_type::duration>(
+                                                 std::chrono::duration<float>(_warmupFrameBudget));
+    for (auto& task : _warmupTasks)
+    {
+        auto& programs = task.programs;
+        for (auto it = programs.begin(); it != programs.end();)
+        {
+            // every pending program is prepared each frame so that the driver compiles them all concurrently,
+            // but the loads which may compile synchronously are bounded by the frame budget
+            auto& pending = *it;
+            if (_cachedPrograms.find(pending.progId) != _cachedPrograms.end())
+                it = programs.erase(it);
+            else if (driver->prepareProgram(pending.vertSource, pending.fragSource) && clock_type::now() < endTime)
+            {
+                createProgram(pending.vertSource, pending.fragSource, pending.progType, pending.progId, pending.vlt);
+                it = programs.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        if (!programs.empty())
+            continue;
+
+        auto& pipelines     = task.pipelines;
+        auto renderPipeline = Director::getInstance()->getRenderer()->getRenderPipeline();
+        size_t created      = 0;
+        for (; created < pipelines.size() && clock_type::now() < endTime; ++created)
+        {
+            auto& desc = pipelines[created];
+            if (auto program = loadProgram(desc.programId))
+                renderPipeline->warmup(program, desc);
+        }
+        pipelines.erase(pipelines.begin(), pipelines.begin() + created);
+    }
+
+    // tasks complete in request order
+    while (!_warmupTasks.empty() && _warmupTasks.front().programs.empty() && _warmupTasks.front().pipelines.empty())
+    {
+        auto callback = std::move(_warmupTasks.front().callback);
+        _warmupTasks.erase(_warmupTasks.begin());
+        if (callback)
+            callback();
+    }
+
+    if (_warmupTasks.empty())
+        Director::getInstance()->getScheduler()->unschedule(PROGRAM_WARMUP_KEY, this);
+}
+
 NS_AX_BACKEND_END
@@ -29,10 +29,13 @@
 #include "base/Object.h"
 #include "platform/PlatformMacros.h"
 #include "Program.h"
+#include "PipelineCache.h"
 
 #include <string>
 #include <unordered_map>
 #include <string_view>
+#include <vector>
+#include <functional>
 #include "ProgramStateRegistry.h"
 
 struct XXH64_state_s;
@@ -103,6 +106,51 @@ public:
      * Unload all program objects from cache.
      */
     void unloadAllPrograms();
+
+    /**
+     * Set the directory where the linked program binaries are cached by the drivers supporting it (OpenGL 4.1,
+     * OpenGL ES 3.0), the programs are loaded from it without compiling their shaders on next runs.
+     * Defaults to "programs/" in the writable path, empty disables the cache.
+     */
+    void setProgramBinaryCachePath(std::string_view path);
+    std::string_view getProgramBinaryCachePath() const;
+
+    /**
+     * Load programs ahead of their first use, i.e. while a loading scene is shown, so that their first appearance
+     * doesn't hitch. The programs are loaded over the next frames within a time budget per frame, drivers
+     * supporting KHR_parallel_shader_compile compile the shaders in background threads meanwhile.
+     * @param progIds the ids of builtin or registered custom programs
+     * @param callback invoked once all the programs are loaded
+     */
+    void warmupPrograms(std::vector<uint64_t> progIds, std::function<void()> callback = nullptr);
+
+    /**
+     * Create the pipeline states recorded by the previous sessions ahead of their first use, with their programs.
+     * The backends compiling the shaders on creation of the pipeline state objects, i.e. metal, record the states
+     * to the program binary cache directory. The states are created within the time budget per frame of
+     * `warmupPrograms`.
+     * @param callback invoked once all the states are created
+     */
+    void warmupPipelines(std::function<void()> callback = nullptr);
+
+    /** Whether programs requested by `warmupPrograms` are still loading. */
+    bool isWarmingUp() const { return !_warmupTasks.empty(); }
+
+    struct ProgramLoadTime
+    {
+        uint64_t progId;
+        float milliseconds;  ///< spent compiling and linking the program
+    };
+
+    /**
+     * The creation time of the programs loaded so far, in loading order. The builtin programs are loaded on first
+     * use, the slow ones loaded while the app starts are the candidates for `warmupPrograms`.
+     */
+    const std::vector<ProgramLoadTime>& getProgramLoadTimes() const { return _programLoadTimes; }
+
+    /** Set the time in seconds spent loading programs each frame by `warmupPrograms`, 0.008 by default. */
+    void setWarmupFrameBudget(float seconds) { _warmupFrameBudget = seconds; }
+    float getWarmupFrameBudget() const { return _warmupFrameBudget; }
 #ifndef AX_CORE_PROFILE
     /**
      * Remove a program object from cache.
@@ -125,7 +173,7 @@ protected:
     virtual ~ProgramManager();
 
     /**
-     * Pre-load programs into cache.
+     * Register the builtin programs, they are loaded on first use.
      */
     bool init();
 
@@ -149,6 +197,17 @@ protected:
 
     uint64_t computeProgramId(std::string_view vsName, std::string_view fsName);
 
+    /**
+     * create a program from the shader sources and add it to the cache
+     */
+    Program* createProgram(std::string_view vertSource,
+                           std::string_view fragSource,
+                           uint32_t progType,
+                           uint64_t progId,
+                           VertexLayoutType vlt);
+
+    void updateWarmup();
+
     struct BuiltinRegInfo
     {  // builtin shader name is literal string, so use std::string_view ok
         std::string_view vsName;
@@ -161,6 +220,24 @@ protected:
 
     std::unordered_map<uint64_t, Program*> _cachedPrograms;  ///< The cached program object.
 
+    struct WarmupProgram
+    {
+        uint64_t progId;
+        uint32_t progType;
+        VertexLayoutType vlt;
+        std::string vertSource;
+        std::string fragSource;
+    };
+    struct WarmupTask
+    {
+        std::vector<WarmupProgram> programs;
+        std::vector<PipelineStateDesc> pipelines;  ///< created once the programs are loaded
+        std::function<void()> callback;
+    };
+    std::vector<WarmupTask> _warmupTasks;
+    std::vector<ProgramLoadTime> _programLoadTimes;
+    float _warmupFrameBudget = 0.008f;
+
     XXH64_state_s* _programIdGen;
 
     static ProgramManager* _sharedProgramManager;  ///< A shared instance of the program cache.
@@ -27,10 +27,12 @@
 #include "renderer/backend/Program.h"
 #include "renderer/backend/Texture.h"
 #include "renderer/backend/Types.h"
+#include "renderer/backend/Buffer.h"
 #include "base/EventDispatcher.h"
 #include "base/EventType.h"
 #include "base/Director.h"
 #include <algorithm>
+#include <atomic>
 #include "xxhash/xxhash.h"
 
 #include "axslcc/sgs-spec.h"
@@ -152,6 +154,11 @@ ProgramState::ProgramState(Program* program)
     init(program);
 }
 
+namespace
+{
+std::atomic<uint64_t> s_nextUniqueId{1};
+}
+
 bool ProgramState::init(Program* program)
 {
     AX_SAFE_RETAIN(program);
@@ -165,7 +172,11 @@ bool ProgramState::init(Program* program)
     _fragmentUniformBufferSize = _program->getUniformBufferSize(ShaderStage::FRAGMENT);
 #endif
 
-    _uniformBuffers.resize((std::max)(_vertexUniformBufferSize + _fragmentUniformBufferSize, (size_t)1), 0);
+    _uniformBuffers = std::make_shared<yasio::sbyte_buffer>();
+    _uniformBuffers->resize((std::max)(_vertexUniformBufferSize + _fragmentUniformBufferSize, (size_t)1), 0);
+
+    _uniqueId = s_nextUniqueId++;
+    markUniformDirty(0, _vertexUniformBufferSize);
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
@@ -185,7 +196,7 @@ bool ProgramState::init(Program* program)
 
 void ProgramState::updateBatchId()
 {
-    _batchId = XXH64(_uniformBuffers.data(), _uniformBuffers.size(), _program->getProgramId());
+    _batchId = XXH64(_uniformBuffers->data(), _uniformBuffers->size(), _program->getProgramId());
     _isBatchable = true;
 }
 
@@ -207,11 +218,16 @@ void ProgramState::resetUniforms()
             _vertexTextureInfos[location].location = mappedLocation;
         }
     }
+
+    // the uniform buffers were lost with the context
+    releaseOwnedUniformBuffers();
+    markUniformDirty(0, _vertexUniformBufferSize);
 #endif
 }
 
 ProgramState::~ProgramState()
 {
+    releaseOwnedUniformBuffers();
     AX_SAFE_RELEASE(_program);
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -234,9 +250,59 @@ ProgramState* ProgramState::clone() const
 
     cp->_batchId = this->_batchId;
     cp->_isBatchable = this->_isBatchable;
+    cp->_uniformBufferOwned = this->_uniformBufferOwned;
+
+    // the resolvers bind their callbacks to the program state they're applied on
+    cp->_autoBindings = _autoBindings;
+    for (auto&& binding : cp->_autoBindings)
+        cp->applyAutoBinding(binding.first, binding.second);
     return cp;
 }
 
+char* ProgramState::getWritableUniformBuffer()
+{
+    if (_uniformBuffers.use_count() > 1)
+        _uniformBuffers = std::make_shared<yasio::sbyte_buffer>(*_uniformBuffers);
+    return _uniformBuffers->data();
+}
+
+void ProgramState::setUniformBufferOwned(bool owned)
+{
+    if (_uniformBufferOwned == owned)
+        return;
+
+    _uniformBufferOwned = owned;
+    releaseOwnedUniformBuffers();
+    // the buffers used from now on don't hold the current uniforms
+    markUniformDirty(0, _vertexUniformBufferSize);
+}
+
+void ProgramState::releaseOwnedUniformBuffers()
+{
+    for (auto&& buffer : _ownedUniformBuffers)
+        buffer->release();
+    _ownedUniformBuffers.clear();
+}
+
+void ProgramState::markUniformDirty(std::size_t begin, std::size_t end)
+{
+    if (_uniformDirtyBegin >= _uniformDirtyEnd)
+    {
+        _uniformDirtyBegin = begin;
+        _uniformDirtyEnd   = end;
+    }
+    else
+    {
+        _uniformDirtyBegin = (std::min)(_uniformDirtyBegin, begin);
+        _uniformDirtyEnd   = (std::max)(_uniformDirtyEnd, end);
+    }
+}
+
+void ProgramState::clearUniformDirtyRange()
+{
+    _uniformDirtyBegin = _uniformDirtyEnd = 0;
+}
+
 backend::UniformLocation ProgramState::getUniformLocation(backend::Uniform name) const
 {
     return _program->getUniformLocation(name);
@@ -268,10 +334,12 @@ void ProgramState::setVertexUniform(int location, const void* data, std::size_t
         return;
 #if AX_GLES_PROFILE != 200
     assert(location + offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + location + offset, data, size);
+    memcpy(getWritableUniformBuffer() + location + offset, data, size);
+    markUniformDirty(location + offset, location + offset + size);
 #else
     assert(offset + size <= _vertexUniformBufferSize);
-    memcpy(_uniformBuffers.data() + offset, data, size);
+    memcpy(getWritableUniformBuffer() + offset, data, size);
+    markUniformDirty(offset, offset + size);
 #endif
 }
 
@@ -281,7 +349,7 @@ void ProgramState::setFragmentUniform(int location, const void* data, std::size_
     if (location < 0)
         return;
 
-    memcpy(_uniformBuffers.data() + _vertexUniformBufferSize + location + offset, data, size);
+    memcpy(getWritableUniformBuffer() + _vertexUniformBufferSize + location + offset, data, size);
 }
 #endif
 
@@ -437,13 +505,13 @@ ProgramState::AutoBindingResolver::~AutoBindingResolver()
 const char* ProgramState::getVertexUniformBuffer(std::size_t& size) const
 {
     size = _vertexUniformBufferSize;
-    return _uniformBuffers.data();
+    return _uniformBuffers->data();
 }
 
 const char* ProgramState::getFragmentUniformBuffer(std::size_t& size) const
 {
     size = _fragmentUniformBufferSize;
-    return _uniformBuffers.data() + _vertexUniformBufferSize;
+    return _uniformBuffers->data() + _vertexUniformBufferSize;
 }
 
 NS_AX_BACKEND_END
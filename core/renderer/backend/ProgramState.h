@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <unordered_map>
 #include <cstdint>
 #include <functional>
@@ -42,6 +43,7 @@ NS_AX_BACKEND_BEGIN
 
 class TextureBackend;
 class VertexLayout;
+class Buffer;
 
 /**
  * @addtogroup _backend
@@ -99,7 +101,8 @@ public:
     virtual ~ProgramState();
 
     /**
-     * Deep clone ProgramState
+     * Clone ProgramState, the clone shares the uniform values of this program state until one of them changes its
+     * uniforms (copy-on-write), so cloning a material doesn't copy its uniform blocks.
      */
     ProgramState* clone() const;
 
@@ -327,6 +330,34 @@ public:
      */
     void validateSharedVertexLayout(VertexLayoutType);
 
+    /**
+     * Keep the uniforms in uniform buffers owned by this program state instead of the ones shared by all program
+     * states of the program, so that only the ranges modified since its last draw are uploaded, even when other
+     * program states of the same program are drawn in between. Costs one GPU buffer per uniform block, ignored by the
+     * backends without uniform buffers.
+     */
+    void setUniformBufferOwned(bool owned);
+    bool isUniformBufferOwned() const { return _uniformBufferOwned; }
+
+    /**
+     * For internal use only: the byte range of the vertex uniform buffer modified since the last upload,
+     * empty when begin >= end.
+     */
+    std::size_t getUniformDirtyBegin() const { return _uniformDirtyBegin; }
+    std::size_t getUniformDirtyEnd() const { return _uniformDirtyEnd; }
+    void clearUniformDirtyRange();
+
+    /**
+     * For internal use only: identifies the program state which uploaded the content of a uniform buffer, never
+     * reused unlike the address of a program state.
+     */
+    uint64_t getUniqueId() const { return _uniqueId; }
+
+    /**
+     * For internal use only: the backend uniform buffers owned by the program state, see `setUniformBufferOwned`.
+     */
+    std::vector<Buffer*>& getOwnedUniformBuffers() { return _ownedUniformBuffers; }
+
 protected:
     void ensureVertexLayoutMutable();
 
@@ -338,6 +369,9 @@ protected:
      */
     void setVertexUniform(int location, const void* data, std::size_t size, std::size_t offset);
 
+    void markUniformDirty(std::size_t begin, std::size_t end);
+    void releaseOwnedUniformBuffers();
+
 #ifdef AX_USE_METAL
     /**
      * Set the fargment uniform data.
@@ -389,9 +423,12 @@ protected:
      */
     void applyAutoBinding(std::string_view, std::string_view);
 
+    /** Gets the uniform values for writing, copies them first when they are shared with a clone. */
+    char* getWritableUniformBuffer();
+
     backend::Program* _program = nullptr;
     std::unordered_map<UniformLocation, UniformCallback, UniformLocation> _callbackUniforms;
-    yasio::sbyte_buffer _uniformBuffers;
+    std::shared_ptr<yasio::sbyte_buffer> _uniformBuffers;
     std::size_t _vertexUniformBufferSize   = 0;
     std::size_t _fragmentUniformBufferSize = 0;
 
@@ -407,6 +444,12 @@ protected:
     uint64_t _batchId    = -1;
     bool _isBatchable = false;
 
+    uint64_t _uniqueId              = 0;
+    std::size_t _uniformDirtyBegin  = 0;
+    std::size_t _uniformDirtyEnd    = 0;
+    bool _uniformBufferOwned        = false;
+    std::vector<Buffer*> _ownedUniformBuffers;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
@@ -36,6 +36,8 @@ NS_AX_BACKEND_BEGIN
  * @{
  */
 class RenderTarget;
+class Program;
+struct PipelineStateDesc;
 
 /**
  * Render pipeline
@@ -45,6 +47,12 @@ class RenderPipeline : public ax::Object
 public:
     virtual void update(const RenderTarget*, const PipelineDescriptor& pipelineDescriptor) = 0;
 
+    /**
+     * Create the pipeline state object of a recorded state ahead of its first use, nothing is done by the backends
+     * without such objects.
+     */
+    virtual void warmup(Program* /*program*/, const PipelineStateDesc& /*desc*/) {}
+
 protected:
     virtual ~RenderPipeline() = default;
 };
@@ -104,6 +104,21 @@ public:
 
     bool isDirty() const { return !!_dirtyFlags; }
 
+    /**
+     * The content of the transient attachments doesn't outlive a render pass, it is never loaded nor stored. This is
+     * what the depth and stencil of an offscreen pass usually need, the tile based GPUs then don't write them back to
+     * memory.
+     */
+    void setTransientAttachments(TargetBufferFlags flags) { _transientFlags = flags; }
+    TargetBufferFlags getTransientAttachments() const { return _transientFlags; }
+
+    /**
+     * The overwritten attachments are entirely drawn over by each pass rendering to the target, e.g. by a fullscreen
+     * quad, their previous content is never loaded.
+     */
+    void setOverwrittenAttachments(TargetBufferFlags flags) { _overwrittenFlags = flags; }
+    TargetBufferFlags getOverwrittenAttachments() const { return _overwrittenFlags; }
+
     ColorAttachment _color{};
     RenderBuffer _depth{};
     RenderBuffer _stencil{};
@@ -111,6 +126,8 @@ public:
 protected:
     bool _defaultRenderTarget = false;
     mutable TargetBufferFlags _dirtyFlags{};
+    TargetBufferFlags _transientFlags{};
+    TargetBufferFlags _overwrittenFlags{};
 };
 
 NS_AX_BACKEND_END
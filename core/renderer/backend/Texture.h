@@ -28,6 +28,7 @@
 #include "Types.h"
 #include "base/Object.h"
 #include <cassert>
+#include <atomic>
 
 #include <functional>
 
@@ -49,6 +50,7 @@ struct TextureDescriptor
     uint32_t height           = 0;
     uint32_t depth            = 0;
     SamplerDescriptor samplerDescriptor;
+    bool transient = false;  // a render target whose content doesn't outlive a render pass, memoryless when possible
 };
 
 /**
@@ -103,6 +105,13 @@ public:
     int getWidth() const { return _width; }
     int getHeight() const { return _height; }
 
+    /**
+     * The frame the texture was last bound for drawing in, see Director::getTotalFrames.
+     * It's updated by the command buffers, so the caches can tell the textures which aren't drawn any more.
+     */
+    unsigned int getLastUsedFrame() const { return _lastUsedFrame.load(std::memory_order_relaxed); }
+    void markUsed(unsigned int frame) { _lastUsedFrame.store(frame, std::memory_order_relaxed); }
+
 protected:
     /**
      * @param descriptor Specifies the texture descriptor.
@@ -120,6 +129,9 @@ protected:
     TextureType _textureType   = TextureType::TEXTURE_2D;
     PixelFormat _textureFormat = PixelFormat::RGBA8;
     TextureUsage _textureUsage = TextureUsage::READ;
+
+    // the textures are bound by the parallel encoders too
+    std::atomic<unsigned int> _lastUsedFrame{0};
 };
 
 /**
@@ -130,7 +142,7 @@ class Texture2DBackend : public TextureBackend
 public:
     /**
      * Update a two-dimensional texture image
-     * @param data Specifies a pointer to the image data in memory.
+     * @param data Specifies a pointer to the image data in memory, nullptr only allocates the image.
      * @param width Specifies the width of the texture image.
      * @param height Specifies the height of the texture image.
      * @param level Specifies the level-of-detail number. Level 0 is the base image level. Level n is the nth mipmap
@@ -192,6 +204,24 @@ public:
                                          uint8_t* data,
                                          int index = 0) = 0;
 
+    /**
+     * Samples an image the platform owns instead of the storage of the texture, e.g. a video frame decoded on the
+     * GPU, so its pixels are never copied. The image is retained until it's replaced or the texture is destroyed.
+     * @param handle The native image, an id<MTLTexture> for the Metal backend.
+     * @param format The pixel format of the image.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @return false if the backend can't sample the images of the platform, the pixels have to be uploaded then.
+     */
+    virtual bool updateNativeTexture(uintptr_t handle,
+                                     PixelFormat format,
+                                     std::size_t width,
+                                     std::size_t height,
+                                     int index = 0)
+    {
+        return false;
+    }
+
     /**
      * Get texture width.
      * @return Texture width.
@@ -217,6 +247,19 @@ public:
      * @param data Specifies a pointer to the image data in memory.
      */
     virtual void updateFaceData(TextureCubeFace side, void* data, int index = 0) = 0;
+
+    /**
+     * Update a mipmap level of a cube face, the data is in the format of the texture, compressed or not.
+     * @param side Specifies which slice texture of cube to be update.
+     * @param data Specifies a pointer to the image data in memory.
+     * @param dataLen Specifies the size of the data in bytes.
+     * @param level Specifies the mipmap level, the faces of level n are (size >> n) pixels wide.
+     */
+    virtual void updateFaceLevelData(TextureCubeFace side,
+                                     const void* data,
+                                     std::size_t dataLen,
+                                     int level,
+                                     int index = 0) = 0;
 };
 
 // end of _backend group
@@ -143,4 +143,14 @@ struct BlendDescriptor
     BlendFactor destinationAlphaBlendFactor = BlendFactor::ZERO;
 };
 
+/**
+ * @brief The GPU time of a timer scope, see `CommandBuffer::beginGPUTimer`.
+ */
+struct GPUTimerSample
+{
+    std::string label;
+    int depth           = 0;  ///< the nesting level of the scope, 0 for the outermost ones
+    double milliseconds = 0;
+};
+
 NS_AX_BACKEND_END
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include "../Macros.h"
 
@@ -62,6 +63,8 @@ public:
 
 private:
     static std::vector<BufferMTL*> _buffers;
+    // the buffers are created on the axmol thread while the render thread begins a frame
+    static std::mutex _mutex;
 };
 
 // end of _metal group
@@ -28,14 +28,17 @@
 NS_AX_BACKEND_BEGIN
 
 std::vector<BufferMTL*> BufferManager::_buffers;
+std::mutex BufferManager::_mutex;
 
 void BufferManager::addBuffer(BufferMTL* buffer)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _buffers.push_back(buffer);
 }
 
 void BufferManager::removeBuffer(BufferMTL* buffer)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     auto iter = std::find(_buffers.begin(), _buffers.end(), buffer);
     if (_buffers.end() != iter)
         _buffers.erase(iter);
@@ -43,6 +46,7 @@ void BufferManager::removeBuffer(BufferMTL* buffer)
 
 void BufferManager::beginFrame()
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     for (auto& buffer : _buffers)
         buffer->beginFrame();
 }
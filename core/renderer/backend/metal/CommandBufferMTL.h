@@ -28,6 +28,7 @@
 #include "../CommandBuffer.h"
 #include "DriverMTL.h"
 #include <unordered_map>
+#include <atomic>
 
 NS_AX_BACKEND_BEGIN
 
@@ -201,6 +202,24 @@ public:
      */
     void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
 
+    /**
+     * Split the current render pass with a MTLParallelRenderCommandEncoder, each returned command buffer encodes
+     * into one of its render command encoders, which are created in order so the GPU executes them in index order.
+     */
+    bool beginParallelEncoding(int count, std::vector<CommandBuffer*>& commandBuffers) override;
+
+    void endParallelEncoding() override;
+
+    /**
+     * Only the GPU time of the whole frame is reported, from the GPU start and end time of the command buffer,
+     * the scopes are ignored.
+     */
+    bool isGPUTimerSupported() const override { return true; }
+    bool getGPUTimerResults(std::vector<GPUTimerSample>& samples) override;
+
+    /** The Metal device and its resources are thread safe, the frames only have to be begun and ended on one thread. */
+    bool isRenderThreadSupported() const override { return true; }
+
     id<MTLRenderCommandEncoder> getRenderCommandEncoder() const { return _mtlRenderEncoder; }
 
     id<MTLCommandBuffer> getMTLCommandBuffer() const { return _mtlCommandBuffer; }
@@ -230,6 +249,11 @@ protected:
                            PixelBufferDescriptor& pbd);
 
 private:
+    /**
+     * A command buffer encoding into a render command encoder of the parallel encoder of `primary`.
+     */
+    CommandBufferMTL(DriverMTL* driver, CommandBufferMTL* primary);
+
     void prepareDrawing() const;
     void setTextures() const;
     void doSetTextures(bool isVertex) const;
@@ -258,6 +282,16 @@ private:
     NSAutoreleasePool* _autoReleasePool         = nil;
 
     std::vector<std::pair<TextureBackend*, std::function<void(const PixelBufferDescriptor&)>>> _captureCallbacks;
+
+    id<MTLParallelRenderCommandEncoder> _mtlParallelEncoder = nil;
+    // kept across frames, so the pipeline states they cache are reused
+    std::vector<CommandBufferMTL*> _parallelCommandBuffers;
+    size_t _parallelCommandBufferCount = 0;
+    CommandBufferMTL* _primary         = nullptr;  // weak ref, set for the parallel command buffers
+
+    // written by the completed handler of the command buffer
+    std::atomic<double> _gpuFrameTime{0};
+    std::atomic<bool> _gpuFrameTimeAvailable{false};
 };
 
 // end of _metal group
@@ -33,6 +33,7 @@
 #include "BufferManager.h"
 #include "DepthStencilStateMTL.h"
 #include "RenderTargetMTL.h"
+#include "base/Director.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -165,8 +166,28 @@ CommandBufferMTL::CommandBufferMTL(DriverMTL* driver)
     , _frameBoundarySemaphore(dispatch_semaphore_create(MAX_INFLIGHT_BUFFER))
 {}
 
+CommandBufferMTL::CommandBufferMTL(DriverMTL* driver, CommandBufferMTL* primary)
+    : _mtlCommandQueue(driver->getMTLCommandQueue()), _frameBoundarySemaphore(nullptr), _primary(primary)
+{
+    _renderPipelineMTL    = static_cast<RenderPipelineMTL*>(driver->newRenderPipeline());
+    _depthStencilStateMTL = static_cast<DepthStencilStateMTL*>(driver->newDepthStencilState());
+}
+
 CommandBufferMTL::~CommandBufferMTL()
 {
+    if (_primary)
+    {
+        // the parallel command buffers own their states, the frame belongs to the primary one
+        endEncoding();
+        AX_SAFE_RELEASE(_renderPipelineMTL);
+        AX_SAFE_RELEASE(_depthStencilStateMTL);
+        return;
+    }
+
+    for (auto commandBuffer : _parallelCommandBuffers)
+        commandBuffer->release();
+    _parallelCommandBuffers.clear();
+
     // Wait for all frames to finish by submitting and waiting on a dummy command buffer.
     flush();
     id<MTLCommandBuffer> oneOffBuffer = [_mtlCommandQueue commandBuffer];
@@ -188,6 +209,7 @@ void CommandBufferMTL::setRenderPipeline(RenderPipeline* renderPipeline)
 
 bool CommandBufferMTL::beginFrame()
 {
+    AXASSERT(!_primary, "A parallel command buffer is begun by beginParallelEncoding");
     _autoReleasePool = [[NSAutoreleasePool alloc] init];
     dispatch_semaphore_wait(_frameBoundarySemaphore, DISPATCH_TIME_FOREVER);
 
@@ -228,6 +250,12 @@ void CommandBufferMTL::updateRenderCommandEncoder(const RenderTarget* renderTarg
 
 void CommandBufferMTL::beginRenderPass(const RenderTarget* renderTarget, const RenderPassDescriptor& renderPassDesc)
 {
+    if (_primary)
+    {
+        // the encoder is given by the parallel encoder, the pass can't change
+        AXASSERT(renderTarget == _currentRenderTarget, "The render pass can't change while encoding in parallel");
+        return;
+    }
     updateRenderCommandEncoder(renderTarget, renderPassDesc);
     //    [_mtlRenderEncoder setFrontFacingWinding:MTLWindingCounterClockwise];
 }
@@ -346,8 +374,71 @@ void CommandBufferMTL::readPixels(RenderTarget* rt, std::function<void(const Pix
     _captureCallbacks.emplace_back(texture, std::move(callback));
 }
 
+bool CommandBufferMTL::beginParallelEncoding(int count, std::vector<CommandBuffer*>& commandBuffers)
+{
+    AXASSERT(!_primary && _mtlParallelEncoder == nil, "Parallel encoding can't be nested");
+    commandBuffers.clear();
+    if (count <= 0 || _mtlRenderEncoder == nil)
+        return false;
+
+    // the current pass is cleared already, the parallel encoder loads its attachments
+    endEncoding();
+    auto renderPassDesc        = _currentRenderPassDesc;
+    renderPassDesc.flags.clear        = TargetBufferFlags::NONE;
+    renderPassDesc.flags.discardStart = TargetBufferFlags::NONE;
+    auto mtlDescriptor = toMTLRenderPassDescriptor(_currentRenderTarget, renderPassDesc);
+    _mtlParallelEncoder        = [_mtlCommandBuffer parallelRenderCommandEncoderWithDescriptor:mtlDescriptor];
+    [_mtlParallelEncoder retain];
+
+    auto driver = static_cast<DriverMTL*>(DriverBase::getInstance());
+    while (_parallelCommandBuffers.size() < static_cast<size_t>(count))
+        _parallelCommandBuffers.emplace_back(new CommandBufferMTL(driver, this));
+
+    _parallelCommandBufferCount = count;
+    for (size_t i = 0; i < _parallelCommandBufferCount; ++i)
+    {
+        auto commandBuffer = _parallelCommandBuffers[i];
+
+        // the encoders execute in creation order
+        commandBuffer->_mtlRenderEncoder = [_mtlParallelEncoder renderCommandEncoder];
+        [commandBuffer->_mtlRenderEncoder retain];
+        commandBuffer->_mtlCommandBuffer            = _mtlCommandBuffer;
+        commandBuffer->_currentRenderTarget         = _currentRenderTarget;
+        commandBuffer->_currentRenderPassDesc       = renderPassDesc;
+        commandBuffer->_renderTargetWidth           = _renderTargetWidth;
+        commandBuffer->_renderTargetHeight          = _renderTargetHeight;
+        commandBuffer->_stencilReferenceValueFront  = _stencilReferenceValueFront;
+        commandBuffer->_stencilReferenceValueBack   = _stencilReferenceValueBack;
+        commandBuffers.emplace_back(commandBuffer);
+    }
+
+    // the commands encoded after the parallel ones, continue the pass with a new encoder
+    _currentRenderPassDesc = renderPassDesc;
+    return true;
+}
+
+void CommandBufferMTL::endParallelEncoding()
+{
+    if (_mtlParallelEncoder == nil)
+        return;
+
+    for (size_t i = 0; i < _parallelCommandBufferCount; ++i)
+    {
+        auto commandBuffer = _parallelCommandBuffers[i];
+        commandBuffer->afterDraw();
+        commandBuffer->endEncoding();
+        commandBuffer->_mtlCommandBuffer = nil;
+    }
+    _parallelCommandBufferCount = 0;
+
+    [_mtlParallelEncoder endEncoding];
+    [_mtlParallelEncoder release];
+    _mtlParallelEncoder = nil;
+}
+
 void CommandBufferMTL::endFrame()
 {
+    AXASSERT(_mtlParallelEncoder == nil, "endParallelEncoding must be invoked before endFrame");
     [_mtlRenderEncoder endEncoding];
     [_mtlRenderEncoder release];
     _mtlRenderEncoder = nil;
@@ -356,6 +447,8 @@ void CommandBufferMTL::endFrame()
     [_mtlCommandBuffer presentDrawable:currentDrawable];
     _drawableTexture = currentDrawable.texture;
     [_mtlCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+      _gpuFrameTime.store((commandBuffer.GPUEndTime - commandBuffer.GPUStartTime) * 1000.0);
+      _gpuFrameTimeAvailable.store(true);
       // GPU work is complete
       // Signal the semaphore to start the CPU work
       dispatch_semaphore_signal(_frameBoundarySemaphore);
@@ -367,6 +460,18 @@ void CommandBufferMTL::endFrame()
     [_autoReleasePool drain];
 }
 
+bool CommandBufferMTL::getGPUTimerResults(std::vector<GPUTimerSample>& samples)
+{
+    if (!_gpuFrameTimeAvailable.exchange(false))
+        return false;
+
+    samples.resize(1);
+    samples[0].label        = "frame";
+    samples[0].depth        = 0;
+    samples[0].milliseconds = _gpuFrameTime.load();
+    return true;
+}
+
 void CommandBufferMTL::endEncoding()
 {
     if (_mtlRenderEncoder) {
@@ -466,6 +571,7 @@ void CommandBufferMTL::doSetTextures(bool isVertex) const
 {
     const auto& bindTextureInfos =
         (isVertex) ? _programState->getVertexTextureInfos() : _programState->getFragmentTextureInfos();
+    auto frame = Director::getInstance()->getTotalFrames();
 
     for (const auto& iter : bindTextureInfos)
     {
@@ -481,6 +587,7 @@ void CommandBufferMTL::doSetTextures(bool isVertex) const
 
         auto texture = textures[0];
         auto index   = indexs[0];
+        texture->markUsed(frame);
 
         if (isVertex)
         {
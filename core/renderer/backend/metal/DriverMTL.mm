@@ -36,6 +36,7 @@
 #include "base/Macros.h"
 
 #include "renderer/backend/ProgramManager.h"
+#include "renderer/backend/null/DriverNull.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -392,7 +393,12 @@ id<CAMetalDrawable> DriverMTL::_currentDrawable = nil;
 DriverBase* DriverBase::getInstance()
 {
     if (!_instance)
-        _instance = new DriverMTL();
+    {
+        if (_nullDriverEnabled)
+            _instance = new DriverNull();
+        else
+            _instance = new DriverMTL();
+    }
 
     return _instance;
 }
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "../RenderPipeline.h"
+#include "../PipelineCache.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -38,6 +39,8 @@ NS_AX_BACKEND_BEGIN
  * @{
  */
 
+class ProgramMTL;
+
 /**
  * Create and compile a new MTLRenderPipelineState object synchronously.
  */
@@ -51,6 +54,7 @@ public:
     RenderPipelineMTL(id<MTLDevice> mtlDevice);
     ~RenderPipelineMTL();
     virtual void update(const RenderTarget* renderTarget, const PipelineDescriptor&) override;
+    void warmup(Program* program, const PipelineStateDesc& desc) override;
 
     /**
      * Get a MTLRenderPipelineState object.
@@ -59,9 +63,12 @@ public:
     inline id<MTLRenderPipelineState> getMTLRenderPipelineState() const { return _mtlRenderPipelineState; }
 
 private:
-    void setVertexLayout(MTLRenderPipelineDescriptor*, const PipelineDescriptor&);
+    id<MTLRenderPipelineState> getOrCreateState(ProgramMTL* program,
+                                                const VertexLayout& vertexLayout,
+                                                const BlendDescriptor& blendDescriptor);
+    void setVertexLayout(MTLRenderPipelineDescriptor*, const VertexLayout&);
     void setBlendState(MTLRenderPipelineColorAttachmentDescriptor*, const BlendDescriptor&);
-    void setShaderModules(const PipelineDescriptor&);
+    void setShaderModules(ProgramMTL*);
     void setBlendStateAndFormat(const BlendDescriptor&);
     void chooseAttachmentFormat(const RenderTarget* renderTarget,
                                 PixelFormat colorAttachmentsFormat[MAX_COLOR_ATTCHMENT],
@@ -76,7 +83,7 @@ private:
     PixelFormat _depthAttachmentFormat                        = PixelFormat::NONE;
     PixelFormat _stencilAttachmentFormat                      = PixelFormat::NONE;
 
-    tsl::robin_map<uint32_t, id<MTLRenderPipelineState>> _mtlStateCache;
+    tsl::robin_map<uint64_t, id<MTLRenderPipelineState>> _mtlStateCache;  ///< keyed by PipelineCache::computeKey
 };
 
 // end of _metal group
@@ -85,6 +85,18 @@ MTLVertexFormat toMTLVertexFormat(VertexFormat vertexFormat, bool needNormalize)
         else
             ret = MTLVertexFormatUChar4;
         break;
+    case VertexFormat::SHORT4:
+        if (needNormalize)
+            ret = MTLVertexFormatShort4Normalized;
+        else
+            ret = MTLVertexFormatShort4;
+        break;
+    case VertexFormat::HALF4:
+        ret = MTLVertexFormatHalf4;
+        break;
+    case VertexFormat::HALF2:
+        ret = MTLVertexFormatHalf2;
+        break;
     default:
         assert(false);
         break;
@@ -164,81 +176,70 @@ RenderPipelineMTL::RenderPipelineMTL(id<MTLDevice> mtlDevice) : _mtlDevice(mtlDe
 
 void RenderPipelineMTL::update(const RenderTarget* renderTarget, const PipelineDescriptor& pipelineDescriptor)
 {
-    struct
-    {
-        size_t vertexShaderHash;
-        size_t fragmentShaderHash;
-        unsigned int vertexLayoutInfo[32];
-        backend::PixelFormat colorAttachment[MAX_COLOR_ATTCHMENT];
-        backend::PixelFormat depthAttachment;
-        backend::PixelFormat stencilAttachment;
-        bool blendEnabled;
-        unsigned int writeMask;
-        unsigned int rgbBlendOperation;
-        unsigned int alphaBlendOperation;
-        unsigned int sourceRGBBlendFactor;
-        unsigned int destinationRGBBlendFactor;
-        unsigned int sourceAlphaBlendFactor;
-        unsigned int destinationAlphaBlendFactor;
-    } hashMe;
-
-    memset(&hashMe, 0, sizeof(hashMe));
-    const auto& blendDescriptor = pipelineDescriptor.blendDescriptor;
     chooseAttachmentFormat(renderTarget, _colorAttachmentsFormat, _depthAttachmentFormat, _stencilAttachmentFormat);
-    auto program              = static_cast<ProgramMTL*>(pipelineDescriptor.programState->getProgram());
-    hashMe.vertexShaderHash   = program->getVertexShader()->getHashValue();
-    hashMe.fragmentShaderHash = program->getFragmentShader()->getHashValue();
-    memcpy(&hashMe.colorAttachment, &_colorAttachmentsFormat, sizeof(_colorAttachmentsFormat));
-    hashMe.depthAttachment             = _depthAttachmentFormat;
-    hashMe.stencilAttachment           = _stencilAttachmentFormat;
-    hashMe.blendEnabled                = blendDescriptor.blendEnabled;
-    hashMe.writeMask                   = (unsigned int)blendDescriptor.writeMask;
-    hashMe.rgbBlendOperation           = (unsigned int)blendDescriptor.rgbBlendOperation;
-    hashMe.alphaBlendOperation         = (unsigned int)blendDescriptor.alphaBlendOperation;
-    hashMe.sourceRGBBlendFactor        = (unsigned int)blendDescriptor.sourceRGBBlendFactor;
-    hashMe.destinationRGBBlendFactor   = (unsigned int)blendDescriptor.destinationRGBBlendFactor;
-    hashMe.sourceAlphaBlendFactor      = (unsigned int)blendDescriptor.sourceAlphaBlendFactor;
-    hashMe.destinationAlphaBlendFactor = (unsigned int)blendDescriptor.destinationAlphaBlendFactor;
-    int index                          = 0;
-    auto vertexLayout                  = pipelineDescriptor.programState->getVertexLayout();
-    const auto& attributes             = vertexLayout->getAttributes();
-    for (const auto& it : attributes)
+    auto program            = static_cast<ProgramMTL*>(pipelineDescriptor.programState->getProgram());
+    _mtlRenderPipelineState = getOrCreateState(program, *pipelineDescriptor.programState->getVertexLayout(),
+                                               pipelineDescriptor.blendDescriptor);
+}
+
+void RenderPipelineMTL::warmup(Program* program, const PipelineStateDesc& desc)
+{
+    // the attachment formats are chosen again by the next update
+    memcpy(_colorAttachmentsFormat, desc.colorAttachments, sizeof(_colorAttachmentsFormat));
+    _depthAttachmentFormat   = desc.depthAttachment;
+    _stencilAttachmentFormat = desc.stencilAttachment;
+    getOrCreateState(static_cast<ProgramMTL*>(program), desc.vertexLayout, desc.blendDescriptor);
+}
+
+id<MTLRenderPipelineState> RenderPipelineMTL::getOrCreateState(ProgramMTL* program,
+                                                               const VertexLayout& vertexLayout,
+                                                               const BlendDescriptor& blendDescriptor)
+{
+    // the programs created without an id are told apart by their shaders
+    auto programId = program->getProgramId();
+    if (programId == 0)
     {
-        auto& attribute = it.second;
-        /*
-         stepFunction:1     stride:15       offest:10       format:5        needNormalized:1
-         bit31           bit30 ~ bit16   bit15 ~ bit6    bit5 ~ bit1     bit0
-         */
-        hashMe.vertexLayoutInfo[index++] =
-            ((unsigned int)vertexLayout->getVertexStepMode() & 0x1) << 31 |
-            ((unsigned int)(vertexLayout->getStride() & 0x7FFF)) << 16 | ((unsigned int)attribute.offset & 0x3FF) << 6 |
-            ((unsigned int)attribute.format & 0x1F) << 1 | ((unsigned int)attribute.needToBeNormallized & 0x1);
+        const size_t shaderHashes[] = {program->getVertexShader()->getHashValue(),
+                                       program->getFragmentShader()->getHashValue()};
+        programId                   = XXH3_64bits(shaderHashes, sizeof(shaderHashes));
     }
 
-    unsigned int hash = XXH32((const void*)&hashMe, sizeof(hashMe), 0);
-    auto it           = _mtlStateCache.find(hash);
+    const auto key = PipelineCache::computeKey(programId, vertexLayout, _colorAttachmentsFormat,
+                                               _depthAttachmentFormat, _stencilAttachmentFormat, blendDescriptor);
+    auto it        = _mtlStateCache.find(key);
     if (it != _mtlStateCache.end())
-    {
-        _mtlRenderPipelineState = it->second;
-        return;
-    }
+        return it->second;
 
     _mtlRenderPipelineDescriptor = [[MTLRenderPipelineDescriptor alloc] init];
 
-    setShaderModules(pipelineDescriptor);
-    setVertexLayout(_mtlRenderPipelineDescriptor, pipelineDescriptor);
+    setShaderModules(program);
+    setVertexLayout(_mtlRenderPipelineDescriptor, vertexLayout);
 
-    setBlendStateAndFormat(pipelineDescriptor.blendDescriptor);
+    setBlendStateAndFormat(blendDescriptor);
 
-    NSError* error          = nil;
-    _mtlRenderPipelineState = [_mtlDevice newRenderPipelineStateWithDescriptor:_mtlRenderPipelineDescriptor
-                                                                         error:&error];
+    NSError* error                   = nil;
+    id<MTLRenderPipelineState> state = [_mtlDevice newRenderPipelineStateWithDescriptor:_mtlRenderPipelineDescriptor
+                                                                                  error:&error];
     if (error)
         NSLog(@"Can not create renderpipeline state: %@", error);
 
     [_mtlRenderPipelineDescriptor release];
 
-    _mtlStateCache.emplace(hash, _mtlRenderPipelineState);
+    _mtlStateCache.emplace(key, state);
+
+    // recorded so that the next sessions can create it ahead of its first use
+    if (state && program->getProgramId() != 0)
+    {
+        PipelineStateDesc desc;
+        desc.programId    = programId;
+        desc.vertexLayout = vertexLayout;
+        memcpy(desc.colorAttachments, _colorAttachmentsFormat, sizeof(_colorAttachmentsFormat));
+        desc.depthAttachment   = _depthAttachmentFormat;
+        desc.stencilAttachment = _stencilAttachmentFormat;
+        desc.blendDescriptor   = blendDescriptor;
+        DriverBase::getInstance()->getPipelineCache()->record(key, desc);
+    }
+    return state;
 }
 
 RenderPipelineMTL::~RenderPipelineMTL()
@@ -247,20 +248,18 @@ RenderPipelineMTL::~RenderPipelineMTL()
         [item.second release];
 }
 
-void RenderPipelineMTL::setVertexLayout(MTLRenderPipelineDescriptor* mtlDescriptor,
-                                        const PipelineDescriptor& descriptor)
+void RenderPipelineMTL::setVertexLayout(MTLRenderPipelineDescriptor* mtlDescriptor, const VertexLayout& vertexLayout)
 {
-    auto vertexLayout = descriptor.programState->getVertexLayout();
-    if (!vertexLayout->isValid())
+    if (!vertexLayout.isValid())
         return;
 
-    int stride = static_cast<int>(vertexLayout->getStride());
+    int stride = static_cast<int>(vertexLayout.getStride());
     auto vertexDesc = mtlDescriptor.vertexDescriptor;
     vertexDesc.layouts[DriverMTL::DEFAULT_ATTRIBS_BINDING_INDEX].stride = stride;
     vertexDesc.layouts[DriverMTL::DEFAULT_ATTRIBS_BINDING_INDEX].stepFunction =
-        toMTLVertexStepFunction(vertexLayout->getVertexStepMode());
+        toMTLVertexStepFunction(vertexLayout.getVertexStepMode());
 
-    const auto& attributes = vertexLayout->getAttributes();
+    const auto& attributes = vertexLayout.getAttributes();
 
 
     for (const auto& it : attributes)
@@ -292,12 +291,12 @@ void RenderPipelineMTL::setBlendState(MTLRenderPipelineColorAttachmentDescriptor
         toMTLBlendFactor(blendDescriptor.destinationAlphaBlendFactor);
 }
 
-void RenderPipelineMTL::setShaderModules(const PipelineDescriptor& descriptor)
+void RenderPipelineMTL::setShaderModules(ProgramMTL* program)
 {
-    auto vertexShaderModule = static_cast<ProgramMTL*>(descriptor.programState->getProgram())->getVertexShader();
+    auto vertexShaderModule = program->getVertexShader();
     _mtlRenderPipelineDescriptor.vertexFunction = vertexShaderModule->getMTLFunction();
 
-    auto fragShaderModule = static_cast<ProgramMTL*>(descriptor.programState->getProgram())->getFragmentShader();
+    auto fragShaderModule = program->getFragmentShader();
     _mtlRenderPipelineDescriptor.fragmentFunction = fragShaderModule->getMTLFunction();
 }
 
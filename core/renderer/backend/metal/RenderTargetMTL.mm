@@ -31,9 +31,14 @@ static MTLStoreAction getStoreAction(const RenderPassDescriptor& params, TargetB
 RenderTargetMTL::RenderTargetMTL(bool defaultRenderTarget) : RenderTarget(defaultRenderTarget) {}
 RenderTargetMTL::~RenderTargetMTL() {}
 
-void RenderTargetMTL::applyRenderPassAttachments(const RenderPassDescriptor& params,
+void RenderTargetMTL::applyRenderPassAttachments(const RenderPassDescriptor& passParams,
                                                  MTLRenderPassDescriptor* descriptor) const
 {
+    // the transient attachments are never loaded nor stored, a memoryless texture allows nothing else
+    auto params = passParams;
+    params.flags.discardStart |= _transientFlags | _overwrittenFlags;
+    params.flags.discardEnd |= _transientFlags;
+
     // const auto discardFlags = params.flags.discardEnd;
     auto clearFlags = params.flags.clear;
 
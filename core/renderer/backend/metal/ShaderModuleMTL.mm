@@ -63,6 +63,7 @@ ShaderModuleMTL::ShaderModuleMTL(id<MTLDevice> mtlDevice, ShaderStage stage, std
     ibs.read_bytes(&chunk, static_cast<int>(sizeof(chunk)));
 
     std::string_view mslCode;
+    bool isBinary = false;
 
     do
     {
@@ -91,8 +92,10 @@ ShaderModuleMTL::ShaderModuleMTL(id<MTLDevice> mtlDevice, ShaderStage stage, std
         }
         else if (fourccId == SGS_CHUNK_DATA)
         {
+            // a metallib precompiled by axslcc --bin, see AXSLCC_COMPILE_BINARY
             code_size = ibs.read<int>();
             mslCode   = ibs.read_bytes(code_size);
+            isBinary  = true;
         }
         else
         {
@@ -158,24 +161,42 @@ ShaderModuleMTL::ShaderModuleMTL(id<MTLDevice> mtlDevice, ShaderStage stage, std
         assert(ibs.eof());
     } while (false);  // iterator stages, current only 1 stage
 
-    auto metalShader = mslCode.data();
-    NSString* shader = [NSString stringWithUTF8String:metalShader];
     NSError* error;
-    id<MTLLibrary> library = [mtlDevice newLibraryWithSource:shader options:nil error:&error];
-    if (!library)
+    id<MTLLibrary> library = nil;
+    if (isBinary)
     {
-        NSLog(@"Can not compile metal shader: %@", error);
-        NSLog(@"%s", metalShader);
-        assert(false);
-        return;
+        dispatch_data_t data = dispatch_data_create(mslCode.data(), mslCode.size(), nullptr,
+                                                    DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+        library              = [mtlDevice newLibraryWithData:data error:&error];
+        dispatch_release(data);
+        if (!library)
+        {
+            NSLog(@"Can not load metal library: %@", error);
+            assert(false);
+            return;
+        }
+    }
+    else
+    {
+        auto metalShader = mslCode.data();
+        NSString* shader = [NSString stringWithUTF8String:metalShader];
+        library          = [mtlDevice newLibraryWithSource:shader options:nil error:&error];
+        if (!library)
+        {
+            NSLog(@"Can not compile metal shader: %@", error);
+            NSLog(@"%s", metalShader);
+            assert(false);
+            return;
+        }
     }
 
     _mtlFunction = [library newFunctionWithName:@"main0"];
 
     if (!_mtlFunction)
     {
-        NSLog(@"metal shader is ---------------");
-        NSLog(@"%s", metalShader);
+        NSLog(@"metal shader has no main0 function ---------------");
+        if (!isBinary)
+            NSLog(@"%s", mslCode.data());
         assert(false);
     }
 
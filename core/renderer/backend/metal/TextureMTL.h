@@ -154,6 +154,16 @@ public:
                                          uint8_t* data,
                                          int index = 0) override;
 
+    /**
+     * Samples a MTLTexture the platform owns, e.g. one of a CVMetalTextureCache, instead of a texture of its own.
+     * @param handle The id<MTLTexture>, it's retained.
+     */
+    bool updateNativeTexture(uintptr_t handle,
+                             PixelFormat format,
+                             std::size_t width,
+                             std::size_t height,
+                             int index = 0) override;
+
     /**
      * Update sampler
      * @param sampler Specifies the sampler descriptor.
@@ -218,6 +228,12 @@ public:
      */
     virtual void updateFaceData(TextureCubeFace side, void* data, int index = 0) override;
 
+    void updateFaceLevelData(TextureCubeFace side,
+                             const void* data,
+                             std::size_t dataLen,
+                             int level,
+                             int index = 0) override;
+
     /**
      * Generate mipmaps.
      */
@@ -164,6 +164,16 @@ id<MTLTexture> TextureInfoMTL::createTexture(id<MTLDevice> mtlDevice, const Text
         if (PixelFormat::D24S8 == descriptor.textureFormat && target == MTL_TEXTURE_2D)
             textureDescriptor.resourceOptions = MTLResourceStorageModePrivate;
         textureDescriptor.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_IOS)
+        // a transient depth stencil only lives in the tile memory
+        if (descriptor.transient && PixelFormat::D24S8 == descriptor.textureFormat && target == MTL_TEXTURE_2D)
+        {
+            textureDescriptor.resourceOptions  = MTLResourceStorageModeMemoryless;
+            textureDescriptor.usage            = MTLTextureUsageRenderTarget;
+            textureDescriptor.mipmapLevelCount = 1;
+        }
+#endif
     }
 
     return [mtlDevice newTextureWithDescriptor:textureDescriptor];
@@ -220,6 +230,18 @@ void TextureMTL::updateTextureDescriptor(const ax::backend::TextureDescriptor& d
 {
     TextureBackend::updateTextureDescriptor(descriptor, index);
 
+    // the texture is recreated by ensure when the size or the format changes
+    if (index < AX_META_TEXTURES)
+    {
+        id<MTLTexture>& mtlTexture = _textureInfo._mtlTextures[index];
+        if (mtlTexture && (mtlTexture.width != _width || mtlTexture.height != _height ||
+                           mtlTexture.pixelFormat != UtilsMTL::toMTLPixelFormat(descriptor.textureFormat)))
+        {
+            [mtlTexture release];
+            mtlTexture = nil;
+        }
+    }
+
     _textureInfo._descriptor = descriptor;
     _textureInfo.ensure(index, MTL_TEXTURE_2D);
     updateSamplerDescriptor(descriptor.samplerDescriptor);
@@ -241,7 +263,7 @@ void TextureMTL::updateSubData(std::size_t xoffset,
                                int index)
 {
     auto mtlTexture = _textureInfo.ensure(index, MTL_TEXTURE_2D);
-    if (!mtlTexture)
+    if (!mtlTexture || !data)  // no data only allocates the texture
         return;
 
     MTLRegion region = {
@@ -279,6 +301,37 @@ void TextureMTL::updateCompressedSubData(std::size_t xoffset,
     updateSubData(xoffset, yoffset, width, height, level, data, index);
 }
 
+bool TextureMTL::updateNativeTexture(uintptr_t handle,
+                                     PixelFormat format,
+                                     std::size_t width,
+                                     std::size_t height,
+                                     int index)
+{
+    if (index >= AX_META_TEXTURES)
+        return false;
+
+    auto texture               = reinterpret_cast<id<MTLTexture>>((void*)handle);
+    id<MTLTexture>& mtlTexture = _textureInfo._mtlTextures[index];
+    if (mtlTexture != texture)
+    {
+        [texture retain];
+        [mtlTexture release];
+        mtlTexture = texture;
+    }
+    if (_textureInfo._maxIdx < index)
+        _textureInfo._maxIdx = index;
+
+    _textureInfo._descriptor.textureFormat = format;
+    _textureInfo._descriptor.width         = static_cast<uint32_t>(width);
+    _textureInfo._descriptor.height        = static_cast<uint32_t>(height);
+
+    _textureFormat = format;
+    _width         = static_cast<uint32_t>(width);
+    _height        = static_cast<uint32_t>(height);
+    _hasMipmaps    = false;
+    return true;
+}
+
 void TextureMTL::generateMipmaps()
 {
     if (TextureUsage::RENDER_TARGET == _textureUsage || isColorRenderable(_textureFormat) == false)
@@ -332,6 +385,29 @@ void TextureCubeMTL::updateFaceData(TextureCubeFace side, void* data, int index)
                 bytesPerImage:_bytesPerImage];
 }
 
+void TextureCubeMTL::updateFaceLevelData(TextureCubeFace side,
+                                         const void* data,
+                                         std::size_t /*dataLen*/,
+                                         int level,
+                                         int index)
+{
+    auto mtlTexture = _textureInfo.ensure(index, MTL_TEXTURE_CUBE);
+    if (!mtlTexture)
+        return;
+
+    // the row pitch of the compressed formats counts the blocks, PVRTC wants 0
+    const auto size = (std::max)(static_cast<uint32_t>(_width) >> level, 1u);
+    [mtlTexture replaceRegion:MTLRegionMake2D(0, 0, size, size)
+                  mipmapLevel:level
+                        slice:static_cast<NSUInteger>(side)
+                    withBytes:data
+                  bytesPerRow:PixelFormatUtils::computeRowPitch(_textureFormat, size)
+                bytesPerImage:0];
+
+    if (!_hasMipmaps && level > 0)
+        _hasMipmaps = true;
+}
+
 void TextureCubeMTL::generateMipmaps()
 {
     if (TextureUsage::RENDER_TARGET == _textureUsage || isColorRenderable(_textureFormat) == false)
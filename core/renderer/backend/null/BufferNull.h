@@ -0,0 +1,56 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../Buffer.h"
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+class DriverNull;
+
+/**
+ * A buffer without storage, the uploads are only counted.
+ */
+class BufferNull : public Buffer
+{
+public:
+    BufferNull(DriverNull* driver, std::size_t size, BufferType type, BufferUsage usage);
+    ~BufferNull();
+
+    void updateData(const void* data, std::size_t size) override;
+    void updateSubData(const void* data, std::size_t offset, std::size_t size) override;
+    void usingDefaultStoredData(bool needDefaultStoredData) override {}
+
+private:
+    DriverNull* _driver = nullptr;
+};
+
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CommandBufferNull.h"
+#include "DriverNull.h"
+#include "../ProgramState.h"
+#include "base/Director.h"
+
+NS_AX_BACKEND_BEGIN
+
+CommandBufferNull::CommandBufferNull(DriverNull* driver) : _driver(driver) {}
+
+CommandBufferNull::~CommandBufferNull()
+{
+    AX_SAFE_RELEASE_NULL(_programState);
+}
+
+void CommandBufferNull::beginRenderPass(const RenderTarget* /*renderTarget*/,
+                                        const RenderPassDescriptor& /*descriptor*/)
+{
+    ++_driver->getCounters().renderPasses;
+}
+
+void CommandBufferNull::setProgramState(ProgramState* programState)
+{
+    AX_SAFE_RETAIN(programState);
+    AX_SAFE_RELEASE(_programState);
+    _programState = programState;
+}
+
+void CommandBufferNull::drawArrays(PrimitiveType /*primitiveType*/,
+                                   std::size_t /*start*/,
+                                   std::size_t count,
+                                   bool /*wireframe*/)
+{
+    draw(count, 1);
+}
+
+void CommandBufferNull::drawElements(PrimitiveType /*primitiveType*/,
+                                     IndexFormat /*indexType*/,
+                                     std::size_t count,
+                                     std::size_t /*offset*/,
+                                     bool /*wireframe*/)
+{
+    draw(count, 1);
+}
+
+void CommandBufferNull::drawElementsInstanced(PrimitiveType /*primitiveType*/,
+                                              IndexFormat /*indexType*/,
+                                              std::size_t count,
+                                              std::size_t /*offset*/,
+                                              int instanceCount,
+                                              bool /*wireframe*/)
+{
+    draw(count, instanceCount);
+}
+
+void CommandBufferNull::draw(std::size_t count, int instanceCount)
+{
+    auto& counters = _driver->getCounters();
+    ++counters.drawCalls;
+    counters.instances += instanceCount;
+    counters.vertices += count * instanceCount;
+
+    if (_programState)
+    {
+        auto frame = Director::getInstance()->getTotalFrames();
+        auto stages = {&_programState->getVertexTextureInfos(), &_programState->getFragmentTextureInfos()};
+        for (auto textureInfos : stages)
+        {
+            for (const auto& iter : *textureInfos)
+            {
+                for (const auto& texture : iter.second.textures)
+                    texture->markUsed(frame);
+            }
+        }
+    }
+}
+
+void CommandBufferNull::endFrame()
+{
+    ++_driver->getCounters().frames;
+    AX_SAFE_RELEASE_NULL(_programState);
+}
+
+void CommandBufferNull::readPixels(RenderTarget* /*rt*/, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    callback(PixelBufferDescriptor{});
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,168 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "DriverNull.h"
+#include "BufferNull.h"
+#include "CommandBufferNull.h"
+#include "ProgramNull.h"
+#include "TextureNull.h"
+#include "../RenderPipeline.h"
+#include "../RenderTarget.h"
+#include "../ShaderModule.h"
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+class ShaderModuleNull : public ShaderModule
+{
+public:
+    explicit ShaderModuleNull(ShaderStage stage) : ShaderModule(stage) {}
+};
+
+class DepthStencilStateNull : public DepthStencilState
+{
+};
+
+class RenderPipelineNull : public RenderPipeline
+{
+public:
+    void update(const RenderTarget*, const PipelineDescriptor&) override {}
+};
+
+class RenderTargetNull : public RenderTarget
+{
+public:
+    RenderTargetNull(bool defaultRenderTarget, DriverNull* driver) : RenderTarget(defaultRenderTarget), _driver(driver)
+    {
+        ++_driver->getCounters().liveRenderTargets;
+    }
+    ~RenderTargetNull() { --_driver->getCounters().liveRenderTargets; }
+
+private:
+    DriverNull* _driver = nullptr;
+};
+}  // namespace
+
+DriverNull::DriverNull()
+{
+    // the limits of a common desktop GPU, the engine sizes its batches and atlases after them
+    _maxAttributes     = 16;
+    _maxTextureSize    = 16384;
+    _maxTextureUnits   = 16;
+    _maxSamplesAllowed = 4;
+}
+
+CommandBuffer* DriverNull::newCommandBuffer()
+{
+    return new CommandBufferNull(this);
+}
+
+Buffer* DriverNull::newBuffer(std::size_t size, BufferType type, BufferUsage usage)
+{
+    return new BufferNull(this, size, type, usage);
+}
+
+TextureBackend* DriverNull::newTexture(const TextureDescriptor& descriptor)
+{
+    switch (descriptor.textureType)
+    {
+    case TextureType::TEXTURE_2D:
+        return new Texture2DNull(this, descriptor);
+    case TextureType::TEXTURE_CUBE:
+        return new TextureCubeNull(this, descriptor);
+    default:
+        return nullptr;
+    }
+}
+
+RenderTarget* DriverNull::newDefaultRenderTarget()
+{
+    return new RenderTargetNull(true, this);
+}
+
+RenderTarget* DriverNull::newRenderTarget(TextureBackend* colorAttachment,
+                                          TextureBackend* depthAttachment,
+                                          TextureBackend* stencilAttachhment)
+{
+    auto rt = new RenderTargetNull(false, this);
+    RenderTarget::ColorAttachment colors{{colorAttachment, 0}};
+    rt->setColorAttachment(colors);
+    rt->setDepthAttachment(depthAttachment);
+    rt->setStencilAttachment(stencilAttachhment);
+    return rt;
+}
+
+DepthStencilState* DriverNull::newDepthStencilState()
+{
+    return new DepthStencilStateNull();
+}
+
+RenderPipeline* DriverNull::newRenderPipeline()
+{
+    return new RenderPipelineNull();
+}
+
+Program* DriverNull::newProgram(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    return new ProgramNull(this, vertexShader, fragmentShader);
+}
+
+ShaderModule* DriverNull::newShaderModule(ShaderStage stage, std::string_view /*source*/)
+{
+    return new ShaderModuleNull(stage);
+}
+
+const char* DriverNull::getVendor() const
+{
+    return "axmol";
+}
+
+const char* DriverNull::getRenderer() const
+{
+    return "Null";
+}
+
+const char* DriverNull::getVersion() const
+{
+    return "1.0";
+}
+
+bool DriverNull::checkForFeatureSupported(FeatureType /*feature*/)
+{
+    return true;
+}
+
+void DriverNull::resetCounters()
+{
+    // the live objects aren't frame counters, they're kept
+    Counters counters;
+    counters.liveBuffers       = _counters.liveBuffers;
+    counters.liveTextures      = _counters.liveTextures;
+    counters.livePrograms      = _counters.livePrograms;
+    counters.liveRenderTargets = _counters.liveRenderTargets;
+    _counters                  = counters;
+}
+
+NS_AX_BACKEND_END
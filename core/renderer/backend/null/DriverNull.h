@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "../DriverBase.h"
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * A driver which creates the resources without a GPU, the commands are accepted and counted but nothing is drawn.
+ * It's used by the simulation servers and the benchmarks run on the build machines, where there is no window and no
+ * graphics context, see DriverBase::setNullDriverEnabled.
+ */
+class DriverNull : public DriverBase
+{
+public:
+    /**
+     * What the engine asked the driver for since the counters were reset, the live objects are never reset.
+     */
+    struct Counters
+    {
+        uint64_t frames         = 0;
+        uint64_t renderPasses   = 0;
+        uint64_t drawCalls      = 0;
+        uint64_t instances      = 0;
+        uint64_t vertices       = 0;  ///< Vertices or indices drawn, of all the instances.
+        uint64_t bufferUploads  = 0;  ///< Bytes uploaded to the buffers.
+        uint64_t textureUploads = 0;  ///< Bytes uploaded to the textures.
+        int liveBuffers         = 0;
+        int liveTextures        = 0;
+        int livePrograms        = 0;
+        int liveRenderTargets   = 0;
+    };
+
+    DriverNull();
+
+    CommandBuffer* newCommandBuffer() override;
+    Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
+    TextureBackend* newTexture(const TextureDescriptor& descriptor) override;
+    RenderTarget* newDefaultRenderTarget() override;
+    RenderTarget* newRenderTarget(TextureBackend* colorAttachment,
+                                  TextureBackend* depthAttachment,
+                                  TextureBackend* stencilAttachhment) override;
+    DepthStencilState* newDepthStencilState() override;
+    RenderPipeline* newRenderPipeline() override;
+    void setFrameBufferOnly(bool frameBufferOnly) override {}
+    Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    const char* getVendor() const override;
+    const char* getRenderer() const override;
+    const char* getVersion() const override;
+
+    /// Every feature is reported as supported, so the engine takes its usual paths.
+    bool checkForFeatureSupported(FeatureType feature) override;
+
+    Counters& getCounters() { return _counters; }
+    const Counters& getCounters() const { return _counters; }
+
+    /// Resets the frame, draw and upload counters, e.g. before a benchmark starts.
+    void resetCounters();
+
+protected:
+    ShaderModule* newShaderModule(ShaderStage stage, std::string_view source) override;
+
+    Counters _counters;
+};
+
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TextureNull.h"
+#include "DriverNull.h"
+
+NS_AX_BACKEND_BEGIN
+
+Texture2DNull::Texture2DNull(DriverNull* driver, const TextureDescriptor& descriptor) : _driver(driver)
+{
+    updateTextureDescriptor(descriptor);
+    ++_driver->getCounters().liveTextures;
+}
+
+Texture2DNull::~Texture2DNull()
+{
+    --_driver->getCounters().liveTextures;
+}
+
+void Texture2DNull::updateData(uint8_t* data, std::size_t width, std::size_t height, std::size_t level, int index)
+{
+    if (data)
+        _driver->getCounters().textureUploads += width * height * _bitsPerPixel / 8;
+}
+
+void Texture2DNull::updateCompressedData(uint8_t* data,
+                                         std::size_t width,
+                                         std::size_t height,
+                                         std::size_t dataLen,
+                                         std::size_t level,
+                                         int index)
+{
+    _driver->getCounters().textureUploads += dataLen;
+}
+
+void Texture2DNull::updateSubData(std::size_t xoffset,
+                                  std::size_t yoffset,
+                                  std::size_t width,
+                                  std::size_t height,
+                                  std::size_t level,
+                                  uint8_t* data,
+                                  int index)
+{
+    _driver->getCounters().textureUploads += width * height * _bitsPerPixel / 8;
+}
+
+void Texture2DNull::updateCompressedSubData(std::size_t xoffset,
+                                            std::size_t yoffset,
+                                            std::size_t width,
+                                            std::size_t height,
+                                            std::size_t dataLen,
+                                            std::size_t level,
+                                            uint8_t* data,
+                                            int index)
+{
+    _driver->getCounters().textureUploads += dataLen;
+}
+
+void Texture2DNull::generateMipmaps()
+{
+    _hasMipmaps = true;
+}
+
+TextureCubeNull::TextureCubeNull(DriverNull* driver, const TextureDescriptor& descriptor) : _driver(driver)
+{
+    updateTextureDescriptor(descriptor);
+    ++_driver->getCounters().liveTextures;
+}
+
+TextureCubeNull::~TextureCubeNull()
+{
+    --_driver->getCounters().liveTextures;
+}
+
+void TextureCubeNull::updateFaceData(TextureCubeFace side, void* data, int index)
+{
+    _driver->getCounters().textureUploads += static_cast<uint64_t>(_width) * _height * _bitsPerPixel / 8;
+}
+
+void TextureCubeNull::updateFaceLevelData(TextureCubeFace side,
+                                          const void* data,
+                                          std::size_t dataLen,
+                                          int level,
+                                          int index)
+{
+    _driver->getCounters().textureUploads += dataLen;
+}
+
+void TextureCubeNull::generateMipmaps()
+{
+    _hasMipmaps = true;
+}
+
+NS_AX_BACKEND_END
@@ -138,4 +138,176 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     }
 }
 
+// RingBufferGL
+
+#if defined(GL_ARB_buffer_storage) || defined(GL_EXT_buffer_storage)
+#    define AX_GL_HAS_BUFFER_STORAGE 1
+#else
+#    define AX_GL_HAS_BUFFER_STORAGE 0
+#endif
+
+RingBufferGL::RingBufferGL(std::size_t pageSize, BufferType type, bool persistent)
+    : BufferGL(pageSize, type, BufferUsage::DYNAMIC), _persistent(persistent && AX_GL_HAS_BUFFER_STORAGE)
+{
+    _needDefaultStoredData = false;
+
+    // the first page adopts the buffer object created by BufferGL
+    _pages.resize(INITIAL_PAGE_COUNT);
+    _pages[0].buffer = _buffer;
+    for (auto&& page : _pages)
+        createPage(page);
+}
+
+RingBufferGL::~RingBufferGL()
+{
+    for (auto&& page : _pages)
+        destroyPage(page);
+    _buffer = 0;
+}
+
+void RingBufferGL::createPage(Page& page)
+{
+    if (!page.buffer)
+        glGenBuffers(1, &page.buffer);
+
+    auto target = __gl->bindBuffer(_type, page.buffer);
+    if (_persistent)
+    {
+#if AX_GL_HAS_BUFFER_STORAGE
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+#    if AX_GLES_PROFILE
+        glBufferStorageEXT(target, _size, nullptr, flags);
+#    else
+        glBufferStorage(target, _size, nullptr, flags);
+#    endif
+        page.data = static_cast<uint8_t*>(glMapBufferRange(target, 0, _size, flags));
+#endif
+    }
+    else
+        glBufferData(target, _size, nullptr, GL_STREAM_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void RingBufferGL::destroyPage(Page& page)
+{
+    if (page.fence)
+        glDeleteSync(page.fence);
+    if (page.data)
+        glUnmapBuffer(__gl->bindBuffer(_type, page.buffer));
+    if (page.buffer)
+        __gl->deleteBuffer(_type, page.buffer);
+    page = Page{};
+}
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+void RingBufferGL::reloadBuffer()
+{
+    // all GL objects are gone with the context
+    for (auto&& page : _pages)
+    {
+        page = Page{};
+        createPage(page);
+    }
+    _pageOffset = 0;
+    _mapped     = false;
+    _buffer     = _pages[_currentPage].buffer;
+}
+#endif
+
+void RingBufferGL::updateData(const void* /*data*/, std::size_t /*size*/)
+{
+    AXASSERT(false, "The data of a ring buffer must be written with mapRange");
+}
+
+void RingBufferGL::updateSubData(const void* /*data*/, std::size_t /*offset*/, std::size_t /*size*/)
+{
+    AXASSERT(false, "The data of a ring buffer must be written with mapRange");
+}
+
+bool RingBufferGL::acquireNextPage()
+{
+    auto next  = (_currentPage + 1) % _pages.size();
+    auto busy  = [this](const Page& page) {
+        return page.usedInFrame || (page.fence && glClientWaitSync(page.fence, 0, 0) == GL_TIMEOUT_EXPIRED);
+    };
+
+    if (busy(_pages[next]))
+    {
+        if (_pages.size() < MAX_PAGE_COUNT)
+        {
+            // grow rather than stall, the new page is the next one of the ring
+            _pages.insert(_pages.begin() + next, Page{});
+            createPage(_pages[next]);
+        }
+        else if (_pages[next].usedInFrame)
+            return false;  // the whole ring is written by this frame, the caller falls back to a copy
+        else
+            glClientWaitSync(_pages[next].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    }
+
+    auto& page = _pages[next];
+    if (page.fence)
+    {
+        glDeleteSync(page.fence);
+        page.fence = nullptr;
+    }
+
+    _currentPage = next;
+    _pageOffset  = 0;
+    return true;
+}
+
+void* RingBufferGL::mapRange(std::size_t size, std::size_t alignment, std::size_t& offset)
+{
+    AXASSERT(!_mapped, "unmapRange should be invoked before mapping another range");
+    if (size == 0 || size > _size)
+        return nullptr;
+
+    auto aligned = (_pageOffset + alignment - 1) / alignment * alignment;
+    if (aligned + size > _size)
+    {
+        if (!acquireNextPage())
+            return nullptr;
+        aligned = 0;
+    }
+
+    auto& page       = _pages[_currentPage];
+    page.usedInFrame = true;
+    _buffer          = page.buffer;
+    _pageOffset      = aligned + size;
+    offset           = aligned;
+
+    if (_persistent)
+        return page.data + aligned;
+
+    // the range was never used by a draw in flight, so no synchronization is needed
+    auto data = glMapBufferRange(__gl->bindBuffer(_type, page.buffer), aligned, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    _mapped   = data != nullptr;
+    return data;
+}
+
+void RingBufferGL::unmapRange()
+{
+    // the persistent mapping is coherent, nothing to flush
+    if (_mapped)
+    {
+        glUnmapBuffer(__gl->bindBuffer(_type, _buffer));
+        _mapped = false;
+    }
+}
+
+void RingBufferGL::endFrame()
+{
+    for (auto&& page : _pages)
+    {
+        if (!page.usedInFrame)
+            continue;
+        if (page.fence)
+            glDeleteSync(page.fence);
+        page.fence       = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        page.usedInFrame = false;
+    }
+}
+
 NS_AX_BACKEND_END
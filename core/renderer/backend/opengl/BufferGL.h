@@ -84,9 +84,9 @@ public:
      */
     inline GLuint getHandler() const { return _buffer; }
 
-private:
+protected:
 #if AX_ENABLE_CACHE_TEXTURE_DATA
-    void reloadBuffer();
+    virtual void reloadBuffer();
     void fillBuffer(const void* data, std::size_t offset, std::size_t size);
 
     bool _bufferAlreadyFilled                      = false;
@@ -97,6 +97,59 @@ private:
     char* _data                  = nullptr;
     bool _needDefaultStoredData  = true;
 };
+
+/**
+ * A ring of pages for data streamed every frame, see `Buffer::mapRange`.
+ * Pages are persistently mapped with glBufferStorage (OpenGL 4.4, ARB/EXT_buffer_storage), or mapped
+ * unsynchronized with glMapBufferRange otherwise. A page is fenced at the end of every frame which wrote it and
+ * only reused once the fence signaled, a new page is added instead of waiting for the GPU.
+ * The handler is the page of the last mapped region, so it must be bound after `mapRange`.
+ */
+class RingBufferGL : public BufferGL
+{
+public:
+    /**The pages created up front, one per frame in flight.*/
+    static const int INITIAL_PAGE_COUNT = 3;
+    /**The max number of pages, beyond it the ring waits for the GPU.*/
+    static const int MAX_PAGE_COUNT = 8;
+
+    RingBufferGL(std::size_t pageSize, BufferType type, bool persistent);
+    ~RingBufferGL();
+
+    /** Not supported, the data of a ring buffer is written with `mapRange`. */
+    void updateData(const void* data, std::size_t size) override;
+    /** Not supported, the data of a ring buffer is written with `mapRange`. */
+    void updateSubData(const void* data, std::size_t offset, std::size_t size) override;
+
+    void* mapRange(std::size_t size, std::size_t alignment, std::size_t& offset) override;
+    void unmapRange() override;
+    void endFrame() override;
+
+    bool isPersistent() const { return _persistent; }
+
+protected:
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    void reloadBuffer() override;
+#endif
+
+    struct Page
+    {
+        GLuint buffer    = 0;
+        uint8_t* data    = nullptr;  // the persistent mapping
+        GLsync fence     = nullptr;  // signaled when the GPU is done with the frames which wrote the page
+        bool usedInFrame = false;
+    };
+
+    void createPage(Page& page);
+    void destroyPage(Page& page);
+    bool acquireNextPage();
+
+    std::vector<Page> _pages;
+    std::size_t _currentPage = 0;
+    std::size_t _pageOffset  = 0;
+    bool _persistent         = false;
+    bool _mapped             = false;
+};
 // end of _opengl group
 ///> @}
 NS_AX_BACKEND_END
@@ -64,6 +64,7 @@ CommandBufferGL::CommandBufferGL() {}
 CommandBufferGL::~CommandBufferGL()
 {
     cleanResources();
+    AX_SAFE_RELEASE_NULL(_currentRenderTarget);
 }
 
 bool CommandBufferGL::beginFrame()
@@ -75,6 +76,19 @@ void CommandBufferGL::beginRenderPass(const RenderTarget* rt, const RenderPassDe
 {
     auto rtGL = static_cast<const RenderTargetGL*>(rt);
 
+    // each draw is a render pass of its own, the transient attachments are only done with once the target changes
+    if (rt != _currentRenderTarget)
+    {
+        releaseRenderTarget();
+        _currentRenderTarget = const_cast<RenderTarget*>(rt);
+        _currentRenderTarget->retain();
+
+        // the content of the attachments the passes overwrite is never loaded
+        rtGL->bindFrameBuffer();
+        rtGL->update();
+        invalidateAttachments(rt->getOverwrittenAttachments());
+    }
+
     rtGL->bindFrameBuffer();
     rtGL->update();
 
@@ -296,7 +310,82 @@ void CommandBufferGL::endRenderPass()
     AX_SAFE_RELEASE_NULL(_instanceTransformBuffer);
 }
 
-void CommandBufferGL::endFrame() {}
+void CommandBufferGL::releaseRenderTarget()
+{
+    if (!_currentRenderTarget)
+        return;
+
+    // the transient attachments are done with once the target changes
+    static_cast<RenderTargetGL*>(_currentRenderTarget)->bindFrameBuffer();
+    invalidateAttachments(_currentRenderTarget->getTransientAttachments());
+    AX_SAFE_RELEASE_NULL(_currentRenderTarget);
+}
+
+void CommandBufferGL::invalidateAttachments(TargetBufferFlags flags)
+{
+    if (_currentRenderTarget->isDefaultRenderTarget() || !flags)
+        return;
+
+    GLenum attachments[MAX_COLOR_ATTCHMENT + 2];
+    GLsizei count = 0;
+    for (int i = 0; i < MAX_COLOR_ATTCHMENT; ++i)
+        if (bitmask::any(flags, getMRTColorFlag(i)))
+            attachments[count++] = GL_COLOR_ATTACHMENT0 + i;
+    if (bitmask::any(flags, TargetBufferFlags::DEPTH))
+        attachments[count++] = GL_DEPTH_ATTACHMENT;
+    if (bitmask::any(flags, TargetBufferFlags::STENCIL))
+        attachments[count++] = GL_STENCIL_ATTACHMENT;
+
+    auto driver = static_cast<DriverGL*>(DriverBase::getInstance());
+#if AX_GLES_PROFILE != 200
+    if (driver->isInvalidateFramebufferSupported())
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments);
+    else if (driver->isDiscardFramebufferSupported())
+        glDiscardFramebufferEXT(GL_FRAMEBUFFER, count, attachments);
+#else
+    if (driver->isDiscardFramebufferSupported())
+        glDiscardFramebufferEXT(GL_FRAMEBUFFER, count, attachments);
+#endif
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void CommandBufferGL::endFrame()
+{
+    releaseRenderTarget();
+
+    _elidedStateCalls = __gl->getElidedCalls();
+    __gl->clearElidedCalls();
+
+    if (_gpuTimer)
+        _gpuTimer->endFrame();
+}
+
+bool CommandBufferGL::isGPUTimerSupported() const
+{
+    return static_cast<DriverGL*>(DriverBase::getInstance())->isGPUTimerSupported();
+}
+
+void CommandBufferGL::beginGPUTimer(std::string_view label)
+{
+    if (!_gpuTimer)
+    {
+        if (!isGPUTimerSupported())
+            return;
+        _gpuTimer = std::make_unique<GPUTimerGL>(static_cast<DriverGL*>(DriverBase::getInstance())->isGLES());
+    }
+    _gpuTimer->begin(label);
+}
+
+void CommandBufferGL::endGPUTimer()
+{
+    if (_gpuTimer)
+        _gpuTimer->end();
+}
+
+bool CommandBufferGL::getGPUTimerResults(std::vector<GPUTimerSample>& samples)
+{
+    return _gpuTimer && _gpuTimer->getResults(samples);
+}
 
 void CommandBufferGL::prepareDrawing() const
 {
@@ -341,9 +430,9 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
     {
         const auto& attribute = attributeInfo.second;
         __gl->enableVertexAttribArray(attribute.index);
-        glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
-                              UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
-                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+        __gl->vertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                                  UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                                  vertexLayout->getStride(), (GLvoid*)attribute.offset);
         // non-instance attrib not use divisor, so clear to 0
         __gl->clearVertexAttribDivisor(attribute.index);
         usedBits |= (1 << attribute.index);
@@ -364,8 +453,8 @@ void CommandBufferGL::bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits)
             {
                 auto elementLoc = instanceLoc + i;
                 __gl->enableVertexAttribArray(elementLoc);
-                glVertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
-                                      (void*)(sizeof(float) * 4 * i));
+                __gl->vertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                                          (void*)(sizeof(float) * 4 * i));
                 __gl->setVertexAttribDivisor(elementLoc);
                 usedBits |= (1 << elementLoc);
             }
@@ -385,11 +474,10 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
         auto& uniformInfos = program->getAllActiveUniformInfo(ShaderStage::VERTEX);
 
-        std::size_t bufferSize = 0;
-        auto buffer            = _programState->getVertexUniformBuffer(bufferSize);
-        program->bindUniformBuffers(buffer, bufferSize);
+        program->bindUniformBuffers(_programState);
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
+        auto frame              = Director::getInstance()->getTotalFrames();
         for (const auto& iter : textureInfo)
         {
             /* About mutli textures support
@@ -409,14 +497,11 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
             for (const auto& texture : textures)
             {
                 applyTexture(texture, slots[i], indexs[i]);
+                texture->markUsed(frame);
                 ++i;
             }
 
-            auto arrayCount = slots.size();
-            if (arrayCount == 1)  // Most of the time， not use sampler2DArray, should be 1
-                glUniform1i(location, slots[0]);
-            else
-                glUniform1iv(location, static_cast<GLsizei>(arrayCount), static_cast<const GLint*>(slots.data()));
+            program->setSamplerSlots(location, slots.data(), slots.size());
         }
     }
 }
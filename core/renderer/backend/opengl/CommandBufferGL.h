@@ -29,6 +29,7 @@
 #include "../CommandBuffer.h"
 #include "base/EventListenerCustom.h"
 #include "platform/GL.h"
+#include "GPUTimerGL.h"
 
 #include "StdC.h"
 
@@ -190,6 +191,16 @@ public:
      */
     void endFrame() override;
 
+    /**
+     * The number of GL state calls skipped in the last frame because they wouldn't change the current state.
+     */
+    std::size_t getElidedStateCalls() const override { return _elidedStateCalls; }
+
+    bool isGPUTimerSupported() const override;
+    void beginGPUTimer(std::string_view label) override;
+    void endGPUTimer() override;
+    bool getGPUTimerResults(std::vector<GPUTimerSample>& samples) override;
+
     /**
      * Fixed-function state
      * @param x, y Specifies the lower left corner of the scissor box
@@ -224,6 +235,8 @@ protected:
     virtual void bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits) const;
     void bindUniforms(ProgramGL* program) const;
     void cleanResources();
+    void releaseRenderTarget();
+    void invalidateAttachments(TargetBufferFlags flags);
 
     BufferGL* _vertexBuffer                   = nullptr;
     ProgramState* _programState               = nullptr;
@@ -234,6 +247,9 @@ protected:
     DepthStencilStateGL* _depthStencilStateGL = nullptr;
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
+    std::size_t _elidedStateCalls             = 0;
+    std::unique_ptr<GPUTimerGL> _gpuTimer;
+    RenderTarget* _currentRenderTarget        = nullptr;
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
@@ -33,8 +33,10 @@
 #include "ProgramGL.h"
 #include "DriverGL.h"
 #include "RenderTargetGL.h"
+#include "GPUTimerGL.h"
 #include "MacrosGL.h"
 #include "renderer/backend/ProgramManager.h"
+#include "renderer/backend/null/DriverNull.h"
 #if !defined(__APPLE__) && AX_TARGET_PLATFORM != AX_PLATFORM_WINRT
 #    include "CommandBufferGLES2.h"
 #endif
@@ -84,7 +86,12 @@ static void GL_EnumAllExtensions(_Fty&& func)
 DriverBase* DriverBase::getInstance()
 {
     if (!_instance)
-        _instance = new DriverGL();
+    {
+        if (_nullDriverEnabled)
+            _instance = new DriverNull();
+        else
+            _instance = new DriverGL();
+    }
 
     return _instance;
 }
@@ -169,6 +176,41 @@ DriverGL::DriverGL()
 
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_defaultFBO);
 
+#if AX_GLES_PROFILE != 200
+    // program binaries: core in GL 4.1, GLES 3.0
+    if ((_verInfo.es ? _verInfo.major >= 3 : (_verInfo.major > 4 || (_verInfo.major == 4 && _verInfo.minor >= 1))) ||
+        hasExtension("GL_ARB_get_program_binary"sv))
+    {
+        GLint numBinaryFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+        _programBinarySupported = numBinaryFormats > 0;
+    }
+#endif
+
+    if (glMaxShaderCompilerThreadsKHR && hasExtension("GL_KHR_parallel_shader_compile"sv))
+    {
+        // let the driver choose the count of compiler threads
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        _parallelShaderCompile = true;
+    }
+
+#if AX_GLES_PROFILE != 200
+    // core in GL 4.3, GLES 3.0
+    if (glInvalidateFramebuffer)
+        _invalidateFramebuffer = _verInfo.es ? _verInfo.major >= 3
+                                             : (_verInfo.major > 4 || (_verInfo.major == 4 && _verInfo.minor >= 3) ||
+                                                hasExtension("GL_ARB_invalidate_subdata"sv));
+#endif
+    if (_verInfo.es && glDiscardFramebufferEXT)
+        _discardFramebuffer = hasExtension("GL_EXT_discard_framebuffer"sv);
+
+#if AX_GL_TIMER_QUERY
+    if (glQueryCounter && glGetQueryObjectui64v)
+        _gpuTimerSupported = _verInfo.es ? hasExtension("GL_EXT_disjoint_timer_query"sv)
+                                         : (_verInfo.major > 3 || (_verInfo.major == 3 && _verInfo.minor >= 3) ||
+                                            hasExtension("GL_ARB_timer_query"sv));
+#endif
+
 #if AX_GLES_PROFILE != 200
     glGenVertexArrays(1, &_defaultVAO);
     glBindVertexArray(_defaultVAO);
@@ -200,6 +242,21 @@ Buffer* DriverGL::newBuffer(std::size_t size, BufferType type, BufferUsage usage
     return new BufferGL(size, type, usage);
 }
 
+Buffer* DriverGL::newRingBuffer(std::size_t pageSize, BufferType type)
+{
+#if AX_GLES_PROFILE != 200
+    // glMapBufferRange and fences are core since OpenGL 3.0 and OpenGL ES 3.0
+    if (_verInfo.major >= 3)
+    {
+        bool persistent = _verInfo.es ? hasExtension("GL_EXT_buffer_storage"sv)
+                                      : (_verInfo.major > 4 || (_verInfo.major == 4 && _verInfo.minor >= 4) ||
+                                         hasExtension("GL_ARB_buffer_storage"sv));
+        return new RingBufferGL(pageSize, type, persistent);
+    }
+#endif
+    return nullptr;
+}
+
 TextureBackend* DriverGL::newTexture(const TextureDescriptor& descriptor)
 {
     switch (descriptor.textureType)
@@ -252,6 +309,11 @@ Program* DriverGL::newProgram(std::string_view vertexShader, std::string_view fr
     return new ProgramGL(vertexShader, fragmentShader);
 }
 
+bool DriverGL::prepareProgram(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    return ProgramGL::prepare(vertexShader, fragmentShader);
+}
+
 void DriverGL::resetState()
 {
     OpenGLState::reset();
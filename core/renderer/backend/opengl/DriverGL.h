@@ -63,6 +63,15 @@ public:
      */
     Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
 
+    /**
+     * New a ring Buffer object, persistently mapped when the driver supports buffer storage,
+     * otherwise mapped unsynchronized and guarded by fences.
+     * @param pageSize Specifies the size in bytes of one page.
+     * @param type Specifies the target buffer object.
+     * @return A Buffer object, or nullptr for OpenGL ES 2.0 which can't map buffers.
+     */
+    Buffer* newRingBuffer(std::size_t pageSize, BufferType type) override;
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -97,6 +106,12 @@ public:
      */
     Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
 
+    /**
+     * Compile the shaders in background threads with KHR_parallel_shader_compile, never needed when the program
+     * binary is cached.
+     */
+    bool prepareProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
+
     void resetState() override;
 
     /// below is driver info API
@@ -143,6 +158,33 @@ public:
     */
     bool isGLES2Only() const;
 
+    /*
+     * Check whether linked programs can be retrieved and reloaded with glGetProgramBinary/glProgramBinary
+     */
+    bool isProgramBinarySupported() const { return _programBinarySupported; }
+
+    /*
+     * Check whether the driver compiles shaders in background threads, KHR_parallel_shader_compile
+     */
+    bool isParallelShaderCompileSupported() const { return _parallelShaderCompile; }
+
+    /*
+     * Check whether GPU timestamps can be queried, GL_ARB_timer_query or GL_EXT_disjoint_timer_query
+     */
+    bool isGPUTimerSupported() const { return _gpuTimerSupported; }
+
+    /*
+     * Check whether the content of the framebuffer attachments can be discarded, glInvalidateFramebuffer or
+     * GL_EXT_discard_framebuffer
+     */
+    bool isInvalidateFramebufferSupported() const { return _invalidateFramebuffer; }
+    bool isDiscardFramebufferSupported() const { return _discardFramebuffer; }
+
+    /*
+     * Check whether the context is an OpenGL ES one
+     */
+    bool isGLES() const { return _verInfo.es; }
+
 protected:
     /**
      * New a shaderModule, not auto released.
@@ -172,6 +214,11 @@ private:
 
     bool _textureCompressionAstc = false;
     bool _textureCompressionEtc2 = false;
+    bool _programBinarySupported = false;
+    bool _parallelShaderCompile  = false;
+    bool _gpuTimerSupported      = false;
+    bool _invalidateFramebuffer  = false;
+    bool _discardFramebuffer     = false;
 };
 // end of _opengl group
 /// @}
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "GPUTimerGL.h"
+#include "MacrosGL.h"
+
+NS_AX_BACKEND_BEGIN
+
+GPUTimerGL::GPUTimerGL(bool checkDisjoint) : _checkDisjoint(checkDisjoint) {}
+
+GPUTimerGL::~GPUTimerGL()
+{
+    recycle(_current);
+    for (auto&& frame : _pending)
+        recycle(frame);
+#if AX_GL_TIMER_QUERY
+    if (!_freeQueries.empty())
+        glDeleteQueries(static_cast<GLsizei>(_freeQueries.size()), _freeQueries.data());
+#endif
+}
+
+GLuint GPUTimerGL::issueTimestamp()
+{
+    GLuint query = 0;
+#if AX_GL_TIMER_QUERY
+    if (_freeQueries.empty())
+    {
+        GLuint queries[32];
+        glGenQueries(32, queries);
+        _freeQueries.insert(_freeQueries.end(), std::begin(queries), std::end(queries));
+    }
+    query = _freeQueries.back();
+    _freeQueries.pop_back();
+
+    glQueryCounter(query, GL_TIMESTAMP);
+    CHECK_GL_ERROR_DEBUG();
+#endif
+    _current.lastQuery = query;
+    return query;
+}
+
+void GPUTimerGL::recycle(Frame& frame)
+{
+    for (auto&& scope : frame.scopes)
+    {
+        _freeQueries.emplace_back(scope.beginQuery);
+        if (scope.endQuery)
+            _freeQueries.emplace_back(scope.endQuery);
+    }
+    frame.scopes.clear();
+    frame.lastQuery = 0;
+}
+
+void GPUTimerGL::begin(std::string_view label)
+{
+    _openScopes.emplace_back(_current.scopes.size());
+    auto& scope      = _current.scopes.emplace_back();
+    scope.label      = label;
+    scope.depth      = static_cast<int>(_openScopes.size()) - 1;
+    scope.beginQuery = issueTimestamp();
+}
+
+void GPUTimerGL::end()
+{
+    AXASSERT(!_openScopes.empty(), "GPU timer end without begin");
+    if (_openScopes.empty())
+        return;
+
+    _current.scopes[_openScopes.back()].endQuery = issueTimestamp();
+    _openScopes.pop_back();
+}
+
+void GPUTimerGL::endFrame()
+{
+    AXASSERT(_openScopes.empty(), "GPU timer scopes must be ended in the frame they are begun in");
+    while (!_openScopes.empty())
+        end();
+
+    if (_current.scopes.empty())
+        return;
+
+    _pending.emplace_back(std::move(_current));
+    _current = Frame{};
+    if (_pending.size() > MAX_PENDING_FRAMES)
+    {
+        recycle(_pending.front());
+        _pending.pop_front();
+    }
+}
+
+bool GPUTimerGL::getResults(std::vector<GPUTimerSample>& samples)
+{
+#if AX_GL_TIMER_QUERY
+    if (_checkDisjoint)
+    {
+        // the timestamps issued before a disjoint operation, e.g. a frequency change, are meaningless
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (disjoint)
+        {
+            for (auto&& frame : _pending)
+                recycle(frame);
+            _pending.clear();
+            return false;
+        }
+    }
+
+    bool found = false;
+    while (!_pending.empty())
+    {
+        auto& frame      = _pending.front();
+        GLuint available = 0;
+        glGetQueryObjectuiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        samples.resize(frame.scopes.size());
+        for (size_t i = 0; i < frame.scopes.size(); ++i)
+        {
+            auto& scope = frame.scopes[i];
+            GLuint64 beginTime = 0, endTime = 0;
+            glGetQueryObjectui64v(scope.beginQuery, GL_QUERY_RESULT, &beginTime);
+            glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &endTime);
+
+            samples[i].label        = std::move(scope.label);
+            samples[i].depth        = scope.depth;
+            samples[i].milliseconds = endTime > beginTime ? (endTime - beginTime) / 1e6 : 0.0;
+        }
+        CHECK_GL_ERROR_DEBUG();
+
+        recycle(frame);
+        _pending.pop_front();
+        found = true;
+    }
+    return found;
+#else
+    return false;
+#endif
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "../CommandBuffer.h"
+#include "platform/GL.h"
+
+#include <deque>
+#include <string_view>
+#include <vector>
+
+// timestamp queries: GL_ARB_timer_query, core in OpenGL 3.3, or GL_EXT_disjoint_timer_query on OpenGL ES
+#if defined(GL_TIMESTAMP) && defined(GL_GPU_DISJOINT_EXT)
+#    define AX_GL_TIMER_QUERY 1
+#else
+#    define AX_GL_TIMER_QUERY 0
+#endif
+
+NS_AX_BACKEND_BEGIN
+
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * Measures the GPU time of nested scopes with timestamp queries. The queries of a frame are read once the GPU
+ * finished it, without blocking, a few frames are kept in flight.
+ */
+class GPUTimerGL
+{
+public:
+    /** The frames kept in flight, older ones are dropped when the results aren't read. */
+    static const size_t MAX_PENDING_FRAMES = 4;
+
+    /** @param checkDisjoint Whether the results may be invalidated by a disjoint operation, OpenGL ES. */
+    explicit GPUTimerGL(bool checkDisjoint);
+    ~GPUTimerGL();
+
+    void begin(std::string_view label);
+    void end();
+    void endFrame();
+
+    bool getResults(std::vector<GPUTimerSample>& samples);
+
+private:
+    struct Scope
+    {
+        std::string label;
+        int depth         = 0;
+        GLuint beginQuery = 0;
+        GLuint endQuery   = 0;
+    };
+
+    struct Frame
+    {
+        std::vector<Scope> scopes;
+        GLuint lastQuery = 0;  ///< the last issued query, the frame is finished when it's available
+    };
+
+    GLuint issueTimestamp();
+    void recycle(Frame& frame);
+
+    Frame _current;
+    std::vector<size_t> _openScopes;
+    std::deque<Frame> _pending;
+    std::vector<GLuint> _freeQueries;
+    bool _checkDisjoint = false;
+};
+
+// end of _opengl group
+/// @}
+
+NS_AX_BACKEND_END
@@ -98,6 +98,37 @@ struct CommonBindState
     GLuint handle;
 };
 
+struct ScissorBoxState
+{
+    ScissorBoxState(GLint x, GLint y, GLsizei w, GLsizei h) : x(x), y(y), width(w), height(h) {}
+    inline bool equals(GLint x, GLint y, GLsizei w, GLsizei h) const
+    {
+        return this->x == x && this->y == y && this->width == w && this->height == h;
+    }
+    GLint x;
+    GLint y;
+    GLsizei width;
+    GLsizei height;
+};
+
+struct VertexAttribPointerState
+{
+    VertexAttribPointerState(GLuint b, GLint s, GLenum t, GLboolean n, GLsizei st, const void* o)
+        : buffer(b), size(s), type(t), normalized(n), stride(st), offset(o)
+    {}
+    inline bool equals(GLuint b, GLint s, GLenum t, GLboolean n, GLsizei st, const void* o) const
+    {
+        return this->buffer == b && this->size == s && this->type == t && this->normalized == n &&
+               this->stride == st && this->offset == o;
+    }
+    GLuint buffer;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLsizei stride;
+    const void* offset;
+};
+
 struct UniformBufferBaseBindState
 {
     UniformBufferBaseBindState(GLenum i, GLuint h) : index(i), handle(h) {}
@@ -120,72 +151,72 @@ struct OpenGLState
     constexpr static int MAX_TEXTURE_UNITS  = 16;
 
     template <typename _Left>
-    static inline void try_enable(GLenum target, _Left& opt)
+    inline void try_enable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt.has_value() && opt.value())
-            return;
+            return countElidedCalls();
         opt = true;
 #endif
         glEnable(target);
     }
     template <typename _Left>
-    static inline void try_disable(GLenum target, _Left& opt)
+    inline void try_disable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (!opt.has_value() || !opt.value())
-            return;
+            return countElidedCalls();
         opt = false;
 #endif
         glDisable(target);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_call(_Func&& func, _Left& opt, _Right&& v)
+    inline void try_call(_Func&& func, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return countElidedCalls();
         opt = v;
 #endif
         func(v);
     }
     template <typename _Func, typename _Left, typename _Right, typename... _Args>
-    static inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
+    inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return countElidedCalls();
         opt = v;
 #endif
         func(args...);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
+    inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return countElidedCalls();
         opt = v;
 #endif
         func(target, v);
     }
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
+    inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return countElidedCalls();
         opt.emplace(args...);
 #endif
         func(args...);
     }
 
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
+    inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return countElidedCalls();
         opt.emplace(args...);
 #endif
         func(upvalue, args...);
@@ -206,7 +237,7 @@ struct OpenGLState
     void enableScissor(GLint x, GLint y, GLsizei width, GLsizei height)
     {
         try_enable(GL_SCISSOR_TEST, _scissor);
-        glScissor(x, y, width, height);
+        try_callx(glScissor, _scissorBox, x, y, width, height);
     }
     void disableScissor() { try_disable(GL_SCISSOR_TEST, _scissor); }
     void lineWidth(float v) { try_call(glLineWidth, _lineWidth, v); }
@@ -230,7 +261,7 @@ struct OpenGLState
     void enableCullFace(GLenum mode)
     {
         try_enable(GL_CULL_FACE, _cullFace);
-        glCullFace(mode);
+        try_call(glCullFace, _cullFaceMode, mode);
     }
     void disableCullFace() { try_disable(GL_CULL_FACE, _cullFace); }
     void useProgram(GLuint v) { try_call(glUseProgram, _programBind, v); }
@@ -286,6 +317,16 @@ struct OpenGLState
         glDeleteBuffers(1, &buffer);
         if (_bufferBindings[static_cast<int>(type)] == buffer)
             _bufferBindings[static_cast<int>(type)].reset();
+
+        // deleting a buffer detaches it from the attributes of the bound VAO
+        if (type == BufferType::ARRAY_BUFFER)
+        {
+            for (auto& attribPointer : _vertexAttribPointers)
+            {
+                if (attribPointer.has_value() && attribPointer->buffer == buffer)
+                    attribPointer.reset();
+            }
+        }
     }
     void bindUniformBufferBase(GLuint index, GLuint handle)
     {
@@ -300,6 +341,27 @@ struct OpenGLState
     {
         _bufferBindings[static_cast<int>(BufferType::ARRAY_BUFFER)].reset();
         _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+        for (auto& attribPointer : _vertexAttribPointers)
+            attribPointer.reset();
+    }
+
+    // the attribute state includes the ARRAY_BUFFER bound when it was specified
+    void vertexAttribPointer(GLuint index,
+                             GLint size,
+                             GLenum type,
+                             GLboolean normalized,
+                             GLsizei stride,
+                             const void* offset)
+    {
+        if (index < MAX_VERTEX_ATTRIBS)
+        {
+            auto buffer         = _bufferBindings[static_cast<int>(BufferType::ARRAY_BUFFER)].value_or(0);
+            auto& attribPointer = _vertexAttribPointers[index];
+            if (attribPointer && attribPointer->equals(buffer, size, type, normalized, stride, offset))
+                return countElidedCalls();
+            attribPointer.emplace(buffer, size, type, normalized, stride, offset);
+        }
+        glVertexAttribPointer(index, size, type, normalized, stride, offset);
     }
 
     void enableVertexAttribArray(GLuint index)
@@ -310,6 +372,8 @@ struct OpenGLState
             glEnableVertexAttribArray(index);
             _attribBits |= mask;
         }
+        else
+            countElidedCalls();
     }
 
     void disableVertexAttribArray(GLuint index)
@@ -376,6 +440,8 @@ struct OpenGLState
 #endif
             _divisorBits |= mask;
         }
+        else
+            countElidedCalls();
     }
 
     void clearVertexAttribDivisor(GLuint index)
@@ -391,19 +457,32 @@ struct OpenGLState
 #endif
             _divisorBits &= ~mask;
         }
+        else
+            countElidedCalls();
     }
 
+    /**
+     * Count GL calls skipped because they wouldn't change the current state, also used by the state caches outside
+     * OpenGLState, i.e. the uniforms of ProgramGL.
+     */
+    void countElidedCalls(uint32_t count = 1) { _elidedCalls += count; }
+    uint32_t getElidedCalls() const { return _elidedCalls; }
+    void clearElidedCalls() { _elidedCalls = 0; }
+
 private:
+    uint32_t _elidedCalls{0};
     uint32_t _attribBits{0}; // vertexAttribArray bitset
     uint32_t _divisorBits{0}; // divisor bitset
     std::optional<GLuint> _bufferBindings[(int)BufferType::COUNT];
     std::optional<CommonBindState> _textureBindings[MAX_TEXTURE_UNITS];
+    std::optional<VertexAttribPointerState> _vertexAttribPointers[MAX_VERTEX_ATTRIBS];
 
     std::optional<Viewport> _viewPort;
     std::optional<Winding> _winding;
     std::optional<bool> _depthTest;
     std::optional<bool> _blend;
     std::optional<bool> _scissor;
+    std::optional<ScissorBoxState> _scissorBox;
 
     std::optional<float> _lineWidth;
     std::optional<GLuint> _frameBufferBind;
@@ -414,6 +493,7 @@ private:
     std::optional<GLenum> _depthFunc;
     std::optional<bool> _stencilTest;
     std::optional<bool> _cullFace;
+    std::optional<GLenum> _cullFaceMode;
 
     std::optional<GLuint> _programBind;
     std::optional<StencilFuncState> _stencilFunc;
@@ -26,6 +26,10 @@
 #include "ProgramGL.h"
 #include "ShaderModuleGL.h"
 #include "renderer/backend/Types.h"
+#include "renderer/backend/ProgramState.h"
+#include "renderer/backend/ShaderCache.h"
+#include "renderer/backend/opengl/DriverGL.h"
+#include "platform/FileUtils.h"
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "base/Director.h"
 #include "base/EventDispatcher.h"
@@ -34,9 +38,47 @@
 #include "yasio/byte_buffer.hpp"
 #include "renderer/backend/opengl/UtilsGL.h"
 #include "OpenGLState.h"
+#include "xxhash/xxhash.h"
 
 NS_AX_BACKEND_BEGIN
 
+namespace
+{
+#if AX_GLES_PROFILE != 200
+struct ProgramBinaryHeader
+{
+    uint32_t magic;
+    uint32_t format;
+    uint64_t key;
+};
+
+constexpr uint32_t PROGRAM_BINARY_MAGIC = 0x42505841;  // AXPB
+
+// the binaries are only valid for the driver which produced them
+uint64_t computeProgramBinaryKey(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    static const uint64_t driverKey = [] {
+        auto driver = DriverBase::getInstance();
+        std::string driverInfo;
+        driverInfo.append(driver->getVendor() ? driver->getVendor() : "")
+            .append(driver->getRenderer() ? driver->getRenderer() : "")
+            .append(driver->getVersion() ? driver->getVersion() : "");
+        return XXH3_64bits(driverInfo.data(), driverInfo.size());
+    }();
+    auto key = XXH3_64bits_withSeed(vertexShader.data(), vertexShader.size(), driverKey);
+    return XXH3_64bits_withSeed(fragmentShader.data(), fragmentShader.size(), key);
+}
+
+std::string getProgramBinaryPath(uint64_t key)
+{
+    auto cachePath = DriverBase::getInstance()->getProgramBinaryCachePath();
+    if (cachePath.empty() || !static_cast<DriverGL*>(DriverBase::getInstance())->isProgramBinarySupported())
+        return {};
+    return fmt::format("{}{:016x}.bin", cachePath, key);
+}
+#endif
+}  // namespace
+
 #if AX_GLES_PROFILE == 200
 #    define DEF_TO_INT(pointer, index) (*((GLint*)(pointer) + index))
 #    define DEF_TO_FLOAT(pointer, index) (*((GLfloat*)(pointer) + index))
@@ -121,12 +163,7 @@ static void setUniform(bool isArray, GLuint location, unsigned int size, GLenum
 ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader)
     : Program(vertexShader, fragmentShader)
 {
-    _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
-    _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
-
-    AX_SAFE_RETAIN(_vertexShaderModule);
-    AX_SAFE_RETAIN(_fragmentShaderModule);
-    compileProgram();
+    createProgram();
     computeUniformInfos();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     for (const auto& uniform : _activeUniformInfos)
@@ -165,9 +202,19 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
-    static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
-    static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
-    compileProgram();
+    _samplerSlotHashes.clear();
+#    if AX_GLES_PROFILE == 200
+    _uniformDataHash = 0;
+#    endif
+    if (!loadProgramBinary())
+    {
+        // the shaders were lost with the context
+        ensureShaderModules();
+        _vertexShaderModule->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
+        _fragmentShaderModule->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
+        compileProgram();
+        saveProgramBinary();
+    }
     computeUniformInfos();
 
     for (const auto& uniform : _activeUniformInfos)
@@ -179,6 +226,117 @@ void ProgramGL::reloadProgram()
 }
 #endif
 
+void ProgramGL::createProgram()
+{
+    if (loadProgramBinary())
+        return;
+
+    ensureShaderModules();
+    compileProgram();
+    saveProgramBinary();
+}
+
+void ProgramGL::ensureShaderModules()
+{
+    if (!_vertexShaderModule)
+    {
+        _vertexShaderModule =
+            static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
+        AX_SAFE_RETAIN(_vertexShaderModule);
+    }
+    if (!_fragmentShaderModule)
+    {
+        _fragmentShaderModule =
+            static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
+        AX_SAFE_RETAIN(_fragmentShaderModule);
+    }
+}
+
+bool ProgramGL::prepare(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    auto driver = static_cast<DriverGL*>(DriverBase::getInstance());
+    if (!driver->isParallelShaderCompileSupported())
+        return true;
+
+#if AX_GLES_PROFILE != 200
+    auto binaryPath = getProgramBinaryPath(computeProgramBinaryKey(vertexShader, fragmentShader));
+    if (!binaryPath.empty() && FileUtils::getInstance()->isFileExist(binaryPath))
+        return true;
+#endif
+
+    // the shader cache issues the compilations once, they are checked by the program
+    auto shaderCache    = ShaderCache::getInstance();
+    auto vertexModule   = static_cast<ShaderModuleGL*>(shaderCache->newVertexShaderModule(vertexShader));
+    auto fragmentModule = static_cast<ShaderModuleGL*>(shaderCache->newFragmentShaderModule(fragmentShader));
+    return vertexModule->isCompileComplete() && fragmentModule->isCompileComplete();
+}
+
+bool ProgramGL::loadProgramBinary()
+{
+#if AX_GLES_PROFILE != 200
+    const auto key  = computeProgramBinaryKey(_vertexShader, _fragmentShader);
+    auto binaryPath = getProgramBinaryPath(key);
+    auto fileUtils  = FileUtils::getInstance();
+    if (binaryPath.empty() || !fileUtils->isFileExist(binaryPath))
+        return false;
+
+    auto data = fileUtils->getDataFromFile(binaryPath);
+    ProgramBinaryHeader header{};
+    if (data.getSize() > static_cast<ssize_t>(sizeof(header)))
+        memcpy(&header, data.getBytes(), sizeof(header));
+    if (header.magic == PROGRAM_BINARY_MAGIC && header.key == key)
+    {
+        _program = glCreateProgram();
+        glProgramBinary(_program, header.format, data.getBytes() + sizeof(header),
+                        static_cast<GLsizei>(data.getSize() - sizeof(header)));
+
+        GLint status = 0;
+        glGetProgramiv(_program, GL_LINK_STATUS, &status);
+        if (status != GL_FALSE)
+            return true;
+
+        glDeleteProgram(_program);
+        _program = 0;
+    }
+
+    // i.e. rejected by an updated driver, recompile it
+    AXLOGW("axmol: invalid program binary {}, recompiling the program", binaryPath);
+    fileUtils->removeFile(binaryPath);
+#endif
+    return false;
+}
+
+void ProgramGL::saveProgramBinary()
+{
+#if AX_GLES_PROFILE != 200
+    if (!_program)
+        return;
+
+    const auto key  = computeProgramBinaryKey(_vertexShader, _fragmentShader);
+    auto binaryPath = getProgramBinaryPath(key);
+    if (binaryPath.empty())
+        return;
+
+    GLint binaryLength = 0;
+    glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    Data data;
+    auto bytes = data.resize(sizeof(ProgramBinaryHeader) + binaryLength);
+    ProgramBinaryHeader header{PROGRAM_BINARY_MAGIC, 0, key};
+    glGetProgramBinary(_program, binaryLength, &binaryLength, &header.format, bytes + sizeof(header));
+    memcpy(bytes, &header, sizeof(header));
+
+    auto fileUtils = FileUtils::getInstance();
+    auto cachePath = DriverBase::getInstance()->getProgramBinaryCachePath();
+    if (!fileUtils->isDirectoryExist(cachePath))
+        fileUtils->createDirectories(cachePath);
+    if (!fileUtils->writeDataToFile(data, binaryPath))
+        AXLOGW("axmol: failed to write program binary {}", binaryPath);
+#endif
+}
+
 void ProgramGL::compileProgram()
 {
     if (_vertexShaderModule == nullptr || _fragmentShaderModule == nullptr)
@@ -198,6 +356,12 @@ void ProgramGL::compileProgram()
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
+#if AX_GLES_PROFILE != 200
+    if (!DriverBase::getInstance()->getProgramBinaryCachePath().empty() &&
+        static_cast<DriverGL*>(DriverBase::getInstance())->isProgramBinarySupported())
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(_program);
 
     GLint status = 0;
@@ -413,16 +577,84 @@ void ProgramGL::computeUniformInfos()
     }
 }
 
-void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
+void ProgramGL::bindUniformBuffers(ProgramState* programState)
 {
+    std::size_t bufferSize = 0;
+    auto buffer            = programState->getVertexUniformBuffer(bufferSize);
 #if AX_GLES_PROFILE != 200
+    const auto dirtyBegin = programState->getUniformDirtyBegin();
+    const auto dirtyEnd   = programState->getUniformDirtyEnd();
+    const auto ownerId    = programState->getUniqueId();
+
+    auto& ownedBuffers  = programState->getOwnedUniformBuffers();
+    auto firstUpToDate = _uniformBuffers.size();
+    if (programState->isUniformBufferOwned() && ownedBuffers.size() != _uniformBuffers.size())
+    {
+        firstUpToDate = ownedBuffers.size();
+        auto driver = DriverBase::getInstance();
+        for (auto i = ownedBuffers.size(); i < _uniformBuffers.size(); ++i)
+        {
+            auto& desc = _uniformBuffers[i];
+            auto ubo   = driver->newBuffer(desc._size, BufferType::UNIFORM, BufferUsage::DYNAMIC);
+            ubo->updateData(buffer + desc._location, desc._size);
+            ownedBuffers.emplace_back(ubo);
+        }
+    }
+
     for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
     {
-        auto& desc = _uniformBuffers[blockIdx];
-        desc._ubo->updateData(buffer + desc._location, desc._size);
-        __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
+        auto& desc       = _uniformBuffers[blockIdx];
+        auto blockBegin  = static_cast<std::size_t>(desc._location);
+        auto blockEnd    = blockBegin + desc._size;
+        auto rangeBegin  = (std::max)(dirtyBegin, blockBegin);
+        auto rangeEnd    = (std::min)(dirtyEnd, blockEnd);
+        BufferGL* ubo    = desc._ubo;
+        bool uploadRange = false;
+        if (!ownedBuffers.empty())
+        {
+            // the buffers created above are up to date
+            ubo         = static_cast<BufferGL*>(ownedBuffers[blockIdx]);
+            uploadRange = blockIdx < firstUpToDate;
+        }
+        else if (desc._ownerId == ownerId)
+        {
+            // still holds the uniforms of the program state
+            uploadRange    = true;
+            desc._dataHash = rangeBegin < rangeEnd ? 0 : desc._dataHash;
+        }
+        else
+        {
+            auto dataHash = XXH3_64bits(buffer + blockBegin, desc._size);
+            if (dataHash != desc._dataHash)
+            {
+                ubo->updateData(buffer + blockBegin, desc._size);
+                desc._dataHash = dataHash;
+            }
+            else
+                __gl->countElidedCalls();
+            desc._ownerId = ownerId;
+        }
+
+        if (uploadRange)
+        {
+            if (rangeBegin < rangeEnd)
+                ubo->updateSubData(buffer + rangeBegin, rangeBegin - blockBegin, rangeEnd - rangeBegin);
+            else
+                __gl->countElidedCalls();
+        }
+        __gl->bindUniformBufferBase(blockIdx, ubo->getHandler());
     }
+    programState->clearUniformDirtyRange();
 #else
+    // uniforms are program state, nothing to set when they didn't change since the last draw with the program
+    auto dataHash = XXH3_64bits(buffer, bufferSize);
+    if (dataHash == _uniformDataHash)
+    {
+        __gl->countElidedCalls(static_cast<uint32_t>(_activeUniformInfos.size()));
+        return;
+    }
+    _uniformDataHash = dataHash;
+
     for (auto&& iter : _activeUniformInfos)
     {
         auto& uniformInfo = iter.second;
@@ -438,6 +670,20 @@ void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
     CHECK_GL_ERROR_DEBUG();
 }
 
+void ProgramGL::setSamplerSlots(int location, const int* slots, size_t count)
+{
+    auto slotsHash = XXH3_64bits(slots, count * sizeof(slots[0]));
+    auto it        = _samplerSlotHashes.find(location);
+    if (it != _samplerSlotHashes.end() && it->second == slotsHash)
+        return __gl->countElidedCalls();
+    _samplerSlotHashes[location] = slotsHash;
+
+    if (count == 1)  // Most of the time, not use sampler2DArray, should be 1
+        glUniform1i(location, slots[0]);
+    else
+        glUniform1iv(location, static_cast<GLsizei>(count), static_cast<const GLint*>(slots));
+}
+
 void ProgramGL::clearUniformBuffers()
 {
     if (_uniformBuffers.empty())
@@ -43,6 +43,7 @@
 NS_AX_BACKEND_BEGIN
 
 class ShaderModuleGL;
+class ProgramState;
 
 /**
  * Store attribute information.
@@ -67,13 +68,17 @@ struct AttributeInfo
 
 struct UniformBlockDescriptor
 {
-    UniformBlockDescriptor(BufferGL* ubo, int loc, int size) : _ubo(ubo), _location(loc), _size(size) {}
+    UniformBlockDescriptor(BufferGL* ubo, int loc, int size)
+        : _ubo(ubo), _location(loc), _size(size), _dataHash(0), _ownerId(0)
+    {}
     BufferGL* _ubo;
     int _location;
     int _size;
 #if !AX_64BITS
     int __padding;
 #endif
+    uint64_t _dataHash;  // hash of the data uploaded to _ubo, the upload is skipped when unchanged, 0: unknown
+    uint64_t _ownerId;   // unique id of the program state which uploaded the data of _ubo
 };
 
 /**
@@ -161,10 +166,31 @@ public:
      */
     virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
 
-    void bindUniformBuffers(const char* buffer, size_t bufferSize);
+    /**
+     * Upload the uniforms of a program state and bind them. With uniform buffers, only the ranges modified since the
+     * program state was last drawn are uploaded when the buffers still hold its uniforms.
+     */
+    void bindUniformBuffers(ProgramState* programState);
+
+    /**
+     * Set the texture slots of a sampler uniform, skipped when the program already has them, uniforms are program
+     * state.
+     */
+    void setSamplerSlots(int location, const int* slots, size_t count);
+
+    /**
+     * Start compiling the shaders of a program in background threads, see `DriverBase::prepareProgram`.
+     */
+    static bool prepare(std::string_view vertexShader, std::string_view fragmentShader);
 
 private:
+    void createProgram();
+    void ensureShaderModules();
     void compileProgram();
+
+    /// load the linked program from the binary cache, see `DriverBase::getProgramBinaryCachePath`
+    bool loadProgramBinary();
+    void saveProgramBinary();
     void computeUniformInfos();
     void setBuiltinLocations();
 
@@ -198,6 +224,10 @@ private:
 #endif
 
     std::size_t _totalBufferSize = 0;  // total uniform buffer size (all blocks)
+#if AX_GLES_PROFILE == 200
+    uint64_t _uniformDataHash = 0;  // hash of the last uniforms set by bindUniformBuffers
+#endif
+    std::unordered_map<int, uint64_t> _samplerSlotHashes;
 
     int _maxLocation = -1;
     UniformLocation _builtinUniformLocation[UNIFORM_MAX];
@@ -28,6 +28,7 @@
 #include "platform/PlatformMacros.h"
 #include "base/Macros.h"
 #include "base/axstd.h"
+#include "DriverGL.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -52,6 +53,34 @@ void ShaderModuleGL::compileShader(ShaderStage stage, std::string_view source)
     glShaderSource(_shader, 1, &sourcePtr, nullptr);
     glCompileShader(_shader);
 
+    _statusPending = true;
+    _pendingSource = source;
+}
+
+GLuint ShaderModuleGL::getShader()
+{
+    if (_statusPending)
+        checkCompileStatus();
+    return _shader;
+}
+
+bool ShaderModuleGL::isCompileComplete() const
+{
+    if (!_statusPending ||
+        !static_cast<DriverGL*>(DriverBase::getInstance())->isParallelShaderCompileSupported())
+        return true;
+
+    GLint completed = GL_TRUE;
+    glGetShaderiv(_shader, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed != GL_FALSE;
+}
+
+void ShaderModuleGL::checkCompileStatus()
+{
+    _statusPending = false;
+    std::string source;
+    source.swap(_pendingSource);
+
     GLint status = 0;
     glGetShaderiv(_shader, GL_COMPILE_STATUS, &status);
     if (!status)
@@ -28,6 +28,8 @@
 
 #include "platform/GL.h"
 
+#include <string>
+
 NS_AX_BACKEND_BEGIN
 /**
  * @addtogroup _opengl
@@ -48,16 +50,26 @@ public:
     ~ShaderModuleGL();
 
     /**
-     * Get shader object.
-     * @return Shader object.
+     * Get shader object, waits for the compilation to complete.
+     * @return Shader object, 0 if the compilation failed.
+     */
+    GLuint getShader();
+
+    /**
+     * Check whether the compilation completed without waiting, always true unless the driver compiles in background
+     * threads.
      */
-    inline GLuint getShader() const { return _shader; }
+    bool isCompileComplete() const;
 
 private:
     void compileShader(ShaderStage stage, std::string_view source);
+    void checkCompileStatus();
     void deleteShader();
 
     GLuint _shader = 0;
+    // the status is checked when the shader is needed, so compilations can run concurrently in the driver
+    bool _statusPending = false;
+    std::string _pendingSource;  // for the error log
     friend class ProgramGL;
 };
 // end of _opengl group
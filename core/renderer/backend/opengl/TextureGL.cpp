@@ -274,6 +274,11 @@ void Texture2DGL::updateSubData(std::size_t xoffset,
     if (!_textureInfo.ensure(index, GL_TEXTURE_2D))
         return;
 
+    // the alignment set by the last upload may not fit the rows of this one
+    unsigned int bytesPerRow = width * _bitsPerPixel / 8;
+    GLint alignment          = bytesPerRow % 8 == 0 ? 8 : bytesPerRow % 4 == 0 ? 4 : bytesPerRow % 2 == 0 ? 2 : 1;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
     glTexSubImage2D(GL_TEXTURE_2D, level, xoffset, yoffset, width, height, _textureInfo.format, _textureInfo.type,
                     data);
     CHECK_GL_ERROR_DEBUG();
@@ -374,6 +379,32 @@ void TextureCubeGL::updateFaceData(TextureCubeFace side, void* data, int index)
     __gl->bindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
+void TextureCubeGL::updateFaceLevelData(TextureCubeFace side,
+                                        const void* data,
+                                        std::size_t dataLen,
+                                        int level,
+                                        int index)
+{
+    if (!_textureInfo.ensure(index, GL_TEXTURE_CUBE_MAP))
+        return;
+
+    const int i       = static_cast<int>(side);
+    const GLsizei size = (std::max)(static_cast<GLsizei>(_width) >> level, 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (_isCompressed)
+        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, _textureInfo.internalFormat, size, size,
+                               0,  // border
+                               static_cast<GLsizei>(dataLen), data);
+    else
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, _textureInfo.internalFormat, size, size,
+                     0,  // border
+                     _textureInfo.format, _textureInfo.type, data);
+    CHECK_GL_ERROR_DEBUG();
+
+    if (!_hasMipmaps && level > 0)
+        _hasMipmaps = true;
+}
+
 void TextureCubeGL::generateMipmaps()
 {
     if (TextureUsage::RENDER_TARGET == _textureUsage)
@@ -239,6 +239,12 @@ public:
      */
     virtual void updateFaceData(TextureCubeFace side, void* data, int index = 0) override;
 
+    void updateFaceLevelData(TextureCubeFace side,
+                             const void* data,
+                             std::size_t dataLen,
+                             int level,
+                             int index = 0) override;
+
     /// Generate mipmaps.
     virtual void generateMipmaps() override;
 
@@ -123,6 +123,17 @@ GLenum UtilsGL::toGLAttributeType(VertexFormat vertexFormat)
     case VertexFormat::INT:
         ret = GL_INT;
         break;
+    case VertexFormat::USHORT4:
+    case VertexFormat::USHORT2:
+        ret = GL_UNSIGNED_SHORT;
+        break;
+    case VertexFormat::SHORT4:
+        ret = GL_SHORT;
+        break;
+    case VertexFormat::HALF4:
+    case VertexFormat::HALF2:
+        ret = GL_HALF_FLOAT;
+        break;
     case VertexFormat::UBYTE4:
         ret = GL_UNSIGNED_BYTE;
         break;
@@ -139,6 +150,9 @@ GLsizei UtilsGL::getGLAttributeSize(VertexFormat vertexFormat)
     {
     case VertexFormat::FLOAT4:
     case VertexFormat::INT4:
+    case VertexFormat::USHORT4:
+    case VertexFormat::SHORT4:
+    case VertexFormat::HALF4:
     case VertexFormat::UBYTE4:
         ret = 4;
         break;
@@ -148,6 +162,8 @@ GLsizei UtilsGL::getGLAttributeSize(VertexFormat vertexFormat)
         break;
     case VertexFormat::FLOAT2:
     case VertexFormat::INT2:
+    case VertexFormat::USHORT2:
+    case VertexFormat::HALF2:
         ret = 2;
         break;
     case VertexFormat::FLOAT:
@@ -0,0 +1,56 @@
+#version 310 es
+
+// a unit quad, every instance maps it to a billboard quad turned towards the camera
+layout(location = POSITION) in vec2 a_position;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_VPMatrix;
+    vec3 u_cameraPos;
+    vec3 u_cameraUp;
+    vec3 u_cameraForward;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// instance layout, see BillBoardInstance
+//   [0]: xyz: anchor point in world, w: 1 when oriented to the view plane, +2 when the texture rect is rotated
+//   [1]: xy: quad bottom left corner from the anchor point, zw: quad size
+//   [2]: xy: texture coordinates of the bottom left corner, zw: texture coordinates size
+//   [3]: color
+void main()
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    bool rotated = inst[0].w >= 2.0;
+
+    // the same axes as BillBoard::calculateBillboardTransform
+    vec3 dir = u_cameraForward;
+    if (mod(inst[0].w, 2.0) < 0.5)
+    {
+        vec3 toAnchor = inst[0].xyz - u_cameraPos;
+        if (dot(toAnchor, toAnchor) > 0.0)
+            dir = toAnchor;
+    }
+    dir        = normalize(dir);
+    vec3 right = normalize(cross(dir, u_cameraUp));
+    vec3 up    = cross(right, dir);
+
+    vec2 corner = inst[1].xy + a_position * inst[1].zw;
+    vec3 pos    = inst[0].xyz + right * corner.x + up * corner.y;
+    gl_Position = u_VPMatrix * vec4(pos, 1.0);
+    v_color     = inst[3];
+    v_texCoord  = inst[2].xy + (rotated ? a_position.yx : a_position) * inst[2].zw;
+}
@@ -0,0 +1,173 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+#include "base.glsl"
+
+// the froxel grid and the clusters texture width, see LightClusterGrid and LightClusters
+#define LIGHT_CLUSTER_X 16
+#define LIGHT_CLUSTER_Y 9
+#define LIGHT_CLUSTER_Z 24
+#define LIGHT_CLUSTER_TEXTURE_WIDTH 1024
+
+// the cascades of the shadow map, see ShadowCascades and CascadedShadowMap
+#define SHADOW_CASCADES 4
+
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+layout(location = NORMAL) in vec3 v_normal;
+layout(location = TEXCOORD1) in vec3 v_worldPosition;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+#if !defined(GLES2)
+layout(binding = 3) uniform highp sampler2D u_lightClusters;
+layout(binding = 4) uniform sampler2D u_shadowMap0;
+layout(binding = 5) uniform sampler2D u_shadowMap1;
+layout(binding = 6) uniform sampler2D u_shadowMap2;
+layout(binding = 7) uniform sampler2D u_shadowMap3;
+#endif
+
+layout(std140) uniform fs_ub {
+    vvec3_def(u_DirLightSourceColor, MAX_DIRECTIONAL_LIGHT_NUM);
+    vvec3_def(u_DirLightSourceDirection, MAX_DIRECTIONAL_LIGHT_NUM);
+    vec3 u_AmbientLightSourceColor;
+    vec4 u_color;
+#if !defined(GLES2)
+    mat4 u_clusterMatrix;  // the view projection the clusters are built for
+    vec4 u_clusterDepth;   // the view depth of a position is dot(u_clusterDepth, position)
+    vec4 u_clusterParams;  // near plane, slice scale, first cluster texel, exponential slices
+    int u_lightMask;
+    mat4 u_shadowMatrices[SHADOW_CASCADES];  // world to the clip space of each cascade
+    vec4 u_shadowSplits;  // the view depth each cascade ends at
+    vec4 u_shadowDepth;   // the view depth of a position is dot(u_shadowDepth, position)
+    vec4 u_shadowBias;    // the depth bias of each cascade
+    vec4 u_shadowParams;  // cascade count, texel size, texture y direction, depth scale
+    vec3 u_shadowLightColor;
+    vec3 u_shadowLightDirection;
+#endif
+};
+
+vec3 computeLighting(vec3 normalVector, vec3 lightDirection, vec3 lightColor, float attenuation)
+{
+    float diffuse = max(dot(normalVector, lightDirection), 0.0);
+    vec3 diffuseColor = lightColor  * diffuse * attenuation;
+
+    return diffuseColor;
+}
+
+#if !defined(GLES2)
+vec4 clusterTexel(int index)
+{
+    return texelFetch(u_lightClusters, ivec2(index % LIGHT_CLUSTER_TEXTURE_WIDTH, index / LIGHT_CLUSTER_TEXTURE_WIDTH), 0);
+}
+
+// the depth packed by shadowDepth.frag, sampled without derivatives since the cascade isn't uniform
+float shadowTexel(int cascade, vec2 uv)
+{
+    vec4 texel;
+    if (cascade == 0)
+        texel = textureLod(u_shadowMap0, uv, 0.0);
+    else if (cascade == 1)
+        texel = textureLod(u_shadowMap1, uv, 0.0);
+    else if (cascade == 2)
+        texel = textureLod(u_shadowMap2, uv, 0.0);
+    else
+        texel = textureLod(u_shadowMap3, uv, 0.0);
+    return dot(texel, vec4(1.0, 1.0 / 255.0, 1.0 / 65025.0, 1.0 / 16581375.0));
+}
+
+// the lit fraction of the fragment, 3x3 percentage closer filtered
+float computeShadow(float diffuse)
+{
+    float depth = dot(u_shadowDepth, vec4(v_worldPosition, 1.0));
+    int count = int(u_shadowParams.x);
+    int cascade = 0;
+    while (cascade < count && depth > u_shadowSplits[cascade])
+        ++cascade;
+    if (cascade >= count)
+        return 1.0;
+
+    vec4 clip = u_shadowMatrices[cascade] * vec4(v_worldPosition, 1.0);
+    vec3 coord = clip.xyz / clip.w;
+    vec2 uv = vec2(coord.x, coord.y * u_shadowParams.z) * 0.5 + 0.5;
+
+    // the bias grows with the slope of the surface to the light
+    float slope = clamp(sqrt(1.0 - diffuse * diffuse) / max(diffuse, 0.05), 1.0, 4.0);
+    float receiver = coord.z * u_shadowParams.w + (1.0 - u_shadowParams.w) - u_shadowBias[cascade] * slope;
+
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+            lit += step(receiver, shadowTexel(cascade, uv + vec2(x, y) * u_shadowParams.y));
+    }
+    return lit / 9.0;
+}
+#endif
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main(void)
+{
+    vec3 normal = normalize(v_normal);
+
+    vec4 combinedColor = vec4(u_AmbientLightSourceColor, 1.0);
+
+    // Directional light contribution
+    for (int i = 0; i < MAX_DIRECTIONAL_LIGHT_NUM; ++i)
+    {
+        vec3 lightDirection = normalize(vvec3_at(u_DirLightSourceDirection, i) * 2.0);
+        combinedColor.xyz += computeLighting(normal, -lightDirection, vvec3_at(u_DirLightSourceColor, i), 1.0);
+    }
+
+#if !defined(GLES2)
+    // the shadowed directional light, it isn't passed with the directional lights
+    if (u_shadowParams.x > 0.0)
+    {
+        vec3 lightDirection = normalize(u_shadowLightDirection);
+        float diffuse = dot(normal, -lightDirection);
+        if (diffuse > 0.0)
+            combinedColor.xyz += computeLighting(normal, -lightDirection, u_shadowLightColor, computeShadow(diffuse));
+    }
+
+    // the cluster of the fragment, computed like LightClusterGrid::getCluster
+    vec4 clip = u_clusterMatrix * vec4(v_worldPosition, 1.0);
+    vec2 tile = clamp((clip.xy / clip.w * 0.5 + 0.5) * vec2(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y), vec2(0.0),
+                      vec2(LIGHT_CLUSTER_X - 1, LIGHT_CLUSTER_Y - 1));
+    float depth = dot(u_clusterDepth, vec4(v_worldPosition, 1.0));
+    float slice = u_clusterParams.w > 0.5 ? log(max(depth / u_clusterParams.x, 1.0))
+                                          : max(depth - u_clusterParams.x, 0.0);
+    int cluster = int(tile.x) + LIGHT_CLUSTER_X *
+                  (int(tile.y) + LIGHT_CLUSTER_Y * min(int(slice * u_clusterParams.y), LIGHT_CLUSTER_Z - 1));
+
+    int headers = int(u_clusterParams.z);
+    int indices = headers + LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z;
+    vec4 header = clusterTexel(headers + cluster);
+    int first = int(header.x);
+    int last = first + int(header.y);
+
+    // Point and spot light contribution, a point light has no spot attenuation
+    for (int i = first; i < last; ++i)
+    {
+        int light = int(clusterTexel(indices + i / 4)[i % 4]) * 4;
+        vec4 lightColor = clusterTexel(light + 1);
+        if ((int(lightColor.w) & u_lightMask) == 0)
+            continue;
+
+        vec4 lightPosition = clusterTexel(light);
+        vec4 spot = clusterTexel(light + 2);
+        float outerAngleCos = clusterTexel(light + 3).x;
+
+        vec3 vertexToLight = lightPosition.xyz - v_worldPosition;
+        vec3 ldir = vertexToLight * lightPosition.w;
+        float attenuation = clamp(1.0 - dot(ldir, ldir), 0.0, 1.0);
+        vec3 lightDirection = normalize(vertexToLight);
+
+        attenuation *= smoothstep(outerAngleCos, spot.w, dot(spot.xyz, -lightDirection));
+        attenuation = clamp(attenuation, 0.0, 1.0);
+        combinedColor.xyz += computeLighting(normal, lightDirection, lightColor.rgb, attenuation);
+    }
+#endif
+
+    FragColor = texture(u_tex0, v_texCoord) * u_color * combinedColor;
+}
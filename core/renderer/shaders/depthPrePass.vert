@@ -0,0 +1,17 @@
+#version 310 es
+
+
+layout(location = POSITION) in vec4 a_position;
+
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVMatrix;
+    mat4 u_PMatrix;
+};
+
+void main(void)
+{
+    // the same expression as the lit shaders, the opaque pass compares its depth with LESS_EQUAL
+    vec4 ePosition = u_MVMatrix * a_position;
+    gl_Position = u_PMatrix * ePosition;
+}
@@ -0,0 +1,27 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+layout(location = TEXCOORD1) in vec4 v_shape;
+layout(location = TEXCOORD2) in vec4 v_borderColor;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+// signed distance to a box of half extents b with corners rounded by r, circles and capsules are such boxes
+float roundedBox(vec2 p, vec2 b, float r)
+{
+    vec2 q = abs(p) - b + r;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
+}
+
+void main()
+{
+    float d = roundedBox(v_texCoord, v_shape.xy, v_shape.z);
+    // about one pixel of anti-aliasing, whatever the scale of the node
+    float aa = max(length(fwidth(v_texCoord)), 1e-4);
+    float coverage = clamp(0.5 - d / aa, 0.0, 1.0);
+    float fill = clamp(0.5 - (d + v_shape.w) / aa, 0.0, 1.0);
+    FragColor = mix(v_borderColor, v_color, fill) * coverage;
+}
@@ -0,0 +1,29 @@
+#version 310 es
+
+// a quad around an analytic DrawNode shape, see V2F_C4B_T2F_T4F_C4B
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+layout(location = COLOR0) in vec4 a_color;
+// xy: half extents, z: corner radius, w: border width
+layout(location = TEXCOORD1) in vec4 a_texCoord1;
+layout(location = TEXCOORD2) in vec4 a_texCoord2;
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+layout(location = TEXCOORD1) out vec4 v_shape;
+layout(location = TEXCOORD2) out vec4 v_borderColor;
+
+layout(std140) uniform vs_ub {
+    float u_alpha;
+    mat4 u_MVPMatrix;
+};
+
+void main()
+{
+    v_color = vec4(a_color.rgb * a_color.a * u_alpha, a_color.a * u_alpha);
+    v_borderColor = vec4(a_texCoord2.rgb * a_texCoord2.a * u_alpha, a_texCoord2.a * u_alpha);
+    v_texCoord = a_texCoord;
+    v_shape = a_texCoord1;
+
+    gl_Position = u_MVPMatrix * a_position;
+}
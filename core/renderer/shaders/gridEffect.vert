@@ -0,0 +1,113 @@
+#version 310 es
+
+// a vertex of a Grid3D, the effect is applied to it as set with setVertex
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // xy: origin of the grid rect, zw: step between two vertices
+    vec4 u_grid;
+    // xy: size of the grid, z: the effect, see GridShaderEffect::Type
+    vec4 u_gridSize;
+    // the parameters of the effect, see GridShaderEffect::Type
+    vec4 u_params0;
+    vec4 u_params1;
+};
+
+const int WAVES_3D     = 1;
+const int RIPPLE_3D    = 2;
+const int LENS_3D      = 3;
+const int LIQUID       = 4;
+const int WAVES        = 5;
+const int TWIRL        = 6;
+const int PAGE_TURN_3D = 7;
+
+const float PI = 3.14159265358979;
+
+// see PageTurn3D::update
+vec3 pageTurn(vec3 p)
+{
+    float ay       = u_params0.x;
+    float sinTheta = u_params0.y;
+    float cosTheta = u_params0.z;
+    float rotation = u_params0.w;
+
+    p.x -= u_grid.x;
+    float R       = sqrt(p.x * p.x + (p.y - ay) * (p.y - ay));
+    float r       = R * sinTheta;
+    float beta    = asin(p.x / R) / sinTheta;
+    float cosBeta = cos(beta);
+
+    // the points wrapped around the cone are stuck at 0
+    p.x = beta <= PI ? r * sin(beta) : 0.0;
+    p.y = R + ay - r * (1.0 - cosBeta) * sinTheta;
+    p.z = r * (1.0 - cosBeta) * cosTheta;
+    p.x = p.z * sin(rotation) + p.x * cos(rotation);
+    p.z = p.z * cos(rotation) - p.x * sin(rotation);
+    p.z = max(p.z / 7.0, 0.5);
+    p.x += u_grid.x;
+    return p;
+}
+
+void main()
+{
+    vec3 v     = a_position.xyz;
+    int effect = int(u_gridSize.z + 0.5);
+
+    // the coordinates of the vertex in the grid
+    vec2 gridPos    = floor((v.xy - u_grid.xy) / u_grid.zw + 0.5);
+    float phase     = u_params0.x;
+    float amplitude = u_params0.y;
+
+    if (effect == WAVES_3D)
+    {
+        v.z += sin(phase + (v.x + v.y) * 0.01) * amplitude;
+    }
+    else if (effect == RIPPLE_3D)
+    {
+        float r = distance(u_params1.xy, v.xy);
+        if (r < u_params1.z)
+        {
+            r          = u_params1.z - r;
+            float rate = r / u_params1.z;
+            v.z += sin(phase + r * 0.1) * amplitude * rate * rate;
+        }
+    }
+    else if (effect == LENS_3D)
+    {
+        float r = distance(u_params1.xy, v.xy);
+        if (r < u_params1.z && r > 0.0)
+        {
+            float lensEffect = u_params0.x;
+            float newR       = pow(max((u_params1.z - r) / u_params1.z, 0.001), lensEffect) * u_params1.z;
+            v.z += u_params0.y * newR * lensEffect;
+        }
+    }
+    else if (effect == LIQUID)
+    {
+        // the border of the grid doesn't move
+        if (all(greaterThan(gridPos, vec2(0.0))) && all(lessThan(gridPos, u_gridSize.xy)))
+            v.xy += sin(phase + v.xy * 0.01) * amplitude;
+    }
+    else if (effect == WAVES)
+    {
+        vec2 offset = sin(phase + v.yx * 0.01) * amplitude;
+        v.xy += offset * u_params0.wz;
+    }
+    else if (effect == TWIRL)
+    {
+        float a = length(gridPos - u_gridSize.xy * 0.5) * u_params0.x;
+        vec2 d  = v.xy - u_params1.xy;
+        v.xy    = u_params1.xy + vec2(sin(a) * d.y + cos(a) * d.x, cos(a) * d.y - sin(a) * d.x);
+    }
+    else if (effect == PAGE_TURN_3D)
+    {
+        v = pageTurn(v);
+    }
+
+    gl_Position = u_MVPMatrix * vec4(v, 1.0);
+    v_texCoord  = a_texCoord;
+}
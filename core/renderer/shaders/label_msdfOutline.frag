@@ -0,0 +1,36 @@
+#version 310 es
+precision highp float;
+#include "base.glsl"
+
+const float thickness = 0.15;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+layout(std140) uniform fs_ub {
+    vec4 u_textColor;
+    vec4 u_effectColor;
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+float median(float r, float g, float b)
+{
+    return max(min(r, g), min(max(r, g), b));
+}
+
+void main()
+{
+    vec4 msdf = texture(u_tex0, v_texCoord);
+    float dist = median(msdf.r, msdf.g, msdf.b);
+    float smoothing = fwidth(dist);
+
+    // the outline reaches past the corners of the multi-channel distance, the true distance in alpha is used there
+    float pivot = abs(0.5 - thickness * u_effectColor.w);
+    float outlineDist = min(dist, msdf.a);
+    float alpha = smoothstep(pivot - smoothing, pivot + smoothing, outlineDist);
+    float border = smoothstep(0.5 - smoothing, 0.5 + smoothing, dist);
+    FragColor = v_color * vec4(mix(u_effectColor.xyz, u_textColor.rgb, border), alpha);
+}
@@ -0,0 +1,27 @@
+#version 310 es
+
+// a point of a trail, see TrailBuffer::Vertex
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec4 a_texCoord;
+layout(location = COLOR0) in vec4 a_color;
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // x: time, y: 1 / fade time, z: stroke
+    vec4 u_streak;
+};
+
+// a_position: xyz: point, w: time it was appended
+// a_texCoord: xyz: offset to the edge of the strip for a stroke of 1, w: u texture coordinate
+void main()
+{
+    // 1 for a new point, 0 once it faded out
+    float life = clamp(1.0 - (u_streak.x - a_position.w) * u_streak.y, 0.0, 1.0);
+
+    gl_Position = u_MVPMatrix * vec4(a_position.xyz + a_texCoord.xyz * u_streak.z, 1.0);
+    v_color     = vec4(a_color.rgb, a_color.a * life);
+    v_texCoord  = vec2(a_texCoord.w, life);
+}
@@ -0,0 +1,80 @@
+#version 310 es
+
+// a unit quad, every instance is a particle evaluated at its age, see ParticleSystemQuad::GPUParticle
+layout(location = POSITION) in vec2 a_position;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // maps the emitter position at spawn time to the space of the node
+    mat4 u_startMatrix;
+    // x: time, y: 1 for the radius mode, z: y coordinate flip, w: 1 to premultiply the alpha
+    vec4 u_simulation;
+    // xy: gravity
+    vec4 u_gravity;
+    // xy: texture coordinates of the bottom left corner, zw: texture coordinates size
+    vec4 u_texRect;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// two 8 bit channels are packed in every float
+vec4 unpackColor(vec2 packed)
+{
+    vec2 hi = floor(packed / 256.0);
+    return vec4(hi.x, packed.x - hi.x * 256.0, hi.y, packed.y - hi.y * 256.0) / 255.0;
+}
+
+// instance layout, see ParticleSystemQuad::GPUParticle
+//   [0]: x: spawn time, y: life, zw: emitter position
+//   [1]: gravity mode: xy: position, zw: velocity
+//        radius mode: x: angle, y: angular speed, z: radius, w: radius speed
+//   [2]: x: size, y: size speed, z: rotation in degrees, w: rotation speed
+//   [3]: xy: start color, zw: end color
+void main()
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    float age = u_simulation.x - inst[0].x;
+    if (age < 0.0 || age >= inst[0].y)
+    {
+        // not spawned yet or dead, move the quad out of the clip volume
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        v_color     = vec4(0.0);
+        v_texCoord  = vec2(0.0);
+        return;
+    }
+
+    vec2 pos;
+    if (u_simulation.y > 0.5)
+    {
+        float angle  = inst[1].x + inst[1].y * age;
+        float radius = inst[1].z + inst[1].w * age;
+        pos          = vec2(-cos(angle), -sin(angle) * u_simulation.z) * radius;
+    }
+    else
+        pos = inst[1].xy + (inst[1].zw + 0.5 * u_gravity.xy * age) * age * u_simulation.z;
+    pos += (u_startMatrix * vec4(inst[0].zw, 0.0, 1.0)).xy;
+
+    float size  = max(inst[2].x + inst[2].y * age, 0.0);
+    float r     = -radians(inst[2].z + inst[2].w * age);
+    vec2 corner = (a_position - 0.5) * size;
+    pos += vec2(corner.x * cos(r) - corner.y * sin(r), corner.x * sin(r) + corner.y * cos(r));
+    gl_Position = u_MVPMatrix * vec4(pos, 0.0, 1.0);
+
+    vec4 color = clamp(mix(unpackColor(inst[3].xy), unpackColor(inst[3].zw), age / inst[0].y), 0.0, 1.0);
+    v_color    = u_simulation.w > 0.5 ? vec4(color.rgb * color.a, color.a) : color;
+    v_texCoord = u_texRect.xy + a_position * u_texRect.zw;
+}
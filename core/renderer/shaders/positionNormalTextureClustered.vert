@@ -0,0 +1,29 @@
+#version 310 es
+
+#include "base.glsl"
+
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+layout(location = NORMAL) in vec3 a_normal;
+
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+layout(location = NORMAL) out vec3 v_normal;
+// the lights are evaluated per fragment in world space, see colorNormalTextureClustered.frag
+layout(location = TEXCOORD1) out vec3 v_worldPosition;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVMatrix;
+    mat4 u_PMatrix;
+    mat3 u_NormalMatrix;
+};
+
+void main(void)
+{
+    vec4 position = u_MVMatrix * a_position;
+    v_worldPosition = position.xyz;
+    v_normal = u_NormalMatrix * a_normal;
+
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+    gl_Position = u_PMatrix * position;
+}
@@ -0,0 +1,38 @@
+#version 310 es
+
+// a unit quad, every instance maps it to a sprite quad
+layout(location = POSITION) in vec2 a_position;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// instance layout, see SpriteInstance
+//   [0]: xy: quad bottom edge, zw: quad left edge
+//   [1]: xyz: quad bottom left corner
+//   [2]: xy: texture coordinates of the bottom left corner, zw: texture coordinates size
+//   [3]: color
+void main()
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    vec2 pos    = inst[1].xy + a_position.x * inst[0].xy + a_position.y * inst[0].zw;
+    gl_Position = u_MVPMatrix * vec4(pos, inst[1].z, 1.0);
+    v_color     = inst[3];
+    v_texCoord  = inst[2].xy + a_position * inst[2].zw;
+}
@@ -0,0 +1,36 @@
+#version 310 es
+
+layout (location = POSITION) in vec4 a_position;
+layout (location = TEXCOORD0) in vec2 a_texCoord;
+#if !defined(METAL)
+layout (location = TEXCOORD1) in mat4 a_instance;
+#endif
+layout (location = COLOR0) out vec4 v_color;
+layout (location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// instance layout, see Mesh::setInstanceTransforms
+//   [0..2]: rows of the affine instance transform
+//   [3]: color
+void main(void)
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    vec4 pos    = vec4(dot(inst[0], a_position), dot(inst[1], a_position), dot(inst[2], a_position), 1.0);
+    gl_Position = u_MVPMatrix * pos;
+    v_color     = inst[3];
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+}
@@ -0,0 +1,36 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+layout(location = TEXCOORD1) in vec2 v_maskCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+layout(binding = 1) uniform sampler2D u_tex1;
+
+layout(std140) uniform fs_ub {
+    vec4 u_maskAxes;   // texture coords steps along the x and y of the mask quad
+    vec4 u_maskParams; // texture coords of the origin, distance field, inverted
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main()
+{
+    vec2 p = v_maskCoord;
+    vec2 uv = u_maskParams.xy + p.x * u_maskAxes.xy + p.y * u_maskAxes.zw;
+    float mask = texture(u_tex1, uv).a;
+    if (u_maskParams.z > 0.5)
+    {
+        // the edge of a distance field is at 0.5, antialiased over a pixel
+        float width = max(fwidth(mask), 0.0001);
+        mask = smoothstep(0.5 - width, 0.5 + width, mask);
+    }
+    // nothing outside of the quad, the texture coords would read the neighbors in an atlas
+    mask *= step(0.0, p.x) * step(p.x, 1.0) * step(0.0, p.y) * step(p.y, 1.0);
+    mask = mix(mask, 1.0 - mask, u_maskParams.w);
+
+    // premultiplied colors, all the channels are scaled
+    FragColor = v_color * texture(u_tex0, v_texCoord) * mask;
+}
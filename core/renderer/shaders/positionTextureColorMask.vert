@@ -0,0 +1,23 @@
+#version 310 es
+
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+layout(location = COLOR0) in vec4 a_color;
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+layout(location = TEXCOORD1) out vec2 v_maskCoord;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    mat4 u_maskMatrix;
+};
+
+void main()
+{
+    gl_Position = u_MVPMatrix * a_position;
+    v_color = a_color;
+    v_texCoord = a_texCoord;
+    // the batched vertices are in world space, the mask matrix maps them to the unit square of the mask quad
+    v_maskCoord = (u_maskMatrix * a_position).xy;
+}
@@ -0,0 +1,26 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+layout(std140) uniform fs_ub {
+    vec2 u_direction;
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main()
+{
+    // a 9 taps gaussian in 5 fetches, the bilinear filtering weights the texels between the taps
+    vec2 offset1 = u_direction * 1.3846153846;
+    vec2 offset2 = u_direction * 3.2307692308;
+
+    vec4 color = texture(u_tex0, v_texCoord) * 0.2270270270;
+    color += (texture(u_tex0, v_texCoord + offset1) + texture(u_tex0, v_texCoord - offset1)) * 0.3162162162;
+    color += (texture(u_tex0, v_texCoord + offset2) + texture(u_tex0, v_texCoord - offset2)) * 0.0702702703;
+    FragColor = color;
+}
@@ -0,0 +1,24 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+layout(binding = 1) uniform sampler2D u_tex1;
+
+layout(std140) uniform fs_ub {
+    mat4 u_colorMatrix;
+    vec4 u_colorOffset;
+    float u_weight;
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main()
+{
+    // the second input is added for a composite, its weight is 0 otherwise
+    vec4 color = texture(u_tex0, v_texCoord) + texture(u_tex1, v_texCoord) * u_weight;
+    FragColor = u_colorMatrix * color + u_colorOffset;
+}
@@ -0,0 +1,22 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+layout(std140) uniform fs_ub {
+    float u_threshold;
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main()
+{
+    // scaled by the brightest channel so the hue is kept
+    vec4 color = texture(u_tex0, v_texCoord);
+    float brightness = max(color.r, max(color.g, color.b));
+    FragColor = color * (max(brightness - u_threshold, 0.0) / max(brightness, 0.0001));
+}
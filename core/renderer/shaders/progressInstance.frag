@@ -0,0 +1,40 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+layout(location = TEXCOORD1) in vec4 v_progress;
+layout(location = TEXCOORD2) in vec4 v_shape;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+const float TWO_PI = 6.28318530718;
+
+void main()
+{
+    vec2 p        = v_progress.xy;
+    bool reversed = mod(v_progress.w, 2.0) > 0.5;
+    float shown;
+    if (v_progress.w < 1.5)
+    {
+        // the radial progress goes clockwise from 12 o'clock, counter-clockwise when reversed
+        vec2 d      = p - v_shape.xy;
+        float angle = atan(reversed ? -d.x : d.x, d.y);
+        if (angle < 0.0)
+            angle += TWO_PI;
+        shown = 1.0 - step(v_progress.z * TWO_PI, angle);
+    }
+    else
+    {
+        // the reversed bar shows the sprite around the rect
+        shown = step(v_shape.x, p.x) * step(v_shape.y, p.y) * step(p.x, v_shape.z) * step(p.y, v_shape.w);
+        if (reversed)
+            shown = 1.0 - shown;
+    }
+
+    // premultiplied colors, all the channels are scaled
+    FragColor = v_color * texture(u_tex0, v_texCoord) * shown;
+}
@@ -0,0 +1,68 @@
+#version 310 es
+
+// a unit quad, every instance maps it to the sprite of a progress timer
+layout(location = POSITION) in vec2 a_position;
+#if !defined(METAL)
+layout(location = TEXCOORD1) in mat4 a_instance;
+#endif
+
+layout(location = COLOR0) out vec4 v_color;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+// xy: point in the sprite from 0 to 1, z: progress, w: mode
+layout(location = TEXCOORD1) out vec4 v_progress;
+// radial: xy: midpoint, bar: xy: shown rect min, zw: shown rect max
+layout(location = TEXCOORD2) out vec4 v_shape;
+
+layout(std140, binding = 0) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    vec4 u_shape; // xy: midpoint, zw: bar change rate
+    float u_mode; // 0: radial, 2: bar, +1 when reversed
+};
+
+#if defined(METAL)
+layout(std140, binding = 1) buffer vs_inst {
+    mat4 u_instance[];
+};
+#endif
+
+// instance layout, see ProgressInstance
+//   [0]: xy: sprite bottom edge, zw: sprite left edge
+//   [1]: xyz: sprite bottom left corner, w: progress from 0 to 1, +2 when the texture rect is rotated
+//   [2]: xy: texture coordinates of the bottom left corner, zw: texture coordinates size
+//   [3]: color
+void main()
+{
+#if defined(METAL)
+    mat4 inst = u_instance[gl_InstanceIndex];
+#else
+    mat4 inst = a_instance;
+#endif
+    bool rotated   = inst[1].w >= 2.0;
+    float progress = rotated ? inst[1].w - 2.0 : inst[1].w;
+
+    vec2 pos    = inst[1].xy + a_position.x * inst[0].xy + a_position.y * inst[0].zw;
+    gl_Position = u_MVPMatrix * vec4(pos, inst[1].z, 1.0);
+    v_color     = inst[3];
+    // the same mapping as ProgressTimer::textureCoordFromAlphaPoint
+    v_texCoord  = inst[2].xy + (rotated ? a_position.yx : a_position) * inst[2].zw;
+    v_progress  = vec4(a_position, progress, u_mode);
+
+    if (u_mode < 1.5)
+    {
+        v_shape = vec4(u_shape.xy, 0.0, 0.0);
+    }
+    else
+    {
+        // the same rect as ProgressTimer::updateBar, moved back inside the sprite
+        vec2 offset = ((vec2(1.0) - u_shape.zw) + progress * u_shape.zw) * 0.5;
+        vec2 lo     = u_shape.xy - offset;
+        vec2 hi     = u_shape.xy + offset;
+        vec2 under  = max(-lo, vec2(0.0));
+        lo += under;
+        hi += under;
+        vec2 over = max(hi - vec2(1.0), vec2(0.0));
+        lo -= over;
+        hi -= over;
+        v_shape = vec4(lo, hi);
+    }
+}
@@ -0,0 +1,13 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main(void)
+{
+    // the depth packed into the 8 bit channels, unpacked by dot(texel, vec4(1, 1/255, 1/65025, 1/16581375))
+    vec4 packedDepth = fract(gl_FragCoord.z * vec4(1.0, 255.0, 65025.0, 16581375.0));
+    packedDepth -= packedDepth.yzww * vec4(1.0 / 255.0, 1.0 / 255.0, 1.0 / 255.0, 0.0);
+    FragColor = packedDepth;
+}
@@ -0,0 +1,103 @@
+#version 310 es
+
+#include "base.glsl"
+
+layout(location = POSITION) in vec3 a_position;
+
+layout(location = BLENDWEIGHT) in vec4 a_blendWeight;
+layout(location = BLENDINDICES) in vec4 a_blendIndex;
+
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+
+#if defined(GLES2)
+// no vertex texture fetch, same as the uniform palette
+#define SKINNING_JOINT_COUNT 60
+#else
+// the palettes of all skinned meshes of the frame, three texels per bone, see BonePalette
+#define BONE_PALETTE_TEXTURE_WIDTH 1024
+#endif
+// Uniforms
+
+// Varyings
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140) uniform vs_ub {
+#if defined(GLES2)
+    vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];
+#else
+    int u_paletteOffset;
+#endif
+    mat4 u_MVPMatrix;
+};
+
+#if defined(GLES2)
+vec4 paletteRow(int index)
+{
+    return u_matrixPalette[index];
+}
+#else
+layout(binding = 2) uniform highp sampler2D u_bonePalette;
+
+vec4 paletteRow(int index)
+{
+    index += u_paletteOffset;
+    return texelFetch(u_bonePalette, ivec2(index % BONE_PALETTE_TEXTURE_WIDTH, index / BONE_PALETTE_TEXTURE_WIDTH), 0);
+}
+#endif
+
+vec4 getPosition()
+{
+    float blendWeight = a_blendWeight[0];
+
+    int matrixIndex = int (a_blendIndex[0]) * 3;
+    vec4 matrixPalette1 = paletteRow(matrixIndex) * blendWeight;
+    vec4 matrixPalette2 = paletteRow(matrixIndex + 1) * blendWeight;
+    vec4 matrixPalette3 = paletteRow(matrixIndex + 2) * blendWeight;
+
+
+    blendWeight = a_blendWeight[1];
+    if (blendWeight > 0.0)
+    {
+        matrixIndex = int(a_blendIndex[1]) * 3;
+        matrixPalette1 += paletteRow(matrixIndex) * blendWeight;
+        matrixPalette2 += paletteRow(matrixIndex + 1) * blendWeight;
+        matrixPalette3 += paletteRow(matrixIndex + 2) * blendWeight;
+
+        blendWeight = a_blendWeight[2];
+        if (blendWeight > 0.0)
+        {
+            matrixIndex = int(a_blendIndex[2]) * 3;
+            matrixPalette1 += paletteRow(matrixIndex) * blendWeight;
+            matrixPalette2 += paletteRow(matrixIndex + 1) * blendWeight;
+            matrixPalette3 += paletteRow(matrixIndex + 2) * blendWeight;
+
+            blendWeight = a_blendWeight[3];
+            if (blendWeight > 0.0)
+            {
+                matrixIndex = int(a_blendIndex[3]) * 3;
+                matrixPalette1 += paletteRow(matrixIndex) * blendWeight;
+                matrixPalette2 += paletteRow(matrixIndex + 1) * blendWeight;
+                matrixPalette3 += paletteRow(matrixIndex + 2) * blendWeight;
+            }
+        }
+    }
+
+    vec4 _skinnedPosition;
+    vec4 position = vec4(a_position, 1.0);
+    _skinnedPosition.x = dot(position, matrixPalette1);
+    _skinnedPosition.y = dot(position, matrixPalette2);
+    _skinnedPosition.z = dot(position, matrixPalette3);
+    _skinnedPosition.w = position.w;
+
+    return _skinnedPosition;
+}
+
+void main()
+{
+    vec4 position = getPosition();
+    gl_Position = u_MVPMatrix * position;
+
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+}
+
@@ -0,0 +1,48 @@
+#version 310 es
+
+// the grid of a page in samples, z is 1 for the skirt vertices, see PagedTerrain
+layout(location = POSITION) in vec3 a_position;
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+layout(location = 1) out vec3 v_normal;
+
+#if !defined(GLES2)
+layout(binding = 6) uniform highp sampler2D u_heightMap;
+#endif
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // xy: the first sample of the page, zw: half of the terrain size in samples
+    vec4 u_pageOrigin;
+    // x: map scale, y: map height, z: skirt height, w: texture repeats per sample
+    vec4 u_mapParams;
+};
+
+#if defined(GLES2)
+// no vertex texture fetch, PagedTerrain::isSupported is false
+float sampleHeight(ivec2 texel)
+{
+    return 0.0;
+}
+#else
+float sampleHeight(ivec2 texel)
+{
+    texel = clamp(texel, ivec2(0), textureSize(u_heightMap, 0) - 1);
+    return (texelFetch(u_heightMap, texel, 0).r - 0.5) * u_mapParams.y;
+}
+#endif
+
+void main()
+{
+    ivec2 texel = ivec2(a_position.xy);
+    float height = sampleHeight(texel) - a_position.z * u_mapParams.z;
+    vec2 xz = (u_pageOrigin.xy + a_position.xy - u_pageOrigin.zw) * u_mapParams.x;
+    gl_Position = u_MVPMatrix * vec4(xz.x, height, xz.y, 1.0);
+
+    // central differences, the normals are not stored
+    float left = sampleHeight(texel - ivec2(1, 0));
+    float right = sampleHeight(texel + ivec2(1, 0));
+    float back = sampleHeight(texel - ivec2(0, 1));
+    float front = sampleHeight(texel + ivec2(0, 1));
+    v_normal = normalize(vec3(left - right, 2.0 * u_mapParams.x, back - front));
+    v_texCoord = (u_pageOrigin.xy + a_position.xy) * u_mapParams.w;
+}
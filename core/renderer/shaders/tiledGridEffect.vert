@@ -0,0 +1,43 @@
+#version 310 es
+
+// a vertex of a TiledGrid3D, the effect is applied to it as set with setTile
+layout(location = POSITION) in vec4 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+// the coordinates of the tile in the grid
+layout(location = TEXCOORD1) in vec2 a_tile;
+
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // xy: origin of the grid rect, zw: size of a tile
+    vec4 u_grid;
+    // xy: size of the grid, z: the effect, see GridShaderEffect::Type
+    vec4 u_gridSize;
+    // the parameters of the effect, see GridShaderEffect::Type
+    vec4 u_params0;
+    vec4 u_params1;
+};
+
+const int WAVES_TILES_3D = 8;
+const int JUMP_TILES_3D  = 9;
+
+void main()
+{
+    vec3 v     = a_position.xyz;
+    int effect = int(u_gridSize.z + 0.5);
+
+    if (effect == WAVES_TILES_3D)
+    {
+        // the whole tile follows its bottom left corner
+        vec2 corner = u_grid.xy + a_tile * u_grid.zw;
+        v.z         = sin(u_params0.x + (corner.x + corner.y) * 0.01) * u_params0.y;
+    }
+    else if (effect == JUMP_TILES_3D)
+    {
+        v.z += mod(a_tile.x + a_tile.y, 2.0) < 0.5 ? u_params0.x : u_params0.y;
+    }
+
+    gl_Position = u_MVPMatrix * vec4(v, 1.0);
+    v_texCoord  = a_texCoord;
+}
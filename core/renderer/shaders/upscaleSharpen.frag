@@ -0,0 +1,31 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+
+layout(binding = 0) uniform sampler2D u_tex0;
+
+layout(std140) uniform fs_ub {
+    vec2 u_texelSize;
+    float u_sharpness;
+};
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+void main()
+{
+    // bilinear upscale, then a cross shaped unsharp mask clamped to the neighborhood to avoid halos
+    vec4 center = texture(u_tex0, v_texCoord);
+    vec4 left   = texture(u_tex0, v_texCoord - vec2(u_texelSize.x, 0.0));
+    vec4 right  = texture(u_tex0, v_texCoord + vec2(u_texelSize.x, 0.0));
+    vec4 top    = texture(u_tex0, v_texCoord - vec2(0.0, u_texelSize.y));
+    vec4 bottom = texture(u_tex0, v_texCoord + vec2(0.0, u_texelSize.y));
+
+    vec4 minColor = min(center, min(min(left, right), min(top, bottom)));
+    vec4 maxColor = max(center, max(max(left, right), max(top, bottom)));
+
+    vec4 sharpened = center + (4.0 * center - left - right - top - bottom) * (0.25 * u_sharpness);
+    FragColor = clamp(sharpened, minColor, maxColor);
+}
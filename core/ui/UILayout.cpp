@@ -47,6 +47,8 @@ namespace ui
 static const int BACKGROUNDIMAGE_Z         = (-1);
 static const int BCAKGROUNDCOLORRENDERER_Z = (-2);
 
+uint32_t Layout::s_layoutPassCount = 0;
+
 IMPLEMENT_CLASS_GUI_INFO(Layout)
 
 Layout::Layout()
@@ -76,6 +78,7 @@ Layout::Layout()
     , _stencilStateManager(new StencilStateManager())
     , _doLayoutDirty(true)
     , _isInterceptTouch(false)
+    , _layoutManager(nullptr)
     , _loopFocus(false)
     , _passFocusToChild(true)
     , _isFocusPassing(false)
@@ -86,6 +89,7 @@ Layout::Layout()
 Layout::~Layout()
 {
     AX_SAFE_RELEASE(_clippingStencil);
+    AX_SAFE_RELEASE(_layoutManager);
     AX_SAFE_DELETE(_stencilStateManager);
 }
 
@@ -891,6 +895,7 @@ void Layout::setLayoutType(Type type)
             supplyTheLayoutParameterLackToChild(static_cast<Widget*>(child));
         }
     }
+    AX_SAFE_RELEASE_NULL(_layoutManager);
     _doLayoutDirty = true;
 }
 
@@ -910,6 +915,14 @@ void Layout::requestDoLayout()
     _doLayoutDirty = true;
 }
 
+void Layout::onChildSizeChanged(Widget* /*child*/)
+{
+    if (_layoutType != Type::ABSOLUTE)
+    {
+        _doLayoutDirty = true;
+    }
+}
+
 Vec2 Layout::getLayoutContentSize() const
 {
     return this->getContentSize();
@@ -956,11 +969,16 @@ void Layout::doLayout()
 
     sortAllChildren();
 
-    LayoutManager* executant = this->createLayoutManager();
+    if (_layoutManager == nullptr)
+    {
+        _layoutManager = this->createLayoutManager();
+        AX_SAFE_RETAIN(_layoutManager);
+    }
 
-    if (executant)
+    if (_layoutManager)
     {
-        executant->doLayout(this);
+        _layoutManager->doLayout(this);
+        ++s_layoutPassCount;
     }
 
     _doLayoutDirty = false;
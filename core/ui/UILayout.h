@@ -405,6 +405,18 @@ public:
      */
     virtual void requestDoLayout();
 
+    /**
+     * Called when the size of a child widget changed, the layout is refreshed by the next visit.
+     * Only this layout is refreshed, a layout manager positions the children and doesn't change the size of the layout.
+     */
+    virtual void onChildSizeChanged(Widget* child);
+
+    /**
+     * The count of the layout passes run by all the layouts, a pass positions the children of one layout.
+     * Compare it between frames to find the layouts refreshed every frame.
+     */
+    static uint32_t getLayoutPassCount() { return s_layoutPassCount; }
+
     /**
      * @lua NA
      */
@@ -650,12 +662,17 @@ protected:
     bool _doLayoutDirty;
     bool _isInterceptTouch;
 
+    // created by the first layout pass of the layout type and reused by the next ones
+    LayoutManager* _layoutManager;
+
     // whether enable loop focus or not
     bool _loopFocus;
     // on default, it will pass the focus to the next nearest widget
     bool _passFocusToChild;
     // when finding the next focused widget, use this variable to pass focus between layout & widget
     bool _isFocusPassing;
+
+    static uint32_t s_layoutPassCount;
 };
 
 }  // namespace ui
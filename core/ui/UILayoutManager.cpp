@@ -43,7 +43,7 @@ LinearHorizontalLayoutManager* LinearHorizontalLayoutManager::create()
 void LinearHorizontalLayoutManager::doLayout(LayoutProtocol* layout)
 {
     Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
+    auto&& container        = layout->getLayoutElements();
     float leftBoundary      = 0.0f;
     for (auto&& subWidget : container)
     {
@@ -93,7 +93,7 @@ LinearVerticalLayoutManager* LinearVerticalLayoutManager::create()
 void LinearVerticalLayoutManager::doLayout(LayoutProtocol* layout)
 {
     Vec2 layoutSize         = layout->getLayoutContentSize();
-    Vector<Node*> container = layout->getLayoutElements();
+    auto&& container        = layout->getLayoutElements();
     float topBoundary       = layoutSize.height;
 
     for (auto&& subWidget : container)
@@ -285,7 +285,7 @@ RelativeLayoutManager* RelativeLayoutManager::create()
 
 Vector<Widget*> RelativeLayoutManager::getAllWidgets(ax::ui::LayoutProtocol* layout)
 {
-    Vector<Node*> container = layout->getLayoutElements();
+    auto&& container = layout->getLayoutElements();
     Vector<Widget*> widgetChildren;
     for (auto&& subWidget : container)
     {
@@ -297,6 +297,8 @@ Vector<Widget*> RelativeLayoutManager::getAllWidgets(ax::ui::LayoutProtocol* lay
             layoutParameter->_put = false;
             _unlayoutChildCount++;
             widgetChildren.pushBack(child);
+            // the first widget of a name is the relative one
+            _namedWidgets.emplace(layoutParameter->getRelativeName(), std::make_pair(child, layoutParameter));
         }
     }
     return widgetChildren;
@@ -310,19 +312,11 @@ Widget* RelativeLayoutManager::getRelativeWidget(Widget* widget)
 
     if (!relativeName.empty())
     {
-        for (auto&& sWidget : _widgetChildren)
+        auto iter = _namedWidgets.find(relativeName);
+        if (iter != _namedWidgets.end())
         {
-            if (sWidget)
-            {
-                RelativeLayoutParameter* rlayoutParameter =
-                    dynamic_cast<RelativeLayoutParameter*>(sWidget->getLayoutParameter());
-                if (rlayoutParameter && rlayoutParameter->getRelativeName() == relativeName)
-                {
-                    relativeWidget    = sWidget;
-                    _relativeWidgetLP = rlayoutParameter;
-                    break;
-                }
-            }
+            relativeWidget    = iter->second.first;
+            _relativeWidgetLP = iter->second.second;
         }
     }
     return relativeWidget;
@@ -652,8 +646,10 @@ void RelativeLayoutManager::doLayout(LayoutProtocol* layout)
 
     _widgetChildren = this->getAllWidgets(layout);
 
+    // a pass puts the widgets whose relative widget is put, until all are put or a pass puts none
     while (_unlayoutChildCount > 0)
     {
+        ssize_t putCount = 0;
         for (auto&& subWidget : _widgetChildren)
         {
             _widget = static_cast<Widget*>(subWidget);
@@ -679,11 +675,18 @@ void RelativeLayoutManager::doLayout(LayoutProtocol* layout)
                 _widget->setPosition(Vec2(_finalPositionX, _finalPositionY));
 
                 layoutParameter->_put = true;
+                ++putCount;
             }
         }
-        _unlayoutChildCount--;
+        if (putCount == 0)
+        {
+            break;
+        }
+        _unlayoutChildCount -= putCount;
     }
+    _unlayoutChildCount = 0;
     _widgetChildren.clear();
+    _namedWidgets.clear();
 }
 
 }  // namespace ui
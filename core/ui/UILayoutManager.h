@@ -27,6 +27,9 @@
 #ifndef _AX_LAYOUTMANAGER_H_
 #define _AX_LAYOUTMANAGER_H_
 
+#include <string_view>
+#include <unordered_map>
+
 #include "base/Object.h"
 #include "base/Vector.h"
 #include "ui/GUIExport.h"
@@ -159,6 +162,7 @@ private:
 
     ssize_t _unlayoutChildCount;
     Vector<Widget*> _widgetChildren;
+    std::unordered_map<std::string_view, std::pair<Widget*, RelativeLayoutParameter*>> _namedWidgets;
     Widget* _widget;
     float _finalPositionX;
     float _finalPositionY;
@@ -48,6 +48,9 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _virtualItemCount(0)
+    , _virtual(false)
+    , _virtualItemsDirty(false)
 {
     this->setTouchEnabled(true);
 }
@@ -321,6 +324,22 @@ void ListView::removeChild(ax::Node* child, bool cleanup)
             }
         }
         _items.eraseObject(widget);
+        if (_virtual)
+        {
+            // removed by the user, it is created again by the next layout
+            for (auto&& item : _virtualItems)
+            {
+                if (item.widget == widget)
+                {
+                    item.widget = nullptr;
+                }
+            }
+            for (auto&& pool : _virtualPools)
+            {
+                pool.second.eraseObject(widget);
+            }
+            _virtualItemsDirty = true;
+        }
         onItemListChanged();
     }
 
@@ -338,6 +357,13 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    if (_virtual)
+    {
+        // the visible items are created again by the next layout
+        _virtualItems.clear();
+        _virtualPools.clear();
+        requestDoLayout();
+    }
     onItemListChanged();
 }
 
@@ -381,6 +407,14 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index) const
 {
+    if (_virtual)
+    {
+        if (_virtualItems.empty() || index < _virtualItems.front().index || index > _virtualItems.back().index)
+        {
+            return nullptr;
+        }
+        return _virtualItems[index - _virtualItems.front().index].widget;
+    }
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -399,6 +433,17 @@ ssize_t ListView::getIndex(Widget* item) const
     {
         return -1;
     }
+    if (_virtual)
+    {
+        for (auto&& virtualItem : _virtualItems)
+        {
+            if (virtualItem.widget == item)
+            {
+                return virtualItem.index;
+            }
+        }
+        return -1;
+    }
     return _items.getIndex(item);
 }
 
@@ -530,16 +575,20 @@ void ListView::setDirection(Direction dir)
     case Direction::BOTH:
         break;
     case Direction::VERTICAL:
-        setLayoutType(Type::VERTICAL);
+        setLayoutType(_virtual ? Type::ABSOLUTE : Type::VERTICAL);
         break;
     case Direction::HORIZONTAL:
-        setLayoutType(Type::HORIZONTAL);
+        setLayoutType(_virtual ? Type::ABSOLUTE : Type::HORIZONTAL);
         break;
     default:
         return;
         break;
     }
     ScrollView::setDirection(dir);
+    if (_virtual)
+    {
+        requestDoLayout();
+    }
 }
 
 void ListView::requestDoLayout()
@@ -549,6 +598,18 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (_virtual)
+    {
+        // called by every visit, the visible items follow the inner container however it was moved
+        if (_innerContainerDoLayoutDirty)
+        {
+            updateVirtualLayout();
+            _innerContainerDoLayoutDirty = false;
+        }
+        updateVirtualItems();
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -566,6 +627,310 @@ void ListView::doLayout()
     _innerContainerDoLayoutDirty = false;
 }
 
+void ListView::setVirtualDataSource(const VirtualDataSource& dataSource, ssize_t itemCount)
+{
+    AXASSERT(dataSource.createItem && dataSource.bindItem, "createItem and bindItem are required!");
+
+    removeAllChildren();
+    _virtualTypeSizes.clear();
+    _virtualDataSource = dataSource;
+    _virtual           = true;
+    setLayoutType(Type::ABSOLUTE);
+    setVirtualItemCount(itemCount);
+}
+
+void ListView::removeVirtualDataSource()
+{
+    if (!_virtual)
+    {
+        return;
+    }
+    _virtual = false;
+    removeAllChildren();
+    _virtualDataSource = VirtualDataSource();
+    _virtualItemCount  = 0;
+    _virtualSizes.clear();
+    _virtualStarts.clear();
+    _virtualItems.clear();
+    _virtualPools.clear();
+    _virtualTypeSizes.clear();
+    setDirection(_direction);
+    requestDoLayout();
+}
+
+void ListView::setVirtualItemCount(ssize_t itemCount)
+{
+    if (!_virtual)
+    {
+        return;
+    }
+    _virtualItemCount = std::max<ssize_t>(itemCount, 0);
+    if (_curSelectedIndex >= _virtualItemCount)
+    {
+        _curSelectedIndex = -1;
+    }
+    onItemListChanged();
+    refreshVirtualItems();
+}
+
+void ListView::refreshVirtualItems()
+{
+    _virtualItemsDirty = true;
+    requestDoLayout();
+}
+
+void ListView::updateVirtualLayout()
+{
+    _virtualSizes.resize(_virtualItemCount);
+    _virtualStarts.resize(_virtualItemCount + 1);
+
+    bool vertical = _direction == Direction::VERTICAL;
+    float start   = 0.0f;
+    for (ssize_t i = 0; i < _virtualItemCount; ++i)
+    {
+        Vec2 size;
+        if (_virtualDataSource.itemSize)
+        {
+            size = _virtualDataSource.itemSize(i);
+        }
+        else
+        {
+            int type  = _virtualDataSource.itemType ? _virtualDataSource.itemType(i) : 0;
+            auto iter = _virtualTypeSizes.find(type);
+            if (iter == _virtualTypeSizes.end())
+            {
+                // measure a template, it waits in the pool for the first item of its type
+                VirtualItem item{obtainVirtualItem(type), -1, type};
+                const Vec2& contentSize = item.widget->getContentSize();
+                iter = _virtualTypeSizes.emplace(type, Vec2(contentSize.width * item.widget->getScaleX(),
+                                                            contentSize.height * item.widget->getScaleY())).first;
+                recycleVirtualItem(item);
+            }
+            size = iter->second;
+        }
+        _virtualSizes[i]  = size;
+        _virtualStarts[i] = start;
+        start += (vertical ? size.height : size.width) + _itemsMargin;
+    }
+    _virtualStarts[_virtualItemCount] = start;
+
+    float length = (_virtualItemCount == 0) ? 0.0f : start - _itemsMargin;
+    if (vertical)
+    {
+        length += (_virtualItemCount == 0) ? 0.0f : _topPadding + _bottomPadding;
+        setInnerContainerSize(Vec2(_contentSize.width, length));
+    }
+    else
+    {
+        length += (_virtualItemCount == 0) ? 0.0f : _leftPadding + _rightPadding;
+        setInnerContainerSize(Vec2(length, _contentSize.height));
+    }
+    // the visible items are placed again
+    _virtualItemsDirty = true;
+}
+
+void ListView::updateVirtualItems()
+{
+    // the range of the view along the direction, from the start of the items
+    ssize_t first = 0;
+    ssize_t last  = -1;
+    if (_virtualItemCount > 0)
+    {
+        const Vec2& innerPosition = _innerContainer->getPosition();
+        float viewStart, viewEnd;
+        if (_direction == Direction::VERTICAL)
+        {
+            viewStart = _innerContainer->getContentSize().height + innerPosition.y - _contentSize.height - _topPadding;
+            viewEnd   = viewStart + _contentSize.height;
+        }
+        else
+        {
+            viewStart = -innerPosition.x - _leftPadding;
+            viewEnd   = viewStart + _contentSize.width;
+        }
+        auto begin = _virtualStarts.begin();
+        auto end   = begin + _virtualItemCount;
+        first      = std::max<ssize_t>(std::upper_bound(begin, end, viewStart) - begin - 1, 0);
+        last       = std::lower_bound(begin, end, viewEnd) - begin - 1;
+        // the item ending in the margin before the view isn't visible
+        if (first < last && _virtualStarts[first + 1] - _itemsMargin <= viewStart)
+        {
+            ++first;
+        }
+    }
+
+    if (!_virtualItemsDirty && !_virtualItems.empty() && first == _virtualItems.front().index &&
+        last == _virtualItems.back().index)
+    {
+        return;
+    }
+    if (!_virtualItemsDirty && _virtualItems.empty() && last < first)
+    {
+        return;
+    }
+
+    std::vector<VirtualItem> visibleItems(std::max<ssize_t>(last - first + 1, 0), VirtualItem{nullptr, -1, 0});
+    for (auto&& item : _virtualItems)
+    {
+        if (item.widget == nullptr)
+        {
+            continue;
+        }
+        if (!_virtualItemsDirty && item.index >= first && item.index <= last)
+        {
+            visibleItems[item.index - first] = item;
+        }
+        else
+        {
+            recycleVirtualItem(item);
+        }
+    }
+    _virtualItemsDirty = false;
+
+    _items.clear();
+    for (ssize_t i = first; i <= last; ++i)
+    {
+        auto& item = visibleItems[i - first];
+        if (item.widget == nullptr)
+        {
+            item.index  = i;
+            item.type   = _virtualDataSource.itemType ? _virtualDataSource.itemType(i) : 0;
+            item.widget = obtainVirtualItem(item.type);
+            _virtualDataSource.bindItem(item.widget, i);
+            placeVirtualItem(item);
+        }
+        _items.pushBack(item.widget);
+    }
+    _virtualItems.swap(visibleItems);
+}
+
+Widget* ListView::obtainVirtualItem(int type)
+{
+    auto& pool = _virtualPools[type];
+    if (pool.empty())
+    {
+        Widget* widget = _virtualDataSource.createItem(type);
+        AXASSERT(widget != nullptr, "createItem returned a nullptr!");
+        ScrollView::addChild(widget);
+        return widget;
+    }
+    Widget* widget = pool.back();
+    pool.popBack();
+    widget->setVisible(true);
+    return widget;
+}
+
+void ListView::recycleVirtualItem(const VirtualItem& item)
+{
+    // the recycled templates stay in the inner container, hidden, to reuse them without leaving the scene
+    item.widget->setVisible(false);
+    _virtualPools[item.type].pushBack(item.widget);
+}
+
+void ListView::placeVirtualItem(const VirtualItem& item)
+{
+    Widget* widget          = item.widget;
+    const Vec2& size        = _virtualSizes[item.index];
+    const Vec2& anchorPoint = widget->isIgnoreAnchorPointForPosition() ? Vec2::ZERO : widget->getAnchorPoint();
+    widget->setPosition(calculateVirtualItemOrigin(item.index) +
+                        Vec2(size.width * anchorPoint.x, size.height * anchorPoint.y));
+}
+
+Vec2 ListView::calculateVirtualItemOrigin(ssize_t index) const
+{
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    const Vec2& size      = _virtualSizes[index];
+
+    Vec2 origin;
+    if (_direction == Direction::VERTICAL)
+    {
+        origin.y = innerSize.height - _topPadding - _virtualStarts[index] - size.height;
+        switch (_gravity)
+        {
+        case Gravity::RIGHT:
+            origin.x = innerSize.width - _rightPadding - size.width;
+            break;
+        case Gravity::CENTER_HORIZONTAL:
+            origin.x = _leftPadding + (innerSize.width - _leftPadding - _rightPadding - size.width) / 2;
+            break;
+        default:
+            origin.x = _leftPadding;
+            break;
+        }
+    }
+    else
+    {
+        origin.x = _leftPadding + _virtualStarts[index];
+        switch (_gravity)
+        {
+        case Gravity::BOTTOM:
+            origin.y = _bottomPadding;
+            break;
+        case Gravity::CENTER_VERTICAL:
+            origin.y = _bottomPadding + (innerSize.height - _topPadding - _bottomPadding - size.height) / 2;
+            break;
+        default:
+            origin.y = innerSize.height - _topPadding - size.height;
+            break;
+        }
+    }
+    return origin;
+}
+
+Vec2 ListView::calculateVirtualItemPosition(ssize_t index, const Vec2& itemAnchorPoint) const
+{
+    const Vec2& size = _virtualSizes[index];
+    return calculateVirtualItemOrigin(index) + Vec2(size.width * itemAnchorPoint.x, size.height * itemAnchorPoint.y);
+}
+
+Vec2 ListView::calculateVirtualItemDestination(ssize_t index,
+                                               const Vec2& positionRatioInView,
+                                               const Vec2& itemAnchorPoint)
+{
+    Vec2 positionInView(_contentSize.width * positionRatioInView.x, _contentSize.height * positionRatioInView.y);
+    return -(calculateVirtualItemPosition(index, itemAnchorPoint) - positionInView);
+}
+
+ssize_t ListView::getClosestVirtualIndex(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const
+{
+    if (_virtualItemCount == 0)
+    {
+        return -1;
+    }
+
+    // the items are sorted along the direction, find the first one whose anchor is past the target
+    bool vertical = _direction == Direction::VERTICAL;
+    float target  = vertical ? _innerContainer->getContentSize().height - _topPadding - targetPosition.y
+                             : targetPosition.x - _leftPadding;
+    auto anchorOf = [&](ssize_t i) {
+        return vertical ? _virtualStarts[i] + _virtualSizes[i].height * (1.0f - itemAnchorPoint.y)
+                        : _virtualStarts[i] + _virtualSizes[i].width * itemAnchorPoint.x;
+    };
+    ssize_t low  = 0;
+    ssize_t high = _virtualItemCount;
+    while (low < high)
+    {
+        ssize_t mid = (low + high) / 2;
+        if (anchorOf(mid) < target)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (low == _virtualItemCount)
+    {
+        return low - 1;
+    }
+    if (low > 0 && target - anchorOf(low - 1) <= anchorOf(low) - target)
+    {
+        return low - 1;
+    }
+    return low;
+}
+
 void ListView::addEventListener(const ccListViewCallback& callback)
 {
     _eventCallback = callback;
@@ -675,6 +1040,10 @@ static Widget* findClosestItem(const Vec2& targetPosition,
 
 Widget* ListView::getClosestItemToPosition(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const
 {
+    if (_virtual)
+    {
+        return getItem(getClosestVirtualIndex(targetPosition, itemAnchorPoint));
+    }
     if (_items.empty())
     {
         return nullptr;
@@ -813,14 +1182,26 @@ void ListView::jumpToPercentBothDirection(const Vec2& percent)
 
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    Vec2 destination;
+    if (_virtual)
     {
-        return;
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint);
+    }
+    else
+    {
+        Widget* item = getItem(itemIndex);
+        if (item == nullptr)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     }
-    doLayout();
-
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -840,6 +1221,17 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (_virtual)
+    {
+        if (itemIndex < 0 || itemIndex >= _virtualItemCount)
+        {
+            return;
+        }
+        doLayout();
+        startAutoScrollToDestination(calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint),
+                                     timeInSec, true);
+        return;
+    }
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
@@ -855,8 +1247,7 @@ ssize_t ListView::getCurSelectedIndex() const
 
 void ListView::setCurSelectedIndex(int itemIndex)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    if (_virtual ? (itemIndex < 0 || itemIndex >= _virtualItemCount) : getItem(itemIndex) == nullptr)
     {
         return;
     }
@@ -882,6 +1273,11 @@ Widget* ListView::createCloneInstance()
 
 void ListView::copyClonedWidgetChildren(Widget* model)
 {
+    // the items of a virtual list are created by its data source
+    if (static_cast<ListView*>(model)->isVirtual())
+    {
+        return;
+    }
     auto& arrayItems = static_cast<ListView*>(model)->getItems();
     for (auto&& item : arrayItems)
     {
@@ -899,12 +1295,16 @@ void ListView::copySpecialProperties(Widget* model)
         setItemsMargin(listViewEx->_itemsMargin);
         setGravity(listViewEx->_gravity);
         _eventCallback = listViewEx->_eventCallback;
+        if (listViewEx->_virtual)
+        {
+            setVirtualDataSource(listViewEx->_virtualDataSource, listViewEx->_virtualItemCount);
+        }
     }
 }
 
 Vec2 ListView::getHowMuchOutOfBoundary(const Vec2& addition)
 {
-    if (!_magneticAllowedOutOfBoundary || _items.empty())
+    if (!_magneticAllowedOutOfBoundary || isItemListEmpty())
     {
         return ScrollView::getHowMuchOutOfBoundary(addition);
     }
@@ -923,29 +1323,30 @@ Vec2 ListView::getHowMuchOutOfBoundary(const Vec2& addition)
     float topBoundary    = _topBoundary;
     float bottomBoundary = _bottomBoundary;
     {
-        ssize_t lastItemIndex = _items.size() - 1;
-        Vec2 contentSize      = getContentSize();
+        Vec2 contentSize   = getContentSize();
+        Vec2 firstItemSize = _virtual ? _virtualSizes.front() : _items.at(0)->getContentSize();
+        Vec2 lastItemSize  = _virtual ? _virtualSizes.back() : _items.at(_items.size() - 1)->getContentSize();
         Vec2 firstItemAdjustment, lastItemAdjustment;
         if (_magneticType == MagneticType::CENTER)
         {
-            firstItemAdjustment = (contentSize - _items.at(0)->getContentSize()) / 2;
-            lastItemAdjustment  = (contentSize - _items.at(lastItemIndex)->getContentSize()) / 2;
+            firstItemAdjustment = (contentSize - firstItemSize) / 2;
+            lastItemAdjustment  = (contentSize - lastItemSize) / 2;
         }
         else if (_magneticType == MagneticType::LEFT)
         {
-            lastItemAdjustment = contentSize - _items.at(lastItemIndex)->getContentSize();
+            lastItemAdjustment = contentSize - lastItemSize;
         }
         else if (_magneticType == MagneticType::RIGHT)
         {
-            firstItemAdjustment = contentSize - _items.at(0)->getContentSize();
+            firstItemAdjustment = contentSize - firstItemSize;
         }
         else if (_magneticType == MagneticType::TOP)
         {
-            lastItemAdjustment = contentSize - _items.at(lastItemIndex)->getContentSize();
+            lastItemAdjustment = contentSize - lastItemSize;
         }
         else if (_magneticType == MagneticType::BOTTOM)
         {
-            firstItemAdjustment = contentSize - _items.at(0)->getContentSize();
+            firstItemAdjustment = contentSize - firstItemSize;
         }
         leftBoundary += firstItemAdjustment.x;
         rightBoundary -= lastItemAdjustment.x;
@@ -1007,7 +1408,7 @@ void ListView::startAttenuatingAutoScroll(const Vec2& deltaMove, const Vec2& ini
 {
     Vec2 adjustedDeltaMove = deltaMove;
 
-    if (!_items.empty() && _magneticType != MagneticType::NONE)
+    if (!isItemListEmpty() && _magneticType != MagneticType::NONE)
     {
         adjustedDeltaMove = flattenVectorByDirection(adjustedDeltaMove);
 
@@ -1033,9 +1434,21 @@ void ListView::startAttenuatingAutoScroll(const Vec2& deltaMove, const Vec2& ini
             magneticPosition.x += getContentSize().width * magneticAnchorPoint.x;
             magneticPosition.y += getContentSize().height * magneticAnchorPoint.y;
 
-            Widget* pTargetItem = getClosestItemToPosition(magneticPosition - adjustedDeltaMove, magneticAnchorPoint);
-            Vec2 itemPosition   = calculateItemPositionWithAnchor(pTargetItem, magneticAnchorPoint);
-            adjustedDeltaMove   = magneticPosition - itemPosition;
+            Vec2 itemPosition;
+            if (_virtual)
+            {
+                // the target item may be out of the view, not instantiated
+                ssize_t targetIndex =
+                    getClosestVirtualIndex(magneticPosition - adjustedDeltaMove, magneticAnchorPoint);
+                itemPosition = calculateVirtualItemPosition(targetIndex, magneticAnchorPoint);
+            }
+            else
+            {
+                Widget* pTargetItem =
+                    getClosestItemToPosition(magneticPosition - adjustedDeltaMove, magneticAnchorPoint);
+                itemPosition = calculateItemPositionWithAnchor(pTargetItem, magneticAnchorPoint);
+            }
+            adjustedDeltaMove = magneticPosition - itemPosition;
         }
     }
     ScrollView::startAttenuatingAutoScroll(adjustedDeltaMove, initialVelocity);
@@ -1043,7 +1456,7 @@ void ListView::startAttenuatingAutoScroll(const Vec2& deltaMove, const Vec2& ini
 
 void ListView::startMagneticScroll()
 {
-    if (_items.empty() || _magneticType == MagneticType::NONE)
+    if (isItemListEmpty() || _magneticType == MagneticType::NONE)
     {
         return;
     }
@@ -1054,6 +1467,12 @@ void ListView::startMagneticScroll()
     magneticPosition.x += getContentSize().width * magneticAnchorPoint.x;
     magneticPosition.y += getContentSize().height * magneticAnchorPoint.y;
 
+    if (_virtual)
+    {
+        scrollToItem(getClosestVirtualIndex(magneticPosition, magneticAnchorPoint), magneticAnchorPoint,
+                     magneticAnchorPoint);
+        return;
+    }
     Widget* pTargetItem = getClosestItemToPosition(magneticPosition, magneticAnchorPoint);
     scrollToItem(getIndex(pTargetItem), magneticAnchorPoint, magneticAnchorPoint);
 }
@@ -27,6 +27,9 @@ THE SOFTWARE.
 #ifndef __UILISTVIEW_H__
 #define __UILISTVIEW_H__
 
+#include <unordered_map>
+#include <vector>
+
 #include "ui/UIScrollView.h"
 #include "ui/GUIExport.h"
 
@@ -43,9 +46,9 @@ namespace ui
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
- *ScrollView.
+ * @warning The items added to a ListView are all created and laid out, if you have a large amount of data to display,
+ *use the virtual mode, see `setVirtualDataSource`. ListView is a subclass of  `ScrollView`, so it shares many features
+ *of ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
 {
@@ -96,6 +99,21 @@ public:
      */
     typedef std::function<void(Object*, EventType)> ccListViewCallback;
 
+    /**
+     * Supplies the items of a virtual ListView.
+     */
+    struct VirtualDataSource
+    {
+        /** Returns the template type of an item, all the items are of type 0 when it is null. */
+        std::function<int(ssize_t index)> itemType;
+        /** Returns the size of an item, the size of the first template of its type is used when it is null. */
+        std::function<Vec2(ssize_t index)> itemSize;
+        /** Creates a template of a type, the templates are reused by all the items of their type. */
+        std::function<Widget*(int type)> createItem;
+        /** Fills a template with the data of an item. */
+        std::function<void(Widget* item, ssize_t index)> bindItem;
+    };
+
     /**
      * Default constructor
      * @js ctor
@@ -191,6 +209,45 @@ public:
      */
     ssize_t getIndex(Widget* item) const;
 
+    /**
+     * @brief Turn the ListView into a virtual list of itemCount items.
+     *
+     * Only the items in the view are instantiated: a template is created for each visible item, filled by the bind
+     * function, and reused for another item of its type when it is scrolled out of the view. The inner container is
+     * sized from the sizes of the items, so scrolling and the scroll bars behave as if all the items existed.
+     * The current items are removed. In virtual mode the indices are the indices of the data source, `getItem` and
+     * `getItems` only return the visible items, and the items are not added with `pushBackCustomItem` and the like.
+     *
+     * @param dataSource The functions supplying the items, createItem and bindItem are required.
+     * @param itemCount The item count.
+     */
+    void setVirtualDataSource(const VirtualDataSource& dataSource, ssize_t itemCount);
+
+    /**
+     * Remove the virtual data source and its items, the ListView takes the items added to it again.
+     */
+    void removeVirtualDataSource();
+
+    /**
+     * Query whether the ListView is virtual.
+     */
+    bool isVirtual() const { return _virtual; }
+
+    /**
+     * Change the item count of a virtual ListView, the visible items are bound again.
+     */
+    void setVirtualItemCount(ssize_t itemCount);
+
+    /**
+     * Query the item count of a virtual ListView.
+     */
+    ssize_t getVirtualItemCount() const { return _virtualItemCount; }
+
+    /**
+     * Query the sizes of the items and bind the visible items again, after the data of a virtual ListView changed.
+     */
+    void refreshVirtualItems();
+
     /**
      * Set the gravity of ListView.
      * @see `ListViewGravity`
@@ -444,6 +501,27 @@ protected:
 
     void startMagneticScroll();
 
+    struct VirtualItem
+    {
+        Widget* widget;
+        ssize_t index;
+        int type;
+    };
+
+    bool isItemListEmpty() const { return _virtual ? _virtualItemCount == 0 : _items.empty(); }
+    /** Query the sizes of the virtual items and size the inner container. */
+    void updateVirtualLayout();
+    /** Recycle the virtual items scrolled out of the view and bind the ones scrolled into it. */
+    void updateVirtualItems();
+    Widget* obtainVirtualItem(int type);
+    void recycleVirtualItem(const VirtualItem& item);
+    void placeVirtualItem(const VirtualItem& item);
+    /** The bottom left corner of a virtual item in the inner container, where it is or would be placed. */
+    Vec2 calculateVirtualItemOrigin(ssize_t index) const;
+    Vec2 calculateVirtualItemPosition(ssize_t index, const Vec2& itemAnchorPoint) const;
+    Vec2 calculateVirtualItemDestination(ssize_t index, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint);
+    ssize_t getClosestVirtualIndex(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const;
+
 protected:
     Widget* _model;
 
@@ -465,6 +543,16 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    VirtualDataSource _virtualDataSource;
+    ssize_t _virtualItemCount;
+    std::vector<Vec2> _virtualSizes;
+    std::vector<float> _virtualStarts;       // distance of each item from the start of the items, along the direction
+    std::vector<VirtualItem> _virtualItems;  // visible, in index order
+    std::unordered_map<int, Vector<Widget*>> _virtualPools;
+    std::unordered_map<int, Vec2> _virtualTypeSizes;
+    bool _virtual;
+    bool _virtualItemsDirty;
 };
 
 }  // namespace ui
@@ -964,46 +964,64 @@ MediaPlayer::MediaPlayer()
 
             auto& bufferDim = frame._vpd._dim;
 
-            switch (pixelFormat)
-            {
-            case MEVideoPixelFormat::YUY2:
-            {
-                pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RG8, PixelFormat::RG8,
-                                               bufferDim.x, bufferDim.y, false, 0);
-                pvd->_vchromaTexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RGBA8,
-                                                     PixelFormat::RGBA8, bufferDim.x >> 1, bufferDim.y, false, 0);
-                break;
-            }
-            case MEVideoPixelFormat::NV12:
-            {
-                pvd->_vtexture->updateWithData(frame._dataPointer, bufferDim.x * bufferDim.y, PixelFormat::R8,
-                                               PixelFormat::R8, bufferDim.x, bufferDim.y, false, 0);
-                pvd->_vchromaTexture->updateWithData(frame._cbcrDataPointer, (bufferDim.x * bufferDim.y) >> 1,
-                                                     PixelFormat::RG8, PixelFormat::RG8, bufferDim.x >> 1,
-                                                     bufferDim.y >> 1, false, 0);
-                break;
+            if (frame._nativePlanes[0])
+            {  // decoded on the GPU, the textures sample its planes without a copy
+                if (pixelFormat == MEVideoPixelFormat::NV12)
+                {
+                    pvd->_vtexture->updateWithNativeTexture(frame._nativePlanes[0], PixelFormat::R8, bufferDim.x,
+                                                            bufferDim.y);
+                    pvd->_vchromaTexture->updateWithNativeTexture(frame._nativePlanes[1], PixelFormat::RG8,
+                                                                  (bufferDim.x + 1) >> 1, (bufferDim.y + 1) >> 1);
+                }
+                else
+                {
+                    auto format = pixelFormat == MEVideoPixelFormat::RGB32 ? PixelFormat::RGBA8 : PixelFormat::BGRA8;
+                    pvd->_vtexture->updateWithNativeTexture(frame._nativePlanes[0], format, bufferDim.x, bufferDim.y);
+                }
             }
-            case MEVideoPixelFormat::I420:
+            else
             {
-                pvd->_vtexture->updateWithData(frame._dataPointer, bufferDim.x * bufferDim.y, PixelFormat::R8,
-                                               PixelFormat::R8, bufferDim.x, bufferDim.y, false, 0);
-                const auto chromaTexDataSize = (bufferDim.x * bufferDim.y) >> 2;
-                pvd->_vchromaTexture->updateWithData(frame._cbcrDataPointer, chromaTexDataSize, PixelFormat::R8,
-                                                     PixelFormat::R8, bufferDim.x >> 1, bufferDim.y >> 1, false, 0);
-                pvd->_vchroma2Texture->updateWithData(frame._cbcrDataPointer + chromaTexDataSize, chromaTexDataSize,
-                                                      PixelFormat::R8, PixelFormat::R8, bufferDim.x >> 1,
-                                                      bufferDim.y >> 1, false, 0);
-                break;
-            }
-            case MEVideoPixelFormat::RGB32:
-                pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RGBA8,
-                                               PixelFormat::RGBA8, bufferDim.x, bufferDim.y, false, 0);
-                break;
-            case MEVideoPixelFormat::BGR32:
-                pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::BGRA8,
-                                               PixelFormat::BGRA8, bufferDim.x, bufferDim.y, false, 0);
-                break;
-            default:;
+                switch (pixelFormat)
+                {
+                case MEVideoPixelFormat::YUY2:
+                {
+                    pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RG8,
+                                                   PixelFormat::RG8, bufferDim.x, bufferDim.y, false, 0);
+                    pvd->_vchromaTexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RGBA8,
+                                                         PixelFormat::RGBA8, bufferDim.x >> 1, bufferDim.y, false, 0);
+                    break;
+                }
+                case MEVideoPixelFormat::NV12:
+                {
+                    pvd->_vtexture->updateWithData(frame._dataPointer, bufferDim.x * bufferDim.y, PixelFormat::R8,
+                                                   PixelFormat::R8, bufferDim.x, bufferDim.y, false, 0);
+                    pvd->_vchromaTexture->updateWithData(frame._cbcrDataPointer, (bufferDim.x * bufferDim.y) >> 1,
+                                                         PixelFormat::RG8, PixelFormat::RG8, bufferDim.x >> 1,
+                                                         bufferDim.y >> 1, false, 0);
+                    break;
+                }
+                case MEVideoPixelFormat::I420:
+                {
+                    pvd->_vtexture->updateWithData(frame._dataPointer, bufferDim.x * bufferDim.y, PixelFormat::R8,
+                                                   PixelFormat::R8, bufferDim.x, bufferDim.y, false, 0);
+                    const auto chromaTexDataSize = (bufferDim.x * bufferDim.y) >> 2;
+                    pvd->_vchromaTexture->updateWithData(frame._cbcrDataPointer, chromaTexDataSize, PixelFormat::R8,
+                                                         PixelFormat::R8, bufferDim.x >> 1, bufferDim.y >> 1, false, 0);
+                    pvd->_vchroma2Texture->updateWithData(frame._cbcrDataPointer + chromaTexDataSize, chromaTexDataSize,
+                                                          PixelFormat::R8, PixelFormat::R8, bufferDim.x >> 1,
+                                                          bufferDim.y >> 1, false, 0);
+                    break;
+                }
+                case MEVideoPixelFormat::RGB32:
+                    pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::RGBA8,
+                                                   PixelFormat::RGBA8, bufferDim.x, bufferDim.y, false, 0);
+                    break;
+                case MEVideoPixelFormat::BGR32:
+                    pvd->_vtexture->updateWithData(frame._dataPointer, frame._dataLen, PixelFormat::BGRA8,
+                                                   PixelFormat::BGRA8, bufferDim.x, bufferDim.y, false, 0);
+                    break;
+                default:;
+                }
             }
             if (bPixelDescChnaged)
             {
@@ -36,6 +36,7 @@
 #include "base/EventListenerTouch.h"
 #include "base/EventDispatcher.h"
 #include "base/Director.h"
+#include "2d/FontAtlas.h"
 #include "2d/Label.h"
 #include "2d/Sprite.h"
 #include "base/UTF8.h"
@@ -1769,6 +1770,15 @@ void RichText::formatText(bool force)
     if (_formatTextDirty)
     {
         this->removeAllProtectedChildren();
+        for (auto&& renderers : _textRenderers)
+        {
+            auto& freeRenderers = _freeTextRenderers[renderers.first];
+            for (auto&& label : renderers.second)
+            {
+                freeRenderers.pushBack(label);
+            }
+        }
+        _textRenderers.clear();
         _elementRenders.clear();
         _lineHeights.clear();
         if (_ignoreSize)
@@ -1783,39 +1793,10 @@ void RichText::formatText(bool force)
                 case RichElement::Type::TEXT:
                 {
                     RichElementText* elmtText = static_cast<RichElementText*>(element);
-                    Label* label;
-                    if (FileUtils::getInstance()->isFileExist(elmtText->_fontName))
-                    {
-                        label = Label::createWithTTF(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    else
-                    {
-                        label = Label::createWithSystemFont(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    if (elmtText->_flags & RichElementText::ITALICS_FLAG)
-                        label->enableItalics();
-                    if (elmtText->_flags & RichElementText::BOLD_FLAG)
-                        label->enableBold();
-                    if (elmtText->_flags & RichElementText::UNDERLINE_FLAG)
-                        label->enableUnderline();
-                    if (elmtText->_flags & RichElementText::STRIKETHROUGH_FLAG)
-                        label->enableStrikethrough();
-                    if (elmtText->_flags & RichElementText::URL_FLAG)
-                        label->addComponent(UrlTouchListenerComponent::create(
-                            label, elmtText->_url, [this](std::string_view url) { openUrl(url); }));
-                    if (elmtText->_flags & RichElementText::OUTLINE_FLAG)
-                    {
-                        label->enableOutline(Color4B(elmtText->_outlineColor), elmtText->_outlineSize);
-                    }
-                    if (elmtText->_flags & RichElementText::SHADOW_FLAG)
-                    {
-                        label->enableShadow(Color4B(elmtText->_shadowColor), elmtText->_shadowOffset,
-                                            elmtText->_shadowBlurRadius);
-                    }
-                    if (elmtText->_flags & RichElementText::GLOW_FLAG)
-                    {
-                        label->enableGlow(Color4B(elmtText->_glowColor));
-                    }
+                    Label* label              = obtainTextRenderer(
+                        elmtText->_text, elmtText->_fontName, elmtText->_fontSize, elmtText->_flags, elmtText->_url,
+                        elmtText->_outlineColor, elmtText->_outlineSize, elmtText->_shadowColor,
+                        elmtText->_shadowOffset, elmtText->_shadowBlurRadius, elmtText->_glowColor);
                     label->setTextColor(Color4B(elmtText->_color));
 
                     label->setName(elmtText->_id);
@@ -1923,10 +1904,74 @@ void RichText::formatText(bool force)
             }
         }
         formatRenderers();
+        _freeTextRenderers.clear();
         _formatTextDirty = false;
     }
 }
 
+Label* RichText::obtainTextRenderer(std::string_view text,
+                                    std::string_view fontName,
+                                    float fontSize,
+                                    uint32_t flags,
+                                    std::string_view url,
+                                    const Color3B& outlineColor,
+                                    int outlineSize,
+                                    const Color3B& shadowColor,
+                                    const Vec2& shadowOffset,
+                                    int shadowBlurRadius,
+                                    const Color3B& glowColor)
+{
+    // the effects are part of the style, a reused label only changes its string, color and url
+    const uint32_t effectFlags = flags & ~RichElementText::URL_FLAG;
+    std::string style = fmt::format("{}|{}|{}", fontName, fontSize, effectFlags);
+    if (flags & RichElementText::OUTLINE_FLAG)
+        fmt::format_to(std::back_inserter(style), "|o{},{},{},{}", outlineColor.r, outlineColor.g, outlineColor.b,
+                       outlineSize);
+    if (flags & RichElementText::SHADOW_FLAG)
+        fmt::format_to(std::back_inserter(style), "|s{},{},{},{},{},{}", shadowColor.r, shadowColor.g, shadowColor.b,
+                       shadowOffset.x, shadowOffset.y, shadowBlurRadius);
+    if (flags & RichElementText::GLOW_FLAG)
+        fmt::format_to(std::back_inserter(style), "|g{},{},{}", glowColor.r, glowColor.g, glowColor.b);
+
+    Label* label = nullptr;
+    auto iter    = _freeTextRenderers.find(style);
+    if (iter != _freeTextRenderers.end() && !iter->second.empty())
+    {
+        label = iter->second.back();
+        _textRenderers[style].pushBack(label);
+        iter->second.popBack();
+
+        label->setString(text);
+        label->setName("");
+        label->removeComponent(UrlTouchListenerComponent::COMPONENT_NAME);
+    }
+    else
+    {
+        label = FileUtils::getInstance()->isFileExist(fontName) ? Label::createWithTTF(text, fontName, fontSize)
+                                                                : Label::createWithSystemFont(text, fontName, fontSize);
+        _textRenderers[style].pushBack(label);
+
+        if (flags & RichElementText::ITALICS_FLAG)
+            label->enableItalics();
+        if (flags & RichElementText::BOLD_FLAG)
+            label->enableBold();
+        if (flags & RichElementText::UNDERLINE_FLAG)
+            label->enableUnderline();
+        if (flags & RichElementText::STRIKETHROUGH_FLAG)
+            label->enableStrikethrough();
+        if (flags & RichElementText::OUTLINE_FLAG)
+            label->enableOutline(Color4B(outlineColor), outlineSize);
+        if (flags & RichElementText::SHADOW_FLAG)
+            label->enableShadow(Color4B(shadowColor), shadowOffset, shadowBlurRadius);
+        if (flags & RichElementText::GLOW_FLAG)
+            label->enableGlow(Color4B(glowColor));
+    }
+    if (flags & RichElementText::URL_FLAG)
+        label->addComponent(
+            UrlTouchListenerComponent::create(label, url, [this](std::string_view url) { openUrl(url); }));
+    return label;
+}
+
 namespace
 {
 inline bool isUTF8CharWrappable(const StringUtils::StringUTF8::CharUTF8& ch)
@@ -2023,6 +2068,39 @@ int findSplitPositionForWord(Label* label,
     return idx;
 }
 
+/** Estimates the count of the first chars of a label's text fitting in a width, from the advances of its glyphs,
+    -1 when the label has no font atlas. */
+int estimateFittingLength(Label* label, const StringUtils::StringUTF8& text, float textWidth, float width)
+{
+    FontAtlas* fontAtlas = label->getFontAtlas();
+    std::u32string utf32Text;
+    if (!fontAtlas || textWidth <= 0.0f || !StringUtils::UTF8ToUTF32(text.getAsCharSequence(), utf32Text))
+        return -1;
+
+    std::vector<float> advances(utf32Text.size());
+    float totalAdvance = 0.0f;
+    FontLetterDefinition letterDef;
+    for (size_t i = 0; i < utf32Text.size(); ++i)
+    {
+        if (fontAtlas->getLetterDefinitionForChar(utf32Text[i], letterDef))
+            advances[i] = letterDef.xAdvance;
+        totalAdvance += advances[i];
+    }
+    if (totalAdvance <= 0.0f)
+        return -1;
+
+    // the advances are scaled to the width the label measured, its font scale and kerning included
+    const float scale = textWidth / totalAdvance;
+    float advance     = 0.0f;
+    for (size_t i = 0; i < advances.size(); ++i)
+    {
+        advance += advances[i] * scale;
+        if (advance > width)
+            return static_cast<int>(i);
+    }
+    return static_cast<int>(advances.size());
+}
+
 int findSplitPositionForChar(Label* label,
                              const StringUtils::StringUTF8& text,
                              int estimatedIdx,
@@ -2094,7 +2172,6 @@ void RichText::handleTextRenderer(std::string_view text,
                                   const Color3B& glowColor,
                                   std::string_view id)
 {
-    bool fileExist              = FileUtils::getInstance()->isFileExist(fontName);
     RichText::WrapMode wrapMode = static_cast<RichText::WrapMode>(_defaults.at(KEY_WRAP_MODE).asInt());
 
     // split text by \n
@@ -2123,26 +2200,9 @@ void RichText::handleTextRenderer(std::string_view text,
             }
             ++splitParts;
 
-            Label* textRenderer = fileExist ? Label::createWithTTF(currentText, fontName, fontSize)
-                                            : Label::createWithSystemFont(currentText, fontName, fontSize);
-
-            if (flags & RichElementText::ITALICS_FLAG)
-                textRenderer->enableItalics();
-            if (flags & RichElementText::BOLD_FLAG)
-                textRenderer->enableBold();
-            if (flags & RichElementText::UNDERLINE_FLAG)
-                textRenderer->enableUnderline();
-            if (flags & RichElementText::STRIKETHROUGH_FLAG)
-                textRenderer->enableStrikethrough();
-            if (flags & RichElementText::URL_FLAG)
-                textRenderer->addComponent(UrlTouchListenerComponent::create(
-                    textRenderer, url, [this](std::string_view url) { openUrl(url); }));
-            if (flags & RichElementText::OUTLINE_FLAG)
-                textRenderer->enableOutline(Color4B(outlineColor), outlineSize);
-            if (flags & RichElementText::SHADOW_FLAG)
-                textRenderer->enableShadow(Color4B(shadowColor), shadowOffset, shadowBlurRadius);
-            if (flags & RichElementText::GLOW_FLAG)
-                textRenderer->enableGlow(Color4B(glowColor));
+            Label* textRenderer =
+                obtainTextRenderer(currentText, fontName, fontSize, flags, url, outlineColor, outlineSize, shadowColor,
+                                   shadowOffset, shadowBlurRadius, glowColor);
 
             textRenderer->setTextColor(Color4B(color));
             textRenderer->setOpacity(opacity);
@@ -2165,14 +2225,18 @@ void RichText::handleTextRenderer(std::string_view text,
                 break;
             }
 
-            // rough estimate
-            // when textRendererWidth == 0.0f, use fontSize as the rough estimate of width for each char,
-            //  (_leftSpaceWidth / fontSize) means how many chars can be aligned in leftSpaceWidth.
-            int estimatedIdx = 0;
-            if (textRendererWidth > 0.0f)
-                estimatedIdx = static_cast<int>(_leftSpaceWidth / textRendererWidth * utf8Text.length());
-            else
-                estimatedIdx = static_cast<int>(_leftSpaceWidth / fontSize);
+            // estimate from the glyph advances, so that the split search measures the label a few times only
+            int estimatedIdx = estimateFittingLength(textRenderer, utf8Text, textRendererWidth, _leftSpaceWidth);
+            if (estimatedIdx < 0)
+            {
+                // rough estimate
+                // when textRendererWidth == 0.0f, use fontSize as the rough estimate of width for each char,
+                //  (_leftSpaceWidth / fontSize) means how many chars can be aligned in leftSpaceWidth.
+                if (textRendererWidth > 0.0f)
+                    estimatedIdx = static_cast<int>(_leftSpaceWidth / textRendererWidth * utf8Text.length());
+                else
+                    estimatedIdx = static_cast<int>(_leftSpaceWidth / fontSize);
+            }
 
             int leftLength = 0;
             if (wrapMode == WRAP_PER_WORD)
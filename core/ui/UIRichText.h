@@ -29,6 +29,8 @@
 #include "ui/GUIExport.h"
 #include "base/Value.h"
 
+#include <unordered_map>
+
 namespace ax
 {
 /**
@@ -645,6 +647,18 @@ protected:
                              float scaleY        = 1.f,
                              std::string_view id = ""sv);
     void handleCustomRenderer(Node* renderer, std::string_view id = ""sv);
+    /** Returns a label of a text style, one of the previous format when there is one. */
+    Label* obtainTextRenderer(std::string_view text,
+                              std::string_view fontName,
+                              float fontSize,
+                              uint32_t flags,
+                              std::string_view url,
+                              const Color3B& outlineColor,
+                              int outlineSize,
+                              const Color3B& shadowColor,
+                              const Vec2& shadowOffset,
+                              int shadowBlurRadius,
+                              const Color3B& glowColor);
     void formatRenderers();
     void addNewLine(int quantity = 1);
     void doHorizontalAlignment(const Vector<Node*>& row, float rowWidth);
@@ -656,6 +670,10 @@ protected:
     std::vector<float> _lineHeights;
     float _leftSpaceWidth;
 
+    // the labels of the texts by style, the ones of the previous format are reused by the next one
+    std::unordered_map<std::string, Vector<Label*>> _textRenderers;
+    std::unordered_map<std::string, Vector<Label*>> _freeTextRenderers;
+
     ValueMap _defaults;            /*!< default values */
     OpenUrlHandler _handleOpenUrl; /*!< the callback for open URL */
 
@@ -85,6 +85,8 @@ Slider::Slider()
     , _slidBallPressedTextureFile("")
     , _slidBallDisabledTextureFile("")
 {
+    // the ball is hit outside the bar
+    _touchBoundsCulling = false;
     setTouchEnabled(true);
 }
 
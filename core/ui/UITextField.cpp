@@ -275,7 +275,10 @@ TextField::TextField()
     , _fontName("Thonburi")
     , _fontSize(10)
     , _fontType(FontType::SYSTEM)
-{}
+{
+    // hit in its touch area, and detaches the IME when a touch misses it
+    _touchBoundsCulling = false;
+}
 
 TextField::~TextField()
 {
@@ -159,6 +159,7 @@ Widget::Widget()
     , _affectByClipping(false)
     , _ignoreSize(false)
     , _propagateTouchEvents(true)
+    , _touchBoundsCulling(true)
     , _brightStyle(BrightStyle::NONE)
     , _sizeType(SizeType::ABSOLUTE)
     , _positionType(PositionType::ABSOLUTE)
@@ -552,6 +553,10 @@ void Widget::onSizeChanged()
             }
         }
     }
+    if (Layout* layoutParent = dynamic_cast<Layout*>(_parent))
+    {
+        layoutParent->onChildSizeChanged(this);
+    }
 }
 
 Vec2 Widget::getVirtualRendererSize() const
@@ -588,6 +593,7 @@ void Widget::setTouchEnabled(bool enable)
         _touchListener = EventListenerTouchOneByOne::create();
         AX_SAFE_RETAIN(_touchListener);
         _touchListener->setSwallowTouches(true);
+        _touchListener->setBoundsCulling(_touchBoundsCulling);
         _touchListener->onTouchBegan     = AX_CALLBACK_2(Widget::onTouchBegan, this);
         _touchListener->onTouchMoved     = AX_CALLBACK_2(Widget::onTouchMoved, this);
         _touchListener->onTouchEnded     = AX_CALLBACK_2(Widget::onTouchEnded, this);
@@ -452,6 +452,8 @@ public:
      * @param camera    The camera look at widget, used to convert GL screen point to near/far plane.
      * @param p         Point to a Vec3 for store the intersect point, if don't need them set to nullptr.
      * @return true if the point is in widget's content space, false otherwise.
+     * @note The touch listener skips the touches beginning outside the content rect, a subclass hit outside it or
+     * handling the touches it misses turns _touchBoundsCulling off in its constructor.
      */
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const;
 
@@ -795,6 +797,8 @@ protected:
     bool _affectByClipping;
     bool _ignoreSize;
     bool _propagateTouchEvents;
+    // whether the touch listener skips the touches outside the content rect, see EventListenerTouchOneByOne
+    bool _touchBoundsCulling;
 
     BrightStyle _brightStyle;
     SizeType _sizeType;
@@ -3,6 +3,18 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+static CCArmatureDisplay::UpdatePolicy s_defaultUpdatePolicy;
+
+void CCArmatureDisplay::setDefaultUpdatePolicy(const UpdatePolicy& policy)
+{
+    s_defaultUpdatePolicy = policy;
+}
+
+const CCArmatureDisplay::UpdatePolicy& CCArmatureDisplay::getDefaultUpdatePolicy()
+{
+    return s_defaultUpdatePolicy;
+}
+
 CCArmatureDisplay* CCArmatureDisplay::create()
 {
     CCArmatureDisplay* displayContainer = new CCArmatureDisplay();
@@ -56,6 +68,141 @@ void CCArmatureDisplay::dbUpdate()
     }
 }
 
+bool CCArmatureDisplay::dbAdvanceTime(float& passedTime)
+{
+    const auto& policy = getUpdatePolicy();
+    const auto frame   = ax::Director::getInstance()->getTotalFrames();
+
+    // not drawn in the last frame, it is culled or hidden
+    const bool culled = _drawnFrame != NOT_DRAWN && _drawnFrame + 1 < frame;
+
+    auto skip = policy.skipWhenCulled && culled;
+    if (!skip && !culled && policy.smallUpdateInterval > 1 && _drawnSize < policy.smallSize)
+    {
+        skip = ++_throttledFrames < policy.smallUpdateInterval;
+    }
+
+    if (skip)
+    {
+        _skippedTime += passedTime;
+        return false;
+    }
+
+    passedTime += _skippedTime;
+    _skippedTime     = 0.0f;
+    _throttledFrames = 0;
+    return true;
+}
+
+void CCArmatureDisplay::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags)
+{
+    const auto frame = ax::Director::getInstance()->getTotalFrames();
+    if (_batchFrame != frame)
+    {
+        _batchFrame = frame;
+        _batchCount = 0;
+    }
+
+    // the slots are added to the batches while they are visited, their commands once all of them are
+    _visitBatchBegin = _batchCount;
+    _batching        = _batchEnabled && _canBatch();
+
+    ax::Node::visit(renderer, parentTransform, parentFlags);
+
+    _batching = false;
+    for (auto i = _visitBatchBegin; i < _batchCount; ++i)
+    {
+        auto& batch = _batches[i];
+        ax::TrianglesCommand::Triangles triangles(batch.vertices.data(), batch.indices.data(),
+                                                  (unsigned int)batch.vertices.size(),
+                                                  (unsigned int)batch.indices.size());
+        batch.command.init(batch.globalZOrder, batch.texture, batch.blendFunc, triangles, _modelViewTransform,
+                           parentFlags);
+        renderer->addCommand(&batch.command);
+    }
+
+    // the size of the armature bounds on the screen, for the update policy
+    if (_armature != nullptr && _drawnFrame == ax::Director::getInstance()->getTotalFrames())
+    {
+        const auto& aabb = _armature->getArmatureData()->aabb;
+        const auto& m    = _modelViewTransform.m;
+        _drawnSize = std::max(aabb.width * ax::Vec2(m[0], m[1]).length(), aabb.height * ax::Vec2(m[4], m[5]).length());
+    }
+}
+
+bool CCArmatureDisplay::dbBatchTriangles(ax::Texture2D* texture,
+                                         const ax::BlendFunc& blendFunc,
+                                         const ax::PipelineDescriptor& pipelineDescriptor,
+                                         const ax::TrianglesCommand::Triangles& triangles,
+                                         const ax::Mat4& transform,
+                                         float globalZOrder)
+{
+    if (!_batching)
+    {
+        return false;
+    }
+
+    const auto programBatchId = pipelineDescriptor.programState->getBatchId();
+
+    // the indices are 16 bits, a batch is split above 65536 vertices
+    auto batch = _batchCount > _visitBatchBegin ? &_batches[_batchCount - 1] : nullptr;
+    if (batch == nullptr || batch->texture != texture || batch->blendFunc != blendFunc ||
+        batch->programBatchId != programBatchId || batch->globalZOrder != globalZOrder ||
+        batch->vertices.size() + triangles.vertCount > ax::Renderer::VBO_SIZE)
+    {
+        if (_batchCount == _batches.size())
+        {
+            _batches.emplace_back();
+        }
+
+        batch = &_batches[_batchCount++];
+        batch->vertices.clear();
+        batch->indices.clear();
+        batch->texture                         = texture;
+        batch->blendFunc                       = blendFunc;
+        batch->programBatchId                  = programBatchId;
+        batch->globalZOrder                    = globalZOrder;
+        batch->command.getPipelineDescriptor() = pipelineDescriptor;
+    }
+
+    const auto vertexOffset = batch->vertices.size();
+    const auto indexOffset  = batch->indices.size();
+    batch->vertices.resize(vertexOffset + triangles.vertCount);
+    batch->indices.resize(indexOffset + triangles.indexCount);
+    ax::MathUtil::transformVertices(batch->vertices.data() + vertexOffset, triangles.verts, triangles.vertCount,
+                                    transform);
+    for (unsigned int i = 0; i < triangles.indexCount; ++i)
+    {
+        batch->indices[indexOffset + i] = (unsigned short)(triangles.indices[i] + vertexOffset);
+    }
+
+    return true;
+}
+
+bool CCArmatureDisplay::_canBatch() const
+{
+    for (const auto child : _children)
+    {
+        if (dynamic_cast<DBCCSprite*>(child) == nullptr)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CCArmatureDisplay::setUpdatePolicy(const UpdatePolicy& policy)
+{
+    _updatePolicy    = policy;
+    _hasUpdatePolicy = true;
+}
+
+void CCArmatureDisplay::resetUpdatePolicy()
+{
+    _hasUpdatePolicy = false;
+}
+
 void CCArmatureDisplay::addDBEventListener(std::string_view type, const std::function<void(EventObject*)>& callback)
 {
     auto lambda = [callback](ax::EventCustom* event) -> void {
@@ -192,13 +339,25 @@ void DBCCSprite::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_
     if (_insideBounds)
 #endif
     {
+        // the armature is seen, for its update policy
+        const auto armatureDisplay = static_cast<CCArmatureDisplay*>(_parent);
+        if (armatureDisplay != nullptr)
+        {
+            armatureDisplay->dbMarkDrawn();
+        }
+
+        if (armatureDisplay == nullptr || _texture == nullptr ||
+            !armatureDisplay->dbBatchTriangles(_texture, _blendFunc, _trianglesCommand.getPipelineDescriptor(),
+                                               _polyInfo.triangles, getNodeToParentTransform(), _globalZOrder))
+        {
 #if COCOS2D_VERSION >= 0x00040000
-        _trianglesCommand.init(_globalZOrder, _texture, _blendFunc, _polyInfo.triangles, transform, flags);
+            _trianglesCommand.init(_globalZOrder, _texture, _blendFunc, _polyInfo.triangles, transform, flags);
 #else
-        _trianglesCommand.init(_globalZOrder, _texture->getName(), getGLProgramState(), _blendFunc, _polyInfo.triangles,
-                               transform, flags);
+            _trianglesCommand.init(_globalZOrder, _texture->getName(), getGLProgramState(), _blendFunc,
+                                   _polyInfo.triangles, transform, flags);
 #endif
-        renderer->addCommand(&_trianglesCommand);
+            renderer->addCommand(&_trianglesCommand);
+        }
 
 #if AX_SPRITE_DEBUG_DRAW
         _debugDrawNode->clear();
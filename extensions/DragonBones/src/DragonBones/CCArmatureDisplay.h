@@ -23,6 +23,7 @@
 #ifndef DRAGONBONES_AX_ARMATURE_DISPLAY_CONTAINER_H
 #define DRAGONBONES_AX_ARMATURE_DISPLAY_CONTAINER_H
 
+#include <deque>
 #include "DragonBones/DragonBonesHeaders.h"
 #include "cocos2d.h"
 
@@ -40,14 +41,70 @@ public:
      */
     static CCArmatureDisplay* create();
 
+public:
+    /**
+     * - How the armature advances when it isn't seen or is small on the screen.
+     */
+    struct UpdatePolicy
+    {
+        /**
+         * - Doesn't advance the armature while none of its slots is drawn, the skipped time is caught up once one is.
+         * The animation events of the skipped time are dispatched then.
+         */
+        bool skipWhenCulled = false;
+        /**
+         * - Below this size of the armature bounds on the screen, in points, the armature advances once every
+         * smallUpdateInterval frames, by the time of all of them.
+         */
+        float smallSize         = 0.0f;
+        int smallUpdateInterval = 1;
+    };
+
+    /**
+     * - The policy used by the armatures without their own one.
+     */
+    static void setDefaultUpdatePolicy(const UpdatePolicy& policy);
+    static const UpdatePolicy& getDefaultUpdatePolicy();
+
 public:
     bool debugDraw;
 
 protected:
+    static constexpr unsigned int NOT_DRAWN = UINT_MAX;
+
+    /**
+     * - The slots drawn with the same texture, blend function, program and global z order, in the armature space.
+     */
+    struct Batch
+    {
+        ax::TrianglesCommand command;
+        std::vector<ax::V3F_C4B_T2F> vertices;
+        std::vector<unsigned short> indices;
+        ax::Texture2D* texture = nullptr;
+        ax::BlendFunc blendFunc;
+        uint64_t programBatchId = 0;
+        float globalZOrder      = 0.0f;
+    };
+
     bool _debugDraw;
     Armature* _armature;
     ax::EventDispatcher* _dispatcher;
 
+    UpdatePolicy _updatePolicy;
+    bool _hasUpdatePolicy;
+    unsigned int _drawnFrame;
+    int _throttledFrames;
+    float _drawnSize;
+    float _skippedTime;
+
+    bool _batchEnabled;
+    bool _batching;
+    // the commands added to the renderer stay valid until the next frame
+    std::deque<Batch> _batches;
+    size_t _batchCount;
+    size_t _visitBatchBegin;
+    unsigned int _batchFrame;
+
 public:
     CCArmatureDisplay()
         : debugDraw(false)
@@ -56,6 +113,16 @@ public:
         _debugDraw(false)
         , _armature(nullptr)
         , _dispatcher(nullptr)
+        , _hasUpdatePolicy(false)
+        , _drawnFrame(NOT_DRAWN)
+        , _throttledFrames(0)
+        , _drawnSize(0.0f)
+        , _skippedTime(0.0f)
+        , _batchEnabled(true)
+        , _batching(false)
+        , _batchCount(0)
+        , _visitBatchBegin(0)
+        , _batchFrame(NOT_DRAWN)
     {
         _dispatcher = new ax::EventDispatcher();
         setEventDispatcher(_dispatcher);
@@ -76,6 +143,26 @@ public:
      * @inheritDoc
      */
     virtual void dbUpdate() override;
+    /**
+     * @inheritDoc
+     */
+    virtual bool dbAdvanceTime(float& passedTime) override;
+    /**
+     * - Called by the slot displays drawn in this frame.
+     * @internal
+     */
+    void dbMarkDrawn() { _drawnFrame = ax::Director::getInstance()->getTotalFrames(); }
+    /**
+     * - Called by the slot displays drawn in this frame, adds their triangles to the batch of the armature.
+     * Returns false if the armature doesn't batch them, the slot display draws them itself then.
+     * @internal
+     */
+    bool dbBatchTriangles(ax::Texture2D* texture,
+                          const ax::BlendFunc& blendFunc,
+                          const ax::PipelineDescriptor& pipelineDescriptor,
+                          const ax::TrianglesCommand::Triangles& triangles,
+                          const ax::Mat4& transform,
+                          float globalZOrder);
     /**
      * @inheritDoc
      */
@@ -109,6 +196,32 @@ public:
      * @inheritDoc
      */
     virtual ax::Rect getBoundingBox() const override;
+
+    virtual void visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags) override;
+
+    /**
+     * - Sets the update policy of this armature, instead of the default one.
+     */
+    void setUpdatePolicy(const UpdatePolicy& policy);
+    /**
+     * - Uses the default update policy again.
+     */
+    void resetUpdatePolicy();
+    const UpdatePolicy& getUpdatePolicy() const
+    {
+        return _hasUpdatePolicy ? _updatePolicy : getDefaultUpdatePolicy();
+    }
+
+    /**
+     * - Draws the slots with one command per run of slots sharing their texture, blend function, program and global
+     * z order, instead of one command per slot. Only used while all the children of the armature are slot displays,
+     * not with a child armature or another node added to it. Enabled by default.
+     */
+    void setBatchEnabled(bool enabled) { _batchEnabled = enabled; }
+    bool isBatchEnabled() const { return _batchEnabled; }
+
+protected:
+    bool _canBatch() const;
 };
 /**
  * @internal
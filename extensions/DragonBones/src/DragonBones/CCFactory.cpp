@@ -5,8 +5,33 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+namespace
+{
+/**
+ * Reads a binary file into a buffer a DragonBonesData can own, it frees its binary with delete[].
+ */
+class BinaryBuffer : public ax::ResizableBuffer
+{
+public:
+    virtual void resize(size_t size) override
+    {
+        _data.reset(new char[size]);
+        _size = size;
+    }
+    virtual void* buffer() const override { return _data.get(); }
+    virtual size_t size() const override { return _size; }
+
+    char* release() { return _data.release(); }
+
+private:
+    std::unique_ptr<char[]> _data;
+    size_t _size = 0;
+};
+}  // namespace
+
 DragonBones* CCFactory::_dragonBonesInstance = nullptr;
 CCFactory* CCFactory::_factory               = nullptr;
+hlookup::string_map<CCFactory::SharedData> CCFactory::_sharedDataCache;
 
 TextureAtlasData* CCFactory::_buildTextureAtlasData(TextureAtlasData* textureAtlasData, void* textureAtlas) const
 {
@@ -139,6 +164,25 @@ Slot* CCFactory::_buildSlot(const BuildArmaturePackage& dataPackage, const SlotD
     return slot;
 }
 
+bool CCFactory::_releaseSharedData(DragonBonesData* data)
+{
+    for (auto iter = _sharedDataCache.begin(); iter != _sharedDataCache.end(); ++iter)
+    {
+        if (iter->second.data == data)
+        {
+            if (--iter->second.refCount == 0)
+            {
+                data->returnToPool();
+                _sharedDataCache.erase(iter);
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
 DragonBonesData* CCFactory::loadDragonBonesData(std::string_view filePath, std::string_view name, float scale)
 {
     if (!name.empty())
@@ -150,34 +194,96 @@ DragonBonesData* CCFactory::loadDragonBonesData(std::string_view filePath, std::
         }
     }
 
-    const auto fullpath = ax::FileUtils::getInstance()->fullPathForFilename(filePath);
-    if (ax::FileUtils::getInstance()->isFileExist(filePath))
+    const auto fileUtils = ax::FileUtils::getInstance();
+    const auto fullpath  = fileUtils->fullPathForFilename(filePath);
+    if (fullpath.empty())
     {
-        const auto pos = fullpath.find(".json");
+        return nullptr;
+    }
 
-        if (pos != std::string::npos)
+    const auto shared = _sharedDataCache.find(fullpath);
+    if (shared != _sharedDataCache.end() && shared->second.scale == scale)
+    {
+        const auto data = shared->second.data;
+        if (getDragonBonesData(!name.empty() ? name : std::string_view{data->name}) != data)
         {
-            const auto data = ax::FileUtils::getInstance()->getStringFromFile(filePath);
+            ++shared->second.refCount;
+            addDragonBonesData(data, name);
+        }
 
-            return parseDragonBonesData(data.c_str(), name, scale);
+        return data;
+    }
+
+    DragonBonesData* data        = nullptr;
+    const auto textureAtlasCount = _textureAtlasDataMap.size();
+    if (fullpath.find(".json") != std::string::npos)
+    {
+        const auto json = fileUtils->getStringFromFile(fullpath);
+        if (json.empty())
+        {
+            return nullptr;
         }
-        else
+
+        data = parseDragonBonesData(json.c_str(), name, scale);
+    }
+    else
+    {
+        // the arrays of the data point into the binary, the file is read to a buffer the data takes
+        BinaryBuffer binary;
+        if (fileUtils->getContents(fullpath, &binary) != ax::FileUtils::Status::OK || binary.size() < 4)
         {
-#if COCOS2D_VERSION >= 0x00031200
-            ax::Data cocos2dData;
-            ax::FileUtils::getInstance()->getContents(fullpath, &cocos2dData);
-#else
-            const auto cocos2dData = ax::FileUtils::getInstance()->getDataFromFile(fullpath);
-#endif
-            const auto binary = (unsigned char*)malloc(sizeof(unsigned char) * cocos2dData.getSize());
-            memcpy(binary, cocos2dData.getBytes(), cocos2dData.getSize());
-            const auto data = parseDragonBonesData((char*)binary, name, scale);
+            return nullptr;
+        }
 
-            return data;
+        data = parseDragonBonesData(static_cast<const char*>(binary.buffer()), name, scale);
+        if (data != nullptr)
+        {
+            binary.release();
         }
     }
 
-    return nullptr;
+    // the texture atlas data embedded in the file are only added to this factory
+    if (data != nullptr && shared == _sharedDataCache.end() && _textureAtlasDataMap.size() == textureAtlasCount)
+    {
+        _sharedDataCache.emplace(fullpath, SharedData{data, scale, 1});
+    }
+
+    return data;
+}
+
+void CCFactory::removeDragonBonesData(std::string_view name, bool disposeData)
+{
+    if (disposeData)
+    {
+        const auto data = getDragonBonesData(name);
+        if (data != nullptr && _releaseSharedData(data))
+        {
+            BaseFactory::removeDragonBonesData(name, false);
+            return;
+        }
+    }
+
+    BaseFactory::removeDragonBonesData(name, disposeData);
+}
+
+void CCFactory::clear(bool disposeData)
+{
+    if (disposeData)
+    {
+        for (auto iter = _dragonBonesDataMap.begin(); iter != _dragonBonesDataMap.end();)
+        {
+            if (_releaseSharedData(iter->second))
+            {
+                iter = _dragonBonesDataMap.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    BaseFactory::clear(disposeData);
 }
 
 TextureAtlasData* CCFactory::loadTextureAtlasData(std::string_view filePath, std::string_view name, float scale)
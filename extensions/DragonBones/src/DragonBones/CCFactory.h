@@ -43,8 +43,19 @@ class CCFactory : public BaseFactory
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(CCFactory)
 
 private:
+    /**
+     * - A data loaded from a file, shared by the factories loading it.
+     */
+    struct SharedData
+    {
+        DragonBonesData* data;
+        float scale;
+        unsigned int refCount;
+    };
+
     static DragonBones* _dragonBonesInstance;
     static CCFactory* _factory;
+    static hlookup::string_map<SharedData> _sharedDataCache;
 
 public:
     /**
@@ -100,11 +111,35 @@ protected:
     virtual Slot* _buildSlot(const BuildArmaturePackage& dataPackage,
                              const SlotData* slotData,
                              Armature* armature) const override;
+    /**
+     * - Releases a data of the shared cache, returns false if the data isn't shared.
+     */
+    static bool _releaseSharedData(DragonBonesData* data);
 
 public:
+    /**
+     * - Load and parse a DragonBonesData from a JSON file or a DBBin binary file, and cache it to the factory.
+     * The binary is parsed in place, the data keeps the file buffer instead of copying its arrays.
+     * A file already loaded by a factory with the same scale isn't parsed again, its data is shared by the factories
+     * until the last of them removes it. The files with their texture atlas data embedded aren't shared.
+     * @param filePath - The file path of the DragonBones data.
+     * @param name - Specify a cache name for the instance so that the instance can be obtained through this name. (If
+     * not set, use the instance name instead)
+     * @param scale - Specify a scaling value for the armatures. (Not scaled by default)
+     * @returns The DragonBonesData instance.
+     * @language en_US
+     */
     virtual DragonBonesData* loadDragonBonesData(std::string_view filePath,
                                                  std::string_view name = "",
                                                  float scale           = 1.0f);
+    /**
+     * @inheritDoc
+     */
+    virtual void removeDragonBonesData(std::string_view name, bool disposeData = true) override;
+    /**
+     * @inheritDoc
+     */
+    virtual void clear(bool disposeData = true) override;
     /**
      * - Load and parse a texture atlas data and texture from the local and cache them to the factory.
      * @param  filePath - The file path of texture atlas data.
@@ -197,6 +197,11 @@ void Armature::advanceTime(float passedTime)
         return;
     }
 
+    if (!_proxy->dbAdvanceTime(passedTime))
+    {
+        return;
+    }
+
     const auto prevCacheFrameIndex = _cacheFrameIndex;
 
     // Update animation.
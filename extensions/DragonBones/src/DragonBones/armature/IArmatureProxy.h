@@ -56,6 +56,12 @@ public:
      * @internal
      */
     virtual void dbUpdate() = 0;
+    /**
+     * - Called before the armature advances, returns false to skip the advance. The proxy can change the passed
+     * time, to catch up the time of the advances it skipped.
+     * @internal
+     */
+    virtual bool dbAdvanceTime(float& passedTime) { return true; }
     /**
      * - Dispose the instance and the Armature instance. (The Armature instance will return to the object pool)
      * @example
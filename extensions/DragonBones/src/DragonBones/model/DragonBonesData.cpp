@@ -13,7 +13,7 @@ void DragonBonesData::_onClear()
 
     if (binary != nullptr)
     {
-        delete binary;
+        delete[] binary;
     }
 
     if (userData != nullptr)
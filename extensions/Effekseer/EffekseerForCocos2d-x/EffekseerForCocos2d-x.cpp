@@ -697,8 +697,9 @@ void EffectEmitter::update(float delta)
 
 void EffectEmitter::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags)
 {
-    if (!manager->getInternalManager()->GetShown(handle) ||
-        manager->getInternalManager()->GetTotalInstanceCount() < 1)
+    // while the async update runs, DrawHandle checks the handle once it is done
+    if (!manager->isUpdating() && (!manager->getInternalManager()->GetShown(handle) ||
+                                   manager->getInternalManager()->GetTotalInstanceCount() < 1))
         return; // nothing to draw
             
 #ifdef AX_USE_METAL
@@ -748,11 +749,13 @@ void EffectEmitter::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& paren
 
 ::Effekseer::Handle EffectManager::play(Effect* effect, float x, float y, float z)
 {
+	waitUpdate();
 	return manager2d->Play(effect->getInternalPtr(), x, y, z);
 }
 
 ::Effekseer::Handle EffectManager::play(Effect* effect, float x, float y, float z, int startTime)
 {
+	waitUpdate();
 	return manager2d->Play(effect->getInternalPtr(), Effekseer::Vector3D(x, y, z), startTime);
 }
 
@@ -768,14 +771,14 @@ void EffectManager::setMatrix(::Effekseer::Handle handle, const cocos2d::Mat4& m
 	memcpy(mat_.Value[2], p, size);
 	p += 4;
 	memcpy(mat_.Value[3], p, size);
-	manager2d->SetMatrix(handle, mat_);
+	getInternalManager()->SetMatrix(handle, mat_);
 }
 
-void EffectManager::setPotation(::Effekseer::Handle handle, float x, float y, float z) { manager2d->SetLocation(handle, x, y, z); }
+void EffectManager::setPotation(::Effekseer::Handle handle, float x, float y, float z) { getInternalManager()->SetLocation(handle, x, y, z); }
 
-void EffectManager::setRotation(::Effekseer::Handle handle, float x, float y, float z) { manager2d->SetRotation(handle, x, y, z); }
+void EffectManager::setRotation(::Effekseer::Handle handle, float x, float y, float z) { getInternalManager()->SetRotation(handle, x, y, z); }
 
-void EffectManager::setScale(::Effekseer::Handle handle, float x, float y, float z) { manager2d->SetScale(handle, x, y, z); }
+void EffectManager::setScale(::Effekseer::Handle handle, float x, float y, float z) { getInternalManager()->SetScale(handle, x, y, z); }
 
 bool EffectManager::Initialize(cocos2d::Size visibleSize)
 {
@@ -830,6 +833,13 @@ EffectManager::EffectManager() {}
 
 EffectManager::~EffectManager()
 {
+	if (afterUpdateListener_ != nullptr)
+	{
+		cocos2d::Director::getInstance()->getEventDispatcher()->removeEventListener(afterUpdateListener_);
+		afterUpdateListener_ = nullptr;
+	}
+	waitUpdate();
+
 	if (distortingCallback != nullptr &&
         renderer2d->GetDistortingCallback() != distortingCallback)
 	{
@@ -926,7 +936,7 @@ void EffectManager::setCameraMatrix(const cocos2d::Mat4& mat)
 
 	Effekseer::Manager::LayerParameter layerParam;
 	layerParam.ViewerPosition = cameraPosition;
-	manager2d->SetLayerParameter(0, layerParam);
+	getInternalManager()->SetLayerParameter(0, layerParam);
 
 	getInternalRenderer()->SetCameraMatrix(mat_);
 }
@@ -940,11 +950,71 @@ void EffectManager::setProjectionMatrix(const cocos2d::Mat4& mat)
 
 void EffectManager::update(float delta)
 {
+	if (isAsyncUpdateEnabled_)
+	{
+		// updated by startAsyncUpdate once all the nodes are updated
+		++pendingUpdateCount_;
+		pendingUpdateTime_ += delta;
+		return;
+	}
+
 	manager2d->Update();
 	time_ += delta;
 	renderer2d->SetTime(time_);
 }
 
+void EffectManager::setIsAsyncUpdateEnabled(bool value)
+{
+	if (isAsyncUpdateEnabled_ == value)
+		return;
+
+	isAsyncUpdateEnabled_ = value;
+
+	auto eventDispatcher = cocos2d::Director::getInstance()->getEventDispatcher();
+	if (value)
+	{
+		afterUpdateListener_ = eventDispatcher->addCustomEventListener(
+			cocos2d::Director::EVENT_AFTER_UPDATE, [this](cocos2d::EventCustom*) { startAsyncUpdate(); });
+	}
+	else
+	{
+		eventDispatcher->removeEventListener(afterUpdateListener_);
+		afterUpdateListener_ = nullptr;
+
+		// the frames counted since the last update aren't lost
+		startAsyncUpdate();
+		waitUpdate();
+	}
+}
+
+void EffectManager::startAsyncUpdate()
+{
+	if (pendingUpdateCount_ == 0)
+		return;
+
+	waitUpdate();
+
+	time_ += pendingUpdateTime_;
+	renderer2d->SetTime(time_);
+
+	// Effekseer advances the frames in one update
+	float deltaFrame = static_cast<float>(pendingUpdateCount_);
+	pendingUpdateCount_ = 0;
+	pendingUpdateTime_ = 0.0f;
+
+	updateJob_ = cocos2d::Director::getInstance()->getJobSystem()->schedule(
+		[this, deltaFrame]() { manager2d->Update(deltaFrame); }, cocos2d::JobPriority::High);
+}
+
+void EffectManager::waitUpdate()
+{
+	if (updateJob_.valid())
+	{
+		cocos2d::Director::getInstance()->getJobSystem()->wait(updateJob_);
+		updateJob_ = {};
+	}
+}
+
 NetworkServer* NetworkServer::create() { return new NetworkServer(); }
 
 NetworkServer::NetworkServer() { internalManager_ = getGlobalInternalManager(); }
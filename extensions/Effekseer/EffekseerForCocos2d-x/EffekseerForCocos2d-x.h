@@ -2,6 +2,7 @@
 #pragma once
 
 #include "cocos2d.h"
+#include "base/JobSystem.h"
 #include <Effekseer.h>
 #include <EffekseerRendererCommon/EffekseerRenderer.Renderer.h>
 
@@ -324,6 +325,12 @@ private:
 	float time_ = 0.0f;
 	InternalManager* internalManager_ = nullptr;
 
+	bool isAsyncUpdateEnabled_ = false;
+	int32_t pendingUpdateCount_ = 0;
+	float pendingUpdateTime_ = 0.0f;
+	cocos2d::JobHandle updateJob_;
+	cocos2d::EventListenerCustom* afterUpdateListener_ = nullptr;
+
 	cocos2d::CustomCommand distortionCommand;
 	cocos2d::CustomCommand beginCommand;
 	cocos2d::CustomCommand endCommand;
@@ -345,6 +352,9 @@ private:
     void CreateRenderer(int32_t spriteSize);
 	void onDestructor();
 
+	void startAsyncUpdate();
+	bool isUpdating() const { return updateJob_.valid() && !updateJob_.isDone(); }
+
 public:
 	/**
 		@brief
@@ -409,6 +419,22 @@ public:
 	*/
 	void update(float delta = 1.0f / 60.0f);
 
+	/**
+		@brief
+		\~English	Set whether the manager is updated on a JobSystem worker, while the scene is visited.
+		update() then only counts the frames, the update starts once all the nodes are updated
+		and the Effekseer::Manager is waited for by getInternalManager and the draws.
+	*/
+	void setIsAsyncUpdateEnabled(bool value);
+
+	bool getIsAsyncUpdateEnabled() const { return isAsyncUpdateEnabled_; }
+
+	/**
+		@brief
+		\~English	Wait for the async update, if any is running.
+	*/
+	void waitUpdate();
+
 	/**
 		@brief
 		\~English	Get the pointer of Effekseer::Manager
@@ -417,7 +443,11 @@ public:
 		\~English　	The pointer of Effekseer::Manager
 		\~Japanese	Effekseer::Managerのポインタ
 	*/
-	::Effekseer::ManagerRef getInternalManager() { return manager2d; }
+	::Effekseer::ManagerRef getInternalManager()
+	{
+		waitUpdate();
+		return manager2d;
+	}
 
 	/**
 		@brief
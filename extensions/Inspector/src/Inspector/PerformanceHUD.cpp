@@ -0,0 +1,322 @@
+#include "PerformanceHUD.h"
+#include "Inspector.h"
+#include "ImGuiPresenter.h"
+#include "axmol.h"
+#include "base/ObjectArena.h"
+
+#include "fmt/format.h"
+#include <algorithm>
+#include <unordered_map>
+
+NS_AX_EXT_BEGIN
+
+namespace
+{
+PerformanceHUD* g_instance = nullptr;
+
+const char* const PHASE_NAMES[] = {"Update", "Visit", "Sort", "Render", "Present", "GPU"};
+const char* const BATCH_BREAK_NAMES[] = {"Texture",       "Program",     "Blend func",
+                                         "Skip batching", "Buffer full", "Other command"};
+
+void collectNodes(Node* node, std::unordered_map<const Node*, Node*>& nodes)
+{
+    nodes.emplace(node, node);
+    for (auto* child : node->getChildren())
+        collectNodes(child, nodes);
+}
+}  // namespace
+
+PerformanceHUD* PerformanceHUD::getInstance()
+{
+    if (g_instance == nullptr)
+    {
+        g_instance = new PerformanceHUD();
+        g_instance->init();
+    }
+    return g_instance;
+}
+
+void PerformanceHUD::destroyInstance()
+{
+    if (g_instance)
+    {
+        g_instance->close();
+        g_instance->cleanup();
+        delete g_instance;
+        g_instance = nullptr;
+    }
+}
+
+void PerformanceHUD::init()
+{
+    auto* eventDispatcher = Director::getInstance()->getEventDispatcher();
+    _beforeUpdateListener =
+        eventDispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) {
+        if (_opened)
+            _updateStart = std::chrono::steady_clock::now();
+    });
+    _afterUpdateListener = eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [this](EventCustom*) {
+        if (_opened)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - _updateStart;
+            _updateTime  = std::chrono::duration<float, std::milli>(elapsed).count();
+        }
+    });
+}
+
+void PerformanceHUD::cleanup()
+{
+    auto* eventDispatcher = Director::getInstance()->getEventDispatcher();
+    eventDispatcher->removeEventListener(_beforeUpdateListener);
+    eventDispatcher->removeEventListener(_afterUpdateListener);
+
+    _beforeUpdateListener = nullptr;
+    _afterUpdateListener  = nullptr;
+}
+
+void PerformanceHUD::open(Scene* target)
+{
+    close();
+
+    auto* renderer = Director::getInstance()->getRenderer();
+    renderer->setProfilingEnabled(true);
+    renderer->setBatchDiagnosticsEnabled(true);
+    ObjectArena::getInstance()->setCreationStatsEnabled(true);
+
+    _history       = {};
+    _historyOffset = 0;
+    _updateTime    = 0;
+    _opened        = true;
+
+    ImGuiPresenter::getInstance()->addRenderLoop("#perf", AX_CALLBACK_0(PerformanceHUD::mainLoop, this), target);
+}
+
+void PerformanceHUD::close()
+{
+    if (!_opened)
+        return;
+
+    _opened = false;
+    ImGuiPresenter::getInstance()->removeRenderLoop("#perf");
+
+    auto* renderer = Director::getInstance()->getRenderer();
+    renderer->setProfilingEnabled(false);
+    renderer->setBatchDiagnosticsEnabled(false);
+    ObjectArena::getInstance()->setCreationStatsEnabled(false);
+}
+
+void PerformanceHUD::mainLoop()
+{
+    // the render loops run before the scene is visited, the renderer still holds the stats of the last frame
+    sampleFrame();
+
+    if (ImGui::Begin("Performance"))
+    {
+        if (ImGui::CollapsingHeader("Frame", ImGuiTreeNodeFlags_DefaultOpen))
+            drawPhases();
+        if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+            drawCounters();
+        if (ImGui::CollapsingHeader("Batch breaks"))
+            drawBatchBreaks();
+        if (ImGui::CollapsingHeader("Node memory"))
+            drawNodeMemory();
+    }
+    ImGui::End();
+}
+
+void PerformanceHUD::sampleFrame()
+{
+    const auto& profile = Director::getInstance()->getRenderer()->getFrameProfile();
+
+    const float samples[PHASE_COUNT] = {
+        _updateTime,
+        std::max((float)profile.visit - _updateTime, 0.0f),  // the profiled visit includes the update
+        (float)profile.sort,
+        (float)profile.encode,
+        (float)profile.submit,
+        (float)profile.gpu,
+    };
+    for (int phase = 0; phase < PHASE_COUNT; ++phase)
+        _history[phase][_historyOffset] = samples[phase];
+    _historyOffset = (_historyOffset + 1) % HISTORY_SIZE;
+}
+
+void PerformanceHUD::drawPhases()
+{
+    float total = 0;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        const auto& history = _history[phase];
+        float average       = 0;
+        float maximum       = 0;
+        for (auto value : history)
+        {
+            average += value;
+            maximum = std::max(maximum, value);
+        }
+        average /= HISTORY_SIZE;
+        if (phase != GPU)
+            total += average;
+
+        auto overlay = fmt::format("{}: {:.2f} ms (max {:.2f})", PHASE_NAMES[phase], average, maximum);
+        ImGui::PlotLines(PHASE_NAMES[phase], history.data(), HISTORY_SIZE, _historyOffset, overlay.c_str(), 0.0f,
+                         std::max(maximum, 1.0f), ImVec2(0, 40));
+    }
+
+    ImGui::Text("CPU frame: %.2f ms", total);
+    if (!Director::getInstance()->getRenderer()->isGPUTimerSupported())
+        ImGui::TextDisabled("GPU timers aren't supported by this backend");
+}
+
+void PerformanceHUD::drawCounters()
+{
+    auto* director = Director::getInstance();
+    auto* renderer = director->getRenderer();
+
+    ImGui::Text("Draw calls: %d", (int)renderer->getDrawnBatches());
+    ImGui::Text("Vertices: %d", (int)renderer->getDrawnVertices());
+    ImGui::Text("State calls elided: %d", (int)renderer->getElidedStateCalls());
+    const auto& stateChanges = renderer->getStateChanges();
+    ImGui::Text("State changes: %d programs, %d materials, %d vertex buffers", (int)stateChanges.programs,
+                (int)stateChanges.programStates, (int)stateChanges.vertexBuffers);
+#if _AX_DEBUG
+    const auto& overdraw = renderer->getOverdrawStats();
+    ImGui::Text("Opaque 3D draws: %d, %d out of depth order, %d depth pre-pass draws", (int)overdraw.opaqueDraws,
+                (int)overdraw.nearerDraws, (int)overdraw.prePassDraws);
+#endif
+    ImGui::Text("Renderer heap allocations: %d", (int)renderer->getFrameHeapAllocations());
+    ImGui::Text("Texture memory: %.2f MB", director->getTextureCache()->getMemoryUsage() / (1024.0 * 1024.0));
+
+    auto* jobSystem = director->getJobSystem();
+    ImGui::Text("Jobs pending: %d, workers: %d", (int)jobSystem->getPendingJobCount(),
+                (int)jobSystem->getWorkerCount());
+
+    const auto& creations = ObjectArena::getInstance()->getLastFrameCreations();
+    size_t autoreleased = 0, arena = 0;
+    for (auto& stats : creations)
+    {
+        autoreleased += stats.autoreleased;
+        arena += stats.arena;
+    }
+    if (ImGui::TreeNode("##creations", "Objects created: %d autoreleased, %d in the arena", (int)autoreleased,
+                        (int)arena))
+    {
+        // sorted by count
+        const auto count = std::min(creations.size(), size_t{10});
+        for (size_t i = 0; i < count; ++i)
+            ImGui::BulletText("%s: %d, %d", creations[i].typeName.c_str(), (int)creations[i].autoreleased,
+                              (int)creations[i].arena);
+        ImGui::TreePop();
+    }
+}
+
+void PerformanceHUD::drawBatchBreaks()
+{
+    auto* director     = Director::getInstance();
+    const auto& counts = director->getRenderer()->getBatchBreakCounts();
+    for (size_t reason = 0; reason < counts.size(); ++reason)
+        ImGui::Text("%s: %d", BATCH_BREAK_NAMES[reason], (int)counts[reason]);
+
+    const auto& breaks = director->getRenderer()->getBatchBreaks();
+    if (breaks.empty())
+        return;
+
+    // the recorded nodes are only compared with the live ones, they may be gone already
+    std::unordered_map<const Node*, Node*> nodes;
+    if (auto* scene = director->getRunningScene())
+        collectNodes(scene, nodes);
+
+    const auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("##breaks", 3, flags, ImVec2(0, 240)))
+        return;
+
+    auto findNode = [&nodes](const Node* recorded) -> Node* {
+        auto it = nodes.find(recorded);
+        return it != nodes.end() ? it->second : nullptr;
+    };
+    auto nodeText = [](Node* node, uint32_t materialID) {
+        if (node)
+            ImGui::Text("%s %s (%08x)", Inspector::getNodeTypeName(node).c_str(), node->getName().data(), materialID);
+        else
+            ImGui::TextDisabled("unknown (%08x)", materialID);
+    };
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Reason");
+    ImGui::TableSetupColumn("Batch ended by");
+    ImGui::TableSetupColumn("Next batch started by");
+    ImGui::TableHeadersRow();
+
+    ImGuiListClipper clipper;
+    clipper.Begin((int)breaks.size());
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+        {
+            const auto& info   = breaks[row];
+            Node* previousNode = findNode(info.previousNode);
+            Node* node         = findNode(info.node);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::PushID(row);
+            ImGui::Selectable(BATCH_BREAK_NAMES[(size_t)info.reason], false, ImGuiSelectableFlags_SpanAllColumns);
+            const bool hovered = ImGui::IsItemHovered();
+            ImGui::PopID();
+            ImGui::TableNextColumn();
+            nodeText(previousNode, info.previousMaterialID);
+            ImGui::TableNextColumn();
+            nodeText(node, info.materialID);
+
+            if (hovered)
+            {
+                if (previousNode)
+                    highlightNode(previousNode, IM_COL32(255, 200, 64, 255));
+                if (node)
+                    highlightNode(node, IM_COL32(255, 64, 64, 255));
+            }
+        }
+    }
+    ImGui::EndTable();
+}
+
+void PerformanceHUD::drawNodeMemory()
+{
+    auto* scene = Director::getInstance()->getRunningScene();
+    if (!scene)
+        return;
+
+    // walks the whole scene, only while the header is open
+    const auto footprint = scene->getMemoryFootprint();
+    auto kb              = [](size_t bytes) { return bytes / 1024.0; };
+    ImGui::Text("Nodes: %d, %.1f KB", (int)footprint.nodeCount, kb(footprint.getTotal()));
+    ImGui::BulletText("Node objects: %.1f KB", kb(footprint.nodeBytes));
+    ImGui::BulletText("Children arrays: %.1f KB", kb(footprint.childrenBytes));
+    ImGui::BulletText("Children indexers: %.1f KB", kb(footprint.indexerBytes));
+    ImGui::BulletText("Component containers: %.1f KB", kb(footprint.componentBytes));
+    ImGui::BulletText("Other: %.1f KB", kb(footprint.otherBytes));
+    ImGui::Text("Interned strings: %d, %.1f KB", (int)InternedString::getInternedCount(),
+                kb(InternedString::getMemoryUsage()));
+}
+
+void PerformanceHUD::highlightNode(Node* node, uint32_t color)
+{
+    auto* director = Director::getInstance();
+    auto box       = utils::getCascadeBoundingBox(node);
+
+    // world to the top left origin of ImGui, in display pixels
+    const auto& winSize = director->getWinSize();
+    const auto& display = ImGui::GetIO().DisplaySize;
+    if (winSize.width <= 0 || winSize.height <= 0)
+        return;
+    const float scaleX = display.x / winSize.width;
+    const float scaleY = display.y / winSize.height;
+
+    auto topLeft     = director->convertToUI(Vec2(box.getMinX(), box.getMaxY()));
+    auto bottomRight = director->convertToUI(Vec2(box.getMaxX(), box.getMinY()));
+    ImGui::GetForegroundDrawList()->AddRect(ImVec2(topLeft.x * scaleX, topLeft.y * scaleY),
+                                            ImVec2(bottomRight.x * scaleX, bottomRight.y * scaleY),
+                                            color, 0.0f, 0, 2.0f);
+}
+
+NS_AX_EXT_END
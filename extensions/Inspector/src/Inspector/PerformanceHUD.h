@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include "extensions/ExtensionMacros.h"
+#include "base/Config.h"
+#include "EventListenerCustom.h"
+#include "RefPtr.h"
+
+namespace ax
+{
+class Node;
+class Scene;
+}
+
+NS_AX_EXT_BEGIN
+
+/**
+ * An ImGui window with the frame times by phase, the counters of the engine systems and the batch breaks of the
+ * last frame. Opening it enables the profiling of the renderer, its batch diagnostics and the creation stats of the
+ * ObjectArena, closing it disables them again.
+ */
+class PerformanceHUD
+{
+  public:
+    static constexpr int HISTORY_SIZE = 120;
+
+    static PerformanceHUD* getInstance();
+    static void destroyInstance();
+
+    /** Shows the HUD over all the scenes, or only over a scene. */
+    void open(Scene* target = nullptr);
+    void close();
+    bool isOpen() const { return _opened; }
+
+  private:
+    enum Phase
+    {
+        UPDATE,
+        VISIT,
+        SORT,
+        RENDER,
+        PRESENT,
+        GPU,
+        PHASE_COUNT
+    };
+
+    void init();
+    void cleanup();
+    void mainLoop();
+    void sampleFrame();
+    void drawPhases();
+    void drawCounters();
+    void drawBatchBreaks();
+    void drawNodeMemory();
+    void highlightNode(Node* node, uint32_t color);
+
+    std::array<std::array<float, HISTORY_SIZE>, PHASE_COUNT> _history{};
+    int _historyOffset = 0;
+
+    std::chrono::steady_clock::time_point _updateStart;
+    float _updateTime = 0;
+
+    RefPtr<EventListenerCustom> _beforeUpdateListener;
+    RefPtr<EventListenerCustom> _afterUpdateListener;
+
+    bool _opened = false;
+};
+
+NS_AX_EXT_END
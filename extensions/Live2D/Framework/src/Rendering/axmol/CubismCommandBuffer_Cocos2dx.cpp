@@ -108,6 +108,7 @@ CubismCommandBuffer_Cocos2dx::DrawCommandBuffer::DrawCommand* CubismCommandBuffe
 CubismCommandBuffer_Cocos2dx::CubismCommandBuffer_Cocos2dx()
     :_currentColorBuffer(NULL)
 {
+    ResetQueuedStates();
 }
 
 CubismCommandBuffer_Cocos2dx::~CubismCommandBuffer_Cocos2dx()
@@ -120,17 +121,27 @@ void CubismCommandBuffer_Cocos2dx::PushCommandGroup()
     groupCommand->init(0.0);
     GetCocos2dRenderer()->addCommand(groupCommand);
     GetCocos2dRenderer()->pushGroup(groupCommand->getRenderQueueID());
+    ResetQueuedStates();
 }
 
 void CubismCommandBuffer_Cocos2dx::PopCommandGroup()
 {
     GetCocos2dRenderer()->popGroup();
+    ResetQueuedStates();
 }
 
 void CubismCommandBuffer_Cocos2dx::SetOperationEnable(OperationType operationType, csmBool enabled)
 {
     _operationStateArray[operationType].Enabled = enabled;
 
+    // every drawable sets the culling and the winding, only the changes are queued
+    const csmInt32 cullType = _operationStateArray[OperationType_Culling].Arg0.i32;
+    const csmInt32 state = (operationType == OperationType_Culling && enabled) ? 1 + cullType : (enabled ? 1 : 0);
+    if (_queuedStateArray[operationType] == state)
+    {
+        return;
+    }
+    _queuedStateArray[operationType] = state;
 
     AddCommand
     (
@@ -154,7 +165,7 @@ void CubismCommandBuffer_Cocos2dx::SetOperationEnable(OperationType operationTyp
             }
             else
             {
-                switch (_operationStateArray[operationType].Arg0.i32)
+                switch (cullType)
                 {
                 case CullType_Front:
                     GetCocos2dRenderer()->setCullMode(ax::CullMode::FRONT);
@@ -188,12 +199,17 @@ void CubismCommandBuffer_Cocos2dx::SetWindingMode(WindingType windingType)
 {
     _operationStateArray[OperationType_Winding].Arg0.i32 = windingType;
 
+    if (_queuedStateArray[OperationType_Winding] == windingType)
+    {
+        return;
+    }
+    _queuedStateArray[OperationType_Winding] = windingType;
 
     AddCommand
     (
         [=] () -> void
         {
-            switch (_operationStateArray[OperationType_Winding].Arg0.i32)
+            switch (windingType)
             {
             case WindingType_ClockWise:
                 GetCocos2dRenderer()->setWinding(ax::Winding::CLOCK_WISE);
@@ -254,6 +270,14 @@ void CubismCommandBuffer_Cocos2dx::AddDrawCommand(DrawCommandBuffer::DrawCommand
     GetCocos2dRenderer()->addCommand(drawCommand->GetCommand());
 }
 
+void CubismCommandBuffer_Cocos2dx::ResetQueuedStates()
+{
+    for (csmInt32 i = 0; i < OperationType_TypeMax; ++i)
+    {
+        _queuedStateArray[i] = -1;
+    }
+}
+
 void CubismCommandBuffer_Cocos2dx::AddCommand(const std::function<void()>& fn)
 {
     ax::CallbackCommand* command = GetCocos2dRenderer()->nextCallbackCommand();
@@ -155,11 +155,18 @@ public:
 
     void AddDrawCommand(DrawCommandBuffer::DrawCommand* drawCommand);
 
+    /**
+     * @brief   Forgets the states queued to the renderer, the next state changes are all queued again.
+     *          The other render commands may change the states, it is called at the start of a frame.
+     */
+    void ResetQueuedStates();
+
 private:
     void AddCommand(const std::function<void()>& fn);
 
     backend::TextureBackend* _currentColorBuffer;
     OperationStateData _operationStateArray[OperationType_TypeMax];
+    csmInt32 _queuedStateArray[OperationType_TypeMax]; ///< the last state queued to the renderer, -1 when unknown
 };
 
 }}}}
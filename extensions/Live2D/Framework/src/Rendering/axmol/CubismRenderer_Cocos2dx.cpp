@@ -1603,6 +1603,7 @@ CubismCommandBuffer_Cocos2dx* CubismRenderer_Cocos2dx::GetCommandBuffer()
 void CubismRenderer_Cocos2dx::StartFrame(CubismCommandBuffer_Cocos2dx* commandBuffer)
 {
     _commandBuffer = commandBuffer;
+    _commandBuffer->ResetQueuedStates();
 }
 
 void CubismRenderer_Cocos2dx::EndFrame(CubismCommandBuffer_Cocos2dx* commandBuffer)
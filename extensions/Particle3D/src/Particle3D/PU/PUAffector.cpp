@@ -201,4 +201,37 @@ void PUAffector::process(PUParticle3D* particle, float delta, bool firstParticle
     updatePUAffector(particle, delta);
 }
 
+void PUAffector::updatePUAffectors(PUParticle3D* const* particles, size_t count, float delta)
+{
+    for (size_t i = 0; i < count; ++i)
+        updatePUAffector(particles[i], delta);
+}
+
+void PUAffector::process(const std::vector<PUParticle3D*>& particles, float delta, bool firstParticle)
+{
+    if (particles.empty())
+        return;
+
+    if (firstParticle)
+    {
+        firstParticleUpdate(particles.front(), delta);
+    }
+
+    if (_excludedEmitters.empty())
+    {
+        updatePUAffectors(particles.data(), particles.size(), delta);
+        return;
+    }
+
+    _includedParticles.clear();
+    for (auto&& particle : particles)
+    {
+        if (particle->parentEmitter && std::find(_excludedEmitters.begin(), _excludedEmitters.end(),
+                                                 particle->parentEmitter->getName()) != _excludedEmitters.end())
+            continue;
+        _includedParticles.emplace_back(particle);
+    }
+    updatePUAffectors(_includedParticles.data(), _includedParticles.size(), delta);
+}
+
 }
@@ -69,6 +69,17 @@ public:
     virtual void initParticleForEmission(PUParticle3D* particle);
     void process(PUParticle3D* particle, float delta, bool firstParticle);
 
+    /** Updates all the particles of a pass at once, by default calls updatePUAffector for each of them.
+        Affectors override it to hoist their per-pass work out of the per particle loop.
+    */
+    virtual void updatePUAffectors(PUParticle3D* const* particles, size_t count, float delta);
+    void process(const std::vector<PUParticle3D*>& particles, float delta, bool firstParticle);
+
+    /** Whether the update of a particle reads other particles, which have to be moved before it then. The
+        particle system runs the affectors particle by particle instead of by pass while such one is enabled.
+    */
+    virtual bool isOrderDependent() const { return false; }
+
     void setLocalPosition(const Vec3& pos) { _position = pos; };
     const Vec3 getLocalPosition() const { return _position; };
     void setMass(float mass);
@@ -142,6 +153,8 @@ protected:
     std::string _name;
 
     float _mass;
+
+    std::vector<PUParticle3D*> _includedParticles;  // scratch of process(), without the excluded emitters ones
 };
 
 }
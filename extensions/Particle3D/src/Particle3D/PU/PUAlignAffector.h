@@ -42,6 +42,7 @@ public:
 
     virtual void firstParticleUpdate(PUParticle3D* particle, float deltaTime) override;
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isOrderDependent() const override { return true; }  // reads the moved previous particle
 
     /** See setResize().
      */
@@ -81,6 +81,44 @@ PUColorAffector::ColorMapIterator PUColorAffector::findNearestColorMapIterator(f
     return --it;
 }
 
+void PUColorAffector::updatePUAffectors(PUParticle3D* const* particles, size_t count, float /*deltaTime*/)
+{
+    if (_colorMap.empty())
+        return;
+
+    _times.clear();
+    _colors.clear();
+    for (auto&& [time, color] : _colorMap)
+    {
+        _times.emplace_back(time);
+        _colors.emplace_back(color);
+    }
+    const size_t last = _times.size() - 1;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        PUParticle3D* particle = particles[i];
+        float timeFraction     = (particle->totalTimeToLive - particle->timeToLive) / particle->totalTimeToLive;
+
+        // the nearest key at or before the time fraction, like findNearestColorMapIterator
+        size_t index = std::upper_bound(_times.begin(), _times.end(), timeFraction) - _times.begin();
+        index        = index > 0 ? index - 1 : 0;
+
+        Vec4 color = _colors[index];
+        if (index < last)
+        {
+            color += (_colors[index + 1] - _colors[index]) *
+                     ((timeFraction - _times[index]) / (_times[index + 1] - _times[index]));
+        }
+
+        if (_colorOperation == CAO_SET)
+            particle->color = color;
+        else
+            particle->color = Vec4(color.x * particle->originalColor.x, color.y * particle->originalColor.y,
+                                   color.z * particle->originalColor.z, color.w * particle->originalColor.w);
+    }
+}
+
 void PUColorAffector::updatePUAffector(PUParticle3D* particle, float /*deltaTime*/)
 {
     // Fast rejection
@@ -30,6 +30,7 @@
 #include "Particle3D/PU/PUAffector.h"
 #include "base/Types.h"
 #include <map>
+#include <vector>
 
 namespace ax
 {
@@ -51,6 +52,7 @@ public:
     static PUColorAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual void updatePUAffectors(PUParticle3D* const* particles, size_t count, float deltaTime) override;
 
     /**
      */
@@ -84,6 +86,10 @@ protected:
 
 protected:
     ColorMap _colorMap;
+
+    // flat copy of the color map searched by updatePUAffectors
+    std::vector<float> _times;
+    std::vector<Vec4> _colors;
     ColorOperation _colorOperation;
 };
 }
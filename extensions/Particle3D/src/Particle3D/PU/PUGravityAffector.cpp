@@ -71,6 +71,24 @@ void PUGravityAffector::updatePUAffector(PUParticle3D* particle, float deltaTime
     }
 }
 
+void PUGravityAffector::updatePUAffectors(PUParticle3D* const* particles, size_t count, float deltaTime)
+{
+    const float scaleVelocity =
+        (static_cast<PUParticleSystem3D*>(_particleSystem))->getParticleSystemScaleVelocity();
+    const float gravity = scaleVelocity * _gravity * _mass * deltaTime;
+    for (size_t i = 0; i < count; ++i)
+    {
+        PUParticle3D* particle = particles[i];
+        Vec3 distance          = _derivedPosition - particle->position;
+        float length           = distance.lengthSquared();
+        if (length > 0)
+        {
+            float force = gravity * particle->mass / length;
+            particle->direction += force * distance * calculateAffectSpecialisationFactor(particle);
+        }
+    }
+}
+
 void PUGravityAffector::preUpdateAffector(float /*deltaTime*/)
 {
     getDerivedPosition();
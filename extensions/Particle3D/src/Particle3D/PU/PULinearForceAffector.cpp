@@ -55,6 +55,25 @@ void PULinearForceAffector::updatePUAffector(PUParticle3D* particle, float /*del
     }
 }
 
+void PULinearForceAffector::updatePUAffectors(PUParticle3D* const* particles, size_t count, float /*deltaTime*/)
+{
+    if (_forceApplication != FA_ADD)
+    {
+        for (size_t i = 0; i < count; ++i)
+            particles[i]->direction = (particles[i]->direction + _forceVector) / 2;
+    }
+    else if (_affectSpecialisation == AFSP_DEFAULT)
+    {
+        for (size_t i = 0; i < count; ++i)
+            particles[i]->direction += _scaledVector;
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+            particles[i]->direction += _scaledVector * calculateAffectSpecialisationFactor(particles[i]);
+    }
+}
+
 PULinearForceAffector* PULinearForceAffector::create()
 {
     auto plfa = new PULinearForceAffector();
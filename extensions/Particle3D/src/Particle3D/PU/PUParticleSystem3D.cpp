@@ -81,6 +81,7 @@ void PUParticle3D::initForEmission()
 {
     eventFlags   = 0;
     timeFraction = 0.0f;
+    affected     = false;
     /*	Note, that this flag must only be set as soon as the particle is emitted. As soon as the particle has
         been moved once, the flag must be removed again.
     */
@@ -152,6 +153,7 @@ PUParticle3D::PUParticle3D()
     , textureAnimationDirectionUp(true)
     , depthInView(0.0f)
     , zRotation(0.0f)
+    , affected(false)
 // widthInWorld(width),
 // heightInWorld(height),
 // depthInWorld(depth)
@@ -1319,7 +1321,52 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
                                          bool& firstParticle,
                                          float elapsedTime)
 {
-    Vec3 scale             = getDerivedScale();
+    Vec3 scale = getDerivedScale();
+
+    // Each affector updates all the alive particles in a pass, unless one needs the previous particles moved. The
+    // particles emitted by this loop into the pool aren't in the pass, they are processed one by one.
+    bool affectByPass = !_affectors.empty();
+    for (auto&& it : _affectors)
+    {
+        if (it->isEnabled() && static_cast<PUAffector*>(it)->isOrderDependent())
+        {
+            affectByPass = false;
+            break;
+        }
+    }
+
+    if (affectByPass)
+    {
+        _affectedParticles.clear();
+        for (auto particle = static_cast<PUParticle3D*>(pool.getFirst()); particle;
+             particle      = static_cast<PUParticle3D*>(pool.getNext()))
+        {
+            particle->affected = !isExpired(particle, elapsedTime);
+            if (particle->affected)
+            {
+                particle->process(elapsedTime);
+
+                for (auto&& it : _emitters)
+                {
+                    if (it->isEnabled() && !it->isMarkedForEmission())
+                    {
+                        (static_cast<PUEmitter*>(it))->updateEmitter(particle, elapsedTime);
+                    }
+                }
+
+                _affectedParticles.emplace_back(particle);
+            }
+        }
+
+        for (auto&& it : _affectors)
+        {
+            if (it->isEnabled())
+            {
+                (static_cast<PUAffector*>(it))->process(_affectedParticles, elapsedTime, firstActiveParticle);
+            }
+        }
+    }
+
     PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
     // Mat4 ltow = getNodeToWorldTransform();
     // Vec3 scl;
@@ -1327,27 +1374,32 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
     // ltow.decompose(&scl, &rot, nullptr);
     while (particle)
     {
+        const bool affected = affectByPass && particle->affected;
+        particle->affected  = false;
 
-        if (!isExpired(particle, elapsedTime))
+        if (affected || !isExpired(particle, elapsedTime))
         {
-            particle->process(elapsedTime);
+            if (!affected)
+            {
+                particle->process(elapsedTime);
 
-            // if (_emitter && _emitter->isEnabled())
-            //     _emitter->updateEmitter(particle, elapsedTime);
+                // if (_emitter && _emitter->isEnabled())
+                //     _emitter->updateEmitter(particle, elapsedTime);
 
-            for (auto&& it : _emitters)
-            {
-                if (it->isEnabled() && !it->isMarkedForEmission())
+                for (auto&& it : _emitters)
                 {
-                    (static_cast<PUEmitter*>(it))->updateEmitter(particle, elapsedTime);
+                    if (it->isEnabled() && !it->isMarkedForEmission())
+                    {
+                        (static_cast<PUEmitter*>(it))->updateEmitter(particle, elapsedTime);
+                    }
                 }
-            }
 
-            for (auto&& it : _affectors)
-            {
-                if (it->isEnabled())
+                for (auto&& it : _affectors)
                 {
-                    (static_cast<PUAffector*>(it))->process(particle, elapsedTime, firstActiveParticle);
+                    if (it->isEnabled())
+                    {
+                        (static_cast<PUAffector*>(it))->process(particle, elapsedTime, firstActiveParticle);
+                    }
                 }
             }
 
@@ -199,6 +199,9 @@ struct AX_EX_DLL PUParticle3D : public Particle3D
     bool textureAnimationDirectionUp;
 
     float depthInView;  // depth in camera view
+
+    // Set while the affectors already updated it in the pass of PUParticleSystem3D::processParticle
+    bool affected;
     float zRotation;    // zRotation is used to rotate the particle in 2D (around the Z-axis)   (radian)
     // float widthInWorld;
     // float heightInWorld;
@@ -389,6 +392,8 @@ protected:
     PUParticle3D::ParticleBehaviourList _behaviourTemplates;
     std::vector<PUListener*> _listeners;
 
+    std::vector<PUParticle3D*> _affectedParticles;  // the alive particles of the pool being processed
+
     bool _prepared;
     bool _poolPrepared;
 
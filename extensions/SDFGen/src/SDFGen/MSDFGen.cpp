@@ -0,0 +1,623 @@
+#include "MSDFGen.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include FT_OUTLINE_H
+
+NS_AX_EXT_BEGIN
+
+/*
+ * The multi-channel distance field construction of Viktor Chlumsky's msdfgen, reduced to what the font atlases need:
+ * the simple edge coloring and the per channel pseudo distance, without the error correction pass.
+ */
+namespace
+{
+constexpr double PI = 3.14159265358979323846;
+
+struct Point
+{
+    double x = 0, y = 0;
+
+    Point() = default;
+    Point(double x_, double y_) : x(x_), y(y_) {}
+
+    Point operator+(const Point& o) const { return {x + o.x, y + o.y}; }
+    Point operator-(const Point& o) const { return {x - o.x, y - o.y}; }
+    Point operator*(double s) const { return {x * s, y * s}; }
+    bool operator==(const Point& o) const { return x == o.x && y == o.y; }
+    bool operator!=(const Point& o) const { return !(*this == o); }
+
+    double length() const { return sqrt(x * x + y * y); }
+    Point normalize() const
+    {
+        double len = length();
+        return len == 0 ? Point{0, 1} : Point{x / len, y / len};
+    }
+};
+
+inline Point operator*(double s, const Point& p)
+{
+    return p * s;
+}
+inline double dot(const Point& a, const Point& b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+inline double cross(const Point& a, const Point& b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+inline Point mix(const Point& a, const Point& b, double t)
+{
+    return a + (b - a) * t;
+}
+inline double nonZeroSign(double v)
+{
+    return v > 0 ? 1.0 : -1.0;
+}
+
+enum EdgeColor : int
+{
+    BLACK   = 0,
+    RED     = 1,
+    GREEN   = 2,
+    YELLOW  = 3,
+    BLUE    = 4,
+    MAGENTA = 5,
+    CYAN    = 6,
+    WHITE   = 7,
+};
+
+struct SignedDistance
+{
+    double distance = -1e240;
+    double dot      = 1;
+
+    // closer, or as close and more orthogonal
+    bool operator<(const SignedDistance& o) const
+    {
+        return fabs(distance) < fabs(o.distance) || (fabs(distance) == fabs(o.distance) && dot < o.dot);
+    }
+};
+
+int solveQuadratic(double x[2], double a, double b, double c)
+{
+    if (a == 0 || fabs(b) > 1e12 * fabs(a))
+    {
+        if (b == 0)
+            return c == 0 ? -1 : 0;
+        x[0] = -c / b;
+        return 1;
+    }
+    double dscr = b * b - 4 * a * c;
+    if (dscr > 0)
+    {
+        dscr = sqrt(dscr);
+        x[0] = (-b + dscr) / (2 * a);
+        x[1] = (-b - dscr) / (2 * a);
+        return 2;
+    }
+    if (dscr == 0)
+    {
+        x[0] = -b / (2 * a);
+        return 1;
+    }
+    return 0;
+}
+
+int solveCubicNormed(double x[3], double a, double b, double c)
+{
+    double a2 = a * a;
+    double q  = 1 / 9. * (a2 - 3 * b);
+    double r  = 1 / 54. * (a * (2 * a2 - 9 * b) + 27 * c);
+    double r2 = r * r;
+    double q3 = q * q * q;
+    a *= 1 / 3.;
+    if (r2 < q3)
+    {
+        double t = std::clamp(r / sqrt(q3), -1.0, 1.0);
+        t        = acos(t);
+        q        = -2 * sqrt(q);
+        x[0]     = q * cos(1 / 3. * t) - a;
+        x[1]     = q * cos(1 / 3. * (t + 2 * PI)) - a;
+        x[2]     = q * cos(1 / 3. * (t - 2 * PI)) - a;
+        return 3;
+    }
+    double u = (r < 0 ? 1 : -1) * pow(fabs(r) + sqrt(r2 - q3), 1 / 3.);
+    double v = u == 0 ? 0 : q / u;
+    x[0]     = (u + v) - a;
+    if (u == v || fabs(u - v) < 1e-12 * fabs(u + v))
+    {
+        x[1] = -.5 * (u + v) - a;
+        return 2;
+    }
+    return 1;
+}
+
+int solveCubic(double x[3], double a, double b, double c, double d)
+{
+    if (a != 0)
+    {
+        double bn = b / a;
+        if (fabs(bn) < 1e6)
+            return solveCubicNormed(x, bn, c / a, d / a);
+    }
+    return solveQuadratic(x, b, c, d);
+}
+
+struct Edge
+{
+    int degree = 1;  // 1 linear, 2 quadratic, 3 cubic
+    Point p[4];
+    int color = WHITE;
+
+    Point point(double t) const
+    {
+        switch (degree)
+        {
+        case 1:
+            return mix(p[0], p[1], t);
+        case 2:
+            return mix(mix(p[0], p[1], t), mix(p[1], p[2], t), t);
+        default:
+        {
+            Point p12 = mix(p[1], p[2], t);
+            return mix(mix(mix(p[0], p[1], t), p12, t), mix(p12, mix(p[2], p[3], t), t), t);
+        }
+        }
+    }
+
+    Point direction(double t) const
+    {
+        switch (degree)
+        {
+        case 1:
+            return p[1] - p[0];
+        case 2:
+        {
+            Point tangent = mix(p[1] - p[0], p[2] - p[1], t);
+            return (tangent.x == 0 && tangent.y == 0) ? p[2] - p[0] : tangent;
+        }
+        default:
+        {
+            Point tangent = mix(mix(p[1] - p[0], p[2] - p[1], t), mix(p[2] - p[1], p[3] - p[2], t), t);
+            if (tangent.x == 0 && tangent.y == 0)
+            {
+                if (t == 0)
+                    return p[2] - p[0];
+                if (t == 1)
+                    return p[3] - p[1];
+            }
+            return tangent;
+        }
+        }
+    }
+
+    // de Casteljau, the edge keeps the part before t
+    Edge splitAt(double t)
+    {
+        Point points[4][4];
+        for (int i = 0; i <= degree; ++i)
+            points[0][i] = p[i];
+        for (int level = 1; level <= degree; ++level)
+            for (int i = 0; i <= degree - level; ++i)
+                points[level][i] = mix(points[level - 1][i], points[level - 1][i + 1], t);
+
+        Edge after;
+        after.degree = degree;
+        after.color  = color;
+        for (int i = 0; i <= degree; ++i)
+        {
+            p[i]       = points[i][0];
+            after.p[i] = points[degree - i][i];
+        }
+        return after;
+    }
+
+    SignedDistance signedDistance(const Point& origin, double& param) const
+    {
+        switch (degree)
+        {
+        case 1:
+        {
+            Point aq = origin - p[0];
+            Point ab = p[1] - p[0];
+            param    = dot(aq, ab) / dot(ab, ab);
+            Point eq = p[param > .5] - origin;
+
+            double endDistance = eq.length();
+            if (param > 0 && param < 1)
+            {
+                Point ortho          = Point{ab.y, -ab.x}.normalize();
+                double orthoDistance = dot(ortho, aq);
+                if (fabs(orthoDistance) < endDistance)
+                    return {orthoDistance, 0};
+            }
+            return {nonZeroSign(cross(aq, ab)) * endDistance, fabs(dot(ab.normalize(), eq.normalize()))};
+        }
+        case 2:
+        {
+            Point qa = p[0] - origin;
+            Point ab = p[1] - p[0];
+            Point br = p[2] - p[1] - ab;
+            double t[3];
+            int solutions = solveCubic(t, dot(br, br), 3 * dot(ab, br), 2 * dot(ab, ab) + dot(qa, br), dot(qa, ab));
+
+            Point epDir        = direction(0);
+            double minDistance = nonZeroSign(cross(epDir, qa)) * qa.length();
+            param              = -dot(qa, epDir) / dot(epDir, epDir);
+            {
+                epDir           = direction(1);
+                double distance = (p[2] - origin).length();
+                if (distance < fabs(minDistance))
+                {
+                    minDistance = nonZeroSign(cross(epDir, p[2] - origin)) * distance;
+                    param       = dot(origin - p[1], epDir) / dot(epDir, epDir);
+                }
+            }
+            for (int i = 0; i < solutions; ++i)
+            {
+                if (t[i] > 0 && t[i] < 1)
+                {
+                    Point qe        = qa + 2 * t[i] * ab + t[i] * t[i] * br;
+                    double distance = qe.length();
+                    if (distance <= fabs(minDistance))
+                    {
+                        minDistance = nonZeroSign(cross(ab + t[i] * br, qe)) * distance;
+                        param       = t[i];
+                    }
+                }
+            }
+            return endpointDistance(origin, minDistance, param, p[2]);
+        }
+        default:
+        {
+            Point qa = p[0] - origin;
+            Point ab = p[1] - p[0];
+            Point br = p[2] - p[1] - ab;
+            Point as = (p[3] - p[2]) - (p[2] - p[1]) - br;
+
+            Point epDir        = direction(0);
+            double minDistance = nonZeroSign(cross(epDir, qa)) * qa.length();
+            param              = -dot(qa, epDir) / dot(epDir, epDir);
+            {
+                epDir           = direction(1);
+                double distance = (p[3] - origin).length();
+                if (distance < fabs(minDistance))
+                {
+                    minDistance = nonZeroSign(cross(epDir, p[3] - origin)) * distance;
+                    param       = dot(epDir - (p[3] - origin), epDir) / dot(epDir, epDir);
+                }
+            }
+
+            // newton iterations from a few starting points
+            constexpr int searchStarts = 4;
+            constexpr int searchSteps  = 4;
+            for (int i = 0; i <= searchStarts; ++i)
+            {
+                double t = (double)i / searchStarts;
+                Point qe = qa + 3 * t * ab + 3 * t * t * br + t * t * t * as;
+                for (int step = 0; step < searchSteps; ++step)
+                {
+                    Point d1 = 3 * ab + 6 * t * br + 3 * t * t * as;
+                    Point d2 = 6 * br + 6 * t * as;
+                    t -= dot(qe, d1) / (dot(d1, d1) + dot(qe, d2));
+                    if (t <= 0 || t >= 1)
+                        break;
+                    qe              = qa + 3 * t * ab + 3 * t * t * br + t * t * t * as;
+                    double distance = qe.length();
+                    if (distance < fabs(minDistance))
+                    {
+                        minDistance = nonZeroSign(cross(d1, qe)) * distance;
+                        param       = t;
+                    }
+                }
+            }
+            return endpointDistance(origin, minDistance, param, p[3]);
+        }
+        }
+    }
+
+    SignedDistance endpointDistance(const Point& origin, double minDistance, double param, const Point& end) const
+    {
+        if (param >= 0 && param <= 1)
+            return {minDistance, 0};
+        if (param < .5)
+            return {minDistance, fabs(dot(direction(0).normalize(), (p[0] - origin).normalize()))};
+        return {minDistance, fabs(dot(direction(1).normalize(), (end - origin).normalize()))};
+    }
+
+    // beyond the ends, the distance to the extended edge keeps the corners sharp
+    void distanceToPseudoDistance(SignedDistance& distance, const Point& origin, double param) const
+    {
+        if (param < 0)
+        {
+            Point dir = direction(0).normalize();
+            Point aq  = origin - point(0);
+            if (dot(aq, dir) < 0)
+            {
+                double pseudoDistance = cross(aq, dir);
+                if (fabs(pseudoDistance) <= fabs(distance.distance))
+                    distance = {pseudoDistance, 0};
+            }
+        }
+        else if (param > 1)
+        {
+            Point dir = direction(1).normalize();
+            Point bq  = origin - point(1);
+            if (dot(bq, dir) > 0)
+            {
+                double pseudoDistance = cross(bq, dir);
+                if (fabs(pseudoDistance) <= fabs(distance.distance))
+                    distance = {pseudoDistance, 0};
+            }
+        }
+    }
+};
+
+using Contour = std::vector<Edge>;
+
+struct OutlineBuilder
+{
+    std::vector<Contour> contours;
+    Point position;
+
+    static Point toPoint(const FT_Vector* v) { return {v->x / 64.0, v->y / 64.0}; }
+
+    static int moveTo(const FT_Vector* to, void* user)
+    {
+        auto self = static_cast<OutlineBuilder*>(user);
+        if (self->contours.empty() || !self->contours.back().empty())
+            self->contours.emplace_back();
+        self->position = toPoint(to);
+        return 0;
+    }
+
+    static int lineTo(const FT_Vector* to, void* user)
+    {
+        auto self = static_cast<OutlineBuilder*>(user);
+        Point end = toPoint(to);
+        if (end != self->position)
+            self->add(1, {self->position, end});
+        return 0;
+    }
+
+    static int conicTo(const FT_Vector* control, const FT_Vector* to, void* user)
+    {
+        auto self = static_cast<OutlineBuilder*>(user);
+        self->add(2, {self->position, toPoint(control), toPoint(to)});
+        return 0;
+    }
+
+    static int cubicTo(const FT_Vector* control1, const FT_Vector* control2, const FT_Vector* to, void* user)
+    {
+        auto self = static_cast<OutlineBuilder*>(user);
+        self->add(3, {self->position, toPoint(control1), toPoint(control2), toPoint(to)});
+        return 0;
+    }
+
+    void add(int degree, std::initializer_list<Point> points)
+    {
+        Edge edge;
+        edge.degree = degree;
+        std::copy(points.begin(), points.end(), edge.p);
+        contours.back().emplace_back(edge);
+        position = edge.p[degree];
+    }
+};
+
+void switchColor(int& color, unsigned long long& seed, int banned = BLACK)
+{
+    int combined = color & banned;
+    if (combined == RED || combined == GREEN || combined == BLUE)
+    {
+        color = combined ^ WHITE;
+        return;
+    }
+    if (color == BLACK || color == WHITE)
+    {
+        static const int start[3] = {CYAN, MAGENTA, YELLOW};
+        color                     = start[seed % 3];
+        seed /= 3;
+        return;
+    }
+    int shifted = color << (1 + (seed & 1));
+    color       = (shifted | shifted >> 3) & WHITE;
+    seed >>= 1;
+}
+
+bool isCorner(const Point& a, const Point& b, double crossThreshold)
+{
+    return dot(a, b) <= 0 || fabs(cross(a, b)) > crossThreshold;
+}
+
+// two edges meeting at a corner never share a color, smooth joins keep theirs
+void colorEdges(std::vector<Contour>& contours)
+{
+    const double crossThreshold = sin(3.0);
+    unsigned long long seed     = 0;
+    std::vector<int> corners;
+    for (auto& contour : contours)
+    {
+        // a teardrop needs three edges to split into colors, the parts of a smooth edge are smooth
+        if (contour.size() < 3)
+        {
+            Contour parts;
+            for (auto& edge : contour)
+            {
+                Edge first  = edge;
+                Edge second = first.splitAt(1 / 3.);
+                Edge third  = second.splitAt(.5);
+                parts.emplace_back(first);
+                parts.emplace_back(second);
+                parts.emplace_back(third);
+            }
+            contour.swap(parts);
+        }
+
+        corners.clear();
+        Point prevDirection = contour.back().direction(1);
+        for (int i = 0, count = static_cast<int>(contour.size()); i < count; ++i)
+        {
+            if (isCorner(prevDirection.normalize(), contour[i].direction(0).normalize(), crossThreshold))
+                corners.emplace_back(i);
+            prevDirection = contour[i].direction(1);
+        }
+
+        const int m = static_cast<int>(contour.size());
+        if (corners.empty())
+        {
+            for (auto& edge : contour)
+                edge.color = WHITE;
+        }
+        else if (corners.size() == 1)
+        {
+            int color = WHITE;
+            int colors[3];
+            switchColor(color, seed);
+            colors[0] = color;
+            colors[1] = WHITE;
+            switchColor(color, seed);
+            colors[2] = color;
+
+            int corner = corners[0];
+            for (int i = 0; i < m; ++i)
+                contour[(corner + i) % m].color = colors[int(3 + 2.875 * i / (m - 1) - 1.4375 + .5) - 2];
+        }
+        else
+        {
+            int cornerCount = static_cast<int>(corners.size());
+            int spline      = 0;
+            int start       = corners[0];
+            int color       = WHITE;
+            switchColor(color, seed);
+            int initialColor = color;
+            for (int i = 0; i < m; ++i)
+            {
+                int index = (start + i) % m;
+                if (spline + 1 < cornerCount && corners[spline + 1] == index)
+                {
+                    ++spline;
+                    switchColor(color, seed, spline == cornerCount - 1 ? initialColor : BLACK);
+                }
+                contour[index].color = color;
+            }
+        }
+    }
+}
+
+inline uint8_t encodeDistance(double distance, double range)
+{
+    double value = std::clamp(distance / range + 0.5, 0.0, 1.0);
+    return static_cast<uint8_t>(value * 255.0 + 0.5);
+}
+}  // namespace
+
+bool generateMSDFGlyph(FT_Face face,
+                       unsigned int glyphIndex,
+                       int spread,
+                       std::vector<uint8_t>& pixels,
+                       int& outWidth,
+                       int& outHeight,
+                       ax::Rect& outRect,
+                       int& xAdvance)
+{
+    pixels.clear();
+    outWidth  = 0;
+    outHeight = 0;
+    outRect   = ax::Rect::ZERO;
+
+    if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP))
+        return false;
+
+    auto glyph = face->glyph;
+    xAdvance   = static_cast<int>(glyph->metrics.horiAdvance >> 6);
+    if (glyph->format != FT_GLYPH_FORMAT_OUTLINE)
+        return false;
+
+    auto& outline = glyph->outline;
+    if (outline.n_points == 0)
+        return true;
+
+    OutlineBuilder builder;
+    FT_Outline_Funcs funcs{&OutlineBuilder::moveTo, &OutlineBuilder::lineTo, &OutlineBuilder::conicTo,
+                           &OutlineBuilder::cubicTo, 0, 0};
+    if (FT_Outline_Decompose(&outline, &funcs, &builder))
+        return false;
+
+    auto& contours = builder.contours;
+    contours.erase(std::remove_if(contours.begin(), contours.end(), [](const Contour& c) { return c.empty(); }),
+                   contours.end());
+    if (contours.empty())
+        return true;
+
+    colorEdges(contours);
+
+    // the distances are positive inside the clockwise contours of TrueType, PostScript outlines wind the other way
+    const double polarity = FT_Outline_Get_Orientation(&outline) == FT_ORIENTATION_POSTSCRIPT ? -1.0 : 1.0;
+
+    FT_BBox cbox;
+    FT_Outline_Get_CBox(&outline, &cbox);
+    const int xMin = static_cast<int>(floor(cbox.xMin / 64.0));
+    const int yMin = static_cast<int>(floor(cbox.yMin / 64.0));
+    const int xMax = static_cast<int>(ceil(cbox.xMax / 64.0));
+    const int yMax = static_cast<int>(ceil(cbox.yMax / 64.0));
+
+    outRect.origin.x    = static_cast<float>(xMin);
+    outRect.origin.y    = static_cast<float>(-yMax);
+    outRect.size.width  = static_cast<float>(xMax - xMin);
+    outRect.size.height = static_cast<float>(yMax - yMin);
+
+    outWidth  = xMax - xMin + 2 * spread;
+    outHeight = yMax - yMin + 2 * spread;
+    pixels.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+
+    struct ChannelDistance
+    {
+        SignedDistance distance;
+        const Edge* edge = nullptr;
+        double param     = 0;
+    };
+
+    const double range = 2.0 * spread;
+    for (int py = 0; py < outHeight; ++py)
+    {
+        for (int px = 0; px < outWidth; ++px)
+        {
+            // the rows go down from the top of the glyph box
+            Point origin{xMin - spread + px + 0.5, yMax + spread - py - 0.5};
+
+            ChannelDistance channels[3];
+            SignedDistance trueDistance;
+            for (auto& contour : contours)
+            {
+                for (auto& edge : contour)
+                {
+                    double param;
+                    auto distance = edge.signedDistance(origin, param);
+                    if (distance < trueDistance)
+                        trueDistance = distance;
+                    for (int channel = 0; channel < 3; ++channel)
+                    {
+                        if ((edge.color & (1 << channel)) && distance < channels[channel].distance)
+                            channels[channel] = {distance, &edge, param};
+                    }
+                }
+            }
+
+            auto pixel = pixels.data() + (static_cast<size_t>(py) * outWidth + px) * 4;
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                auto& nearest = channels[channel];
+                if (nearest.edge)
+                    nearest.edge->distanceToPseudoDistance(nearest.distance, origin, nearest.param);
+                pixel[channel] = encodeDistance(polarity * nearest.distance.distance, range);
+            }
+            pixel[3] = encodeDistance(polarity * trueDistance.distance, range);
+        }
+    }
+    return true;
+}
+
+NS_AX_EXT_END
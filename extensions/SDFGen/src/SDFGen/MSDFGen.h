@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "math/Rect.h"
+#include "extensions/ExtensionMacros.h"
+
+NS_AX_EXT_BEGIN
+
+/**
+ * Generates the multi-channel signed distance field of a glyph, the face must be sized with FT_Set_Pixel_Sizes.
+ *
+ * The edges of each contour are split into colors at the corners, and every channel stores the distance to the
+ * nearest edge of its color, so the median of rgb keeps the corners sharp at any scale. Alpha stores the true
+ * distance, for the effects reaching beyond the outline. A distance of spread pixels maps to 0 outside and 1 inside,
+ * the outline is at 0.5, like the single channel fields FreeType renders.
+ *
+ * The bitmap has the layout of the FreeType SDF bitmaps, the glyph box grown by spread pixels on each side, so it is
+ * placed in the atlas the same way. Glyphs without outline, e.g. the space, have an empty bitmap.
+ */
+bool generateMSDFGlyph(FT_Face face,
+                       unsigned int glyphIndex,
+                       int spread,
+                       std::vector<uint8_t>& pixels,
+                       int& outWidth,
+                       int& outHeight,
+                       ax::Rect& outRect,
+                       int& xAdvance);
+
+NS_AX_EXT_END
@@ -11,6 +11,7 @@
 #include <zlib.h>
 #include "base/JsonWriter.h"
 #include "yasio/utils.hpp"
+#include "MSDFGen.h"
 
 NS_AX_EXT_BEGIN
 
@@ -22,6 +23,7 @@ struct FontAtlasGenParams
     int faceSize    = 32;
     int atlasDim[2] = {512, 512};  // w,h
     bool useAscii   = true;
+    bool multiChannel = true;  // msdf, served at every font size by the runtime
 
     bool saved = false;
     float cost = 0.0f;  // milliseconds
@@ -39,6 +41,7 @@ struct FontAtlasGenParams
  *   "atlasName": "xxx",
  *   "sourceFont: "xxx",
  *   "spread": 6, // reserved
+ *   "distanceField": "msdf", // optional, RGBA8 multi-channel pages, the median of rgb is the distance
  *   "faceSize": 32,
  *   "atlasSize": [512, 512],
  *   "letters": [
@@ -65,7 +68,11 @@ namespace xasset
 class FontAtlas : public ax::FontAtlas
 {
 public:
-    FontAtlas(Font* theFont, int atlasWidth, int atlasHeight) : ax::FontAtlas(theFont, atlasWidth, atlasHeight) {}
+    FontAtlas(Font* theFont, int atlasWidth, int atlasHeight) : ax::FontAtlas(theFont, atlasWidth, atlasHeight)
+    {
+        // every glyph of the character set is saved, the pages must not be reused
+        _maxPageCount = 0;
+    }
     static FontAtlas* newFontAtlas(FontAtlasGenParams* params)
     {
         auto font      = FontFreeType::create(params->sourceFont, params->faceSize,
@@ -104,7 +111,9 @@ public:
         xasset.writeString("type"sv, "fontatlas"sv);
         xasset.writeString("sourceFont"sv, _params->sourceFont);
         xasset.writeString("atlasName"sv, _atlasName);
-        xasset.writeNumber("spread"sv, 6);
+        xasset.writeNumber("spread"sv, FontFreeType::DistanceMapSpread);
+        if (isMultiChannelDistanceField())
+            xasset.writeString("distanceField"sv, "msdf"sv);
         xasset.writeNumber("faceSize"sv, _params->faceSize);
 
         xasset.writeNumberArray("atlasDim"sv, _params->atlasDim);
@@ -171,16 +180,60 @@ protected:
     {
         _params = params;
 
-        // match with runtime
-        _atlasName = fmt::format("df {} {}", params->faceSize, params->sourceFont);
+        // match with runtime, a multi-channel atlas serves every face size
+        _atlasName = params->multiChannel ? fmt::format("msdf {}", params->sourceFont)
+                                          : fmt::format("df {} {}", params->faceSize, params->sourceFont);
 
         std::u32string utf32;
         if (StringUtils::UTF8ToUTF32(_fontFreeType->getGlyphCollection(), utf32))
-            this->prepareLetterDefinitions(utf32);
+        {
+            if (params->multiChannel)
+                this->generateMultiChannelLetters(utf32);
+            else
+                this->prepareLetterDefinitions(utf32);
+        }
 
         _pageDatas.emplace_back(_currentPageData, _currentPageData + _currentPageDataSize);
     }
 
+    void generateMultiChannelLetters(const std::u32string& utf32)
+    {
+        enableMultiChannelDistanceField();
+        reinit();
+
+        // a face of our own, the outlines are read unhinted
+        auto data    = FileUtils::getInstance()->getDataFromFile(_params->sourceFont);
+        FT_Face face = nullptr;
+        if (data.isNull() || FT_New_Memory_Face(FontFreeType::getFTLibrary(), data.getBytes(),
+                                                static_cast<FT_Long>(data.getSize()), 0, &face))
+        {
+            _params->error = fmt::format("Open font {} fail!", _params->sourceFont);
+            return;
+        }
+        FT_Set_Pixel_Sizes(face, 0, _params->faceSize);
+
+        std::vector<uint8_t> pixels;
+        int width = 0, height = 0, xAdvance = 0;
+        Rect rect;
+        for (auto charCode : utf32)
+        {
+            if (_letterDefinitions.find(charCode) != _letterDefinitions.end())
+                continue;
+
+            auto glyphIndex = FT_Get_Char_Index(face, charCode);
+            if (glyphIndex == 0)
+                continue;
+
+            if (generateMSDFGlyph(face, glyphIndex, FontFreeType::DistanceMapSpread, pixels, width, height, rect,
+                                  xAdvance))
+                placeLetter(charCode, nullptr, pixels.empty() ? nullptr : pixels.data(), width, height, rect,
+                            xAdvance);
+        }
+        updateTextureContent();
+
+        FT_Done_Face(face);
+    }
+
     void addNewPage() override
     {
         if (_currentPage != -1)
@@ -292,6 +345,8 @@ void SDFGen::onImGuiDraw()
         ImGui::DragInt("Sampling Point Size", &_atlasParams->faceSize, 1, 1, 144);
         ImGui::DragInt2("Atlas Resolution", _atlasParams->atlasDim, 32, 64, 4096);
 
+        ImGui::Checkbox("Multi-channel (MSDF)", &_atlasParams->multiChannel);
+
         bool modified = ImGui::Checkbox("Use ASCII", &_atlasParams->useAscii);
         ImGui::SameLine();
         ImGui::Text("%s", "Character Set");
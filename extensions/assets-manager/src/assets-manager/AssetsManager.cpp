@@ -24,8 +24,6 @@
  ****************************************************************************/
 #include "AssetsManager.h"
 
-#include <thread>
-
 #include "base/Director.h"
 #include "base/Scheduler.h"
 #include "base/UserDefault.h"
@@ -311,7 +309,7 @@ bool AssetsManager::checkUpdate()
 
 void AssetsManager::downloadAndUncompress()
 {
-    std::thread([this]() {
+    Director::getInstance()->getJobSystem()->schedule([this]() {
         do
         {
             // Uncompress zip file.
@@ -351,7 +349,7 @@ void AssetsManager::downloadAndUncompress()
         } while (0);
 
         _isDownloading = false;
-    }).detach();
+    }, JobPriority::Low);
 }
 
 void AssetsManager::update()
@@ -26,6 +26,7 @@
 #include "EventListenerAssetsManagerEx.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
+#include "base/JobSystem.h"
 
 #include <stdio.h>
 
@@ -46,6 +47,8 @@ NS_AX_EXT_BEGIN
 #define BUFFER_SIZE                8192
 #define MAX_FILENAME               512
 
+#define MIN_DECOMPRESS_JOB_ENTRIES 16
+
 #define DEFAULT_CONNECTION_TIMEOUT 45
 
 #define SAVE_POINT_INTERVAL        0.1
@@ -423,9 +426,8 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         return false;
     }
 
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
-    // Loop to extract all files.
+    // Create all the directories first, only from this thread, the files are then extracted in parallel
+    hlookup::string_set directories;
     uLong i;
     for (i = 0; i < global_info.number_entry; ++i)
     {
@@ -441,34 +443,128 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         std::string fullPath{rootPath};
         fullPath += fileName;
 
-        // Check if this entry is a directory or a file.
-        const size_t filenameLength = strlen(fileName);
-        if (fileName[filenameLength - 1] == '/')
+        // There are not directory entry in some case.
+        // So we need to create the directory of the file entries too
+        std::string_view dir = basename(fullPath);
+        if (directories.find(dir) == directories.end())
         {
-            // There are not directory entry in some case.
-            // So we need to create directory when decompressing file entry
-            if (!_fileUtils->createDirectories(basename(fullPath)))
+            if (!_fileUtils->isDirectoryExist(dir) && !_fileUtils->createDirectories(dir))
             {
                 // Failed to create directory
                 AXLOGD("AssetsManagerEx : can not create directory {}\n", fullPath);
                 unzClose(zipfile);
                 return false;
             }
+            directories.emplace(dir);
         }
-        else
+
+        // Goto next entry listed in the zip file.
+        if ((i + 1) < global_info.number_entry)
         {
-            // Create all directories in advance to avoid issue
-            std::string_view dir = basename(fullPath);
-            if (!_fileUtils->isDirectoryExist(dir))
+            if (unzGoToNextFile(zipfile) != UNZ_OK)
             {
-                if (!_fileUtils->createDirectories(dir))
-                {
-                    // Failed to create directory
-                    AXLOGD("AssetsManagerEx : can not create directory {}\n", fullPath);
-                    unzClose(zipfile);
-                    return false;
-                }
+                AXLOGD("AssetsManagerEx : can not read next file for decompressing\n");
+                unzClose(zipfile);
+                return false;
             }
+        }
+    }
+    unzClose(zipfile);
+
+    // The entries are split in ranges, the jobs and the calling job claim the ranges until they are all claimed, then
+    // it waits for the claimed ones only, a job a busy worker hasn't started yet finds nothing left to extract
+    struct DecompressState
+    {
+        std::string zip;
+        std::string rootPath;
+        size_t entryCount;
+        size_t rangeCount;
+        size_t rangeEntries;
+        std::atomic<size_t> nextRange{0};
+        std::atomic<size_t> doneRanges{0};
+        std::atomic<bool> succeed{true};
+    };
+    auto jobSystem      = Director::getInstance()->getJobSystem();
+    auto state          = std::make_shared<DecompressState>();
+    state->zip          = zip;
+    state->rootPath     = rootPath;
+    state->entryCount   = global_info.number_entry;
+    state->rangeCount   = std::clamp(state->entryCount / MIN_DECOMPRESS_JOB_ENTRIES, (size_t)1,
+                                     std::max(jobSystem->getWorkerCount(), (size_t)1));
+    state->rangeEntries = (state->entryCount + state->rangeCount - 1) / state->rangeCount;
+
+    auto extractRanges = [this, state]() {
+        size_t range;
+        while ((range = state->nextRange.fetch_add(1)) < state->rangeCount)
+        {
+            const size_t begin = range * state->rangeEntries;
+            const size_t end   = std::min(begin + state->rangeEntries, state->entryCount);
+            if (!state->succeed || !decompressEntries(state->zip, state->rootPath, begin, end))
+                state->succeed = false;
+            state->doneRanges.fetch_add(1);
+        }
+    };
+
+    for (size_t i = 1; i < state->rangeCount; ++i)
+        jobSystem->schedule(extractRanges, JobPriority::Low);
+
+    extractRanges();
+
+    while (state->doneRanges.load() < state->rangeCount)
+        std::this_thread::yield();
+
+    return state->succeed;
+}
+
+bool AssetsManagerEx::decompressEntries(std::string_view zip, std::string_view rootPath, size_t begin, size_t end)
+{
+    zlib_filefunc_def_s zipFunctionOverrides;
+    fillZipFunctionOverrides(zipFunctionOverrides);
+
+    AssetManagerExZipFileInfo zipFileInfo;
+    zipFileInfo.zipFileName = zip;
+
+    zipFunctionOverrides.opaque = &zipFileInfo;
+
+    unzFile zipfile = unzOpen2(zip.data(), &zipFunctionOverrides);
+    if (!zipfile)
+    {
+        AXLOGD("AssetsManagerEx : can not open downloaded zip file {}\n", zip);
+        return false;
+    }
+
+    // Skip the entries before the range, it only reads the central directory
+    for (size_t i = 0; i < begin; ++i)
+    {
+        if (unzGoToNextFile(zipfile) != UNZ_OK)
+        {
+            AXLOGD("AssetsManagerEx : can not read next file for decompressing\n");
+            unzClose(zipfile);
+            return false;
+        }
+    }
+
+    // Buffer to hold data read from the zip file
+    char readBuffer[BUFFER_SIZE];
+    // Loop to extract the files of the range.
+    for (size_t i = begin; i < end; ++i)
+    {
+        // Get info about current file.
+        unz_file_info fileInfo;
+        char fileName[MAX_FILENAME];
+        if (unzGetCurrentFileInfo(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK)
+        {
+            AXLOGD("AssetsManagerEx : can not read compressed file info\n");
+            unzClose(zipfile);
+            return false;
+        }
+        std::string fullPath{rootPath};
+        fullPath += fileName;
+
+        // Check if this entry is a directory or a file, the directories are already created.
+        const size_t filenameLength = strlen(fileName);
+        if (fileName[filenameLength - 1] != '/')
+        {
             // Entry is a file, so extract it.
             // Open current file.
             if (unzOpenCurrentFile(zipfile) != UNZ_OK)
@@ -515,7 +611,7 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         unzCloseCurrentFile(zipfile);
 
         // Goto next entry listed in the zip file.
-        if ((i + 1) < global_info.number_entry)
+        if ((i + 1) < end)
         {
             if (unzGoToNextFile(zipfile) != UNZ_OK)
             {
@@ -1259,7 +1355,17 @@ void AssetsManagerEx::queueDowload()
         _currConcurrentTask++;
         DownloadUnit& unit = _downloadUnits[key];
         _fileUtils->createDirectories(basename(unit.storagePath));
-        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId);
+
+        // The downloader updates the digest with the received data, a mismatch fails the task
+        std::string_view checksum;
+        if (_checksumVerifyEnabled && _remoteManifest)
+        {
+            auto& assets = _remoteManifest->getAssets();
+            auto assetIt = assets.find(unit.customId);
+            if (assetIt != assets.end())
+                checksum = assetIt->second.md5;
+        }
+        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId, checksum);
 
         _tempManifest->setAssetDownloadState(key, Manifest::DownloadState::DOWNLOADING);
     }
@@ -136,6 +136,14 @@ public:
         _verifyCallback = callback;
     };
 
+    /** @brief Enables checking the md5 of the remote manifest assets while they are downloaded, a mismatching asset
+     * fails like a download error, without a pass over the file after it is downloaded. The md5 of the manifest must
+     * be the digest of the downloaded file, compressed or not.
+     * @param enabled   Whether the downloads are checked, disabled by default
+     */
+    void setChecksumVerifyEnabled(bool enabled) { _checksumVerifyEnabled = enabled; }
+    bool isChecksumVerifyEnabled() const { return _checksumVerifyEnabled; }
+
     AssetsManagerEx(std::string_view manifestUrl, std::string_view storagePath);
 
     virtual ~AssetsManagerEx();
@@ -168,6 +176,8 @@ protected:
     void startUpdate();
     void updateSucceed();
     bool decompress(std::string_view filename);
+    /** Extracts the file entries in [begin, end) of a zip, the directories must exist. */
+    bool decompressEntries(std::string_view zip, std::string_view rootPath, size_t begin, size_t end);
     void decompressDownloadedZip(std::string_view customId, std::string_view storagePath);
 
     /** @brief Update a list of assets under the current AssetsManagerEx context
@@ -334,6 +344,9 @@ private:
     //! Callback function to verify the downloaded assets
     std::function<bool(std::string_view path, Manifest::Asset asset)> _verifyCallback = nullptr;
 
+    //! Whether the md5 of the assets is checked during their download
+    bool _checksumVerifyEnabled = false;
+
     //! Marker for whether the assets manager is inited
     bool _inited = false;
 };
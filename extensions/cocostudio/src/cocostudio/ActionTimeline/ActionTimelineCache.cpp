@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "2d/SpriteFrameCache.h"
 #include "2d/SpriteFrame.h"
 #include "base/Utils.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
 
 #include "cocostudio/CSParseBinary_generated.h"
 
@@ -447,6 +449,52 @@ ActionTimeline* ActionTimelineCache::loadAnimationActionWithFlatBuffersFile(std:
     return action;
 }
 
+void ActionTimelineCache::loadAnimationActionWithFlatBuffersFileAsync(std::string_view fileName,
+                                                                      std::function<void(ActionTimeline*)> callback)
+{
+    ActionTimeline* action = _animationActions.at(fileName);
+    if (action)
+    {
+        if (callback)
+            callback(action);
+        return;
+    }
+
+    struct AsyncLoad
+    {
+        Data data;
+        bool valid = false;
+    };
+    auto load = std::make_shared<AsyncLoad>();
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
+
+    Director::getInstance()->getJobSystem()->enqueue(
+        [load, fullPath]() {
+            load->data = FileUtils::getInstance()->getDataFromFile(fullPath);
+            if (load->data.isNull())
+                return;
+
+            flatbuffers::Verifier verifier(load->data.getBytes(), load->data.getSize());
+            load->valid = VerifyCSParseBinaryBuffer(verifier) && GetCSParseBinary(load->data.getBytes())->action();
+        },
+        [this, load, name = std::string{fileName}, callback]() {
+            // may be loaded while it was read
+            ActionTimeline* action = _animationActions.at(name);
+            if (action == nullptr)
+            {
+                if (load->valid)
+                {
+                    action = createActionWithDataBuffer(load->data);
+                    _animationActions.insert(name, action);
+                }
+                else
+                    AXLOGW("ActionTimelineCache: {} isn't a valid csb file", name);
+            }
+            if (callback)
+                callback(action);
+        });
+}
+
 ActionTimeline* ActionTimelineCache::loadAnimationWithDataBuffer(const ax::Data& data, std::string_view fileName)
 {
     // if already exists an action with filename, then return this action
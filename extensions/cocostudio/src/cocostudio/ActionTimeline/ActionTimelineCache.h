@@ -86,6 +86,14 @@ public:
     ActionTimeline* loadAnimationActionWithFlatBuffersFile(std::string_view fileName);
     ActionTimeline* loadAnimationWithDataBuffer(const ax::Data& data, std::string_view fileName);
 
+    /**
+     * Loads a .csb action like loadAnimationActionWithFlatBuffersFile, the file is read and its flatbuffers
+     * verified on a JobSystem worker, the timelines are built and cached on the axmol thread, which then calls
+     * the callback with the cached action, nullptr if the file can't be read or isn't valid.
+     */
+    void loadAnimationActionWithFlatBuffersFileAsync(std::string_view fileName,
+                                                     std::function<void(ActionTimeline*)> callback);
+
     ActionTimeline* createActionWithFlatBuffersForSimulator(std::string_view fileName);
 
 protected:
@@ -29,6 +29,7 @@
 
 #include "base/ObjectFactory.h"
 #include "base/Director.h"
+#include "base/JobSystem.h"
 #include "base/UTF8.h"
 #include "ui/CocosGUI.h"
 #include "2d/SpriteFrameCache.h"
@@ -319,6 +320,36 @@ Node* CSLoader::createNode(std::string_view filename, const ccNodeLoadCallback&
     return nullptr;
 }
 
+void CSLoader::createNodeAsync(std::string_view filename, std::function<void(ax::Node*)> callback)
+{
+    struct AsyncLoad
+    {
+        Data data;
+        bool valid = false;
+    };
+    auto load = std::make_shared<AsyncLoad>();
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+
+    Director::getInstance()->getJobSystem()->enqueue(
+        [load, fullPath]() {
+            load->data = FileUtils::getInstance()->getDataFromFile(fullPath);
+            if (load->data.isNull())
+                return;
+
+            flatbuffers::Verifier verifier(load->data.getBytes(), load->data.getSize());
+            load->valid = VerifyCSParseBinaryBuffer(verifier);
+        },
+        [load, name = std::string{filename}, callback]() {
+            Node* node = nullptr;
+            if (load->valid)
+                node = createNode(load->data);
+            else
+                AXLOGW("CSLoader: {} isn't a valid csb file", name);
+            if (callback)
+                callback(node);
+        });
+}
+
 Node* CSLoader::createNodeWithVisibleSize(std::string_view filename)
 {
     auto node = createNode(filename);
@@ -82,6 +82,12 @@ public:
     static ax::Node* createNode(std::string_view filename, const ccNodeLoadCallback& callback);
     static ax::Node* createNode(const Data& data);
     static ax::Node* createNode(const Data& data, const ccNodeLoadCallback& callback);
+    /**
+     * Creates the node of a .csb file, the file is read and its flatbuffers verified on a JobSystem worker,
+     * the node is built on the axmol thread, which then calls the callback with it, nullptr if the file can't
+     * be read or isn't valid. The node is autoreleased, retain it to keep it after the callback.
+     */
+    static void createNodeAsync(std::string_view filename, std::function<void(ax::Node*)> callback);
     static ax::Node* createNodeWithVisibleSize(std::string_view filename);
     static ax::Node* createNodeWithVisibleSize(std::string_view filename, const ccNodeLoadCallback& callback);
 
@@ -87,7 +87,10 @@ Armature::Armature()
     , _parentBone(nullptr)
     , _armatureTransformDirty(true)
     , _animation(nullptr)
-{}
+{
+    // getNodeToParentTransform tracks when the transform gets dirty
+    _transformBatchable = false;
+}
 
 Armature::~Armature()
 {
@@ -118,7 +121,7 @@ bool Armature::init(std::string_view name)
 
         _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
 
-        _name = name;
+        _name = InternedString(name);
 
         ArmatureDataManager* armatureDataManager = ArmatureDataManager::getInstance();
 
@@ -160,7 +163,7 @@ bool Armature::init(std::string_view name)
         }
         else
         {
-            _name               = "new_armature";
+            _name               = InternedString("new_armature");
             _armatureData       = ArmatureData::create();
             _armatureData->name = _name;
 
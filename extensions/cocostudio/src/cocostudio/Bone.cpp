@@ -101,7 +101,7 @@ bool Bone::init(std::string_view name)
     do
     {
 
-        _name = name;
+        _name = InternedString(name);
 
         AX_SAFE_DELETE(_tweenData);
         _tweenData = new FrameData();
@@ -137,7 +137,7 @@ void Bone::setBoneData(BoneData* boneData)
         _boneData = boneData;
     }
 
-    _name = _boneData->name;
+    _name = InternedString(_boneData->name);
     _setLocalZOrder(_boneData->zOrder);
 
     _displayManager->initDisplayList(boneData);
@@ -144,6 +144,53 @@ static std::string readFileContent(std::string_view filename, bool binary)
     return s;
 };
 
+using JsonObject = simdjson::ondemand::object;
+
+// The getters of the fields of a json object, a missing or null field gives the default value
+static float getJsonFloat(JsonObject& json, std::string_view key, float def = 0.0f)
+{
+    double value;
+    return json[key].get_double().get(value) == simdjson::SUCCESS ? static_cast<float>(value) : def;
+}
+
+static int getJsonInt(JsonObject& json, std::string_view key, int def = 0)
+{
+    double value;
+    return json[key].get_double().get(value) == simdjson::SUCCESS ? static_cast<int>(value) : def;
+}
+
+static bool getJsonBool(JsonObject& json, std::string_view key, bool def = false)
+{
+    bool value;
+    return json[key].get_bool().get(value) == simdjson::SUCCESS ? value : def;
+}
+
+static bool getJsonString(JsonObject& json, std::string_view key, std::string& value)
+{
+    std::string_view str;
+    if (json[key].get_string().get(str) != simdjson::SUCCESS)
+        return false;
+    value.assign(str);
+    return true;
+}
+
+// Calls fn with the objects of the array field of a json object, in order
+template <typename Fn>
+static void forEachJsonObject(JsonObject& json, std::string_view key, Fn&& fn)
+{
+    simdjson::ondemand::array array;
+    if (json[key].get_array().get(array) != simdjson::SUCCESS)
+        return;
+
+    for (auto item : array)
+    {
+        JsonObject object;
+        if (item.get_object().get(object) != simdjson::SUCCESS)
+            break;
+        fn(object);
+    }
+}
+
 namespace cocostudio
 {
 
@@ -1111,37 +1158,27 @@ ContourData* DataReaderHelper::decodeContour(pugi::xml_node& contourXML, DataInf
 
 void DataReaderHelper::addDataFromJsonCache(std::string_view fileContent, DataInfo* dataInfo)
 {
-    rapidjson::Document json;
-    rapidjson::StringStream stream(fileContent.data());
-
-    if (fileContent.size() >= 3)
-    {
-        // Skip BOM if exists
-        const unsigned char* c = (const unsigned char*)fileContent.data();
-        unsigned bom           = c[0] | (c[1] << 8) | (c[2] << 16);
-
-        if (bom == 0xBFBBEF)  // UTF8 BOM
-        {
-            stream.Take();
-            stream.Take();
-            stream.Take();
-        }
-    }
-
-    json.ParseStream<0>(stream);
-    if (json.HasParseError())
-    {
-        AXLOGD("GetParseError {}\n",  static_cast<int>(json.GetParseError()));
+    // Skip BOM if exists
+    if (fileContent.size() >= 3 && fileContent.substr(0, 3) == std::string_view{"\xEF\xBB\xBF"})
+        fileContent.remove_prefix(3);
+
+    // The on-demand parser reads the values while the decoders walk the document, no DOM is built. The fields
+    // of an object are found by name in any order, the decoders only have to read an object before its parent.
+    simdjson::padded_string content(fileContent);
+    simdjson::ondemand::parser parser;
+    simdjson::ondemand::document doc;
+    JsonObject json;
+    if (parser.iterate(content).get(doc) != simdjson::SUCCESS || doc.get_object().get(json) != simdjson::SUCCESS)
+    {
+        AXLOGD("GetParseError, {} isn't a json object", dataInfo->filename);
+        return;
     }
 
-    dataInfo->contentScale = DICTOOL->getFloatValue_json(json, CONTENT_SCALE, 1.0f);
+    dataInfo->contentScale = getJsonFloat(json, CONTENT_SCALE, 1.0f);
 
     // Decode armatures
-    int length = DICTOOL->getArrayCount_json(json, ARMATURE_DATA);
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& armatureDic = DICTOOL->getSubDictionary_json(json, ARMATURE_DATA, i);
-        ArmatureData* armatureData          = decodeArmature(armatureDic, dataInfo);
+    forEachJsonObject(json, ARMATURE_DATA, [dataInfo](JsonObject& armatureDic) {
+        ArmatureData* armatureData = decodeArmature(armatureDic, dataInfo);
 
         if (dataInfo->asyncStruct)
         {
@@ -1153,15 +1190,11 @@ void DataReaderHelper::addDataFromJsonCache(std::string_view fileContent, DataIn
         {
             _dataReaderHelper->_addDataMutex.unlock();
         }
-    }
+    });
 
     // Decode animations
-    length = DICTOOL->getArrayCount_json(
-        json, ANIMATION_DATA);  // json[ANIMATION_DATA].IsNull() ? 0 : json[ANIMATION_DATA].Size();
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& animationDic = DICTOOL->getSubDictionary_json(json, ANIMATION_DATA, i);
-        AnimationData* animationData         = decodeAnimation(animationDic, dataInfo);
+    forEachJsonObject(json, ANIMATION_DATA, [dataInfo](JsonObject& animationDic) {
+        AnimationData* animationData = decodeAnimation(animationDic, dataInfo);
 
         if (dataInfo->asyncStruct)
         {
@@ -1173,14 +1206,11 @@ void DataReaderHelper::addDataFromJsonCache(std::string_view fileContent, DataIn
         {
             _dataReaderHelper->_addDataMutex.unlock();
         }
-    }
+    });
 
     // Decode textures
-    length = DICTOOL->getArrayCount_json(json, TEXTURE_DATA);
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& textureDic = DICTOOL->getSubDictionary_json(json, TEXTURE_DATA, i);
-        TextureData* textureData           = decodeTexture(textureDic);
+    forEachJsonObject(json, TEXTURE_DATA, [dataInfo](JsonObject& textureDic) {
+        TextureData* textureData = decodeTexture(textureDic);
 
         if (dataInfo->asyncStruct)
         {
@@ -1192,28 +1222,25 @@ void DataReaderHelper::addDataFromJsonCache(std::string_view fileContent, DataIn
         {
             _dataReaderHelper->_addDataMutex.unlock();
         }
-    }
+    });
 
     // Auto load sprite file
     bool autoLoad = dataInfo->asyncStruct == nullptr ? ArmatureDataManager::getInstance()->isAutoLoadSpriteFile()
                                                      : dataInfo->asyncStruct->autoLoadSpriteFile;
-    if (autoLoad)
+    simdjson::ondemand::array configFiles;
+    if (autoLoad && json[CONFIG_FILE_PATH].get_array().get(configFiles) == simdjson::SUCCESS)
     {
-        length = DICTOOL->getArrayCount_json(
-            json, CONFIG_FILE_PATH);  // json[CONFIG_FILE_PATH].IsNull() ? 0 : json[CONFIG_FILE_PATH].Size();
-        for (int i = 0; i < length; i++)
+        for (auto item : configFiles)
         {
-            const char* path = DICTOOL->getStringValueFromArray_json(
-                json, CONFIG_FILE_PATH,
-                i);  // json[CONFIG_FILE_PATH][i].IsNull() ? nullptr : json[CONFIG_FILE_PATH][i].GetString();
-            if (path == nullptr)
+            std::string_view path;
+            if (item.get_string().get(path) != simdjson::SUCCESS)
             {
                 AXLOGD("load CONFIG_FILE_PATH error.");
                 return;
             }
 
-            std::string filePath = path;
-            filePath             = filePath.erase(filePath.find_last_of('.'));
+            std::string filePath{path};
+            filePath = filePath.erase(filePath.find_last_of('.'));
 
             if (dataInfo->asyncStruct)
             {
@@ -1238,66 +1265,46 @@ void DataReaderHelper::addDataFromJsonCache(std::string_view fileContent, DataIn
     }
 }
 
-ArmatureData* DataReaderHelper::decodeArmature(const rapidjson::Value& json, DataInfo* dataInfo)
+ArmatureData* DataReaderHelper::decodeArmature(JsonObject& json, DataInfo* dataInfo)
 {
     ArmatureData* armatureData = new ArmatureData();
     armatureData->init();
 
-    const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-    if (name != nullptr)
-    {
-        armatureData->name = name;
-    }
+    getJsonString(json, A_NAME, armatureData->name);
 
-    dataInfo->cocoStudioVersion = armatureData->dataVersion = DICTOOL->getFloatValue_json(json, VERSION, 0.1f);
+    dataInfo->cocoStudioVersion = armatureData->dataVersion = getJsonFloat(json, VERSION, 0.1f);
 
-    int length = DICTOOL->getArrayCount_json(json, BONE_DATA, 0);
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, BONE_DATA, i);  // json[BONE_DATA][i];
-        BoneData* boneData          = decodeBone(dic, dataInfo);
+    forEachJsonObject(json, BONE_DATA, [armatureData, dataInfo](JsonObject& dic) {
+        BoneData* boneData = decodeBone(dic, dataInfo);
         armatureData->addBoneData(boneData);
         boneData->release();
-    }
+    });
 
     return armatureData;
 }
 
-BoneData* DataReaderHelper::decodeBone(const rapidjson::Value& json, DataInfo* dataInfo)
+BoneData* DataReaderHelper::decodeBone(JsonObject& json, DataInfo* dataInfo)
 {
     BoneData* boneData = new BoneData();
     boneData->init();
 
     decodeNode(boneData, json, dataInfo);
 
-    const char* str = DICTOOL->getStringValue_json(json, A_NAME);
-    if (str != nullptr)
-    {
-        boneData->name = str;
-    }
-
-    str = DICTOOL->getStringValue_json(json, A_PARENT);
-    if (str != nullptr)
-    {
-        boneData->parentName = str;
-    }
-
-    int length = DICTOOL->getArrayCount_json(json, DISPLAY_DATA);
+    getJsonString(json, A_NAME, boneData->name);
+    getJsonString(json, A_PARENT, boneData->parentName);
 
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, DISPLAY_DATA, i);
-        DisplayData* displayData    = decodeBoneDisplay(dic, dataInfo);
+    forEachJsonObject(json, DISPLAY_DATA, [boneData, dataInfo](JsonObject& dic) {
+        DisplayData* displayData = decodeBoneDisplay(dic, dataInfo);
         boneData->addDisplayData(displayData);
         displayData->release();
-    }
+    });
 
     return boneData;
 }
 
-DisplayData* DataReaderHelper::decodeBoneDisplay(const rapidjson::Value& json, DataInfo* dataInfo)
+DisplayData* DataReaderHelper::decodeBoneDisplay(JsonObject& json, DataInfo* dataInfo)
 {
-    DisplayType displayType = (DisplayType)(DICTOOL->getIntValue_json(json, A_DISPLAY_TYPE, CS_DISPLAY_SPRITE));
+    DisplayType displayType = (DisplayType)(getJsonInt(json, A_DISPLAY_TYPE, CS_DISPLAY_SPRITE));
 
     DisplayData* displayData = nullptr;
 
@@ -1307,31 +1314,29 @@ DisplayData* DataReaderHelper::decodeBoneDisplay(const rapidjson::Value& json, D
     {
         displayData = new SpriteDisplayData();
 
-        const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-        if (name != nullptr)
-        {
-            ((SpriteDisplayData*)displayData)->displayName = name;
-        }
-        if (json.HasMember(SKIN_DATA))
+        getJsonString(json, A_NAME, ((SpriteDisplayData*)displayData)->displayName);
+
+        simdjson::ondemand::array dicArray;
+        if (json[SKIN_DATA].get_array().get(dicArray) == simdjson::SUCCESS)
         {
-            const rapidjson::Value& dicArray = DICTOOL->getSubDictionary_json(json, SKIN_DATA);
-            if (!dicArray.IsNull())
+            // only the first skin is read
+            for (auto item : dicArray)
             {
-                rapidjson::SizeType index   = 0;
-                const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(dicArray, index);
-                if (!dic.IsNull())
+                JsonObject dic;
+                if (item.get_object().get(dic) == simdjson::SUCCESS)
                 {
                     SpriteDisplayData* sdd = (SpriteDisplayData*)displayData;
-                    sdd->skinData.x        = DICTOOL->getFloatValue_json(dic, A_X) * s_PositionReadScale;
-                    sdd->skinData.y        = DICTOOL->getFloatValue_json(dic, A_Y) * s_PositionReadScale;
-                    sdd->skinData.scaleX   = DICTOOL->getFloatValue_json(dic, A_SCALE_X, 1.0f);
-                    sdd->skinData.scaleY   = DICTOOL->getFloatValue_json(dic, A_SCALE_Y, 1.0f);
-                    sdd->skinData.skewX    = DICTOOL->getFloatValue_json(dic, A_SKEW_X, 1.0f);
-                    sdd->skinData.skewY    = DICTOOL->getFloatValue_json(dic, A_SKEW_Y, 1.0f);
+                    sdd->skinData.x        = getJsonFloat(dic, A_X) * s_PositionReadScale;
+                    sdd->skinData.y        = getJsonFloat(dic, A_Y) * s_PositionReadScale;
+                    sdd->skinData.scaleX   = getJsonFloat(dic, A_SCALE_X, 1.0f);
+                    sdd->skinData.scaleY   = getJsonFloat(dic, A_SCALE_Y, 1.0f);
+                    sdd->skinData.skewX    = getJsonFloat(dic, A_SKEW_X, 1.0f);
+                    sdd->skinData.skewY    = getJsonFloat(dic, A_SKEW_Y, 1.0f);
 
                     sdd->skinData.x *= dataInfo->contentScale;
                     sdd->skinData.y *= dataInfo->contentScale;
                 }
+                break;
             }
         }
     }
@@ -1341,19 +1346,15 @@ DisplayData* DataReaderHelper::decodeBoneDisplay(const rapidjson::Value& json, D
     {
         displayData = new ArmatureDisplayData();
 
-        const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-        if (name != nullptr)
-        {
-            ((ArmatureDisplayData*)displayData)->displayName = name;
-        }
+        getJsonString(json, A_NAME, ((ArmatureDisplayData*)displayData)->displayName);
     }
     break;
     case CS_DISPLAY_PARTICLE:
     {
         displayData = new ParticleDisplayData();
 
-        const char* plist = DICTOOL->getStringValue_json(json, A_PLIST);
-        if (plist != nullptr)
+        std::string plist;
+        if (getJsonString(json, A_PLIST, plist))
         {
             if (dataInfo->asyncStruct)
             {
@@ -1378,84 +1379,64 @@ DisplayData* DataReaderHelper::decodeBoneDisplay(const rapidjson::Value& json, D
     return displayData;
 }
 
-AnimationData* DataReaderHelper::decodeAnimation(const rapidjson::Value& json, DataInfo* dataInfo)
+AnimationData* DataReaderHelper::decodeAnimation(JsonObject& json, DataInfo* dataInfo)
 {
     AnimationData* aniData = new AnimationData();
 
-    const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-    if (name != nullptr)
-    {
-        aniData->name = name;
-    }
-
-    int length = DICTOOL->getArrayCount_json(json, MOVEMENT_DATA);
+    getJsonString(json, A_NAME, aniData->name);
 
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, MOVEMENT_DATA, i);
-        MovementData* movementData  = decodeMovement(dic, dataInfo);
+    forEachJsonObject(json, MOVEMENT_DATA, [aniData, dataInfo](JsonObject& dic) {
+        MovementData* movementData = decodeMovement(dic, dataInfo);
         aniData->addMovement(movementData);
         movementData->release();
-    }
+    });
 
     return aniData;
 }
 
-MovementData* DataReaderHelper::decodeMovement(const rapidjson::Value& json, DataInfo* dataInfo)
+MovementData* DataReaderHelper::decodeMovement(JsonObject& json, DataInfo* dataInfo)
 {
     MovementData* movementData = new MovementData();
 
-    movementData->loop          = DICTOOL->getBooleanValue_json(json, A_LOOP, true);
-    movementData->durationTween = DICTOOL->getIntValue_json(json, A_DURATION_TWEEN, 0);
-    movementData->durationTo    = DICTOOL->getIntValue_json(json, A_DURATION_TO, 0);
-    movementData->duration      = DICTOOL->getIntValue_json(json, A_DURATION, 0);
-    if (!DICTOOL->checkObjectExist_json(json, A_DURATION))
+    movementData->loop          = getJsonBool(json, A_LOOP, true);
+    movementData->durationTween = getJsonInt(json, A_DURATION_TWEEN, 0);
+    movementData->durationTo    = getJsonInt(json, A_DURATION_TO, 0);
+
+    double duration;
+    if (json[A_DURATION].get_double().get(duration) != simdjson::SUCCESS)
     {
-        movementData->scale = 1.0f;
+        movementData->duration = 0;
+        movementData->scale    = 1.0f;
     }
     else
     {
-        movementData->scale = DICTOOL->getFloatValue_json(json, A_MOVEMENT_SCALE, 1.0f);
+        movementData->duration = static_cast<int>(duration);
+        movementData->scale    = getJsonFloat(json, A_MOVEMENT_SCALE, 1.0f);
     }
-    movementData->tweenEasing =
-        (TweenType)(DICTOOL->getIntValue_json(json, A_TWEEN_EASING, ax::tweenfunc::Linear));
+    movementData->tweenEasing = (TweenType)(getJsonInt(json, A_TWEEN_EASING, ax::tweenfunc::Linear));
 
-    const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-    if (name != nullptr)
-    {
-        movementData->name = name;
-    }
+    getJsonString(json, A_NAME, movementData->name);
 
-    int length = DICTOOL->getArrayCount_json(json, MOVEMENT_BONE_DATA);
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic        = DICTOOL->getSubDictionary_json(json, MOVEMENT_BONE_DATA, i);
+    forEachJsonObject(json, MOVEMENT_BONE_DATA, [movementData, dataInfo](JsonObject& dic) {
         MovementBoneData* movementBoneData = decodeMovementBone(dic, dataInfo);
         movementData->addMovementBoneData(movementBoneData);
         movementBoneData->release();
-    }
+    });
 
     return movementData;
 }
 
-MovementBoneData* DataReaderHelper::decodeMovementBone(const rapidjson::Value& json, DataInfo* dataInfo)
+MovementBoneData* DataReaderHelper::decodeMovementBone(JsonObject& json, DataInfo* dataInfo)
 {
     MovementBoneData* movementBoneData = new MovementBoneData();
     movementBoneData->init();
 
-    movementBoneData->delay = DICTOOL->getFloatValue_json(json, A_MOVEMENT_DELAY);
+    movementBoneData->delay = getJsonFloat(json, A_MOVEMENT_DELAY);
 
-    const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-    if (name != nullptr)
-    {
-        movementBoneData->name = name;
-    }
+    getJsonString(json, A_NAME, movementBoneData->name);
 
-    rapidjson::SizeType length = DICTOOL->getArrayCount_json(json, FRAME_DATA);
-    for (rapidjson::SizeType i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, FRAME_DATA, i);
-        FrameData* frameData        = decodeFrame(dic, dataInfo);
+    forEachJsonObject(json, FRAME_DATA, [movementBoneData, dataInfo](JsonObject& dic) {
+        FrameData* frameData = decodeFrame(dic, dataInfo);
 
         movementBoneData->addFrameData(frameData);
         frameData->release();
@@ -1465,7 +1446,7 @@ MovementBoneData* DataReaderHelper::decodeMovementBone(const rapidjson::Value& j
             frameData->frameID = movementBoneData->duration;
             movementBoneData->duration += frameData->duration;
         }
-    }
+    });
 
     if (dataInfo->cocoStudioVersion < VERSION_CHANGE_ROTATION_RANGE)
     {
@@ -1509,140 +1490,119 @@ MovementBoneData* DataReaderHelper::decodeMovementBone(const rapidjson::Value& j
     return movementBoneData;
 }
 
-FrameData* DataReaderHelper::decodeFrame(const rapidjson::Value& json, DataInfo* dataInfo)
+FrameData* DataReaderHelper::decodeFrame(JsonObject& json, DataInfo* dataInfo)
 {
     FrameData* frameData = new FrameData();
 
     decodeNode(frameData, json, dataInfo);
 
-    frameData->tweenEasing   = (TweenType)(DICTOOL->getIntValue_json(json, A_TWEEN_EASING, ax::tweenfunc::Linear));
-    frameData->displayIndex  = DICTOOL->getIntValue_json(json, A_DISPLAY_INDEX);
+    frameData->tweenEasing   = (TweenType)(getJsonInt(json, A_TWEEN_EASING, ax::tweenfunc::Linear));
+    frameData->displayIndex  = getJsonInt(json, A_DISPLAY_INDEX);
     frameData->blendFunc.src = utils::toBackendBlendFactor(
-        DICTOOL->getIntValue_json(json, A_BLEND_SRC, utils::toGLBlendFactor(BlendFunc::ALPHA_PREMULTIPLIED.src)));
+        getJsonInt(json, A_BLEND_SRC, utils::toGLBlendFactor(BlendFunc::ALPHA_PREMULTIPLIED.src)));
     frameData->blendFunc.dst = utils::toBackendBlendFactor(
-        DICTOOL->getIntValue_json(json, A_BLEND_DST, utils::toGLBlendFactor(BlendFunc::ALPHA_PREMULTIPLIED.dst)));
-    frameData->isTween = DICTOOL->getBooleanValue_json(json, A_TWEEN_FRAME, true);
+        getJsonInt(json, A_BLEND_DST, utils::toGLBlendFactor(BlendFunc::ALPHA_PREMULTIPLIED.dst)));
+    frameData->isTween = getJsonBool(json, A_TWEEN_FRAME, true);
 
-    const char* event = DICTOOL->getStringValue_json(json, A_EVENT);
-    if (event != nullptr)
-    {
-        frameData->strEvent = event;
-    }
+    getJsonString(json, A_EVENT, frameData->strEvent);
 
     if (dataInfo->cocoStudioVersion < VERSION_COMBINED)
     {
-        frameData->duration = DICTOOL->getIntValue_json(json, A_DURATION, 1);
+        frameData->duration = getJsonInt(json, A_DURATION, 1);
     }
     else
     {
-        frameData->frameID = DICTOOL->getIntValue_json(json, A_FRAME_INDEX);
+        frameData->frameID = getJsonInt(json, A_FRAME_INDEX);
     }
 
-    int length = DICTOOL->getArrayCount_json(json, A_EASING_PARAM);
-    if (length != 0)
+    simdjson::ondemand::array easingParams;
+    if (json[A_EASING_PARAM].get_array().get(easingParams) == simdjson::SUCCESS)
     {
-        frameData->easingParams      = new float[length];
-        frameData->easingParamNumber = length;
+        std::vector<float> params;
+        for (auto item : easingParams)
+        {
+            double value;
+            params.emplace_back(item.get_double().get(value) == simdjson::SUCCESS ? static_cast<float>(value) : 0.0f);
+        }
 
-        for (int i = 0; i < length; i++)
+        if (!params.empty())
         {
-            frameData->easingParams[i] = DICTOOL->getFloatValueFromArray_json(json, A_EASING_PARAM, i);
+            frameData->easingParams      = new float[params.size()];
+            frameData->easingParamNumber = static_cast<int>(params.size());
+            std::copy(params.begin(), params.end(), frameData->easingParams);
         }
     }
 
     return frameData;
 }
 
-TextureData* DataReaderHelper::decodeTexture(const rapidjson::Value& json)
+TextureData* DataReaderHelper::decodeTexture(JsonObject& json)
 {
     TextureData* textureData = new TextureData();
     textureData->init();
 
-    const char* name = DICTOOL->getStringValue_json(json, A_NAME);
-    if (name != nullptr)
-    {
-        textureData->name = name;
-    }
+    getJsonString(json, A_NAME, textureData->name);
 
-    textureData->width  = DICTOOL->getFloatValue_json(json, A_WIDTH);
-    textureData->height = DICTOOL->getFloatValue_json(json, A_HEIGHT);
-    textureData->pivotX = DICTOOL->getFloatValue_json(json, A_PIVOT_X);
-    textureData->pivotY = DICTOOL->getFloatValue_json(json, A_PIVOT_Y);
+    textureData->width  = getJsonFloat(json, A_WIDTH);
+    textureData->height = getJsonFloat(json, A_HEIGHT);
+    textureData->pivotX = getJsonFloat(json, A_PIVOT_X);
+    textureData->pivotY = getJsonFloat(json, A_PIVOT_Y);
 
-    int length = DICTOOL->getArrayCount_json(json, CONTOUR_DATA);
-    for (int i = 0; i < length; i++)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, CONTOUR_DATA, i);
-        ContourData* contourData    = decodeContour(dic);
+    forEachJsonObject(json, CONTOUR_DATA, [textureData](JsonObject& dic) {
+        ContourData* contourData = decodeContour(dic);
         textureData->contourDataList.pushBack(contourData);
         contourData->release();
-    }
+    });
 
     return textureData;
 }
 
-ContourData* DataReaderHelper::decodeContour(const rapidjson::Value& json)
+ContourData* DataReaderHelper::decodeContour(JsonObject& json)
 {
     ContourData* contourData = new ContourData();
     contourData->init();
 
-    int length = DICTOOL->getArrayCount_json(json, VERTEX_POINT);
-    for (int i = length - 1; i >= 0; i--)
-    {
-        const rapidjson::Value& dic = DICTOOL->getSubDictionary_json(json, VERTEX_POINT, i);
-
+    forEachJsonObject(json, VERTEX_POINT, [contourData](JsonObject& dic) {
         Vec2 vertex;
 
-        vertex.x = DICTOOL->getFloatValue_json(dic, A_X);
-        vertex.y = DICTOOL->getFloatValue_json(dic, A_Y);
+        vertex.x = getJsonFloat(dic, A_X);
+        vertex.y = getJsonFloat(dic, A_Y);
 
         contourData->vertexList.emplace_back(vertex);
-    }
+    });
+
+    // the vertices are stored in the reverse order
+    std::reverse(contourData->vertexList.begin(), contourData->vertexList.end());
 
     return contourData;
 }
 
-void DataReaderHelper::decodeNode(BaseData* node, const rapidjson::Value& json, DataInfo* dataInfo)
+void DataReaderHelper::decodeNode(BaseData* node, JsonObject& json, DataInfo* dataInfo)
 {
-    node->x = DICTOOL->getFloatValue_json(json, A_X) * s_PositionReadScale;
-    node->y = DICTOOL->getFloatValue_json(json, A_Y) * s_PositionReadScale;
+    node->x = getJsonFloat(json, A_X) * s_PositionReadScale;
+    node->y = getJsonFloat(json, A_Y) * s_PositionReadScale;
 
     node->x *= dataInfo->contentScale;
     node->y *= dataInfo->contentScale;
 
-    node->zOrder = DICTOOL->getIntValue_json(json, A_Z);
+    node->zOrder = getJsonInt(json, A_Z);
 
-    node->skewX  = DICTOOL->getFloatValue_json(json, A_SKEW_X);
-    node->skewY  = DICTOOL->getFloatValue_json(json, A_SKEW_Y);
-    node->scaleX = DICTOOL->getFloatValue_json(json, A_SCALE_X, 1.0f);
-    node->scaleY = DICTOOL->getFloatValue_json(json, A_SCALE_Y, 1.0f);
+    node->skewX  = getJsonFloat(json, A_SKEW_X);
+    node->skewY  = getJsonFloat(json, A_SKEW_Y);
+    node->scaleX = getJsonFloat(json, A_SCALE_X, 1.0f);
+    node->scaleY = getJsonFloat(json, A_SCALE_Y, 1.0f);
 
-    if (dataInfo->cocoStudioVersion < VERSION_COLOR_READING)
+    // the nodes of the files older than VERSION_COLOR_READING have no color
+    JsonObject colorDic;
+    if (dataInfo->cocoStudioVersion >= VERSION_COLOR_READING &&
+        json[COLOR_INFO].get_object().get(colorDic) == simdjson::SUCCESS)
     {
-        if (DICTOOL->checkObjectExist_json(json, 0))
-        {
-            const rapidjson::Value& colorDic = DICTOOL->getSubDictionary_json(json, 0);
-            node->a                          = DICTOOL->getIntValue_json(colorDic, A_ALPHA, 255);
-            node->r                          = DICTOOL->getIntValue_json(colorDic, A_RED, 255);
-            node->g                          = DICTOOL->getIntValue_json(colorDic, A_GREEN, 255);
-            node->b                          = DICTOOL->getIntValue_json(colorDic, A_BLUE, 255);
+        node->a = getJsonInt(colorDic, A_ALPHA, 255);
+        node->r = getJsonInt(colorDic, A_RED, 255);
+        node->g = getJsonInt(colorDic, A_GREEN, 255);
+        node->b = getJsonInt(colorDic, A_BLUE, 255);
 
-            node->isUseColorInfo = true;
-        }
-    }
-    else
-    {
-        if (DICTOOL->checkObjectExist_json(json, COLOR_INFO))
-        {
-            const rapidjson::Value& colorDic =
-                DICTOOL->getSubDictionary_json(json, COLOR_INFO);  // json.getSubDictionary(COLOR_INFO);
-            node->a = DICTOOL->getIntValue_json(colorDic, A_ALPHA, 255);
-            node->r = DICTOOL->getIntValue_json(colorDic, A_RED, 255);
-            node->g = DICTOOL->getIntValue_json(colorDic, A_GREEN, 255);
-            node->b = DICTOOL->getIntValue_json(colorDic, A_BLUE, 255);
-
-            node->isUseColorInfo = true;
-        }
+        node->isUseColorInfo = true;
     }
 }
 
@@ -37,6 +37,7 @@ THE SOFTWARE.
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/document.h"
 
+#include "simdjson/simdjson.h"
 
 #include <string>
 #include <queue>
@@ -162,22 +163,28 @@ public:
     static ContourData* decodeContour(pugi::xml_node& contourXML, DataInfo* dataInfo);
 
 public:
+    using JsonObject = simdjson::ondemand::object;
+
+    /**
+     * Decode the armatures, animations and textures of a CocoStudio json file with the simdjson on-demand parser,
+     * the objects are decoded while the file is parsed.
+     */
     static void addDataFromJsonCache(std::string_view fileContent, DataInfo* dataInfo = nullptr);
 
-    static ArmatureData* decodeArmature(const rapidjson::Value& json, DataInfo* dataInfo);
-    static BoneData* decodeBone(const rapidjson::Value& json, DataInfo* dataInfo);
-    static DisplayData* decodeBoneDisplay(const rapidjson::Value& json, DataInfo* dataInfo);
+    static ArmatureData* decodeArmature(JsonObject& json, DataInfo* dataInfo);
+    static BoneData* decodeBone(JsonObject& json, DataInfo* dataInfo);
+    static DisplayData* decodeBoneDisplay(JsonObject& json, DataInfo* dataInfo);
 
-    static AnimationData* decodeAnimation(const rapidjson::Value& json, DataInfo* dataInfo);
-    static MovementData* decodeMovement(const rapidjson::Value& json, DataInfo* dataInfo);
-    static MovementBoneData* decodeMovementBone(const rapidjson::Value& json, DataInfo* dataInfo);
-    static FrameData* decodeFrame(const rapidjson::Value& json, DataInfo* dataInfo);
+    static AnimationData* decodeAnimation(JsonObject& json, DataInfo* dataInfo);
+    static MovementData* decodeMovement(JsonObject& json, DataInfo* dataInfo);
+    static MovementBoneData* decodeMovementBone(JsonObject& json, DataInfo* dataInfo);
+    static FrameData* decodeFrame(JsonObject& json, DataInfo* dataInfo);
 
-    static TextureData* decodeTexture(const rapidjson::Value& json);
+    static TextureData* decodeTexture(JsonObject& json);
 
-    static ContourData* decodeContour(const rapidjson::Value& json);
+    static ContourData* decodeContour(JsonObject& json);
 
-    static void decodeNode(BaseData* node, const rapidjson::Value& json, DataInfo* dataInfo);
+    static void decodeNode(BaseData* node, JsonObject& json, DataInfo* dataInfo);
 
     // for binary decode
 public:
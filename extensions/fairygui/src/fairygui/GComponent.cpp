@@ -21,6 +21,7 @@ _apexIndex(0),
 _boundsChanged(false),
 _trackBounds(false),
 _opaque(false),
+_fairyBatching(false),
 _sortingChildCount(0),
 _applyingController(nullptr),
 _buildingDisplayList(false),
@@ -42,6 +43,7 @@ GComponent::~GComponent()
     AX_SAFE_DELETE(_hitArea);
     CALL_LATER_CANCEL(GComponent, doUpdateBounds);
     CALL_LATER_CANCEL(GComponent, buildNativeDisplayList);
+    CALL_LATER_CANCEL(GComponent, doFairyBatching);
 }
 
 void GComponent::handleInit()
@@ -328,6 +330,7 @@ int GComponent::moveChild(GObject* child, int oldIndex, int index)
             CALL_LATER(GComponent, buildNativeDisplayList);
 
         setBoundsChangedFlag();
+        setFairyBatchingDirty();
     }
 
     return index;
@@ -619,6 +622,8 @@ void GComponent::setViewHeight(float value)
 
 void GComponent::setBoundsChangedFlag()
 {
+    setFairyBatchingDirty();
+
     if (_scrollPane == nullptr && !_trackBounds)
         return;
 
@@ -749,6 +754,8 @@ void GComponent::childStateChanged(GObject* child)
             }
         }
     }
+
+    setFairyBatchingDirty();
 }
 
 void GComponent::childSortingOrderChanged(GObject* child, int oldValue, int newValue)
@@ -829,6 +836,117 @@ void GComponent::buildNativeDisplayList()
     }
     break;
     }
+
+    setFairyBatchingDirty();
+}
+
+int GComponent::getRenderOrder(int index) const
+{
+    int cnt = (int)_children.size();
+    switch (_childrenRenderOrder)
+    {
+    case ChildrenRenderOrder::DESCENT:
+        return cnt - 1 - index;
+    case ChildrenRenderOrder::ARCH:
+    {
+        int ai = MIN(_apexIndex, cnt);
+        return index < ai ? index : ai + cnt - 1 - index;
+    }
+    default:
+        return index;
+    }
+}
+
+void GComponent::setFairyBatching(bool value)
+{
+    if (_fairyBatching == value)
+        return;
+
+    _fairyBatching = value;
+    if (_fairyBatching)
+    {
+        CALL_LATER(GComponent, doFairyBatching);
+        return;
+    }
+
+    CALL_LATER_CANCEL(GComponent, doFairyBatching);
+    int cnt = (int)_children.size();
+    for (int i = 0; i < cnt; i++)
+    {
+        GObject* child = _children.at(i);
+        if (child->_displayObject != nullptr && child->_displayObject->getParent() == _container)
+            child->_displayObject->setLocalZOrder(getRenderOrder(i));
+    }
+}
+
+void GComponent::setFairyBatchingDirty()
+{
+    if (_fairyBatching)
+        CALL_LATER(GComponent, doFairyBatching);
+}
+
+static Texture2D* getBatchingTexture(Node* node)
+{
+    if (auto sprite = dynamic_cast<Sprite*>(node))
+        return sprite->getTexture();
+    if (auto label = dynamic_cast<Label*>(node))
+    {
+        auto atlas = label->getFontAtlas();
+        return atlas != nullptr ? atlas->getTexture(0) : nullptr;
+    }
+    return nullptr;
+}
+
+void GComponent::doFairyBatching()
+{
+    struct BatchingItem
+    {
+        int renderOrder;
+        Node* node;
+        Texture2D* texture;
+        Rect bounds;
+    };
+
+    std::vector<BatchingItem> items;
+    int cnt = (int)_children.size();
+    items.reserve(cnt);
+    for (int i = 0; i < cnt; i++)
+    {
+        GObject* child = _children.at(i);
+        Node* node     = child->_displayObject;
+        if (node != nullptr && node->getParent() == _container)
+            items.push_back({getRenderOrder(i), node, getBatchingTexture(node), node->getBoundingBox()});
+    }
+    std::sort(items.begin(), items.end(),
+              [](const BatchingItem& a, const BatchingItem& b) { return a.renderOrder < b.renderOrder; });
+
+    // a child moves down to the last child of its texture, unless it overlaps a child drawn between them
+    std::vector<BatchingItem> batched;
+    batched.reserve(items.size());
+    for (auto& item : items)
+    {
+        size_t insertPos = batched.size();
+        if (item.texture != nullptr)
+        {
+            for (size_t j = batched.size(); j-- > 0;)
+            {
+                if (batched[j].texture == item.texture)
+                {
+                    insertPos = j + 1;
+                    break;
+                }
+                if (batched[j].bounds.intersectsRect(item.bounds))
+                    break;
+            }
+        }
+        batched.insert(batched.begin() + insertPos, item);
+    }
+
+    for (size_t i = 0; i < batched.size(); i++)
+    {
+        if (batched[i].node->getLocalZOrder() != (int)i)
+            batched[i].node->setLocalZOrder((int)i);
+    }
 }
 
 ax::Vec2 GComponent::getSnappingPosition(const ax::Vec2& pt)
@@ -70,6 +70,12 @@ public:
     int getApexIndex() const { return _apexIndex; }
     void setApexIndex(int value);
 
+    // Draws the children of the same texture one after another when the children between them don't overlap them,
+    // so they are batched, like the fairyBatching of the other FairyGUI runtimes. The order is updated in the next
+    // frame after the children changed.
+    bool isFairyBatching() const { return _fairyBatching; }
+    void setFairyBatching(bool value);
+
     ax::Node* getMask() const;
     void setMask(ax::Node* value, bool inverted = false);
 
@@ -134,11 +140,15 @@ protected:
 private:
     int getInsertPosForSortingChild(GObject* target);
     int moveChild(GObject* child, int oldIndex, int index);
+    int getRenderOrder(int index) const;
+    void setFairyBatchingDirty();
 
     CALL_LATER_FUNC(GComponent, doUpdateBounds);
     CALL_LATER_FUNC(GComponent, buildNativeDisplayList);
+    CALL_LATER_FUNC(GComponent, doFairyBatching);
 
     bool _opaque;
+    bool _fairyBatching;
     int _sortingChildCount;
     GController* _applyingController;
 
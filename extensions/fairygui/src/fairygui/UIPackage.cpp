@@ -95,6 +95,84 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
     if (it != _packageInstById.end())
         return it->second;
 
+    createEmptyTexture();
+
+    UIPackage* pkg = loadFromFile(assetPath);
+    if (pkg != nullptr)
+        registerPackage(pkg, assetPath);
+
+    return pkg;
+}
+
+void UIPackage::addPackageAsync(const string& assetPath, const std::function<void(UIPackage*)>& callback)
+{
+    auto it = _packageInstById.find(assetPath);
+    if (it != _packageInstById.end())
+    {
+        if (callback)
+            callback(it->second);
+        return;
+    }
+
+    createEmptyTexture();
+
+    struct AtlasImages
+    {
+        PackageItem* item;
+        Image* image;
+        Image* alphaImage;
+    };
+    struct AsyncLoad
+    {
+        UIPackage* pkg = nullptr;
+        std::vector<AtlasImages> atlases;
+    };
+    auto load = std::make_shared<AsyncLoad>();
+
+    Director::getInstance()->getJobSystem()->enqueue(
+        [load, assetPath]() {
+            load->pkg = loadFromFile(assetPath);
+            if (load->pkg == nullptr)
+                return;
+
+            for (auto item : load->pkg->_items)
+            {
+                if (item->type == PackageItemType::ATLAS)
+                {
+                    Image* alphaImage = nullptr;
+                    Image* image      = loadAtlasImages(item, &alphaImage);
+                    load->atlases.push_back({item, image, alphaImage});
+                }
+            }
+        },
+        [load, assetPath, callback]() {
+            UIPackage* pkg = load->pkg;
+            auto it        = _packageInstById.find(assetPath);
+            if (it != _packageInstById.end())
+            {
+                // added while it was loading
+                for (auto& atlas : load->atlases)
+                {
+                    delete atlas.image;
+                    delete atlas.alphaImage;
+                }
+                delete pkg;
+                pkg = it->second;
+            }
+            else if (pkg != nullptr)
+            {
+                for (auto& atlas : load->atlases)
+                    setAtlasTexture(atlas.item, atlas.image, atlas.alphaImage);
+                registerPackage(pkg, assetPath);
+            }
+
+            if (callback)
+                callback(pkg);
+        });
+}
+
+void UIPackage::createEmptyTexture()
+{
     if (_emptyTexture == nullptr)
     {
         Image* emptyImage = new Image();
@@ -103,7 +181,10 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
         _emptyTexture->initWithImage(emptyImage);
         delete emptyImage;
     }
+}
 
+UIPackage* UIPackage::loadFromFile(const string& assetPath)
+{
     Data data;
 
     if (FileUtils::getInstance()->getContents(assetPath + ".fui", &data) != FileUtils::Status::OK)
@@ -124,12 +205,15 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
         return nullptr;
     }
 
+    return pkg;
+}
+
+void UIPackage::registerPackage(UIPackage* pkg, const string& assetPath)
+{
     _packageInstById[pkg->getId()] = pkg;
     _packageInstByName[pkg->getName()] = pkg;
     _packageInstById[assetPath] = pkg;
     _packageList.push_back(pkg);
-
-    return pkg;
 }
 
 void UIPackage::removePackage(const string& packageIdOrName)
@@ -602,30 +686,32 @@ void* UIPackage::getItemAsset(PackageItem* item)
 
 void UIPackage::loadAtlas(PackageItem* item)
 {
+    Image* alphaImage = nullptr;
+    Image* image      = loadAtlasImages(item, &alphaImage);
+    setAtlasTexture(item, image, alphaImage);
+}
+
+Image* UIPackage::loadAtlasImages(PackageItem* item, Image** alphaImage)
+{
+    *alphaImage = nullptr;
+
     Image* image = new Image();
 #if COCOS2D_VERSION < 0x00031702
     Image::setPNGPremultipliedAlphaEnabled(false);
 #endif
     if (!image->initWithImageFile(item->file))
     {
-        item->texture = _emptyTexture;
-        _emptyTexture->retain();
         delete image;
 #if COCOS2D_VERSION < 0x00031702
         Image::setPNGPremultipliedAlphaEnabled(true);
 #endif
-        AXLOGW("FairyGUI: texture '{}' not found in {}", item->file, _name);
-        return;
+        AXLOGW("FairyGUI: texture '{}' not found in {}", item->file, item->owner->_name);
+        return nullptr;
     }
 #if COCOS2D_VERSION < 0x00031702
     Image::setPNGPremultipliedAlphaEnabled(true);
 #endif
 
-    Texture2D* tex = new Texture2D();
-    tex->initWithImage(image);
-    item->texture = tex;
-    delete image;
-
     string alphaFilePath;
     string ext = FileUtils::getPathExtension(item->file);
     size_t pos = item->file.find_last_of('.');
@@ -637,23 +723,43 @@ void UIPackage::loadAtlas(PackageItem* item)
     bool hasAlphaTexture = ToolSet::isFileExist(alphaFilePath);
     if (hasAlphaTexture)
     {
-        image = new Image();
-        if (!image->initWithImageFile(alphaFilePath))
+        *alphaImage = new Image();
+        if (!(*alphaImage)->initWithImageFile(alphaFilePath))
         {
-            delete image;
-            return;
+            delete *alphaImage;
+            *alphaImage = nullptr;
         }
+    }
 
+    return image;
+}
+
+void UIPackage::setAtlasTexture(PackageItem* item, Image* image, Image* alphaImage)
+{
+    if (image == nullptr)
+    {
+        item->texture = _emptyTexture;
+        _emptyTexture->retain();
+        return;
+    }
+
+    Texture2D* tex = new Texture2D();
+    tex->initWithImage(image);
+    item->texture = tex;
+    delete image;
+
+    if (alphaImage != nullptr)
+    {
 #if defined(AX_VERSION)
-        if(image->getFileType() == Image::Format::ETC1)
-            tex->updateWithImage(image, Texture2D::getDefaultAlphaPixelFormat(), 1);
+        if(alphaImage->getFileType() == Image::Format::ETC1)
+            tex->updateWithImage(alphaImage, Texture2D::getDefaultAlphaPixelFormat(), 1);
 #else
         tex = new Texture2D();
-        tex->initWithImage(image);
+        tex->initWithImage(alphaImage);
         item->texture->setAlphaTexture(tex);
         tex->release();
 #endif
-        delete image;
+        delete alphaImage;
     }
 }
 
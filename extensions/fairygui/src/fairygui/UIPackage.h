@@ -20,6 +20,9 @@ public:
     static UIPackage* getById(const std::string& id);
     static UIPackage* getByName(const std::string& name);
     static UIPackage* addPackage(const std::string& descFilePath);
+    // Loads the package and the images of its atlases on a worker, the textures are created on the axmol thread.
+    // The callback is called on the axmol thread with the package, or nullptr when it can't be loaded.
+    static void addPackageAsync(const std::string& descFilePath, const std::function<void(UIPackage*)>& callback);
     static void removePackage(const std::string& packageIdOrName);
     static void removeAllPackages();
     static GObject* createObject(const std::string& pkgName, const std::string& resName);
@@ -47,8 +50,16 @@ public:
     static const std::string URL_PREFIX;
 
 private:
+    static void createEmptyTexture();
+    // reads and parses a package, it can be called from any thread
+    static UIPackage* loadFromFile(const std::string& assetPath);
+    static void registerPackage(UIPackage* pkg, const std::string& assetPath);
+
     bool loadPackage(ByteBuffer* buffer);
     void loadAtlas(PackageItem* item);
+    // decodes the image of an atlas and its alpha image, it can be called from any thread
+    static ax::Image* loadAtlasImages(PackageItem* item, ax::Image** alphaImage);
+    static void setAtlasTexture(PackageItem* item, ax::Image* image, ax::Image* alphaImage);
     AtlasSprite* getSprite(const std::string& spriteId);
     ax::SpriteFrame* createSpriteTexture(AtlasSprite* sprite);
     void loadImage(PackageItem* item);
@@ -40,6 +40,11 @@ int axlua_loader(lua_State* L)
 {
     auto relativePath = axlua_tostr(L, 1);
 
+    // the precompiled chunks first, they're found without searching the files
+    LuaStack* stack = LuaEngine::getInstance()->getLuaStack();
+    if (stack->luaLoadChunkFromBundles(L, relativePath))
+        return 1;
+
     //  convert any '.' to '/'
     std::replace(relativePath.begin(), relativePath.end(), '.', '/');
 
@@ -87,7 +92,6 @@ int axlua_loader(lua_State* L)
     int nret = chunk.getSize() > 0 ? 1 : 0;
     if (nret)
     {
-        LuaStack* stack = LuaEngine::getInstance()->getLuaStack();
         resolvedPath.insert(resolvedPath.begin(), '@');  // lua standard, add file chunck mark '@'
         stack->luaLoadBuffer(L, reinterpret_cast<const char*>(chunk.getBytes()), static_cast<int>(chunk.getSize()),
                              resolvedPath.c_str());
@@ -343,6 +343,31 @@ bool luaval_to_std_string_view(lua_State* L, int lo, cxx17::string_view* outValu
     return ok;
 }
 
+// The vectors of vec2_to_luaval and vec2_new keep their components in the array part, their named fields go through
+// the __index metamethod, so they are read raw. Returns false for the other tables.
+static bool luaval_to_floats_raw(lua_State* L, int lo, float* outValues, int count)
+{
+    if (lo < 0 && lo > LUA_REGISTRYINDEX)
+        lo = lua_gettop(L) + lo + 1;
+
+    lua_rawgeti(L, lo, 1);
+    if (lua_type(L, -1) != LUA_TNUMBER)
+    {
+        lua_pop(L, 1);
+        return false;
+    }
+    outValues[0] = (float)lua_tonumber(L, -1);
+    lua_pop(L, 1);
+
+    for (int i = 1; i < count; ++i)
+    {
+        lua_rawgeti(L, lo, i + 1);
+        outValues[i] = lua_isnil(L, -1) ? 0.0f : (float)lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
+    return true;
+}
+
 bool luaval_to_vec2(lua_State* L, int lo, ax::Vec2* outValue, const char* funcName)
 {
     if (nullptr == L || nullptr == outValue)
@@ -363,7 +388,7 @@ bool luaval_to_vec2(lua_State* L, int lo, ax::Vec2* outValue, const char* funcNa
     const auto objlen = lua_objlen(L, lo);
     assert(objlen != 4);
 
-    if (ok)
+    if (ok && !luaval_to_floats_raw(L, lo, &outValue->x, 2))
     {
         lua_pushstring(L, "x");
         lua_gettable(L, lo);
@@ -408,7 +433,7 @@ bool luaval_to_vec3(lua_State* L, int lo, ax::Vec3* outValue, const char* funcNa
         ok = false;
     }
 
-    if (ok)
+    if (ok && !luaval_to_floats_raw(L, lo, &outValue->x, 3))
     {
         lua_pushstring(L, "x");
         lua_gettable(L, lo);
@@ -444,7 +469,7 @@ bool luaval_to_vec4(lua_State* L, int lo, ax::Vec4* outValue, const char* funcNa
         ok = false;
     }
 
-    if (ok)
+    if (ok && !luaval_to_floats_raw(L, lo, &outValue->x, 4))
     {
         lua_pushstring(L, "x");
         lua_gettable(L, lo);
@@ -608,7 +633,7 @@ bool luaval_to_size(lua_State* L, int lo, Size* outValue, const char* funcName)
         ok = false;
     }
 
-    if (ok)
+    if (ok && !luaval_to_floats_raw(L, lo, &outValue->width, 2))
     {
         lua_pushstring(L, "width"); /* L: paramStack key */
         lua_gettable(L, lo);        /* L: paramStack paramStack[lo][key] */
@@ -2339,7 +2364,7 @@ void size_to_luaval(lua_State* L, const Size& sz)
 {
     if (NULL == L)
         return;
-    lua_newtable(L);                          /* L: table */
+    lua_createtable(L, 0, 2);                 /* L: table */
     lua_pushstring(L, "width");               /* L: table key */
     lua_pushnumber(L, (lua_Number)sz.width);  /* L: table key value*/
     lua_rawset(L, -3);                        /* table[key] = value, L: table */
@@ -2352,7 +2377,7 @@ void rect_to_luaval(lua_State* L, const Rect& rt)
 {
     if (NULL == L)
         return;
-    lua_newtable(L);                               /* L: table */
+    lua_createtable(L, 0, 4);                      /* L: table */
     lua_pushstring(L, "x");                        /* L: table key */
     lua_pushnumber(L, (lua_Number)rt.origin.x);    /* L: table key value*/
     lua_rawset(L, -3);                             /* table[key] = value, L: table */
@@ -2371,7 +2396,7 @@ void color4b_to_luaval(lua_State* L, const Color4B& color)
 {
     if (NULL == L)
         return;
-    lua_newtable(L);                     /* L: table */
+    lua_createtable(L, 0, 4);            /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
     lua_rawset(L, -3);                   /* table[key] = value, L: table */
@@ -2390,7 +2415,7 @@ void color4f_to_luaval(lua_State* L, const Color4F& color)
 {
     if (NULL == L)
         return;
-    lua_newtable(L);                     /* L: table */
+    lua_createtable(L, 0, 4);            /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
     lua_rawset(L, -3);                   /* table[key] = value, L: table */
@@ -2414,7 +2439,7 @@ void color3b_to_luaval(lua_State* L, const Color3B& color)
 {
     if (NULL == L)
         return;
-    lua_newtable(L);                     /* L: table */
+    lua_createtable(L, 0, 3);            /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
     lua_rawset(L, -3);                   /* table[key] = value, L: table */
@@ -2431,7 +2456,7 @@ void affinetransform_to_luaval(lua_State* L, const AffineTransform& inValue)
     if (NULL == L)
         return;
 
-    lua_newtable(L);                           /* L: table */
+    lua_createtable(L, 0, 6);                  /* L: table */
     lua_pushstring(L, "a");                    /* L: table key */
     lua_pushnumber(L, (lua_Number)inValue.a);  /* L: table key value*/
     lua_rawset(L, -3);                         /* table[key] = value, L: table */
@@ -2912,7 +2937,7 @@ void quaternion_to_luaval(lua_State* L, const ax::Quaternion& inValue)
     if (NULL == L)
         return;
 
-    lua_newtable(L);                          /* L: table */
+    lua_createtable(L, 0, 4);                 /* L: table */
     lua_pushstring(L, "x");                   /* L: table key */
     lua_pushnumber(L, (lua_Number)inValue.x); /* L: table key value*/
     lua_rawset(L, -3);                        /* table[key] = value, L: table */
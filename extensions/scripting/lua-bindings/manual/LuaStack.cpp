@@ -54,6 +54,8 @@ extern "C" {
 #include "lua-bindings/auto/axlua_backend_auto.hpp"
 #include "base/ZipUtils.h"
 #include "platform/FileUtils.h"
+#include "xxhash/xxhash.h"
+#include "mio/mio.hpp"
 
 namespace
 {
@@ -174,6 +176,8 @@ int lua_version(lua_State* L)
 namespace ax
 {
 
+LuaStack::LuaStack() : _state(nullptr), _callFromLua(0) {}
+
 LuaStack::~LuaStack()
 {
     if (nullptr != _state)
@@ -292,6 +296,62 @@ void LuaStack::addLuaLoader(lua_CFunction func)
     lua_pop(_state, 1);
 }
 
+static const char s_bindingProfilingKey = 0;
+
+void LuaStack::setBindingProfilingEnabled(bool enabled)
+{
+    if (_bindingProfilingEnabled == enabled)
+        return;
+
+    _bindingProfilingEnabled = enabled;
+
+    // the hook finds the stack through the registry, a lua_State may be shared by several stacks
+    lua_pushlightuserdata(_state, (void*)&s_bindingProfilingKey);
+    if (enabled)
+        lua_pushlightuserdata(_state, this);
+    else
+        lua_pushnil(_state);
+    lua_rawset(_state, LUA_REGISTRYINDEX);
+
+    lua_sethook(_state, enabled ? bindingProfilingHook : nullptr, enabled ? LUA_MASKCALL : 0, 0);
+}
+
+void LuaStack::bindingProfilingHook(lua_State* L, lua_Debug* ar)
+{
+    if (ar->event != LUA_HOOKCALL || !lua_getinfo(L, "nS", ar) || ar->what == nullptr || strcmp(ar->what, "C") != 0)
+        return;
+
+    lua_pushlightuserdata(L, (void*)&s_bindingProfilingKey);
+    lua_rawget(L, LUA_REGISTRYINDEX);
+    auto stack = static_cast<LuaStack*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!stack)
+        return;
+
+    std::string_view name = ar->name ? ar->name : "?";
+    auto it               = stack->_bindingCallCounts.find(name);
+    if (it != stack->_bindingCallCounts.end())
+        ++it.value();
+    else
+        stack->_bindingCallCounts.emplace(name, 1);
+}
+
+void LuaStack::dumpBindingCallCounts(size_t maxCount) const
+{
+    std::vector<std::pair<std::string_view, uint64_t>> counts;
+    counts.reserve(_bindingCallCounts.size());
+    for (auto&& item : _bindingCallCounts)
+        counts.emplace_back(item.first, item.second);
+
+    maxCount = std::min(maxCount, counts.size());
+    std::partial_sort(counts.begin(), counts.begin() + maxCount, counts.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+    AXLOGI("[LUA] binding calls, {} functions:", counts.size());
+    for (size_t i = 0; i < maxCount; ++i)
+        AXLOGI("    {:>10} {}", counts[i].second, counts[i].first);
+}
+
 void LuaStack::removeScriptObjectByObject(Object* pObj)
 {
     toluafix_remove_ccobject_by_refid(_state, pObj->_luaID);
@@ -743,6 +803,277 @@ int LuaStack::luaLoadChunksFromZIP(lua_State* L)
     return 1;
 }
 
+namespace
+{
+constexpr char BYTECODE_BUNDLE_MAGIC[4]    = {'A', 'X', 'L', 'B'};
+constexpr uint32_t BYTECODE_BUNDLE_VERSION = 1;
+
+struct BytecodeBundleHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t luaVersion;  // LUA_VERSION_NUM of the compiler, the chunks check the rest of the build
+    uint32_t chunkCount;
+    uint32_t slotCount;    // a power of two
+    uint32_t entryOffset;  // BytecodeBundleEntry per chunk
+    uint32_t slotOffset;   // uint32 per slot, index of the entry + 1, 0 if the slot is empty
+};
+
+struct BytecodeBundleEntry
+{
+    uint32_t hash;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t dataOffset;
+    uint32_t dataSize;
+};
+
+uint32_t hashModuleName(std::string_view name)
+{
+    return XXH32(name.data(), name.size(), 0);
+}
+}  // namespace
+
+struct LuaStack::BytecodeBundle
+{
+    mio::mmap_source mapping;
+    Data buffer;  // used when the file can't be mapped, e.g. in the apk
+    const uint8_t* bytes = nullptr;
+    size_t size          = 0;
+
+    const BytecodeBundleHeader& header() const { return *reinterpret_cast<const BytecodeBundleHeader*>(bytes); }
+
+    bool open(std::string_view fullPath)
+    {
+        std::error_code error;
+        mapping.map(std::string{fullPath}, error);
+        if (!error && mapping.size() > 0)
+        {
+            bytes = reinterpret_cast<const uint8_t*>(mapping.data());
+            size  = mapping.size();
+        }
+        else
+        {
+            buffer = FileUtils::getInstance()->getDataFromFile(fullPath);
+            bytes  = buffer.getBytes();
+            size   = static_cast<size_t>(buffer.getSize());
+        }
+
+        if (size < sizeof(BytecodeBundleHeader))
+            return false;
+
+        auto& h = header();
+        if (memcmp(h.magic, BYTECODE_BUNDLE_MAGIC, sizeof(h.magic)) != 0 || h.version != BYTECODE_BUNDLE_VERSION)
+            return false;
+        if (h.luaVersion != LUA_VERSION_NUM)
+        {
+            AXLOGW("addBytecodeBundle() - {} is compiled for another Lua version", fullPath);
+            return false;
+        }
+
+        // the offsets are checked once here, not by the lookups
+        if (h.slotCount == 0 || (h.slotCount & (h.slotCount - 1)) != 0 || h.chunkCount > h.slotCount / 2 ||
+            h.entryOffset % 4 != 0 || h.slotOffset % 4 != 0 ||
+            h.entryOffset + uint64_t{h.chunkCount} * sizeof(BytecodeBundleEntry) > size ||
+            h.slotOffset + uint64_t{h.slotCount} * sizeof(uint32_t) > size)
+            return false;
+        auto entries = reinterpret_cast<const BytecodeBundleEntry*>(bytes + h.entryOffset);
+        for (uint32_t i = 0; i < h.chunkCount; ++i)
+        {
+            if (uint64_t{entries[i].nameOffset} + entries[i].nameLength > size ||
+                uint64_t{entries[i].dataOffset} + entries[i].dataSize > size)
+                return false;
+        }
+        return true;
+    }
+
+    const BytecodeBundleEntry* find(std::string_view name) const
+    {
+        auto& h      = header();
+        auto entries = reinterpret_cast<const BytecodeBundleEntry*>(bytes + h.entryOffset);
+        auto slots   = reinterpret_cast<const uint32_t*>(bytes + h.slotOffset);
+
+        // open addressing with linear probing
+        const uint32_t hash = hashModuleName(name);
+        const uint32_t mask = h.slotCount - 1;
+        for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            const uint32_t index = slots[slot];
+            if (index == 0 || index > h.chunkCount)
+                return nullptr;
+
+            auto& entry = entries[index - 1];
+            if (entry.hash == hash && std::string_view{reinterpret_cast<const char*>(bytes + entry.nameOffset),
+                                                       entry.nameLength} == name)
+                return &entry;
+        }
+    }
+};
+
+bool LuaStack::addBytecodeBundle(std::string_view bundlePath)
+{
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(bundlePath);
+    if (fullPath.empty())
+    {
+        AXLOGW("addBytecodeBundle() - not found: {}", bundlePath);
+        return false;
+    }
+
+    auto bundle = std::make_unique<BytecodeBundle>();
+    if (!bundle->open(fullPath))
+    {
+        AXLOGW("addBytecodeBundle() - invalid bundle: {}", fullPath);
+        return false;
+    }
+
+    AXLOGD("addBytecodeBundle() - {} chunks in {}", bundle->header().chunkCount, fullPath);
+    _bytecodeBundles.emplace_back(std::move(bundle));
+    return true;
+}
+
+void LuaStack::removeAllBytecodeBundles()
+{
+    _bytecodeBundles.clear();
+}
+
+bool LuaStack::luaLoadChunkFromBundles(lua_State* L, std::string_view moduleName)
+{
+    for (auto it = _bytecodeBundles.rbegin(); it != _bytecodeBundles.rend(); ++it)
+    {
+        auto& bundle = *it;
+        if (auto entry = bundle->find(moduleName))
+        {
+            // the chunk name of the bytecode is the one it was compiled with
+            std::string chunkName{"@"};
+            chunkName += moduleName;
+            if (luaLoadBuffer(L, reinterpret_cast<const char*>(bundle->bytes + entry->dataOffset),
+                              static_cast<int>(entry->dataSize), chunkName.c_str()) == 0)
+                return true;
+
+            // compiled by another build of Lua, the script files are searched instead
+            AXLOGW("luaLoadChunkFromBundles() - can't load {}: {}", moduleName, lua_tostring(L, -1));
+            lua_pop(L, 1);
+            return false;
+        }
+    }
+    return false;
+}
+
+bool LuaStack::writeBytecodeBundle(std::string_view scriptsDir, std::string_view bundlePath, bool stripDebugInfo)
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto rootPath  = fileUtils->fullPathForDirectory(scriptsDir);
+    if (rootPath.empty())
+        return false;
+
+    std::vector<std::string> files;
+    fileUtils->listFilesRecursively(rootPath, &files);
+    std::sort(files.begin(), files.end());
+
+    struct Chunk
+    {
+        std::string name;
+        std::string code;
+    };
+    std::vector<Chunk> chunks;
+
+    const int top = lua_gettop(_state);
+    for (auto&& file : files)
+    {
+        using namespace cxx17;
+        std::string_view path{file};
+        if (!cxx20::starts_with(path, rootPath) || !cxx20::ends_with(path, ".lua"_sv))
+            continue;
+
+        auto relativePath = path.substr(rootPath.length());
+        auto data         = fileUtils->getDataFromFile(file);
+        std::string chunkName{"@"};
+        chunkName += relativePath;
+        if (luaLoadBuffer(_state, reinterpret_cast<const char*>(data.getBytes()), static_cast<int>(data.getSize()),
+                          chunkName.c_str()) != 0)
+        {
+            AXLOGE("writeBytecodeBundle() - can't compile {}: {}", file, lua_tostring(_state, -1));
+            lua_settop(_state, top);
+            return false;
+        }
+
+        // string.dump strips the debug info in both LuaJIT and Lua 5.4, unlike lua_dump
+        lua_getglobal(_state, "string");   /* L: func string */
+        lua_getfield(_state, -1, "dump");  /* L: func string dump */
+        lua_insert(_state, -3);            /* L: dump func string */
+        lua_pop(_state, 1);                /* L: dump func */
+        lua_pushboolean(_state, stripDebugInfo);
+        if (lua_pcall(_state, 2, 1, 0) != 0)
+        {
+            AXLOGE("writeBytecodeBundle() - can't dump {}: {}", file, lua_tostring(_state, -1));
+            lua_settop(_state, top);
+            return false;
+        }
+
+        size_t codeSize = 0;
+        auto code       = lua_tolstring(_state, -1, &codeSize);
+
+        auto& chunk = chunks.emplace_back();
+        chunk.name  = relativePath.substr(0, relativePath.length() - 4);
+        std::replace(chunk.name.begin(), chunk.name.end(), '/', '.');
+        chunk.code.assign(code, codeSize);
+        lua_settop(_state, top);
+    }
+
+    // the hash table is kept at most half full
+    uint32_t slotCount = 1;
+    while (slotCount < chunks.size() * 2)
+        slotCount <<= 1;
+
+    BytecodeBundleHeader header{};
+    memcpy(header.magic, BYTECODE_BUNDLE_MAGIC, sizeof(header.magic));
+    header.version     = BYTECODE_BUNDLE_VERSION;
+    header.luaVersion  = LUA_VERSION_NUM;
+    header.chunkCount  = static_cast<uint32_t>(chunks.size());
+    header.slotCount   = slotCount;
+    header.entryOffset = sizeof(BytecodeBundleHeader);
+    header.slotOffset  = header.entryOffset + header.chunkCount * sizeof(BytecodeBundleEntry);
+
+    std::vector<BytecodeBundleEntry> entries(chunks.size());
+    std::vector<uint32_t> slots(header.slotCount, 0);
+    size_t offset = header.slotOffset + header.slotCount * sizeof(uint32_t);
+    for (uint32_t i = 0; i < header.chunkCount; ++i)
+    {
+        auto& entry      = entries[i];
+        entry.hash       = hashModuleName(chunks[i].name);
+        entry.nameOffset = static_cast<uint32_t>(offset);
+        entry.nameLength = static_cast<uint32_t>(chunks[i].name.length());
+        offset += entry.nameLength;
+        entry.dataOffset = static_cast<uint32_t>(offset);
+        entry.dataSize   = static_cast<uint32_t>(chunks[i].code.length());
+        offset += entry.dataSize;
+
+        uint32_t slot = entry.hash & (header.slotCount - 1);
+        while (slots[slot] != 0)
+            slot = (slot + 1) & (header.slotCount - 1);
+        slots[slot] = i + 1;
+    }
+    if (offset > UINT32_MAX)
+    {
+        AXLOGE("writeBytecodeBundle() - the bundle is larger than 4GB");
+        return false;
+    }
+
+    std::string bundle;
+    bundle.reserve(offset);
+    bundle.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    bundle.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BytecodeBundleEntry));
+    bundle.append(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(uint32_t));
+    for (auto&& chunk : chunks)
+    {
+        bundle += chunk.name;
+        bundle += chunk.code;
+    }
+
+    AXLOGD("writeBytecodeBundle() - {} chunks written to {}", chunks.size(), bundlePath);
+    return fileUtils->writeStringToFile(bundle, bundlePath);
+}
+
 namespace
 {
 
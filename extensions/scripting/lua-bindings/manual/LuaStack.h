@@ -31,7 +31,9 @@ extern "C" {
 #include "lua.h"
 }
 
+#include <memory>
 #include "lua-bindings/manual/LuaValue.h"
+#include "base/hlookup.h"
 
 /**
  * @addtogroup lua
@@ -319,14 +321,77 @@ public:
      */
     int luaLoadChunksFromZIP(lua_State* L);
 
+    /**
+     * Adds a bundle of precompiled chunks written by writeBytecodeBundle(). The modules it holds are required from it
+     * instead of being searched in package.path and compiled, the bundles added last are searched first.
+     * The file is memory mapped when it can be, its index is a hash table looked up without being parsed.
+     *
+     * @param bundlePath path to the bundle file.
+     * @return true if the bundle was added.
+     */
+    bool addBytecodeBundle(std::string_view bundlePath);
+
+    /** Removes all the bytecode bundles, the modules loaded already stay loaded. */
+    void removeAllBytecodeBundles();
+
+    /**
+     * Compiles the Lua scripts of a directory and writes their bytecode to a bundle. A module is named by its path
+     * relative to the directory, "app/views/MainScene.lua" is the module "app.views.MainScene".
+     * The bytecode only loads in the Lua build it was compiled by, so the bundles are written by the engine itself,
+     * from a build of the game for the same Lua engine and pointer size as the targeted platforms.
+     *
+     * @param scriptsDir directory of the .lua scripts.
+     * @param bundlePath full path of the bundle to write.
+     * @param stripDebugInfo strips the line numbers and the local names from the bytecode, the chunks are smaller
+     *        but the errors don't tell the lines anymore.
+     * @return true if all the scripts were compiled and the bundle written.
+     */
+    bool writeBytecodeBundle(std::string_view scriptsDir, std::string_view bundlePath, bool stripDebugInfo = false);
+
+    /**
+     * Loads the chunk of a module from the bytecode bundles.
+     *
+     * @param L the current lua_State.
+     * @param moduleName the name of the module, as given to require.
+     * @return true if the chunk was found and pushed onto the stack.
+     */
+    bool luaLoadChunkFromBundles(lua_State* L, std::string_view moduleName);
+
+    /**
+     * Enables counting the calls of the C functions, the bindings, by name to find the hot ones of a script.
+     * It installs a call hook, which slows down every call and stops the LuaJIT compiler while it is enabled.
+     *
+     * @param enabled true to count the calls, the counts are kept when it is disabled.
+     */
+    void setBindingProfilingEnabled(bool enabled);
+    bool isBindingProfilingEnabled() const { return _bindingProfilingEnabled; }
+
+    /** The call counts of the C functions by name, the name of a method doesn't include its class. */
+    const hlookup::string_map<uint64_t>& getBindingCallCounts() const { return _bindingCallCounts; }
+    void resetBindingCallCounts() { _bindingCallCounts.clear(); }
+
+    /**
+     * Logs the most called C functions.
+     *
+     * @param maxCount the number of functions to log.
+     */
+    void dumpBindingCallCounts(size_t maxCount = 20) const;
+
 protected:
-    LuaStack() : _state(nullptr), _callFromLua(0) {}
+    LuaStack();
 
     bool init();
     bool initWithLuaState(lua_State* L);
 
+    static void bindingProfilingHook(lua_State* L, lua_Debug* ar);
+
     lua_State* _state;
     int _callFromLua;
+    bool _bindingProfilingEnabled = false;
+    hlookup::string_map<uint64_t> _bindingCallCounts;
+
+    struct BytecodeBundle;
+    std::vector<std::unique_ptr<BytecodeBundle>> _bytecodeBundles;
 };
 
 }
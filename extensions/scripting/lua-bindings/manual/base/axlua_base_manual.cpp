@@ -4023,6 +4023,85 @@ static void extendMenu(lua_State* tolua_S)
     lua_pop(tolua_S, 1);
 }
 
+// ax.Node.setPositions(nodes, xs, ys) sets the positions of many nodes in one call, without a table per position
+static int axlua_Node_setPositions(lua_State* tolua_S)
+{
+    int argc = lua_gettop(tolua_S);
+#if _AX_DEBUG >= 1
+    tolua_Error tolua_err;
+    if (!tolua_istable(tolua_S, 1, 0, &tolua_err) || !tolua_istable(tolua_S, 2, 0, &tolua_err) ||
+        !tolua_istable(tolua_S, 3, 0, &tolua_err))
+        goto tolua_lerror;
+#endif
+
+    if (argc == 3)
+    {
+        const int count = (int)lua_objlen(tolua_S, 1);
+        for (int i = 1; i <= count; ++i)
+        {
+            lua_rawgeti(tolua_S, 1, i);
+            lua_rawgeti(tolua_S, 2, i);
+            lua_rawgeti(tolua_S, 3, i);
+            auto node = static_cast<ax::Node*>(tolua_tousertype(tolua_S, -3, nullptr));
+            if (node)
+                node->setPosition((float)lua_tonumber(tolua_S, -2), (float)lua_tonumber(tolua_S, -1));
+            lua_pop(tolua_S, 3);
+        }
+        return 0;
+    }
+
+    luaL_error(tolua_S, "%s has wrong number of arguments: %d, was expecting %d \n", "ax.Node.setPositions", argc, 3);
+    return 0;
+
+#if _AX_DEBUG >= 1
+tolua_lerror:
+    tolua_error(tolua_S, "#ferror in function 'axlua_Node_setPositions'.", &tolua_err);
+    return 0;
+#endif
+}
+
+// ax.Node.getPositions(nodes) returns the tables of the x and y of many nodes
+static int axlua_Node_getPositions(lua_State* tolua_S)
+{
+    int argc = lua_gettop(tolua_S);
+#if _AX_DEBUG >= 1
+    tolua_Error tolua_err;
+    if (!tolua_istable(tolua_S, 1, 0, &tolua_err))
+        goto tolua_lerror;
+#endif
+
+    if (argc == 1)
+    {
+        const int count = (int)lua_objlen(tolua_S, 1);
+        lua_createtable(tolua_S, count, 0); /* L: nodes xs */
+        lua_createtable(tolua_S, count, 0); /* L: nodes xs ys */
+        for (int i = 1; i <= count; ++i)
+        {
+            lua_rawgeti(tolua_S, 1, i);
+            auto node = static_cast<ax::Node*>(tolua_tousertype(tolua_S, -1, nullptr));
+            lua_pop(tolua_S, 1);
+
+            float x = 0.0f, y = 0.0f;
+            if (node)
+                node->getPosition(&x, &y);
+            lua_pushnumber(tolua_S, (lua_Number)x);
+            lua_rawseti(tolua_S, -3, i);
+            lua_pushnumber(tolua_S, (lua_Number)y);
+            lua_rawseti(tolua_S, -2, i);
+        }
+        return 2;
+    }
+
+    luaL_error(tolua_S, "%s has wrong number of arguments: %d, was expecting %d \n", "ax.Node.getPositions", argc, 1);
+    return 0;
+
+#if _AX_DEBUG >= 1
+tolua_lerror:
+    tolua_error(tolua_S, "#ferror in function 'axlua_Node_getPositions'.", &tolua_err);
+    return 0;
+#endif
+}
+
 static void extendNode(lua_State* tolua_S)
 {
     lua_pushstring(tolua_S, "ax.Node");
@@ -4059,6 +4138,12 @@ static void extendNode(lua_State* tolua_S)
         lua_pushstring(tolua_S, "setRotationQuat");
         lua_pushcfunction(tolua_S, axlua_Node_setRotationQuat);
         lua_rawset(tolua_S, -3);
+        lua_pushstring(tolua_S, "setPositions");
+        lua_pushcfunction(tolua_S, axlua_Node_setPositions);
+        lua_rawset(tolua_S, -3);
+        lua_pushstring(tolua_S, "getPositions");
+        lua_pushcfunction(tolua_S, axlua_Node_getPositions);
+        lua_rawset(tolua_S, -3);
     }
     lua_pop(tolua_S, 1);
 }
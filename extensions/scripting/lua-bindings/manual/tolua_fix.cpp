@@ -79,6 +79,27 @@ TOLUA_API int toluafix_pushusertype_object(lua_State* L, int refid, int* p_refid
 
         // AXLOGD("[LUA] push CCObject OK - refid: {}, ptr: {}, type: {}\n", *p_refid, (int)ptr, type);
     }
+    else
+    {
+        // the object was pushed before, its userdata is kept in the root until the object is removed,
+        // reuse it when it already has the metatable of the type instead of going through the ubox
+        lua_pushstring(L, TOLUA_VALUE_ROOT);
+        lua_rawget(L, LUA_REGISTRYINDEX); /* stack: root */
+        lua_pushlightuserdata(L, vPtr);   /* stack: root ptr */
+        lua_rawget(L, -2);                /* stack: root ud */
+        if (lua_isuserdata(L, -1) && lua_getmetatable(L, -1)) /* stack: root ud udmt */
+        {
+            luaL_getmetatable(L, vType); /* stack: root ud udmt mt */
+            const bool sameType = lua_rawequal(L, -1, -2);
+            lua_pop(L, 2); /* stack: root ud */
+            if (sameType)
+            {
+                lua_remove(L, -2); /* stack: ud */
+                return 0;
+            }
+        }
+        lua_pop(L, 2); /* stack: - */
+    }
 
     tolua_pushusertype_and_addtoroot(L, vPtr, vType);
 
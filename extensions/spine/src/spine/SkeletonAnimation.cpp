@@ -31,6 +31,7 @@
 #include <spine/Extension.h>
 #include <spine/SkeletonAnimation.h>
 #include <spine/spine-axmol.h>
+#include "base/JobSystem.h"
 
 using namespace ax;
 using std::max;
@@ -48,12 +49,27 @@ namespace spine {
 		EventListener eventListener;
 	} _TrackEntryListeners;
 
+	// the skeletons waiting for a parallel update, retained
+	static std::vector<SkeletonAnimation *> s_pendingSkeletons;
+	static EventListenerCustom *s_afterUpdateListener = nullptr;
+
+	static SkeletonAnimation::UpdatePolicy s_defaultUpdatePolicy;
+
 	void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onAnimationStateEvent(entry, type, event);
+		SkeletonAnimation *node = (SkeletonAnimation *) state->getRendererObject();
+		// on a worker, the event is dispatched once all the skeletons are updated
+		if (node->_deferEvents) {
+			node->_deferredEvents.push_back({entry, type, event});
+			return;
+		}
+		node->onAnimationStateEvent(entry, type, event);
 	}
 
 	void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onTrackEntryEvent(entry, type, event);
+		SkeletonAnimation *node = (SkeletonAnimation *) state->getRendererObject();
+		// deferred by animationCallback, which is called for every event
+		if (node->_deferEvents) return;
+		node->onTrackEntryEvent(entry, type, event);
 		if (type == EventType_Dispose) {
 			if (entry->getRendererObject()) {
 				delete (spine::_TrackEntryListeners *) entry->getRendererObject();
@@ -118,6 +134,17 @@ namespace spine {
 		_state->setListener(animationCallback);
 
 		_firstDraw = true;
+		_parallelUpdate = false;
+		_updatePending = false;
+		_deferEvents = false;
+		_manualTrackEntryDisposal = false;
+		_pendingDeltaTime = 0;
+		_hasUpdatePolicy = false;
+		_throttledFrames = 0;
+		_skippedTime = 0;
+		_bakedAnimation = nullptr;
+		_bakedTime = 0;
+		_bakedLoop = false;
 	}
 
 	SkeletonAnimation::SkeletonAnimation()
@@ -135,21 +162,181 @@ namespace spine {
 		super::update(deltaTime);
 
 		deltaTime *= _timeScale;
+		if (skipUpdate(deltaTime)) return;
+		deltaTime += _skippedTime;
+		_skippedTime = 0;
+
+		if (_parallelUpdate)
+			queueParallelUpdate(deltaTime);
+		else
+			applyAnimation(deltaTime);
+	}
+
+	void SkeletonAnimation::applyAnimation(float deltaTime) {
 		if (_preUpdateListener) _preUpdateListener(this);
+		updatePose(deltaTime);
+		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	void SkeletonAnimation::updatePose(float deltaTime) {
+		if (_bakedAnimation) {
+			_bakedTime += deltaTime;
+			_bakedAnimation->applyFrame(*_skeleton, _bakedAnimation->getFrameIndex(_bakedTime, _bakedLoop));
+			return;
+		}
+
 		_state->update(deltaTime);
 		_state->apply(*_skeleton);
 		_skeleton->updateWorldTransform();
-		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	bool SkeletonAnimation::setBakedAnimation(const std::string &name, bool loop, float frameRate) {
+		AXASSERT(frameRate > 0, "Invalid baked frame rate");
+		Animation *animation = _skeleton->getData()->findAnimation(name.c_str());
+		if (!animation) {
+			AXLOGW("Spine: Animation not found: {}", name);
+			return false;
+		}
+
+		_bakedAnimation = SkeletonBakedAnimation::getInstance(_skeleton->getData(), animation, _skeleton->getSkin(), frameRate);
+		_bakedTime = 0;
+		_bakedLoop = loop;
+		return true;
+	}
+
+	void SkeletonAnimation::clearBakedAnimation() {
+		_bakedAnimation = nullptr;
 	}
 
 	void SkeletonAnimation::draw(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags) {
 		if (_firstDraw) {
 			_firstDraw = false;
-			update(0);
+			// the pose is needed now, it doesn't wait for the next parallel update
+			if (_parallelUpdate)
+				applyAnimation(0);
+			else
+				update(0);
 		}
 		super::draw(renderer, transform, transformFlags);
 	}
 
+	bool SkeletonAnimation::skipUpdate(float deltaTime) {
+		// the first pose is set by the first draw
+		if (_firstDraw) return false;
+
+		const UpdatePolicy &policy = getUpdatePolicy();
+		const unsigned int frame = Director::getInstance()->getTotalFrames();
+
+		// not drawn in the last frame, it is culled or hidden
+		const bool culled = _drawnFrame == UINT_MAX || _drawnFrame + 1 < frame;
+
+		bool skip = policy.skipWhenCulled && culled;
+		if (!skip && !culled && policy.smallUpdateInterval > 1 && _drawnSize < policy.smallSize)
+			skip = ++_throttledFrames < policy.smallUpdateInterval;
+
+		if (skip) {
+			_skippedTime += deltaTime;
+			return true;
+		}
+		_throttledFrames = 0;
+		return false;
+	}
+
+	void SkeletonAnimation::setUpdatePolicy(const UpdatePolicy &policy) {
+		_updatePolicy = policy;
+		_hasUpdatePolicy = true;
+	}
+
+	void SkeletonAnimation::resetUpdatePolicy() {
+		_hasUpdatePolicy = false;
+	}
+
+	const SkeletonAnimation::UpdatePolicy &SkeletonAnimation::getUpdatePolicy() const {
+		return _hasUpdatePolicy ? _updatePolicy : s_defaultUpdatePolicy;
+	}
+
+	void SkeletonAnimation::setDefaultUpdatePolicy(const UpdatePolicy &policy) {
+		s_defaultUpdatePolicy = policy;
+	}
+
+	const SkeletonAnimation::UpdatePolicy &SkeletonAnimation::getDefaultUpdatePolicy() {
+		return s_defaultUpdatePolicy;
+	}
+
+	void SkeletonAnimation::setParallelUpdate(bool enabled) {
+		_parallelUpdate = enabled;
+	}
+
+	void SkeletonAnimation::queueParallelUpdate(float deltaTime) {
+		// updated twice in a frame, the times add up
+		if (_updatePending) {
+			_pendingDeltaTime += deltaTime;
+			return;
+		}
+
+		_updatePending = true;
+		_pendingDeltaTime = deltaTime;
+		retain();
+		s_pendingSkeletons.push_back(this);
+
+		if (!s_afterUpdateListener) {
+			s_afterUpdateListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+					Director::EVENT_AFTER_UPDATE, [](EventCustom *) { SkeletonAnimation::updatePendingSkeletons(); });
+		}
+	}
+
+	void SkeletonAnimation::updatePendingSkeletons() {
+		if (s_afterUpdateListener) {
+			Director::getInstance()->getEventDispatcher()->removeEventListener(s_afterUpdateListener);
+			s_afterUpdateListener = nullptr;
+		}
+		if (s_pendingSkeletons.empty()) return;
+
+		// the listeners can queue skeletons for the next update
+		std::vector<SkeletonAnimation *> skeletons;
+		skeletons.swap(s_pendingSkeletons);
+
+		for (auto skeleton : skeletons) {
+			if (skeleton->_preUpdateListener) skeleton->_preUpdateListener(skeleton);
+			skeleton->_manualTrackEntryDisposal = skeleton->_state->getManualTrackEntryDisposal();
+			skeleton->_state->setManualTrackEntryDisposal(true);
+			skeleton->_deferEvents = true;
+		}
+
+		auto updateRange = [&skeletons](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				skeletons[i]->updatePose(skeletons[i]->_pendingDeltaTime);
+			}
+		};
+
+		auto jobSystem = Director::getInstance()->getJobSystem();
+		if (jobSystem && skeletons.size() > 1)
+			jobSystem->wait(jobSystem->parallelFor(skeletons.size(), 1, updateRange));
+		else
+			updateRange(0, skeletons.size());
+
+		for (auto skeleton : skeletons) {
+			skeleton->_updatePending = false;
+			skeleton->dispatchDeferredEvents();
+			if (skeleton->_postUpdateListener) skeleton->_postUpdateListener(skeleton);
+			skeleton->release();
+		}
+	}
+
+	void SkeletonAnimation::dispatchDeferredEvents() {
+		_deferEvents = false;
+		_state->setManualTrackEntryDisposal(_manualTrackEntryDisposal);
+
+		// in the order of AnimationState's event queue, the track entry listeners first
+		for (auto &deferred : _deferredEvents) {
+			trackEntryCallback(_state, deferred.type, deferred.entry, deferred.event);
+			onAnimationStateEvent(deferred.entry, deferred.type, deferred.event);
+			if (deferred.type == EventType_Dispose && !_manualTrackEntryDisposal)
+				_state->disposeTrackEntry(deferred.entry);
+		}
+		_deferredEvents.clear();
+	}
+
 	void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
 		AXASSERT(stateData, "stateData cannot be null.");
 
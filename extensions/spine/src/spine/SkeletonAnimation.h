@@ -32,6 +32,7 @@
 
 #include <spine/spine-axmol.h>
 #include <spine/spine.h>
+#include <spine/SkeletonBakedAnimation.h>
 
 namespace spine {
 
@@ -102,16 +103,88 @@ namespace spine {
 		AnimationState *getState() const;
 		void setUpdateOnlyIfVisible(bool status);
 
+		/** Plays the baked poses of an animation instead of the animation state, they are shared by the skeletons of
+		 * the same data and skin playing it at the same frame rate, see SkeletonBakedAnimation. The baked animation
+		 * isn't mixed and fires no events. Returns false when the animation isn't found. */
+		bool setBakedAnimation(const std::string &name, bool loop, float frameRate = 30);
+		/** Stops the baked animation, the animation state is applied again. */
+		void clearBakedAnimation();
+		SkeletonBakedAnimation *getBakedAnimation() const { return _bakedAnimation; }
+
+		/** Updates the animation state and the world transform of the skeleton on the JobSystem workers, together with
+		 * the other skeletons in this mode, after the scheduler update. The listeners set on this node are still
+		 * called on the axmol thread, after the update of all the skeletons. The skeleton data must not be changed
+		 * from other threads meanwhile. */
+		void setParallelUpdate(bool enabled);
+		bool isParallelUpdate() const { return _parallelUpdate; }
+
+		/** Updates the skeletons waiting for a parallel update, called after the scheduler update. */
+		static void updatePendingSkeletons();
+
+		/** How the animation advances when the skeleton isn't seen or is small on the screen. */
+		struct UpdatePolicy {
+			/** Doesn't update the skeleton while it isn't drawn, the skipped time is caught up once it is. The
+			 * animation events of the skipped time are dispatched then. */
+			bool skipWhenCulled = false;
+			/** Below this size of the skeleton on the screen, in points, it is updated once every
+			 * smallUpdateInterval frames, by the time of all of them. */
+			float smallSize = 0;
+			int smallUpdateInterval = 1;
+		};
+
+		/** Sets the update policy of this skeleton, instead of the default one. */
+		void setUpdatePolicy(const UpdatePolicy &policy);
+		/** Uses the default update policy again. */
+		void resetUpdatePolicy();
+		const UpdatePolicy &getUpdatePolicy() const;
+
+		/** The policy used by the skeletons without their own one. */
+		static void setDefaultUpdatePolicy(const UpdatePolicy &policy);
+		static const UpdatePolicy &getDefaultUpdatePolicy();
+
 		SkeletonAnimation();
 		virtual ~SkeletonAnimation();
 		virtual void initialize() override;
 
 	protected:
+		struct DeferredEvent {
+			TrackEntry *entry;
+			EventType type;
+			Event *event;
+		};
+
+		friend void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+		friend void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+
+		/** Applies the animations to the skeleton and updates its world transform, with the listeners. */
+		void applyAnimation(float deltaTime);
+		/** Advances the animation state or the baked animation, and updates the pose of the skeleton. */
+		void updatePose(float deltaTime);
+		void queueParallelUpdate(float deltaTime);
+		void dispatchDeferredEvents();
+		/** Returns true when the update policy skips this update, the time is then added to the skipped time. */
+		bool skipUpdate(float deltaTime);
+
 		AnimationState *_state;
 
 		bool _ownsAnimationStateData;
 		bool _updateOnlyIfVisible;
 		bool _firstDraw;
+		bool _parallelUpdate;
+		bool _updatePending;
+		bool _deferEvents;
+		bool _manualTrackEntryDisposal;
+		float _pendingDeltaTime;
+		std::vector<DeferredEvent> _deferredEvents;
+
+		UpdatePolicy _updatePolicy;
+		bool _hasUpdatePolicy;
+		int _throttledFrames;
+		float _skippedTime;
+
+		SkeletonBakedAnimation *_bakedAnimation;
+		float _bakedTime;
+		bool _bakedLoop;
 
 		StartListener _startListener;
 		InterruptListener _interruptListener;
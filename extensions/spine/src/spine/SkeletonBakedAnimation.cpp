@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonBakedAnimation.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace spine {
+
+	using BakedAnimationKey = std::tuple<SkeletonData *, Animation *, Skin *, float>;
+
+	static std::map<BakedAnimationKey, SkeletonBakedAnimation *> s_bakedAnimations;
+
+	SkeletonBakedAnimation *SkeletonBakedAnimation::getInstance(SkeletonData *data, Animation *animation, Skin *skin, float frameRate) {
+		const BakedAnimationKey key(data, animation, skin, frameRate);
+		auto it = s_bakedAnimations.find(key);
+		if (it != s_bakedAnimations.end()) return it->second;
+
+		auto bakedAnimation = new SkeletonBakedAnimation(data, animation, skin, frameRate);
+		s_bakedAnimations.emplace(key, bakedAnimation);
+		return bakedAnimation;
+	}
+
+	void SkeletonBakedAnimation::purge(SkeletonData *data) {
+		for (auto it = s_bakedAnimations.begin(); it != s_bakedAnimations.end();) {
+			if (std::get<0>(it->first) == data) {
+				delete it->second;
+				it = s_bakedAnimations.erase(it);
+			} else
+				++it;
+		}
+	}
+
+	void SkeletonBakedAnimation::purgeAll() {
+		for (auto &item : s_bakedAnimations)
+			delete item.second;
+		s_bakedAnimations.clear();
+	}
+
+	SkeletonBakedAnimation::SkeletonBakedAnimation(SkeletonData *data, Animation *animation, Skin *skin, float frameRate)
+		: _data(data), _animation(animation), _frameRate(frameRate) {
+		// the last frame is the end of the animation, the pose a non looping animation stops on
+		_frameCount = (size_t) std::ceil(animation->getDuration() * frameRate) + 1;
+
+		_skeleton = new (__FILE__, __LINE__) Skeleton(data);
+		if (skin) _skeleton->setSkin(skin);
+		_boneCount = _skeleton->getBones().size();
+		_slotCount = _skeleton->getSlots().size();
+
+		_baked.resize(_frameCount, 0);
+		_bones.resize(_frameCount * _boneCount * 6);
+		_slots.resize(_frameCount * _slotCount);
+		_drawOrder.resize(_frameCount * _slotCount);
+		_deforms.resize(_frameCount);
+	}
+
+	SkeletonBakedAnimation::~SkeletonBakedAnimation() {
+		delete _skeleton;
+	}
+
+	size_t SkeletonBakedAnimation::getFrameIndex(float time, bool loop) const {
+		const float duration = _animation->getDuration();
+		if (duration <= 0) return 0;
+
+		if (loop)
+			time = std::fmod(time, duration);
+		else
+			time = std::min(time, duration);
+		return std::min((size_t) std::max(time * _frameRate, 0.0f), _frameCount - 1);
+	}
+
+	void SkeletonBakedAnimation::applyFrame(Skeleton &skeleton, size_t frame) {
+		AXASSERT(frame < _frameCount, "Invalid baked frame");
+		AXASSERT(skeleton.getData() == _data, "The skeleton isn't of the baked data");
+		{
+			std::lock_guard<std::mutex> lock(_bakeMutex);
+			if (!_baked[frame]) {
+				bakeFrame(frame);
+				_baked[frame] = 1;
+			}
+		}
+
+		Vector<Bone *> &bones = skeleton.getBones();
+		const float *bonePose = &_bones[frame * _boneCount * 6];
+		for (size_t i = 0; i < _boneCount; ++i, bonePose += 6) {
+			Bone *bone = bones[i];
+			bone->setA(bonePose[0]);
+			bone->setB(bonePose[1]);
+			bone->setC(bonePose[2]);
+			bone->setD(bonePose[3]);
+			bone->setWorldX(bonePose[4]);
+			bone->setWorldY(bonePose[5]);
+		}
+
+		Vector<Slot *> &slots = skeleton.getSlots();
+		const SlotPose *slotPose = &_slots[frame * _slotCount];
+		const std::vector<float> &deforms = _deforms[frame];
+		for (size_t i = 0; i < _slotCount; ++i, ++slotPose) {
+			Slot *slot = slots[i];
+			if (slot->getAttachment() != slotPose->attachment) slot->setAttachment(slotPose->attachment);
+
+			const Color &color = slotPose->color;
+			slot->getColor().set(color.r, color.g, color.b, color.a);
+			if (slot->hasDarkColor()) {
+				const Color &darkColor = slotPose->darkColor;
+				slot->getDarkColor().set(darkColor.r, darkColor.g, darkColor.b, darkColor.a);
+			}
+
+			Vector<float> &deform = slot->getDeform();
+			deform.setSize(slotPose->deformCount, 0);
+			if (slotPose->deformCount)
+				memcpy(deform.buffer(), &deforms[slotPose->deformStart], slotPose->deformCount * sizeof(float));
+		}
+
+		Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+		const int *slotIndices = &_drawOrder[frame * _slotCount];
+		for (size_t i = 0; i < _slotCount; ++i)
+			drawOrder[i] = slots[slotIndices[i]];
+	}
+
+	void SkeletonBakedAnimation::bakeFrame(size_t frame) {
+		const float time = std::min(frame / _frameRate, _animation->getDuration());
+		_skeleton->setToSetupPose();
+		_animation->apply(*_skeleton, time, time, false, nullptr, 1, MixBlend_Setup, MixDirection_In);
+		_skeleton->updateWorldTransform();
+
+		Vector<Bone *> &bones = _skeleton->getBones();
+		float *bonePose = &_bones[frame * _boneCount * 6];
+		for (size_t i = 0; i < _boneCount; ++i, bonePose += 6) {
+			Bone *bone = bones[i];
+			bonePose[0] = bone->getA();
+			bonePose[1] = bone->getB();
+			bonePose[2] = bone->getC();
+			bonePose[3] = bone->getD();
+			bonePose[4] = bone->getWorldX();
+			bonePose[5] = bone->getWorldY();
+		}
+
+		Vector<Slot *> &slots = _skeleton->getSlots();
+		SlotPose *slotPose = &_slots[frame * _slotCount];
+		std::vector<float> &deforms = _deforms[frame];
+		for (size_t i = 0; i < _slotCount; ++i, ++slotPose) {
+			Slot *slot = slots[i];
+			slotPose->attachment = slot->getAttachment();
+			slotPose->color = slot->getColor();
+			slotPose->darkColor = slot->getDarkColor();
+
+			Vector<float> &deform = slot->getDeform();
+			slotPose->deformStart = deforms.size();
+			slotPose->deformCount = deform.size();
+			deforms.insert(deforms.end(), deform.buffer(), deform.buffer() + deform.size());
+		}
+
+		Vector<Slot *> &drawOrder = _skeleton->getDrawOrder();
+		int *slotIndices = &_drawOrder[frame * _slotCount];
+		for (size_t i = 0; i < _slotCount; ++i)
+			slotIndices[i] = drawOrder[i]->getData().getIndex();
+	}
+
+}// namespace spine
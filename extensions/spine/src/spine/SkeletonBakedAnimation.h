@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONBAKEDANIMATION_H_
+#define SPINE_SKELETONBAKEDANIMATION_H_
+
+#include <spine/spine.h>
+#include <mutex>
+#include <vector>
+
+namespace spine {
+
+	/** The poses of an animation sampled at a fixed rate, shared by the skeletons of the same data and skin playing it.
+	 * A pose holds the bone world transforms, the slot attachments, colors and deforms, and the draw order, so the
+	 * skeletons using it don't apply the animation nor update their world transform. A frame is sampled the first time
+	 * it is used. The poses are sampled without the skeleton position, scale and constraints mixing of an
+	 * AnimationState, scale the node to flip the skeleton. */
+	class SP_API SkeletonBakedAnimation {
+	public:
+		/** Returns the baked animation shared for a data, animation, skin and frame rate, created on first use. */
+		static SkeletonBakedAnimation *getInstance(SkeletonData *data, Animation *animation, Skin *skin, float frameRate);
+		/** Deletes the baked animations of a skeleton data, before the data is deleted. */
+		static void purge(SkeletonData *data);
+		static void purgeAll();
+
+		Animation *getAnimation() const { return _animation; }
+		float getFrameRate() const { return _frameRate; }
+		size_t getFrameCount() const { return _frameCount; }
+
+		/** Returns the frame shown at a time of the animation. */
+		size_t getFrameIndex(float time, bool loop) const;
+
+		/** Sets the pose of a frame to a skeleton of the same data, it can be called from several threads. */
+		void applyFrame(Skeleton &skeleton, size_t frame);
+
+	protected:
+		struct SlotPose {
+			Attachment *attachment;
+			Color color;
+			Color darkColor;
+			size_t deformStart;
+			size_t deformCount;
+		};
+
+		SkeletonBakedAnimation(SkeletonData *data, Animation *animation, Skin *skin, float frameRate);
+		~SkeletonBakedAnimation();
+
+		void bakeFrame(size_t frame);
+
+		SkeletonData *_data;
+		Animation *_animation;
+		float _frameRate;
+		size_t _frameCount;
+		size_t _boneCount;
+		size_t _slotCount;
+
+		Skeleton *_skeleton;// samples the poses
+		// the arrays are sized for all the frames, baking a frame only writes its own part
+		std::mutex _bakeMutex;
+		std::vector<uint8_t> _baked;
+		std::vector<float> _bones;// a, b, c, d, worldX, worldY of each bone, by frame
+		std::vector<SlotPose> _slots;
+		std::vector<int> _drawOrder;// slot indices
+		std::vector<std::vector<float>> _deforms;// by frame
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONBAKEDANIMATION_H_ */
@@ -131,7 +131,10 @@ namespace spine {
 	}
 
 	SkeletonRenderer::~SkeletonRenderer() {
-		if (_ownsSkeletonData) delete _skeleton->getData();
+		if (_ownsSkeletonData) {
+			SkeletonBakedAnimation::purge(_skeleton->getData());
+			delete _skeleton->getData();
+		}
 		if (_ownsSkeleton) delete _skeleton;
 		if (_ownsAtlas && _atlas) delete _atlas;
 		if (_attachmentLoader) delete _attachmentLoader;
@@ -236,15 +239,19 @@ namespace spine {
 		VLA(float, worldCoords, coordCount);
 		transformWorldVertices(worldCoords, coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
 
-#if AX_USE_CULLING
 		const axmol::Rect bb = computeBoundingRect(worldCoords, coordCount / 2);
 
+#if AX_USE_CULLING
 		if (cullRectangle(renderer, transform, bb)) {
 			VLA_FREE(worldCoords);
 			return;
 		}
 #endif
 
+		_drawnFrame = Director::getInstance()->getTotalFrames();
+		_drawnSize = std::max(bb.size.width * Vec2(transform.m[0], transform.m[1]).length(),
+							  bb.size.height * Vec2(transform.m[4], transform.m[5]).length());
+
 		const float *worldCoordPtr = worldCoords;
 		SkeletonBatch *batch = SkeletonBatch::getInstance();
 		SkeletonTwoColorBatch *twoColorBatch = SkeletonTwoColorBatch::getInstance();
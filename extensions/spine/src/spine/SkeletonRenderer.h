@@ -151,6 +151,10 @@ namespace spine {
 		int _startSlotIndex;
 		int _endSlotIndex;
 		bool _twoColorTint;
+
+		// the last frame the skeleton was drawn in and its size on the screen then, for the update policies
+		unsigned int _drawnFrame = UINT_MAX;
+		float _drawnSize = 0;
 	};
 
 }// namespace spine
@@ -38,6 +38,7 @@ ActionsProgressTests::ActionsProgressTests()
     ADD_TEST_CASE(SpriteProgressBarVarious);
     ADD_TEST_CASE(SpriteProgressBarTintAndFade);
     ADD_TEST_CASE(SpriteProgressWithSpriteFrame);
+    ADD_TEST_CASE(SpriteProgressShaderCooldowns);
 }
 
 //------------------------------------------------------------------
@@ -385,3 +386,54 @@ std::string SpriteProgressWithSpriteFrame::subtitle() const
 {
     return "Progress With Sprite Frame";
 }
+
+//------------------------------------------------------------------
+//
+// SpriteProgressShaderCooldowns
+//
+//------------------------------------------------------------------
+void SpriteProgressShaderCooldowns::onEnter()
+{
+    SpriteDemo::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // a grid of cooldown icons, the radial ones and the bar ones are drawn with one call each
+    const int columns = 16;
+    const int rows    = 6;
+    const float step  = s.width / (columns + 1);
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto timer = ProgressTimer::create(Sprite::create(s_pathSister1));
+        if (i % 2 == 1)
+        {
+            timer->setType(ProgressTimer::Type::BAR);
+            timer->setMidpoint(Vec2(0, 0));
+            timer->setBarChangeRate(Vec2(0, 1));
+        }
+        timer->setShaderProgressEnabled(true);
+        timer->setScale(step / timer->getContentSize().width * 0.9f);
+        timer->setPosition(step * (i % columns + 1), s.height / 2 + step * (rows / 2 - i / columns - 0.5f));
+        addChild(timer);
+
+        auto cooldown = ProgressFromTo::create(2.0f + (i % 5) * 0.5f, 0, 100);
+        timer->runAction(RepeatForever::create(cooldown));
+        _timers.pushBack(timer);
+    }
+
+    auto toggle = MenuItemFont::create("Shader progress: On", [this](Object* sender) {
+        auto item    = static_cast<MenuItemFont*>(sender);
+        bool enabled = !_timers.front()->isShaderProgressEnabled();
+        for (auto&& timer : _timers)
+            timer->setShaderProgressEnabled(enabled);
+        item->setString(enabled ? "Shader progress: On" : "Shader progress: Off");
+    });
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(s.width / 2, 40);
+    addChild(menu, 1);
+}
+
+std::string SpriteProgressShaderCooldowns::subtitle() const
+{
+    return "Shader progress, batched cooldowns";
+}
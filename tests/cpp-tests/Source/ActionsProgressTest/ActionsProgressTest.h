@@ -104,4 +104,16 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class SpriteProgressShaderCooldowns : public SpriteDemo
+{
+public:
+    CREATE_FUNC(SpriteProgressShaderCooldowns);
+
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+
+private:
+    ax::Vector<ax::ProgressTimer*> _timers;
+};
+
 #endif  // _ACTIONS__PROGRESS_TEST_H_
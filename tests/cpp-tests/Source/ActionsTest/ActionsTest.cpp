@@ -96,6 +96,7 @@ ActionsTests::ActionsTests()
     ADD_TEST_CASE(SequenceWithFinalInstant);
     ADD_TEST_CASE(Issue18003);
     ADD_TEST_CASE(ActionCoroutineTest);
+    ADD_TEST_CASE(TweenSystemTest);
 }
 
 std::string ActionsDemo::title() const
@@ -2479,3 +2480,48 @@ Coroutine ActionCoroutineTest::coroutineCallback()
 
     // co_return;   // return coroutine
 }
+
+void TweenSystemTest::onEnter()
+{
+    ActionsDemo::onEnter();
+
+    centerSprites(0);
+
+    auto s = Director::getInstance()->getWinSize();
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto sprite = Sprite::create("Images/grossini_dance_01.png");
+        sprite->setScale(0.25f);
+        sprite->setPosition(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height);
+        addChild(sprite);
+        tweenSprite(sprite);
+    }
+}
+
+void TweenSystemTest::tweenSprite(Sprite* sprite)
+{
+    auto tweens = Director::getInstance()->getActionManager()->getTweenSystem();
+    auto s      = Director::getInstance()->getWinSize();
+
+    const float duration = 1.0f + AXRANDOM_0_1() * 2.0f;
+    auto id = tweens->moveTo(sprite, duration, Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height),
+                             tweenfunc::Sine_EaseInOut);
+    tweens->rotateTo(sprite, duration, AXRANDOM_MINUS1_1() * 180, tweenfunc::Back_EaseOut);
+    tweens->fadeTo(sprite, duration, static_cast<uint8_t>(64 + AXRANDOM_0_1() * 191));
+    tweens->tintTo(sprite, duration,
+                   Color3B(static_cast<uint8_t>(AXRANDOM_0_1() * 255), static_cast<uint8_t>(AXRANDOM_0_1() * 255),
+                           static_cast<uint8_t>(AXRANDOM_0_1() * 255)));
+
+    // start over from where the sprite stopped
+    tweens->setCompletionCallback(id, [this, sprite] { tweenSprite(sprite); });
+}
+
+std::string TweenSystemTest::title() const
+{
+    return "TweenSystem";
+}
+
+std::string TweenSystemTest::subtitle() const
+{
+    return "2000 sprites moved, rotated, faded and tinted without actions";
+}
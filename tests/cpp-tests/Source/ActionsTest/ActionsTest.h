@@ -672,4 +672,17 @@ private:
     uint64_t _frameCount;
 };
 
+class TweenSystemTest : public ActionsDemo
+{
+public:
+    CREATE_FUNC(TweenSystemTest);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void tweenSprite(ax::Sprite* sprite);
+};
+
 #endif
@@ -38,6 +38,7 @@ BillBoardTests::BillBoardTests()
 {
     ADD_TEST_CASE(BillBoardRotationTest);
     ADD_TEST_CASE(BillBoardTest);
+    ADD_TEST_CASE(BillBoardInstancingTest);
 }
 
 //------------------------------------------------------------------
@@ -302,3 +303,67 @@ void BillBoardTest::rotateCameraCallback(Object* sender, float value)
     rotation3D.y += value;
     _camera->setRotation3D(rotation3D);
 }
+
+//------------------------------------------------------------------
+//
+// Billboard Instancing Test
+//
+//------------------------------------------------------------------
+BillBoardInstancingTest::BillBoardInstancingTest()
+{
+    auto s     = Director::getInstance()->getWinSize();
+    auto layer = Layer::create();
+    addChild(layer);
+
+    auto camera = Camera::createPerspective(60, (float)s.width / s.height, 1, 1000);
+    camera->setCameraFlag(CameraFlag::USER1);
+    camera->setPosition3D(Vec3(0.0f, 150.0f, 400.0f));
+    camera->lookAt(Vec3(0, 0, 0), Vec3(0.0f, 1.0f, 0.0f));
+    layer->addChild(camera);
+
+    // one texture and one blend function, so the billboards are drawn with a single instanced call when enabled
+    auto grid = Node::create();
+    for (int i = 0; i < 4000; ++i)
+    {
+        auto billboard = BillBoard::create("Images/Icon.png",
+                                           i % 2 ? BillBoard::Mode::VIEW_POINT_ORIENTED
+                                                 : BillBoard::Mode::VIEW_PLANE_ORIENTED);
+        billboard->setScale(0.1f);
+        billboard->setPosition3D(Vec3(rand_minus1_1() * 300.0f, rand_minus1_1() * 50.0f, rand_minus1_1() * 300.0f));
+        grid->addChild(billboard);
+    }
+    grid->runAction(RepeatForever::create(RotateBy::create(10.0f, Vec3(0.0f, 360.0f, 0.0f))));
+    layer->addChild(grid);
+    layer->setCameraMask(2);
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(24);
+    _toggleItem =
+        MenuItemFont::create("Instancing: OFF", AX_CALLBACK_1(BillBoardInstancingTest::toggleInstancing, this));
+    auto menu = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, VisibleRect::top().y - 100));
+    addChild(menu, 1);
+}
+
+void BillBoardInstancingTest::onExit()
+{
+    Director::getInstance()->getRenderer()->setBillBoardInstancingEnabled(false);
+    TestCase::onExit();
+}
+
+void BillBoardInstancingTest::toggleInstancing(Object* sender)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setBillBoardInstancingEnabled(!renderer->isBillBoardInstancingEnabled());
+    _toggleItem->setString(renderer->isBillBoardInstancingEnabled() ? "Instancing: ON" : "Instancing: OFF");
+}
+
+std::string BillBoardInstancingTest::title() const
+{
+    return "BillBoard Instancing";
+}
+
+std::string BillBoardInstancingTest::subtitle() const
+{
+    return "The billboards are turned by the vertex shader and drawn with one call when enabled";
+}
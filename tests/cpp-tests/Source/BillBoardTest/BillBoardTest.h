@@ -71,6 +71,21 @@ protected:
     std::vector<ax::BillBoard*> _billboards;
 };
 
+class BillBoardInstancingTest : public TestCase
+{
+public:
+    CREATE_FUNC(BillBoardInstancingTest);
+    BillBoardInstancingTest();
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void toggleInstancing(ax::Object* sender);
+
+protected:
+    ax::MenuItemFont* _toggleItem = nullptr;
+};
+
 DEFINE_TEST_SUITE(BillBoardTests);
 
 #endif
@@ -718,18 +718,22 @@ std::string CameraCullingDemo::title() const
     return "Camera Frustum Clipping";
 }
 
+std::string CameraCullingDemo::subtitle() const
+{
+    return "Queried from the bounds tree of the scene, tap to pick";
+}
+
 void CameraCullingDemo::onEnter()
 {
     CameraBaseTest::onEnter();
 
     schedule(AX_SCHEDULE_SELECTOR(CameraCullingDemo::update), 0.0f);
+    setBoundsTreeEnabled(true);
 
-    auto s = Director::getInstance()->getWinSize();
-    /*auto listener = EventListenerTouchAllAtOnce::create();
-    listener->onTouchesBegan = AX_CALLBACK_2(Camera3DTestDemo::onTouchesBegan, this);
-    listener->onTouchesMoved = AX_CALLBACK_2(Camera3DTestDemo::onTouchesMoved, this);
-    listener->onTouchesEnded = AX_CALLBACK_2(Camera3DTestDemo::onTouchesEnded, this);
-    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);*/
+    auto s                   = Director::getInstance()->getWinSize();
+    auto listener            = EventListenerTouchAllAtOnce::create();
+    listener->onTouchesEnded = AX_CALLBACK_2(CameraCullingDemo::onTouchesEnded, this);
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
     auto layer3D = Layer::create();
     addChild(layer3D, 0);
     _layer3D = layer3D;
@@ -783,6 +787,8 @@ void CameraCullingDemo::onEnter()
 void CameraCullingDemo::onExit()
 {
     CameraBaseTest::onExit();
+    setBoundsTreeEnabled(false);
+    _picked = nullptr;
     if (_cameraFirst)
     {
         _cameraFirst = nullptr;
@@ -800,20 +806,30 @@ void CameraCullingDemo::update(float dt)
     if (_cameraType == CameraType::ThirdPerson)
         drawCameraFrustum();
 
-    Vector<Node*>& children = _layer3D->getChildren();
     Vec3 corners[8];
 
-    for (const auto& iter : children)
+    _visibleNodes.clear();
+    getBoundsTree()->queryFrustum(_cameraFirst->getFrustum(), _visibleNodes);
+    for (auto node : _visibleNodes)
     {
-        const AABB& aabb = static_cast<MeshRenderer*>(iter)->getAABB();
-        if (_cameraFirst->isVisibleInFrustum(&aabb))
-        {
-            aabb.getCorners(corners);
-            _drawAABB->drawCube(corners, Color4F(0, 1, 0, 1));
-        }
+        const AABB& aabb = static_cast<MeshRenderer*>(node)->getAABB();
+        aabb.getCorners(corners);
+        _drawAABB->drawCube(corners, node == _picked ? Color4F(1, 0, 0, 1) : Color4F(0, 1, 0, 1));
     }
 }
 
+void CameraCullingDemo::onTouchesEnded(const std::vector<Touch*>& touches, ax::Event* event)
+{
+    auto camera   = _cameraType == CameraType::FirstPerson ? _cameraFirst : _cameraThird;
+    auto location = touches[0]->getLocationInView();
+    Vec3 nearP(location.x, location.y, 0.0f), farP(location.x, location.y, 1.0f);
+    auto size = Director::getInstance()->getWinSize();
+    camera->unproject(size, &nearP, &nearP);
+    camera->unproject(size, &farP, &farP);
+
+    _picked = static_cast<MeshRenderer*>(getBoundsTree()->raycast(Ray(nearP, farP - nearP)));
+}
+
 void CameraCullingDemo::reachEndCallBack()
 {
     _cameraFirst->stopActionByTag(100);
@@ -877,6 +893,7 @@ void CameraCullingDemo::addMeshCallback(Object* sender)
     _layer3D->removeAllChildren();
     _objects.clear();
     _drawAABB->clear();
+    _picked = nullptr;
 
     ++_row;
     for (int x = -_row; x < _row; x++)
@@ -907,6 +924,7 @@ void CameraCullingDemo::delMeshCallback(Object* sender)
 
     _layer3D->removeAllChildren();
     _objects.clear();
+    _picked = nullptr;
 
     --_row;
     for (int x = -_row; x < _row; x++)
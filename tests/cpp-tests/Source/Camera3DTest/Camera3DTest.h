@@ -174,12 +174,14 @@ public:
 
     // overrides
     virtual std::string title() const override;
+    virtual std::string subtitle() const override;
     void reachEndCallBack();
     void switchViewCallback(ax::Object* sender);
     void addMeshCallback(ax::Object* sender);
     void delMeshCallback(ax::Object* sender);
 
     void drawCameraFrustum();
+    void onTouchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event);
 
 protected:
     ax::Label* _labelMeshCount;
@@ -191,6 +193,8 @@ protected:
     ax::MoveBy* _moveAction;
     ax::DrawNode3D* _drawAABB;
     ax::DrawNode3D* _drawFrustum;
+    ax::MeshRenderer* _picked = nullptr;
+    std::vector<ax::Node*> _visibleNodes;
     int _row;
 };
 
@@ -1350,6 +1350,8 @@ DrawNodeTests::DrawNodeTests()
     ADD_TEST_CASE(DrawNodeThicknessStressTest);
     ADD_TEST_CASE(DrawNodeLineDrawTest);
     ADD_TEST_CASE(DrawNodeIssueTester);
+    ADD_TEST_CASE(DrawNodeGroupsTest);
+    ADD_TEST_CASE(DrawNodeAnalyticShapesTest);
 }
 
 DrawNodeBaseTest::DrawNodeBaseTest()
@@ -3461,6 +3463,95 @@ string DrawNodeIssueTester::subtitle() const
     return "";
 }
 
+DrawNodeGroupsTest::DrawNodeGroupsTest()
+{
+    // the map is recorded once, every marker is a group redrawn on its own
+    drawNode->beginGroup("map");
+    for (int x = 0; x < 40; x++)
+        for (int y = 0; y < 24; y++)
+            drawNode->drawSolidRect(Vec2(x * 10.0f + 40, y * 10.0f + 20), Vec2(x * 10.0f + 49, y * 10.0f + 29),
+                                    Color4F(0.1f, 0.2f + 0.01f * y, 0.1f + 0.01f * x, 1.0f));
+    drawNode->endGroup();
+
+    for (int i = 0; i < 200; i++)
+        _markers.emplace_back(AXRANDOM_0_1() * 400 + 40, AXRANDOM_0_1() * 240 + 20);
+
+    // the sweep is redrawn every frame, its vertices are streamed into the renderer ring buffer
+    _radar = DrawNode::create();
+    _radar->setTransient(true);
+    addChild(_radar, 10);
+
+    scheduleUpdate();
+}
+
+void DrawNodeGroupsTest::update(float dt)
+{
+    DrawNodeBaseTest::update(dt);
+    _time += dt;
+
+    // only a tenth of the markers move every frame
+    int frame = static_cast<int>(_time * 60);
+    for (size_t i = frame % 10; i < _markers.size(); i += 10)
+    {
+        auto& marker = _markers[i];
+        marker.x     = 40 + fmodf(marker.x - 40 + 2, 400);
+
+        drawNode->beginGroup(fmt::format("marker{}", i));
+        drawNode->drawDot(marker, 3.0f + (i % 3), Color4F::RED);
+        drawNode->endGroup();
+    }
+
+    Vec2 sweepCenter(240, 140);
+    _radar->clear();
+    for (int i = 0; i < 8; i++)
+    {
+        float angle = _time * 2 - i * 0.05f;
+        _radar->drawLine(sweepCenter, sweepCenter + Vec2(cosf(angle), sinf(angle)) * 120,
+                         Color4F(0, 1, 0, 1 - i / 8.0f), 2);
+    }
+}
+
+string DrawNodeGroupsTest::title() const
+{
+    return "Groups and transient geometry";
+}
+
+string DrawNodeGroupsTest::subtitle() const
+{
+    return "Only the moving markers are uploaded again";
+}
+
+DrawNodeAnalyticShapesTest::DrawNodeAnalyticShapesTest()
+{
+    // the same shapes tessellated on the left, and analytic on the right
+    auto analytic = DrawNode::create();
+    analytic->setAnalyticShapes(true);
+    analytic->setPosition(Vec2(240, 0));
+    addChild(analytic);
+
+    for (auto&& node : {drawNode, analytic})
+    {
+        node->drawSolidCircle(Vec2(60, 240), 30, 0, 100, 1.0f, 1.0f, Color4F::ORANGE, 2, Color4F::WHITE);
+        node->drawCircle(Vec2(140, 240), 30, 0, 100, false, Color4F::GREEN, 4);
+        node->drawSegment(Vec2(30, 160), Vec2(170, 190), 12, Color4F::BLUE);
+        node->drawSegment(Vec2(30, 130), Vec2(170, 130), 12, Color4F::MAGENTA, DrawNode::EndType::Square,
+                          DrawNode::EndType::Butt);
+        node->drawSolidRoundedRect(Vec2(30, 40), Vec2(170, 100), 16, Color4F::GRAY, 2, Color4F::YELLOW);
+        for (int i = 0; i < 10; i++)
+            node->drawSolidCircle(Vec2(25 + i * 16, 20), 2 + i * 0.5f, 0, 12, Color4F::RED);
+    }
+}
+
+string DrawNodeAnalyticShapesTest::title() const
+{
+    return "Analytic shapes";
+}
+
+string DrawNodeAnalyticShapesTest::subtitle() const
+{
+    return "Tessellated (left) vs one quad per shape (right)";
+}
+
 DrawNodeSpLinesTest::DrawNodeSpLinesTest()
 {
     auto listener            = EventListenerTouchAllAtOnce::create();
@@ -381,6 +381,35 @@ private:
     float threshold = 0;
 };
 
+class DrawNodeGroupsTest : public DrawNodeBaseTest
+{
+public:
+    CREATE_FUNC(DrawNodeGroupsTest);
+
+    DrawNodeGroupsTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void update(float dt);
+
+private:
+    ax::DrawNode* _radar = nullptr;
+    std::vector<ax::Vec2> _markers;
+    float _time = 0.0f;
+};
+
+class DrawNodeAnalyticShapesTest : public DrawNodeBaseTest
+{
+public:
+    CREATE_FUNC(DrawNodeAnalyticShapesTest);
+
+    DrawNodeAnalyticShapesTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 
 class DrawNodeThicknessStressTest : public DrawNodeBaseTest
 {
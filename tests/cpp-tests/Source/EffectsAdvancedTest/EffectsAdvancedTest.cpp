@@ -45,6 +45,7 @@ EffectAdvanceTests::EffectAdvanceTests()
     ADD_TEST_CASE(Effect4);
     ADD_TEST_CASE(Effect5);
     ADD_TEST_CASE(Issue631);
+    ADD_TEST_CASE(ShaderGridEffects);
 }
 
 //------------------------------------------------------------------
@@ -242,6 +243,45 @@ void Effect5::onExit()
     Director::getInstance()->setProjection(Director::Projection::_3D);
 }
 
+//------------------------------------------------------------------
+//
+// ShaderGridEffects
+//
+//------------------------------------------------------------------
+void ShaderGridEffects::onEnter()
+{
+    EffectAdvanceBaseTest::onEnter();
+
+    auto onGPU = [](GridAction* action) {
+        action->setShaderEffectEnabled(true);
+        return action;
+    };
+
+    // a grid this dense would take most of the frame with the effects computed on the CPU
+    auto size     = Director::getInstance()->getWinSize();
+    auto gridSize = Size(160, 120);
+    auto effects  = Sequence::create(onGPU(Waves3D::create(4, gridSize, 5, 40)),
+                                     onGPU(Ripple3D::create(4, gridSize, size / 2, 240, 4, 160)),
+                                     onGPU(Twirl::create(4, gridSize, size / 2, 1, 2.5f)),
+                                     onGPU(Liquid::create(4, gridSize, 4, 20)),
+                                     onGPU(Waves::create(4, gridSize, 4, 20, true, true)),
+                                     onGPU(PageTurn3D::create(4, gridSize)), nullptr);
+    _bgNode->runAction(RepeatForever::create(effects));
+
+    _target1->runAction(RepeatForever::create(onGPU(WavesTiles3D::create(4, Size(40, 30), 4, 120))));
+    _target2->runAction(RepeatForever::create(onGPU(JumpTiles3D::create(4, Size(40, 30), 2, 30))));
+}
+
+std::string ShaderGridEffects::title() const
+{
+    return "Grid effects in the vertex shader";
+}
+
+std::string ShaderGridEffects::subtitle() const
+{
+    return "A 160x120 grid, the vertices are only uploaded once";
+}
+
 //------------------------------------------------------------------
 //
 // Effect5
@@ -90,6 +90,15 @@ public:
     virtual std::string title() const override;
 };
 
+class ShaderGridEffects : public EffectAdvanceBaseTest
+{
+public:
+    CREATE_FUNC(ShaderGridEffects);
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class Issue631 : public EffectAdvanceBaseTest
 {
 public:
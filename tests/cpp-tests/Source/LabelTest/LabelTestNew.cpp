@@ -170,6 +170,9 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelAsyncGlyphsTest);
+    ADD_TEST_CASE(LabelTextBatchingTest);
+    ADD_TEST_CASE(LabelSystemFontGlyphCacheTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3833,3 +3836,185 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color3B&
             letter->setColor(color);
     }
 }
+
+//
+// LabelAsyncGlyphsTest
+//
+LabelAsyncGlyphsTest::LabelAsyncGlyphsTest()
+{
+    auto center = VisibleRect::center();
+
+    TTFConfig ttfConfig("fonts/HKYuanMini.ttf", 40, GlyphCollection::DYNAMIC);
+    _label = Label::createWithTTF(ttfConfig, "你好，Axmol Label.");
+    _label->setPosition(center.x, center.y + 20);
+    addChild(_label);
+
+    _stateLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _stateLabel->setPosition(center.x, center.y - 40);
+    addChild(_stateLabel);
+
+    schedule(AX_CALLBACK_1(LabelAsyncGlyphsTest::nextString, this), 0.5f, "next_string");
+}
+
+void LabelAsyncGlyphsTest::onEnter()
+{
+    AtlasDemoNew::onEnter();
+    FontAtlas::setAsyncRasterizationEnabled(true);
+}
+
+void LabelAsyncGlyphsTest::onExit()
+{
+    FontAtlas::setAsyncRasterizationEnabled(false);
+    AtlasDemoNew::onExit();
+}
+
+void LabelAsyncGlyphsTest::nextString(float /*dt*/)
+{
+    static const char* strings[] = {
+        "早上好，Axmol Label.",
+        "中国 123 你好",
+        "美好的一天啊美好的一天啊",
+        "你好，Axmol Label.",
+    };
+    _label->setString(strings[_index++ % std::size(strings)]);
+
+    auto atlas = _label->getFontAtlas();
+    _stateLabel->setString(atlas && atlas->hasPendingLetters() ? "rasterizing on a worker" : "all glyphs ready");
+}
+
+std::string LabelAsyncGlyphsTest::title() const
+{
+    return "Background glyph rasterization";
+}
+
+std::string LabelAsyncGlyphsTest::subtitle() const
+{
+    return "The text changes once its new glyphs are in the atlas";
+}
+
+//
+// LabelTextBatchingTest
+//
+LabelTextBatchingTest::LabelTextBatchingTest()
+{
+    static const Color4B colors[] = {Color4B::WHITE, Color4B::YELLOW, Color4B::GREEN, Color4B::ORANGE};
+
+    auto visibleRect  = VisibleRect::getVisibleRect();
+    const int columns = 15;
+    const int rows    = 20;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            auto label = Label::createWithTTF("0", "fonts/arial.ttf", 12);
+            label->setTextColor(colors[(row + column) % std::size(colors)]);
+            label->setTextBatchingEnabled(_batching);
+            label->setPosition(visibleRect.origin.x + visibleRect.size.width * (column + 0.5f) / columns,
+                               visibleRect.origin.y + visibleRect.size.height * (0.15f + 0.65f * row / rows));
+            addChild(label);
+            _labels.push_back(label);
+        }
+    }
+
+    MenuItemFont::setFontSize(20);
+    auto toggle = MenuItemFont::create("Toggle batching", AX_CALLBACK_1(LabelTextBatchingTest::toggleBatching, this));
+    auto menu   = Menu::create(toggle, nullptr);
+    menu->setPosition(visibleRect.origin.x + visibleRect.size.width / 2,
+                      visibleRect.origin.y + visibleRect.size.height * 0.07f);
+    addChild(menu);
+
+    _stateLabel = Label::createWithTTF("batching", "fonts/arial.ttf", 16);
+    _stateLabel->setPosition(visibleRect.origin.x + visibleRect.size.width / 2,
+                             visibleRect.origin.y + visibleRect.size.height * 0.85f);
+    addChild(_stateLabel);
+
+    schedule(AX_CALLBACK_1(LabelTextBatchingTest::updateCounters, this), "update_counters");
+}
+
+void LabelTextBatchingTest::toggleBatching(Object* /*sender*/)
+{
+    _batching = !_batching;
+    for (auto&& label : _labels)
+        label->setTextBatchingEnabled(_batching);
+    _stateLabel->setString(_batching ? "batching" : "one draw per label");
+}
+
+void LabelTextBatchingTest::updateCounters(float /*dt*/)
+{
+    ++_frame;
+    for (size_t index = 0; index < _labels.size(); ++index)
+        _labels[index]->setString(fmt::format("{}", (_frame + static_cast<int>(index) * 7) % 1000));
+}
+
+std::string LabelTextBatchingTest::title() const
+{
+    return "Text batching";
+}
+
+std::string LabelTextBatchingTest::subtitle() const
+{
+    return "300 labels on one font atlas, compare the draw calls in the stats";
+}
+
+//
+// LabelSystemFontGlyphCacheTest
+//
+LabelSystemFontGlyphCacheTest::LabelSystemFontGlyphCacheTest()
+{
+    auto visibleRect  = VisibleRect::getVisibleRect();
+    const int columns = 10;
+    const int rows    = 12;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            auto label = Label::createWithSystemFont("0", "Arial", 14);
+            label->setSystemFontGlyphCacheEnabled(_glyphCache);
+            label->setTextBatchingEnabled(true);
+            label->setPosition(visibleRect.origin.x + visibleRect.size.width * (column + 0.5f) / columns,
+                               visibleRect.origin.y + visibleRect.size.height * (0.15f + 0.65f * row / rows));
+            addChild(label);
+            _labels.push_back(label);
+        }
+    }
+
+    MenuItemFont::setFontSize(20);
+    auto toggle = MenuItemFont::create("Toggle glyph cache",
+                                       AX_CALLBACK_1(LabelSystemFontGlyphCacheTest::toggleGlyphCache, this));
+    auto menu   = Menu::create(toggle, nullptr);
+    menu->setPosition(visibleRect.origin.x + visibleRect.size.width / 2,
+                      visibleRect.origin.y + visibleRect.size.height * 0.07f);
+    addChild(menu);
+
+    _stateLabel = Label::createWithTTF("glyph cache", "fonts/arial.ttf", 16);
+    _stateLabel->setPosition(visibleRect.origin.x + visibleRect.size.width / 2,
+                             visibleRect.origin.y + visibleRect.size.height * 0.85f);
+    addChild(_stateLabel);
+
+    schedule(AX_CALLBACK_1(LabelSystemFontGlyphCacheTest::updateCounters, this), "update_counters");
+}
+
+void LabelSystemFontGlyphCacheTest::toggleGlyphCache(Object* /*sender*/)
+{
+    _glyphCache = !_glyphCache;
+    for (auto&& label : _labels)
+        label->setSystemFontGlyphCacheEnabled(_glyphCache);
+    _stateLabel->setString(_glyphCache ? "glyph cache" : "one texture per label");
+}
+
+void LabelSystemFontGlyphCacheTest::updateCounters(float /*dt*/)
+{
+    ++_frame;
+    for (size_t index = 0; index < _labels.size(); ++index)
+        _labels[index]->setString(fmt::format("{} ms", (_frame + static_cast<int>(index) * 7) % 1000));
+}
+
+std::string LabelSystemFontGlyphCacheTest::title() const
+{
+    return "System font glyph cache";
+}
+
+std::string LabelSystemFontGlyphCacheTest::subtitle() const
+{
+    return "120 system font labels changing every frame, compare the draw calls and the texture memory";
+}
@@ -1043,4 +1043,64 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color3B& color);
 };
 
+class LabelAsyncGlyphsTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelAsyncGlyphsTest);
+
+    LabelAsyncGlyphsTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void nextString(float dt);
+
+    ax::Label* _label      = nullptr;
+    ax::Label* _stateLabel = nullptr;
+    int _index             = 0;
+};
+
+class LabelTextBatchingTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelTextBatchingTest);
+
+    LabelTextBatchingTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void toggleBatching(ax::Object* sender);
+    void updateCounters(float dt);
+
+    std::vector<ax::Label*> _labels;
+    ax::Label* _stateLabel = nullptr;
+    bool _batching         = true;
+    int _frame             = 0;
+};
+
+class LabelSystemFontGlyphCacheTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelSystemFontGlyphCacheTest);
+
+    LabelSystemFontGlyphCacheTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void toggleGlyphCache(ax::Object* sender);
+    void updateCounters(float dt);
+
+    std::vector<ax::Label*> _labels;
+    ax::Label* _stateLabel = nullptr;
+    bool _glyphCache       = true;
+    int _frame             = 0;
+};
+
 #endif
@@ -29,6 +29,8 @@ using namespace ax;
 LightTests::LightTests()
 {
     ADD_TEST_CASE(LightTest);
+    ADD_TEST_CASE(LightClusterTest);
+    ADD_TEST_CASE(ShadowMapTest);
 }
 
 LightTest::LightTest() : _directionalLight(nullptr), _pointLight(nullptr), _spotLight(nullptr)
@@ -305,3 +307,183 @@ void LightTest::SwitchLight(Object* sender, LightType lightType)
         break;
     }
 }
+
+LightClusterTest::LightClusterTest()
+{
+    auto s      = Director::getInstance()->getWinSize();
+    auto camera = Camera::createPerspective(60, (float)s.width / s.height, 1.0f, 1000.0f);
+    camera->setCameraFlag(CameraFlag::USER1);
+    camera->setPosition3D(Vec3(0.0f, 120.0f, 160.0f));
+    camera->lookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+    addChild(camera);
+
+    for (int z = -5; z <= 5; ++z)
+    {
+        for (int x = -5; x <= 5; ++x)
+        {
+            auto mesh = MeshRenderer::create("MeshRendererTest/sphere.c3b");
+            auto material = MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::DIFFUSE_CLUSTERED, false);
+            mesh->setMaterial(material);
+            mesh->setScale(0.6f);
+            mesh->setPosition3D(Vec3(x * 20.0f, 0.0f, z * 20.0f));
+            mesh->setCameraMask(2);
+            addChild(mesh);
+        }
+    }
+
+    auto ambientLight = AmbientLight::create(Color3B(40, 40, 40));
+    ambientLight->setCameraMask(2);
+    addChild(ambientLight);
+
+    const Color3B colors[] = {Color3B::RED, Color3B::GREEN, Color3B::BLUE, Color3B::YELLOW, Color3B::MAGENTA,
+                              Color3B::ORANGE};
+    for (int i = 0; i < 48; ++i)
+    {
+        auto light = PointLight::create(Vec3::ZERO, colors[i % 6], 30.0f);
+        light->setCameraMask(2);
+        addChild(light);
+        _lights.emplace_back(light);
+    }
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    _label->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _label->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::top().y - 50));
+    addChild(_label);
+
+    scheduleUpdate();
+}
+
+std::string LightClusterTest::title() const
+{
+    return "Clustered Lights";
+}
+
+std::string LightClusterTest::subtitle() const
+{
+    return LightClusters::isSupported() ? "48 point lights, each mesh evaluates only the lights of its froxels"
+                                        : "Clustered lights not supported, using the light uniforms";
+}
+
+void LightClusterTest::update(float delta)
+{
+    _time += delta;
+    for (size_t i = 0; i < _lights.size(); ++i)
+    {
+        // three rings orbiting in opposite directions
+        float ring  = 30.0f + 25.0f * (i % 3);
+        float angle  = _time * (i % 2 ? 0.5f : -0.4f) + i * 2.0f * M_PI / _lights.size();
+        _lights[i]->setPosition3D(Vec3(ring * cosf(angle), 8.0f, ring * sinf(angle)));
+    }
+
+    auto clusters = LightClusters::getInstance();
+    _label->setString(fmt::format("lights: {}  cluster entries: {}", clusters->getLightCount(),
+                                  clusters->getIndexCount()));
+}
+
+ShadowMapTest::ShadowMapTest()
+{
+    auto s      = Director::getInstance()->getWinSize();
+    auto camera = Camera::createPerspective(60, (float)s.width / s.height, 1.0f, 1000.0f);
+    camera->setCameraFlag(CameraFlag::USER1);
+    camera->setPosition3D(Vec3(0.0f, 60.0f, 90.0f));
+    camera->lookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+    addChild(camera);
+
+    auto material = [] {
+        return MeshMaterial::createBuiltInMaterial(MeshMaterial::MaterialType::DIFFUSE_CLUSTERED, false);
+    };
+
+    // a flat box as the ground, scaled from its bounds
+    auto ground = MeshRenderer::create("MeshRendererTest/box.c3t");
+    auto size   = ground->getAABB()._max - ground->getAABB()._min;
+    ground->setMaterial(material());
+    ground->setScaleX(300.0f / size.x);
+    ground->setScaleY(1.0f / size.y);
+    ground->setScaleZ(300.0f / size.z);
+    ground->setPosition3D(Vec3(0.0f, -0.5f, 0.0f));
+    ground->setCameraMask(2);
+    addChild(ground);
+
+    // static casters, their cascades are only drawn again when the camera moves
+    for (int z = -3; z <= 3; ++z)
+    {
+        for (int x = -3; x <= 3; ++x)
+        {
+            auto mesh = MeshRenderer::create(x % 2 ? "MeshRendererTest/sphere.c3b" : "MeshRendererTest/box.c3t");
+            mesh->setMaterial(material());
+            mesh->setScale(x % 2 ? 0.4f : 3.0f);
+            mesh->setPosition3D(Vec3(x * 18.0f, 4.0f, z * 18.0f));
+            mesh->setCastShadow(true);
+            mesh->setCameraMask(2);
+            addChild(mesh);
+        }
+    }
+
+    _mover = MeshRenderer::create("MeshRendererTest/teapot.c3b");
+    _mover->setMaterial(material());
+    _mover->setScale(5.0f);
+    _mover->setCastShadow(true);
+    _mover->setCameraMask(2);
+    addChild(_mover);
+
+    auto ambientLight = AmbientLight::create(Color3B(60, 60, 60));
+    ambientLight->setCameraMask(2);
+    addChild(ambientLight);
+
+    auto light = DirectionLight::create(Vec3(-1.0f, -2.0f, -0.6f), Color3B(220, 220, 200));
+    light->setCameraMask(2);
+    addChild(light);
+
+    _shadowMap = CascadedShadowMap::create(light, 3, 1024);
+    _shadowMap->setShadowDistance(200.0f);
+    _shadowMap->setCameraMask(2);
+    addChild(_shadowMap);
+
+    auto item = MenuItemFont::create("Motion: on", AX_CALLBACK_1(ShadowMapTest::switchMotionCallback, this));
+    item->setColor(Color3B(0, 200, 20));
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    item->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    item->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::top().y - 50));
+    addChild(menu, 1);
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    _label->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _label->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::top().y - 80));
+    addChild(_label);
+
+    scheduleUpdate();
+}
+
+std::string ShadowMapTest::title() const
+{
+    return "Cascaded Shadow Map";
+}
+
+std::string ShadowMapTest::subtitle() const
+{
+    return CascadedShadowMap::isSupported() ? "The cascades are cached while their casters don't move"
+                                            : "Shadow maps not supported";
+}
+
+void ShadowMapTest::switchMotionCallback(Object* sender)
+{
+    _moving = !_moving;
+    static_cast<MenuItemFont*>(sender)->setString(_moving ? "Motion: on" : "Motion: off");
+}
+
+void ShadowMapTest::update(float delta)
+{
+    if (_moving)
+    {
+        _time += delta;
+        _mover->setPosition3D(Vec3(30.0f * cosf(_time * 0.5f), 8.0f, 30.0f * sinf(_time * 0.5f)));
+        _mover->setRotation3D(Vec3(0.0f, -_time * 0.5f * 180.0f / M_PI, 0.0f));
+    }
+
+    std::string text;
+    for (int i = 0; i < _shadowMap->getCascadeCount(); ++i)
+        text += fmt::format("cascade {}: {} casters, drawn {} times\n", i, _shadowMap->getCasterCount(i),
+                            _shadowMap->getDrawCount(i));
+    _label->setString(text);
+}
@@ -59,4 +59,43 @@ private:
     ax::Label* _spotLightLabel;
 };
 
+// dozens of point lights on a grid of meshes with the clustered diffuse material
+class LightClusterTest : public TestCase
+{
+public:
+    CREATE_FUNC(LightClusterTest);
+    LightClusterTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float delta) override;
+
+private:
+    std::vector<ax::PointLight*> _lights;
+    ax::Label* _label = nullptr;
+    float _time       = 0.0f;
+};
+
+class ShadowMapTest : public TestCase
+{
+public:
+    CREATE_FUNC(ShadowMapTest);
+    ShadowMapTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float delta) override;
+
+private:
+    void switchMotionCallback(ax::Object* sender);
+
+    ax::CascadedShadowMap* _shadowMap = nullptr;
+    ax::MeshRenderer* _mover          = nullptr;
+    ax::Label* _label                 = nullptr;
+    float _time                       = 0.0f;
+    bool _moving                      = true;
+};
+
 #endif
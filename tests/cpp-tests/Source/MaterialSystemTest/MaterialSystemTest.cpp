@@ -27,6 +27,7 @@
 #include "MaterialSystemTest.h"
 
 #include <ctime>
+#include <chrono>
 #include <spine/spine-cocos2dx.h>
 
 #include "../testResource.h"
@@ -45,6 +46,7 @@ MaterialSystemTest::MaterialSystemTest()
     ADD_TEST_CASE(Material_AutoBindings);
     ADD_TEST_CASE(Material_setTechnique);
     ADD_TEST_CASE(Material_clone);
+    ADD_TEST_CASE(Material_asyncLoad);
     ADD_TEST_CASE(Material_MultipleMeshRenderer);
     ADD_TEST_CASE(Material_MeshRendererTest);
     ADD_TEST_CASE(Material_parsePerformance);
@@ -391,6 +393,70 @@ std::string Material_clone::subtitle() const
     return "Testing material->clone()";
 }
 
+//
+//
+//
+void Material_asyncLoad::onEnter()
+{
+    MaterialSystemBaseTest::onEnter();
+
+    // parsed again, the cached prototype would call back immediately
+    Material::removeCachedMaterial("Materials/3d_effects.material");
+
+    // the model and the material are loaded in parallel on the job system, the test is kept until both are
+    retain();
+    retain();
+    MeshRenderer::createAsync(
+        "MeshRendererTest/boss1.obj",
+        [this](MeshRenderer* mesh, void*) {
+        _mesh = mesh;
+        onLoaded();
+        release();
+    },
+        nullptr);
+    Material::createWithFilenameAsync("Materials/3d_effects.material", [this](Material* material) {
+        _material = material;
+        onLoaded();
+        release();
+    });
+}
+
+void Material_asyncLoad::onLoaded()
+{
+    if (!_mesh || !_material)
+        return;
+
+    // one material per mesh, the clones of the cached prototype share its uniforms until they change them
+    const char* techniques[] = {"lit", "normal", "outline"};
+    const int columns = 8, rows = 4;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto mesh = i == 0 ? _mesh.get() : MeshRenderer::create("MeshRendererTest/boss1.obj");
+        mesh->setScale(1.5f);
+        mesh->setPositionNormalized(Vec2((i % columns + 0.5f) / columns, (i / columns + 0.5f) / (rows + 1)));
+        addChild(mesh);
+
+        auto material = i == 0 ? _material.get() : Material::createWithFilename("Materials/3d_effects.material");
+        material->setTechnique(techniques[i % 3]);
+        mesh->setMaterial(material);
+        mesh->runAction(RepeatForever::create(RotateBy::create(5, Vec3(30.0f, 60.0f, 270.0f))));
+    }
+    auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto label = Label::createWithSystemFont(
+        fmt::format("{} meshes with their own material created in {:.2f} ms", columns * rows, elapsed), "Helvetica",
+        10);
+    label->setPositionNormalized(Vec2(0.5f, 0.9f));
+    addChild(label);
+}
+
+std::string Material_asyncLoad::subtitle() const
+{
+    return "Loading a model and a material asynchronously";
+}
+
 //
 //
 //
@@ -450,6 +516,9 @@ void Material_parsePerformance::onEnter()
 
 void Material_parsePerformance::parsingTesting(unsigned int count)
 {
+    // the files are parsed by the first calls, the others clone the cached materials
+    Material::purgeCachedData();
+
     std::clock_t begin = std::clock();
 
     for (unsigned int i = 0; i < count; i++)
@@ -123,6 +123,21 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class Material_asyncLoad : public MaterialSystemBaseTest
+{
+public:
+    CREATE_FUNC(Material_asyncLoad);
+
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+
+private:
+    void onLoaded();
+
+    ax::RefPtr<ax::MeshRenderer> _mesh;
+    ax::RefPtr<ax::Material> _material;
+};
+
 class Material_parsePerformance : public MaterialSystemBaseTest
 {
 public:
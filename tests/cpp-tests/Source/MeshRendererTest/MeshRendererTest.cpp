@@ -33,6 +33,7 @@
 #include "Particle3D/PU/PUParticleSystem3D.h"
 
 #include <algorithm>
+#include <chrono>
 #include "../testResource.h"
 
 using namespace ax;
@@ -44,6 +45,8 @@ MeshRendererTests::MeshRendererTests()
     ADD_TEST_CASE(MeshRendererDynamicInstancingBasicTest);
     ADD_TEST_CASE(MeshRendererPreallocatedInstancingBufferTest);
     ADD_TEST_CASE(MeshRendererInstancingStressTest);
+    ADD_TEST_CASE(MeshRendererInstanceCullingTest);
+    ADD_TEST_CASE(MeshRendererInstanceTransformsTest);
     ADD_TEST_CASE(MeshRendererHitTest);
     ADD_TEST_CASE(AsyncLoadMeshRendererTest);
     //    // 3DEffect use custom shader which is not supported on WP8/WinRT yet.
@@ -54,6 +57,10 @@ MeshRendererTests::MeshRendererTests()
     ADD_TEST_CASE(MeshRendererLightMapTest);
     ADD_TEST_CASE(MeshRendererWithSkinTest);
     ADD_TEST_CASE(MeshRendererWithSkinOutlineTest);
+    ADD_TEST_CASE(MeshRendererSkinnedCrowdTest);
+    ADD_TEST_CASE(MeshRendererMeshBundleTest);
+    ADD_TEST_CASE(MeshRendererLODGroupTest);
+    ADD_TEST_CASE(MeshRendererStaticBatchTest);
     ADD_TEST_CASE(Animate3DTest);
     ADD_TEST_CASE(AttachmentTest);
     ADD_TEST_CASE(MeshRendererReskinTest);
@@ -400,6 +407,126 @@ std::string MeshRendererInstancingStressTest::subtitle() const
     return "10000 instances of the same mesh";
 }
 
+//------------------------------------------------------------------
+//
+// MeshRendererInstanceCullingTest
+//
+//------------------------------------------------------------------
+
+MeshRendererInstanceCullingTest::MeshRendererInstanceCullingTest()
+{
+    auto mesh = MeshRenderer::create("MeshRendererTest/boss1.obj");
+    mesh->setScale(3.f);
+    mesh->setTexture("MeshRendererTest/boss.png");
+
+    auto& s = Director::getInstance()->getWinSize();
+    mesh->setPosition(s.width / 2, s.height / 2);
+
+    mesh->enableInstancing(ax::MeshMaterial::InstanceMaterialType::UNLIT_INSTANCE, 10000);
+    mesh->setInstanceCulling(true);
+
+    // spread over three screens in each direction, most instances are out of view
+    FastRNG r{};
+
+    for (int i = 0; i < 10000; i++)
+    {
+        auto inst = Node::create();
+        inst->setPosition(s.width * r.rangef(), s.height * r.rangef());
+        inst->setRotation(r.maxf(360));
+        mesh->addInstanceChild(inst, false);
+    }
+
+    auto move = MoveBy::create(4, Vec2(s.width * 2, 0));
+    auto pan  = Sequence::create(move, move->reverse(), move->reverse(), move->clone(), nullptr);
+    mesh->runAction(RepeatForever::create(pan));
+
+    addChild(mesh);
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    label->setPosition(s.width / 2, s.height / 6);
+    addChild(label);
+
+    schedule(
+        [mesh, label](float) {
+            label->setString(fmt::format("drawn instances: {}", mesh->getMeshByIndex(0)->getVisibleInstanceCount()));
+        },
+        "instanceCount");
+}
+
+std::string MeshRendererInstanceCullingTest::title() const
+{
+    return "Testing Instance Culling";
+}
+
+std::string MeshRendererInstanceCullingTest::subtitle() const
+{
+    return "10000 instances, only those in view are drawn";
+}
+
+//------------------------------------------------------------------
+//
+// MeshRendererInstanceTransformsTest
+//
+//------------------------------------------------------------------
+static constexpr int INSTANCE_GRID_SIZE = 100;
+
+MeshRendererInstanceTransformsTest::MeshRendererInstanceTransformsTest()
+{
+    _mesh = MeshRenderer::create("MeshRendererTest/boss1.obj");
+    _mesh->setScale(0.5f);
+    _mesh->setTexture("MeshRendererTest/boss.png");
+
+    auto& s = Director::getInstance()->getWinSize();
+    _mesh->setPosition(s.width / 2, s.height / 2);
+    addChild(_mesh);
+
+    _transforms.resize(INSTANCE_GRID_SIZE * INSTANCE_GRID_SIZE);
+    _colors.resize(_transforms.size());
+    for (int y = 0; y < INSTANCE_GRID_SIZE; ++y)
+    {
+        for (int x = 0; x < INSTANCE_GRID_SIZE; ++x)
+        {
+            float u = x / float(INSTANCE_GRID_SIZE - 1);
+            float v = y / float(INSTANCE_GRID_SIZE - 1);
+            _colors[y * INSTANCE_GRID_SIZE + x] = Color4F(u, v, 1.f - u, 1.f);
+        }
+    }
+
+    updateInstances(0);
+    schedule(AX_SCHEDULE_SELECTOR(MeshRendererInstanceTransformsTest::updateInstances));
+}
+
+void MeshRendererInstanceTransformsTest::updateInstances(float dt)
+{
+    _time += dt;
+
+    auto& s        = Director::getInstance()->getWinSize();
+    float spacingX = s.width * 2.f / INSTANCE_GRID_SIZE;
+    float spacingY = s.height * 2.f / INSTANCE_GRID_SIZE;
+    for (int y = 0; y < INSTANCE_GRID_SIZE; ++y)
+    {
+        for (int x = 0; x < INSTANCE_GRID_SIZE; ++x)
+        {
+            auto& mat = _transforms[y * INSTANCE_GRID_SIZE + x];
+            Mat4::createTranslation((x - INSTANCE_GRID_SIZE / 2) * spacingX, (y - INSTANCE_GRID_SIZE / 2) * spacingY,
+                                    std::sin(_time * 2.f + (x + y) * 0.2f) * 40.f, &mat);
+            mat.rotateY(_time + x * 0.1f);
+        }
+    }
+
+    _mesh->setInstanceTransforms(_transforms, _colors);
+}
+
+std::string MeshRendererInstanceTransformsTest::title() const
+{
+    return "Testing Instance Transforms";
+}
+
+std::string MeshRendererInstanceTransformsTest::subtitle() const
+{
+    return "10000 colored instances from one array, one draw";
+}
+
 //------------------------------------------------------------------
 //
 // MeshRendererUVAnimationTest
@@ -1117,6 +1244,263 @@ void MeshRendererWithSkinTest::addNewMeshWithCoords(Vec2 p)
     }
 }
 
+//------------------------------------------------------------------
+//
+// MeshRendererSkinnedCrowdTest
+//
+//------------------------------------------------------------------
+static const std::vector<Animate3D::LODLevel> CROWD_LOD_LEVELS = {{150.f, 2}, {300.f, 4}};
+
+MeshRendererSkinnedCrowdTest::MeshRendererSkinnedCrowdTest()
+{
+    auto s      = Director::getInstance()->getWinSize();
+    auto camera = Camera::createPerspective(60, s.width / s.height, 1.0f, 1000.0f);
+    camera->setCameraFlag(CameraFlag::USER1);
+    camera->setPosition3D(Vec3(0.0f, 60.0f, 80.0f));
+    camera->lookAt(Vec3(0.0f, 0.0f, -200.0f));
+    addChild(camera);
+
+    std::string fileName = "MeshRendererTest/orc.c3b";
+    auto animation       = Animation3D::create(fileName);
+    if (animation)
+        animation->bake();
+
+    // 200 characters, from close to the camera to far away
+    for (int z = 0; z < 20; ++z)
+    {
+        for (int x = 0; x < 10; ++x)
+        {
+            auto mesh = MeshRenderer::create(fileName);
+            mesh->setPosition3D(Vec3((x - 4.5f) * 20.0f, 0.0f, -z * 25.0f));
+            mesh->setRotation3D(Vec3(0.0f, 180.0f, 0.0f));
+            mesh->setCameraMask((unsigned short)CameraFlag::USER1);
+            addChild(mesh);
+
+            if (animation)
+            {
+                auto animate = Animate3D::create(animation);
+                animate->setSpeed(0.8f + AXRANDOM_0_1() * 0.4f);
+                animate->setLODLevels(CROWD_LOD_LEVELS);
+                mesh->runAction(RepeatForever::create(animate));
+                _animates.emplace_back(animate);
+            }
+        }
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(15);
+    auto item = MenuItemFont::create("LOD: on", AX_CALLBACK_1(MeshRendererSkinnedCrowdTest::switchLODCallback, this));
+    item->setColor(Color3B(0, 200, 20));
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    item->setPosition(VisibleRect::left().x + 50, VisibleRect::top().y - 70);
+    addChild(menu, 1);
+
+    auto label = Label::createWithTTF(
+        BonePalette::isSupported() ? "bone palette texture" : "uniform bone palettes", "fonts/arial.ttf", 16);
+    label->setPosition(s.width / 2, s.height / 6);
+    addChild(label, 1);
+}
+
+void MeshRendererSkinnedCrowdTest::switchLODCallback(Object* sender)
+{
+    _lodEnabled = !_lodEnabled;
+    for (auto&& animate : _animates)
+        animate->setLODLevels(_lodEnabled ? CROWD_LOD_LEVELS : std::vector<Animate3D::LODLevel>{});
+    static_cast<MenuItemFont*>(sender)->setString(_lodEnabled ? "LOD: on" : "LOD: off");
+}
+
+std::string MeshRendererSkinnedCrowdTest::title() const
+{
+    return "Testing Skinned Crowd";
+}
+
+std::string MeshRendererSkinnedCrowdTest::subtitle() const
+{
+    return "200 characters, distant ones animate at a lower rate";
+}
+
+//------------------------------------------------------------------
+//
+// MeshRendererMeshBundleTest
+//
+//------------------------------------------------------------------
+MeshRendererMeshBundleTest::MeshRendererMeshBundleTest()
+{
+    auto s               = Director::getInstance()->getWinSize();
+    std::string fileName = "MeshRendererTest/orc.c3b";
+    std::string c3mPath  = FileUtils::getInstance()->getWritablePath() + "orc.c3m";
+
+    if (!MeshBundle::convert(fileName, c3mPath))
+    {
+        auto label = Label::createWithTTF("convert failed", "fonts/arial.ttf", 16);
+        label->setPosition(s.width / 2, s.height / 2);
+        addChild(label);
+        return;
+    }
+
+    // measure the loads from the files, not from the cache
+    auto loadTimed = [](std::string_view path, double& ms) {
+        MeshRendererCache::getInstance()->removeMeshRenderData(path);
+        auto start = std::chrono::steady_clock::now();
+        auto mesh  = MeshRenderer::create(path);
+        ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return mesh;
+    };
+
+    double c3bTime = 0, c3mTime = 0;
+    auto c3b       = loadTimed(fileName, c3bTime);
+    auto c3m       = loadTimed(c3mPath, c3mTime);
+
+    int i = 0;
+    for (auto&& mesh : {c3b, c3m})
+    {
+        if (!mesh)
+            continue;
+        mesh->setScale(3.f);
+        mesh->setRotation3D(Vec3(0.0f, 180.0f, 0.0f));
+        mesh->setPosition(Vec2(s.width * (i + 1) / 3.f, s.height / 4.f));
+        addChild(mesh);
+
+        // the animations stay in the source model
+        auto animation = Animation3D::create(fileName);
+        if (animation)
+            mesh->runAction(RepeatForever::create(Animate3D::create(animation)));
+        ++i;
+    }
+
+    auto label = Label::createWithTTF(fmt::format("c3b: {:.2f} ms    c3m: {:.2f} ms", c3bTime, c3mTime),
+                                      "fonts/arial.ttf", 16);
+    label->setPosition(s.width / 2, s.height / 6);
+    addChild(label, 1);
+}
+
+std::string MeshRendererMeshBundleTest::title() const
+{
+    return "Testing MeshBundle";
+}
+
+std::string MeshRendererMeshBundleTest::subtitle() const
+{
+    return "orc.c3b converted to .c3m, left c3b, right c3m";
+}
+
+//------------------------------------------------------------------
+//
+// MeshRendererLODGroupTest
+//
+//------------------------------------------------------------------
+MeshRendererLODGroupTest::MeshRendererLODGroupTest()
+{
+    auto s               = Director::getInstance()->getWinSize();
+    std::string fileName = "MeshRendererTest/orc.c3b";
+
+    auto group = LODGroup::create();
+    group->setPosition(Vec2(s.width / 2, s.height / 4));
+    group->setFadeDuration(0.25f);
+    addChild(group);
+
+    // the lower levels are tinted to tell them apart
+    const struct
+    {
+        float ratio;
+        float minScreenSize;
+        Color3B color;
+    } levels[] = {{1.0f, 0.3f, Color3B::WHITE}, {0.5f, 0.15f, Color3B::YELLOW}, {0.2f, 0.05f, Color3B::RED}};
+    std::string triangles;
+    for (auto&& level : levels)
+    {
+        auto mesh = MeshRenderer::createSimplified(fileName, level.ratio);
+        if (!mesh)
+            continue;
+        mesh->setScale(3.f);
+        mesh->setRotation3D(Vec3(0.0f, 180.0f, 0.0f));
+        mesh->setColor(level.color);
+        group->addLevel(mesh, level.minScreenSize);
+
+        int count = 0;
+        for (auto&& it : mesh->getMeshes())
+            count += static_cast<int>(it->getIndexCount() / 3);
+        triangles += fmt::format("{} ", count);
+
+        auto animation = Animation3D::create(fileName);
+        if (animation)
+            mesh->runAction(RepeatForever::create(Animate3D::create(animation)));
+    }
+
+    auto move = MoveBy::create(4.0f, Vec3(0.0f, 0.0f, -2000.0f));
+    group->runAction(RepeatForever::create(Sequence::create(move, move->reverse(), nullptr)));
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    label->setPosition(s.width / 2, s.height / 6);
+    addChild(label, 1);
+    schedule(
+        [group, label, triangles](float) {
+        label->setString(fmt::format("level: {}  screen size: {:.3f}  triangles: {}", group->getCurrentLevel(),
+                                     group->getScreenSize(), triangles));
+    },
+        "lod_label");
+}
+
+std::string MeshRendererLODGroupTest::title() const
+{
+    return "Testing LODGroup";
+}
+
+std::string MeshRendererLODGroupTest::subtitle() const
+{
+    return "orc simplified to 50% and 20%, switched by screen size";
+}
+
+//------------------------------------------------------------------
+//
+// MeshRendererStaticBatchTest
+//
+//------------------------------------------------------------------
+MeshRendererStaticBatchTest::MeshRendererStaticBatchTest()
+{
+    auto s = Director::getInstance()->getWinSize();
+
+    // a grid of ships merged into the meshes of one batch, the model is loaded once
+    auto batch        = StaticBatch3D::create();
+    const int columns = 8;
+    const int rows    = 4;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            Mat4 transform;
+            Mat4::createTranslation((column - (columns - 1) * 0.5f) * 15.0f, 0.0f, -row * 20.0f, &transform);
+            transform.rotateY(AX_DEGREES_TO_RADIANS(column * 45.0f));
+            batch->addModel("MeshRendererTest/boss1.obj", transform);
+        }
+    }
+    batch->build();
+    batch->setTexture("MeshRendererTest/boss.png");
+    batch->setScale(3.f);
+    batch->setPosition(Vec2(s.width / 2, s.height / 3));
+    batch->setRotation3D(Vec3(20.0f, 0.0f, 0.0f));
+    addChild(batch);
+
+    batch->runAction(RepeatForever::create(RotateBy::create(8.0f, Vec3(0.0f, 360.0f, 0.0f))));
+
+    auto label = Label::createWithTTF(
+        fmt::format("{} meshes drawn as {}", batch->getSourceMeshCount(), batch->getMeshes().size()),
+        "fonts/arial.ttf", 16);
+    label->setPosition(s.width / 2, s.height / 6);
+    addChild(label, 1);
+}
+
+std::string MeshRendererStaticBatchTest::title() const
+{
+    return "Testing StaticBatch3D";
+}
+
+std::string MeshRendererStaticBatchTest::subtitle() const
+{
+    return "32 ships merged into shared buffers";
+}
+
 std::string MeshRendererWithSkinTest::getAnimationQualityMessage() const
 {
     if (_animateQuality == (int)Animate3DQuality::QUALITY_NONE)
@@ -116,6 +116,32 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class MeshRendererInstanceCullingTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererInstanceCullingTest);
+    MeshRendererInstanceCullingTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
+class MeshRendererInstanceTransformsTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererInstanceTransformsTest);
+    MeshRendererInstanceTransformsTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void updateInstances(float dt);
+
+    ax::MeshRenderer* _mesh = nullptr;
+    std::vector<ax::Mat4> _transforms;
+    std::vector<ax::Color4F> _colors;
+    float _time = 0;
+};
+
 class MeshRendererUVAnimationTest : public MeshRendererTestDemo
 {
 public:
@@ -273,6 +299,48 @@ private:
     ax::MenuItemFont* _menuItem;
 };
 
+class MeshRendererSkinnedCrowdTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererSkinnedCrowdTest);
+    MeshRendererSkinnedCrowdTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void switchLODCallback(ax::Object* sender);
+
+private:
+    std::vector<ax::Animate3D*> _animates;
+    bool _lodEnabled = true;
+};
+
+class MeshRendererMeshBundleTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererMeshBundleTest);
+    MeshRendererMeshBundleTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
+class MeshRendererLODGroupTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererLODGroupTest);
+    MeshRendererLODGroupTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
+class MeshRendererStaticBatchTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererStaticBatchTest);
+    MeshRendererStaticBatchTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class MeshRendererWithSkinOutlineTest : public MeshRendererTestDemo
 {
 public:
@@ -40,6 +40,7 @@ MotionStreakTests::MotionStreakTests()
     ADD_TEST_CASE(MotionStreakTest2);
     ADD_TEST_CASE(Issue1358);
     ADD_TEST_CASE(Issue12226);
+    ADD_TEST_CASE(MotionStreakManyTrails);
 }
 
 //------------------------------------------------------------------
@@ -229,6 +230,56 @@ std::string Issue12226::subtitle() const
     return "Image should look without artifacts";
 }
 
+//------------------------------------------------------------------
+//
+// MotionStreakManyTrails
+//
+//------------------------------------------------------------------
+
+void MotionStreakManyTrails::onEnter()
+{
+    MotionStreakTest::onEnter();
+
+    // every streak uploads its new point only, the fading is done by the vertex shader
+    const int count = 200;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto color = Color3B(AXRANDOM_0_1() * 255, AXRANDOM_0_1() * 255, AXRANDOM_0_1() * 255);
+        auto streak      = MotionStreak::create(0.5f, 2.0f, 6.0f, color, s_streak);
+        addChild(streak);
+        _streaks.pushBack(streak);
+    }
+    _streak = _streaks.front();
+
+    scheduleUpdate();
+}
+
+void MotionStreakManyTrails::update(float dt)
+{
+    _time += dt;
+
+    // projectiles on lissajous curves
+    auto size = Director::getInstance()->getWinSize();
+    for (ssize_t i = 0; i < _streaks.size(); ++i)
+    {
+        const float phase = i * 0.37f;
+        const float speed = 1.0f + (i % 7) * 0.15f;
+        _streaks.at(i)->setPosition(
+            Vec2(size.width * (0.5f + 0.4f * sinf(_time * speed + phase)),
+                 size.height * (0.5f + 0.4f * sinf(_time * speed * 1.3f + phase * 2.0f))));
+    }
+}
+
+std::string MotionStreakManyTrails::title() const
+{
+    return "Many trails";
+}
+
+std::string MotionStreakManyTrails::subtitle() const
+{
+    return "200 streaks, faded out on the GPU";
+}
+
 //------------------------------------------------------------------
 //
 // MotionStreakTest
@@ -98,4 +98,19 @@ public:
     virtual void onEnter() override;
 };
 
+class MotionStreakManyTrails : public MotionStreakTest
+{
+public:
+    CREATE_FUNC(MotionStreakManyTrails);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+    virtual void update(float dt) override;
+
+private:
+    ax::Vector<ax::MotionStreak*> _streaks;
+    float _time = 0;
+};
+
 #endif
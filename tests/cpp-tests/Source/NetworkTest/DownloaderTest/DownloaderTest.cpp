@@ -31,6 +31,7 @@
 #include "ui/UILoadingBar.h"
 #include "ui/UIButton.h"
 #include "network/Downloader.h"
+#include "network/RemoteTextureLoader.h"
 
 using namespace ax;
 
@@ -357,8 +358,66 @@ struct DownloaderMultiTask : public TestCase
     }
 };
 
+struct DownloaderRemoteTextures : public TestCase
+{
+    CREATE_FUNC(DownloaderRemoteTextures);
+
+    virtual std::string title() const override { return "Remote Textures"; }
+    virtual std::string subtitle() const override
+    {
+        return "a texture and an atlas sprite frame, cached on disk and revalidated";
+    }
+
+    virtual void onEnter() override
+    {
+        TestCase::onEnter();
+
+        auto loader = network::RemoteTextureLoader::getInstance();
+        loader->setCacheDirectory(FileUtils::getInstance()->getWritablePath() + "CppTests/RemoteTextures/");
+        loader->setRevalidate(true);
+
+        auto status = Label::createWithTTF("Loading...", "fonts/arial.ttf", 16);
+        status->setPosition(VisibleRect::bottom() + Vec2(0, 40));
+        addChild(status);
+
+        loader->loadTexture(sURLList[0], [this, status](Texture2D* texture) {
+            if (!texture)
+            {
+                status->setString("The texture can't be loaded");
+                return;
+            }
+            auto sprite = Sprite::createWithTexture(texture);
+            sprite->setScale(0.4f);
+            sprite->setPosition(VisibleRect::center() - Vec2(120, 0));
+            addChild(sprite);
+            status->setString("Loaded");
+        });
+        loader->loadSpriteFrame(sURLList[1], [this](SpriteFrame* frame) {
+            if (!frame)
+                return;
+            auto sprite = Sprite::createWithSpriteFrame(frame);
+            sprite->setPosition(VisibleRect::center() + Vec2(120, 0));
+            addChild(sprite);
+        });
+
+        auto clear = MenuItemFont::create("Clear the cache", [](Object*) {
+            network::RemoteTextureLoader::getInstance()->removeAllCachedImages();
+        });
+        auto menu = Menu::create(clear, nullptr);
+        menu->setPosition(VisibleRect::top() - Vec2(0, 80));
+        addChild(menu);
+    }
+
+    virtual void onExit() override
+    {
+        network::RemoteTextureLoader::getInstance()->cancelAll();
+        TestCase::onExit();
+    }
+};
+
 DownloaderTests::DownloaderTests()
 {
     ADD_TEST_CASE(DownloaderTest);
     ADD_TEST_CASE(DownloaderMultiTask);
+    ADD_TEST_CASE(DownloaderRemoteTextures);
 };
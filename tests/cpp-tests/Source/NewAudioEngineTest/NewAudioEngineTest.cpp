@@ -817,60 +817,6 @@ std::string AudioIssue11143Test::subtitle() const
     return "2 seconds after first sound play,you should hear another sound.";
 }
 
-// Enable profiles for this file
-#undef AX_PROFILER_DISPLAY_TIMERS
-#define AX_PROFILER_DISPLAY_TIMERS() Profiler::getInstance()->displayTimers()
-#undef AX_PROFILER_PURGE_ALL
-#define AX_PROFILER_PURGE_ALL() Profiler::getInstance()->releaseAllTimers()
-
-#undef AX_PROFILER_START
-#define AX_PROFILER_START(__name__) ProfilingBeginTimingBlock(__name__)
-#undef AX_PROFILER_STOP
-#define AX_PROFILER_STOP(__name__) ProfilingEndTimingBlock(__name__)
-#undef AX_PROFILER_RESET
-#define AX_PROFILER_RESET(__name__) ProfilingResetTimingBlock(__name__)
-
-#undef AX_PROFILER_START_CATEGORY
-#define AX_PROFILER_START_CATEGORY(__cat__, __name__) \
-    do                                                \
-    {                                                 \
-        if (__cat__)                                  \
-            ProfilingBeginTimingBlock(__name__);      \
-    } while (0)
-#undef AX_PROFILER_STOP_CATEGORY
-#define AX_PROFILER_STOP_CATEGORY(__cat__, __name__) \
-    do                                               \
-    {                                                \
-        if (__cat__)                                 \
-            ProfilingEndTimingBlock(__name__);       \
-    } while (0)
-#undef AX_PROFILER_RESET_CATEGORY
-#define AX_PROFILER_RESET_CATEGORY(__cat__, __name__) \
-    do                                                \
-    {                                                 \
-        if (__cat__)                                  \
-            ProfilingResetTimingBlock(__name__);      \
-    } while (0)
-
-#undef AX_PROFILER_START_INSTANCE
-#define AX_PROFILER_START_INSTANCE(__id__, __name__)                                                      \
-    do                                                                                                    \
-    {                                                                                                     \
-        ProfilingBeginTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-#undef AX_PROFILER_STOP_INSTANCE
-#define AX_PROFILER_STOP_INSTANCE(__id__, __name__)                                                     \
-    do                                                                                                  \
-    {                                                                                                   \
-        ProfilingEndTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-#undef AX_PROFILER_RESET_INSTANCE
-#define AX_PROFILER_RESET_INSTANCE(__id__, __name__)                                                      \
-    do                                                                                                    \
-    {                                                                                                     \
-        ProfilingResetTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-
 bool AudioPerformanceTest::init()
 {
     if (AudioEngineTestDemo::init())
@@ -894,12 +840,12 @@ bool AudioPerformanceTest::init()
             static_cast<TextButton*>(getChildByName("DisplayButton"))->setEnabled(true);
 
             unschedule("test");
+            Tracer::getInstance()->start();
             schedule(
                 [audioFiles](float dt) {
                     int index = ax::random(0, (int)(audioFiles.size() - 1));
-                    AX_PROFILER_START("play2d");
+                    AX_TRACE_SCOPE("AudioEngine::play2d");
                     AudioEngine::play2d(audioFiles[index]);
-                    AX_PROFILER_STOP("play2d");
                 },
                 0.25f, "test");
         });
@@ -910,7 +856,12 @@ bool AudioPerformanceTest::init()
         auto displayItem = TextButton::create("Display Result", [this, playItem](TextButton* button) {
             unschedule("test");
             AudioEngine::stopAll();
-            AX_PROFILER_DISPLAY_TIMERS();
+
+            auto tracer = Tracer::getInstance();
+            tracer->stop();
+            auto path = FileUtils::getInstance()->getWritablePath() + "AudioPerformanceTest.json";
+            if (tracer->saveChromeTrace(path))
+                AXLOGI("The trace is saved to {}, open it in chrome://tracing or ui.perfetto.dev", path);
             playItem->setEnabled(true);
             button->setEnabled(false);
         });
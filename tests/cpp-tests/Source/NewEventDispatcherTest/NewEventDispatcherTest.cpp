@@ -143,7 +143,8 @@ EventDispatcherTests::EventDispatcherTests()
     ADD_TEST_CASE(RegisterAndUnregisterWhileEventHanldingTest);
     ADD_TEST_CASE(WindowEventsTest);
     ADD_TEST_CASE(Issue8194);
-    ADD_TEST_CASE(Issue9898)
+    ADD_TEST_CASE(Issue9898);
+    ADD_TEST_CASE(TouchBoundsCullingTest);
 }
 
 std::string EventDispatcherTestDemo::title() const
@@ -1797,3 +1798,73 @@ std::string Issue9898::subtitle() const
 {
     return "Should not crash if dispatch event after remove\n event listener in callback";
 }
+
+void TouchBoundsCullingTest::onEnter()
+{
+    EventDispatcherTestDemo::onEnter();
+
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size   = Director::getInstance()->getVisibleSize();
+
+    const int columns = 40;
+    const int rows    = 24;
+    const Vec2 tileSize(size.width * 0.8f / columns, size.height * 0.6f / rows);
+    const Vec2 gridOrigin = origin + Vec2(size.width * 0.1f, size.height * 0.15f);
+
+    auto grid = Node::create();
+    addChild(grid);
+
+    for (int y = 0; y < rows; ++y)
+    {
+        for (int x = 0; x < columns; ++x)
+        {
+            auto tile = LayerColor::create(Color4B(60, 90 + 6 * y, 120 + 3 * x, 255), tileSize.x - 2, tileSize.y - 2);
+            tile->setPosition(gridOrigin + Vec2(x * tileSize.x, y * tileSize.y));
+            grid->addChild(tile);
+
+            // only called for the tiles under the touch
+            auto listener = EventListenerTouchOneByOne::create();
+            listener->setSwallowTouches(true);
+            listener->setBoundsCulling(true);
+            listener->onTouchBegan = [this](Touch* touch, Event* event) {
+                ++_beganCalls;
+                auto target = event->getCurrentTarget();
+                if (!Rect(Vec2::ZERO, target->getContentSize()).containsPoint(target->convertTouchToNodeSpace(touch)))
+                    return false;
+
+                // reordered, the listeners are ranked again from the grid only
+                target->setLocalZOrder(++_topZOrder);
+                target->setScale(1.5f);
+                target->setColor(Color3B::ORANGE);
+                return true;
+            };
+            listener->onTouchEnded = [this](Touch* touch, Event* event) {
+                event->getCurrentTarget()->setScale(1.0f);
+                updateStats();
+            };
+            _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, tile);
+        }
+    }
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setPosition(origin + Vec2(size.width / 2, size.height * 0.08f));
+    addChild(_statsLabel);
+    updateStats();
+}
+
+void TouchBoundsCullingTest::updateStats()
+{
+    const auto& stats = _eventDispatcher->getSortStats();
+    _statsLabel->setString(fmt::format("onTouchBegan calls: {}, sorts: {}, full walks: {}, partial walks: {}",
+                                       _beganCalls, stats.sorts, stats.fullWalks, stats.partialWalks));
+}
+
+std::string TouchBoundsCullingTest::title() const
+{
+    return "Touch bounds culling";
+}
+
+std::string TouchBoundsCullingTest::subtitle() const
+{
+    return "Touch the tiles, only the ones under the touch are called,\nthe one touched is reordered without a full walk";
+}
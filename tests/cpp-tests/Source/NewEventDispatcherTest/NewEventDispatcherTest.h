@@ -311,4 +311,20 @@ private:
     ax::EventListenerCustom* _listener;
 };
 
+class TouchBoundsCullingTest : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(TouchBoundsCullingTest);
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void updateStats();
+
+    ax::Label* _statsLabel = nullptr;
+    int _beganCalls        = 0;
+    int _topZOrder         = 0;
+};
+
 #endif /* defined(__samples__NewEventDispatcherTest__) */
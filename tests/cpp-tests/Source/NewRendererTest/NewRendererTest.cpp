@@ -93,6 +93,9 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererUniformBatch2);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
+    ADD_TEST_CASE(ParallelVisitTest);
+    ADD_TEST_CASE(SpriteInstancingTest);
+    ADD_TEST_CASE(RenderThreadTest);
 };
 
 std::string MultiSceneTest::title() const
@@ -1070,3 +1073,198 @@ std::string NonBatchSprites::subtitle() const
     return "RELEASE: simulate lots of sprites, drop to 30 fps";
 #endif
 }
+
+ParallelVisitTest::ParallelVisitTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // each column is a parallel visit root with its own sprites
+    const int columns = 4;
+    for (int c = 0; c < columns; ++c)
+    {
+        auto column = Node::create();
+        column->setParallelVisitRoot(true);
+        column->setPosition(s.width * (c + 0.5f) / columns, 0);
+        column->runAction(RepeatForever::create(Sequence::create(MoveBy::create(1, Vec2(0, 40)),
+                                                                 MoveBy::create(1, Vec2(0, -40)), nullptr)));
+        addChild(column);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            auto sprite = Sprite::create(i % 2 ? "Images/grossini_dance_01.png" : "Images/grossini_dance_05.png");
+            sprite->setScale(0.3f);
+            sprite->setPosition(AXRANDOM_MINUS1_1() * s.width / columns / 2, AXRANDOM_0_1() * s.height);
+            sprite->runAction(RepeatForever::create(RotateBy::create(1, 45)));
+            column->addChild(sprite);
+        }
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(40);
+    _toggleItem = MenuItemFont::create("Parallel visit: OFF", AX_CALLBACK_1(ParallelVisitTest::toggleParallelVisit, this));
+    auto menu   = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 105));
+    addChild(menu, 1);
+}
+
+ParallelVisitTest::~ParallelVisitTest() {}
+
+void ParallelVisitTest::onEnter()
+{
+    MultiSceneTest::onEnter();
+    Director::getInstance()->getRenderer()->setParallelVisitEnabled(false);
+}
+
+void ParallelVisitTest::onExit()
+{
+    Director::getInstance()->getRenderer()->setParallelVisitEnabled(false);
+    MultiSceneTest::onExit();
+}
+
+void ParallelVisitTest::toggleParallelVisit(Object* sender)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setParallelVisitEnabled(!renderer->isParallelVisitEnabled());
+    _toggleItem->setString(renderer->isParallelVisitEnabled() ? "Parallel visit: ON" : "Parallel visit: OFF");
+}
+
+std::string ParallelVisitTest::title() const
+{
+    return "Parallel Visit";
+}
+
+std::string ParallelVisitTest::subtitle() const
+{
+    return "Each column is visited on a JobSystem worker when enabled";
+}
+
+SpriteInstancingTest::SpriteInstancingTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // one texture and one blend function, so the quads are drawn with a single instanced call when enabled
+    auto frameCache = SpriteFrameCache::getInstance();
+    frameCache->addSpriteFramesWithFile("animations/grossini.plist");
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto name   = fmt::format("grossini_dance_{:02d}.png", i % 14 + 1);
+        auto sprite = Sprite::createWithSpriteFrameName(name);
+        sprite->setScale(0.2f);
+        sprite->setFlippedX(i % 3 == 0);
+        sprite->setPosition(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height);
+        sprite->runAction(RepeatForever::create(RotateBy::create(1, 45)));
+        addChild(sprite);
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(40);
+    _toggleItem = MenuItemFont::create("Instancing: OFF", AX_CALLBACK_1(SpriteInstancingTest::toggleInstancing, this));
+    auto menu   = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 105));
+    addChild(menu, 1);
+}
+
+SpriteInstancingTest::~SpriteInstancingTest() {}
+
+void SpriteInstancingTest::onExit()
+{
+    Director::getInstance()->getRenderer()->setSpriteInstancingEnabled(false);
+    MultiSceneTest::onExit();
+}
+
+void SpriteInstancingTest::toggleInstancing(Object* sender)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setSpriteInstancingEnabled(!renderer->isSpriteInstancingEnabled());
+    _toggleItem->setString(renderer->isSpriteInstancingEnabled() ? "Instancing: ON" : "Instancing: OFF");
+}
+
+std::string SpriteInstancingTest::title() const
+{
+    return "Sprite Instancing";
+}
+
+std::string SpriteInstancingTest::subtitle() const
+{
+    return "Should look the same with fewer draw calls when enabled";
+}
+
+RenderThreadTest::RenderThreadTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto sprite = Sprite::create(i % 2 ? "Images/grossini_dance_01.png" : "Images/grossini_dance_05.png");
+        sprite->setScale(0.3f);
+        sprite->setPosition(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height);
+        sprite->runAction(RepeatForever::create(RotateBy::create(1, 45)));
+        addChild(sprite);
+    }
+
+    // its uniform changes in the update, while the previous frame is submitted, the snapshot keeps it per frame
+    _blurSprite = Sprite::create("Images/grossini.png");
+    _blurSprite->setPosition(s.width / 2, s.height / 2);
+    auto programState =
+        new backend::ProgramState(ProgramManager::getInstance()->loadProgram(s_blur_program_id));
+    programState->autorelease();
+    _blurSprite->setProgramState(programState);
+    addChild(_blurSprite, 1);
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(40);
+    _toggleItem =
+        MenuItemFont::create("Render thread: OFF", AX_CALLBACK_1(RenderThreadTest::toggleRenderThread, this));
+    auto menu = Menu::create(_toggleItem, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 105));
+    addChild(menu, 1);
+
+    _statusLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _statusLabel->setPosition(Vec2(s.width / 2, s.height - 140));
+    addChild(_statusLabel, 1);
+
+    scheduleUpdate();
+}
+
+RenderThreadTest::~RenderThreadTest() {}
+
+void RenderThreadTest::onExit()
+{
+    Director::getInstance()->getRenderer()->setRenderThreadEnabled(false);
+    MultiSceneTest::onExit();
+}
+
+void RenderThreadTest::update(float dt)
+{
+    _time += dt;
+    auto programState = _blurSprite->getProgramState();
+    programState->setUniform(programState->getUniformLocation("resolution"), &_blurSprite->getContentSize(),
+                             sizeof(Vec2));
+    float blurRadius = 4 + 4 * std::sin(_time * 3);
+    programState->setUniform(programState->getUniformLocation("blurRadius"), &blurRadius, sizeof(blurRadius));
+    float sampleNum = 6;
+    programState->setUniform(programState->getUniformLocation("sampleNum"), &sampleNum, sizeof(sampleNum));
+
+    auto renderer = Director::getInstance()->getRenderer();
+    if (renderer->isRenderThreadEnabled() && !renderer->isRenderThreadRunning())
+        _statusLabel->setString("Not supported by this backend");
+    else
+        _statusLabel->setString("");
+}
+
+void RenderThreadTest::toggleRenderThread(Object* sender)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setRenderThreadEnabled(!renderer->isRenderThreadEnabled());
+    _toggleItem->setString(renderer->isRenderThreadEnabled() ? "Render thread: ON" : "Render thread: OFF");
+}
+
+std::string RenderThreadTest::title() const
+{
+    return "Render Thread";
+}
+
+std::string RenderThreadTest::subtitle() const
+{
+    return "Should look the same when the frames are submitted on the render thread";
+}
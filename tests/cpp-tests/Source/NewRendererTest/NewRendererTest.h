@@ -279,4 +279,63 @@ protected:
     Ticker _contFast              = Ticker(2);
     Ticker _around30fps           = Ticker(60 * 3);
 };
+
+class ParallelVisitTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(ParallelVisitTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    ParallelVisitTest();
+    virtual ~ParallelVisitTest();
+
+    void toggleParallelVisit(ax::Object* sender);
+
+    ax::MenuItemFont* _toggleItem = nullptr;
+};
+
+class SpriteInstancingTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(SpriteInstancingTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onExit() override;
+
+protected:
+    SpriteInstancingTest();
+    virtual ~SpriteInstancingTest();
+
+    void toggleInstancing(ax::Object* sender);
+
+    ax::MenuItemFont* _toggleItem = nullptr;
+};
+
+class RenderThreadTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RenderThreadTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    RenderThreadTest();
+    virtual ~RenderThreadTest();
+
+    void toggleRenderThread(ax::Object* sender);
+
+    ax::MenuItemFont* _toggleItem = nullptr;
+    ax::Label* _statusLabel       = nullptr;
+    ax::Sprite* _blurSprite       = nullptr;
+    float _time                   = 0;
+};
 #endif  //__NewRendererTest_H_
@@ -2220,6 +2220,8 @@ ParticleTests::ParticleTests()
 
     ADD_TEST_CASE(ParticleIssue12310);
     ADD_TEST_CASE(ParticleSpriteFrame);
+    ADD_TEST_CASE(ParticleGPUSimulation);
+    ADD_TEST_CASE(ParticleParallelUpdate);
 }
 
 ParticleDemo::~ParticleDemo()
@@ -3250,3 +3252,104 @@ std::string ParticleSpriteFrame::subtitle() const
 {
     return "Should not use entire texture atlas";
 }
+
+// ParticleGPUSimulation
+
+void ParticleGPUSimulation::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    _emitter = ParticleFireworks::createWithTotalParticles(100000);
+    _emitter->retain();
+    _emitter->setTexture(Director::getInstance()->getTextureCache()->addImage(s_stars1));
+    _emitter->setStartSize(4);
+    _emitter->setEndSize(2);
+    _emitter->setGPUSimulationEnabled(true);
+    addChild(_emitter, 10);
+
+    setEmitterPosition();
+
+    auto emitter = _emitter;
+    auto toggle  = MenuItemFont::create("GPU simulation: on", [emitter](Object* sender) {
+        emitter->setGPUSimulationEnabled(!emitter->isGPUSimulationEnabled());
+        static_cast<MenuItemFont*>(sender)->setString(emitter->isGPUSimulationEnabled() ? "GPU simulation: on"
+                                                                                          : "GPU simulation: off");
+    });
+    toggle->setFontSizeObj(20);
+
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2(VisibleRect::center().x, VisibleRect::bottom().y + 60));
+    this->addChild(menu, 100);
+}
+
+std::string ParticleGPUSimulation::title() const
+{
+    return "GPU particle simulation";
+}
+
+std::string ParticleGPUSimulation::subtitle() const
+{
+    return "100k particles, toggle to compare with the CPU";
+}
+
+// ParticleParallelUpdate
+
+void ParticleParallelUpdate::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    // 200 emitters, half of them in a batch node to check the disjoint atlas ranges
+    auto texture = Director::getInstance()->getTextureCache()->addImage(s_fire);
+    auto batch   = ParticleBatchNode::createWithTexture(texture, 100 * 250);
+    addChild(batch, 1);
+
+    auto s = Director::getInstance()->getWinSize();
+    for (int i = 0; i < 200; ++i)
+    {
+        auto emitter = ParticleSun::createWithTotalParticles(250);
+        emitter->setTexture(texture);
+        emitter->setPosition(Vec2(s.width * (i % 20 + 0.5f) / 20, s.height * (i / 20 + 0.5f) / 10));
+        if (i % 2)
+            batch->addChild(emitter);
+        else
+            addChild(emitter, 1);
+    }
+
+    ParticleSystem::setParallelUpdateEnabled(true);
+
+    auto toggle = MenuItemFont::create("parallel update: on", [](Object* sender) {
+        ParticleSystem::setParallelUpdateEnabled(!ParticleSystem::isParallelUpdateEnabled());
+        static_cast<MenuItemFont*>(sender)->setString(ParticleSystem::isParallelUpdateEnabled()
+                                                          ? "parallel update: on"
+                                                          : "parallel update: off");
+    });
+    toggle->setFontSizeObj(20);
+
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2(VisibleRect::center().x, VisibleRect::bottom().y + 60));
+    this->addChild(menu, 100);
+}
+
+void ParticleParallelUpdate::onExit()
+{
+    ParticleSystem::setParallelUpdateEnabled(false);
+    ParticleDemo::onExit();
+}
+
+std::string ParticleParallelUpdate::title() const
+{
+    return "Parallel particle update";
+}
+
+std::string ParticleParallelUpdate::subtitle() const
+{
+    return "200 emitters updated on the JobSystem workers";
+}
@@ -643,4 +643,23 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class ParticleGPUSimulation : public ParticleDemo
+{
+public:
+    CREATE_FUNC(ParticleGPUSimulation);
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
+class ParticleParallelUpdate : public ParticleDemo
+{
+public:
+    CREATE_FUNC(ParticleParallelUpdate);
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
@@ -739,14 +739,23 @@ bool Physics3DCollisionCallbackDemo::init()
             Physics3DRigidBodyDes rbDes;
 
             float scale = 2.0f;
-            std::vector<Vec3> trianglesList = Bundle3D::getTrianglesList(boss[i]);
-            for (auto&& it : trianglesList)
-            {
-                it *= scale;
-            }
 
+            // cooked on the first run, the next runs load the cooked bvh instead of building it
+            auto cookedPath = fmt::format("{}physics3d-boss{}.axcm", FileUtils::getInstance()->getWritablePath(), i);
             rbDes.mass = 0.0f;
-            rbDes.shape = Physics3DShape::createMesh(&trianglesList[0], (int)trianglesList.size() / 3);
+            rbDes.shape = Physics3DShape::createCookedMesh(cookedPath);
+            if (!rbDes.shape)
+            {
+                std::vector<Vec3> trianglesList = Bundle3D::getTrianglesList(boss[i]);
+                for (auto&& it : trianglesList)
+                {
+                    it *= scale;
+                }
+                if (Physics3DShape::cookMesh(&trianglesList[0], (int)trianglesList.size() / 3, cookedPath))
+                    rbDes.shape = Physics3DShape::createCookedMesh(cookedPath);
+                else
+                    rbDes.shape = Physics3DShape::createMesh(&trianglesList[0], (int)trianglesList.size() / 3);
+            }
             auto rigidBody = Physics3DRigidBody::create(&rbDes);
             auto component = Physics3DComponent::create(rigidBody);
             auto mesh = MeshRenderer::create(boss[i]);
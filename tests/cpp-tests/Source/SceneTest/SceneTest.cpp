@@ -30,6 +30,7 @@ using namespace ax;
 SceneTests::SceneTests()
 {
     ADD_TEST_CASE(SceneTestScene);
+    ADD_TEST_CASE(ScenePrepareAsyncTest);
 }
 
 //------------------------------------------------------------------
@@ -266,3 +267,82 @@ SceneTestScene* SceneTestScene::create(int testIndex /* = 1 */)
 
     return scene;
 }
+
+//------------------------------------------------------------------
+//
+// ScenePrepareAsyncTest
+//
+//------------------------------------------------------------------
+
+bool ScenePrepareAsyncTest::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    auto s    = _director->getWinSize();
+    auto item = MenuItemFont::create("Push a scene of 24 panels", [this](Object*) { pushPreparedScene(); });
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(s.width / 2, s.height / 2 + 20);
+    addChild(menu);
+
+    _statusLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statusLabel->setPosition(s.width / 2, s.height / 2 - 30);
+    addChild(_statusLabel);
+
+    // the frames keep running while the scene is prepared
+    auto sprite = Sprite::create(s_pathGrossini);
+    sprite->setPosition(s.width - 40, s.height / 2);
+    sprite->runAction(RepeatForever::create(RotateBy::create(2, 360)));
+    addChild(sprite);
+
+    scheduleUpdate();
+    return true;
+}
+
+void ScenePrepareAsyncTest::update(float dt)
+{
+    if (!_preparedScene || !_preparedScene->isPreparing())
+        return;
+
+    _longestFrame = std::max(_longestFrame, dt);
+    _statusLabel->setString(fmt::format("Preparing, {} children, the longest frame took {:.1f} ms",
+                                        _preparedScene->getChildrenCount(), _longestFrame * 1000));
+}
+
+void ScenePrepareAsyncTest::pushPreparedScene()
+{
+    if (_preparedScene && _preparedScene->isPreparing())
+        return;
+
+    auto scene     = Scene::create();
+    _preparedScene = scene;
+    _longestFrame  = 0;
+
+    _director->pushSceneAsync(scene, [scene](TimeSlice& slice) -> Task<void> {
+        auto s = scene->getContentSize();
+        for (int i = 0; i < 24; ++i)
+        {
+            // a panel of 200 sprites and a label, built in one piece
+            auto panel = Node::create();
+            panel->setPosition(s.width * (i % 6 + 0.5f) / 6, s.height * (i / 6 + 0.5f) / 4);
+            for (int j = 0; j < 200; ++j)
+            {
+                auto sprite = Sprite::create(s_pathGrossini);
+                sprite->setScale(0.15f);
+                sprite->setPosition(AXRANDOM_MINUS1_1() * 30, AXRANDOM_MINUS1_1() * 30);
+                sprite->runAction(RepeatForever::create(RotateBy::create(1 + j % 3, 360)));
+                panel->addChild(sprite);
+            }
+            auto label = Label::createWithTTF(fmt::format("panel {}", i), "fonts/arial.ttf", 12);
+            panel->addChild(label);
+            scene->addChild(panel);
+
+            co_await slice;
+        }
+
+        auto back = MenuItemFont::create("Go back", [](Object*) { Director::getInstance()->popScene(); });
+        auto menu = Menu::create(back, nullptr);
+        menu->setPosition(s.width / 2, 30);
+        scene->addChild(menu);
+    });
+}
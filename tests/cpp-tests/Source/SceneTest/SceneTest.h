@@ -83,4 +83,22 @@ public:
     static SceneTestScene* create(int testIndex = 1);
 };
 
+class ScenePrepareAsyncTest : public TestCase
+{
+public:
+    CREATE_FUNC(ScenePrepareAsyncTest);
+
+    bool init() override;
+    void update(float dt) override;
+    std::string title() const override { return "Scene::prepareAsync"; }
+    std::string subtitle() const override { return "A heavy scene built and entered over several frames"; }
+
+private:
+    void pushPreparedScene();
+
+    ax::RefPtr<ax::Scene> _preparedScene;
+    ax::Label* _statusLabel = nullptr;
+    float _longestFrame     = 0;
+};
+
 #endif
@@ -30,6 +30,7 @@
 #include <cassert>
 
 #include "NinePatchImageParser.h"
+#include "2d/BinarySpriteSheetLoader.h"
 
 using namespace ax;
 
@@ -39,6 +40,9 @@ SpriteFrameCacheTests::SpriteFrameCacheTests()
     ADD_TEST_CASE(SpriteFrameCacheLoadMultipleTimes);
     ADD_TEST_CASE(SpriteFrameCacheFullCheck);
     ADD_TEST_CASE(SpriteFrameCacheJsonAtlasTest);
+    ADD_TEST_CASE(SpriteFrameCacheDynamicAtlasTest);
+    ADD_TEST_CASE(SpriteFrameCacheBinarySheetTest);
+    ADD_TEST_CASE(SpriteFrameCacheTracedSheetTest);
 }
 
 SpriteFrameCachePixelFormatTest::SpriteFrameCachePixelFormatTest()
@@ -500,3 +504,154 @@ void SpriteFrameCacheJsonAtlasTest::loadSpriteFrames(std::string_view file,
     SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(file);
     Director::getInstance()->getTextureCache()->removeTexture(texture);
 }
+
+SpriteFrameCacheDynamicAtlasTest::SpriteFrameCacheDynamicAtlasTest()
+{
+    // small pages, so the images spread over a few of them
+    _atlas = std::make_unique<DynamicAtlas>(256);
+
+    const char* files[] = {"Images/grossini.png", "Images/grossinis_sister1.png", "Images/grossinis_sister2.png",
+                           "Images/b1.png",       "Images/b2.png",                "Images/r1.png",
+                           "Images/r2.png",       "Images/f1.png",                "Images/f2.png",
+                           "Images/ball.png",     "Images/close.png",             "Images/btn-play-normal.png"};
+    for (auto file : files)
+    {
+        if (_atlas->addImage(file))
+            _names.emplace_back(file);
+    }
+
+    const Size screenSize = Director::getInstance()->getWinSize();
+
+    _infoLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _infoLabel->setPosition(screenSize.width * 0.5f, screenSize.height * 0.2f);
+    addChild(_infoLabel);
+
+    _spriteRoot = Node::create();
+    addChild(_spriteRoot);
+    layoutSprites();
+
+    auto listener          = EventListenerTouchOneByOne::create();
+    listener->onTouchBegan = [this](Touch*, Event*) {
+        removeEveryOther();
+        return false;
+    };
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+}
+
+void SpriteFrameCacheDynamicAtlasTest::layoutSprites()
+{
+    _spriteRoot->removeAllChildren();
+
+    const Size screenSize = Director::getInstance()->getWinSize();
+    const int columns     = 6;
+    for (size_t i = 0; i < _names.size(); ++i)
+    {
+        // the frames are served by SpriteFrameCache
+        auto sprite = Sprite::createWithSpriteFrameName(_names[i]);
+        sprite->setScale(0.6f);
+        sprite->setPosition(screenSize.width * (i % columns + 1) / (columns + 1),
+                            screenSize.height * (0.6f - 0.2f * (i / columns)));
+        _spriteRoot->addChild(sprite);
+    }
+
+    _infoLabel->setString(fmt::format("{} images in {} pages of {}x{}", _atlas->getImageCount(),
+                                      _atlas->getPageCount(), _atlas->getPageSize(), _atlas->getPageSize()));
+}
+
+void SpriteFrameCacheDynamicAtlasTest::removeEveryOther()
+{
+    std::vector<std::string> kept;
+    for (size_t i = 0; i < _names.size(); ++i)
+    {
+        if (i % 2)
+            _atlas->removeImage(_names[i]);
+        else
+            kept.emplace_back(_names[i]);
+    }
+    _names = std::move(kept);
+
+    // the compacted images moved, the sprites take their frames again
+    layoutSprites();
+}
+
+SpriteFrameCacheBinarySheetTest::SpriteFrameCacheBinarySheetTest()
+{
+    const Size screenSize = Director::getInstance()->getWinSize();
+
+    _sheetPath = FileUtils::getInstance()->getWritablePath() + "grossini.ssb";
+    if (!BinarySpriteSheetLoader::convert("animations/grossini.plist", _sheetPath))
+        return;
+
+    // the .ssb is in the writable path, the texture is given instead of resolved next to it
+    auto cache = SpriteFrameCache::getInstance();
+    cache->addSpriteFramesWithFile(_sheetPath, "animations/grossini.png"sv);
+
+    Vector<SpriteFrame*> frames;
+    for (int i = 1; i <= 14; ++i)
+    {
+        auto frame = cache->getSpriteFrameByName(fmt::format("grossini_dance_{:02d}.png", i));
+        if (frame)
+            frames.pushBack(frame);
+    }
+    if (frames.empty())
+        return;
+
+    auto sprite = Sprite::createWithSpriteFrame(frames.front());
+    sprite->setPosition(screenSize.width * 0.5f, screenSize.height * 0.5f);
+    sprite->runAction(RepeatForever::create(Animate::create(Animation::createWithSpriteFrames(frames, 0.1f))));
+    addChild(sprite);
+}
+
+SpriteFrameCacheBinarySheetTest::~SpriteFrameCacheBinarySheetTest()
+{
+    SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(_sheetPath);
+    FileUtils::getInstance()->removeFile(_sheetPath);
+}
+
+SpriteFrameCacheTracedSheetTest::SpriteFrameCacheTracedSheetTest()
+{
+    const Size screenSize = Director::getInstance()->getWinSize();
+
+    _sheetPath = FileUtils::getInstance()->getWritablePath() + "grossini_traced.ssb";
+    if (!BinarySpriteSheetLoader::convert("animations/grossini.plist", _sheetPath, true))
+        return;
+
+    auto cache = SpriteFrameCache::getInstance();
+    cache->addSpriteFramesWithFile(_sheetPath, "animations/grossini.png"sv);
+
+    auto frame = cache->getSpriteFrameByName("grossini_dance_05.png");
+    if (!frame || !frame->hasPolygonInfo())
+        return;
+
+    auto sprite = Sprite::createWithSpriteFrame(frame);
+    sprite->setPosition(screenSize.width * 0.35f, screenSize.height * 0.5f);
+    addChild(sprite);
+
+    auto wireframe = Sprite::createWithSpriteFrame(frame);
+    wireframe->setPosition(screenSize.width * 0.65f, screenSize.height * 0.5f);
+    addChild(wireframe);
+
+    auto& triangles = frame->getPolygonInfo().triangles;
+    auto drawNode   = DrawNode::create();
+    for (unsigned int i = 0; i + 2 < triangles.indexCount; i += 3)
+    {
+        Vec2 points[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            auto& position = triangles.verts[triangles.indices[i + j]].vertices;
+            points[j].set(position.x, position.y);
+        }
+        drawNode->drawPoly(points, 3, true, Color4F::GREEN);
+    }
+    wireframe->addChild(drawNode);
+
+    auto label = Label::createWithTTF(fmt::format("{} triangles", triangles.indexCount / 3), "fonts/arial.ttf", 14);
+    label->setPosition(screenSize.width * 0.5f, screenSize.height * 0.25f);
+    addChild(label);
+}
+
+SpriteFrameCacheTracedSheetTest::~SpriteFrameCacheTracedSheetTest()
+{
+    SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(_sheetPath);
+    FileUtils::getInstance()->removeFile(_sheetPath);
+}
@@ -91,3 +91,62 @@ private:
 
     ax::Label* infoLabel;
 };
+
+class SpriteFrameCacheDynamicAtlasTest : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheDynamicAtlasTest);
+
+    virtual std::string title() const override { return "DynamicAtlas"; }
+    virtual std::string subtitle() const override
+    {
+        return "Separate images packed into shared pages\nTap to remove every other image and compact";
+    }
+
+    SpriteFrameCacheDynamicAtlasTest();
+
+private:
+    void layoutSprites();
+    void removeEveryOther();
+
+    std::unique_ptr<ax::DynamicAtlas> _atlas;
+    std::vector<std::string> _names;
+    ax::Node* _spriteRoot = nullptr;
+    ax::Label* _infoLabel = nullptr;
+};
+
+class SpriteFrameCacheBinarySheetTest : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheBinarySheetTest);
+
+    virtual std::string title() const override { return "Binary sprite sheet"; }
+    virtual std::string subtitle() const override
+    {
+        return "A plist converted to .ssb, the frames are created on first use";
+    }
+
+    SpriteFrameCacheBinarySheetTest();
+    ~SpriteFrameCacheBinarySheetTest() override;
+
+private:
+    std::string _sheetPath;
+};
+
+class SpriteFrameCacheTracedSheetTest : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheTracedSheetTest);
+
+    virtual std::string title() const override { return "Binary sprite sheet with traced polygons"; }
+    virtual std::string subtitle() const override
+    {
+        return "The trimmed meshes are traced by the conversion, the right sprite shows their triangles";
+    }
+
+    SpriteFrameCacheTracedSheetTest();
+    ~SpriteFrameCacheTracedSheetTest() override;
+
+private:
+    std::string _sheetPath;
+};
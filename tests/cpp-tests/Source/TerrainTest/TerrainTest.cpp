@@ -31,6 +31,8 @@ TerrainTests::TerrainTests()
     ADD_TEST_CASE(TerrainSimple);
     ADD_TEST_CASE(TerrainWalkThru);
     ADD_TEST_CASE(TerrainWithLightMap);
+    ADD_TEST_CASE(TerrainPaged);
+    ADD_TEST_CASE(TerrainBatchQueries);
 }
 
 Vec3 camera_offset(0, 45, 60);
@@ -393,3 +395,196 @@ void TerrainWithLightMap::onTouchesMoved(const std::vector<ax::Touch*>& touches,
     cameraPos += cameraRightDir * newPos.x * 0.5 * delta;
     _camera->setPosition3D(cameraPos);
 }
+
+TerrainPaged::TerrainPaged()
+{
+    Size visibleSize = Director::getInstance()->getVisibleSize();
+
+    _camera = Camera::createPerspective(60, visibleSize.width / visibleSize.height, 0.1f, 800);
+    _camera->setCameraFlag(CameraFlag::USER1);
+    _camera->setPosition3D(Vec3(-1, 1.6f, 4));
+    addChild(_camera);
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    label->setPosition(visibleSize.width / 2, visibleSize.height / 6);
+    addChild(label, 1);
+
+    // page the small height map, a large one is split offline the same way
+    int pagesX = 0, pagesY = 0;
+    auto pagePattern = FileUtils::getInstance()->getWritablePath() + "terrain_page_{}_{}.png";
+    if (!PagedTerrain::isSupported() ||
+        !PagedTerrain::splitHeightMap("TerrainTest/heightmap16.jpg", pagePattern, 32, &pagesX, &pagesY))
+    {
+        label->setString("paged terrain not supported");
+        return;
+    }
+
+    PagedTerrain::PagedTerrainData data(pagePattern, pagesX, pagesY, 32, "TerrainTest/Grass2.jpg");
+    _terrain = PagedTerrain::create(data);
+    _terrain->setLoadRadius(1);
+    _terrain->setCameraMask(2);
+    addChild(_terrain);
+
+    auto terrain = _terrain;
+    schedule(
+        [terrain, label](float) {
+        label->setString(fmt::format("resident pages: {}  loading: {}  {} KB", terrain->getLoadedPageCount(),
+                                     terrain->getPendingLoadCount(), terrain->getResidentBytes() / 1024));
+    },
+        "paged_label");
+
+    auto listener            = EventListenerTouchAllAtOnce::create();
+    listener->onTouchesMoved = AX_CALLBACK_2(TerrainPaged::onTouchesMoved, this);
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+}
+
+std::string TerrainPaged::title() const
+{
+    return "Paged terrain";
+}
+
+std::string TerrainPaged::subtitle() const
+{
+    return "Drag to walkThru, pages stream around the camera";
+}
+
+void TerrainPaged::onTouchesMoved(const std::vector<ax::Touch*>& touches, ax::Event* event)
+{
+    float delta   = Director::getInstance()->getDeltaTime();
+    auto touch    = touches[0];
+    Point newPos  = touch->getPreviousLocation() - touch->getLocation();
+
+    Vec3 cameraDir;
+    Vec3 cameraRightDir;
+    _camera->getNodeToWorldTransform().getForwardVector(&cameraDir);
+    cameraDir.normalize();
+    cameraDir.y = 0;
+    _camera->getNodeToWorldTransform().getRightVector(&cameraRightDir);
+    cameraRightDir.normalize();
+    cameraRightDir.y = 0;
+    Vec3 cameraPos   = _camera->getPosition3D();
+    cameraPos += cameraDir * newPos.y * 0.5 * delta;
+    cameraPos += cameraRightDir * newPos.x * 0.5 * delta;
+    if (_terrain)
+        cameraPos.y = _terrain->getHeight(cameraPos.x, cameraPos.z) + 1.6f;
+    _camera->setPosition3D(cameraPos);
+}
+
+TerrainBatchQueries::TerrainBatchQueries()
+{
+    Size visibleSize = Director::getInstance()->getVisibleSize();
+
+    _camera = Camera::createPerspective(60, visibleSize.width / visibleSize.height, 0.1f, 800);
+    _camera->setCameraFlag(CameraFlag::USER1);
+    _camera->setPosition3D(Vec3(0, 60, 90));
+    _camera->lookAt(Vec3::ZERO);
+    addChild(_camera);
+
+    Terrain::DetailMap r("TerrainTest/dirt.jpg"), g("TerrainTest/Grass2.jpg"), b("TerrainTest/road.jpg"),
+        a("TerrainTest/GreenSkin.jpg");
+    Terrain::TerrainData data("TerrainTest/heightmap16.jpg", "TerrainTest/alphamap.png", r, g, b, a);
+    _terrain = Terrain::create(data, Terrain::CrackFixedType::SKIRT);
+    _terrain->setMaxDetailMapAmount(4);
+    _terrain->setCameraMask(2);
+    addChild(_terrain);
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _label->setPosition(visibleSize.width / 2, visibleSize.height / 6);
+    addChild(_label, 1);
+
+    // the units wander on the terrain, their heights are sampled in a batch every frame
+    const int unitCount = 512;
+    auto size           = _terrain->getTerrainSize() * 0.45f;
+    for (int i = 0; i < unitCount; ++i)
+    {
+        auto unit = BillBoard::create("Images/Icon.png");
+        unit->setScale(0.01f);
+        unit->setCameraMask(2);
+        addChild(unit);
+        _units.emplace_back(unit);
+        _positions.emplace_back(AXRANDOM_MINUS1_1() * size.x, AXRANDOM_MINUS1_1() * size.y);
+        _velocities.emplace_back(AXRANDOM_MINUS1_1() * 4, AXRANDOM_MINUS1_1() * 4);
+    }
+    _heights.resize(unitCount);
+
+    auto listener            = EventListenerTouchAllAtOnce::create();
+    listener->onTouchesEnded = AX_CALLBACK_2(TerrainBatchQueries::onTouchesEnded, this);
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+
+    scheduleUpdate();
+}
+
+std::string TerrainBatchQueries::title() const
+{
+    return "Terrain batched queries";
+}
+
+std::string TerrainBatchQueries::subtitle() const
+{
+    return "Tap to cast a fan of rays";
+}
+
+void TerrainBatchQueries::update(float dt)
+{
+    auto size = _terrain->getTerrainSize() * 0.45f;
+    for (size_t i = 0; i < _positions.size(); ++i)
+    {
+        _positions[i] += _velocities[i] * dt;
+        if (std::abs(_positions[i].x) > size.x)
+            _velocities[i].x = -_velocities[i].x;
+        if (std::abs(_positions[i].y) > size.y)
+            _velocities[i].y = -_velocities[i].y;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    _terrain->getHeights(_positions, _heights);
+    auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t i = 0; i < _units.size(); ++i)
+        _units[i]->setPosition3D(Vec3(_positions[i].x, _heights[i] + 0.5f, _positions[i].y));
+    _label->setString(fmt::format("{} heights in {:.1f} us", _positions.size(), elapsed));
+}
+
+void TerrainBatchQueries::onTouchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event)
+{
+    auto location = touches[0]->getLocationInView();
+    Vec3 nearP(location.x, location.y, 0.0f), farP(location.x, location.y, 1.0f);
+    nearP = _camera->unproject(nearP);
+    farP  = _camera->unproject(farP);
+    Vec3 dir(farP - nearP);
+    dir.normalize();
+
+    // a fan of rays around the tapped one, cast in a batch
+    const int rayCount = 256;
+    std::vector<Ray> rays;
+    for (int i = 0; i < rayCount; ++i)
+    {
+        Vec3 spread(AXRANDOM_MINUS1_1(), AXRANDOM_MINUS1_1() * 0.2f, AXRANDOM_MINUS1_1());
+        rays.emplace_back(nearP, dir + spread * 0.1f);
+    }
+    std::vector<Terrain::RayHit> hits(rayCount);
+
+    auto start = std::chrono::steady_clock::now();
+    _terrain->getIntersectionPoints(rays, hits);
+    auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    for (auto marker : _markers)
+        marker->removeFromParent();
+    _markers.clear();
+
+    int hitCount = 0;
+    for (auto& hit : hits)
+    {
+        if (!hit.hit)
+            continue;
+        auto marker = BillBoard::create("Images/Icon.png");
+        marker->setScale(0.005f);
+        marker->setColor(Color3B::RED);
+        marker->setPosition3D(hit.point);
+        marker->setCameraMask(2);
+        addChild(marker);
+        _markers.emplace_back(marker);
+        ++hitCount;
+    }
+    AXLOGI("TerrainBatchQueries: {} of {} rays hit in {:.1f} us", hitCount, rayCount, elapsed);
+}
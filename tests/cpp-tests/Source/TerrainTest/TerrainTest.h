@@ -28,6 +28,7 @@
 
 #include "3d/MeshRenderer.h"
 #include "3d/Terrain.h"
+#include "3d/PagedTerrain.h"
 #include "2d/Camera.h"
 #include "2d/Action.h"
 
@@ -112,4 +113,39 @@ protected:
     ax::Camera* _camera;
 };
 
+class TerrainPaged : public TerrainTestDemo
+{
+public:
+    CREATE_FUNC(TerrainPaged);
+    TerrainPaged();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    void onTouchesMoved(const std::vector<ax::Touch*>& touches, ax::Event* event);
+
+protected:
+    ax::PagedTerrain* _terrain = nullptr;
+    ax::Camera* _camera;
+};
+
+class TerrainBatchQueries : public TerrainTestDemo
+{
+public:
+    CREATE_FUNC(TerrainBatchQueries);
+    TerrainBatchQueries();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    void update(float dt) override;
+    void onTouchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event);
+
+protected:
+    ax::Terrain* _terrain;
+    ax::Camera* _camera;
+    ax::Label* _label;
+    std::vector<ax::Node*> _units;
+    std::vector<ax::Vec2> _positions;
+    std::vector<ax::Vec2> _velocities;
+    std::vector<float> _heights;
+    std::vector<ax::Node*> _markers;
+};
+
 #endif  // !TERRAIN_TESH_H
@@ -30,6 +30,10 @@ TextureCacheTests::TextureCacheTests()
 {
     ADD_TEST_CASE(TextureCacheTest);
     ADD_TEST_CASE(TextureCacheUnbindTest);
+    ADD_TEST_CASE(TextureCacheBatchTest);
+    ADD_TEST_CASE(TextureCacheUploadBudgetTest);
+    ADD_TEST_CASE(TextureCacheMemoryBudgetTest);
+    ADD_TEST_CASE(TextureCacheMipStreamingTest);
 }
 
 TextureCacheTest::TextureCacheTest() : _numberOfSprites(20), _numberOfLoadedSprites(0)
@@ -234,3 +238,193 @@ void TextureCacheUnbindTest::textureLoadedB(Texture2D* texture)
     s->setPosition(3 * size.width / 4, size.height / 2);
     this->addChild(s);
 }
+
+TextureCacheBatchTest::~TextureCacheBatchTest()
+{
+    if (_loadToken)
+        _loadToken->cancel();
+}
+
+std::string TextureCacheBatchTest::subtitle() const
+{
+    return "14 dancers should appear at once\nthe cancelled batch shouldn't show the background";
+}
+
+void TextureCacheBatchTest::onEnter()
+{
+    TestCase::onEnter();
+
+    auto cache = Director::getInstance()->getTextureCache();
+
+    std::vector<std::string> paths;
+    for (int i = 1; i <= 14; ++i)
+        paths.emplace_back(fmt::format("Images/grossini_dance_{:02d}.png", i));
+    for (auto&& path : paths)
+        cache->removeTextureForKey(path);
+    cache->removeTextureForKey("Images/background3.png");
+
+    _loadToken = cache->addImagesAsync(paths, AX_CALLBACK_1(TextureCacheBatchTest::texturesLoaded, this));
+
+    // lower priority than the dancers, so it's still pending when it's cancelled
+    std::vector<std::string> background{"Images/background3.png"};
+    _cancelledToken = cache->addImagesAsync(
+        background,
+        [this](const std::vector<Texture2D*>& textures) {
+        auto size = Director::getInstance()->getWinSize();
+        auto bg   = Sprite::createWithTexture(textures[0]);
+        bg->setPosition(size.width / 2, size.height / 2);
+        this->addChild(bg, -1);
+    },
+        -1);
+    _cancelledToken->cancel();
+}
+
+void TextureCacheBatchTest::texturesLoaded(const std::vector<Texture2D*>& textures)
+{
+    _loadToken = nullptr;
+
+    auto size = Director::getInstance()->getWinSize();
+    float x   = size.width / 2 - (textures.size() - 1) * 15.0f;
+    for (auto&& texture : textures)
+    {
+        if (texture)
+        {
+            auto s = Sprite::createWithTexture(texture);
+            s->setPosition(x, size.height / 2);
+            this->addChild(s);
+        }
+        x += 30.0f;
+    }
+}
+
+TextureCacheUploadBudgetTest::~TextureCacheUploadBudgetTest()
+{
+    if (_loadToken)
+        _loadToken->cancel();
+    Director::getInstance()->getTextureCache()->setAsyncUploadBudget(_oldBudget);
+}
+
+void TextureCacheUploadBudgetTest::onEnter()
+{
+    TestCase::onEnter();
+
+    auto cache = Director::getInstance()->getTextureCache();
+    _oldBudget = cache->getAsyncUploadBudget();
+    cache->setAsyncUploadBudget(1024 * 1024);
+    cache->removeTextureForKey("Images/texture2048x2048.png");
+
+    auto label = Label::createWithTTF("frames: 0", "fonts/arial.ttf", 15);
+    auto size  = Director::getInstance()->getWinSize();
+    label->setPosition(size.width / 2, size.height / 4);
+    this->addChild(label);
+
+    // counts the frames the upload is spread over
+    auto frames = std::make_shared<int>(0);
+    label->schedule(
+        [label, frames](float) { label->setString(fmt::format("frames: {}", ++(*frames))); }, "frames");
+
+    _loadToken = cache->addImageAsync(
+        "Images/texture2048x2048.png",
+        [this, label](Texture2D* texture) {
+        _loadToken = nullptr;
+        label->unschedule("frames");
+        if (!texture)
+            return;
+
+        auto size = Director::getInstance()->getWinSize();
+        auto s    = Sprite::createWithTexture(texture);
+        s->setScale(0.15f);
+        s->setPosition(size.width / 2, size.height / 2);
+        this->addChild(s);
+    },
+        0);
+}
+
+TextureCacheMemoryBudgetTest::~TextureCacheMemoryBudgetTest()
+{
+    Director::getInstance()->getTextureCache()->setMemoryBudget(_oldBudget);
+}
+
+std::string TextureCacheMemoryBudgetTest::subtitle() const
+{
+    return "one background is shown at a time, the hidden ones are evicted\nthe budget is 8MB";
+}
+
+void TextureCacheMemoryBudgetTest::onEnter()
+{
+    TestCase::onEnter();
+
+    auto cache = Director::getInstance()->getTextureCache();
+    _oldBudget = cache->getMemoryBudget();
+    cache->setMemoryBudget(8 * 1024 * 1024, 30);
+
+    auto size = Director::getInstance()->getWinSize();
+    for (auto&& path : {"Images/background1.png", "Images/background2.png", "Images/background3.png",
+                        "Images/texture2048x2048.png"})
+    {
+        auto sprite = Sprite::create(path);
+        sprite->setPosition(size.width / 2, size.height / 2);
+        sprite->setScale(std::min(size.width / sprite->getContentSize().width,
+                                  size.height / sprite->getContentSize().height) *
+                         0.8f);
+        sprite->setVisible(false);
+        this->addChild(sprite, -1);
+        _sprites.emplace_back(sprite);
+    }
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    label->setPosition(size.width / 2, size.height / 5);
+    this->addChild(label);
+
+    // shows the backgrounds in turn, the hidden ones are evicted and reloaded when they're shown again
+    auto elapsed = std::make_shared<float>(0.0f);
+    label->schedule(
+        [this, label, elapsed, cache](float dt) {
+        *elapsed += dt;
+        auto shown = static_cast<size_t>(*elapsed / 2.0f) % _sprites.size();
+        for (size_t i = 0; i < _sprites.size(); ++i)
+            _sprites[i]->setVisible(i == shown);
+
+        int evicted = 0;
+        for (auto&& sprite : _sprites)
+            evicted += sprite->getTexture()->isStorageEvicted() ? 1 : 0;
+        label->setString(fmt::format("texture memory: {} KB, evicted: {}", cache->getMemoryUsage() / 1024, evicted));
+    },
+        "budget");
+}
+
+TextureCacheMipStreamingTest::~TextureCacheMipStreamingTest()
+{
+    Director::getInstance()->getTextureCache()->setMipStreaming(0);
+}
+
+void TextureCacheMipStreamingTest::onEnter()
+{
+    TestCase::onEnter();
+
+    // the small size makes the streaming visible with the test images
+    auto cache = Director::getInstance()->getTextureCache();
+    cache->setMipStreaming(128, 16, 60);
+    cache->removeTextureForKey("Images/test_image_rgba4444_mipmap.pvr");
+
+    auto size   = Director::getInstance()->getWinSize();
+    auto sprite = Sprite::create("Images/test_image_rgba4444_mipmap.pvr");
+    sprite->setPosition(size.width / 2, size.height / 2);
+    sprite->setScale(0.1f);
+    this->addChild(sprite);
+
+    auto zoom = Sequence::create(DelayTime::create(1.0f), ScaleTo::create(2.0f, 1.5f), DelayTime::create(1.0f),
+                                 ScaleTo::create(2.0f, 0.1f), nullptr);
+    sprite->runAction(RepeatForever::create(zoom));
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    label->setPosition(size.width / 2, size.height / 5);
+    this->addChild(label);
+    label->schedule(
+        [label, sprite](float) {
+        auto texture = sprite->getTexture();
+        label->setString(fmt::format("resident mip level: {} of {}", texture->getResidentMipLevel(),
+                                     texture->getMipLevelCount()));
+    },
+        "level");
+}
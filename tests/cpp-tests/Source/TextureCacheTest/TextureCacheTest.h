@@ -66,4 +66,66 @@ private:
     void textureLoadedB(ax::Texture2D* texture);
 };
 
+class TextureCacheBatchTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheBatchTest);
+
+    ~TextureCacheBatchTest() override;
+
+    void onEnter() override;
+    std::string title() const override { return "TextureCache::addImagesAsync"; }
+    std::string subtitle() const override;
+
+private:
+    void texturesLoaded(const std::vector<ax::Texture2D*>& textures);
+
+    std::shared_ptr<ax::TextureCache::AsyncLoadToken> _loadToken;
+    std::shared_ptr<ax::TextureCache::AsyncLoadToken> _cancelledToken;
+};
+
+class TextureCacheUploadBudgetTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheUploadBudgetTest);
+
+    ~TextureCacheUploadBudgetTest() override;
+
+    void onEnter() override;
+    std::string title() const override { return "TextureCache::setAsyncUploadBudget"; }
+    std::string subtitle() const override { return "the 2048x2048 texture is uploaded 1MB per frame"; }
+
+private:
+    std::shared_ptr<ax::TextureCache::AsyncLoadToken> _loadToken;
+    size_t _oldBudget = 0;
+};
+
+class TextureCacheMemoryBudgetTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheMemoryBudgetTest);
+
+    ~TextureCacheMemoryBudgetTest() override;
+
+    void onEnter() override;
+    std::string title() const override { return "TextureCache::setMemoryBudget"; }
+    std::string subtitle() const override;
+
+private:
+    std::vector<ax::Sprite*> _sprites;
+    size_t _oldBudget = 0;
+};
+
+class TextureCacheMipStreamingTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheMipStreamingTest);
+
+    ~TextureCacheMipStreamingTest() override;
+
+    void onEnter() override;
+    std::string title() const override { return "TextureCache::setMipStreaming"; }
+    std::string subtitle() const override { return "the lower mip levels stream in as the sprite grows"; }
+};
+
 #endif  // _TEXTURECACHE_TEST_H_
@@ -19,6 +19,7 @@
 
 //cocos2d
 #include "base/Director.h"
+#include "base/JobSystem.h"
 #include "renderer/backend/DriverBase.h"
 
 using namespace Csm;
@@ -200,6 +201,19 @@ void LAppLive2DManager::OnUpdate(Csm::Rendering::CubismCommandBuffer_Cocos2dx* c
 
     Csm::Rendering::CubismRenderer_Cocos2dx::StartFrame(commandBuffer);
 
+    // the models are independent, their motions, physics and deformations are updated on the workers
+    for (csmUint32 i = 0; i < _models.GetSize(); ++i)
+    {
+        GetModel(i)->PrepareUpdate();
+    }
+    auto jobSystem = director->getJobSystem();
+    jobSystem->wait(jobSystem->parallelFor(_models.GetSize(), 1, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            GetModel(static_cast<csmUint32>(i))->UpdateParameters();
+        }
+    }));
+
     for (csmUint32 i = 0; i < _models.GetSize(); ++i)
     {
         CubismMatrix44 projection;
@@ -227,7 +241,6 @@ void LAppLive2DManager::OnUpdate(Csm::Rendering::CubismCommandBuffer_Cocos2dx* c
             _renderBuffer->BeginDraw(commandBuffer, NULL);
             _renderBuffer->Clear(commandBuffer, _clearColor[0], _clearColor[1], _clearColor[2], _clearColor[3]); // 背景クリアカラー
 
-            model->Update();
             model->Draw(commandBuffer, projection);///< 参照渡しなのでprojectionは変質する
 
             _renderBuffer->EndDraw(commandBuffer);
@@ -250,7 +263,6 @@ void LAppLive2DManager::OnUpdate(Csm::Rendering::CubismCommandBuffer_Cocos2dx* c
             commandBuffer = lastCommandBuffer;
         }
         else {
-            model->Update();
             model->Draw(commandBuffer, projection);///< 参照渡しなのでprojectionは変質する
         }
     }
@@ -60,6 +60,8 @@ LAppModel::LAppModel()
     : CubismUserModel()
     , _modelSetting(NULL)
     , _userTimeSeconds(0.0f)
+    , _deltaTimeSeconds(0.0f)
+    , _idleMotionStarted(false)
     , _renderSprite(NULL)
 {
     if (DebugLogEnable)
@@ -373,24 +375,37 @@ void LAppModel::ReleaseExpressions()
 
 void LAppModel::Update()
 {
-    const csmFloat32 deltaTimeSeconds = LAppPal::GetDeltaTime();
-    _userTimeSeconds += deltaTimeSeconds;
+    PrepareUpdate();
+    UpdateParameters();
+}
+
+void LAppModel::PrepareUpdate()
+{
+    _deltaTimeSeconds = LAppPal::GetDeltaTime();
+    _userTimeSeconds += _deltaTimeSeconds;
 
-    _dragManager->Update(deltaTimeSeconds);
+    _dragManager->Update(_deltaTimeSeconds);
     _dragX = _dragManager->GetX();
     _dragY = _dragManager->GetY();
 
+    _idleMotionStarted = _motionManager->IsFinished();
+    if (_idleMotionStarted)
+    {
+        // モーションの再生がない場合、待機モーションの中からランダムで再生する
+        StartRandomMotion(MotionGroupIdle, PriorityIdle);
+    }
+}
+
+void LAppModel::UpdateParameters()
+{
+    const csmFloat32 deltaTimeSeconds = _deltaTimeSeconds;
+
     // モーションによるパラメータ更新の有無
     csmBool motionUpdated = false;
 
     //-----------------------------------------------------------------
     _model->LoadParameters(); // 前回セーブされた状態をロード
-    if (_motionManager->IsFinished())
-    {
-        // モーションの再生がない場合、待機モーションの中からランダムで再生する
-        StartRandomMotion(MotionGroupIdle, PriorityIdle);
-    }
-    else
+    if (!_idleMotionStarted)
     {
         motionUpdated = _motionManager->UpdateMotion(_model, deltaTimeSeconds); // モーションを更新
     }
@@ -53,6 +53,18 @@ public:
      */
     void Update();
 
+    /**
+     * @brief   Update()の前半。時間とドラッグを進め、待機モーションを開始する。
+     *          Starts the idle motions, which load files and play sounds, so it runs on the axmol thread.
+     */
+    void PrepareUpdate();
+
+    /**
+     * @brief   Update()の後半。モーション、物理演算などでパラメータを更新し、頂点を計算する。
+     *          It only touches this model, the models of a scene are updated on the JobSystem workers.
+     */
+    void UpdateParameters();
+
     /**
      * @brief   モデルを描画する処理。モデルを描画する空間のView-Projection行列を渡す。
      *
@@ -186,6 +198,8 @@ private:
     Csm::ICubismModelSetting* _modelSetting;        ///< モデルセッティング情報
     Csm::csmString _modelHomeDir;                   ///< モデルセッティングが置かれたディレクトリ
     Csm::csmFloat32 _userTimeSeconds;               ///< デルタ時間の積算値[秒]
+    Csm::csmFloat32 _deltaTimeSeconds;              ///< PrepareUpdate()で取得したデルタ時間[秒]
+    Csm::csmBool _idleMotionStarted;                ///< PrepareUpdate()で待機モーションを開始した
 
     Csm::csmVector<Csm::CubismIdHandle> _eyeBlinkIds; ///< モデルに設定されたまばたき機能用パラメータID
     Csm::csmVector<Csm::CubismIdHandle> _lipSyncIds;  ///< モデルに設定されたリップシンク機能用パラメータID
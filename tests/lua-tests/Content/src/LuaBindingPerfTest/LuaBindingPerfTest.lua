@@ -0,0 +1,96 @@
+local ITERATIONS = 100000
+
+local function measure(fn)
+    local start = os.clock()
+    fn()
+    return (os.clock() - start) * 1000
+end
+
+local function runBenchmarks(node, child)
+    local results = {}
+    local function add(name, fn)
+        results[#results + 1] = string.format("%-28s %8.2f ms", name, measure(fn))
+    end
+
+    add("empty loop", function()
+        for i = 1, ITERATIONS do
+        end
+    end)
+    add("node:getPosition()", function()
+        for i = 1, ITERATIONS do
+            local x, y = node:getPosition()
+        end
+    end)
+    add("node:setPosition(x, y)", function()
+        for i = 1, ITERATIONS do
+            node:setPosition(i, i)
+        end
+    end)
+    add("node:setPosition(cc.p())", function()
+        for i = 1, ITERATIONS do
+            node:setPosition(cc.p(i, i))
+        end
+    end)
+    add("node:getChildByTag()", function()
+        for i = 1, ITERATIONS do
+            local c = node:getChildByTag(1)
+        end
+    end)
+    add("child:getParent()", function()
+        for i = 1, ITERATIONS do
+            local p = child:getParent()
+        end
+    end)
+    add("node:getContentSize()", function()
+        for i = 1, ITERATIONS do
+            local s = node:getContentSize()
+        end
+    end)
+
+    return results
+end
+
+local function LuaBindingPerfTestLayer()
+    local layer = cc.Layer:create()
+    Helper.initWithLayer(layer)
+    Helper.titleLabel:setString("Lua binding call overhead")
+    Helper.subtitleLabel:setString(ITERATIONS .. " calls per line, touch to run again")
+
+    local node = cc.Node:create()
+    layer:addChild(node)
+    local child = cc.Node:create()
+    node:addChild(child, 0, 1)
+
+    local label = cc.Label:createWithTTF("", "fonts/arial.ttf", 16)
+    label:setPosition(VisibleRect:center())
+    layer:addChild(label)
+
+    local function run()
+        local results = runBenchmarks(node, child)
+        label:setString(table.concat(results, "\n"))
+        for _, line in ipairs(results) do
+            print(line)
+        end
+    end
+
+    local listener = cc.EventListenerTouchOneByOne:create()
+    listener:registerScriptHandler(function() return true end, cc.Handler.EVENT_TOUCH_BEGAN)
+    listener:registerScriptHandler(run, cc.Handler.EVENT_TOUCH_ENDED)
+    layer:getEventDispatcher():addEventListenerWithSceneGraphPriority(listener, layer)
+
+    run()
+    return layer
+end
+
+function LuaBindingPerfTestMain()
+    local scene = cc.Scene:create()
+
+    Helper.createFunctionTable = {
+        LuaBindingPerfTestLayer
+    }
+    Helper.index = 1
+
+    scene:addChild(LuaBindingPerfTestLayer())
+    scene:addChild(CreateBackMenuItem())
+    return scene
+end
@@ -62,6 +62,7 @@ require "Physics3DTest/Physics3DTest"
 require "Scene3DTest/Scene3DTest"
 require "MaterialSystemTest/MaterialSystemTest"
 require "NavMeshTest/NavMeshTest"
+require "LuaBindingPerfTest/LuaBindingPerfTest"
 require "LuaLoaderTest/LuaLoaderTest"
 
 local LINE_SPACE = 40
@@ -118,6 +119,7 @@ local _allTests = {
     { isSupported = true,  name = "LabelTestNew"           , create_func   =                 LabelTestNew      },
     { isSupported = true,  name = "LayerTest"              , create_func   =                 LayerTestMain  },
     { isSupported = true,  name = "LightTest"              , create_func   =                 LightTestMain  },
+    { isSupported = true,  name = "LuaBindingPerfTest"     , create_func   =        LuaBindingPerfTestMain },
     { isSupported = true,  name = "LuaBridgeTest"          , create_func   =        LuaBridgeMainTest },
     { isSupported = true,  name = "LuaLoaderTest"          , create_func   =        LuaLoaderMain },
     { isSupported = true,  name = "MaterialSystemTest"     , create_func   =        MaterialSystemTest },
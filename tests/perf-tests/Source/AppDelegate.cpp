@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "AppDelegate.h"
+#include "Benchmark.h"
+
+using namespace ax;
+
+static Vec2 gWindowSize = Vec2(1024, 768);
+
+void AppDelegate::initGLContextAttrs()
+{
+    // the benchmarks render offscreen: no visible window, no vsync throttling
+    GLContextAttrs glContextAttrs = {8, 8, 8, 8, 24, 8, 0};
+    glContextAttrs.visible        = false;
+    glContextAttrs.vsync          = false;
+
+    GLView::setGLContextAttrs(glContextAttrs);
+}
+
+bool AppDelegate::applicationDidFinishLaunching()
+{
+    return true;
+}
+
+void AppDelegate::applicationDidEnterBackground() {}
+
+void AppDelegate::applicationWillEnterForeground() {}
+
+bool AppDelegate::createHiddenView()
+{
+    initGLContextAttrs();
+
+    auto glView = GLViewImpl::createWithRect("Perf Tests", Rect(0, 0, gWindowSize.x, gWindowSize.y));
+    if (!glView)
+        return false;
+
+    auto director = Director::getInstance();
+    director->setGLView(glView);
+    glView->setDesignResolutionSize(gWindowSize.x, gWindowSize.y, ResolutionPolicy::SHOW_ALL);
+    return true;
+}
+
+int AppDelegate::run(int argc, char** argv)
+{
+    perf::Options options;
+    if (!perf::parseCommandLine(argc, argv, options))
+        return 1;
+
+    ax::setLogFmtFlag(ax::LogFmtFlag::Level);
+    Director::getInstance();
+
+    // the CPU benchmarks still run on hosts without a display
+    bool gpuAvailable = options.gpu && !options.list && createHiddenView();
+    if (options.gpu && !options.list && !gpuAvailable)
+        AXLOGW("Couldn't create a GPU context, the GPU benchmarks are skipped");
+
+    return perf::runBenchmarks(options, gpuAvailable);
+}
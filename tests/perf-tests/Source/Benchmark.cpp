@@ -0,0 +1,318 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+#include "axmol.h"
+
+using namespace ax;
+
+namespace perf
+{
+
+namespace
+{
+
+struct Benchmark
+{
+    std::string name;
+    Function fn;
+    std::vector<int64_t> args;
+};
+
+struct Result
+{
+    std::string name;
+    int64_t arg;
+    bool hasArg;
+    size_t iterations;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+    double itemsPerSecond;
+    std::string skipped;
+};
+
+std::vector<Benchmark>& getBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Result makeResult(std::string_view name, int64_t arg, bool hasArg, const State& state)
+{
+    Result result{std::string{name}, arg, hasArg, state.getIterations(), 0, 0, 0, 0, 0, state.getSkipped()};
+
+    auto samples = state.getSamples();
+    if (samples.empty())
+    {
+        if (result.skipped.empty())
+            result.skipped = "State::run wasn't called";
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    result.minNs    = samples.front();
+    result.medianNs = samples.size() % 2 ? samples[samples.size() / 2]
+                                         : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+    result.meanNs = sum / samples.size();
+
+    double variance = 0;
+    for (auto sample : samples)
+        variance += (sample - result.meanNs) * (sample - result.meanNs);
+    result.stddevNs = std::sqrt(variance / samples.size());
+
+    if (state.getItemsPerCall() > 0 && result.medianNs > 0)
+        result.itemsPerSecond = state.getItemsPerCall() * 1e9 / result.medianNs;
+    return result;
+}
+
+std::string jsonString(std::string_view str)
+{
+    std::string ret = "\"";
+    for (auto ch : str)
+    {
+        if (ch == '"' || ch == '\\')
+            ret += '\\';
+        if (static_cast<unsigned char>(ch) < 0x20)
+            ret += fmt::format("\\u{:04x}", static_cast<int>(ch));
+        else
+            ret += ch;
+    }
+    ret += '"';
+    return ret;
+}
+
+const char* getPlatformName()
+{
+#if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
+    return "windows";
+#elif AX_TARGET_PLATFORM == AX_PLATFORM_MAC
+    return "mac";
+#elif AX_TARGET_PLATFORM == AX_PLATFORM_LINUX
+    return "linux";
+#else
+    return "unknown";
+#endif
+}
+
+std::string toJson(const std::vector<Result>& results, const Options& options, bool gpuAvailable)
+{
+    auto timestamp = std::time(nullptr);
+    char date[32]{};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&timestamp));
+
+    std::string json = "{\n";
+    json += fmt::format("  \"engine\": {},\n", jsonString(axmolVersion()));
+    json += fmt::format("  \"platform\": \"{}\",\n", getPlatformName());
+#if defined(NDEBUG)
+    json += "  \"build\": \"release\",\n";
+#else
+    json += "  \"build\": \"debug\",\n";
+#endif
+    if (gpuAvailable)
+    {
+        auto driver = backend::DriverBase::getInstance();
+        json += fmt::format("  \"gpu\": {},\n", jsonString(fmt::format("{} {}", driver->getVendor(), driver->getRenderer())));
+    }
+    json += fmt::format("  \"date\": \"{}\",\n", date);
+    json += fmt::format("  \"min_time\": {},\n", options.minTime);
+    json += "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto& result = results[i];
+        json += i ? ",\n    {" : "\n    {";
+        json += fmt::format("\"name\": {}", jsonString(result.name));
+        if (result.hasArg)
+            json += fmt::format(", \"arg\": {}", result.arg);
+        if (!result.skipped.empty())
+        {
+            json += fmt::format(", \"skipped\": {}}}", jsonString(result.skipped));
+            continue;
+        }
+        json += fmt::format(", \"iterations\": {}, \"min_ns\": {:.1f}, \"median_ns\": {:.1f}, \"mean_ns\": {:.1f}, \"stddev_ns\": {:.1f}",
+                            result.iterations, result.minNs, result.medianNs, result.meanNs, result.stddevNs);
+        if (result.itemsPerSecond > 0)
+            json += fmt::format(", \"items_per_second\": {:.1f}", result.itemsPerSecond);
+        json += '}';
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+std::string formatTime(double ns)
+{
+    if (ns >= 1e6)
+        return fmt::format("{:.3f} ms", ns / 1e6);
+    if (ns >= 1e3)
+        return fmt::format("{:.3f} us", ns / 1e3);
+    return fmt::format("{:.1f} ns", ns);
+}
+
+}  // namespace
+
+State::State(int64_t arg, double minTime, bool gpuAvailable)
+    : _arg(arg), _minTime(minTime), _gpuAvailable(gpuAvailable)
+{}
+
+bool State::requireGPU()
+{
+    if (!_gpuAvailable)
+        skip("no GPU context");
+    return _gpuAvailable;
+}
+
+void State::measure(const std::function<void(size_t)>& batch)
+{
+    AXASSERT(_samples.empty(), "State::run must be called once");
+
+    // warm up the caches, then grow the batch until it lasts a twentieth of the minimum time
+    batch(1);
+
+    const double sampleTime = _minTime / 20;
+    size_t count            = 1;
+    double elapsed          = 0;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        batch(count);
+        elapsed = elapsedSeconds(start);
+        if (elapsed >= sampleTime || count >= (size_t{1} << 30))
+            break;
+        count *= 2;
+    }
+    _samples.emplace_back(elapsed * 1e9 / count);
+    _iterations = count;
+
+    auto begin = std::chrono::steady_clock::now();
+    while (_samples.size() < 5 || (elapsedSeconds(begin) < _minTime && _samples.size() < 1000))
+    {
+        auto start = std::chrono::steady_clock::now();
+        batch(count);
+        _samples.emplace_back(elapsedSeconds(start) * 1e9 / count);
+        _iterations += count;
+    }
+}
+
+int registerBenchmark(std::string_view name, Function fn, std::vector<int64_t> args)
+{
+    auto& benchmarks = getBenchmarks();
+    benchmarks.emplace_back(Benchmark{std::string{name}, fn, std::move(args)});
+    return static_cast<int>(benchmarks.size());
+}
+
+bool parseCommandLine(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view option = argv[i];
+        if (option.starts_with("--filter="))
+            options.filter = option.substr(9);
+        else if (option.starts_with("--out="))
+            options.output = option.substr(6);
+        else if (option.starts_with("--min-time="))
+            options.minTime = std::max(std::atof(argv[i] + 11), 0.01);
+        else if (option == "--no-gpu")
+            options.gpu = false;
+        else if (option == "--list")
+            options.list = true;
+        else
+        {
+            fmt::println("unknown option: {}", option);
+            fmt::println("usage: perf-tests [--filter=<text>] [--out=<path>] [--min-time=<seconds>] [--no-gpu] [--list]");
+            return false;
+        }
+    }
+    return true;
+}
+
+int runBenchmarks(const Options& options, bool gpuAvailable)
+{
+    // benchmarks registered from several files, keep the report order stable
+    auto benchmarks = getBenchmarks();
+    std::stable_sort(benchmarks.begin(), benchmarks.end(),
+                     [](const Benchmark& a, const Benchmark& b) { return a.name < b.name; });
+
+    std::vector<Result> results;
+    for (auto&& benchmark : benchmarks)
+    {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+
+        auto args   = benchmark.args;
+        bool hasArg = !args.empty();
+        if (!hasArg)
+            args.emplace_back(0);
+
+        for (auto arg : args)
+        {
+            auto name = hasArg ? fmt::format("{}/{}", benchmark.name, arg) : benchmark.name;
+            if (options.list)
+            {
+                fmt::println("{}", name);
+                continue;
+            }
+
+            State state(arg, options.minTime, gpuAvailable);
+            benchmark.fn(state);
+            PoolManager::getInstance()->getCurrentPool()->clear();
+
+            auto& result = results.emplace_back(makeResult(benchmark.name, arg, hasArg, state));
+            if (!result.skipped.empty())
+                fmt::println("{:<48} skipped: {}", name, result.skipped);
+            else
+                fmt::println("{:<48} {:>12} median {:>12} min  {:>10} iterations", name, formatTime(result.medianNs),
+                             formatTime(result.minNs), result.iterations);
+            fflush(stdout);
+        }
+    }
+
+    if (options.list || options.output.empty())
+        return 0;
+
+    if (!FileUtils::getInstance()->writeStringToFile(toJson(results, options, gpuAvailable), options.output))
+    {
+        fmt::println("failed to write {}", options.output);
+        return 1;
+    }
+    fmt::println("results written to {}", options.output);
+    return 0;
+}
+
+}  // namespace perf
@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+namespace perf
+{
+
+/** Keep the compiler from optimizing away a value that is computed but never used. */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ The timing state passed to a benchmark function.
+ A benchmark prepares its data, then calls `run` once with the code to measure. `run` calls it in
+ batches until the minimum time is spent and records the time of one call of each batch.
+ */
+class State
+{
+public:
+    State(int64_t arg, double minTime, bool gpuAvailable);
+
+    /** The argument the benchmark is registered with, 0 when it has none. */
+    int64_t arg() const { return _arg; }
+
+    /** Measure `fn`, must be called once per benchmark. */
+    template <typename F>
+    void run(F&& fn)
+    {
+        measure([&fn](size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                fn();
+        });
+    }
+
+    /** The number of items, e.g. nodes or bytes, one call of the measured code processes. */
+    void setItemsPerCall(int64_t items) { _itemsPerCall = items; }
+
+    /** Returns false and skips the benchmark when no GPU context could be created. */
+    bool requireGPU();
+
+    /** Skip the benchmark, e.g. when its input can't be prepared. */
+    void skip(std::string_view reason) { _skipped = reason; }
+
+    const std::vector<double>& getSamples() const { return _samples; }
+    size_t getIterations() const { return _iterations; }
+    int64_t getItemsPerCall() const { return _itemsPerCall; }
+    const std::string& getSkipped() const { return _skipped; }
+
+private:
+    void measure(const std::function<void(size_t)>& batch);
+
+    int64_t _arg;
+    double _minTime;
+    bool _gpuAvailable;
+
+    /** nanoseconds per call of each batch */
+    std::vector<double> _samples;
+    size_t _iterations    = 0;
+    int64_t _itemsPerCall = 0;
+    std::string _skipped;
+};
+
+using Function = void (*)(State&);
+
+/** Register a benchmark, it runs once per argument or once without an argument when `args` is empty. */
+int registerBenchmark(std::string_view name, Function fn, std::vector<int64_t> args = {});
+
+struct Options
+{
+    /** only run the benchmarks whose name contains it */
+    std::string filter;
+    /** the path of the JSON report, nothing is written when empty */
+    std::string output = "perf-results.json";
+    /** the minimum seconds spent measuring one benchmark */
+    double minTime = 0.5;
+    bool list      = false;
+    bool gpu       = true;
+};
+
+/** Parse `--filter=<text> --out=<path> --min-time=<seconds> --no-gpu --list`, returns false on bad options. */
+bool parseCommandLine(int argc, char** argv, Options& options);
+
+/** Run the benchmarks and write the report, returns the process exit code. */
+int runBenchmarks(const Options& options, bool gpuAvailable);
+
+}  // namespace perf
+
+#define PERF_CONCAT_IMPL(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_IMPL(a, b)
+
+/** Register `fn` under `name`, the optional arguments are the values of `State::arg`. */
+#define PERF_BENCHMARK(name, fn, ...) \
+    static const int PERF_CONCAT(s_perfBenchmark, __LINE__) = perf::registerBenchmark(name, fn, {__VA_ARGS__})
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Benchmark.h"
+#include "2d/ActionEase.h"
+#include "2d/ActionInterval.h"
+#include "2d/ActionManager.h"
+#include "2d/Node.h"
+#include "2d/TweenSystem.h"
+#include "base/RefPtr.h"
+
+using namespace ax;
+
+// `count` running nodes under a root, the tweens never finish while measured
+static constexpr float TWEEN_DURATION = 1.0e6f;
+
+static Node* createRunningNodes(int64_t count)
+{
+    auto root = Node::create();
+    for (int64_t i = 0; i < count; ++i)
+        root->addChild(Node::create());
+    root->onEnter();
+    return root;
+}
+
+static void ActionManager_update_moveTo(perf::State& state)
+{
+    RefPtr<Node> root = createRunningNodes(state.arg());
+    RefPtr<ActionManager> manager = ReferencedObject<ActionManager>{new ActionManager()};
+
+    for (auto child : root->getChildren())
+    {
+        auto action = EaseSineInOut::create(MoveTo::create(TWEEN_DURATION, Vec2(100, 100)));
+        manager->addAction(action, child, false);
+    }
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { manager->update(1.0f / 60); });
+
+    manager->removeAllActions();
+    root->onExit();
+}
+PERF_BENCHMARK("2d/ActionManager/update_moveTo", ActionManager_update_moveTo, 1000, 20000);
+
+static void TweenSystem_update_moveTo(perf::State& state)
+{
+    RefPtr<Node> root = createRunningNodes(state.arg());
+    TweenSystem tweens;
+    // the single threaded loop, the parallel one is measured below
+    tweens.setParallelThreshold(0);
+
+    for (auto child : root->getChildren())
+        tweens.moveTo(child, TWEEN_DURATION, Vec2(100, 100), tweenfunc::Sine_EaseInOut);
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { tweens.update(1.0f / 60); });
+
+    tweens.stopAll();
+    root->onExit();
+}
+PERF_BENCHMARK("2d/TweenSystem/update_moveTo", TweenSystem_update_moveTo, 1000, 20000);
+
+static void TweenSystem_update_moveTo_parallel(perf::State& state)
+{
+    RefPtr<Node> root = createRunningNodes(state.arg());
+    TweenSystem tweens;
+    tweens.setParallelThreshold(1);
+
+    for (auto child : root->getChildren())
+        tweens.moveTo(child, TWEEN_DURATION, Vec2(100, 100), tweenfunc::Sine_EaseInOut);
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { tweens.update(1.0f / 60); });
+
+    tweens.stopAll();
+    root->onExit();
+}
+PERF_BENCHMARK("2d/TweenSystem/update_moveTo_parallel", TweenSystem_update_moveTo_parallel, 1000, 20000);
@@ -0,0 +1,55 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "2d/FontAtlas.h"
+#include "2d/FontFreeType.h"
+
+using namespace ax;
+
+static void FontAtlas_prepareLetterDefinitions(perf::State& state)
+{
+    if (!state.requireGPU())
+        return;
+
+    RefPtr<FontFreeType> font = FontFreeType::create("fonts/Marker Felt.ttf", static_cast<int>(state.arg()),
+                                                     GlyphCollection::DYNAMIC, ""sv);
+    if (!font)
+    {
+        state.skip("missing fonts/Marker Felt.ttf");
+        return;
+    }
+
+    std::u32string glyphs;
+    for (char32_t ch = 32; ch < 127; ++ch)
+        glyphs += ch;
+
+    // a new atlas for each call, so every glyph is rendered and inserted
+    state.setItemsPerCall(static_cast<int64_t>(glyphs.size()));
+    state.run([&] {
+        auto atlas = font->newFontAtlas();
+        atlas->prepareLetterDefinitions(glyphs);
+        atlas->release();
+    });
+}
+PERF_BENCHMARK("2d/FontAtlas/prepareLetterDefinitions", FontAtlas_prepareLetterDefinitions, 16, 48);
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "2d/Label.h"
+
+using namespace ax;
+
+static const char* FONT_FILE = "fonts/Marker Felt.ttf";
+
+static std::string makeText(int64_t length, char first)
+{
+    static const std::string_view words = "the quick brown fox jumps over the lazy dog ";
+
+    std::string text;
+    for (int64_t i = 0; i < length; ++i)
+        text += i ? words[i % words.size()] : first;
+    return text;
+}
+
+// `setString` ignores unchanged text, so two strings of the same length take turns
+static void layout(perf::State& state, float maxLineWidth)
+{
+    if (!state.requireGPU())
+        return;
+
+    RefPtr<Label> label = Label::createWithTTF("", FONT_FILE, 24);
+    if (!label)
+    {
+        state.skip(fmt::format("missing {}", FONT_FILE));
+        return;
+    }
+    label->setMaxLineWidth(maxLineWidth);
+
+    std::string texts[] = {makeText(state.arg(), 'A'), makeText(state.arg(), 'B')};
+    label->setString(texts[1]);
+    label->updateContent();
+
+    int index = 0;
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        label->setString(texts[index ^= 1]);
+        label->updateContent();
+    });
+}
+
+static void Label_layout(perf::State& state)
+{
+    layout(state, 0);
+}
+PERF_BENCHMARK("2d/Label/layout", Label_layout, 16, 256, 4096);
+
+static void Label_layout_wrapped(perf::State& state)
+{
+    layout(state, 320);
+}
+PERF_BENCHMARK("2d/Label/layout_wrapped", Label_layout_wrapped, 16, 256, 4096);
@@ -0,0 +1,72 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "2d/Node.h"
+#include "base/Director.h"
+
+using namespace ax;
+
+// a synthetic tree of `count` nodes, 8 children per node
+static Node* createTree(int64_t count)
+{
+    auto root = Node::create();
+    std::vector<Node*> parents{root};
+    for (int64_t created = 1, parent = 0; created < count; ++created)
+    {
+        auto node = Node::create();
+        node->setPosition(static_cast<float>(created % 64), static_cast<float>(created % 48));
+        node->setRotation(static_cast<float>(created % 360));
+        parents[parent]->addChild(node);
+        parents.emplace_back(node);
+        if (parents[parent]->getChildrenCount() == 8)
+            ++parent;
+    }
+    return root;
+}
+
+static void Node_visit(perf::State& state)
+{
+    RefPtr<Node> root = createTree(state.arg());
+    auto renderer     = Director::getInstance()->getRenderer();
+
+    // nothing moves, the cached transforms are reused
+    state.setItemsPerCall(state.arg());
+    state.run([&] { root->visit(renderer, Mat4::IDENTITY, 0); });
+}
+PERF_BENCHMARK("2d/Node/visit", Node_visit, 100, 1000, 10000);
+
+static void Node_visit_dirty(perf::State& state)
+{
+    RefPtr<Node> root = createTree(state.arg());
+    auto renderer     = Director::getInstance()->getRenderer();
+
+    // the root moves every frame, all transforms are recomputed
+    float x = 0;
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        root->setPositionX(x += 1.0f);
+        root->visit(renderer, Mat4::IDENTITY, 0);
+    });
+}
+PERF_BENCHMARK("2d/Node/visit_dirty", Node_visit_dirty, 100, 1000, 10000);
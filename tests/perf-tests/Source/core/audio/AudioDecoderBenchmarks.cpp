@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "audio/AudioConvert.h"
+#include "audio/AudioDecoder.h"
+#include "audio/AudioDecoderManager.h"
+#include "platform/FileUtils.h"
+
+#include <cmath>
+
+using namespace ax;
+
+// a second of 48kHz stereo, about what a streamed music decodes per second
+static const uint32_t FRAMES   = 48000;
+static const uint32_t CHANNELS = 2;
+
+static std::vector<float> makePlane(float phase)
+{
+    std::vector<float> plane(FRAMES);
+    for (uint32_t i = 0; i < FRAMES; ++i)
+        plane[i] = 0.8f * std::sin(phase + 0.0577f * i);
+    return plane;
+}
+
+static void AudioConvert_planarFloatToS16(perf::State& state)
+{
+    auto left                   = makePlane(0.0f);
+    auto right                  = makePlane(1.0f);
+    const float* const planes[] = {left.data(), right.data()};
+    std::vector<int16_t> pcm(FRAMES * CHANNELS);
+
+    state.setItemsPerCall(FRAMES);
+    state.run([&] {
+        AudioConvert::planarFloatToS16(planes, CHANNELS, FRAMES, pcm.data());
+        perf::doNotOptimize(pcm.data());
+    });
+}
+PERF_BENCHMARK("audio/AudioConvert/planarFloatToS16", AudioConvert_planarFloatToS16);
+
+static void AudioConvert_s24ToFloat(perf::State& state)
+{
+    std::vector<uint8_t> packed(FRAMES * CHANNELS * 3);
+    for (size_t i = 0; i < packed.size(); ++i)
+        packed[i] = static_cast<uint8_t>(i * 7);
+    std::vector<float> pcm(FRAMES * CHANNELS);
+
+    state.setItemsPerCall(FRAMES);
+    state.run([&] {
+        AudioConvert::s24ToFloat(packed.data(), pcm.size(), pcm.data());
+        perf::doNotOptimize(pcm.data());
+    });
+}
+PERF_BENCHMARK("audio/AudioConvert/s24ToFloat", AudioConvert_s24ToFloat);
+
+static void AudioConvert_s32ToFloat(perf::State& state)
+{
+    std::vector<int32_t> samples(FRAMES * CHANNELS);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<int32_t>(i * 2654435761u);
+    std::vector<float> pcm(FRAMES * CHANNELS);
+
+    state.setItemsPerCall(FRAMES);
+    state.run([&] {
+        AudioConvert::s32ToFloat(samples.data(), pcm.size(), pcm.data());
+        perf::doNotOptimize(pcm.data());
+    });
+}
+PERF_BENCHMARK("audio/AudioConvert/s32ToFloat", AudioConvert_s32ToFloat);
+
+// writes a .wav file of the bit depth, the engine has no encoder for the compressed formats
+static std::string writeWav(uint16_t bits)
+{
+    const uint32_t bytesPerSample = bits / 8;
+    const uint32_t dataSize       = FRAMES * CHANNELS * bytesPerSample;
+
+    std::vector<uint8_t> wav;
+    auto put = [&wav](uint32_t value, uint32_t bytes) {
+        for (uint32_t i = 0; i < bytes; ++i)
+            wav.emplace_back(static_cast<uint8_t>(value >> (i * 8)));
+    };
+    wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+    put(36 + dataSize, 4);
+    wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put(16, 4);
+    put(1, 2);  // PCM
+    put(CHANNELS, 2);
+    put(48000, 4);
+    put(48000 * CHANNELS * bytesPerSample, 4);
+    put(CHANNELS * bytesPerSample, 2);
+    put(bits, 2);
+    wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+    put(dataSize, 4);
+
+    auto plane = makePlane(0.0f);
+    for (uint32_t i = 0; i < FRAMES * CHANNELS; ++i)
+    {
+        auto sample = static_cast<int32_t>(plane[i / CHANNELS] * 2147483647.0f);
+        put(static_cast<uint32_t>(sample) >> (32 - bits), bytesPerSample);
+    }
+
+    auto path = fmt::format("{}perf-tests-audio{}.wav", FileUtils::getInstance()->getWritablePath(), bits);
+    Data data;
+    data.copy(wav.data(), static_cast<ssize_t>(wav.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, path) ? path : std::string{};
+}
+
+static void decodeWav(perf::State& state, uint16_t bits)
+{
+    auto path = writeWav(bits);
+    if (path.empty())
+    {
+        state.skip("writing the file failed");
+        return;
+    }
+
+    // room for the frames of the widest output format
+    std::vector<char> pcm(FRAMES * CHANNELS * sizeof(float));
+    state.setItemsPerCall(FRAMES);
+    state.run([&] {
+        auto decoder = AudioDecoderManager::createDecoder(path);
+        if (decoder && decoder->open(path))
+            perf::doNotOptimize(decoder->readFixedFrames(FRAMES, pcm.data()));
+        AudioDecoderManager::destroyDecoder(decoder);
+    });
+    FileUtils::getInstance()->removeFile(path);
+}
+
+static void AudioDecoder_wav16(perf::State& state)
+{
+    decodeWav(state, 16);
+}
+PERF_BENCHMARK("audio/AudioDecoder/wav16", AudioDecoder_wav16);
+
+static void AudioDecoder_wav24(perf::State& state)
+{
+    decodeWav(state, 24);
+}
+PERF_BENCHMARK("audio/AudioDecoder/wav24", AudioDecoder_wav24);
+
+static void AudioDecoder_wav32(perf::State& state)
+{
+    decodeWav(state, 32);
+}
+PERF_BENCHMARK("audio/AudioDecoder/wav32", AudioDecoder_wav32);
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "fmt/format.h"
+#include "rapidjson/document.h"
+#include "simdjson/simdjson.h"
+
+// A CocoStudio armature export like json with `frames` frames, the frames are the bulk of the real files
+static std::string makeArmatureJson(int64_t frames)
+{
+    std::string json = R"({"content_scale":1.0,"armature_data":[{"name":"hero","version":1.6,"bone_data":[)"
+                       R"({"name":"body","parent":"","x":0,"y":0,"z":0,"cX":1,"cY":1,"kX":0,"kY":0,)"
+                       R"("display_data":[{"name":"body.png","displayType":0,"skin_data":[{"x":1,"y":2}]}]}]}],)"
+                       R"("animation_data":[{"name":"hero","mov_data":[{"name":"run","dr":)";
+    json += fmt::format("{}", frames);
+    json += R"(,"lp":true,"to":0,"drTW":10,"twE":0,"mov_bone_data":[{"name":"body","dl":0,"frame_data":[)";
+    for (int64_t i = 0; i < frames; ++i)
+    {
+        if (i)
+            json += ',';
+        json += fmt::format(R"({{"dI":0,"x":{0}.5,"y":{1}.25,"z":0,"cX":1.0,"cY":1.0,"kX":{2},"kY":{2},"fi":{0},)"
+                            R"("twE":0,"tweenFrame":true,"color":{{"a":255,"r":255,"g":{3},"b":255}}}})",
+                            i, i * 2, i % 360, i % 256);
+    }
+    json += R"(]}]}]}],"texture_data":[{"name":"body","width":64,"height":64,"pX":0.5,"pY":0.5}]})";
+    return json;
+}
+
+// Sums the frame fields the armature reader decodes
+static double sumFrames(const rapidjson::Value& root)
+{
+    double sum = root["content_scale"].GetDouble();
+    for (auto& animation : root["animation_data"].GetArray())
+        for (auto& movement : animation["mov_data"].GetArray())
+            for (auto& bone : movement["mov_bone_data"].GetArray())
+                for (auto& frame : bone["frame_data"].GetArray())
+                {
+                    sum += frame["x"].GetDouble() + frame["y"].GetDouble() + frame["kX"].GetDouble() +
+                           frame["fi"].GetDouble();
+                    sum += frame["color"]["g"].GetDouble();
+                }
+    return sum;
+}
+
+static double toDouble(simdjson::simdjson_result<simdjson::ondemand::value> value)
+{
+    double number;
+    return value.get_double().get(number) == simdjson::SUCCESS ? number : 0.0;
+}
+
+static double sumFrames(simdjson::simdjson_result<simdjson::ondemand::object> root)
+{
+    double sum = toDouble(root["content_scale"]);
+    for (auto animation : root["animation_data"])
+        for (auto movement : animation["mov_data"])
+            for (auto bone : movement["mov_bone_data"])
+                for (auto frame : bone["frame_data"])
+                {
+                    sum += toDouble(frame["x"]) + toDouble(frame["y"]) + toDouble(frame["kX"]) +
+                           toDouble(frame["fi"]);
+                    sum += toDouble(frame["color"]["g"]);
+                }
+    return sum;
+}
+
+// The DOM reader cocostudio used for the armature json files
+static void Json_rapidjsonDom(perf::State& state)
+{
+    auto json = makeArmatureJson(state.arg());
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        rapidjson::Document doc;
+        doc.Parse(json.data(), json.size());
+        auto sum = sumFrames(doc);
+        perf::doNotOptimize(sum);
+    });
+}
+PERF_BENCHMARK("base/Json/rapidjsonDom", Json_rapidjsonDom, 1000, 10000);
+
+// The on-demand reader DataReaderHelper::addDataFromJsonCache uses, the parser is kept like in a loading thread
+static void Json_simdjsonOnDemand(perf::State& state)
+{
+    simdjson::padded_string json(makeArmatureJson(state.arg()));
+    simdjson::ondemand::parser parser;
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        auto doc = parser.iterate(json);
+        auto sum = sumFrames(doc.get_object());
+        perf::doNotOptimize(sum);
+    });
+}
+PERF_BENCHMARK("base/Json/simdjsonOnDemand", Json_simdjsonOnDemand, 1000, 10000);
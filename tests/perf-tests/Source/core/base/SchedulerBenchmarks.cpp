@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "base/Scheduler.h"
+
+using namespace ax;
+
+static void Scheduler_update(perf::State& state)
+{
+    RefPtr<Scheduler> scheduler = new Scheduler();
+    scheduler->release();
+
+    // one timer per target, half of them fire every frame
+    std::vector<int> targets(static_cast<size_t>(state.arg()));
+    int64_t calls = 0;
+    for (size_t i = 0; i < targets.size(); ++i)
+        scheduler->schedule([&calls](float) { ++calls; }, &targets[i], i % 2 ? 0.0f : 1.0f, false, "timer");
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { scheduler->update(1.0f / 60); });
+    perf::doNotOptimize(calls);
+
+    scheduler->unscheduleAll();
+}
+PERF_BENCHMARK("base/Scheduler/update", Scheduler_update, 100, 1000, 10000);
+
+static void Scheduler_update_sparse(perf::State& state)
+{
+    RefPtr<Scheduler> scheduler = new Scheduler();
+    scheduler->release();
+
+    // low frequency timers, a few of them are due each frame
+    std::vector<int> targets(static_cast<size_t>(state.arg()));
+    int64_t calls = 0;
+    for (size_t i = 0; i < targets.size(); ++i)
+        scheduler->schedule([&calls](float) { ++calls; }, &targets[i], 5.0f + (i % 100) * 0.1f, false, "timer");
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { scheduler->update(1.0f / 60); });
+    perf::doNotOptimize(calls);
+
+    scheduler->unscheduleAll();
+}
+PERF_BENCHMARK("base/Scheduler/update_sparse", Scheduler_update_sparse, 100, 1000, 10000);
+
+namespace
+{
+struct Updatable
+{
+    int64_t* calls;
+    void update(float) { ++*calls; }
+};
+}  // namespace
+
+static void Scheduler_update_updates(perf::State& state)
+{
+    RefPtr<Scheduler> scheduler = new Scheduler();
+    scheduler->release();
+
+    // per frame update callbacks, like Node::scheduleUpdate
+    int64_t calls = 0;
+    std::vector<Updatable> targets(static_cast<size_t>(state.arg()), Updatable{&calls});
+    for (size_t i = 0; i < targets.size(); ++i)
+        scheduler->scheduleUpdate(&targets[i], 0, false);
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] { scheduler->update(1.0f / 60); });
+    perf::doNotOptimize(calls);
+
+    scheduler->unscheduleAll();
+}
+PERF_BENCHMARK("base/Scheduler/update_per_frame", Scheduler_update_updates, 100, 1000, 10000);
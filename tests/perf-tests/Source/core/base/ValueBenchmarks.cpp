@@ -0,0 +1,83 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+// a sprite sheet like property list with `frames` entries
+static std::string makePlist(int64_t frames)
+{
+    std::string plist =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+        "<plist version=\"1.0\">\n<dict>\n<key>frames</key>\n<dict>\n";
+    for (int64_t i = 0; i < frames; ++i)
+    {
+        plist += fmt::format(
+            "<key>frame_{0}.png</key>\n<dict>\n"
+            "<key>frame</key><string>{{{{{1},{2}}},{{32,32}}}}</string>\n"
+            "<key>offset</key><string>{{0,0}}</string>\n"
+            "<key>rotated</key><{3}/>\n"
+            "<key>sourceSize</key><string>{{32,32}}</string>\n"
+            "<key>index</key><integer>{0}</integer>\n"
+            "<key>scale</key><real>1.5</real>\n"
+            "</dict>\n",
+            i, i % 32 * 32, i / 32 * 32, i % 2 ? "true" : "false");
+    }
+    plist += "</dict>\n<key>metadata</key>\n<dict>\n<key>format</key><integer>2</integer>\n"
+             "<key>textureFileName</key><string>sheet.png</string>\n</dict>\n</dict>\n</plist>\n";
+    return plist;
+}
+
+static void FileUtils_getValueMapFromData(perf::State& state)
+{
+    auto plist = makePlist(state.arg());
+    auto size  = static_cast<int>(plist.size());
+    if (FileUtils::getInstance()->getValueMapFromData(plist.data(), size).size() != 2)
+    {
+        state.skip("invalid property list");
+        return;
+    }
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        auto map = FileUtils::getInstance()->getValueMapFromData(plist.data(), size);
+        perf::doNotOptimize(map);
+    });
+}
+PERF_BENCHMARK("base/Value/getValueMapFromData", FileUtils_getValueMapFromData, 100, 1000);
+
+static void Value_copy(perf::State& state)
+{
+    auto plist = makePlist(state.arg());
+    Value value(FileUtils::getInstance()->getValueMapFromData(plist.data(), static_cast<int>(plist.size())));
+
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        Value copy(value);
+        perf::doNotOptimize(copy);
+    });
+}
+PERF_BENCHMARK("base/Value/copy", Value_copy, 100, 1000);
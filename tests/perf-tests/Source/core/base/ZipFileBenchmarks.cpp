@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "base/ZipUtils.h"
+
+using namespace ax;
+
+static const int ZIP_ENTRIES = 64;
+
+static void put16(std::vector<uint8_t>& out, uint32_t value)
+{
+    out.emplace_back(static_cast<uint8_t>(value));
+    out.emplace_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t value)
+{
+    put16(out, value & 0xffff);
+    put16(out, value >> 16);
+}
+
+/**
+ An in memory archive of `ZIP_ENTRIES` text files of `size` bytes. The raw deflate stream and the
+ crc32 of an entry are taken from the gzip container ZipUtils::compressGZ writes.
+ */
+static std::vector<uint8_t> makeZip(size_t size, bool deflated)
+{
+    std::vector<uint8_t> zip, directory;
+    for (int i = 0; i < ZIP_ENTRIES; ++i)
+    {
+        std::string content;
+        while (content.size() < size)
+            content += fmt::format("line {} of file {}\n", content.size(), i);
+        content.resize(size);
+
+        auto gz      = ZipUtils::compressGZ(content.data(), content.size());
+        uint32_t crc = 0;
+        for (int byte = 0; byte < 4; ++byte)
+            crc |= static_cast<uint32_t>(gz[gz.size() - 8 + byte]) << (byte * 8);
+
+        auto data   = deflated ? std::span<const uint8_t>(gz.data() + 10, gz.size() - 18)
+                               : std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(content.data()), size);
+        auto name   = fmt::format("file{}.txt", i);
+        auto offset = static_cast<uint32_t>(zip.size());
+
+        // local file header
+        put32(zip, 0x04034b50);
+        put16(zip, 20);
+        put16(zip, 0);
+        put16(zip, deflated ? 8 : 0);
+        put16(zip, 0);
+        put16(zip, 0x21);
+        put32(zip, crc);
+        put32(zip, static_cast<uint32_t>(data.size()));
+        put32(zip, static_cast<uint32_t>(size));
+        put16(zip, static_cast<uint32_t>(name.size()));
+        put16(zip, 0);
+        zip.insert(zip.end(), name.begin(), name.end());
+        zip.insert(zip.end(), data.begin(), data.end());
+
+        // central directory entry
+        put32(directory, 0x02014b50);
+        put16(directory, 20);
+        put16(directory, 20);
+        put16(directory, 0);
+        put16(directory, deflated ? 8 : 0);
+        put16(directory, 0);
+        put16(directory, 0x21);
+        put32(directory, crc);
+        put32(directory, static_cast<uint32_t>(data.size()));
+        put32(directory, static_cast<uint32_t>(size));
+        put16(directory, static_cast<uint32_t>(name.size()));
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put32(directory, 0);
+        put32(directory, offset);
+        directory.insert(directory.end(), name.begin(), name.end());
+    }
+
+    auto directoryOffset = static_cast<uint32_t>(zip.size());
+    zip.insert(zip.end(), directory.begin(), directory.end());
+
+    // end of central directory
+    put32(zip, 0x06054b50);
+    put16(zip, 0);
+    put16(zip, 0);
+    put16(zip, ZIP_ENTRIES);
+    put16(zip, ZIP_ENTRIES);
+    put32(zip, static_cast<uint32_t>(directory.size()));
+    put32(zip, directoryOffset);
+    put16(zip, 0);
+    return zip;
+}
+
+static void getFileData(perf::State& state, bool deflated)
+{
+    auto size = static_cast<size_t>(state.arg());
+    auto zip  = makeZip(size, deflated);
+    std::unique_ptr<ZipFile> archive(ZipFile::createWithBuffer(zip.data(), static_cast<unsigned long>(zip.size())));
+    if (!archive || !archive->fileExists("file0.txt"))
+    {
+        state.skip("invalid archive");
+        return;
+    }
+
+    std::vector<std::string> names;
+    for (int i = 0; i < ZIP_ENTRIES; ++i)
+        names.emplace_back(fmt::format("file{}.txt", i));
+
+    std::string content;
+    ResizableBufferAdapter<std::string> buffer(&content);
+    int index = 0;
+    state.setItemsPerCall(state.arg());
+    state.run([&] {
+        archive->getFileData(names[index++ % ZIP_ENTRIES], &buffer);
+        perf::doNotOptimize(content.data());
+    });
+}
+
+static void ZipFile_getFileData_deflated(perf::State& state)
+{
+    getFileData(state, true);
+}
+PERF_BENCHMARK("base/ZipFile/getFileData_deflated", ZipFile_getFileData_deflated, 4096, 262144);
+
+static void ZipFile_getFileData_stored(perf::State& state)
+{
+    getFileData(state, false);
+}
+PERF_BENCHMARK("base/ZipFile/getFileData_stored", ZipFile_getFileData_stored, 4096, 262144);
@@ -0,0 +1,53 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "math/Mat4.h"
+
+using namespace ax;
+
+static void Mat4_multiply(perf::State& state)
+{
+    Mat4 a, b, dst;
+    Mat4::createRotationZ(0.5f, &a);
+    Mat4::createTranslation(10.0f, 20.0f, 0.0f, &b);
+
+    state.run([&] {
+        Mat4::multiply(a, b, &dst);
+        perf::doNotOptimize(dst);
+    });
+}
+PERF_BENCHMARK("math/Mat4/multiply", Mat4_multiply);
+
+static void Mat4_transformVector(perf::State& state)
+{
+    Mat4 m;
+    Mat4::createRotationZ(0.5f, &m);
+    Vec4 v(1.0f, 2.0f, 3.0f, 1.0f), dst;
+
+    state.run([&] {
+        m.transformVector(v, &dst);
+        perf::doNotOptimize(dst);
+    });
+}
+PERF_BENCHMARK("math/Mat4/transformVector", Mat4_transformVector);
@@ -0,0 +1,134 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+
+using namespace ax;
+
+static const int IMAGE_SIZE = 256;
+
+static std::vector<uint8_t> makePixels()
+{
+    std::vector<uint8_t> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+    for (int y = 0; y < IMAGE_SIZE; ++y)
+    {
+        for (int x = 0; x < IMAGE_SIZE; ++x)
+        {
+            auto pixel = &pixels[(y * IMAGE_SIZE + x) * 4];
+            pixel[0]   = static_cast<uint8_t>(x);
+            pixel[1]   = static_cast<uint8_t>(y);
+            pixel[2]   = static_cast<uint8_t>(x ^ y);
+            pixel[3]   = 255;
+        }
+    }
+    return pixels;
+}
+
+// encode with the engine's own writer, then keep the file contents in memory
+static Data encodeImage(std::string_view extension)
+{
+    auto pixels = makePixels();
+    auto path   = fmt::format("{}perf-tests-image{}", FileUtils::getInstance()->getWritablePath(), extension);
+
+    auto image = new Image();
+    image->initWithRawData(pixels.data(), static_cast<ssize_t>(pixels.size()), IMAGE_SIZE, IMAGE_SIZE, 8);
+    Data data;
+    if (image->saveToFile(path, false))
+        data = FileUtils::getInstance()->getDataFromFile(path);
+    FileUtils::getInstance()->removeFile(path);
+    image->release();
+    return data;
+}
+
+// a bottom-up 32 bits BMP, the engine doesn't write BMP files
+static Data encodeBmp()
+{
+    auto pixels = makePixels();
+
+    std::vector<uint8_t> bmp(54);
+    auto put32 = [&bmp](size_t offset, uint32_t value) {
+        for (int i = 0; i < 4; ++i)
+            bmp[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+    };
+    bmp[0] = 'B';
+    bmp[1] = 'M';
+    put32(2, static_cast<uint32_t>(54 + pixels.size()));
+    put32(10, 54);
+    put32(14, 40);
+    put32(18, IMAGE_SIZE);
+    put32(22, IMAGE_SIZE);
+    bmp[26] = 1;
+    bmp[28] = 32;
+    put32(34, static_cast<uint32_t>(pixels.size()));
+
+    for (int y = IMAGE_SIZE - 1; y >= 0; --y)
+    {
+        for (int x = 0; x < IMAGE_SIZE; ++x)
+        {
+            auto pixel = &pixels[(y * IMAGE_SIZE + x) * 4];
+            uint8_t bgra[] = {pixel[2], pixel[1], pixel[0], pixel[3]};
+            bmp.insert(bmp.end(), bgra, bgra + 4);
+        }
+    }
+
+    Data data;
+    data.copy(bmp.data(), static_cast<ssize_t>(bmp.size()));
+    return data;
+}
+
+static void decode(perf::State& state, const Data& data)
+{
+    if (data.isNull())
+    {
+        state.skip("encoding failed");
+        return;
+    }
+
+    state.setItemsPerCall(IMAGE_SIZE * IMAGE_SIZE);
+    state.run([&] {
+        auto image = new Image();
+        image->initWithImageData(data.getBytes(), data.getSize());
+        perf::doNotOptimize(image->getData());
+        image->release();
+    });
+}
+
+static void Image_initWithImageData_png(perf::State& state)
+{
+    decode(state, encodeImage(".png"));
+}
+PERF_BENCHMARK("platform/Image/initWithImageData_png", Image_initWithImageData_png);
+
+static void Image_initWithImageData_jpg(perf::State& state)
+{
+    decode(state, encodeImage(".jpg"));
+}
+PERF_BENCHMARK("platform/Image/initWithImageData_jpg", Image_initWithImageData_jpg);
+
+static void Image_initWithImageData_bmp(perf::State& state)
+{
+    decode(state, encodeBmp());
+}
+PERF_BENCHMARK("platform/Image/initWithImageData_bmp", Image_initWithImageData_bmp);
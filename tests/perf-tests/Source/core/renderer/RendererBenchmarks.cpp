@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "Benchmark.h"
+#include "2d/Scene.h"
+#include "2d/Sprite.h"
+#include "base/Director.h"
+#include "platform/Image.h"
+#include "renderer/Texture2D.h"
+
+using namespace ax;
+
+static RefPtr<Texture2D> createTexture(uint8_t shade)
+{
+    std::vector<uint8_t> pixels(32 * 32 * 4, shade);
+
+    auto image = new Image();
+    image->initWithRawData(pixels.data(), static_cast<ssize_t>(pixels.size()), 32, 32, 8);
+
+    RefPtr<Texture2D> texture = new Texture2D();
+    texture->initWithImage(image);
+    texture->release();
+    image->release();
+    return texture;
+}
+
+// `textures` alternating textures, every texture switch breaks the batch
+static void spriteFrame(perf::State& state, int textures)
+{
+    if (!state.requireGPU())
+        return;
+
+    std::vector<RefPtr<Texture2D>> atlas;
+    for (int i = 0; i < textures; ++i)
+        atlas.emplace_back(createTexture(static_cast<uint8_t>(255 - i * 64)));
+
+    RefPtr<Scene> scene = Scene::create();
+    auto size           = Director::getInstance()->getWinSize();
+    for (int64_t i = 0; i < state.arg(); ++i)
+    {
+        auto sprite = Sprite::createWithTexture(atlas[i % textures]);
+        sprite->setPosition(static_cast<float>(i * 7 % static_cast<int64_t>(size.width)),
+                            static_cast<float>(i * 13 % static_cast<int64_t>(size.height)));
+        scene->addChild(sprite);
+    }
+
+    // the scene becomes the running one on the first frame, which is the warm up call of `run`
+    auto director = Director::getInstance();
+    if (director->getRunningScene())
+        director->replaceScene(scene);
+    else
+        director->runWithScene(scene);
+
+    state.setItemsPerCall(state.arg());
+    state.run([director] { director->drawScene(); });
+}
+
+static void Renderer_sprites(perf::State& state)
+{
+    spriteFrame(state, 1);
+}
+PERF_BENCHMARK("renderer/Renderer/sprites", Renderer_sprites, 100, 1000, 10000);
+
+static void Renderer_sprites_batch_breaks(perf::State& state)
+{
+    spriteFrame(state, 2);
+}
+PERF_BENCHMARK("renderer/Renderer/sprites_batch_breaks", Renderer_sprites_batch_breaks, 100, 1000, 10000);
@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "2d/NodePool.h"
+#include "base/AutoreleasePool.h"
+
+using namespace ax;
+
+TEST_SUITE("2d/NodePool") {
+    TEST_CASE("recycle") {
+        auto parent = Node();
+        int resets  = 0;
+        NodePool<Node> pool(2, [&](Node* node) { ++resets; node->setPosition(Vec2::ZERO); });
+
+        Node* node;
+        {
+            AutoreleasePool frame;
+            node = pool.obtain();
+            parent.addChild(node);
+        }
+        CHECK_EQ(node->getNodePool(), &pool);
+        CHECK_EQ(pool.getNodeCount(), 1);
+
+        node->setPosition(10.0f, 20.0f);
+        node->removeFromParent();
+        CHECK_EQ(pool.getFreeCount(), 1);
+        CHECK_EQ(pool.getRecycledCount(), 1);
+        CHECK_EQ(resets, 1);
+        CHECK_EQ(node->getReferenceCount(), 1);
+
+        {
+            AutoreleasePool frame;
+            CHECK_EQ(pool.obtain(), node);
+            CHECK_EQ(node->getPosition(), Vec2::ZERO);
+            CHECK_EQ(pool.getFreeCount(), 0);
+            CHECK_EQ(pool.getNodeCount(), 1);
+        }
+    }
+
+    TEST_CASE("retained nodes are not recycled") {
+        auto parent = Node();
+        NodePool<Node> pool(2);
+
+        Node* kept;
+        {
+            AutoreleasePool frame;
+            kept = pool.obtain();
+            parent.addChild(kept);
+            parent.addChild(pool.obtain());
+            parent.addChild(pool.obtain());
+            kept->retain();
+        }
+        CHECK_EQ(pool.getNodeCount(), 3);
+
+        parent.removeAllChildren();
+        CHECK_EQ(pool.getFreeCount(), 2);
+        CHECK_EQ(kept->getReferenceCount(), 1);
+
+        kept->release();
+        CHECK_EQ(pool.getNodeCount(), 2);
+
+        pool.setCapacity(1);
+        CHECK_EQ(pool.getFreeCount(), 1);
+        CHECK_EQ(pool.getNodeCount(), 1);
+    }
+
+    TEST_CASE("nodes outlive the pool") {
+        auto parent = Node();
+        Node* node;
+        {
+            NodePool<Node> pool;
+            {
+                AutoreleasePool frame;
+                node = pool.obtain();
+                parent.addChild(node);
+            }
+        }
+        CHECK_EQ(node->getNodePool(), nullptr);
+        node->removeFromParent();
+        CHECK_EQ(parent.getChildrenCount(), 0);
+    }
+}
@@ -59,4 +59,75 @@ TEST_SUITE("2d/Node") {
         CHECK_EQ(200.0f, node.getPosition().x);
         CHECK_EQ(100.0f, node.getPosition().y);
     }
+
+    TEST_CASE("transforms") {
+        auto parent = Node();
+        auto node = Node();
+        parent.setPosition(30.0f, -10.0f);
+        parent.setRotation(25.0f);
+        node.setParent(&parent);
+        node.setContentSize(Vec2(40.0f, 20.0f));
+        node.setAnchorPoint(Vec2(0.5f, 0.25f));
+        node.setPosition3D(Vec3(12.0f, 7.0f, -3.0f));
+        node.setRotation(-35.0f);
+        node.setScale(1.5f, 0.75f);
+        node.setSkewX(10.0f);
+        node.setSkewY(-5.0f);
+
+        // translation * rotation * scale * skew, then the anchor point
+        Mat4 expected, rotation, skew;
+        Mat4::createTranslation(12.0f, 7.0f, -3.0f, &expected);
+        Mat4::createRotationZ(AX_DEGREES_TO_RADIANS(35.0f), &rotation);
+        expected *= rotation;
+        expected.scale(1.5f, 0.75f, 1.0f);
+        skew.m[1] = tanf(AX_DEGREES_TO_RADIANS(-5.0f));
+        skew.m[4] = tanf(AX_DEGREES_TO_RADIANS(10.0f));
+        expected *= skew;
+        expected.translate(-20.0f, -5.0f, 0.0f);
+
+        auto& local = node.getNodeToParentTransform();
+        for (int k = 0; k < 16; ++k)
+            CHECK(local.m[k] == doctest::Approx(expected.m[k]).epsilon(1e-5));
+
+        auto world = parent.getNodeToParentTransform() * expected;
+        auto inverse = world.getInversed();
+        auto nodeToWorld = node.getNodeToWorldTransform();
+        auto worldToNode = node.getWorldToNodeTransform();
+        for (int k = 0; k < 16; ++k)
+        {
+            CHECK(nodeToWorld.m[k] == doctest::Approx(world.m[k]).epsilon(1e-5));
+            CHECK(worldToNode.m[k] == doctest::Approx(inverse.m[k]).epsilon(1e-5));
+        }
+
+        auto point = node.convertToNodeSpace(node.convertToWorldSpace(Vec2(3.0f, 4.0f)));
+        CHECK(point.x == doctest::Approx(3.0f));
+        CHECK(point.y == doctest::Approx(4.0f));
+    }
+
+    TEST_CASE("subtree_camera_mask") {
+        auto grandChild = Node();
+        auto child = Node();
+        auto parent = Node();
+        parent.addChild(&child);
+        child.addChild(&grandChild);
+
+        const auto user1 = (unsigned short)CameraFlag::USER1;
+        const auto user2 = (unsigned short)CameraFlag::USER2;
+        CHECK_EQ(1, parent.getSubtreeCameraMask());
+
+        grandChild.setCameraMask(user1);
+        CHECK_EQ(1 | user1, parent.getSubtreeCameraMask());
+        CHECK_EQ(1 | user1, child.getSubtreeCameraMask());
+
+        parent.setCameraMask(user2);
+        CHECK_EQ(user2, parent.getSubtreeCameraMask());
+
+        // the removed subtree doesn't count anymore
+        child.removeChild(&grandChild);
+        grandChild.setCameraMask(user1);
+        parent.addChild(&grandChild);
+        CHECK_EQ(user2 | user1, parent.getSubtreeCameraMask());
+        parent.removeChild(&grandChild);
+        CHECK_EQ(user2, parent.getSubtreeCameraMask());
+    }
 }
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <algorithm>
+#include "2d/Node.h"
+#include "2d/SpatialGrid.h"
+
+using namespace ax;
+
+static bool contains(const std::vector<Node*>& nodes, Node* node)
+{
+    return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+}
+
+TEST_SUITE("2d/SpatialGrid") {
+    TEST_CASE("query") {
+        auto near = Node();
+        auto far = Node();
+        auto big = Node();
+        near.setContentSize(Vec2(50.0f, 50.0f));
+        near.setPosition(10.0f, 10.0f);
+        far.setContentSize(Vec2(50.0f, 50.0f));
+        far.setPosition(5000.0f, 5000.0f);
+        big.setContentSize(Vec2(100000.0f, 100.0f));
+
+        SpatialGrid grid(100.0f);
+        grid.insert(&near);
+        grid.insert(&far);
+        grid.insert(&big);
+        grid.refresh();
+        CHECK_EQ(3, grid.size());
+
+        std::vector<Node*> nodes;
+        grid.query(Rect(0.0f, 0.0f, 200.0f, 200.0f), nodes);
+        CHECK_EQ(2, nodes.size());
+        CHECK(contains(nodes, &near));
+        CHECK(contains(nodes, &big));
+
+        // spanning several cells, returned once
+        nodes.clear();
+        grid.query(Rect(-1000.0f, -1000.0f, 10000.0f, 10000.0f), nodes);
+        CHECK_EQ(3, nodes.size());
+
+        grid.remove(&near);
+        nodes.clear();
+        grid.query(Rect(0.0f, 0.0f, 200.0f, 200.0f), nodes);
+        CHECK_EQ(1, nodes.size());
+        CHECK(contains(nodes, &big));
+    }
+
+    TEST_CASE("children_move") {
+        auto child = Node();
+        auto parent = Node();
+        parent.setSpatialIndexEnabled(true, 100.0f);
+        child.setContentSize(Vec2(10.0f, 10.0f));
+        parent.addChild(&child);
+
+        auto grid = parent.getSpatialIndex();
+        std::vector<Node*> nodes;
+        grid->refresh();
+        grid->query(Rect(0.0f, 0.0f, 100.0f, 100.0f), nodes);
+        CHECK_EQ(1, nodes.size());
+
+        // moving marks the child dirty in the grid of its parent
+        child.setPosition(1000.0f, 1000.0f);
+        grid->refresh();
+        nodes.clear();
+        grid->query(Rect(0.0f, 0.0f, 100.0f, 100.0f), nodes);
+        CHECK(nodes.empty());
+        grid->query(Rect(950.0f, 950.0f, 100.0f, 100.0f), nodes);
+        CHECK_EQ(1, nodes.size());
+
+        parent.removeChild(&child, false);
+        CHECK_EQ(0, grid->size());
+    }
+}
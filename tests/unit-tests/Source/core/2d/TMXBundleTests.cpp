@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/TMXBundle.h"
+#include "2d/TMXXMLParser.h"
+#include "platform/FileUtils.h"
+#include "base/axstd.h"
+
+using namespace ax;
+
+TEST_SUITE("2d/TMXBundle")
+{
+    static void fillMapInfo(TMXMapInfo* mapInfo, std::string_view dir)
+    {
+        mapInfo->setOrientation(TMXOrientationIso);
+        mapInfo->setMapSize(Vec2(3, 2));
+        mapInfo->setTileSize(Vec2(32, 16));
+        mapInfo->getProperties()["name"] = Value("level1");
+        mapInfo->getTileProperties()[5]  = Value(ValueMap{{"solid", Value(true)}});
+
+        auto tileset          = new TMXTilesetInfo();
+        tileset->_name        = "ground";
+        tileset->_firstGid    = 1;
+        tileset->_tileSize    = Vec2(32, 16);
+        tileset->_imageSize   = Vec2(128, 64);
+        tileset->_sourceImage = std::string{dir} + "ground.png";
+        auto animation        = TMXTileAnimInfo::create(4);
+        animation->_frames.emplace_back(4, 0.1f);
+        animation->_frames.emplace_back(5, 0.2f);
+        tileset->_animationInfo.insert(4, animation);
+        mapInfo->getTilesets().pushBack(tileset);
+        tileset->release();
+
+        auto layer        = new TMXLayerInfo();
+        layer->_name      = "background";
+        layer->_layerSize = Vec2(3, 2);
+        layer->_visible   = true;
+        layer->_opacity   = 200;
+        layer->_offset    = Vec2(1, 2);
+        layer->_tiles     = axstd::pod_vector<uint32_t>(6).release_pointer();
+        for (uint32_t i = 0; i < 6; ++i)
+            layer->_tiles[i] = i + 1;
+        layer->_tiles[5] |= kTMXTileHorizontalFlag;
+        layer->getProperties()["depth"] = Value(2.5f);
+        mapInfo->getLayers().pushBack(layer);
+        layer->release();
+
+        auto group = new TMXObjectGroup();
+        group->setGroupName("spawns");
+        group->setPositionOffset(Vec2(4, 8));
+        group->getProperties()["count"] = Value(int64_t{1} << 40);
+        group->getObjects().emplace_back(Value(ValueMap{
+            {"name", Value("player")},
+            {"points", Value(ValueVector{Value(1), Value(2.0)})},
+        }));
+        mapInfo->getObjectGroups().pushBack(group);
+        group->release();
+    }
+
+    TEST_CASE("write_load")
+    {
+        auto dir  = FileUtils::getInstance()->getWritablePath();
+        auto path = dir + "tmx_bundle_test.tmxb";
+
+        auto source = new TMXMapInfo();
+        fillMapInfo(source, dir);
+        REQUIRE(TMXBundle::write(path, source, dir));
+        source->release();
+
+        auto mapInfo = TMXMapInfo::create(path);
+        REQUIRE(mapInfo != nullptr);
+        CHECK_EQ(mapInfo->getOrientation(), TMXOrientationIso);
+        CHECK_EQ(mapInfo->getMapSize(), Vec2(3, 2));
+        CHECK_EQ(mapInfo->getTileSize(), Vec2(32, 16));
+        CHECK_EQ(mapInfo->getProperties()["name"].asString(), "level1");
+        CHECK(mapInfo->getTileProperties()[5].asValueMap()["solid"].asBool());
+
+        REQUIRE_EQ(mapInfo->getTilesets().size(), 1);
+        auto tileset = mapInfo->getTilesets().at(0);
+        CHECK_EQ(tileset->_name, "ground");
+        CHECK_EQ(tileset->_sourceImage, dir + "ground.png");
+        CHECK_EQ(tileset->_imageSize, Vec2(128, 64));
+        REQUIRE_EQ(tileset->_animationInfo.size(), 1);
+        auto animation = tileset->_animationInfo.at(4);
+        REQUIRE(animation != nullptr);
+        REQUIRE_EQ(animation->_frames.size(), 2);
+        CHECK_EQ(animation->_frames[1]._tileID, 5);
+        CHECK_EQ(animation->_frames[1]._duration, 0.2f);
+
+        REQUIRE_EQ(mapInfo->getLayers().size(), 1);
+        auto layer = mapInfo->getLayers().at(0);
+        CHECK_EQ(layer->_name, "background");
+        CHECK_EQ(layer->_opacity, 200);
+        CHECK_EQ(layer->_offset, Vec2(1, 2));
+        CHECK_EQ(layer->getProperties()["depth"].asFloat(), 2.5f);
+        REQUIRE(layer->_tiles != nullptr);
+        CHECK_EQ(layer->_tiles[0], 1);
+        CHECK_EQ(layer->_tiles[5], 6 | kTMXTileHorizontalFlag);
+
+        REQUIRE_EQ(mapInfo->getObjectGroups().size(), 1);
+        auto group = mapInfo->getObjectGroups().at(0);
+        CHECK_EQ(group->getGroupName(), "spawns");
+        CHECK_EQ(group->getPositionOffset(), Vec2(4, 8));
+        CHECK_EQ(group->getProperty("count").getType(), Value::Type::INT_I64);
+        CHECK_EQ(group->getProperty("count").asInt64(), int64_t{1} << 40);
+        auto object = group->getObject("player");
+        REQUIRE_EQ(object["points"].asValueVector().size(), 2);
+        CHECK_EQ(object["points"].asValueVector()[1].getType(), Value::Type::DOUBLE);
+
+        FileUtils::getInstance()->removeFile(path);
+    }
+
+    TEST_CASE("invalid")
+    {
+        auto path = FileUtils::getInstance()->getWritablePath() + "tmx_bundle_invalid.tmxb";
+        FileUtils::getInstance()->writeStringToFile("not a tile map bundle", path);
+
+        TMXBundle bundle;
+        CHECK_FALSE(bundle.load(path));
+        CHECK_FALSE(bundle.isLoaded());
+        CHECK(TMXMapInfo::create(path) == nullptr);
+
+        FileUtils::getInstance()->removeFile(path);
+    }
+}
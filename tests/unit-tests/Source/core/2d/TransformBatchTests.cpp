@@ -0,0 +1,214 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "2d/Node.h"
+#include "2d/TransformBatch.h"
+
+using namespace ax;
+
+namespace
+{
+class ProbeNode : public Node
+{
+public:
+    const Mat4& getWorldTransform() const { return _modelViewTransform; }
+
+    // what Node::visit does with the transforms
+    void visitTransforms(const Mat4& parentTransform, uint32_t parentFlags)
+    {
+        uint32_t flags = processParentFlags(parentTransform, parentFlags);
+        if (getTransformBatch())
+            getTransformBatch()->update(this, flags);
+        for (auto child : _children)
+            static_cast<ProbeNode*>(child)->visitTransforms(_modelViewTransform, flags);
+    }
+};
+
+ProbeNode* addProbe(Node* parent, std::vector<ProbeNode*>& nodes)
+{
+    auto node = new ProbeNode();
+    parent->addChild(node);
+    node->release();
+    nodes.push_back(node);
+    return node;
+}
+
+// 3 levels of varied nodes: rotated, scaled, anchored, skewed and rotated out of the XY plane
+ProbeNode* createTree(std::vector<ProbeNode*>& nodes)
+{
+    auto root = new ProbeNode();
+    for (int i = 0; i < 5; ++i)
+    {
+        auto child = addProbe(root, nodes);
+        child->setPosition(10.0f * i, -3.0f * i);
+        child->setRotation(17.0f * i);
+        child->setScale(1.0f + 0.25f * i);
+        for (int j = 0; j < 7; ++j)
+        {
+            auto leaf = addProbe(child, nodes);
+            leaf->setContentSize(Size(20.0f, 10.0f));
+            leaf->setAnchorPoint(Vec2(0.5f, 0.25f * (j % 3)));
+            leaf->setPosition3D(Vec3(1.0f * j, 2.0f * i, 0.5f * j));
+            leaf->setRotation(-11.0f * j);
+            leaf->setScaleX(0.5f + j);
+            leaf->setIgnoreAnchorPointForPosition(j == 2);
+            if (j == 3)
+                leaf->setSkewX(12.0f);
+            if (j == 4)
+                leaf->setRotation3D(Vec3(30.0f, 10.0f * i, 5.0f));
+            if (j == 5)
+                leaf->setRotationSkewX(20.0f);
+            addProbe(leaf, nodes)->setPosition(3.0f, 4.0f);
+        }
+    }
+    return root;
+}
+
+void checkWorldTransforms(const std::vector<ProbeNode*>& nodes)
+{
+    for (auto node : nodes)
+    {
+        auto expected = node->getNodeToWorldTransform();
+        for (int k = 0; k < 16; ++k)
+            CHECK(node->getWorldTransform().m[k] == doctest::Approx(expected.m[k]).epsilon(1e-5));
+    }
+}
+}  // namespace
+
+TEST_SUITE("2d/TransformBatch") {
+    TEST_CASE("local transforms") {
+        std::vector<ProbeNode*> nodes;
+        auto root = createTree(nodes);
+
+        for (auto node : nodes)
+        {
+            if (!TransformBatch::isBatchable(node))
+                continue;
+            auto expected = node->getNodeToParentTransform();
+            Node* batched = node;
+            TransformBatch::computeLocalTransforms(&batched, 1);
+            auto& local = node->getNodeToParentTransform();
+            for (int k = 0; k < 16; ++k)
+                CHECK(local.m[k] == doctest::Approx(expected.m[k]).epsilon(1e-6));
+        }
+        root->release();
+    }
+
+    TEST_CASE("multiply") {
+        Mat4 parent;
+        Mat4::createRotation(Vec3(0.3f, 1.0f, 0.2f).getNormalized(), 0.7f, &parent);
+        parent.translate(4.0f, -2.0f, 9.0f);
+        parent.scale(1.5f, 0.5f, 2.0f);
+
+        Mat4 affine, rotated;
+        Mat4::createRotationZ(0.4f, &affine);
+        affine.translate(3.0f, 1.0f, -2.0f);
+        Mat4::createRotationX(0.4f, &rotated);
+        rotated.translate(3.0f, 1.0f, -2.0f);
+
+        for (auto& local : {affine, rotated})
+        {
+            Mat4 dst;
+            TransformBatch::multiply(parent, local, dst);
+            auto expected = parent * local;
+            for (int k = 0; k < 16; ++k)
+                CHECK(dst.m[k] == doctest::Approx(expected.m[k]).epsilon(1e-6));
+        }
+    }
+
+    TEST_CASE("invert") {
+        Mat4 affine, rotated;
+        Mat4::createRotationZ(0.4f, &affine);
+        affine.translate(3.0f, 1.0f, -2.0f);
+        affine.scale(2.0f, 0.5f, 4.0f);
+        Mat4::createRotationX(0.4f, &rotated);
+        rotated.translate(3.0f, 1.0f, -2.0f);
+
+        for (auto& m : {affine, rotated})
+        {
+            Mat4 dst;
+            TransformBatch::invert(m, dst);
+            auto expected = m.getInversed();
+            for (int k = 0; k < 16; ++k)
+                CHECK(dst.m[k] == doctest::Approx(expected.m[k]).epsilon(1e-5));
+        }
+    }
+
+    TEST_CASE("world transforms") {
+        std::vector<ProbeNode*> nodes;
+        auto root = createTree(nodes);
+
+        TransformBatch batch;
+        batch.update(root, Node::FLAGS_TRANSFORM_DIRTY);
+        CHECK_EQ(nodes.size(), batch.getNodeCount());
+        CHECK_EQ(nodes.size(), batch.getUpdatedCount());
+        // the skewed and rotation skewed leaves are left to getNodeToParentTransform
+        CHECK_EQ(nodes.size() - 10, batch.getBatchedCount());
+        checkWorldTransforms(nodes);
+
+        // invisible subtrees are left to the visit
+        nodes[0]->setVisible(false);
+        batch.update(root, 0);
+        CHECK_EQ(nodes.size() - 15, batch.getNodeCount());
+        root->release();
+    }
+
+    TEST_CASE("visit") {
+        std::vector<ProbeNode*> nodes;
+        auto root = createTree(nodes);
+        root->setTransformBatchRoot(true);
+        CHECK(root->isTransformBatchRoot());
+
+        root->visitTransforms(Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+        checkWorldTransforms(nodes);
+        CHECK_EQ(nodes.size(), root->getTransformBatch()->getUpdatedCount());
+
+        // only the moved subtree is dirty on the next visit
+        nodes[0]->setPosition(-40.0f, 25.0f);
+        root->visitTransforms(Mat4::IDENTITY, 0);
+        checkWorldTransforms(nodes);
+        CHECK_EQ(15, root->getTransformBatch()->getUpdatedCount());
+
+        root->setTransformBatchRoot(false);
+        CHECK_FALSE(root->isTransformBatchRoot());
+        root->release();
+    }
+
+    TEST_CASE("changes after the batch") {
+        std::vector<ProbeNode*> nodes;
+        auto root = createTree(nodes);
+
+        TransformBatch batch;
+        batch.update(root, Node::FLAGS_TRANSFORM_DIRTY);
+
+        // a node moving between the batch and its visit gets its transform and its subtree computed again
+        nodes[0]->setRotation(45.0f);
+        for (auto child : root->getChildren())
+            static_cast<ProbeNode*>(child)->visitTransforms(root->getWorldTransform(), Node::FLAGS_TRANSFORM_DIRTY);
+        checkWorldTransforms(nodes);
+        root->release();
+    }
+}
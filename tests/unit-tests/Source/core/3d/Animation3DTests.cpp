@@ -0,0 +1,148 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "3d/Animation3D.h"
+
+USING_NS_AX;
+
+TEST_SUITE("3d/Animation3D")
+{
+    static Animation3D* createAnimation()
+    {
+        Animation3DData data;
+        data._totalTime = 2.0f;
+
+        auto& trans = data._translationKeys["root"];
+        trans.emplace_back(0.0f, Vec3(0.0f, 0.0f, 0.0f));
+        trans.emplace_back(0.5f, Vec3(10.0f, -4.0f, 2.0f));
+        trans.emplace_back(1.0f, Vec3(-6.0f, 8.0f, 1.0f));
+
+        Quaternion rot;
+        Quaternion::createFromAxisAngle(Vec3::UNIT_Y, AX_DEGREES_TO_RADIANS(170), &rot);
+        auto& rots = data._rotationKeys["root"];
+        rots.emplace_back(0.0f, Quaternion::identity());
+        rots.emplace_back(1.0f, rot);
+
+        auto& scales = data._scaleKeys["arm"];
+        scales.emplace_back(0.0f, Vec3(1.0f, 1.0f, 1.0f));
+        scales.emplace_back(1.0f, Vec3(2.0f, 0.5f, 1.0f));
+
+        auto animation = new Animation3D();
+        animation->init(data);
+        return animation;
+    }
+
+    TEST_CASE("bake")
+    {
+        auto animation = createAnimation();
+        REQUIRE(animation->getBakedClip() == nullptr);
+        REQUIRE(animation->bake(30.0f));
+
+        auto clip = animation->getBakedClip();
+        REQUIRE(clip != nullptr);
+        CHECK_EQ(clip->getTrackCount(), 2);
+        CHECK_EQ(clip->getLaneCount(), 4);
+        CHECK_EQ(clip->getFrameCount(), 61);
+        CHECK_EQ(clip->getPoseSize(), Animation3D::BakedClip::CHANNEL_COUNT * 4);
+
+        // baking again keeps the clip
+        CHECK(animation->bake(60.0f));
+        CHECK_EQ(animation->getBakedClip(), clip);
+
+        animation->release();
+    }
+
+    TEST_CASE("sample")
+    {
+        auto animation = createAnimation();
+        animation->bake(30.0f);
+        auto clip       = animation->getBakedClip();
+        const int lanes = clip->getLaneCount();
+
+        std::vector<float> pose(clip->getPoseSize());
+        for (int track = 0; track < clip->getTrackCount(); ++track)
+        {
+            auto curve = animation->getBoneCurveByName(clip->getTrackNames()[track]);
+            REQUIRE(curve != nullptr);
+            CHECK_EQ((clip->getTrackFlags(track) & Animation3D::BakedClip::HAS_TRANSLATION) != 0,
+                     curve->translateCurve != nullptr);
+            CHECK_EQ((clip->getTrackFlags(track) & Animation3D::BakedClip::HAS_ROTATION) != 0,
+                     curve->rotCurve != nullptr);
+            CHECK_EQ((clip->getTrackFlags(track) & Animation3D::BakedClip::HAS_SCALE) != 0,
+                     curve->scaleCurve != nullptr);
+
+            for (float t : {0.0f, 0.13f, 0.37f, 0.5f, 0.81f, 1.0f})
+            {
+                clip->sample(t, pose.data());
+                float expected[4];
+                if (curve->translateCurve)
+                {
+                    curve->translateCurve->evaluate(t, expected, EvaluateType::INT_LINEAR);
+                    for (int c = 0; c < 3; ++c)
+                        CHECK_EQ(pose[(Animation3D::BakedClip::CHANNEL_TRANSLATE + c) * lanes + track],
+                                 doctest::Approx(expected[c]).epsilon(0.01));
+                }
+                if (curve->rotCurve)
+                {
+                    curve->rotCurve->evaluate(t, expected, EvaluateType::INT_QUAT_SLERP);
+                    float dot = 0.0f;
+                    for (int c = 0; c < 4; ++c)
+                        dot += pose[(Animation3D::BakedClip::CHANNEL_ROTATION + c) * lanes + track] * expected[c];
+                    CHECK_GT(std::abs(dot), 0.9999f);
+                }
+                if (curve->scaleCurve)
+                {
+                    curve->scaleCurve->evaluate(t, expected, EvaluateType::INT_LINEAR);
+                    for (int c = 0; c < 3; ++c)
+                        CHECK_EQ(pose[(Animation3D::BakedClip::CHANNEL_SCALE + c) * lanes + track],
+                                 doctest::Approx(expected[c]).epsilon(0.01));
+                }
+                else
+                {
+                    // the channels without a curve keep the identity
+                    CHECK_EQ(pose[Animation3D::BakedClip::CHANNEL_SCALE * lanes + track], doctest::Approx(1.0f));
+                }
+            }
+        }
+
+        animation->release();
+    }
+
+    TEST_CASE("sample_nearest")
+    {
+        auto animation = createAnimation();
+        animation->bake(10.0f);
+        auto clip = animation->getBakedClip();
+
+        std::vector<float> nearest(clip->getPoseSize()), frame(clip->getPoseSize());
+        // 21 frames, t = 0.52 falls between frame 10 and 11 and is closer to frame 10
+        clip->sample(0.52f, nearest.data(), true);
+        clip->sample(0.5f, frame.data());
+        for (size_t i = 0; i < frame.size(); ++i)
+            CHECK_EQ(nearest[i], doctest::Approx(frame[i]));
+
+        animation->release();
+    }
+}
@@ -0,0 +1,177 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/BoundsTree.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace ax;
+
+TEST_SUITE("3d/BoundsTree")
+{
+    static Node* fakeNode(int i)
+    {
+        return reinterpret_cast<Node*>(static_cast<uintptr_t>(i + 1) * 16);
+    }
+
+    static AABB randomBox(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.5f, 5.0f);
+        Vec3 min(position(rng), position(rng), position(rng));
+        return AABB(min, min + Vec3(size(rng), size(rng), size(rng)));
+    }
+
+    static std::vector<Node*> sorted(std::vector<Node*> nodes)
+    {
+        std::sort(nodes.begin(), nodes.end());
+        return nodes;
+    }
+
+    TEST_CASE("queries")
+    {
+        std::mt19937 rng(7);
+        BoundsTree tree;
+        std::vector<AABB> boxes;
+        std::vector<int> proxies;
+        for (int i = 0; i < 500; ++i)
+        {
+            boxes.emplace_back(randomBox(rng));
+            proxies.emplace_back(tree.insert(fakeNode(i), boxes.back()));
+        }
+        CHECK_EQ(500, tree.size());
+        CHECK_LE(tree.getHeight(), 20);
+
+        // move half of them, a few only slightly
+        for (int i = 0; i < 500; i += 2)
+        {
+            if (i % 10 == 0)
+                boxes[i] = AABB(boxes[i]._min + Vec3(0.01f, 0.0f, 0.0f), boxes[i]._max + Vec3(0.01f, 0.0f, 0.0f));
+            else
+                boxes[i] = randomBox(rng);
+            tree.update(proxies[i], boxes[i]);
+        }
+        CHECK_FALSE(tree.update(proxies[0], boxes[0]));
+        for (int i = 1; i < 500; i += 4)
+            tree.remove(proxies[i]);
+        CHECK_EQ(375, tree.size());
+        CHECK_LE(tree.getHeight(), 20);
+
+        auto isInTree = [](int i) { return i % 4 != 1; };
+
+        SUBCASE("sphere")
+        {
+            Vec3 center(10.0f, -5.0f, 20.0f);
+            float radius = 30.0f;
+            std::vector<Node*> expected;
+            for (int i = 0; i < 500; ++i)
+            {
+                Vec3 closest(std::clamp(center.x, boxes[i]._min.x, boxes[i]._max.x),
+                             std::clamp(center.y, boxes[i]._min.y, boxes[i]._max.y),
+                             std::clamp(center.z, boxes[i]._min.z, boxes[i]._max.z));
+                if (isInTree(i) && closest.distanceSquared(center) <= radius * radius)
+                    expected.emplace_back(fakeNode(i));
+            }
+            REQUIRE_FALSE(expected.empty());
+
+            std::vector<Node*> nodes;
+            tree.querySphere(center, radius, nodes);
+            CHECK_EQ(sorted(expected), sorted(nodes));
+        }
+
+        SUBCASE("frustum")
+        {
+            Mat4 projection, view;
+            Mat4::createPerspective(60.0f, 1.5f, 1.0f, 80.0f, &projection);
+            Mat4::createLookAt(Vec3(0.0f, 0.0f, 120.0f), Vec3::ZERO, Vec3::UNIT_Y, &view);
+            Frustum frustum;
+            frustum.initFrustum(projection * view);
+
+            std::vector<Node*> expected;
+            for (int i = 0; i < 500; ++i)
+                if (isInTree(i) && !frustum.isOutOfFrustum(boxes[i]))
+                    expected.emplace_back(fakeNode(i));
+            REQUIRE_FALSE(expected.empty());
+            REQUIRE_LT(expected.size(), 375);
+
+            std::vector<Node*> nodes;
+            tree.queryFrustum(frustum, nodes);
+            CHECK_EQ(sorted(expected), sorted(nodes));
+
+            tree.cull(frustum);
+            for (int i = 0; i < 500; ++i)
+                if (isInTree(i))
+                    CHECK_EQ(tree.isVisible(proxies[i]), !frustum.isOutOfFrustum(boxes[i]));
+        }
+
+        SUBCASE("ray")
+        {
+            Vec3 origin(-150.0f, 1.0f, 2.0f);
+            Ray ray(origin, (boxes[3]._min + boxes[3]._max) * 0.5f - origin);
+            std::vector<Node*> nodes;
+            std::vector<float> distances;
+            tree.queryRay(ray, nodes, FLT_MAX, &distances);
+
+            std::vector<Node*> expected;
+            for (int i = 0; i < 500; ++i)
+                if (isInTree(i) && ray.intersects(boxes[i]))
+                    expected.emplace_back(fakeNode(i));
+            REQUIRE_FALSE(expected.empty());
+            CHECK_EQ(sorted(expected), sorted(nodes));
+            CHECK(std::is_sorted(distances.begin(), distances.end()));
+
+            float distance = 0.0f;
+            CHECK_EQ(nodes[0], tree.raycast(ray, FLT_MAX, &distance));
+            CHECK_EQ(doctest::Approx(distances[0]), distance);
+            CHECK_EQ(nullptr, tree.raycast(ray, distances[0] * 0.5f));
+
+            // from inside of a box
+            int inside = 0;
+            Ray fromInside((boxes[inside]._min + boxes[inside]._max) * 0.5f, Vec3::UNIT_Z);
+            CHECK_EQ(fakeNode(inside), tree.raycast(fromInside, FLT_MAX, &distance));
+            CHECK_EQ(0.0f, distance);
+        }
+    }
+
+    TEST_CASE("reuse_proxies")
+    {
+        BoundsTree tree;
+        int a = tree.insert(fakeNode(0), AABB(Vec3::ZERO, Vec3::ONE));
+        int b = tree.insert(fakeNode(1), AABB(Vec3(2, 0, 0), Vec3(3, 1, 1)));
+        tree.remove(a);
+        int c = tree.insert(fakeNode(2), AABB(Vec3(4, 0, 0), Vec3(5, 1, 1)));
+        CHECK_EQ(2, tree.size());
+        CHECK_EQ(fakeNode(1), tree.getNode(b));
+        CHECK_EQ(fakeNode(2), tree.getNode(c));
+
+        std::vector<Node*> nodes;
+        tree.querySphere(Vec3(0.5f, 0.5f, 0.5f), 0.5f, nodes);
+        CHECK(nodes.empty());
+
+        tree.clear();
+        CHECK_EQ(0, tree.size());
+        CHECK_EQ(nullptr, tree.raycast(Ray(Vec3::ZERO, Vec3::UNIT_X)));
+    }
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/Frustum.h"
+
+#include <random>
+
+using namespace ax;
+
+TEST_SUITE("3d/Frustum")
+{
+    static Frustum createFrustum()
+    {
+        Mat4 projection, view;
+        Mat4::createPerspective(60.0f, 1.5f, 1.0f, 100.0f, &projection);
+        Mat4::createLookAt(Vec3(0.0f, 0.0f, 10.0f), Vec3::ZERO, Vec3::UNIT_Y, &view);
+
+        Frustum frustum;
+        frustum.initFrustum(projection * view);
+        return frustum;
+    }
+
+    TEST_CASE("cull_volumes")
+    {
+        auto frustum = createFrustum();
+
+        BoundsBatch batch;
+        batch.add(AABB(Vec3(-1.0f, -1.0f, -1.0f), Vec3(1.0f, 1.0f, 1.0f)));  // in front of the eye
+        batch.add(AABB(Vec3(-1.0f, -1.0f, 20.0f), Vec3(1.0f, 1.0f, 22.0f)));  // behind the eye
+        batch.add(AABB(Vec3(-500.0f, -1.0f, -1.0f), Vec3(500.0f, 1.0f, 1.0f)));  // crossing the sides
+        batch.add(Vec3(0.0f, 0.0f, -200.0f), 10.0f);  // beyond the far plane
+        batch.add(Vec3(0.0f, 0.0f, -200.0f), 150.0f);  // reaching in
+        batch.add(AABB(Vec3(100.0f, 100.0f, -1.0f), Vec3(101.0f, 101.0f, 1.0f)));  // beside
+
+        std::vector<uint32_t> visibility;
+        frustum.cull(batch, visibility);
+        REQUIRE_EQ(1, visibility.size());
+        CHECK(BoundsBatch::isVisible(visibility, 0));
+        CHECK_FALSE(BoundsBatch::isVisible(visibility, 1));
+        CHECK(BoundsBatch::isVisible(visibility, 2));
+        CHECK_FALSE(BoundsBatch::isVisible(visibility, 3));
+        CHECK(BoundsBatch::isVisible(visibility, 4));
+        CHECK_FALSE(BoundsBatch::isVisible(visibility, 5));
+
+        // all visible when the frustum isn't initialized
+        Frustum empty;
+        empty.cull(batch, visibility);
+        CHECK_EQ(0x3f, visibility[0]);
+    }
+
+    TEST_CASE("cull_matches_single_tests")
+    {
+        auto frustum = createFrustum();
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> size(0.1f, 8.0f);
+
+        // not a multiple of 4, the remainder goes through the scalar path
+        std::vector<AABB> boxes;
+        BoundsBatch batch;
+        for (int i = 0; i < 203; ++i)
+        {
+            Vec3 min(position(rng), position(rng), position(rng) - 40.0f);
+            boxes.emplace_back(min, min + Vec3(size(rng), size(rng), size(rng)));
+            CHECK_EQ(i, batch.add(boxes.back()));
+        }
+
+        std::vector<uint32_t> visibility;
+        frustum.cull(batch, visibility);
+        REQUIRE_EQ(7, visibility.size());
+        int visible = 0;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            CHECK_EQ(!frustum.isOutOfFrustum(boxes[i]), BoundsBatch::isVisible(visibility, i));
+            visible += BoundsBatch::isVisible(visibility, i);
+        }
+        CHECK(visible > 0);
+        CHECK(visible < (int)boxes.size());
+
+        frustum.setClipZ(false);
+        frustum.cull(batch, visibility);
+        for (size_t i = 0; i < boxes.size(); ++i)
+            CHECK_EQ(!frustum.isOutOfFrustum(boxes[i]), BoundsBatch::isVisible(visibility, i));
+    }
+}
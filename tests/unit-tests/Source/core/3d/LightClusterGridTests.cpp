@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/LightClusterGrid.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace ax;
+
+TEST_SUITE("3d/LightClusterGrid")
+{
+    static bool clusterHasLight(const LightClusterGrid& grid, int cluster, uint32_t light)
+    {
+        auto& offsets = grid.getOffsets();
+        auto& indices = grid.getIndices();
+        return std::find(indices.begin() + offsets[cluster], indices.begin() + offsets[cluster + 1], light) !=
+               indices.begin() + offsets[cluster + 1];
+    }
+
+    // every light reaching a point inside the frustum must be in the cluster of the point
+    static void checkConservative(LightClusterGrid& grid, const Mat4& view, float nearPlane, float farPlane)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<Vec4> lights;
+        for (int i = 0; i < 64; ++i)
+            lights.emplace_back(unit(rng) * 80 - 40, unit(rng) * 40 - 20, -unit(rng) * 120, 1 + unit(rng) * 10);
+        grid.build(view, lights);
+
+        auto inverseViewProjection = grid.getViewProjection().getInversed();
+        int tested                 = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            // a point in the frustum, from ndc xy and a view depth
+            float depth = nearPlane + (farPlane - nearPlane) * unit(rng) * unit(rng);
+            Vec2 ndc(unit(rng) * 2 - 1, unit(rng) * 2 - 1);
+            Vec4 onNear = inverseViewProjection * Vec4(ndc.x, ndc.y, -1.0f, 1.0f);
+            Vec4 onFar  = inverseViewProjection * Vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+            Vec3 a(onNear.x / onNear.w, onNear.y / onNear.w, onNear.z / onNear.w);
+            Vec3 b(onFar.x / onFar.w, onFar.y / onFar.w, onFar.z / onFar.w);
+            Vec3 eyeA, eyeB;
+            view.transformPoint(a, &eyeA);
+            view.transformPoint(b, &eyeB);
+            float t       = (depth + eyeA.z) / (eyeA.z - eyeB.z);
+            Vec3 position = a + (b - a) * t;
+            int cluster   = grid.getCluster(position);
+
+            REQUIRE(cluster >= 0);
+            REQUIRE(cluster < LightClusterGrid::CLUSTER_COUNT);
+            for (uint32_t light = 0; light < lights.size(); ++light)
+            {
+                Vec3 center(lights[light].x, lights[light].y, lights[light].z);
+                if (center.distance(position) < lights[light].w * 0.999f)
+                {
+                    CHECK(clusterHasLight(grid, cluster, light));
+                    ++tested;
+                }
+            }
+        }
+        CHECK(tested > 1000);
+    }
+
+    TEST_CASE("perspective")
+    {
+        Mat4 projection, view;
+        Mat4::createPerspective(60, 16.0f / 9.0f, 0.5f, 150.0f, &projection);
+        Mat4::createLookAt(Vec3(0, 5, 10), Vec3(0, 0, -40), Vec3::UNIT_Y, &view);
+
+        LightClusterGrid grid;
+        grid.setProjection(projection, 0.5f, 150.0f);
+        checkConservative(grid, view, 0.5f, 150.0f);
+
+        // the binning must stay far below testing every light in every cluster
+        CHECK(grid.getIndices().size() < 64 * LightClusterGrid::CLUSTER_COUNT / 20);
+    }
+
+    TEST_CASE("orthographic")
+    {
+        Mat4 projection, view;
+        Mat4::createOrthographicOffCenter(-40, 40, -22.5f, 22.5f, 1.0f, 200.0f, &projection);
+        Mat4::createLookAt(Vec3(0, 5, 10), Vec3(0, 0, -40), Vec3::UNIT_Y, &view);
+
+        LightClusterGrid grid;
+        grid.setProjection(projection, 1.0f, 200.0f);
+        checkConservative(grid, view, 1.0f, 200.0f);
+    }
+
+    TEST_CASE("culled")
+    {
+        Mat4 projection;
+        Mat4::createPerspective(60, 1.0f, 1.0f, 100.0f, &projection);
+
+        LightClusterGrid grid;
+        grid.setProjection(projection, 1.0f, 100.0f);
+
+        // behind the camera, past the far plane and outside the sides
+        std::vector<Vec4> lights = {{0, 0, 10, 5}, {0, 0, -200, 50}, {500, 0, -50, 10}, {0, 0, -50, 1}};
+        grid.build(Mat4::IDENTITY, lights);
+
+        auto& indices = grid.getIndices();
+        CHECK(std::count(indices.begin(), indices.end(), 0u) == 0);
+        CHECK(std::count(indices.begin(), indices.end(), 1u) == 0);
+        CHECK(std::count(indices.begin(), indices.end(), 2u) == 0);
+        CHECK(std::count(indices.begin(), indices.end(), 3u) > 0);
+        CHECK(clusterHasLight(grid, grid.getCluster(Vec3(0, 0, -50)), 3));
+        CHECK(grid.getOffsets().size() == LightClusterGrid::CLUSTER_COUNT + 1);
+        CHECK(grid.getOffsets().back() == indices.size());
+    }
+}
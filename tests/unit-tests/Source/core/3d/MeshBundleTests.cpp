@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "3d/MeshBundle.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+TEST_SUITE("3d/MeshBundle")
+{
+    static void fillDatas(MeshDatas& meshdatas, MaterialDatas& materialdatas, NodeDatas& nodedatas, std::string_view dir)
+    {
+        auto meshdata = new MeshData();
+        meshdata->attribs.push_back({backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION});
+        meshdata->attribs.push_back({backend::VertexFormat::FLOAT2, shaderinfos::VertexKey::VERTEX_ATTRIB_TEX_COORD});
+        meshdata->attribCount = 2;
+        meshdata->vertex      = {0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1};
+        meshdata->subMeshIndices.emplace_back(IndexArray{uint16_t{0}, uint16_t{1}, uint16_t{2}});
+        meshdata->subMeshIndices.emplace_back(IndexArray{uint32_t{2}, uint32_t{1}, uint32_t{0}});
+        meshdata->subMeshIds = {"front", "back"};
+        meshdatas.meshDatas.emplace_back(meshdata);
+
+        NMaterialData material;
+        material.id = "skin";
+        NTextureData texture;
+        texture.id       = "diffuse";
+        texture.filename = std::string{dir} + "textures/skin.png";
+        texture.type     = NTextureData::Usage::Diffuse;
+        texture.wrapS    = backend::SamplerAddressMode::REPEAT;
+        texture.wrapT    = backend::SamplerAddressMode::CLAMP_TO_EDGE;
+        material.textures.emplace_back(texture);
+        materialdatas.materials.emplace_back(material);
+
+        auto node = new NodeData();
+        node->id  = "root";
+        node->transform.translate(1, 2, 3);
+        auto model        = new ModelData();
+        model->subMeshId  = "front";
+        model->materialId = "skin";
+        model->bones      = {"hip", "spine"};
+        model->invBindPose.resize(2);
+        node->modelNodeDatas.emplace_back(model);
+        auto child = new NodeData();
+        child->id  = "child";
+        node->children.emplace_back(child);
+        nodedatas.nodes.emplace_back(node);
+
+        auto bone = new NodeData();
+        bone->id  = "hip";
+        nodedatas.skeleton.emplace_back(bone);
+    }
+
+    TEST_CASE("write_load")
+    {
+        auto dir  = FileUtils::getInstance()->getWritablePath();
+        auto path = dir + "mesh_bundle_test.c3m";
+
+        MeshDatas meshdatas;
+        MaterialDatas materialdatas;
+        NodeDatas nodedatas;
+        fillDatas(meshdatas, materialdatas, nodedatas, dir);
+        REQUIRE(MeshBundle::write(path, meshdatas, materialdatas, nodedatas, dir));
+
+        MeshBundle bundle;
+        REQUIRE(bundle.load(path));
+        REQUIRE_EQ(bundle.getMeshCount(), 1);
+        REQUIRE_EQ(bundle.getSubMeshCount(0), 2);
+
+        auto vertices = bundle.getVertices(0);
+        REQUIRE_EQ(vertices.size(), meshdatas.meshDatas[0]->vertex.size());
+        CHECK(std::equal(vertices.begin(), vertices.end(), meshdatas.meshDatas[0]->vertex.begin()));
+        CHECK_EQ(reinterpret_cast<uintptr_t>(vertices.data()) % MeshBundle::BLOB_ALIGNMENT, 0);
+
+        CHECK_EQ(bundle.getIndexFormat(0, 0), backend::IndexFormat::U_SHORT);
+        CHECK_EQ(bundle.getIndexFormat(0, 1), backend::IndexFormat::U_INT);
+        auto indices = bundle.getIndices(0, 1);
+        REQUIRE_EQ(indices.size(), 3 * sizeof(uint32_t));
+        CHECK_EQ(reinterpret_cast<const uint32_t*>(indices.data())[0], 2);
+
+        MaterialDatas loadedMaterials;
+        REQUIRE(bundle.loadMaterials(loadedMaterials));
+        REQUIRE_EQ(loadedMaterials.materials.size(), 1);
+        auto texture = loadedMaterials.materials[0].getTextureData(NTextureData::Usage::Diffuse);
+        REQUIRE(texture != nullptr);
+        CHECK_EQ(texture->filename, dir + "textures/skin.png");
+        CHECK_EQ(texture->wrapS, backend::SamplerAddressMode::REPEAT);
+
+        NodeDatas loadedNodes;
+        REQUIRE(bundle.loadNodes(loadedNodes));
+        REQUIRE_EQ(loadedNodes.nodes.size(), 1);
+        REQUIRE_EQ(loadedNodes.skeleton.size(), 1);
+        auto node = loadedNodes.nodes[0];
+        CHECK_EQ(node->id, "root");
+        CHECK_EQ(memcmp(node->transform.m, nodedatas.nodes[0]->transform.m, sizeof(Mat4::m)), 0);
+        REQUIRE_EQ(node->modelNodeDatas.size(), 1);
+        CHECK_EQ(node->modelNodeDatas[0]->bones.size(), 2);
+        CHECK_EQ(node->modelNodeDatas[0]->invBindPose.size(), 2);
+        REQUIRE_EQ(node->children.size(), 1);
+        CHECK_EQ(node->children[0]->id, "child");
+
+        bundle.clear();
+        FileUtils::getInstance()->removeFile(path);
+    }
+
+    TEST_CASE("invalid")
+    {
+        auto path = FileUtils::getInstance()->getWritablePath() + "mesh_bundle_invalid.c3m";
+        FileUtils::getInstance()->writeStringToFile("not a mesh bundle", path);
+
+        MeshBundle bundle;
+        CHECK_FALSE(bundle.load(path));
+        CHECK_FALSE(bundle.isLoaded());
+        CHECK_EQ(bundle.getMeshCount(), 0);
+
+        FileUtils::getInstance()->removeFile(path);
+    }
+}
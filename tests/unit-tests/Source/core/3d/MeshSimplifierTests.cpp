@@ -0,0 +1,124 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/MeshSimplifier.h"
+
+#include <set>
+
+using namespace ax;
+
+TEST_SUITE("3d/MeshSimplifier")
+{
+    static constexpr int GRID = 16;
+
+    // a flat grid in the xy plane, position and uv per vertex
+    static void makeGrid(std::vector<float>& vertices, IndexArray& indices)
+    {
+        for (int y = 0; y <= GRID; ++y)
+        {
+            for (int x = 0; x <= GRID; ++x)
+            {
+                float u = float(x) / GRID, v = float(y) / GRID;
+                vertices.insert(vertices.end(), {float(x), float(y), 0.0f, u, v});
+            }
+        }
+        for (int y = 0; y < GRID; ++y)
+        {
+            for (int x = 0; x < GRID; ++x)
+            {
+                auto i = static_cast<uint16_t>(y * (GRID + 1) + x);
+                uint16_t quad[] = {i, uint16_t(i + 1), uint16_t(i + GRID + 2), i, uint16_t(i + GRID + 2),
+                                   uint16_t(i + GRID + 1)};
+                for (auto index : quad)
+                    indices.emplace_back(index);
+            }
+        }
+    }
+
+    TEST_CASE("keep_all")
+    {
+        std::vector<float> vertices;
+        IndexArray indices(backend::IndexFormat::U_SHORT);
+        makeGrid(vertices, indices);
+
+        auto result = MeshSimplifier::simplify(vertices, 5, 0, indices, 1.0f);
+        CHECK(result.size() == indices.size());
+        CHECK(memcmp(result.data(), indices.data(), indices.bsize()) == 0);
+    }
+
+    TEST_CASE("simplify_grid")
+    {
+        std::vector<float> vertices;
+        IndexArray indices(backend::IndexFormat::U_SHORT);
+        makeGrid(vertices, indices);
+
+        float error = -1.0f;
+        auto result = MeshSimplifier::simplify(vertices, 5, 0, indices, 0.25f, &error);
+        CHECK(result.format() == backend::IndexFormat::U_SHORT);
+        CHECK(result.size() % 3 == 0);
+        CHECK(result.size() < indices.size() / 2);
+        CHECK(result.size() > 0);
+        // the grid is flat, collapsing inside it is free
+        CHECK(error == doctest::Approx(0.0f));
+
+        const size_t vertexCount = vertices.size() / 5;
+        std::set<uint16_t> used;
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            Vec3 p[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                auto index = result.at<uint16_t>(i + k);
+                REQUIRE(index < vertexCount);
+                used.insert(index);
+                p[k].set(vertices[index * 5], vertices[index * 5 + 1], vertices[index * 5 + 2]);
+            }
+            // no degenerate nor flipped triangle
+            Vec3 n;
+            Vec3::cross(p[1] - p[0], p[2] - p[0], &n);
+            CHECK(n.z > 0.0f);
+        }
+
+        // the border is locked
+        for (int x = 0; x <= GRID; ++x)
+        {
+            CHECK(used.count(uint16_t(x)) == 1);
+            CHECK(used.count(uint16_t(GRID * (GRID + 1) + x)) == 1);
+        }
+    }
+
+    TEST_CASE("welded_seam")
+    {
+        // two quads sharing an edge through duplicated vertices, e.g. a texture seam
+        std::vector<float> vertices = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 0, 2, 0, 0, 2, 1, 0, 1, 1, 0};
+        IndexArray indices(backend::IndexFormat::U_INT);
+        for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u, 4u, 5u, 6u, 4u, 6u, 7u})
+            indices.emplace_back(index);
+
+        // every vertex is on the border of the welded strip, nothing may collapse
+        auto result = MeshSimplifier::simplify(vertices, 3, 0, indices, 0.0f);
+        CHECK(result.format() == backend::IndexFormat::U_INT);
+        CHECK(result.size() == indices.size());
+    }
+}
@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/ShadowCascades.h"
+
+#include <random>
+
+using namespace ax;
+
+TEST_SUITE("3d/ShadowCascades")
+{
+    static Vec3 toClip(const Mat4& matrix, const Vec3& position)
+    {
+        Vec4 clip = matrix * Vec4(position.x, position.y, position.z, 1.0f);
+        return Vec3(clip.x / clip.w, clip.y / clip.w, clip.z / clip.w);
+    }
+
+    static Mat4 cameraView(const Vec3& eye, const Vec3& target)
+    {
+        Mat4 view;
+        Mat4::createLookAt(eye, target, Vec3::UNIT_Y, &view);
+        return view;
+    }
+
+    TEST_CASE("splits")
+    {
+        float splits[ShadowCascades::MAX_CASCADES];
+        ShadowCascades::computeSplits(4, 1.0f, 100.0f, 0.0f, splits);
+        CHECK(splits[0] == doctest::Approx(25.75f));
+        CHECK(splits[3] == 100.0f);
+
+        ShadowCascades::computeSplits(4, 1.0f, 100.0f, 1.0f, splits);
+        CHECK(splits[0] == doctest::Approx(3.1623f));
+        CHECK(splits[1] == doctest::Approx(10.0f));
+
+        ShadowCascades::computeSplits(4, 1.0f, 100.0f, 0.75f, splits);
+        for (int i = 1; i < 4; ++i)
+            CHECK(splits[i] > splits[i - 1]);
+        CHECK(splits[3] == 100.0f);
+
+        // no logarithmic splits without a near plane
+        ShadowCascades::computeSplits(2, 0.0f, 10.0f, 0.75f, splits);
+        CHECK(splits[0] == doctest::Approx(5.0f));
+    }
+
+    TEST_CASE("cascades contain their slice")
+    {
+        Mat4 projection;
+        Mat4::createPerspective(60.0f, 16.0f / 9.0f, 0.5f, 500.0f, &projection);
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (int n = 0; n < 16; ++n)
+        {
+            Vec3 eye(unit(rng) * 100 - 50, unit(rng) * 20, unit(rng) * 100 - 50);
+            Vec3 target(unit(rng) * 100 - 50, 0.0f, unit(rng) * 100 - 50);
+            Mat4 view = cameraView(eye, target);
+            Vec3 light(unit(rng) - 0.5f, -1.0f, unit(rng) - 0.5f);
+
+            ShadowCascades cascades;
+            cascades.setCascadeCount(4);
+            cascades.update(view, projection, 0.5f, 80.0f, light);
+            cascades.computeMatrices();
+
+            const Mat4 inverseViewProjection = (projection * view).getInversed();
+            for (int i = 0; i < 16; ++i)
+            {
+                // a position in the frustum before the shadow distance, in the cascade of its view depth
+                Vec3 ndc(unit(rng) * 2 - 1, unit(rng) * 2 - 1, 0.0f);
+                float depth = 0.5f + 79.5f * unit(rng);
+                float z     = projection.m[10] * -depth + projection.m[14];
+                float w     = projection.m[11] * -depth + projection.m[15];
+                Vec3 position = toClip(inverseViewProjection, Vec3(ndc.x, ndc.y, z / w));
+
+                int cascade = 0;
+                while (depth > cascades.getSplit(cascade))
+                    ++cascade;
+                REQUIRE(cascade < 4);
+
+                Vec3 clip = toClip(cascades.getViewProjection(cascade), position);
+                CHECK(std::abs(clip.x) <= 1.0f);
+                CHECK(std::abs(clip.y) <= 1.0f);
+                CHECK(std::abs(clip.z) <= 1.0f);
+            }
+        }
+    }
+
+    TEST_CASE("casters")
+    {
+        Mat4 projection;
+        Mat4::createPerspective(60.0f, 1.0f, 1.0f, 100.0f, &projection);
+        Mat4 view = cameraView(Vec3(0, 10, 10), Vec3::ZERO);
+
+        ShadowCascades cascades;
+        cascades.setCascadeCount(2);
+        cascades.update(view, projection, 1.0f, 50.0f, Vec3(0, -1, 0));
+        float range = cascades.getDepthRange(0);
+
+        // high above the frustum, towards the light
+        AABB above(Vec3(-1, 200, -1), Vec3(1, 201, 1));
+        CHECK(cascades.addCaster(0, above));
+        CHECK(cascades.getDepthRange(0) > range);
+
+        // below the ground, and beside the frustum
+        CHECK_FALSE(cascades.addCaster(0, AABB(Vec3(-1, -500, -1), Vec3(1, -499, 1))));
+        CHECK_FALSE(cascades.addCaster(0, AABB(Vec3(500, 0, 0), Vec3(501, 1, 1))));
+
+        cascades.computeMatrices();
+        Vec3 clip = toClip(cascades.getViewProjection(0), Vec3(0, 200.5f, 0));
+        CHECK(std::abs(clip.z) <= 1.0f);
+    }
+
+    TEST_CASE("snapping")
+    {
+        Mat4 projection;
+        Mat4::createPerspective(60.0f, 1.0f, 1.0f, 100.0f, &projection);
+
+        ShadowCascades cascades;
+        cascades.setCascadeCount(3);
+        cascades.setMapSize(512);
+        cascades.update(cameraView(Vec3(0, 10, 10), Vec3::ZERO), projection, 1.0f, 60.0f, Vec3(1, -2, 0.5f));
+        cascades.computeMatrices();
+        Mat4 before = cascades.getViewProjection(0);
+        float radius = cascades.getRadius(0);
+
+        // the radius only depends on the projection, the center moves by whole texels
+        Vec3 offset(0.3f, 0.0f, -0.7f);
+        cascades.update(cameraView(Vec3(0, 10, 10) + offset, offset), projection, 1.0f, 60.0f, Vec3(1, -2, 0.5f));
+        cascades.computeMatrices();
+        CHECK(cascades.getRadius(0) == doctest::Approx(radius));
+
+        const Mat4& after = cascades.getViewProjection(0);
+        float texel       = 2.0f / 512;
+        for (int k : {12, 13})
+        {
+            float texels = (after.m[k] - before.m[k]) / texel;
+            CHECK(texels == doctest::Approx(std::round(texels)).epsilon(0.01));
+        }
+
+        // moving less than a texel keeps the matrices
+        float step = 0.2f * 2.0f * radius / 512;
+        Mat4 moved = cascades.getViewProjection(0);
+        int same   = 0;
+        for (int i = 1; i <= 10; ++i)
+        {
+            Vec3 small = offset + Vec3(step * i * 0.1f, 0.0f, 0.0f);
+            cascades.update(cameraView(Vec3(0, 10, 10) + small, small), projection, 1.0f, 60.0f, Vec3(1, -2, 0.5f));
+            cascades.computeMatrices();
+            same += std::equal(moved.m, moved.m + 16, cascades.getViewProjection(0).m);
+        }
+        CHECK(same >= 8);
+    }
+}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "3d/StaticBatch3D.h"
+
+using namespace ax;
+
+TEST_SUITE("3d/StaticBatch3D")
+{
+    // a unit quad in the xy plane facing +z, position, normal and uv per vertex
+    static MeshData makeQuad()
+    {
+        MeshData meshData;
+        meshData.attribs = {
+            {backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION},
+            {backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_NORMAL},
+            {backend::VertexFormat::FLOAT2, shaderinfos::VertexKey::VERTEX_ATTRIB_TEX_COORD},
+        };
+        meshData.vertex = {
+            0, 0, 0, 0, 0, 1, 0, 0,  //
+            1, 0, 0, 0, 0, 1, 1, 0,  //
+            0, 1, 0, 0, 0, 1, 0, 1,  //
+            1, 1, 0, 0, 0, 1, 1, 1,  //
+        };
+        meshData.vertexSizeInFloat = 8;
+        return meshData;
+    }
+
+    TEST_CASE("transform")
+    {
+        auto quad = makeQuad();
+        IndexArray triangles{uint16_t(0), uint16_t(1), uint16_t(2), uint16_t(2), uint16_t(1), uint16_t(3)};
+
+        Mat4 transform;
+        Mat4::createTranslation(10, 0, 0, &transform);
+        transform.scale(2);
+
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        StaticBatch3D::appendMesh(vertices, indices, quad, triangles, transform);
+
+        REQUIRE(vertices.size() == 32);
+        CHECK(indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3});
+
+        // the last vertex
+        CHECK(vertices[24] == doctest::Approx(12));
+        CHECK(vertices[25] == doctest::Approx(2));
+        CHECK(vertices[26] == doctest::Approx(0));
+        CHECK(vertices[29] == doctest::Approx(1));
+        CHECK(vertices[30] == 1);
+        CHECK(vertices[31] == 1);
+    }
+
+    TEST_CASE("normals")
+    {
+        auto quad = makeQuad();
+        for (int i = 0; i < 4; ++i)
+        {
+            quad.vertex[i * 8 + 3] = 1;
+            quad.vertex[i * 8 + 5] = 0;
+        }
+        IndexArray triangle{uint16_t(0), uint16_t(1), uint16_t(2)};
+
+        Mat4 transform;
+        Mat4::createScale(2, 1, 1, &transform);
+
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        StaticBatch3D::appendMesh(vertices, indices, quad, triangle, transform);
+
+        // the normals stay normalized and perpendicular to the scaled surface
+        Vec3 normal(&vertices[3]);
+        CHECK(normal.length() == doctest::Approx(1));
+        CHECK(normal.x == doctest::Approx(1));
+        CHECK(normal.y == doctest::Approx(0));
+    }
+
+    TEST_CASE("merge")
+    {
+        auto quad = makeQuad();
+        IndexArray topRight{uint16_t(3), uint16_t(2), uint16_t(3)};
+
+        Mat4 transform;
+        Mat4::createTranslation(0, 0, 5, &transform);
+
+        // only the used vertices are appended, the indices follow the vertices merged before
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        StaticBatch3D::appendMesh(vertices, indices, quad, topRight, Mat4::IDENTITY);
+        StaticBatch3D::appendMesh(vertices, indices, quad, topRight, transform);
+
+        REQUIRE(vertices.size() == 32);
+        CHECK(indices == std::vector<uint32_t>{0, 1, 0, 2, 3, 2});
+        CHECK(vertices[0] == 1);
+        CHECK(vertices[2] == 0);
+        CHECK(vertices[16] == 1);
+        CHECK(vertices[18] == doctest::Approx(5));
+    }
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include <cstring>
+#include "3d/VertexCompression.h"
+
+using namespace ax;
+
+TEST_SUITE("3d/VertexCompression")
+{
+    TEST_CASE("half")
+    {
+        CHECK(VertexCompression::toHalf(0.0f) == 0);
+        CHECK(VertexCompression::toHalf(1.0f) == 0x3c00);
+        CHECK(VertexCompression::toHalf(-2.0f) == 0xc000);
+        CHECK(VertexCompression::toHalf(65504.0f) == 0x7bff);
+        CHECK(VertexCompression::toHalf(1e6f) == 0x7c00);
+        CHECK(VertexCompression::toHalf(1e-10f) == 0);
+
+        // the smallest denormal, and a tie rounded to the even mantissa
+        CHECK(VertexCompression::toHalf(5.9604645e-8f) == 1);
+        CHECK(VertexCompression::toHalf(1.0f + 1.0f / 2048) == 0x3c00);
+
+        for (float value : {0.1f, -3.75f, 123.456f, 0.00012f})
+        {
+            const float roundTrip = VertexCompression::fromHalf(VertexCompression::toHalf(value));
+            CHECK(roundTrip == doctest::Approx(value).epsilon(1e-3));
+        }
+    }
+
+    TEST_CASE("compress")
+    {
+        // position, normal, uv and blend weights of two vertices
+        MeshData meshData;
+        meshData.attribs = {
+            {backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION},
+            {backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_NORMAL},
+            {backend::VertexFormat::FLOAT2, shaderinfos::VertexKey::VERTEX_ATTRIB_TEX_COORD},
+            {backend::VertexFormat::FLOAT4, shaderinfos::VertexKey::VERTEX_ATTRIB_BLEND_WEIGHT},
+        };
+        meshData.vertex = {
+            1, 2, 3, 0, 0, 1, 0.5f, 0.25f, 1.0f / 3, 1.0f / 3, 1.0f / 3, 0,  //
+            -4, 5, -6, 0, -1, 0, 1, 0, 0.5f, 0.5f, 0, 0,                      //
+        };
+        meshData.vertexSizeInFloat = 12;
+        meshData.subMeshIndices.emplace_back(IndexArray{uint16_t(0), uint16_t(1)});
+
+        REQUIRE(VertexCompression::compress(meshData, VertexCompressionFlags::ALL));
+        CHECK(meshData.getPerVertexSize() == 24);
+        CHECK(meshData.vertexSizeInFloat == 6);
+        CHECK(meshData.vertex.size() == 12);
+        CHECK(meshData.attribs[0].type == backend::VertexFormat::HALF4);
+        CHECK(meshData.attribs[1].type == backend::VertexFormat::SHORT4);
+        CHECK(meshData.attribs[2].type == backend::VertexFormat::HALF2);
+        CHECK(meshData.attribs[3].type == backend::VertexFormat::UBYTE4);
+        CHECK(meshData.attribs[1].isNormalized());
+        CHECK(!meshData.attribs[0].isNormalized());
+
+        // the bounds were taken before the positions were packed
+        REQUIRE(meshData.subMeshAABB.size() == 1);
+        CHECK(meshData.subMeshAABB[0]._min == Vec3(-4, 2, -6));
+        CHECK(meshData.subMeshAABB[0]._max == Vec3(1, 5, 3));
+
+        const auto* second = reinterpret_cast<const uint8_t*>(meshData.vertex.data()) + 24;
+        uint16_t position[4];
+        int16_t normal[4];
+        uint16_t uv[2];
+        memcpy(position, second, sizeof(position));
+        memcpy(normal, second + 8, sizeof(normal));
+        memcpy(uv, second + 16, sizeof(uv));
+        CHECK(VertexCompression::fromHalf(position[0]) == -4);
+        CHECK(VertexCompression::fromHalf(position[2]) == -6);
+        CHECK(VertexCompression::fromHalf(position[3]) == 1);
+        CHECK(normal[1] == -32767);
+        CHECK(normal[2] == 0);
+        CHECK(VertexCompression::fromHalf(uv[0]) == 1);
+        CHECK(second[20] + second[21] == 255);
+        CHECK(second[22] == 0);
+
+        // the weights of the first vertex still add up to one
+        const auto* first = reinterpret_cast<const uint8_t*>(meshData.vertex.data());
+        CHECK(first[20] + first[21] + first[22] + first[23] == 255);
+
+        // nothing left to pack
+        CHECK(!VertexCompression::compress(meshData, VertexCompressionFlags::ALL));
+    }
+
+    TEST_CASE("flags")
+    {
+        MeshData meshData;
+        meshData.attribs = {
+            {backend::VertexFormat::FLOAT3, shaderinfos::VertexKey::VERTEX_ATTRIB_POSITION},
+            {backend::VertexFormat::FLOAT2, shaderinfos::VertexKey::VERTEX_ATTRIB_TEX_COORD},
+        };
+        meshData.vertex            = {1, 2, 3, 0.5f, 0.5f};
+        meshData.vertexSizeInFloat = 5;
+
+        CHECK(!VertexCompression::compress(meshData, VertexCompressionFlags::NORMAL));
+        REQUIRE(VertexCompression::compress(meshData, VertexCompressionFlags::TEX_COORD));
+        CHECK(meshData.attribs[0].type == backend::VertexFormat::FLOAT3);
+        CHECK(meshData.attribs[1].type == backend::VertexFormat::HALF2);
+        CHECK(meshData.vertexSizeInFloat == 4);
+        CHECK(meshData.vertex[2] == 3);
+    }
+}
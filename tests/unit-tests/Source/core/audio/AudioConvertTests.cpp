@@ -0,0 +1,187 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <cmath>
+#include <vector>
+#include "audio/AudioConvert.h"
+#include "audio/AudioDecoder.h"
+#include "audio/AudioDecoderManager.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+TEST_SUITE("audio/AudioConvert")
+{
+    // odd counts, so the SIMD loops leave a remainder to the scalar code
+    static const size_t FRAMES = 37;
+
+    static std::vector<float> makePlane(size_t frames, float phase)
+    {
+        std::vector<float> plane(frames);
+        for (size_t i = 0; i < frames; ++i)
+            plane[i] = 1.25f * std::sin(phase + 0.37f * i);
+        // the clamping and the rounding of the halves
+        plane[0] = 2.0f;
+        plane[1] = -2.0f;
+        plane[2] = 0.5f / 32768.0f;
+        plane[3] = 1.5f / 32768.0f;
+        return plane;
+    }
+
+    static int16_t referenceS16(float v)
+    {
+        v = std::min(std::max(v * 32768.0f, -32768.0f), 32767.0f);
+        return static_cast<int16_t>(std::lrintf(v));
+    }
+
+    static void checkPlanar(uint32_t channels)
+    {
+        std::vector<std::vector<float>> planes;
+        std::vector<const float*> pointers;
+        for (uint32_t c = 0; c < channels; ++c)
+            planes.emplace_back(makePlane(FRAMES, 0.5f * c));
+        for (auto&& plane : planes)
+            pointers.emplace_back(plane.data());
+
+        std::vector<int16_t> result(FRAMES * channels);
+        AudioConvert::planarFloatToS16(pointers.data(), channels, FRAMES, result.data());
+
+        for (size_t i = 0; i < FRAMES; ++i)
+        {
+            for (uint32_t c = 0; c < channels; ++c)
+                CHECK(result[i * channels + c] == referenceS16(planes[c][i]));
+        }
+        CHECK(result[0] == 32767);
+        CHECK(result[channels] == -32768);
+        CHECK(result[channels * 2] == 0);
+        CHECK(result[channels * 3] == 2);
+    }
+
+    TEST_CASE("planar_float_to_s16")
+    {
+        SUBCASE("mono") { checkPlanar(1); }
+        SUBCASE("stereo") { checkPlanar(2); }
+        SUBCASE("multichannel") { checkPlanar(3); }
+    }
+
+    TEST_CASE("s24_to_float")
+    {
+        std::vector<int32_t> values(FRAMES);
+        for (size_t i = 0; i < FRAMES; ++i)
+            values[i] = static_cast<int32_t>(i * 226771) % 8388608 - 4194304;
+        values[0] = -8388608;
+        values[1] = 8388607;
+
+        std::vector<uint8_t> packed;
+        for (auto v : values)
+        {
+            packed.push_back(static_cast<uint8_t>(v));
+            packed.push_back(static_cast<uint8_t>(v >> 8));
+            packed.push_back(static_cast<uint8_t>(v >> 16));
+        }
+
+        std::vector<float> result(FRAMES);
+        AudioConvert::s24ToFloat(packed.data(), FRAMES, result.data());
+        for (size_t i = 0; i < FRAMES; ++i)
+            CHECK(result[i] == values[i] / 8388608.0f);
+        CHECK(result[0] == -1.0f);
+    }
+
+    TEST_CASE("s32_to_float")
+    {
+        std::vector<int32_t> values(FRAMES);
+        for (size_t i = 0; i < FRAMES; ++i)
+            values[i] = static_cast<int32_t>(i * 115370371u);
+        values[0] = INT32_MIN;
+        values[1] = INT32_MAX;
+
+        std::vector<float> result(FRAMES);
+        AudioConvert::s32ToFloat(values.data(), FRAMES, result.data());
+        for (size_t i = 0; i < FRAMES; ++i)
+            CHECK(result[i] == static_cast<float>(values[i]) / 2147483648.0f);
+        CHECK(result[0] == -1.0f);
+        CHECK(result[1] == 1.0f);
+    }
+
+#if !defined(__APPLE__)
+    TEST_CASE("wav_24bits_decoded_to_float")
+    {
+        const uint16_t channels = 2;
+        std::vector<uint8_t> samples;
+        for (size_t i = 0; i < FRAMES * channels; ++i)
+        {
+            int32_t v = static_cast<int32_t>(i * 100003) - 2000000;
+            samples.push_back(static_cast<uint8_t>(v));
+            samples.push_back(static_cast<uint8_t>(v >> 8));
+            samples.push_back(static_cast<uint8_t>(v >> 16));
+        }
+
+        std::vector<uint8_t> wav;
+        auto put = [&wav](uint32_t value, int bytes) {
+            for (int i = 0; i < bytes; ++i)
+                wav.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        };
+        wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+        put(static_cast<uint32_t>(36 + samples.size()), 4);
+        wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+        put(16, 4);
+        put(1, 2);  // PCM
+        put(channels, 2);
+        put(44100, 4);
+        put(44100 * channels * 3, 4);
+        put(channels * 3, 2);
+        put(24, 2);
+        wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+        put(static_cast<uint32_t>(samples.size()), 4);
+        wav.insert(wav.end(), samples.begin(), samples.end());
+
+        auto fu   = FileUtils::getInstance();
+        auto path = fu->getWritablePath() + "__audio_convert_24.wav";
+        Data data;
+        data.copy(wav.data(), static_cast<ssize_t>(wav.size()));
+        REQUIRE(fu->writeDataToFile(data, path));
+
+        auto decoder = AudioDecoderManager::createDecoder(path);
+        REQUIRE(decoder != nullptr);
+        REQUIRE(decoder->open(path));
+        CHECK(decoder->getSourceFormat() == AUDIO_SOURCE_FORMAT::PCM_FLT32);
+        CHECK(decoder->getTotalFrames() == FRAMES);
+
+        std::vector<float> expected(FRAMES * channels);
+        AudioConvert::s24ToFloat(samples.data(), expected.size(), expected.data());
+
+        std::vector<float> pcm(FRAMES * channels);
+        CHECK(decoder->readFixedFrames(FRAMES, reinterpret_cast<char*>(pcm.data())) == FRAMES);
+        CHECK(pcm == expected);
+
+        REQUIRE(decoder->seek(FRAMES - 5));
+        CHECK(decoder->read(5, reinterpret_cast<char*>(pcm.data())) == 5);
+        CHECK(std::equal(pcm.begin(), pcm.begin() + 10, expected.end() - 10));
+
+        AudioDecoderManager::destroyDecoder(decoder);
+        fu->removeFile(path);
+    }
+#endif
+}
@@ -0,0 +1,167 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <cstdint>
+#include "base/Allocator.h"
+#include "base/Object.h"
+
+using namespace ax;
+
+namespace
+{
+class CountingAllocator : public Allocator
+{
+public:
+    void* allocate(std::size_t size, std::size_t alignment) override
+    {
+        ++allocations;
+        lastAlignment = alignment;
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    void deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+    {
+        ++deallocations;
+        lastSize = size;
+        ::operator delete(ptr, std::align_val_t(alignment));
+    }
+
+    int allocations           = 0;
+    int deallocations         = 0;
+    std::size_t lastSize      = 0;
+    std::size_t lastAlignment = 0;
+};
+
+class TestObject : public Object
+{
+public:
+    char payload[100];
+};
+}  // namespace
+
+TEST_SUITE("base/Allocator")
+{
+    TEST_CASE("live bytes")
+    {
+        auto before = Memory::getStats(MemoryTag::GENERAL);
+
+        auto ptr = Memory::allocate(64, MemoryTag::GENERAL);
+        REQUIRE(ptr);
+        auto stats = Memory::getStats(MemoryTag::GENERAL);
+        CHECK_EQ(stats.liveBytes, before.liveBytes + 64);
+        CHECK_EQ(stats.allocations, before.allocations + 1);
+        CHECK_GE(stats.peakBytes, stats.liveBytes);
+
+        Memory::deallocate(ptr, 64, MemoryTag::GENERAL);
+        stats = Memory::getStats(MemoryTag::GENERAL);
+        CHECK_EQ(stats.liveBytes, before.liveBytes);
+        CHECK_EQ(stats.deallocations, before.deallocations + 1);
+    }
+
+    TEST_CASE("alignment")
+    {
+        auto ptr = Memory::allocate(100, MemoryTag::GENERAL, 64);
+        REQUIRE(ptr);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+        Memory::deallocate(ptr, 100, MemoryTag::GENERAL, 64);
+    }
+
+    TEST_CASE("tracked memory")
+    {
+        auto before = Memory::getStats(MemoryTag::TEXTURE).liveBytes;
+        Memory::trackAllocation(MemoryTag::TEXTURE, 4096);
+        CHECK_EQ(Memory::getStats(MemoryTag::TEXTURE).liveBytes, before + 4096);
+        Memory::trackDeallocation(MemoryTag::TEXTURE, 4096);
+        CHECK_EQ(Memory::getStats(MemoryTag::TEXTURE).liveBytes, before);
+    }
+
+    TEST_CASE("per frame counts")
+    {
+        Memory::endFrame();
+        Memory::trackAllocation(MemoryTag::MESH, 10);
+        Memory::trackAllocation(MemoryTag::MESH, 20);
+
+        // the counts of the frame in progress aren't reported yet
+        CHECK_EQ(Memory::getStats(MemoryTag::MESH).frameAllocations, 0);
+        Memory::endFrame();
+        auto stats = Memory::getStats(MemoryTag::MESH);
+        CHECK_EQ(stats.frameAllocations, 2);
+        CHECK_EQ(stats.frameBytes, 30);
+
+        Memory::endFrame();
+        CHECK_EQ(Memory::getStats(MemoryTag::MESH).frameAllocations, 0);
+        Memory::trackDeallocation(MemoryTag::MESH, 30);
+    }
+
+    TEST_CASE("budget")
+    {
+        auto live = Memory::getStats(MemoryTag::AUDIO).liveBytes;
+        Memory::setBudget(MemoryTag::AUDIO, live + 100);
+        CHECK_FALSE(Memory::isOverBudget(MemoryTag::AUDIO));
+
+        Memory::trackAllocation(MemoryTag::AUDIO, 200);
+        CHECK(Memory::isOverBudget(MemoryTag::AUDIO));
+        Memory::trackDeallocation(MemoryTag::AUDIO, 200);
+        CHECK_FALSE(Memory::isOverBudget(MemoryTag::AUDIO));
+
+        Memory::setBudget(MemoryTag::AUDIO, 0);
+        CHECK_EQ(Memory::getStats(MemoryTag::AUDIO).budget, 0);
+    }
+
+    TEST_CASE("custom allocator")
+    {
+        CountingAllocator allocator;
+        Memory::setAllocator(&allocator);
+        CHECK_EQ(Memory::getAllocator(), &allocator);
+
+        auto ptr = Memory::allocate(32, MemoryTag::FONT);
+        CHECK_EQ(allocator.allocations, 1);
+        Memory::deallocate(ptr, 32, MemoryTag::FONT);
+        CHECK_EQ(allocator.deallocations, 1);
+        CHECK_EQ(allocator.lastSize, 32);
+
+        Memory::setAllocator(nullptr);
+        CHECK_NE(Memory::getAllocator(), &allocator);
+    }
+
+    TEST_CASE("objects")
+    {
+        CountingAllocator allocator;
+        Memory::setAllocator(&allocator);
+        auto before = Memory::getStats(MemoryTag::OBJECT).liveBytes;
+
+        auto obj = new TestObject();
+        CHECK_EQ(allocator.allocations, 1);
+        CHECK_EQ(Memory::getStats(MemoryTag::OBJECT).liveBytes, before + sizeof(TestObject));
+
+        // the size of the most derived type is given back by the virtual destructor
+        obj->release();
+        CHECK_EQ(allocator.deallocations, 1);
+        CHECK_EQ(allocator.lastSize, sizeof(TestObject));
+        CHECK_EQ(Memory::getStats(MemoryTag::OBJECT).liveBytes, before);
+
+        Memory::setAllocator(nullptr);
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/AssetPreloader.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+TEST_SUITE("base/AssetPreloader") {
+    TEST_CASE("manifest_add") {
+        AssetManifest manifest;
+        manifest.addAsset(AssetType::Texture, "bg.png");
+        manifest.addAsset(AssetType::FontTTF, "fonts/arial.ttf", 0, 24);
+        manifest.addAsset(AssetType::FontTTF, "fonts/arial.ttf", 0, 32);
+
+        // the same asset is listed once, with the highest priority
+        auto& texture = manifest.addAsset(AssetType::Texture, "bg.png", 2);
+        CHECK(texture.priority == 2);
+        CHECK(manifest.getAssets().size() == 3);
+
+        AssetManifest other;
+        other.addAsset(AssetType::Texture, "bg.png").dependencies.emplace_back("ui.plist");
+        other.addAsset(AssetType::Audio, "bgm.mp3");
+        manifest.addManifest(other);
+        REQUIRE(manifest.getAssets().size() == 4);
+        CHECK(manifest.getAssets()[0].dependencies.size() == 1);
+        CHECK(manifest.getAssets()[3].type == AssetType::Audio);
+    }
+
+    TEST_CASE("manifest_file") {
+        auto fileUtils = FileUtils::getInstance();
+        auto common    = fileUtils->getWritablePath() + "__common.manifest";
+        auto scene     = fileUtils->getWritablePath() + "__scene.manifest";
+
+        AssetManifest manifest;
+        manifest.addAsset(AssetType::Texture, "ui.png");
+        REQUIRE(manifest.writeToFile(common));
+
+        auto& sheet   = manifest.addAsset(AssetType::SpriteSheet, "ui.plist", 1);
+        sheet.texture = "ui.png";
+        manifest.addAsset(AssetType::Model, "orc.c3b").dependencies.emplace_back("ui.plist");
+        manifest.addAsset(AssetType::FontTTF, "fonts/arial.ttf", 0, 24);
+        REQUIRE(manifest.writeToFile(scene));
+
+        AssetManifest loaded;
+        REQUIRE(loaded.initWithFile(scene));
+        auto& assets = loaded.getAssets();
+        REQUIRE(assets.size() == 4);
+        CHECK(assets[1].type == AssetType::SpriteSheet);
+        CHECK(assets[1].texture == "ui.png");
+        CHECK(assets[1].priority == 1);
+        CHECK(assets[2].dependencies == std::vector<std::string>{"ui.plist"});
+        CHECK(assets[3].fontSize == 24);
+
+        // the included assets come first, the ones listed twice are merged
+        auto json = fmt::format(R"({{"include": ["{}"], "assets": [{{"type": "audio", "path": "bgm.mp3"}},
+            {{"type": "texture", "path": "ui.png", "priority": 3}}, {{"type": "unknown", "path": "x"}}]}})", common);
+        REQUIRE(fileUtils->writeStringToFile(json, scene));
+        REQUIRE(loaded.initWithFile(scene));
+        REQUIRE(assets.size() == 2);
+        CHECK(assets[0].path == "ui.png");
+        CHECK(assets[0].priority == 3);
+        CHECK(assets[1].type == AssetType::Audio);
+
+        CHECK_FALSE(loaded.initWithFile(fileUtils->getWritablePath() + "__missing.manifest"));
+
+        fileUtils->removeFile(common);
+        fileUtils->removeFile(scene);
+    }
+}
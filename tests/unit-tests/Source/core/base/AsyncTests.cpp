@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <string>
+#include <vector>
+#include "base/Async.h"
+
+using namespace ax;
+
+namespace
+{
+// Resumed by hand, stands in for the engine awaiters
+struct ManualEvent
+{
+    std::vector<axstd::coroutine_handle<>> waiting;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(axstd::coroutine_handle<> handle) { waiting.push_back(handle); }
+    void await_resume() const noexcept {}
+
+    void set()
+    {
+        auto handles = std::move(waiting);
+        for (auto handle : handles)
+            handle.resume();
+    }
+};
+
+Task<int> valueAfter(ManualEvent& event, int value)
+{
+    co_await event;
+    co_return value;
+}
+
+Task<int> immediate(int value)
+{
+    co_return value;
+}
+
+Task<void> appendAfter(ManualEvent& event, std::vector<std::string>& log, std::string text)
+{
+    co_await event;
+    log.push_back(std::move(text));
+}
+}  // namespace
+
+TEST_SUITE("base/Async")
+{
+    TEST_CASE("values")
+    {
+        auto done = immediate(3);
+        CHECK(done.isDone());
+
+        ManualEvent event;
+        auto pending = valueAfter(event, 5);
+        CHECK_FALSE(pending.isDone());
+        event.set();
+        CHECK(pending.isDone());
+    }
+
+    TEST_CASE("chaining")
+    {
+        ManualEvent first;
+        ManualEvent second;
+        std::vector<int> results;
+
+        auto sum = [&]() -> Task<int> {
+            // both started before the first await
+            auto a = valueAfter(first, 1);
+            auto b = valueAfter(second, 2);
+            int ready = co_await immediate(10);
+            results.push_back(ready);
+            co_return ready + co_await a + co_await b;
+        };
+        auto outer = [&]() -> Task<void> { results.push_back(co_await sum()); };
+
+        auto task = outer();
+        CHECK(results == std::vector<int>{10});
+        CHECK_FALSE(task.isDone());
+
+        second.set();
+        CHECK_FALSE(task.isDone());
+        first.set();
+        CHECK(task.isDone());
+        CHECK(results == std::vector<int>{10, 13});
+    }
+
+    TEST_CASE("void tasks keep the order")
+    {
+        ManualEvent event;
+        std::vector<std::string> log;
+
+        auto sequence = [&]() -> Task<void> {
+            co_await appendAfter(event, log, "a");
+            co_await appendAfter(event, log, "b");
+            log.push_back("c");
+        };
+
+        auto task = sequence();
+        CHECK(log.empty());
+        event.set();
+        CHECK(log == std::vector<std::string>{"a"});
+        event.set();
+        CHECK(log == std::vector<std::string>{"a", "b", "c"});
+        CHECK(task.isDone());
+    }
+
+    TEST_CASE("dropped tasks run to their end")
+    {
+        ManualEvent event;
+        std::vector<std::string> log;
+
+        appendAfter(event, log, "detached");
+        CHECK(log.empty());
+        event.set();
+        CHECK(log == std::vector<std::string>{"detached"});
+
+        Task<void> moved = appendAfter(event, log, "moved");
+        moved            = appendAfter(event, log, "assigned");
+        event.set();
+        CHECK(log == std::vector<std::string>{"detached", "moved", "assigned"});
+        CHECK(moved.isDone());
+    }
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <vector>
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+
+using namespace ax;
+
+TEST_SUITE("base/EventDispatcher")
+{
+    TEST_CASE("event ids")
+    {
+        static_assert(hashEventName("unit_test_event") != hashEventName("unit_test_event2"));
+
+        CHECK_FALSE(EventId::find("unit_test_never_interned").isValid());
+
+        auto id = EventId::intern("unit_test_event");
+        CHECK(id.isValid());
+        CHECK(id.getName() == "unit_test_event");
+        CHECK(EventId::find("unit_test_event") == id);
+
+        constexpr auto hash = hashEventName("unit_test_event");
+        CHECK(EventId::intern("unit_test_event", hash) == id);
+        CHECK(EventId::intern(std::string("unit_test_") + "event") == id);
+        CHECK(EventId::fromIndex(id.getIndex()).getName() == "unit_test_event");
+
+        auto other = EventId::intern("unit_test_event2");
+        CHECK(other != id);
+        CHECK(EventId::getInternedCount() > other.getIndex());
+    }
+
+    TEST_CASE("dispatch by id")
+    {
+        EventDispatcher dispatcher;
+        dispatcher.setEnabled(true);
+
+        std::vector<int> calls;
+        auto addListener = [&](std::string_view name, int tag) {
+            return dispatcher.addCustomEventListener(name, [&calls, tag](EventCustom* event) {
+                calls.push_back(tag * 10 + *static_cast<int*>(event->getUserData()));
+            });
+        };
+
+        // listeners added before the name is interned and before the dispatcher looks the id up
+        addListener("unit_test_dispatch", 1);
+        auto id = EventId::intern("unit_test_dispatch");
+        auto late = EventId::intern("unit_test_dispatch_late");
+
+        int data = 1;
+        dispatcher.dispatchCustomEvent(id, &data);
+        dispatcher.dispatchCustomEvent(late, &data);
+        CHECK(calls == std::vector<int>{11});
+
+        // a list created after the lookup
+        auto lateListener = addListener("unit_test_dispatch_late", 2);
+        data              = 2;
+        dispatcher.dispatchCustomEvent(late, &data);
+        dispatcher.dispatchCustomEvent("unit_test_dispatch_late", &data);
+        CHECK(calls == std::vector<int>{11, 22, 22});
+
+        // a list deleted with its last listener
+        dispatcher.removeEventListener(lateListener);
+        dispatcher.dispatchCustomEvent(late, &data);
+        CHECK(calls == std::vector<int>{11, 22, 22});
+
+        EventCustom event(id);
+        data = 3;
+        event.setUserData(&data);
+        dispatcher.dispatchEvent(&event);
+        CHECK(calls == std::vector<int>{11, 22, 22, 13});
+
+        dispatcher.removeCustomEventListeners("unit_test_dispatch");
+        dispatcher.dispatchEvent(&event);
+        CHECK(calls.size() == 4);
+    }
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <utility>
+#include <vector>
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerKeyboard.h"
+#include "base/FrameRecorder.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+
+TEST_SUITE("base/FrameRecorder")
+{
+    TEST_CASE("record and replay")
+    {
+        using KeyCode = EventKeyboard::KeyCode;
+
+        auto director         = Director::getInstance();
+        auto dispatcher       = director->getEventDispatcher();
+        auto recorder         = director->getFrameRecorder();
+        const bool wasEnabled = dispatcher->isEnabled();
+        dispatcher->setEnabled(true);
+
+        std::vector<std::pair<unsigned int, KeyCode>> keys;  // the frame and the key pressed
+        auto listener          = EventListenerKeyboard::create();
+        listener->onKeyPressed = [&](KeyCode keyCode, Event*) {
+            keys.emplace_back(recorder->getFrameIndex(), keyCode);
+        };
+        dispatcher->addEventListenerWithFixedPriority(listener, 1);
+
+        auto pressKey = [dispatcher](KeyCode keyCode) {
+            EventKeyboard event(keyCode, true);
+            dispatcher->dispatchEvent(&event);
+        };
+        auto runFrame = [recorder](std::function<void()> input) {
+            const float deltaTime = recorder->beginFrame(1.0f);
+            if (input)
+                input();
+            recorder->dispatchInput();
+            recorder->endFrame();
+            return deltaTime;
+        };
+
+        const auto path = FileUtils::getInstance()->getWritablePath() + "unit_test_recording.axrec";
+        REQUIRE(recorder->startRecording(path, 0.02f));
+
+        // input received between frames belongs to the next one
+        pressKey(KeyCode::KEY_A);
+        CHECK_EQ(runFrame(nullptr), doctest::Approx(0.02f));
+        runFrame(nullptr);
+        runFrame([&] { pressKey(KeyCode::KEY_B); });
+        recorder->stop();
+        CHECK_EQ(keys.size(), 2);
+        keys.clear();
+
+        bool finished = false;
+        REQUIRE(recorder->startReplay(path, "", [&finished] { finished = true; }));
+        CHECK_EQ(recorder->getState(), FrameRecorder::State::REPLAYING);
+        CHECK_EQ(recorder->getFrameCount(), 3);
+
+        // the live input is ignored
+        pressKey(KeyCode::KEY_C);
+        for (int i = 0; i < 3; ++i)
+            CHECK_EQ(runFrame(nullptr), doctest::Approx(0.02f));
+
+        CHECK(finished);
+        CHECK_EQ(recorder->getState(), FrameRecorder::State::IDLE);
+        CHECK(keys == std::vector<std::pair<unsigned int, KeyCode>>{{0, KeyCode::KEY_A}, {2, KeyCode::KEY_B}});
+
+        // the filter is removed with the replay
+        pressKey(KeyCode::KEY_C);
+        CHECK_EQ(keys.size(), 3);
+
+        dispatcher->removeEventListener(listener);
+        dispatcher->setEnabled(wasEnabled);
+        FileUtils::getInstance()->removeFile(path);
+    }
+}
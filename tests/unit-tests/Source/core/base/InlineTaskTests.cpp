@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <array>
+#include <memory>
+#include "base/InlineTask.h"
+
+using namespace ax;
+
+TEST_SUITE("base/InlineTask")
+{
+    TEST_CASE("empty")
+    {
+        InlineTask task;
+        CHECK_FALSE(task);
+        CHECK_FALSE(task.isInline());
+
+        std::function<void()> function;
+        CHECK_FALSE(InlineTask(function));
+        CHECK_FALSE(InlineTask(nullptr));
+    }
+
+    TEST_CASE("small callables are stored in place")
+    {
+        int calls = 0;
+        InlineTask task([&calls] { ++calls; });
+        REQUIRE(task);
+        CHECK(task.isInline());
+        task();
+        task();
+        CHECK_EQ(calls, 2);
+
+        // move only captures are accepted
+        auto value = std::make_unique<int>(3);
+        InlineTask moveOnly([&calls, value = std::move(value)] { calls += *value; });
+        CHECK(moveOnly.isInline());
+        moveOnly();
+        CHECK_EQ(calls, 5);
+    }
+
+    TEST_CASE("large callables are allocated")
+    {
+        std::array<char, InlineTask::INLINE_SIZE + 1> payload{};
+        payload.back() = 7;
+        int result     = 0;
+        InlineTask task([payload, &result] { result = payload.back(); });
+        CHECK_FALSE(task.isInline());
+        task();
+        CHECK_EQ(result, 7);
+    }
+
+    TEST_CASE("move and destroy")
+    {
+        auto counter = std::make_shared<int>(0);
+        {
+            InlineTask a([counter] { ++*counter; });
+            CHECK_EQ(counter.use_count(), 2);
+
+            InlineTask b(std::move(a));
+            CHECK_FALSE(a);
+            CHECK_EQ(counter.use_count(), 2);
+            b();
+
+            std::array<char, InlineTask::INLINE_SIZE> payload{};
+            InlineTask c([counter, payload] { *counter += 1 + payload[0]; });
+            CHECK_FALSE(c.isInline());
+            CHECK_EQ(counter.use_count(), 3);
+
+            // assigning destroys the previous callable
+            b = std::move(c);
+            CHECK_EQ(counter.use_count(), 2);
+            b();
+            CHECK_EQ(*counter, 2);
+
+            b.reset();
+            CHECK_FALSE(b);
+            CHECK_EQ(counter.use_count(), 1);
+        }
+        CHECK_EQ(counter.use_count(), 1);
+    }
+}
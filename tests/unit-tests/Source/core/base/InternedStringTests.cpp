@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <thread>
+#include <vector>
+#include "base/InternedString.h"
+
+using namespace ax;
+
+TEST_SUITE("base/InternedString")
+{
+    TEST_CASE("intern")
+    {
+        std::string first = "interned_string_test";
+        std::string second(first);
+
+        auto a = InternedString::intern(first);
+        auto b = InternedString(second);
+        CHECK(a == b);
+        CHECK(a.view().data() == b.view().data());
+        CHECK(a.view() == "interned_string_test");
+        CHECK(a.hash() != 0);
+
+        CHECK(InternedString::find("interned_string_test") == a);
+        CHECK(InternedString::find("interned_string_test_other").empty());
+        CHECK(InternedString::intern("interned_string_test_other") != a);
+
+        InternedString empty;
+        CHECK(empty.empty());
+        CHECK(empty.view().empty());
+        CHECK(empty.hash() == 0);
+        CHECK(std::string_view{empty.c_str()}.empty());
+        CHECK(InternedString::intern("") == empty);
+    }
+
+    TEST_CASE("threads")
+    {
+        const auto count = InternedString::getInternedCount();
+
+        std::vector<InternedString> results(4);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < results.size(); ++i)
+            threads.emplace_back([&results, i] { results[i] = InternedString::intern("interned_by_threads"); });
+        for (auto& thread : threads)
+            thread.join();
+
+        for (auto& result : results)
+            CHECK(result == results[0]);
+        CHECK(InternedString::getInternedCount() == count + 1);
+    }
+}
@@ -0,0 +1,134 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "base/JobSystem.h"
+
+using namespace ax;
+
+TEST_SUITE("base/JobSystem")
+{
+    TEST_CASE("continuations")
+    {
+        JobSystem jobSystem(4);
+
+        std::mutex mutex;
+        std::vector<int> order;
+        auto push = [&](int value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+
+        auto first = jobSystem.schedule([&] { push(1); });
+        auto last  = first.then([&] { push(2); }).then([&] { push(3); }, JobPriority::High);
+        jobSystem.wait(last);
+
+        CHECK(first.isDone());
+        CHECK(last.isDone());
+        CHECK_EQ(order, std::vector<int>{1, 2, 3});
+
+        // continuing a job done already
+        auto again = first.then([&] { push(4); });
+        jobSystem.wait(again);
+        CHECK_EQ(order.back(), 4);
+    }
+
+    TEST_CASE("when all")
+    {
+        JobSystem jobSystem(4);
+
+        std::atomic<int> count{0};
+        std::vector<JobHandle> handles;
+        for (int i = 0; i < 100; ++i)
+            handles.emplace_back(jobSystem.schedule([&count] { ++count; }, JobPriority::Low));
+
+        int seen = 0;
+        auto all = jobSystem.whenAll(handles).then([&] { seen = count.load(); });
+        jobSystem.wait(all);
+        CHECK_EQ(seen, 100);
+
+        CHECK(jobSystem.whenAll({}).isDone());
+    }
+
+    TEST_CASE("jobs scheduled by a job")
+    {
+        JobSystem jobSystem(4);
+
+        std::atomic<int> count{0};
+        auto outer = jobSystem.schedule([&] {
+            std::vector<JobHandle> children;
+            for (int i = 0; i < 64; ++i)
+                children.emplace_back(jobSystem.schedule([&count] { ++count; }, JobPriority::High));
+            jobSystem.wait(jobSystem.whenAll(children));
+        });
+        jobSystem.wait(outer);
+        CHECK_EQ(count.load(), 64);
+    }
+
+    TEST_CASE("parallel for")
+    {
+        JobSystem jobSystem(4);
+
+        for (size_t grainSize : {1, 7, 64, 1000, 5000})
+        {
+            std::vector<std::atomic<int>> visits(1000);
+            auto handle = jobSystem.parallelFor(visits.size(), grainSize, [&visits](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    ++visits[i];
+            });
+            jobSystem.wait(handle);
+
+            bool once = true;
+            for (auto&& visit : visits)
+                once = once && visit.load() == 1;
+            CHECK_MESSAGE(once, "grain size ", grainSize);
+        }
+
+        bool called = false;
+        jobSystem.wait(jobSystem.parallelFor(0, 16, [&called](size_t, size_t) { called = true; }));
+        CHECK_FALSE(called);
+    }
+
+    TEST_CASE("without workers")
+    {
+        JobSystem jobSystem(std::span<std::shared_ptr<JobThreadData>>{});
+        CHECK_EQ(jobSystem.getWorkerCount(), 0);
+
+        int value   = 0;
+        auto handle = jobSystem.schedule([&value] { value = 1; }).then([&value] { value *= 2; });
+        CHECK(handle.isDone());
+        CHECK_EQ(value, 2);
+
+        size_t sum = 0;
+        auto sumHandle = jobSystem.parallelFor(100, 10, [&sum](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                sum += i;
+        });
+        CHECK(sumHandle.isDone());
+        CHECK_EQ(sum, 4950);
+    }
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/AutoreleasePool.h"
+#include "base/ObjectArena.h"
+
+using namespace ax;
+
+namespace
+{
+struct Counted : public Object
+{
+    explicit Counted(int& destroyed) : destroyed(destroyed) {}
+    ~Counted() override { ++destroyed; }
+
+    int& destroyed;
+};
+
+struct Plain : public Object
+{};
+
+struct Large : public Object
+{
+    char payload[ObjectArena::BLOCK_SIZE];
+};
+}  // namespace
+
+TEST_SUITE("base/ObjectArena")
+{
+    TEST_CASE("drain")
+    {
+        auto arena    = ObjectArena::getInstance();
+        int destroyed = 0;
+
+        SUBCASE("objects are released by the drain")
+        {
+            for (int i = 0; i < 100; ++i)
+                arena->create<Counted>(destroyed);
+            CHECK(arena->getLiveObjects() == 100);
+
+            arena->drain();
+            CHECK(destroyed == 100);
+            CHECK(arena->getLiveObjects() == 0);
+        }
+
+        SUBCASE("retained objects are destroyed by their last release")
+        {
+            auto kept = arena->create<Counted>(destroyed);
+            arena->create<Counted>(destroyed);
+            kept->retain();
+
+            arena->drain();
+            CHECK(destroyed == 1);
+            CHECK(kept->getReferenceCount() == 1);
+
+            kept->release();
+            CHECK(destroyed == 2);
+            CHECK(arena->getLiveObjects() == 0);
+        }
+
+        SUBCASE("large objects get a dedicated block")
+        {
+            auto capacity = arena->getCapacity();
+            auto large    = arena->create<Large>();
+            CHECK(arena->getCapacity() > capacity + ObjectArena::BLOCK_SIZE);
+            large->payload[ObjectArena::BLOCK_SIZE - 1] = 1;
+
+            arena->drain();
+            CHECK(arena->getCapacity() == capacity);
+        }
+    }
+
+    TEST_CASE("blocks are reused")
+    {
+        auto arena    = ObjectArena::getInstance();
+        int destroyed = 0;
+
+        for (int i = 0; i < 5000; ++i)
+            arena->create<Counted>(destroyed);
+        arena->drain();
+
+        arena->clearHeapAllocations();
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            for (int i = 0; i < 5000; ++i)
+                arena->create<Counted>(destroyed);
+            arena->drain();
+        }
+        CHECK(destroyed == 55000);
+        CHECK(arena->getHeapAllocations() == 0);
+    }
+
+    TEST_CASE("retained objects outlive the arena")
+    {
+        int destroyed = 0;
+        auto kept     = ObjectArena::getInstance()->create<Counted>(destroyed);
+        kept->retain();
+        ObjectArena::destroyInstance();
+        CHECK(destroyed == 0);
+
+        ObjectArena::getInstance()->create<Counted>(destroyed);
+        kept->release();
+        CHECK(destroyed == 1);
+        CHECK(ObjectArena::getInstance()->getLiveObjects() == 1);
+        ObjectArena::getInstance()->drain();
+        CHECK(destroyed == 2);
+    }
+
+    TEST_CASE("creation stats")
+    {
+        auto arena    = ObjectArena::getInstance();
+        int destroyed = 0;
+        arena->setCreationStatsEnabled(true);
+
+        for (int i = 0; i < 3; ++i)
+            arena->create<Counted>(destroyed);
+        auto object = new Plain();
+        object->autorelease();
+        object->retain();
+        arena->drain();
+
+        auto& stats = arena->getLastFrameCreations();
+        REQUIRE(stats.size() == 2);
+        CHECK(stats[0].typeName == typeid(Counted).name());
+        CHECK(stats[0].arena == 3);
+        CHECK(stats[1].typeName == typeid(Plain).name());
+        CHECK(stats[1].autoreleased == 1);
+
+        arena->drain();
+        CHECK(arena->getLastFrameCreations().empty());
+
+        arena->setCreationStatsEnabled(false);
+        PoolManager::getInstance()->getCurrentPool()->clear();
+        object->release();
+    }
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <thread>
+#include "base/AutoreleasePool.h"
+
+using namespace ax;
+
+namespace
+{
+struct Counted : public Object
+{
+    explicit Counted(int& destroyed) : destroyed(destroyed) {}
+    ~Counted() override { ++destroyed; }
+
+    int& destroyed;
+};
+}  // namespace
+
+TEST_SUITE("base/Object")
+{
+    TEST_CASE("releaseDeferred")
+    {
+        int destroyed = 0;
+        auto object   = new Counted(destroyed);
+
+        // the workers only queue their releases, the object is destroyed when the queue is released
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 4; ++i)
+        {
+            object->retain();
+            workers.emplace_back([object] { object->releaseDeferred(); });
+        }
+        for (auto&& worker : workers)
+            worker.join();
+        object->release();
+
+        CHECK(destroyed == 0);
+        CHECK(object->getReferenceCount() == 4);
+        PoolManager::getInstance()->releaseDeferredObjects();
+        CHECK(destroyed == 1);
+    }
+
+#if AX_ENABLE_ATOMIC_REFCOUNT
+    TEST_CASE("atomic")
+    {
+        int destroyed = 0;
+        auto object   = new Counted(destroyed);
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 4; ++i)
+        {
+            workers.emplace_back([object] {
+                for (int k = 0; k < 10000; ++k)
+                {
+                    object->retain();
+                    object->release();
+                }
+            });
+        }
+        for (auto&& worker : workers)
+            worker.join();
+
+        CHECK(object->getReferenceCount() == 1);
+        object->release();
+        CHECK(destroyed == 1);
+    }
+#endif
+}
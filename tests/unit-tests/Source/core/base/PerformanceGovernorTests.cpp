@@ -0,0 +1,82 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "base/PerformanceGovernor.h"
+
+using namespace ax;
+
+TEST_SUITE("base/PerformanceGovernor")
+{
+    using Level        = PerformanceGovernor::Level;
+    using ThermalState = Device::ThermalState;
+
+    TEST_CASE("evaluate")
+    {
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, -1.0f, -1.0f, false), Level::NORMAL);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::FAIR, -1.0f, -1.0f, false), Level::REDUCED);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::SERIOUS, -1.0f, -1.0f, false), Level::LOW);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::CRITICAL, -1.0f, -1.0f, false), Level::MINIMUM);
+
+        // the forecast headroom steps down before the thermal state changes
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, 0.5f, -1.0f, false), Level::NORMAL);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, 0.8f, -1.0f, false), Level::REDUCED);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, 0.95f, -1.0f, false), Level::LOW);
+
+        // the battery
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, -1.0f, 0.5f, false), Level::NORMAL);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, -1.0f, 0.1f, false), Level::REDUCED);
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::NOMINAL, -1.0f, -1.0f, true), Level::REDUCED);
+
+        // the worst reading wins
+        CHECK_EQ(PerformanceGovernor::evaluate(ThermalState::SERIOUS, 0.8f, 0.1f, true), Level::LOW);
+    }
+
+    TEST_CASE("step")
+    {
+        auto governor = PerformanceGovernor::getInstance();
+        REQUIRE_EQ(governor->getLevel(), Level::NORMAL);
+
+        // a worse level is applied right away
+        CHECK(governor->step(Level::LOW, 1.0f));
+        CHECK_EQ(governor->getLevel(), Level::LOW);
+
+        // a better one has to last, then the level recovers one step at a time
+        const int polls = static_cast<int>(PerformanceGovernor::RECOVERY_TIME);
+        for (int i = 1; i < polls; ++i)
+            CHECK_FALSE(governor->step(Level::NORMAL, 1.0f));
+        CHECK(governor->step(Level::NORMAL, 1.0f));
+        CHECK_EQ(governor->getLevel(), Level::REDUCED);
+
+        // a relapse restarts the wait
+        for (int i = 1; i < polls; ++i)
+            governor->step(Level::NORMAL, 1.0f);
+        CHECK_FALSE(governor->step(Level::REDUCED, 1.0f));
+        CHECK_FALSE(governor->step(Level::NORMAL, 1.0f));
+        CHECK_EQ(governor->getLevel(), Level::REDUCED);
+
+        PerformanceGovernor::destroyInstance();
+    }
+}
@@ -0,0 +1,281 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/Scheduler.h"
+
+using namespace ax;
+
+namespace
+{
+struct SchedulerFixture
+{
+    SchedulerFixture() : scheduler(new Scheduler()) {}
+    ~SchedulerFixture()
+    {
+        scheduler->unscheduleAll();
+        scheduler->release();
+    }
+
+    void step(float dt, int frames = 1)
+    {
+        for (int i = 0; i < frames; ++i)
+            scheduler->update(dt);
+    }
+
+    Scheduler* scheduler;
+    int target = 0;
+    int otherTarget = 0;
+};
+}  // namespace
+
+TEST_SUITE("base/Scheduler")
+{
+    TEST_CASE_FIXTURE(SchedulerFixture, "interval")
+    {
+        // the first update after scheduling starts the timer, like before the timer wheel
+        int calls = 0;
+        scheduler->schedule([&calls](float dt) {
+            CHECK_EQ(dt, 0.5f);
+            ++calls;
+        }, &target, 0.5f, false, "timer");
+
+        step(0.25f, 2);
+        CHECK_EQ(calls, 0);
+        step(0.25f);
+        CHECK_EQ(calls, 1);
+        step(0.25f, 2);
+        CHECK_EQ(calls, 2);
+
+        // a long frame triggers the missed intervals
+        step(1.0f);
+        CHECK_EQ(calls, 4);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "repeat and delay")
+    {
+        std::vector<float> dts;
+        scheduler->schedule([&dts](float dt) { dts.emplace_back(dt); }, &target, 0.5f, 2, 1.0f, false, "timer");
+
+        step(0.25f, 20);
+        CHECK_EQ(dts, std::vector<float>{1.0f, 0.5f, 0.5f});
+        CHECK_FALSE(scheduler->isScheduled("timer", &target));
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "every frame")
+    {
+        int calls = 0;
+        scheduler->schedule([&calls](float) { ++calls; }, &target, 0.0f, false, "timer");
+
+        step(0.25f);
+        CHECK_EQ(calls, 0);
+        step(0.25f, 3);
+        CHECK_EQ(calls, 3);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "pause keeps the remaining time")
+    {
+        int calls = 0;
+        scheduler->schedule([&calls](float) { ++calls; }, &target, 1.0f, false, "timer");
+
+        step(0.25f, 3);  // started, 0.5s counted
+        scheduler->pauseTarget(&target);
+        step(0.25f, 10);
+        CHECK_EQ(calls, 0);
+
+        scheduler->resumeTarget(&target);
+        CHECK_FALSE(scheduler->isTargetPaused(&target));
+        step(0.25f);
+        CHECK_EQ(calls, 0);
+        step(0.25f);
+        CHECK_EQ(calls, 1);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "unschedule from a callback")
+    {
+        int calls = 0;
+        scheduler->schedule([this](float) { scheduler->unschedule("other", &otherTarget); }, &target, 0.5f, false,
+                            "first");
+        scheduler->schedule([&calls](float) { ++calls; }, &otherTarget, 0.75f, false, "other");
+
+        step(0.25f, 10);
+        CHECK_EQ(calls, 0);
+        CHECK_FALSE(scheduler->isScheduled("other", &otherTarget));
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "reschedule from its callback")
+    {
+        // the timer of the key is restarted with the new interval, the callback is kept
+        int calls = 0;
+        scheduler->schedule([this, &calls](float) {
+            ++calls;
+            scheduler->schedule([](float) {}, &target, 1.0f, false, "timer");
+        }, &target, 0.5f, false, "timer");
+
+        step(0.25f, 3);
+        CHECK_EQ(calls, 1);
+        step(0.25f, 4);
+        CHECK_EQ(calls, 1);
+        step(0.25f);
+        CHECK_EQ(calls, 2);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "long intervals")
+    {
+        // beyond the span of every level of the wheel
+        int hours = 0;
+        int calls = 0;
+        scheduler->schedule([&hours](float) { ++hours; }, &target, 3600.0f, false, "hour");
+        scheduler->schedule([&calls](float) { ++calls; }, &otherTarget, 100000.0f, false, "long");
+
+        step(1000.0f, 100);
+        CHECK_EQ(calls, 0);
+        CHECK_EQ(hours, 27);
+        step(1000.0f);
+        CHECK_EQ(calls, 1);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "many timers")
+    {
+        std::vector<int> targets(1000);
+        int calls = 0;
+        for (size_t i = 0; i < targets.size(); ++i)
+            scheduler->schedule([&calls](float) { ++calls; }, &targets[i], 1.0f + (i % 4), false, "timer");
+
+        // started by the first update, then 10s: 10 + 5 + 3 + 2 calls per group of 4
+        step(0.125f, 1 + 80);
+        CHECK_EQ(calls, 250 * (10 + 5 + 3 + 2));
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "parallel phase")
+    {
+        // on the axmol thread, the order of the phase is what is checked here
+        scheduler->setParallelThreshold(0);
+
+        std::vector<int> order;
+        scheduler->scheduleParallel([&order](float) { order.push_back(1); }, &target, false);
+        scheduler->schedule([&order](float) { order.push_back(3); }, &target, 0.0f, false, "frame");
+        scheduler->scheduleParallel(
+            [this, &order](float) { scheduler->runAfterParallelUpdates([&order] { order.push_back(2); }); },
+            &otherTarget, false);
+
+        CHECK(scheduler->isScheduledParallel(&target));
+        step(0.1f);  // starts the timer
+        order.clear();
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{1, 2, 3});
+
+        order.clear();
+        scheduler->pauseTarget(&target);
+        CHECK(scheduler->isTargetPaused(&target));
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{2});
+
+        order.clear();
+        scheduler->resumeTarget(&target);
+        scheduler->unscheduleAllForTarget(&otherTarget);
+        CHECK_FALSE(scheduler->isScheduledParallel(&otherTarget));
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{1, 3});
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "deferred functions keep the schedule order")
+    {
+        scheduler->setParallelThreshold(0);
+
+        std::vector<int> targets(64);
+        std::vector<size_t> order;
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            scheduler->scheduleParallel(
+                [this, &order, i](float) {
+                    scheduler->runAfterParallelUpdates([&order, i] { order.push_back(i); });
+                    scheduler->runAfterParallelUpdates([&order, i] { order.push_back(i); });
+                },
+                &targets[i], false);
+        }
+
+        // unscheduled by a deferred function, the targets after it still get their deferred functions this frame
+        scheduler->scheduleParallel(
+            [this, &targets](float) {
+                scheduler->runAfterParallelUpdates([this, &targets] { scheduler->unscheduleParallel(&targets[0]); });
+            },
+            &target, false);
+
+        step(0.1f);
+        REQUIRE_EQ(order.size(), targets.size() * 2);
+        for (size_t i = 0; i < order.size(); ++i)
+            CHECK_EQ(order[i], i / 2);
+
+        order.clear();
+        step(0.1f);
+        CHECK_EQ(order.size(), (targets.size() - 1) * 2);
+        CHECK_EQ(order.front(), 1u);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "functions run on the axmol thread")
+    {
+        std::vector<int> order;
+        for (int i = 0; i < 4; ++i)
+        {
+            scheduler->runOnAxmolThread([this, &order, i] {
+                order.push_back(i);
+                // queued while they run, called on the next frame
+                scheduler->runOnAxmolThread([&order, i] { order.push_back(10 + i); });
+            });
+        }
+        CHECK_EQ(scheduler->getPendingActionCount(), 4u);
+
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{0, 1, 2, 3});
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{0, 1, 2, 3, 10, 11, 12, 13});
+        CHECK_EQ(scheduler->getPendingActionCount(), 0u);
+    }
+
+    TEST_CASE_FIXTURE(SchedulerFixture, "pending actions budget")
+    {
+        // a budget shorter than any function calls one per frame, the others keep their order
+        scheduler->setPendingActionsBudget(1e-9f);
+
+        std::vector<int> order;
+        for (int i = 0; i < 3; ++i)
+            scheduler->runOnAxmolThread([&order, i] { order.push_back(i); });
+
+        step(0.1f);
+        CHECK_EQ(order, std::vector<int>{0});
+        scheduler->runOnAxmolThread([&order] { order.push_back(3); });
+        step(0.1f, 3);
+        CHECK_EQ(order, std::vector<int>{0, 1, 2, 3});
+
+        // the carried functions are removed too
+        for (int i = 0; i < 3; ++i)
+            scheduler->runOnAxmolThread([&order, i] { order.push_back(i); });
+        step(0.1f);
+        scheduler->removeAllPendingActions();
+        step(0.1f, 2);
+        CHECK_EQ(order.size(), 5u);
+        CHECK_EQ(scheduler->getPendingActionCount(), 0u);
+    }
+}
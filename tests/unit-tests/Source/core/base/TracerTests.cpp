@@ -0,0 +1,104 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <thread>
+#include "base/Profiling.h"
+
+using namespace ax;
+
+static size_t countOf(const std::string& str, std::string_view pattern)
+{
+    size_t count = 0;
+    for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + pattern.size()))
+        ++count;
+    return count;
+}
+
+TEST_SUITE("base/Tracer") {
+    TEST_CASE("record") {
+        auto tracer = Tracer::getInstance();
+        tracer->start();
+        {
+            AX_TRACE_SCOPE("outer");
+            AX_TRACE_SCOPE("inner");
+        }
+        tracer->stop();
+        {
+            AX_TRACE_SCOPE("ignored");
+        }
+
+        auto json = tracer->toChromeTrace();
+        CHECK_EQ(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+        CHECK_EQ(1, countOf(json, "\"name\":\"outer\""));
+        CHECK_EQ(1, countOf(json, "\"name\":\"inner\""));
+        CHECK_EQ(0, countOf(json, "\"name\":\"ignored\""));
+
+        tracer->clear();
+        CHECK_EQ(0, countOf(tracer->toChromeTrace(), "\"ph\":\"X\""));
+    }
+
+    TEST_CASE("ring_buffer") {
+        auto tracer = Tracer::getInstance();
+        tracer->start();
+        for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD + 10; ++i)
+        {
+            AX_TRACE_SCOPE("event");
+        }
+        tracer->stop();
+
+        // only the newest events are kept
+        CHECK_EQ(Tracer::EVENTS_PER_THREAD, countOf(tracer->toChromeTrace(), "\"name\":\"event\""));
+        tracer->clear();
+    }
+
+    TEST_CASE("counter") {
+        auto tracer = Tracer::getInstance();
+        tracer->start();
+        tracer->addCounter("GPU", 2.5);
+        tracer->stop();
+
+        auto json = tracer->toChromeTrace();
+        CHECK_EQ(1, countOf(json, "{\"ph\":\"C\",\"name\":\"GPU\""));
+        CHECK_EQ(1, countOf(json, "\"args\":{\"ms\":2.500}"));
+        CHECK_EQ(0, countOf(json, "\"ph\":\"X\""));
+        tracer->clear();
+    }
+
+    TEST_CASE("threads") {
+        auto tracer = Tracer::getInstance();
+        tracer->start();
+        std::thread worker([tracer] {
+            tracer->setThreadName("worker \"1\"");
+            AX_TRACE_SCOPE("work");
+        });
+        worker.join();
+        tracer->stop();
+
+        auto json = tracer->toChromeTrace();
+        CHECK_EQ(1, countOf(json, "\"name\":\"work\""));
+        CHECK_EQ(1, countOf(json, "\"args\":{\"name\":\"worker \\\"1\\\"\"}"));
+        tracer->clear();
+    }
+}
@@ -102,4 +102,70 @@ TEST_SUITE("base/UTF8") {
         CHECK(!StringUtils::isCJKUnicode(0xFFFF));
         CHECK(StringUtils::isCJKUnicode(0x3100));
     }
+
+    TEST_CASE("conversions") {
+        // longer than a vector, with the non ascii characters in the middle of and after the ascii runs
+        const std::string utf8 = "The quick brown fox jumps over \xe5\xa4\xa7\xe8\xb1\xa1 and \xf0\x9f\x98\x80"
+                                 " \xc3\xa9t\xc3\xa9 the lazy dog, 0123456789abcdef";
+        const std::u16string utf16 = u"The quick brown fox jumps over \u5927\u8c61 and \U0001F600 \u00e9t\u00e9"
+                                     u" the lazy dog, 0123456789abcdef";
+        const std::u32string utf32 = U"The quick brown fox jumps over \u5927\u8c61 and \U0001F600 \u00e9t\u00e9"
+                                     U" the lazy dog, 0123456789abcdef";
+
+        std::u16string outUtf16;
+        CHECK(StringUtils::UTF8ToUTF16(utf8, outUtf16));
+        CHECK(outUtf16 == utf16);
+
+        std::u32string outUtf32;
+        CHECK(StringUtils::UTF8ToUTF32(utf8, outUtf32));
+        CHECK(outUtf32 == utf32);
+
+        std::string outUtf8;
+        CHECK(StringUtils::UTF16ToUTF8(utf16, outUtf8));
+        CHECK(outUtf8 == utf8);
+        outUtf8.clear();
+        CHECK(StringUtils::UTF32ToUTF8(utf32, outUtf8));
+        CHECK(outUtf8 == utf8);
+
+        CHECK(StringUtils::getCharacterCountInUTF8String(utf8) == (int)utf32.length());
+        CHECK(StringUtils::isLegalUTF8String(utf8.data(), utf8.length()));
+
+        CHECK(StringUtils::UTF8ToUTF16("", outUtf16));
+        CHECK(outUtf16.empty());
+    }
+
+    TEST_CASE("ill_formed") {
+        const char* const illFormed[] = {
+            "overlong \xc0\x80",
+            "overlong \xe0\x80\xaf",
+            "surrogate \xed\xa0\x80",
+            "above U+10FFFF \xf4\x90\x80\x80",
+            "truncated at the end \xe5\xa4",
+            "truncated \xf0\x9f\x98 in the middle",
+            "stray continuation \x80",
+        };
+        for (auto* str : illFormed)
+        {
+            std::u16string outUtf16 = u"unchanged";
+            CHECK_FALSE(StringUtils::UTF8ToUTF16(str, outUtf16));
+            CHECK(outUtf16 == u"unchanged");
+
+            std::u32string outUtf32;
+            CHECK_FALSE(StringUtils::UTF8ToUTF32(str, outUtf32));
+            CHECK_FALSE(StringUtils::isLegalUTF8String(str, strlen(str)));
+            CHECK(StringUtils::getCharacterCountInUTF8String(str) == 0);
+        }
+
+        std::string outUtf8;
+        const char16_t unpairedHigh[] = {u'a', 0xD83D, u'b', 0};
+        const char16_t unpairedLow[]  = {0xDE00, u'a', 0};
+        CHECK_FALSE(StringUtils::UTF16ToUTF8(unpairedHigh, outUtf8));
+        CHECK_FALSE(StringUtils::UTF16ToUTF8(unpairedLow, outUtf8));
+
+        const char32_t surrogate[] = {U'a', 0xD800, 0};
+        const char32_t tooLarge[]  = {0x110000, 0};
+        CHECK_FALSE(StringUtils::UTF32ToUTF8(surrogate, outUtf8));
+        CHECK_FALSE(StringUtils::UTF32ToUTF8(tooLarge, outUtf8));
+        CHECK(outUtf8.empty());
+    }
 }
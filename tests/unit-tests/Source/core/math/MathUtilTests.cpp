@@ -43,14 +43,14 @@ using namespace ax;
 namespace UnitTest
 {
 
+#include "math/MathUtil.inl"
+
 #ifdef AX_NEON_INTRINSICS
 #    include "math/MathUtilNeon.inl"
 #elif defined(AX_SSE_INTRINSICS)
 #    include "math/MathUtilSSE.inl"
 #endif
 
-#include "math/MathUtil.inl"
-
 }  // namespace UnitTest
 
 static void __checkMathUtilResult(std::string_view description, const float* a1, const float* a2, int size)
@@ -119,6 +119,109 @@ TEST_SUITE("math/MathUtil")
 #endif
     }
 
+    TEST_CASE("transformVertices in place")
+    {
+        std::vector<V3F_C4B_T2F> vertices(6);
+        for (int i = 0; i < 6; ++i)
+        {
+            vertices[i].vertices.set(float(i), float(i + 1), float(i + 2));
+            vertices[i].colors.set(uint8_t(i + 3), uint8_t(i + 4), uint8_t(i + 5), uint8_t(i + 6));
+            vertices[i].texCoords.set(float(i + 7), float(i + 8));
+        }
+
+        Mat4 transform(0, 4, 0, 0, -5, 0, 0, 0, 0, 0, 6, 0, 1, 2, 3, 1);
+        std::vector<V3F_C4B_T2F> expected(vertices.size());
+        MathUtilC::transformVertices(expected.data(), vertices.data(), vertices.size(), transform);
+
+#ifdef AX_NEON_INTRINSICS
+        MathUtilNeon::transformVertices(vertices.data(), vertices.data(), vertices.size(), transform);
+#elif defined(AX_SSE_INTRINSICS)
+        MathUtilSSE::transformVertices(vertices.data(), vertices.data(), vertices.size(), transform);
+#else
+        MathUtilC::transformVertices(vertices.data(), vertices.data(), vertices.size(), transform);
+#endif
+        checkVerticesAreEqual(expected.data(), vertices.data(), vertices.size());
+    }
+
+    TEST_CASE("array kernels")
+    {
+        // not a multiple of 4, the remainders go through the C kernels
+        const size_t count = 11;
+        Mat4 transform(0.5f, 4, 1, 0, -5, 2, 0.25f, 0, 3, 0.75f, 6, 0, 1, 2, 3, 1);
+        std::vector<float> a(count * 3), b(count * 3), expected(count * 3), dst(count * 3);
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = float(i) * 0.37f - 2.0f;
+            b[i] = float(i % 5) * 1.5f + 0.25f;
+        }
+
+#ifdef AX_NEON_INTRINSICS
+#    define SIMD_KERNEL(call) MathUtilNeon::call
+#elif defined(AX_SSE_INTRINSICS)
+#    define SIMD_KERNEL(call) MathUtilSSE::call
+#else
+#    define SIMD_KERNEL(call) MathUtilC::call
+#endif
+
+        MathUtilC::transformVec2(transform.m, a.data(), expected.data(), count);
+        SIMD_KERNEL(transformVec2(transform.m, a.data(), dst.data(), count));
+        __checkMathUtilResult("transformVec2", expected.data(), dst.data(), count * 2);
+        dst = a;
+        SIMD_KERNEL(transformVec2(transform.m, dst.data(), dst.data(), count));
+        __checkMathUtilResult("transformVec2 in place", expected.data(), dst.data(), count * 2);
+
+        MathUtilC::transformVec3(transform.m, a.data(), expected.data(), count);
+        dst = a;
+        SIMD_KERNEL(transformVec3(transform.m, dst.data(), dst.data(), count));
+        __checkMathUtilResult("transformVec3", expected.data(), dst.data(), count * 3);
+        CHECK(expected[0] == doctest::Approx(a[0] * 0.5f + a[1] * 4 + a[2]));
+
+        MathUtilC::transformVec2(transform.m, a.data(), b.data(), expected.data(), expected.data() + count, count);
+        SIMD_KERNEL(transformVec2(transform.m, a.data(), b.data(), dst.data(), dst.data() + count, count));
+        __checkMathUtilResult("transformVec2 SoA", expected.data(), dst.data(), count * 2);
+
+        expected = a;
+        dst      = a;
+        MathUtilC::addScaled(expected.data(), b.data(), 0.3f, count);
+        SIMD_KERNEL(addScaled(dst.data(), b.data(), 0.3f, count));
+        __checkMathUtilResult("addScaled", expected.data(), dst.data(), count);
+
+        MathUtilC::lerp(a.data(), b.data(), 0.3f, expected.data(), count);
+        SIMD_KERNEL(lerp(a.data(), b.data(), 0.3f, dst.data(), count));
+        __checkMathUtilResult("lerp", expected.data(), dst.data(), count);
+        CHECK(dst[3] == doctest::Approx(a[3] + (b[3] - a[3]) * 0.3f));
+
+        expected = a;
+        dst      = a;
+        MathUtilC::clamp(expected.data(), count, -1.0f, 1.0f);
+        SIMD_KERNEL(clamp(dst.data(), count, -1.0f, 1.0f));
+        __checkMathUtilResult("clamp", expected.data(), dst.data(), count);
+        CHECK_EQ(-1.0f, dst[0]);
+        CHECK_EQ(1.0f, dst[count - 1]);
+
+        // a 5x4 grid, the points on the last column or row and the NaN ones are out of it
+        const int width = 5, height = 4;
+        std::vector<float> grid(width * height);
+        for (size_t i = 0; i < grid.size(); ++i)
+            grid[i] = float(i) * 0.5f + float(i % 3);
+        const float points[count * 2] = {0, 0,    1.5f, 2.25f, 3.99f, 2.99f, 4, 1,     -0.1f, 1,    2, NAN,
+                                         2, 3,    0.25f, 0.75f, 3.5f, 0.5f, 1, 1,     2.75f, 1.25f};
+        MathUtilC::sampleBilinear(grid.data(), width, height, points, expected.data(), count, -7.0f);
+        SIMD_KERNEL(sampleBilinear(grid.data(), width, height, points, dst.data(), count, -7.0f));
+        __checkMathUtilResult("sampleBilinear", expected.data(), dst.data(), count);
+        CHECK_EQ(grid[0], dst[0]);
+        float top    = grid[11] + (grid[12] - grid[11]) * 0.5f;
+        float bottom = grid[16] + (grid[17] - grid[16]) * 0.5f;
+        CHECK(dst[1] == doctest::Approx(top + (bottom - top) * 0.25f));
+        CHECK_EQ(-7.0f, dst[3]);
+        CHECK_EQ(-7.0f, dst[4]);
+        CHECK_EQ(-7.0f, dst[5]);
+        CHECK_EQ(-7.0f, dst[6]);
+        CHECK_EQ(grid[6], dst[9]);
+
+#undef SIMD_KERNEL
+    }
+
     TEST_CASE("transformIndices")
     {
         auto count = 43;
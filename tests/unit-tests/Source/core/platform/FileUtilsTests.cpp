@@ -107,6 +107,32 @@ TEST_SUITE("platform/FileUtils") {
     }
 
 
+    TEST_CASE("path_manifest") {
+        fu->purgeCachedEntries();
+        auto root     = fu->getDefaultResourceRootPath();
+        auto manifest = fu->getWritablePath() + "__manifest.txt";
+
+        REQUIRE(fu->writeStringToFile("text/123.txt\r\nother.txt\n", manifest));
+        REQUIRE(fu->loadPathManifest(manifest));
+        CHECK(fu->isPathManifestLoaded());
+        CHECK(fu->fullPathForFilename("text/123.txt") == root + "text/123.txt");
+        CHECK(fu->fullPathForFilename("other.txt") == root + "other.txt");
+
+        REQUIRE(fu->writeStringToFile("other.txt\n", manifest));
+        REQUIRE(fu->loadPathManifest(manifest));
+        CHECK(fu->fullPathForFilename("text/123.txt") == "");
+
+        fu->unloadPathManifest();
+        CHECK(not fu->isPathManifestLoaded());
+        CHECK(fu->fullPathForFilename("text/123.txt") == root + "text/123.txt");
+        CHECK(fu->fullPathForFilename("other.txt") == "");
+
+        REQUIRE(fu->writePathManifest("text", manifest));
+        CHECK(fu->getStringFromFile(manifest).find("123.txt\n") != std::string::npos);
+        fu->removeFile(manifest);
+    }
+
+
     TEST_CASE("isFileExist" * doctest::timeout(10)) {
         CHECK(fu->isFileExist("text/123.txt"));
         CHECK(fu->isFileExist(fu->fullPathForFilename("text/123.txt")));
@@ -269,6 +295,19 @@ TEST_SUITE("platform/FileUtils") {
             CHECK(dbuf.getSize() == binary.size());
             CHECK(std::equal(dbuf.getBytes(), dbuf.getBytes() + dbuf.getSize(), binary.begin()));
         }
+
+
+        SUBCASE("getMappedContents") {
+            auto contents = fu->getMappedContents(file);
+            REQUIRE(not contents.isNull());
+            CHECK(contents.view() == text);
+
+            auto copy = contents;
+            contents  = {};
+            CHECK(copy.view() == text);
+
+            CHECK(fu->getMappedContents("text/doesnt_exist.bin").isNull());
+        }
     }
 
 
@@ -372,6 +411,49 @@ TEST_SUITE("platform/FileUtils") {
     }
 
 
+    TEST_CASE("binary_plist") {
+        // plistlib.dumps({"frames": {"a.png": {"x": 1, "big": 5000000000, "neg": -3}}, "scale": 0.5,
+        //                 "name": "h\u00e9llo", "list": [True, False, "s"], "u": 3}, fmt=plistlib.FMT_BINARY)
+        const std::string_view bplist{
+            "\x62\x70\x6c\x69\x73\x74\x30\x30\xd5\x01\x02\x03\x04\x05\x06\x0f\x13\x14\x15\x56\x66\x72\x61\x6d"
+            "\x65\x73\x54\x6c\x69\x73\x74\x54\x6e\x61\x6d\x65\x55\x73\x63\x61\x6c\x65\x51\x75\xd1\x07\x08\x55"
+            "\x61\x2e\x70\x6e\x67\xd3\x09\x0a\x0b\x0c\x0d\x0e\x53\x62\x69\x67\x53\x6e\x65\x67\x51\x78\x13\x00"
+            "\x00\x00\x01\x2a\x05\xf2\x00\x13\xff\xff\xff\xff\xff\xff\xff\xfd\x10\x01\xa3\x10\x11\x12\x09\x08"
+            "\x51\x73\x65\x00\x68\x00\xe9\x00\x6c\x00\x6c\x00\x6f\x23\x3f\xe0\x00\x00\x00\x00\x00\x00\x10\x03"
+            "\x08\x13\x1a\x1f\x24\x2a\x2c\x2f\x35\x3c\x40\x44\x46\x4f\x58\x5a\x5e\x5f\x60\x62\x6d\x76\x00\x00"
+            "\x00\x00\x00\x00\x01\x01\x00\x00\x00\x00\x00\x00\x00\x16\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+            "\x00\x00\x00\x00\x00\x78",
+            174};
+
+        auto file = fu->getWritablePath() + "__test.plist";
+        REQUIRE(fu->writeStringToFile(bplist, file));
+
+        ValueMap readValueMap = fu->getValueMapFromFile(file);
+        REQUIRE(readValueMap.size() == 5);
+        CHECK(readValueMap["scale"].asDouble() == 0.5);
+        CHECK(readValueMap["name"].asString() == "h\xc3\xa9llo");
+        CHECK(readValueMap["u"].getType() == Value::Type::INTEGER);
+        CHECK(readValueMap["u"].asInt() == 3);
+
+        auto& frame = readValueMap["frames"].asValueMap()["a.png"].asValueMap();
+        CHECK(frame["x"].asInt() == 1);
+        CHECK(frame["neg"].asInt() == -3);
+        CHECK(frame["big"].asInt64() == 5000000000);
+
+        auto& list = readValueMap["list"].asValueVector();
+        REQUIRE(list.size() == 3);
+        CHECK(list[0].asBool() == true);
+        CHECK(list[1].asBool() == false);
+        CHECK(list[2].asString() == "s");
+
+        CHECK(fu->getValueMapFromData(bplist.data(), static_cast<int>(bplist.size())).size() == 5);
+        CHECK(fu->getValueMapFromData(bplist.data(), static_cast<int>(bplist.size()) - 1).empty());
+        CHECK(fu->getValueVectorFromFile(file).empty());
+
+        CHECK(fu->removeFile(file));
+    }
+
+
     TEST_CASE("ValueVector") {
         auto file = fu->getWritablePath() + "__test.txt";
 
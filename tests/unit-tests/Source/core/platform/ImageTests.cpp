@@ -0,0 +1,216 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "platform/Image.h"
+#include "base/ktxspec_v2.h"
+#include "base/ZipUtils.h"
+#include "renderer/backend/PixelFormatUtils.h"
+
+using namespace ax;
+
+TEST_SUITE("platform/Image")
+{
+    // a KTX2 file of a single 2D image, the levels are given level 0 first
+    static std::vector<uint8_t> makeKTX2(uint32_t vkFormat,
+                                         uint32_t width,
+                                         uint32_t height,
+                                         const std::vector<std::vector<uint8_t>>& levels,
+                                         uint32_t scheme    = KTXv2Header::SupercompressionScheme::NONE,
+                                         uint8_t colorModel = 1)
+    {
+        KTXv2Header header{};
+        memcpy(header.identifier, "\xABKTX 20\xBB\r\n\x1A\n", sizeof(header.identifier));
+        header.vkFormat               = vkFormat;
+        header.typeSize               = 1;
+        header.pixelWidth             = width;
+        header.pixelHeight            = height;
+        header.faceCount              = 1;
+        header.levelCount             = static_cast<uint32_t>(levels.size());
+        header.supercompressionScheme = scheme;
+        header.dfdByteOffset = static_cast<uint32_t>(KTX_V2_HEADER_SIZE + levels.size() * sizeof(KTXv2LevelIndex));
+        header.dfdByteLength = sizeof(KTXv2BasicDFD);
+
+        KTXv2BasicDFD dfd{};
+        dfd.totalSize  = sizeof(KTXv2BasicDFD);
+        dfd.colorModel = colorModel;
+
+        std::vector<KTXv2LevelIndex> index(levels.size());
+        std::vector<uint8_t> levelData;
+        size_t offset = header.dfdByteOffset + header.dfdByteLength;
+        // the smallest level is stored first
+        for (size_t i = levels.size(); i-- > 0;)
+        {
+            auto stored = levels[i];
+            if (scheme == KTXv2Header::SupercompressionScheme::ZLIB)
+            {
+                auto compressed = ZipUtils::compressGZ(levels[i].data(), levels[i].size());
+                stored.assign(compressed.begin(), compressed.end());
+            }
+            index[i] = KTXv2LevelIndex{offset + levelData.size(), stored.size(), levels[i].size()};
+            levelData.insert(levelData.end(), stored.begin(), stored.end());
+        }
+
+        std::vector<uint8_t> file(offset);
+        memcpy(file.data(), &header, sizeof(header));
+        memcpy(file.data() + KTX_V2_HEADER_SIZE, index.data(), index.size() * sizeof(KTXv2LevelIndex));
+        memcpy(file.data() + header.dfdByteOffset, &dfd, sizeof(dfd));
+        file.insert(file.end(), levelData.begin(), levelData.end());
+        return file;
+    }
+
+    TEST_CASE("ktx2_rgba8")
+    {
+        std::vector<uint8_t> pixels = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+        auto file = makeKTX2(KTXv2Header::VkFormat::R8G8B8A8_UNORM, 2, 2, {pixels});
+
+        auto image = new Image();
+        REQUIRE(image->initWithImageData(file.data(), static_cast<ssize_t>(file.size())));
+        CHECK(image->getWidth() == 2);
+        CHECK(image->getHeight() == 2);
+        CHECK(image->getPixelFormat() == backend::PixelFormat::RGBA8);
+        REQUIRE(image->getDataLen() == static_cast<ssize_t>(pixels.size()));
+        CHECK(memcmp(image->getData(), pixels.data(), pixels.size()) == 0);
+        image->release();
+    }
+
+    TEST_CASE("ktx2_zlib")
+    {
+        std::vector<uint8_t> pixels(16 * 16 * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<uint8_t>(i * 7);
+        auto file = makeKTX2(KTXv2Header::VkFormat::R8G8B8A8_UNORM, 16, 16, {pixels},
+                             KTXv2Header::SupercompressionScheme::ZLIB);
+
+        auto image = new Image();
+        REQUIRE(image->initWithImageData(file.data(), static_cast<ssize_t>(file.size())));
+        REQUIRE(image->getDataLen() == static_cast<ssize_t>(pixels.size()));
+        CHECK(memcmp(image->getData(), pixels.data(), pixels.size()) == 0);
+        image->release();
+    }
+
+    TEST_CASE("ktx2_mipmaps_decoded")
+    {
+        // without a renderer no device format is reported as supported, BGRA8 is swizzled to RGBA8
+        std::vector<uint8_t> level0 = {3, 2, 1, 4, 7, 6, 5, 8, 11, 10, 9, 12, 15, 14, 13, 16};
+        std::vector<uint8_t> level1 = {30, 20, 10, 40};
+        auto file = makeKTX2(KTXv2Header::VkFormat::B8G8R8A8_UNORM, 2, 2, {level0, level1});
+
+        auto image = new Image();
+        REQUIRE(image->initWithImageData(file.data(), static_cast<ssize_t>(file.size())));
+        CHECK(image->getPixelFormat() == backend::PixelFormat::RGBA8);
+        REQUIRE(image->getNumberOfMipmaps() == 2);
+
+        auto mipmaps = image->getMipmaps();
+        REQUIRE(mipmaps[0].len == 16);
+        REQUIRE(mipmaps[1].len == 4);
+        for (uint8_t i = 0; i < 16; ++i)
+            CHECK(mipmaps[0].address[i] == i + 1);
+        CHECK(mipmaps[1].address[0] == 10);
+        CHECK(mipmaps[1].address[2] == 30);
+        image->release();
+    }
+
+    TEST_CASE("ktx2_rejected")
+    {
+        std::vector<uint8_t> pixels(16);
+
+        auto basis = makeKTX2(KTXv2Header::VkFormat::UNDEFINED, 2, 2, {pixels},
+                              KTXv2Header::SupercompressionScheme::NONE, KTXv2BasicDFD::ColorModel::UASTC);
+        auto image = new Image();
+        CHECK_FALSE(image->initWithImageData(basis.data(), static_cast<ssize_t>(basis.size())));
+        image->release();
+
+        auto truncated = makeKTX2(KTXv2Header::VkFormat::R8G8B8A8_UNORM, 2, 2, {pixels});
+        truncated.resize(truncated.size() - 1);
+        image = new Image();
+        CHECK_FALSE(image->initWithImageData(truncated.data(), static_cast<ssize_t>(truncated.size())));
+        image->release();
+    }
+
+    // enough pixels for the vector loops, and an odd remainder for the scalar ones
+    static std::vector<uint8_t> makePixels(size_t count)
+    {
+        std::vector<uint8_t> pixels(count * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<uint8_t>(i * 37 + (i >> 3) * 11);
+        return pixels;
+    }
+
+    TEST_CASE("premultiply_alpha")
+    {
+        auto pixels = makePixels(75);
+        auto result = pixels;
+        backend::PixelFormatUtils::premultiplyAlpha(result.data(), result.size());
+
+        for (size_t i = 0; i < pixels.size(); i += 4)
+        {
+            const uint8_t* p      = pixels.data() + i;
+            unsigned int expected = AX_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
+            CHECK(memcmp(&expected, result.data() + i, 4) == 0);
+        }
+    }
+
+    TEST_CASE("convert_rgba8")
+    {
+        using backend::PixelFormat;
+        auto pixels = makePixels(75);
+
+        auto convert = [&](PixelFormat format) {
+            unsigned char* outData = nullptr;
+            size_t outDataLen      = 0;
+            CHECK(backend::PixelFormatUtils::convertDataToFormat(pixels.data(), pixels.size(), PixelFormat::RGBA8,
+                                                                 format, &outData, &outDataLen) == format);
+            std::vector<uint8_t> result(outData, outData + outDataLen);
+            free(outData);
+            return result;
+        };
+
+        auto rgb565 = convert(PixelFormat::RGB565);
+        auto rgba4  = convert(PixelFormat::RGBA4);
+        auto rgb5a1 = convert(PixelFormat::RGB5A1);
+        auto r8     = convert(PixelFormat::R8);
+        auto rg8    = convert(PixelFormat::RG8);
+        auto rgb8   = convert(PixelFormat::RGB8);
+        REQUIRE(rgb565.size() == pixels.size() / 2);
+        REQUIRE(r8.size() == pixels.size() / 4);
+        REQUIRE(rgb8.size() == pixels.size() / 4 * 3);
+
+        for (size_t i = 0; i < pixels.size() / 4; ++i)
+        {
+            const uint8_t* p = pixels.data() + i * 4;
+            uint16_t value;
+            memcpy(&value, rgb565.data() + i * 2, 2);
+            CHECK(value == ((p[0] & 0xF8) << 8 | (p[1] & 0xFC) << 3 | (p[2] & 0xF8) >> 3));
+            memcpy(&value, rgba4.data() + i * 2, 2);
+            CHECK(value == ((p[0] & 0xF0) << 8 | (p[1] & 0xF0) << 4 | (p[2] & 0xF0) | (p[3] & 0xF0) >> 4));
+            memcpy(&value, rgb5a1.data() + i * 2, 2);
+            CHECK(value == ((p[0] & 0xF8) << 8 | (p[1] & 0xF8) << 3 | (p[2] & 0xF8) >> 2 | (p[3] & 0x80) >> 7));
+            CHECK(r8[i] == p[0]);
+            CHECK(rg8[i * 2] == p[0]);
+            CHECK(rg8[i * 2 + 1] == p[1]);
+            CHECK(memcmp(rgb8.data() + i * 3, p, 3) == 0);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "platform/FileUtils.h"
+#include "platform/PackArchive.h"
+
+using namespace ax;
+
+TEST_SUITE("platform/PackArchive") {
+#define fu FileUtils::getInstance()
+
+    TEST_CASE("pack_and_mount") {
+        const auto root    = fu->getWritablePath() + "pack_archive_test/";
+        const auto srcDir  = root + "src/";
+        const auto archive = root + "test.axpak";
+        const std::string repeated(4096, 'a');
+
+        fu->removeDirectory(root);
+        REQUIRE(fu->createDirectories(srcDir + "dir/"));
+        REQUIRE(fu->writeStringToFile("hello", srcDir + "hello.txt"));
+        REQUIRE(fu->writeStringToFile(repeated, srcDir + "dir/repeated.txt"));
+        REQUIRE(fu->writeStringToFile("", srcDir + "dir/empty.txt"));
+
+        REQUIRE(PackArchive::pack(srcDir, archive));
+
+        SUBCASE("lookups") {
+            PackArchive pack;
+            REQUIRE(pack.open(archive));
+            CHECK(pack.getEntryCount() == 3);
+            CHECK(pack.find("missing.txt") == nullptr);
+
+            auto hello = pack.find("hello.txt");
+            REQUIRE(hello != nullptr);
+            CHECK(hello->compression == PackArchive::Compression::NONE);
+            CHECK(hello->offset % PackArchive::ALIGNMENT == 0);
+
+            auto compressed = pack.find("dir/repeated.txt");
+            REQUIRE(compressed != nullptr);
+            CHECK(compressed->compression == PackArchive::Compression::DEFLATE);
+
+            std::string content;
+            ResizableBufferAdapter<std::string> buffer(&content);
+            REQUIRE(pack.read(*compressed, &buffer));
+            CHECK(content == repeated);
+
+            auto empty = pack.find("dir/empty.txt");
+            REQUIRE(empty != nullptr);
+            REQUIRE(pack.read(*empty, &buffer));
+            CHECK(content.empty());
+        }
+
+        SUBCASE("mount") {
+            auto searchPaths = fu->getOriginalSearchPaths();
+            fu->purgeCachedEntries();
+            CHECK(fu->fullPathForFilename("dir/repeated.txt").empty());
+
+            REQUIRE(fu->mountArchive(archive));
+            auto fullPath = fu->fullPathForFilename("dir/repeated.txt");
+            CHECK(fullPath == archive + "/dir/repeated.txt");
+            CHECK(fu->isFileExist(fullPath));
+            CHECK(fu->getStringFromFile("hello.txt") == "hello");
+            CHECK(fu->getStringFromFile("dir/repeated.txt") == repeated);
+
+            auto stored = fu->getMappedContents("hello.txt");
+            CHECK(stored.isMapped());
+            CHECK(stored.view() == "hello");
+            auto inflated = fu->getMappedContents("dir/repeated.txt");
+            CHECK(not inflated.isMapped());
+            CHECK(inflated.view() == repeated);
+
+            auto stream = fu->openFileStream(fullPath, IFileStream::Mode::READ);
+            REQUIRE(stream != nullptr);
+            CHECK(stream->size() == static_cast<int64_t>(repeated.size()));
+            char bytes[8] = {};
+            CHECK(stream->seek(-4, SEEK_END) == static_cast<int64_t>(repeated.size() - 4));
+            CHECK(stream->read(bytes, sizeof(bytes)) == 4);
+
+            CHECK(fu->unmountArchive(archive));
+            CHECK(fu->fullPathForFilename("dir/repeated.txt").empty());
+            CHECK(stream->read(bytes, sizeof(bytes)) == 0);
+            fu->setSearchPaths(searchPaths);
+        }
+
+        fu->removeDirectory(root);
+    }
+}
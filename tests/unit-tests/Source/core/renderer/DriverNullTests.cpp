@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "renderer/backend/null/DriverNull.h"
+#include "renderer/backend/Buffer.h"
+#include "renderer/backend/CommandBuffer.h"
+#include "renderer/backend/Program.h"
+
+using namespace ax;
+using namespace ax::backend;
+
+TEST_SUITE("renderer/DriverNull")
+{
+    TEST_CASE("counters")
+    {
+        DriverNull driver;
+
+        auto buffer = driver.newBuffer(64, BufferType::VERTEX, BufferUsage::DYNAMIC);
+        buffer->updateData(nullptr, 64);
+        buffer->updateSubData(nullptr, 16, 32);
+
+        TextureDescriptor descriptor;
+        descriptor.width  = 4;
+        descriptor.height = 2;
+        auto texture      = static_cast<Texture2DBackend*>(driver.newTexture(descriptor));
+        REQUIRE(texture);
+        uint8_t pixels[4 * 2 * 4]{};
+        texture->updateData(pixels, 4, 2, 0);
+
+        auto& counters = driver.getCounters();
+        CHECK_EQ(counters.bufferUploads, 96);
+        CHECK_EQ(counters.textureUploads, sizeof(pixels));
+        CHECK_EQ(counters.liveBuffers, 1);
+        CHECK_EQ(counters.liveTextures, 1);
+
+        auto commandBuffer = driver.newCommandBuffer();
+        commandBuffer->beginFrame();
+        commandBuffer->beginRenderPass(nullptr, RenderPassDescriptor{});
+        commandBuffer->drawArrays(PrimitiveType::TRIANGLE, 0, 6);
+        commandBuffer->drawElementsInstanced(PrimitiveType::TRIANGLE, IndexFormat::U_SHORT, 6, 0, 10);
+        commandBuffer->endRenderPass();
+        commandBuffer->endFrame();
+
+        CHECK_EQ(counters.frames, 1);
+        CHECK_EQ(counters.renderPasses, 1);
+        CHECK_EQ(counters.drawCalls, 2);
+        CHECK_EQ(counters.instances, 11);
+        CHECK_EQ(counters.vertices, 66);
+
+        driver.resetCounters();
+        CHECK_EQ(counters.drawCalls, 0);
+        CHECK_EQ(counters.bufferUploads, 0);
+        CHECK_EQ(counters.liveBuffers, 1);
+
+        buffer->release();
+        texture->release();
+        commandBuffer->release();
+        CHECK_EQ(counters.liveBuffers, 0);
+        CHECK_EQ(counters.liveTextures, 0);
+    }
+
+    TEST_CASE("attribute locations")
+    {
+        DriverNull driver;
+        auto program = driver.newProgram("", "");
+        CHECK_EQ(program->getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD), Attribute::TEXCOORD);
+        CHECK_EQ(program->getAttributeLocation(Attribute::TEXCOORD), Attribute::TEXCOORD);
+
+        const auto custom = program->getAttributeLocation("a_custom");
+        CHECK_GE(custom, static_cast<int>(Attribute::ATTRIBUTE_MAX));
+        CHECK_EQ(program->getAttributeLocation("a_custom"), custom);
+        CHECK_NE(program->getAttributeLocation("a_other"), custom);
+        CHECK_FALSE(program->getUniformLocation("u_custom"));
+        program->release();
+    }
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "renderer/DynamicResolution.h"
+
+using namespace ax;
+
+TEST_SUITE("renderer/DynamicResolution")
+{
+    // feed the same frame time until the cooldown of a change has passed
+    static void feed(DynamicResolution& resolution, float frameTime, int frames)
+    {
+        for (int i = 0; i < frames; ++i)
+            resolution.update(frameTime);
+    }
+
+    TEST_CASE("scale range")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setScale(2.0f);
+        CHECK_EQ(resolution.getScale(), 1.0f);
+        resolution.setScale(0.1f);
+        CHECK_EQ(resolution.getScale(), 0.5f);
+
+        // the current scale follows a narrower range
+        resolution.setScaleRange(0.6f, 0.8f);
+        CHECK_EQ(resolution.getScale(), 0.6f);
+    }
+
+    TEST_CASE("drops when over budget")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setTargetFrameTime(16.0f);
+
+        // a single step is limited
+        resolution.update(32.0f);
+        CHECK_EQ(resolution.getScale(), doctest::Approx(1.0f - DynamicResolution::MAX_SCALE_DOWN));
+
+        // then waits for the time to settle
+        CHECK_FALSE(resolution.update(32.0f));
+
+        feed(resolution, 32.0f, 200);
+        CHECK_EQ(resolution.getScale(), 0.5f);
+    }
+
+    TEST_CASE("recovers with headroom")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setTargetFrameTime(16.0f);
+        resolution.setHeadroom(0.8f);
+        resolution.setScale(0.5f);
+
+        feed(resolution, 4.0f, 300);
+        CHECK_EQ(resolution.getScale(), 1.0f);
+    }
+
+    TEST_CASE("holds between headroom and target")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setTargetFrameTime(16.0f);
+        resolution.setHeadroom(0.8f);
+        resolution.setScale(0.7f);
+
+        feed(resolution, 14.0f, 300);
+        CHECK_EQ(resolution.getScale(), 0.7f);
+    }
+
+    TEST_CASE("ignores a single slow frame")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setTargetFrameTime(16.0f);
+
+        feed(resolution, 12.0f, 30);
+        CHECK_FALSE(resolution.update(40.0f));
+        CHECK_EQ(resolution.getScale(), 1.0f);
+    }
+
+    TEST_CASE("manual scale")
+    {
+        DynamicResolution resolution;
+        resolution.setScaleRange(0.5f, 1.0f);
+        resolution.setAdaptive(false);
+        resolution.setScale(0.75f);
+
+        feed(resolution, 40.0f, 100);
+        CHECK_EQ(resolution.getScale(), 0.75f);
+    }
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "renderer/backend/PipelineCache.h"
+
+using namespace ax;
+using namespace ax::backend;
+
+TEST_SUITE("renderer/PipelineCache")
+{
+    static PipelineStateDesc makeSpriteState()
+    {
+        PipelineStateDesc desc;
+        desc.programId = 1;
+        desc.vertexLayout.setAttrib("a_position", 0, VertexFormat::FLOAT3, 0, false);
+        desc.vertexLayout.setAttrib("a_texCoord", 1, VertexFormat::FLOAT2, 12, false);
+        desc.vertexLayout.setAttrib("a_color", 2, VertexFormat::UBYTE4, 20, true);
+        desc.vertexLayout.setStride(24);
+        desc.colorAttachments[0] = PixelFormat::RGBA8;
+        desc.depthAttachment     = PixelFormat::D24S8;
+        desc.stencilAttachment   = PixelFormat::D24S8;
+
+        auto& blend                       = desc.blendDescriptor;
+        blend.blendEnabled                = true;
+        blend.sourceRGBBlendFactor        = BlendFactor::ONE;
+        blend.destinationRGBBlendFactor   = BlendFactor::ONE_MINUS_SRC_ALPHA;
+        blend.sourceAlphaBlendFactor      = BlendFactor::ONE;
+        blend.destinationAlphaBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA;
+        return desc;
+    }
+
+    TEST_CASE("key")
+    {
+        const auto desc = makeSpriteState();
+        const auto key  = PipelineCache::computeKey(desc);
+        CHECK_EQ(PipelineCache::computeKey(makeSpriteState()), key);
+
+        auto other      = desc;
+        other.programId = 2;
+        CHECK_NE(PipelineCache::computeKey(other), key);
+
+        other                              = desc;
+        other.blendDescriptor.blendEnabled = false;
+        CHECK_NE(PipelineCache::computeKey(other), key);
+
+        other                     = desc;
+        other.colorAttachments[0] = PixelFormat::RGB565;
+        CHECK_NE(PipelineCache::computeKey(other), key);
+
+        other                 = desc;
+        other.depthAttachment = other.stencilAttachment = PixelFormat::NONE;
+        CHECK_NE(PipelineCache::computeKey(other), key);
+
+        other = desc;
+        other.vertexLayout.setAttrib("a_color", 2, VertexFormat::UBYTE4, 20, false);
+        CHECK_NE(PipelineCache::computeKey(other), key);
+    }
+
+    TEST_CASE("attribute order")
+    {
+        PipelineStateDesc desc;
+        desc.vertexLayout.setAttrib("a_color", 2, VertexFormat::UBYTE4, 20, true);
+        desc.vertexLayout.setAttrib("a_texCoord", 1, VertexFormat::FLOAT2, 12, false);
+        desc.vertexLayout.setAttrib("a_position", 0, VertexFormat::FLOAT3, 0, false);
+        desc.vertexLayout.setStride(24);
+
+        auto sprite              = makeSpriteState();
+        desc.programId           = sprite.programId;
+        desc.colorAttachments[0] = sprite.colorAttachments[0];
+        desc.depthAttachment     = sprite.depthAttachment;
+        desc.stencilAttachment   = sprite.stencilAttachment;
+        desc.blendDescriptor     = sprite.blendDescriptor;
+        CHECK_EQ(PipelineCache::computeKey(desc), PipelineCache::computeKey(sprite));
+    }
+
+    TEST_CASE("record")
+    {
+        PipelineCache cache;
+        const auto desc = makeSpriteState();
+        const auto key  = PipelineCache::computeKey(desc);
+
+        CHECK(cache.record(key, desc));
+        CHECK_FALSE(cache.record(key, desc));
+        CHECK(cache.contains(key));
+        CHECK_EQ(cache.getStates().size(), 1);
+    }
+
+    TEST_CASE("serialize")
+    {
+        PipelineCache cache;
+        auto sprite = makeSpriteState();
+        auto opaque = sprite;
+
+        opaque.blendDescriptor = BlendDescriptor{};
+        opaque.programId       = 42;
+        cache.record(PipelineCache::computeKey(sprite), sprite);
+        cache.record(PipelineCache::computeKey(opaque), opaque);
+
+        const auto data = cache.serialize();
+        PipelineCache loaded;
+        REQUIRE(loaded.deserialize(data.data(), data.size()));
+        REQUIRE_EQ(loaded.getStates().size(), 2);
+        CHECK(loaded.contains(PipelineCache::computeKey(sprite)));
+        CHECK(loaded.contains(PipelineCache::computeKey(opaque)));
+
+        const auto& state = loaded.getStates()[0];
+        CHECK_EQ(state.programId, sprite.programId);
+        CHECK_EQ(state.vertexLayout.getStride(), 24);
+        CHECK_EQ(state.vertexLayout.getAttributes().size(), 3);
+        CHECK_EQ(state.colorAttachments[1], PixelFormat::NONE);
+        CHECK_EQ(state.blendDescriptor.destinationRGBBlendFactor, BlendFactor::ONE_MINUS_SRC_ALPHA);
+        CHECK_EQ(PipelineCache::computeKey(state), PipelineCache::computeKey(sprite));
+    }
+
+    TEST_CASE("truncated data")
+    {
+        PipelineCache cache;
+        const auto desc = makeSpriteState();
+        cache.record(PipelineCache::computeKey(desc), desc);
+        const auto data = cache.serialize();
+
+        // a state cut short, i.e. by a crash while it was appended, is dropped
+        PipelineCache loaded;
+        CHECK(loaded.deserialize(data.data(), data.size() - 3));
+        CHECK(loaded.getStates().empty());
+
+        CHECK_FALSE(loaded.deserialize("AXPB", 4));
+        CHECK_FALSE(loaded.deserialize(nullptr, 0));
+    }
+}
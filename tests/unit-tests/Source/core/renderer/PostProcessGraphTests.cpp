@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "renderer/PostProcessGraph.h"
+
+
+using namespace ax;
+
+TEST_SUITE("renderer/PostProcessGraph")
+{
+    using Pass = PostProcessPass;
+
+    static constexpr auto SCENE  = PostProcessGraph::SCENE;
+    static constexpr auto SCREEN = PostProcessGraph::SCREEN;
+
+    TEST_CASE("ordered by dependencies")
+    {
+        PostProcessGraph graph;
+        auto screen = Pass::createColor("graded", SCREEN);
+        auto graded = Pass::createThreshold(SCENE, "graded", 0.5f, 1.0f);
+        graph.addPass(screen);
+        graph.addPass(graded);
+
+        REQUIRE(graph.compile());
+        REQUIRE_EQ(graph.getDrawCount(), 2);
+        CHECK_EQ(graph.getDrawPasses(0)[0], graded);
+        CHECK_EQ(graph.getDrawPasses(1)[0], screen);
+        CHECK_EQ(graph.getDrawTarget(0), 0);
+        CHECK_EQ(graph.getDrawTarget(1), -1);
+    }
+
+    TEST_CASE("culls the passes the screen doesn't read")
+    {
+        PostProcessGraph graph;
+        graph.addPass(Pass::createBlur(SCENE, "unused", Vec2(1, 0)));
+        graph.addPass(Pass::createThreshold(SCENE, SCREEN));
+
+        REQUIRE(graph.compile());
+        CHECK_EQ(graph.getDrawCount(), 1);
+        CHECK_EQ(graph.getTargetCount(), 0);
+    }
+
+    TEST_CASE("invalid graphs")
+    {
+        PostProcessGraph graph;
+        graph.addPass(Pass::createThreshold(SCENE, "bright"));
+        CHECK_FALSE(graph.compile());
+
+        // written twice
+        graph.addPass(Pass::createBlur(SCENE, "bright", Vec2(1, 0)));
+        graph.addPass(Pass::createColor("bright", SCREEN));
+        CHECK_FALSE(graph.compile());
+
+        // read but never written
+        graph.removeAllPasses();
+        graph.addPass(Pass::createColor("missing", SCREEN));
+        CHECK_FALSE(graph.compile());
+
+        // a cycle
+        graph.removeAllPasses();
+        graph.addPass(Pass::createBlur("b", "a", Vec2(1, 0)));
+        graph.addPass(Pass::createBlur("a", "b", Vec2(0, 1)));
+        graph.addPass(Pass::createComposite(SCENE, "a", SCREEN));
+        CHECK_FALSE(graph.compile());
+    }
+
+    TEST_CASE("merges the color passes")
+    {
+        PostProcessGraph graph;
+        auto composite = Pass::createComposite(SCENE, "blurred", "composited");
+        auto tint      = Pass::createColor("composited", "tinted");
+        auto grade     = Pass::createColor("tinted", SCREEN);
+        graph.addPass(Pass::createBlur(SCENE, "blurred", Vec2(1, 0)));
+        graph.addPass(composite);
+        graph.addPass(tint);
+        graph.addPass(grade);
+
+        REQUIRE(graph.compile());
+        REQUIRE_EQ(graph.getDrawCount(), 2);
+        const auto& passes = graph.getDrawPasses(1);
+        REQUIRE_EQ(passes.size(), 3);
+        CHECK_EQ(passes[0], composite);
+        CHECK_EQ(passes[1], tint);
+        CHECK_EQ(passes[2], grade);
+        CHECK_EQ(graph.getDrawTarget(1), -1);
+        CHECK_EQ(graph.getTargetCount(), 1);
+    }
+
+    TEST_CASE("doesn't merge an input read twice")
+    {
+        PostProcessGraph graph;
+        graph.addPass(Pass::createColor(SCENE, "graded"));
+        graph.addPass(Pass::createBlur("graded", "blurred", Vec2(1, 0), 1.0f));
+        graph.addPass(Pass::createComposite("graded", "blurred", "composited"));
+        graph.addPass(Pass::createColor("composited", SCREEN));
+
+        REQUIRE(graph.compile());
+        CHECK_EQ(graph.getDrawCount(), 3);
+        CHECK_EQ(graph.getDrawPasses(2).size(), 2);
+    }
+
+    TEST_CASE("aliases the targets")
+    {
+        // a bloom
+        PostProcessGraph graph;
+        graph.addPass(Pass::createThreshold(SCENE, "bright", 0.8f, 0.5f));
+        graph.addPass(Pass::createBlur("bright", "blurX", Vec2(1, 0), 0.5f));
+        graph.addPass(Pass::createBlur("blurX", "blurY", Vec2(0, 1), 0.5f));
+        graph.addPass(Pass::createBlur("blurY", "blurX2", Vec2(2, 0), 0.5f));
+        graph.addPass(Pass::createBlur("blurX2", "blurY2", Vec2(0, 2), 0.5f));
+        graph.addPass(Pass::createComposite(SCENE, "blurY2", SCREEN, 0.7f));
+
+        REQUIRE(graph.compile());
+        REQUIRE_EQ(graph.getDrawCount(), 6);
+        CHECK_EQ(graph.getTargetCount(), 2);
+        for (size_t i = 1; i < 5; ++i)
+            CHECK_NE(graph.getDrawTarget(i), graph.getDrawTarget(i - 1));
+        CHECK_EQ(graph.getDrawTarget(0), graph.getDrawTarget(2));
+
+        // the targets of other scales aren't shared
+        graph.removeAllPasses();
+        graph.addPass(Pass::createThreshold(SCENE, "bright", 0.8f, 0.5f));
+        graph.addPass(Pass::createBlur("bright", "blurX", Vec2(1, 0), 0.25f));
+        graph.addPass(Pass::createBlur("blurX", "blurY", Vec2(0, 1), 0.5f));
+        graph.addPass(Pass::createComposite(SCENE, "blurY", SCREEN));
+
+        REQUIRE(graph.compile());
+        CHECK_EQ(graph.getTargetCount(), 2);
+        CHECK_EQ(graph.getDrawTarget(0), graph.getDrawTarget(2));
+    }
+}
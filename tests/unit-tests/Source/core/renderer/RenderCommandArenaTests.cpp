@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/RenderCommandArena.h"
+
+TEST_SUITE("renderer/RenderCommandArena")
+{
+    struct Tracked
+    {
+        explicit Tracked(std::vector<int>& log, int id) : _log(log), _id(id) {}
+        ~Tracked() { _log.push_back(_id); }
+
+        std::vector<int>& _log;
+        int _id;
+    };
+
+    TEST_CASE("allocate")
+    {
+        ax::RenderCommandArena arena;
+
+        auto a = arena.allocate(3, 1);
+        auto b = arena.allocate(8, 8);
+        CHECK_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0);
+        CHECK_NE(a, b);
+        CHECK_EQ(arena.getHeapAllocations(), 1);
+
+        // bigger than one block, gets a dedicated block
+        arena.allocate(ax::RenderCommandArena::BLOCK_SIZE * 2);
+        CHECK_EQ(arena.getHeapAllocations(), 2);
+        CHECK_EQ(arena.getCapacity(), ax::RenderCommandArena::BLOCK_SIZE * 3);
+    }
+
+    TEST_CASE("reset")
+    {
+        ax::RenderCommandArena arena;
+        std::vector<int> log;
+
+        arena.create<Tracked>(log, 1);
+        arena.create<Tracked>(log, 2);
+        arena.create<int>(3);
+        arena.reset();
+
+        // destroyed in reverse creation order
+        CHECK_EQ(log, std::vector<int>{2, 1});
+
+        // steady state: the blocks are reused
+        arena.clearHeapAllocations();
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            for (int i = 0; i < 1000; ++i)
+                arena.create<Tracked>(log, i);
+            arena.reset();
+        }
+        auto warmedUp = arena.getHeapAllocations();
+
+        arena.clearHeapAllocations();
+        for (int i = 0; i < 1000; ++i)
+            arena.create<Tracked>(log, i);
+        arena.reset();
+        CHECK_GT(warmedUp, 0);
+        CHECK_EQ(arena.getHeapAllocations(), 0);
+    }
+}